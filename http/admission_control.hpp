@@ -0,0 +1,321 @@
+#pragma once
+
+#include "bmcweb_config.h"
+
+#include "logging.hpp"
+
+#include <boost/beast/http/verb.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace crow
+{
+
+enum class RequestClass
+{
+    // Service root probes used as health checks
+    Light,
+    Normal,
+    // $expand, D-Bus enumeration, log enumeration and CSR generation, which
+    // fan out into many calls or keep the daemons behind them busy
+    Heavy,
+};
+
+inline RequestClass classifyRequest(boost::beast::http::verb method,
+                                    std::string_view path,
+                                    std::string_view query)
+{
+    if (method == boost::beast::http::verb::get ||
+        method == boost::beast::http::verb::head)
+    {
+        if (path == "/redfish" || path == "/redfish/" ||
+            path == "/redfish/v1" || path == "/redfish/v1/")
+        {
+            return RequestClass::Light;
+        }
+    }
+    if (query.find("$expand") != std::string_view::npos ||
+        query.find("%24expand") != std::string_view::npos)
+    {
+        return RequestClass::Heavy;
+    }
+    if (path.starts_with("/bus/") &&
+        (path.ends_with("/enumerate") || path.ends_with("/list")))
+    {
+        return RequestClass::Heavy;
+    }
+    if (method == boost::beast::http::verb::get &&
+        path.find("/LogServices/") != std::string_view::npos &&
+        (path.ends_with("/Entries") || path.ends_with("/Entries/")))
+    {
+        return RequestClass::Heavy;
+    }
+    if (path.ends_with("/CertificateService.GenerateCSR"))
+    {
+        return RequestClass::Heavy;
+    }
+    return RequestClass::Normal;
+}
+
+class TokenBucket
+{
+  public:
+    TokenBucket(double capacity, std::chrono::steady_clock::time_point now) :
+        tokens(capacity), lastRefill(now)
+    {}
+
+    void refill(double ratePerSecond, double capacity,
+                std::chrono::steady_clock::time_point now)
+    {
+        std::chrono::duration<double> elapsed = now - lastRefill;
+        tokens = std::min(capacity, tokens + elapsed.count() * ratePerSecond);
+        lastRefill = now;
+    }
+
+    bool has(double cost) const
+    {
+        return tokens >= cost;
+    }
+
+    void take(double cost)
+    {
+        tokens -= cost;
+    }
+
+    bool full(double capacity) const
+    {
+        return tokens >= capacity;
+    }
+
+    // Whole seconds until cost is available again
+    std::chrono::seconds wait(double cost, double ratePerSecond) const
+    {
+        double seconds = std::ceil((cost - tokens) / ratePerSecond);
+        return std::chrono::seconds(
+            std::max(1L, static_cast<long>(seconds)));
+    }
+
+  private:
+    double tokens;
+    std::chrono::steady_clock::time_point lastRefill;
+};
+
+class AdmissionController;
+
+// Holds one in-flight slot until destroyed
+class AdmissionTicket
+{
+  public:
+    explicit AdmissionTicket(AdmissionController& controllerIn) :
+        controller(&controllerIn)
+    {}
+
+    AdmissionTicket(const AdmissionTicket&) = delete;
+    AdmissionTicket& operator=(const AdmissionTicket&) = delete;
+
+    AdmissionTicket(AdmissionTicket&& other) noexcept :
+        controller(std::exchange(other.controller, nullptr))
+    {}
+
+    AdmissionTicket& operator=(AdmissionTicket&& other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            controller = std::exchange(other.controller, nullptr);
+        }
+        return *this;
+    }
+
+    ~AdmissionTicket()
+    {
+        release();
+    }
+
+  private:
+    inline void release();
+
+    AdmissionController* controller;
+};
+
+/**
+ * @brief Bounds the requests the one io_context works on at a time, and how
+ * fast a single client can add to them.
+ *
+ * Heavy requests may only fill half of the maxInFlight slots, so a burst of
+ * $expand queries can't crowd out everything else, and health checks get a
+ * few slots past the limit and skip rate limiting entirely.  Every other
+ * request costs a token from both its client address's bucket and its
+ * session's, heavy ones heavyCost tokens.  A rejected request should be
+ * answered right away with a 503 and a Retry-After of the returned wait.
+ */
+class AdmissionController
+{
+  public:
+    static constexpr size_t lightReserve = 4;
+    static constexpr double heavyCost = 4.0;
+    // Buckets that have filled back up are dropped past this many clients
+    static constexpr size_t maxTrackedClients = 1024;
+
+    // 0 disables the respective limit
+    AdmissionController(size_t maxInFlightIn, size_t ratePerSecondIn) :
+        maxInFlight(maxInFlightIn),
+        ratePerSecond(static_cast<double>(ratePerSecondIn)),
+        burst(std::max(heavyCost, 2.0 * ratePerSecond))
+    {}
+
+    AdmissionController(const AdmissionController&) = delete;
+    AdmissionController(AdmissionController&&) = delete;
+    AdmissionController& operator=(const AdmissionController&) = delete;
+    AdmissionController& operator=(AdmissionController&&) = delete;
+    ~AdmissionController() = default;
+
+    /**
+     * @brief Admits a request, returning the ticket to hold until its
+     * response has been sent.  Returns std::nullopt, and sets retryAfter,
+     * when the request should be rejected.
+     *
+     * @param[in] client   Client address
+     * @param[in] session  Session id, or empty when there's no session
+     */
+    std::optional<AdmissionTicket>
+        admit(RequestClass requestClass, std::string_view client,
+              std::string_view session,
+              std::chrono::steady_clock::time_point now,
+              std::chrono::seconds& retryAfter)
+    {
+        if (maxInFlight != 0)
+        {
+            size_t limit = maxInFlight;
+            if (requestClass == RequestClass::Light)
+            {
+                limit += lightReserve;
+            }
+            else if (requestClass == RequestClass::Heavy)
+            {
+                limit = std::max<size_t>(1, maxInFlight / 2);
+            }
+            if (inFlight >= limit)
+            {
+                BMCWEB_LOG_WARNING << "Rejecting request, " << inFlight
+                                   << " requests in flight";
+                retryAfter = std::chrono::seconds(1);
+                return std::nullopt;
+            }
+        }
+
+        if (ratePerSecond != 0.0 && requestClass != RequestClass::Light)
+        {
+            double cost = requestClass == RequestClass::Heavy ? heavyCost
+                                                              : 1.0;
+            TokenBucket& clientBucket = bucket(clients, client, now);
+            TokenBucket* sessionBucket = nullptr;
+            if (!session.empty())
+            {
+                sessionBucket = &bucket(sessions, session, now);
+            }
+            if (!clientBucket.has(cost))
+            {
+                BMCWEB_LOG_WARNING << "Rate limiting client " << client;
+                retryAfter = clientBucket.wait(cost, ratePerSecond);
+                return std::nullopt;
+            }
+            if (sessionBucket != nullptr && !sessionBucket->has(cost))
+            {
+                BMCWEB_LOG_WARNING << "Rate limiting session requests";
+                retryAfter = sessionBucket->wait(cost, ratePerSecond);
+                return std::nullopt;
+            }
+            clientBucket.take(cost);
+            if (sessionBucket != nullptr)
+            {
+                sessionBucket->take(cost);
+            }
+        }
+
+        inFlight++;
+        return AdmissionTicket(*this);
+    }
+
+    size_t inFlightCount() const
+    {
+        return inFlight;
+    }
+
+  private:
+    friend class AdmissionTicket;
+
+    using BucketMap = std::unordered_map<std::string, TokenBucket>;
+
+    TokenBucket& bucket(BucketMap& buckets, std::string_view key,
+                        std::chrono::steady_clock::time_point now)
+    {
+        std::string keyStr(key);
+        auto it = buckets.find(keyStr);
+        if (it != buckets.end())
+        {
+            it->second.refill(ratePerSecond, burst, now);
+            return it->second;
+        }
+        if (buckets.size() >= maxTrackedClients)
+        {
+            // A full bucket is the same as a missing one
+            for (auto entry = buckets.begin(); entry != buckets.end();)
+            {
+                entry->second.refill(ratePerSecond, burst, now);
+                if (entry->second.full(burst))
+                {
+                    entry = buckets.erase(entry);
+                }
+                else
+                {
+                    entry++;
+                }
+            }
+            if (buckets.size() >= maxTrackedClients)
+            {
+                buckets.clear();
+            }
+        }
+        return buckets.try_emplace(std::move(keyStr), burst, now)
+            .first->second;
+    }
+
+    void release()
+    {
+        inFlight--;
+    }
+
+    size_t maxInFlight;
+    double ratePerSecond;
+    double burst;
+    size_t inFlight = 0;
+    BucketMap clients;
+    BucketMap sessions;
+};
+
+inline void AdmissionTicket::release()
+{
+    if (controller != nullptr)
+    {
+        controller->release();
+        controller = nullptr;
+    }
+}
+
+inline AdmissionController& getAdmissionController()
+{
+    static AdmissionController controller(bmcwebHttpMaxInFlightRequests,
+                                          bmcwebHttpClientRateLimit);
+    return controller;
+}
+
+} // namespace crow
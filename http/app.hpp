@@ -65,6 +65,12 @@ class App
         router.handleUpgrade(req, asyncResp, std::forward<Adaptor>(adaptor));
     }
 
+    bool isFileUpload(boost::beast::http::verb method,
+                      std::string_view target) const
+    {
+        return router.isFileUpload(method, target);
+    }
+
     void handle(Request& req,
                 const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
     {
@@ -158,6 +164,11 @@ class App
         return router.getRoutes(parent);
     }
 
+    std::vector<metrics::RouteSeries> getRouteMetrics() const
+    {
+        return router.getRouteMetrics();
+    }
+
 #ifdef BMCWEB_ENABLE_SSL
     App& ssl(std::shared_ptr<boost::asio::ssl::context>&& ctx)
     {
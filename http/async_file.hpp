@@ -0,0 +1,192 @@
+#pragma once
+
+#include "logging.hpp"
+#include "worker_pool.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <boost/system/error_code.hpp>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace crow
+{
+namespace async_file
+{
+
+/**
+ * @brief Reads the whole of path into contents.  Files larger than maxSize
+ * aren't read, and fail with file_too_large.
+ */
+inline boost::system::error_code
+    readFile(const std::string& path, std::string& contents, size_t maxSize)
+{
+    contents.clear();
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return {errno, boost::system::system_category()};
+    }
+    boost::system::error_code ec;
+    struct stat info
+    {};
+    if (fstat(fd, &info) != 0)
+    {
+        ec = {errno, boost::system::system_category()};
+    }
+    else if (!S_ISREG(info.st_mode))
+    {
+        ec = boost::system::errc::make_error_code(
+            boost::system::errc::invalid_argument);
+    }
+    else if (static_cast<uint64_t>(info.st_size) > maxSize)
+    {
+        ec = boost::system::errc::make_error_code(
+            boost::system::errc::file_too_large);
+    }
+    else
+    {
+        contents.resize(static_cast<size_t>(info.st_size));
+        size_t done = 0;
+        while (done < contents.size())
+        {
+            ssize_t got = read(fd, &contents[done], contents.size() - done);
+            if (got < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (got < 0)
+            {
+                ec = {errno, boost::system::system_category()};
+                break;
+            }
+            if (got == 0)
+            {
+                // Truncated while it was read
+                break;
+            }
+            done += static_cast<size_t>(got);
+        }
+        contents.resize(done);
+    }
+    close(fd);
+    if (ec)
+    {
+        contents.clear();
+    }
+    return ec;
+}
+
+/**
+ * @brief Reads path on a worker thread, then calls
+ * callback(const boost::system::error_code&, std::string&&) on ex.
+ */
+template <typename Executor, typename Callback>
+inline void asyncReadFile(const Executor& ex, std::string path, size_t maxSize,
+                          Callback&& callback)
+{
+    struct Read
+    {
+        std::string path;
+        std::string contents;
+        boost::system::error_code ec;
+    };
+    auto file = std::make_shared<Read>();
+    file->path = std::move(path);
+    worker_pool::offload(
+        ex,
+        [file, maxSize]() {
+        file->ec = readFile(file->path, file->contents, maxSize);
+    },
+        [file, callback{std::forward<Callback>(callback)}]() mutable {
+        if (file->ec)
+        {
+            BMCWEB_LOG_DEBUG << "Failed to read " << file->path << ": "
+                             << file->ec.message();
+        }
+        callback(file->ec, std::move(file->contents));
+    });
+}
+
+/**
+ * @brief Rewrites one file, off the io thread, in the order the writes were
+ * asked for.
+ *
+ * Each write replaces the whole file, so a write that hasn't started by the
+ * time a later one has finished is dropped rather than run over it.  write()
+ * and writeNow() must only be called from the io thread; the file itself is
+ * only touched by one thread at a time.
+ */
+class OrderedWriter
+{
+  public:
+    // Replaces the file at path with contents, returning false on failure
+    using WriteFunc = bool (*)(const std::string& path,
+                               std::string_view contents);
+
+    OrderedWriter(std::string path, WriteFunc writeFunc) :
+        state(std::make_shared<State>(std::move(path), writeFunc))
+    {}
+
+    // Writes contents on a worker thread
+    template <typename Executor>
+    void write(const Executor& ex, std::string contents)
+    {
+        worker_pool::offload(
+            ex,
+            [target{state}, sequence{++issued},
+             contents{std::move(contents)}]() {
+            target->write(sequence, contents);
+        },
+            []() {});
+    }
+
+    // Writes contents before returning, for when there's no io to come back
+    // to
+    bool writeNow(std::string_view contents)
+    {
+        return state->write(++issued, contents);
+    }
+
+  private:
+    struct State
+    {
+        State(std::string pathIn, WriteFunc writeFuncIn) :
+            path(std::move(pathIn)), writeFunc(writeFuncIn)
+        {}
+
+        bool write(uint64_t sequence, std::string_view contents)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (sequence <= written)
+            {
+                BMCWEB_LOG_DEBUG << "Skipping superseded write of " << path;
+                return true;
+            }
+            written = sequence;
+            return writeFunc(path, contents);
+        }
+
+        std::mutex mutex;
+        const std::string path;
+        const WriteFunc writeFunc;
+        // The last write started
+        uint64_t written = 0;
+    };
+
+    std::shared_ptr<State> state;
+    uint64_t issued = 0;
+};
+
+} // namespace async_file
+} // namespace crow
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+
+#include <deque>
+#include <functional>
+#include <utility>
+
+namespace crow
+{
+
+/**
+ * @brief Runs bulk work, like $expand or log enumeration, on the io_context
+ * one task per turn of the event loop.
+ *
+ * Everything else, including KVM, SOL and login traffic, keeps running
+ * straight from its own completion handlers.  After each bulk task the rest
+ * of the queue goes to the back of the io_context's ready queue, so any
+ * interactive completion that became ready in the meantime runs before the
+ * next bulk task does, however many are waiting.
+ */
+class BulkScheduler
+{
+  public:
+    explicit BulkScheduler(boost::asio::io_context& ioIn) : io(ioIn) {}
+
+    BulkScheduler(const BulkScheduler&) = delete;
+    BulkScheduler(BulkScheduler&&) = delete;
+    BulkScheduler& operator=(const BulkScheduler&) = delete;
+    BulkScheduler& operator=(BulkScheduler&&) = delete;
+    ~BulkScheduler() = default;
+
+    void post(std::function<void()>&& task)
+    {
+        tasks.emplace_back(std::move(task));
+        schedule();
+    }
+
+    size_t pending() const
+    {
+        return tasks.size();
+    }
+
+  private:
+    void schedule()
+    {
+        if (scheduled || tasks.empty())
+        {
+            return;
+        }
+        scheduled = true;
+        boost::asio::post(io, [this]() { runOne(); });
+    }
+
+    void runOne()
+    {
+        std::function<void()> task = std::move(tasks.front());
+        tasks.pop_front();
+        // Anything the task queues still goes after what it posts itself
+        task();
+        scheduled = false;
+        schedule();
+    }
+
+    boost::asio::io_context& io;
+    std::deque<std::function<void()>> tasks;
+    bool scheduled = false;
+};
+
+// bmcweb runs everything on one io_context, so there is one scheduler
+inline BulkScheduler& getBulkScheduler(boost::asio::io_context& io)
+{
+    static BulkScheduler scheduler(io);
+    return scheduler;
+}
+
+} // namespace crow
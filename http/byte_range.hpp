@@ -0,0 +1,239 @@
+#pragma once
+
+#include "http_request.hpp"
+#include "http_response.hpp"
+
+#include <sys/stat.h>
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/beast/http/field.hpp>
+#include <boost/beast/http/status.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace crow
+{
+namespace byte_range
+{
+
+// Inclusive offsets of the bytes a Range header selected
+struct ByteRange
+{
+    uint64_t first = 0;
+    uint64_t last = 0;
+
+    uint64_t length() const
+    {
+        return last - first + 1;
+    }
+};
+
+enum class RangeStatus
+{
+    // No usable range; the whole representation is sent with a 200
+    Full,
+    Partial,
+    Unsatisfiable,
+};
+
+struct RangeSelection
+{
+    RangeStatus status = RangeStatus::Full;
+    ByteRange range;
+};
+
+// The headers selectRange() looks at, copied so they outlive the request for
+// handlers that only learn the size after an async call
+struct RangeRequest
+{
+    RangeRequest() = default;
+
+    explicit RangeRequest(const Request& req) :
+        range(req.getHeaderValue(boost::beast::http::field::range)),
+        ifRange(req.getHeaderValue(boost::beast::http::field::if_range))
+    {}
+
+    std::string range;
+    std::string ifRange;
+};
+
+inline std::string_view trim(std::string_view value)
+{
+    while (!value.empty() && (value.front() == ' ' || value.front() == '\t'))
+    {
+        value.remove_prefix(1);
+    }
+    while (!value.empty() && (value.back() == ' ' || value.back() == '\t'))
+    {
+        value.remove_suffix(1);
+    }
+    return value;
+}
+
+inline bool parseOffset(std::string_view value, uint64_t& out)
+{
+    value = trim(value);
+    if (value.empty())
+    {
+        return false;
+    }
+    const char* end = value.data() + value.size();
+    auto [ptr, ec] = std::from_chars(value.data(), end, out);
+    return ec == std::errc() && ptr == end;
+}
+
+/**
+ * @brief Works out which bytes of a size byte representation a Range header
+ * asks for.
+ *
+ * Only a single range is supported.  A malformed header, a unit other than
+ * bytes, or a list of ranges gets the whole representation, as RFC 9110
+ * allows servers to ignore Range.
+ */
+inline RangeSelection parseRange(std::string_view header, uint64_t size)
+{
+    RangeSelection selection;
+    header = trim(header);
+    constexpr std::string_view unit = "bytes=";
+    if (!boost::algorithm::istarts_with(header, unit))
+    {
+        return selection;
+    }
+    std::string_view spec = header.substr(unit.size());
+    if (spec.find(',') != std::string_view::npos)
+    {
+        return selection;
+    }
+    size_t dash = spec.find('-');
+    if (dash == std::string_view::npos)
+    {
+        return selection;
+    }
+    std::string_view firstStr = trim(spec.substr(0, dash));
+    std::string_view lastStr = trim(spec.substr(dash + 1));
+
+    ByteRange range;
+    if (firstStr.empty())
+    {
+        // bytes=-N is the last N bytes
+        uint64_t suffix = 0;
+        if (!parseOffset(lastStr, suffix))
+        {
+            return selection;
+        }
+        if (suffix == 0 || size == 0)
+        {
+            selection.status = RangeStatus::Unsatisfiable;
+            return selection;
+        }
+        range.first = size - std::min(suffix, size);
+        range.last = size - 1;
+    }
+    else
+    {
+        if (!parseOffset(firstStr, range.first))
+        {
+            return selection;
+        }
+        range.last = UINT64_MAX;
+        if (!lastStr.empty() &&
+            (!parseOffset(lastStr, range.last) || range.last < range.first))
+        {
+            return selection;
+        }
+        if (range.first >= size)
+        {
+            selection.status = RangeStatus::Unsatisfiable;
+            return selection;
+        }
+        range.last = std::min(range.last, size - 1);
+    }
+    selection.status = RangeStatus::Partial;
+    selection.range = range;
+    return selection;
+}
+
+/**
+ * @brief parseRange(), honoring If-Range.
+ *
+ * validator is the strong ETag the response carries.  A range is only used
+ * if If-Range is absent or names that ETag, so a resumed download never
+ * splices together two versions of a file.
+ */
+inline RangeSelection selectRange(std::string_view rangeHeader,
+                                  std::string_view ifRangeHeader,
+                                  uint64_t size, std::string_view validator)
+{
+    ifRangeHeader = trim(ifRangeHeader);
+    if (!ifRangeHeader.empty() &&
+        (validator.empty() || ifRangeHeader != validator))
+    {
+        return {};
+    }
+    return parseRange(rangeHeader, size);
+}
+
+inline RangeSelection selectRange(const RangeRequest& request, uint64_t size,
+                                  std::string_view validator)
+{
+    return selectRange(request.range, request.ifRange, size, validator);
+}
+
+inline std::string contentRange(const ByteRange& range, uint64_t size)
+{
+    return "bytes " + std::to_string(range.first) + "-" +
+           std::to_string(range.last) + "/" + std::to_string(size);
+}
+
+inline std::string unsatisfiedRange(uint64_t size)
+{
+    return "bytes */" + std::to_string(size);
+}
+
+// Strong ETag for a file, from its modification time and size
+inline std::string fileValidator(const struct stat& st)
+{
+    std::string etag = "\"";
+    etag += std::to_string(st.st_mtim.tv_sec);
+    etag += '.';
+    etag += std::to_string(st.st_mtim.tv_nsec);
+    etag += '-';
+    etag += std::to_string(st.st_size);
+    etag += '"';
+    return etag;
+}
+
+/**
+ * @brief Sets the status and headers for answering selection.
+ *
+ * The caller fills the body with just selection.range when the result is
+ * Partial, and leaves it empty when Unsatisfiable.
+ */
+inline void setRangeHeaders(Response& res, const RangeSelection& selection,
+                            uint64_t size, std::string_view validator)
+{
+    res.addHeader(boost::beast::http::field::accept_ranges, "bytes");
+    if (!validator.empty())
+    {
+        res.addHeader(boost::beast::http::field::etag, validator);
+    }
+    if (selection.status == RangeStatus::Partial)
+    {
+        res.result(boost::beast::http::status::partial_content);
+        res.addHeader(boost::beast::http::field::content_range,
+                      contentRange(selection.range, size));
+    }
+    else if (selection.status == RangeStatus::Unsatisfiable)
+    {
+        res.result(boost::beast::http::status::range_not_satisfiable);
+        res.addHeader(boost::beast::http::field::content_range,
+                      unsatisfiedRange(size));
+    }
+}
+
+} // namespace byte_range
+} // namespace crow
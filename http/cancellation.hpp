@@ -0,0 +1,86 @@
+#pragma once
+
+#include <sys/socket.h>
+
+#include <boost/beast/http/verb.hpp>
+
+#include <cerrno>
+#include <cstddef>
+
+namespace crow
+{
+
+/**
+ * @brief Whether the client a request came from is still waiting for the
+ * response.
+ *
+ * The connection cancels it when the client resets the connection before the
+ * response is written.  It's shared by the request's AsyncResp and its D-Bus
+ * trace, so D-Bus calls issued on the request's behalf, and $expand
+ * sub-requests, are dropped rather than made for a response nobody will
+ * read.
+ */
+class Cancellation
+{
+  public:
+    void cancel()
+    {
+        cancelledFlag = true;
+    }
+
+    bool cancelled() const
+    {
+        return cancelledFlag;
+    }
+
+  private:
+    bool cancelledFlag = false;
+};
+
+// What a readable socket says about the client of the request in flight
+enum class PeerState
+{
+    // Sent more data, such as a pipelined request
+    Sending,
+    // Nothing to read after all
+    Idle,
+    // Shut down its side, but may still be reading the response
+    HalfClosed,
+    // Reset the connection, or the socket failed; nothing more gets through
+    Gone,
+};
+
+// Looks at, without reading, what's waiting on the socket fd
+inline PeerState peekPeerState(int fd)
+{
+    char byte = 0;
+    ssize_t n = ::recv(fd, &byte, 1, MSG_PEEK | MSG_DONTWAIT);
+    if (n > 0)
+    {
+        return PeerState::Sending;
+    }
+    if (n == 0)
+    {
+        return PeerState::HalfClosed;
+    }
+    if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+    {
+        return PeerState::Idle;
+    }
+    return PeerState::Gone;
+}
+
+/**
+ * @brief Whether a request whose client has shut down its side is dropped
+ * rather than answered.  Only a GET or HEAD, which the client can send again
+ * without harm, is, and only if nothing else the client sent is waiting to be
+ * handled.
+ */
+inline bool dropOnHalfClose(boost::beast::http::verb method,
+                            size_t bufferedBytes)
+{
+    return bufferedBytes == 0 && (method == boost::beast::http::verb::get ||
+                                  method == boost::beast::http::verb::head);
+}
+
+} // namespace crow
@@ -3,11 +3,14 @@
 #include "utility.hpp"
 
 #include <boost/beast/http/verb.hpp>
+#include <boost/container/small_vector.hpp>
 
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <stdexcept>
 #include <string>
-#include <vector>
+#include <string_view>
 
 namespace crow
 {
@@ -23,12 +26,25 @@ enum class ParamType
     MAX
 };
 
+/**
+ * @brief The parameters matched in a url, held inline so routing a request
+ * doesn't allocate.  No route has more parameters than fit; any beyond that
+ * spill to the heap.
+ *
+ * String parameters are views into the url that was routed, so they're only
+ * valid as long as the request is.
+ */
 struct RoutingParams
 {
-    std::vector<int64_t> intParams;
-    std::vector<uint64_t> uintParams;
-    std::vector<double> doubleParams;
-    std::vector<std::string> stringParams;
+    static constexpr size_t inlineParams = 4;
+
+    template <typename T>
+    using Params = boost::container::small_vector<T, inlineParams>;
+
+    Params<int64_t> intParams;
+    Params<uint64_t> uintParams;
+    Params<double> doubleParams;
+    Params<std::string_view> stringParams;
 
     void debugPrint() const
     {
@@ -48,7 +64,7 @@ struct RoutingParams
             std::cerr << i << ", ";
         }
         std::cerr << std::endl;
-        for (const std::string& i : stringParams)
+        for (std::string_view i : stringParams)
         {
             std::cerr << i << ", ";
         }
@@ -80,7 +96,7 @@ inline double RoutingParams::get<double>(unsigned index) const
 template <>
 inline std::string RoutingParams::get<std::string>(unsigned index) const
 {
-    return stringParams[index];
+    return std::string(stringParams[index]);
 }
 
 } // namespace crow
@@ -0,0 +1,186 @@
+#pragma once
+
+#include "intrusive_link.hpp"
+#include "logging.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+namespace crow
+{
+
+class ManagedConnection;
+
+/**
+ * @brief Caps the connections a Server holds open at once.
+ *
+ * Connections waiting on a keep-alive for their next request are kept in
+ * least recently used order.  When a new connection would go over the cap,
+ * the one that has been idle longest is closed to make room, so a sweep that
+ * opens hundreds of connections doesn't leave each holding its buffers and
+ * parser until its timeout, while clients with requests in flight are left
+ * alone.  A new connection is only turned away when none are idle.
+ */
+class ConnectionManager
+{
+  public:
+    explicit ConnectionManager(size_t maxConnectionsIn) :
+        maxConnections(maxConnectionsIn)
+    {}
+
+    ConnectionManager(const ConnectionManager&) = delete;
+    ConnectionManager(ConnectionManager&&) = delete;
+    ConnectionManager& operator=(const ConnectionManager&) = delete;
+    ConnectionManager& operator=(ConnectionManager&&) = delete;
+    ~ConnectionManager() = default;
+
+    size_t liveCount() const
+    {
+        return live;
+    }
+
+    size_t idleCount() const
+    {
+        return idle;
+    }
+
+    size_t evictedCount() const
+    {
+        return evicted;
+    }
+
+  private:
+    friend class ManagedConnection;
+
+    bool open(ManagedConnection& conn);
+    void release(ManagedConnection& conn);
+    void markIdle(ManagedConnection& conn);
+    void markBusy(ManagedConnection& conn);
+
+    size_t maxConnections;
+    size_t live = 0;
+    size_t idle = 0;
+    size_t evicted = 0;
+    // Idle connections, longest idle first
+    intrusive::Link idleList;
+};
+
+/**
+ * @brief A connection's place in its ConnectionManager, embedded in the
+ * connection.  onEvict is given once, up front, and is called when the
+ * manager closes the connection to make room for another; by then it no
+ * longer counts against the cap.  Destroying it releases the connection.
+ */
+class ManagedConnection : private intrusive::Link
+{
+  public:
+    ManagedConnection(ConnectionManager& managerIn,
+                      std::function<void()>&& onEvictIn) :
+        manager(managerIn),
+        onEvict(std::move(onEvictIn))
+    {}
+
+    ManagedConnection(const ManagedConnection&) = delete;
+    ManagedConnection(ManagedConnection&&) = delete;
+    ManagedConnection& operator=(const ManagedConnection&) = delete;
+    ManagedConnection& operator=(ManagedConnection&&) = delete;
+
+    ~ManagedConnection()
+    {
+        release();
+    }
+
+    // Counts the connection against the cap, evicting an idle one if need
+    // be; false if the cap is reached with nothing idle
+    bool open()
+    {
+        return manager.open(*this);
+    }
+
+    void release()
+    {
+        manager.release(*this);
+    }
+
+    // Waiting on the client for another request
+    void markIdle()
+    {
+        manager.markIdle(*this);
+    }
+
+    // Working on a request
+    void markBusy()
+    {
+        manager.markBusy(*this);
+    }
+
+    bool isIdle() const
+    {
+        return linked();
+    }
+
+  private:
+    friend class ConnectionManager;
+
+    ConnectionManager& manager;
+    std::function<void()> onEvict;
+    bool counted = false;
+};
+
+inline bool ConnectionManager::open(ManagedConnection& conn)
+{
+    if (conn.counted)
+    {
+        return true;
+    }
+    if (live >= maxConnections)
+    {
+        if (!idleList.linked())
+        {
+            return false;
+        }
+        ManagedConnection& victim =
+            static_cast<ManagedConnection&>(*idleList.next);
+        release(victim);
+        evicted++;
+        BMCWEB_LOG_DEBUG << "Evicting idle connection, " << live
+                         << " connections open";
+        victim.onEvict();
+    }
+    conn.counted = true;
+    live++;
+    return true;
+}
+
+inline void ConnectionManager::release(ManagedConnection& conn)
+{
+    markBusy(conn);
+    if (conn.counted)
+    {
+        conn.counted = false;
+        live--;
+    }
+}
+
+inline void ConnectionManager::markIdle(ManagedConnection& conn)
+{
+    if (!conn.counted)
+    {
+        return;
+    }
+    markBusy(conn);
+    conn.insertBefore(idleList);
+    idle++;
+}
+
+inline void ConnectionManager::markBusy(ManagedConnection& conn)
+{
+    if (conn.linked())
+    {
+        conn.unlink();
+        idle--;
+    }
+}
+
+} // namespace crow
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace crow
+{
+
+/**
+ * @brief A bounded free-list of server side connections, so an accept can
+ * reuse the buffers, parser and timer of a connection that already closed
+ * instead of constructing new ones.
+ *
+ * share() hands an object out as a shared_ptr.  Once the last reference is
+ * dropped the object's park() is called and it's kept for a later take(), as
+ * long as fewer than capacity objects are parked; past that, and after the
+ * pool itself is gone, it's destroyed as usual.  T::park() must leave the
+ * object holding no external resources.
+ */
+template <typename T>
+class ConnectionPool : public std::enable_shared_from_this<ConnectionPool<T>>
+{
+  public:
+    explicit ConnectionPool(size_t capacityIn) : capacity(capacityIn)
+    {
+        parked.reserve(capacity);
+    }
+
+    ConnectionPool(const ConnectionPool&) = delete;
+    ConnectionPool(ConnectionPool&&) = delete;
+    ConnectionPool& operator=(const ConnectionPool&) = delete;
+    ConnectionPool& operator=(ConnectionPool&&) = delete;
+    ~ConnectionPool() = default;
+
+    // A parked object, or nullptr when there are none.  The caller is
+    // expected to reinitialize it before use.
+    std::unique_ptr<T> take()
+    {
+        if (parked.empty())
+        {
+            return nullptr;
+        }
+        std::unique_ptr<T> obj = std::move(parked.back());
+        parked.pop_back();
+        return obj;
+    }
+
+    std::shared_ptr<T> share(std::unique_ptr<T> obj)
+    {
+        return {obj.release(),
+                [weakPool{this->weak_from_this()}](T* ptr) {
+            std::unique_ptr<T> released(ptr);
+            std::shared_ptr<ConnectionPool<T>> pool = weakPool.lock();
+            if (pool)
+            {
+                pool->put(std::move(released));
+            }
+        }};
+    }
+
+    size_t parkedCount() const
+    {
+        return parked.size();
+    }
+
+  private:
+    void put(std::unique_ptr<T> obj)
+    {
+        if (parked.size() >= capacity)
+        {
+            return;
+        }
+        obj->park();
+        parked.emplace_back(std::move(obj));
+    }
+
+    size_t capacity;
+    std::vector<std::unique_ptr<T>> parked;
+};
+
+} // namespace crow
@@ -0,0 +1,234 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/sendfile.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <boost/asio/buffer.hpp>
+#include <boost/beast/http/error.hpp>
+#include <boost/beast/http/message.hpp>
+#include <boost/optional.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <filesystem>
+#include <utility>
+
+namespace crow
+{
+
+/**
+ * @brief An open file, or a window into one, to send as a response body.
+ *
+ * Unlike beast's file_body this can start part way into the file, which byte
+ * range responses need, and can take over a descriptor handed back by a
+ * D-Bus call.  Nothing is read until the response is written, and then only
+ * one buffer's worth at a time.
+ */
+class BodyFile
+{
+  public:
+    BodyFile() = default;
+
+    ~BodyFile()
+    {
+        close();
+    }
+
+    BodyFile(const BodyFile&) = delete;
+    BodyFile& operator=(const BodyFile&) = delete;
+
+    BodyFile(BodyFile&& other) noexcept :
+        fd(std::exchange(other.fd, -1)), fileSize(other.fileSize),
+        offset(other.offset), length(other.length)
+    {}
+
+    BodyFile& operator=(BodyFile&& other) noexcept
+    {
+        if (this != &other)
+        {
+            close();
+            fd = std::exchange(other.fd, -1);
+            fileSize = other.fileSize;
+            offset = other.offset;
+            length = other.length;
+        }
+        return *this;
+    }
+
+    void open(const std::filesystem::path& path, boost::system::error_code& ec)
+    {
+        int newFd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (newFd < 0)
+        {
+            ec.assign(errno, boost::system::system_category());
+            return;
+        }
+        adopt(newFd, ec);
+    }
+
+    // Takes ownership of fdIn, which is read with pread() so its file
+    // position doesn't matter
+    void adopt(int fdIn, boost::system::error_code& ec)
+    {
+        close();
+        fd = fdIn;
+        struct stat st
+        {};
+        if (fstat(fd, &st) != 0)
+        {
+            ec.assign(errno, boost::system::system_category());
+            close();
+            return;
+        }
+        fileSize = static_cast<uint64_t>(st.st_size);
+        offset = 0;
+        length = fileSize;
+        ec = {};
+    }
+
+    // Sends only the lengthIn bytes starting at offsetIn, clamped to the file
+    void setRange(uint64_t offsetIn, uint64_t lengthIn)
+    {
+        offset = std::min(offsetIn, fileSize);
+        length = std::min(lengthIn, fileSize - offset);
+    }
+
+    bool isOpen() const
+    {
+        return fd >= 0;
+    }
+
+    // Bytes that will be sent
+    uint64_t size() const
+    {
+        return length;
+    }
+
+    uint64_t getFileSize() const
+    {
+        return fileSize;
+    }
+
+    // Reads from pos bytes into the window
+    ssize_t read(uint64_t pos, char* out, size_t count) const
+    {
+        while (true)
+        {
+            ssize_t got =
+                ::pread(fd, out, count, static_cast<off_t>(offset + pos));
+            if (got >= 0 || errno != EINTR)
+            {
+                return got;
+            }
+        }
+    }
+
+    // Copies up to count bytes from pos bytes into the window straight to
+    // socket, in the kernel, stopping at the end of the window.  socket must
+    // not be encrypted in user space.
+    ssize_t sendTo(int socket, uint64_t pos, size_t count) const
+    {
+        if (pos >= length)
+        {
+            return 0;
+        }
+        count = static_cast<size_t>(std::min<uint64_t>(count, length - pos));
+        off_t fileOffset = static_cast<off_t>(offset + pos);
+        while (true)
+        {
+            ssize_t sent = ::sendfile(socket, fd, &fileOffset, count);
+            if (sent >= 0 || errno != EINTR)
+            {
+                return sent;
+            }
+        }
+    }
+
+    void close()
+    {
+        if (fd >= 0)
+        {
+            ::close(fd);
+            fd = -1;
+        }
+        fileSize = 0;
+        offset = 0;
+        length = 0;
+    }
+
+  private:
+    int fd = -1;
+    uint64_t fileSize = 0;
+    uint64_t offset = 0;
+    uint64_t length = 0;
+};
+
+// Beast body type that writes a BodyFile to the socket as it drains
+struct FileBody
+{
+    using value_type = BodyFile;
+
+    static std::uint64_t size(const value_type& body)
+    {
+        return body.size();
+    }
+
+    class writer
+    {
+      public:
+        using const_buffers_type = boost::asio::const_buffer;
+
+        template <bool isRequest, class Fields>
+        writer(boost::beast::http::header<isRequest, Fields>& /*header*/,
+               const value_type& bodyIn) :
+            body(bodyIn)
+        {}
+
+        void init(boost::system::error_code& ec)
+        {
+            ec = {};
+        }
+
+        boost::optional<std::pair<const_buffers_type, bool>>
+            get(boost::system::error_code& ec)
+        {
+            uint64_t remaining = body.size() - sent;
+            if (remaining == 0)
+            {
+                ec = {};
+                return boost::none;
+            }
+            size_t count = static_cast<size_t>(
+                std::min<uint64_t>(buffer.size(), remaining));
+            ssize_t got = body.read(sent, buffer.data(), count);
+            if (got < 0)
+            {
+                ec.assign(errno, boost::system::system_category());
+                return boost::none;
+            }
+            if (got == 0)
+            {
+                // The file shrank after Content-Length was sent
+                ec = boost::beast::http::error::short_read;
+                return boost::none;
+            }
+            sent += static_cast<uint64_t>(got);
+            ec = {};
+            return {{const_buffers_type(buffer.data(),
+                                        static_cast<size_t>(got)),
+                     sent < body.size()}};
+        }
+
+      private:
+        const value_type& body;
+        uint64_t sent = 0;
+        std::array<char, 16384> buffer{};
+    };
+};
+
+} // namespace crow
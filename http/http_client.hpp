@@ -20,12 +20,15 @@
 
 #include <boost/asio/connect.hpp>
 #include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/asio/ip/address.hpp>
 #include <boost/asio/ip/basic_endpoint.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/ssl/context.hpp>
 #include <boost/asio/ssl/error.hpp>
 #include <boost/asio/steady_timer.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/beast/core/error.hpp>
 #include <boost/beast/core/flat_buffer.hpp>
 #include <boost/beast/core/flat_static_buffer.hpp>
 #include <boost/beast/http/message.hpp>
@@ -36,18 +39,25 @@
 #include <boost/beast/ssl/ssl_stream.hpp>
 #include <boost/beast/version.hpp>
 #include <boost/container/devector.hpp>
+#include <boost/optional/optional.hpp>
 #include <boost/system/error_code.hpp>
 #include <boost/url/format.hpp>
 #include <boost/url/url_view.hpp>
 #include <logging.hpp>
 #include <ssl_key_handler.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <functional>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <queue>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 namespace crow
 {
 
@@ -112,14 +122,240 @@ struct ConnectionPolicy
     std::chrono::seconds retryIntervalSecs = std::chrono::seconds(0);
     std::function<boost::system::error_code(unsigned int respCode)>
         invalidResp = defaultRetryHandler;
+
+    // How long a keep-alive connection may sit idle before it's closed.  0
+    // leaves idle connections open until the server closes them.
+    std::chrono::seconds idleTimeoutSecs = std::chrono::seconds(60);
+
+    // How many requests may be written to a keep-alive connection before the
+    // first response is read.  1 disables pipelining.  Only raise this for
+    // servers known to handle pipelined requests; if the connection fails
+    // part way through, every request that wasn't answered is sent again.
+    size_t pipelineDepth = 1;
+
+    // How long resolved addresses are reused for new connections.  0
+    // resolves on every connect.
+    std::chrono::seconds resolveCacheSecs = std::chrono::seconds(60);
+
+    // How long a failed resolve is reused before the host is looked up
+    // again.  Only applies when resolveCacheSecs is non-zero.
+    std::chrono::seconds resolveFailureCacheSecs = std::chrono::seconds(5);
+};
+
+// Counters for one destination, or summed over all of them by
+// HttpClient::getStats()
+struct ConnectionPoolStats
+{
+    // Requests written, and how many of those went out on a connection that
+    // had already carried a request
+    uint64_t requestsSent = 0;
+    uint64_t requestsReused = 0;
+    uint64_t requestsDropped = 0;
+
+    // Completed connects, and the total time spent resolving, connecting and
+    // handshaking for them
+    uint64_t connects = 0;
+    std::chrono::steady_clock::duration connectTime{};
+
+    size_t queueDepth = 0;
+    size_t maxQueueDepth = 0;
+
+    double reuseRatio() const
+    {
+        if (requestsSent == 0)
+        {
+            return 0.0;
+        }
+        return static_cast<double>(requestsReused) /
+               static_cast<double>(requestsSent);
+    }
+
+    std::chrono::milliseconds averageConnectLatency() const
+    {
+        if (connects == 0)
+        {
+            return std::chrono::milliseconds(0);
+        }
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            connectTime / connects);
+    }
+
+    void add(const ConnectionPoolStats& other)
+    {
+        requestsSent += other.requestsSent;
+        requestsReused += other.requestsReused;
+        requestsDropped += other.requestsDropped;
+        connects += other.connects;
+        connectTime += other.connectTime;
+        queueDepth += other.queueDepth;
+        maxQueueDepth = std::max(maxQueueDepth, other.maxQueueDepth);
+    }
+};
+
+/**
+ * @brief Addresses resolved for each host and port, shared by every
+ * ConnectionPool, so new connections to a destination don't each wait on a
+ * ResolveHostname call.  Failed lookups are remembered too, for a shorter
+ * time, and connections that need the same host while a lookup is in flight
+ * wait for that lookup rather than starting their own.  An entry is dropped
+ * when it expires or when connecting to it fails.
+ */
+class ResolveCache
+{
+  public:
+    using Callback =
+        std::function<void(const boost::system::error_code&,
+                           const std::vector<boost::asio::ip::tcp::endpoint>&)>;
+
+    static ResolveCache& getInstance()
+    {
+        static ResolveCache cache;
+        return cache;
+    }
+
+    bool find(const std::string& host, uint16_t port,
+              boost::system::error_code& ec,
+              std::vector<boost::asio::ip::tcp::endpoint>& endpoints) const
+    {
+        auto it = entries.find(makeKey(host, port));
+        if (it == entries.end() ||
+            it->second.expires <= std::chrono::steady_clock::now())
+        {
+            return false;
+        }
+        ec = it->second.ec;
+        endpoints = it->second.endpoints;
+        return true;
+    }
+
+    /**
+     * @brief Queues callback for the result of the lookup of host and port.
+     * Returns true if no lookup was in flight, in which case the caller
+     * must start one and pass its result to complete().
+     */
+    bool wait(const std::string& host, uint16_t port, Callback&& callback)
+    {
+        std::vector<Callback>& waiting = pending[makeKey(host, port)];
+        waiting.emplace_back(std::move(callback));
+        return waiting.size() == 1;
+    }
+
+    void complete(const std::string& host, uint16_t port,
+                  const boost::system::error_code& ec,
+                  const std::vector<boost::asio::ip::tcp::endpoint>& endpoints,
+                  std::chrono::seconds ttl, std::chrono::seconds failureTtl)
+    {
+        std::string key = makeKey(host, port);
+        if (ec || endpoints.empty())
+        {
+            if (ttl.count() > 0 && failureTtl.count() > 0)
+            {
+                insert(key, {ec, {}, {}}, failureTtl);
+            }
+        }
+        else if (ttl.count() > 0)
+        {
+            insert(key, {ec, endpoints, {}}, ttl);
+        }
+
+        auto it = pending.find(key);
+        if (it == pending.end())
+        {
+            return;
+        }
+        std::vector<Callback> waiting = std::move(it->second);
+        pending.erase(it);
+        for (Callback& callback : waiting)
+        {
+            callback(ec, endpoints);
+        }
+    }
+
+    void erase(const std::string& host, uint16_t port)
+    {
+        entries.erase(makeKey(host, port));
+    }
+
+  private:
+    struct Entry
+    {
+        boost::system::error_code ec;
+        std::vector<boost::asio::ip::tcp::endpoint> endpoints;
+        std::chrono::steady_clock::time_point expires;
+    };
+
+    static std::string makeKey(const std::string& host, uint16_t port)
+    {
+        return host + ":" + std::to_string(port);
+    }
+
+    void insert(const std::string& key, Entry&& entry, std::chrono::seconds ttl)
+    {
+        std::chrono::steady_clock::time_point now =
+            std::chrono::steady_clock::now();
+        std::erase_if(entries, [now](const auto& e) {
+            return e.second.expires <= now;
+        });
+        entry.expires = now + ttl;
+        entries[key] = std::move(entry);
+    }
+
+    std::unordered_map<std::string, Entry> entries;
+    std::unordered_map<std::string, std::vector<Callback>> pending;
+};
+
+/**
+ * @brief Beast body holding a shared, immutable string, so a payload sent to
+ * many destinations is queued and written without a copy per request.
+ */
+struct SharedStringBody
+{
+    using value_type = std::shared_ptr<const std::string>;
+
+    static std::uint64_t size(const value_type& body)
+    {
+        return body == nullptr ? 0 : body->size();
+    }
+
+    class writer
+    {
+      public:
+        using const_buffers_type = boost::asio::const_buffer;
+
+        template <bool isRequest, class Fields>
+        writer(const boost::beast::http::header<isRequest, Fields>& /*h*/,
+               const value_type& bodyIn) :
+            body(bodyIn)
+        {}
+
+        static void init(boost::beast::error_code& ec)
+        {
+            ec = {};
+        }
+
+        boost::optional<std::pair<const_buffers_type, bool>>
+            get(boost::beast::error_code& ec)
+        {
+            ec = {};
+            if (body == nullptr || body->empty())
+            {
+                return boost::none;
+            }
+            return {{boost::asio::const_buffer(body->data(), body->size()),
+                     false}};
+        }
+
+      private:
+        const value_type& body;
+    };
 };
 
 struct PendingRequest
 {
-    boost::beast::http::request<boost::beast::http::string_body> req;
+    boost::beast::http::request<SharedStringBody> req;
     std::function<void(bool, uint32_t, Response&)> callback;
     PendingRequest(
-        boost::beast::http::request<boost::beast::http::string_body>&& reqIn,
+        boost::beast::http::request<SharedStringBody>&& reqIn,
         const std::function<void(bool, uint32_t, Response&)>& callbackIn) :
         req(std::move(reqIn)),
         callback(callbackIn)
@@ -133,12 +369,21 @@ class ConnectionInfo : public std::enable_shared_from_this<ConnectionInfo>
     uint32_t retryCount = 0;
     std::string subId;
     std::shared_ptr<ConnectionPolicy> connPolicy;
+    std::shared_ptr<ConnectionPoolStats> stats;
     std::string host;
     uint16_t port;
     uint32_t connId;
+    std::chrono::steady_clock::time_point connectStart;
+    uint64_t requestsOnConnection = 0;
+    // The server has answered on this connection and said it stays open
+    bool keepAliveConfirmed = false;
 
     // Data buffers
-    boost::beast::http::request<boost::beast::http::string_body> req;
+    boost::beast::http::request<SharedStringBody> req;
+    // Requests written behind req that are still waiting on a response, in
+    // the order they were sent
+    boost::container::devector<PendingRequest> pipeline;
+    size_t pipelineWritten = 0;
     std::optional<
         boost::beast::http::response_parser<boost::beast::http::string_body>>
         parser;
@@ -160,13 +405,49 @@ class ConnectionInfo : public std::enable_shared_from_this<ConnectionInfo>
     void doResolve()
     {
         state = ConnState::resolveInProgress;
+        connectStart = std::chrono::steady_clock::now();
+
+        ResolveCache& cache = ResolveCache::getInstance();
+        boost::system::error_code ec;
+        std::vector<boost::asio::ip::tcp::endpoint> endpointList;
+        if (connPolicy->resolveCacheSecs.count() > 0 &&
+            cache.find(host, port, ec, endpointList))
+        {
+            BMCWEB_LOG_DEBUG << "Using cached address for: " << host << ":"
+                             << std::to_string(port)
+                             << ", id: " << std::to_string(connId);
+            boost::asio::post(ioc, [self(shared_from_this()), ec,
+                                    endpoints{std::move(endpointList)}]() {
+                self->afterResolve(self, ec, endpoints);
+            });
+            return;
+        }
+
+        if (!cache.wait(host, port,
+                        std::bind_front(&ConnectionInfo::afterResolve, this,
+                                        shared_from_this())))
+        {
+            BMCWEB_LOG_DEBUG << "Waiting on resolve in flight for: " << host
+                             << ":" << std::to_string(port)
+                             << ", id: " << std::to_string(connId);
+            return;
+        }
+
         BMCWEB_LOG_DEBUG << "Trying to resolve: " << host << ":"
                          << std::to_string(port)
                          << ", id: " << std::to_string(connId);
 
-        resolver.asyncResolve(host, port,
-                              std::bind_front(&ConnectionInfo::afterResolve,
-                                              this, shared_from_this()));
+        // The cache owns the result, so it doesn't matter if this
+        // connection is gone by the time it arrives
+        resolver.asyncResolve(
+            host, port,
+            [host{host}, port{port}, ttl{connPolicy->resolveCacheSecs},
+             failureTtl{connPolicy->resolveFailureCacheSecs}](
+                const boost::system::error_code& resolveEc,
+                const std::vector<boost::asio::ip::tcp::endpoint>& endpoints) {
+            ResolveCache::getInstance().complete(host, port, resolveEc,
+                                                 endpoints, ttl, failureTtl);
+        });
     }
 
     void afterResolve(
@@ -217,6 +498,8 @@ class ConnectionInfo : public std::enable_shared_from_this<ConnectionInfo>
                              << " : " << std::to_string(endpoint.port())
                              << ", id: " << std::to_string(connId)
                              << " failed: " << ec.message();
+            // The address may have changed, so look it up again on retry
+            ResolveCache::getInstance().erase(host, port);
             state = ConnState::connectFailed;
             waitAndRetry();
             return;
@@ -229,8 +512,7 @@ class ConnectionInfo : public std::enable_shared_from_this<ConnectionInfo>
             doSslHandshake();
             return;
         }
-        state = ConnState::connected;
-        sendMessage();
+        onConnected();
     }
 
     void doSslHandshake()
@@ -270,14 +552,55 @@ class ConnectionInfo : public std::enable_shared_from_this<ConnectionInfo>
         }
         BMCWEB_LOG_DEBUG << "SSL Handshake successful -"
                          << " id: " << std::to_string(connId);
+        onConnected();
+    }
+
+    void onConnected()
+    {
         state = ConnState::connected;
+        stats->connects++;
+        stats->connectTime += std::chrono::steady_clock::now() - connectStart;
+        requestsOnConnection = 0;
+        keepAliveConfirmed = false;
         sendMessage();
     }
 
+    // Whether a request can be written right behind the ones this connection
+    // is writing now, so a burst of requests to one server shares a single
+    // connection instead of each waiting on a connect.  Only done once the
+    // server has shown it keeps the connection open.
+    bool canPipeline() const
+    {
+        return state == ConnState::sendInProgress && keepAliveConfirmed &&
+               pipeline.size() + 1 < connPolicy->pipelineDepth;
+    }
+
+    void addToPipeline(PendingRequest&& pending)
+    {
+        pipeline.emplace_back(std::move(pending));
+        stats->requestsSent++;
+        stats->requestsReused++;
+        requestsOnConnection++;
+    }
+
     void sendMessage()
     {
         state = ConnState::sendInProgress;
 
+        // Everything after the first request on a connection reuses it
+        uint64_t count = 1 + pipeline.size();
+        stats->requestsSent += count;
+        stats->requestsReused += (requestsOnConnection > 0) ? count
+                                                            : count - 1;
+        requestsOnConnection += count;
+
+        pipelineWritten = 0;
+        writeRequest(req);
+    }
+
+    void writeRequest(
+        boost::beast::http::request<SharedStringBody>& msg)
+    {
         // Set a timeout on the operation
         timer.expires_after(std::chrono::seconds(30));
         timer.async_wait(std::bind_front(onTimeout, weak_from_this()));
@@ -286,14 +609,14 @@ class ConnectionInfo : public std::enable_shared_from_this<ConnectionInfo>
         if (sslConn)
         {
             boost::beast::http::async_write(
-                *sslConn, req,
+                *sslConn, msg,
                 std::bind_front(&ConnectionInfo::afterWrite, this,
                                 shared_from_this()));
         }
         else
         {
             boost::beast::http::async_write(
-                conn, req,
+                conn, msg,
                 std::bind_front(&ConnectionInfo::afterWrite, this,
                                 shared_from_this()));
         }
@@ -321,6 +644,13 @@ class ConnectionInfo : public std::enable_shared_from_this<ConnectionInfo>
         BMCWEB_LOG_DEBUG << "sendMessage() bytes transferred: "
                          << bytesTransferred;
 
+        // Write any pipelined requests before waiting on the first response
+        if (pipelineWritten < pipeline.size())
+        {
+            writeRequest(pipeline[pipelineWritten++].req);
+            return;
+        }
+
         recvMessage();
     }
 
@@ -414,16 +744,61 @@ class ConnectionInfo : public std::enable_shared_from_this<ConnectionInfo>
 
         // Keep the connection alive if server supports it
         // Else close the connection
-        BMCWEB_LOG_DEBUG << "recvMessage() keepalive : "
-                         << parser->keep_alive();
+        bool keepAlive = parser->keep_alive();
+        BMCWEB_LOG_DEBUG << "recvMessage() keepalive : " << keepAlive;
+        keepAliveConfirmed = keepAlive;
 
         // Copy the response into a Response object so that it can be
         // processed by the callback function.
         res.stringResponse = parser->release();
-        callback(parser->keep_alive(), connId, res);
+        if (keepAlive && !pipeline.empty())
+        {
+            // Responses to the requests pipelined behind this one are still
+            // coming, so keep reading instead of handing back the connection
+            std::function<void(bool, uint32_t, Response&)> done =
+                std::move(callback);
+            req = std::move(pipeline.front().req);
+            callback = std::move(pipeline.front().callback);
+            pipeline.pop_front();
+            recvMessage();
+            done(keepAlive, connId, res);
+            res.clear();
+            return;
+        }
+        callback(keepAlive, connId, res);
         res.clear();
     }
 
+    void startIdleTimer()
+    {
+        if (connPolicy->idleTimeoutSecs.count() == 0)
+        {
+            return;
+        }
+        timer.expires_after(connPolicy->idleTimeoutSecs);
+        timer.async_wait(std::bind_front(onIdleTimeout, weak_from_this()));
+    }
+
+    static void onIdleTimeout(const std::weak_ptr<ConnectionInfo>& weakSelf,
+                              const boost::system::error_code& ec)
+    {
+        if (ec == boost::asio::error::operation_aborted)
+        {
+            // The connection was picked up for another request
+            return;
+        }
+        std::shared_ptr<ConnectionInfo> self = weakSelf.lock();
+        if (self == nullptr || self->state != ConnState::idle)
+        {
+            return;
+        }
+        BMCWEB_LOG_DEBUG << self->host << ":" << std::to_string(self->port)
+                         << ", id: " << std::to_string(self->connId)
+                         << " closing idle connection";
+        self->state = ConnState::abortConnection;
+        self->doClose();
+    }
+
     static void onTimeout(const std::weak_ptr<ConnectionInfo>& weakSelf,
                           const boost::system::error_code ec)
     {
@@ -657,11 +1032,13 @@ class ConnectionInfo : public std::enable_shared_from_this<ConnectionInfo>
     explicit ConnectionInfo(
         boost::asio::io_context& iocIn, const std::string& idIn,
         const std::shared_ptr<ConnectionPolicy>& connPolicyIn,
+        const std::shared_ptr<ConnectionPoolStats>& statsIn,
         const std::string& destIPIn, uint16_t destPortIn, bool useSSL,
         unsigned int connIdIn) :
         subId(idIn),
-        connPolicy(connPolicyIn), host(destIPIn), port(destPortIn),
-        connId(connIdIn), ioc(iocIn), conn(iocIn), timer(iocIn)
+        connPolicy(connPolicyIn), stats(statsIn), host(destIPIn),
+        port(destPortIn), connId(connIdIn), ioc(iocIn), conn(iocIn),
+        timer(iocIn)
     {
         initializeConnection(useSSL);
     }
@@ -678,6 +1055,8 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool>
     bool useSSL;
     std::vector<std::shared_ptr<ConnectionInfo>> connections;
     boost::container::devector<PendingRequest> requestQueue;
+    std::shared_ptr<ConnectionPoolStats> stats =
+        std::make_shared<ConnectionPoolStats>();
 
     friend class HttpClient;
 
@@ -704,6 +1083,19 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool>
         requestQueue.pop_front();
     }
 
+    // Moves queued requests onto a keep-alive connection that is about to
+    // send, up to the pipeline depth, so they're written without waiting on
+    // the response to the first one
+    void fillPipeline(ConnectionInfo& conn)
+    {
+        while (conn.pipeline.size() + 1 < connPolicy->pipelineDepth &&
+               !requestQueue.empty())
+        {
+            conn.pipeline.emplace_back(std::move(requestQueue.front()));
+            requestQueue.pop_front();
+        }
+    }
+
     // Gets called as part of callback after request is sent
     // Reuses the connection if there are any requests waiting to be sent
     // Otherwise closes the connection if it is not a keep-alive
@@ -711,11 +1103,29 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool>
     {
         auto conn = connections[connId];
 
+        // The connection is still reading responses to requests that were
+        // pipelined behind this one
+        if (conn->state == ConnState::recvInProgress)
+        {
+            return;
+        }
+
         // Allow the connection's handler to be deleted
         // This is needed because of Redfish Aggregation passing an
         // AsyncResponse shared_ptr to this callback
         conn->callback = nullptr;
 
+        // Pipelined requests won't be answered once the connection is
+        // closing, so put them back at the front of the queue in order
+        if (!keepAlive)
+        {
+            while (!conn->pipeline.empty())
+            {
+                requestQueue.emplace_front(std::move(conn->pipeline.back()));
+                conn->pipeline.pop_back();
+            }
+        }
+
         // Reuse the connection to send the next request in the queue
         if (!requestQueue.empty())
         {
@@ -729,6 +1139,7 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool>
 
             if (keepAlive)
             {
+                fillPipeline(*conn);
                 conn->sendMessage();
             }
             else
@@ -741,10 +1152,17 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool>
             return;
         }
 
+        BMCWEB_LOG_DEBUG << destIP << ":" << std::to_string(destPort)
+                         << " requests sent: " << stats->requestsSent
+                         << ", reuse ratio: " << stats->reuseRatio()
+                         << ", average connect latency: "
+                         << stats->averageConnectLatency().count() << "ms";
+
         // No more messages to send so close the connection if necessary
         if (keepAlive)
         {
             conn->state = ConnState::idle;
+            conn->startIdleTimer();
         }
         else
         {
@@ -754,17 +1172,18 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool>
         }
     }
 
-    void sendData(std::string& data, const std::string& destUri,
+    void sendData(const std::shared_ptr<const std::string>& data,
+                  const std::string& destUri,
                   const boost::beast::http::fields& httpHeader,
                   const boost::beast::http::verb verb,
                   const std::function<void(Response&)>& resHandler)
     {
         // Construct the request to be sent
-        boost::beast::http::request<boost::beast::http::string_body> thisReq(
+        boost::beast::http::request<SharedStringBody> thisReq(
             verb, destUri, 11, "", httpHeader);
         thisReq.set(boost::beast::http::field::host, destIP);
         thisReq.keep_alive(true);
-        thisReq.body() = std::move(data);
+        thisReq.body() = data;
         thisReq.prepare_payload();
         auto cb = std::bind_front(&ConnectionPool::afterSendData,
                                   weak_from_this(), resHandler);
@@ -795,6 +1214,28 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool>
             }
         }
 
+        // Prefer writing behind a request already going out on a keep-alive
+        // connection to paying for another connect.  Only reads are, since
+        // a failure part way through resends everything unanswered.
+        if (connPolicy->pipelineDepth > 1 &&
+            (verb == boost::beast::http::verb::get ||
+             verb == boost::beast::http::verb::head))
+        {
+            for (const std::shared_ptr<ConnectionInfo>& conn : connections)
+            {
+                if (conn->canPipeline())
+                {
+                    conn->addToPipeline(
+                        PendingRequest(std::move(thisReq), std::move(cb)));
+                    BMCWEB_LOG_DEBUG << "Pipelined request on connection "
+                                     << std::to_string(conn->connId)
+                                     << " to " << destIP << ":"
+                                     << std::to_string(destPort);
+                    return;
+                }
+            }
+        }
+
         // All connections in use so create a new connection or add request to
         // the queue
         if (connections.size() < connPolicy->maxConnections)
@@ -811,6 +1252,8 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool>
             BMCWEB_LOG_DEBUG << "Max pool size reached. Adding data to queue."
                              << destIP << ":" << std::to_string(destPort);
             requestQueue.emplace_back(std::move(thisReq), std::move(cb));
+            stats->maxQueueDepth = std::max(stats->maxQueueDepth,
+                                            requestQueue.size());
         }
         else
         {
@@ -818,6 +1261,7 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool>
             // handle a 429 Too Many Requests dummy response
             BMCWEB_LOG_ERROR << destIP << ": " << std::to_string(destPort)
                              << " request queue full.  Dropping request.";
+            stats->requestsDropped++;
             Response dummyRes;
             dummyRes.result(boost::beast::http::status::too_many_requests);
             resHandler(dummyRes);
@@ -850,7 +1294,7 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool>
         unsigned int newId = static_cast<unsigned int>(connections.size());
 
         auto& ret = connections.emplace_back(std::make_shared<ConnectionInfo>(
-            ioc, id, connPolicy, destIP, destPort, useSSL, newId));
+            ioc, id, connPolicy, stats, destIP, destPort, useSSL, newId));
 
         BMCWEB_LOG_DEBUG << "Added connection "
                          << std::to_string(connections.size() - 1)
@@ -875,6 +1319,72 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool>
         // Initialize the pool with a single connection
         addConnection();
     }
+
+    ConnectionPoolStats getStats() const
+    {
+        ConnectionPoolStats ret = *stats;
+        ret.queueDepth = requestQueue.size();
+        return ret;
+    }
+};
+
+/**
+ * @brief The connection pools of every HttpClient that shares them, by
+ * destination and policy.
+ *
+ * Clients sending to the same host and port under the same ConnectionPolicy
+ * object get the same pool, so they share its connections, TLS sessions,
+ * queue and retry timers instead of each keeping their own.  A policy is
+ * only shared by clients meant to retry alike, so every request is still
+ * retried the way its sender asked.  Pools are held by the clients using
+ * them and dropped from here once the last of those is gone.
+ */
+class SharedConnectionPools
+{
+  public:
+    static SharedConnectionPools& getInstance()
+    {
+        static SharedConnectionPools pools;
+        return pools;
+    }
+
+    SharedConnectionPools(const SharedConnectionPools&) = delete;
+    SharedConnectionPools(SharedConnectionPools&&) = delete;
+    SharedConnectionPools& operator=(const SharedConnectionPools&) = delete;
+    SharedConnectionPools& operator=(SharedConnectionPools&&) = delete;
+    ~SharedConnectionPools() = default;
+
+    std::shared_ptr<ConnectionPool>
+        get(boost::asio::io_context& ioc, const std::string& clientKey,
+            const std::shared_ptr<ConnectionPolicy>& connPolicy,
+            const std::string& destIP, uint16_t destPort, bool useSSL)
+    {
+        std::erase_if(pools, [](const auto& entry) {
+            return entry.second.expired();
+        });
+        std::weak_ptr<ConnectionPool>& weakPool =
+            pools[std::make_pair(clientKey, connPolicy.get())];
+        std::shared_ptr<ConnectionPool> pool = weakPool.lock();
+        if (pool == nullptr)
+        {
+            pool = std::make_shared<ConnectionPool>(ioc, clientKey, connPolicy,
+                                                    destIP, destPort, useSSL);
+            weakPool = pool;
+        }
+        return pool;
+    }
+
+    size_t size() const
+    {
+        return pools.size();
+    }
+
+  private:
+    SharedConnectionPools() = default;
+
+    std::map<std::pair<std::string, const ConnectionPolicy*>,
+             std::weak_ptr<ConnectionPool>>
+        pools;
 };
 
 class HttpClient
@@ -885,6 +1395,8 @@ class HttpClient
     boost::asio::io_context& ioc =
         crow::connections::systemBus->get_io_context();
     std::shared_ptr<ConnectionPolicy> connPolicy;
+    // Whether pools come from SharedConnectionPools
+    bool sharePools = false;
 
     // Used as a dummy callback by sendData() in order to call
     // sendDataWithCallback()
@@ -899,6 +1411,13 @@ class HttpClient
     explicit HttpClient(const std::shared_ptr<ConnectionPolicy>& connPolicyIn) :
         connPolicy(connPolicyIn)
     {}
+    // With sharePoolsIn, sends over the same connections as every other
+    // sharing client with this connPolicyIn; see SharedConnectionPools
+    HttpClient(const std::shared_ptr<ConnectionPolicy>& connPolicyIn,
+               bool sharePoolsIn) :
+        connPolicy(connPolicyIn),
+        sharePools(sharePoolsIn)
+    {}
     HttpClient(const HttpClient&) = delete;
     HttpClient& operator=(const HttpClient&) = delete;
     HttpClient(HttpClient&&) = delete;
@@ -911,6 +1430,17 @@ class HttpClient
                   uint16_t destPort, const std::string& destUri, bool useSSL,
                   const boost::beast::http::fields& httpHeader,
                   const boost::beast::http::verb verb)
+    {
+        sendData(std::make_shared<const std::string>(std::move(data)), destIP,
+                 destPort, destUri, useSSL, httpHeader, verb);
+    }
+
+    // Same as above, for a body that may be shared with other requests
+    void sendData(const std::shared_ptr<const std::string>& data,
+                  const std::string& destIP, uint16_t destPort,
+                  const std::string& destUri, bool useSSL,
+                  const boost::beast::http::fields& httpHeader,
+                  const boost::beast::http::verb verb)
     {
         const std::function<void(Response&)> cb = genericResHandler;
         sendDataWithCallback(data, destIP, destPort, destUri, useSSL,
@@ -925,6 +1455,20 @@ class HttpClient
                               const boost::beast::http::fields& httpHeader,
                               const boost::beast::http::verb verb,
                               const std::function<void(Response&)>& resHandler)
+    {
+        sendDataWithCallback(
+            std::make_shared<const std::string>(std::move(data)), destIP,
+            destPort, destUri, useSSL, httpHeader, verb, resHandler);
+    }
+
+    // Same as above, for a body that may be shared with other requests
+    void sendDataWithCallback(const std::shared_ptr<const std::string>& data,
+                              const std::string& destIP,
+                              uint16_t destPort, const std::string& destUri,
+                              bool useSSL,
+                              const boost::beast::http::fields& httpHeader,
+                              const boost::beast::http::verb verb,
+                              const std::function<void(Response&)>& resHandler)
     {
         std::string clientKey = useSSL ? "https" : "http";
         clientKey += destIP;
@@ -933,13 +1477,32 @@ class HttpClient
         auto pool = connectionPools.try_emplace(clientKey);
         if (pool.first->second == nullptr)
         {
-            pool.first->second = std::make_shared<ConnectionPool>(
-                ioc, clientKey, connPolicy, destIP, destPort, useSSL);
+            if (sharePools)
+            {
+                pool.first->second = SharedConnectionPools::getInstance().get(
+                    ioc, clientKey, connPolicy, destIP, destPort, useSSL);
+            }
+            else
+            {
+                pool.first->second = std::make_shared<ConnectionPool>(
+                    ioc, clientKey, connPolicy, destIP, destPort, useSSL);
+            }
         }
         // Send the data using either the existing connection pool or the newly
         // created connection pool
         pool.first->second->sendData(data, destUri, httpHeader, verb,
                                      resHandler);
     }
+
+    // Counters summed over every destination this client has sent to
+    ConnectionPoolStats getStats() const
+    {
+        ConnectionPoolStats ret;
+        for (const auto& pool : connectionPools)
+        {
+            ret.add(pool.second->getStats());
+        }
+        return ret;
+    }
 };
 } // namespace crow
@@ -0,0 +1,226 @@
+#pragma once
+
+#include "logging.hpp"
+
+#include <zlib.h>
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace crow
+{
+namespace compression
+{
+
+enum class Encoding
+{
+    Identity,
+    Gzip,
+    Deflate,
+};
+
+// Bodies smaller than this are sent as-is; the framing overhead and cpu time
+// aren't worth it.
+constexpr size_t minCompressSize = 1024;
+
+inline std::string_view encodingName(Encoding encoding)
+{
+    switch (encoding)
+    {
+        case Encoding::Gzip:
+            return "gzip";
+        case Encoding::Deflate:
+            return "deflate";
+        case Encoding::Identity:
+            break;
+    }
+    return "identity";
+}
+
+/**
+ * @brief Picks the encoding to use given an Accept-Encoding header.  gzip is
+ * preferred over deflate when both are allowed.  Codings with q=0 are
+ * treated as refused.
+ */
+inline Encoding getPreferredEncoding(std::string_view header)
+{
+    bool gzip = false;
+    bool deflate = false;
+    while (!header.empty())
+    {
+        size_t comma = header.find(',');
+        std::string_view coding = header.substr(0, comma);
+        header = (comma == std::string_view::npos) ? std::string_view()
+                                                   : header.substr(comma + 1);
+
+        std::string_view params;
+        size_t semicolon = coding.find(';');
+        if (semicolon != std::string_view::npos)
+        {
+            params = coding.substr(semicolon + 1);
+            coding = coding.substr(0, semicolon);
+        }
+        while (!coding.empty() && coding.front() == ' ')
+        {
+            coding.remove_prefix(1);
+        }
+        while (!coding.empty() && coding.back() == ' ')
+        {
+            coding.remove_suffix(1);
+        }
+        while (!params.empty() && params.front() == ' ')
+        {
+            params.remove_prefix(1);
+        }
+        if (params.starts_with("q=0") &&
+            params.find_first_not_of("0.", 2) == std::string_view::npos)
+        {
+            continue;
+        }
+
+        if (coding == "gzip" || coding == "x-gzip" || coding == "*")
+        {
+            gzip = true;
+        }
+        else if (coding == "deflate")
+        {
+            deflate = true;
+        }
+    }
+    if (gzip)
+    {
+        return Encoding::Gzip;
+    }
+    if (deflate)
+    {
+        return Encoding::Deflate;
+    }
+    return Encoding::Identity;
+}
+
+/**
+ * @brief Compresses in with the given encoding into out.  Returns false if
+ * zlib fails, in which case out is unspecified.
+ */
+inline bool encode(std::string_view in, Encoding encoding, std::string& out)
+{
+    if (encoding == Encoding::Identity)
+    {
+        out = in;
+        return true;
+    }
+
+    z_stream strm{};
+    // 16 + MAX_WBITS asks zlib for a gzip wrapper instead of a zlib one.
+    // "deflate" as a content coding is the zlib format (RFC 9110 8.4.1.2).
+    int windowBits = (encoding == Encoding::Gzip) ? 16 + MAX_WBITS
+                                                  : MAX_WBITS;
+    if (deflateInit2(&strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, windowBits, 8,
+                     Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+        return false;
+    }
+
+    out.resize(deflateBound(&strm, static_cast<uLong>(in.size())));
+
+    // zlib doesn't take const input buffers
+    strm.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(in.data())); // NOLINT
+    strm.avail_in = static_cast<uInt>(in.size());
+    strm.next_out = reinterpret_cast<Bytef*>(out.data()); // NOLINT
+    strm.avail_out = static_cast<uInt>(out.size());
+
+    int ret = deflate(&strm, Z_FINISH);
+    out.resize(strm.total_out);
+    deflateEnd(&strm);
+    return ret == Z_STREAM_END;
+}
+
+/**
+ * @brief Holds encoded copies of responses whose content only changes when
+ * bmcweb is rebuilt, such as message registries and the schema collection.
+ *
+ * Entries are keyed on the request target, the encoding and the ETag of the
+ * rendered json, so a response that does change for any reason simply misses.
+ * The cache is bounded by total body size and drops the oldest entries first.
+ */
+class EncodedBodyCache
+{
+  public:
+    static constexpr size_t maxBytes = 1024 * 1024;
+
+    static EncodedBodyCache& getInstance()
+    {
+        static EncodedBodyCache cache;
+        return cache;
+    }
+
+    static std::string makeKey(std::string_view target, std::string_view etag,
+                               Encoding encoding)
+    {
+        std::string key(encodingName(encoding));
+        key += '|';
+        key += etag;
+        key += '|';
+        key += target;
+        return key;
+    }
+
+    std::shared_ptr<const std::string> find(const std::string& key) const
+    {
+        auto it = entries.find(key);
+        if (it == entries.end())
+        {
+            return nullptr;
+        }
+        return it->second;
+    }
+
+    void insert(const std::string& key, std::string body)
+    {
+        if (body.size() > maxBytes || entries.contains(key))
+        {
+            return;
+        }
+        while (totalBytes + body.size() > maxBytes && !order.empty())
+        {
+            auto it = entries.find(order.front());
+            if (it != entries.end())
+            {
+                totalBytes -= it->second->size();
+                entries.erase(it);
+            }
+            order.pop_front();
+        }
+        totalBytes += body.size();
+        BMCWEB_LOG_DEBUG << "Caching " << body.size() << " byte encoded body";
+        entries.emplace(key,
+                        std::make_shared<const std::string>(std::move(body)));
+        order.push_back(key);
+    }
+
+    size_t size() const
+    {
+        return entries.size();
+    }
+
+    void clear()
+    {
+        entries.clear();
+        order.clear();
+        totalBytes = 0;
+    }
+
+  private:
+    std::unordered_map<std::string, std::shared_ptr<const std::string>>
+        entries;
+    std::list<std::string> order;
+    size_t totalBytes = 0;
+};
+
+} // namespace compression
+} // namespace crow
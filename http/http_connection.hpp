@@ -1,22 +1,42 @@
 #pragma once
 #include "bmcweb_config.h"
 
+#include "admission_control.hpp"
 #include "authentication.hpp"
+#include "bulk_scheduler.hpp"
+#include "cancellation.hpp"
+#include "connection_manager.hpp"
+#include "dbus_trace.hpp"
 #ifdef BMCWEB_ENABLE_LINUX_AUDIT_EVENTS
 #include "audit_events.hpp"
 #endif
 #include "dump_utils.hpp"
+#include "file_body.hpp"
+#include "http_compression.hpp"
 #include "http_response.hpp"
 #include "http_utility.hpp"
 #include "logging.hpp"
+#include "memory_trim.hpp"
+#include "request_arena.hpp"
+#include "route_metrics.hpp"
+#include "timer_wheel.hpp"
+#include "tls_user_cache.hpp"
+#include "tracepoints.hpp"
+#ifdef BMCWEB_ENABLE_TRAFFIC_CAPTURE
+#include "traffic_capture.hpp"
+#endif
+#include "upload_body.hpp"
 #include "utility.hpp"
+#include "worker_pool.hpp"
 
-#include <boost/algorithm/string/predicate.hpp>
+#include <boost/asio/bind_cancellation_slot.hpp>
+#include <boost/asio/cancellation_signal.hpp>
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/ssl/stream.hpp>
 #include <boost/asio/steady_timer.hpp>
 #include <boost/beast/core/flat_static_buffer.hpp>
+#include <boost/beast/http/buffer_body.hpp>
 #include <boost/beast/http/error.hpp>
 #include <boost/beast/http/parser.hpp>
 #include <boost/beast/http/read.hpp>
@@ -26,11 +46,19 @@
 #include <boost/beast/websocket.hpp>
 #include <boost/url/url_view.hpp>
 #include <json_html_serializer.hpp>
+#include <json_stream_serializer.hpp>
 #include <security_headers.hpp>
 #include <ssl_key_handler.hpp>
 
+#include <sys/socket.h>
+
 #include <atomic>
+#include <cerrno>
 #include <chrono>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
 #include <vector>
 
 namespace crow
@@ -46,6 +74,13 @@ inline void prettyPrintJson(crow::Response& res)
 
 static int connectionCount = 0;
 
+// Requests read but not yet answered, across all connections
+static int inFlightRequests = 0;
+
+// Set while the server drains before exiting; connections close once their
+// current response has been written
+static bool drainingConnections = false;
+
 // request body limit size set by the bmcwebHttpReqBodyLimitMb option
 constexpr uint64_t httpReqBodyLimit = 1024UL * 1024UL *
                                       bmcwebHttpReqBodyLimitMb;
@@ -54,16 +89,22 @@ constexpr uint64_t loggedOutPostBodyLimit = 4096;
 
 constexpr uint32_t httpHeaderLimit = 8192;
 
+// json responses larger than this are sent with chunked transfer encoding;
+// it bounds the serialized bytes held per connection at any one time.
+constexpr size_t jsonStreamChunkSize = 16384;
+
 template <typename Adaptor, typename Handler>
 class Connection :
     public std::enable_shared_from_this<Connection<Adaptor, Handler>>
 {
   public:
-    Connection(Handler* handlerIn, boost::asio::steady_timer&& timerIn,
+    Connection(Handler* handlerIn, TimerWheel& timeouts,
+               ConnectionManager& connections,
                std::function<std::string()>& getCachedDateStrF,
                Adaptor adaptorIn) :
         adaptor(std::move(adaptorIn)),
-        handler(handlerIn), timer(std::move(timerIn)),
+        handler(handlerIn), timer(timeouts, [this] { onDeadline(); }),
+        managed(connections, [this] { onEvicted(); }),
         getCachedDateStr(getCachedDateStrF)
     {
         parser.emplace(std::piecewise_construct, std::make_tuple());
@@ -82,8 +123,14 @@ class Connection :
 
     ~Connection()
     {
+        if (parked)
+        {
+            return;
+        }
         res.setCompleteRequestHandler(nullptr);
         cancelDeadlineTimer();
+        managed.release();
+        endRequest();
 
         connectionCount--;
         BMCWEB_LOG_DEBUG << this << " Connection closed, total "
@@ -103,7 +150,7 @@ class Connection :
         caAvailable = caAvailable && !error;
         if (caAvailable && persistent_data::SessionStore::getInstance()
                                .getAuthMethodsConfig()
-                               .tls)
+                               ->tls)
         {
             adaptor.set_verify_mode(boost::asio::ssl::verify_peer);
             std::string id = "bmcweb";
@@ -125,7 +172,7 @@ class Connection :
             // do nothing if TLS is disabled
             if (!persistent_data::SessionStore::getInstance()
                      .getAuthMethodsConfig()
-                     .tls)
+                     ->tls)
             {
                 BMCWEB_LOG_DEBUG << this << " TLS auth_config is disabled";
                 return true;
@@ -176,99 +223,13 @@ class Connection :
             BMCWEB_LOG_DEBUG << this
                              << " Certificate verification of final depth";
 
-            // Verify KeyUsage
-            bool isKeyUsageDigitalSignature = false;
-            bool isKeyUsageKeyAgreement = false;
-
-            ASN1_BIT_STRING* usage = static_cast<ASN1_BIT_STRING*>(
-                X509_get_ext_d2i(peerCert, NID_key_usage, nullptr, nullptr));
-
-            if (usage == nullptr)
-            {
-                BMCWEB_LOG_DEBUG << this << " TLS usage is null";
-                return true;
-            }
-
-            for (int i = 0; i < usage->length; i++)
-            {
-                // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-                unsigned char usageChar = usage->data[i];
-                if (KU_DIGITAL_SIGNATURE & usageChar)
-                {
-                    isKeyUsageDigitalSignature = true;
-                }
-                if (KU_KEY_AGREEMENT & usageChar)
-                {
-                    isKeyUsageKeyAgreement = true;
-                }
-            }
-            ASN1_BIT_STRING_free(usage);
-
-            if (!isKeyUsageDigitalSignature || !isKeyUsageKeyAgreement)
-            {
-                BMCWEB_LOG_DEBUG << this
-                                 << " Certificate ExtendedKeyUsage does "
-                                    "not allow provided certificate to "
-                                    "be used for user authentication";
-                return true;
-            }
-
-            // Determine that ExtendedKeyUsage includes Client Auth
-
-            stack_st_ASN1_OBJECT* extUsage = static_cast<stack_st_ASN1_OBJECT*>(
-                X509_get_ext_d2i(peerCert, NID_ext_key_usage, nullptr,
-                                 nullptr));
-
-            if (extUsage == nullptr)
-            {
-                BMCWEB_LOG_DEBUG << this << " TLS extUsage is null";
-                return true;
-            }
-
-            bool isExKeyUsageClientAuth = false;
-            for (int i = 0; i < sk_ASN1_OBJECT_num(extUsage); i++)
-            {
-                // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
-                int nid = OBJ_obj2nid(sk_ASN1_OBJECT_value(extUsage, i));
-                if (NID_client_auth == nid)
-                {
-                    isExKeyUsageClientAuth = true;
-                    break;
-                }
-            }
-            sk_ASN1_OBJECT_free(extUsage);
-
-            // Certificate has to have proper key usages set
-            if (!isExKeyUsageClientAuth)
+            std::string sslUser =
+                crow::authentication::TlsUserCache::getInstance().getUserName(
+                    peerCert);
+            if (sslUser.empty())
             {
-                BMCWEB_LOG_DEBUG << this
-                                 << " Certificate ExtendedKeyUsage does "
-                                    "not allow provided certificate to "
-                                    "be used for user authentication";
                 return true;
             }
-            std::string sslUser;
-            // Extract username contained in CommonName
-            sslUser.resize(256, '\0');
-
-            int status = X509_NAME_get_text_by_NID(
-                X509_get_subject_name(peerCert), NID_commonName, sslUser.data(),
-                static_cast<int>(sslUser.size()));
-
-            if (status == -1)
-            {
-                BMCWEB_LOG_DEBUG
-                    << this << " TLS cannot get username to create session";
-                return true;
-            }
-
-            size_t lastChar = sslUser.find('\0');
-            if (lastChar == std::string::npos || lastChar == 0)
-            {
-                BMCWEB_LOG_DEBUG << this << " Invalid TLS user name";
-                return true;
-            }
-            sslUser.resize(lastChar);
             sessionIsFromTransport = true;
             userSession = persistent_data::SessionStore::getInstance()
                               .generateUserSession(
@@ -289,13 +250,88 @@ class Connection :
         return adaptor;
     }
 
+    // Called by the ConnectionPool once nothing references this connection
+    // any more.  Leaves it in the state of a closed connection, without
+    // giving back its buffers.
+    void park()
+    {
+        res.setCompleteRequestHandler(nullptr);
+        cancelDeadlineTimer();
+        managed.release();
+        endRequest();
+
+        // An upgraded connection handed its socket to the websocket
+        if (!upgraded)
+        {
+            boost::system::error_code ec;
+            boost::beast::get_lowest_layer(adaptor).close(ec);
+        }
+
+        serializer.reset();
+        jsonStream.reset();
+        bodyStream = nullptr;
+        asyncBodyStream = nullptr;
+        streamSerializer.reset();
+        streamResponse.reset();
+        streamChunk.clear();
+#ifdef BMCWEB_ENABLE_HTTP_COMPRESSION
+        encodedBody.reset();
+#endif
+        fileSerializer.reset();
+        fileResponse.reset();
+        admission.reset();
+        dbusTrace.reset();
+        cancellation.reset();
+        uploadParser.reset();
+        req.reset();
+        res.clear();
+        userSession = nullptr;
+        if (!arena->reset())
+        {
+            arena = std::make_shared<RequestArena>();
+        }
+        parked = true;
+
+        connectionCount--;
+        BMCWEB_LOG_DEBUG << this << " Connection parked, total "
+                         << connectionCount;
+    }
+
+    // Reuses a parked connection for a newly created socket
+    void reset(Adaptor&& adaptorIn)
+    {
+        adaptor = std::move(adaptorIn);
+        parked = false;
+        upgraded = false;
+        keepAlive = true;
+        sessionIsFromTransport = false;
+
+        parser.emplace(std::piecewise_construct, std::make_tuple());
+        parser->body_limit(httpReqBodyLimit);
+        parser->header_limit(httpHeaderLimit);
+        buffer.consume(buffer.size());
+
+#ifdef BMCWEB_ENABLE_MUTUAL_TLS_AUTHENTICATION
+        prepareMutualTls();
+#endif // BMCWEB_ENABLE_MUTUAL_TLS_AUTHENTICATION
+
+        connectionCount++;
+
+        BMCWEB_LOG_DEBUG << this << " Connection reused, total "
+                         << connectionCount;
+    }
+
     void start()
     {
-        if (connectionCount >= 200)
+        if (!managed.open())
         {
             BMCWEB_LOG_CRITICAL << this << "Max connection count exceeded.";
             return;
         }
+#ifdef BMCWEB_ENABLE_TRAFFIC_CAPTURE
+        captureConnection =
+            capture::TrafficCapture::getInstance().nextConnection();
+#endif
 
         startDeadline();
 
@@ -308,6 +344,8 @@ class Connection :
             adaptor.async_handshake(boost::asio::ssl::stream_base::server,
                                     [this, self(shared_from_this())](
                                         const boost::system::error_code& ec) {
+                BMCWEB_TRACEPOINT2(tls_handshake_done, this,
+                                   static_cast<int>(static_cast<bool>(ec)));
                 if (ec)
                 {
                     return;
@@ -323,8 +361,19 @@ class Connection :
 
     void handle()
     {
+        if (!requestInFlight)
+        {
+            requestInFlight = true;
+            inFlightRequests++;
+        }
         std::error_code reqEc;
-        crow::Request& thisReq = req.emplace(parser->release(), reqEc);
+        crow::Request& thisReq = req.emplace(releaseRequest(), reqEc);
+        if (uploadParser)
+        {
+            thisReq.upload = std::make_shared<UploadFile>(
+                std::move(uploadParser->get().body()));
+            uploadParser.reset();
+        }
         if (reqEc)
         {
             BMCWEB_LOG_DEBUG << "Request failed to construct" << reqEc;
@@ -333,6 +382,7 @@ class Connection :
             return;
         }
         thisReq.session = userSession;
+        requestStart = std::chrono::steady_clock::now();
 
         // Fetch the client IP address
         readClientIp();
@@ -377,7 +427,15 @@ class Connection :
             return;
         }
 #endif // BMCWEB_INSECURE_DISABLE_AUTHX
-        auto asyncResp = std::make_shared<bmcweb::AsyncResp>();
+        if (!admit())
+        {
+            completeRequest(res);
+            return;
+        }
+        // Drawn from the connection's arena, so keep-alive requests reuse
+        // the same space instead of going back to malloc
+        auto asyncResp = std::allocate_shared<bmcweb::AsyncResp>(
+            ArenaAllocator<bmcweb::AsyncResp>(arena));
         BMCWEB_LOG_DEBUG << "Setting completion handler";
         asyncResp->res.setCompleteRequestHandler(
             [self(shared_from_this())](crow::Response& thisRes) {
@@ -403,13 +461,16 @@ class Connection :
                     return;
                 }
             });
+            // The websocket outlives the request; don't hold its slot
+            admission.reset();
+            upgraded = true;
             handler->handleUpgrade(thisReq, asyncResp, std::move(adaptor));
             return;
         }
 
-        std::string url(req->target());
-        if (boost::contains(url, "/Dump/Entries/") &&
-            boost::ends_with(url, "/attachment"))
+        std::string_view path = req->url;
+        if (path.find("/Dump/Entries/") != std::string_view::npos &&
+            path.ends_with("/attachment"))
         {
             asyncResp->res.setCompleteRequestHandler(
                 [self(shared_from_this())](crow::Response& thisRes) {
@@ -427,12 +488,14 @@ class Connection :
             });
 
             redfish::dump_utils::getValidDumpEntryForAttachment(
-                asyncResp, url,
+                asyncResp, std::string(path),
                 [asyncResp, this, self(shared_from_this())](
                     [[maybe_unused]] const std::string& objectPath,
                     [[maybe_unused]] const std::string& entryID,
                     [[maybe_unused]] const std::string& dumpType) {
                 BMCWEB_LOG_DEBUG << "upgrade stream connection";
+                admission.reset();
+                upgraded = true;
                 handler->handleUpgrade(*req, asyncResp, std::move(adaptor));
 
                 // delete lambda with self shared_ptr
@@ -448,8 +511,159 @@ class Connection :
         if (!expected.empty())
         {
             res.setExpectedHash(expected);
+            // So handlers with a version for their content can skip
+            // building it with setEtagVersion()
+            asyncResp->res.setExpectedHash(expected);
+        }
+        // Binary encodings of the json are told apart from it by their ETag
+        http_helpers::ContentType prefered = preferedJsonType();
+        if (prefered == http_helpers::ContentType::CBOR ||
+            prefered == http_helpers::ContentType::MsgPack)
+        {
+            std::string_view representation =
+                prefered == http_helpers::ContentType::CBOR ? "cbor"
+                                                            : "msgpack";
+            res.setEtagRepresentation(representation);
+            asyncResp->res.setEtagRepresentation(representation);
+        }
+        // Cancelled if the client goes before the response is written
+        cancellation = std::make_shared<Cancellation>();
+        asyncResp->cancellation = cancellation;
+        // D-Bus calls the handler makes, directly or from their replies
+        dbusTrace = std::make_shared<dbus_trace::RequestTrace>(cancellation);
+        BMCWEB_TRACEPOINT3(request_start, this, &thisReq,
+                           static_cast<int>(thisReq.method()));
+        if (requestClass == RequestClass::Heavy)
+        {
+            // Waits its turn behind interactive traffic
+            BulkScheduler& scheduler = getBulkScheduler(*thisReq.ioService);
+            scheduler.post([self(shared_from_this()), asyncResp]() {
+                if (asyncResp->cancelled())
+                {
+                    BMCWEB_LOG_DEBUG << self.get()
+                                     << " Client gone, not handling";
+                    return;
+                }
+                dbus_trace::ScopedTrace traceScope(self->dbusTrace);
+                self->handler->handle(*self->req, asyncResp);
+            });
+            watchForDisconnect();
+            return;
+        }
+        {
+            dbus_trace::ScopedTrace traceScope(dbusTrace);
+            handler->handle(thisReq, asyncResp);
+        }
+        // Still waiting on something once the handler returns
+        if (asyncResp.use_count() > 1)
+        {
+            watchForDisconnect();
         }
-        handler->handle(thisReq, asyncResp);
+    }
+
+    /**
+     * @brief Waits for the socket to become readable while a request is being
+     * handled, and cancels the request if that's because the client reset
+     * it.  A client that only shut down its side may still read the
+     * response, so the connection just closes after it, unless the request
+     * is one dropOnHalfClose() says can be cancelled too.  Data from the
+     * client, such as a pipelined request, ends the watch without cancelling
+     * anything; it's read once the response is written.  The watch ends as
+     * the response completes.
+     */
+    void watchForDisconnect()
+    {
+        // A client that has already pipelined more requests is waiting on
+        // the responses, even if it has shut down its side since
+        if (buffer.size() != 0)
+        {
+            return;
+        }
+        watchingDisconnect = true;
+        boost::beast::get_lowest_layer(adaptor).async_wait(
+            boost::asio::socket_base::wait_read,
+            boost::asio::bind_cancellation_slot(
+                disconnectWatchCancel.slot(),
+                [self(shared_from_this()),
+                 watched{cancellation}](const boost::system::error_code& ec) {
+            if (ec || !self->watchingDisconnect ||
+                watched != self->cancellation || watched->cancelled())
+            {
+                return;
+            }
+            self->watchingDisconnect = false;
+            switch (peekPeerState(
+                boost::beast::get_lowest_layer(self->adaptor).native_handle()))
+            {
+                case PeerState::Sending:
+                    return;
+                case PeerState::Idle:
+                    self->watchForDisconnect();
+                    return;
+                case PeerState::HalfClosed:
+                    BMCWEB_LOG_DEBUG << self.get()
+                                     << " Client half-closed mid-request";
+                    if (!dropOnHalfClose(self->req->method(),
+                                         self->buffer.size()))
+                    {
+                        self->keepAlive = false;
+                        return;
+                    }
+                    break;
+                case PeerState::Gone:
+                    BMCWEB_LOG_DEBUG
+                        << self.get()
+                        << " Client reset the connection mid-request";
+                    break;
+            }
+            self->cancellation->cancel();
+            self->close();
+        }));
+    }
+
+    // Stops the watch of watchForDisconnect(), so nothing the client does
+    // while the response is written cancels it.  Only the wait is cancelled;
+    // other operations on the socket carry on.
+    void stopWatchingForDisconnect()
+    {
+        if (!watchingDisconnect)
+        {
+            return;
+        }
+        watchingDisconnect = false;
+        disconnectWatchCancel.emit(boost::asio::cancellation_type::all);
+    }
+
+    // The type a json payload is sent as, going by the Accept header
+    http_helpers::ContentType preferedJsonType() const
+    {
+        using http_helpers::ContentType;
+        std::array<ContentType, 4> allowed{ContentType::JSON, ContentType::HTML,
+                                           ContentType::CBOR,
+                                           ContentType::MsgPack};
+        return getPreferedContentType(req->getHeaderValue("Accept"), allowed);
+    }
+
+    // Encodes the json payload as CBOR or MessagePack, for clients that
+    // would rather not parse json.  Both encode the same document, with
+    // numbers kept binary and strings unescaped.
+    void encodeBinaryJson(http_helpers::ContentType type)
+    {
+        if (type == http_helpers::ContentType::CBOR)
+        {
+            res.addHeader(boost::beast::http::field::content_type,
+                          "application/cbor");
+            nlohmann::json::to_cbor(res.jsonValue, res.body());
+        }
+        else
+        {
+            res.addHeader(boost::beast::http::field::content_type,
+                          "application/msgpack");
+            nlohmann::json::to_msgpack(res.jsonValue, res.body());
+        }
+        // The EncodedBodyCache only holds compressed json
+        res.encodedBodyCacheable = false;
+        res.addHeader(boost::beast::http::field::vary, "Accept");
     }
 
     bool isAlive()
@@ -487,14 +701,48 @@ class Connection :
         }
     }
 
+    // Returns false, with a 503 filled in, when the AdmissionController
+    // turns the request away
+    bool admit()
+    {
+        std::string session;
+        if (userSession != nullptr)
+        {
+            session = userSession->uniqueId;
+        }
+        std::chrono::seconds retryAfter{0};
+        requestClass = classifyRequest(req->method(), req->url,
+                                       req->urlView.encoded_query());
+        admission = getAdmissionController().admit(
+            requestClass, req->ipAddress.to_string(), session,
+            std::chrono::steady_clock::now(), retryAfter);
+        if (admission)
+        {
+            return true;
+        }
+        res.result(boost::beast::http::status::service_unavailable);
+        res.addHeader(boost::beast::http::field::retry_after,
+                      std::to_string(retryAfter.count()));
+        return false;
+    }
+
     void completeRequest(crow::Response& thisRes)
     {
+        stopWatchingForDisconnect();
         if (!req)
         {
             return;
         }
+        admission.reset();
         res = std::move(thisRes);
         res.keepAlive(keepAlive);
+        BMCWEB_TRACEPOINT2(handler_done, this, res.resultInt());
+
+        // Calls still outstanding at this point aren't in the summary
+        if (dbusTrace && !req->getHeaderValue("X-DBus-Trace").empty())
+        {
+            res.addHeader("X-DBus-Trace", dbusTrace->headerValue());
+        }
 
 #ifdef BMCWEB_ENABLE_LINUX_AUDIT_EVENTS
         if (audit::wantAudit(*req))
@@ -541,18 +789,37 @@ class Connection :
 
         res.setHashAndHandleNotModified();
 
-        if (res.body().empty() && !res.jsonValue.empty())
+        if (res.bodyGenerator && res.jsonValue.empty() && res.body().empty())
+        {
+            // As with json, fill the first chunk up front; a body that fits
+            // in it is sent with a Content-Length.
+            bodyStream = std::move(res.bodyGenerator);
+            res.bodyGenerator = nullptr;
+            if (!bodyStream(res.body(), jsonStreamChunkSize))
+            {
+                bodyStream = nullptr;
+            }
+        }
+        else if (res.asyncBodyGenerator && res.jsonValue.empty() &&
+                 res.body().empty())
+        {
+            asyncBodyStream = std::move(res.asyncBodyGenerator);
+            res.asyncBodyGenerator = nullptr;
+        }
+        else if (res.body().empty() && !res.jsonValue.empty())
         {
             using http_helpers::ContentType;
-            std::array<ContentType, 2> allowed{ContentType::JSON,
-                                               ContentType::HTML};
-            ContentType prefered =
-                getPreferedContentType(req->getHeaderValue("Accept"), allowed);
+            ContentType prefered = preferedJsonType();
 
             if (prefered == ContentType::HTML)
             {
                 prettyPrintJson(res);
             }
+            else if (prefered == ContentType::CBOR ||
+                     prefered == ContentType::MsgPack)
+            {
+                encodeBinaryJson(prefered);
+            }
             else
             {
                 // Technically prefered could also be NoMatch here, but we'd
@@ -560,8 +827,15 @@ class Connection :
                 // backward compatibility.
                 res.addHeader(boost::beast::http::field::content_type,
                               "application/json");
-                res.body() = res.jsonValue.dump(
-                    2, ' ', true, nlohmann::json::error_handler_t::replace);
+                // Serialize the first chunk up front.  Payloads that fit in
+                // it are sent with a Content-Length as before; anything
+                // larger is streamed chunk by chunk as the socket drains.
+                jsonStream.emplace(res.jsonValue);
+                jsonStream->fill(res.body(), jsonStreamChunkSize);
+                if (jsonStream->done())
+                {
+                    jsonStream.reset();
+                }
             }
         }
 
@@ -578,19 +852,199 @@ class Connection :
             BMCWEB_LOG_CRITICAL
                 << this << " Response content provided but code was no-content";
             res.body().clear();
+            jsonStream.reset();
+            bodyStream = nullptr;
+            asyncBodyStream = nullptr;
+            res.fileBody.reset();
         }
 
         res.addHeader(boost::beast::http::field::date, getCachedDateStr());
 
         res.keepAlive(req->keepAlive());
 
-        doWrite(res);
+#ifdef BMCWEB_ENABLE_HTTP_COMPRESSION
+        compression::Encoding encoding = getResponseEncoding();
+        if (encoding != compression::Encoding::Identity)
+        {
+            doWriteEncoded(encoding);
+            res.setCompleteRequestHandler(nullptr);
+            return;
+        }
+#endif
+
+        if (jsonStream)
+        {
+            if constexpr (worker_pool::enabled())
+            {
+                // Render the remainder on a worker thread.  Nothing else
+                // touches res until the write that follows has completed.
+                worker_pool::offload(
+                    adaptor.get_executor(),
+                    [this]() {
+                    jsonStream->fill(res.body(), std::string::npos);
+                },
+                    [this, self(shared_from_this())]() {
+                    jsonStream.reset();
+                    if (!isAlive())
+                    {
+                        return;
+                    }
+                    doWrite(res);
+                });
+            }
+            else if (req->version() >= 11 &&
+                     req->method() != boost::beast::http::verb::head)
+            {
+                doWriteStreamed(res);
+            }
+            else
+            {
+                // HTTP/1.0 clients can't receive chunked bodies
+                jsonStream->fill(res.body(), std::string::npos);
+                jsonStream.reset();
+                doWrite(res);
+            }
+        }
+        else if (bodyStream)
+        {
+            // Generators may touch state owned by the io_context, so unlike
+            // json they always run here, between writes.
+            if (req->version() >= 11 &&
+                req->method() != boost::beast::http::verb::head)
+            {
+                doWriteStreamed(res);
+            }
+            else
+            {
+                while (bodyStream(res.body(), std::string::npos))
+                {}
+                bodyStream = nullptr;
+                doWrite(res);
+            }
+        }
+        else if (asyncBodyStream)
+        {
+            if (req->version() >= 11 &&
+                req->method() != boost::beast::http::verb::head)
+            {
+                doWriteStreamed(res);
+            }
+            else
+            {
+                drainAsyncBody();
+            }
+        }
+        else if (res.fileBody)
+        {
+            doWriteFile(res);
+        }
+        else
+        {
+            doWrite(res);
+        }
 
         // delete lambda with self shared_ptr
         // to enable connection destruction
         res.setCompleteRequestHandler(nullptr);
     }
 
+#ifdef BMCWEB_ENABLE_HTTP_COMPRESSION
+    compression::Encoding getResponseEncoding()
+    {
+        // Generated bodies are streamed to keep memory bounded; compressing
+        // them would need the whole body.  Bodies offered in byte ranges stay
+        // identity encoded, so a resumed download lines up with the first
+        // part.
+        if (res.result() != boost::beast::http::status::ok || res.fileBody ||
+            bodyStream || asyncBodyStream ||
+            req->method() == boost::beast::http::verb::head ||
+            !res.getHeaderValue("Content-Encoding").empty() ||
+            !res.getHeaderValue("Accept-Ranges").empty())
+        {
+            return compression::Encoding::Identity;
+        }
+        if (!jsonStream && res.body().size() < compression::minCompressSize)
+        {
+            return compression::Encoding::Identity;
+        }
+        return compression::getPreferredEncoding(
+            req->getHeaderValue(boost::beast::http::field::accept_encoding));
+    }
+
+    // Sends the body compressed with encoding.  Responses marked with
+    // setEncodedBodyCacheable are served from, or added to, the
+    // EncodedBodyCache.
+    void doWriteEncoded(compression::Encoding encoding)
+    {
+        std::string cacheKey;
+        if (res.encodedBodyCacheable)
+        {
+            cacheKey = compression::EncodedBodyCache::makeKey(
+                req->target(), res.getHeaderValue("ETag"), encoding);
+            std::shared_ptr<const std::string> cached =
+                compression::EncodedBodyCache::getInstance().find(cacheKey);
+            if (cached != nullptr)
+            {
+                BMCWEB_LOG_DEBUG << this << " using cached encoded body";
+                jsonStream.reset();
+                res.body() = *cached;
+                addEncodingHeaders(encoding);
+                doWrite(res);
+                return;
+            }
+        }
+
+        worker_pool::offload(
+            adaptor.get_executor(),
+            [this, encoding]() {
+            if (jsonStream)
+            {
+                jsonStream->fill(res.body(), std::string::npos);
+            }
+            std::string out;
+            if (compression::encode(res.body(), encoding, out))
+            {
+                encodedBody = std::move(out);
+            }
+        },
+            [this, self(shared_from_this()), encoding,
+             cacheKey{std::move(cacheKey)}]() {
+            jsonStream.reset();
+            if (!isAlive())
+            {
+                encodedBody.reset();
+                return;
+            }
+            if (encodedBody)
+            {
+                res.body() = std::move(*encodedBody);
+                encodedBody.reset();
+                addEncodingHeaders(encoding);
+                if (!cacheKey.empty())
+                {
+                    compression::EncodedBodyCache::getInstance().insert(
+                        cacheKey, res.body());
+                }
+            }
+            else
+            {
+                BMCWEB_LOG_ERROR << this << " Failed to encode response body";
+            }
+            doWrite(res);
+        });
+    }
+
+    void addEncodingHeaders(compression::Encoding encoding)
+    {
+        res.addHeader(boost::beast::http::field::content_encoding,
+                      compression::encodingName(encoding));
+        // Keeping the Vary: Accept of a binary encoding
+        std::string vary(res.getHeaderValue("Vary"));
+        vary += vary.empty() ? "Accept-Encoding" : ", Accept-Encoding";
+        res.addHeader(boost::beast::http::field::vary, vary);
+    }
+#endif
+
     void readClientIp()
     {
         boost::asio::ip::address ip;
@@ -634,6 +1088,8 @@ class Connection :
                                        std::size_t bytesTransferred) {
             BMCWEB_LOG_DEBUG << this << " async_read_header "
                              << bytesTransferred << " Bytes";
+            managed.markBusy();
+            bytesRead += bytesTransferred;
             bool errorWhileReading = false;
             if (ec)
             {
@@ -668,6 +1124,7 @@ class Connection :
                 BMCWEB_LOG_DEBUG << this << " from read(1)";
                 return;
             }
+            BMCWEB_TRACEPOINT2(headers_read, this, bytesTransferred);
 
             readClientIp();
 
@@ -679,53 +1136,108 @@ class Connection :
             sessionIsFromTransport = false;
 #ifndef BMCWEB_INSECURE_DISABLE_AUTHX
             boost::beast::http::verb method = parser->get().method();
-            userSession = crow::authentication::authenticate(
-                ip, res, method, parser->get().base(), userSession);
+            // Basic auth may wait on PAM, so the body is read once it answers
+            crow::authentication::authenticate(
+                adaptor.get_executor(), ip, res, method, parser->get().base(),
+                userSession,
+                [this, self(shared_from_this())](
+                    std::shared_ptr<persistent_data::UserSession> session) {
+                userSession = std::move(session);
+                afterAuthenticate();
+            });
+#else
+            doRead();
+#endif // BMCWEB_INSECURE_DISABLE_AUTHX
+        });
+    }
 
-            bool loggedIn = userSession != nullptr;
-            if (!loggedIn)
+#ifndef BMCWEB_INSECURE_DISABLE_AUTHX
+    void afterAuthenticate()
+    {
+        bool loggedIn = userSession != nullptr;
+        BMCWEB_TRACEPOINT2(auth_done, this, static_cast<int>(loggedIn));
+        if (!loggedIn)
+        {
+            const boost::optional<uint64_t> contentLength =
+                parser->content_length();
+            if (contentLength && *contentLength > loggedOutPostBodyLimit)
             {
-                const boost::optional<uint64_t> contentLength =
-                    parser->content_length();
-                if (contentLength && *contentLength > loggedOutPostBodyLimit)
-                {
-                    BMCWEB_LOG_DEBUG << "Content length greater than limit "
-                                     << *contentLength;
-                    close();
-                    return;
-                }
-
-                BMCWEB_LOG_DEBUG << "Starting quick deadline";
+                BMCWEB_LOG_DEBUG << "Content length greater than limit "
+                                 << *contentLength;
+                close();
+                return;
             }
-#endif // BMCWEB_INSECURE_DISABLE_AUTHX
 
-            doRead();
-        });
+            BMCWEB_LOG_DEBUG << "Starting quick deadline";
+        }
+
+        doRead();
     }
+#endif // BMCWEB_INSECURE_DISABLE_AUTHX
 
     void doRead()
     {
         BMCWEB_LOG_DEBUG << this << " doRead";
+        if (handler->isFileUpload(parser->get().method(),
+                                  parser->get().target()))
+        {
+            doReadUpload();
+            return;
+        }
         startDeadline();
         boost::beast::http::async_read(adaptor, buffer, *parser,
                                        [this, self(shared_from_this())](
                                            const boost::system::error_code& ec,
                                            std::size_t bytesTransferred) {
-            BMCWEB_LOG_DEBUG << this << " async_read " << bytesTransferred
-                             << " Bytes";
-            cancelDeadlineTimer();
-            if (ec)
-            {
-                BMCWEB_LOG_ERROR << this
-                                 << " Error while reading: " << ec.message();
-                close();
-                BMCWEB_LOG_DEBUG << this << " from read(1)";
-                return;
-            }
-            handle();
+            afterRead(ec, bytesTransferred);
         });
     }
 
+    // Reads the body straight into an UploadFile, a buffer at a time, so a
+    // firmware image never has to fit in memory
+    void doReadUpload()
+    {
+        BMCWEB_LOG_DEBUG << this << " doReadUpload";
+        uploadParser.emplace(std::move(*parser));
+        uploadParser->body_limit(httpReqBodyLimit);
+        startDeadline();
+        boost::beast::http::async_read(adaptor, buffer, *uploadParser,
+                                       [this, self(shared_from_this())](
+                                           const boost::system::error_code& ec,
+                                           std::size_t bytesTransferred) {
+            afterRead(ec, bytesTransferred);
+        });
+    }
+
+    void afterRead(const boost::system::error_code& ec,
+                   std::size_t bytesTransferred)
+    {
+        BMCWEB_LOG_DEBUG << this << " async_read " << bytesTransferred
+                         << " Bytes";
+        bytesRead += bytesTransferred;
+        cancelDeadlineTimer();
+        if (ec)
+        {
+            BMCWEB_LOG_ERROR << this
+                             << " Error while reading: " << ec.message();
+            uploadParser.reset();
+            close();
+            BMCWEB_LOG_DEBUG << this << " from read(1)";
+            return;
+        }
+        handle();
+    }
+
+    crow::Request::http_request_body releaseRequest()
+    {
+        if (!uploadParser)
+        {
+            return parser->release();
+        }
+        return crow::Request::http_request_body(
+            std::move(uploadParser->get().base()));
+    }
+
     void doWrite(crow::Response& thisRes)
     {
         BMCWEB_LOG_DEBUG << this << " doWrite";
@@ -738,42 +1250,349 @@ class Connection :
                                             std::size_t bytesTransferred) {
             BMCWEB_LOG_DEBUG << this << " async_write " << bytesTransferred
                              << " bytes";
+            bytesWritten += bytesTransferred;
+            afterWrite(ec);
+        });
+    }
 
-            cancelDeadlineTimer();
+    // Sends a response whose body is a file opened with Response::openFile.
+    // The file is read straight into the socket's write buffers as it
+    // drains, without passing through res.body().
+    void doWriteFile(crow::Response& thisRes)
+    {
+        BMCWEB_LOG_DEBUG << this << " doWriteFile";
+        fileResponse.emplace(thisRes.stringResponse->base(),
+                             std::move(*thisRes.fileBody));
+        thisRes.fileBody.reset();
+        fileResponse->prepare_payload();
+        fileSerializer.emplace(*fileResponse);
+        startDeadline();
+        if constexpr (std::is_same_v<Adaptor, boost::asio::ip::tcp::socket>)
+        {
+            if (req->method() != boost::beast::http::verb::head)
+            {
+                doWriteFileHeader();
+                return;
+            }
+        }
+        boost::beast::http::async_write(adaptor, *fileSerializer,
+                                        [this, self(shared_from_this())](
+                                            const boost::system::error_code& ec,
+                                            std::size_t bytesTransferred) {
+            BMCWEB_LOG_DEBUG << this << " async_write (file) "
+                             << bytesTransferred << " bytes";
+            bytesWritten += bytesTransferred;
+            fileSerializer.reset();
+            fileResponse.reset();
+            afterWrite(ec);
+        });
+    }
 
+    // On a plain socket the file goes from the page cache to the socket
+    // with sendfile(), once the header has been written.  TLS connections
+    // encrypt in user space, so they read the file through FileBody.
+    void doWriteFileHeader()
+    {
+        fileSerializer->split(true);
+        boost::beast::http::async_write_header(
+            adaptor, *fileSerializer,
+            [this, self(shared_from_this())](
+                const boost::system::error_code& ec,
+                std::size_t bytesTransferred) {
+            bytesWritten += bytesTransferred;
             if (ec)
             {
-                BMCWEB_LOG_DEBUG << this << " from write(2)";
+                finishWriteFile(ec);
                 return;
             }
-            if (!keepAlive)
+            fileSent = 0;
+            boost::system::error_code nonBlockingEc;
+            adaptor.native_non_blocking(true, nonBlockingEc);
+            if (nonBlockingEc)
             {
-                close();
-                BMCWEB_LOG_DEBUG << this << " from write(1)";
+                finishWriteFile(nonBlockingEc);
                 return;
             }
+            doSendFile();
+        });
+    }
+
+    void doSendFile()
+    {
+        const BodyFile& file = fileResponse->body();
+        if (fileSent >= file.size())
+        {
+            finishWriteFile({});
+            return;
+        }
+        size_t count = static_cast<size_t>(
+            std::min<uint64_t>(file.size() - fileSent, sendFileChunk));
+        ssize_t sent = file.sendTo(adaptor.native_handle(), fileSent, count);
+        if (sent < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+        {
+            finishWriteFile(boost::system::error_code(
+                errno, boost::system::system_category()));
+            return;
+        }
+        if (sent == 0)
+        {
+            // The file shrank after Content-Length was sent
+            finishWriteFile(boost::beast::http::error::short_read);
+            return;
+        }
+        if (sent > 0)
+        {
+            fileSent += static_cast<uint64_t>(sent);
+            bytesWritten += static_cast<size_t>(sent);
+        }
+        // Waiting even when the socket can take more lets other connections
+        // run between chunks
+        adaptor.async_wait(boost::asio::ip::tcp::socket::wait_write,
+                           [this, self(shared_from_this())](
+                               const boost::system::error_code& ec) {
+            if (ec)
+            {
+                finishWriteFile(ec);
+                return;
+            }
+            doSendFile();
+        });
+    }
+
+    void finishWriteFile(const boost::system::error_code& ec)
+    {
+        BMCWEB_LOG_DEBUG << this << " sendfile " << fileSent << " bytes";
+        fileSerializer.reset();
+        fileResponse.reset();
+        afterWrite(ec);
+    }
+
+    // Sends the response with a chunked body, handing the socket one
+    // jsonStreamChunkSize piece of serialized json, or of a generated body,
+    // at a time.  res.body() holds the first chunk on entry.
+    void doWriteStreamed(crow::Response& thisRes)
+    {
+        BMCWEB_LOG_DEBUG << this << " doWriteStreamed";
+        streamChunk = std::move(thisRes.body());
+        thisRes.body().clear();
+        streamResponse.emplace(thisRes.stringResponse->base());
+        streamResponse->chunked(true);
+        setStreamChunk(true);
+        streamSerializer.emplace(*streamResponse);
+        doWriteStreamChunk();
+    }
+
+    // Points the chunked body at streamChunk.  An empty chunk is left out,
+    // as beast would otherwise take it for the end of the body.
+    void setStreamChunk(bool more)
+    {
+        streamResponse->body().data =
+            streamChunk.empty() ? nullptr : streamChunk.data();
+        streamResponse->body().size = streamChunk.size();
+        streamResponse->body().more = more;
+    }
 
-            serializer.reset();
-            BMCWEB_LOG_DEBUG << this << " Clearing response";
-            res.clear();
-            parser.emplace(std::piecewise_construct, std::make_tuple());
-            parser->body_limit(httpReqBodyLimit); // reset body limit for
-                                                  // newly created parser
-            buffer.consume(buffer.size());
+    // Asks asyncBodyStream for its next part, then carries on writing
+    void pullAsyncBodyChunk()
+    {
+        // A copy, as the handler may run after asyncBodyStream is reset
+        crow::Response::AsyncBodyGenerator generator = asyncBodyStream;
+        generator([this, self(shared_from_this())](std::string chunk,
+                                                   bool more) {
+            if (!isAlive() || !streamResponse)
+            {
+                return;
+            }
+            streamChunk = std::move(chunk);
+            setStreamChunk(more);
+            if (!more)
+            {
+                asyncBodyStream = nullptr;
+            }
+            doWriteStreamChunk();
+        });
+    }
 
-            // If the session was built from the transport, we don't need to
-            // clear it.  All other sessions are generated per request.
-            if (!sessionIsFromTransport)
+    // HTTP/1.0 clients and HEAD requests get a generated body all at once,
+    // with a Content-Length
+    void drainAsyncBody()
+    {
+        crow::Response::AsyncBodyGenerator generator = asyncBodyStream;
+        generator([this, self(shared_from_this())](std::string chunk,
+                                                   bool more) {
+            if (!isAlive() || !asyncBodyStream)
             {
-                userSession = nullptr;
+                return;
+            }
+            res.body() += chunk;
+            if (more)
+            {
+                drainAsyncBody();
+                return;
             }
+            asyncBodyStream = nullptr;
+            doWrite(res);
+        });
+    }
 
-            // Destroy the Request via the std::optional
-            req.reset();
-            doReadHeaders();
+    void doWriteStreamChunk()
+    {
+        startDeadline();
+        boost::beast::http::async_write(adaptor, *streamSerializer,
+                                        [this, self(shared_from_this())](
+                                            const boost::system::error_code& ec,
+                                            std::size_t bytesTransferred) {
+            BMCWEB_LOG_DEBUG << this << " async_write (streamed) "
+                             << bytesTransferred << " bytes";
+            bytesWritten += bytesTransferred;
+            if (ec == boost::beast::http::error::need_buffer)
+            {
+                cancelDeadlineTimer();
+                streamChunk.clear();
+                bool more = false;
+                if (jsonStream)
+                {
+                    jsonStream->fill(streamChunk, jsonStreamChunkSize);
+                    more = !jsonStream->done();
+                }
+                else if (bodyStream)
+                {
+                    more = bodyStream(streamChunk, jsonStreamChunkSize);
+                }
+                else if (asyncBodyStream)
+                {
+                    // Nothing is written, and no deadline runs, until the
+                    // next part arrives
+                    pullAsyncBodyChunk();
+                    return;
+                }
+                setStreamChunk(more);
+                if (!more)
+                {
+                    jsonStream.reset();
+                    bodyStream = nullptr;
+                }
+                doWriteStreamChunk();
+                return;
+            }
+            streamSerializer.reset();
+            streamResponse.reset();
+            jsonStream.reset();
+            bodyStream = nullptr;
+            asyncBodyStream = nullptr;
+            streamChunk.clear();
+            streamChunk.shrink_to_fit();
+            afterWrite(ec);
         });
     }
 
+    void afterWrite(const boost::system::error_code& ec)
+    {
+        BMCWEB_TRACEPOINT3(write_done, this, bytesWritten,
+                           static_cast<int>(static_cast<bool>(ec)));
+        cancelDeadlineTimer();
+        size_t written = bytesWritten;
+        recordMetrics();
+        endRequest();
+        if (memory::trimThreshold != 0 && written >= memory::trimThreshold)
+        {
+            // Once the buffers of the response itself have been released
+            boost::asio::post(adaptor.get_executor(), [written]() {
+                memory::trimAfterResponse(written);
+            });
+        }
+
+        if (ec)
+        {
+            BMCWEB_LOG_DEBUG << this << " from write(2)";
+            return;
+        }
+        if (!keepAlive || drainingConnections)
+        {
+            close();
+            BMCWEB_LOG_DEBUG << this << " from write(1)";
+            return;
+        }
+
+        serializer.reset();
+        BMCWEB_LOG_DEBUG << this << " Clearing response";
+        res.clear();
+        parser.emplace(std::piecewise_construct, std::make_tuple());
+        parser->body_limit(httpReqBodyLimit); // reset body limit for
+                                              // newly created parser
+        // Anything left in the buffer is the start of the requests the
+        // client pipelined behind this one; they're parsed from there, and
+        // answered in the order they came.  They're still handled one at a
+        // time: the request, response, session, trace and admission slot
+        // are members, so the next request isn't read until this one's
+        // response is written.
+
+        // If the session was built from the transport, we don't need to
+        // clear it.  All other sessions are generated per request.
+        if (!sessionIsFromTransport)
+        {
+            userSession = nullptr;
+        }
+
+        // Destroy the Request via the std::optional
+        req.reset();
+
+        // A handler that still holds something from the last request keeps
+        // that arena; start this one on a fresh one
+        if (!arena->reset())
+        {
+            BMCWEB_LOG_DEBUG << this << " " << arena->outstandingBlocks()
+                             << " request allocations still in use";
+            arena = std::make_shared<RequestArena>();
+        }
+        if (buffer.size() == 0)
+        {
+            // Fair game for eviction until the next request's headers are in
+            managed.markIdle();
+        }
+        else
+        {
+            BMCWEB_LOG_DEBUG << this << " " << buffer.size()
+                             << " bytes of pipelined requests buffered";
+        }
+        doReadHeaders();
+    }
+
+    void endRequest()
+    {
+        if (requestInFlight)
+        {
+            requestInFlight = false;
+            inFlightRequests--;
+        }
+    }
+
+    // Charges the request just written to the route that handled it
+    void recordMetrics()
+    {
+        std::chrono::microseconds elapsed =
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - requestStart);
+        if (req && req->routeMetrics != nullptr)
+        {
+            req->routeMetrics->record(elapsed, res.resultInt(), bytesRead,
+                                      bytesWritten,
+                                      dbusTrace ? dbusTrace->count() : 0);
+        }
+#ifdef BMCWEB_ENABLE_TRAFFIC_CAPTURE
+        if (req)
+        {
+            capture::TrafficCapture::getInstance().record(
+                *req, captureConnection, requestStart, res.resultInt(),
+                elapsed);
+        }
+#endif
+        bytesRead = 0;
+        bytesWritten = 0;
+        dbusTrace.reset();
+        cancellation.reset();
+    }
+
     void cancelDeadlineTimer()
     {
         timer.cancel();
@@ -795,35 +1614,31 @@ class Connection :
             return;
         }
 
-        std::weak_ptr<Connection<Adaptor, Handler>> weakSelf = weak_from_this();
-        timer.expires_after(timeout);
-        timer.async_wait([weakSelf](const boost::system::error_code ec) {
-            // Note, we are ignoring other types of errors here;  If the timer
-            // failed for any reason, we should still close the connection
+        timer.expiresAfter(timeout);
 
-            std::shared_ptr<Connection<Adaptor, Handler>> self =
-                weakSelf.lock();
-            if (!self)
-            {
-                BMCWEB_LOG_CRITICAL << self << " Failed to capture connection";
-                return;
-            }
-            if (ec == boost::asio::error::operation_aborted)
-            {
-                // Canceled wait means the path succeeeded.
-                return;
-            }
-            if (ec)
-            {
-                BMCWEB_LOG_CRITICAL << self << " timer failed " << ec;
-            }
+        BMCWEB_LOG_DEBUG << this << " timer started";
+    }
 
-            BMCWEB_LOG_WARNING << self << "Connection timed out, closing";
+    void onDeadline()
+    {
+        std::shared_ptr<Connection<Adaptor, Handler>> self =
+            this->weak_from_this().lock();
+        if (!self)
+        {
+            BMCWEB_LOG_CRITICAL << this << " Failed to capture connection";
+            return;
+        }
 
-            self->close();
-        });
+        BMCWEB_LOG_WARNING << this << "Connection timed out, closing";
 
-        BMCWEB_LOG_DEBUG << this << " timer started";
+        close();
+    }
+
+    // Closed while idle, so a new connection fits under the cap
+    void onEvicted()
+    {
+        BMCWEB_LOG_DEBUG << this << " Evicted while idle, closing";
+        close();
     }
 
     Adaptor adaptor;
@@ -833,6 +1648,9 @@ class Connection :
     std::optional<
         boost::beast::http::request_parser<boost::beast::http::string_body>>
         parser;
+    // Takes over from parser for routes marked fileUpload(); see
+    // doReadUpload()
+    std::optional<boost::beast::http::request_parser<UploadBody>> uploadParser;
 
     boost::beast::flat_static_buffer<8192> buffer;
 
@@ -840,16 +1658,76 @@ class Connection :
         boost::beast::http::string_body>>
         serializer;
 
+    // State for chunked json responses; see doWriteStreamed()
+    std::optional<json_stream::JsonChunkSerializer> jsonStream;
+    crow::Response::BodyGenerator bodyStream;
+    crow::Response::AsyncBodyGenerator asyncBodyStream;
+    std::optional<
+        boost::beast::http::response<boost::beast::http::buffer_body>>
+        streamResponse;
+    std::optional<boost::beast::http::response_serializer<
+        boost::beast::http::buffer_body>>
+        streamSerializer;
+    std::string streamChunk;
+
+#ifdef BMCWEB_ENABLE_HTTP_COMPRESSION
+    // Result of compressing res.body(); see doWriteEncoded()
+    std::optional<std::string> encodedBody;
+#endif
+
+    // State for file responses; see doWriteFile()
+    std::optional<boost::beast::http::response<FileBody>> fileResponse;
+    std::optional<boost::beast::http::response_serializer<FileBody>>
+        fileSerializer;
+    // Body bytes of the file response sent with sendfile()
+    uint64_t fileSent = 0;
+    // Most handed to one sendfile(), so a large file doesn't hold the
+    // io_context on one connection
+    static constexpr size_t sendFileChunk = 1024 * 1024;
+
     std::optional<crow::Request> req;
     crow::Response res;
 
+    // In-flight slot of the current request; see AdmissionController
+    std::optional<AdmissionTicket> admission;
+    RequestClass requestClass = RequestClass::Normal;
+
+    // For the route's RouteMetrics; bytes count headers as well
+    std::chrono::steady_clock::time_point requestStart;
+    size_t bytesRead = 0;
+    size_t bytesWritten = 0;
+    std::shared_ptr<dbus_trace::RequestTrace> dbusTrace;
+    // Of the request being handled; see watchForDisconnect()
+    std::shared_ptr<Cancellation> cancellation;
+    bool watchingDisconnect = false;
+    // Bound to the wait of watchForDisconnect() alone
+    boost::asio::cancellation_signal disconnectWatchCancel;
+#ifdef BMCWEB_ENABLE_TRAFFIC_CAPTURE
+    // The number this connection goes by in the traffic capture
+    uint64_t captureConnection = 0;
+#endif
+
+    // Request scoped allocations; see RequestArena
+    std::shared_ptr<RequestArena> arena = std::make_shared<RequestArena>();
+
     bool sessionIsFromTransport = false;
     std::shared_ptr<persistent_data::UserSession> userSession;
 
-    boost::asio::steady_timer timer;
+    // Idle timeout; see startDeadline()
+    WheelTimer timer;
+    // Place under the Server's connection cap
+    ManagedConnection managed;
 
     bool keepAlive = true;
 
+    // Counted in inFlightRequests
+    bool requestInFlight = false;
+
+    // Set once the socket has been moved out by handleUpgrade()
+    bool upgraded = false;
+    // Set while the connection sits in a ConnectionPool
+    bool parked = false;
+
     std::function<std::string()>& getCachedDateStr;
 
     using std::enable_shared_from_this<
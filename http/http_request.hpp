@@ -18,6 +18,9 @@
 namespace crow
 {
 
+struct RouteMetrics;
+class UploadFile;
+
 struct Request
 {
     using http_request_body =
@@ -39,6 +42,16 @@ struct Request
     std::shared_ptr<persistent_data::UserSession> session;
 
     std::string userRole{};
+
+    // Set by the Router to the metrics of the rule that matched, and the
+    // rule itself
+    RouteMetrics* routeMetrics = nullptr;
+    std::string_view route{};
+
+    // For routes marked fileUpload(), the body as written to disk; body is
+    // left empty
+    std::shared_ptr<UploadFile> upload;
+
     Request(http_request_body reqIn, std::error_code& ec) :
         reqPtr(std::make_shared<http_request_body>(std::move(reqIn))),
         req(*reqPtr), fields(req.base()), body(req.body())
@@ -49,24 +62,27 @@ struct Request
         }
     }
 
+    // Copies share the underlying message, so url and urlView, which point
+    // into its target, stay valid and the target isn't parsed again
     Request(const Request& other) :
-        reqPtr(other.reqPtr), req(*reqPtr), fields(req.base()),
-        isSecure(other.isSecure), body(req.body()), ioService(other.ioService),
-        ipAddress(other.ipAddress), session(other.session),
-        userRole(other.userRole)
-    {
-        setUrlInfo();
-    }
+        reqPtr(other.reqPtr), req(*reqPtr), fields(req.base()), url(other.url),
+        urlView(other.urlView), isSecure(other.isSecure), body(req.body()),
+        ioService(other.ioService), ipAddress(other.ipAddress),
+        session(other.session), userRole(other.userRole),
+        routeMetrics(other.routeMetrics), route(other.route),
+        upload(other.upload)
+    {}
 
     Request(Request&& other) noexcept :
         reqPtr(std::move(other.reqPtr)), req(*reqPtr), fields(req.base()),
+        url(other.url), urlView(other.urlView),
         isSecure(std::move(other.isSecure)), body(req.body()),
         ioService(std::move(other.ioService)),
         ipAddress(std::move(other.ipAddress)),
-        session(std::move(other.session)), userRole(std::move(other.userRole))
-    {
-        setUrlInfo();
-    }
+        session(std::move(other.session)), userRole(std::move(other.userRole)),
+        routeMetrics(other.routeMetrics), route(other.route),
+        upload(std::move(other.upload))
+    {}
 
     Request& operator=(const Request&) = delete;
     Request& operator=(const Request&&) = delete;
@@ -1,6 +1,8 @@
 #pragma once
+#include "file_body.hpp"
 #include "logging.hpp"
 #include "nlohmann/json.hpp"
+#include "small_function.hpp"
 
 #include <boost/asio/buffer.hpp>
 #include <boost/beast/core/flat_static_buffer.hpp>
@@ -9,6 +11,8 @@
 #include <boost/beast/http/string_body.hpp>
 #include <utils/hex_utils.hpp>
 
+#include <filesystem>
+#include <functional>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -19,6 +23,41 @@ namespace crow
 template <typename Adaptor, typename Handler>
 class Connection;
 
+/**
+ * @brief Returns true if any entity tag in an If-None-Match header value
+ * matches etag.  Per RFC 7232 the comparison is weak, so a W/ prefix is
+ * ignored.
+ */
+inline bool etagMatches(std::string_view ifNoneMatch, std::string_view etag)
+{
+    while (!ifNoneMatch.empty())
+    {
+        size_t comma = ifNoneMatch.find(',');
+        std::string_view candidate = ifNoneMatch.substr(0, comma);
+        ifNoneMatch = (comma == std::string_view::npos)
+                          ? std::string_view()
+                          : ifNoneMatch.substr(comma + 1);
+
+        while (!candidate.empty() && candidate.front() == ' ')
+        {
+            candidate.remove_prefix(1);
+        }
+        while (!candidate.empty() && candidate.back() == ' ')
+        {
+            candidate.remove_suffix(1);
+        }
+        if (candidate.starts_with("W/"))
+        {
+            candidate.remove_prefix(2);
+        }
+        if (candidate == "*" || candidate == etag)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 struct Response
 {
     template <typename Adaptor, typename Handler>
@@ -26,6 +65,26 @@ struct Response
     using response_type =
         boost::beast::http::response<boost::beast::http::string_body>;
 
+    // Appends the next part of a generated body to out, stopping once out
+    // holds at least chunkSize bytes.  Returns false when the body is done.
+    using BodyGenerator =
+        std::function<bool(std::string& out, size_t chunkSize)>;
+
+    // Called with the next part of an asynchronously generated body, and
+    // whether more follows
+    using BodyChunkHandler = std::function<void(std::string chunk, bool more)>;
+
+    // Starts producing the next part of a body whose content comes from
+    // async calls, passing it to the handler once it is ready.  The handler
+    // must not be called inline.
+    using AsyncBodyGenerator = std::function<void(BodyChunkHandler&& done)>;
+
+    // Run once the response is complete.  One that holds no more than a
+    // connection is kept without allocating, as it's set on every request.
+    using CompletionHandler = SmallFunction<void(Response&)>;
+
+    using IsAliveHelper = SmallFunction<bool()>;
+
     std::optional<response_type> stringResponse;
 
     nlohmann::json jsonValue;
@@ -43,16 +102,24 @@ struct Response
     Response() : stringResponse(response_type{}) {}
 
     Response(Response&& res) noexcept :
-        stringResponse(std::move(res.stringResponse)), completed(res.completed)
+        stringResponse(std::move(res.stringResponse)),
+        fileBody(std::move(res.fileBody)),
+        bodyGenerator(std::move(res.bodyGenerator)),
+        asyncBodyGenerator(std::move(res.asyncBodyGenerator)),
+        encodedBodyCacheable(res.encodedBodyCacheable),
+        versionEtag(std::move(res.versionEtag)), completed(res.completed)
     {
         jsonValue = std::move(res.jsonValue);
+        res.fileBody.reset();
+        res.bodyGenerator = nullptr;
+        res.asyncBodyGenerator = nullptr;
         // See note in operator= move handler for why this is needed.
         if (!res.completed)
         {
             completeRequestHandler = std::move(res.completeRequestHandler);
             res.completeRequestHandler = nullptr;
         }
-        isAliveHelper = res.isAliveHelper;
+        isAliveHelper = std::move(res.isAliveHelper);
         res.isAliveHelper = nullptr;
     }
 
@@ -73,6 +140,15 @@ struct Response
         stringResponse = std::move(r.stringResponse);
         r.stringResponse.emplace(response_type{});
         jsonValue = std::move(r.jsonValue);
+        fileBody = std::move(r.fileBody);
+        r.fileBody.reset();
+        bodyGenerator = std::move(r.bodyGenerator);
+        r.bodyGenerator = nullptr;
+        asyncBodyGenerator = std::move(r.asyncBodyGenerator);
+        r.asyncBodyGenerator = nullptr;
+        encodedBodyCacheable = r.encodedBodyCacheable;
+        versionEtag = std::move(r.versionEtag);
+        r.versionEtag.reset();
 
         // Only need to move completion handler if not already completed
         // Note, there are cases where we might move out of a Response object
@@ -154,8 +230,111 @@ struct Response
         BMCWEB_LOG_DEBUG << this << " Clearing response containers";
         stringResponse.emplace(response_type{});
         jsonValue = nullptr;
+        fileBody.reset();
+        bodyGenerator = nullptr;
+        asyncBodyGenerator = nullptr;
+        encodedBodyCacheable = false;
         completed = false;
         expectedHash = std::nullopt;
+        versionEtag = std::nullopt;
+        etagRepresentation.clear();
+    }
+
+    /**
+     * @brief Sends the contents of path as the body.  The file is streamed
+     * to the socket when the response is written rather than being copied
+     * into body().
+     */
+    bool openFile(const std::filesystem::path& path)
+    {
+        BodyFile file;
+        boost::system::error_code ec;
+        file.open(path, ec);
+        if (ec)
+        {
+            BMCWEB_LOG_ERROR << "Failed to open " << path.string() << ": "
+                             << ec.message();
+            return false;
+        }
+        fileBody.emplace(std::move(file));
+        return true;
+    }
+
+    /**
+     * @brief As openFile(), for a descriptor the response takes ownership
+     * of, such as one a D-Bus call returned.  fd is closed even on failure.
+     */
+    bool openFile(int fd)
+    {
+        BodyFile file;
+        boost::system::error_code ec;
+        file.adopt(fd, ec);
+        if (ec)
+        {
+            BMCWEB_LOG_ERROR << "Failed to stat fd " << fd << ": "
+                             << ec.message();
+            return false;
+        }
+        fileBody.emplace(std::move(file));
+        return true;
+    }
+
+    // Size of the file opened with openFile(), for working out byte ranges
+    uint64_t fileSize() const
+    {
+        return fileBody ? fileBody->getFileSize() : 0;
+    }
+
+    // Sends only length bytes of the opened file, starting at offset
+    void setFileRange(uint64_t offset, uint64_t length)
+    {
+        if (fileBody)
+        {
+            fileBody->setRange(offset, length);
+        }
+    }
+
+    bool hasFileBody() const
+    {
+        return fileBody.has_value();
+    }
+
+    /**
+     * @brief Produces the body with generator while the response is being
+     * written, so it never has to be held in memory all at once.  The
+     * generator runs on the io_context between writes to the socket and may
+     * own whatever state it reads from.  Only used when jsonValue is empty.
+     */
+    void setBodyGenerator(BodyGenerator generator)
+    {
+        bodyGenerator = std::move(generator);
+    }
+
+    bool hasBodyGenerator() const
+    {
+        return static_cast<bool>(bodyGenerator) ||
+               static_cast<bool>(asyncBodyGenerator);
+    }
+
+    /**
+     * @brief Like setBodyGenerator(), for bodies built from async calls.  The
+     * headers go out as soon as the handler completes, and each part is asked
+     * for only once the one before it has been written, so a slow client
+     * holds back the calls rather than piling up their results.
+     */
+    void setAsyncBodyGenerator(AsyncBodyGenerator generator)
+    {
+        asyncBodyGenerator = std::move(generator);
+    }
+
+    /**
+     * @brief Marks the response as one whose content depends only on the
+     * request target, allowing the connection to reuse a previously
+     * compressed copy of the body.
+     */
+    void setEncodedBodyCacheable()
+    {
+        encodedBodyCacheable = true;
     }
 
     void write(std::string_view bodyPart)
@@ -200,7 +379,7 @@ struct Response
         return isAliveHelper && isAliveHelper();
     }
 
-    void setCompleteRequestHandler(std::function<void(Response&)>&& handler)
+    void setCompleteRequestHandler(CompletionHandler&& handler)
     {
         BMCWEB_LOG_DEBUG << this << " setting completion handler";
         completeRequestHandler = std::move(handler);
@@ -210,24 +389,24 @@ struct Response
         completed = false;
     }
 
-    std::function<void(Response&)> releaseCompleteRequestHandler()
+    CompletionHandler releaseCompleteRequestHandler()
     {
         BMCWEB_LOG_DEBUG << this << " releasing completion handler"
                          << static_cast<bool>(completeRequestHandler);
-        std::function<void(Response&)> ret = completeRequestHandler;
+        CompletionHandler ret = std::move(completeRequestHandler);
         completeRequestHandler = nullptr;
         completed = true;
         return ret;
     }
 
-    void setIsAliveHelper(std::function<bool()>&& handler)
+    void setIsAliveHelper(IsAliveHelper&& handler)
     {
         isAliveHelper = std::move(handler);
     }
 
-    std::function<bool()> releaseIsAliveHelper()
+    IsAliveHelper releaseIsAliveHelper()
     {
-        std::function<bool()> ret = std::move(isAliveHelper);
+        IsAliveHelper ret = std::move(isAliveHelper);
         isAliveHelper = nullptr;
         return ret;
     }
@@ -235,14 +414,23 @@ struct Response
     void setHashAndHandleNotModified()
     {
         // Can only hash if we have content that's valid
-        if (jsonValue.empty() || result() != boost::beast::http::status::ok)
+        if (result() != boost::beast::http::status::ok)
         {
             return;
         }
-        size_t hashval = std::hash<nlohmann::json>{}(jsonValue);
-        std::string hexVal = "\"" + intToHexString(hashval, 8) + "\"";
-        addHeader(boost::beast::http::field::etag, hexVal);
-        if (expectedHash && hexVal == *expectedHash)
+        if (jsonValue.empty())
+        {
+            // A body serialized ahead of time carries its version
+            if (versionEtag && !body().empty())
+            {
+                addHeader(boost::beast::http::field::etag, *versionEtag);
+            }
+            return;
+        }
+        std::string etag =
+            representationEtag(versionEtag ? *versionEtag : computeEtag());
+        addHeader(boost::beast::http::field::etag, etag);
+        if (expectedHash && etagMatches(*expectedHash, etag))
         {
             jsonValue = nullptr;
             result(boost::beast::http::status::not_modified);
@@ -254,11 +442,60 @@ struct Response
         expectedHash = hash;
     }
 
+    /**
+     * @brief Tags the ETag of the json with the representation it's sent in,
+     * such as "cbor", so a client holding the ETag of one encoding doesn't
+     * get a 304 for another.  Like setExpectedHash(), it's set before the
+     * handler runs and isn't moved with the response.
+     */
+    void setEtagRepresentation(std::string_view representation)
+    {
+        etagRepresentation = representation;
+    }
+
+    /**
+     * @brief Uses version, which the handler changes whenever its content
+     * does, as the ETag instead of hashing the json once it's built.
+     *
+     * Returns true if the client already holds this version.  The response
+     * is then a 304, and the handler can end it without building a body.
+     */
+    bool setEtagVersion(std::string_view version)
+    {
+        versionEtag = "\"" + std::string(version) + "\"";
+        std::string etag = representationEtag(*versionEtag);
+        if (expectedHash && etagMatches(*expectedHash, etag))
+        {
+            jsonValue = nullptr;
+            result(boost::beast::http::status::not_modified);
+            addHeader(boost::beast::http::field::etag, etag);
+            return true;
+        }
+        return false;
+    }
+
   private:
+    // etag, a quoted string, with the representation added inside the quotes
+    std::string representationEtag(std::string etag) const
+    {
+        if (etagRepresentation.empty() || etag.size() < 2)
+        {
+            return etag;
+        }
+        etag.insert(etag.size() - 1, "-" + etagRepresentation);
+        return etag;
+    }
+
+    std::optional<BodyFile> fileBody;
+    BodyGenerator bodyGenerator;
+    AsyncBodyGenerator asyncBodyGenerator;
+    bool encodedBodyCacheable = false;
     std::optional<std::string> expectedHash;
+    std::optional<std::string> versionEtag;
+    std::string etagRepresentation;
     bool completed = false;
-    std::function<void(Response&)> completeRequestHandler;
-    std::function<bool()> isAliveHelper;
+    CompletionHandler completeRequestHandler;
+    IsAliveHelper isAliveHelper;
 };
 
 struct DynamicResponse
@@ -1,7 +1,14 @@
 #pragma once
 
+#include "bmcweb_config.h"
+
+#include "connection_manager.hpp"
+#include "connection_pool.hpp"
 #include "http_connection.hpp"
 #include "logging.hpp"
+#include "timer_wheel.hpp"
+#include "tracepoints.hpp"
+#include "worker_pool.hpp"
 
 #include <boost/asio/ip/address.hpp>
 #include <boost/asio/ip/tcp.hpp>
@@ -14,6 +21,7 @@
 #include <atomic>
 #include <chrono>
 #include <cstdint>
+#include <exception>
 #include <filesystem>
 #include <future>
 #include <memory>
@@ -36,7 +44,9 @@ class Server
                std::make_shared<boost::asio::io_context>()) :
         ioService(std::move(io)),
         acceptor(std::move(acceptorIn)),
-        signals(*ioService, SIGINT, SIGTERM, SIGHUP), handler(handlerIn),
+        signals(*ioService, SIGINT, SIGTERM, SIGHUP), drainTimer(*ioService),
+        connectionTimeouts(*ioService), connections(bmcwebHttpMaxConnections),
+        handler(handlerIn),
         adaptorCtx(std::move(adaptorCtxIn))
     {
 #ifdef BMCWEB_ENABLE_IBM_MANAGEMENT_CONSOLE
@@ -80,7 +90,6 @@ class Server
 
     void run()
     {
-        loadCertificate();
         updateDateStr();
 
         getCachedDateStr = [this]() -> std::string {
@@ -98,12 +107,36 @@ class Server
         BMCWEB_LOG_INFO << "bmcweb server is running, local endpoint "
                         << acceptor->local_endpoint().address().to_string();
         startAsyncWaitForSignal();
+#ifdef BMCWEB_ENABLE_SSL
+        // Accepting starts once the first context is built
+        loadCertificate();
+#else
         doAccept();
+#endif
     }
 
+    /**
+     * @brief Builds the TLS context from server.pem, generating a self
+     * signed certificate first if there isn't a valid one.
+     *
+     * Key generation and parsing are done through worker_pool::offload, so
+     * with http-worker-threads set, a first boot or a SIGHUP reload doesn't
+     * stall the io thread.  The new context is used for connections
+     * accepted once it is installed; connections already open keep the
+     * context they were accepted with.
+     */
     void loadCertificate()
     {
 #ifdef BMCWEB_ENABLE_SSL
+        if (certificateLoading)
+        {
+            // Build again once the load in flight is done, so the last
+            // reload always sees the latest file
+            certificateReloadPending = true;
+            return;
+        }
+        certificateLoading = true;
+
         namespace fs = std::filesystem;
         // Cleanup older certificate file existing in the system
         fs::path oldCert = "/home/root/server.pem";
@@ -121,15 +154,60 @@ class Server
         }
         fs::path certFile = certPath / "server.pem";
         BMCWEB_LOG_INFO << "Building SSL Context file=" << certFile.string();
-        std::string sslPemFile(certFile);
-        ensuressl::ensureOpensslKeyPresentAndValid(sslPemFile);
-        std::shared_ptr<boost::asio::ssl::context> sslContext =
-            ensuressl::getSslContext(sslPemFile);
-        adaptorCtx = sslContext;
-        handler->ssl(std::move(sslContext));
+        auto built = std::make_shared<
+            std::shared_ptr<boost::asio::ssl::context>>();
+        crow::worker_pool::offload(
+            ioService->get_executor(),
+            [sslPemFile{std::string(certFile)}, built]() {
+            try
+            {
+                ensuressl::ensureOpensslKeyPresentAndValid(sslPemFile);
+                *built = ensuressl::getSslContext(sslPemFile);
+            }
+            catch (const std::exception& e)
+            {
+                BMCWEB_LOG_ERROR << "Failed to build SSL context: "
+                                 << e.what();
+            }
+        },
+            [this, built]() { installCertificate(std::move(*built)); });
 #endif
     }
 
+    void installCertificate(std::shared_ptr<boost::asio::ssl::context> ctx)
+    {
+        certificateLoading = false;
+        if (ctx != nullptr)
+        {
+            adaptorCtx = ctx;
+            handler->ssl(std::move(ctx));
+        }
+        if (certificateReloadPending)
+        {
+            certificateReloadPending = false;
+            loadCertificate();
+        }
+        if (adaptorCtx == nullptr || drainingConnections)
+        {
+            return;
+        }
+        if (!accepting)
+        {
+            accepting = true;
+            doAccept();
+            return;
+        }
+        // The accept in flight was set up with the old context; cancelling
+        // it makes doAccept() start over with the new one
+        boost::system::error_code ec;
+        acceptor->cancel(ec);
+        if (ec)
+        {
+            BMCWEB_LOG_ERROR << "Error while canceling async operations:"
+                             << ec.message();
+        }
+    }
+
     void startAsyncWaitForSignal()
     {
         signals.async_wait(
@@ -144,14 +222,6 @@ class Server
                 {
                     BMCWEB_LOG_INFO << "Receivied reload signal";
                     loadCertificate();
-                    boost::system::error_code ec2;
-                    acceptor->cancel(ec2);
-                    if (ec2)
-                    {
-                        BMCWEB_LOG_ERROR
-                            << "Error while canceling async operations:"
-                            << ec2.message();
-                    }
                     this->startAsyncWaitForSignal();
                 }
 #ifdef BMCWEB_ENABLE_IBM_MANAGEMENT_CONSOLE
@@ -166,7 +236,7 @@ class Server
 #endif
                 else
                 {
-                    stop();
+                    drain();
                 }
             }
         });
@@ -177,32 +247,92 @@ class Server
         ioService->stop();
     }
 
-    void doAccept()
+    /**
+     * @brief Stops accepting connections, then stops once every request
+     * already read has been answered, or drainTimeout has passed.
+     *
+     * When socket activated, systemd keeps the listening socket, so
+     * connections made meanwhile wait for the next instance rather than
+     * being refused.
+     */
+    void drain()
+    {
+        BMCWEB_LOG_INFO << "Draining " << inFlightRequests
+                        << " requests before exiting";
+        drainingConnections = true;
+        boost::system::error_code ec;
+        acceptor->close(ec);
+        drainDeadline = std::chrono::steady_clock::now() + drainTimeout;
+        waitForDrain();
+    }
+
+    void waitForDrain()
+    {
+        if (inFlightRequests <= 0 ||
+            std::chrono::steady_clock::now() >= drainDeadline)
+        {
+            if (inFlightRequests > 0)
+            {
+                BMCWEB_LOG_WARNING << "Exiting with " << inFlightRequests
+                                   << " requests unanswered";
+            }
+            stop();
+            return;
+        }
+        drainTimer.expires_after(std::chrono::milliseconds(50));
+        drainTimer.async_wait([this](const boost::system::error_code& ec) {
+            if (ec)
+            {
+                return;
+            }
+            waitForDrain();
+        });
+    }
+
+    Adaptor makeAdaptor()
     {
-        boost::asio::steady_timer timer(*ioService);
-        std::shared_ptr<Connection<Adaptor, Handler>> connection;
         if constexpr (std::is_same<Adaptor,
                                    boost::beast::ssl_stream<
                                        boost::asio::ip::tcp::socket>>::value)
         {
-            connection = std::make_shared<Connection<Adaptor, Handler>>(
-                handler, std::move(timer), getCachedDateStr,
-                Adaptor(*ioService, *adaptorCtx));
+            return Adaptor(*ioService, *adaptorCtx);
         }
         else
         {
-            connection = std::make_shared<Connection<Adaptor, Handler>>(
-                handler, std::move(timer), getCachedDateStr,
-                Adaptor(*ioService));
+            return Adaptor(*ioService);
         }
+    }
+
+    void doAccept()
+    {
+        // Closed connections are reused, along with their buffers, so
+        // connection churn doesn't keep allocating them
+        std::unique_ptr<Connection<Adaptor, Handler>> pooled = pool->take();
+        if (pooled)
+        {
+            pooled->reset(makeAdaptor());
+        }
+        else
+        {
+            pooled = std::make_unique<Connection<Adaptor, Handler>>(
+                handler, connectionTimeouts, connections, getCachedDateStr,
+                makeAdaptor());
+        }
+        std::shared_ptr<Connection<Adaptor, Handler>> connection =
+            pool->share(std::move(pooled));
         acceptor->async_accept(
             boost::beast::get_lowest_layer(connection->socket()),
             [this, connection](boost::system::error_code ec) {
             if (!ec)
             {
+                BMCWEB_TRACEPOINT1(connection_accept, connection.get());
                 boost::asio::post(*this->ioService,
                                   [connection] { connection->start(); });
             }
+            if (drainingConnections)
+            {
+                return;
+            }
             doAccept();
         });
     }
@@ -213,10 +343,28 @@ class Server
     std::unique_ptr<boost::asio::ip::tcp::acceptor> acceptor;
     boost::asio::signal_set signals;
 
+    // How long a SIGTERM waits for in-flight requests
+    static constexpr std::chrono::seconds drainTimeout{10};
+    boost::asio::steady_timer drainTimer;
+    std::chrono::steady_clock::time_point drainDeadline;
+
+    // Idle timeouts of every connection; declared ahead of pool so it
+    // outlives the connections parked there
+    TimerWheel connectionTimeouts;
+    // Caps open connections, evicting idle keep-alives under pressure
+    ConnectionManager connections;
+
     std::string dateStr;
 
     Handler* handler;
 
     std::shared_ptr<boost::asio::ssl::context> adaptorCtx;
+    bool accepting = false;
+    bool certificateLoading = false;
+    bool certificateReloadPending = false;
+
+    std::shared_ptr<ConnectionPool<Connection<Adaptor, Handler>>> pool =
+        std::make_shared<ConnectionPool<Connection<Adaptor, Handler>>>(
+            bmcwebHttpConnectionPoolSize);
 };
 } // namespace crow
@@ -8,6 +8,8 @@
 #include <boost/beast/core/ostream.hpp>
 #include <boost/beast/http/basic_dynamic_body.hpp>
 
+#include <optional>
+
 namespace crow
 {
 
@@ -18,6 +20,8 @@ struct Connection : std::enable_shared_from_this<Connection>
 {
   public:
     explicit Connection(const crow::Request& reqIn) : req(reqIn) {}
+    // Writes buffer to the client in place; it must stay valid until handler
+    // runs, and only one message may be in flight at a time
     virtual void sendMessage(const boost::asio::mutable_buffer& buffer,
                              std::function<void()> handler) = 0;
     virtual void close() = 0;
@@ -98,16 +102,24 @@ class ConnectionImpl : public Connection
     {
         streamres.addHeader("Content-Length", streamDataSize);
         streamres.addHeader("Content-Type", contentType);
+        doingWrite = true;
         boost::beast::http::async_write(
             adaptor, *streamres.bufferResponse,
             [this, self(shared_from_this())](
                 const boost::system::error_code& ec2, std::size_t) {
+            doingWrite = false;
             if (ec2)
             {
                 BMCWEB_LOG_DEBUG << "Error while writing on socket" << ec2;
                 close();
                 return;
             }
+            if (pendingBuffer)
+            {
+                boost::asio::const_buffer buffer = *pendingBuffer;
+                pendingBuffer.reset();
+                doWrite(buffer);
+            }
         });
     }
 
@@ -117,11 +129,13 @@ class ConnectionImpl : public Connection
         if (buffer.size() != 0)
         {
             this->handlerFunc = handler;
-            auto bytes = boost::asio::buffer_copy(
-                streamres.bufferResponse->body().prepare(buffer.size()),
-                buffer);
-            streamres.bufferResponse->body().commit(bytes);
-            doWrite();
+            if (doingWrite)
+            {
+                // Goes out once the headers have
+                pendingBuffer = buffer;
+                return;
+            }
+            doWrite(buffer);
         }
     }
 
@@ -132,14 +146,14 @@ class ConnectionImpl : public Connection
         closeHandler(*this, completionStatus);
     }
 
-    void doWrite()
+    void doWrite(const boost::asio::const_buffer& buffer)
     {
+        doingWrite = true;
         boost::asio::async_write(
-            adaptor, streamres.bufferResponse->body().data(),
+            adaptor, buffer,
             [this, self(shared_from_this())](boost::beast::error_code ec,
-                                             std::size_t bytesWritten) {
-            streamres.bufferResponse->body().consume(bytesWritten);
-
+                                             std::size_t /*bytesWritten*/) {
+            doingWrite = false;
             if (ec)
             {
                 BMCWEB_LOG_DEBUG << "Error in async_write " << ec;
@@ -154,6 +168,7 @@ class ConnectionImpl : public Connection
     Adaptor adaptor;
     boost::asio::steady_timer waitTimer;
     bool doingWrite = false;
+    std::optional<boost::asio::const_buffer> pendingBuffer;
     std::function<void(Connection&)> openHandler;
     std::function<void(Connection&, const std::string&, bool)> messageHandler;
     std::function<void(Connection&, bool&)> closeHandler;
@@ -0,0 +1,62 @@
+#pragma once
+
+namespace crow
+{
+
+namespace intrusive
+{
+
+// A node of an intrusive circular list; a lone node is its own neighbour
+struct Link
+{
+    Link() = default;
+    Link(const Link&) = delete;
+    Link(Link&&) = delete;
+    Link& operator=(const Link&) = delete;
+    Link& operator=(Link&&) = delete;
+    ~Link() = default;
+
+    bool linked() const
+    {
+        return next != this;
+    }
+
+    void unlink()
+    {
+        prev->next = next;
+        next->prev = prev;
+        prev = this;
+        next = this;
+    }
+
+    // Links this in just before pos, which for a list head is the back
+    void insertBefore(Link& pos)
+    {
+        prev = pos.prev;
+        next = &pos;
+        pos.prev->next = this;
+        pos.prev = this;
+    }
+
+    // Moves every node after head on to the end of this list
+    void takeAll(Link& head)
+    {
+        if (!head.linked())
+        {
+            return;
+        }
+        head.next->prev = prev;
+        head.prev->next = this;
+        prev->next = head.next;
+        prev = head.prev;
+        head.prev = &head;
+        head.next = &head;
+    }
+
+    Link* prev = this;
+    Link* next = this;
+};
+
+} // namespace intrusive
+
+} // namespace crow
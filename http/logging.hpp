@@ -1,12 +1,15 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <cstdio>
 #include <cstdlib>
 #include <ctime>
-#include <filesystem>
 #include <iostream>
-#include <sstream>
+#include <ostream>
+#include <streambuf>
 #include <string>
+#include <string_view>
 
 namespace crow
 {
@@ -19,43 +22,146 @@ enum class LogLevel
     Critical,
 };
 
-class Logger
+// Statements below this level are discarded at compile time.  Builds without
+// BMCWEB_ENABLE_LOGGING only ever run at LogLevel::Error, so there is no
+// reason to carry the code for anything more verbose.
+#ifdef BMCWEB_ENABLE_LOGGING
+constexpr LogLevel compiledLogLevel = LogLevel::Debug;
+#else
+constexpr LogLevel compiledLogLevel = LogLevel::Error;
+#endif
+
+namespace logging
 {
-  private:
-    //
-    static std::string timestamp()
+
+constexpr std::string_view baseName(std::string_view filename)
+{
+    size_t slash = filename.rfind('/');
+    if (slash == std::string_view::npos)
     {
-        std::string date;
-        date.resize(32, '\0');
-        time_t t = time(nullptr);
+        return filename;
+    }
+    return filename.substr(slash + 1);
+}
+
+/**
+ * @brief streambuf over a fixed array.  Output past the end of the array is
+ * dropped rather than growing the buffer.
+ */
+class FixedStreambuf : public std::streambuf
+{
+  public:
+    static constexpr size_t capacity = 1024;
 
-        tm myTm{};
+    FixedStreambuf()
+    {
+        reset();
+    }
 
-        gmtime_r(&t, &myTm);
+    void reset()
+    {
+        truncated = false;
+        // Leave room for the trailing newline appended by finish()
+        setp(data.data(), data.data() + data.size() - 1);
+    }
+
+    std::string_view finish()
+    {
+        *pptr() = '\n';
+        pbump(1);
+        return {pbase(), static_cast<size_t>(pptr() - pbase())};
+    }
+
+    bool isTruncated() const
+    {
+        return truncated;
+    }
+
+  protected:
+    int_type overflow(int_type /*ch*/) override
+    {
+        truncated = true;
+        return traits_type::eof();
+    }
+
+  private:
+    std::array<char, capacity> data{};
+    bool truncated = false;
+};
 
-        size_t sz = strftime(date.data(), date.size(), "%Y-%m-%d %H:%M:%S",
-                             &myTm);
-        date.resize(sz);
-        return date;
+struct ThreadBuffer
+{
+    FixedStreambuf buf;
+    std::ostream stream{&buf};
+    bool inUse = false;
+};
+
+inline ThreadBuffer& getThreadBuffer()
+{
+    thread_local ThreadBuffer buffer;
+    return buffer;
+}
+
+/**
+ * @brief Returns "YYYY-MM-DD HH:MM:SS" for the current time.  The string is
+ * only reformatted when the second changes.
+ */
+inline std::string_view timestamp()
+{
+    thread_local time_t lastSecond = 0;
+    thread_local std::array<char, 32> date{};
+    thread_local size_t dateSize = 0;
+
+    time_t t = time(nullptr);
+    if (t != lastSecond || dateSize == 0)
+    {
+        tm myTm{};
+        gmtime_r(&t, &myTm);
+        dateSize = strftime(date.data(), date.size(), "%Y-%m-%d %H:%M:%S",
+                            &myTm);
+        lastSecond = t;
     }
+    return {date.data(), dateSize};
+}
+
+} // namespace logging
 
+class Logger
+{
   public:
-    Logger([[maybe_unused]] const std::string& prefix,
-           [[maybe_unused]] const std::string& filename,
-           [[maybe_unused]] const size_t line, LogLevel levelIn) :
-        level(levelIn)
+    Logger(std::string_view prefix, std::string_view filename,
+           const size_t line, [[maybe_unused]] LogLevel level)
     {
-        stringstream << "(" << timestamp() << ") [" << prefix << " "
-                     << std::filesystem::path(filename).filename() << ":"
-                     << line << "] ";
+        logging::ThreadBuffer& threadBuffer = logging::getThreadBuffer();
+        if (!threadBuffer.inUse)
+        {
+            // A log statement evaluated while formatting another one (for
+            // example from inside an operator<<) writes straight to stderr
+            // rather than clobbering the buffer in use.
+            threadBuffer.inUse = true;
+            threadBuffer.buf.reset();
+            threadBuffer.stream.clear();
+            buffer = &threadBuffer;
+            stream = &threadBuffer.stream;
+        }
+        *stream << "(" << logging::timestamp() << ") [" << prefix << " \""
+                << logging::baseName(filename) << "\":" << line << "] ";
     }
     ~Logger()
     {
-        if (level >= getCurrentLogLevel())
+        if (buffer == nullptr)
         {
-            stringstream << std::endl;
-            std::cerr << stringstream.str();
+            *stream << std::endl;
+            return;
         }
+        if (buffer->buf.isTruncated())
+        {
+            buffer->stream.clear();
+        }
+        std::string_view out = buffer->buf.finish();
+        std::cerr.write(out.data(), static_cast<std::streamsize>(out.size()));
+        std::cerr.flush();
+        buffer->inUse = false;
     }
 
     Logger(const Logger&) = delete;
@@ -67,14 +173,11 @@ class Logger
     template <typename T>
     Logger& operator<<([[maybe_unused]] const T& value)
     {
-        if (level >= getCurrentLogLevel())
-        {
-            // Somewhere in the code we're implicitly casting an array to a
-            // pointer in logging code.  It's non-trivial to find, so disable
-            // the check here for now
-            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-array-to-pointer-decay)
-            stringstream << value;
-        }
+        // Somewhere in the code we're implicitly casting an array to a
+        // pointer in logging code.  It's non-trivial to find, so disable
+        // the check here for now
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-array-to-pointer-decay)
+        *stream << value;
         return *this;
     }
 
@@ -89,6 +192,11 @@ class Logger
         return getLogLevelRef();
     }
 
+    static bool isEnabled(LogLevel level)
+    {
+        return getCurrentLogLevel() <= level;
+    }
+
   private:
     //
     static LogLevel& getLogLevelRef()
@@ -98,36 +206,36 @@ class Logger
     }
 
     //
-    std::ostringstream stringstream;
-    LogLevel level;
+    logging::ThreadBuffer* buffer = nullptr;
+    std::ostream* stream = &std::cerr;
 };
 } // namespace crow
 
 // The logging functions currently use macros.  Now that we have c++20, ideally
 // they'd use source_location with fixed functions, but for the moment, disable
 // the check.
+//
+// The level is checked before the Logger is constructed, so a statement that
+// is filtered out never evaluates its arguments or formats anything.
+// Statements below crow::compiledLogLevel are removed entirely.
+
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define BMCWEB_LOG_AT(levelName, lvl)                                          \
+    if constexpr (crow::compiledLogLevel <= (lvl))                             \
+        if (crow::Logger::isEnabled(lvl))                                      \
+    crow::Logger(levelName, __FILE__, __LINE__, lvl)
 
 // NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
-#define BMCWEB_LOG_CRITICAL                                                    \
-    if (crow::Logger::getCurrentLogLevel() <= crow::LogLevel::Critical)        \
-    crow::Logger("CRITICAL", __FILE__, __LINE__, crow::LogLevel::Critical)
+#define BMCWEB_LOG_CRITICAL BMCWEB_LOG_AT("CRITICAL", crow::LogLevel::Critical)
 
 // NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
-#define BMCWEB_LOG_ERROR                                                       \
-    if (crow::Logger::getCurrentLogLevel() <= crow::LogLevel::Error)           \
-    crow::Logger("ERROR", __FILE__, __LINE__, crow::LogLevel::Error)
+#define BMCWEB_LOG_ERROR BMCWEB_LOG_AT("ERROR", crow::LogLevel::Error)
 
 // NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
-#define BMCWEB_LOG_WARNING                                                     \
-    if (crow::Logger::getCurrentLogLevel() <= crow::LogLevel::Warning)         \
-    crow::Logger("WARNING", __FILE__, __LINE__, crow::LogLevel::Warning)
+#define BMCWEB_LOG_WARNING BMCWEB_LOG_AT("WARNING", crow::LogLevel::Warning)
 
 // NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
-#define BMCWEB_LOG_INFO                                                        \
-    if (crow::Logger::getCurrentLogLevel() <= crow::LogLevel::Info)            \
-    crow::Logger("INFO", __FILE__, __LINE__, crow::LogLevel::Info)
+#define BMCWEB_LOG_INFO BMCWEB_LOG_AT("INFO", crow::LogLevel::Info)
 
 // NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
-#define BMCWEB_LOG_DEBUG                                                       \
-    if (crow::Logger::getCurrentLogLevel() <= crow::LogLevel::Debug)           \
-    crow::Logger("DEBUG", __FILE__, __LINE__, crow::LogLevel::Debug)
+#define BMCWEB_LOG_DEBUG BMCWEB_LOG_AT("DEBUG", crow::LogLevel::Debug)
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "bmcweb_config.h"
+
+#include "logging.hpp"
+
+#include <malloc.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+namespace crow
+{
+namespace memory
+{
+
+// Responses at least this large release freed heap back to the kernel once
+// written; 0 never does
+constexpr size_t trimThreshold = bmcwebMallocTrimThresholdKb * 1024;
+
+// Trims closer together than this are skipped, so a run of large responses
+// doesn't trim after every one
+constexpr std::chrono::seconds minTrimInterval{1};
+
+struct TrimStats
+{
+    uint64_t trims = 0;
+    uint64_t releasedBytes = 0;
+    std::chrono::steady_clock::time_point lastTrim;
+};
+
+inline TrimStats& getTrimStats()
+{
+    static TrimStats stats;
+    return stats;
+}
+
+// Heap the allocator holds, in use or free, as mallinfo2 reports it
+inline size_t heapBytes()
+{
+    struct mallinfo2 info = mallinfo2();
+    return info.arena + info.hblkhd;
+}
+
+/**
+ * @brief Called once a response of responseBytes has been written.  Large
+ * responses leave the heap at its peak; trimming hands the free pages at the
+ * top of the heap back, so RSS drops again on BMCs short of memory.
+ */
+inline void trimAfterResponse(size_t responseBytes)
+{
+    if (trimThreshold == 0 || responseBytes < trimThreshold)
+    {
+        return;
+    }
+    TrimStats& stats = getTrimStats();
+    std::chrono::steady_clock::time_point now =
+        std::chrono::steady_clock::now();
+    if (stats.trims > 0 && now - stats.lastTrim < minTrimInterval)
+    {
+        return;
+    }
+    stats.lastTrim = now;
+    size_t before = heapBytes();
+    malloc_trim(0);
+    size_t after = heapBytes();
+    stats.trims++;
+    if (before > after)
+    {
+        stats.releasedBytes += before - after;
+    }
+    BMCWEB_LOG_DEBUG << "Trimmed heap after " << responseBytes
+                     << " byte response, " << before << " -> " << after;
+}
+
+// Resident set size of this process, from /proc/self/statm
+inline uint64_t residentBytes()
+{
+    std::ifstream statm("/proc/self/statm");
+    uint64_t sizePages = 0;
+    uint64_t residentPages = 0;
+    statm >> sizePages >> residentPages;
+    long pageSize = sysconf(_SC_PAGESIZE);
+    if (!statm || pageSize <= 0)
+    {
+        return 0;
+    }
+    return residentPages * static_cast<uint64_t>(pageSize);
+}
+
+// Memory counters for /metrics
+inline std::string renderPrometheus()
+{
+    std::string out;
+    auto appendSample = [&out](std::string_view name, std::string_view help,
+                               std::string_view type, uint64_t value) {
+        out += "# HELP ";
+        out += name;
+        out += ' ';
+        out += help;
+        out += "\n# TYPE ";
+        out += name;
+        out += ' ';
+        out += type;
+        out += '\n';
+        out += name;
+        out += ' ';
+        out += std::to_string(value);
+        out += '\n';
+    };
+    struct mallinfo2 info = mallinfo2();
+    const TrimStats& stats = getTrimStats();
+    appendSample("bmcweb_resident_bytes", "Resident set size", "gauge",
+                 residentBytes());
+    appendSample("bmcweb_heap_bytes", "Heap held by the allocator", "gauge",
+                 info.arena + info.hblkhd);
+    appendSample("bmcweb_heap_in_use_bytes", "Heap allocated and not freed",
+                 "gauge", info.uordblks + info.hblkhd);
+    appendSample("bmcweb_heap_free_bytes",
+                 "Heap freed but still held by the allocator", "gauge",
+                 info.fordblks);
+    appendSample("bmcweb_heap_trims_total",
+                 "Times the heap was trimmed after a large response",
+                 "counter", stats.trims);
+    appendSample("bmcweb_heap_trimmed_bytes_total",
+                 "Heap handed back to the kernel by trimming", "counter",
+                 stats.releasedBytes);
+    return out;
+}
+
+} // namespace memory
+} // namespace crow
@@ -157,10 +157,27 @@ class Handler : public std::enable_shared_from_this<Handler>
             }
             std::string_view payload(outputBuffer.data(), bytesRead);
             session->sendBinary(payload);
+            if (readPaused)
+            {
+                readStopped = true;
+                return;
+            }
             doRead();
         });
     }
 
+    // Stops reading from the shell while the websocket has more than it can
+    // send waiting
+    void setCongested(bool congested)
+    {
+        readPaused = congested;
+        if (!readPaused && readStopped)
+        {
+            readStopped = false;
+            doRead();
+        }
+    }
+
     // this has to public
     std::string inputBuffer;
 
@@ -168,6 +185,8 @@ class Handler : public std::enable_shared_from_this<Handler>
     crow::websocket::Connection* session;
     boost::asio::posix::stream_descriptor streamFileDescriptor;
     bool doingWrite{false};
+    bool readPaused{false};
+    bool readStopped{false};
     int ttyFileDescriptor{0};
     pid_t pid{0};
 
@@ -182,6 +201,7 @@ inline void requestRoutes(App& app)
     BMCWEB_ROUTE(app, "/bmc-console")
         .privileges({{"OemIBMPerformService"}})
         .websocket()
+        .permessageDeflate()
         .onopen([](crow::websocket::Connection& conn) {
         BMCWEB_LOG_DEBUG << "Connection " << &conn << " opened";
 
@@ -198,6 +218,13 @@ inline void requestRoutes(App& app)
                 mapHandler.emplace(&conn, std::make_shared<Handler>(&conn));
             if (std::get<bool>(insertData))
             {
+                conn.setBackpressureHandler(64 * 1024, [&conn](bool congested) {
+                    if (auto handler = mapHandler.find(&conn);
+                        handler != mapHandler.end())
+                    {
+                        handler->second->setCongested(congested);
+                    }
+                });
                 std::get<0>(insertData)->second->connect();
             }
         }
@@ -0,0 +1,197 @@
+#pragma once
+
+#include <boost/container/flat_map.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace crow
+{
+namespace profile
+{
+
+// Running totals of one route or D-Bus call, as kept by route_metrics.hpp
+// and dbus_trace.hpp
+struct Counters
+{
+    uint64_t count = 0;
+    std::chrono::microseconds total{0};
+    uint64_t dbusCalls = 0;
+};
+
+// What one route or call did over a window.  name points into the totals
+// it was worked out from.
+struct Usage
+{
+    std::string_view name;
+    Counters counters;
+};
+
+// The busiest routes and calls over a window
+struct Profile
+{
+    // Shorter than asked for when there's no recording that old
+    std::chrono::seconds covered{0};
+    std::vector<Usage> routes;
+    std::vector<Usage> calls;
+};
+
+/**
+ * @brief The totals of every route and D-Bus call, recorded every interval
+ * so what was busiest over any recent window can be worked out by
+ * subtracting an old recording from the current totals.
+ *
+ * Recording only copies counters that already exist, so it can stay on.
+ * Names are kept once each, and a recording only holds what has been used
+ * since startup.
+ */
+class ProfileSampler
+{
+  public:
+    static constexpr std::chrono::seconds interval{30};
+    // Recordings older than this are dropped
+    static constexpr std::chrono::seconds maxWindow{600};
+
+    using Clock = std::chrono::steady_clock;
+    // Totals by name, as passed to record()
+    using Totals = std::vector<std::pair<std::string, Counters>>;
+
+    void record(Clock::time_point now, const Totals& routes,
+                const Totals& calls)
+    {
+        Recording& recording = recordings.emplace_back();
+        recording.at = now;
+        recording.routes = intern(routeNames, routes);
+        recording.calls = intern(callNames, calls);
+        while (recordings.size() > 1 &&
+               now - recordings.front().at > maxWindow + interval)
+        {
+            recordings.pop_front();
+        }
+    }
+
+    /**
+     * @brief The routes and calls most used since now - window, by time
+     * spent, at most top of each
+     */
+    Profile hottest(Clock::time_point now, std::chrono::seconds window,
+                    size_t top, const Totals& routes,
+                    const Totals& calls) const
+    {
+        const Recording* from = nullptr;
+        for (const Recording& recording : recordings)
+        {
+            if (from != nullptr && now - recording.at < window)
+            {
+                break;
+            }
+            from = &recording;
+        }
+        Profile profile;
+        if (from == nullptr)
+        {
+            profile.routes = difference(routes, routeNames, nullptr, top);
+            profile.calls = difference(calls, callNames, nullptr, top);
+            return profile;
+        }
+        profile.covered =
+            std::chrono::duration_cast<std::chrono::seconds>(now - from->at);
+        profile.routes = difference(routes, routeNames, &from->routes, top);
+        profile.calls = difference(calls, callNames, &from->calls, top);
+        return profile;
+    }
+
+  private:
+    using Interned = boost::container::flat_map<size_t, Counters>;
+
+    struct Recording
+    {
+        Clock::time_point at;
+        Interned routes;
+        Interned calls;
+    };
+
+    // Each name seen, and the index recordings know it by
+    struct Names
+    {
+        boost::container::flat_map<std::string, size_t, std::less<>> indexes;
+
+        size_t indexOf(std::string_view name)
+        {
+            auto it = indexes.find(name);
+            if (it != indexes.end())
+            {
+                return it->second;
+            }
+            size_t index = indexes.size();
+            indexes.emplace(std::string(name), index);
+            return index;
+        }
+    };
+
+    static Interned intern(Names& names, const Totals& totals)
+    {
+        Interned interned;
+        for (const auto& [name, counters] : totals)
+        {
+            if (counters.count != 0)
+            {
+                interned.emplace(names.indexOf(name), counters);
+            }
+        }
+        return interned;
+    }
+
+    static std::vector<Usage> difference(const Totals& current,
+                                         const Names& names,
+                                         const Interned* before, size_t top)
+    {
+        std::vector<Usage> used;
+        for (const auto& [name, counters] : current)
+        {
+            Counters delta = counters;
+            if (before != nullptr)
+            {
+                auto index = names.indexes.find(name);
+                if (index != names.indexes.end())
+                {
+                    auto old = before->find(index->second);
+                    if (old != before->end())
+                    {
+                        delta.count -= old->second.count;
+                        delta.total -= old->second.total;
+                        delta.dbusCalls -= old->second.dbusCalls;
+                    }
+                }
+            }
+            if (delta.count != 0)
+            {
+                used.push_back({name, delta});
+            }
+        }
+        std::sort(used.begin(), used.end(),
+                  [](const Usage& lhs, const Usage& rhs) {
+            return lhs.counters.total > rhs.counters.total;
+        });
+        if (used.size() > top)
+        {
+            used.resize(top);
+        }
+        return used;
+    }
+
+    std::deque<Recording> recordings;
+    Names routeNames;
+    Names callNames;
+};
+
+} // namespace profile
+} // namespace crow
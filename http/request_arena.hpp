@@ -0,0 +1,112 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+
+namespace crow
+{
+
+/**
+ * @brief Monotonic memory for the objects a connection allocates per
+ * request, rewound in one step when the connection goes back to reading.
+ *
+ * The first initialSize bytes live inside the arena itself, so a connection
+ * that serves the same kind of request over and over stops calling malloc
+ * for them.  Blocks aren't freed one at a time; the arena counts the ones
+ * outstanding and only rewinds once none are, so an object that outlives its
+ * request (a handler still holding an AsyncResp) keeps its space.  The arena
+ * is itself kept alive by the ArenaAllocators that point at it.
+ */
+class RequestArena
+{
+  public:
+    static constexpr size_t initialSize = 2048;
+
+    RequestArena() : resource(initial.data(), initial.size()) {}
+
+    RequestArena(const RequestArena&) = delete;
+    RequestArena(RequestArena&&) = delete;
+    RequestArena& operator=(const RequestArena&) = delete;
+    RequestArena& operator=(RequestArena&&) = delete;
+    ~RequestArena() = default;
+
+    void* allocate(size_t bytes, size_t alignment)
+    {
+        void* block = resource.allocate(bytes, alignment);
+        outstanding++;
+        return block;
+    }
+
+    void deallocate(void* /*block*/, size_t /*bytes*/, size_t /*alignment*/)
+    {
+        outstanding--;
+    }
+
+    // Rewinds to the start of the arena.  Returns false, leaving it as is,
+    // while any block is still in use.
+    bool reset()
+    {
+        if (outstanding != 0)
+        {
+            return false;
+        }
+        resource.release();
+        return true;
+    }
+
+    size_t outstandingBlocks() const
+    {
+        return outstanding;
+    }
+
+  private:
+    alignas(std::max_align_t) std::array<std::byte, initialSize> initial{};
+    std::pmr::monotonic_buffer_resource resource;
+    size_t outstanding = 0;
+};
+
+// Allocator over a shared RequestArena, e.g. for std::allocate_shared
+template <typename T>
+class ArenaAllocator
+{
+  public:
+    using value_type = T;
+
+    explicit ArenaAllocator(std::shared_ptr<RequestArena> arenaIn) :
+        arena(std::move(arenaIn))
+    {}
+
+    template <typename U>
+    explicit ArenaAllocator(const ArenaAllocator<U>& other) :
+        arena(other.getArena())
+    {}
+
+    T* allocate(size_t n)
+    {
+        return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* block, size_t n)
+    {
+        arena->deallocate(block, n * sizeof(T), alignof(T));
+    }
+
+    const std::shared_ptr<RequestArena>& getArena() const
+    {
+        return arena;
+    }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const
+    {
+        return arena == other.getArena();
+    }
+
+  private:
+    std::shared_ptr<RequestArena> arena;
+};
+
+} // namespace crow
@@ -0,0 +1,221 @@
+#pragma once
+
+#include "http_response.hpp"
+#include "logging.hpp"
+
+#include <boost/beast/http/status.hpp>
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace crow
+{
+
+/**
+ * @brief Short-lived copies of GET responses, for routes that opt in with
+ * cacheFor(), so identical requests polled at the same moment run the handler
+ * once.
+ *
+ * Entries are keyed on the request target, the role the request is handled
+ * as and its Accept-Encoding, so a route should only opt in if its response
+ * depends on nothing else.  While a request for a key is being handled, the
+ * same request for it waits for that response instead of running the handler
+ * again.  Only complete 200 responses are kept or shared; the requests that
+ * waited on any other get handled on their own.  Every request that may
+ * change something invalidates the cache as it starts and again as it
+ * completes, and a response started before an invalidation isn't kept.
+ */
+class ResponseCache
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t maxEntries = 64;
+
+    // A response as it was when its handler completed
+    struct Entry
+    {
+        Response::response_type message;
+        nlohmann::json json;
+        Clock::time_point expires;
+    };
+
+    // Called with the response to copy once the request waited on completes,
+    // or nullptr if it can't be shared and the request has to be handled
+    using Waiter = std::function<void(const Entry*)>;
+
+    static ResponseCache& getInstance()
+    {
+        static ResponseCache cache;
+        return cache;
+    }
+
+    static std::string makeKey(std::string_view target, std::string_view role,
+                               std::string_view acceptEncoding)
+    {
+        std::string key(role);
+        key += '|';
+        key += acceptEncoding;
+        key += '|';
+        key += target;
+        return key;
+    }
+
+    // Copies a cached response into res
+    static void fill(const Entry& entry, Response& res)
+    {
+        res.result(entry.message.result());
+        for (const auto& field : entry.message.base())
+        {
+            res.addHeader(field.name_string(), field.value());
+        }
+        res.body() = entry.message.body();
+        res.jsonValue = entry.json;
+    }
+
+    // Fills res from the entry for key, if it's still fresh at now
+    bool serve(const std::string& key, Clock::time_point now, Response& res)
+    {
+        auto it = entries.find(key);
+        if (it == entries.end())
+        {
+            return false;
+        }
+        if (it->second.expires <= now)
+        {
+            order.remove(key);
+            entries.erase(it);
+            return false;
+        }
+        BMCWEB_LOG_DEBUG << "Serving cached response for " << key;
+        fill(it->second, res);
+        return true;
+    }
+
+    // Has waiter called once the request already being handled for key
+    // completes.  Returns false if there's no such request.
+    bool join(const std::string& key, Waiter&& waiter)
+    {
+        auto it = inFlight.find(key);
+        if (it == inFlight.end())
+        {
+            return false;
+        }
+        it->second.waiters.emplace_back(std::move(waiter));
+        return true;
+    }
+
+    // Records that a request for key is being handled; complete() must
+    // follow once its response is ready
+    void start(const std::string& key)
+    {
+        inFlight.try_emplace(key, InFlight{generation, {}});
+    }
+
+    // Keeps res under key until ttl past now, if it can be shared, and
+    // passes it to the requests waiting on key
+    void complete(const std::string& key, std::chrono::milliseconds ttl,
+                  Clock::time_point now, const Response& res)
+    {
+        auto it = inFlight.find(key);
+        if (it == inFlight.end())
+        {
+            return;
+        }
+        InFlight done = std::move(it->second);
+        inFlight.erase(it);
+
+        bool shareable = res.result() == boost::beast::http::status::ok &&
+                         !res.hasFileBody() && !res.hasBodyGenerator();
+        if (!shareable)
+        {
+            for (Waiter& waiter : done.waiters)
+            {
+                waiter(nullptr);
+            }
+            return;
+        }
+        Entry entry{*res.stringResponse, res.jsonValue, now + ttl};
+        for (Waiter& waiter : done.waiters)
+        {
+            waiter(&entry);
+        }
+        if (done.generation == generation)
+        {
+            insert(key, std::move(entry));
+        }
+    }
+
+    // Ends the request being handled for key without keeping or sharing
+    // its response, as when its client went away and the handler may have
+    // stopped part way.  The requests waiting on it get handled on their own.
+    void abandon(const std::string& key)
+    {
+        auto it = inFlight.find(key);
+        if (it == inFlight.end())
+        {
+            return;
+        }
+        InFlight done = std::move(it->second);
+        inFlight.erase(it);
+        for (Waiter& waiter : done.waiters)
+        {
+            waiter(nullptr);
+        }
+    }
+
+    // Drops every entry, and keeps the responses of requests already being
+    // handled from being added
+    void invalidate()
+    {
+        entries.clear();
+        order.clear();
+        generation++;
+    }
+
+    size_t size() const
+    {
+        return entries.size();
+    }
+
+  private:
+    struct InFlight
+    {
+        uint64_t generation = 0;
+        std::vector<Waiter> waiters;
+    };
+
+    void insert(const std::string& key, Entry&& entry)
+    {
+        auto it = entries.find(key);
+        if (it != entries.end())
+        {
+            it->second = std::move(entry);
+            return;
+        }
+        while (entries.size() >= maxEntries && !order.empty())
+        {
+            entries.erase(order.front());
+            order.pop_front();
+        }
+        entries.emplace(key, std::move(entry));
+        order.push_back(key);
+    }
+
+    std::unordered_map<std::string, Entry> entries;
+    // Keys in the order they were added, oldest first
+    std::list<std::string> order;
+    std::unordered_map<std::string, InFlight> inFlight;
+    uint64_t generation = 0;
+};
+
+} // namespace crow
@@ -0,0 +1,237 @@
+#pragma once
+
+#include <boost/container/flat_map.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace crow
+{
+
+/**
+ * @brief Request latencies counted into fixed 1-2.5-5 buckets, from 100us
+ * to 10s, plus one for anything slower.  Recording is a short search over
+ * a constant table, so it can stay on for every request.
+ */
+class LatencyHistogram
+{
+  public:
+    // Upper bounds of each bucket, in microseconds
+    static constexpr std::array<uint64_t, 16> bounds = {
+        100,    250,    500,     1000,    2500,    5000,    10000,   25000,
+        50000,  100000, 250000,  500000,  1000000, 2500000, 5000000, 10000000};
+
+    void observe(std::chrono::microseconds latency)
+    {
+        uint64_t us = static_cast<uint64_t>(std::max<int64_t>(
+            0, static_cast<int64_t>(latency.count())));
+        size_t bucket = static_cast<size_t>(
+            std::lower_bound(bounds.begin(), bounds.end(), us) -
+            bounds.begin());
+        counts[bucket]++;
+        sumUs += us;
+    }
+
+    // Count in bucket index; index bounds.size() holds everything slower
+    uint64_t bucketCount(size_t index) const
+    {
+        return counts[index];
+    }
+
+    uint64_t sumMicroseconds() const
+    {
+        return sumUs;
+    }
+
+  private:
+    std::array<uint64_t, bounds.size() + 1> counts{};
+    uint64_t sumUs = 0;
+};
+
+// Counters for one route, updated once a response has been sent
+struct RouteMetrics
+{
+    LatencyHistogram latency;
+    uint64_t requests = 0;
+    uint64_t bytesIn = 0;
+    uint64_t bytesOut = 0;
+    uint64_t dbusCalls = 0;
+    boost::container::flat_map<unsigned, uint64_t> statusCodes;
+
+    void record(std::chrono::microseconds elapsed, unsigned status,
+                size_t received, size_t sent, uint64_t calls)
+    {
+        latency.observe(elapsed);
+        requests++;
+        bytesIn += received;
+        bytesOut += sent;
+        dbusCalls += calls;
+        statusCodes[status]++;
+    }
+};
+
+namespace metrics
+{
+
+// One rule's counters, labelled with its pattern and the methods it serves
+struct RouteSeries
+{
+    std::string_view route;
+    std::string methods;
+    const RouteMetrics* metrics = nullptr;
+};
+
+inline void appendLabelValue(std::string& out, std::string_view value)
+{
+    for (char c : value)
+    {
+        if (c == '\\' || c == '"')
+        {
+            out += '\\';
+            out += c;
+        }
+        else if (c == '\n')
+        {
+            out += "\\n";
+        }
+        else
+        {
+            out += c;
+        }
+    }
+}
+
+inline void appendSample(std::string& out, std::string_view name,
+                         const RouteSeries& series,
+                         std::string_view extraLabel,
+                         std::string_view extraValue, std::string_view value)
+{
+    out += name;
+    out += "{route=\"";
+    appendLabelValue(out, series.route);
+    out += "\",method=\"";
+    out += series.methods;
+    out += '"';
+    if (!extraLabel.empty())
+    {
+        out += ',';
+        out += extraLabel;
+        out += "=\"";
+        out += extraValue;
+        out += '"';
+    }
+    out += "} ";
+    out += value;
+    out += '\n';
+}
+
+inline std::string formatSeconds(uint64_t microseconds)
+{
+    std::string seconds = std::to_string(microseconds / 1000000);
+    uint64_t fraction = microseconds % 1000000;
+    if (fraction != 0)
+    {
+        std::string digits = std::to_string(fraction);
+        seconds += '.';
+        seconds.append(6 - digits.size(), '0');
+        seconds += digits;
+        while (seconds.back() == '0')
+        {
+            seconds.pop_back();
+        }
+    }
+    return seconds;
+}
+
+/**
+ * @brief Renders the metrics of every route that has served a request in
+ * the Prometheus text exposition format.
+ *
+ * @param[in] routes  Every rule, as returned by Router::getRouteMetrics()
+ */
+inline std::string renderPrometheus(std::span<const RouteSeries> routes)
+{
+    std::string out;
+    out += "# HELP bmcweb_http_request_duration_seconds Time from reading a "
+           "request to finishing its response\n"
+           "# TYPE bmcweb_http_request_duration_seconds histogram\n";
+    for (const RouteSeries& series : routes)
+    {
+        const RouteMetrics* metrics = series.metrics;
+        if (metrics->requests == 0)
+        {
+            continue;
+        }
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < LatencyHistogram::bounds.size(); i++)
+        {
+            cumulative += metrics->latency.bucketCount(i);
+            appendSample(out, "bmcweb_http_request_duration_seconds_bucket",
+                         series, "le",
+                         formatSeconds(LatencyHistogram::bounds[i]),
+                         std::to_string(cumulative));
+        }
+        appendSample(out, "bmcweb_http_request_duration_seconds_bucket",
+                     series, "le", "+Inf", std::to_string(metrics->requests));
+        appendSample(out, "bmcweb_http_request_duration_seconds_sum", series,
+                     "", "",
+                     formatSeconds(metrics->latency.sumMicroseconds()));
+        appendSample(out, "bmcweb_http_request_duration_seconds_count",
+                     series, "", "", std::to_string(metrics->requests));
+    }
+
+    out += "# HELP bmcweb_http_responses_total Responses sent, by status\n"
+           "# TYPE bmcweb_http_responses_total counter\n";
+    for (const RouteSeries& series : routes)
+    {
+        for (const auto& [status, count] : series.metrics->statusCodes)
+        {
+            appendSample(out, "bmcweb_http_responses_total", series, "code",
+                         std::to_string(status), std::to_string(count));
+        }
+    }
+
+    out += "# HELP bmcweb_http_request_bytes_total Request bytes read\n"
+           "# TYPE bmcweb_http_request_bytes_total counter\n";
+    for (const RouteSeries& series : routes)
+    {
+        if (series.metrics->requests != 0)
+        {
+            appendSample(out, "bmcweb_http_request_bytes_total", series, "", "",
+                         std::to_string(series.metrics->bytesIn));
+        }
+    }
+
+    out += "# HELP bmcweb_http_response_bytes_total Response bytes written\n"
+           "# TYPE bmcweb_http_response_bytes_total counter\n";
+    for (const RouteSeries& series : routes)
+    {
+        if (series.metrics->requests != 0)
+        {
+            appendSample(out, "bmcweb_http_response_bytes_total", series, "",
+                         "", std::to_string(series.metrics->bytesOut));
+        }
+    }
+
+    out += "# HELP bmcweb_http_dbus_calls_total D-Bus calls made while "
+           "handling requests\n"
+           "# TYPE bmcweb_http_dbus_calls_total counter\n";
+    for (const RouteSeries& series : routes)
+    {
+        if (series.metrics->requests != 0)
+        {
+            appendSample(out, "bmcweb_http_dbus_calls_total", series, "", "",
+                         std::to_string(series.metrics->dbusCalls));
+        }
+    }
+    return out;
+}
+
+} // namespace metrics
+} // namespace crow
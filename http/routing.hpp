@@ -8,22 +8,32 @@
 #include "http_stream.hpp"
 #include "logging.hpp"
 #include "privileges.hpp"
+#include "response_cache.hpp"
+#include "route_metrics.hpp"
 #include "sessions.hpp"
+#include "tracepoints.hpp"
 #include "utility.hpp"
 #include "verb.hpp"
 #include "websocket.hpp"
 
 #include <async_resp.hpp>
+#include <boost/beast/core/static_string.hpp>
 #include <boost/beast/ssl/ssl_stream.hpp>
 #include <boost/container/flat_map.hpp>
 
+#include <array>
 #include <cerrno>
+#include <chrono>
 #include <cstdint>
 #include <cstdlib>
+#include <functional>
 #include <limits>
 #include <memory>
 #include <optional>
+#include <string>
+#include <string_view>
 #include <tuple>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -77,23 +87,9 @@ class BaseRule
         return methodsBitfield;
     }
 
-    bool checkPrivileges(const redfish::Privileges& userPrivileges)
+    bool checkPrivileges(redfish::UserRoleId role) const
     {
-        // If there are no privileges assigned, assume no privileges
-        // required
-        if (privilegesSet.empty())
-        {
-            return true;
-        }
-
-        for (const redfish::Privileges& requiredPrivileges : privilegesSet)
-        {
-            if (userPrivileges.isSupersetOf(requiredPrivileges))
-            {
-                return true;
-            }
-        }
-        return false;
+        return (allowedRoles & (1U << static_cast<size_t>(role))) != 0;
     }
 
     size_t methodsBitfield{1 << static_cast<size_t>(HttpVerb::Get)};
@@ -102,10 +98,21 @@ class BaseRule
                   "Not enough bits to store bitfield");
 
     std::vector<redfish::Privileges> privilegesSet;
+    // privilegesSet, worked out for each role by Router::validate()
+    redfish::UserRoleMask allowedRoles = 0;
 
     std::string rule;
     std::string nameStr;
 
+    RouteMetrics metrics;
+
+    // How long a GET response is kept in the ResponseCache; zero to not use it
+    std::chrono::milliseconds cacheTtl{0};
+
+    // Request bodies are streamed to a file instead of held in memory; see
+    // UploadFile
+    bool isFileUpload = false;
+
     std::unique_ptr<BaseRule> ruleToUpgrade;
 
     friend class Router;
@@ -353,7 +360,7 @@ class WebSocketRule : public BaseRule
             myConnection = std::make_shared<
                 crow::websocket::ConnectionImpl<boost::asio::ip::tcp::socket>>(
                 req, std::move(adaptor), openHandler, messageHandler,
-                messageExHandler, closeHandler, errorHandler);
+                messageExHandler, closeHandler, errorHandler, deflate);
         myConnection->start();
     }
 #ifdef BMCWEB_ENABLE_SSL
@@ -368,7 +375,7 @@ class WebSocketRule : public BaseRule
             myConnection = std::make_shared<crow::websocket::ConnectionImpl<
                 boost::beast::ssl_stream<boost::asio::ip::tcp::socket>>>(
                 req, std::move(adaptor), openHandler, messageHandler,
-                messageExHandler, closeHandler, errorHandler);
+                messageExHandler, closeHandler, errorHandler, deflate);
         myConnection->start();
     }
 #endif
@@ -408,6 +415,14 @@ class WebSocketRule : public BaseRule
         return *this;
     }
 
+    // Offers permessage-deflate to clients of this route.  Routes sending
+    // data that is already compressed, like KVM, are better off without it.
+    self_t& permessageDeflate()
+    {
+        deflate = true;
+        return *this;
+    }
+
   protected:
     std::function<void(crow::websocket::Connection&)> openHandler;
     std::function<void(crow::websocket::Connection&, const std::string&, bool)>
@@ -419,6 +434,7 @@ class WebSocketRule : public BaseRule
     std::function<void(crow::websocket::Connection&, const std::string&)>
         closeHandler;
     std::function<void(crow::websocket::Connection&)> errorHandler;
+    bool deflate = false;
 };
 
 class StreamingResponseRule : public BaseRule
@@ -565,6 +581,22 @@ struct RuleParameterTraits
         return *self;
     }
 
+    // Keeps GET responses for ttl, for routes whose response depends only on
+    // the URL and the role of the user; see ResponseCache
+    self_t& cacheFor(std::chrono::milliseconds ttl)
+    {
+        self_t* self = static_cast<self_t*>(this);
+        self->cacheTtl = ttl;
+        return *self;
+    }
+
+    self_t& fileUpload()
+    {
+        self_t* self = static_cast<self_t*>(this);
+        self->isFileUpload = true;
+        return *self;
+    }
+
     self_t& notFound()
     {
         self_t* self = static_cast<self_t*>(this);
@@ -876,10 +908,40 @@ class Trie
         optimizeNode(head());
     }
 
+    // Precomputes the trie result for every route without parameters, so
+    // that a request for exactly that url skips the trie walk.  Entries are
+    // taken from find() itself, which keeps the lowest-rule-index-wins
+    // semantics intact when a parameterized route also matches.
+    void buildStaticRoutes()
+    {
+        staticRoutes.clear();
+        staticRoutes.reserve(staticUrls.size());
+        for (const std::string& url : staticUrls)
+        {
+            std::pair<unsigned, RoutingParams> found = findInTrie(url);
+            const RoutingParams& params = found.second;
+            if (found.first == 0U || !params.intParams.empty() ||
+                !params.uintParams.empty() || !params.doubleParams.empty() ||
+                !params.stringParams.empty())
+            {
+                continue;
+            }
+            staticRoutes.emplace(url, found.first);
+        }
+    }
+
   public:
     void validate()
     {
         optimize();
+        buildStaticRoutes();
+    }
+
+    // Makes room for rules more routes, each of which is added with and
+    // without its trailing slash
+    void reserve(size_t rules)
+    {
+        staticUrls.reserve(staticUrls.size() + rules * 2);
     }
 
     void findRouteIndexes(const std::string& reqUrl,
@@ -915,9 +977,19 @@ class Trie
         }
     }
 
+    std::pair<unsigned, RoutingParams> find(const std::string_view reqUrl) const
+    {
+        auto staticRoute = staticRoutes.find(reqUrl);
+        if (staticRoute != staticRoutes.end())
+        {
+            return {staticRoute->second, {}};
+        }
+        return findInTrie(reqUrl);
+    }
+
     std::pair<unsigned, RoutingParams>
-        find(const std::string_view reqUrl, const Node* node = nullptr,
-             size_t pos = 0, RoutingParams* params = nullptr) const
+        findInTrie(const std::string_view reqUrl, const Node* node = nullptr,
+                   size_t pos = 0, RoutingParams* params = nullptr) const
     {
         RoutingParams empty;
         if (params == nullptr)
@@ -958,11 +1030,11 @@ class Trie
                 if (errno != ERANGE && eptr != reqUrl.data() + pos)
                 {
                     params->intParams.push_back(value);
-                    std::pair<unsigned, RoutingParams> ret =
-                        find(reqUrl,
-                             &nodes[node->paramChildrens[static_cast<size_t>(
-                                 ParamType::INT)]],
-                             static_cast<size_t>(eptr - reqUrl.data()), params);
+                    std::pair<unsigned, RoutingParams> ret = findInTrie(
+                        reqUrl,
+                        &nodes[node->paramChildrens[static_cast<size_t>(
+                            ParamType::INT)]],
+                        static_cast<size_t>(eptr - reqUrl.data()), params);
                     updateFound(ret);
                     params->intParams.pop_back();
                 }
@@ -981,11 +1053,11 @@ class Trie
                 if (errno != ERANGE && eptr != reqUrl.data() + pos)
                 {
                     params->uintParams.push_back(value);
-                    std::pair<unsigned, RoutingParams> ret =
-                        find(reqUrl,
-                             &nodes[node->paramChildrens[static_cast<size_t>(
-                                 ParamType::UINT)]],
-                             static_cast<size_t>(eptr - reqUrl.data()), params);
+                    std::pair<unsigned, RoutingParams> ret = findInTrie(
+                        reqUrl,
+                        &nodes[node->paramChildrens[static_cast<size_t>(
+                            ParamType::UINT)]],
+                        static_cast<size_t>(eptr - reqUrl.data()), params);
                     updateFound(ret);
                     params->uintParams.pop_back();
                 }
@@ -1003,11 +1075,11 @@ class Trie
                 if (errno != ERANGE && eptr != reqUrl.data() + pos)
                 {
                     params->doubleParams.push_back(value);
-                    std::pair<unsigned, RoutingParams> ret =
-                        find(reqUrl,
-                             &nodes[node->paramChildrens[static_cast<size_t>(
-                                 ParamType::DOUBLE)]],
-                             static_cast<size_t>(eptr - reqUrl.data()), params);
+                    std::pair<unsigned, RoutingParams> ret = findInTrie(
+                        reqUrl,
+                        &nodes[node->paramChildrens[static_cast<size_t>(
+                            ParamType::DOUBLE)]],
+                        static_cast<size_t>(eptr - reqUrl.data()), params);
                     updateFound(ret);
                     params->doubleParams.pop_back();
                 }
@@ -1029,11 +1101,11 @@ class Trie
             {
                 params->stringParams.emplace_back(
                     reqUrl.substr(pos, epos - pos));
-                std::pair<unsigned, RoutingParams> ret =
-                    find(reqUrl,
-                         &nodes[node->paramChildrens[static_cast<size_t>(
-                             ParamType::STRING)]],
-                         epos, params);
+                std::pair<unsigned, RoutingParams> ret = findInTrie(
+                    reqUrl,
+                    &nodes[node->paramChildrens[static_cast<size_t>(
+                        ParamType::STRING)]],
+                    epos, params);
                 updateFound(ret);
                 params->stringParams.pop_back();
             }
@@ -1047,11 +1119,11 @@ class Trie
             {
                 params->stringParams.emplace_back(
                     reqUrl.substr(pos, epos - pos));
-                std::pair<unsigned, RoutingParams> ret =
-                    find(reqUrl,
-                         &nodes[node->paramChildrens[static_cast<size_t>(
-                             ParamType::PATH)]],
-                         epos, params);
+                std::pair<unsigned, RoutingParams> ret = findInTrie(
+                    reqUrl,
+                    &nodes[node->paramChildrens[static_cast<size_t>(
+                        ParamType::PATH)]],
+                    epos, params);
                 updateFound(ret);
                 params->stringParams.pop_back();
             }
@@ -1065,7 +1137,7 @@ class Trie
             if (reqUrl.compare(pos, fragment.size(), fragment) == 0)
             {
                 std::pair<unsigned, RoutingParams> ret =
-                    find(reqUrl, child, pos + fragment.size(), params);
+                    findInTrie(reqUrl, child, pos + fragment.size(), params);
                 updateFound(ret);
             }
         }
@@ -1077,6 +1149,14 @@ class Trie
     {
         size_t idx = 0;
 
+        // The static table is rebuilt by validate(); until then every lookup
+        // goes through the trie.
+        staticRoutes.clear();
+        if (url.find('<') == std::string::npos)
+        {
+            staticUrls.push_back(url);
+        }
+
         for (unsigned i = 0; i < url.size(); i++)
         {
             char c = url[i];
@@ -1113,13 +1193,18 @@ class Trie
             }
             else
             {
-                std::string piece(&c, 1);
-                if (nodes[idx].children.count(piece) == 0U)
+                std::string_view piece(&c, 1);
+                auto child = nodes[idx].children.find(piece);
+                if (child == nodes[idx].children.end())
                 {
                     unsigned newNodeIdx = newNode();
                     nodes[idx].children.emplace(piece, newNodeIdx);
+                    idx = newNodeIdx;
+                }
+                else
+                {
+                    idx = child->second;
                 }
-                idx = nodes[idx].children[piece];
             }
         }
         if (nodes[idx].ruleIndex != 0U)
@@ -1195,7 +1280,20 @@ class Trie
         return static_cast<unsigned>(nodes.size() - 1);
     }
 
+    struct StringViewHash
+    {
+        using is_transparent = void;
+
+        size_t operator()(std::string_view str) const
+        {
+            return std::hash<std::string_view>{}(str);
+        }
+    };
+
     std::vector<Node> nodes;
+    std::vector<std::string> staticUrls;
+    std::unordered_map<std::string, unsigned, StringViewHash, std::equal_to<>>
+        staticRoutes;
 };
 
 class Router
@@ -1256,6 +1354,29 @@ class Router
 
     void validate()
     {
+        // Size each method's tables up front rather than growing them one
+        // rule at a time
+        std::array<size_t, std::tuple_size_v<decltype(perMethods)>> counts{};
+        for (const std::unique_ptr<BaseRule>& rule : allRules)
+        {
+            if (!rule)
+            {
+                continue;
+            }
+            for (size_t method = 0; method < counts.size(); method++)
+            {
+                if ((rule->methodsBitfield & (size_t{1} << method)) > 0U)
+                {
+                    counts[method]++;
+                }
+            }
+        }
+        for (size_t method = 0; method < counts.size(); method++)
+        {
+            perMethods[method].rules.reserve(counts[method]);
+            perMethods[method].trie.reserve(counts[method]);
+        }
+
         for (std::unique_ptr<BaseRule>& rule : allRules)
         {
             if (rule)
@@ -1266,6 +1387,8 @@ class Router
                     rule = std::move(upgraded);
                 }
                 rule->validate();
+                rule->allowedRoles =
+                    redfish::getAllowedUserRoles(rule->privilegesSet);
                 internalAddRuleObject(rule->rule, rule.get());
             }
         }
@@ -1283,7 +1406,8 @@ class Router
 
     struct FindRouteResponse
     {
-        std::string allowHeader;
+        // Long enough for every verb
+        boost::beast::static_string<64> allowHeader;
         FindRoute route;
     };
 
@@ -1337,7 +1461,8 @@ class Router
                 findRoute.allowHeader += ", ";
             }
             HttpVerb thisVerb = static_cast<HttpVerb>(perMethodIndex);
-            findRoute.allowHeader += httpVerbToString(thisVerb);
+            std::string_view verbName = httpVerbToString(thisVerb);
+            findRoute.allowHeader.append(verbName.data(), verbName.size());
             if (perMethodIndex == reqMethodIndex)
             {
                 findRoute.route = route;
@@ -1346,6 +1471,21 @@ class Router
         return findRoute;
     }
 
+    // Whether the route a request for target would reach wants its body as
+    // an UploadFile.  Called once the headers are in, before the body is read.
+    bool isFileUpload(boost::beast::http::verb method,
+                      std::string_view target) const
+    {
+        std::optional<HttpVerb> verb = httpVerbFromBoost(method);
+        if (!verb)
+        {
+            return false;
+        }
+        std::string_view path = target.substr(0, target.find('?'));
+        FindRoute route = findRouteByIndex(path, static_cast<size_t>(*verb));
+        return route.rule != nullptr && route.rule->isFileUpload;
+    }
+
     template <typename Adaptor>
     void handleUpgrade(const Request& req,
                        const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
@@ -1425,8 +1565,10 @@ class Router
         // Fill in the allow header if it's valid
         if (!foundRoute.allowHeader.empty())
         {
-            asyncResp->res.addHeader(boost::beast::http::field::allow,
-                                     foundRoute.allowHeader);
+            asyncResp->res.addHeader(
+                boost::beast::http::field::allow,
+                std::string_view(foundRoute.allowHeader.data(),
+                                 foundRoute.allowHeader.size()));
         }
 
         // If we couldn't find a real route or a 404 route, return a generic
@@ -1451,10 +1593,26 @@ class Router
         BMCWEB_LOG_DEBUG << "Matched rule '" << rule.rule << "' "
                          << static_cast<uint32_t>(*verb) << " / "
                          << rule.getMethods();
+        req.routeMetrics = &rule.metrics;
+        req.route = rule.rule;
+        BMCWEB_TRACEPOINT2(route_matched, &req, rule.rule.c_str());
 
         if (req.session == nullptr)
         {
-            rule.handle(req, asyncResp, params);
+            dispatch(req, asyncResp, rule, params, "");
+            return;
+        }
+
+        const std::optional<persistent_data::UserSession::UserInfo>& cached =
+            req.session->userInfo;
+        if (cached && std::chrono::steady_clock::now() - cached->fetched <
+                          persistent_data::userInfoCacheTimeout)
+        {
+            BMCWEB_LOG_DEBUG << "Using cached user info for "
+                             << req.session->username;
+            std::string userRole = cached->userRole;
+            afterGetUserInfo(req, asyncResp, rule, params, userRole,
+                             cached->roleId, cached->passwordExpired);
             return;
         }
         std::string username = req.session->username;
@@ -1526,42 +1684,143 @@ class Router
                 passwordExpired = false;
             }
 
-            // Get the user's privileges from the role
-            redfish::Privileges userPrivileges =
-                redfish::getUserPrivileges(userRole);
+            redfish::UserRoleId roleId = redfish::getUserRoleId(userRole);
+
+            // Only sessions that outlive this request benefit from caching
+            if (req.session->persistence ==
+                persistent_data::PersistenceType::TIMEOUT)
+            {
+                req.session->userInfo = persistent_data::UserSession::UserInfo{
+                    userRole, roleId, *passwordExpired,
+                    std::chrono::steady_clock::now()};
+            }
+
+            afterGetUserInfo(req, asyncResp, rule, params, userRole, roleId,
+                             *passwordExpired);
+        },
+            "xyz.openbmc_project.User.Manager", "/xyz/openbmc_project/user",
+            "xyz.openbmc_project.User.Manager", "GetUserInfo", username);
+    }
+
+    static void
+        afterGetUserInfo(Request& req,
+                         const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+                         BaseRule& rule, RoutingParams& params,
+                         const std::string& userRole,
+                         redfish::UserRoleId roleId, bool passwordExpired)
+    {
+        // Set isConfigureSelfOnly based on D-Bus results.  This
+        // ignores the results from both pamAuthenticateUser and the
+        // value from any previous use of this session.
+        req.session->isConfigureSelfOnly = passwordExpired;
 
-            // Set isConfigureSelfOnly based on D-Bus results.  This
-            // ignores the results from both pamAuthenticateUser and the
-            // value from any previous use of this session.
-            req.session->isConfigureSelfOnly = *passwordExpired;
+        // Remove all privileges except ConfigureSelf if isConfigureSelfOnly.
+        redfish::UserRoleId effectiveRole = redfish::getEffectiveUserRoleId(
+            roleId, req.session->isConfigureSelfOnly);
+        if (req.session->isConfigureSelfOnly)
+        {
+            BMCWEB_LOG_DEBUG << "Operation limited to ConfigureSelf";
+        }
 
-            // Modify privileges if isConfigureSelfOnly.
+        if (!rule.checkPrivileges(effectiveRole))
+        {
+            asyncResp->res.result(boost::beast::http::status::forbidden);
             if (req.session->isConfigureSelfOnly)
             {
-                // Remove all privileges except ConfigureSelf
-                userPrivileges = userPrivileges.intersection(
-                    redfish::Privileges{"ConfigureSelf"});
-                BMCWEB_LOG_DEBUG << "Operation limited to ConfigureSelf";
+                redfish::messages::passwordChangeRequired(
+                    asyncResp->res, crow::utility::urlFromPieces(
+                                        "redfish", "v1", "AccountService",
+                                        "Accounts", req.session->username));
             }
+            return;
+        }
 
-            if (!rule.checkPrivileges(userPrivileges))
-            {
-                asyncResp->res.result(boost::beast::http::status::forbidden);
-                if (req.session->isConfigureSelfOnly)
+        req.userRole = userRole;
+        dispatch(req, asyncResp, rule, params,
+                 std::to_string(static_cast<size_t>(effectiveRole)));
+    }
+
+    /**
+     * @brief Runs the handler of rule, going through the ResponseCache for a
+     * GET on a route that uses it.  Any request that may change something
+     * invalidates the cache.
+     */
+    static void dispatch(Request& req,
+                         const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+                         BaseRule& rule, RoutingParams& params,
+                         std::string_view role)
+    {
+        ResponseCache& cache = ResponseCache::getInstance();
+        boost::beast::http::verb method = req.method();
+        if (method != boost::beast::http::verb::get &&
+            method != boost::beast::http::verb::head)
+        {
+            cache.invalidate();
+            Response::CompletionHandler handler =
+                asyncResp->res.releaseCompleteRequestHandler();
+            asyncResp->res.setCompleteRequestHandler(
+                [handler(std::move(handler))](Response& res) {
+                ResponseCache::getInstance().invalidate();
+                if (handler)
                 {
-                    redfish::messages::passwordChangeRequired(
-                        asyncResp->res, crow::utility::urlFromPieces(
-                                            "redfish", "v1", "AccountService",
-                                            "Accounts", req.session->username));
+                    handler(res);
                 }
+            });
+            rule.handle(req, asyncResp, params);
+            return;
+        }
+        if (method != boost::beast::http::verb::get ||
+            rule.cacheTtl.count() == 0)
+        {
+            rule.handle(req, asyncResp, params);
+            return;
+        }
+
+        std::string key = ResponseCache::makeKey(
+            req.target(), role,
+            req.getHeaderValue(boost::beast::http::field::accept_encoding));
+        if (cache.serve(key, ResponseCache::Clock::now(), asyncResp->res))
+        {
+            return;
+        }
+        ResponseCache::Waiter waiter =
+            [req, asyncResp, &rule,
+             params](const ResponseCache::Entry* shared) mutable {
+            if (shared != nullptr)
+            {
+                ResponseCache::fill(*shared, asyncResp->res);
                 return;
             }
-
-            req.userRole = userRole;
             rule.handle(req, asyncResp, params);
-        },
-            "xyz.openbmc_project.User.Manager", "/xyz/openbmc_project/user",
-            "xyz.openbmc_project.User.Manager", "GetUserInfo", username);
+        };
+        if (cache.join(key, std::move(waiter)))
+        {
+            return;
+        }
+
+        cache.start(key);
+        Response::CompletionHandler handler =
+            asyncResp->res.releaseCompleteRequestHandler();
+        asyncResp->res.setCompleteRequestHandler(
+            [handler(std::move(handler)), key{std::move(key)},
+             ttl{rule.cacheTtl},
+             cancellation{asyncResp->cancellation}](Response& res) {
+            // Cancelled handlers may have dropped part of the response
+            if (cancellation != nullptr && cancellation->cancelled())
+            {
+                ResponseCache::getInstance().abandon(key);
+            }
+            else
+            {
+                ResponseCache::getInstance().complete(
+                    key, ttl, ResponseCache::Clock::now(), res);
+            }
+            if (handler)
+            {
+                handler(res);
+            }
+        });
+        rule.handle(req, asyncResp, params);
     }
 
     void debugPrint()
@@ -1590,6 +1849,36 @@ class Router
         return ret;
     }
 
+    std::vector<metrics::RouteSeries> getRouteMetrics() const
+    {
+        std::vector<metrics::RouteSeries> ret;
+        ret.reserve(allRules.size());
+        for (const std::unique_ptr<BaseRule>& rule : allRules)
+        {
+            if (!rule)
+            {
+                continue;
+            }
+            metrics::RouteSeries& series = ret.emplace_back();
+            series.route = rule->rule;
+            series.metrics = &rule->metrics;
+            for (size_t method = 0; method <= maxVerbIndex; method++)
+            {
+                if ((rule->methodsBitfield & (1U << method)) == 0U)
+                {
+                    continue;
+                }
+                if (!series.methods.empty())
+                {
+                    series.methods += ',';
+                }
+                series.methods +=
+                    httpVerbToString(static_cast<HttpVerb>(method));
+            }
+        }
+        return ret;
+    }
+
   private:
     struct PerMethod
     {
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace crow
+{
+
+template <typename Signature, size_t Capacity = 4 * sizeof(void*)>
+class SmallFunction;
+
+/**
+ * @brief A move-only std::function that keeps callables of up to Capacity
+ * bytes inside itself, so setting one that captures, say, a shared_ptr and a
+ * pointer doesn't allocate.  Larger callables are kept on the heap.
+ *
+ * Like std::function, operator() is const but calls the callable as
+ * non-const, so mutable lambdas can be stored.
+ */
+template <typename R, typename... Args, size_t Capacity>
+class SmallFunction<R(Args...), Capacity>
+{
+  public:
+    // Whether a callable of type F is kept without allocating
+    template <typename F>
+    static constexpr bool storedInline()
+    {
+        return sizeof(F) <= Capacity &&
+               alignof(F) <= alignof(std::max_align_t) &&
+               std::is_nothrow_move_constructible_v<F>;
+    }
+
+    SmallFunction() = default;
+
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    SmallFunction(std::nullptr_t) {}
+
+    template <typename F,
+              typename = std::enable_if_t<
+                  !std::is_same_v<std::decay_t<F>, SmallFunction> &&
+                  std::is_invocable_r_v<R, std::decay_t<F>&, Args...>>>
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    SmallFunction(F&& f)
+    {
+        using Stored = std::decay_t<F>;
+        if constexpr (storedInline<Stored>())
+        {
+            new (storage.data()) Stored(std::forward<F>(f));
+            ops = &inlineOps<Stored>;
+        }
+        else
+        {
+            new (storage.data()) Stored*(new Stored(std::forward<F>(f)));
+            ops = &heapOps<Stored>;
+        }
+    }
+
+    SmallFunction(SmallFunction&& other) noexcept
+    {
+        moveFrom(other);
+    }
+
+    SmallFunction& operator=(SmallFunction&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    SmallFunction& operator=(std::nullptr_t)
+    {
+        reset();
+        return *this;
+    }
+
+    SmallFunction(const SmallFunction&) = delete;
+    SmallFunction& operator=(const SmallFunction&) = delete;
+
+    ~SmallFunction()
+    {
+        reset();
+    }
+
+    explicit operator bool() const
+    {
+        return ops != nullptr;
+    }
+
+    R operator()(Args... args) const
+    {
+        if (ops == nullptr)
+        {
+            throw std::bad_function_call();
+        }
+        return ops->invoke(storage.data(), std::forward<Args>(args)...);
+    }
+
+  private:
+    struct Ops
+    {
+        R (*invoke)(void*, Args&&...);
+        // Moves the callable at from into to, leaving from empty
+        void (*relocate)(void* from, void* to) noexcept;
+        void (*destroy)(void*) noexcept;
+    };
+
+    template <typename F>
+    static constexpr Ops inlineOps = {
+        [](void* self, Args&&... args) -> R {
+            return std::invoke(*static_cast<F*>(self),
+                               std::forward<Args>(args)...);
+        },
+        [](void* from, void* to) noexcept {
+            F* source = static_cast<F*>(from);
+            new (to) F(std::move(*source));
+            source->~F();
+        },
+        [](void* self) noexcept { static_cast<F*>(self)->~F(); }};
+
+    template <typename F>
+    static constexpr Ops heapOps = {
+        [](void* self, Args&&... args) -> R {
+            return std::invoke(**static_cast<F**>(self),
+                               std::forward<Args>(args)...);
+        },
+        [](void* from, void* to) noexcept {
+            new (to) F*(*static_cast<F**>(from));
+        },
+        [](void* self) noexcept { delete *static_cast<F**>(self); }};
+
+    void moveFrom(SmallFunction& other) noexcept
+    {
+        if (other.ops != nullptr)
+        {
+            other.ops->relocate(other.storage.data(), storage.data());
+            ops = std::exchange(other.ops, nullptr);
+        }
+    }
+
+    void reset() noexcept
+    {
+        if (ops != nullptr)
+        {
+            std::exchange(ops, nullptr)->destroy(storage.data());
+        }
+    }
+
+    // Mutable so the const operator() can call a non-const callable
+    alignas(std::max_align_t) mutable std::array<std::byte, Capacity>
+        storage{};
+    const Ops* ops = nullptr;
+};
+
+} // namespace crow
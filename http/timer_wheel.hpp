@@ -0,0 +1,191 @@
+#pragma once
+
+#include "intrusive_link.hpp"
+#include "logging.hpp"
+
+#include <boost/asio/error.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+namespace crow
+{
+
+class WheelTimer;
+
+/**
+ * @brief Idle and inactivity timeouts for many objects, on one steady_timer.
+ *
+ * Timeouts are kept to whole ticks in a ring of slots, each an intrusive
+ * list of the WheelTimers due on it; a timeout more than a turn of the ring
+ * away waits out the extra turns in its slot.  Arming and cancelling are a
+ * list link and unlink, with no allocation and no timer queue operation,
+ * which matters when every read and write of hundreds of keep-alive
+ * connections re-arms one.  The price is precision: a timeout fires on the
+ * tick after it comes due.  The ring only ticks while something is armed.
+ */
+class TimerWheel
+{
+  public:
+    static constexpr std::chrono::seconds tick{1};
+    static constexpr size_t slotCount = 256;
+
+    explicit TimerWheel(boost::asio::io_context& io) : timer(io) {}
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel(TimerWheel&&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+    TimerWheel& operator=(TimerWheel&&) = delete;
+    ~TimerWheel() = default;
+
+    size_t armedCount() const
+    {
+        return armed;
+    }
+
+  private:
+    friend class WheelTimer;
+
+    void arm(WheelTimer& entry, std::chrono::steady_clock::duration timeout);
+    void disarm(WheelTimer& entry);
+
+    void scheduleTick()
+    {
+        timer.async_wait([this](const boost::system::error_code& ec) {
+            if (ec)
+            {
+                if (ec != boost::asio::error::operation_aborted)
+                {
+                    BMCWEB_LOG_ERROR << "Timer wheel tick failed " << ec;
+                }
+                ticking = false;
+                return;
+            }
+            advance();
+            if (armed == 0)
+            {
+                ticking = false;
+                return;
+            }
+            timer.expires_at(timer.expiry() + tick);
+            scheduleTick();
+        });
+    }
+
+    void advance();
+
+    std::array<intrusive::Link, slotCount> slots;
+    size_t current = 0;
+    size_t armed = 0;
+    bool ticking = false;
+    boost::asio::steady_timer timer;
+};
+
+/**
+ * @brief A timeout on a TimerWheel, embedded in whatever it times out.
+ *
+ * The handler is given once, up front, so re-arming doesn't copy a callable
+ * either; it's called from the io_context when the timeout passes without a
+ * cancel() or another expiresAfter().  Destroying the timer cancels it.
+ */
+class WheelTimer : private intrusive::Link
+{
+  public:
+    WheelTimer(TimerWheel& wheelIn, std::function<void()>&& handlerIn) :
+        wheel(wheelIn), handler(std::move(handlerIn))
+    {}
+
+    WheelTimer(const WheelTimer&) = delete;
+    WheelTimer(WheelTimer&&) = delete;
+    WheelTimer& operator=(const WheelTimer&) = delete;
+    WheelTimer& operator=(WheelTimer&&) = delete;
+
+    ~WheelTimer()
+    {
+        cancel();
+    }
+
+    // Replaces any timeout already armed
+    void expiresAfter(std::chrono::steady_clock::duration timeout)
+    {
+        wheel.arm(*this, timeout);
+    }
+
+    void cancel()
+    {
+        wheel.disarm(*this);
+    }
+
+    bool pending() const
+    {
+        return linked();
+    }
+
+  private:
+    friend class TimerWheel;
+
+    TimerWheel& wheel;
+    std::function<void()> handler;
+    // Turns of the wheel left to wait out once in its slot
+    size_t rounds = 0;
+};
+
+inline void TimerWheel::arm(WheelTimer& entry,
+                            std::chrono::steady_clock::duration timeout)
+{
+    disarm(entry);
+
+    auto ticks = std::chrono::ceil<std::chrono::seconds>(timeout) / tick;
+    size_t due = ticks > 1 ? static_cast<size_t>(ticks) : 1;
+    entry.rounds = (due - 1) / slotCount;
+    entry.insertBefore(slots[(current + due) % slotCount]);
+    armed++;
+
+    if (!ticking)
+    {
+        ticking = true;
+        timer.expires_after(tick);
+        scheduleTick();
+    }
+}
+
+inline void TimerWheel::disarm(WheelTimer& entry)
+{
+    if (entry.linked())
+    {
+        entry.unlink();
+        armed--;
+    }
+}
+
+inline void TimerWheel::advance()
+{
+    current = (current + 1) % slotCount;
+    intrusive::Link& slot = slots[current];
+
+    // Handlers may cancel or re-arm any timer, including ones due now, so
+    // the slot is moved aside and drained one timer at a time
+    intrusive::Link due;
+    due.takeAll(slot);
+    while (due.linked())
+    {
+        WheelTimer& entry = static_cast<WheelTimer&>(*due.next);
+        entry.unlink();
+        if (entry.rounds > 0)
+        {
+            entry.rounds--;
+            entry.insertBefore(slot);
+            continue;
+        }
+        armed--;
+        // The handler may destroy entry
+        entry.handler();
+    }
+}
+
+} // namespace crow
@@ -0,0 +1,44 @@
+#pragma once
+
+/**
+ * @file Static tracepoints, for following a request through bmcweb on a live
+ * system with perf or bpftrace, e.g.
+ *
+ *   bpftrace -e 'usdt:/usr/bin/bmcweb:bmcweb:route_matched
+ *                { printf("%s\n", str(arg1)); }'
+ *
+ * Built with the tracepoints option, each one is a single nop in the code
+ * path, plus a note that tells the tracer where it is and how to read its
+ * arguments; nothing is evaluated until a tracer attaches.  Built without it,
+ * they are compiled out entirely.
+ *
+ * The tracepoints, all under the bmcweb provider:
+ *   connection_accept(connection)
+ *   tls_handshake_done(connection, failed)
+ *   headers_read(connection, bytes)
+ *   auth_done(connection, authenticated)
+ *   request_start(connection, request, method)
+ *   route_matched(request, rule)
+ *   dbus_call_start(service, member)
+ *   dbus_call_done(service, member, latency_us, failed)
+ *   handler_done(connection, status)
+ *   write_done(connection, bytes, failed)
+ *
+ * connection and request are addresses, which identify the connection and
+ * request while they are alive; strings are nul terminated.
+ */
+
+#ifdef BMCWEB_ENABLE_TRACEPOINTS
+#include <sys/sdt.h>
+
+#define BMCWEB_TRACEPOINT1(name, a) DTRACE_PROBE1(bmcweb, name, a)
+#define BMCWEB_TRACEPOINT2(name, a, b) DTRACE_PROBE2(bmcweb, name, a, b)
+#define BMCWEB_TRACEPOINT3(name, a, b, c) DTRACE_PROBE3(bmcweb, name, a, b, c)
+#define BMCWEB_TRACEPOINT4(name, a, b, c, d)                                   \
+    DTRACE_PROBE4(bmcweb, name, a, b, c, d)
+#else
+#define BMCWEB_TRACEPOINT1(name, a)
+#define BMCWEB_TRACEPOINT2(name, a, b)
+#define BMCWEB_TRACEPOINT3(name, a, b, c)
+#define BMCWEB_TRACEPOINT4(name, a, b, c, d)
+#endif
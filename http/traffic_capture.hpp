@@ -0,0 +1,163 @@
+#pragma once
+
+#include "http_request.hpp"
+#include "logging.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+namespace crow
+{
+namespace capture
+{
+
+/**
+ * @file Records the requests bmcweb serves, one JSON object per line, so
+ * scripts/replay_capture.py can send the same traffic, with the same timing,
+ * to another build.
+ *
+ * Each record holds when the request arrived, in microseconds since the
+ * capture started; which connection it came on; the request line and
+ * headers; the size of the body; the route that matched; and the status and
+ * latency it was answered with.  Credentials are left out: the headers in
+ * credentialHeaders are dropped and bodies are never written.
+ */
+
+// Headers that carry a password, session token or session cookie
+constexpr std::array<std::string_view, 5> credentialHeaders = {
+    "authorization", "cookie", "proxy-authorization", "x-auth-token",
+    "x-xsrf-token"};
+
+inline bool isCredentialHeader(std::string_view name)
+{
+    for (std::string_view credential : credentialHeaders)
+    {
+        if (name.size() == credential.size() &&
+            std::equal(name.begin(), name.end(), credential.begin(),
+                       [](char a, char b) {
+            return std::tolower(static_cast<unsigned char>(a)) == b;
+        }))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief The capture record of req, which arrived arrivedUs after the
+ * capture started on connection, and was answered with status after
+ * latency.
+ */
+inline nlohmann::json makeRecord(const Request& req, uint64_t connection,
+                                 uint64_t arrivedUs, unsigned status,
+                                 std::chrono::microseconds latency)
+{
+    nlohmann::json::array_t headers;
+    for (const auto& field : req.fields)
+    {
+        if (isCredentialHeader(field.name_string()))
+        {
+            continue;
+        }
+        headers.push_back(nlohmann::json::array_t{
+            std::string(field.name_string()), std::string(field.value())});
+    }
+
+    nlohmann::json::object_t record;
+    record["at_us"] = arrivedUs;
+    record["connection"] = connection;
+    record["method"] = std::string(req.methodString());
+    record["target"] = std::string(req.target());
+    record["version"] = req.version();
+    record["headers"] = std::move(headers);
+    record["body_bytes"] = req.body.size();
+    if (!req.route.empty())
+    {
+        record["route"] = std::string(req.route);
+    }
+    record["status"] = status;
+    record["latency_us"] = latency.count();
+    return record;
+}
+
+/**
+ * @brief The file requests are captured to, opened at startup.  Capturing
+ * writes, and flushes, a line per request on the io thread, so it's meant
+ * for test systems rather than production.
+ */
+class TrafficCapture
+{
+  public:
+    static TrafficCapture& getInstance()
+    {
+        static TrafficCapture capture;
+        return capture;
+    }
+
+    TrafficCapture(const TrafficCapture&) = delete;
+    TrafficCapture(TrafficCapture&&) = delete;
+    TrafficCapture& operator=(const TrafficCapture&) = delete;
+    TrafficCapture& operator=(TrafficCapture&&) = delete;
+    ~TrafficCapture() = default;
+
+    // Starts capturing to path, adding to anything already there
+    void open(const std::string& path)
+    {
+        out.open(path, std::ios::app);
+        if (!out)
+        {
+            BMCWEB_LOG_ERROR << "Couldn't open traffic capture file " << path;
+            return;
+        }
+        BMCWEB_LOG_INFO << "Capturing requests to " << path;
+        started = std::chrono::steady_clock::now();
+    }
+
+    bool enabled() const
+    {
+        return out.is_open();
+    }
+
+    // A number for a newly started connection, to tell its requests apart
+    uint64_t nextConnection()
+    {
+        return ++connections;
+    }
+
+    void record(const Request& req, uint64_t connection,
+                std::chrono::steady_clock::time_point arrived,
+                unsigned status, std::chrono::microseconds latency)
+    {
+        if (!enabled())
+        {
+            return;
+        }
+        uint64_t arrivedUs = static_cast<uint64_t>(std::max<int64_t>(
+            0, std::chrono::duration_cast<std::chrono::microseconds>(
+                   arrived - started)
+                   .count()));
+        out << makeRecord(req, connection, arrivedUs, status, latency)
+                   .dump(-1, ' ', true,
+                         nlohmann::json::error_handler_t::replace)
+            << std::endl;
+    }
+
+  private:
+    TrafficCapture() = default;
+
+    std::ofstream out;
+    uint64_t connections = 0;
+    std::chrono::steady_clock::time_point started;
+};
+
+} // namespace capture
+} // namespace crow
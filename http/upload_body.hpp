@@ -0,0 +1,416 @@
+#pragma once
+
+#include "logging.hpp"
+#include "multipart_parser.hpp"
+
+#include <fcntl.h>
+#include <openssl/evp.h>
+#include <unistd.h>
+
+#include <boost/beast/core/buffers_range.hpp>
+#include <boost/beast/http/error.hpp>
+#include <boost/beast/http/message.hpp>
+#include <boost/beast/http/rfc7230.hpp>
+#include <boost/optional.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace crow
+{
+
+// Where upload bodies are written while they arrive.  This should be on the
+// same filesystem as the directories handlers move them into.
+constexpr const char* uploadStagingTemplate = "/tmp/bmcweb-upload-XXXXXX";
+
+// Most bytes of a multipart part other than the file, like Redfish's
+// UpdateParameters, held in memory
+constexpr std::size_t uploadMaxBufferedPart = 64UL * 1024UL;
+
+/**
+ * @brief A request body written to a file as it arrives, and hashed on the
+ * way, so large uploads never sit in memory.
+ *
+ * The file stays open until moveTo() puts it in its final place, so tools
+ * watching that directory for IN_CLOSE_WRITE, like phosphor-software-manager
+ * watching /tmp/images, only ever see complete files.  A body that is never
+ * moved is deleted with this object.
+ *
+ * A multipart/form-data body is parsed as it arrives instead.  The first part
+ * with a filename is what goes to the file, and is what sha256() covers; the
+ * other parts are kept in parts().  This must not be moved while a body is
+ * still being parsed into it.
+ */
+class UploadFile
+{
+  public:
+    UploadFile() = default;
+
+    ~UploadFile()
+    {
+        discard();
+    }
+
+    UploadFile(const UploadFile&) = delete;
+    UploadFile& operator=(const UploadFile&) = delete;
+
+    UploadFile(UploadFile&& other) noexcept :
+        fd(other.fd), stagedPath(std::move(other.stagedPath)),
+        bytes(other.bytes), hash(std::move(other.hash)),
+        digest(std::move(other.digest)), multipart(std::move(other.multipart)),
+        multipartError(other.multipartError),
+        filePartIndex(other.filePartIndex)
+    {
+        other.fd = -1;
+        other.stagedPath.clear();
+    }
+
+    UploadFile& operator=(UploadFile&& other) noexcept
+    {
+        if (this != &other)
+        {
+            discard();
+            fd = other.fd;
+            stagedPath = std::move(other.stagedPath);
+            bytes = other.bytes;
+            hash = std::move(other.hash);
+            digest = std::move(other.digest);
+            multipart = std::move(other.multipart);
+            multipartError = other.multipartError;
+            filePartIndex = other.filePartIndex;
+            other.fd = -1;
+            other.stagedPath.clear();
+        }
+        return *this;
+    }
+
+    void open(boost::system::error_code& ec)
+    {
+        discard();
+        std::string name(uploadStagingTemplate);
+        fd = mkstemp(name.data());
+        if (fd < 0)
+        {
+            ec.assign(errno, boost::system::system_category());
+            BMCWEB_LOG_ERROR << "Couldn't create upload file: " << ec.message();
+            return;
+        }
+        stagedPath = std::move(name);
+        bytes = 0;
+        digest.clear();
+        hash.reset(EVP_MD_CTX_new());
+        if (hash == nullptr ||
+            EVP_DigestInit_ex(hash.get(), EVP_sha256(), nullptr) != 1)
+        {
+            ec = boost::system::errc::make_error_code(
+                boost::system::errc::not_enough_memory);
+        }
+    }
+
+    // Call after open() to parse the body as multipart/form-data
+    void startMultipart(std::string_view contentType)
+    {
+        multipart = std::make_unique<MultipartParser>();
+        multipart->maxBufferedPartSize = uploadMaxBufferedPart;
+        multipartError = multipart->start(contentType);
+        filePartIndex.reset();
+        multipart->onPartHeaders = [this](FormPart& part) {
+            if (filePartIndex || !hasFilename(part))
+            {
+                return;
+            }
+            filePartIndex = multipart->mime_fields.size() - 1;
+            part.sink = [this](std::string_view data) {
+                boost::system::error_code ec;
+                writeFile(data, ec);
+                return !ec;
+            };
+        };
+    }
+
+    void write(std::string_view data, boost::system::error_code& ec)
+    {
+        if (multipart == nullptr)
+        {
+            writeFile(data, ec);
+            return;
+        }
+        // A malformed body is still read in full, so the handler can answer
+        // it; multipartResult() says what went wrong
+        if (multipartError == ParserError::PARSER_SUCCESS)
+        {
+            multipartError = multipart->feed(data);
+        }
+    }
+
+    void finish(boost::system::error_code& ec)
+    {
+        if (multipart != nullptr)
+        {
+            if (multipartError == ParserError::PARSER_SUCCESS)
+            {
+                multipartError = multipart->finish();
+            }
+            // These point at this object, which is about to be moved
+            multipart->onPartHeaders = nullptr;
+            for (FormPart& part : multipart->mime_fields)
+            {
+                part.sink = nullptr;
+            }
+        }
+
+        std::array<unsigned char, EVP_MAX_MD_SIZE> md{};
+        unsigned int mdLen = 0;
+        if (EVP_DigestFinal_ex(hash.get(), md.data(), &mdLen) != 1)
+        {
+            ec = boost::system::errc::make_error_code(
+                boost::system::errc::io_error);
+            return;
+        }
+        hash.reset();
+        digest.clear();
+        for (unsigned int i = 0; i < mdLen; i++)
+        {
+            std::array<char, 3> hex{};
+            std::snprintf(hex.data(), hex.size(), "%02x", md[i]);
+            digest += hex.data();
+        }
+    }
+
+    // Renames the file to path and closes it.  path must be on the same
+    // filesystem as uploadStagingTemplate.
+    bool moveTo(const std::string& path)
+    {
+        if (stagedPath.empty())
+        {
+            return false;
+        }
+        if (std::rename(stagedPath.c_str(), path.c_str()) != 0)
+        {
+            BMCWEB_LOG_ERROR << "Couldn't move upload to " << path << ": "
+                             << std::strerror(errno);
+            return false;
+        }
+        stagedPath.clear();
+        ::close(fd);
+        fd = -1;
+        return true;
+    }
+
+    // Bytes written to the file so far
+    uint64_t size() const
+    {
+        return bytes;
+    }
+
+    // Lowercase hex SHA-256 of the file, once the body has all arrived
+    const std::string& sha256() const
+    {
+        return digest;
+    }
+
+    bool isOpen() const
+    {
+        return fd >= 0;
+    }
+
+    bool isMultipart() const
+    {
+        return multipart != nullptr;
+    }
+
+    ParserError multipartResult() const
+    {
+        return multipartError;
+    }
+
+    // Every part of a multipart body.  The one in the file has no content.
+    const std::vector<FormPart>& parts() const
+    {
+        static const std::vector<FormPart> none;
+        if (multipart == nullptr)
+        {
+            return none;
+        }
+        return multipart->mime_fields;
+    }
+
+    // The part of a multipart body that went to the file, if any
+    const FormPart* filePart() const
+    {
+        if (multipart == nullptr || !filePartIndex)
+        {
+            return nullptr;
+        }
+        return &multipart->mime_fields[*filePartIndex];
+    }
+
+  private:
+    struct HashDeleter
+    {
+        void operator()(EVP_MD_CTX* ctx) const
+        {
+            EVP_MD_CTX_free(ctx);
+        }
+    };
+
+    static bool hasFilename(const FormPart& part)
+    {
+        auto it = part.fields.find("Content-Disposition");
+        if (it == part.fields.end())
+        {
+            return false;
+        }
+        boost::beast::string_view value = it->value();
+        size_t index = value.find(';');
+        if (index == boost::beast::string_view::npos)
+        {
+            return false;
+        }
+        for (const auto& param :
+             boost::beast::http::param_list(value.substr(index)))
+        {
+            if (param.first == "filename")
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void writeFile(std::string_view data, boost::system::error_code& ec)
+    {
+        if (EVP_DigestUpdate(hash.get(), data.data(), data.size()) != 1)
+        {
+            ec = boost::system::errc::make_error_code(
+                boost::system::errc::io_error);
+            return;
+        }
+        while (!data.empty())
+        {
+            ssize_t written = ::write(fd, data.data(), data.size());
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                ec.assign(errno, boost::system::system_category());
+                BMCWEB_LOG_ERROR << "Couldn't write upload file: "
+                                 << ec.message();
+                return;
+            }
+            data.remove_prefix(static_cast<size_t>(written));
+            bytes += static_cast<uint64_t>(written);
+        }
+    }
+
+    void discard()
+    {
+        if (!stagedPath.empty())
+        {
+            ::unlink(stagedPath.c_str());
+            stagedPath.clear();
+        }
+        if (fd >= 0)
+        {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+
+    int fd = -1;
+    std::string stagedPath;
+    uint64_t bytes = 0;
+    std::unique_ptr<EVP_MD_CTX, HashDeleter> hash;
+    std::string digest;
+
+    std::unique_ptr<MultipartParser> multipart;
+    ParserError multipartError = ParserError::PARSER_SUCCESS;
+    std::optional<size_t> filePartIndex;
+};
+
+// Beast body type that parses a request straight into an UploadFile
+struct UploadBody
+{
+    using value_type = UploadFile;
+
+    static std::uint64_t size(const value_type& body)
+    {
+        return body.size();
+    }
+
+    class reader
+    {
+      public:
+        // The parser makes this before it has read the header, so header is
+        // only looked at in init()
+        template <bool isRequest, class Fields>
+        reader(boost::beast::http::header<isRequest, Fields>& header,
+               value_type& bodyIn) :
+            getContentType([&header]() {
+                boost::beast::string_view type =
+                    header[boost::beast::http::field::content_type];
+                return std::string_view(type.data(), type.size());
+            }),
+            body(bodyIn)
+        {}
+
+        void init(const boost::optional<std::uint64_t>& /*contentLength*/,
+                  boost::system::error_code& ec)
+        {
+            ec = {};
+            body.open(ec);
+#ifdef BMCWEB_ENABLE_REDFISH_MULTIPART_UPDATE
+            std::string_view contentType = getContentType();
+            if (!ec && contentType.starts_with("multipart/form-data"))
+            {
+                body.startMultipart(contentType);
+            }
+#endif
+        }
+
+        template <class ConstBufferSequence>
+        std::size_t put(const ConstBufferSequence& buffers,
+                        boost::system::error_code& ec)
+        {
+            ec = {};
+            std::size_t accepted = 0;
+            for (const auto buffer : boost::beast::buffers_range_ref(buffers))
+            {
+                body.write(std::string_view(
+                               static_cast<const char*>(buffer.data()),
+                               buffer.size()),
+                           ec);
+                if (ec)
+                {
+                    return accepted;
+                }
+                accepted += buffer.size();
+            }
+            return accepted;
+        }
+
+        void finish(boost::system::error_code& ec)
+        {
+            ec = {};
+            body.finish(ec);
+        }
+
+      private:
+        std::function<std::string_view()> getContentType;
+        value_type& body;
+    };
+};
+
+} // namespace crow
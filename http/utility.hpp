@@ -378,115 +378,187 @@ struct FunctionTraits
     using arg = std::tuple_element_t<i, boost::callable_traits::args_t<T>>;
 };
 
-inline std::string base64encode(const std::string_view data)
+namespace details
 {
-    const std::array<char, 64> key = {
-        'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M',
-        'N', 'O', 'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z',
-        'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm',
-        'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z',
-        '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '+', '/'};
 
-    size_t size = data.size();
-    std::string ret;
-    ret.resize((size + 2) / 3 * 4);
-    auto it = ret.begin();
+constexpr std::array<char, 64> base64Key = {
+    'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M',
+    'N', 'O', 'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z',
+    'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm',
+    'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z',
+    '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '+', '/'};
+
+// Value of each base64 character, with the top bit set for anything else
+constexpr std::array<uint8_t, 256> base64Values = []() {
+    std::array<uint8_t, 256> values{};
+    values.fill(0xff);
+    for (size_t i = 0; i < base64Key.size(); i++)
+    {
+        values[static_cast<unsigned char>(base64Key[i])] =
+            static_cast<uint8_t>(i);
+    }
+    return values;
+}();
 
-    size_t i = 0;
-    while (i < size)
+// Encodes the whole groups of 3 in data into out, which must have room for
+// 4 characters per group, and returns the number of bytes consumed
+inline size_t base64EncodeGroups(std::string_view data, char* out)
+{
+    size_t end = data.size() - data.size() % 3;
+    for (size_t i = 0; i < end; i += 3)
     {
-        size_t keyIndex = 0;
+        uint32_t bits =
+            (static_cast<uint32_t>(static_cast<unsigned char>(data[i]))
+             << 16) |
+            (static_cast<uint32_t>(static_cast<unsigned char>(data[i + 1]))
+             << 8) |
+            static_cast<unsigned char>(data[i + 2]);
+        *out++ = base64Key[bits >> 18];
+        *out++ = base64Key[(bits >> 12) & 0x3f];
+        *out++ = base64Key[(bits >> 6) & 0x3f];
+        *out++ = base64Key[bits & 0x3f];
+    }
+    return end;
+}
 
-        keyIndex = static_cast<size_t>(data[i] & 0xFC) >> 2;
-        *it++ = key[keyIndex];
+// Encodes the last 1 or 2 bytes of an input, with padding
+inline void base64EncodeTail(std::string_view data, char* out)
+{
+    uint32_t bits = static_cast<uint32_t>(static_cast<unsigned char>(data[0]))
+                    << 16;
+    if (data.size() > 1)
+    {
+        bits |= static_cast<uint32_t>(static_cast<unsigned char>(data[1]))
+                << 8;
+    }
+    out[0] = base64Key[bits >> 18];
+    out[1] = base64Key[(bits >> 12) & 0x3f];
+    out[2] = data.size() > 1 ? base64Key[(bits >> 6) & 0x3f] : '=';
+    out[3] = '=';
+}
 
-        if (i + 1 < size)
-        {
-            keyIndex = static_cast<size_t>(data[i] & 0x03) << 4;
-            keyIndex += static_cast<size_t>(data[i + 1] & 0xF0) >> 4;
-            *it++ = key[keyIndex];
+} // namespace details
 
-            if (i + 2 < size)
-            {
-                keyIndex = static_cast<size_t>(data[i + 1] & 0x0F) << 2;
-                keyIndex += static_cast<size_t>(data[i + 2] & 0xC0) >> 6;
-                *it++ = key[keyIndex];
+inline size_t base64EncodedSize(size_t size)
+{
+    return (size + 2) / 3 * 4;
+}
+
+/**
+ * @brief Appends the base64 encoding of data to out, growing out once to
+ * exactly the size needed.
+ */
+inline void base64EncodeAppend(std::string& out, std::string_view data)
+{
+    size_t start = out.size();
+    out.resize(start + base64EncodedSize(data.size()));
+    char* dest = out.data() + start;
+    size_t done = details::base64EncodeGroups(data, dest);
+    if (done < data.size())
+    {
+        details::base64EncodeTail(data.substr(done), dest + done / 3 * 4);
+    }
+}
 
-                keyIndex = static_cast<size_t>(data[i + 2] & 0x3F);
-                *it++ = key[keyIndex];
+inline std::string base64encode(const std::string_view data)
+{
+    std::string ret;
+    base64EncodeAppend(ret, data);
+    return ret;
+}
+
+/**
+ * @brief Base64 encodes an input that arrives in pieces, such as a file read
+ * a chunk at a time.  The output is the same as base64encode of the pieces
+ * joined together; bytes that don't make up a whole group of 3 are held back
+ * until the next piece, or until finish().
+ */
+class Base64Encoder
+{
+  public:
+    void update(std::string& out, std::string_view data)
+    {
+        if (pendingSize > 0)
+        {
+            while (pendingSize < pending.size() && !data.empty())
+            {
+                pending[pendingSize++] = data.front();
+                data.remove_prefix(1);
             }
-            else
+            if (pendingSize < pending.size())
             {
-                keyIndex = static_cast<size_t>(data[i + 1] & 0x0F) << 2;
-                *it++ = key[keyIndex];
-                *it++ = '=';
+                return;
             }
+            base64EncodeAppend(out, {pending.data(), pending.size()});
+            pendingSize = 0;
         }
-        else
+        size_t whole = data.size() - data.size() % 3;
+        base64EncodeAppend(out, data.substr(0, whole));
+        data.remove_prefix(whole);
+        for (char c : data)
         {
-            keyIndex = static_cast<size_t>(data[i] & 0x03) << 4;
-            *it++ = key[keyIndex];
-            *it++ = '=';
-            *it++ = '=';
+            pending[pendingSize++] = c;
         }
+    }
 
-        i += 3;
+    void finish(std::string& out)
+    {
+        base64EncodeAppend(out, {pending.data(), pendingSize});
+        pendingSize = 0;
     }
 
-    return ret;
-}
+  private:
+    std::array<char, 3> pending{};
+    size_t pendingSize = 0;
+};
 
 // TODO this is temporary and should be deleted once base64 is refactored out of
 // crow
 inline bool base64Decode(const std::string_view input, std::string& output)
 {
-    static const char nop = static_cast<char>(-1);
-    // See note on encoding_data[] in above function
-    static const std::array<char, 256> decodingData = {
-        nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop,
-        nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop,
-        nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop,
-        nop, 62,  nop, nop, nop, 63,  52,  53,  54,  55,  56,  57,  58,  59,
-        60,  61,  nop, nop, nop, nop, nop, nop, nop, 0,   1,   2,   3,   4,
-        5,   6,   7,   8,   9,   10,  11,  12,  13,  14,  15,  16,  17,  18,
-        19,  20,  21,  22,  23,  24,  25,  nop, nop, nop, nop, nop, nop, 26,
-        27,  28,  29,  30,  31,  32,  33,  34,  35,  36,  37,  38,  39,  40,
-        41,  42,  43,  44,  45,  46,  47,  48,  49,  50,  51,  nop, nop, nop,
-        nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop,
-        nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop,
-        nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop,
-        nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop,
-        nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop,
-        nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop,
-        nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop,
-        nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop,
-        nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop, nop,
-        nop, nop, nop, nop};
+    const std::array<uint8_t, 256>& decodingData = details::base64Values;
+    constexpr uint8_t nop = 0xff;
 
     size_t inputLength = input.size();
 
-    // allocate space for output string
-    output.clear();
-    output.reserve(((inputLength + 2) / 3) * 4);
+    // Every whole group of 4 characters decodes to 3 bytes; the output is
+    // trimmed once the padding, if any, is known
+    output.resize(inputLength / 4 * 3);
+    char* out = output.data();
 
-    auto getCodeValue = [](char c) {
-        auto code = static_cast<unsigned char>(c);
-        // Ensure we cannot index outside the bounds of the decoding array
-        static_assert(std::numeric_limits<decltype(code)>::max() <
-                      decodingData.size());
-        return decodingData[code];
+    auto getCodeValue = [&decodingData](char c) {
+        return decodingData[static_cast<unsigned char>(c)];
     };
 
-    // for each 4-bytes sequence from the input, extract 4 6-bits sequences by
-    // dropping first two bits
-    // and regenerate into 3 8-bits sequences
+    // Groups with no padding or invalid characters in them need no checks
+    // beyond one test of the combined values
+    size_t i = 0;
+    for (; i + 4 <= inputLength; i += 4)
+    {
+        uint8_t code0 = getCodeValue(input[i]);
+        uint8_t code1 = getCodeValue(input[i + 1]);
+        uint8_t code2 = getCodeValue(input[i + 2]);
+        uint8_t code3 = getCodeValue(input[i + 3]);
+        if (((code0 | code1 | code2 | code3) & 0x80) != 0)
+        {
+            break;
+        }
+        uint32_t bits = (static_cast<uint32_t>(code0) << 18) |
+                        (static_cast<uint32_t>(code1) << 12) |
+                        (static_cast<uint32_t>(code2) << 6) | code3;
+        *out++ = static_cast<char>(bits >> 16);
+        *out++ = static_cast<char>((bits >> 8) & 0xff);
+        *out++ = static_cast<char>(bits & 0xff);
+    }
+    output.resize(i / 4 * 3);
 
-    for (size_t i = 0; i < inputLength; i++)
+    // The last group, which may be padded or short, and anything invalid
+    for (; i < inputLength; i++)
     {
-        char base64code0 = 0;
-        char base64code1 = 0;
-        char base64code2 = 0; // initialized to 0 to suppress warnings
-        char base64code3 = 0;
+        uint8_t base64code0 = 0;
+        uint8_t base64code1 = 0;
+        uint8_t base64code2 = 0; // initialized to 0 to suppress warnings
+        uint8_t base64code3 = 0;
 
         base64code0 = getCodeValue(input[i]);
         if (base64code0 == nop)
@@ -626,6 +698,126 @@ inline void appendUrlPieces(boost::urls::url& url, const AV... args)
 namespace details
 {
 
+// A string literal usable as a template argument
+template <size_t N>
+struct UrlTemplate
+{
+    // NOLINTNEXTLINE(google-explicit-constructor,hicpp-explicit-conversions)
+    consteval UrlTemplate(const char (&str)[N])
+    {
+        for (size_t i = 0; i < N; i++)
+        {
+            value[i] = str[i];
+        }
+    }
+
+    constexpr std::string_view view() const
+    {
+        return {value.data(), N - 1};
+    }
+
+    constexpr size_t placeholders() const
+    {
+        size_t count = 0;
+        std::string_view rest = view();
+        for (size_t pos = rest.find("{}"); pos != std::string_view::npos;
+             pos = rest.find("{}", pos + 2))
+        {
+            count++;
+        }
+        return count;
+    }
+
+    std::array<char, N> value{};
+};
+
+// pchar from RFC 3986, which is what boost::urls leaves unencoded in a
+// path segment
+constexpr bool isSegmentChar(char c)
+{
+    if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+        (c >= '0' && c <= '9'))
+    {
+        return true;
+    }
+    return std::string_view("-._~!$&'()*+,;=:@").find(c) !=
+           std::string_view::npos;
+}
+
+inline void appendEncodedSegment(std::string& out, std::string_view segment)
+{
+    constexpr std::string_view hex = "0123456789ABCDEF";
+    // Dot segments would be removed when the path is normalized
+    if (segment == "." || segment == "..")
+    {
+        for (size_t i = 0; i < segment.size(); i++)
+        {
+            out += "%2E";
+        }
+        return;
+    }
+    size_t clean = 0;
+    for (size_t i = 0; i < segment.size(); i++)
+    {
+        char c = segment[i];
+        if (isSegmentChar(c))
+        {
+            continue;
+        }
+        out.append(segment.substr(clean, i - clean));
+        unsigned char byte = static_cast<unsigned char>(c);
+        out += '%';
+        out += hex[byte >> 4];
+        out += hex[byte & 0xf];
+        clean = i + 1;
+    }
+    out.append(segment.substr(clean));
+}
+
+} // namespace details
+
+/**
+ * @brief Builds a URL path from a template known at compile time, such as
+ * urlPath<"/redfish/v1/Chassis/{}/Sensors/{}">(chassisId, sensorId).
+ *
+ * The literal parts of the template are copied as they are; each {} is
+ * replaced by the next argument, percent-encoded as a single path segment the
+ * way urlFromPieces would.  The result is built straight into one string,
+ * which suits the @odata.id of every member of a large collection better than
+ * building a boost::urls::url segment by segment.
+ */
+template <details::UrlTemplate urlTemplate, typename... Args>
+inline std::string urlPath(const Args&... args)
+{
+    static_assert(urlTemplate.placeholders() == sizeof...(Args),
+                  "Need one argument for every {} in the URL template");
+    constexpr std::string_view tmpl = urlTemplate.view();
+    const std::array<std::string_view, sizeof...(Args)> values{
+        std::string_view(args)...};
+
+    size_t size = tmpl.size();
+    for (const std::string_view value : values)
+    {
+        size += value.size();
+    }
+    std::string out;
+    out.reserve(size);
+
+    size_t start = 0;
+    for (const std::string_view value : values)
+    {
+        size_t pos = tmpl.find("{}", start);
+        out.append(tmpl.substr(start, pos - start));
+        details::appendEncodedSegment(out, value);
+        start = pos + 2;
+    }
+    out.append(tmpl.substr(start));
+    return out;
+}
+
+namespace details
+{
+
 // std::reference_wrapper<std::string> - extracts segment to variable
 //                    std::string_view - checks if segment is equal to variable
 using UrlSegment = std::variant<std::reference_wrapper<std::string>,
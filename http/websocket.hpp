@@ -1,13 +1,17 @@
 #pragma once
+#include "bmcweb_config.h"
 #include "http_request.hpp"
+#include "websocket_write_queue.hpp"
 
 #include <async_resp.hpp>
 #include <boost/asio/buffer.hpp>
-#include <boost/beast/core/multi_buffer.hpp>
 #include <boost/beast/websocket.hpp>
 
 #include <array>
 #include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
 
 #ifdef BMCWEB_ENABLE_SSL
 #include <boost/beast/websocket/ssl.hpp>
@@ -18,22 +22,31 @@ namespace crow
 namespace websocket
 {
 
-enum class MessageType
-{
-    Binary,
-    Text,
-};
+// Whether permessage-deflate is built in at all; each route still has to
+// ask for it
+#ifdef BMCWEB_ENABLE_WEBSOCKET_DEFLATE
+constexpr bool deflateSupported = true;
+#else
+constexpr bool deflateSupported = false;
+#endif
+
+// Websockets currently open
+static int websocketCount = 0;
 
 struct Connection : std::enable_shared_from_this<Connection>
 {
   public:
     explicit Connection(const crow::Request& reqIn) :
         req(reqIn.req), userdataPtr(nullptr)
-    {}
+    {
+        websocketCount++;
+    }
 
     explicit Connection(const crow::Request& reqIn, std::string user) :
         req(reqIn.req), userName{std::move(user)}, userdataPtr(nullptr)
-    {}
+    {
+        websocketCount++;
+    }
 
     Connection(const Connection&) = delete;
     Connection(Connection&&) = delete;
@@ -46,11 +59,24 @@ struct Connection : std::enable_shared_from_this<Connection>
                         std::function<void()>&& onDone) = 0;
     virtual void sendText(std::string_view msg) = 0;
     virtual void sendText(std::string&& msg) = 0;
+    // Sends msg without copying it, so one buffer can go to many connections
+    virtual void sendShared(MessageType type,
+                            std::shared_ptr<const std::string> msg) = 0;
+    // Calls handler with true once more than highWater bytes are waiting to
+    // be written, and with false once they have drained to half that, so a
+    // producer can stop reading from its source in between
+    virtual void setBackpressureHandler(size_t highWater,
+                                        std::function<void(bool)> handler) = 0;
+    // What to do with messages past bmcwebWebsocketWriteQueueLimitMb
+    virtual void setOverflowPolicy(OverflowPolicy policy) = 0;
     virtual void close(std::string_view msg = "quit") = 0;
     virtual void deferRead() = 0;
     virtual void resumeRead() = 0;
     virtual boost::asio::io_context& getIoContext() = 0;
-    virtual ~Connection() = default;
+    virtual ~Connection()
+    {
+        websocketCount--;
+    }
 
     void userdata(void* u)
     {
@@ -88,7 +114,8 @@ class ConnectionImpl : public Connection
                            std::function<void()>&& whenComplete)>
             messageExHandlerIn,
         std::function<void(Connection&, const std::string&)> closeHandlerIn,
-        std::function<void(Connection&)> errorHandlerIn) :
+        std::function<void(Connection&)> errorHandlerIn,
+        bool permessageDeflate = false) :
         Connection(reqIn, reqIn.session == nullptr ? std::string{}
                                                    : reqIn.session->username),
         ws(std::move(adaptorIn)), inBuffer(inString, 131088),
@@ -101,6 +128,21 @@ class ConnectionImpl : public Connection
         /* Turn on the timeouts on websocket stream to server role */
         ws.set_option(boost::beast::websocket::stream_base::timeout::suggested(
             boost::beast::role_type::server));
+        if constexpr (deflateSupported)
+        {
+            if (permessageDeflate)
+            {
+                boost::beast::websocket::permessage_deflate deflate;
+                deflate.server_enable = true;
+                deflate.server_max_window_bits =
+                    bmcwebWebsocketDeflateWindowBits;
+                deflate.client_max_window_bits =
+                    bmcwebWebsocketDeflateWindowBits;
+                deflate.memLevel = bmcwebWebsocketDeflateMemLevel;
+                ws.set_option(deflate);
+            }
+        }
+        outQueue.setLimits(0, bmcwebWebsocketWriteQueueLimitMb * 1024 * 1024);
         BMCWEB_LOG_DEBUG << "Creating new connection " << this;
     }
 
@@ -165,68 +207,47 @@ class ConnectionImpl : public Connection
 
     void sendBinary(const std::string_view msg) override
     {
-        ws.binary(true);
-        outBuffer.commit(boost::asio::buffer_copy(outBuffer.prepare(msg.size()),
-                                                  boost::asio::buffer(msg)));
-        doWrite();
+        enqueue({MessageType::Binary, std::string(msg), nullptr});
     }
 
     void sendEx(MessageType type, std::string_view msg,
                 std::function<void()>&& onDone) override
     {
-        if (doingWrite)
-        {
-            BMCWEB_LOG_CRITICAL
-                << "Cannot mix sendEx usage with sendBinary or sendText";
-            onDone();
-            return;
-        }
-        ws.binary(type == MessageType::Binary);
-
-        ws.async_write(boost::asio::buffer(msg),
-                       [weak(weak_from_this()), onDone{std::move(onDone)}](
-                           const boost::beast::error_code& ec, size_t) {
-            std::shared_ptr<Connection> self = weak.lock();
-            if (!self)
-            {
-                BMCWEB_LOG_ERROR << "Connection went away";
-                return;
-            }
-
-            // Call the done handler regardless of whether we
-            // errored, but before we close things out
-            onDone();
-
-            if (ec)
-            {
-                BMCWEB_LOG_ERROR << "Error in ws.async_write " << ec;
-                self->close("write error");
-            }
-        });
+        enqueue({type, msg, std::move(onDone)});
     }
 
     void sendBinary(std::string&& msg) override
     {
-        ws.binary(true);
-        outBuffer.commit(boost::asio::buffer_copy(outBuffer.prepare(msg.size()),
-                                                  boost::asio::buffer(msg)));
-        doWrite();
+        enqueue({MessageType::Binary, std::move(msg), nullptr});
     }
 
     void sendText(const std::string_view msg) override
     {
-        ws.text(true);
-        outBuffer.commit(boost::asio::buffer_copy(outBuffer.prepare(msg.size()),
-                                                  boost::asio::buffer(msg)));
-        doWrite();
+        enqueue({MessageType::Text, std::string(msg), nullptr});
     }
 
     void sendText(std::string&& msg) override
     {
-        ws.text(true);
-        outBuffer.commit(boost::asio::buffer_copy(outBuffer.prepare(msg.size()),
-                                                  boost::asio::buffer(msg)));
-        doWrite();
+        enqueue({MessageType::Text, std::move(msg), nullptr});
+    }
+
+    void sendShared(MessageType type,
+                    std::shared_ptr<const std::string> msg) override
+    {
+        enqueue({type, std::move(msg), nullptr});
+    }
+
+    void setBackpressureHandler(size_t highWater,
+                                std::function<void(bool)> handler) override
+    {
+        outQueue.setLimits(highWater,
+                           bmcwebWebsocketWriteQueueLimitMb * 1024 * 1024);
+        outQueue.setCongestionHandler(std::move(handler));
+    }
+
+    void setOverflowPolicy(OverflowPolicy policy) override
+    {
+        overflowPolicy = policy;
     }
 
     void close(const std::string_view msg) override
@@ -302,36 +323,64 @@ class ConnectionImpl : public Connection
             handleMessage(bytesRead);
         });
     }
-    void doWrite()
+    void enqueue(WriteQueue::Message&& message)
     {
-        // If we're already doing a write, ignore the request, it will be picked
-        // up when the current write is complete
-        if (doingWrite)
+        if (outQueue.wouldOverflow(message.data().size()))
         {
+            if (overflowPolicy == OverflowPolicy::Drop)
+            {
+                BMCWEB_LOG_WARNING << this << " Websocket write queue full, "
+                                   << "dropping message";
+                if (message.onDone)
+                {
+                    message.onDone();
+                }
+                return;
+            }
+            BMCWEB_LOG_ERROR << this << " Websocket write queue full, closing";
+            outQueue.clear();
+            close("Write queue full");
             return;
         }
+        outQueue.push(std::move(message));
+        doWrite();
+    }
 
-        if (outBuffer.size() == 0)
+    // Writes the queued messages one frame at a time
+    void doWrite()
+    {
+        // If we're already doing a write, ignore the request, it will be picked
+        // up when the current write is complete
+        if (doingWrite || outQueue.empty())
         {
-            // Done for now
             return;
         }
         doingWrite = true;
-        ws.async_write(outBuffer.data(), [this, self(shared_from_this())](
-                                             const boost::beast::error_code& ec,
-                                             size_t bytesSent) {
+        const WriteQueue::Message& message = outQueue.front();
+        ws.binary(message.type == MessageType::Binary);
+        ws.async_write(boost::asio::buffer(message.data()),
+                       [this, self(shared_from_this())](
+                           const boost::beast::error_code& ec, size_t) {
             doingWrite = false;
-            outBuffer.consume(bytesSent);
+            std::function<void()> onDone = outQueue.pop();
+            // Call the done handler regardless of whether we errored, but
+            // before we close things out
+            if (onDone)
+            {
+                onDone();
+            }
             if (ec == boost::beast::websocket::error::closed)
             {
                 // Do nothing here.  doRead handler will call the
                 // closeHandler.
+                outQueue.clear();
                 close("Write error");
                 return;
             }
             if (ec)
             {
                 BMCWEB_LOG_ERROR << "Error in ws.async_write " << ec;
+                outQueue.clear();
                 return;
             }
             doWrite();
@@ -369,7 +418,7 @@ class ConnectionImpl : public Connection
         doRead();
     }
 
-    boost::beast::websocket::stream<Adaptor, false> ws;
+    boost::beast::websocket::stream<Adaptor, deflateSupported> ws;
 
     bool readingDefered = false;
     std::string inString;
@@ -378,7 +427,8 @@ class ConnectionImpl : public Connection
                                        std::string::allocator_type>
         inBuffer;
 
-    boost::beast::multi_buffer outBuffer;
+    WriteQueue outQueue;
+    OverflowPolicy overflowPolicy = OverflowPolicy::Close;
     bool doingWrite = false;
 
     std::function<void(Connection&)> openHandler;
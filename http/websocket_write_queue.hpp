@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+
+namespace crow
+{
+namespace websocket
+{
+
+enum class MessageType
+{
+    Binary,
+    Text,
+};
+
+// What happens to a message that would take a connection's write queue past
+// its limit
+enum class OverflowPolicy
+{
+    // The client isn't keeping up; give up on it
+    Close,
+    // Leave the message out.  For streams where a later message supersedes
+    // an earlier one, like sensor readings.
+    Drop,
+};
+
+/**
+ * @brief Messages waiting to be written to one websocket, each sent as its
+ * own frame straight from the storage it was handed over in.
+ *
+ * Owned strings are moved in, shared buffers let one message go to many
+ * connections without a copy each, and views are for sendEx() callers that
+ * keep the data alive until their completion handler runs.
+ */
+class WriteQueue
+{
+  public:
+    struct Message
+    {
+        MessageType type = MessageType::Binary;
+        std::variant<std::string, std::shared_ptr<const std::string>,
+                     std::string_view>
+            payload;
+        // Called once the message has been written, or dropped
+        std::function<void()> onDone;
+
+        std::string_view data() const
+        {
+            if (const std::string* owned = std::get_if<std::string>(&payload))
+            {
+                return *owned;
+            }
+            if (const auto* shared =
+                    std::get_if<std::shared_ptr<const std::string>>(&payload))
+            {
+                return **shared;
+            }
+            return std::get<std::string_view>(payload);
+        }
+    };
+
+    // highWaterIn of zero means the queue is never congested, and limitIn of
+    // zero that it is never full
+    void setLimits(size_t highWaterIn, size_t limitIn)
+    {
+        highWater = highWaterIn;
+        limit = limitIn;
+    }
+
+    // Called with true once more than the high water mark is waiting, and
+    // with false once it has drained to half of that
+    void setCongestionHandler(std::function<void(bool)> handler)
+    {
+        onCongestion = std::move(handler);
+    }
+
+    // Whether a message of size bytes would take the queue past its limit.
+    // A message is always taken when the queue is empty, however large it
+    // is.
+    bool wouldOverflow(size_t size) const
+    {
+        return limit != 0 && !messages.empty() && bytes + size > limit;
+    }
+
+    void push(Message&& message)
+    {
+        bytes += message.data().size();
+        messages.emplace_back(std::move(message));
+        if (!congested && highWater != 0 && bytes > highWater)
+        {
+            setCongested(true);
+        }
+    }
+
+    bool empty() const
+    {
+        return messages.empty();
+    }
+
+    size_t size() const
+    {
+        return bytes;
+    }
+
+    const Message& front() const
+    {
+        return messages.front();
+    }
+
+    // Removes the front message once it's written, returning its onDone
+    std::function<void()> pop()
+    {
+        std::function<void()> onDone = std::move(messages.front().onDone);
+        bytes -= messages.front().data().size();
+        messages.pop_front();
+        if (congested && bytes <= highWater / 2)
+        {
+            setCongested(false);
+        }
+        return onDone;
+    }
+
+    // Drops everything still waiting, without calling onDone, once the
+    // connection can't be written to any more
+    void clear()
+    {
+        messages.clear();
+        bytes = 0;
+        congested = false;
+    }
+
+  private:
+    void setCongested(bool value)
+    {
+        congested = value;
+        if (onCongestion)
+        {
+            onCongestion(value);
+        }
+    }
+
+    std::deque<Message> messages;
+    size_t bytes = 0;
+    size_t highWater = 0;
+    size_t limit = 0;
+    bool congested = false;
+    std::function<void(bool)> onCongestion;
+};
+
+} // namespace websocket
+} // namespace crow
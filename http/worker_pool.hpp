@@ -0,0 +1,56 @@
+#pragma once
+
+#include "bmcweb_config.h"
+
+#include <boost/asio/post.hpp>
+#ifndef BOOST_ASIO_DISABLE_THREADS
+#include <boost/asio/thread_pool.hpp>
+#endif
+
+#include <utility>
+
+namespace crow
+{
+namespace worker_pool
+{
+
+/**
+ * @brief Runs work on one of the http-worker-threads, then runs done on ex.
+ *
+ * bmcweb state (sessions, D-Bus, routing) is only ever touched from the main
+ * io_context, so work must only operate on data it owns for the duration of
+ * the call, such as the json and body of a response that is waiting to be
+ * written.  done is always posted back to ex and is where the result may be
+ * used.  When built with no worker threads, both run inline.
+ */
+template <typename Executor, typename Work, typename Done>
+inline void offload(const Executor& ex, Work&& work, Done&& done)
+{
+#ifndef BOOST_ASIO_DISABLE_THREADS
+    if constexpr (bmcwebHttpWorkerThreads > 0)
+    {
+        static boost::asio::thread_pool pool(bmcwebHttpWorkerThreads);
+        boost::asio::post(pool, [ex, work{std::forward<Work>(work)},
+                                 done{std::forward<Done>(done)}]() mutable {
+            work();
+            boost::asio::post(ex, std::move(done));
+        });
+        return;
+    }
+#endif
+    (void)ex;
+    work();
+    done();
+}
+
+inline constexpr bool enabled()
+{
+#ifdef BOOST_ASIO_DISABLE_THREADS
+    return false;
+#else
+    return bmcwebHttpWorkerThreads > 0;
+#endif
+}
+
+} // namespace worker_pool
+} // namespace crow
@@ -1,8 +1,10 @@
 #pragma once
 
+#include "cancellation.hpp"
 #include "http_response.hpp"
 
 #include <functional>
+#include <memory>
 
 namespace bmcweb
 {
@@ -28,7 +30,15 @@ class AsyncResp
         res.end();
     }
 
+    // Whether the client has gone, so the work left for this response can
+    // be dropped.  Responses that aren't for a client never are.
+    bool cancelled() const
+    {
+        return cancellation != nullptr && cancellation->cancelled();
+    }
+
     crow::Response res;
+    std::shared_ptr<const crow::Cancellation> cancellation;
 };
 
 } // namespace bmcweb
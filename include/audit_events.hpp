@@ -2,13 +2,20 @@
 
 #include "http_request.hpp"
 #include "logging.hpp"
+#include "worker_pool.hpp"
 
 #include <libaudit.h>
 
+#include <boost/asio/io_context.hpp>
 #include <boost/asio/ip/host_name.hpp>
+#include <boost/asio/post.hpp>
 
+#include <cstdint>
 #include <cstring>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace audit
 {
@@ -203,14 +210,28 @@ inline bool appendItemToBuf(std::string& strBuf, size_t maxBufSize,
     return true;
 }
 
-inline void auditEvent(const crow::Request& req, const std::string& userName,
-                       bool success)
+/**
+ * @brief One audit message, formatted on the io thread from the request it
+ * records so that it can be written after the request is gone
+ */
+struct AuditRecord
 {
-    if (!auditOpen())
+    std::string message;
+    std::string ipAddress;
+    bool success = false;
+    // Identical records queued back to back are written once, with a count
+    size_t count = 1;
+
+    bool sameEvent(const AuditRecord& other) const
     {
-        return;
+        return message == other.message && ipAddress == other.ipAddress &&
+               success == other.success;
     }
+};
 
+inline AuditRecord formatAuditRecord(const crow::Request& req,
+                                     const std::string& userName, bool success)
+{
     std::string opPath = "op=" + std::string(req.methodString()) + ":" +
                          std::string(req.target()) + " ";
 
@@ -278,12 +299,32 @@ inline void auditEvent(const crow::Request& req, const std::string& userName,
                      << " detailLen=" << detail.length()
                      << " userLen=" << userLen;
 
-    std::string ipAddress = req.ipAddress.to_string();
+    return {std::move(cnfgBuff), req.ipAddress.to_string(), success};
+}
+
+/**
+ * @brief Sends record to the audit subsystem.  This is a blocking netlink
+ * write, so it is normally only called from AuditQueue.
+ */
+inline void writeAuditRecord(const AuditRecord& record)
+{
+    if (!auditOpen())
+    {
+        return;
+    }
+
+    std::string message = record.message;
+    if (record.count > 1)
+    {
+        message += " count=" + std::to_string(record.count);
+    }
+
+    static const std::string hostName = boost::asio::ip::host_name();
 
     int rc = audit_log_user_message(auditfd, AUDIT_USYS_CONFIG,
-                                    cnfgBuff.c_str(),
-                                    boost::asio::ip::host_name().c_str(),
-                                    ipAddress.c_str(), NULL, int(success));
+                                    message.c_str(), hostName.c_str(),
+                                    record.ipAddress.c_str(), NULL,
+                                    int(record.success));
 
     if (rc <= 0)
     {
@@ -294,17 +335,127 @@ inline void auditEvent(const crow::Request& req, const std::string& userName,
         if (auditReopen())
         {
             rc = audit_log_user_message(auditfd, AUDIT_USYS_CONFIG,
-                                        cnfgBuff.c_str(),
-                                        boost::asio::ip::host_name().c_str(),
-                                        ipAddress.c_str(), NULL, int(success));
+                                        message.c_str(), hostName.c_str(),
+                                        record.ipAddress.c_str(), NULL,
+                                        int(record.success));
         }
         if (rc <= 0)
         {
             BMCWEB_LOG_ERROR << "Error writing audit message: " << origErrno;
         }
     }
+}
 
-    return;
+/**
+ * @brief Audit records waiting to be written.
+ *
+ * Records are queued on the io thread and written in batches by a worker
+ * thread (or, with no http-worker-threads, from a handler posted after the
+ * response), so a burst of mutating requests doesn't wait on the audit
+ * socket one request at a time.  At most maxQueued records wait at once; any
+ * more are dropped and counted, and the count is itself written to the audit
+ * log with the next batch.
+ */
+class AuditQueue
+{
+  public:
+    static constexpr size_t maxQueued = 1024;
+
+    static AuditQueue& getInstance()
+    {
+        static AuditQueue queue;
+        return queue;
+    }
+
+    void push(boost::asio::io_context& io, AuditRecord&& record)
+    {
+        if (!queued.empty() && queued.back().sameEvent(record))
+        {
+            queued.back().count++;
+            coalesced++;
+        }
+        else if (queued.size() >= maxQueued)
+        {
+            dropped++;
+            droppedSinceWrite++;
+        }
+        else
+        {
+            queued.emplace_back(std::move(record));
+        }
+        if (!writing)
+        {
+            writing = true;
+            boost::asio::post(io, [this, &io]() { writeBatch(io); });
+        }
+    }
+
+    size_t size() const
+    {
+        return queued.size();
+    }
+
+    uint64_t droppedTotal() const
+    {
+        return dropped;
+    }
+
+    uint64_t coalescedTotal() const
+    {
+        return coalesced;
+    }
+
+  private:
+    void writeBatch(boost::asio::io_context& io)
+    {
+        std::vector<AuditRecord> batch = std::move(queued);
+        queued.clear();
+        if (droppedSinceWrite > 0)
+        {
+            batch.push_back({"op=audit-queue-overflow dropped=" +
+                                 std::to_string(droppedSinceWrite) + " ",
+                             "", false});
+            droppedSinceWrite = 0;
+        }
+        if (batch.empty())
+        {
+            writing = false;
+            return;
+        }
+        crow::worker_pool::offload(
+            io.get_executor(),
+            [batch{std::move(batch)}]() {
+            for (const AuditRecord& record : batch)
+            {
+                writeAuditRecord(record);
+            }
+        },
+            [this, &io]() { writeBatch(io); });
+    }
+
+    std::vector<AuditRecord> queued;
+    bool writing = false;
+    uint64_t dropped = 0;
+    uint64_t droppedSinceWrite = 0;
+    uint64_t coalesced = 0;
+};
+
+inline void auditEvent(const crow::Request& req, const std::string& userName,
+                       bool success)
+{
+    if (!tryOpen)
+    {
+        BMCWEB_LOG_DEBUG << "Audit connection disabled";
+        return;
+    }
+
+    AuditRecord record = formatAuditRecord(req, userName, success);
+    if (req.ioService == nullptr)
+    {
+        writeAuditRecord(record);
+        return;
+    }
+    AuditQueue::getInstance().push(*req.ioService, std::move(record));
 }
 
 } // namespace audit
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "basic_auth_cache.hpp"
 #include "webroutes.hpp"
 
 #include <app.hpp>
@@ -36,14 +37,35 @@ static void cleanupTempSession(const Request& req)
 
 #ifdef BMCWEB_ENABLE_BASIC_AUTHENTICATION
 static std::shared_ptr<persistent_data::UserSession>
-    performBasicAuth(const boost::asio::ip::address& clientIp,
-                     std::string_view authHeader)
+    afterBasicAuth(const boost::asio::ip::address& clientIp,
+                   const std::string& user, int pamrc)
+{
+    bool isConfigureSelfOnly = pamrc == PAM_NEW_AUTHTOK_REQD;
+    if ((pamrc != PAM_SUCCESS) && !isConfigureSelfOnly)
+    {
+        return nullptr;
+    }
+
+    // TODO(ed) generateUserSession is a little expensive for basic
+    // auth, as it generates some random identifiers that will never be
+    // used.  This should have a "fast" path for when user tokens aren't
+    // needed.
+    return persistent_data::SessionStore::getInstance().generateUserSession(
+        user, clientIp, std::nullopt,
+        persistent_data::PersistenceType::SINGLE_REQUEST, isConfigureSelfOnly);
+}
+
+template <typename Executor, typename Callback>
+inline void performBasicAuth(const Executor& ex,
+                             const boost::asio::ip::address& clientIp,
+                             std::string_view authHeader, Callback&& callback)
 {
     BMCWEB_LOG_DEBUG << "[AuthMiddleware] Basic authentication";
 
     if (!authHeader.starts_with("Basic "))
     {
-        return nullptr;
+        callback(nullptr);
+        return;
     }
 
     std::string_view param = authHeader.substr(strlen("Basic "));
@@ -51,19 +73,22 @@ static std::shared_ptr<persistent_data::UserSession>
 
     if (!crow::utility::base64Decode(param, authData))
     {
-        return nullptr;
+        callback(nullptr);
+        return;
     }
     std::size_t separator = authData.find(':');
     if (separator == std::string::npos)
     {
-        return nullptr;
+        callback(nullptr);
+        return;
     }
 
     std::string user = authData.substr(0, separator);
     separator += 1;
     if (separator > authData.size())
     {
-        return nullptr;
+        callback(nullptr);
+        return;
     }
     std::string pass = authData.substr(separator);
 
@@ -71,22 +96,30 @@ static std::shared_ptr<persistent_data::UserSession>
     BMCWEB_LOG_DEBUG << "[AuthMiddleware] User IPAddress: "
                      << clientIp.to_string();
 
-    int pamrc = pamAuthenticateUser(user, pass);
-    bool isConfigureSelfOnly = pamrc == PAM_NEW_AUTHTOK_REQD;
-    if ((pamrc != PAM_SUCCESS) && !isConfigureSelfOnly)
+    BasicAuthCache& cache = BasicAuthCache::getInstance();
+    std::string credentials = cache.digest(user, pass);
+    if (cache.lookup(credentials))
     {
-        return nullptr;
+        BMCWEB_LOG_DEBUG << "[AuthMiddleware] Using cached PAM result";
+        callback(afterBasicAuth(clientIp, user, PAM_SUCCESS));
+        return;
     }
 
-    // TODO(ed) generateUserSession is a little expensive for basic
-    // auth, as it generates some random identifiers that will never be
-    // used.  This should have a "fast" path for when user tokens aren't
-    // needed.
-    // This whole flow needs to be revisited anyway, as we can't be
-    // calling directly into pam for every request
-    return persistent_data::SessionStore::getInstance().generateUserSession(
-        user, clientIp, std::nullopt,
-        persistent_data::PersistenceType::SINGLE_REQUEST, isConfigureSelfOnly);
+    pamAuthenticateUserAsync(
+        ex, user, std::move(pass),
+        [clientIp, user, credentials{std::move(credentials)},
+         generation{cache.generation()},
+         callback{std::forward<Callback>(callback)}](int pamrc) mutable {
+        std::shared_ptr<persistent_data::UserSession> session =
+            afterBasicAuth(clientIp, user, pamrc);
+        // Not PAM_NEW_AUTHTOK_REQD, so an expired password is checked
+        // again each time
+        if (pamrc == PAM_SUCCESS)
+        {
+            BasicAuthCache::getInstance().insert(credentials, user, generation);
+        }
+        callback(std::move(session));
+    });
 }
 #endif
 
@@ -275,24 +308,25 @@ static std::shared_ptr<persistent_data::UserSession>
         [[maybe_unused]] const std::shared_ptr<persistent_data::UserSession>&
             session)
 {
-    const persistent_data::AuthConfigMethods& authMethodsConfig =
-        persistent_data::SessionStore::getInstance().getAuthMethodsConfig();
+    std::shared_ptr<const persistent_data::AuthConfigMethods>
+        authMethodsConfig =
+            persistent_data::SessionStore::getInstance().getAuthMethodsConfig();
 
     std::shared_ptr<persistent_data::UserSession> sessionOut = nullptr;
 #ifdef BMCWEB_ENABLE_MUTUAL_TLS_AUTHENTICATION
-    if (authMethodsConfig.tls)
+    if (authMethodsConfig->tls)
     {
         sessionOut = performTLSAuth(res, reqHeader, session);
     }
 #endif
 #ifdef BMCWEB_ENABLE_XTOKEN_AUTHENTICATION
-    if (sessionOut == nullptr && authMethodsConfig.xtoken)
+    if (sessionOut == nullptr && authMethodsConfig->xtoken)
     {
         sessionOut = performXtokenAuth(reqHeader);
     }
 #endif
 #ifdef BMCWEB_ENABLE_COOKIE_AUTHENTICATION
-    if (sessionOut == nullptr && authMethodsConfig.cookie)
+    if (sessionOut == nullptr && authMethodsConfig->cookie)
     {
         sessionOut = performCookieAuth(method, reqHeader);
     }
@@ -300,16 +334,10 @@ static std::shared_ptr<persistent_data::UserSession>
     std::string_view authHeader = reqHeader["Authorization"];
     BMCWEB_LOG_DEBUG << "authHeader=" << authHeader;
 
-    if (sessionOut == nullptr && authMethodsConfig.sessionToken)
+    if (sessionOut == nullptr && authMethodsConfig->sessionToken)
     {
 #ifdef BMCWEB_ENABLE_SESSION_AUTHENTICATION
         sessionOut = performTokenAuth(authHeader);
-#endif
-    }
-    if (sessionOut == nullptr && authMethodsConfig.basic)
-    {
-#ifdef BMCWEB_ENABLE_BASIC_AUTHENTICATION
-        sessionOut = performBasicAuth(ipAddress, authHeader);
 #endif
     }
     if (sessionOut != nullptr)
@@ -320,5 +348,37 @@ static std::shared_ptr<persistent_data::UserSession>
     return nullptr;
 }
 
+/**
+ * @brief authenticate(), falling back to basic auth when allowed.
+ *
+ * Basic auth asks PAM, which runs on a worker thread when bmcweb has them, so
+ * the result is always delivered through callback(session) on ex, or inline
+ * when no PAM call was needed.
+ */
+template <typename Executor, typename Callback>
+inline void authenticate(
+    const Executor& ex [[maybe_unused]],
+    const boost::asio::ip::address& ipAddress, Response& res,
+    boost::beast::http::verb method,
+    const boost::beast::http::header<true>& reqHeader,
+    const std::shared_ptr<persistent_data::UserSession>& session,
+    Callback&& callback)
+{
+    std::shared_ptr<persistent_data::UserSession> sessionOut =
+        authenticate(ipAddress, res, method, reqHeader, session);
+#ifdef BMCWEB_ENABLE_BASIC_AUTHENTICATION
+    std::shared_ptr<const persistent_data::AuthConfigMethods>
+        authMethodsConfig =
+            persistent_data::SessionStore::getInstance().getAuthMethodsConfig();
+    if (sessionOut == nullptr && authMethodsConfig->basic)
+    {
+        performBasicAuth(ex, ipAddress, reqHeader["Authorization"],
+                         std::forward<Callback>(callback));
+        return;
+    }
+#endif
+    callback(std::move(sessionOut));
+}
+
 } // namespace authentication
 } // namespace crow
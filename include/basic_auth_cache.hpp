@@ -0,0 +1,199 @@
+#pragma once
+
+#include "bmcweb_config.h"
+#include "logging.hpp"
+
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/rand.h>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace crow
+{
+namespace authentication
+{
+
+// Most credentials remembered at once.  Clients past this go back to PAM.
+constexpr std::size_t basicAuthCacheMaxEntries = 64;
+
+/**
+ * @brief Remembers username/password pairs PAM accepted recently, so clients
+ * that send basic auth on every request don't pay for a PAM conversation each
+ * time.
+ *
+ * Entries are keyed by an HMAC-SHA256 of the credentials under a key drawn at
+ * startup; neither passwords nor unkeyed digests of them are ever stored.
+ * Only PAM_SUCCESS is remembered.  Failed attempts always reach PAM and its
+ * lockout accounting, and so does an expired password, which an admin may
+ * change outside bmcweb at any time.
+ *
+ * Not thread safe: every call has to be made from the thread running the main
+ * io_context, as authentication is today.  Dispatching requests from more
+ * threads needs a lock here first.
+ */
+class BasicAuthCache
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit BasicAuthCache(Clock::duration timeoutIn) : timeout(timeoutIn)
+    {
+        if (RAND_bytes(key.data(), static_cast<int>(key.size())) != 1)
+        {
+            BMCWEB_LOG_ERROR << "Cannot key the basic auth cache; disabling it";
+            timeout = Clock::duration::zero();
+        }
+    }
+
+    static BasicAuthCache& getInstance()
+    {
+        static BasicAuthCache cache{
+            std::chrono::seconds(bmcwebBasicAuthCacheTimeoutSeconds)};
+        return cache;
+    }
+
+    ~BasicAuthCache() = default;
+    BasicAuthCache(const BasicAuthCache&) = delete;
+    BasicAuthCache& operator=(const BasicAuthCache&) = delete;
+    BasicAuthCache(BasicAuthCache&&) = delete;
+    BasicAuthCache& operator=(BasicAuthCache&&) = delete;
+
+    bool enabled() const
+    {
+        return timeout > Clock::duration::zero();
+    }
+
+    // Cache key for these credentials, or empty if the cache is disabled
+    std::string digest(std::string_view username,
+                       std::string_view password) const
+    {
+        if (!enabled())
+        {
+            return "";
+        }
+        // The separator keeps "ab"+"c" and "a"+"bc" apart; PAM usernames
+        // can't contain NUL
+        std::string data(username);
+        data += '\0';
+        data += password;
+
+        std::array<unsigned char, EVP_MAX_MD_SIZE> out{};
+        unsigned int outLen = 0;
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        const auto* dataPtr =
+            reinterpret_cast<const unsigned char*>(data.data());
+        if (HMAC(EVP_sha256(), key.data(), static_cast<int>(key.size()),
+                 dataPtr, data.size(), out.data(), &outLen) == nullptr)
+        {
+            return "";
+        }
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        return {reinterpret_cast<const char*>(out.data()), outLen};
+    }
+
+    // Whether PAM accepted these credentials recently enough to skip it
+    bool lookup(const std::string& credentials,
+                Clock::time_point now = Clock::now())
+    {
+        if (credentials.empty())
+        {
+            return false;
+        }
+        auto it = entries.find(credentials);
+        if (it == entries.end())
+        {
+            return false;
+        }
+        if (now - it->second.verified >= timeout)
+        {
+            entries.erase(it);
+            return false;
+        }
+        return true;
+    }
+
+    // Counter to read before asking PAM and pass to insert(), so a result
+    // that raced with an invalidation is dropped
+    uint64_t generation() const
+    {
+        return currentGeneration;
+    }
+
+    // Remembers credentials PAM returned PAM_SUCCESS for
+    void insert(const std::string& credentials, std::string_view username,
+                uint64_t startedGeneration,
+                Clock::time_point now = Clock::now())
+    {
+        if (credentials.empty() || startedGeneration != currentGeneration)
+        {
+            return;
+        }
+        if (entries.size() >= basicAuthCacheMaxEntries &&
+            entries.find(credentials) == entries.end())
+        {
+            evictOldest(now);
+        }
+        entries.insert_or_assign(credentials,
+                                 Entry{std::string(username), now});
+    }
+
+    // Forgets this user's credentials, or everyone's if username is empty
+    void invalidate(std::string_view username)
+    {
+        currentGeneration++;
+        if (username.empty())
+        {
+            entries.clear();
+            return;
+        }
+        std::erase_if(entries, [username](const auto& entry) {
+            return entry.second.username == username;
+        });
+    }
+
+    std::size_t size() const
+    {
+        return entries.size();
+    }
+
+  private:
+    struct Entry
+    {
+        std::string username;
+        Clock::time_point verified;
+    };
+
+    void evictOldest(Clock::time_point now)
+    {
+        std::erase_if(entries, [this, now](const auto& entry) {
+            return now - entry.second.verified >= timeout;
+        });
+        if (entries.size() < basicAuthCacheMaxEntries)
+        {
+            return;
+        }
+        auto oldest = entries.begin();
+        for (auto it = entries.begin(); it != entries.end(); it++)
+        {
+            if (it->second.verified < oldest->second.verified)
+            {
+                oldest = it;
+            }
+        }
+        entries.erase(oldest);
+    }
+
+    Clock::duration timeout;
+    std::array<unsigned char, 32> key{};
+    uint64_t currentGeneration = 0;
+    std::unordered_map<std::string, Entry> entries;
+};
+
+} // namespace authentication
+} // namespace crow
@@ -0,0 +1,642 @@
+#pragma once
+
+#include "async_file.hpp"
+#include "dbus_singleton.hpp"
+#include "dbus_utility.hpp"
+#include "logging.hpp"
+#include "persistent_data.hpp"
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/system/error_code.hpp>
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace dbus
+{
+namespace utility
+{
+
+/**
+ * @brief What DbusObjectCache held at one point, in a form that can be
+ * written to a file and read back when bmcweb next starts.
+ *
+ * Every mapper reply is kept.  GetAll replies are only kept for inventory
+ * interfaces that describe the hardware rather than its state, and only when
+ * every value is a string or a bool; see snapshotInterfaces.
+ */
+struct CacheSnapshot
+{
+    struct Properties
+    {
+        std::string service;
+        std::string path;
+        std::string interface;
+        DBusPropertiesMap properties;
+    };
+
+    // Keyed by DbusObjectCache::mapperKey()
+    std::vector<std::pair<std::string, MapperGetSubTreeResponse>> subTrees;
+    std::vector<std::pair<std::string, MapperGetSubTreePathsResponse>>
+        subTreePaths;
+    std::vector<std::pair<std::string, MapperGetObject>> objects;
+    std::vector<Properties> properties;
+};
+
+// Bumped whenever the encoding changes; other versions aren't loaded
+constexpr uint64_t cacheSnapshotVersion = 1;
+
+// Interfaces whose GetAll replies are saved.  These are only read once per
+// part in practice, so having them at startup saves a read per part on the
+// first inventory walk.
+constexpr std::array<std::string_view, 3> snapshotInterfaces = {
+    "xyz.openbmc_project.Inventory.Decorator.Asset",
+    "xyz.openbmc_project.Inventory.Decorator.LocationCode",
+    "xyz.openbmc_project.Inventory.Decorator.Revision"};
+
+/**
+ * @brief The arguments of a mapper call, as recovered from its
+ * DbusObjectCache::mapperKey()
+ */
+struct MapperQuery
+{
+    std::string method;
+    std::string path;
+    int32_t depth = 0;
+    std::vector<std::string> interfaces;
+};
+
+inline std::optional<MapperQuery> parseMapperKey(std::string_view key)
+{
+    std::vector<std::string_view> fields;
+    size_t start = 0;
+    while (true)
+    {
+        size_t split = key.find('|', start);
+        fields.emplace_back(key.substr(start, split - start));
+        if (split == std::string_view::npos)
+        {
+            break;
+        }
+        start = split + 1;
+    }
+    if (fields.size() < 3)
+    {
+        return std::nullopt;
+    }
+    MapperQuery query;
+    query.method = fields[0];
+    query.path = fields[1];
+    const char* end = fields[2].data() + fields[2].size();
+    auto [ptr, ec] = std::from_chars(fields[2].data(), end, query.depth);
+    if (ec != std::errc() || ptr != end)
+    {
+        return std::nullopt;
+    }
+    for (size_t i = 3; i < fields.size(); i++)
+    {
+        query.interfaces.emplace_back(fields[i]);
+    }
+    return query;
+}
+
+inline CacheSnapshot takeCacheSnapshot(const DbusObjectCache& cache)
+{
+    CacheSnapshot snapshot;
+    cache.forEachMapper([&snapshot](const std::string& key,
+                                    const auto& response) {
+        using ResponseType = std::decay_t<decltype(response)>;
+        if constexpr (std::is_same_v<ResponseType, MapperGetSubTreeResponse>)
+        {
+            snapshot.subTrees.emplace_back(key, response);
+        }
+        else if constexpr (std::is_same_v<ResponseType,
+                                          MapperGetSubTreePathsResponse>)
+        {
+            snapshot.subTreePaths.emplace_back(key, response);
+        }
+        else
+        {
+            snapshot.objects.emplace_back(key, response);
+        }
+    });
+    cache.forEachProperties(
+        [&snapshot](const std::string& service, const std::string& path,
+                    const std::string& interface,
+                    const DBusPropertiesMap& properties) {
+        if (std::find(snapshotInterfaces.begin(), snapshotInterfaces.end(),
+                      interface) == snapshotInterfaces.end())
+        {
+            return;
+        }
+        for (const auto& property : properties)
+        {
+            if (!std::holds_alternative<std::string>(property.second) &&
+                !std::holds_alternative<bool>(property.second))
+            {
+                return;
+            }
+        }
+        snapshot.properties.emplace_back(
+            CacheSnapshot::Properties{service, path, interface, properties});
+    });
+    return snapshot;
+}
+
+inline std::string encodeCacheSnapshot(const CacheSnapshot& snapshot)
+{
+    nlohmann::json::object_t data;
+    data["version"] = cacheSnapshotVersion;
+    data["subtrees"] = snapshot.subTrees;
+    data["subtree_paths"] = snapshot.subTreePaths;
+    data["objects"] = snapshot.objects;
+    nlohmann::json::array_t properties;
+    for (const CacheSnapshot::Properties& entry : snapshot.properties)
+    {
+        nlohmann::json::object_t values;
+        for (const auto& [name, value] : entry.properties)
+        {
+            const std::string* str = std::get_if<std::string>(&value);
+            if (str != nullptr)
+            {
+                values[name] = *str;
+                continue;
+            }
+            const bool* flag = std::get_if<bool>(&value);
+            if (flag != nullptr)
+            {
+                values[name] = *flag;
+            }
+        }
+        nlohmann::json::array_t row;
+        row.emplace_back(entry.service);
+        row.emplace_back(entry.path);
+        row.emplace_back(entry.interface);
+        row.emplace_back(std::move(values));
+        properties.emplace_back(std::move(row));
+    }
+    data["properties"] = std::move(properties);
+
+    std::string out;
+    nlohmann::json::to_cbor(data, out);
+    return out;
+}
+
+namespace snapshot_detail
+{
+
+inline bool readStrings(const nlohmann::json& json,
+                        std::vector<std::string>& out)
+{
+    const nlohmann::json::array_t* arr =
+        json.get_ptr<const nlohmann::json::array_t*>();
+    if (arr == nullptr)
+    {
+        return false;
+    }
+    for (const nlohmann::json& item : *arr)
+    {
+        const std::string* str = item.get_ptr<const std::string*>();
+        if (str == nullptr)
+        {
+            return false;
+        }
+        out.emplace_back(*str);
+    }
+    return true;
+}
+
+// Reads [first, second] into a pair, with readSecond() filling second
+template <typename T, typename ReadSecond>
+bool readPair(const nlohmann::json& json, std::pair<std::string, T>& out,
+              ReadSecond&& readSecond)
+{
+    const nlohmann::json::array_t* arr =
+        json.get_ptr<const nlohmann::json::array_t*>();
+    if (arr == nullptr || arr->size() != 2)
+    {
+        return false;
+    }
+    const std::string* first = (*arr)[0].get_ptr<const std::string*>();
+    if (first == nullptr)
+    {
+        return false;
+    }
+    out.first = *first;
+    return readSecond((*arr)[1], out.second);
+}
+
+// Reads an array of pairs, with readSecond() filling each second
+template <typename T, typename ReadSecond>
+bool readPairs(const nlohmann::json& json,
+               std::vector<std::pair<std::string, T>>& out,
+               ReadSecond&& readSecond)
+{
+    const nlohmann::json::array_t* arr =
+        json.get_ptr<const nlohmann::json::array_t*>();
+    if (arr == nullptr)
+    {
+        return false;
+    }
+    for (const nlohmann::json& item : *arr)
+    {
+        if (!readPair(item, out.emplace_back(), readSecond))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+inline bool readServiceMap(const nlohmann::json& json, MapperServiceMap& out)
+{
+    return readPairs(json, out, readStrings);
+}
+
+inline bool readSubTree(const nlohmann::json& json,
+                        MapperGetSubTreeResponse& out)
+{
+    return readPairs(json, out, readServiceMap);
+}
+
+inline bool readProperties(const nlohmann::json& json,
+                           CacheSnapshot::Properties& out)
+{
+    const nlohmann::json::array_t* arr =
+        json.get_ptr<const nlohmann::json::array_t*>();
+    if (arr == nullptr || arr->size() != 4)
+    {
+        return false;
+    }
+    const std::string* service = (*arr)[0].get_ptr<const std::string*>();
+    const std::string* path = (*arr)[1].get_ptr<const std::string*>();
+    const std::string* interface = (*arr)[2].get_ptr<const std::string*>();
+    const nlohmann::json::object_t* values =
+        (*arr)[3].get_ptr<const nlohmann::json::object_t*>();
+    if (service == nullptr || path == nullptr || interface == nullptr ||
+        values == nullptr)
+    {
+        return false;
+    }
+    out.service = *service;
+    out.path = *path;
+    out.interface = *interface;
+    for (const auto& [name, value] : *values)
+    {
+        const std::string* str = value.get_ptr<const std::string*>();
+        const bool* flag = value.get_ptr<const bool*>();
+        if (str != nullptr)
+        {
+            out.properties.emplace_back(name, *str);
+        }
+        else if (flag != nullptr)
+        {
+            out.properties.emplace_back(name, *flag);
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace snapshot_detail
+
+/**
+ * @brief Reads a snapshot written by encodeCacheSnapshot().  Anything that
+ * doesn't parse, or was written by another version, gives nullopt.
+ */
+inline std::optional<CacheSnapshot>
+    decodeCacheSnapshot(std::string_view encoded)
+{
+    using namespace snapshot_detail;
+
+    nlohmann::json data = nlohmann::json::from_cbor(encoded, true, false);
+    const nlohmann::json::object_t* obj =
+        data.get_ptr<const nlohmann::json::object_t*>();
+    if (obj == nullptr)
+    {
+        return std::nullopt;
+    }
+    auto version = obj->find("version");
+    auto subTrees = obj->find("subtrees");
+    auto subTreePaths = obj->find("subtree_paths");
+    auto objects = obj->find("objects");
+    auto properties = obj->find("properties");
+    if (version == obj->end() || subTrees == obj->end() ||
+        subTreePaths == obj->end() || objects == obj->end() ||
+        properties == obj->end())
+    {
+        return std::nullopt;
+    }
+    const uint64_t* versionNum = version->second.get_ptr<const uint64_t*>();
+    if (versionNum == nullptr || *versionNum != cacheSnapshotVersion)
+    {
+        return std::nullopt;
+    }
+
+    CacheSnapshot snapshot;
+    if (!readPairs(subTrees->second, snapshot.subTrees, readSubTree) ||
+        !readPairs(subTreePaths->second, snapshot.subTreePaths,
+                   readStrings) ||
+        !readPairs(objects->second, snapshot.objects, readServiceMap))
+    {
+        return std::nullopt;
+    }
+    const nlohmann::json::array_t* propertyRows =
+        properties->second.get_ptr<const nlohmann::json::array_t*>();
+    if (propertyRows == nullptr)
+    {
+        return std::nullopt;
+    }
+    for (const nlohmann::json& row : *propertyRows)
+    {
+        if (!readProperties(row, snapshot.properties.emplace_back()))
+        {
+            return std::nullopt;
+        }
+    }
+    return snapshot;
+}
+
+/**
+ * @brief Keeps a copy of DbusObjectCache on disk, so a restarted bmcweb
+ * doesn't have to rebuild it from the mapper one request at a time.
+ *
+ * The snapshot is written every writeInterval when it has changed, and on
+ * exit.  At startup it's loaded into the cache and served as is, and every
+ * entry is then fetched again, one call at a time on the bulk connection;
+ * replies replace the loaded entries, and entries whose call fails are
+ * dropped.  The usual signal handling applies to loaded entries too, so
+ * anything that changes before it's fetched again is dropped as well.
+ */
+class DbusCacheSnapshot
+{
+  public:
+    static constexpr const char* filename = "bmcweb_dbus_cache.cbor";
+    static constexpr std::chrono::minutes writeInterval{10};
+    // Larger files are neither written nor read
+    static constexpr size_t maxFileSize = 4 * 1024 * 1024;
+
+    static DbusCacheSnapshot& getInstance()
+    {
+        static DbusCacheSnapshot snapshot;
+        return snapshot;
+    }
+
+    DbusCacheSnapshot(const DbusCacheSnapshot&) = delete;
+    DbusCacheSnapshot(DbusCacheSnapshot&&) = delete;
+    DbusCacheSnapshot& operator=(const DbusCacheSnapshot&) = delete;
+    DbusCacheSnapshot& operator=(DbusCacheSnapshot&&) = delete;
+    ~DbusCacheSnapshot() = default;
+
+    // Loads the snapshot, if there is one, and starts writing it.  The cache
+    // must already be registered.
+    void start(boost::asio::io_context& ioIn)
+    {
+        io = &ioIn;
+        timer.emplace(ioIn);
+        crow::async_file::asyncReadFile(
+            ioIn.get_executor(), filename, maxFileSize,
+            [this](const boost::system::error_code& ec,
+                   std::string&& contents) {
+            if (!ec)
+            {
+                load(contents);
+            }
+            armTimer();
+        });
+    }
+
+    // Writes the snapshot a last time; must be called before io is destroyed
+    void stop()
+    {
+        timer.reset();
+        io = nullptr;
+        write();
+    }
+
+  private:
+    DbusCacheSnapshot() = default;
+
+    void load(std::string_view contents)
+    {
+        std::optional<CacheSnapshot> snapshot = decodeCacheSnapshot(contents);
+        if (!snapshot)
+        {
+            BMCWEB_LOG_ERROR << "Ignoring unreadable D-Bus cache snapshot";
+            return;
+        }
+        DbusObjectCache& cache = DbusObjectCache::getInstance();
+        auto pending = std::make_shared<Pending>();
+        for (const auto& [key, response] : snapshot->subTrees)
+        {
+            cache.insertMapper(key, cache.getMapperGeneration(), response);
+            pending->mapperKeys.emplace_back(key);
+        }
+        for (const auto& [key, response] : snapshot->subTreePaths)
+        {
+            cache.insertMapper(key, cache.getMapperGeneration(), response);
+            pending->mapperKeys.emplace_back(key);
+        }
+        for (const auto& [key, response] : snapshot->objects)
+        {
+            cache.insertMapper(key, cache.getMapperGeneration(), response);
+            pending->mapperKeys.emplace_back(key);
+        }
+        for (CacheSnapshot::Properties& entry : snapshot->properties)
+        {
+            cache.insertProperties(entry.service, entry.path, entry.interface,
+                                   cache.getGeneration(), entry.properties);
+            pending->properties.emplace_back(std::move(entry));
+        }
+        BMCWEB_LOG_INFO << "Loaded " << pending->mapperKeys.size()
+                        << " mapper replies and "
+                        << pending->properties.size()
+                        << " property sets from the D-Bus cache snapshot";
+        revalidateNext(pending);
+    }
+
+    // What's still to be fetched again after a load
+    struct Pending
+    {
+        std::vector<std::string> mapperKeys;
+        std::vector<CacheSnapshot::Properties> properties;
+        size_t next = 0;
+    };
+
+    static void revalidateNext(const std::shared_ptr<Pending>& pending)
+    {
+        size_t index = pending->next++;
+        if (index < pending->mapperKeys.size())
+        {
+            revalidateMapper(pending, pending->mapperKeys[index]);
+            return;
+        }
+        index -= pending->mapperKeys.size();
+        if (index < pending->properties.size())
+        {
+            revalidateProperties(pending, pending->properties[index]);
+        }
+    }
+
+    template <typename ResponseType>
+    static auto mapperReplyHandler(const std::shared_ptr<Pending>& pending,
+                                   const std::string& key)
+    {
+        uint64_t generation =
+            DbusObjectCache::getInstance().getMapperGeneration();
+        return [pending, key, generation](const boost::system::error_code& ec,
+                                          const ResponseType& response) {
+            DbusObjectCache& cache = DbusObjectCache::getInstance();
+            if (ec)
+            {
+                cache.eraseMapper(key);
+            }
+            else
+            {
+                // Dropped if the mapper changed meanwhile, in which case the
+                // loaded entry went with everything else
+                cache.insertMapper(key, generation, response);
+            }
+            revalidateNext(pending);
+        };
+    }
+
+    static void revalidateMapper(const std::shared_ptr<Pending>& pending,
+                                 const std::string& key)
+    {
+        std::optional<MapperQuery> query = parseMapperKey(key);
+        if (!query)
+        {
+            DbusObjectCache::getInstance().eraseMapper(key);
+            revalidateNext(pending);
+            return;
+        }
+        if (query->method == "GetSubTree")
+        {
+            crow::connections::bulkBus->async_method_call(
+                mapperReplyHandler<MapperGetSubTreeResponse>(pending, key),
+                "xyz.openbmc_project.ObjectMapper",
+                "/xyz/openbmc_project/object_mapper",
+                "xyz.openbmc_project.ObjectMapper", "GetSubTree",
+                query->path, query->depth, query->interfaces);
+        }
+        else if (query->method == "GetSubTreePaths")
+        {
+            crow::connections::bulkBus->async_method_call(
+                mapperReplyHandler<MapperGetSubTreePathsResponse>(pending,
+                                                                  key),
+                "xyz.openbmc_project.ObjectMapper",
+                "/xyz/openbmc_project/object_mapper",
+                "xyz.openbmc_project.ObjectMapper", "GetSubTreePaths",
+                query->path, query->depth, query->interfaces);
+        }
+        else if (query->method == "GetObject")
+        {
+            crow::connections::bulkBus->async_method_call(
+                mapperReplyHandler<MapperGetObject>(pending, key),
+                "xyz.openbmc_project.ObjectMapper",
+                "/xyz/openbmc_project/object_mapper",
+                "xyz.openbmc_project.ObjectMapper", "GetObject", query->path,
+                query->interfaces);
+        }
+        else
+        {
+            DbusObjectCache::getInstance().eraseMapper(key);
+            revalidateNext(pending);
+        }
+    }
+
+    static void revalidateProperties(const std::shared_ptr<Pending>& pending,
+                                     const CacheSnapshot::Properties& entry)
+    {
+        uint64_t generation = DbusObjectCache::getInstance().getGeneration();
+        crow::connections::bulkBus->async_method_call(
+            [pending, service{entry.service}, path{entry.path},
+             interface{entry.interface},
+             generation](const boost::system::error_code& ec,
+                         const DBusPropertiesMap& properties) {
+            DbusObjectCache& cache = DbusObjectCache::getInstance();
+            if (ec || !cache.propertiesUnchangedSince(path, generation))
+            {
+                // The path changed while it was fetched, so the reply can't
+                // be stored; drop the loaded entry rather than leave it
+                // unchecked
+                cache.eraseProperties(path);
+            }
+            else
+            {
+                cache.insertProperties(service, path, interface, generation,
+                                       properties);
+            }
+            revalidateNext(pending);
+        },
+            entry.service, entry.path, "org.freedesktop.DBus.Properties",
+            "GetAll", entry.interface);
+    }
+
+    void armTimer()
+    {
+        if (!timer)
+        {
+            return;
+        }
+        timer->expires_after(writeInterval);
+        timer->async_wait([this](const boost::system::error_code& ec) {
+            if (ec)
+            {
+                return;
+            }
+            write();
+            armTimer();
+        });
+    }
+
+    void write()
+    {
+        std::string encoded = encodeCacheSnapshot(
+            takeCacheSnapshot(DbusObjectCache::getInstance()));
+        if (encoded == lastWritten)
+        {
+            return;
+        }
+        if (encoded.size() > maxFileSize)
+        {
+            BMCWEB_LOG_WARNING << "D-Bus cache snapshot is " << encoded.size()
+                               << " bytes; not writing it";
+            return;
+        }
+        lastWritten = encoded;
+        if (io == nullptr)
+        {
+            writer.writeNow(encoded);
+            return;
+        }
+        writer.write(io->get_executor(), std::move(encoded));
+    }
+
+    boost::asio::io_context* io = nullptr;
+    std::optional<boost::asio::steady_timer> timer;
+    std::string lastWritten;
+    crow::async_file::OrderedWriter writer{
+        filename, persistent_data::writeFileAtomically};
+};
+
+} // namespace utility
+} // namespace dbus
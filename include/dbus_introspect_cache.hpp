@@ -0,0 +1,332 @@
+#pragma once
+
+#include "dbus_singleton.hpp"
+#include "logging.hpp"
+
+#include <tinyxml2.h>
+
+#include <boost/asio/post.hpp>
+#include <boost/system/error_code.hpp>
+#include <sdbusplus/asio/connection.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace dbus
+{
+
+namespace utility
+{
+
+// A method or signal argument.  Attributes the XML left out are empty.
+struct IntrospectArg
+{
+    std::string name;
+    std::string direction;
+    std::string type;
+};
+
+struct IntrospectMember
+{
+    std::string name;
+    std::vector<IntrospectArg> args;
+};
+
+struct IntrospectProperty
+{
+    std::string name;
+    std::string type;
+};
+
+struct IntrospectInterface
+{
+    std::string name;
+    std::vector<IntrospectMember> methods;
+    std::vector<IntrospectMember> signals;
+    std::vector<IntrospectProperty> properties;
+};
+
+// What org.freedesktop.DBus.Introspectable.Introspect returned for one
+// object, in document order.  Elements without a name are left out.
+struct IntrospectData
+{
+    std::vector<std::string> children;
+    std::vector<IntrospectInterface> interfaces;
+
+    const IntrospectInterface* findInterface(std::string_view name) const
+    {
+        for (const IntrospectInterface& interface : interfaces)
+        {
+            if (interface.name == name)
+            {
+                return &interface;
+            }
+        }
+        return nullptr;
+    }
+};
+
+inline std::string xmlAttribute(const tinyxml2::XMLElement& element,
+                                const char* name)
+{
+    const char* value = element.Attribute(name);
+    if (value == nullptr)
+    {
+        return "";
+    }
+    return value;
+}
+
+inline std::vector<IntrospectArg>
+    parseIntrospectArgs(const tinyxml2::XMLElement& member)
+{
+    std::vector<IntrospectArg> args;
+    for (const tinyxml2::XMLElement* arg = member.FirstChildElement("arg");
+         arg != nullptr; arg = arg->NextSiblingElement("arg"))
+    {
+        args.emplace_back(IntrospectArg{xmlAttribute(*arg, "name"),
+                                        xmlAttribute(*arg, "direction"),
+                                        xmlAttribute(*arg, "type")});
+    }
+    return args;
+}
+
+inline std::vector<IntrospectMember>
+    parseIntrospectMembers(const tinyxml2::XMLElement& interface,
+                           const char* kind)
+{
+    std::vector<IntrospectMember> members;
+    for (const tinyxml2::XMLElement* member = interface.FirstChildElement(kind);
+         member != nullptr; member = member->NextSiblingElement(kind))
+    {
+        const char* name = member->Attribute("name");
+        if (name != nullptr)
+        {
+            members.emplace_back(
+                IntrospectMember{name, parseIntrospectArgs(*member)});
+        }
+    }
+    return members;
+}
+
+// Returns nullopt if xml isn't an introspection document
+inline std::optional<IntrospectData> parseIntrospection(std::string_view xml)
+{
+    tinyxml2::XMLDocument doc;
+    doc.Parse(xml.data(), xml.size());
+    const tinyxml2::XMLElement* root = doc.FirstChildElement("node");
+    if (root == nullptr)
+    {
+        return std::nullopt;
+    }
+
+    IntrospectData data;
+    for (const tinyxml2::XMLElement* node = root->FirstChildElement("node");
+         node != nullptr; node = node->NextSiblingElement("node"))
+    {
+        const char* name = node->Attribute("name");
+        if (name != nullptr)
+        {
+            data.children.emplace_back(name);
+        }
+    }
+    for (const tinyxml2::XMLElement* element =
+             root->FirstChildElement("interface");
+         element != nullptr;
+         element = element->NextSiblingElement("interface"))
+    {
+        const char* name = element->Attribute("name");
+        if (name == nullptr)
+        {
+            continue;
+        }
+        IntrospectInterface& interface = data.interfaces.emplace_back();
+        interface.name = name;
+        interface.methods = parseIntrospectMembers(*element, "method");
+        interface.signals = parseIntrospectMembers(*element, "signal");
+        for (const tinyxml2::XMLElement* property =
+                 element->FirstChildElement("property");
+             property != nullptr;
+             property = property->NextSiblingElement("property"))
+        {
+            const char* propertyName = property->Attribute("name");
+            const char* type = property->Attribute("type");
+            if (propertyName != nullptr && type != nullptr)
+            {
+                interface.properties.emplace_back(
+                    IntrospectProperty{propertyName, type});
+            }
+        }
+    }
+    return data;
+}
+
+/**
+ * @brief Parsed introspection of each (service, object path) the REST API
+ * has asked about, so repeated calls skip both the Introspect round trip and
+ * the XML parse.
+ *
+ * Objects appearing or disappearing anywhere, and any service starting or
+ * stopping, drop everything, as signals don't say which service they came
+ * from by its well-known name.  Like DbusObjectCache, every lookup misses
+ * until registerMatches() has been called.
+ */
+class IntrospectCache
+{
+  public:
+    // Called with a null pointer and no error if the reply wasn't valid
+    // introspection XML
+    using Callback =
+        std::function<void(const boost::system::error_code&,
+                           const std::shared_ptr<const IntrospectData>&)>;
+
+    // The table is flushed when this is reached
+    static constexpr size_t maxEntries = 512;
+
+    static IntrospectCache& getInstance()
+    {
+        static IntrospectCache cache;
+        return cache;
+    }
+
+    IntrospectCache(const IntrospectCache&) = delete;
+    IntrospectCache(IntrospectCache&&) = delete;
+    IntrospectCache& operator=(const IntrospectCache&) = delete;
+    IntrospectCache& operator=(IntrospectCache&&) = delete;
+    ~IntrospectCache() = default;
+
+    void registerMatches(sdbusplus::asio::connection& conn)
+    {
+        namespace rules = sdbusplus::bus::match::rules;
+        auto onChange = [this](sdbusplus::message_t& /*msg*/) { clear(); };
+
+        matches.clear();
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::interfacesAdded(), onChange));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::interfacesRemoved(), onChange));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::nameOwnerChanged(), onChange));
+        clear();
+    }
+
+    bool enabled() const
+    {
+        return !matches.empty();
+    }
+
+    void clear()
+    {
+        entries.clear();
+        generation++;
+    }
+
+    std::shared_ptr<const IntrospectData> find(const std::string& service,
+                                               const std::string& path) const
+    {
+        if (!enabled())
+        {
+            return nullptr;
+        }
+        auto it = entries.find(key(service, path));
+        if (it == entries.end())
+        {
+            return nullptr;
+        }
+        return it->second;
+    }
+
+    // Counter to read before calling Introspect and pass to insert(), so a
+    // reply that raced with a signal is never cached
+    uint64_t getGeneration() const
+    {
+        return generation;
+    }
+
+    void insert(const std::string& service, const std::string& path,
+                uint64_t startGeneration,
+                const std::shared_ptr<const IntrospectData>& data)
+    {
+        if (!enabled() || startGeneration != generation)
+        {
+            return;
+        }
+        if (entries.size() >= maxEntries)
+        {
+            entries.clear();
+        }
+        entries.insert_or_assign(key(service, path), data);
+    }
+
+    /**
+     * @brief Calls callback with the introspection of path on service,
+     * asking the service only if it isn't cached.  The callback is never
+     * called inline.
+     */
+    void get(const std::string& service, const std::string& path,
+             Callback&& callback)
+    {
+        std::shared_ptr<const IntrospectData> cached = find(service, path);
+        if (cached != nullptr)
+        {
+            boost::asio::post(crow::connections::systemBus->get_io_context(),
+                              [callback{std::move(callback)},
+                               cached{std::move(cached)}]() {
+                callback(boost::system::error_code(), cached);
+            });
+            return;
+        }
+        crow::connections::systemBus->async_method_call(
+            [this, service, path, startGeneration(generation),
+             callback{std::move(callback)}](const boost::system::error_code& ec,
+                                            const std::string& introspectXml) {
+            if (ec)
+            {
+                callback(ec, nullptr);
+                return;
+            }
+            std::optional<IntrospectData> parsed =
+                parseIntrospection(introspectXml);
+            if (!parsed)
+            {
+                BMCWEB_LOG_ERROR << "XML document failed to parse " << service
+                                 << " " << path << ": " << introspectXml;
+                callback(ec, nullptr);
+                return;
+            }
+            auto data = std::make_shared<const IntrospectData>(
+                std::move(*parsed));
+            insert(service, path, startGeneration, data);
+            callback(ec, data);
+        },
+            service, path, "org.freedesktop.DBus.Introspectable", "Introspect");
+    }
+
+  private:
+    IntrospectCache() = default;
+
+    static std::string key(std::string_view service, std::string_view path)
+    {
+        std::string out(service);
+        out += '|';
+        out += path;
+        return out;
+    }
+
+    std::unordered_map<std::string, std::shared_ptr<const IntrospectData>>
+        entries;
+    uint64_t generation = 0;
+    std::vector<std::unique_ptr<sdbusplus::bus::match_t>> matches;
+};
+
+} // namespace utility
+} // namespace dbus
@@ -3,13 +3,21 @@
 #include <async_resp.hpp>
 #include <boost/container/flat_map.hpp>
 #include <boost/container/flat_set.hpp>
+#include <dbus_path_trie.hpp>
 #include <dbus_singleton.hpp>
 #include <openbmc_dbus_rest.hpp>
 #include <sdbusplus/bus/match.hpp>
 #include <sdbusplus/message/types.hpp>
 #include <websocket.hpp>
 
+#include <cstring>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
 #include <variant>
+#include <vector>
 
 namespace crow
 {
@@ -18,113 +26,280 @@ namespace dbus_monitor
 
 struct DbusWebsocketSession
 {
-    std::vector<std::unique_ptr<sdbusplus::bus::match_t>> matches;
     boost::container::flat_set<std::string, std::less<>,
                                std::vector<std::string>>
         interfaces;
+    // Path namespaces this session is filed under in the registry
+    boost::container::flat_set<std::string> paths;
+    // Match rules this session holds a reference on
+    boost::container::flat_set<std::string> rules;
 };
 
-static boost::container::flat_map<crow::websocket::Connection*,
-                                  DbusWebsocketSession>
-    sessions;
-
-inline int onPropertyUpdate(sd_bus_message* m, void* userdata,
-                            sd_bus_error* retError)
+/**
+ * @brief Every /subscribe session, and the D-Bus matches they share.
+ *
+ * Sessions asking for the same rule share one match.  A signal is converted
+ * from D-Bus and serialized once, then the same text is sent to each session
+ * whose paths and interfaces it falls under, found through a trie of the
+ * subscribed path namespaces.
+ */
+class SubscriptionRegistry
 {
-    if (retError == nullptr || (sd_bus_error_is_set(retError) != 0))
+  public:
+    static SubscriptionRegistry& getInstance()
+    {
+        static SubscriptionRegistry registry;
+        return registry;
+    }
+
+    SubscriptionRegistry(const SubscriptionRegistry&) = delete;
+    SubscriptionRegistry(SubscriptionRegistry&&) = delete;
+    SubscriptionRegistry& operator=(const SubscriptionRegistry&) = delete;
+    SubscriptionRegistry& operator=(SubscriptionRegistry&&) = delete;
+    ~SubscriptionRegistry() = default;
+
+    void open(crow::websocket::Connection& conn)
+    {
+        sessions.try_emplace(&conn);
+    }
+
+    DbusWebsocketSession* find(crow::websocket::Connection& conn)
+    {
+        auto it = sessions.find(&conn);
+        if (it == sessions.end())
+        {
+            return nullptr;
+        }
+        return &it->second;
+    }
+
+    void close(crow::websocket::Connection& conn)
     {
-        BMCWEB_LOG_ERROR << "Got sdbus error on match";
-        return 0;
+        auto it = sessions.find(&conn);
+        if (it == sessions.end())
+        {
+            return;
+        }
+        for (const std::string& path : it->second.paths)
+        {
+            subscribers.erase(path, &conn);
+        }
+        for (const std::string& rule : it->second.rules)
+        {
+            releaseRule(rule);
+        }
+        sessions.erase(it);
+    }
+
+    // Sends conn the signals from path and everything under it
+    void addPath(crow::websocket::Connection& conn, const std::string& path)
+    {
+        DbusWebsocketSession* session = find(conn);
+        if (session != nullptr && session->paths.insert(path).second)
+        {
+            subscribers.insert(path, &conn);
+        }
+    }
+
+    void addRule(crow::websocket::Connection& conn, const std::string& rule)
+    {
+        DbusWebsocketSession* session = find(conn);
+        if (session == nullptr || !session->rules.insert(rule).second)
+        {
+            return;
+        }
+        Match& match = matches[rule];
+        match.users++;
+        if (match.match != nullptr)
+        {
+            return;
+        }
+        BMCWEB_LOG_DEBUG << "Creating match " << rule;
+        match.match = std::make_unique<sdbusplus::bus::match_t>(
+            *crow::connections::systemBus, rule,
+            [this](sdbusplus::message_t& message) { onSignal(message); });
+    }
+
+  private:
+    struct Match
+    {
+        std::unique_ptr<sdbusplus::bus::match_t> match;
+        size_t users = 0;
+    };
+
+    SubscriptionRegistry() = default;
+
+    void releaseRule(const std::string& rule)
+    {
+        auto it = matches.find(rule);
+        if (it != matches.end() && --it->second.users == 0)
+        {
+            BMCWEB_LOG_DEBUG << "Removing match " << rule;
+            matches.erase(it);
+        }
     }
-    crow::websocket::Connection* connection =
-        static_cast<crow::websocket::Connection*>(userdata);
-    auto thisSession = sessions.find(connection);
-    if (thisSession == sessions.end())
+
+    void onSignal(sdbusplus::message_t& message)
     {
-        BMCWEB_LOG_ERROR << "Couldn't find dbus connection " << connection;
-        return 0;
+        // sd-bus runs the callback of every match a message satisfies.  The
+        // first one has already reached every session it's for.  Holding a
+        // reference keeps another message from reusing the address.
+        if (lastMessage && lastMessage->get() == message.get())
+        {
+            return;
+        }
+        lastMessage.emplace(message.get());
+
+        std::vector<crow::websocket::Connection*> targets;
+        subscribers.find(message.get_path(),
+                         [&targets](crow::websocket::Connection* const& conn) {
+            targets.push_back(conn);
+        });
+        if (targets.empty())
+        {
+            return;
+        }
+
+        nlohmann::json json;
+        json["event"] = message.get_member();
+        json["path"] = message.get_path();
+        if (strcmp(message.get_member(), "PropertiesChanged") == 0)
+        {
+            sendPropertiesChanged(message, json, targets);
+        }
+        else if (strcmp(message.get_member(), "InterfacesAdded") == 0)
+        {
+            sendInterfacesAdded(message, json, targets);
+        }
+        else
+        {
+            BMCWEB_LOG_CRITICAL << "message " << message.get_member()
+                                << " was unexpected";
+        }
     }
-    sdbusplus::message_t message(m);
-    nlohmann::json json;
-    json["event"] = message.get_member();
-    json["path"] = message.get_path();
-    if (strcmp(message.get_member(), "PropertiesChanged") == 0)
+
+    void sendPropertiesChanged(
+        sdbusplus::message_t& message, nlohmann::json& json,
+        const std::vector<crow::websocket::Connection*>& targets)
     {
         nlohmann::json data;
         int r = openbmc_mapper::convertDBusToJSON("sa{sv}as", message, data);
         if (r < 0)
         {
             BMCWEB_LOG_ERROR << "convertDBusToJSON failed with " << r;
-            return 0;
+            return;
         }
         if (!data.is_array())
         {
             BMCWEB_LOG_ERROR << "No data in PropertiesChanged signal";
-            return 0;
+            return;
         }
 
         // data is type sa{sv}as and is an array[3] of string, object, array
+        const std::string* interface = data[0].get_ptr<const std::string*>();
         json["interface"] = data[0];
-        json["properties"] = data[1];
+        json["properties"] = std::move(data[1]);
+        auto text = std::make_shared<const std::string>(
+            json.dump(2, ' ', true, nlohmann::json::error_handler_t::replace));
+
+        for (crow::websocket::Connection* conn : targets)
+        {
+            const DbusWebsocketSession& session = sessions.find(conn)->second;
+            // Sessions that named interfaces only asked for those
+            if (!session.interfaces.empty() &&
+                (interface == nullptr ||
+                 !session.interfaces.contains(*interface)))
+            {
+                continue;
+            }
+            conn->sendShared(crow::websocket::MessageType::Text, text);
+        }
     }
-    else if (strcmp(message.get_member(), "InterfacesAdded") == 0)
+
+    void sendInterfacesAdded(
+        sdbusplus::message_t& message, nlohmann::json& json,
+        const std::vector<crow::websocket::Connection*>& targets)
     {
         nlohmann::json data;
         int r = openbmc_mapper::convertDBusToJSON("oa{sa{sv}}", message, data);
         if (r < 0)
         {
             BMCWEB_LOG_ERROR << "convertDBusToJSON failed with " << r;
-            return 0;
+            return;
         }
 
         if (!data.is_array())
         {
             BMCWEB_LOG_ERROR << "No data in InterfacesAdded signal";
-            return 0;
+            return;
         }
 
-        // data is type oa{sa{sv}} which is an array[2] of string, object
-        for (const auto& entry : data[1].items())
+        // data is type oa{sa{sv}} which is an array[2] of string, object.
+        // Each session only hears about the interfaces it named, so the text
+        // is shared between sessions whose interfaces pick out the same ones.
+        std::map<std::string, std::shared_ptr<const std::string>> texts;
+        for (crow::websocket::Connection* conn : targets)
         {
-            auto it = thisSession->second.interfaces.find(entry.key());
-            if (it != thisSession->second.interfaces.end())
+            const DbusWebsocketSession& session = sessions.find(conn)->second;
+            std::string picked;
+            for (const auto& entry : data[1].items())
             {
-                json["interfaces"][entry.key()] = entry.value();
+                if (session.interfaces.contains(entry.key()))
+                {
+                    picked += entry.key();
+                    picked += ' ';
+                }
             }
+            auto text = texts.find(picked);
+            if (text == texts.end())
+            {
+                nlohmann::json out = json;
+                for (const auto& entry : data[1].items())
+                {
+                    if (session.interfaces.contains(entry.key()))
+                    {
+                        out["interfaces"][entry.key()] = entry.value();
+                    }
+                }
+                auto dumped = std::make_shared<const std::string>(out.dump(
+                    2, ' ', true, nlohmann::json::error_handler_t::replace));
+                text = texts.emplace(picked, std::move(dumped)).first;
+            }
+            conn->sendShared(crow::websocket::MessageType::Text, text->second);
         }
     }
-    else
-    {
-        BMCWEB_LOG_CRITICAL << "message " << message.get_member()
-                            << " was unexpected";
-        return 0;
-    }
 
-    connection->sendText(
-        json.dump(2, ' ', true, nlohmann::json::error_handler_t::replace));
-    return 0;
-}
+    boost::container::flat_map<crow::websocket::Connection*,
+                               DbusWebsocketSession>
+        sessions;
+    dbus::utility::PathNamespaceTrie<crow::websocket::Connection*> subscribers;
+    std::map<std::string, Match, std::less<>> matches;
+    std::optional<sdbusplus::message_t> lastMessage;
+};
 
 inline void requestRoutes(App& app)
 {
     BMCWEB_ROUTE(app, "/subscribe")
         .privileges({{"Login"}})
         .websocket()
+        .permessageDeflate()
         .onopen([&](crow::websocket::Connection& conn) {
         BMCWEB_LOG_DEBUG << "Connection " << &conn << " opened";
-        sessions.try_emplace(&conn);
+        SubscriptionRegistry::getInstance().open(conn);
     })
         .onclose([&](crow::websocket::Connection& conn, const std::string&) {
-        sessions.erase(&conn);
+        SubscriptionRegistry::getInstance().close(conn);
     })
         .onmessage([&](crow::websocket::Connection& conn,
                        const std::string& data, bool) {
-        const auto sessionPair = sessions.find(&conn);
-        if (sessionPair == sessions.end())
+        SubscriptionRegistry& registry = SubscriptionRegistry::getInstance();
+        DbusWebsocketSession* session = registry.find(conn);
+        if (session == nullptr)
         {
             conn.close("Internal error");
+            return;
         }
-        DbusWebsocketSession& thisSession = sessionPair->second;
+        DbusWebsocketSession& thisSession = *session;
         BMCWEB_LOG_DEBUG << "Connection " << &conn << " received " << data;
         nlohmann::json j = nlohmann::json::parse(data, nullptr, false);
         if (j.is_discarded())
@@ -156,16 +331,6 @@ inline void requestRoutes(App& app)
             return;
         }
 
-        size_t interfaceCount = thisSession.interfaces.size();
-        if (interfaceCount == 0)
-        {
-            interfaceCount = 1;
-        }
-        // Reserve our matches upfront.  For each path there is 1 for
-        // interfacesAdded, and InterfaceCount number for
-        // PropertiesChanged
-        thisSession.matches.reserve(thisSession.matches.size() +
-                                    paths->size() * (1U + interfaceCount));
         std::string objectManagerMatchString;
         std::string propertiesMatchString;
         std::string objectManagerInterfacesMatchString;
@@ -202,12 +367,7 @@ inline void requestRoutes(App& app)
             // interfaces
             if (thisSession.interfaces.empty())
             {
-                BMCWEB_LOG_DEBUG << "Creating match " << propertiesMatchString;
-
-                thisSession.matches.emplace_back(
-                    std::make_unique<sdbusplus::bus::match_t>(
-                        *crow::connections::systemBus, propertiesMatchString,
-                        onPropertyUpdate, &conn));
+                registry.addRule(conn, propertiesMatchString);
             }
             else
             {
@@ -226,11 +386,7 @@ inline void requestRoutes(App& app)
                     ifaceMatchString += ",arg0='";
                     ifaceMatchString += interface;
                     ifaceMatchString += "'";
-                    BMCWEB_LOG_DEBUG << "Creating match " << ifaceMatchString;
-                    thisSession.matches.emplace_back(
-                        std::make_unique<sdbusplus::bus::match_t>(
-                            *crow::connections::systemBus, ifaceMatchString,
-                            onPropertyUpdate, &conn));
+                    registry.addRule(conn, ifaceMatchString);
                 }
             }
             objectManagerMatchString =
@@ -240,11 +396,8 @@ inline void requestRoutes(App& app)
                  *thisPathString +
                  "',"
                  "member='InterfacesAdded'");
-            BMCWEB_LOG_DEBUG << "Creating match " << objectManagerMatchString;
-            thisSession.matches.emplace_back(
-                std::make_unique<sdbusplus::bus::match_t>(
-                    *crow::connections::systemBus, objectManagerMatchString,
-                    onPropertyUpdate, &conn));
+            registry.addRule(conn, objectManagerMatchString);
+            registry.addPath(conn, *thisPathString);
         }
     });
 }
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <boost/container/flat_set.hpp>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace dbus
+{
+
+namespace utility
+{
+
+/**
+ * @brief Values filed under D-Bus object paths, looked up the way a match
+ * rule's path_namespace is: a value filed under /a is found for /a and for
+ * anything below it, like /a/b, but not for /ab.
+ *
+ * A value filed under several paths that cover the same object is only
+ * reported once for it.
+ */
+template <typename T>
+class PathNamespaceTrie
+{
+  public:
+    void insert(std::string_view path, const T& value)
+    {
+        Node* node = &root;
+        forEachSegment(path, [&node](std::string_view segment) {
+            std::unique_ptr<Node>& child = node->children[std::string(segment)];
+            if (child == nullptr)
+            {
+                child = std::make_unique<Node>();
+            }
+            node = child.get();
+            return true;
+        });
+        node->values.insert(value);
+    }
+
+    void erase(std::string_view path, const T& value)
+    {
+        eraseFrom(root, path, value);
+    }
+
+    // Calls callback once for each distinct value whose namespace holds path
+    void find(std::string_view path,
+              const std::function<void(const T&)>& callback) const
+    {
+        boost::container::flat_set<T> found(root.values);
+        const Node* node = &root;
+        forEachSegment(path, [&node, &found](std::string_view segment) {
+            auto it = node->children.find(segment);
+            if (it == node->children.end())
+            {
+                return false;
+            }
+            node = it->second.get();
+            found.insert(node->values.begin(), node->values.end());
+            return true;
+        });
+        for (const T& value : found)
+        {
+            callback(value);
+        }
+    }
+
+    bool empty() const
+    {
+        return root.values.empty() && root.children.empty();
+    }
+
+  private:
+    struct Node
+    {
+        std::map<std::string, std::unique_ptr<Node>, std::less<>> children;
+        boost::container::flat_set<T> values;
+    };
+
+    // Calls handler with each non-empty segment of path until it returns
+    // false
+    template <typename Handler>
+    static void forEachSegment(std::string_view path, Handler&& handler)
+    {
+        while (!path.empty())
+        {
+            size_t slash = path.find('/');
+            std::string_view segment = path.substr(0, slash);
+            path.remove_prefix(slash == std::string_view::npos ? path.size()
+                                                               : slash + 1);
+            if (!segment.empty() && !handler(segment))
+            {
+                return;
+            }
+        }
+    }
+
+    // Returns true if node is left with nothing in it
+    static bool eraseFrom(Node& node, std::string_view path, const T& value)
+    {
+        while (!path.empty() && path.front() == '/')
+        {
+            path.remove_prefix(1);
+        }
+        if (path.empty())
+        {
+            node.values.erase(value);
+        }
+        else
+        {
+            size_t slash = path.find('/');
+            std::string_view segment = path.substr(0, slash);
+            std::string_view rest =
+                slash == std::string_view::npos ? "" : path.substr(slash);
+            auto it = node.children.find(segment);
+            if (it != node.children.end() &&
+                eraseFrom(*it->second, rest, value))
+            {
+                node.children.erase(it);
+            }
+        }
+        return node.values.empty() && node.children.empty();
+    }
+
+    Node root;
+};
+
+} // namespace utility
+} // namespace dbus
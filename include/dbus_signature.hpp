@@ -0,0 +1,171 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace dbus
+{
+
+namespace utility
+{
+
+// One complete type of a D-Bus signature
+struct DbusTypeNode
+{
+    // The type code: a basic type, 'a', '(', '{' or 'v'
+    char code = '\0';
+    // What sd_bus_message_enter_container() wants for a container: the
+    // element type of an array, or the members of a struct or dict entry
+    std::string contents;
+    std::vector<DbusTypeNode> children;
+};
+
+using DbusSignature = std::vector<DbusTypeNode>;
+
+// Containers nest no deeper than this in a valid signature
+constexpr size_t dbusMaxSignatureDepth = 64;
+
+inline bool isBasicDbusType(char code)
+{
+    switch (code)
+    {
+        case 'y':
+        case 'b':
+        case 'n':
+        case 'q':
+        case 'i':
+        case 'u':
+        case 'x':
+        case 't':
+        case 'd':
+        case 'h':
+        case 's':
+        case 'o':
+        case 'g':
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Parses the complete type starting at pos into node, leaving pos after it
+inline bool parseDbusType(std::string_view signature, size_t& pos,
+                          DbusTypeNode& node, size_t depth)
+{
+    if (pos >= signature.size() || depth > dbusMaxSignatureDepth)
+    {
+        return false;
+    }
+    node.code = signature[pos++];
+    if (isBasicDbusType(node.code) || node.code == 'v')
+    {
+        return true;
+    }
+    if (node.code == 'a')
+    {
+        size_t start = pos;
+        DbusTypeNode& element = node.children.emplace_back();
+        if (pos < signature.size() && signature[pos] == '{')
+        {
+            // Dict entries only appear as array elements, and are a basic
+            // key and any value
+            pos++;
+            element.code = '{';
+            if (!parseDbusType(signature, pos, element.children.emplace_back(),
+                               depth + 1) ||
+                !isBasicDbusType(element.children.back().code) ||
+                !parseDbusType(signature, pos, element.children.emplace_back(),
+                               depth + 1) ||
+                pos >= signature.size() || signature[pos] != '}')
+            {
+                return false;
+            }
+            element.contents = signature.substr(start + 1, pos - start - 1);
+            pos++;
+        }
+        else if (!parseDbusType(signature, pos, element, depth + 1))
+        {
+            return false;
+        }
+        node.contents = signature.substr(start, pos - start);
+        return true;
+    }
+    if (node.code == '(')
+    {
+        size_t start = pos;
+        while (pos < signature.size() && signature[pos] != ')')
+        {
+            if (!parseDbusType(signature, pos, node.children.emplace_back(),
+                               depth + 1))
+            {
+                return false;
+            }
+        }
+        if (pos >= signature.size() || node.children.empty())
+        {
+            return false;
+        }
+        node.contents = signature.substr(start, pos - start);
+        pos++;
+        return true;
+    }
+    return false;
+}
+
+// Splits signature into its complete types, or returns false if it isn't
+// valid
+inline bool parseDbusSignature(std::string_view signature, DbusSignature& out)
+{
+    out.clear();
+    size_t pos = 0;
+    while (pos < signature.size())
+    {
+        if (!parseDbusType(signature, pos, out.emplace_back(), 0))
+        {
+            out.clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief The parse of signature, remembered so messages with the same
+ * signature, like every reply from one method or every variant holding the
+ * same type, share one tree.  Returns null for an invalid signature.
+ *
+ * The table is flushed once it holds maxParsedSignatures, which is why the
+ * result is shared: a caller still walking one tree keeps it alive.  This is
+ * only used from the main io_context.
+ */
+inline std::shared_ptr<const DbusSignature>
+    getParsedSignature(const std::string& signature)
+{
+    constexpr size_t maxParsedSignatures = 256;
+    static std::unordered_map<std::string, std::shared_ptr<const DbusSignature>>
+        parsed;
+
+    auto it = parsed.find(signature);
+    if (it != parsed.end())
+    {
+        return it->second;
+    }
+    auto tree = std::make_shared<DbusSignature>();
+    if (!parseDbusSignature(signature, *tree))
+    {
+        return nullptr;
+    }
+    if (parsed.size() >= maxParsedSignatures)
+    {
+        parsed.clear();
+    }
+    parsed.emplace(signature, tree);
+    return tree;
+}
+
+} // namespace utility
+} // namespace dbus
@@ -1,15 +1,69 @@
 #pragma once
+#include "dbus_trace.hpp"
+
 #include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
 #include <sdbusplus/asio/connection.hpp>
 
+#include <string>
+#include <utility>
+
 namespace crow
 {
+
+/**
+ * @brief The system bus connection.  Method calls made through it are timed
+ * and attributed to the request that issued them; see dbus_trace.
+ *
+ * A call issued for a request whose client has gone isn't made; its handler
+ * is run with operation_aborted instead, so the rest of the work it would
+ * have started is dropped too.
+ *
+ * Calls made through the sdbusplus::asio property helpers go straight to the
+ * base class and aren't traced; dbus::utility has traced equivalents.
+ */
+class TracedConnection : public sdbusplus::asio::connection
+{
+  public:
+    using sdbusplus::asio::connection::connection;
+
+    template <typename MessageHandler, typename... InputArgs>
+    void async_method_call(MessageHandler&& handler,
+                           const std::string& service,
+                           const std::string& objpath,
+                           const std::string& interf,
+                           const std::string& method, const InputArgs&... a)
+    {
+        auto traced = dbus_trace::traceHandler(
+            std::forward<MessageHandler>(handler), service, interf, method);
+        if constexpr (decltype(traced)::abortable)
+        {
+            if (traced.cancelled())
+            {
+                boost::asio::post(
+                    get_io_context(),
+                    [traced{std::move(traced)}]() mutable { traced.abort(); });
+                return;
+            }
+        }
+        sdbusplus::asio::connection::async_method_call(
+            std::move(traced), service, objpath, interf, method, a...);
+    }
+};
+
 namespace connections
 {
 
 // Initialze before using!
 // Please see webserver_main for the example how this variable is initialzed,
-extern sdbusplus::asio::connection* systemBus;
+extern TracedConnection* systemBus;
+
+// For bulk calls, whose replies are large or slow to build, such as reading
+// every log entry.  With the dbus-bulk-connection option this is a second
+// connection, so those replies don't hold up interactive calls behind them
+// on the socket; otherwise it's systemBus.  Signal matches belong on
+// systemBus.
+extern TracedConnection* bulkBus;
 
 } // namespace connections
 } // namespace crow
@@ -0,0 +1,389 @@
+#pragma once
+
+#include "cancellation.hpp"
+#include "route_metrics.hpp"
+#include "tracepoints.hpp"
+
+#include <boost/asio/error.hpp>
+#include <boost/callable_traits/args.hpp>
+#include <boost/container/flat_map.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace crow
+{
+namespace dbus_trace
+{
+
+struct CallSummary
+{
+    uint64_t count = 0;
+    uint64_t errors = 0;
+    // Not made, as the request that issued them had been cancelled
+    uint64_t cancelled = 0;
+    std::chrono::microseconds total{0};
+
+    void add(std::chrono::microseconds latency, bool failed)
+    {
+        count++;
+        if (failed)
+        {
+            errors++;
+        }
+        total += latency;
+    }
+};
+
+// Keyed by service and interface.method
+using CallSummaries =
+    boost::container::flat_map<std::pair<std::string, std::string>,
+                               CallSummary>;
+
+// Every traced call since startup, whether or not a request issued it
+inline CallSummaries& getCallTotals()
+{
+    static CallSummaries totals;
+    return totals;
+}
+
+/**
+ * @brief The D-Bus calls made on behalf of one request, including those
+ * issued from the replies to earlier ones.
+ */
+class RequestTrace
+{
+  public:
+    // Entries past this many are only counted in the header's totals
+    static constexpr size_t maxHeaderEntries = 16;
+
+    RequestTrace() = default;
+
+    explicit RequestTrace(std::shared_ptr<const Cancellation> cancellationIn) :
+        cancellation(std::move(cancellationIn))
+    {}
+
+    // Calls issued for a cancelled request aren't made; see TracedConnection
+    bool cancelled() const
+    {
+        return cancellation != nullptr && cancellation->cancelled();
+    }
+
+    void record(std::string_view service, std::string_view method,
+                std::chrono::microseconds latency, bool failed)
+    {
+        calls[{std::string(service), std::string(method)}].add(latency,
+                                                                failed);
+        callCount++;
+        totalLatency += latency;
+    }
+
+    uint64_t count() const
+    {
+        return callCount;
+    }
+
+    const CallSummaries& summaries() const
+    {
+        return calls;
+    }
+
+    // "<n> calls <us>us", then "; <service> <member> <n> <us>us" for each
+    // method called, slowest first
+    std::string headerValue() const
+    {
+        std::vector<CallSummaries::const_pointer> sorted;
+        sorted.reserve(calls.size());
+        for (const auto& entry : calls)
+        {
+            sorted.emplace_back(&entry);
+        }
+        std::sort(sorted.begin(), sorted.end(),
+                  [](const auto* a, const auto* b) {
+            return a->second.total > b->second.total;
+        });
+        sorted.resize(std::min(sorted.size(), maxHeaderEntries));
+
+        std::string value = std::to_string(callCount) + " calls " +
+                            std::to_string(totalLatency.count()) + "us";
+        for (const auto* entry : sorted)
+        {
+            value += "; ";
+            value += entry->first.first;
+            value += ' ';
+            value += entry->first.second;
+            value += ' ';
+            value += std::to_string(entry->second.count);
+            value += ' ';
+            value += std::to_string(entry->second.total.count());
+            value += "us";
+            if (entry->second.errors != 0)
+            {
+                value += ' ';
+                value += std::to_string(entry->second.errors);
+                value += " failed";
+            }
+        }
+        return value;
+    }
+
+  private:
+    std::shared_ptr<const Cancellation> cancellation;
+    CallSummaries calls;
+    uint64_t callCount = 0;
+    std::chrono::microseconds totalLatency{0};
+};
+
+// The trace that calls issued right now are attributed to, if any
+inline std::shared_ptr<RequestTrace>& currentTrace()
+{
+    static std::shared_ptr<RequestTrace> current;
+    return current;
+}
+
+// Whether calls issued right now are shared with other requests; see
+// SharedCallScope
+inline bool& currentShared()
+{
+    static bool shared = false;
+    return shared;
+}
+
+// Makes trace current for the scope, restoring the previous one after
+class ScopedTrace
+{
+  public:
+    explicit ScopedTrace(std::shared_ptr<RequestTrace> trace,
+                         bool shared = false) :
+        previous(std::exchange(currentTrace(), std::move(trace))),
+        previousShared(std::exchange(currentShared(), shared))
+    {}
+
+    ScopedTrace(const ScopedTrace&) = delete;
+    ScopedTrace(ScopedTrace&&) = delete;
+    ScopedTrace& operator=(const ScopedTrace&) = delete;
+    ScopedTrace& operator=(ScopedTrace&&) = delete;
+
+    ~ScopedTrace()
+    {
+        currentTrace() = std::move(previous);
+        currentShared() = previousShared;
+    }
+
+  private:
+    std::shared_ptr<RequestTrace> previous;
+    bool previousShared;
+};
+
+/**
+ * @brief Marks the calls issued in its scope, and those issued from their
+ * replies, as shared: a fetch that other requests are waiting on too, such
+ * as a cache fill.  They're still attributed to the request that issued
+ * them, but aren't dropped when that request is cancelled.
+ */
+class SharedCallScope
+{
+  public:
+    SharedCallScope() : previous(std::exchange(currentShared(), true)) {}
+
+    SharedCallScope(const SharedCallScope&) = delete;
+    SharedCallScope(SharedCallScope&&) = delete;
+    SharedCallScope& operator=(const SharedCallScope&) = delete;
+    SharedCallScope& operator=(SharedCallScope&&) = delete;
+
+    ~SharedCallScope()
+    {
+        currentShared() = previous;
+    }
+
+  private:
+    bool previous;
+};
+
+// One call in flight, from issuing it to its reply
+class PendingCall
+{
+  public:
+    PendingCall(std::string_view serviceIn, std::string_view interface,
+                std::string_view method) :
+        trace(currentTrace()),
+        shared(currentShared()), service(serviceIn),
+        start(std::chrono::steady_clock::now())
+    {
+        member.reserve(interface.size() + 1 + method.size());
+        member += interface;
+        member += '.';
+        member += method;
+        BMCWEB_TRACEPOINT2(dbus_call_start, service.c_str(), member.c_str());
+    }
+
+    void finish(bool failed) const
+    {
+        std::chrono::microseconds latency =
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - start);
+        BMCWEB_TRACEPOINT4(dbus_call_done, service.c_str(), member.c_str(),
+                           static_cast<int64_t>(latency.count()),
+                           static_cast<int>(failed));
+        getCallTotals()[{service, member}].add(latency, failed);
+        if (trace)
+        {
+            trace->record(service, member, latency, failed);
+        }
+    }
+
+    // For a call that wasn't made
+    void cancel() const
+    {
+        getCallTotals()[{service, member}].cancelled++;
+    }
+
+    const std::shared_ptr<RequestTrace>& getTrace() const
+    {
+        return trace;
+    }
+
+    bool isShared() const
+    {
+        return shared;
+    }
+
+  private:
+    std::shared_ptr<RequestTrace> trace;
+    bool shared;
+    std::string service;
+    std::string member;
+    std::chrono::steady_clock::time_point start;
+};
+
+template <typename Handler, typename Args>
+class TracedHandler;
+
+/**
+ * @brief Wraps a D-Bus reply handler, recording the call when the reply
+ * arrives and running the handler with the issuing request's trace current,
+ * so the calls it makes in turn are attributed to the same request.
+ *
+ * operator() takes exactly the arguments of the wrapped handler, so code
+ * that deduces the reply type from the handler's signature, as
+ * sdbusplus::asio::connection::async_method_call does, sees the same types.
+ */
+template <typename Handler, typename... Args>
+class TracedHandler<Handler, std::tuple<Args...>>
+{
+  public:
+    TracedHandler(Handler&& handlerIn, PendingCall&& callIn) :
+        handler(std::move(handlerIn)), call(std::move(callIn))
+    {}
+
+    // Whether abort() can make up the handler's arguments
+    static constexpr bool abortable =
+        (std::is_default_constructible_v<std::decay_t<Args>> && ...);
+
+    void operator()(Args... args)
+    {
+        const boost::system::error_code& ec =
+            std::get<0>(std::forward_as_tuple(args...));
+        call.finish(static_cast<bool>(ec));
+        ScopedTrace scope(call.getTrace(), call.isShared());
+        handler(std::forward<Args>(args)...);
+    }
+
+    // Whether the request that issued the call has been cancelled, and no
+    // other request shares the call
+    bool cancelled() const
+    {
+        return !call.isShared() && call.getTrace() != nullptr &&
+               call.getTrace()->cancelled();
+    }
+
+    // Runs the handler for a call that wasn't made, failed with
+    // operation_aborted and with empty results
+    void abort()
+        requires abortable
+    {
+        call.cancel();
+        ScopedTrace scope(call.getTrace(), call.isShared());
+        std::tuple<std::decay_t<Args>...> values{};
+        std::get<0>(values) = boost::asio::error::operation_aborted;
+        std::apply(
+            [this](std::decay_t<Args>&... value) {
+            handler(std::forward<Args>(value)...);
+        },
+            values);
+    }
+
+  private:
+    Handler handler;
+    PendingCall call;
+};
+
+template <typename Handler>
+auto traceHandler(Handler&& handler, std::string_view service,
+                  std::string_view interface, std::string_view method)
+{
+    using Decayed = std::decay_t<Handler>;
+    return TracedHandler<Decayed, boost::callable_traits::args_t<Decayed>>(
+        Decayed(std::forward<Handler>(handler)),
+        PendingCall(service, interface, method));
+}
+
+// Renders getCallTotals() in the Prometheus text format
+inline std::string renderPrometheus(const CallSummaries& totals)
+{
+    std::string out;
+    auto appendSamples = [&out, &totals](std::string_view name, auto value) {
+        for (const auto& [key, summary] : totals)
+        {
+            out += name;
+            out += "{service=\"";
+            metrics::appendLabelValue(out, key.first);
+            out += "\",member=\"";
+            metrics::appendLabelValue(out, key.second);
+            out += "\"} ";
+            out += value(summary);
+            out += '\n';
+        }
+    };
+    out += "# HELP bmcweb_dbus_calls_total D-Bus method calls made\n"
+           "# TYPE bmcweb_dbus_calls_total counter\n";
+    appendSamples("bmcweb_dbus_calls_total", [](const CallSummary& summary) {
+        return std::to_string(summary.count);
+    });
+    out += "# HELP bmcweb_dbus_call_errors_total D-Bus method calls that "
+           "failed\n"
+           "# TYPE bmcweb_dbus_call_errors_total counter\n";
+    appendSamples("bmcweb_dbus_call_errors_total",
+                  [](const CallSummary& summary) {
+        return std::to_string(summary.errors);
+    });
+    out += "# HELP bmcweb_dbus_calls_cancelled_total D-Bus method calls not "
+           "made, as the client had gone\n"
+           "# TYPE bmcweb_dbus_calls_cancelled_total counter\n";
+    appendSamples("bmcweb_dbus_calls_cancelled_total",
+                  [](const CallSummary& summary) {
+        return std::to_string(summary.cancelled);
+    });
+    out += "# HELP bmcweb_dbus_call_seconds_total Time spent waiting on "
+           "D-Bus replies\n"
+           "# TYPE bmcweb_dbus_call_seconds_total counter\n";
+    appendSamples("bmcweb_dbus_call_seconds_total",
+                  [](const CallSummary& summary) {
+        return metrics::formatSeconds(
+            static_cast<uint64_t>(summary.total.count()));
+    });
+    return out;
+}
+
+} // namespace dbus_trace
+} // namespace crow
@@ -18,21 +18,29 @@
 #include "dbus_singleton.hpp"
 #include "logging.hpp"
 
+#include <boost/asio/post.hpp>
 #include <boost/system/error_code.hpp> // IWYU pragma: keep
 #include <sdbusplus/asio/property.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/exception.hpp>
+#include <sdbusplus/message.hpp>
 #include <sdbusplus/message/native_types.hpp>
 
+#include <algorithm>
 #include <array>
+#include <cerrno>
 #include <cstddef>
 #include <cstdint>
 #include <filesystem>
 #include <functional>
+#include <memory>
 #include <regex>
 #include <span>
 #include <sstream>
 #include <string>
 #include <string_view>
 #include <tuple>
+#include <unordered_map>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -107,6 +115,392 @@ using MapperEndPoints = std::vector<std::string>;
 using AssociationList =
     std::vector<std::tuple<std::string, std::string, std::string>>;
 
+/**
+ * @brief In-process cache of ObjectMapper and Properties.GetAll replies.
+ *
+ * Handlers poll the same inventory objects over and over; this keeps the last
+ * reply for each distinct query in memory so repeated GETs do not turn into
+ * D-Bus round trips.  Entries are kept coherent by signal matches:
+ * InterfacesAdded/InterfacesRemoved drop all mapper replies and the property
+ * maps of the object they name, PropertiesChanged drops the property maps of
+ * its path, and a well-known name losing its owner drops everything that
+ * service answered.  The cache stays disabled (every lookup misses) until
+ * registerMatches() has been called, so it can never serve data it is not
+ * able to invalidate.
+ */
+class DbusObjectCache
+{
+  public:
+    static DbusObjectCache& getInstance()
+    {
+        static DbusObjectCache cache;
+        return cache;
+    }
+
+    DbusObjectCache(const DbusObjectCache&) = delete;
+    DbusObjectCache(DbusObjectCache&&) = delete;
+    DbusObjectCache& operator=(const DbusObjectCache&) = delete;
+    DbusObjectCache& operator=(DbusObjectCache&&) = delete;
+    ~DbusObjectCache() = default;
+
+    // Upper bound on the entries held per table; the table is flushed when
+    // this is reached rather than tracking per-entry recency.
+    static constexpr size_t maxEntries = 512;
+    // Upper bound on the paths remembered as changed; see
+    // propertiesUnchangedSince()
+    static constexpr size_t maxChangedPaths = 4096;
+
+    void registerMatches(sdbusplus::asio::connection& conn)
+    {
+        auto onInterfacesChanged = [this](sdbusplus::message_t& msg) {
+            // The signal comes from the ObjectManager; the object it's about
+            // is the first argument
+            sdbusplus::message::object_path path;
+            try
+            {
+                msg.read(path);
+            }
+            catch (const sdbusplus::exception_t& e)
+            {
+                BMCWEB_LOG_ERROR << "Failed to read interfaces signal: "
+                                 << e.what();
+                clear();
+                return;
+            }
+            mapperCache.clear();
+            mapperGeneration++;
+            invalidatePath(path.str);
+        };
+        auto onPropertiesChanged = [this](sdbusplus::message_t& msg) {
+            invalidatePath(msg.get_path());
+        };
+        auto onNameOwnerChanged = [this](sdbusplus::message_t& msg) {
+            std::string name;
+            std::string oldOwner;
+            std::string newOwner;
+            try
+            {
+                msg.read(name, oldOwner, newOwner);
+            }
+            catch (const sdbusplus::exception_t& e)
+            {
+                BMCWEB_LOG_ERROR << "Failed to read NameOwnerChanged: "
+                                 << e.what();
+                clear();
+                return;
+            }
+            // Clients connecting and leaving come and go with unique names
+            // only, and a service that just started has nothing cached
+            if (name.starts_with(':') || !newOwner.empty())
+            {
+                return;
+            }
+            serviceLost(name);
+        };
+
+        matches.clear();
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, sdbusplus::bus::match::rules::interfacesAdded(),
+            onInterfacesChanged));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, sdbusplus::bus::match::rules::interfacesRemoved(),
+            onInterfacesChanged));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn,
+            sdbusplus::bus::match::rules::type::signal() +
+                sdbusplus::bus::match::rules::member("PropertiesChanged") +
+                sdbusplus::bus::match::rules::interface(
+                    "org.freedesktop.DBus.Properties"),
+            onPropertiesChanged));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, sdbusplus::bus::match::rules::nameOwnerChanged(),
+            onNameOwnerChanged));
+        clear();
+    }
+
+    bool enabled() const
+    {
+        return !matches.empty();
+    }
+
+    // Incremented on every invalidation.  Callers capture it before issuing a
+    // D-Bus call and pass it back on insert, so a reply that raced with a
+    // signal about its path is never cached.
+    uint64_t getGeneration() const
+    {
+        return generation;
+    }
+
+    // Whether nothing has invalidated the properties of path since
+    // getGeneration() returned startGeneration.  Changes are tracked per path,
+    // so a busy sensor doesn't keep every other fetch from being cached.
+    bool propertiesUnchangedSince(const std::string& path,
+                                  uint64_t startGeneration) const
+    {
+        if (startGeneration < propertyFloor)
+        {
+            return false;
+        }
+        auto it = changedPaths.find(path);
+        return it == changedPaths.end() || it->second <= startGeneration;
+    }
+
+    // Like getGeneration(), but only incremented when mapper replies are
+    // dropped.  PropertiesChanged doesn't change what the mapper returns, so
+    // mapper replies and anything derived from them are checked against this.
+    uint64_t getMapperGeneration() const
+    {
+        return mapperGeneration;
+    }
+
+    void clear()
+    {
+        mapperCache.clear();
+        propertyCache.clear();
+        changedPaths.clear();
+        generation++;
+        propertyFloor = generation;
+        mapperGeneration++;
+    }
+
+    static std::string
+        mapperKey(std::string_view method, std::string_view path,
+                  int32_t depth, std::span<const std::string_view> interfaces)
+    {
+        std::string key(method);
+        key += '|';
+        key += path;
+        key += '|';
+        key += std::to_string(depth);
+        for (std::string_view interface : interfaces)
+        {
+            key += '|';
+            key += interface;
+        }
+        return key;
+    }
+
+    template <typename ResponseType>
+    std::shared_ptr<const ResponseType> findMapper(const std::string& key) const
+    {
+        if (!enabled())
+        {
+            return nullptr;
+        }
+        auto it = mapperCache.find(key);
+        if (it == mapperCache.end())
+        {
+            return nullptr;
+        }
+        const auto* entry =
+            std::get_if<std::shared_ptr<const ResponseType>>(&it->second);
+        if (entry == nullptr)
+        {
+            return nullptr;
+        }
+        return *entry;
+    }
+
+    template <typename ResponseType>
+    void insertMapper(const std::string& key, uint64_t startGeneration,
+                      const ResponseType& response)
+    {
+        if (!enabled() || startGeneration != mapperGeneration)
+        {
+            return;
+        }
+        if (mapperCache.size() >= maxEntries)
+        {
+            mapperCache.clear();
+        }
+        mapperCache.insert_or_assign(
+            key, std::make_shared<const ResponseType>(response));
+    }
+
+    std::shared_ptr<const DBusPropertiesMap>
+        findProperties(const std::string& service, const std::string& path,
+                       const std::string& interface) const
+    {
+        if (!enabled())
+        {
+            return nullptr;
+        }
+        auto pathIt = propertyCache.find(path);
+        if (pathIt == propertyCache.end())
+        {
+            return nullptr;
+        }
+        auto it = pathIt->second.find(service + '|' + interface);
+        if (it == pathIt->second.end())
+        {
+            return nullptr;
+        }
+        return it->second;
+    }
+
+    void insertProperties(const std::string& service, const std::string& path,
+                          const std::string& interface,
+                          uint64_t startGeneration,
+                          const DBusPropertiesMap& properties)
+    {
+        if (!enabled() || !propertiesUnchangedSince(path, startGeneration))
+        {
+            return;
+        }
+        if (propertyCache.size() >= maxEntries)
+        {
+            propertyCache.clear();
+        }
+        propertyCache[path].insert_or_assign(
+            service + '|' + interface,
+            std::make_shared<const DBusPropertiesMap>(properties));
+    }
+
+    // Drops one reply that's known to be wrong, such as one loaded from a
+    // snapshot that no longer matches the bus; see dbus_cache_snapshot.hpp
+    void eraseMapper(const std::string& key)
+    {
+        mapperCache.erase(key);
+    }
+
+    void eraseProperties(const std::string& path)
+    {
+        propertyCache.erase(path);
+    }
+
+    // Calls visitor(key, response) for each mapper reply held
+    template <typename Visitor>
+    void forEachMapper(Visitor&& visitor) const
+    {
+        for (const auto& entry : mapperCache)
+        {
+            std::visit(
+                [&visitor, &entry](const auto& response) {
+                visitor(entry.first, *response);
+            },
+                entry.second);
+        }
+    }
+
+    // Calls visitor(service, path, interface, properties) for each GetAll
+    // reply held
+    template <typename Visitor>
+    void forEachProperties(Visitor&& visitor) const
+    {
+        for (const auto& [path, interfaces] : propertyCache)
+        {
+            for (const auto& [key, properties] : interfaces)
+            {
+                // Bus names can't contain '|'
+                size_t split = key.find('|');
+                visitor(key.substr(0, split), path, key.substr(split + 1),
+                        *properties);
+            }
+        }
+    }
+
+  private:
+    DbusObjectCache() = default;
+
+    // Drops the property maps of path, and keeps fetches of it already in
+    // flight from being cached
+    void invalidatePath(const std::string& path)
+    {
+        propertyCache.erase(path);
+        markChanged(path);
+    }
+
+    // Keeps fetches of path already in flight from being cached
+    void markChanged(const std::string& path)
+    {
+        generation++;
+        if (changedPaths.size() >= maxChangedPaths)
+        {
+            // Fetches of every path that started before now are refused
+            // instead
+            changedPaths.clear();
+            propertyFloor = generation;
+        }
+        changedPaths.insert_or_assign(path, generation);
+    }
+
+    // Drops what service answered, once its well-known name has no owner
+    void serviceLost(const std::string& service)
+    {
+        std::erase_if(mapperCache, [&service](const auto& entry) {
+            return std::visit(
+                [&service](const auto& response) {
+                return mentionsService(*response, service);
+            },
+                entry.second);
+        });
+        mapperGeneration++;
+
+        std::string prefix = service + '|';
+        std::vector<std::string> changed;
+        for (auto& [path, interfaces] : propertyCache)
+        {
+            if (std::erase_if(interfaces, [&prefix](const auto& entry) {
+                    return entry.first.starts_with(prefix);
+                }) != 0)
+            {
+                changed.push_back(path);
+            }
+        }
+        std::erase_if(propertyCache, [](const auto& entry) {
+            return entry.second.empty();
+        });
+        for (const std::string& path : changed)
+        {
+            markChanged(path);
+        }
+    }
+
+    static bool mentionsService(const MapperGetSubTreeResponse& response,
+                                const std::string& service)
+    {
+        return std::ranges::any_of(response, [&service](const auto& object) {
+            return mentionsService(object.second, service);
+        });
+    }
+
+    static bool mentionsService(const MapperGetObject& response,
+                                const std::string& service)
+    {
+        return std::ranges::any_of(response, [&service](const auto& entry) {
+            return entry.first == service;
+        });
+    }
+
+    // Paths don't say who serves them
+    static bool mentionsService(const MapperGetSubTreePathsResponse& /*paths*/,
+                                const std::string& /*service*/)
+    {
+        return true;
+    }
+
+    using MapperEntry =
+        std::variant<std::shared_ptr<const MapperGetSubTreeResponse>,
+                     std::shared_ptr<const MapperGetSubTreePathsResponse>,
+                     std::shared_ptr<const MapperGetObject>>;
+
+    // Keyed by mapperKey()
+    std::unordered_map<std::string, MapperEntry> mapperCache;
+    // Keyed by object path, then by "service|interface"
+    std::unordered_map<
+        std::string,
+        std::unordered_map<std::string,
+                           std::shared_ptr<const DBusPropertiesMap>>>
+        propertyCache;
+    uint64_t generation = 0;
+    // The generation at which each path was last invalidated
+    std::unordered_map<std::string, uint64_t> changedPaths;
+    // Property fetches started before this generation aren't cached
+    uint64_t propertyFloor = 0;
+    uint64_t mapperGeneration = 0;
+    std::vector<std::unique_ptr<sdbusplus::bus::match_t>> matches;
+};
+
 inline void escapePathForDbus(std::string& path)
 {
     const std::regex reg("[^A-Za-z0-9_/]");
@@ -163,20 +557,145 @@ inline void checkDbusPathExists(const std::string& path, Callback&& callback)
         std::array<std::string, 0>());
 }
 
+/**
+ * @brief Completes a mapper query from DbusObjectCache if possible.
+ *
+ * The callback is posted rather than invoked inline so that a cache hit has
+ * the same ordering guarantees as a real D-Bus reply.
+ *
+ * @return true if the callback was scheduled from the cache
+ */
+template <typename ResponseType, typename Callback>
+inline bool completeFromCache(const std::string& key, Callback& callback)
+{
+    std::shared_ptr<const ResponseType> cached =
+        DbusObjectCache::getInstance().findMapper<ResponseType>(key);
+    if (cached == nullptr)
+    {
+        return false;
+    }
+    boost::asio::post(crow::connections::systemBus->get_io_context(),
+                      [callback{std::move(callback)},
+                       cached{std::move(cached)}]() {
+        callback(boost::system::error_code(), *cached);
+    });
+    return true;
+}
+
+template <typename ResponseType>
+using MapperCallback =
+    std::function<void(const boost::system::error_code&, const ResponseType&)>;
+
+/**
+ * @brief Callbacks waiting on outstanding mapper calls of one reply type.
+ *
+ * Calls are told apart by DbusObjectCache::mapperKey() and by the mapper
+ * generation they were issued at, so a caller that arrives after an
+ * InterfacesAdded or InterfacesRemoved doesn't get the reply to a call made
+ * before it.
+ */
+template <typename ResponseType>
+class PendingMapperCalls
+{
+  public:
+    // Queues callback behind the call for key issued at generation.  Returns
+    // true if there was no such call, and the caller has to make it.
+    bool join(const std::string& key, uint64_t generation,
+              MapperCallback<ResponseType>&& callback)
+    {
+        auto [pending, first] = calls.try_emplace(pendingKey(key, generation));
+        pending->second.emplace_back(std::move(callback));
+        return first;
+    }
+
+    // Removes the call for key issued at generation, giving back the
+    // callbacks waiting on it
+    std::vector<MapperCallback<ResponseType>> take(const std::string& key,
+                                                   uint64_t generation)
+    {
+        auto node = calls.extract(pendingKey(key, generation));
+        if (node.empty())
+        {
+            return {};
+        }
+        return std::move(node.mapped());
+    }
+
+    size_t size() const
+    {
+        return calls.size();
+    }
+
+  private:
+    static std::string pendingKey(const std::string& key, uint64_t generation)
+    {
+        return key + '#' + std::to_string(generation);
+    }
+
+    std::unordered_map<std::string, std::vector<MapperCallback<ResponseType>>>
+        calls;
+};
+
+template <typename ResponseType>
+inline PendingMapperCalls<ResponseType>& getPendingMapperCalls()
+{
+    static PendingMapperCalls<ResponseType> pending;
+    return pending;
+}
+
+/**
+ * @brief Issues an ObjectMapper method call with caching and coalescing.
+ *
+ * If an identical query is already in flight, and was issued since the
+ * mapper's view last changed, the callback is queued behind it instead of
+ * sending a second call; every waiter receives the same reply (or error) once
+ * it arrives.
+ */
+template <typename ResponseType, typename... Args>
+inline void mapperCall(std::string&& key, const char* method,
+                       MapperCallback<ResponseType>&& callback,
+                       const Args&... args)
+{
+    if (completeFromCache<ResponseType>(key, callback))
+    {
+        return;
+    }
+    uint64_t generation = DbusObjectCache::getInstance().getMapperGeneration();
+    if (!getPendingMapperCalls<ResponseType>().join(key, generation,
+                                                    std::move(callback)))
+    {
+        BMCWEB_LOG_DEBUG << "Joining in-flight mapper call " << key;
+        return;
+    }
+    crow::dbus_trace::SharedCallScope sharedCalls;
+    crow::connections::systemBus->async_method_call(
+        [key{std::move(key)}, generation](const boost::system::error_code& ec,
+                                          const ResponseType& response) {
+        if (!ec)
+        {
+            DbusObjectCache::getInstance().insertMapper(key, generation,
+                                                        response);
+        }
+        for (const MapperCallback<ResponseType>& waiter :
+             getPendingMapperCalls<ResponseType>().take(key, generation))
+        {
+            waiter(ec, response);
+        }
+    },
+        "xyz.openbmc_project.ObjectMapper",
+        "/xyz/openbmc_project/object_mapper",
+        "xyz.openbmc_project.ObjectMapper", method, args...);
+}
+
 inline void
     getSubTree(const std::string& path, int32_t depth,
                std::span<const std::string_view> interfaces,
                std::function<void(const boost::system::error_code&,
                                   const MapperGetSubTreeResponse&)>&& callback)
 {
-    crow::connections::systemBus->async_method_call(
-        [callback{std::move(callback)}](
-            const boost::system::error_code ec,
-            const MapperGetSubTreeResponse& subtree) { callback(ec, subtree); },
-        "xyz.openbmc_project.ObjectMapper",
-        "/xyz/openbmc_project/object_mapper",
-        "xyz.openbmc_project.ObjectMapper", "GetSubTree", path, depth,
-        interfaces);
+    mapperCall<MapperGetSubTreeResponse>(
+        DbusObjectCache::mapperKey("GetSubTree", path, depth, interfaces),
+        "GetSubTree", std::move(callback), path, depth, interfaces);
 }
 
 inline void getSubTreePaths(
@@ -184,17 +703,45 @@ inline void getSubTreePaths(
     std::span<const std::string_view> interfaces,
     std::function<void(const boost::system::error_code&,
                        const MapperGetSubTreePathsResponse&)>&& callback)
+{
+    mapperCall<MapperGetSubTreePathsResponse>(
+        DbusObjectCache::mapperKey("GetSubTreePaths", path, depth,
+                                   interfaces),
+        "GetSubTreePaths", std::move(callback), path, depth, interfaces);
+}
+
+/**
+ * @brief Properties.Get, like sdbusplus::asio::getProperty but made through
+ * the traced systemBus.  A property of another type fails with EINVAL.
+ */
+template <typename PropertyType>
+inline void getProperty(const std::string& service, const std::string& path,
+                        const std::string& interface,
+                        const std::string& property,
+                        std::function<void(const boost::system::error_code&,
+                                           const PropertyType&)>&& callback)
 {
     crow::connections::systemBus->async_method_call(
         [callback{std::move(callback)}](
-            const boost::system::error_code ec,
-            const MapperGetSubTreePathsResponse& subtreePaths) {
-        callback(ec, subtreePaths);
+            const boost::system::error_code& ec,
+            const std::variant<std::monostate, PropertyType>& value) {
+        if (ec)
+        {
+            callback(ec, PropertyType());
+            return;
+        }
+        const PropertyType* typed = std::get_if<PropertyType>(&value);
+        if (typed == nullptr)
+        {
+            callback(boost::system::error_code(
+                         EINVAL, boost::system::system_category()),
+                     PropertyType());
+            return;
+        }
+        callback(ec, *typed);
     },
-        "xyz.openbmc_project.ObjectMapper",
-        "/xyz/openbmc_project/object_mapper",
-        "xyz.openbmc_project.ObjectMapper", "GetSubTreePaths", path, depth,
-        interfaces);
+        service, path, "org.freedesktop.DBus.Properties", "Get", interface,
+        property);
 }
 
 inline void getAssociationEndPoints(
@@ -202,13 +749,9 @@ inline void getAssociationEndPoints(
     std::function<void(const boost::system::error_code&,
                        const MapperEndPoints&)>&& callback)
 {
-    sdbusplus::asio::getProperty<MapperEndPoints>(
-        *crow::connections::systemBus, "xyz.openbmc_project.ObjectMapper", path,
-        "xyz.openbmc_project.Association", "endpoints",
-        [callback{std::move(callback)}](const boost::system::error_code& ec,
-                                        const MapperEndPoints& endpoints) {
-        callback(ec, endpoints);
-    });
+    getProperty<MapperEndPoints>("xyz.openbmc_project.ObjectMapper", path,
+                                 "xyz.openbmc_project.Association", "endpoints",
+                                 std::move(callback));
 }
 
 inline void getAssociatedSubTree(
@@ -253,14 +796,346 @@ inline void
                   std::function<void(const boost::system::error_code&,
                                      const MapperGetObject&)>&& callback)
 {
+    mapperCall<MapperGetObject>(
+        DbusObjectCache::mapperKey("GetObject", path, 0, interfaces),
+        "GetObject", std::move(callback), path, interfaces);
+}
+
+/**
+ * @brief Properties.GetAll through DbusObjectCache.
+ *
+ * An empty interface requests the properties of every interface on the
+ * object, matching sdbusplus::asio::getAllProperties.
+ */
+inline void getAllProperties(
+    const std::string& service, const std::string& path,
+    const std::string& interface,
+    std::function<void(const boost::system::error_code&,
+                       const DBusPropertiesMap&)>&& callback)
+{
+    std::shared_ptr<const DBusPropertiesMap> cached =
+        DbusObjectCache::getInstance().findProperties(service, path,
+                                                      interface);
+    if (cached != nullptr)
+    {
+        boost::asio::post(crow::connections::systemBus->get_io_context(),
+                          [callback{std::move(callback)},
+                           cached{std::move(cached)}]() {
+            callback(boost::system::error_code(), *cached);
+        });
+        return;
+    }
+    uint64_t generation = DbusObjectCache::getInstance().getGeneration();
     crow::connections::systemBus->async_method_call(
-        [callback{std::move(callback)}](const boost::system::error_code& ec,
-                                        const MapperGetObject& object) {
-        callback(ec, object);
+        [callback{std::move(callback)}, service, path, interface,
+         generation](const boost::system::error_code& ec,
+                     const DBusPropertiesMap& properties) {
+        if (!ec)
+        {
+            DbusObjectCache::getInstance().insertProperties(
+                service, path, interface, generation, properties);
+        }
+        callback(ec, properties);
     },
-        "xyz.openbmc_project.ObjectMapper",
-        "/xyz/openbmc_project/object_mapper",
-        "xyz.openbmc_project.ObjectMapper", "GetObject", path, interfaces);
+        service, path, "org.freedesktop.DBus.Properties", "GetAll",
+        interface);
+}
+
+/**
+ * @brief Answers Properties.GetAll reads from GetManagedObjects replies.
+ *
+ * Reads of objects below the same ObjectManager of a service, issued while a
+ * GetManagedObjects call for it is outstanding, wait for that call and are
+ * each handed their slice of the reply.  A handler that reads several
+ * interfaces from many objects then costs one call per service rather than
+ * one per object and interface.  Replies aren't kept once they have been
+ * handed out; the slices go into DbusObjectCache like any other GetAll.
+ */
+class ManagedObjectBatcher
+{
+  public:
+    using Callback = std::function<void(const boost::system::error_code&,
+                                        const DBusPropertiesMap&)>;
+
+    static constexpr std::array<std::string_view, 1> objectManagerInterface =
+        {"org.freedesktop.DBus.ObjectManager"};
+
+    static ManagedObjectBatcher& getInstance()
+    {
+        static ManagedObjectBatcher batcher;
+        return batcher;
+    }
+
+    ManagedObjectBatcher(const ManagedObjectBatcher&) = delete;
+    ManagedObjectBatcher(ManagedObjectBatcher&&) = delete;
+    ManagedObjectBatcher& operator=(const ManagedObjectBatcher&) = delete;
+    ManagedObjectBatcher& operator=(ManagedObjectBatcher&&) = delete;
+    ~ManagedObjectBatcher() = default;
+
+    /**
+     * @brief Returns the deepest ObjectManager of service that path is
+     * below, or an empty string if there is none.
+     */
+    static std::string
+        findObjectManager(const MapperGetSubTreeResponse& managers,
+                          std::string_view service, std::string_view path)
+    {
+        std::string found;
+        for (const auto& [managerPath, services] : managers)
+        {
+            if (managerPath.size() <= found.size())
+            {
+                continue;
+            }
+            bool below = managerPath == "/"
+                             ? path.size() > 1
+                             : path.size() > managerPath.size() + 1 &&
+                                   path.starts_with(managerPath) &&
+                                   path[managerPath.size()] == '/';
+            if (!below)
+            {
+                continue;
+            }
+            for (const auto& entry : services)
+            {
+                if (entry.first == service)
+                {
+                    found = managerPath;
+                    break;
+                }
+            }
+        }
+        return found;
+    }
+
+    void getAllProperties(const std::string& service, const std::string& path,
+                          const std::string& interface, Callback&& callback)
+    {
+        std::shared_ptr<const DBusPropertiesMap> cached =
+            DbusObjectCache::getInstance().findProperties(service, path,
+                                                          interface);
+        if (cached != nullptr)
+        {
+            dbus::utility::getAllProperties(service, path, interface,
+                                            std::move(callback));
+            return;
+        }
+        getSubTree("/", 0, objectManagerInterface,
+                   [this, service, path, interface,
+                    callback{std::move(callback)}](
+                       const boost::system::error_code& ec,
+                       const MapperGetSubTreeResponse& managers) mutable {
+            std::string managerPath;
+            if (!ec)
+            {
+                managerPath = findObjectManager(managers, service, path);
+            }
+            if (managerPath.empty())
+            {
+                dbus::utility::getAllProperties(service, path, interface,
+                                                std::move(callback));
+                return;
+            }
+            read(service, managerPath,
+                 Read{path, interface, std::move(callback)});
+        });
+    }
+
+  private:
+    ManagedObjectBatcher() = default;
+
+    struct Read
+    {
+        std::string path;
+        std::string interface;
+        Callback callback;
+    };
+
+    void read(const std::string& service, const std::string& managerPath,
+              Read&& pending)
+    {
+        std::string key = service + '|' + managerPath;
+        std::vector<Read>& waiting = fetches[key];
+        waiting.emplace_back(std::move(pending));
+        if (waiting.size() > 1)
+        {
+            return;
+        }
+        crow::dbus_trace::SharedCallScope sharedCalls;
+        uint64_t generation = DbusObjectCache::getInstance().getGeneration();
+        crow::connections::systemBus->async_method_call(
+            [this, key, service,
+             generation](const boost::system::error_code& ec,
+                         const ManagedObjectType& objects) {
+            afterGetManagedObjects(key, service, generation, ec, objects);
+        },
+            service, managerPath, "org.freedesktop.DBus.ObjectManager",
+            "GetManagedObjects");
+    }
+
+    void afterGetManagedObjects(const std::string& key,
+                                const std::string& service,
+                                uint64_t generation,
+                                const boost::system::error_code& ec,
+                                const ManagedObjectType& objects)
+    {
+        auto fetch = fetches.find(key);
+        if (fetch == fetches.end())
+        {
+            return;
+        }
+        std::vector<Read> waiting = std::move(fetch->second);
+        fetches.erase(fetch);
+
+        if (ec)
+        {
+            BMCWEB_LOG_DEBUG << "GetManagedObjects on " << key
+                             << " failed: " << ec;
+            for (Read& pending : waiting)
+            {
+                pending.callback(ec, DBusPropertiesMap());
+            }
+            return;
+        }
+
+        std::unordered_map<std::string_view, const DBusInteracesMap*> index;
+        index.reserve(objects.size());
+        for (const auto& [path, interfaces] : objects)
+        {
+            index.try_emplace(path.str, &interfaces);
+        }
+        for (Read& pending : waiting)
+        {
+            DBusPropertiesMap merged;
+            const DBusPropertiesMap* properties = nullptr;
+            if (pending.interface.empty())
+            {
+                properties = mergeInterfaces(index, pending.path, merged);
+            }
+            else
+            {
+                properties =
+                    findInterface(index, pending.path, pending.interface);
+            }
+            if (properties == nullptr)
+            {
+                // What GetAll reports for an object or interface that isn't
+                // there
+                pending.callback(boost::system::error_code(
+                                     EBADR, boost::system::system_category()),
+                                 DBusPropertiesMap());
+                continue;
+            }
+            DbusObjectCache::getInstance().insertProperties(
+                service, pending.path, pending.interface, generation,
+                *properties);
+            pending.callback(boost::system::error_code(), *properties);
+        }
+    }
+
+    static const DBusPropertiesMap* findInterface(
+        const std::unordered_map<std::string_view, const DBusInteracesMap*>&
+            index,
+        const std::string& path, const std::string& interface)
+    {
+        auto object = index.find(path);
+        if (object == index.end())
+        {
+            return nullptr;
+        }
+        for (const auto& [name, properties] : *object->second)
+        {
+            if (name == interface)
+            {
+                return &properties;
+            }
+        }
+        return nullptr;
+    }
+
+    // What GetAll with no interface returns: the properties of every
+    // interface of the object, put into merged
+    static const DBusPropertiesMap* mergeInterfaces(
+        const std::unordered_map<std::string_view, const DBusInteracesMap*>&
+            index,
+        const std::string& path, DBusPropertiesMap& merged)
+    {
+        auto object = index.find(path);
+        if (object == index.end())
+        {
+            return nullptr;
+        }
+        for (const auto& [name, properties] : *object->second)
+        {
+            merged.insert(merged.end(), properties.begin(), properties.end());
+        }
+        return &merged;
+    }
+
+    // Reads waiting on each outstanding call, keyed by service and
+    // ObjectManager path
+    std::unordered_map<std::string, std::vector<Read>> fetches;
+};
+
+/**
+ * @brief Properties.GetAll of one interface, batched with the other reads of
+ * the same service through ManagedObjectBatcher when the service has an
+ * ObjectManager above path.  An empty interface reads the properties of
+ * every interface, as GetAll does.
+ */
+inline void getAllPropertiesBatched(
+    const std::string& service, const std::string& path,
+    const std::string& interface,
+    std::function<void(const boost::system::error_code&,
+                       const DBusPropertiesMap&)>&& callback)
+{
+    ManagedObjectBatcher::getInstance().getAllProperties(
+        service, path, interface, std::move(callback));
+}
+
+/**
+ * @brief Properties.Get of one property, read through
+ * getAllPropertiesBatched.  A missing property fails with EBADR and one of
+ * another type with EINVAL.
+ */
+template <typename PropertyType>
+inline void getPropertyBatched(
+    const std::string& service, const std::string& path,
+    const std::string& interface, const std::string& property,
+    std::function<void(const boost::system::error_code&,
+                       const PropertyType&)>&& callback)
+{
+    getAllPropertiesBatched(
+        service, path, interface,
+        [property, callback{std::move(callback)}](
+            const boost::system::error_code& ec,
+            const DBusPropertiesMap& properties) {
+        if (ec)
+        {
+            callback(ec, PropertyType());
+            return;
+        }
+        for (const auto& [name, value] : properties)
+        {
+            if (name != property)
+            {
+                continue;
+            }
+            const PropertyType* typed = std::get_if<PropertyType>(&value);
+            if (typed == nullptr)
+            {
+                callback(boost::system::error_code(
+                             EINVAL, boost::system::system_category()),
+                         PropertyType());
+                return;
+            }
+            callback(boost::system::error_code(), *typed);
+            return;
+        }
+        callback(boost::system::error_code(EBADR,
+                                           boost::system::system_category()),
+                 PropertyType());
+    });
 }
 
 inline void
@@ -268,13 +1143,159 @@ inline void
                        std::function<void(const boost::system::error_code&,
                                           const AssociationList&)>&& callback)
 {
-    sdbusplus::asio::getProperty<AssociationList>(
-        *crow::connections::systemBus, service, path,
-        "xyz.openbmc_project.Association.Definitions", "Associations",
-        [callback{std::move(callback)}](const boost::system::error_code& ec,
-                                        const AssociationList& associations) {
-        callback(ec, associations);
-    });
+    getProperty<AssociationList>(service, path,
+                                 "xyz.openbmc_project.Association.Definitions",
+                                 "Associations", std::move(callback));
+}
+
+/**
+ * @brief Reads a GetManagedObjects reply in place, deserializing only the
+ * interfaces for which filter(path, interface) returns true.  The properties
+ * of every other interface are skipped in the message without being copied
+ * out, and objects left with no interfaces aren't returned.
+ *
+ * @return 0, or the negative errno of the read that failed
+ */
+template <typename Filter>
+inline int readManagedObjects(sdbusplus::message_t& m, const Filter& filter,
+                              ManagedObjectType& objects)
+{
+    int r = sd_bus_message_enter_container(m.get(), SD_BUS_TYPE_ARRAY,
+                                           "{oa{sa{sv}}}");
+    if (r < 0)
+    {
+        return r;
+    }
+    while ((r = sd_bus_message_at_end(m.get(), 0)) == 0)
+    {
+        r = sd_bus_message_enter_container(m.get(), SD_BUS_TYPE_DICT_ENTRY,
+                                           "oa{sa{sv}}");
+        if (r < 0)
+        {
+            return r;
+        }
+        // Points into the message, which outlives this loop
+        const char* path = nullptr;
+        r = sd_bus_message_read_basic(m.get(), SD_BUS_TYPE_OBJECT_PATH, &path);
+        if (r < 0)
+        {
+            return r;
+        }
+        r = sd_bus_message_enter_container(m.get(), SD_BUS_TYPE_ARRAY,
+                                           "{sa{sv}}");
+        if (r < 0)
+        {
+            return r;
+        }
+
+        DBusInteracesMap interfaces;
+        while ((r = sd_bus_message_at_end(m.get(), 0)) == 0)
+        {
+            r = sd_bus_message_enter_container(m.get(), SD_BUS_TYPE_DICT_ENTRY,
+                                               "sa{sv}");
+            if (r < 0)
+            {
+                return r;
+            }
+            const char* interface = nullptr;
+            r = sd_bus_message_read_basic(m.get(), SD_BUS_TYPE_STRING,
+                                          &interface);
+            if (r < 0)
+            {
+                return r;
+            }
+            if (filter(std::string_view(path), std::string_view(interface)))
+            {
+                DBusPropertiesMap properties;
+                try
+                {
+                    m.read(properties);
+                }
+                catch (const sdbusplus::exception_t& e)
+                {
+                    BMCWEB_LOG_ERROR << "Failed to read properties of "
+                                     << interface << " on " << path << ": "
+                                     << e.what();
+                    return -EINVAL;
+                }
+                interfaces.emplace_back(interface, std::move(properties));
+            }
+            else
+            {
+                r = sd_bus_message_skip(m.get(), "a{sv}");
+                if (r < 0)
+                {
+                    return r;
+                }
+            }
+            r = sd_bus_message_exit_container(m.get());
+            if (r < 0)
+            {
+                return r;
+            }
+        }
+        if (r < 0)
+        {
+            return r;
+        }
+
+        // The interface array, then the object's dict entry
+        r = sd_bus_message_exit_container(m.get());
+        if (r < 0)
+        {
+            return r;
+        }
+        r = sd_bus_message_exit_container(m.get());
+        if (r < 0)
+        {
+            return r;
+        }
+        if (!interfaces.empty())
+        {
+            objects.emplace_back(sdbusplus::message::object_path(path),
+                                 std::move(interfaces));
+        }
+    }
+    if (r < 0)
+    {
+        return r;
+    }
+    return sd_bus_message_exit_container(m.get());
+}
+
+/**
+ * @brief GetManagedObjects of service at path, keeping only the interfaces
+ * filter selects; see readManagedObjects.  Handlers that look at a few
+ * objects of a large tree use this to avoid materializing the rest.
+ */
+inline void getManagedObjectsFiltered(
+    const std::string& service, const std::string& path,
+    std::function<bool(std::string_view, std::string_view)>&& filter,
+    std::function<void(const boost::system::error_code&,
+                       const ManagedObjectType&)>&& callback)
+{
+    crow::connections::systemBus->async_method_call(
+        [filter{std::move(filter)}, callback{std::move(callback)}](
+            const boost::system::error_code& ec, sdbusplus::message_t& m) {
+        ManagedObjectType objects;
+        if (ec)
+        {
+            callback(ec, objects);
+            return;
+        }
+        int r = readManagedObjects(m, filter, objects);
+        if (r < 0)
+        {
+            BMCWEB_LOG_ERROR << "Failed to read managed objects: " << r;
+            callback(boost::system::error_code(
+                         -r, boost::system::system_category()),
+                     ManagedObjectType());
+            return;
+        }
+        callback(ec, objects);
+    },
+        service, path, "org.freedesktop.DBus.ObjectManager",
+        "GetManagedObjects");
 }
 
 } // namespace utility
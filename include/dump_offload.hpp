@@ -1,5 +1,7 @@
 #pragma once
 
+#include "bmcweb_config.h"
+
 #include <sys/select.h>
 
 #include <boost/asio.hpp>
@@ -9,10 +11,16 @@
 #include <boost/beast/core/flat_static_buffer.hpp>
 #include <boost/beast/http.hpp>
 #include <boost/shared_ptr.hpp>
+#include <byte_range.hpp>
 #include <http_stream.hpp>
 #include <ibm/utils.hpp>
+#include <route_metrics.hpp>
 
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <cstddef>
+#include <filesystem>
 #include <random>
 #include <string>
 
@@ -28,7 +36,10 @@ inline void handleDumpOffloadUrl(const crow::Request& req, crow::Response& res,
                                  const std::string& dumpEntryType);
 inline void resetHandler();
 
-static constexpr size_t socketBufferSize = static_cast<size_t>(64 * 1024);
+// Each of the two buffers the offload alternates between: one fills from the
+// dump manager while the other drains to the client
+static constexpr size_t socketBufferSize = bmcwebDumpOffloadBufferSizeKb *
+                                           1024UL;
 static constexpr uint8_t maxConnectRetryCount = 3;
 
 /** class Handler
@@ -47,6 +58,33 @@ class Handler : public std::enable_shared_from_this<Handler>
         waitTimer(ios)
     {}
 
+    // Payload bytes sent to the client so far
+    uint64_t getBytesSent() const
+    {
+        return bytesSent;
+    }
+
+    uint64_t getDumpSize() const
+    {
+        return dumpSize;
+    }
+
+    // Average rate since the dump manager connected, in bytes per second
+    double getThroughput() const
+    {
+        if (!started)
+        {
+            return 0.0;
+        }
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - startTime;
+        if (elapsed.count() <= 0.0)
+        {
+            return 0.0;
+        }
+        return static_cast<double>(bytesSent) / elapsed.count();
+    }
+
     /**
      * @brief Connects to unix socket to read dump data
      *
@@ -82,8 +120,22 @@ class Handler : public std::enable_shared_from_this<Handler>
                 return;
             }
             waitTimer.cancel();
-            this->connection->sendStreamHeaders(std::to_string(this->dumpSize),
+            uint64_t length = this->dumpSize;
+            this->connection->setStreamHeaders("Accept-Ranges", "bytes");
+            this->connection->setStreamHeaders("ETag", this->validator());
+            if (selection.status == crow::byte_range::RangeStatus::Partial)
+            {
+                this->connection->streamres.result(
+                    boost::beast::http::status::partial_content);
+                this->connection->setStreamHeaders(
+                    "Content-Range", crow::byte_range::contentRange(
+                                         selection.range, this->dumpSize));
+                length = selection.range.length();
+            }
+            this->connection->sendStreamHeaders(std::to_string(length),
                                                 "application/octet-stream");
+            this->started = true;
+            this->startTime = std::chrono::steady_clock::now();
             this->doReadStream();
         });
     }
@@ -257,6 +309,10 @@ class Handler : public std::enable_shared_from_this<Handler>
                 return;
             }
             this->dumpSize = *dumpsize;
+            if (!this->selectRange())
+            {
+                return;
+            }
             this->initiateOffload();
             this->doConnect();
         },
@@ -267,22 +323,80 @@ class Handler : public std::enable_shared_from_this<Handler>
             "xyz.openbmc_project.Dump.Entry", "Size");
     }
 
+    // A dump's content never changes once it has an id
+    std::string validator() const
+    {
+        return "\"" + dumpType + "-" + entryID + "-" +
+               std::to_string(dumpSize) + "\"";
+    }
+
     /**
-     * @brief  Reads data from unix domain socket and writes on
-     *         http stream connection socket.
+     * @brief  Works out which bytes of the dump the client asked for.
      *
-     * @return void
+     * @return false if the request has been answered because none of them
+     *         can be sent
      */
+    bool selectRange()
+    {
+        selection = crow::byte_range::selectRange(
+            connection->req.getHeaderValue(boost::beast::http::field::range),
+            connection->req.getHeaderValue(
+                boost::beast::http::field::if_range),
+            dumpSize, validator());
+        if (selection.status == crow::byte_range::RangeStatus::Unsatisfiable)
+        {
+            this->connection->setStreamHeaders(
+                "Content-Range", crow::byte_range::unsatisfiedRange(dumpSize));
+            this->connection->sendStreamErrorStatus(
+                boost::beast::http::status::range_not_satisfiable);
+            this->connection->close();
+            this->cleanupSocketFiles();
+            return false;
+        }
+        toSkip = 0;
+        toRead = dumpSize;
+        if (selection.status == crow::byte_range::RangeStatus::Partial)
+        {
+            // The dump manager always starts from the beginning
+            toSkip = selection.range.first;
+            toRead = selection.range.last + 1;
+        }
+        return true;
+    }
 
+    /**
+     * @brief  Reads data from unix domain socket into whichever buffer isn't
+     *         being written to the http stream connection socket.
+     *
+     * @return void
+     */
     void doReadStream()
     {
-        std::size_t bytes = this->outputBuffer.capacity() -
-                            this->outputBuffer.size();
-
+        boost::beast::flat_static_buffer<socketBufferSize>& buffer =
+            buffers[readIndex];
+        if (reading || eof || buffer.size() == buffer.max_size())
+        {
+            // A full buffer waits for the other one to finish sending
+            return;
+        }
+        if (toRead == 0)
+        {
+            // The rest of the dump is past the requested range
+            eof = true;
+            doWriteStream();
+            return;
+        }
+        size_t space = buffer.max_size() - buffer.size();
+        if (toRead < space)
+        {
+            space = static_cast<size_t>(toRead);
+        }
+        reading = true;
         this->unixSocket.async_read_some(
-            this->outputBuffer.prepare(bytes),
+            buffer.prepare(space),
             [this, self(shared_from_this())](
                 const boost::system::error_code& ec, std::size_t bytesRead) {
+            reading = false;
             if (ec)
             {
                 if (ec != boost::asio::error::eof)
@@ -294,24 +408,89 @@ class Handler : public std::enable_shared_from_this<Handler>
                     return;
                 }
                 BMCWEB_LOG_CRITICAL << "INFO: Hit Dump end of file";
-                this->connection->completionStatus = true;
-                this->connection->close();
+                eof = true;
+                doWriteStream();
                 return;
             }
 
-            this->outputBuffer.commit(bytesRead);
-            auto streamHandler = [this, bytesRead, self(shared_from_this())]() {
-                this->outputBuffer.consume(bytesRead);
-                this->doReadStream();
-            };
-            this->connection->sendMessage(this->outputBuffer.data(),
-                                          streamHandler);
+            toRead -= bytesRead;
+            buffers[readIndex].commit(bytesRead);
+            if (toSkip > 0)
+            {
+                size_t skipped = static_cast<size_t>(
+                    std::min<uint64_t>(toSkip, buffers[readIndex].size()));
+                buffers[readIndex].consume(skipped);
+                toSkip -= skipped;
+            }
+            doWriteStream();
+            doReadStream();
         });
     }
 
+    /**
+     * @brief  Sends what has been read, and switches reads to the other
+     *         buffer until that is done.
+     *
+     * @return void
+     */
+    void doWriteStream()
+    {
+        // The buffer being read into can't be swapped out mid read; the read
+        // completing will come back here
+        if (writing || reading)
+        {
+            return;
+        }
+        if (buffers[readIndex].size() == 0)
+        {
+            if (eof)
+            {
+                finishStream();
+            }
+            return;
+        }
+        writing = true;
+        size_t sendIndex = readIndex;
+        readIndex ^= 1U;
+        // buffers[sendIndex] is written in place until this runs
+        this->connection->sendMessage(
+            buffers[sendIndex].data(),
+            [this, self(shared_from_this()), sendIndex]() {
+            bytesSent += buffers[sendIndex].size();
+            buffers[sendIndex].clear();
+            writing = false;
+            doWriteStream();
+            doReadStream();
+        });
+    }
+
+    void finishStream()
+    {
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - startTime;
+        BMCWEB_LOG_CRITICAL << "INFO: " << dumpType << " dump id " << entryID
+                            << " offloaded " << bytesSent << " bytes in "
+                            << elapsed.count() << "s, "
+                            << getThroughput() / (1024.0 * 1024.0) << " MiB/s";
+        this->connection->completionStatus = true;
+        this->connection->close();
+    }
+
     std::string entryID;
     std::string dumpType;
-    boost::beast::flat_static_buffer<socketBufferSize> outputBuffer;
+    std::array<boost::beast::flat_static_buffer<socketBufferSize>, 2> buffers;
+    size_t readIndex = 0;
+    bool reading = false;
+    bool writing = false;
+    bool eof = false;
+    bool started = false;
+    std::chrono::steady_clock::time_point startTime;
+    uint64_t bytesSent = 0;
+    crow::byte_range::RangeSelection selection;
+    // Bytes before the requested range still to be read and dropped
+    uint64_t toSkip = 0;
+    // Bytes still to be read from the dump manager, skipped ones included
+    uint64_t toRead = 0;
     std::filesystem::path unixSocketPath;
     boost::asio::local::stream_protocol::socket unixSocket;
     uint64_t dumpSize{0};
@@ -347,6 +526,54 @@ inline void resetHandlers()
     }
 }
 
+// Progress of the offloads currently running, for /metrics
+inline std::string renderPrometheus()
+{
+    std::string out;
+    auto appendSamples = [&out](std::string_view name, std::string_view help,
+                                std::string_view type, auto value) {
+        out += "# HELP ";
+        out += name;
+        out += ' ';
+        out += help;
+        out += "\n# TYPE ";
+        out += name;
+        out += ' ';
+        out += type;
+        out += '\n';
+        for (const auto* handlers : {&bmcHandlers, &systemHandlers})
+        {
+            for (const auto& [conn, handler] : *handlers)
+            {
+                out += name;
+                out += "{type=\"";
+                metrics::appendLabelValue(out, handler->dumpType);
+                out += "\",id=\"";
+                metrics::appendLabelValue(out, handler->entryID);
+                out += "\"} ";
+                out += value(*handler);
+                out += '\n';
+            }
+        }
+    };
+    appendSamples("bmcweb_dump_offload_sent_bytes",
+                  "Bytes of the dump sent to the client so far", "gauge",
+                  [](const Handler& handler) {
+        return std::to_string(handler.getBytesSent());
+    });
+    appendSamples("bmcweb_dump_offload_size_bytes", "Size of the dump",
+                  "gauge", [](const Handler& handler) {
+        return std::to_string(handler.getDumpSize());
+    });
+    appendSamples("bmcweb_dump_offload_throughput_bytes_per_second",
+                  "Average rate the dump has been sent at", "gauge",
+                  [](const Handler& handler) {
+        return std::to_string(
+            static_cast<uint64_t>(handler.getThroughput()));
+    });
+    return out;
+}
+
 inline void requestRoutes(App& app)
 {
     BMCWEB_ROUTE(
@@ -418,7 +645,6 @@ inline void requestRoutes(App& app)
         {
             handler->second->resetOffloadURI();
         }
-        handler->second->outputBuffer.clear();
         bmcHandlers.erase(handler);
     });
 
@@ -509,7 +735,6 @@ inline void requestRoutes(App& app)
         {
             handler->second->resetOffloadURI();
         }
-        handler->second->outputBuffer.clear();
         systemHandlers.clear();
         BMCWEB_LOG_CRITICAL
             << "INFO:Request closed for system dump offload with"
@@ -5,6 +5,8 @@
 #include <boost/container/flat_map.hpp>
 #include <nlohmann/json.hpp>
 
+#include <cstdint>
+
 namespace persistent_data
 {
 
@@ -22,6 +24,11 @@ struct UserSubscription
     std::vector<std::string> resourceTypes;
     boost::beast::http::fields httpHeaders;
     std::vector<std::string> metricReportDefinitions;
+    // Oem MetricAggregation: MetricReports are reduced to one value per
+    // metric for each interval before they are sent.  An empty function
+    // sends every update as it comes.
+    std::string metricAggregationFunction;
+    uint64_t metricAggregationIntervalMs = 0;
 
     static std::shared_ptr<UserSubscription>
         fromJson(const nlohmann::json& j, const bool loadFromOldConfig = false)
@@ -172,6 +179,26 @@ struct UserSubscription
                     subvalue->metricReportDefinitions.emplace_back(*value);
                 }
             }
+            else if (element.key() == "MetricAggregationFunction")
+            {
+                const std::string* value =
+                    element.value().get_ptr<const std::string*>();
+                if (value == nullptr)
+                {
+                    continue;
+                }
+                subvalue->metricAggregationFunction = *value;
+            }
+            else if (element.key() == "MetricAggregationIntervalMs")
+            {
+                const uint64_t* value =
+                    element.value().get_ptr<const uint64_t*>();
+                if (value == nullptr)
+                {
+                    continue;
+                }
+                subvalue->metricAggregationIntervalMs = *value;
+            }
             else
             {
                 BMCWEB_LOG_ERROR
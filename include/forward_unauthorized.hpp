@@ -43,7 +43,7 @@ inline void sendUnauthorized(std::string_view url,
     // if basic auth is disabled, don't propose it.
     if (!persistent_data::SessionStore::getInstance()
              .getAuthMethodsConfig()
-             .basic)
+             ->basic)
     {
         return;
     }
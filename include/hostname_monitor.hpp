@@ -7,6 +7,8 @@
 #include <sdbusplus/message/types.hpp>
 #include <ssl_key_handler.hpp>
 
+#include <filesystem>
+
 namespace crow
 {
 namespace hostname_monitor
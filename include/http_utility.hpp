@@ -6,9 +6,14 @@
 #include <boost/type_index/type_index_facade.hpp>
 
 #include <cctype>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
 #include <iomanip>
+#include <optional>
 #include <ostream>
 #include <span>
+#include <sstream>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -25,6 +30,8 @@ enum class ContentType
     CBOR,
     HTML,
     JSON,
+    MsgPack,
+    NDJSON,
     OctetStream,
 };
 
@@ -34,10 +41,12 @@ struct ContentTypePair
     ContentType contentTypeEnum;
 };
 
-constexpr std::array<ContentTypePair, 4> contentTypes{{
+constexpr std::array<ContentTypePair, 6> contentTypes{{
     {"application/cbor", ContentType::CBOR},
     {"application/json", ContentType::JSON},
+    {"application/msgpack", ContentType::MsgPack},
     {"application/octet-stream", ContentType::OctetStream},
+    {"application/x-ndjson", ContentType::NDJSON},
     {"text/html", ContentType::HTML},
 }};
 
@@ -133,4 +142,44 @@ inline std::string urlEncode(const std::string_view value)
 
     return escaped.str();
 }
+
+// Returns the wait preference (RFC 7240) of a Prefer header, if it has one
+inline std::optional<std::chrono::seconds>
+    getPreferredWait(std::string_view header)
+{
+    while (!header.empty())
+    {
+        size_t comma = header.find(',');
+        std::string_view preference = header.substr(0, comma);
+        header.remove_prefix(comma == std::string_view::npos ? header.size()
+                                                             : comma + 1);
+
+        // Drop any parameters, and the whitespace around the preference
+        preference = preference.substr(0, preference.find(';'));
+        size_t start = preference.find_first_not_of(" \t");
+        if (start == std::string_view::npos)
+        {
+            continue;
+        }
+        preference.remove_prefix(start);
+        preference = preference.substr(
+            0, preference.find_last_not_of(" \t") + 1);
+
+        constexpr std::string_view waitPrefix = "wait=";
+        if (!preference.starts_with(waitPrefix))
+        {
+            continue;
+        }
+        preference.remove_prefix(waitPrefix.size());
+        uint32_t seconds = 0;
+        const char* end = preference.data() + preference.size();
+        auto [ptr, ec] = std::from_chars(preference.data(), end, seconds);
+        if (ec != std::errc() || ptr != end)
+        {
+            return std::nullopt;
+        }
+        return std::chrono::seconds(seconds);
+    }
+    return std::nullopt;
+}
 } // namespace http_helpers
@@ -1,8 +1,14 @@
 #pragma once
 
+#include <algorithm>
 #include <charconv>
+#include <climits>
+#include <cstddef>
 #include <iterator>
+#include <string>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 namespace details
 {
@@ -20,6 +26,20 @@ enum class ModeType
     NUMBER
 };
 
+// Ranks a non-digit character for alphanumSortKey().  Characters keep the
+// order alphanumComp() compares them in (char's own signedness), moved up by
+// one so 0 is free to mark a number, and down over the digits they skip.
+inline char sortKeyChar(const char c)
+{
+    constexpr int firstDigit = '0' - CHAR_MIN;
+    int rank = static_cast<int>(c) - CHAR_MIN;
+    if (rank > firstDigit + 9)
+    {
+        rank -= 10;
+    }
+    return static_cast<char>(rank + 1);
+}
+
 } // namespace details
 
 inline int alphanumComp(const std::string_view left,
@@ -108,3 +128,84 @@ struct AlphanumLess
         return alphanumComp(left, right) < 0;
     }
 };
+
+/**
+ * @brief Encodes value so that plain string comparison of two keys orders
+ * them the way alphanumComp() orders the values.
+ *
+ * Each run of digits becomes a 0 byte, the number of significant digits as
+ * two bytes and then the digits, so numbers compare by magnitude without
+ * being parsed, and without the int range limit of alphanumComp().  Other
+ * characters become one byte each, ranked above the number marker.
+ */
+inline std::string alphanumSortKey(const std::string_view value)
+{
+    std::string key;
+    key.reserve(value.size() + 4);
+    size_t i = 0;
+    while (i < value.size())
+    {
+        if (!details::simpleIsDigit(value[i]))
+        {
+            key += details::sortKeyChar(value[i]);
+            i++;
+            continue;
+        }
+        size_t end = i;
+        while (end < value.size() && details::simpleIsDigit(value[end]))
+        {
+            end++;
+        }
+        while (i < end && value[i] == '0')
+        {
+            i++;
+        }
+        size_t digits = std::min<size_t>(end - i, 0xFFFF);
+        key += '\0';
+        key += static_cast<char>(digits >> 8);
+        key += static_cast<char>(digits & 0xFF);
+        key.append(value.substr(i, digits));
+        i = end;
+    }
+    return key;
+}
+
+/**
+ * @brief Sorts [begin, end) in AlphanumLess order of projection(element).
+ *
+ * Each element is encoded once with alphanumSortKey(), so sorting N elements
+ * costs N encodes and O(N log N) byte compares rather than O(N log N)
+ * alphanumComp() parses.  Elements with equal keys keep their original
+ * order.
+ */
+template <typename Iterator, typename Projection>
+inline void alphanumSort(Iterator begin, Iterator end, Projection&& projection)
+{
+    using Value = typename std::iterator_traits<Iterator>::value_type;
+
+    std::vector<std::pair<std::string, size_t>> keys;
+    keys.reserve(static_cast<size_t>(std::distance(begin, end)));
+    size_t index = 0;
+    for (Iterator it = begin; it != end; it++)
+    {
+        keys.emplace_back(alphanumSortKey(projection(*it)), index++);
+    }
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<Value> sorted;
+    sorted.reserve(keys.size());
+    for (const std::pair<std::string, size_t>& key : keys)
+    {
+        sorted.emplace_back(std::move(
+            *(begin + static_cast<std::ptrdiff_t>(key.second))));
+    }
+    std::move(sorted.begin(), sorted.end(), begin);
+}
+
+template <typename Iterator>
+inline void alphanumSort(Iterator begin, Iterator end)
+{
+    alphanumSort(begin, end, [](const auto& value) -> std::string_view {
+        return value;
+    });
+}
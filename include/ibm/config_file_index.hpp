@@ -0,0 +1,196 @@
+#pragma once
+
+#include <logging.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace crow
+{
+namespace ibm_utils
+{
+
+/*
+ * Keeps the names, sizes and modification times of the files in the
+ * management console config file directory, and the space they take, so
+ * uploads and listings don't walk the directory each time.
+ *
+ * The index is built by one scan of the directory and then kept up to date
+ * by added() and removed() as bmcweb writes and deletes files.  A change to
+ * the directory made some other way moves its modification time, which
+ * refresh() checks, and the index is built again.
+ */
+class ConfigFileIndex
+{
+  public:
+    struct Entry
+    {
+        std::uintmax_t size = 0;
+        std::filesystem::file_time_type modified;
+    };
+
+    explicit ConfigFileIndex(std::filesystem::path dirIn) :
+        dir(std::move(dirIn))
+    {}
+
+    /*
+     * Brings the index up to date with the directory, scanning it only if
+     * the index hasn't been built or the directory changed behind it.
+     *
+     * Returns : False (if the directory couldn't be read)
+     */
+    bool refresh()
+    {
+        std::error_code ec;
+        if (!std::filesystem::is_directory(dir, ec))
+        {
+            clear();
+            loaded = true;
+            return true;
+        }
+        std::filesystem::file_time_type dirModified =
+            std::filesystem::last_write_time(dir, ec);
+        if (ec)
+        {
+            BMCWEB_LOG_ERROR << "Failed to read the modification time of "
+                             << dir << ". ec : " << ec;
+            return false;
+        }
+        if (loaded && dirModified == lastDirModified)
+        {
+            return true;
+        }
+        return scan(dirModified);
+    }
+
+    // The space taken by every file under the directory
+    std::uintmax_t totalSize() const
+    {
+        return total;
+    }
+
+    const Entry* find(const std::string& name) const
+    {
+        auto it = files.find(name);
+        if (it == files.end())
+        {
+            return nullptr;
+        }
+        return &it->second;
+    }
+
+    // The names of the files in the directory, in order
+    std::vector<std::string> names() const
+    {
+        std::vector<std::string> out;
+        out.reserve(files.size());
+        for (const auto& file : files)
+        {
+            out.emplace_back(file.first);
+        }
+        return out;
+    }
+
+    // Records that name was written with size bytes
+    void added(const std::string& name, std::uintmax_t size)
+    {
+        Entry& entry = files[name];
+        total = total - entry.size + size;
+        entry.size = size;
+        std::error_code ec;
+        entry.modified = std::filesystem::last_write_time(dir / name, ec);
+        rememberDirModified();
+    }
+
+    // Records that name was deleted
+    void removed(const std::string& name)
+    {
+        auto it = files.find(name);
+        if (it != files.end())
+        {
+            total -= it->second.size;
+            files.erase(it);
+        }
+        rememberDirModified();
+    }
+
+    // Records that the whole directory was deleted
+    void clear()
+    {
+        files.clear();
+        total = 0;
+        lastDirModified = {};
+    }
+
+  private:
+    bool scan(std::filesystem::file_time_type dirModified)
+    {
+        BMCWEB_LOG_DEBUG << "Building the config file index of " << dir;
+        std::map<std::string, Entry> scanned;
+        std::uintmax_t scannedTotal = 0;
+
+        std::error_code ec;
+        std::filesystem::recursive_directory_iterator iter(dir, ec);
+        std::filesystem::recursive_directory_iterator end;
+        for (; !ec && iter != end; iter.increment(ec))
+        {
+            if (iter->is_directory(ec) || ec)
+            {
+                continue;
+            }
+            std::uintmax_t size = iter->file_size(ec);
+            if (ec)
+            {
+                break;
+            }
+            scannedTotal += size;
+            // Listed files are the ones directly in the directory
+            if (iter.depth() == 0 && iter->is_regular_file(ec))
+            {
+                Entry& entry = scanned[iter->path().filename().string()];
+                entry.size = size;
+                entry.modified = iter->last_write_time(ec);
+            }
+        }
+        if (ec)
+        {
+            BMCWEB_LOG_ERROR << "Failed to scan " << dir << ". ec : " << ec;
+            loaded = false;
+            return false;
+        }
+        files = std::move(scanned);
+        total = scannedTotal;
+        lastDirModified = dirModified;
+        loaded = true;
+        return true;
+    }
+
+    // Changes made through added() and removed() are already in the index
+    void rememberDirModified()
+    {
+        std::error_code ec;
+        std::filesystem::file_time_type dirModified =
+            std::filesystem::last_write_time(dir, ec);
+        if (ec)
+        {
+            loaded = false;
+            return;
+        }
+        lastDirModified = dirModified;
+    }
+
+    std::filesystem::path dir;
+    std::map<std::string, Entry> files;
+    std::uintmax_t total = 0;
+    std::filesystem::file_time_type lastDirModified;
+    bool loaded = false;
+};
+
+} // namespace ibm_utils
+} // namespace crow
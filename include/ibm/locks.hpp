@@ -3,13 +3,17 @@
 #include "ibm/utils.hpp"
 
 #include <boost/algorithm/string/predicate.hpp>
-#include <boost/container/flat_map.hpp>
 #include <boost/endian/conversion.hpp>
 #include <logging.hpp>
 #include <nlohmann/json.hpp>
 
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
+#include <map>
+#include <optional>
+#include <set>
+#include <unordered_map>
 #include <variant>
 
 namespace crow
@@ -42,7 +46,45 @@ using ListOfSessionIds = std::vector<std::string>;
 class Lock
 {
     uint32_t transactionId = 0;
-    boost::container::flat_map<uint32_t, LockRequests> lockTable;
+    std::map<uint32_t, LockRequests> lockTable;
+
+    // A lock record in the lock table: its transaction id and its position
+    // in that transaction.  These order the same way the table does.
+    using LockRef = std::pair<uint32_t, uint32_t>;
+
+    /*
+     * Indexes of the lock table, kept by addLocks() and removeLocks().
+     *
+     * isConflictRecord() decides most pairs of records on their first
+     * segments: a LockAll conflicts, a LockSame conflicts at the same
+     * length, different lengths never do, and two DontLocks compare leading
+     * bytes of the resource id.  The records indexed under the first segment
+     * of a new record are the only ones it can conflict with, so only those
+     * need comparing in full.
+     */
+    std::set<LockRef> writeLocks;
+    std::set<LockRef> firstLockAll;
+    std::map<uint32_t, std::set<LockRef>> firstLockSame;
+    // Every record not locking all, by the length of its first segment
+    std::map<uint32_t, std::set<LockRef>> firstByLength;
+    // DontLock records by first segment length and compared resource id bytes
+    std::map<std::pair<uint32_t, uint64_t>, std::set<LockRef>> firstDontLock;
+    // Transaction ids by the session that holds them
+    std::unordered_map<std::string, std::set<uint32_t>> sessionLocks;
+
+    void addLocks(uint32_t id, const LockRequests& lockRequests);
+    void removeLocks(std::map<uint32_t, LockRequests>::iterator it);
+    void indexRecord(const LockRef& ref, const LockRequest& record,
+                     bool remove);
+    std::optional<LockRef> findConflict(const LockRequest& lockRecord);
+
+    /*
+     * The leading bytes of the resource id that isConflictRecord() compares
+     * for two DontLock first segments of this length.  A longer segment runs
+     * past the end of the id, which it takes as no conflict.
+     */
+    static std::optional<uint64_t> dontLockPrefix(uint64_t resourceId,
+                                                  uint32_t length);
 
   protected:
     /*
@@ -189,26 +231,19 @@ inline RcGetLockList Lock::getLockList(const ListOfSessionIds& listSessionId)
 {
     std::vector<std::pair<uint32_t, LockRequests>> lockList{};
 
-    if (!lockTable.empty())
+    for (const auto& i : listSessionId)
     {
-        for (const auto& i : listSessionId)
+        auto session = sessionLocks.find(i);
+        if (session == sessionLocks.end())
         {
-            auto it = lockTable.begin();
-            while (it != lockTable.end())
-            {
-                // Check if session id of this entry matches with session id
-                // given
-                if (std::get<0>(it->second[0]) == i)
-                {
-                    BMCWEB_LOG_DEBUG << "Session id is found in the locktable";
-
-                    // Push the whole lock record into a vector for returning
-                    // the json
-                    lockList.emplace_back(it->first, it->second);
-                }
-                // Go to next entry in map
-                it++;
-            }
+            continue;
+        }
+        BMCWEB_LOG_DEBUG << "Session id is found in the locktable";
+        for (uint32_t id : session->second)
+        {
+            // Push the whole lock record into a vector for returning the
+            // json
+            lockList.emplace_back(id, lockTable[id]);
         }
     }
     // we may have found at least one entry with the given session id
@@ -274,29 +309,20 @@ inline RcAcquireLock Lock::acquireLock(const LockRequests& lockRequestStructure)
 
 inline void Lock::releaseLock(const std::string& sessionId)
 {
-    if (!lockTable.empty())
+    auto session = sessionLocks.find(sessionId);
+    if (session == sessionLocks.end())
     {
-        auto it = lockTable.begin();
-        while (it != lockTable.end())
-        {
-            if (!it->second.empty())
-            {
-                // Check if session id of this entry matches with session id
-                // given
-                if (std::get<0>(it->second[0]) == sessionId)
-                {
-                    BMCWEB_LOG_DEBUG << "Remove the lock from the locktable "
-                                        "having sessionID="
-                                     << sessionId;
-                    BMCWEB_LOG_DEBUG << "TransactionID =" << it->first;
-                    it = lockTable.erase(it);
-                }
-                else
-                {
-                    it++;
-                }
-            }
-        }
+        return;
+    }
+    // removeLocks() drops the session once its last lock goes
+    std::set<uint32_t> ids = session->second;
+    for (uint32_t id : ids)
+    {
+        BMCWEB_LOG_DEBUG << "Remove the lock from the locktable "
+                            "having sessionID="
+                         << sessionId;
+        BMCWEB_LOG_DEBUG << "TransactionID =" << id;
+        removeLocks(lockTable.find(id));
     }
 }
 inline RcRelaseLock Lock::isItMyLock(const ListOfTransactionIds& refRids,
@@ -317,8 +343,10 @@ inline RcRelaseLock Lock::isItMyLock(const ListOfTransactionIds& refRids,
             // It is owned by the currently request hmc
             BMCWEB_LOG_DEBUG << "Lock is owned  by the current hmc";
             // remove the lock
-            if (lockTable.erase(id) != 0U)
+            auto it = lockTable.find(id);
+            if (it != lockTable.end())
             {
+                removeLocks(it);
                 BMCWEB_LOG_DEBUG << "Removing the locks with transaction ID : "
                                  << id;
             }
@@ -436,8 +464,7 @@ inline Rc Lock::isConflictWithTable(const LockRequests& refLockRequestStructure)
         // Lock table is empty, so we are safe to add the lockrecords
         // as there will be no conflict
         BMCWEB_LOG_DEBUG << "Lock table is empty, so adding the lockrecords";
-        lockTable.emplace(std::pair<uint32_t, LockRequests>(
-            thisTransactionId, refLockRequestStructure));
+        addLocks(thisTransactionId, refLockRequestStructure);
 
         return std::make_pair(false, thisTransactionId);
     }
@@ -448,17 +475,13 @@ inline Rc Lock::isConflictWithTable(const LockRequests& refLockRequestStructure)
 
     for (const auto& lockRecord1 : refLockRequestStructure)
     {
-        for (const auto& map : lockTable)
+        std::optional<LockRef> conflict = findConflict(lockRecord1);
+        if (conflict)
         {
-            for (const auto& lockRecord2 : map.second)
-            {
-                bool status = isConflictRecord(lockRecord1, lockRecord2);
-                if (status)
-                {
-                    return std::make_pair(
-                        true, std::make_pair(map.first, lockRecord2));
-                }
-            }
+            return std::make_pair(
+                true, std::make_pair(
+                          conflict->first,
+                          lockTable[conflict->first][conflict->second]));
         }
     }
 
@@ -469,7 +492,7 @@ inline Rc Lock::isConflictWithTable(const LockRequests& refLockRequestStructure)
     // as there will be no conflict
     BMCWEB_LOG_DEBUG << " Adding elements into lock table";
     transactionId = generateTransactionId();
-    lockTable.emplace(std::make_pair(transactionId, refLockRequestStructure));
+    addLocks(transactionId, refLockRequestStructure);
 
     return std::make_pair(false, transactionId);
 }
@@ -605,6 +628,191 @@ inline bool Lock::isConflictRecord(const LockRequest& refLockRecord1,
     return true;
 }
 
+inline std::optional<uint64_t> Lock::dontLockPrefix(uint64_t resourceId,
+                                                    uint32_t length)
+{
+    // isConflictRecord() compares length bytes, length times over
+    uint32_t bytes = length * length;
+    if (bytes >= sizeof(resourceId))
+    {
+        return std::nullopt;
+    }
+    if (bytes == 0)
+    {
+        return 0;
+    }
+    return resourceId >> (8 * (sizeof(resourceId) - bytes));
+}
+
+inline void Lock::indexRecord(const LockRef& ref, const LockRequest& record,
+                              bool remove)
+{
+    auto update = [&ref, remove](std::set<LockRef>& index) {
+        if (remove)
+        {
+            index.erase(ref);
+        }
+        else
+        {
+            index.insert(ref);
+        }
+    };
+    // Drops an index entry once nothing is under it
+    auto updateIn = [&update, remove](auto& indexes, const auto& key) {
+        auto& index = indexes[key];
+        update(index);
+        if (remove && index.empty())
+        {
+            indexes.erase(key);
+        }
+    };
+
+    if (!boost::equals(std::get<2>(record), "Read"))
+    {
+        update(writeLocks);
+    }
+    const SegmentFlags& segments = std::get<4>(record);
+    if (segments.empty())
+    {
+        return;
+    }
+    const auto& [flag, length] = segments[0];
+    if (boost::equals(flag, "LockAll"))
+    {
+        update(firstLockAll);
+        return;
+    }
+    updateIn(firstByLength, length);
+    if (boost::equals(flag, "LockSame"))
+    {
+        updateIn(firstLockSame, length);
+        return;
+    }
+    std::optional<uint64_t> prefix = dontLockPrefix(std::get<3>(record),
+                                                    length);
+    if (prefix)
+    {
+        updateIn(firstDontLock, std::make_pair(length, *prefix));
+    }
+}
+
+inline void Lock::addLocks(uint32_t id, const LockRequests& lockRequests)
+{
+    auto [it, inserted] = lockTable.emplace(id, lockRequests);
+    if (!inserted)
+    {
+        return;
+    }
+    for (uint32_t i = 0; i < lockRequests.size(); i++)
+    {
+        indexRecord({id, i}, lockRequests[i], false);
+    }
+    if (!lockRequests.empty())
+    {
+        sessionLocks[std::get<0>(lockRequests[0])].insert(id);
+    }
+}
+
+inline void Lock::removeLocks(std::map<uint32_t, LockRequests>::iterator it)
+{
+    if (it == lockTable.end())
+    {
+        return;
+    }
+    const LockRequests& lockRequests = it->second;
+    for (uint32_t i = 0; i < lockRequests.size(); i++)
+    {
+        indexRecord({it->first, i}, lockRequests[i], true);
+    }
+    if (!lockRequests.empty())
+    {
+        auto session = sessionLocks.find(std::get<0>(lockRequests[0]));
+        if (session != sessionLocks.end())
+        {
+            session->second.erase(it->first);
+            if (session->second.empty())
+            {
+                sessionLocks.erase(session);
+            }
+        }
+    }
+    lockTable.erase(it);
+}
+
+// Finds the first record in the lock table that lockRecord conflicts with,
+// in the same order a walk of the whole table would
+inline std::optional<Lock::LockRef>
+    Lock::findConflict(const LockRequest& lockRecord)
+{
+    const SegmentFlags& segments = std::get<4>(lockRecord);
+    bool isRead = boost::equals(std::get<2>(lockRecord), "Read");
+
+    std::vector<LockRef> candidates;
+    auto addCandidates = [&candidates](const std::set<LockRef>& index) {
+        candidates.insert(candidates.end(), index.begin(), index.end());
+    };
+    if (segments.empty() || boost::equals(segments[0].first, "LockAll"))
+    {
+        if (!isRead)
+        {
+            // Conflicts with about anything, so the walk ends early
+            for (const auto& [id, lockRequests] : lockTable)
+            {
+                for (uint32_t i = 0; i < lockRequests.size(); i++)
+                {
+                    if (isConflictRecord(lockRecord, lockRequests[i]))
+                    {
+                        return LockRef{id, i};
+                    }
+                }
+            }
+            return std::nullopt;
+        }
+        addCandidates(writeLocks);
+    }
+    else
+    {
+        const auto& [flag, length] = segments[0];
+        addCandidates(firstLockAll);
+        if (boost::equals(flag, "LockSame"))
+        {
+            auto sameLength = firstByLength.find(length);
+            if (sameLength != firstByLength.end())
+            {
+                addCandidates(sameLength->second);
+            }
+        }
+        else
+        {
+            auto lockSame = firstLockSame.find(length);
+            if (lockSame != firstLockSame.end())
+            {
+                addCandidates(lockSame->second);
+            }
+            std::optional<uint64_t> prefix =
+                dontLockPrefix(std::get<3>(lockRecord), length);
+            if (prefix)
+            {
+                auto dontLock = firstDontLock.find({length, *prefix});
+                if (dontLock != firstDontLock.end())
+                {
+                    addCandidates(dontLock->second);
+                }
+            }
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end());
+    for (const LockRef& ref : candidates)
+    {
+        if (isConflictRecord(lockRecord, lockTable[ref.first][ref.second]))
+        {
+            return ref;
+        }
+    }
+    return std::nullopt;
+}
+
 inline uint32_t Lock::generateTransactionId()
 {
     ++transactionId;
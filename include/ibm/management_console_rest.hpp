@@ -3,6 +3,7 @@
 #include "multipart_parser.hpp"
 
 #include <app.hpp>
+#include <async_file.hpp>
 #include <async_resp.hpp>
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/predicate.hpp>
@@ -12,6 +13,7 @@
 #include <dbus_utility.hpp>
 #include <error_messages.hpp>
 #include <event_service_manager.hpp>
+#include <ibm/config_file_index.hpp>
 #include <ibm/locks.hpp>
 #include <nlohmann/json.hpp>
 #include <resource_messages.hpp>
@@ -53,11 +55,19 @@ constexpr size_t maxSaveareaFileSize =
     25000000; // Allow save area file size upto 25MB
 constexpr size_t maxBroadcastMsgSize =
     1000;     // Allow Broadcast message size upto 1KB
+constexpr size_t maxRootCertSize =
+    65536;    // Allow root certificate size upto 64KB
 
 static boost::container::flat_map<std::string,
                                   std::unique_ptr<sdbusplus::bus::match::match>>
     ackMatches;
 
+inline ibm_utils::ConfigFileIndex& getConfigFileIndex()
+{
+    static ibm_utils::ConfigFileIndex index(configFilePath);
+    return index;
+}
+
 inline bool isValidConfigFileName(const std::string& fileName,
                                   nlohmann::json& resp)
 {
@@ -95,7 +105,6 @@ inline bool isValidConfigFileName(const std::string& fileName,
 inline bool saveConfigFile(const std::string& data, const std::string& fileID,
                            const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
 {
-    std::error_code ec;
     // Get the file size getting uploaded
     BMCWEB_LOG_DEBUG << "data length: " << data.length()
                      << "fileID: " << fileID;
@@ -118,48 +127,17 @@ inline bool saveConfigFile(const std::string& data, const std::string& fileID,
     std::filesystem::path loc(configFilePath);
 
     // Get the current size of the savearea directory
-    std::filesystem::recursive_directory_iterator iter(loc, ec);
-    if (ec)
+    ibm_utils::ConfigFileIndex& index = getConfigFileIndex();
+    if (!index.refresh())
     {
         asyncResp->res.result(
             boost::beast::http::status::internal_server_error);
         asyncResp->res.jsonValue["Description"] = internalFileSystemError;
-        BMCWEB_LOG_DEBUG << "handleIbmPut: Failed to prepare save-area "
-                            "directory iterator. ec : "
-                         << ec;
+        BMCWEB_LOG_DEBUG << "handleIbmPut: Failed to find the size of the "
+                            "save-area directory";
         return false;
     }
-    std::uintmax_t saveAreaDirSize = 0;
-    for (const auto& it : iter)
-    {
-        if (!std::filesystem::is_directory(it, ec))
-        {
-            if (ec)
-            {
-                asyncResp->res.result(
-                    boost::beast::http::status::internal_server_error);
-                asyncResp->res.jsonValue["Description"] =
-                    internalFileSystemError;
-                BMCWEB_LOG_DEBUG << "handleIbmPut: Failed to find save-area "
-                                    "directory . ec : "
-                                 << ec;
-                return false;
-            }
-            std::uintmax_t fileSize = std::filesystem::file_size(it, ec);
-            if (ec)
-            {
-                asyncResp->res.result(
-                    boost::beast::http::status::internal_server_error);
-                asyncResp->res.jsonValue["Description"] =
-                    internalFileSystemError;
-                BMCWEB_LOG_DEBUG << "handleIbmPut: Failed to find save-area "
-                                    "file size inside the directory . ec : "
-                                 << ec;
-                return false;
-            }
-            saveAreaDirSize += fileSize;
-        }
-    }
+    std::uintmax_t saveAreaDirSize = index.totalSize();
     BMCWEB_LOG_DEBUG << "saveAreaDirSize: " << saveAreaDirSize;
 
     // Form the file path
@@ -167,30 +145,13 @@ inline bool saveConfigFile(const std::string& data, const std::string& fileID,
     BMCWEB_LOG_DEBUG << "Writing to the file: " << loc;
 
     // Check if the same file exists in the directory
-    bool fileExists = std::filesystem::exists(loc, ec);
-    if (ec)
-    {
-        asyncResp->res.result(
-            boost::beast::http::status::internal_server_error);
-        asyncResp->res.jsonValue["Description"] = internalFileSystemError;
-        BMCWEB_LOG_DEBUG << "handleIbmPut: Failed to find if file exists. ec : "
-                         << ec;
-        return false;
-    }
+    const ibm_utils::ConfigFileIndex::Entry* existing = index.find(fileID);
+    bool fileExists = existing != nullptr;
     std::uintmax_t newSizeToWrite = 0;
     if (fileExists)
     {
         // File exists. Get the current file size
-        std::uintmax_t currentFileSize = std::filesystem::file_size(loc, ec);
-        if (ec)
-        {
-            asyncResp->res.result(
-                boost::beast::http::status::internal_server_error);
-            asyncResp->res.jsonValue["Description"] = internalFileSystemError;
-            BMCWEB_LOG_DEBUG << "handleIbmPut: Failed to find file size. ec : "
-                             << ec;
-            return false;
-        }
+        std::uintmax_t currentFileSize = existing->size;
         // Calculate the difference in the file size.
         // If the data.length is greater than the existing file size, then
         // calculate the difference. Else consider the delta size as zero -
@@ -237,6 +198,8 @@ inline bool saveConfigFile(const std::string& data, const std::string& fileID,
         return false;
     }
     file << data;
+    file.close();
+    index.added(fileID, data.length());
     std::string origin = "/ibm/v1/Host/ConfigFiles/" + fileID;
     // Push an event
     if (fileExists)
@@ -381,19 +344,18 @@ inline void
 inline void
     handleConfigFileList(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
 {
-    std::vector<std::string> pathObjList;
-    std::filesystem::path loc(configFilePath);
-    if (std::filesystem::exists(loc) && std::filesystem::is_directory(loc))
+    ibm_utils::ConfigFileIndex& index = getConfigFileIndex();
+    if (!index.refresh())
     {
-        for (const auto& file : std::filesystem::directory_iterator(loc))
-        {
-            const std::filesystem::path& pathObj = file.path();
-            if (std::filesystem::is_regular_file(pathObj))
-            {
-                pathObjList.push_back("/ibm/v1/Host/ConfigFiles/" +
-                                      pathObj.filename().string());
-            }
-        }
+        asyncResp->res.result(
+            boost::beast::http::status::internal_server_error);
+        asyncResp->res.jsonValue["Description"] = internalFileSystemError;
+        return;
+    }
+    std::vector<std::string> pathObjList = index.names();
+    for (std::string& pathObj : pathObjList)
+    {
+        pathObj.insert(0, "/ibm/v1/Host/ConfigFiles/");
     }
     asyncResp->res.jsonValue["@odata.type"] =
         "#IBMConfigFile.v1_0_0.IBMConfigFile";
@@ -415,6 +377,7 @@ inline void
     if (std::filesystem::exists(loc) && std::filesystem::is_directory(loc))
     {
         std::filesystem::remove_all(loc, ec);
+        getConfigFileIndex().clear();
         if (ec)
         {
             asyncResp->res.result(
@@ -452,33 +415,27 @@ inline void handleFileGet(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
                           const std::string& fileID)
 {
     BMCWEB_LOG_DEBUG << "HandleGet on SaveArea files on path: " << fileID;
-    std::filesystem::path loc(
-        "/var/lib/bmcweb/ibm-management-console/configfiles/" + fileID);
-    if (!std::filesystem::exists(loc) || !std::filesystem::is_regular_file(loc))
-    {
-        BMCWEB_LOG_ERROR << loc.string() << " Not found";
-        asyncResp->res.result(boost::beast::http::status::not_found);
-        asyncResp->res.jsonValue["Description"] = resourceNotFoundMsg;
-        return;
-    }
-
-    std::ifstream readfile(loc.string());
-    if (!readfile)
-    {
-        BMCWEB_LOG_ERROR << loc.string() << " Not found";
-        asyncResp->res.result(boost::beast::http::status::not_found);
-        asyncResp->res.jsonValue["Description"] = resourceNotFoundMsg;
-        return;
-    }
+    std::string loc("/var/lib/bmcweb/ibm-management-console/configfiles/" +
+                    fileID);
+    crow::async_file::asyncReadFile(
+        crow::connections::systemBus->get_io_context().get_executor(), loc,
+        maxSaveareaFileSize,
+        [asyncResp, fileID, loc](const boost::system::error_code& ec,
+                                 std::string&& fileData) {
+        if (ec)
+        {
+            BMCWEB_LOG_ERROR << loc << " Not found";
+            asyncResp->res.result(boost::beast::http::status::not_found);
+            asyncResp->res.jsonValue["Description"] = resourceNotFoundMsg;
+            return;
+        }
 
-    std::string contentDispositionParam = "attachment; filename=\"" + fileID +
-                                          "\"";
-    asyncResp->res.addHeader(boost::beast::http::field::content_disposition,
-                             contentDispositionParam);
-    std::string fileData;
-    fileData = {std::istreambuf_iterator<char>(readfile),
-                std::istreambuf_iterator<char>()};
-    asyncResp->res.jsonValue["Data"] = fileData;
+        std::string contentDispositionParam = "attachment; filename=\"" +
+                                              fileID + "\"";
+        asyncResp->res.addHeader(boost::beast::http::field::content_disposition,
+                                 contentDispositionParam);
+        asyncResp->res.jsonValue["Data"] = std::move(fileData);
+    });
 }
 
 inline void
@@ -492,6 +449,7 @@ inline void
     {
         if (remove(filePath.c_str()) == 0)
         {
+            getConfigFileIndex().removed(fileID);
             BMCWEB_LOG_CRITICAL << "INFO:configFile removed, FilePath: "
                                 << filePath;
             asyncResp->res.jsonValue["Description"] = "File Deleted";
@@ -1200,30 +1158,23 @@ inline void requestRoutes(App& app)
         .methods(boost::beast::http::verb::get)(
             [](const crow::Request&,
                const std::shared_ptr<bmcweb::AsyncResp>& asyncResp) {
-        if (!std::filesystem::exists(rootCertPath))
-        {
-            BMCWEB_LOG_ERROR << "RootCert file does not exist";
-            asyncResp->res.result(
-                boost::beast::http::status::internal_server_error);
-            asyncResp->res.jsonValue["Description"] = internalServerError;
-            return;
-        }
-        std::ifstream inFile;
-        inFile.open(rootCertPath.c_str());
-        if (inFile.fail())
-        {
-            BMCWEB_LOG_DEBUG << "Error while opening the root certificate "
-                                "file for reading";
-            asyncResp->res.result(
-                boost::beast::http::status::internal_server_error);
-            asyncResp->res.jsonValue["Description"] = internalServerError;
-            return;
-        }
-
-        std::stringstream strStream;
-        strStream << inFile.rdbuf();
-        inFile.close();
-        asyncResp->res.jsonValue["Certificate"] = strStream.str();
+        crow::async_file::asyncReadFile(
+            crow::connections::systemBus->get_io_context().get_executor(),
+            rootCertPath.string(), maxRootCertSize,
+            [asyncResp](const boost::system::error_code& ec,
+                        std::string&& rootCert) {
+            if (ec)
+            {
+                BMCWEB_LOG_ERROR << "Error while reading the root certificate "
+                                    "file: "
+                                 << ec.message();
+                asyncResp->res.result(
+                    boost::beast::http::status::internal_server_error);
+                asyncResp->res.jsonValue["Description"] = internalServerError;
+                return;
+            }
+            asyncResp->res.jsonValue["Certificate"] = std::move(rootCert);
+        });
     });
 
     BMCWEB_ROUTE(app, "/ibm/v1/Host/Actions/SignCSR")
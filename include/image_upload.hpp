@@ -6,50 +6,54 @@
 #include <boost/uuid/uuid_io.hpp>
 #include <dbus_singleton.hpp>
 #include <dbus_utility.hpp>
+#include <software_update.hpp>
+#include <upload_body.hpp>
 
-#include <cstdio>
-#include <fstream>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <memory>
+#include <optional>
+#include <string>
 
 namespace crow
 {
 namespace image_upload
 {
 
-static std::unique_ptr<sdbusplus::bus::match_t> fwUpdateMatcher;
-
 inline void
     uploadImageHandler(const crow::Request& req,
                        const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
 {
-    // Only allow one FW update at a time
-    if (fwUpdateMatcher != nullptr)
-    {
-        asyncResp->res.addHeader("Retry-After", "30");
-        asyncResp->res.result(boost::beast::http::status::service_unavailable);
-        return;
-    }
-    // Make this const static so it survives outside this method
-    static boost::asio::steady_timer timeout(*req.ioService,
-                                             std::chrono::seconds(5));
-
-    timeout.expires_after(std::chrono::seconds(15));
+    software_update::PendingImage image;
+    image.onSoftwareAdded =
+        [asyncResp](sdbusplus::message_t& /*m*/,
+                    const sdbusplus::message::object_path& path,
+                    const dbus::utility::DBusInteracesMap& interfaces) {
+        BMCWEB_LOG_DEBUG << "Match fired";
 
-    auto timeoutHandler = [asyncResp](const boost::system::error_code& ec) {
-        fwUpdateMatcher = nullptr;
-        if (ec == boost::asio::error::operation_aborted)
+        if (std::find_if(interfaces.begin(), interfaces.end(),
+                         [](const auto& i) {
+            return i.first == "xyz.openbmc_project.Software.Version";
+        }) == interfaces.end())
         {
-            // expected, we were canceled before the timer completed.
-            return;
+            return false;
         }
-        BMCWEB_LOG_ERROR << "Timed out waiting for Version interface";
-
-        if (ec)
+        std::string leaf = path.filename();
+        if (leaf.empty())
         {
-            BMCWEB_LOG_ERROR << "Async_wait failed " << ec;
-            return;
+            leaf = path.str;
         }
 
+        asyncResp->res.jsonValue["data"] = leaf;
+        asyncResp->res.jsonValue["message"] = "200 OK";
+        asyncResp->res.jsonValue["status"] = "ok";
+        BMCWEB_LOG_DEBUG << "ending response";
+        return true;
+    };
+    image.onTimeout = [asyncResp]() {
+        BMCWEB_LOG_ERROR << "Timed out waiting for Version interface";
+
         asyncResp->res.result(boost::beast::http::status::bad_request);
         asyncResp->res.jsonValue["data"]["description"] =
             "Version already exists or failed to be extracted";
@@ -57,54 +61,42 @@ inline void
         asyncResp->res.jsonValue["status"] = "error";
     };
 
-    std::function<void(sdbusplus::message_t&)> callback =
-        [asyncResp](sdbusplus::message_t& m) {
-        BMCWEB_LOG_DEBUG << "Match fired";
-
-        sdbusplus::message::object_path path;
-        dbus::utility::DBusInteracesMap interfaces;
-        m.read(path, interfaces);
-
-        if (std::find_if(interfaces.begin(), interfaces.end(),
-                         [](const auto& i) {
-            return i.first == "xyz.openbmc_project.Software.Version";
-        }) != interfaces.end())
-        {
-            timeout.cancel();
-            std::string leaf = path.filename();
-            if (leaf.empty())
-            {
-                leaf = path.str;
-            }
-
-            asyncResp->res.jsonValue["data"] = leaf;
-            asyncResp->res.jsonValue["message"] = "200 OK";
-            asyncResp->res.jsonValue["status"] = "ok";
-            BMCWEB_LOG_DEBUG << "ending response";
-            fwUpdateMatcher = nullptr;
-        }
-    };
-    fwUpdateMatcher = std::make_unique<sdbusplus::bus::match_t>(
-        *crow::connections::systemBus,
-        "interface='org.freedesktop.DBus.ObjectManager',type='signal',"
-        "member='InterfacesAdded',path='/xyz/openbmc_project/software'",
-        callback);
+    // Other images may be in flight, but only so many
+    std::optional<uint64_t> pendingId =
+        software_update::PendingImages::getInstance().add(
+            *req.ioService, std::chrono::seconds(15), std::move(image));
+    if (!pendingId)
+    {
+        asyncResp->res.addHeader("Retry-After", "30");
+        asyncResp->res.result(boost::beast::http::status::service_unavailable);
+        return;
+    }
 
     std::string filepath(
         "/tmp/images/" +
         boost::uuids::to_string(boost::uuids::random_generator()()));
-    BMCWEB_LOG_DEBUG << "Writing file to " << filepath;
-    std::ofstream out(filepath, std::ofstream::out | std::ofstream::binary |
-                                    std::ofstream::trunc);
-    out << req.body;
-    out.close();
-    timeout.async_wait(timeoutHandler);
+    BMCWEB_LOG_DEBUG << "Moving upload to " << filepath;
+    // The body was written to disk as it arrived; see crow::UploadFile
+    if (req.upload == nullptr || !req.upload->moveTo(filepath))
+    {
+        software_update::PendingImages::getInstance().remove(*pendingId);
+        asyncResp->res.result(
+            boost::beast::http::status::internal_server_error);
+        asyncResp->res.jsonValue["data"]["description"] =
+            "Failed to store image";
+        asyncResp->res.jsonValue["message"] = "500 Internal Server Error";
+        asyncResp->res.jsonValue["status"] = "error";
+        return;
+    }
+    BMCWEB_LOG_INFO << "Received " << req.upload->size() << " byte image "
+                    << filepath << ", sha256 " << req.upload->sha256();
 }
 
 inline void requestRoutes(App& app)
 {
     BMCWEB_ROUTE(app, "/upload/image/<str>")
         .privileges({{"ConfigureComponents", "ConfigureManager"}})
+        .fileUpload()
         .methods(boost::beast::http::verb::post, boost::beast::http::verb::put)(
             [](const crow::Request& req,
                const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
@@ -112,6 +104,7 @@ inline void requestRoutes(App& app)
 
     BMCWEB_ROUTE(app, "/upload/image")
         .privileges({{"ConfigureComponents", "ConfigureManager"}})
+        .fileUpload()
         .methods(boost::beast::http::verb::post, boost::beast::http::verb::put)(
             [](const crow::Request& req,
                const std::shared_ptr<bmcweb::AsyncResp>& asyncResp) {
@@ -1,6 +1,11 @@
 #include <nlohmann/json.hpp>
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
 
 namespace json_html_util
 {
@@ -48,6 +53,61 @@ inline uint8_t decode(uint8_t& state, uint32_t& codePoint,
     return state;
 }
 
+// Bytes dumpEscaped copies as they are: printable ASCII with no meaning in
+// HTML
+constexpr std::array<bool, 256> htmlCleanBytes = []() {
+    std::array<bool, 256> clean{};
+    for (size_t c = 0x20; c < 0x7F; c++)
+    {
+        clean[c] = true;
+    }
+    for (char c : std::string_view("\"'&<>"))
+    {
+        clean[static_cast<unsigned char>(c)] = false;
+    }
+    return clean;
+}();
+
+// Whether any of the 8 bytes packed into block isn't in htmlCleanBytes
+constexpr bool blockNeedsEscaping(uint64_t block) noexcept
+{
+    constexpr uint64_t ones = 0x0101010101010101;
+    constexpr uint64_t highs = 0x8080808080808080;
+    auto hasLess = [](uint64_t x, uint64_t n) {
+        return (x - ones * n) & ~x & highs;
+    };
+    auto hasByte = [&hasLess](uint64_t x, char c) {
+        return hasLess(x ^ (ones * static_cast<unsigned char>(c)), 1);
+    };
+    // Control characters, and DEL or anything non ASCII
+    uint64_t found = hasLess(block, 0x20) | ((block + ones) & highs) |
+                     (block & highs);
+    found |= hasByte(block, '"') | hasByte(block, '\'') |
+             hasByte(block, '&') | hasByte(block, '<') | hasByte(block, '>');
+    return found != 0;
+}
+
+// Length of the run of bytes from the start of str that need no escaping,
+// checked 8 bytes at a time
+inline size_t cleanPrefixLength(std::string_view str) noexcept
+{
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= str.size(); i += sizeof(uint64_t))
+    {
+        uint64_t block = 0;
+        std::memcpy(&block, str.data() + i, sizeof(block));
+        if (blockNeedsEscaping(block))
+        {
+            break;
+        }
+    }
+    while (i < str.size() && htmlCleanBytes[static_cast<uint8_t>(str[i])])
+    {
+        i++;
+    }
+    return i;
+}
+
 inline void dumpEscaped(std::string& out, const std::string& str)
 {
     std::array<char, 512> stringBuffer{{}};
@@ -61,6 +121,26 @@ inline void dumpEscaped(std::string& out, const std::string& str)
 
     for (std::size_t i = 0; i < str.size(); ++i)
     {
+        // Between code points, copy any run of plain ASCII in one go
+        if (state == utf8Accept)
+        {
+            size_t clean =
+                cleanPrefixLength(std::string_view(str).substr(i));
+            if (clean > 0)
+            {
+                out.append(stringBuffer.data(), bytes);
+                out.append(str, i, clean);
+                bytes = 0;
+                bytesAfterLastAccept = 0;
+                undumpedChars = 0;
+                i += clean;
+                if (i == str.size())
+                {
+                    break;
+                }
+            }
+        }
+
         const uint8_t byte = static_cast<uint8_t>(str[i]);
 
         switch (decode(state, codePoint, byte))
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace json_stream
+{
+
+/**
+ * @brief Incremental serializer producing the same text as
+ * nlohmann::json::dump(2, ' ', true, error_handler_t::replace).
+ *
+ * Rather than rendering the whole document into one string, fill() appends
+ * output until the caller's buffer reaches the requested size, remembering
+ * its position in the tree between calls.  The memory needed is bounded by
+ * the chunk size plus the largest single leaf value, not by the size of the
+ * whole response.  The json being serialized must outlive the serializer and
+ * must not be modified while serialization is in progress.
+ */
+class JsonChunkSerializer
+{
+  public:
+    explicit JsonChunkSerializer(const nlohmann::json& rootIn) : root(&rootIn)
+    {}
+
+    bool done() const
+    {
+        return finished;
+    }
+
+    /**
+     * @brief Append serialized output to out until out.size() reaches
+     * chunkSize or the document is complete.
+     */
+    void fill(std::string& out, size_t chunkSize)
+    {
+        while (!finished && out.size() < chunkSize)
+        {
+            step(out);
+        }
+    }
+
+  private:
+    struct Frame
+    {
+        const nlohmann::json* container;
+        nlohmann::json::const_iterator it;
+    };
+
+    static constexpr size_t indentStep = 2;
+
+    // Whether str is printable ASCII with nothing to escape, as nearly every
+    // key and most string values are
+    static bool needsNoEscaping(std::string_view str)
+    {
+        return std::all_of(str.begin(), str.end(), [](char c) {
+            return c >= 0x20 && c < 0x7f && c != '"' && c != '\\';
+        });
+    }
+
+    static void dumpString(std::string& out, const std::string& str)
+    {
+        if (!needsNoEscaping(str))
+        {
+            out += nlohmann::json(str).dump(
+                -1, ' ', true, nlohmann::json::error_handler_t::replace);
+            return;
+        }
+        out += '"';
+        out += str;
+        out += '"';
+    }
+
+    template <typename Integer>
+    static void dumpInteger(std::string& out, Integer number)
+    {
+        std::array<char, 24> buf{};
+        auto result = std::to_chars(buf.begin(), buf.end(), number);
+        out.append(buf.begin(), result.ptr);
+    }
+
+    // Leaves are written straight into out where that's simple; each dump()
+    // allocates a string and a serializer, which adds up over the thousands
+    // of leaves of a large collection
+    static void dumpLeaf(std::string& out, const nlohmann::json& value)
+    {
+        switch (value.type())
+        {
+            case nlohmann::json::value_t::string:
+                dumpString(out, *value.get_ptr<const std::string*>());
+                return;
+            case nlohmann::json::value_t::number_integer:
+                dumpInteger(out, *value.get_ptr<const int64_t*>());
+                return;
+            case nlohmann::json::value_t::number_unsigned:
+                dumpInteger(out, *value.get_ptr<const uint64_t*>());
+                return;
+            case nlohmann::json::value_t::boolean:
+                out += *value.get_ptr<const bool*>() ? "true" : "false";
+                return;
+            case nlohmann::json::value_t::null:
+                out += "null";
+                return;
+            default:
+                out += value.dump(-1, ' ', true,
+                                  nlohmann::json::error_handler_t::replace);
+                return;
+        }
+    }
+
+    void writeIndent(std::string& out) const
+    {
+        out.append(stack.size() * indentStep, ' ');
+    }
+
+    void writeValue(std::string& out, const nlohmann::json& value)
+    {
+        if (!value.is_structured())
+        {
+            dumpLeaf(out, value);
+            return;
+        }
+        if (value.empty())
+        {
+            out += value.is_object() ? "{}" : "[]";
+            return;
+        }
+        out += value.is_object() ? "{\n" : "[\n";
+        stack.push_back({&value, value.cbegin()});
+    }
+
+    void step(std::string& out)
+    {
+        if (!started)
+        {
+            started = true;
+            writeValue(out, *root);
+            finished = stack.empty();
+            return;
+        }
+
+        Frame& frame = stack.back();
+        if (frame.it == frame.container->cend())
+        {
+            bool isObject = frame.container->is_object();
+            stack.pop_back();
+            out += '\n';
+            writeIndent(out);
+            out += isObject ? '}' : ']';
+            finished = stack.empty();
+            return;
+        }
+
+        if (frame.it != frame.container->cbegin())
+        {
+            out += ",\n";
+        }
+        writeIndent(out);
+        if (frame.container->is_object())
+        {
+            dumpString(out, frame.it.key());
+            out += ": ";
+        }
+        // Advance before descending; pushing a new frame may invalidate the
+        // reference to this one.
+        const nlohmann::json& value = *frame.it;
+        ++frame.it;
+        writeValue(out, value);
+    }
+
+    const nlohmann::json* root;
+    std::vector<Frame> stack;
+    bool started = false;
+    bool finished = false;
+};
+
+} // namespace json_stream
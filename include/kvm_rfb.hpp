@@ -0,0 +1,979 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace crow
+{
+namespace obmc_kvm
+{
+
+/**
+ * @file Just enough of the RFB (VNC) protocol to share one KVM server
+ * session between several websocket clients: where each message the server
+ * sends ends, so a viewer can start at a message boundary, and the
+ * handshake a viewer that joins late is shown.
+ *
+ * Sharing only works with RFB 3.8 and no security, as the KVM server on
+ * localhost speaks it, and with messages that can be measured.  Anything
+ * else makes the stream unshareable, and it's then passed through untouched.
+ *
+ * Updates in the zlib based encodings carry compression state from one to
+ * the next, so a viewer can't start in the middle of them.  They're measured
+ * but never shared, and while a session has viewers, the owner's
+ * SetEncodings is cut down to encodings that don't carry state.
+ */
+
+namespace rfb
+{
+
+constexpr std::string_view version38 = "RFB 003.008\n";
+constexpr uint8_t securityNone = 1;
+
+constexpr int32_t encodingRaw = 0;
+constexpr int32_t encodingCopyRect = 1;
+constexpr int32_t encodingRRE = 2;
+constexpr int32_t encodingHextile = 5;
+constexpr int32_t encodingZlib = 6;
+constexpr int32_t encodingTight = 7;
+constexpr int32_t encodingZRLE = 16;
+constexpr int32_t encodingDesktopSize = -223;
+constexpr int32_t encodingLastRect = -224;
+constexpr int32_t encodingPointerPos = -232;
+constexpr int32_t encodingCursor = -239;
+constexpr int32_t encodingXCursor = -240;
+constexpr int32_t encodingQemuExtendedKeyEvent = -258;
+constexpr int32_t encodingTightPng = -260;
+constexpr int32_t encodingDesktopName = -307;
+constexpr int32_t encodingExtendedDesktopSize = -308;
+
+// The encodings a shared stream is limited to
+constexpr std::array<int32_t, 4> shareableEncodings = {
+    encodingRaw, encodingCopyRect, encodingHextile, encodingDesktopSize};
+
+inline uint16_t readU16(std::string_view data, size_t offset)
+{
+    return static_cast<uint16_t>(
+        (static_cast<uint8_t>(data[offset]) << 8U) |
+        static_cast<uint8_t>(data[offset + 1]));
+}
+
+inline uint32_t readU32(std::string_view data, size_t offset)
+{
+    return (static_cast<uint32_t>(readU16(data, offset)) << 16U) |
+           readU16(data, offset + 2);
+}
+
+inline void writeU16(std::string& out, uint16_t value)
+{
+    out += static_cast<char>(value >> 8U);
+    out += static_cast<char>(value & 0xFFU);
+}
+
+} // namespace rfb
+
+/**
+ * @brief Follows the bytes the KVM server sends, recording the handshake and
+ * splitting what follows into whole messages.
+ */
+class RfbServerStream
+{
+  public:
+    /**
+     * @brief Takes the next bytes from the server.  Returns the messages
+     * that are now complete, in one string, or an empty string if none are.
+     * Messages that depend on earlier ones are left out.  Handshake bytes
+     * are kept in handshake() instead.
+     */
+    std::string feed(std::string_view data)
+    {
+        if (unshareable)
+        {
+            return {};
+        }
+        pending.append(data);
+        size_t complete = 0;
+        while (step())
+        {
+            if (state != State::MessageStart || inHandshake())
+            {
+                continue;
+            }
+            if (ownerOnly)
+            {
+                // Leave out the message that just ended
+                pending.erase(complete, pos - complete);
+                pos = complete;
+                ownerOnly = false;
+            }
+            complete = pos;
+        }
+        if (unshareable)
+        {
+            pending.clear();
+            return {};
+        }
+        std::string messages = pending.substr(0, complete);
+        pending.erase(0, complete);
+        pos -= complete;
+        return messages;
+    }
+
+    // Marks the stream as not shareable, for when the client side goes
+    // somewhere this can't follow
+    void giveUp()
+    {
+        unshareable = true;
+        pending.clear();
+    }
+
+    bool shareable() const
+    {
+        return !unshareable;
+    }
+
+    // Whether the handshake has finished, and viewers can join
+    bool ready() const
+    {
+        return !unshareable && !inHandshake();
+    }
+
+    /**
+     * @brief The server's side of the handshake, for a viewer that joins
+     * now: the ServerInit carries the current framebuffer size.
+     */
+    std::string handshake() const
+    {
+        std::string out = handshakeBytes;
+        if (out.size() >= serverInitOffset + 4)
+        {
+            out[serverInitOffset] = static_cast<char>(width >> 8U);
+            out[serverInitOffset + 1] = static_cast<char>(width & 0xFFU);
+            out[serverInitOffset + 2] = static_cast<char>(height >> 8U);
+            out[serverInitOffset + 3] = static_cast<char>(height & 0xFFU);
+        }
+        return out;
+    }
+
+    // A FramebufferUpdateRequest for the whole screen, which makes the
+    // server send all of it, for a viewer that has missed updates
+    std::string fullUpdateRequest() const
+    {
+        std::string out;
+        out += '\x03';
+        out += '\x00';
+        rfb::writeU16(out, 0);
+        rfb::writeU16(out, 0);
+        rfb::writeU16(out, width);
+        rfb::writeU16(out, height);
+        return out;
+    }
+
+    // Takes the 16 byte PIXEL_FORMAT of a ServerInit or SetPixelFormat
+    void setPixelFormat(std::string_view format)
+    {
+        uint8_t bitsPerPixel = static_cast<uint8_t>(format[0]);
+        if (bitsPerPixel != 8 && bitsPerPixel != 16 && bitsPerPixel != 32)
+        {
+            giveUp();
+            return;
+        }
+        bytesPerPixel = bitsPerPixel / 8U;
+
+        // Tight sends 24 bit true colour pixels in three bytes
+        bool trueColour = format[3] != 0;
+        bool eightBitsEach = rfb::readU16(format, 4) == 255 &&
+                             rfb::readU16(format, 6) == 255 &&
+                             rfb::readU16(format, 8) == 255;
+        tightPixelSize = bytesPerPixel;
+        if (bitsPerPixel == 32 && static_cast<uint8_t>(format[1]) == 24 &&
+            trueColour && eightBitsEach)
+        {
+            tightPixelSize = 3;
+        }
+    }
+
+    uint16_t frameWidth() const
+    {
+        return width;
+    }
+
+    uint16_t frameHeight() const
+    {
+        return height;
+    }
+
+  private:
+    enum class State
+    {
+        Version,
+        SecurityTypeCount,
+        SecurityTypes,
+        SecurityResult,
+        ServerInit,
+        ServerName,
+        MessageStart,
+        UpdateHeader,
+        RectHeader,
+        Tile,
+        RreHeader,
+        TightHeader,
+        LengthPrefixed,
+        ScreenCount,
+        Skip,
+    };
+
+    bool inHandshake() const
+    {
+        return !handshakeDone;
+    }
+
+    size_t available() const
+    {
+        return pending.size() - pos;
+    }
+
+    // Moves over the handshake bytes up to pos
+    void recordHandshake()
+    {
+        handshakeBytes.append(pending, 0, pos);
+        pending.erase(0, pos);
+        pos = 0;
+    }
+
+    // Parses the next field if all of it has arrived.  Returns false when it
+    // needs more data, or the stream can't be followed.
+    bool step()
+    {
+        if (unshareable)
+        {
+            return false;
+        }
+        switch (state)
+        {
+            case State::Version:
+                if (available() < rfb::version38.size())
+                {
+                    return false;
+                }
+                if (std::string_view(pending).substr(
+                        pos, rfb::version38.size()) != rfb::version38)
+                {
+                    unshareable = true;
+                    return false;
+                }
+                pos += rfb::version38.size();
+                state = State::SecurityTypeCount;
+                recordHandshake();
+                return true;
+            case State::SecurityTypeCount:
+                if (available() < 1)
+                {
+                    return false;
+                }
+                skipLeft = static_cast<uint8_t>(pending[pos]);
+                pos++;
+                if (skipLeft == 0)
+                {
+                    // Connection refused, with a reason
+                    unshareable = true;
+                    return false;
+                }
+                state = State::SecurityTypes;
+                return true;
+            case State::SecurityTypes:
+                if (available() < skipLeft)
+                {
+                    return false;
+                }
+                pos += skipLeft;
+                state = State::SecurityResult;
+                recordHandshake();
+                return true;
+            case State::SecurityResult:
+                if (available() < 4)
+                {
+                    return false;
+                }
+                if (rfb::readU32(pending, pos) != 0)
+                {
+                    unshareable = true;
+                    return false;
+                }
+                pos += 4;
+                state = State::ServerInit;
+                recordHandshake();
+                return true;
+            case State::ServerInit:
+                if (available() < 24)
+                {
+                    return false;
+                }
+                serverInitOffset = handshakeBytes.size();
+                width = rfb::readU16(pending, pos);
+                height = rfb::readU16(pending, pos + 2);
+                skipLeft = rfb::readU32(pending, pos + 20);
+                state = State::ServerName;
+                setPixelFormat(std::string_view(pending).substr(pos + 4, 16));
+                pos += 24;
+                return !unshareable;
+            case State::ServerName:
+                if (available() < skipLeft)
+                {
+                    return false;
+                }
+                pos += skipLeft;
+                recordHandshake();
+                handshakeDone = true;
+                state = State::MessageStart;
+                return true;
+            case State::MessageStart:
+                return messageStart();
+            case State::UpdateHeader:
+                if (available() < 4)
+                {
+                    return false;
+                }
+                rectsLeft = rfb::readU16(pending, pos + 2);
+                pos += 4;
+                state = State::RectHeader;
+                return true;
+            case State::RectHeader:
+                return rectHeader();
+            case State::Tile:
+                return tile();
+            case State::RreHeader:
+                if (available() < 4 + bytesPerPixel)
+                {
+                    return false;
+                }
+                // The subrectangle count and background, then the subrects
+                pos += 4 + bytesPerPixel;
+                skip(rfb::readU32(pending, pos - 4 - bytesPerPixel) *
+                         (bytesPerPixel + 8),
+                     State::RectHeader);
+                return true;
+            case State::TightHeader:
+                return tightHeader();
+            case State::LengthPrefixed:
+                if (available() < 4)
+                {
+                    return false;
+                }
+                pos += 4;
+                skip(rfb::readU32(pending, pos - 4), State::RectHeader);
+                return true;
+            case State::ScreenCount:
+                if (available() < 4)
+                {
+                    return false;
+                }
+                pos += 4;
+                skip(16U * static_cast<uint8_t>(pending[pos - 4]),
+                     State::RectHeader);
+                return true;
+            case State::Skip:
+                if (available() < skipLeft)
+                {
+                    return false;
+                }
+                pos += skipLeft;
+                state = afterSkip;
+                return true;
+        }
+        return false;
+    }
+
+    void skip(size_t length, State next)
+    {
+        skipLeft = length;
+        afterSkip = next;
+        state = State::Skip;
+    }
+
+    bool messageStart()
+    {
+        if (available() < 1)
+        {
+            return false;
+        }
+        uint8_t type = static_cast<uint8_t>(pending[pos]);
+        switch (type)
+        {
+            case 0:
+                // FramebufferUpdate
+                state = State::UpdateHeader;
+                return true;
+            case 1:
+                // SetColourMapEntries
+                if (available() < 6)
+                {
+                    return false;
+                }
+                pos += 6;
+                skip(6U * rfb::readU16(pending, pos - 2), State::MessageStart);
+                return true;
+            case 2:
+                // Bell
+                pos++;
+                return true;
+            case 3:
+                // ServerCutText
+                if (available() < 8)
+                {
+                    return false;
+                }
+                pos += 8;
+                skip(rfb::readU32(pending, pos - 4), State::MessageStart);
+                return true;
+            case 250:
+                // xvp
+                if (available() < 4)
+                {
+                    return false;
+                }
+                pos += 4;
+                return true;
+            default:
+                unshareable = true;
+                return false;
+        }
+    }
+
+    bool rectHeader()
+    {
+        if (rectsLeft == 0)
+        {
+            state = State::MessageStart;
+            return true;
+        }
+        if (available() < 12)
+        {
+            return false;
+        }
+        uint16_t rectY = rfb::readU16(pending, pos + 2);
+        rectWidth = rfb::readU16(pending, pos + 4);
+        rectHeight = rfb::readU16(pending, pos + 6);
+        int32_t encoding = static_cast<int32_t>(rfb::readU32(pending, pos + 8));
+        pos += 12;
+        rectsLeft--;
+        size_t pixels = static_cast<size_t>(rectWidth) * rectHeight;
+        size_t maskSize = (rectWidth + 7U) / 8U * rectHeight;
+        switch (encoding)
+        {
+            case rfb::encodingRaw:
+                skip(pixels * bytesPerPixel, State::RectHeader);
+                return true;
+            case rfb::encodingCopyRect:
+                skip(4, State::RectHeader);
+                return true;
+            case rfb::encodingRRE:
+                state = State::RreHeader;
+                return true;
+            case rfb::encodingHextile:
+                tileX = 0;
+                tileY = 0;
+                state = State::Tile;
+                return true;
+            case rfb::encodingZlib:
+            case rfb::encodingZRLE:
+                ownerOnly = true;
+                state = State::LengthPrefixed;
+                return true;
+            case rfb::encodingTight:
+            case rfb::encodingTightPng:
+                ownerOnly = true;
+                state = State::TightHeader;
+                return true;
+            case rfb::encodingDesktopSize:
+                width = rectWidth;
+                height = rectHeight;
+                return true;
+            case rfb::encodingExtendedDesktopSize:
+                // y is the status; anything else is a refused resize
+                if (rectY == 0)
+                {
+                    width = rectWidth;
+                    height = rectHeight;
+                }
+                state = State::ScreenCount;
+                return true;
+            case rfb::encodingDesktopName:
+                state = State::LengthPrefixed;
+                return true;
+            case rfb::encodingLastRect:
+                rectsLeft = 0;
+                return true;
+            case rfb::encodingCursor:
+                skip(pixels * bytesPerPixel + maskSize, State::RectHeader);
+                return true;
+            case rfb::encodingXCursor:
+                skip(pixels == 0 ? 0 : 6 + 2 * maskSize, State::RectHeader);
+                return true;
+            case rfb::encodingPointerPos:
+            case rfb::encodingQemuExtendedKeyEvent:
+                return true;
+            default:
+                unshareable = true;
+                return false;
+        }
+    }
+
+    // Reads the Tight compact length at offset past pos into length, and
+    // the number of bytes it takes into size.  Returns false if it hasn't all
+    // arrived.
+    bool readCompactLength(size_t offset, size_t& length, size_t& size) const
+    {
+        length = 0;
+        size = 0;
+        while (true)
+        {
+            if (available() < offset + size + 1)
+            {
+                return false;
+            }
+            uint8_t byte = static_cast<uint8_t>(pending[pos + offset + size]);
+            if (size == 2)
+            {
+                length |= static_cast<size_t>(byte) << 14U;
+                size++;
+                return true;
+            }
+            length |= static_cast<size_t>(byte & 0x7FU) << (7U * size);
+            size++;
+            if ((byte & 0x80U) == 0)
+            {
+                return true;
+            }
+        }
+    }
+
+    // The control byte, filter and length of a Tight rectangle, after which
+    // its data is skipped
+    bool tightHeader()
+    {
+        if (available() < 1)
+        {
+            return false;
+        }
+        uint8_t control = static_cast<uint8_t>(pending[pos]) >> 4U;
+        size_t header = 1;
+        size_t length = 0;
+        size_t lengthSize = 0;
+        if (control == 0x08)
+        {
+            // Fill
+            length = tightPixelSize;
+        }
+        else if (control == 0x09 || control == 0x0A)
+        {
+            // JPEG, or PNG for TightPNG
+            if (!readCompactLength(header, length, lengthSize))
+            {
+                return false;
+            }
+            header += lengthSize;
+        }
+        else if ((control & 0x08U) != 0)
+        {
+            unshareable = true;
+            return false;
+        }
+        else
+        {
+            size_t pixels = static_cast<size_t>(rectWidth) * rectHeight;
+            length = pixels * tightPixelSize;
+            if ((control & 0x04U) != 0)
+            {
+                if (available() < header + 1)
+                {
+                    return false;
+                }
+                uint8_t filter = static_cast<uint8_t>(pending[pos + header]);
+                header++;
+                if (filter == 1)
+                {
+                    // Palette
+                    if (available() < header + 1)
+                    {
+                        return false;
+                    }
+                    size_t colours =
+                        static_cast<uint8_t>(pending[pos + header]) + 1U;
+                    header += 1 + colours * tightPixelSize;
+                    length = colours == 2
+                                 ? (rectWidth + 7U) / 8U * rectHeight
+                                 : pixels;
+                }
+                else if (filter > 2)
+                {
+                    unshareable = true;
+                    return false;
+                }
+            }
+            // Less than 12 bytes are sent as they are
+            if (length >= 12)
+            {
+                if (!readCompactLength(header, length, lengthSize))
+                {
+                    return false;
+                }
+                header += lengthSize;
+            }
+        }
+        if (available() < header)
+        {
+            return false;
+        }
+        pos += header;
+        skip(length, State::RectHeader);
+        return true;
+    }
+
+    // One 16x16 tile of a Hextile rectangle, tiles going across then down
+    bool tile()
+    {
+        if (tileY >= rectHeight || rectWidth == 0)
+        {
+            state = State::RectHeader;
+            return true;
+        }
+        size_t tileWidth = std::min<size_t>(16, rectWidth - tileX);
+        size_t tileHeight = std::min<size_t>(16, rectHeight - tileY);
+        if (available() < 1)
+        {
+            return false;
+        }
+        uint8_t subencoding = static_cast<uint8_t>(pending[pos]);
+        size_t length = 1;
+        if ((subencoding & 0x01U) != 0)
+        {
+            // Raw tile
+            length += tileWidth * tileHeight * bytesPerPixel;
+        }
+        else
+        {
+            size_t subrectSize = 2;
+            if ((subencoding & 0x02U) != 0)
+            {
+                length += bytesPerPixel;
+            }
+            if ((subencoding & 0x04U) != 0)
+            {
+                length += bytesPerPixel;
+            }
+            if ((subencoding & 0x10U) != 0)
+            {
+                subrectSize += bytesPerPixel;
+            }
+            if ((subencoding & 0x08U) != 0)
+            {
+                if (available() < length + 1)
+                {
+                    return false;
+                }
+                length += 1 + subrectSize *
+                                  static_cast<uint8_t>(pending[pos + length]);
+            }
+        }
+        if (available() < length)
+        {
+            return false;
+        }
+        pos += length;
+        tileX += 16;
+        if (tileX >= rectWidth)
+        {
+            tileX = 0;
+            tileY += 16;
+        }
+        return true;
+    }
+
+    State state = State::Version;
+    State afterSkip = State::MessageStart;
+    std::string pending;
+    // How far into pending has been parsed
+    size_t pos = 0;
+    size_t skipLeft = 0;
+    std::string handshakeBytes;
+    size_t serverInitOffset = 0;
+    bool handshakeDone = false;
+    bool unshareable = false;
+    // The message being parsed depends on earlier ones, so isn't shared
+    bool ownerOnly = false;
+    uint16_t width = 0;
+    uint16_t height = 0;
+    size_t bytesPerPixel = 4;
+    size_t tightPixelSize = 4;
+    uint16_t rectsLeft = 0;
+    uint16_t rectWidth = 0;
+    uint16_t rectHeight = 0;
+    size_t tileX = 0;
+    size_t tileY = 0;
+};
+
+/**
+ * @brief Follows the bytes the owner of a shared session sends to the KVM
+ * server, telling server of the pixel format it asks for.  While the session
+ * is shared, the owner's SetEncodings is cut down to the shareable encodings.
+ */
+class RfbClientFilter
+{
+  public:
+    explicit RfbClientFilter(RfbServerStream& serverIn) : server(serverIn) {}
+
+    /**
+     * @brief Takes the next bytes from the owner, and returns what to send
+     * to the server in their place.  A partial message is held until the
+     * rest of it arrives.
+     */
+    std::string filter(std::string_view data)
+    {
+        if (lost)
+        {
+            std::string out;
+            out.swap(pending);
+            out.append(data);
+            return out;
+        }
+        pending.append(data);
+        std::string out;
+        size_t used = 0;
+        while (true)
+        {
+            std::string_view rest = std::string_view(pending).substr(used);
+            size_t length = messageLength(rest);
+            if (length == 0 || lost)
+            {
+                break;
+            }
+            forward(rest.substr(0, length), out);
+            used += length;
+        }
+        if (lost)
+        {
+            // Whatever is left goes through as it is
+            out.append(pending, used);
+            pending.clear();
+            return out;
+        }
+        pending.erase(0, used);
+        return out;
+    }
+
+    // For a FramebufferUpdateRequest sent to the server by something else,
+    // after which the pixel format can't change
+    void markUpdateRequested()
+    {
+        updateRequested = true;
+    }
+
+    /**
+     * @brief Cuts the owner's encodings down to the shareable ones while the
+     * session has viewers, and gives the owner its own back once it hasn't.
+     * Returns the SetEncodings to send the server between two of the owner's
+     * messages, or an empty string if there's none to send.
+     */
+    std::string setShared(bool sharedIn)
+    {
+        // Once the owner's messages can't be followed, nothing can be put
+        // between them
+        if (shared == sharedIn || lost)
+        {
+            return {};
+        }
+        shared = sharedIn;
+        std::string out;
+        if (ownerEncodings.empty())
+        {
+            // The server is still on its default of Raw
+            return out;
+        }
+        if (shared)
+        {
+            appendShareableEncodings(ownerEncodings, out);
+        }
+        else
+        {
+            out = ownerEncodings;
+        }
+        return out;
+    }
+
+  private:
+    enum class State
+    {
+        Version,
+        SecurityType,
+        ClientInit,
+        Messages,
+    };
+
+    // The length of the message at the start of data, or 0 if it hasn't all
+    // arrived.  Gives up on the stream for a message it doesn't know.
+    size_t messageLength(std::string_view data)
+    {
+        switch (state)
+        {
+            case State::Version:
+                return data.size() >= rfb::version38.size()
+                           ? rfb::version38.size()
+                           : 0;
+            case State::SecurityType:
+            case State::ClientInit:
+                return data.empty() ? 0 : 1;
+            case State::Messages:
+                break;
+        }
+        if (data.empty())
+        {
+            return 0;
+        }
+        size_t length = 0;
+        switch (static_cast<uint8_t>(data[0]))
+        {
+            case 0:
+                // SetPixelFormat
+                length = 20;
+                break;
+            case 2:
+                // SetEncodings
+                if (data.size() < 4)
+                {
+                    return 0;
+                }
+                length = 4 + 4U * static_cast<size_t>(rfb::readU16(data, 2));
+                break;
+            case 3:
+                // FramebufferUpdateRequest
+                length = 10;
+                break;
+            case 4:
+                // KeyEvent
+                length = 8;
+                break;
+            case 5:
+                // PointerEvent
+                length = 6;
+                break;
+            case 6:
+                // ClientCutText
+                if (data.size() < 8)
+                {
+                    return 0;
+                }
+                length = 8 + static_cast<size_t>(rfb::readU32(data, 4));
+                break;
+            default:
+                loseTrack();
+                return 0;
+        }
+        return data.size() >= length ? length : 0;
+    }
+
+    // For owner messages that can't be followed, which are then passed
+    // through as they are
+    void loseTrack()
+    {
+        lost = true;
+        server.giveUp();
+    }
+
+    void forward(std::string_view message, std::string& out)
+    {
+        switch (state)
+        {
+            case State::Version:
+                if (message != rfb::version38)
+                {
+                    loseTrack();
+                }
+                state = State::SecurityType;
+                out.append(message);
+                return;
+            case State::SecurityType:
+                if (static_cast<uint8_t>(message[0]) != rfb::securityNone)
+                {
+                    loseTrack();
+                }
+                state = State::ClientInit;
+                out.append(message);
+                return;
+            case State::ClientInit:
+                state = State::Messages;
+                out.append(message);
+                return;
+            case State::Messages:
+                break;
+        }
+        uint8_t type = static_cast<uint8_t>(message[0]);
+        if (type == 0)
+        {
+            // Updates already asked for could come in either format
+            if (updateRequested)
+            {
+                server.giveUp();
+            }
+            else
+            {
+                server.setPixelFormat(message.substr(4, 16));
+            }
+        }
+        else if (type == 2)
+        {
+            ownerEncodings = message;
+            if (shared)
+            {
+                appendShareableEncodings(message, out);
+                return;
+            }
+        }
+        else if (type == 3)
+        {
+            updateRequested = true;
+        }
+        out.append(message);
+    }
+
+    static void appendShareableEncodings(std::string_view message,
+                                         std::string& out)
+    {
+        std::string encodings;
+        uint16_t count = 0;
+        for (size_t offset = 4; offset + 4 <= message.size(); offset += 4)
+        {
+            int32_t encoding = static_cast<int32_t>(rfb::readU32(message,
+                                                                 offset));
+            for (int32_t shareable : rfb::shareableEncodings)
+            {
+                if (encoding == shareable)
+                {
+                    encodings.append(message.substr(offset, 4));
+                    count++;
+                    break;
+                }
+            }
+        }
+        out += '\x02';
+        out += '\x00';
+        rfb::writeU16(out, count);
+        out += encodings;
+    }
+
+    RfbServerStream& server;
+    State state = State::Version;
+    std::string pending;
+    // The owner's last SetEncodings, as it sent it
+    std::string ownerEncodings;
+    bool updateRequested = false;
+    bool shared = false;
+    bool lost = false;
+};
+
+} // namespace obmc_kvm
+} // namespace crow
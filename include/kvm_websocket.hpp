@@ -1,11 +1,25 @@
 #pragma once
+#include "bmcweb_config.h"
+
 #include <sys/socket.h>
 
 #include <app.hpp>
 #include <async_resp.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/beast/core/flat_static_buffer.hpp>
 #include <boost/container/flat_map.hpp>
+#include <kvm_rfb.hpp>
+#include <route_metrics.hpp>
 #include <websocket.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
 namespace crow
 {
 namespace obmc_kvm
@@ -13,147 +27,554 @@ namespace obmc_kvm
 
 static constexpr const uint maxSessions = 4;
 
-class KvmSession
+// Most bytes read from the KVM socket at once
+static constexpr std::size_t kvmReadSize = 64UL * 1024UL;
+
+// Most bytes waiting to go to a client while the previous frame is still
+// being sent.  Reading from the KVM server stops once this is reached.
+static constexpr std::size_t kvmMaxQueued = bmcwebKvmBufferSizeKb * 1024UL;
+
+struct KvmStats
+{
+    uint64_t bytesSent = 0;
+    uint64_t framesSent = 0;
+    uint64_t bytesReceived = 0;
+    // Time data spent queued behind the previous frame before being sent
+    std::chrono::microseconds queued{0};
+    std::chrono::microseconds maxQueued{0};
+    // Updates a shared view viewer fell too far behind to be sent
+    uint64_t droppedFrames = 0;
+};
+
+#ifdef BMCWEB_ENABLE_KVM_SHARED_VIEW
+/**
+ * @brief A read-only client of a shared KVM session.  It's sent the messages
+ * the KVM server sends to the session's owner, as the same immutable buffers
+ * every other viewer is sent, and what it sends is ignored.
+ */
+class KvmViewer : public std::enable_shared_from_this<KvmViewer>
 {
   public:
-    explicit KvmSession(crow::websocket::Connection& connIn) :
-        conn(connIn), hostSocket(conn.getIoContext())
+    KvmViewer(crow::websocket::Connection& connIn, uint64_t idIn) :
+        id(idIn), conn(connIn)
+    {}
+
+    bool started() const
+    {
+        return isStarted;
+    }
+
+    // Starts the viewer off with the server's side of the handshake
+    void start(std::string handshake)
+    {
+        isStarted = true;
+        push(std::make_shared<const std::string>(std::move(handshake)));
+    }
+
+    /**
+     * @brief Queues a frame for the viewer.  If that puts more than
+     * kvmMaxQueued behind the frame being sent, the queued frames are stale
+     * and dropped, and false is returned: the viewer then needs the whole
+     * screen sent again.
+     */
+    bool push(std::shared_ptr<const std::string> frame)
+    {
+        queuedBytes += frame->size();
+        frames.push_back(std::move(frame));
+        if (queuedBytes > kvmMaxQueued)
+        {
+            BMCWEB_LOG_DEBUG << "conn:" << &conn << ", Dropping "
+                             << frames.size() << " frames";
+            stats.droppedFrames += frames.size();
+            frames.clear();
+            queuedBytes = 0;
+            return false;
+        }
+        doSend();
+        return true;
+    }
+
+    uint64_t getId() const
+    {
+        return id;
+    }
+
+    const KvmStats& getStats() const
+    {
+        return stats;
+    }
+
+    crow::websocket::Connection& getConnection()
+    {
+        return conn;
+    }
+
+  private:
+    void doSend()
+    {
+        if (sending || frames.empty())
+        {
+            return;
+        }
+        sending = true;
+        sendingFrame = std::move(frames.front());
+        frames.pop_front();
+        queuedBytes -= sendingFrame->size();
+        stats.bytesSent += sendingFrame->size();
+        stats.framesSent++;
+        conn.sendEx(crow::websocket::MessageType::Binary, *sendingFrame,
+                    [self(shared_from_this())]() {
+            self->sending = false;
+            self->sendingFrame.reset();
+            self->doSend();
+        });
+    }
+
+    uint64_t id;
+    crow::websocket::Connection& conn;
+    std::deque<std::shared_ptr<const std::string>> frames;
+    size_t queuedBytes = 0;
+    std::shared_ptr<const std::string> sendingFrame;
+    bool sending{false};
+    bool isStarted{false};
+    KvmStats stats;
+};
+
+static boost::container::flat_map<crow::websocket::Connection*,
+                                  std::shared_ptr<KvmViewer>>
+    viewers;
+#endif
+
+class KvmSession : public std::enable_shared_from_this<KvmSession>
+{
+  public:
+    explicit KvmSession(crow::websocket::Connection& connIn, uint64_t idIn) :
+        id(idIn), conn(connIn), hostSocket(conn.getIoContext())
+    {}
+
+    void start()
     {
         boost::asio::ip::tcp::endpoint endpoint(
             boost::asio::ip::make_address("127.0.0.1"), 5900);
         hostSocket.async_connect(
-            endpoint, [this, &connIn](const boost::system::error_code& ec) {
+            endpoint, [weak(weak_from_this())](
+                          const boost::system::error_code& ec) {
+            std::shared_ptr<KvmSession> self = weak.lock();
+            if (self == nullptr)
+            {
+                return;
+            }
             if (ec)
             {
                 BMCWEB_LOG_ERROR
-                    << "conn:" << &conn
+                    << "conn:" << &self->conn
                     << ", Couldn't connect to KVM socket port: " << ec;
                 if (ec != boost::asio::error::operation_aborted)
                 {
-                    connIn.close("Error in connecting to KVM port");
+                    self->conn.close("Error in connecting to KVM port");
                 }
                 return;
             }
 
-            doRead();
+            self->doRead();
         });
     }
 
-    void onMessage(const std::string& data)
+    // data stays valid until whenComplete runs, which also holds off the next
+    // websocket read until the KVM server has taken all of it
+    void onMessage(std::string_view data, std::function<void()>&& whenComplete)
     {
-        if (data.length() > inputBuffer.capacity())
+        BMCWEB_LOG_DEBUG << "conn:" << &conn << ", Read " << data.size()
+                         << " bytes from websocket";
+        stats.bytesReceived += data.size();
+#ifdef BMCWEB_ENABLE_KVM_SHARED_VIEW
+        writeUpstream(clientFilter.filter(data), std::move(whenComplete));
+#else
+        boost::asio::async_write(
+            hostSocket, boost::asio::buffer(data),
+            [weak(weak_from_this()), whenComplete{std::move(whenComplete)}](
+                const boost::system::error_code& ec, std::size_t bytesWritten) {
+            std::shared_ptr<KvmSession> self = weak.lock();
+            if (self == nullptr)
+            {
+                return;
+            }
+            BMCWEB_LOG_DEBUG << "conn:" << &self->conn << ", Wrote "
+                             << bytesWritten << "bytes";
+            if (self->writeFailed(ec))
+            {
+                return;
+            }
+            whenComplete();
+        });
+#endif
+    }
+
+    uint64_t getId() const
+    {
+        return id;
+    }
+
+    const KvmStats& getStats() const
+    {
+        return stats;
+    }
+
+#ifdef BMCWEB_ENABLE_KVM_SHARED_VIEW
+    // Shares the session with viewer, once the server has finished its side
+    // of the handshake
+    void addViewer(KvmViewer& viewer)
+    {
+        if (!rfbStream.shareable())
         {
-            BMCWEB_LOG_ERROR << "conn:" << &conn
-                             << ", Buffer overrun when writing "
-                             << data.length() << " bytes";
-            conn.close("Buffer overrun");
+            viewer.getConnection().close("KVM session can't be shared");
             return;
         }
+        if (rfbStream.ready())
+        {
+            startViewer(viewer);
+        }
+    }
 
-        BMCWEB_LOG_DEBUG << "conn:" << &conn << ", Read " << data.size()
-                         << " bytes from websocket";
-        boost::asio::buffer_copy(inputBuffer.prepare(data.size()),
-                                 boost::asio::buffer(data));
-        BMCWEB_LOG_DEBUG << "conn:" << &conn << ", Committing " << data.size()
-                         << " bytes from websocket";
-        inputBuffer.commit(data.size());
+    // Gives the owner back its own encodings once the last viewer has gone
+    void lastViewerClosed()
+    {
+        writeUpstream(clientFilter.setShared(false), nullptr);
+    }
 
-        BMCWEB_LOG_DEBUG << "conn:" << &conn << ", inputbuffer size "
-                         << inputBuffer.size();
-        doWrite();
+    static void closeViewers(const std::string& reason)
+    {
+        std::vector<crow::websocket::Connection*> open;
+        open.reserve(viewers.size());
+        for (const auto& [viewerConn, viewer] : viewers)
+        {
+            open.push_back(viewerConn);
+        }
+        for (crow::websocket::Connection* viewerConn : open)
+        {
+            viewerConn->close(reason);
+        }
     }
+#endif
 
   protected:
-    void doRead()
+    bool writeFailed(const boost::system::error_code& ec)
     {
-        std::size_t bytes = outputBuffer.capacity() - outputBuffer.size();
-        BMCWEB_LOG_DEBUG << "conn:" << &conn << ", Reading " << bytes
-                         << " from kvm socket";
-        hostSocket.async_read_some(
-            outputBuffer.prepare(outputBuffer.capacity() - outputBuffer.size()),
-            [this](const boost::system::error_code& ec, std::size_t bytesRead) {
-            BMCWEB_LOG_DEBUG << "conn:" << &conn << ", read done.  Read "
-                             << bytesRead << " bytes";
-            if (ec)
+        if (ec == boost::asio::error::eof)
+        {
+            conn.close("KVM socket port closed");
+            return true;
+        }
+        if (ec)
+        {
+            BMCWEB_LOG_ERROR << "conn:" << &conn
+                             << ", Error in KVM socket write " << ec;
+            if (ec != boost::asio::error::operation_aborted)
             {
-                BMCWEB_LOG_ERROR
-                    << "conn:" << &conn
-                    << ", Couldn't read from KVM socket port: " << ec;
-                if (ec != boost::asio::error::operation_aborted)
-                {
-                    conn.close("Error in connecting to KVM port");
-                }
-                return;
+                conn.close("Error in reading to host port");
             }
+            return true;
+        }
+        return false;
+    }
 
-            outputBuffer.commit(bytesRead);
-            std::string_view payload(
-                static_cast<const char*>(outputBuffer.data().data()),
-                bytesRead);
-            BMCWEB_LOG_DEBUG << "conn:" << &conn << ", Sending payload size "
-                             << payload.size();
-            conn.sendBinary(payload);
-            outputBuffer.consume(bytesRead);
+#ifdef BMCWEB_ENABLE_KVM_SHARED_VIEW
+    // The owner's messages and the updates asked for on behalf of viewers go
+    // to the server one after the other.  whenComplete may be empty.
+    void writeUpstream(std::string data, std::function<void()>&& whenComplete)
+    {
+        if (data.empty())
+        {
+            if (whenComplete)
+            {
+                whenComplete();
+            }
+            return;
+        }
+        upstream.push_back({std::move(data), std::move(whenComplete)});
+        if (upstream.size() == 1)
+        {
+            doWriteUpstream();
+        }
+    }
 
-            doRead();
+    void doWriteUpstream()
+    {
+        if (upstream.empty())
+        {
+            return;
+        }
+        boost::asio::async_write(
+            hostSocket, boost::asio::buffer(upstream.front().data),
+            [weak(weak_from_this())](const boost::system::error_code& ec,
+                                     std::size_t bytesWritten) {
+            std::shared_ptr<KvmSession> self = weak.lock();
+            if (self == nullptr)
+            {
+                return;
+            }
+            BMCWEB_LOG_DEBUG << "conn:" << &self->conn << ", Wrote "
+                             << bytesWritten << "bytes";
+            if (self->writeFailed(ec))
+            {
+                return;
+            }
+            std::function<void()> whenComplete =
+                std::move(self->upstream.front().whenComplete);
+            self->upstream.pop_front();
+            if (whenComplete)
+            {
+                whenComplete();
+            }
+            self->doWriteUpstream();
         });
     }
 
-    void doWrite()
+    // Has the server send the whole screen, which brings a viewer that has
+    // just joined or dropped updates up to date
+    void requestFullUpdate()
+    {
+        clientFilter.markUpdateRequested();
+        writeUpstream(rfbStream.fullUpdateRequest(), nullptr);
+    }
+
+    // The owner keeps its own encodings until the first viewer starts; from
+    // then on the server only uses ones the viewers can follow
+    void startViewer(KvmViewer& viewer)
     {
-        if (doingWrite)
+        viewer.start(rfbStream.handshake());
+        writeUpstream(clientFilter.setShared(true), nullptr);
+        requestFullUpdate();
+    }
+
+    // Hands the whole messages in data to the viewers
+    void share(std::string_view data)
+    {
+        bool wasReady = rfbStream.ready();
+        std::string messages = rfbStream.feed(data);
+        if (!rfbStream.shareable())
         {
-            BMCWEB_LOG_DEBUG << "conn:" << &conn
-                             << ", Already writing.  Bailing out";
+            if (!viewers.empty())
+            {
+                BMCWEB_LOG_ERROR << "conn:" << &conn
+                                 << ", KVM stream can't be shared";
+                closeViewers("KVM session can't be shared");
+            }
             return;
         }
-        if (inputBuffer.size() == 0)
+        if (!wasReady && rfbStream.ready())
+        {
+            for (auto& [viewerConn, viewer] : viewers)
+            {
+                startViewer(*viewer);
+            }
+        }
+        if (messages.empty())
         {
-            BMCWEB_LOG_DEBUG << "conn:" << &conn
-                             << ", inputBuffer empty.  Bailing out";
             return;
         }
+        auto frame = std::make_shared<const std::string>(std::move(messages));
+        bool behind = false;
+        for (auto& [viewerConn, viewer] : viewers)
+        {
+            if (viewer->started() && !viewer->push(frame))
+            {
+                behind = true;
+            }
+        }
+        if (behind)
+        {
+            requestFullUpdate();
+        }
+    }
+#endif
 
-        doingWrite = true;
-        hostSocket.async_write_some(inputBuffer.data(),
-                                    [this](const boost::system::error_code& ec,
-                                           std::size_t bytesWritten) {
-            BMCWEB_LOG_DEBUG << "conn:" << &conn << ", Wrote " << bytesWritten
-                             << "bytes";
-            doingWrite = false;
-            inputBuffer.consume(bytesWritten);
-
-            if (ec == boost::asio::error::eof)
+    void doRead()
+    {
+        if (reading || queuedBuffer.size() >= kvmMaxQueued)
+        {
+            // Restarted once the frame being sent has gone out
+            return;
+        }
+        reading = true;
+        hostSocket.async_read_some(
+            readBuffer.prepare(kvmReadSize),
+            [weak(weak_from_this())](const boost::system::error_code& ec,
+                                     std::size_t bytesRead) {
+            std::shared_ptr<KvmSession> self = weak.lock();
+            if (self == nullptr)
             {
-                conn.close("KVM socket port closed");
                 return;
             }
+            self->reading = false;
+            BMCWEB_LOG_DEBUG << "conn:" << &self->conn
+                             << ", read done.  Read " << bytesRead << " bytes";
             if (ec)
             {
-                BMCWEB_LOG_ERROR << "conn:" << &conn
-                                 << ", Error in KVM socket write " << ec;
+                BMCWEB_LOG_ERROR
+                    << "conn:" << &self->conn
+                    << ", Couldn't read from KVM socket port: " << ec;
                 if (ec != boost::asio::error::operation_aborted)
                 {
-                    conn.close("Error in reading to host port");
+                    self->conn.close("Error in connecting to KVM port");
                 }
                 return;
             }
 
-            doWrite();
+            self->readBuffer.commit(bytesRead);
+            self->queue();
+            self->doRead();
         });
     }
 
+    // Everything read while a frame is in flight goes out as the next frame,
+    // so a slow client gets fewer, larger frames instead of a backlog
+    void queue()
+    {
+#ifdef BMCWEB_ENABLE_KVM_SHARED_VIEW
+        share(std::string_view(
+            static_cast<const char*>(readBuffer.data().data()),
+            readBuffer.size()));
+#endif
+        if (queuedBuffer.empty())
+        {
+            queuedSince = std::chrono::steady_clock::now();
+        }
+        queuedBuffer.append(static_cast<const char*>(readBuffer.data().data()),
+                            readBuffer.size());
+        readBuffer.clear();
+        if (!sending)
+        {
+            doSend();
+        }
+    }
+
+    void doSend()
+    {
+        if (queuedBuffer.empty())
+        {
+            return;
+        }
+        std::chrono::microseconds waited =
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - queuedSince);
+        stats.queued += waited;
+        stats.maxQueued = std::max(stats.maxQueued, waited);
+        stats.bytesSent += queuedBuffer.size();
+        stats.framesSent++;
+
+        sending = true;
+        sendingBuffer.swap(queuedBuffer);
+        queuedBuffer.clear();
+        BMCWEB_LOG_DEBUG << "conn:" << &conn << ", Sending payload size "
+                         << sendingBuffer.size();
+        // sendingBuffer is read by the websocket until this runs
+        conn.sendEx(crow::websocket::MessageType::Binary, sendingBuffer,
+                    [self(shared_from_this())]() {
+            self->sending = false;
+            self->sendingBuffer.clear();
+            self->doSend();
+            self->doRead();
+        });
+    }
+
+    uint64_t id;
     crow::websocket::Connection& conn;
     boost::asio::ip::tcp::socket hostSocket;
-    boost::beast::flat_static_buffer<1024UL * 50UL> outputBuffer;
-    boost::beast::flat_static_buffer<1024UL> inputBuffer;
-    bool doingWrite{false};
+    boost::beast::flat_static_buffer<kvmReadSize> readBuffer;
+    std::string queuedBuffer;
+    std::chrono::steady_clock::time_point queuedSince;
+    std::string sendingBuffer;
+    bool reading{false};
+    bool sending{false};
+    KvmStats stats;
+#ifdef BMCWEB_ENABLE_KVM_SHARED_VIEW
+    struct UpstreamWrite
+    {
+        std::string data;
+        std::function<void()> whenComplete;
+    };
+
+    std::deque<UpstreamWrite> upstream;
+    RfbServerStream rfbStream;
+    RfbClientFilter clientFilter{rfbStream};
+#endif
 };
 
 static boost::container::flat_map<crow::websocket::Connection*,
-                                  std::unique_ptr<KvmSession>>
+                                  std::shared_ptr<KvmSession>>
     sessions;
 
+// Counters for the sessions currently open, for /metrics
+inline std::string renderPrometheus()
+{
+    std::string out;
+    auto appendSamples = [&out](std::string_view name, std::string_view help,
+                                std::string_view type, auto value) {
+        out += "# HELP ";
+        out += name;
+        out += ' ';
+        out += help;
+        out += "\n# TYPE ";
+        out += name;
+        out += ' ';
+        out += type;
+        out += '\n';
+        auto appendSample = [&](uint64_t id, const KvmStats& stats) {
+            out += name;
+            out += "{session=\"";
+            out += std::to_string(id);
+            out += "\"} ";
+            out += value(stats);
+            out += '\n';
+        };
+        for (const auto& [conn, session] : sessions)
+        {
+            appendSample(session->getId(), session->getStats());
+        }
+#ifdef BMCWEB_ENABLE_KVM_SHARED_VIEW
+        for (const auto& [conn, viewer] : viewers)
+        {
+            appendSample(viewer->getId(), viewer->getStats());
+        }
+#endif
+    };
+    appendSamples("bmcweb_kvm_sent_bytes_total", "Bytes sent to KVM clients",
+                  "counter", [](const KvmStats& stats) {
+        return std::to_string(stats.bytesSent);
+    });
+    appendSamples("bmcweb_kvm_sent_frames_total",
+                  "Websocket frames sent to KVM clients", "counter",
+                  [](const KvmStats& stats) {
+        return std::to_string(stats.framesSent);
+    });
+    appendSamples("bmcweb_kvm_received_bytes_total",
+                  "Bytes received from KVM clients", "counter",
+                  [](const KvmStats& stats) {
+        return std::to_string(stats.bytesReceived);
+    });
+    appendSamples("bmcweb_kvm_queued_seconds_total",
+                  "Time video data waited behind a frame still being sent",
+                  "counter", [](const KvmStats& stats) {
+        return metrics::formatSeconds(
+            static_cast<uint64_t>(stats.queued.count()));
+    });
+    appendSamples("bmcweb_kvm_queued_seconds_max",
+                  "Longest time video data waited to be sent", "gauge",
+                  [](const KvmStats& stats) {
+        return metrics::formatSeconds(
+            static_cast<uint64_t>(stats.maxQueued.count()));
+    });
+#ifdef BMCWEB_ENABLE_KVM_SHARED_VIEW
+    appendSamples("bmcweb_kvm_viewer_dropped_frames_total",
+                  "Frames dropped for shared view viewers that fell behind",
+                  "counter", [](const KvmStats& stats) {
+        return std::to_string(stats.droppedFrames);
+    });
+#endif
+    return out;
+}
+
 inline void requestRoutes(App& app)
 {
     sessions.reserve(maxSessions);
@@ -164,23 +585,73 @@ inline void requestRoutes(App& app)
         .onopen([](crow::websocket::Connection& conn) {
         BMCWEB_LOG_DEBUG << "Connection " << &conn << " opened";
 
-        if (sessions.size() == maxSessions)
+        size_t open = sessions.size();
+#ifdef BMCWEB_ENABLE_KVM_SHARED_VIEW
+        open += viewers.size();
+#endif
+        if (open == maxSessions)
         {
             conn.close("Max sessions are already connected");
             return;
         }
 
-        sessions[&conn] = std::make_unique<KvmSession>(conn);
+        static uint64_t nextId = 0;
+#ifdef BMCWEB_ENABLE_KVM_SHARED_VIEW
+        // The first client owns the session; the rest watch it
+        if (!sessions.empty())
+        {
+            std::shared_ptr<KvmViewer>& viewer = viewers[&conn];
+            viewer = std::make_shared<KvmViewer>(conn, nextId++);
+            sessions.begin()->second->addViewer(*viewer);
+            return;
+        }
+#endif
+        std::shared_ptr<KvmSession>& session = sessions[&conn];
+        session = std::make_shared<KvmSession>(conn, nextId++);
+        session->start();
     })
         .onclose([](crow::websocket::Connection& conn, const std::string&) {
-        sessions.erase(&conn);
+#ifdef BMCWEB_ENABLE_KVM_SHARED_VIEW
+        auto viewer = viewers.find(&conn);
+        if (viewer != viewers.end())
+        {
+            BMCWEB_LOG_INFO << "KVM viewer " << viewer->second->getId()
+                            << " closed after dropping "
+                            << viewer->second->getStats().droppedFrames
+                            << " frames";
+            viewers.erase(viewer);
+            if (viewers.empty() && !sessions.empty())
+            {
+                sessions.begin()->second->lastViewerClosed();
+            }
+            return;
+        }
+#endif
+        auto it = sessions.find(&conn);
+        if (it == sessions.end())
+        {
+            return;
+        }
+        const KvmStats& stats = it->second->getStats();
+        BMCWEB_LOG_INFO << "KVM session " << it->second->getId()
+                        << " closed after sending " << stats.bytesSent
+                        << " bytes in " << stats.framesSent << " frames";
+        sessions.erase(it);
+#ifdef BMCWEB_ENABLE_KVM_SHARED_VIEW
+        KvmSession::closeViewers("KVM session owner disconnected");
+#endif
     })
-        .onmessage([](crow::websocket::Connection& conn,
-                      const std::string& data, bool) {
-        if (sessions[&conn])
+        .onmessageex([](crow::websocket::Connection& conn,
+                        std::string_view data, crow::websocket::MessageType,
+                        std::function<void()>&& whenComplete) {
+        auto it = sessions.find(&conn);
+        if (it == sessions.end())
         {
-            sessions[&conn]->onMessage(data);
+            // Including what shared view viewers send; they're read-only
+            whenComplete();
+            return;
         }
+        it->second->onMessage(data, std::move(whenComplete));
     });
 }
 
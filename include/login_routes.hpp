@@ -21,6 +21,65 @@ namespace crow
 namespace login_routes
 {
 
+inline void
+    afterLoginAuthenticate(const crow::Request& req,
+                           const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+                           const std::string& username,
+                           bool looksLikePhosphorRest, int pamrc)
+{
+    bool isConfigureSelfOnly = pamrc == PAM_NEW_AUTHTOK_REQD;
+    if ((pamrc != PAM_SUCCESS) && !isConfigureSelfOnly)
+    {
+        asyncResp->res.result(boost::beast::http::status::unauthorized);
+#ifdef BMCWEB_ENABLE_LINUX_AUDIT_EVENTS
+        audit::auditEvent(req, username, false);
+#endif
+        return;
+    }
+
+    auto session =
+        persistent_data::SessionStore::getInstance().generateUserSession(
+            username, req.ipAddress, std::nullopt,
+            persistent_data::PersistenceType::TIMEOUT, isConfigureSelfOnly);
+
+    if (looksLikePhosphorRest)
+    {
+        // Phosphor-Rest requires a very specific login
+        // structure, and doesn't actually look at the status
+        // code.
+        // TODO(ed).... Fix that upstream
+
+        asyncResp->res.jsonValue["data"] = "User '" + username + "' logged in";
+        asyncResp->res.jsonValue["message"] = "200 OK";
+        asyncResp->res.jsonValue["status"] = "ok";
+
+        // Hack alert.  Boost beast by default doesn't let you
+        // declare multiple headers of the same name, and in
+        // most cases this is fine.  Unfortunately here we need
+        // to set the Session cookie, which requires the
+        // httpOnly attribute, as well as the XSRF cookie, which
+        // requires it to not have an httpOnly attribute. To get
+        // the behavior we want, we simply inject the second
+        // "set-cookie" string into the value header, and get
+        // the result we want, even though we are technicaly
+        // declaring two headers here.
+        asyncResp->res.addHeader(
+            "Set-Cookie",
+            "XSRF-TOKEN=" + session->csrfToken +
+                "; SameSite=Strict; Secure\r\nSet-Cookie: "
+                "SESSION=" +
+                session->sessionToken + "; SameSite=Strict; Secure; HttpOnly");
+    }
+    else
+    {
+        // if content type is json, assume json token
+        asyncResp->res.jsonValue["token"] = session->sessionToken;
+    }
+#ifdef BMCWEB_ENABLE_LINUX_AUDIT_EVENTS
+    audit::auditEvent(req, username, true);
+#endif
+}
+
 inline void requestRoutes(App& app)
 {
     BMCWEB_ROUTE(app, "/login")
@@ -171,63 +230,14 @@ inline void requestRoutes(App& app)
 
         if (!username.empty() && !password.empty())
         {
-            int pamrc = pamAuthenticateUser(username, password);
-            bool isConfigureSelfOnly = pamrc == PAM_NEW_AUTHTOK_REQD;
-            if ((pamrc != PAM_SUCCESS) && !isConfigureSelfOnly)
-            {
-                asyncResp->res.result(boost::beast::http::status::unauthorized);
-#ifdef BMCWEB_ENABLE_LINUX_AUDIT_EVENTS
-                audit::auditEvent(req, std::string(username), false);
-#endif
-            }
-            else
-            {
-                auto session =
-                    persistent_data::SessionStore::getInstance()
-                        .generateUserSession(
-                            username, req.ipAddress, std::nullopt,
-                            persistent_data::PersistenceType::TIMEOUT,
-                            isConfigureSelfOnly);
-
-                if (looksLikePhosphorRest)
-                {
-                    // Phosphor-Rest requires a very specific login
-                    // structure, and doesn't actually look at the status
-                    // code.
-                    // TODO(ed).... Fix that upstream
-
-                    asyncResp->res.jsonValue["data"] =
-                        "User '" + std::string(username) + "' logged in";
-                    asyncResp->res.jsonValue["message"] = "200 OK";
-                    asyncResp->res.jsonValue["status"] = "ok";
-
-                    // Hack alert.  Boost beast by default doesn't let you
-                    // declare multiple headers of the same name, and in
-                    // most cases this is fine.  Unfortunately here we need
-                    // to set the Session cookie, which requires the
-                    // httpOnly attribute, as well as the XSRF cookie, which
-                    // requires it to not have an httpOnly attribute. To get
-                    // the behavior we want, we simply inject the second
-                    // "set-cookie" string into the value header, and get
-                    // the result we want, even though we are technicaly
-                    // declaring two headers here.
-                    asyncResp->res.addHeader(
-                        "Set-Cookie",
-                        "XSRF-TOKEN=" + session->csrfToken +
-                            "; SameSite=Strict; Secure\r\nSet-Cookie: "
-                            "SESSION=" +
-                            session->sessionToken +
-                            "; SameSite=Strict; Secure; HttpOnly");
-                }
-                else
-                {
-                    // if content type is json, assume json token
-                    asyncResp->res.jsonValue["token"] = session->sessionToken;
-                }
-#ifdef BMCWEB_ENABLE_LINUX_AUDIT_EVENTS
-                audit::auditEvent(req, std::string(username), true);
-#endif
-            }
+            pamAuthenticateUserAsync(
+                req.ioService->get_executor(), std::string(username),
+                std::string(password),
+                [req, asyncResp, username{std::string(username)},
+                 looksLikePhosphorRest](int pamrc) {
+                afterLoginAuthenticate(req, asyncResp, username,
+                                       looksLikePhosphorRest, pamrc);
+            });
         }
         else
         {
@@ -0,0 +1,48 @@
+#pragma once
+#include <app.hpp>
+#include <async_resp.hpp>
+#include <dbus_trace.hpp>
+#include <dump_offload.hpp>
+#include <memory_trim.hpp>
+#include <route_metrics.hpp>
+#ifdef BMCWEB_ENABLE_KVM
+#include <kvm_websocket.hpp>
+#endif
+#ifdef BMCWEB_ENABLE_VM_NBDPROXY
+#include <nbd_proxy.hpp>
+#endif
+
+#include <memory>
+#include <vector>
+
+namespace crow
+{
+namespace metrics
+{
+
+inline void requestRoutes(App& app)
+{
+    BMCWEB_ROUTE(app, "/metrics")
+        .privileges({{"Login"}})
+        .methods(boost::beast::http::verb::get)(
+            [&app](const crow::Request&,
+                   const std::shared_ptr<bmcweb::AsyncResp>& asyncResp) {
+        std::vector<RouteSeries> routes = app.getRouteMetrics();
+        asyncResp->res.addHeader(boost::beast::http::field::content_type,
+                                 "text/plain; version=0.0.4");
+        asyncResp->res.body() = renderPrometheus(routes) +
+                                dbus_trace::renderPrometheus(
+                                    dbus_trace::getCallTotals());
+        asyncResp->res.body() += obmc_dump::renderPrometheus();
+        asyncResp->res.body() += memory::renderPrometheus();
+#ifdef BMCWEB_ENABLE_KVM
+        asyncResp->res.body() += obmc_kvm::renderPrometheus();
+#endif
+#ifdef BMCWEB_ENABLE_VM_NBDPROXY
+        asyncResp->res.body() += nbd_proxy::renderPrometheus();
+#endif
+    });
+}
+
+} // namespace metrics
+} // namespace crow
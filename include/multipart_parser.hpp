@@ -3,8 +3,12 @@
 #include <boost/beast/http/fields.hpp>
 #include <http_request.hpp>
 
+#include <array>
+#include <functional>
+#include <limits>
 #include <string>
 #include <string_view>
+#include <vector>
 
 enum class ParserError
 {
@@ -19,7 +23,9 @@ enum class ParserError
     ERROR_HEADER_ENDING,
     ERROR_UNEXPECTED_END_OF_HEADER,
     ERROR_UNEXPECTED_END_OF_INPUT,
-    ERROR_OUT_OF_RANGE
+    ERROR_OUT_OF_RANGE,
+    ERROR_PART_TOO_LARGE,
+    ERROR_PART_WRITE
 };
 
 enum class State
@@ -48,6 +54,10 @@ struct FormPart
 {
     boost::beast::http::fields fields;
     std::string content;
+    // If set, by MultipartParser::onPartHeaders, the part's content is passed
+    // here as it is parsed instead of collected in content.  Returning false
+    // stops the parse with ERROR_PART_WRITE.
+    std::function<bool(std::string_view)> sink;
 };
 
 class MultipartParser
@@ -55,10 +65,26 @@ class MultipartParser
   public:
     MultipartParser() = default;
 
+    // Parses a whole buffered request body
     [[nodiscard]] ParserError parse(const crow::Request& req)
     {
-        std::string_view contentType = req.getHeaderValue("content-type");
+        ParserError ec = start(req.getHeaderValue("content-type"));
+        if (ec != ParserError::PARSER_SUCCESS)
+        {
+            return ec;
+        }
+        ec = feed(req.body);
+        if (ec != ParserError::PARSER_SUCCESS)
+        {
+            return ec;
+        }
+        return finish();
+    }
 
+    // The incremental interface: start() with the request's Content-Type,
+    // feed() the body in pieces of any size as they arrive, then finish()
+    [[nodiscard]] ParserError start(std::string_view contentType)
+    {
         const std::string boundaryFormat = "multipart/form-data; boundary=";
         if (!contentType.starts_with(boundaryFormat))
         {
@@ -72,9 +98,51 @@ class MultipartParser
         indexBoundary();
         lookbehind.resize(boundary.size() + 8);
         state = State::START;
+        error = ParserError::PARSER_SUCCESS;
+        return error;
+    }
+
+    [[nodiscard]] ParserError feed(std::string_view chunk)
+    {
+        if (error == ParserError::PARSER_SUCCESS)
+        {
+            error = parseChunk(chunk.data(), chunk.size());
+        }
+        return error;
+    }
 
-        const char* buffer = req.body.data();
-        size_t len = req.body.size();
+    [[nodiscard]] ParserError finish() const
+    {
+        if (error != ParserError::PARSER_SUCCESS)
+        {
+            return error;
+        }
+        if (state != State::END)
+        {
+            return ParserError::ERROR_UNEXPECTED_END_OF_INPUT;
+        }
+        return ParserError::PARSER_SUCCESS;
+    }
+
+    // Called once each part's headers have been parsed, before any of its
+    // content, so the caller can route that content elsewhere with
+    // FormPart::sink
+    std::function<void(FormPart&)> onPartHeaders;
+
+    // Most bytes of content a part without a sink may hold
+    std::size_t maxBufferedPartSize = std::numeric_limits<std::size_t>::max();
+
+    std::vector<FormPart> mime_fields;
+    std::string boundary;
+
+  private:
+    ParserError parseChunk(const char* buffer, size_t len)
+    {
+        // Marks from the previous chunk now point at the start of this one;
+        // whatever they covered has already been saved below
+        headerFieldMark = 0;
+        headerValueMark = 0;
+        partDataMark = 0;
         char cl = 0;
 
         for (size_t i = 0; i < len; i++)
@@ -158,6 +226,7 @@ class MultipartParser
                     {
                         break;
                     }
+                    currentHeaderValue.resize(0);
                     headerValueMark = i;
                     state = State::HEADER_VALUE;
                     [[fallthrough]];
@@ -165,10 +234,10 @@ class MultipartParser
                     if (c == cr)
                     {
                         // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-                        std::string_view value(buffer + headerValueMark,
-                                               i - headerValueMark);
+                        currentHeaderValue.append(buffer + headerValueMark,
+                                                  i - headerValueMark);
                         mime_fields.rbegin()->fields.set(currentHeaderName,
-                                                         value);
+                                                         currentHeaderValue);
                         state = State::HEADER_VALUE_ALMOST_DONE;
                     }
                     break;
@@ -189,6 +258,10 @@ class MultipartParser
                         return ParserError::ERROR_UNEXPECTED_END_OF_HEADER;
                     }
                     state = State::PART_DATA_START;
+                    if (onPartHeaders)
+                    {
+                        onPartHeaders(*mime_fields.rbegin());
+                    }
                     break;
                 case State::PART_DATA_START:
                     state = State::PART_DATA;
@@ -215,17 +288,58 @@ class MultipartParser
             }
         }
 
-        if (state != State::END)
+        // Save what the marks cover before the buffer goes away
+        switch (state)
         {
-            return ParserError::ERROR_UNEXPECTED_END_OF_INPUT;
+            case State::HEADER_FIELD:
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                currentHeaderName.append(buffer + headerFieldMark,
+                                         len - headerFieldMark);
+                break;
+            case State::HEADER_VALUE:
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                currentHeaderValue.append(buffer + headerValueMark,
+                                          len - headerValueMark);
+                break;
+            case State::PART_DATA:
+                // Anything that might be the start of a boundary is in
+                // lookbehind instead
+                if (index == 0)
+                {
+                    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    return appendPartData({buffer + partDataMark,
+                                           len - partDataMark});
+                }
+                break;
+            default:
+                break;
         }
+        return ParserError::PARSER_SUCCESS;
+    }
 
+    ParserError appendPartData(std::string_view data)
+    {
+        if (data.empty())
+        {
+            return ParserError::PARSER_SUCCESS;
+        }
+        FormPart& part = *mime_fields.rbegin();
+        if (part.sink)
+        {
+            if (!part.sink(data))
+            {
+                return ParserError::ERROR_PART_WRITE;
+            }
+            return ParserError::PARSER_SUCCESS;
+        }
+        if (part.content.size() + data.size() > maxBufferedPartSize)
+        {
+            return ParserError::ERROR_PART_TOO_LARGE;
+        }
+        part.content += data;
         return ParserError::PARSER_SUCCESS;
     }
-    std::vector<FormPart> mime_fields;
-    std::string boundary;
 
-  private:
     void indexBoundary()
     {
         std::fill(boundaryIndex.begin(), boundaryIndex.end(), 0);
@@ -273,8 +387,11 @@ class MultipartParser
                     // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
                     const char* start = buffer + partDataMark;
                     size_t size = i - partDataMark;
-                    mime_fields.rbegin()->content += std::string_view(start,
-                                                                      size);
+                    ParserError ec = appendPartData({start, size});
+                    if (ec != ParserError::PARSER_SUCCESS)
+                    {
+                        return ec;
+                    }
                 }
                 index++;
             }
@@ -343,7 +460,12 @@ class MultipartParser
             // if our boundary turned out to be rubbish, the captured
             // lookbehind belongs to partData
 
-            mime_fields.rbegin()->content += lookbehind.substr(0, prevIndex);
+            ParserError ec = appendPartData(
+                std::string_view(lookbehind).substr(0, prevIndex));
+            if (ec != ParserError::PARSER_SUCCESS)
+            {
+                return ec;
+            }
             partDataMark = i;
 
             // reconsider the current character even so it interrupted
@@ -365,6 +487,7 @@ class MultipartParser
     std::array<bool, 256> boundaryIndex{};
     std::string lookbehind;
     State state{State::START};
+    ParserError error{ParserError::PARSER_SUCCESS};
     Boundary flags{Boundary::NON_BOUNDARY};
     size_t index = 0;
     size_t partDataMark = 0;
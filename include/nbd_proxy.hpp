@@ -15,16 +15,24 @@
 */
 #pragma once
 #include "app.hpp"
+#include "bmcweb_config.h"
 #include "dbus_utility.hpp"
 #include "privileges.hpp"
+#include "route_metrics.hpp"
 
 #include <boost/asio/local/stream_protocol.hpp>
 #include <boost/asio/write.hpp>
-#include <boost/beast/core/buffers_to_string.hpp>
+#include <boost/beast/core/flat_static_buffer.hpp>
 #include <boost/container/flat_map.hpp>
 #include <websocket.hpp>
 
+#include <array>
+#include <functional>
+#include <memory>
+#include <string>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 namespace crow
 {
@@ -34,16 +42,85 @@ namespace nbd_proxy
 
 using boost::asio::local::stream_protocol;
 
-static constexpr size_t nbdBufferSize = 131088;
+// Payload plus room for an NBD reply header
+static constexpr size_t nbdBufferSize =
+    bmcwebNbdProxyBufferSizeKb * 1024 + 16;
 constexpr const char* requiredPrivilegeString = "ConfigureManager";
 
+// Where the virtual media service serves one slot's NBD device
+struct SlotConfig
+{
+    std::string socket;
+    std::string objectPath;
+};
+
+// Bytes moved through a slot over all its mounts
+struct SlotStats
+{
+    uint64_t bytesToHost = 0;
+    uint64_t bytesFromHost = 0;
+    uint64_t mounts = 0;
+};
+
+/**
+ * @brief The mount points of the virtual media service, by EndpointId (the
+ * /nbd/<n> path a client opens).  Returns an empty map if a MountPoint has
+ * a property of the wrong type.
+ */
+inline boost::container::flat_map<std::string, SlotConfig>
+    parseMountPoints(const dbus::utility::ManagedObjectType& objects)
+{
+    boost::container::flat_map<std::string, SlotConfig> configs;
+    for (const auto& [objectPath, interfaces] : objects)
+    {
+        for (const auto& [interface, properties] : interfaces)
+        {
+            if (interface != "xyz.openbmc_project.VirtualMedia.MountPoint")
+            {
+                continue;
+            }
+            const std::string* endpointValue = nullptr;
+            const std::string* socketValue = nullptr;
+            for (const auto& [name, value] : properties)
+            {
+                if (name == "EndpointId")
+                {
+                    endpointValue = std::get_if<std::string>(&value);
+                    if (endpointValue == nullptr)
+                    {
+                        BMCWEB_LOG_ERROR << "EndpointId property value is null";
+                        return {};
+                    }
+                }
+                if (name == "Socket")
+                {
+                    socketValue = std::get_if<std::string>(&value);
+                    if (socketValue == nullptr)
+                    {
+                        BMCWEB_LOG_ERROR << "Socket property value is null";
+                        return {};
+                    }
+                }
+            }
+            if (endpointValue != nullptr && socketValue != nullptr)
+            {
+                configs.insert_or_assign(*endpointValue,
+                                         SlotConfig{*socketValue,
+                                                    objectPath.str});
+            }
+        }
+    }
+    return configs;
+}
+
 struct NbdProxyServer : std::enable_shared_from_this<NbdProxyServer>
 {
     NbdProxyServer(crow::websocket::Connection& connIn,
                    const std::string& socketIdIn,
-                   const std::string& endpointIdIn, const std::string& pathIn) :
+                   const std::string& endpointIdIn, const std::string& pathIn,
+                   std::shared_ptr<SlotStats> statsIn) :
         socketId(socketIdIn),
-        endpointId(endpointIdIn), path(pathIn),
+        endpointId(endpointIdIn), path(pathIn), stats(std::move(statsIn)),
 
         peerSocket(connIn.getIoContext()),
         acceptor(connIn.getIoContext(), stream_protocol::endpoint(socketId)),
@@ -123,21 +200,43 @@ struct NbdProxyServer : std::enable_shared_from_this<NbdProxyServer>
             "xyz.openbmc_project.VirtualMedia.Proxy", "Mount");
     }
 
-    void send(std::string_view buffer, std::function<void()>&& onDone)
+    // data stays valid until onDone runs, which also holds off the next
+    // websocket read until the UNIX socket has taken all of it
+    void send(std::string_view data, std::function<void()>&& onDone)
     {
-        boost::asio::buffer_copy(ws2uxBuf.prepare(buffer.size()),
-                                 boost::asio::buffer(buffer));
-        ws2uxBuf.commit(buffer.size());
+        stats->bytesToHost += data.size();
+        boost::asio::async_write(
+            peerSocket, boost::asio::buffer(data),
+            [weak(weak_from_this()),
+             onDone(std::move(onDone))](const boost::system::error_code& ec,
+                                        size_t /*bytesWritten*/) {
+            std::shared_ptr<NbdProxyServer> self = weak.lock();
+            if (self == nullptr)
+            {
+                return;
+            }
 
-        doWrite(std::move(onDone));
+            if (ec)
+            {
+                BMCWEB_LOG_ERROR << "UNIX: async_write error = "
+                                 << ec.message();
+                self->connection.close("Internal error");
+                return;
+            }
+            onDone();
+        });
     }
 
   private:
+    // UNIX => WebSocket is double buffered: one buffer is filled from the
+    // socket while the other is being sent, and neither is copied.  Reading
+    // stops when both are full, which pushes back on the NBD server.
     void doRead()
     {
-        // Trigger async read
+        boost::beast::flat_static_buffer<nbdBufferSize>& buf =
+            ux2wsBufs[readIndex];
         peerSocket.async_read_some(
-            ux2wsBuf.prepare(nbdBufferSize),
+            buf.prepare(nbdBufferSize),
             [weak(weak_from_this())](const boost::system::error_code& ec,
                                      size_t bytesRead) {
             if (ec)
@@ -152,81 +251,53 @@ struct NbdProxyServer : std::enable_shared_from_this<NbdProxyServer>
                 return;
             }
 
-            // Send to websocket
-            self->ux2wsBuf.commit(bytesRead);
-            self->connection.sendEx(
-                crow::websocket::MessageType::Binary,
-                boost::beast::buffers_to_string(self->ux2wsBuf.data()),
-                [weak(self->weak_from_this())]() {
-                std::shared_ptr<NbdProxyServer> self2 = weak.lock();
-                if (self2 != nullptr)
-                {
-                    self2->ux2wsBuf.consume(self2->ux2wsBuf.size());
-                    self2->doRead();
-                }
-            });
+            self->ux2wsBufs[self->readIndex].commit(bytesRead);
+            // Otherwise picked up once the current send completes
+            if (!self->wsWriteInProgress)
+            {
+                self->doSend();
+            }
         });
     }
 
-    void doWrite(std::function<void()>&& onDone)
+    void doSend()
     {
-        if (uxWriteInProgress)
-        {
-            BMCWEB_LOG_ERROR << "Write in progress";
-            return;
-        }
-
-        if (ws2uxBuf.size() == 0)
-        {
-            BMCWEB_LOG_ERROR << "No data to write to UNIX socket";
-            return;
-        }
-
-        uxWriteInProgress = true;
-        peerSocket.async_write_some(
-            ws2uxBuf.data(),
-            [weak(weak_from_this()),
-             onDone(std::move(onDone))](const boost::system::error_code& ec,
-                                        size_t bytesWritten) mutable {
-            std::shared_ptr<NbdProxyServer> self = weak.lock();
-            if (self == nullptr)
-            {
-                return;
-            }
-
-            self->ws2uxBuf.consume(bytesWritten);
-            self->uxWriteInProgress = false;
-
-            if (ec)
-            {
-                BMCWEB_LOG_ERROR << "UNIX: async_write error = "
-                                 << ec.message();
-                self->connection.close("Internal error");
-                return;
-            }
-
-            // Retrigger doWrite if there is something in buffer
-            if (self->ws2uxBuf.size() > 0)
+        size_t sendIndex = readIndex;
+        readIndex ^= 1U;
+        wsWriteInProgress = true;
+
+        const boost::beast::flat_static_buffer<nbdBufferSize>& buf =
+            ux2wsBufs[sendIndex];
+        std::string_view data(static_cast<const char*>(buf.data().data()),
+                              buf.size());
+        stats->bytesFromHost += data.size();
+        // Holds a strong reference, as the websocket reads from buf until
+        // this runs
+        connection.sendEx(crow::websocket::MessageType::Binary, data,
+                          [self(shared_from_this()), sendIndex]() {
+            self->ux2wsBufs[sendIndex].clear();
+            self->wsWriteInProgress = false;
+            if (self->ux2wsBufs[self->readIndex].size() > 0)
             {
-                self->doWrite(std::move(onDone));
-                return;
+                self->doSend();
             }
-            onDone();
         });
+
+        doRead();
     }
 
     // Keeps UNIX socket endpoint file path
     const std::string socketId;
     const std::string endpointId;
     const std::string path;
+    // Shared with the slot, so the counts outlive this mount
+    std::shared_ptr<SlotStats> stats;
 
-    bool uxWriteInProgress = false;
-
-    // UNIX => WebSocket buffer
-    boost::beast::flat_static_buffer<nbdBufferSize> ux2wsBuf;
+    bool wsWriteInProgress = false;
 
-    // WebSocket => UNIX buffer
-    boost::beast::flat_static_buffer<nbdBufferSize> ws2uxBuf;
+    // UNIX => WebSocket buffers, and the one being read into
+    std::array<boost::beast::flat_static_buffer<nbdBufferSize>, 2> ux2wsBufs;
+    size_t readIndex = 0;
 
     // The socket used to communicate with the client.
     stream_protocol::socket peerSocket;
@@ -242,105 +313,125 @@ using SessionMap = boost::container::flat_map<crow::websocket::Connection*,
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 static SessionMap sessions;
 
-inline void
-    afterGetManagedObjects(crow::websocket::Connection& conn,
-                           const boost::system::error_code& ec,
-                           const dbus::utility::ManagedObjectType& objects)
+/**
+ * @brief One virtual media slot.  Each slot has its own proxy, so several
+ * can be mounted at once; a slot takes one client at a time.
+ */
+struct Slot
 {
-    const std::string* socketValue = nullptr;
-    const std::string* endpointValue = nullptr;
-    const std::string* endpointObjectPath = nullptr;
+    SlotConfig config;
+    // The client using the slot, if any
+    crow::websocket::Connection* conn = nullptr;
+    std::shared_ptr<SlotStats> stats = std::make_shared<SlotStats>();
+};
+
+// The slots, by EndpointId.  Slots stay once seen, to keep their counts.
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+static boost::container::flat_map<std::string, Slot> slots;
 
-    if (ec)
+// Run once the mount points being read are in slots; true on success
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+static std::vector<std::function<void(bool)>> slotsWaiting;
+
+/**
+ * @brief Reads the mount points of the virtual media service into slots,
+ * then calls then.  Calls made while a read is running wait for it instead
+ * of starting another.
+ */
+inline void loadSlots(std::function<void(bool)>&& then)
+{
+    slotsWaiting.emplace_back(std::move(then));
+    if (slotsWaiting.size() > 1)
     {
-        BMCWEB_LOG_ERROR << "DBus error: " << ec.message();
-        conn.close("Failed to create mount point");
         return;
     }
-
-    for (const auto& [objectPath, interfaces] : objects)
-    {
-        for (const auto& [interface, properties] : interfaces)
+    crow::connections::systemBus->async_method_call(
+        [](const boost::system::error_code& ec,
+           const dbus::utility::ManagedObjectType& objects) {
+        bool loaded = !ec;
+        if (ec)
         {
-            if (interface != "xyz.openbmc_project.VirtualMedia.MountPoint")
+            BMCWEB_LOG_ERROR << "DBus error: " << ec.message();
+        }
+        else
+        {
+            for (auto& [endpointId, config] : parseMountPoints(objects))
             {
-                continue;
-            }
-
-            for (const auto& [name, value] : properties)
-            {
-                if (name == "EndpointId")
-                {
-                    endpointValue = std::get_if<std::string>(&value);
-
-                    if (endpointValue == nullptr)
-                    {
-                        BMCWEB_LOG_ERROR << "EndpointId property value is null";
-                    }
-                }
-                if (name == "Socket")
-                {
-                    socketValue = std::get_if<std::string>(&value);
-                    if (socketValue == nullptr)
-                    {
-                        BMCWEB_LOG_ERROR << "Socket property value is null";
-                    }
-                }
+                slots[endpointId].config = std::move(config);
             }
         }
-
-        if ((endpointValue != nullptr) && (socketValue != nullptr) &&
-            *endpointValue == conn.req.target())
+        std::vector<std::function<void(bool)>> waiting;
+        waiting.swap(slotsWaiting);
+        for (std::function<void(bool)>& callback : waiting)
         {
-            endpointObjectPath = &objectPath.str;
-            break;
+            callback(loaded);
         }
-    }
+    },
+        "xyz.openbmc_project.VirtualMedia", "/xyz/openbmc_project/VirtualMedia",
+        "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
+}
 
-    if (objects.empty() || endpointObjectPath == nullptr)
+// Starts a proxy for conn on the slot of its EndpointId, if that slot is
+// known and free
+inline bool startSession(crow::websocket::Connection& conn)
+{
+    auto slot = slots.find(conn.req.target());
+    if (slot == slots.end() || slot->second.config.socket.empty())
     {
-        BMCWEB_LOG_ERROR << "Cannot find requested EndpointId";
-        conn.close("Failed to match EndpointId");
-        return;
+        return false;
     }
-
-    for (const auto& session : sessions)
+    if (slot->second.conn != nullptr)
     {
-        if (session.second->getEndpointId() == conn.req.target())
-        {
-            BMCWEB_LOG_ERROR << "Cannot open new connection - socket is in use";
-            conn.close("Slot is in use");
-            return;
-        }
+        BMCWEB_LOG_ERROR << "Cannot open new connection - socket is in use";
+        conn.close("Slot is in use");
+        return true;
     }
 
     // If the socket file exists (i.e. after bmcweb crash),
     // we cannot reuse it.
-    std::remove((*socketValue).c_str());
-
-    sessions[&conn] = std::make_shared<NbdProxyServer>(
-        conn, *socketValue, *endpointValue, *endpointObjectPath);
+    std::remove(slot->second.config.socket.c_str());
+
+    slot->second.conn = &conn;
+    slot->second.stats->mounts++;
+    std::shared_ptr<NbdProxyServer>& session = sessions[&conn];
+    session = std::make_shared<NbdProxyServer>(
+        conn, slot->second.config.socket, slot->first,
+        slot->second.config.objectPath, slot->second.stats);
+    session->run();
+    return true;
+}
 
-    sessions[&conn]->run();
-};
 inline void onOpen(crow::websocket::Connection& conn)
 {
     BMCWEB_LOG_DEBUG << "nbd-proxy.onopen(" << &conn << ")";
 
-    auto openHandler =
-        [&conn](const boost::system::error_code& ec,
-                const dbus::utility::ManagedObjectType& objects) {
-        afterGetManagedObjects(conn, ec, objects);
-    };
-    crow::connections::systemBus->async_method_call(
-        std::move(openHandler), "xyz.openbmc_project.VirtualMedia",
-        "/xyz/openbmc_project/VirtualMedia",
-        "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
-
     // We need to wait for dbus and the websockets to hook up before data is
     // sent/received.  Tell the core to hold off messages until the sockets are
     // up
     conn.deferRead();
+
+    if (startSession(conn))
+    {
+        return;
+    }
+    // A slot added since the mount points were read
+    loadSlots([weak(conn.weak_from_this())](bool loaded) {
+        std::shared_ptr<crow::websocket::Connection> self = weak.lock();
+        if (self == nullptr)
+        {
+            return;
+        }
+        if (!loaded)
+        {
+            self->close("Failed to create mount point");
+            return;
+        }
+        if (!startSession(*self))
+        {
+            BMCWEB_LOG_ERROR << "Cannot find requested EndpointId";
+            self->close("Failed to match EndpointId");
+        }
+    });
 }
 
 inline void onClose(crow::websocket::Connection& conn,
@@ -353,6 +444,11 @@ inline void onClose(crow::websocket::Connection& conn,
         BMCWEB_LOG_DEBUG << "No session to close";
         return;
     }
+    auto slot = slots.find(session->second->getEndpointId());
+    if (slot != slots.end() && slot->second.conn == &conn)
+    {
+        slot->second.conn = nullptr;
+    }
     // Remove reference to session in global map
     sessions.erase(session);
 }
@@ -374,8 +470,59 @@ inline void onMessage(crow::websocket::Connection& conn, std::string_view data,
     session->second->send(data, std::move(whenComplete));
 }
 
+// Traffic through each slot, for /metrics
+inline std::string renderPrometheus()
+{
+    std::string out;
+    auto appendSamples = [&out](std::string_view name, std::string_view help,
+                                std::string_view type, auto value) {
+        out += "# HELP ";
+        out += name;
+        out += ' ';
+        out += help;
+        out += "\n# TYPE ";
+        out += name;
+        out += ' ';
+        out += type;
+        out += '\n';
+        for (const auto& [endpointId, slot] : slots)
+        {
+            out += name;
+            out += "{slot=\"";
+            metrics::appendLabelValue(out, endpointId);
+            out += "\"} ";
+            out += value(slot);
+            out += '\n';
+        }
+    };
+    appendSamples("bmcweb_nbd_proxy_to_host_bytes_total",
+                  "Bytes sent from virtual media clients to the host",
+                  "counter", [](const Slot& slot) {
+        return std::to_string(slot.stats->bytesToHost);
+    });
+    appendSamples("bmcweb_nbd_proxy_from_host_bytes_total",
+                  "Bytes sent from the host to virtual media clients",
+                  "counter", [](const Slot& slot) {
+        return std::to_string(slot.stats->bytesFromHost);
+    });
+    appendSamples("bmcweb_nbd_proxy_mounts_total",
+                  "Virtual media clients that have used the slot", "counter",
+                  [](const Slot& slot) {
+        return std::to_string(slot.stats->mounts);
+    });
+    appendSamples("bmcweb_nbd_proxy_in_use",
+                  "Whether a client is using the slot", "gauge",
+                  [](const Slot& slot) {
+        return std::string(slot.conn != nullptr ? "1" : "0");
+    });
+    return out;
+}
+
 inline void requestRoutes(App& app)
 {
+    // Read ahead, so opening a slot doesn't wait on D-Bus
+    loadSlots([](bool) {});
+
     BMCWEB_ROUTE(app, "/nbd/<str>")
         .websocket()
         .onopen(onOpen)
@@ -1,117 +1,405 @@
 #pragma once
+#include "bmcweb_config.h"
+
 #include <sys/socket.h>
 
 #include <app.hpp>
 #include <async_resp.hpp>
 #include <boost/asio/local/stream_protocol.hpp>
-#include <boost/container/flat_set.hpp>
+#include <boost/container/flat_map.hpp>
 #include <dbus_utility.hpp>
 #include <privileges.hpp>
 #include <websocket.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <deque>
+#include <memory>
+#include <string>
+#include <string_view>
+
 namespace crow
 {
 namespace obmc_console
 {
 
-static std::unique_ptr<boost::asio::local::stream_protocol::socket> hostSocket;
-
-static std::array<char, 4096> outputBuffer;
-static std::string inputBuffer;
+// Bytes of recent output replayed to a client when it connects
+static constexpr std::size_t scrollbackSize =
+    bmcwebConsoleScrollbackSizeKb * 1024UL;
 
-static boost::container::flat_set<crow::websocket::Connection*> sessions;
+// A client this far behind the console is disconnected rather than
+// buffered for
+static constexpr std::size_t maxClientBacklog = 1024UL * 1024UL;
 
-static bool doingWrite = false;
+// Output read from the host in one go.  Every client, and the scrollback,
+// hold the same immutable copy.
+using Chunk = std::shared_ptr<const std::string>;
 
-inline void doWrite()
+class ConsoleHandler : public std::enable_shared_from_this<ConsoleHandler>
 {
-    if (doingWrite)
+  public:
+    ConsoleHandler(boost::asio::io_context& ioc, std::string_view consoleId) :
+        hostSocket(ioc), socketName(getSocketName(consoleId))
+    {}
+
+    ConsoleHandler(const ConsoleHandler&) = delete;
+    ConsoleHandler(ConsoleHandler&&) = delete;
+    ConsoleHandler& operator=(const ConsoleHandler&) = delete;
+    ConsoleHandler& operator=(ConsoleHandler&&) = delete;
+    ~ConsoleHandler() = default;
+
+    // obmc-console names the socket of its default console "obmc-console",
+    // and others "obmc-console.<id>"
+    static std::string getSocketName(std::string_view consoleId)
     {
-        BMCWEB_LOG_DEBUG << "Already writing.  Bailing out";
-        return;
+        std::string name("\0obmc-console", 13);
+        if (consoleId != "default")
+        {
+            name += '.';
+            name += consoleId;
+        }
+        return name;
     }
 
-    if (inputBuffer.empty())
+    void connect()
     {
-        BMCWEB_LOG_DEBUG << "Outbuffer empty.  Bailing out";
-        return;
+        boost::asio::local::stream_protocol::endpoint ep(socketName);
+        hostSocket.async_connect(
+            ep, [weak(weak_from_this())](const boost::system::error_code& ec) {
+            std::shared_ptr<ConsoleHandler> self = weak.lock();
+            if (self == nullptr)
+            {
+                return;
+            }
+            if (ec)
+            {
+                BMCWEB_LOG_ERROR << "Couldn't connect to host serial port: "
+                                 << ec;
+                self->closeAll("Error in connecting to host port");
+                return;
+            }
+            self->connected = true;
+            self->doWrite();
+            self->doRead();
+        });
     }
 
-    if (!hostSocket)
+    // Replays the scrollback to conn, then follows the console
+    void subscribe(crow::websocket::Connection& conn)
     {
-        BMCWEB_LOG_ERROR << "doWrite(): Socket closed.";
-        return;
+        Subscriber& subscriber = subscribers[&conn];
+        for (const Chunk& chunk : history)
+        {
+            subscriber.pending.push_back(chunk);
+            subscriber.pendingBytes += chunk->size();
+        }
+        doSend(conn);
     }
 
-    doingWrite = true;
-    hostSocket->async_write_some(
-        boost::asio::buffer(inputBuffer.data(), inputBuffer.size()),
-        [](boost::beast::error_code ec, std::size_t bytesWritten) {
-        doingWrite = false;
-        inputBuffer.erase(0, bytesWritten);
+    // Returns true once nobody is left watching this console
+    bool unsubscribe(crow::websocket::Connection& conn)
+    {
+        subscribers.erase(&conn);
+        return subscribers.empty();
+    }
+
+    void write(std::string_view data)
+    {
+        inputBuffer += data;
+        doWrite();
+    }
+
+  private:
+    struct Subscriber
+    {
+        std::deque<Chunk> pending;
+        std::size_t pendingBytes = 0;
+        bool sending = false;
+        bool closing = false;
+    };
+
+    void closeAll(std::string_view reason)
+    {
+        for (auto& [conn, subscriber] : subscribers)
+        {
+            conn->close(reason);
+        }
+    }
+
+    void doWrite()
+    {
+        if (doingWrite)
+        {
+            BMCWEB_LOG_DEBUG << "Already writing.  Bailing out";
+            return;
+        }
+
+        if (inputBuffer.empty())
+        {
+            BMCWEB_LOG_DEBUG << "Outbuffer empty.  Bailing out";
+            return;
+        }
 
-        if (ec == boost::asio::error::eof)
+        if (!connected)
         {
-            for (crow::websocket::Connection* session : sessions)
+            BMCWEB_LOG_DEBUG << "doWrite(): Socket not connected yet.";
+            return;
+        }
+
+        doingWrite = true;
+        hostSocket.async_write_some(
+            boost::asio::buffer(inputBuffer.data(), inputBuffer.size()),
+            [weak(weak_from_this())](const boost::beast::error_code& ec,
+                                     std::size_t bytesWritten) {
+            std::shared_ptr<ConsoleHandler> self = weak.lock();
+            if (self == nullptr)
             {
-                session->close("Error in reading to host port");
+                return;
             }
-            return;
+            self->doingWrite = false;
+            self->inputBuffer.erase(0, bytesWritten);
+
+            if (ec == boost::asio::error::eof)
+            {
+                self->closeAll("Error in reading to host port");
+                return;
+            }
+            if (ec)
+            {
+                BMCWEB_LOG_ERROR << "Error in host serial write " << ec;
+                return;
+            }
+            self->doWrite();
+        });
+    }
+
+    void doRead()
+    {
+        BMCWEB_LOG_DEBUG << "Reading from socket";
+        hostSocket.async_read_some(
+            boost::asio::buffer(readBuffer),
+            [weak(weak_from_this())](const boost::system::error_code& ec,
+                                     std::size_t bytesRead) {
+            std::shared_ptr<ConsoleHandler> self = weak.lock();
+            if (self == nullptr)
+            {
+                return;
+            }
+            BMCWEB_LOG_DEBUG << "read done.  Read " << bytesRead << " bytes";
+            if (ec)
+            {
+                BMCWEB_LOG_ERROR << "Couldn't read from host serial port: "
+                                 << ec;
+                self->closeAll("Error in connecting to host port");
+                return;
+            }
+            self->publish(std::make_shared<const std::string>(
+                self->readBuffer.data(), bytesRead));
+            self->doRead();
+        });
+    }
+
+    void publish(const Chunk& chunk)
+    {
+        history.push_back(chunk);
+        historyBytes += chunk->size();
+        while (historyBytes > scrollbackSize && !history.empty())
+        {
+            historyBytes -= history.front()->size();
+            history.pop_front();
         }
-        if (ec)
+
+        for (auto& [conn, subscriber] : subscribers)
+        {
+            if (subscriber.closing)
+            {
+                continue;
+            }
+            if (subscriber.pendingBytes + chunk->size() > maxClientBacklog)
+            {
+                BMCWEB_LOG_WARNING << "Console client " << conn
+                                   << " fell too far behind";
+                subscriber.closing = true;
+                conn->close("Too far behind console output");
+                continue;
+            }
+            subscriber.pending.push_back(chunk);
+            subscriber.pendingBytes += chunk->size();
+            doSend(*conn);
+        }
+    }
+
+    void doSend(crow::websocket::Connection& conn)
+    {
+        auto it = subscribers.find(&conn);
+        if (it == subscribers.end() || it->second.sending ||
+            it->second.pending.empty())
         {
-            BMCWEB_LOG_ERROR << "Error in host serial write " << ec;
             return;
         }
-        doWrite();
+        Subscriber& subscriber = it->second;
+        Chunk chunk = subscriber.pending.front();
+        subscriber.pending.pop_front();
+        subscriber.pendingBytes -= chunk->size();
+        subscriber.sending = true;
+
+        // The websocket reads from chunk until this runs
+        conn.sendEx(crow::websocket::MessageType::Binary, *chunk,
+                    [weak(weak_from_this()), &conn, chunk]() {
+            std::shared_ptr<ConsoleHandler> self = weak.lock();
+            if (self == nullptr)
+            {
+                return;
+            }
+            auto sent = self->subscribers.find(&conn);
+            if (sent == self->subscribers.end())
+            {
+                return;
+            }
+            sent->second.sending = false;
+            self->doSend(conn);
+        });
+    }
+
+    boost::asio::local::stream_protocol::socket hostSocket;
+    const std::string socketName;
+    bool connected = false;
+
+    std::array<char, 4096> readBuffer{};
+    std::string inputBuffer;
+    bool doingWrite = false;
+
+    std::deque<Chunk> history;
+    std::size_t historyBytes = 0;
+
+    boost::container::flat_map<crow::websocket::Connection*, Subscriber>
+        subscribers;
+};
+
+// Consoles with at least one client, by obmc-console id
+static boost::container::flat_map<std::string, std::shared_ptr<ConsoleHandler>,
+                                  std::less<>>
+    consoles;
+
+// Which console each subscribed connection watches
+static boost::container::flat_map<crow::websocket::Connection*, std::string>
+    connectionConsoles;
+
+inline bool isValidConsoleId(std::string_view consoleId)
+{
+    if (consoleId.empty())
+    {
+        return false;
+    }
+    return std::all_of(consoleId.begin(), consoleId.end(), [](char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) != 0 || c == '_' ||
+               c == '-';
     });
 }
 
-inline void doRead()
+inline void subscribe(crow::websocket::Connection& conn,
+                      const std::string& consoleId)
 {
-    if (!hostSocket)
+    auto it = consoles.find(consoleId);
+    if (it == consoles.end())
     {
-        BMCWEB_LOG_ERROR << "doRead(): Socket closed.";
-        return;
+        it = consoles
+                 .emplace(consoleId, std::make_shared<ConsoleHandler>(
+                                         conn.getIoContext(), consoleId))
+                 .first;
+        it->second->connect();
     }
+    connectionConsoles[&conn] = consoleId;
+    it->second->subscribe(conn);
+}
 
-    BMCWEB_LOG_DEBUG << "Reading from socket";
-    hostSocket->async_read_some(
-        boost::asio::buffer(outputBuffer.data(), outputBuffer.size()),
-        [](const boost::system::error_code& ec, std::size_t bytesRead) {
-        BMCWEB_LOG_DEBUG << "read done.  Read " << bytesRead << " bytes";
+inline void onOpen(crow::websocket::Connection& conn,
+                   const std::string& consoleId)
+{
+    BMCWEB_LOG_DEBUG << "Connection " << &conn << " opened for console "
+                     << consoleId;
+    // Ensure user has ConfigureManager, setting above does nothing
+    auto getUserInfo =
+        [&conn, consoleId](const boost::system::error_code& ec,
+                           const dbus::utility::DBusPropertiesMap& userInfo) {
         if (ec)
         {
-            BMCWEB_LOG_ERROR << "Couldn't read from host serial port: " << ec;
-            for (crow::websocket::Connection* session : sessions)
-            {
-                session->close("Error in connecting to host port");
-            }
+            BMCWEB_LOG_ERROR << "GetUserInfo failed...";
+            conn.close("Failed to get user information");
             return;
         }
-        std::string_view payload(outputBuffer.data(), bytesRead);
-        for (crow::websocket::Connection* session : sessions)
+
+        const std::string* userRolePtr = nullptr;
+        auto userInfoIter = std::find_if(
+            userInfo.begin(), userInfo.end(),
+            [](const auto& p) { return p.first == "UserPrivilege"; });
+        if (userInfoIter != userInfo.end())
         {
-            session->sendBinary(payload);
+            userRolePtr = std::get_if<std::string>(&userInfoIter->second);
         }
-        doRead();
-    });
+
+        std::string userRole{};
+        if (userRolePtr != nullptr)
+        {
+            userRole = *userRolePtr;
+            BMCWEB_LOG_DEBUG << "userName = " << conn.getUserName()
+                             << " userRole = " << *userRolePtr;
+        }
+
+        // Get the user privileges from the role
+        ::redfish::Privileges userPrivileges =
+            ::redfish::getUserPrivileges(userRole);
+
+        const ::redfish::Privileges requiredPrivileges{"ConfigureManager"};
+
+        if (!userPrivileges.isSupersetOf(requiredPrivileges))
+        {
+            BMCWEB_LOG_DEBUG << "User " << conn.getUserName()
+                             << " not authorized for host console connection";
+            conn.close("Unathourized access");
+            return;
+        }
+
+        subscribe(conn, consoleId);
+    };
+    crow::connections::systemBus->async_method_call(
+        std::move(getUserInfo), "xyz.openbmc_project.User.Manager",
+        "/xyz/openbmc_project/user", "xyz.openbmc_project.User.Manager",
+        "GetUserInfo", conn.getUserName());
 }
 
-inline void connectHandler(const boost::system::error_code& ec)
+inline void onClose(crow::websocket::Connection& conn,
+                    [[maybe_unused]] const std::string& reason)
 {
-    if (ec)
+    BMCWEB_LOG_INFO << "Closing websocket. Reason: " << reason;
+
+    auto subscription = connectionConsoles.find(&conn);
+    if (subscription == connectionConsoles.end())
     {
-        BMCWEB_LOG_ERROR << "Couldn't connect to host serial port: " << ec;
-        for (crow::websocket::Connection* session : sessions)
-        {
-            session->close("Error in connecting to host port");
-        }
         return;
     }
+    auto it = consoles.find(subscription->second);
+    connectionConsoles.erase(subscription);
+    if (it != consoles.end() && it->second->unsubscribe(conn))
+    {
+        consoles.erase(it);
+    }
+}
 
-    doWrite();
-    doRead();
+inline void onMessage(crow::websocket::Connection& conn,
+                      const std::string& data, [[maybe_unused]] bool isBinary)
+{
+    auto subscription = connectionConsoles.find(&conn);
+    if (subscription == connectionConsoles.end())
+    {
+        return;
+    }
+    auto it = consoles.find(subscription->second);
+    if (it != consoles.end())
+    {
+        it->second->write(data);
+    }
 }
 
 inline void requestRoutes(App& app)
@@ -119,85 +407,30 @@ inline void requestRoutes(App& app)
     BMCWEB_ROUTE(app, "/console0")
         .privileges({{"ConfigureManager"}})
         .websocket()
+        .permessageDeflate()
         .onopen([](crow::websocket::Connection& conn) {
-        BMCWEB_LOG_DEBUG << "Connection " << &conn << " opened";
-        // Ensure user has ConfigureManager, setting above does nothing
-        auto getUserInfo =
-            [&conn](const boost::system::error_code& ec,
-                    const dbus::utility::DBusPropertiesMap& userInfo) {
-            if (ec)
-            {
-                BMCWEB_LOG_ERROR << "GetUserInfo failed...";
-                conn.close("Failed to get user information");
-                return;
-            }
-
-            const std::string* userRolePtr = nullptr;
-            auto userInfoIter = std::find_if(
-                userInfo.begin(), userInfo.end(),
-                [](const auto& p) { return p.first == "UserPrivilege"; });
-            if (userInfoIter != userInfo.end())
-            {
-                userRolePtr = std::get_if<std::string>(&userInfoIter->second);
-            }
-
-            std::string userRole{};
-            if (userRolePtr != nullptr)
-            {
-                userRole = *userRolePtr;
-                BMCWEB_LOG_DEBUG << "userName = " << conn.getUserName()
-                                 << " userRole = " << *userRolePtr;
-            }
-
-            // Get the user privileges from the role
-            ::redfish::Privileges userPrivileges =
-                ::redfish::getUserPrivileges(userRole);
-
-            const ::redfish::Privileges requiredPrivileges{"ConfigureManager"};
-
-            if (!userPrivileges.isSupersetOf(requiredPrivileges))
-            {
-                BMCWEB_LOG_DEBUG
-                    << "User " << conn.getUserName()
-                    << " not authorized for host console connection";
-                conn.close("Unathourized access");
-                return;
-            }
-
-            sessions.insert(&conn);
-            if (hostSocket == nullptr)
-            {
-                const std::string consoleName("\0obmc-console", 13);
-                boost::asio::local::stream_protocol::endpoint ep(consoleName);
-
-                hostSocket = std::make_unique<
-                    boost::asio::local::stream_protocol::socket>(
-                    conn.getIoContext());
-                hostSocket->async_connect(ep, connectHandler);
-            }
-        };
-        crow::connections::systemBus->async_method_call(
-            std::move(getUserInfo), "xyz.openbmc_project.User.Manager",
-            "/xyz/openbmc_project/user", "xyz.openbmc_project.User.Manager",
-            "GetUserInfo", conn.getUserName());
+        onOpen(conn, "default");
     })
-        .onclose([](crow::websocket::Connection& conn,
-                    [[maybe_unused]] const std::string& reason) {
-        BMCWEB_LOG_INFO << "Closing websocket. Reason: " << reason;
+        .onclose(onClose)
+        .onmessage(onMessage);
 
-        sessions.erase(&conn);
-        if (sessions.empty())
+    BMCWEB_ROUTE(app, "/console/<str>")
+        .privileges({{"ConfigureManager"}})
+        .websocket()
+        .permessageDeflate()
+        .onopen([](crow::websocket::Connection& conn) {
+        std::string_view target(conn.req.target().data(),
+                                conn.req.target().size());
+        std::string consoleId(target.substr(target.rfind('/') + 1));
+        if (!isValidConsoleId(consoleId))
         {
-            hostSocket = nullptr;
-            inputBuffer.clear();
-            inputBuffer.shrink_to_fit();
+            conn.close("Invalid console id");
+            return;
         }
+        onOpen(conn, consoleId);
     })
-        .onmessage([]([[maybe_unused]] crow::websocket::Connection& conn,
-                      const std::string& data, [[maybe_unused]] bool isBinary) {
-        inputBuffer += data;
-        doWrite();
-    });
+        .onclose(onClose)
+        .onmessage(onMessage);
 }
 } // namespace obmc_console
 } // namespace crow
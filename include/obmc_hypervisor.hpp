@@ -122,6 +122,7 @@ inline void requestRoutes(App& app)
     BMCWEB_ROUTE(app, "/console1")
         .privileges({{"OemIBMPerformService"}})
         .websocket()
+        .permessageDeflate()
         .onopen([](crow::websocket::Connection& conn) {
         BMCWEB_LOG_DEBUG << "Connection " << &conn << " opened";
 
@@ -15,23 +15,26 @@
 #pragma once
 #include "http_request.hpp"
 #include "http_response.hpp"
+#include "http_utility.hpp"
 #include "logging.hpp"
 #include "routing.hpp"
 
 #include <systemd/sd-bus-protocol.h>
 #include <systemd/sd-bus.h>
-#include <tinyxml2.h>
 
 #include <app.hpp>
 #include <async_resp.hpp>
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/algorithm/string/split.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/beast/http/status.hpp>
 #include <boost/beast/http/verb.hpp>
 #include <boost/container/flat_map.hpp>
 #include <boost/container/vector.hpp>
 #include <boost/iterator/iterator_facade.hpp>
+#include <dbus_introspect_cache.hpp>
+#include <dbus_signature.hpp>
 #include <dbus_singleton.hpp>
 #include <dbus_utility.hpp>
 #include <nlohmann/json.hpp>
@@ -46,8 +49,8 @@
 #include <cerrno>
 #include <cstdint>
 #include <cstring>
+#include <deque>
 #include <filesystem>
-#include <fstream>
 #include <functional>
 #include <initializer_list>
 #include <iterator>
@@ -58,6 +61,7 @@
 #include <string>
 #include <string_view>
 #include <type_traits>
+#include <unordered_set>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -124,11 +128,12 @@ inline void
         transaction->res.jsonValue["objects"] = nlohmann::json::array();
     }
 
-    crow::connections::systemBus->async_method_call(
+    dbus::utility::IntrospectCache::getInstance().get(
+        processName, objectPath,
         [transaction, processName{std::string(processName)},
          objectPath{std::string(objectPath)}](
-            const boost::system::error_code ec,
-            const std::string& introspectXml) {
+            const boost::system::error_code& ec,
+            const std::shared_ptr<const dbus::utility::IntrospectData>& data) {
         if (ec)
         {
             BMCWEB_LOG_ERROR
@@ -142,39 +147,22 @@ inline void
 
         transaction->res.jsonValue["objects"].push_back(std::move(object));
 
-        tinyxml2::XMLDocument doc;
-
-        doc.Parse(introspectXml.c_str());
-        tinyxml2::XMLNode* pRoot = doc.FirstChildElement("node");
-        if (pRoot == nullptr)
+        if (data == nullptr)
         {
-            BMCWEB_LOG_ERROR << "XML document failed to parse " << processName
-                             << " " << objectPath << "\n";
+            return;
         }
-        else
+        for (const std::string& childPath : data->children)
         {
-            tinyxml2::XMLElement* node = pRoot->FirstChildElement("node");
-            while (node != nullptr)
+            std::string newpath;
+            if (objectPath != "/")
             {
-                const char* childPath = node->Attribute("name");
-                if (childPath != nullptr)
-                {
-                    std::string newpath;
-                    if (objectPath != "/")
-                    {
-                        newpath += objectPath;
-                    }
-                    newpath += std::string("/") + childPath;
-                    // introspect the subobjects as well
-                    introspectObjects(processName, newpath, transaction);
-                }
-
-                node = node->NextSiblingElement("node");
+                newpath += objectPath;
             }
+            newpath += "/" + childPath;
+            // introspect the subobjects as well
+            introspectObjects(processName, newpath, transaction);
         }
-    },
-        processName, objectPath, "org.freedesktop.DBus.Introspectable",
-        "Introspect");
+    });
 }
 
 inline void getPropertiesForEnumerate(
@@ -935,12 +923,12 @@ inline int convertJsonToDbus(sd_bus_message* m, const std::string& argType,
 }
 
 template <typename T>
-int readMessageItem(const std::string& typeCode, sdbusplus::message_t& m,
+int readMessageItem(char typeCode, sdbusplus::message_t& m,
                     nlohmann::json& data)
 {
     T value;
 
-    int r = sd_bus_message_read_basic(m.get(), typeCode.front(), &value);
+    int r = sd_bus_message_read_basic(m.get(), typeCode, &value);
     if (r < 0)
     {
         BMCWEB_LOG_ERROR << "sd_bus_message_read_basic on type " << typeCode
@@ -952,53 +940,98 @@ int readMessageItem(const std::string& typeCode, sdbusplus::message_t& m,
     return 0;
 }
 
-int convertDBusToJSON(const std::string& returnType, sdbusplus::message_t& m,
-                      nlohmann::json& response);
+int readDbusValue(const dbus::utility::DbusTypeNode& type,
+                  sdbusplus::message_t& m, nlohmann::json& data);
 
-inline int readDictEntryFromMessage(const std::string& typeCode,
-                                    sdbusplus::message_t& m,
-                                    nlohmann::json& object)
+inline int readBasicFromMessage(char typeCode, sdbusplus::message_t& m,
+                                nlohmann::json& data)
 {
-    std::vector<std::string> types = dbusArgSplit(typeCode);
-    if (types.size() != 2)
+    switch (typeCode)
     {
-        BMCWEB_LOG_ERROR << "wrong number contained types in dictionary: "
-                         << types.size();
-        return -1;
+        case 's':
+        case 'g':
+        case 'o':
+            return readMessageItem<char*>(typeCode, m, data);
+        case 'b':
+        {
+            int value = 0;
+            int r = sd_bus_message_read_basic(m.get(), typeCode, &value);
+            if (r < 0)
+            {
+                BMCWEB_LOG_ERROR << "sd_bus_message_read_basic on type b "
+                                    "failed!";
+                return r;
+            }
+            data = value != 0;
+            return 0;
+        }
+        case 'u':
+            return readMessageItem<uint32_t>(typeCode, m, data);
+        case 'i':
+        case 'h':
+            return readMessageItem<int32_t>(typeCode, m, data);
+        case 'x':
+            return readMessageItem<int64_t>(typeCode, m, data);
+        case 't':
+            return readMessageItem<uint64_t>(typeCode, m, data);
+        case 'n':
+            return readMessageItem<int16_t>(typeCode, m, data);
+        case 'q':
+            return readMessageItem<uint16_t>(typeCode, m, data);
+        case 'y':
+            return readMessageItem<uint8_t>(typeCode, m, data);
+        case 'd':
+            return readMessageItem<double>(typeCode, m, data);
+        default:
+            break;
     }
+    BMCWEB_LOG_ERROR << "Invalid D-Bus signature type " << typeCode;
+    return -2;
+}
 
+inline int readDictEntryFromMessage(const dbus::utility::DbusTypeNode& entry,
+                                    sdbusplus::message_t& m,
+                                    nlohmann::json::object_t& object)
+{
     int r = sd_bus_message_enter_container(m.get(), SD_BUS_TYPE_DICT_ENTRY,
-                                           typeCode.c_str());
+                                           entry.contents.c_str());
     if (r < 0)
     {
         BMCWEB_LOG_ERROR << "sd_bus_message_enter_container with rc " << r;
         return r;
     }
 
-    nlohmann::json key;
-    r = convertDBusToJSON(types[0], m, key);
-    if (r < 0)
+    const dbus::utility::DbusTypeNode& keyType = entry.children[0];
+    std::string keyString;
+    if (keyType.code == 's' || keyType.code == 'o' || keyType.code == 'g')
     {
-        return r;
+        // The usual case; read the key straight into place
+        const char* value = nullptr;
+        r = sd_bus_message_read_basic(m.get(), keyType.code, &value);
+        if (r < 0)
+        {
+            BMCWEB_LOG_ERROR << "sd_bus_message_read_basic on type "
+                             << keyType.code << " failed!";
+            return r;
+        }
+        keyString = value;
     }
-
-    const std::string* keyPtr = key.get_ptr<const std::string*>();
-    if (keyPtr == nullptr)
+    else
     {
-        // json doesn't support non-string keys.  If we hit this condition,
-        // convert the result to a string so we can proceed
-        key = key.dump(2, ' ', true, nlohmann::json::error_handler_t::replace);
-        keyPtr = key.get_ptr<const std::string*>();
-        // in theory this can't fail now, but lets be paranoid about it
-        // anyway
-        if (keyPtr == nullptr)
+        nlohmann::json key;
+        r = readBasicFromMessage(keyType.code, m, key);
+        if (r < 0)
         {
-            return -1;
+            return r;
         }
+        // json doesn't support non-string keys, so convert the result to a
+        // string so we can proceed
+        keyString = key.dump(2, ' ', true,
+                             nlohmann::json::error_handler_t::replace);
     }
-    nlohmann::json& value = object[*keyPtr];
+    nlohmann::json& value = object[keyString];
 
-    r = convertDBusToJSON(types[1], m, value);
+    r = readDbusValue(entry.children[1], m, value);
     if (r < 0)
     {
         return r;
@@ -1014,20 +1047,11 @@ inline int readDictEntryFromMessage(const std::string& typeCode,
     return 0;
 }
 
-inline int readArrayFromMessage(const std::string& typeCode,
+inline int readArrayFromMessage(const dbus::utility::DbusTypeNode& array,
                                 sdbusplus::message_t& m, nlohmann::json& data)
 {
-    if (typeCode.size() < 2)
-    {
-        BMCWEB_LOG_ERROR << "Type code " << typeCode
-                         << " too small for an array";
-        return -1;
-    }
-
-    std::string containedType = typeCode.substr(1);
-
     int r = sd_bus_message_enter_container(m.get(), SD_BUS_TYPE_ARRAY,
-                                           containedType.c_str());
+                                           array.contents.c_str());
     if (r < 0)
     {
         BMCWEB_LOG_ERROR << "sd_bus_message_enter_container failed with rc "
@@ -1035,12 +1059,11 @@ inline int readArrayFromMessage(const std::string& typeCode,
         return r;
     }
 
-    bool dict = containedType.starts_with("{") && containedType.ends_with("}");
-
+    const dbus::utility::DbusTypeNode& element = array.children[0];
+    // Dictionaries are only ever seen in an array
+    bool dict = element.code == '{';
     if (dict)
     {
-        // Remove the { }
-        containedType = containedType.substr(1, containedType.size() - 2);
         data = nlohmann::json::object();
     }
     else
@@ -1062,24 +1085,20 @@ inline int readArrayFromMessage(const std::string& typeCode,
             break;
         }
 
-        // Dictionaries are only ever seen in an array
         if (dict)
         {
-            r = readDictEntryFromMessage(containedType, m, data);
-            if (r < 0)
-            {
-                return r;
-            }
+            r = readDictEntryFromMessage(
+                element, m, data.get_ref<nlohmann::json::object_t&>());
         }
         else
         {
-            data.push_back(nlohmann::json());
-
-            r = convertDBusToJSON(containedType, m, data.back());
-            if (r < 0)
-            {
-                return r;
-            }
+            r = readDbusValue(
+                element, m,
+                data.get_ref<nlohmann::json::array_t&>().emplace_back());
+        }
+        if (r < 0)
+        {
+            return r;
         }
     }
 
@@ -1093,21 +1112,11 @@ inline int readArrayFromMessage(const std::string& typeCode,
     return 0;
 }
 
-inline int readStructFromMessage(const std::string& typeCode,
+inline int readStructFromMessage(const dbus::utility::DbusTypeNode& structure,
                                  sdbusplus::message_t& m, nlohmann::json& data)
 {
-    if (typeCode.size() < 3)
-    {
-        BMCWEB_LOG_ERROR << "Type code " << typeCode
-                         << " too small for a struct";
-        return -1;
-    }
-
-    std::string containedTypes = typeCode.substr(1, typeCode.size() - 2);
-    std::vector<std::string> types = dbusArgSplit(containedTypes);
-
     int r = sd_bus_message_enter_container(m.get(), SD_BUS_TYPE_STRUCT,
-                                           containedTypes.c_str());
+                                           structure.contents.c_str());
     if (r < 0)
     {
         BMCWEB_LOG_ERROR << "sd_bus_message_enter_container failed with rc "
@@ -1115,10 +1124,14 @@ inline int readStructFromMessage(const std::string& typeCode,
         return r;
     }
 
-    for (const std::string& type : types)
+    if (!data.is_array())
+    {
+        data = nlohmann::json::array();
+    }
+    nlohmann::json::array_t& members = data.get_ref<nlohmann::json::array_t&>();
+    for (const dbus::utility::DbusTypeNode& type : structure.children)
     {
-        data.push_back(nlohmann::json());
-        r = convertDBusToJSON(type, m, data.back());
+        r = readDbusValue(type, m, members.emplace_back());
         if (r < 0)
         {
             return r;
@@ -1134,6 +1147,9 @@ inline int readStructFromMessage(const std::string& typeCode,
     return 0;
 }
 
+int convertDBusToJSON(const std::string& returnType, sdbusplus::message_t& m,
+                      nlohmann::json& response);
+
 inline int readVariantFromMessage(sdbusplus::message_t& m, nlohmann::json& data)
 {
     const char* containerType = nullptr;
@@ -1169,139 +1185,54 @@ inline int readVariantFromMessage(sdbusplus::message_t& m, nlohmann::json& data)
     return 0;
 }
 
+inline int readDbusValue(const dbus::utility::DbusTypeNode& type,
+                         sdbusplus::message_t& m, nlohmann::json& data)
+{
+    switch (type.code)
+    {
+        case 'a':
+            return readArrayFromMessage(type, m, data);
+        case '(':
+            return readStructFromMessage(type, m, data);
+        case 'v':
+            return readVariantFromMessage(m, data);
+        default:
+            break;
+    }
+    return readBasicFromMessage(type.code, m, data);
+}
+
+/**
+ * @brief Reads values of returnType from m into response, as an array if
+ * returnType holds more than one complete type.
+ *
+ * The signature is parsed once into a tree that is kept for the next message
+ * with the same signature, and values are written straight into their place
+ * in response.
+ */
 inline int convertDBusToJSON(const std::string& returnType,
                              sdbusplus::message_t& m, nlohmann::json& response)
 {
-    int r = 0;
-    const std::vector<std::string> returnTypes = dbusArgSplit(returnType);
+    std::shared_ptr<const dbus::utility::DbusSignature> types =
+        dbus::utility::getParsedSignature(returnType);
+    if (types == nullptr)
+    {
+        BMCWEB_LOG_ERROR << "Invalid D-Bus signature type " << returnType;
+        return -2;
+    }
 
-    for (const std::string& typeCode : returnTypes)
+    for (const dbus::utility::DbusTypeNode& type : *types)
     {
         nlohmann::json* thisElement = &response;
-        if (returnTypes.size() > 1)
+        if (types->size() > 1)
         {
             response.push_back(nlohmann::json{});
             thisElement = &response.back();
         }
-
-        if (typeCode == "s" || typeCode == "g" || typeCode == "o")
-        {
-            r = readMessageItem<char*>(typeCode, m, *thisElement);
-            if (r < 0)
-            {
-                return r;
-            }
-        }
-        else if (typeCode == "b")
-        {
-            r = readMessageItem<int>(typeCode, m, *thisElement);
-            if (r < 0)
-            {
-                return r;
-            }
-
-            *thisElement = static_cast<bool>(thisElement->get<int>());
-        }
-        else if (typeCode == "u")
-        {
-            r = readMessageItem<uint32_t>(typeCode, m, *thisElement);
-            if (r < 0)
-            {
-                return r;
-            }
-        }
-        else if (typeCode == "i")
-        {
-            r = readMessageItem<int32_t>(typeCode, m, *thisElement);
-            if (r < 0)
-            {
-                return r;
-            }
-        }
-        else if (typeCode == "x")
-        {
-            r = readMessageItem<int64_t>(typeCode, m, *thisElement);
-            if (r < 0)
-            {
-                return r;
-            }
-        }
-        else if (typeCode == "t")
-        {
-            r = readMessageItem<uint64_t>(typeCode, m, *thisElement);
-            if (r < 0)
-            {
-                return r;
-            }
-        }
-        else if (typeCode == "n")
-        {
-            r = readMessageItem<int16_t>(typeCode, m, *thisElement);
-            if (r < 0)
-            {
-                return r;
-            }
-        }
-        else if (typeCode == "q")
-        {
-            r = readMessageItem<uint16_t>(typeCode, m, *thisElement);
-            if (r < 0)
-            {
-                return r;
-            }
-        }
-        else if (typeCode == "y")
-        {
-            r = readMessageItem<uint8_t>(typeCode, m, *thisElement);
-            if (r < 0)
-            {
-                return r;
-            }
-        }
-        else if (typeCode == "d")
-        {
-            r = readMessageItem<double>(typeCode, m, *thisElement);
-            if (r < 0)
-            {
-                return r;
-            }
-        }
-        else if (typeCode == "h")
-        {
-            r = readMessageItem<int>(typeCode, m, *thisElement);
-            if (r < 0)
-            {
-                return r;
-            }
-        }
-        else if (typeCode.starts_with("a"))
-        {
-            r = readArrayFromMessage(typeCode, m, *thisElement);
-            if (r < 0)
-            {
-                return r;
-            }
-        }
-        else if (typeCode.starts_with("(") && typeCode.ends_with(")"))
-        {
-            r = readStructFromMessage(typeCode, m, *thisElement);
-            if (r < 0)
-            {
-                return r;
-            }
-        }
-        else if (typeCode.starts_with("v"))
-        {
-            r = readVariantFromMessage(m, *thisElement);
-            if (r < 0)
-            {
-                return r;
-            }
-        }
-        else
+        int r = readDbusValue(type, m, *thisElement);
+        if (r < 0)
         {
-            BMCWEB_LOG_ERROR << "Invalid D-Bus signature type " << typeCode;
-            return -2;
+            return r;
         }
     }
 
@@ -1378,11 +1309,11 @@ inline void findActionOnInterface(
 {
     BMCWEB_LOG_DEBUG << "findActionOnInterface for connection "
                      << connectionName;
-    crow::connections::systemBus->async_method_call(
+    dbus::utility::IntrospectCache::getInstance().get(
+        connectionName, transaction->path,
         [transaction, connectionName{std::string(connectionName)}](
-            const boost::system::error_code ec,
-            const std::string& introspectXml) {
-        BMCWEB_LOG_DEBUG << "got xml:\n " << introspectXml;
+            const boost::system::error_code& ec,
+            const std::shared_ptr<const dbus::utility::IntrospectData>& data) {
         if (ec)
         {
             BMCWEB_LOG_ERROR
@@ -1390,144 +1321,101 @@ inline void findActionOnInterface(
                 << " on process: " << connectionName << "\n";
             return;
         }
-        tinyxml2::XMLDocument doc;
-
-        doc.Parse(introspectXml.data(), introspectXml.size());
-        tinyxml2::XMLNode* pRoot = doc.FirstChildElement("node");
-        if (pRoot == nullptr)
+        if (data == nullptr)
         {
-            BMCWEB_LOG_ERROR << "XML document failed to parse "
-                             << connectionName << "\n";
             return;
         }
-        tinyxml2::XMLElement* interfaceNode =
-            pRoot->FirstChildElement("interface");
-        while (interfaceNode != nullptr)
+        for (const dbus::utility::IntrospectInterface& interface :
+             data->interfaces)
         {
-            const char* thisInterfaceName = interfaceNode->Attribute("name");
-            if (thisInterfaceName != nullptr)
+            if (!transaction->interfaceName.empty() &&
+                (transaction->interfaceName != interface.name))
+            {
+                continue;
+            }
+
+            for (const dbus::utility::IntrospectMember& method :
+                 interface.methods)
             {
-                if (!transaction->interfaceName.empty() &&
-                    (transaction->interfaceName != thisInterfaceName))
+                BMCWEB_LOG_DEBUG << "Found method: " << method.name;
+                if (method.name != transaction->methodName)
                 {
-                    interfaceNode =
-                        interfaceNode->NextSiblingElement("interface");
                     continue;
                 }
+                BMCWEB_LOG_DEBUG << "Found method named " << method.name
+                                 << " on interface " << interface.name;
+                sdbusplus::message_t m =
+                    crow::connections::systemBus->new_method_call(
+                        connectionName.c_str(), transaction->path.c_str(),
+                        interface.name.c_str(),
+                        transaction->methodName.c_str());
+
+                std::string returnType;
 
-                tinyxml2::XMLElement* methodNode =
-                    interfaceNode->FirstChildElement("method");
-                while (methodNode != nullptr)
+                // Find the output type
+                for (const dbus::utility::IntrospectArg& arg : method.args)
                 {
-                    const char* thisMethodName = methodNode->Attribute("name");
-                    BMCWEB_LOG_DEBUG << "Found method: " << thisMethodName;
-                    if (thisMethodName != nullptr &&
-                        thisMethodName == transaction->methodName)
+                    if (arg.direction == "out" && !arg.type.empty())
                     {
-                        BMCWEB_LOG_DEBUG << "Found method named "
-                                         << thisMethodName << " on interface "
-                                         << thisInterfaceName;
-                        sdbusplus::message_t m =
-                            crow::connections::systemBus->new_method_call(
-                                connectionName.c_str(),
-                                transaction->path.c_str(), thisInterfaceName,
-                                transaction->methodName.c_str());
-
-                        tinyxml2::XMLElement* argumentNode =
-                            methodNode->FirstChildElement("arg");
+                        returnType = arg.type;
+                        break;
+                    }
+                }
 
-                        std::string returnType;
+                auto argIt = transaction->arguments.begin();
 
-                        // Find the output type
-                        while (argumentNode != nullptr)
-                        {
-                            const char* argDirection =
-                                argumentNode->Attribute("direction");
-                            const char* argType =
-                                argumentNode->Attribute("type");
-                            if (argDirection != nullptr && argType != nullptr &&
-                                std::string(argDirection) == "out")
-                            {
-                                returnType = argType;
-                                break;
-                            }
-                            argumentNode =
-                                argumentNode->NextSiblingElement("arg");
-                        }
+                for (const dbus::utility::IntrospectArg& arg : method.args)
+                {
+                    if (arg.direction != "in" || arg.type.empty())
+                    {
+                        continue;
+                    }
+                    if (argIt == transaction->arguments.end())
+                    {
+                        transaction->setErrorStatus("Invalid method args");
+                        return;
+                    }
+                    if (convertJsonToDbus(m.get(), arg.type, *argIt) < 0)
+                    {
+                        transaction->setErrorStatus("Invalid method arg type");
+                        return;
+                    }
 
-                        auto argIt = transaction->arguments.begin();
+                    argIt++;
+                }
 
-                        argumentNode = methodNode->FirstChildElement("arg");
+                crow::connections::systemBus->async_send(
+                    m, [transaction, returnType](boost::system::error_code ec2,
+                                                 sdbusplus::message_t& m2) {
+                    if (ec2)
+                    {
+                        transaction->methodFailed = true;
+                        const sd_bus_error* e = m2.get_error();
 
-                        while (argumentNode != nullptr)
+                        if (e != nullptr)
                         {
-                            const char* argDirection =
-                                argumentNode->Attribute("direction");
-                            const char* argType =
-                                argumentNode->Attribute("type");
-                            if (argDirection != nullptr && argType != nullptr &&
-                                std::string(argDirection) == "in")
-                            {
-                                if (argIt == transaction->arguments.end())
-                                {
-                                    transaction->setErrorStatus(
-                                        "Invalid method args");
-                                    return;
-                                }
-                                if (convertJsonToDbus(m.get(),
-                                                      std::string(argType),
-                                                      *argIt) < 0)
-                                {
-                                    transaction->setErrorStatus(
-                                        "Invalid method arg type");
-                                    return;
-                                }
-
-                                argIt++;
-                            }
-                            argumentNode =
-                                argumentNode->NextSiblingElement("arg");
+                            setErrorResponse(
+                                transaction->res,
+                                boost::beast::http::status::bad_request,
+                                e->name, e->message);
                         }
-
-                        crow::connections::systemBus->async_send(
-                            m, [transaction,
-                                returnType](boost::system::error_code ec2,
-                                            sdbusplus::message_t& m2) {
-                            if (ec2)
-                            {
-                                transaction->methodFailed = true;
-                                const sd_bus_error* e = m2.get_error();
-
-                                if (e != nullptr)
-                                {
-                                    setErrorResponse(
-                                        transaction->res,
-                                        boost::beast::http::status::bad_request,
-                                        e->name, e->message);
-                                }
-                                else
-                                {
-                                    setErrorResponse(
-                                        transaction->res,
-                                        boost::beast::http::status::bad_request,
-                                        "Method call failed", methodFailedMsg);
-                                }
-                                return;
-                            }
-                            transaction->methodPassed = true;
-
-                            handleMethodResponse(transaction, m2, returnType);
-                        });
-                        break;
+                        else
+                        {
+                            setErrorResponse(
+                                transaction->res,
+                                boost::beast::http::status::bad_request,
+                                "Method call failed", methodFailedMsg);
+                        }
+                        return;
                     }
-                    methodNode = methodNode->NextSiblingElement("method");
-                }
+                    transaction->methodPassed = true;
+
+                    handleMethodResponse(transaction, m2, returnType);
+                });
+                break;
             }
-            interfaceNode = interfaceNode->NextSiblingElement("interface");
         }
-    },
-        connectionName, transaction->path,
-        "org.freedesktop.DBus.Introspectable", "Introspect");
+    });
 }
 
 inline void handleAction(const crow::Request& req,
@@ -1660,6 +1548,322 @@ inline void handleList(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
         depth, std::array<std::string, 0>());
 }
 
+inline void addPropertiesToJson(
+    const dbus::utility::DBusPropertiesMap& properties,
+    nlohmann::json& objectJson)
+{
+    for (const auto& [name, value] : properties)
+    {
+        nlohmann::json& propertyJson = objectJson[name];
+        std::visit(
+            [&propertyJson](auto&& val) {
+            if constexpr (std::is_same_v<std::decay_t<decltype(val)>,
+                                         sdbusplus::message::unix_fd>)
+            {
+                propertyJson = val.fd;
+            }
+            else
+            {
+                propertyJson = val;
+            }
+        },
+            value);
+    }
+}
+
+/**
+ * @brief An enumerate sent as newline delimited json, one
+ * {"<path>": {<properties>}} object per line.
+ *
+ * Rather than collecting every service's objects into one document, each
+ * GetManagedObjects reply is turned into lines that are written before the
+ * next call is made, so memory is bounded by the largest single reply and not
+ * by the size of the tree.  Objects no ObjectManager reported are then read
+ * with GetAll, one path at a time.  An object implemented by more than one
+ * service can appear on more than one line.
+ */
+class EnumerateStream : public std::enable_shared_from_this<EnumerateStream>
+{
+  public:
+    EnumerateStream(const std::string& objectPathIn,
+                    dbus::utility::MapperGetSubTreeResponse&& subtreeIn) :
+        objectPath(objectPathIn),
+        subtree(std::move(subtreeIn))
+    {
+        // Same choice of ObjectManagers as getObjectAndEnumerate()
+        boost::container::flat_map<std::string, std::string> connections;
+        for (const auto& [path, services] : subtree)
+        {
+            for (const auto& [service, interfaces] : services)
+            {
+                std::string& managerPath = connections[service];
+                if (std::find(interfaces.begin(), interfaces.end(),
+                              "org.freedesktop.DBus.ObjectManager") !=
+                    interfaces.end())
+                {
+                    managerPath = path;
+                }
+            }
+        }
+        for (auto& [service, managerPath] : connections)
+        {
+            pending.emplace_back(
+                ManagedObjectsCall{objectPath, managerPath, service});
+        }
+    }
+
+    // The body generator: sends the next reply's objects to done
+    void next(crow::Response::BodyChunkHandler&& done)
+    {
+        if (pending.empty())
+        {
+            readRemaining(std::move(done));
+            return;
+        }
+        ManagedObjectsCall call = std::move(pending.front());
+        pending.pop_front();
+        if (call.managerPath.empty())
+        {
+            findObjectManager(std::move(call), std::move(done));
+            return;
+        }
+        getManagedObjects(call, std::move(done));
+    }
+
+  private:
+    struct ManagedObjectsCall
+    {
+        std::string objectName;
+        std::string managerPath;
+        std::string connection;
+    };
+
+    static void appendLine(std::string& out, const std::string& path,
+                           nlohmann::json&& objectJson)
+    {
+        nlohmann::json line = nlohmann::json::object();
+        line[path] = std::move(objectJson);
+        out += line.dump(-1, ' ', true,
+                         nlohmann::json::error_handler_t::replace);
+        out += '\n';
+    }
+
+    static void post(crow::Response::BodyChunkHandler&& done,
+                     std::string&& chunk, bool more)
+    {
+        boost::asio::post(crow::connections::systemBus->get_io_context(),
+                          [done{std::move(done)}, chunk{std::move(chunk)},
+                           more]() mutable { done(std::move(chunk), more); });
+    }
+
+    void findObjectManager(ManagedObjectsCall&& call,
+                           crow::Response::BodyChunkHandler&& done)
+    {
+        crow::connections::systemBus->async_method_call(
+            [self(shared_from_this()), call, done{std::move(done)}](
+                const boost::system::error_code& ec,
+                const dbus::utility::MapperGetAncestorsResponse&
+                    objects) mutable {
+            if (ec)
+            {
+                BMCWEB_LOG_ERROR << "GetAncestors on path " << call.objectName
+                                 << " failed with code " << ec;
+                done("", true);
+                return;
+            }
+            for (const auto& [path, services] : objects)
+            {
+                for (const auto& service : services)
+                {
+                    if (service.first == call.connection)
+                    {
+                        call.managerPath = path;
+                        self->getManagedObjects(call, std::move(done));
+                        return;
+                    }
+                }
+            }
+            done("", true);
+        },
+            "xyz.openbmc_project.ObjectMapper",
+            "/xyz/openbmc_project/object_mapper",
+            "xyz.openbmc_project.ObjectMapper", "GetAncestors", call.objectName,
+            std::array<const char*, 1>{"org.freedesktop.DBus.ObjectManager"});
+    }
+
+    void getManagedObjects(const ManagedObjectsCall& call,
+                           crow::Response::BodyChunkHandler&& done)
+    {
+        crow::connections::systemBus->async_method_call(
+            [self(shared_from_this()), call, done{std::move(done)}](
+                const boost::system::error_code& ec,
+                const dbus::utility::ManagedObjectType& objects) {
+            if (ec)
+            {
+                BMCWEB_LOG_ERROR << "GetManagedObjects on path "
+                                 << call.objectName << " on connection "
+                                 << call.connection << " failed with code "
+                                 << ec;
+                done("", true);
+                return;
+            }
+            std::string out;
+            for (const auto& [path, interfaces] : objects)
+            {
+                if (path.str.starts_with(call.objectName))
+                {
+                    nlohmann::json objectJson = nlohmann::json::object();
+                    for (const auto& interface : interfaces)
+                    {
+                        addPropertiesToJson(interface.second, objectJson);
+                    }
+                    appendLine(out, path.str, std::move(objectJson));
+                    self->reported.insert(path.str);
+                }
+                for (const auto& interface : interfaces)
+                {
+                    if (interface.first == "org.freedesktop.DBus.ObjectManager")
+                    {
+                        self->pending.emplace_back(ManagedObjectsCall{
+                            path.str, path.str, call.connection});
+                    }
+                }
+            }
+            done(std::move(out), true);
+        },
+            call.connection, call.managerPath,
+            "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
+    }
+
+    // Reads the next object no ObjectManager reported, the way
+    // findRemainingObjectsForEnumerate() does
+    void readRemaining(crow::Response::BodyChunkHandler&& done)
+    {
+        while (nextRemaining < subtree.size())
+        {
+            const auto& [path, services] = subtree[nextRemaining++];
+            if (path == objectPath || reported.contains(path))
+            {
+                continue;
+            }
+            std::vector<std::pair<std::string, std::string>> reads;
+            for (const auto& [service, interfaces] : services)
+            {
+                for (const std::string& interface : interfaces)
+                {
+                    if (!interface.starts_with("org.freedesktop.DBus"))
+                    {
+                        reads.emplace_back(service, interface);
+                    }
+                }
+            }
+            if (reads.empty())
+            {
+                continue;
+            }
+
+            auto object = std::make_shared<RemainingObject>();
+            object->path = path;
+            object->outstanding = reads.size();
+            object->done = std::move(done);
+            for (const auto& [service, interface] : reads)
+            {
+                sdbusplus::asio::getAllProperties(
+                    *crow::connections::systemBus, service, path, interface,
+                    [object](const boost::system::error_code& ec,
+                             const dbus::utility::DBusPropertiesMap&
+                                 properties) {
+                    if (ec)
+                    {
+                        BMCWEB_LOG_ERROR << "GetAll on path " << object->path
+                                         << " failed with code " << ec;
+                    }
+                    else
+                    {
+                        addPropertiesToJson(properties, object->properties);
+                    }
+                    if (--object->outstanding == 0)
+                    {
+                        std::string out;
+                        appendLine(out, object->path,
+                                   std::move(object->properties));
+                        object->done(std::move(out), true);
+                    }
+                });
+            }
+            return;
+        }
+        post(std::move(done), "", false);
+    }
+
+    struct RemainingObject
+    {
+        std::string path;
+        nlohmann::json properties = nlohmann::json::object();
+        size_t outstanding = 0;
+        crow::Response::BodyChunkHandler done;
+    };
+
+    const std::string objectPath;
+    const dbus::utility::MapperGetSubTreeResponse subtree;
+    std::deque<ManagedObjectsCall> pending;
+    std::unordered_set<std::string> reported;
+    size_t nextRemaining = 0;
+};
+
+// handleEnumerate(), streamed as newline delimited json
+inline void
+    handleEnumerateStream(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+                          const std::string& objectPath)
+{
+    BMCWEB_LOG_DEBUG << "Doing streamed enumerate on " << objectPath;
+
+    crow::connections::systemBus->async_method_call(
+        [objectPath, asyncResp](
+            const boost::system::error_code& ec,
+            const dbus::utility::MapperGetSubTreeResponse& objectNames) {
+        if (ec)
+        {
+            BMCWEB_LOG_ERROR << "GetSubTree failed on " << objectPath;
+            setErrorResponse(asyncResp->res,
+                             boost::beast::http::status::not_found,
+                             notFoundDesc, notFoundMsg);
+            return;
+        }
+        crow::connections::systemBus->async_method_call(
+            [objectPath, asyncResp, subtree{objectNames}](
+                const boost::system::error_code& ec2,
+                const dbus::utility::MapperGetObject& objects) mutable {
+            if (ec2)
+            {
+                BMCWEB_LOG_ERROR << "GetObject for path " << objectPath
+                                 << " failed with code " << ec2;
+                return;
+            }
+            if (!objects.empty())
+            {
+                subtree.emplace_back(objectPath, objects);
+            }
+            auto stream = std::make_shared<EnumerateStream>(objectPath,
+                                                            std::move(subtree));
+            asyncResp->res.addHeader(boost::beast::http::field::content_type,
+                                     "application/x-ndjson");
+            asyncResp->res.setAsyncBodyGenerator(
+                [stream](crow::Response::BodyChunkHandler&& done) {
+                stream->next(std::move(done));
+            });
+        },
+            "xyz.openbmc_project.ObjectMapper",
+            "/xyz/openbmc_project/object_mapper",
+            "xyz.openbmc_project.ObjectMapper", "GetObject", objectPath,
+            std::array<const char*, 0>());
+    },
+        "xyz.openbmc_project.ObjectMapper",
+        "/xyz/openbmc_project/object_mapper",
+        "xyz.openbmc_project.ObjectMapper", "GetSubTree", objectPath, 0,
+        std::array<const char*, 0>());
+}
+
 inline void handleEnumerate(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
                             const std::string& objectPath)
 {
@@ -1893,10 +2097,12 @@ inline void handlePut(const crow::Request& req,
         {
             const std::string& connectionName = connection.first;
 
-            crow::connections::systemBus->async_method_call(
-                [connectionName{std::string(connectionName)},
-                 transaction](const boost::system::error_code ec3,
-                              const std::string& introspectXml) {
+            dbus::utility::IntrospectCache::getInstance().get(
+                connectionName, transaction->objectPath,
+                [connectionName{std::string(connectionName)}, transaction](
+                    const boost::system::error_code& ec3,
+                    const std::shared_ptr<const dbus::utility::IntrospectData>&
+                        data) {
                 if (ec3)
                 {
                     BMCWEB_LOG_ERROR << "Introspect call failed with error: "
@@ -1905,115 +2111,87 @@ inline void handlePut(const crow::Request& req,
                     transaction->setErrorStatus("Unexpected Error");
                     return;
                 }
-                tinyxml2::XMLDocument doc;
-
-                doc.Parse(introspectXml.c_str());
-                tinyxml2::XMLNode* pRoot = doc.FirstChildElement("node");
-                if (pRoot == nullptr)
+                if (data == nullptr)
                 {
-                    BMCWEB_LOG_ERROR << "XML document failed to parse: "
-                                     << introspectXml;
                     transaction->setErrorStatus("Unexpected Error");
                     return;
                 }
-                tinyxml2::XMLElement* ifaceNode =
-                    pRoot->FirstChildElement("interface");
-                while (ifaceNode != nullptr)
+                for (const dbus::utility::IntrospectInterface& interface :
+                     data->interfaces)
                 {
-                    const char* interfaceName = ifaceNode->Attribute("name");
-                    BMCWEB_LOG_DEBUG << "found interface " << interfaceName;
-                    tinyxml2::XMLElement* propNode =
-                        ifaceNode->FirstChildElement("property");
-                    while (propNode != nullptr)
+                    BMCWEB_LOG_DEBUG << "found interface " << interface.name;
+                    for (const dbus::utility::IntrospectProperty& property :
+                         interface.properties)
                     {
-                        const char* propertyName = propNode->Attribute("name");
-                        BMCWEB_LOG_DEBUG << "Found property " << propertyName;
-                        if (propertyName == transaction->propertyName)
+                        BMCWEB_LOG_DEBUG << "Found property " << property.name;
+                        if (property.name != transaction->propertyName)
                         {
-                            const char* argType = propNode->Attribute("type");
-                            if (argType != nullptr)
+                            continue;
+                        }
+                        const char* argType = property.type.c_str();
+                        sdbusplus::message_t m =
+                            crow::connections::systemBus->new_method_call(
+                                connectionName.c_str(),
+                                transaction->objectPath.c_str(),
+                                "org.freedesktop.DBus.Properties", "Set");
+                        m.append(interface.name, transaction->propertyName);
+                        int r = sd_bus_message_open_container(
+                            m.get(), SD_BUS_TYPE_VARIANT, argType);
+                        if (r < 0)
+                        {
+                            transaction->setErrorStatus("Unexpected Error");
+                            return;
+                        }
+                        r = convertJsonToDbus(m.get(), property.type,
+                                              transaction->propertyValue);
+                        if (r < 0)
+                        {
+                            if (r == -ERANGE)
                             {
-                                sdbusplus::message_t m =
-                                    crow::connections::systemBus
-                                        ->new_method_call(
-                                            connectionName.c_str(),
-                                            transaction->objectPath.c_str(),
-                                            "org.freedesktop.DBus."
-                                            "Properties",
-                                            "Set");
-                                m.append(interfaceName,
-                                         transaction->propertyName);
-                                int r = sd_bus_message_open_container(
-                                    m.get(), SD_BUS_TYPE_VARIANT, argType);
-                                if (r < 0)
-                                {
-                                    transaction->setErrorStatus(
-                                        "Unexpected Error");
-                                    return;
-                                }
-                                r = convertJsonToDbus(
-                                    m.get(), argType,
-                                    transaction->propertyValue);
-                                if (r < 0)
-                                {
-                                    if (r == -ERANGE)
-                                    {
-                                        transaction->setErrorStatus(
-                                            "Provided property value "
-                                            "is out of range for the "
-                                            "property type");
-                                    }
-                                    else
-                                    {
-                                        transaction->setErrorStatus(
-                                            "Invalid arg type");
-                                    }
-                                    return;
-                                }
-                                r = sd_bus_message_close_container(m.get());
-                                if (r < 0)
-                                {
-                                    transaction->setErrorStatus(
-                                        "Unexpected Error");
-                                    return;
-                                }
-                                crow::connections::systemBus->async_send(
-                                    m,
-                                    [transaction](boost::system::error_code ec,
-                                                  sdbusplus::message_t& m2) {
-                                    BMCWEB_LOG_DEBUG << "sent";
-                                    if (ec)
-                                    {
-                                        const sd_bus_error* e = m2.get_error();
-                                        setErrorResponse(
-                                            transaction->asyncResp->res,
-                                            boost::beast::http::status::
-                                                forbidden,
-                                            (e) != nullptr
-                                                ? e->name
-                                                : ec.category().name(),
-                                            (e) != nullptr ? e->message
-                                                           : ec.message());
-                                    }
-                                    else
-                                    {
-                                        transaction->asyncResp->res
-                                            .jsonValue["status"] = "ok";
-                                        transaction->asyncResp->res
-                                            .jsonValue["message"] = "200 OK";
-                                        transaction->asyncResp->res
-                                            .jsonValue["data"] = nullptr;
-                                    }
-                                });
+                                transaction->setErrorStatus(
+                                    "Provided property value "
+                                    "is out of range for the "
+                                    "property type");
+                            }
+                            else
+                            {
+                                transaction->setErrorStatus("Invalid arg type");
                             }
+                            return;
                         }
-                        propNode = propNode->NextSiblingElement("property");
+                        r = sd_bus_message_close_container(m.get());
+                        if (r < 0)
+                        {
+                            transaction->setErrorStatus("Unexpected Error");
+                            return;
+                        }
+                        crow::connections::systemBus->async_send(
+                            m, [transaction](boost::system::error_code ec,
+                                             sdbusplus::message_t& m2) {
+                            BMCWEB_LOG_DEBUG << "sent";
+                            if (ec)
+                            {
+                                const sd_bus_error* e = m2.get_error();
+                                setErrorResponse(
+                                    transaction->asyncResp->res,
+                                    boost::beast::http::status::forbidden,
+                                    (e) != nullptr ? e->name
+                                                   : ec.category().name(),
+                                    (e) != nullptr ? e->message : ec.message());
+                            }
+                            else
+                            {
+                                transaction->asyncResp->res
+                                    .jsonValue["status"] = "ok";
+                                transaction->asyncResp->res
+                                    .jsonValue["message"] = "200 OK";
+                                transaction->asyncResp->res.jsonValue["data"] =
+                                    nullptr;
+                            }
+                        });
                     }
-                    ifaceNode = ifaceNode->NextSiblingElement("interface");
                 }
-            },
-                connectionName, transaction->objectPath,
-                "org.freedesktop.DBus.Introspectable", "Introspect");
+            });
         }
     },
         "xyz.openbmc_project.ObjectMapper",
@@ -2058,7 +2236,16 @@ inline void handleDBusUrl(const crow::Request& req,
         {
             objectPath.erase(objectPath.end() - sizeof("enumerate"),
                              objectPath.end());
-            handleEnumerate(asyncResp, objectPath);
+            if (http_helpers::isContentTypeAllowed(
+                    req.getHeaderValue("Accept"),
+                    http_helpers::ContentType::NDJSON, false))
+            {
+                handleEnumerateStream(asyncResp, objectPath);
+            }
+            else
+            {
+                handleEnumerate(asyncResp, objectPath);
+            }
         }
         else if (objectPath.ends_with("/list"))
         {
@@ -2152,10 +2339,12 @@ inline void
     }
     if (interfaceName.empty())
     {
-        crow::connections::systemBus->async_method_call(
-            [asyncResp, processName,
-             objectPath](const boost::system::error_code ec,
-                         const std::string& introspectXml) {
+        dbus::utility::IntrospectCache::getInstance().get(
+            processName, objectPath,
+            [asyncResp, processName, objectPath](
+                const boost::system::error_code& ec,
+                const std::shared_ptr<const dbus::utility::IntrospectData>&
+                    data) {
             if (ec)
             {
                 BMCWEB_LOG_ERROR
@@ -2164,21 +2353,14 @@ inline void
                     << "\n";
                 return;
             }
-            tinyxml2::XMLDocument doc;
-
-            doc.Parse(introspectXml.c_str());
-            tinyxml2::XMLNode* pRoot = doc.FirstChildElement("node");
-            if (pRoot == nullptr)
+            if (data == nullptr)
             {
-                BMCWEB_LOG_ERROR << "XML document failed to parse "
-                                 << processName << " " << objectPath << "\n";
                 asyncResp->res.jsonValue["status"] = "XML parse error";
                 asyncResp->res.result(
                     boost::beast::http::status::internal_server_error);
                 return;
             }
 
-            BMCWEB_LOG_DEBUG << introspectXml;
             asyncResp->res.jsonValue["status"] = "ok";
             asyncResp->res.jsonValue["bus_name"] = processName;
             asyncResp->res.jsonValue["object_path"] = objectPath;
@@ -2186,31 +2368,23 @@ inline void
             nlohmann::json& interfacesArray =
                 asyncResp->res.jsonValue["interfaces"];
             interfacesArray = nlohmann::json::array();
-            tinyxml2::XMLElement* interface =
-                pRoot->FirstChildElement("interface");
-
-            while (interface != nullptr)
+            for (const dbus::utility::IntrospectInterface& interface :
+                 data->interfaces)
             {
-                const char* ifaceName = interface->Attribute("name");
-                if (ifaceName != nullptr)
-                {
-                    nlohmann::json::object_t interfaceObj;
-                    interfaceObj["name"] = ifaceName;
-                    interfacesArray.push_back(std::move(interfaceObj));
-                }
-
-                interface = interface->NextSiblingElement("interface");
+                nlohmann::json::object_t interfaceObj;
+                interfaceObj["name"] = interface.name;
+                interfacesArray.push_back(std::move(interfaceObj));
             }
-        },
-            processName, objectPath, "org.freedesktop.DBus.Introspectable",
-            "Introspect");
+        });
     }
     else if (methodName.empty())
     {
-        crow::connections::systemBus->async_method_call(
-            [asyncResp, processName, objectPath,
-             interfaceName](const boost::system::error_code ec,
-                            const std::string& introspectXml) {
+        dbus::utility::IntrospectCache::getInstance().get(
+            processName, objectPath,
+            [asyncResp, processName, objectPath, interfaceName](
+                const boost::system::error_code& ec,
+                const std::shared_ptr<const dbus::utility::IntrospectData>&
+                    data) {
             if (ec)
             {
                 BMCWEB_LOG_ERROR
@@ -2219,14 +2393,8 @@ inline void
                     << "\n";
                 return;
             }
-            tinyxml2::XMLDocument doc;
-
-            doc.Parse(introspectXml.data(), introspectXml.size());
-            tinyxml2::XMLNode* pRoot = doc.FirstChildElement("node");
-            if (pRoot == nullptr)
+            if (data == nullptr)
             {
-                BMCWEB_LOG_ERROR << "XML document failed to parse "
-                                 << processName << " " << objectPath << "\n";
                 asyncResp->res.result(
                     boost::beast::http::status::internal_server_error);
                 return;
@@ -2249,19 +2417,8 @@ inline void
 
             // if we know we're the only call, build the
             // json directly
-            tinyxml2::XMLElement* interface =
-                pRoot->FirstChildElement("interface");
-            while (interface != nullptr)
-            {
-                const char* ifaceName = interface->Attribute("name");
-
-                if (ifaceName != nullptr && ifaceName == interfaceName)
-                {
-                    break;
-                }
-
-                interface = interface->NextSiblingElement("interface");
-            }
+            const dbus::utility::IntrospectInterface* interface =
+                data->findInterface(interfaceName);
             if (interface == nullptr)
             {
                 // if we got to the end of the list and
@@ -2270,117 +2427,91 @@ inline void
                 return;
             }
 
-            tinyxml2::XMLElement* methods =
-                interface->FirstChildElement("method");
-            while (methods != nullptr)
+            for (const dbus::utility::IntrospectMember& method :
+                 interface->methods)
             {
                 nlohmann::json argsArray = nlohmann::json::array();
-                tinyxml2::XMLElement* arg = methods->FirstChildElement("arg");
-                while (arg != nullptr)
+                for (const dbus::utility::IntrospectArg& arg : method.args)
                 {
                     nlohmann::json thisArg;
-                    for (const char* fieldName : std::array<const char*, 3>{
-                             "name", "direction", "type"})
+                    if (!arg.name.empty())
                     {
-                        const char* fieldValue = arg->Attribute(fieldName);
-                        if (fieldValue != nullptr)
-                        {
-                            thisArg[fieldName] = fieldValue;
-                        }
+                        thisArg["name"] = arg.name;
+                    }
+                    if (!arg.direction.empty())
+                    {
+                        thisArg["direction"] = arg.direction;
+                    }
+                    if (!arg.type.empty())
+                    {
+                        thisArg["type"] = arg.type;
                     }
                     argsArray.push_back(std::move(thisArg));
-                    arg = arg->NextSiblingElement("arg");
                 }
 
-                const char* name = methods->Attribute("name");
-                if (name != nullptr)
-                {
-                    std::string uri;
-                    uri.reserve(14 + processName.size() + objectPath.size() +
-                                interfaceName.size() + strlen(name));
-                    uri += "/bus/system/";
-                    uri += processName;
-                    uri += objectPath;
-                    uri += "/";
-                    uri += interfaceName;
-                    uri += "/";
-                    uri += name;
+                std::string uri;
+                uri.reserve(14 + processName.size() + objectPath.size() +
+                            interfaceName.size() + method.name.size());
+                uri += "/bus/system/";
+                uri += processName;
+                uri += objectPath;
+                uri += "/";
+                uri += interfaceName;
+                uri += "/";
+                uri += method.name;
 
-                    nlohmann::json::object_t object;
-                    object["name"] = name;
-                    object["uri"] = std::move(uri);
-                    object["args"] = argsArray;
+                nlohmann::json::object_t object;
+                object["name"] = method.name;
+                object["uri"] = std::move(uri);
+                object["args"] = std::move(argsArray);
 
-                    methodsArray.push_back(std::move(object));
-                }
-                methods = methods->NextSiblingElement("method");
+                methodsArray.push_back(std::move(object));
             }
-            tinyxml2::XMLElement* signals =
-                interface->FirstChildElement("signal");
-            while (signals != nullptr)
+            for (const dbus::utility::IntrospectMember& signal :
+                 interface->signals)
             {
                 nlohmann::json argsArray = nlohmann::json::array();
-
-                tinyxml2::XMLElement* arg = signals->FirstChildElement("arg");
-                while (arg != nullptr)
+                for (const dbus::utility::IntrospectArg& arg : signal.args)
                 {
-                    const char* name = arg->Attribute("name");
-                    const char* type = arg->Attribute("type");
-                    if (name != nullptr && type != nullptr)
+                    if (!arg.name.empty() && !arg.type.empty())
                     {
                         argsArray.push_back({
-                            {"name", name},
-                            {"type", type},
+                            {"name", arg.name},
+                            {"type", arg.type},
                         });
                     }
-                    arg = arg->NextSiblingElement("arg");
-                }
-                const char* name = signals->Attribute("name");
-                if (name != nullptr)
-                {
-                    nlohmann::json::object_t object;
-                    object["name"] = name;
-                    object["args"] = argsArray;
-                    signalsArray.push_back(std::move(object));
                 }
-
-                signals = signals->NextSiblingElement("signal");
+                nlohmann::json::object_t object;
+                object["name"] = signal.name;
+                object["args"] = std::move(argsArray);
+                signalsArray.push_back(std::move(object));
             }
 
-            tinyxml2::XMLElement* property =
-                interface->FirstChildElement("property");
-            while (property != nullptr)
+            for (const dbus::utility::IntrospectProperty& property :
+                 interface->properties)
             {
-                const char* name = property->Attribute("name");
-                const char* type = property->Attribute("type");
-                if (type != nullptr && name != nullptr)
-                {
-                    sdbusplus::message_t m =
-                        crow::connections::systemBus->new_method_call(
-                            processName.c_str(), objectPath.c_str(),
-                            "org.freedesktop."
-                            "DBus."
-                            "Properties",
-                            "Get");
-                    m.append(interfaceName, name);
-                    nlohmann::json& propertyItem = propertiesObj[name];
-                    crow::connections::systemBus->async_send(
-                        m, [&propertyItem,
-                            asyncResp](const boost::system::error_code& e,
-                                       sdbusplus::message_t& msg) {
-                        if (e)
-                        {
-                            return;
-                        }
+                sdbusplus::message_t m =
+                    crow::connections::systemBus->new_method_call(
+                        processName.c_str(), objectPath.c_str(),
+                        "org.freedesktop."
+                        "DBus."
+                        "Properties",
+                        "Get");
+                m.append(interfaceName, property.name);
+                nlohmann::json& propertyItem = propertiesObj[property.name];
+                crow::connections::systemBus->async_send(
+                    m, [&propertyItem,
+                        asyncResp](const boost::system::error_code& e,
+                                   sdbusplus::message_t& msg) {
+                    if (e)
+                    {
+                        return;
+                    }
 
-                        convertDBusToJSON("v", msg, propertyItem);
-                    });
-                }
-                property = property->NextSiblingElement("property");
+                    convertDBusToJSON("v", msg, propertyItem);
+                });
             }
-        },
-            processName, objectPath, "org.freedesktop.DBus.Introspectable",
-            "Introspect");
+        });
     }
     else
     {
@@ -2535,12 +2666,6 @@ inline void requestRoutes(App& app)
 
         for (const auto& file : files)
         {
-            std::ifstream readFile(file.path());
-            if (!readFile.good())
-            {
-                continue;
-            }
-
             asyncResp->res.addHeader(boost::beast::http::field::content_type,
                                      "application/octet-stream");
 
@@ -2565,8 +2690,11 @@ inline void requestRoutes(App& app)
                 boost::beast::http::field::content_disposition,
                 contentDispositionParam);
 
-            asyncResp->res.body() = {std::istreambuf_iterator<char>(readFile),
-                                     std::istreambuf_iterator<char>()};
+            if (!asyncResp->res.openFile(file.path()))
+            {
+                asyncResp->res.result(
+                    boost::beast::http::status::internal_server_error);
+            }
             return;
         }
         asyncResp->res.result(boost::beast::http::status::not_found);
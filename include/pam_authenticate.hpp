@@ -3,9 +3,12 @@
 #include <security/pam_appl.h>
 
 #include <boost/utility/string_view.hpp>
+#include <worker_pool.hpp>
 
 #include <cstring>
 #include <memory>
+#include <string>
+#include <utility>
 
 // function used to get user input
 inline int pamFunctionConversation(int numMsg, const struct pam_message** msg,
@@ -121,6 +124,30 @@ inline int pamAuthenticateUser(const std::string_view username,
     return pam_end(localAuthHandle, PAM_SUCCESS);
 }
 
+/**
+ * @brief pamAuthenticateUser, run on a worker thread when bmcweb has them.
+ *
+ * pam_unix hashing and LDAP lookups can take hundreds of milliseconds, which
+ * would otherwise stall every other connection.  The PAM conversation only
+ * touches the strings it is given, so it is safe to run off the event loop.
+ * @param ex Executor the handler is posted to.
+ * @param handler Called as handler(int pamrc) on ex. */
+template <typename Executor, typename Handler>
+inline void pamAuthenticateUserAsync(const Executor& ex, std::string username,
+                                     std::string password, Handler&& handler)
+{
+    auto pamrc = std::make_shared<int>(PAM_SYSTEM_ERR);
+    crow::worker_pool::offload(
+        ex,
+        [pamrc, username{std::move(username)},
+         password{std::move(password)}]() {
+        *pamrc = pamAuthenticateUser(username, password);
+    },
+        [pamrc, handler{std::forward<Handler>(handler)}]() mutable {
+        handler(*pamrc);
+    });
+}
+
 inline int pamUpdatePassword(const std::string& username,
                              const std::string& password)
 {
@@ -147,3 +174,24 @@ inline int pamUpdatePassword(const std::string& username,
 
     return pam_end(localAuthHandle, PAM_SUCCESS);
 }
+
+/**
+ * @brief pamUpdatePassword, run on a worker thread when bmcweb has them, as
+ * it hashes the password the same way authentication does.
+ * @param ex Executor the handler is posted to.
+ * @param handler Called as handler(int pamrc) on ex. */
+template <typename Executor, typename Handler>
+inline void pamUpdatePasswordAsync(const Executor& ex, std::string username,
+                                   std::string password, Handler&& handler)
+{
+    auto pamrc = std::make_shared<int>(PAM_SYSTEM_ERR);
+    crow::worker_pool::offload(
+        ex,
+        [pamrc, username{std::move(username)},
+         password{std::move(password)}]() {
+        *pamrc = pamUpdatePassword(username, password);
+    },
+        [pamrc, handler{std::forward<Handler>(handler)}]() mutable {
+        handler(*pamrc);
+    });
+}
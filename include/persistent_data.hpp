@@ -1,6 +1,13 @@
 #pragma once
 
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <app.hpp>
+#include <async_file.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <boost/beast/http/fields.hpp>
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_generators.hpp>
@@ -11,23 +18,83 @@
 #include <nlohmann/json.hpp>
 #include <sessions.hpp>
 
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <memory>
 #include <random>
+#include <string>
+#include <string_view>
 
 namespace persistent_data
 {
 
+/**
+ * @brief Replaces path with contents, mode 640.  The data is written to a
+ * temporary file and synced before being renamed over path, so a crash or
+ * power loss leaves either the old file or the new one, never a torn one.
+ */
+inline bool writeFileAtomically(const std::string& path,
+                                std::string_view contents)
+{
+    std::string tmpPath = path + ".tmp";
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+    int fd = open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                  S_IRUSR | S_IWUSR | S_IRGRP);
+    if (fd < 0)
+    {
+        BMCWEB_LOG_ERROR << "Failed to open " << tmpPath << ": "
+                         << std::strerror(errno);
+        return false;
+    }
+    bool ok = fchmod(fd, S_IRUSR | S_IWUSR | S_IRGRP) == 0;
+    while (ok && !contents.empty())
+    {
+        ssize_t written = write(fd, contents.data(), contents.size());
+        if (written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (written <= 0)
+        {
+            ok = false;
+            break;
+        }
+        contents.remove_prefix(static_cast<size_t>(written));
+    }
+    ok = ok && fsync(fd) == 0;
+    ok = (close(fd) == 0) && ok;
+    if (!ok || std::rename(tmpPath.c_str(), path.c_str()) != 0)
+    {
+        BMCWEB_LOG_ERROR << "Failed to write " << path << ": "
+                         << std::strerror(errno);
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
 class ConfigFile
 {
-    uint64_t jsonRevision = 1;
+    // 2 moved sessions out to sessionsFilename
+    uint64_t jsonRevision = 2;
 
   public:
     // todo(ed) should read this from a fixed location somewhere, not CWD
     static constexpr const char* filename = "bmcweb_persistent_data.json";
+    // Sessions change far more often than anything else, so they're kept
+    // apart and rewriting them leaves the rest of the configuration alone
+    static constexpr const char* sessionsFilename =
+        "bmcweb_persistent_sessions.json";
     static constexpr const char* dumpFilename =
         "bmcweb_current_session_snapshot.json";
 
+    // How long scheduled writes wait, so a burst of changes is written once
+    static constexpr std::chrono::seconds writeDelay{5};
+
     ConfigFile()
     {
         readData();
@@ -35,12 +102,8 @@ class ConfigFile
 
     ~ConfigFile()
     {
-        // Make sure we aren't writing stale sessions
-        persistent_data::SessionStore::getInstance().applySessionTimeouts();
-        if (persistent_data::SessionStore::getInstance().needsWrite())
-        {
-            writeData();
-        }
+        SessionStore::getInstance().setWriteHandler(nullptr);
+        flush();
     }
 
     ConfigFile(const ConfigFile&) = delete;
@@ -48,6 +111,58 @@ class ConfigFile
     ConfigFile& operator=(const ConfigFile&) = delete;
     ConfigFile& operator=(ConfigFile&&) = delete;
 
+    /**
+     * @brief Starts coalescing writes on io.  Until then, and after
+     * stopWriteTimer(), scheduled writes happen immediately and session
+     * changes are only written by flush().
+     */
+    void startWriteTimer(boost::asio::io_context& ioIn)
+    {
+        io = &ioIn;
+        SessionStore::getInstance().setWriteHandler(
+            [this]() { armWriteTimer(); });
+        if (configDirty || SessionStore::getInstance().needsWrite())
+        {
+            armWriteTimer();
+        }
+    }
+
+    // Writes anything pending; must be called before io is destroyed
+    void stopWriteTimer()
+    {
+        SessionStore::getInstance().setWriteHandler(nullptr);
+        io = nullptr;
+        flush();
+    }
+
+    // Writes the configuration once writeDelay has passed
+    void scheduleWrite()
+    {
+        configDirty = true;
+        if (io == nullptr)
+        {
+            flush();
+            return;
+        }
+        armWriteTimer();
+    }
+
+    // Writes whichever files have pending changes now
+    void flush()
+    {
+        SessionStore& store = SessionStore::getInstance();
+        if (configDirty || store.needConfigWrite)
+        {
+            writeData();
+        }
+        if (store.needWrite)
+        {
+            // Make sure we aren't writing stale sessions
+            store.applySessionTimeouts();
+            writeSessions();
+        }
+    }
+
     // TODO(ed) this should really use protobuf, or some other serialization
     // library, but adding another dependency is somewhat outside the scope of
     // this application for the moment
@@ -94,9 +209,8 @@ class ConfigFile
                     }
                     else if (item.key() == "auth_config")
                     {
-                        SessionStore::getInstance()
-                            .getAuthMethodsConfig()
-                            .fromJson(item.value());
+                        SessionStore::getInstance().loadAuthMethodsConfig(
+                            item.value());
                     }
                     else if (item.key() == "sessions")
                     {
@@ -116,8 +230,8 @@ class ConfigFile
                                 << "Restored session: " << newSession->csrfToken
                                 << " " << newSession->uniqueId << " "
                                 << newSession->sessionToken;
-                            SessionStore::getInstance().authTokens.emplace(
-                                newSession->sessionToken, newSession);
+                            SessionStore::getInstance().addSession(
+                                newSession);
                         }
                     }
                     else if (item.key() == "timeout")
@@ -176,6 +290,10 @@ class ConfigFile
                 }
             }
         }
+        bool sessionsInMainFile =
+            !SessionStore::getInstance().authTokens.empty();
+        readSessions();
+
         bool needWrite = false;
 
         if (systemUuid.empty())
@@ -193,6 +311,46 @@ class ConfigFile
         {
             writeData();
         }
+        // Sessions read from an older main file move to their own
+        if (sessionsInMainFile)
+        {
+            writeSessions();
+        }
+        SessionStore::getInstance().needWrite = false;
+        SessionStore::getInstance().needConfigWrite = false;
+    }
+
+    void readSessions()
+    {
+        std::ifstream sessionsFile(sessionsFilename);
+        if (!sessionsFile.is_open())
+        {
+            return;
+        }
+        auto data = nlohmann::json::parse(sessionsFile, nullptr, false);
+        if (data.is_discarded() || !data.is_object())
+        {
+            BMCWEB_LOG_ERROR << "Error parsing persistent sessions file.";
+            return;
+        }
+        auto sessions = data.find("sessions");
+        if (sessions == data.end())
+        {
+            return;
+        }
+        for (const auto& elem : *sessions)
+        {
+            std::shared_ptr<UserSession> newSession =
+                UserSession::fromJson(elem);
+            if (newSession == nullptr)
+            {
+                BMCWEB_LOG_ERROR << "Problem reading session "
+                                    "from persistent store";
+                continue;
+            }
+            BMCWEB_LOG_DEBUG << "Restored session: " << newSession->uniqueId;
+            SessionStore::getInstance().addSession(newSession);
+        }
     }
 
 #ifdef BMCWEB_ENABLE_IBM_MANAGEMENT_CONSOLE
@@ -272,33 +430,33 @@ class ConfigFile
                 {"ResourceTypes", subValue->resourceTypes},
                 {"SubscriptionType", subValue->subscriptionType},
                 {"MetricReportDefinitions", subValue->metricReportDefinitions},
+                {"MetricAggregationFunction",
+                 subValue->metricAggregationFunction},
+                {"MetricAggregationIntervalMs",
+                 subValue->metricAggregationIntervalMs},
             });
         }
         persistentFile << data;
     }
 #endif
 
+    // Writes everything but the sessions, starting now
     void writeData()
     {
-        std::ofstream persistentFile(filename);
-
-        // set the permission of the file to 640
-        std::filesystem::perms permission =
-            std::filesystem::perms::owner_read |
-            std::filesystem::perms::owner_write |
-            std::filesystem::perms::group_read;
-        std::filesystem::permissions(filename, permission);
-        const auto& c = SessionStore::getInstance().getAuthMethodsConfig();
+        configDirty = false;
+        SessionStore::getInstance().needConfigWrite = false;
+        std::shared_ptr<const AuthConfigMethods> c =
+            SessionStore::getInstance().getAuthMethodsConfig();
         const auto& eventServiceConfig =
             EventServiceStore::getInstance().getEventServiceConfig();
         nlohmann::json::object_t data;
         nlohmann::json& authConfig = data["auth_config"];
 
-        authConfig["XToken"] = c.xtoken;
-        authConfig["Cookie"] = c.cookie;
-        authConfig["SessionToken"] = c.sessionToken;
-        authConfig["BasicAuth"] = c.basic;
-        authConfig["TLS"] = c.tls;
+        authConfig["XToken"] = c->xtoken;
+        authConfig["Cookie"] = c->cookie;
+        authConfig["SessionToken"] = c->sessionToken;
+        authConfig["BasicAuth"] = c->basic;
+        authConfig["TLS"] = c->tls;
 
         nlohmann::json& eventserviceConfig = data["eventservice_config"];
         eventserviceConfig["ServiceEnabled"] = eventServiceConfig.enabled;
@@ -311,26 +469,6 @@ class ConfigFile
         data["revision"] = jsonRevision;
         data["timeout"] = SessionStore::getInstance().getTimeoutInSeconds();
 
-        nlohmann::json& sessions = data["sessions"];
-        sessions = nlohmann::json::array();
-        for (const auto& p : SessionStore::getInstance().authTokens)
-        {
-            if (p.second->persistence !=
-                persistent_data::PersistenceType::SINGLE_REQUEST)
-            {
-                nlohmann::json::object_t session;
-                session["unique_id"] = p.second->uniqueId;
-                session["session_token"] = p.second->sessionToken;
-                session["username"] = p.second->username;
-                session["csrf_token"] = p.second->csrfToken;
-                session["client_ip"] = p.second->clientIp;
-                if (p.second->clientId)
-                {
-                    session["client_id"] = *p.second->clientId;
-                }
-                sessions.push_back(std::move(session));
-            }
-        }
         nlohmann::json& subscriptions = data["subscriptions"];
         subscriptions = nlohmann::json::array();
         for (const auto& it :
@@ -370,13 +508,92 @@ class ConfigFile
             subscription["SubscriptionType"] = subValue->subscriptionType;
             subscription["MetricReportDefinitions"] =
                 subValue->metricReportDefinitions;
+            subscription["MetricAggregationFunction"] =
+                subValue->metricAggregationFunction;
+            subscription["MetricAggregationIntervalMs"] =
+                subValue->metricAggregationIntervalMs;
 
             subscriptions.push_back(std::move(subscription));
         }
-        persistentFile << data;
+        writeFile(configWriter, dumpJson(data));
+    }
+
+    // Writes the sessions that outlive a single request, starting now
+    void writeSessions()
+    {
+        SessionStore::getInstance().needWrite = false;
+        nlohmann::json::object_t data;
+        nlohmann::json& sessions = data["sessions"];
+        sessions = nlohmann::json::array();
+        for (const auto& p : SessionStore::getInstance().authTokens)
+        {
+            if (p.second->persistence !=
+                persistent_data::PersistenceType::SINGLE_REQUEST)
+            {
+                nlohmann::json::object_t session;
+                session["unique_id"] = p.second->uniqueId;
+                session["session_token"] = p.second->sessionToken;
+                session["username"] = p.second->username;
+                session["csrf_token"] = p.second->csrfToken;
+                session["client_ip"] = p.second->clientIp;
+                if (p.second->clientId)
+                {
+                    session["client_id"] = *p.second->clientId;
+                }
+                sessions.push_back(std::move(session));
+            }
+        }
+        writeFile(sessionsWriter, dumpJson(data));
     }
 
     std::string systemUuid;
+
+  private:
+    static std::string dumpJson(const nlohmann::json& data)
+    {
+        return data.dump(-1, ' ', false,
+                         nlohmann::json::error_handler_t::replace);
+    }
+
+    // Writes on a worker thread while io is running, so fsync doesn't hold up
+    // requests, and before returning otherwise
+    void writeFile(crow::async_file::OrderedWriter& writer,
+                   std::string contents)
+    {
+        if (io == nullptr)
+        {
+            writer.writeNow(contents);
+            return;
+        }
+        writer.write(io->get_executor(), std::move(contents));
+    }
+
+    void armWriteTimer()
+    {
+        if (io == nullptr || writePending)
+        {
+            return;
+        }
+        writePending = true;
+        auto timer = std::make_shared<boost::asio::steady_timer>(*io);
+        timer->expires_after(writeDelay);
+        timer->async_wait([this, timer](const boost::system::error_code& ec) {
+            writePending = false;
+            if (ec)
+            {
+                return;
+            }
+            flush();
+        });
+    }
+
+    crow::async_file::OrderedWriter configWriter{filename,
+                                                 writeFileAtomically};
+    crow::async_file::OrderedWriter sessionsWriter{sessionsFilename,
+                                                   writeFileAtomically};
+    boost::asio::io_context* io = nullptr;
+    bool configDirty = false;
+    bool writePending = false;
 };
 
 inline ConfigFile& getConfig()
@@ -1,22 +1,53 @@
 #pragma once
 
+#include <openssl/crypto.h>
 #include <openssl/rand.h>
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <span>
+
 namespace bmcweb
 {
 
+/**
+ * @brief A random byte generator backed by RAND_bytes.
+ *
+ * Bytes are drawn from OpenSSL a batch at a time rather than one per call,
+ * as a session login draws a hundred or so.  A generator is meant to live
+ * for one operation; the unused part of its batch is wiped when it goes.
+ */
 struct OpenSSLGenerator
 {
+    OpenSSLGenerator() = default;
+    OpenSSLGenerator(const OpenSSLGenerator&) = delete;
+    OpenSSLGenerator(OpenSSLGenerator&&) = delete;
+    OpenSSLGenerator& operator=(const OpenSSLGenerator&) = delete;
+    OpenSSLGenerator& operator=(OpenSSLGenerator&&) = delete;
+
+    ~OpenSSLGenerator()
+    {
+        OPENSSL_cleanse(buffer.data(), buffer.size());
+    }
+
     uint8_t operator()()
     {
-        uint8_t index = 0;
-        int rc = RAND_bytes(&index, sizeof(index));
-        if (rc != opensslSuccess)
+        if (used == buffer.size())
         {
-            std::cerr << "Cannot get random number\n";
-            err = true;
+            int rc = RAND_bytes(buffer.data(), static_cast<int>(buffer.size()));
+            if (rc != opensslSuccess)
+            {
+                std::cerr << "Cannot get random number\n";
+                err = true;
+            }
+            used = 0;
         }
-
+        uint8_t index = buffer[used];
+        buffer[used] = 0;
+        used++;
         return index;
     }
 
@@ -40,7 +71,37 @@ struct OpenSSLGenerator
   private:
     // RAND_bytes() returns 1 on success, 0 otherwise. -1 if bad function
     static constexpr int opensslSuccess = 1;
+    std::array<uint8_t, 128> buffer{};
+    size_t used = buffer.size();
     bool err = false;
 };
 
+/**
+ * @brief Fills out with characters drawn uniformly from [0-9A-Za-z], as used
+ * for session tokens and ids.  Check gen.error() afterwards.
+ */
+template <typename Generator>
+inline void fillAlphanumeric(Generator& gen, std::span<char> out)
+{
+    static constexpr std::array<char, 62> alphanum = {
+        '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C',
+        'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P',
+        'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z', 'a', 'b', 'c',
+        'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o', 'p',
+        'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z'};
+    // Bytes at or above this would make the low characters more likely, so
+    // they're drawn again
+    static constexpr uint8_t limit = (256 / alphanum.size()) * alphanum.size();
+
+    for (char& c : out)
+    {
+        uint8_t byte = gen();
+        while (byte >= limit && !gen.error())
+        {
+            byte = gen();
+        }
+        c = alphanum[byte % alphanum.size()];
+    }
+}
+
 } // namespace bmcweb
@@ -2,110 +2,156 @@
 
 #include <bmcweb_config.h>
 
+#include <http_request.hpp>
 #include <http_response.hpp>
 
-inline void addSecurityHeaders(const crow::Request& req [[maybe_unused]],
-                               crow::Response& res)
+#include <array>
+#include <string_view>
+
+/**
+ * @brief A header added to every response.  The field is looked up from the
+ * name once, when the table is built, rather than on every response.
+ */
+struct StaticHeader
 {
-    /*
-     TODO(ed) these should really check content types.  for example,
-     X-Content-Type-Options header doesn't make sense when retrieving a JSON or
-     javascript file.  It doesn't hurt anything, it's just ugly.
-     */
-    using bf = boost::beast::http::field;
+    boost::beast::http::field field;
+    std::string_view name;
+    std::string_view value;
 
-    // Recommendations from https://owasp.org/www-project-secure-headers/
-    // https://owasp.org/www-project-secure-headers/ci/headers_add.json
-    res.addHeader(bf::strict_transport_security, "max-age=31536000; "
-                                                 "includeSubdomains");
-    res.addHeader(bf::x_frame_options, "DENY");
+    StaticHeader(std::string_view nameIn, std::string_view valueIn) :
+        field(boost::beast::http::string_to_field(nameIn)), name(nameIn),
+        value(valueIn)
+    {}
+};
 
-    res.addHeader(bf::pragma, "no-cache");
-    res.addHeader(bf::cache_control, "no-store, max-age=0");
+// Recommendations from https://owasp.org/www-project-secure-headers/
+// https://owasp.org/www-project-secure-headers/ci/headers_add.json
+constexpr std::string_view permissionsPolicy = "accelerometer=(),"
+                                               "ambient-light-sensor=(),"
+                                               "autoplay=(),"
+                                               "battery=(),"
+                                               "camera=(),"
+                                               "display-capture=(),"
+                                               "document-domain=(),"
+                                               "encrypted-media=(),"
+                                               "fullscreen=(),"
+                                               "gamepad=(),"
+                                               "geolocation=(),"
+                                               "gyroscope=(),"
+                                               "layout-animations=(self),"
+                                               "legacy-image-formats=(self),"
+                                               "magnetometer=(),"
+                                               "microphone=(),"
+                                               "midi=(),"
+                                               "oversized-images=(self),"
+                                               "payment=(),"
+                                               "picture-in-picture=(),"
+                                               "publickey-credentials-get=(),"
+                                               "speaker-selection=(),"
+                                               "sync-xhr=(self),"
+                                               "unoptimized-images=(self),"
+                                               "unsized-media=(self),"
+                                               "usb=(),"
+                                               "screen-wak-lock=(),"
+                                               "web-share=(),"
+                                               "xr-spatial-tracking=()";
 
-    res.addHeader("X-Content-Type-Options", "nosniff");
+// The KVM currently needs to load images from base64 encoded
+// strings. img-src 'self' data: is used to allow that.
+// https://stackoverflow.com/questions/18447970/content-security-polic
+// y-data-not-working-for-base64-images-in-chrome-28
+constexpr std::string_view contentSecurityPolicy = "default-src 'none'; "
+                                                   "img-src 'self' data:; "
+                                                   "font-src 'self'; "
+                                                   "style-src 'self'; "
+                                                   "script-src 'self'; "
+                                                   "connect-src 'self' wss:; "
+                                                   "form-action 'none'; "
+                                                   "frame-ancestors 'none'; "
+                                                   "object-src 'none'; "
+                                                   "base-uri 'none' ";
 
-    res.addHeader("Referrer-Policy", "no-referrer");
-    res.addHeader("Permissions-Policy", "accelerometer=(),"
-                                        "ambient-light-sensor=(),"
-                                        "autoplay=(),"
-                                        "battery=(),"
-                                        "camera=(),"
-                                        "display-capture=(),"
-                                        "document-domain=(),"
-                                        "encrypted-media=(),"
-                                        "fullscreen=(),"
-                                        "gamepad=(),"
-                                        "geolocation=(),"
-                                        "gyroscope=(),"
-                                        "layout-animations=(self),"
-                                        "legacy-image-formats=(self),"
-                                        "magnetometer=(),"
-                                        "microphone=(),"
-                                        "midi=(),"
-                                        "oversized-images=(self),"
-                                        "payment=(),"
-                                        "picture-in-picture=(),"
-                                        "publickey-credentials-get=(),"
-                                        "speaker-selection=(),"
-                                        "sync-xhr=(self),"
-                                        "unoptimized-images=(self),"
-                                        "unsized-media=(self),"
-                                        "usb=(),"
-                                        "screen-wak-lock=(),"
-                                        "web-share=(),"
-                                        "xr-spatial-tracking=()");
+// If XSS is disabled, we need to allow loading from addresses other
+// than self, as the BMC will be hosted elsewhere.
+constexpr std::string_view contentSecurityPolicyInsecure =
+    "default-src 'none'; "
+    "img-src *; "
+    "font-src *; "
+    "style-src *; "
+    "script-src *; "
+    "connect-src *; "
+    "form-action *; "
+    "frame-ancestors *; "
+    "object-src *; "
+    "base-uri *";
 
-    res.addHeader("X-Permitted-Cross-Domain-Policies", "none");
+/*
+ TODO(ed) these should really check content types.  for example,
+ X-Content-Type-Options header doesn't make sense when retrieving a JSON or
+ javascript file.  It doesn't hurt anything, it's just ugly.
+ */
+inline const std::array<StaticHeader, 12>& getSecurityHeaders()
+{
+    static const std::array<StaticHeader, 12> headers{{
+        {"Strict-Transport-Security", "max-age=31536000; includeSubdomains"},
+        {"X-Frame-Options", "DENY"},
+        {"Pragma", "no-cache"},
+        {"Cache-Control", "no-store, max-age=0"},
+        {"X-Content-Type-Options", "nosniff"},
+        {"Referrer-Policy", "no-referrer"},
+        {"Permissions-Policy", permissionsPolicy},
+        {"X-Permitted-Cross-Domain-Policies", "none"},
+        {"Cross-Origin-Embedder-Policy", "require-corp"},
+        {"Cross-Origin-Opener-Policy", "same-origin"},
+        {"Cross-Origin-Resource-Policy", "same-origin"},
+        {"Content-Security-Policy", bmcwebInsecureDisableXssPrevention == 0
+                                        ? contentSecurityPolicy
+                                        : contentSecurityPolicyInsecure},
+    }};
+    return headers;
+}
 
-    res.addHeader("Cross-Origin-Embedder-Policy", "require-corp");
-    res.addHeader("Cross-Origin-Opener-Policy", "same-origin");
-    res.addHeader("Cross-Origin-Resource-Policy", "same-origin");
+// CORS headers sent when XSS prevention is disabled; Access-Control-Allow-
+// Origin is added separately, as it echoes the request
+inline const std::array<StaticHeader, 3>& getCorsHeaders()
+{
+    static const std::array<StaticHeader, 3> headers{{
+        {"Access-Control-Allow-Methods", "GET, POST, PUT, PATCH, DELETE"},
+        {"Access-Control-Allow-Credentials", "true"},
+        {"Access-Control-Allow-Headers",
+         "Origin, Content-Type, Accept, Cookie, X-XSRF-TOKEN"},
+    }};
+    return headers;
+}
 
-    if (bmcwebInsecureDisableXssPrevention == 0)
+inline void addStaticHeader(crow::Response& res, const StaticHeader& header)
+{
+    if (header.field == boost::beast::http::field::unknown)
     {
-        res.addHeader("Content-Security-Policy", "default-src 'none'; "
-                                                 "img-src 'self' data:; "
-                                                 "font-src 'self'; "
-                                                 "style-src 'self'; "
-                                                 "script-src 'self'; "
-                                                 "connect-src 'self' wss:; "
-                                                 "form-action 'none'; "
-                                                 "frame-ancestors 'none'; "
-                                                 "object-src 'none'; "
-                                                 "base-uri 'none' ");
-        // The KVM currently needs to load images from base64 encoded
-        // strings. img-src 'self' data: is used to allow that.
-        // https://stackoverflow.com/questions/18447970/content-security-polic
-        // y-data-not-working-for-base64-images-in-chrome-28
+        // Handlers don't set any of the headers Beast doesn't know, so
+        // there's nothing to replace
+        res.stringResponse->insert(header.field, header.name, header.value);
+        return;
     }
-    else
+    res.addHeader(header.field, header.value);
+}
+
+inline void addSecurityHeaders(const crow::Request& req [[maybe_unused]],
+                               crow::Response& res)
+{
+    for (const StaticHeader& header : getSecurityHeaders())
     {
-        // If XSS is disabled, we need to allow loading from addresses other
-        // than self, as the BMC will be hosted elsewhere.
-        res.addHeader("Content-Security-Policy", "default-src 'none'; "
-                                                 "img-src *; "
-                                                 "font-src *; "
-                                                 "style-src *; "
-                                                 "script-src *; "
-                                                 "connect-src *; "
-                                                 "form-action *; "
-                                                 "frame-ancestors *; "
-                                                 "object-src *; "
-                                                 "base-uri *");
+        addStaticHeader(res, header);
+    }
 
+    if constexpr (bmcwebInsecureDisableXssPrevention != 0)
+    {
         const std::string_view origin = req.getHeaderValue("Origin");
-        res.addHeader(bf::access_control_allow_origin, origin);
-        res.addHeader(bf::access_control_allow_methods, "GET, "
-                                                        "POST, "
-                                                        "PUT, "
-                                                        "PATCH, "
-                                                        "DELETE");
-        res.addHeader(bf::access_control_allow_credentials, "true");
-        res.addHeader(bf::access_control_allow_headers, "Origin, "
-                                                        "Content-Type, "
-                                                        "Accept, "
-                                                        "Cookie, "
-                                                        "X-XSRF-TOKEN");
+        res.addHeader(boost::beast::http::field::access_control_allow_origin,
+                      origin);
+        for (const StaticHeader& header : getCorsHeaders())
+        {
+            addStaticHeader(res, header);
+        }
     }
 }
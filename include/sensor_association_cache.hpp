@@ -0,0 +1,358 @@
+#pragma once
+
+#include "dbus_singleton.hpp"
+#include "dbus_utility.hpp"
+#include "logging.hpp"
+
+#include <boost/asio/post.hpp>
+#include <sdbusplus/asio/connection.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace dbus
+{
+
+namespace utility
+{
+
+/**
+ * @brief The first endpoint of every <object>/inventory and <object>/leds
+ * association the ObjectMapper publishes, keyed by association path.
+ */
+class SensorAssociationGraph
+{
+  public:
+    static constexpr std::string_view associationInterface =
+        "xyz.openbmc_project.Association";
+
+    static bool isTracked(std::string_view path)
+    {
+        return path.ends_with("/inventory") || path.ends_with("/leds");
+    }
+
+    explicit SensorAssociationGraph(const ManagedObjectType& objects)
+    {
+        for (const auto& [path, interfaces] : objects)
+        {
+            update(path.str, interfaces);
+        }
+    }
+
+    // Inventory item the sensor at sensorPath belongs to, or nullptr
+    const std::string* inventoryForSensor(const std::string& sensorPath) const
+    {
+        return find(sensorPath + "/inventory");
+    }
+
+    // LED of the inventory item at inventoryPath, or nullptr
+    const std::string* ledForInventory(const std::string& inventoryPath) const
+    {
+        return find(inventoryPath + "/leds");
+    }
+
+    void update(const std::string& path, const DBusInteracesMap& interfaces)
+    {
+        for (const auto& [interface, properties] : interfaces)
+        {
+            if (interface == associationInterface)
+            {
+                update(path, properties);
+            }
+        }
+    }
+
+    void update(const std::string& path, const DBusPropertiesMap& properties)
+    {
+        if (!isTracked(path))
+        {
+            return;
+        }
+        for (const auto& [name, value] : properties)
+        {
+            if (name != "endpoints")
+            {
+                continue;
+            }
+            const std::vector<std::string>* endpoints =
+                std::get_if<std::vector<std::string>>(&value);
+            if (endpoints == nullptr || endpoints->empty())
+            {
+                firstEndpoint.erase(path);
+            }
+            else
+            {
+                firstEndpoint.insert_or_assign(path, endpoints->front());
+            }
+        }
+    }
+
+    void erase(const std::string& path)
+    {
+        firstEndpoint.erase(path);
+    }
+
+    size_t size() const
+    {
+        return firstEndpoint.size();
+    }
+
+  private:
+    const std::string* find(const std::string& associationPath) const
+    {
+        auto it = firstEndpoint.find(associationPath);
+        if (it == firstEndpoint.end())
+        {
+            return nullptr;
+        }
+        return &it->second;
+    }
+
+    std::unordered_map<std::string, std::string> firstEndpoint;
+};
+
+/**
+ * @brief Holds the SensorAssociationGraph built from the ObjectMapper's
+ * GetManagedObjects reply, so sensor requests don't each fetch the whole
+ * association tree.
+ *
+ * Association signals from the mapper are applied to the graph in place; a
+ * mapper restart drops it so the next request fetches it again.  A graph that
+ * has been handed out is never modified; a signal that arrives while one is
+ * still in use replaces it with an updated copy.
+ */
+class SensorAssociationCache
+{
+  public:
+    static constexpr std::string_view mapperService =
+        "xyz.openbmc_project.ObjectMapper";
+
+    using Callback = std::function<void(
+        const boost::system::error_code&,
+        const std::shared_ptr<const SensorAssociationGraph>&)>;
+
+    static SensorAssociationCache& getInstance()
+    {
+        static SensorAssociationCache cache;
+        return cache;
+    }
+
+    SensorAssociationCache(const SensorAssociationCache&) = delete;
+    SensorAssociationCache(SensorAssociationCache&&) = delete;
+    SensorAssociationCache& operator=(const SensorAssociationCache&) = delete;
+    SensorAssociationCache& operator=(SensorAssociationCache&&) = delete;
+    ~SensorAssociationCache() = default;
+
+    void registerMatches(sdbusplus::asio::connection& conn)
+    {
+        namespace rules = sdbusplus::bus::match::rules;
+        std::string mapper(mapperService);
+        std::string associationInterface(
+            SensorAssociationGraph::associationInterface);
+
+        matches.clear();
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn,
+            rules::type::signal() + rules::sender(mapper) +
+                rules::member("PropertiesChanged") +
+                rules::interface("org.freedesktop.DBus.Properties") +
+                rules::argN(0, associationInterface),
+            [this](sdbusplus::message_t& msg) { onPropertiesChanged(msg); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::interfacesAdded() + rules::sender(mapper),
+            [this](sdbusplus::message_t& msg) { onInterfacesAdded(msg); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::interfacesRemoved() + rules::sender(mapper),
+            [this](sdbusplus::message_t& msg) { onInterfacesRemoved(msg); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::nameOwnerChanged() + rules::argN(0, mapper),
+            [this](sdbusplus::message_t& /*msg*/) { clear(); }));
+        clear();
+    }
+
+    bool enabled() const
+    {
+        return !matches.empty();
+    }
+
+    /**
+     * @brief Calls callback with the association graph, fetching it from the
+     * mapper if it isn't cached.  Concurrent fetches share one call.  The
+     * callback is never called inline.
+     */
+    void get(Callback&& callback)
+    {
+        if (graph)
+        {
+            std::shared_ptr<const SensorAssociationGraph> current = graph;
+            boost::asio::post(crow::connections::systemBus->get_io_context(),
+                              [current, callback{std::move(callback)}]() {
+                callback(boost::system::error_code(), current);
+            });
+            return;
+        }
+
+        callbacks.emplace_back(std::move(callback));
+        if (callbacks.size() > 1)
+        {
+            return;
+        }
+        crow::dbus_trace::SharedCallScope sharedCalls;
+        crow::connections::systemBus->async_method_call(
+            [this, fetchGeneration{generation}](
+                const boost::system::error_code& ec,
+                const ManagedObjectType& objects) {
+            afterGetManagedObjects(fetchGeneration, ec, objects);
+        },
+            std::string(mapperService), "/",
+            "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
+    }
+
+    void clear()
+    {
+        graph.reset();
+        generation++;
+    }
+
+  private:
+    SensorAssociationCache() = default;
+
+    void afterGetManagedObjects(uint64_t fetchGeneration,
+                                const boost::system::error_code& ec,
+                                const ManagedObjectType& objects)
+    {
+        std::vector<Callback> waiting = std::move(callbacks);
+        callbacks.clear();
+
+        std::shared_ptr<SensorAssociationGraph> fetched;
+        if (!ec)
+        {
+            fetched = std::make_shared<SensorAssociationGraph>(objects);
+            // A signal received while the call was in flight may not be in
+            // the reply, so only keep it if nothing changed meanwhile
+            if (enabled() && fetchGeneration == generation)
+            {
+                graph = fetched;
+            }
+        }
+        for (Callback& callback : waiting)
+        {
+            callback(ec, fetched);
+        }
+    }
+
+    // Returns the graph for modification, or nullptr when nothing is cached
+    SensorAssociationGraph* writableGraph()
+    {
+        generation++;
+        if (!graph)
+        {
+            return nullptr;
+        }
+        if (graph.use_count() > 1)
+        {
+            graph = std::make_shared<SensorAssociationGraph>(*graph);
+        }
+        return graph.get();
+    }
+
+    void onPropertiesChanged(sdbusplus::message_t& msg)
+    {
+        std::string interface;
+        DBusPropertiesMap properties;
+        try
+        {
+            msg.read(interface, properties);
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            BMCWEB_LOG_ERROR << "Failed to read association change: "
+                             << e.what();
+            clear();
+            return;
+        }
+        std::string path = msg.get_path();
+        if (!SensorAssociationGraph::isTracked(path))
+        {
+            return;
+        }
+        SensorAssociationGraph* current = writableGraph();
+        if (current != nullptr)
+        {
+            current->update(path, properties);
+        }
+    }
+
+    void onInterfacesAdded(sdbusplus::message_t& msg)
+    {
+        sdbusplus::message::object_path path;
+        DBusInteracesMap interfaces;
+        try
+        {
+            msg.read(path, interfaces);
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            BMCWEB_LOG_ERROR << "Failed to read added association: "
+                             << e.what();
+            clear();
+            return;
+        }
+        if (!SensorAssociationGraph::isTracked(path.str))
+        {
+            return;
+        }
+        SensorAssociationGraph* current = writableGraph();
+        if (current != nullptr)
+        {
+            current->update(path.str, interfaces);
+        }
+    }
+
+    void onInterfacesRemoved(sdbusplus::message_t& msg)
+    {
+        sdbusplus::message::object_path path;
+        std::vector<std::string> interfaces;
+        try
+        {
+            msg.read(path, interfaces);
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            BMCWEB_LOG_ERROR << "Failed to read removed association: "
+                             << e.what();
+            clear();
+            return;
+        }
+        if (!SensorAssociationGraph::isTracked(path.str) ||
+            std::find(interfaces.begin(), interfaces.end(),
+                      SensorAssociationGraph::associationInterface) ==
+                interfaces.end())
+        {
+            return;
+        }
+        SensorAssociationGraph* current = writableGraph();
+        if (current != nullptr)
+        {
+            current->erase(path.str);
+        }
+    }
+
+    std::shared_ptr<SensorAssociationGraph> graph;
+    std::vector<Callback> callbacks;
+    uint64_t generation = 0;
+    std::vector<std::unique_ptr<sdbusplus::bus::match_t>> matches;
+};
+
+} // namespace utility
+} // namespace dbus
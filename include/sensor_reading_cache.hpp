@@ -0,0 +1,463 @@
+#pragma once
+
+#include "dbus_singleton.hpp"
+#include "dbus_utility.hpp"
+#include "logging.hpp"
+
+#include <boost/asio/post.hpp>
+#include <boost/container/flat_set.hpp>
+#include <sdbusplus/asio/connection.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace dbus
+{
+
+namespace utility
+{
+
+/**
+ * @brief Live copy of the objects each sensor service exposes under
+ * /xyz/openbmc_project/sensors.
+ *
+ * The first read of a service fetches its GetManagedObjects reply.  After
+ * that PropertiesChanged signals are applied to the table in place, so
+ * sensor GETs and the sensor stream are answered without any D-Bus call.
+ * InterfacesAdded/InterfacesRemoved under the sensors tree and
+ * NameOwnerChanged drop every table, because the unique name those signals
+ * come from can't be tied back to the service name a table was fetched
+ * under.  A table that has been handed out is never modified; a signal that
+ * arrives while one is still in use replaces it with an updated copy.
+ *
+ * The last Sensor.Value reading of every object is also kept with a version
+ * number, so a consumer can ask for only what changed since it last looked.
+ */
+class SensorReadingCache
+{
+  public:
+    static constexpr std::string_view sensorsPath =
+        "/xyz/openbmc_project/sensors";
+    static constexpr std::string_view valueInterface =
+        "xyz.openbmc_project.Sensor.Value";
+
+    // PropertiesChanged signals held while a fetch is in flight, so they can
+    // be applied to the reply when it arrives
+    static constexpr size_t maxPendingChanges = 1024;
+
+    using Callback = std::function<void(const boost::system::error_code&,
+                                        const ManagedObjectType&)>;
+
+    struct Reading
+    {
+        double value = 0.0;
+        uint64_t version = 0;
+        // When the reading last changed, or its service was read
+        std::chrono::system_clock::time_point updated;
+    };
+
+    static SensorReadingCache& getInstance()
+    {
+        static SensorReadingCache cache;
+        return cache;
+    }
+
+    SensorReadingCache(const SensorReadingCache&) = delete;
+    SensorReadingCache(SensorReadingCache&&) = delete;
+    SensorReadingCache& operator=(const SensorReadingCache&) = delete;
+    SensorReadingCache& operator=(SensorReadingCache&&) = delete;
+    ~SensorReadingCache() = default;
+
+    void registerMatches(sdbusplus::asio::connection& conn)
+    {
+        namespace rules = sdbusplus::bus::match::rules;
+        std::string sensorsPrefix(sensorsPath);
+        sensorsPrefix += '/';
+
+        auto onInterfacesChanged = [this](sdbusplus::message_t& /*msg*/) {
+            clear();
+        };
+
+        matches.clear();
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn,
+            rules::type::signal() + rules::member("PropertiesChanged") +
+                rules::interface("org.freedesktop.DBus.Properties") +
+                rules::path_namespace(std::string(sensorsPath)),
+            [this](sdbusplus::message_t& msg) { onPropertiesChanged(msg); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::interfacesAdded() + rules::argNpath(0, sensorsPrefix),
+            onInterfacesChanged));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn,
+            rules::interfacesRemoved() + rules::argNpath(0, sensorsPrefix),
+            onInterfacesChanged));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::nameOwnerChanged(), onInterfacesChanged));
+        clear();
+    }
+
+    bool enabled() const
+    {
+        return !matches.empty();
+    }
+
+    bool contains(const std::string& service) const
+    {
+        return tables.contains(service);
+    }
+
+    /**
+     * @brief Calls callback with the objects service has under the sensors
+     * tree, from the cache when present.  Concurrent reads of a service that
+     * isn't cached share one GetManagedObjects call.  The callback is never
+     * called inline.
+     */
+    void getManagedObjects(const std::string& service, Callback&& callback)
+    {
+        if (!enabled())
+        {
+            crow::connections::systemBus->async_method_call(
+                std::move(callback), service, std::string(sensorsPath),
+                "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
+            return;
+        }
+
+        auto table = tables.find(service);
+        if (table != tables.end())
+        {
+            boost::asio::post(crow::connections::systemBus->get_io_context(),
+                              [objects{table->second},
+                               callback{std::move(callback)}]() {
+                callback(boost::system::error_code(), *objects);
+            });
+            return;
+        }
+
+        auto inserted = fetches.try_emplace(service);
+        inserted.first->second.callbacks.emplace_back(std::move(callback));
+        if (!inserted.second)
+        {
+            return;
+        }
+        crow::dbus_trace::SharedCallScope sharedCalls;
+        inserted.first->second.generation = generation;
+        inserted.first->second.firstChange = nextChange;
+
+        crow::connections::systemBus->async_method_call(
+            [this, service](const boost::system::error_code& ec,
+                            const ManagedObjectType& objects) {
+            afterGetManagedObjects(service, ec, objects);
+        },
+            service, std::string(sensorsPath),
+            "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
+    }
+
+    /**
+     * @brief Reads every service the mapper lists under the sensors tree
+     * that isn't cached yet, then calls callback, so every sensor has a
+     * reading.  After the first call this is one cached mapper lookup.  The
+     * callback is never called inline.
+     */
+    void readAllServices(
+        std::function<void(const boost::system::error_code&)>&& callback)
+    {
+        constexpr std::array<std::string_view, 1> interfaces = {
+            valueInterface};
+        getSubTree(std::string(sensorsPath), 2, interfaces,
+                   [this, callback{std::move(callback)}](
+                       const boost::system::error_code& ec,
+                       const MapperGetSubTreeResponse& subtree) {
+            if (ec)
+            {
+                callback(ec);
+                return;
+            }
+            auto pending = std::make_shared<size_t>(1);
+            auto done = [pending, callback]() {
+                if (--(*pending) == 0)
+                {
+                    callback(boost::system::error_code());
+                }
+            };
+            boost::container::flat_set<std::string> services;
+            for (const auto& [path, objects] : subtree)
+            {
+                for (const auto& [service, ifaces] : objects)
+                {
+                    if (!contains(service))
+                    {
+                        services.insert(service);
+                    }
+                }
+            }
+            for (const std::string& service : services)
+            {
+                (*pending)++;
+                getManagedObjects(service,
+                                  [done](const boost::system::error_code&,
+                                         const ManagedObjectType&) {
+                    done();
+                });
+            }
+            done();
+        });
+    }
+
+    /**
+     * @brief Calls callback(path, value) for every reading that changed
+     * after version, and returns the version to pass next time.  0 visits
+     * every reading.
+     */
+    template <typename ReadingCallback>
+    uint64_t forEachReadingSince(uint64_t version,
+                                 ReadingCallback&& callback) const
+    {
+        for (const auto& [path, reading] : readings)
+        {
+            if (reading.version > version)
+            {
+                callback(path, reading.value);
+            }
+        }
+        return readingVersion;
+    }
+
+    // The last reading of the sensor at path, or nullptr if there is none
+    // because its service hasn't been read
+    const Reading* findReading(const std::string& path) const
+    {
+        auto reading = readings.find(path);
+        if (reading == readings.end())
+        {
+            return nullptr;
+        }
+        return &reading->second;
+    }
+
+    void clear()
+    {
+        tables.clear();
+        index.clear();
+        readings.clear();
+        pendingChanges.clear();
+        generation++;
+    }
+
+  private:
+    SensorReadingCache() = default;
+
+    struct Location
+    {
+        std::string service;
+        size_t object = 0;
+    };
+
+    struct Change
+    {
+        uint64_t id = 0;
+        std::string path;
+        std::string interface;
+        DBusPropertiesMap properties;
+    };
+
+    struct Fetch
+    {
+        uint64_t generation = 0;
+        uint64_t firstChange = 0;
+        std::vector<Callback> callbacks;
+    };
+
+    void afterGetManagedObjects(const std::string& service,
+                                const boost::system::error_code& ec,
+                                const ManagedObjectType& objects)
+    {
+        auto fetch = fetches.find(service);
+        if (fetch == fetches.end())
+        {
+            return;
+        }
+        std::vector<Callback> callbacks = std::move(fetch->second.callbacks);
+        bool cacheable = !ec && fetch->second.generation == generation &&
+                         (pendingChanges.empty() ||
+                          pendingChanges.front().id <=
+                              fetch->second.firstChange);
+        uint64_t firstChange = fetch->second.firstChange;
+        fetches.erase(fetch);
+
+        if (cacheable)
+        {
+            insert(service, objects);
+            // Signals that arrived after the call went out may or may not be
+            // in the reply, but they are newer either way
+            for (const Change& change : pendingChanges)
+            {
+                if (change.id >= firstChange)
+                {
+                    applyChange(change.path, change.interface,
+                                change.properties);
+                }
+            }
+        }
+        if (fetches.empty())
+        {
+            pendingChanges.clear();
+        }
+
+        for (Callback& callback : callbacks)
+        {
+            callback(ec, objects);
+        }
+    }
+
+    void insert(const std::string& service, const ManagedObjectType& objects)
+    {
+        auto table = std::make_shared<ManagedObjectType>(objects);
+        for (size_t i = 0; i < table->size(); i++)
+        {
+            const std::string& path = (*table)[i].first.str;
+            index.insert_or_assign(path, Location{service, i});
+            for (const auto& [interface, properties] : (*table)[i].second)
+            {
+                if (interface == valueInterface)
+                {
+                    updateReading(path, properties);
+                }
+            }
+        }
+        tables.insert_or_assign(service, std::move(table));
+    }
+
+    void onPropertiesChanged(sdbusplus::message_t& msg)
+    {
+        std::string interface;
+        DBusPropertiesMap properties;
+        try
+        {
+            msg.read(interface, properties);
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            BMCWEB_LOG_ERROR << "Failed to read PropertiesChanged on "
+                             << msg.get_path() << ": " << e.what();
+            return;
+        }
+        std::string path = msg.get_path();
+        if (!fetches.empty())
+        {
+            if (pendingChanges.size() >= maxPendingChanges)
+            {
+                pendingChanges.pop_front();
+            }
+            pendingChanges.push_back(
+                {nextChange, path, interface, properties});
+        }
+        nextChange++;
+        applyChange(path, interface, properties);
+    }
+
+    void applyChange(const std::string& path, const std::string& interface,
+                     const DBusPropertiesMap& changed)
+    {
+        auto location = index.find(path);
+        if (location == index.end())
+        {
+            return;
+        }
+        auto table = tables.find(location->second.service);
+        if (table == tables.end() ||
+            location->second.object >= table->second->size())
+        {
+            return;
+        }
+        if (table->second.use_count() > 1)
+        {
+            // Still being read by a request; leave that copy alone
+            table->second = std::make_shared<ManagedObjectType>(*table->second);
+        }
+
+        DBusInteracesMap& interfaces =
+            (*table->second)[location->second.object].second;
+        auto iface = std::find_if(interfaces.begin(), interfaces.end(),
+                                  [&interface](const auto& entry) {
+            return entry.first == interface;
+        });
+        if (iface == interfaces.end())
+        {
+            iface = interfaces.emplace(interfaces.end(), interface,
+                                       DBusPropertiesMap());
+        }
+        for (const auto& [name, value] : changed)
+        {
+            auto property = std::find_if(iface->second.begin(),
+                                         iface->second.end(),
+                                         [&name](const auto& entry) {
+                return entry.first == name;
+            });
+            if (property == iface->second.end())
+            {
+                iface->second.emplace_back(name, value);
+            }
+            else
+            {
+                property->second = value;
+            }
+        }
+        if (interface == valueInterface)
+        {
+            updateReading(path, changed);
+        }
+    }
+
+    void updateReading(const std::string& path,
+                       const DBusPropertiesMap& properties)
+    {
+        for (const auto& [name, value] : properties)
+        {
+            if (name != "Value")
+            {
+                continue;
+            }
+            const double* reading = std::get_if<double>(&value);
+            if (reading == nullptr)
+            {
+                return;
+            }
+            readingVersion++;
+            readings.insert_or_assign(
+                path, Reading{*reading, readingVersion,
+                              std::chrono::system_clock::now()});
+            return;
+        }
+    }
+
+    // Keyed by service
+    std::unordered_map<std::string, std::shared_ptr<ManagedObjectType>>
+        tables;
+    // Keyed by object path
+    std::unordered_map<std::string, Location> index;
+    std::unordered_map<std::string, Reading> readings;
+    std::unordered_map<std::string, Fetch> fetches;
+    std::deque<Change> pendingChanges;
+    uint64_t nextChange = 1;
+    uint64_t readingVersion = 0;
+    uint64_t generation = 0;
+    std::vector<std::unique_ptr<sdbusplus::bus::match_t>> matches;
+};
+
+} // namespace utility
+} // namespace dbus
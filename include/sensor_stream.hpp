@@ -0,0 +1,155 @@
+#pragma once
+#include <app.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/container/flat_map.hpp>
+#include <dbus_utility.hpp>
+#include <sensor_reading_cache.hpp>
+#include <websocket.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace crow
+{
+namespace sensor_stream
+{
+
+// Clients can't ask for updates faster than this
+constexpr std::chrono::milliseconds minInterval{100};
+constexpr std::chrono::milliseconds defaultInterval{1000};
+
+struct SensorStreamSession
+{
+    explicit SensorStreamSession(crow::websocket::Connection& connIn) :
+        conn(connIn), timer(connIn.getIoContext())
+    {}
+
+    crow::websocket::Connection& conn;
+    boost::asio::steady_timer timer;
+    std::chrono::milliseconds interval = defaultInterval;
+    // Readings up to this version have already been sent
+    uint64_t lastVersion = 0;
+};
+
+static boost::container::flat_map<crow::websocket::Connection*,
+                                  std::shared_ptr<SensorStreamSession>>
+    sessions;
+
+inline void
+    sendReadings(const std::shared_ptr<SensorStreamSession>& session)
+{
+    nlohmann::json readings = nlohmann::json::object();
+    session->lastVersion =
+        dbus::utility::SensorReadingCache::getInstance().forEachReadingSince(
+            session->lastVersion,
+            [&readings](const std::string& path, double value) {
+        readings[path] = value;
+    });
+    if (readings.empty())
+    {
+        return;
+    }
+    nlohmann::json msg;
+    msg["readings"] = std::move(readings);
+    session->conn.sendText(
+        msg.dump(-1, ' ', true, nlohmann::json::error_handler_t::replace));
+}
+
+inline void startTimer(const std::shared_ptr<SensorStreamSession>& session);
+
+inline void onTick(const std::weak_ptr<SensorStreamSession>& weakSession)
+{
+    std::shared_ptr<SensorStreamSession> session = weakSession.lock();
+    if (!session)
+    {
+        return;
+    }
+    // Readings only exist for services that have been read once; after
+    // that they are kept current by signals
+    dbus::utility::SensorReadingCache::getInstance().readAllServices(
+        [weakSession](const boost::system::error_code& ec) {
+        std::shared_ptr<SensorStreamSession> self = weakSession.lock();
+        if (!self)
+        {
+            return;
+        }
+        if (ec)
+        {
+            BMCWEB_LOG_ERROR << "Sensor stream subtree failed " << ec;
+            startTimer(self);
+            return;
+        }
+        sendReadings(self);
+        startTimer(self);
+    });
+}
+
+inline void startTimer(const std::shared_ptr<SensorStreamSession>& session)
+{
+    session->timer.expires_after(session->interval);
+    session->timer.async_wait(
+        [weakSession{std::weak_ptr<SensorStreamSession>(session)}](
+            const boost::system::error_code& ec) {
+        if (ec)
+        {
+            return;
+        }
+        onTick(weakSession);
+    });
+}
+
+inline void requestRoutes(App& app)
+{
+    BMCWEB_ROUTE(app, "/sensors/stream")
+        .privileges({{"Login"}})
+        .websocket()
+        .permessageDeflate()
+        .onopen([&](crow::websocket::Connection& conn) {
+        BMCWEB_LOG_DEBUG << "Sensor stream " << &conn << " opened";
+        // A reading that didn't fit is sent again once it next changes
+        conn.setOverflowPolicy(crow::websocket::OverflowPolicy::Drop);
+        auto session = std::make_shared<SensorStreamSession>(conn);
+        sessions.insert_or_assign(&conn, session);
+        // The first tick sends every reading
+        onTick(session);
+    })
+        .onclose([&](crow::websocket::Connection& conn, const std::string&) {
+        BMCWEB_LOG_DEBUG << "Sensor stream " << &conn << " closed";
+        sessions.erase(&conn);
+    })
+        .onmessage([&](crow::websocket::Connection& conn,
+                       const std::string& data, bool) {
+        auto session = sessions.find(&conn);
+        if (session == sessions.end())
+        {
+            conn.close("Internal error");
+            return;
+        }
+        nlohmann::json j = nlohmann::json::parse(data, nullptr, false);
+        if (j.is_discarded())
+        {
+            conn.close("Unable to parse json request");
+            return;
+        }
+        auto interval = j.find("interval_ms");
+        if (interval == j.end())
+        {
+            return;
+        }
+        const uint64_t* intervalMs = interval->get_ptr<const uint64_t*>();
+        if (intervalMs == nullptr)
+        {
+            conn.close("interval_ms must be a positive integer");
+            return;
+        }
+        session->second->interval =
+            std::max(minInterval, std::chrono::milliseconds(*intervalMs));
+    });
+}
+
+} // namespace sensor_stream
+} // namespace crow
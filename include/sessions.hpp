@@ -1,16 +1,26 @@
 #pragma once
 
 #include "logging.hpp"
+#include "privileges.hpp"
 #include "random.hpp"
+#include "shared_state.hpp"
 #include "utility.hpp"
 
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <nlohmann/json.hpp>
 #include <utils/ip_utils.hpp>
 
 #include <algorithm>
+#include <chrono>
 #include <csignal>
+#include <functional>
+#include <memory>
 #include <optional>
+#include <queue>
 #include <random>
+#include <unordered_map>
+#include <vector>
 #ifdef BMCWEB_ENABLE_IBM_MANAGEMENT_CONSOLE
 #include <ibm/locks.hpp>
 #endif
@@ -23,6 +33,11 @@ namespace persistent_data
 // https://cheatsheetseries.owasp.org/cheatsheets/Session_Management_Cheat_Sheet.html#session-id-entropy
 constexpr std::size_t sessionTokenSize = 20;
 
+// How long a session may reuse its cached GetUserInfo result.  Changes made
+// through D-Bus invalidate the cache immediately; this bounds staleness for
+// anything the signals don't cover, such as LDAP group membership.
+constexpr std::chrono::seconds userInfoCacheTimeout(10);
+
 enum class PersistenceType
 {
     TIMEOUT, // User session times out after a predetermined amount of time
@@ -41,6 +56,18 @@ struct UserSession
     PersistenceType persistence{PersistenceType::TIMEOUT};
     bool isConfigureSelfOnly = false;
 
+    // Result of the last User.Manager GetUserInfo call for this session.
+    // Router::handle reuses it for userInfoCacheTimeout, or until
+    // user_monitor.hpp sees the account change and clears it.
+    struct UserInfo
+    {
+        std::string userRole;
+        redfish::UserRoleId roleId = redfish::UserRoleId::NoAccess;
+        bool passwordExpired = false;
+        std::chrono::time_point<std::chrono::steady_clock> fetched;
+    };
+    std::optional<UserInfo> userInfo;
+
     // There are two sources of truth for isConfigureSelfOnly:
     //  1. When pamAuthenticateUser() returns PAM_NEW_AUTHTOK_REQD.
     //  2. D-Bus User.Manager.GetUserInfo property UserPasswordExpired.
@@ -209,48 +236,18 @@ class SessionStore
     {
         // TODO(ed) find a secure way to not generate session identifiers if
         // persistence is set to SINGLE_REQUEST
-        static constexpr std::array<char, 62> alphanum = {
-            '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C',
-            'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P',
-            'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z', 'a', 'b', 'c',
-            'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o', 'p',
-            'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z'};
-
-        std::string sessionToken;
-        sessionToken.resize(sessionTokenSize, '0');
-        std::uniform_int_distribution<size_t> dist(0, alphanum.size() - 1);
-
         bmcweb::OpenSSLGenerator gen;
 
-        for (char& sessionChar : sessionToken)
-        {
-            sessionChar = alphanum[dist(gen)];
-            if (gen.error())
-            {
-                return nullptr;
-            }
-        }
+        std::string sessionToken(sessionTokenSize, '0');
+        bmcweb::fillAlphanumeric(gen, sessionToken);
         // Only need csrf tokens for cookie based auth, token doesn't matter
-        std::string csrfToken;
-        csrfToken.resize(sessionTokenSize, '0');
-        for (char& csrfChar : csrfToken)
-        {
-            csrfChar = alphanum[dist(gen)];
-            if (gen.error())
-            {
-                return nullptr;
-            }
-        }
-
-        std::string uniqueId;
-        uniqueId.resize(10, '0');
-        for (char& uidChar : uniqueId)
+        std::string csrfToken(sessionTokenSize, '0');
+        bmcweb::fillAlphanumeric(gen, csrfToken);
+        std::string uniqueId(10, '0');
+        bmcweb::fillAlphanumeric(gen, uniqueId);
+        if (gen.error())
         {
-            uidChar = alphanum[dist(gen)];
-            if (gen.error())
-            {
-                return nullptr;
-            }
+            return nullptr;
         }
 
         auto session = std::make_shared<UserSession>(UserSession{
@@ -258,16 +255,33 @@ class SessionStore
             redfish::ip_util::toString(clientIp),
             std::chrono::steady_clock::now(), persistence,
             isConfigureSelfOnly});
-        auto it = authTokens.emplace(sessionToken, session);
+        std::shared_ptr<UserSession> stored = addSession(session);
         // Only need to write to disk if session isn't about to be destroyed.
-        needWrite = persistence == PersistenceType::TIMEOUT;
-        return it.first->second;
+        if (persistence == PersistenceType::TIMEOUT)
+        {
+            sessionsChanged();
+        }
+        return stored;
+    }
+
+    // Inserts a session into every index.  A session whose token is already
+    // in use is not added, and the existing one is returned instead.
+    std::shared_ptr<UserSession>
+        addSession(const std::shared_ptr<UserSession>& session)
+    {
+        auto it = authTokens.emplace(session->sessionToken, session);
+        if (!it.second)
+        {
+            return it.first->second;
+        }
+        sessionsByUid.insert_or_assign(session->uniqueId, session);
+        expiryQueue.push({session->lastUpdated, session});
+        return session;
     }
 
     std::shared_ptr<UserSession>
         loginSessionByToken(const std::string_view token)
     {
-        applySessionTimeouts();
         if (token.size() != sessionTokenSize)
         {
             return nullptr;
@@ -278,24 +292,30 @@ class SessionStore
             return nullptr;
         }
         std::shared_ptr<UserSession> userSession = sessionIt->second;
-        userSession->lastUpdated = std::chrono::steady_clock::now();
+        auto timeNow = std::chrono::steady_clock::now();
+        if (isExpired(*userSession, timeNow))
+        {
+            expireSession(userSession);
+            return nullptr;
+        }
+        userSession->lastUpdated = timeNow;
         return userSession;
     }
 
     std::shared_ptr<UserSession> getSessionByUid(const std::string_view uid)
     {
-        applySessionTimeouts();
-        // TODO(Ed) this is inefficient
-        auto sessionIt = authTokens.begin();
-        while (sessionIt != authTokens.end())
+        auto sessionIt = sessionsByUid.find(std::string(uid));
+        if (sessionIt == sessionsByUid.end())
         {
-            if (sessionIt->second->uniqueId == uid)
-            {
-                return sessionIt->second;
-            }
-            sessionIt++;
+            return nullptr;
+        }
+        std::shared_ptr<UserSession> userSession = sessionIt->second;
+        if (isExpired(*userSession, std::chrono::steady_clock::now()))
+        {
+            expireSession(userSession);
+            return nullptr;
         }
-        return nullptr;
+        return userSession;
     }
 
     void removeSession(const std::shared_ptr<UserSession>& session)
@@ -303,8 +323,11 @@ class SessionStore
 #ifdef BMCWEB_ENABLE_IBM_MANAGEMENT_CONSOLE
         crow::ibm_mc_lock::Lock::getInstance().releaseLock(session->uniqueId);
 #endif
-        authTokens.erase(session->sessionToken);
-        needWrite = true;
+        eraseSession(*session);
+        if (session->persistence == PersistenceType::TIMEOUT)
+        {
+            sessionsChanged();
+        }
     }
 
     std::vector<const std::string*> getUniqueIds(
@@ -327,34 +350,42 @@ class SessionStore
 
     void removeSessionsByUsername(std::string_view username)
     {
-        std::erase_if(authTokens, [username](const auto& value) {
-            if (value.second == nullptr)
-            {
-                return false;
-            }
-            return value.second->username == username;
+        eraseSessionsIf([username](const UserSession& session) {
+            return session.username == username;
         });
     }
 
-    void removeSessionsByUsernameExceptSession(
-        std::string_view username, const std::shared_ptr<UserSession>& session)
+    // Drops the cached GetUserInfo result for every session of this user, or
+    // for all sessions if username is empty.
+    void invalidateUserInfo(std::string_view username)
     {
-        std::erase_if(authTokens, [username, session](const auto& value) {
-            if (value.second == nullptr)
+        for (auto& [token, session] : authTokens)
+        {
+            if (session == nullptr)
+            {
+                continue;
+            }
+            if (username.empty() || session->username == username)
             {
-                return false;
+                session->userInfo = std::nullopt;
             }
+        }
+    }
 
-            return value.second->username == username &&
-                   value.second->uniqueId != session->uniqueId;
+    void removeSessionsByUsernameExceptSession(
+        std::string_view username, const std::shared_ptr<UserSession>& session)
+    {
+        eraseSessionsIf([username, session](const UserSession& value) {
+            return value.username == username &&
+                   value.uniqueId != session->uniqueId;
         });
     }
 
     void updateAuthMethodsConfig(const AuthConfigMethods& config)
     {
-        bool isTLSchanged = (authMethodsConfig.tls != config.tls);
-        authMethodsConfig = config;
-        needWrite = true;
+        bool isTLSchanged = (authMethodsConfig.load()->tls != config.tls);
+        authMethodsConfig.store(config);
+        configChanged();
         if (isTLSchanged)
         {
             // recreate socket connections with new settings
@@ -362,14 +393,30 @@ class SessionStore
         }
     }
 
-    AuthConfigMethods& getAuthMethodsConfig()
+    // A snapshot, which stays as it is for as long as it's held, so it can
+    // be read from any thread
+    std::shared_ptr<const AuthConfigMethods> getAuthMethodsConfig() const
     {
-        return authMethodsConfig;
+        return authMethodsConfig.load();
+    }
+
+    // Applies the persisted auth config at startup
+    void loadAuthMethodsConfig(const nlohmann::json& j)
+    {
+        authMethodsConfig.update(
+            [&j](AuthConfigMethods& config) { config.fromJson(j); });
     }
 
     bool needsWrite() const
     {
-        return needWrite;
+        return needWrite || needConfigWrite;
+    }
+
+    // Called whenever needWrite or needConfigWrite is set, so the owner of
+    // the persistent store can schedule a write
+    void setWriteHandler(std::function<void()>&& handler)
+    {
+        writeHandler = std::move(handler);
     }
     int64_t getTimeoutInSeconds() const
     {
@@ -379,7 +426,7 @@ class SessionStore
     void updateSessionTimeout(std::chrono::seconds newTimeoutInSeconds)
     {
         timeoutInSeconds = newTimeoutInSeconds;
-        needWrite = true;
+        configChanged();
     }
 
     static SessionStore& getInstance()
@@ -388,34 +435,38 @@ class SessionStore
         return sessionStore;
     }
 
+    // Removes the sessions that have been idle for the timeout.  Only
+    // queue entries that have come due are looked at; a session used since
+    // its entry was queued is queued again from its last use.
     void applySessionTimeouts()
     {
         auto timeNow = std::chrono::steady_clock::now();
-        if (timeNow - lastTimeoutUpdate > std::chrono::seconds(1))
+        while (!expiryQueue.empty() &&
+               timeNow - expiryQueue.top().lastUpdated >= timeoutInSeconds)
         {
-            lastTimeoutUpdate = timeNow;
-            auto authTokensIt = authTokens.begin();
-            while (authTokensIt != authTokens.end())
+            std::shared_ptr<UserSession> session =
+                expiryQueue.top().session.lock();
+            expiryQueue.pop();
+            if (session == nullptr || !isStored(*session))
             {
-                if (timeNow - authTokensIt->second->lastUpdated >=
-                    timeoutInSeconds)
-                {
-#ifdef BMCWEB_ENABLE_IBM_MANAGEMENT_CONSOLE
-                    crow::ibm_mc_lock::Lock::getInstance().releaseLock(
-                        authTokensIt->second->uniqueId);
-#endif
-                    authTokensIt = authTokens.erase(authTokensIt);
-
-                    needWrite = true;
-                }
-                else
-                {
-                    authTokensIt++;
-                }
+                continue;
+            }
+            if (!isExpired(*session, timeNow))
+            {
+                expiryQueue.push({session->lastUpdated, session});
+                continue;
             }
+            expireSession(session);
         }
     }
 
+    // Sweeps timed out sessions once a second on io
+    void startTimeoutTimer(boost::asio::io_context& io)
+    {
+        auto timer = std::make_shared<boost::asio::steady_timer>(io);
+        scheduleTimeoutSweep(timer);
+    }
+
     SessionStore(const SessionStore&) = delete;
     SessionStore& operator=(const SessionStore&) = delete;
     SessionStore(SessionStore&&) = delete;
@@ -427,13 +478,127 @@ class SessionStore
                        crow::utility::ConstantTimeCompare>
         authTokens;
 
-    std::chrono::time_point<std::chrono::steady_clock> lastTimeoutUpdate;
+    // The same sessions, indexed by their uniqueId
+    std::unordered_map<std::string, std::shared_ptr<UserSession>>
+        sessionsByUid;
+
+    // The persisted session list, and the auth config and timeout setting,
+    // have changed since they were last written
     bool needWrite{false};
+    bool needConfigWrite{false};
     std::chrono::seconds timeoutInSeconds;
-    AuthConfigMethods authMethodsConfig;
+    bmcweb::SharedSnapshot<AuthConfigMethods> authMethodsConfig;
 
   private:
     SessionStore() : timeoutInSeconds(1800) {}
+
+    // A session's last use as of when it was queued; see applySessionTimeouts
+    struct ExpiryEntry
+    {
+        std::chrono::time_point<std::chrono::steady_clock> lastUpdated;
+        std::weak_ptr<UserSession> session;
+
+        bool operator>(const ExpiryEntry& other) const
+        {
+            return lastUpdated > other.lastUpdated;
+        }
+    };
+
+    bool isExpired(const UserSession& session,
+                   std::chrono::time_point<std::chrono::steady_clock> timeNow)
+        const
+    {
+        return timeNow - session.lastUpdated >= timeoutInSeconds;
+    }
+
+    // False when the session was already removed, but is still referenced
+    // from somewhere such as the expiry queue or an in flight request
+    bool isStored(const UserSession& session) const
+    {
+        auto it = authTokens.find(session.sessionToken);
+        return it != authTokens.end() && it->second.get() == &session;
+    }
+
+    void expireSession(const std::shared_ptr<UserSession>& session)
+    {
+#ifdef BMCWEB_ENABLE_IBM_MANAGEMENT_CONSOLE
+        crow::ibm_mc_lock::Lock::getInstance().releaseLock(session->uniqueId);
+#endif
+        eraseSession(*session);
+        if (session->persistence == PersistenceType::TIMEOUT)
+        {
+            sessionsChanged();
+        }
+    }
+
+    void sessionsChanged()
+    {
+        needWrite = true;
+        if (writeHandler)
+        {
+            writeHandler();
+        }
+    }
+
+    void configChanged()
+    {
+        needConfigWrite = true;
+        if (writeHandler)
+        {
+            writeHandler();
+        }
+    }
+
+    void eraseSession(const UserSession& session)
+    {
+        if (!isStored(session))
+        {
+            return;
+        }
+        auto uidIt = sessionsByUid.find(session.uniqueId);
+        if (uidIt != sessionsByUid.end() && uidIt->second.get() == &session)
+        {
+            sessionsByUid.erase(uidIt);
+        }
+        authTokens.erase(session.sessionToken);
+    }
+
+    template <typename Predicate>
+    void eraseSessionsIf(Predicate predicate)
+    {
+        auto matches = [&predicate](const auto& value) {
+            return value.second != nullptr && predicate(*value.second);
+        };
+        std::erase_if(sessionsByUid, matches);
+        if (std::erase_if(authTokens, matches) != 0)
+        {
+            sessionsChanged();
+        }
+    }
+
+    void scheduleTimeoutSweep(
+        const std::shared_ptr<boost::asio::steady_timer>& timer)
+    {
+        timer->expires_after(std::chrono::seconds(1));
+        timer->async_wait(
+            [this, timer](const boost::system::error_code& ec) {
+            if (ec)
+            {
+                return;
+            }
+            applySessionTimeouts();
+            scheduleTimeoutSweep(timer);
+        });
+    }
+
+    // Expired sessions are found through this rather than by scanning
+    // authTokens; entries for sessions removed early are dropped when they
+    // come due
+    std::priority_queue<ExpiryEntry, std::vector<ExpiryEntry>,
+                        std::greater<>>
+        expiryQueue;
+
+    std::function<void()> writeHandler;
 };
 
 } // namespace persistent_data
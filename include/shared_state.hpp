@@ -0,0 +1,81 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace bmcweb
+{
+
+/**
+ * @brief A read-mostly value that any thread can read without waiting on
+ * writers.
+ *
+ * Readers take a snapshot, a shared_ptr to an immutable copy, and keep using
+ * it for as long as they hold it.  Writers copy the current value, change
+ * the copy and publish it; readers that took the old snapshot keep it until
+ * they let go, and later readers see the new one.  Writers are serialized
+ * with each other, and a reader only holds the lock long enough to copy the
+ * pointer.
+ *
+ * Most bmcweb state is only touched from the main io_context and needs none
+ * of this; see worker_pool.hpp.  This is for state that's read on every
+ * connection or request, such as the auth config, so it can be read from
+ * any thread the connection runs on.
+ */
+template <typename T>
+class SharedSnapshot
+{
+  public:
+    SharedSnapshot() : current(std::make_shared<const T>()) {}
+
+    explicit SharedSnapshot(T initial) :
+        current(std::make_shared<const T>(std::move(initial)))
+    {}
+
+    SharedSnapshot(const SharedSnapshot&) = delete;
+    SharedSnapshot(SharedSnapshot&&) = delete;
+    SharedSnapshot& operator=(const SharedSnapshot&) = delete;
+    SharedSnapshot& operator=(SharedSnapshot&&) = delete;
+    ~SharedSnapshot() = default;
+
+    std::shared_ptr<const T> load() const
+    {
+        std::lock_guard<std::mutex> lock(pointerMutex);
+        return current;
+    }
+
+    void store(T value)
+    {
+        std::lock_guard<std::mutex> writeLock(writerMutex);
+        publish(std::make_shared<const T>(std::move(value)));
+    }
+
+    // Publishes a copy of the current value as changed by change(T&)
+    template <typename Change>
+    void update(Change&& change)
+    {
+        std::lock_guard<std::mutex> writeLock(writerMutex);
+        T value = *load();
+        std::forward<Change>(change)(value);
+        publish(std::make_shared<const T>(std::move(value)));
+    }
+
+  private:
+    void publish(std::shared_ptr<const T>&& next)
+    {
+        // The old value is released outside the lock, so a reader is never
+        // held up by its destructor
+        std::shared_ptr<const T> previous;
+        {
+            std::lock_guard<std::mutex> lock(pointerMutex);
+            previous = std::exchange(current, std::move(next));
+        }
+    }
+
+    mutable std::mutex pointerMutex;
+    std::mutex writerMutex;
+    std::shared_ptr<const T> current;
+};
+
+} // namespace bmcweb
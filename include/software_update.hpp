@@ -0,0 +1,233 @@
+#pragma once
+
+#include "dbus_singleton.hpp"
+#include "dbus_utility.hpp"
+#include "logging.hpp"
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace crow
+{
+namespace software_update
+{
+
+// Most images that can be waiting on the software manager at once
+constexpr size_t maxPendingImages = 4;
+
+/**
+ * @brief Offered an InterfacesAdded signal; returns true if the signal was
+ * about this image, which then stops waiting.
+ */
+using SignalHandler =
+    std::function<bool(sdbusplus::message_t&,
+                       const sdbusplus::message::object_path&,
+                       const dbus::utility::DBusInteracesMap&)>;
+
+/**
+ * @brief An uploaded or downloaded image waiting for the software manager to
+ * pick it up.
+ */
+struct PendingImage
+{
+    // Offered every object added beneath /xyz/openbmc_project/software
+    SignalHandler onSoftwareAdded;
+    // Offered every log entry added, if set
+    SignalHandler onLogAdded;
+    // Called if neither handler claimed a signal in time
+    std::function<void()> onTimeout;
+};
+
+/**
+ * @brief Waits on the software manager for every image in flight, so the
+ * BMC, host and power supply images of one maintenance window can be
+ * uploaded and activated side by side instead of one at a time.
+ *
+ * One pair of matches, on new software objects and new log entries, serves
+ * every pending image.  Each signal is offered to the images in the order
+ * they were handed over, oldest first, until one claims it: the software
+ * manager picks images up in the order it sees them, and doesn't say which
+ * file an object came from.  Each image has its own timeout.
+ */
+class PendingImages
+{
+  public:
+    static PendingImages& getInstance()
+    {
+        static PendingImages pending;
+        return pending;
+    }
+
+    PendingImages(const PendingImages&) = delete;
+    PendingImages(PendingImages&&) = delete;
+    PendingImages& operator=(const PendingImages&) = delete;
+    PendingImages& operator=(PendingImages&&) = delete;
+    ~PendingImages() = default;
+
+    /**
+     * @brief Starts waiting on image.
+     *
+     * @return An ID for remove(), or nullopt if maxPendingImages are
+     * already waiting.
+     */
+    std::optional<uint64_t> add(boost::asio::io_context& io,
+                                std::chrono::seconds timeout,
+                                PendingImage&& image)
+    {
+        if (entries.size() >= maxPendingImages)
+        {
+            return std::nullopt;
+        }
+        registerMatches();
+
+        uint64_t id = nextId++;
+        Entry& entry = entries.emplace_back(
+            Entry{id, std::move(image),
+                  std::make_unique<boost::asio::steady_timer>(io)});
+        entry.timer->expires_after(timeout);
+        entry.timer->async_wait(
+            [this, id](const boost::system::error_code& ec) {
+            if (ec == boost::asio::error::operation_aborted)
+            {
+                // expected, the image was picked up or given up on
+                return;
+            }
+            if (ec)
+            {
+                BMCWEB_LOG_ERROR << "Async_wait failed " << ec;
+            }
+            std::optional<Entry> expired = take(id);
+            if (expired && expired->image.onTimeout)
+            {
+                expired->image.onTimeout();
+            }
+        });
+        return id;
+    }
+
+    // Stops waiting on an image; it's fine if it has already stopped
+    void remove(uint64_t id)
+    {
+        take(id);
+    }
+
+    size_t size() const
+    {
+        return entries.size();
+    }
+
+  private:
+    struct Entry
+    {
+        uint64_t id;
+        PendingImage image;
+        std::unique_ptr<boost::asio::steady_timer> timer;
+    };
+
+    PendingImages() = default;
+
+    std::optional<Entry> take(uint64_t id)
+    {
+        auto it = std::find_if(entries.begin(), entries.end(),
+                               [id](const Entry& entry) {
+            return entry.id == id;
+        });
+        if (it == entries.end())
+        {
+            return std::nullopt;
+        }
+        Entry entry = std::move(*it);
+        entries.erase(it);
+        entry.timer->cancel();
+        return entry;
+    }
+
+    void registerMatches()
+    {
+        // Kept once made; the software and logging trees are quiet outside
+        // of updates
+        if (!matches.empty())
+        {
+            return;
+        }
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            *crow::connections::systemBus,
+            "interface='org.freedesktop.DBus.ObjectManager',type='signal',"
+            "member='InterfacesAdded',path='/xyz/openbmc_project/software'",
+            [this](sdbusplus::message_t& m) {
+            dispatch(m, &PendingImage::onSoftwareAdded);
+        }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            *crow::connections::systemBus,
+            "interface='org.freedesktop.DBus.ObjectManager',type='signal',"
+            "member='InterfacesAdded',path='/xyz/openbmc_project/logging'",
+            [this](sdbusplus::message_t& m) {
+            dispatch(m, &PendingImage::onLogAdded);
+        }));
+    }
+
+    void dispatch(sdbusplus::message_t& m, SignalHandler PendingImage::*handler)
+    {
+        if (entries.empty())
+        {
+            return;
+        }
+        sdbusplus::message::object_path path;
+        dbus::utility::DBusInteracesMap interfaces;
+        try
+        {
+            m.read(path, interfaces);
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            BMCWEB_LOG_ERROR << "Failed to read added interfaces: "
+                             << e.what();
+            return;
+        }
+        BMCWEB_LOG_DEBUG << "obj path = " << path.str;
+
+        // Handlers may add or remove images, so walk a copy of the order
+        std::vector<uint64_t> order;
+        order.reserve(entries.size());
+        for (const Entry& entry : entries)
+        {
+            order.emplace_back(entry.id);
+        }
+        for (uint64_t id : order)
+        {
+            auto it = std::find_if(entries.begin(), entries.end(),
+                                   [id](const Entry& entry) {
+                return entry.id == id;
+            });
+            if (it == entries.end() || !(it->image.*handler))
+            {
+                continue;
+            }
+            SignalHandler offer = it->image.*handler;
+            if (offer(m, path, interfaces))
+            {
+                remove(id);
+                return;
+            }
+        }
+    }
+
+    std::vector<Entry> entries;
+    uint64_t nextId = 0;
+    std::vector<std::unique_ptr<sdbusplus::bus::match_t>> matches;
+};
+
+} // namespace software_update
+} // namespace crow
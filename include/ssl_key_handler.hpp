@@ -1,10 +1,16 @@
 #pragma once
 
+#include "bmcweb_config.h"
+
+#include "logging.hpp"
+
 #include <openssl/bio.h>
+#include <openssl/core_names.h>
 #include <openssl/dh.h>
 #include <openssl/dsa.h>
 #include <openssl/err.h>
 #include <openssl/evp.h>
+#include <openssl/params.h>
 #include <openssl/pem.h>
 #include <openssl/rand.h>
 #include <openssl/rsa.h>
@@ -13,7 +19,12 @@
 #include <boost/asio/ssl/context.hpp>
 #include <random.hpp>
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <optional>
 #include <random>
+#include <string_view>
 
 namespace ensuressl
 {
@@ -419,6 +430,245 @@ inline void ensureOpensslKeyPresentAndValid(const std::string& filepath)
     }
 }
 
+/**
+ * @brief Keys used to encrypt TLS session tickets.
+ *
+ * The current key encrypts new tickets; the previous one is still accepted so
+ * that tickets issued just before a rotation stay usable for one more period.
+ * Keys are held in memory only, so a restart invalidates every ticket.
+ */
+class TicketKeyRing
+{
+  public:
+    struct Key
+    {
+        std::array<unsigned char, 16> name{};
+        std::array<unsigned char, 32> aesKey{};
+        std::array<unsigned char, 32> hmacKey{};
+    };
+
+    static TicketKeyRing& getInstance()
+    {
+        static TicketKeyRing ring;
+        return ring;
+    }
+
+    // Returns the key to encrypt a new ticket with, rotating first if the
+    // current key has been in use for a full session timeout.
+    const Key* current()
+    {
+        auto now = std::chrono::steady_clock::now();
+        if (!currentKey || now - created >= rotationInterval)
+        {
+            std::optional<Key> next = generate();
+            if (!next)
+            {
+                return currentKey ? &*currentKey : nullptr;
+            }
+            previousKey = std::move(currentKey);
+            currentKey = std::move(next);
+            created = now;
+            rotations++;
+        }
+        return &*currentKey;
+    }
+
+    // Looks up the key a received ticket was encrypted with.  Sets isCurrent
+    // to false for the previous key, which asks OpenSSL to reissue the
+    // ticket under the current one.
+    const Key* find(const unsigned char* keyName, bool& isCurrent) const
+    {
+        for (const std::optional<Key>* key : {&currentKey, &previousKey})
+        {
+            if (*key && std::equal((*key)->name.begin(), (*key)->name.end(),
+                                   keyName))
+            {
+                isCurrent = key == &currentKey;
+                return &**key;
+            }
+        }
+        return nullptr;
+    }
+
+    uint64_t getRotations() const
+    {
+        return rotations;
+    }
+
+    std::chrono::seconds rotationInterval{bmcwebTlsSessionTimeoutSeconds};
+
+  private:
+    TicketKeyRing() = default;
+
+    static std::optional<Key> generate()
+    {
+        Key key;
+        if (RAND_bytes(key.name.data(), static_cast<int>(key.name.size())) !=
+                1 ||
+            RAND_bytes(key.aesKey.data(),
+                       static_cast<int>(key.aesKey.size())) != 1 ||
+            RAND_bytes(key.hmacKey.data(),
+                       static_cast<int>(key.hmacKey.size())) != 1)
+        {
+            BMCWEB_LOG_ERROR << "Failed to generate TLS ticket key";
+            return std::nullopt;
+        }
+        return key;
+    }
+
+    std::optional<Key> currentKey;
+    std::optional<Key> previousKey;
+    std::chrono::time_point<std::chrono::steady_clock> created;
+    uint64_t rotations = 0;
+};
+
+inline int ticketKeyCallback(SSL* /*ssl*/, unsigned char* keyName,
+                             unsigned char* iv, EVP_CIPHER_CTX* cipherCtx,
+                             EVP_MAC_CTX* hmacCtx, int enc)
+{
+    TicketKeyRing& ring = TicketKeyRing::getInstance();
+    bool isCurrent = true;
+    const TicketKeyRing::Key* key = nullptr;
+    if (enc == 1)
+    {
+        key = ring.current();
+        if (key == nullptr ||
+            RAND_bytes(iv, EVP_CIPHER_iv_length(EVP_aes_256_cbc())) != 1)
+        {
+            return -1;
+        }
+        std::copy(key->name.begin(), key->name.end(), keyName);
+    }
+    else
+    {
+        key = ring.find(keyName, isCurrent);
+        if (key == nullptr)
+        {
+            // Unknown or expired key; fall back to a full handshake
+            return 0;
+        }
+    }
+
+    std::array<OSSL_PARAM, 3> params = {
+        OSSL_PARAM_construct_octet_string(
+            OSSL_MAC_PARAM_KEY,
+            const_cast<unsigned char*>(key->hmacKey.data()),
+            key->hmacKey.size()),
+        OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST,
+                                         const_cast<char*>("sha256"), 0),
+        OSSL_PARAM_construct_end()};
+    if (EVP_MAC_CTX_set_params(hmacCtx, params.data()) != 1)
+    {
+        return -1;
+    }
+
+    if (enc == 1)
+    {
+        if (EVP_EncryptInit_ex(cipherCtx, EVP_aes_256_cbc(), nullptr,
+                               key->aesKey.data(), iv) != 1)
+        {
+            return -1;
+        }
+        return 1;
+    }
+    if (EVP_DecryptInit_ex(cipherCtx, EVP_aes_256_cbc(), nullptr,
+                           key->aesKey.data(), iv) != 1)
+    {
+        return -1;
+    }
+    return isCurrent ? 1 : 2;
+}
+
+/**
+ * @brief Turns on server side session resumption for a TLS context.
+ *
+ * Both the stateful session cache and stateless tickets are enabled, sized
+ * by the tls-session-cache-size and tls-session-timeout meson options.  A
+ * cache size of 0 disables resumption entirely.
+ */
+inline void setupSessionResumption(boost::asio::ssl::context& ctx)
+{
+    SSL_CTX* nativeCtx = ctx.native_handle();
+    if constexpr (bmcwebTlsSessionCacheSize == 0)
+    {
+        SSL_CTX_set_session_cache_mode(nativeCtx, SSL_SESS_CACHE_OFF);
+        SSL_CTX_set_options(nativeCtx, SSL_OP_NO_TICKET);
+        return;
+    }
+
+    SSL_CTX_set_session_cache_mode(nativeCtx, SSL_SESS_CACHE_SERVER);
+    SSL_CTX_sess_set_cache_size(nativeCtx, bmcwebTlsSessionCacheSize);
+    SSL_CTX_set_timeout(nativeCtx, bmcwebTlsSessionTimeoutSeconds);
+
+    // Resumed sessions must be bound to this server
+    constexpr std::string_view sessionIdContext = "bmcweb";
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    const auto* idC = reinterpret_cast<const unsigned char*>(
+        sessionIdContext.data());
+    if (SSL_CTX_set_session_id_context(
+            nativeCtx, idC, static_cast<unsigned int>(sessionIdContext.size())) !=
+        1)
+    {
+        BMCWEB_LOG_ERROR << "Failed to set TLS session id context";
+    }
+
+    if (SSL_CTX_set_tlsext_ticket_key_evp_cb(nativeCtx, ticketKeyCallback) !=
+        1)
+    {
+        BMCWEB_LOG_ERROR << "Failed to set TLS ticket key callback";
+    }
+}
+
+// Protocols bmcweb serves, in ALPN wire format: each name preceded by its
+// length
+constexpr std::array<unsigned char, 9> alpnProtocols{
+    8, 'h', 't', 't', 'p', '/', '1', '.', '1'};
+
+// Picks the protocol for a client that sent ALPN.  Clients offering only
+// protocols bmcweb doesn't serve, like h2, carry on without ALPN rather than
+// failing the handshake.
+inline int alpnSelectCallback(SSL* /*ssl*/, const unsigned char** out,
+                              unsigned char* outLen, const unsigned char* in,
+                              unsigned int inLen, void* /*arg*/)
+{
+    unsigned char* selected = nullptr;
+    if (SSL_select_next_proto(&selected, outLen, alpnProtocols.data(),
+                              alpnProtocols.size(), in,
+                              inLen) != OPENSSL_NPN_NEGOTIATED)
+    {
+        BMCWEB_LOG_DEBUG << "No ALPN protocol in common with client";
+        return SSL_TLSEXT_ERR_NOACK;
+    }
+    *out = selected;
+    return SSL_TLSEXT_ERR_OK;
+}
+
+struct SessionCacheStats
+{
+    long hits = 0;
+    long misses = 0;
+    long timeouts = 0;
+    long cacheFull = 0;
+    long cached = 0;
+    uint64_t ticketKeyRotations = 0;
+};
+
+inline SessionCacheStats
+    getSessionCacheStats(const boost::asio::ssl::context& ctx)
+{
+    // The SSL_CTX_sess_* accessors are macros taking a non-const pointer
+    SSL_CTX* nativeCtx =
+        const_cast<boost::asio::ssl::context&>(ctx).native_handle();
+    SessionCacheStats stats;
+    stats.hits = SSL_CTX_sess_hits(nativeCtx);
+    stats.misses = SSL_CTX_sess_misses(nativeCtx);
+    stats.timeouts = SSL_CTX_sess_timeouts(nativeCtx);
+    stats.cacheFull = SSL_CTX_sess_cache_full(nativeCtx);
+    stats.cached = SSL_CTX_sess_number(nativeCtx);
+    stats.ticketKeyRotations = TicketKeyRing::getInstance().getRotations();
+    return stats;
+}
+
 inline std::shared_ptr<boost::asio::ssl::context>
     getSslContext(const std::string& sslPemFile)
 {
@@ -438,6 +688,13 @@ inline std::shared_ptr<boost::asio::ssl::context>
 
     SSL_CTX_set_options(mSslContext->native_handle(), SSL_OP_NO_RENEGOTIATION);
 
+    setupSessionResumption(*mSslContext);
+
+    // Answer ALPN so browsers settle on HTTP/1.1 during the handshake
+    // instead of finding out from the first request
+    SSL_CTX_set_alpn_select_cb(mSslContext->native_handle(),
+                               alpnSelectCallback, nullptr);
+
     BMCWEB_LOG_DEBUG << "Using default TrustStore location: " << trustStorePath;
     mSslContext->add_verify_path(trustStorePath);
 
@@ -0,0 +1,261 @@
+#pragma once
+
+#include "logging.hpp"
+
+#include <openssl/evp.h>
+#include <openssl/x509.h>
+#include <openssl/x509v3.h>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace crow
+{
+namespace authentication
+{
+
+// Most client certificates remembered at once
+constexpr std::size_t tlsUserCacheMaxEntries = 64;
+
+/**
+ * @brief Returns the user a verified client certificate logs in as: the
+ * CommonName of its subject, provided its KeyUsage allows digitalSignature and
+ * keyAgreement and its ExtendedKeyUsage allows clientAuth.  Returns an empty
+ * string for certificates that can't be used to log in.
+ */
+inline std::string getTlsUserName(X509* peerCert)
+{
+    // Verify KeyUsage
+    bool isKeyUsageDigitalSignature = false;
+    bool isKeyUsageKeyAgreement = false;
+
+    ASN1_BIT_STRING* usage = static_cast<ASN1_BIT_STRING*>(
+        X509_get_ext_d2i(peerCert, NID_key_usage, nullptr, nullptr));
+
+    if (usage == nullptr)
+    {
+        BMCWEB_LOG_DEBUG << "TLS usage is null";
+        return "";
+    }
+
+    for (int i = 0; i < usage->length; i++)
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        unsigned char usageChar = usage->data[i];
+        if (KU_DIGITAL_SIGNATURE & usageChar)
+        {
+            isKeyUsageDigitalSignature = true;
+        }
+        if (KU_KEY_AGREEMENT & usageChar)
+        {
+            isKeyUsageKeyAgreement = true;
+        }
+    }
+    ASN1_BIT_STRING_free(usage);
+
+    if (!isKeyUsageDigitalSignature || !isKeyUsageKeyAgreement)
+    {
+        BMCWEB_LOG_DEBUG << "Certificate ExtendedKeyUsage does "
+                            "not allow provided certificate to "
+                            "be used for user authentication";
+        return "";
+    }
+
+    // Determine that ExtendedKeyUsage includes Client Auth
+
+    stack_st_ASN1_OBJECT* extUsage = static_cast<stack_st_ASN1_OBJECT*>(
+        X509_get_ext_d2i(peerCert, NID_ext_key_usage, nullptr, nullptr));
+
+    if (extUsage == nullptr)
+    {
+        BMCWEB_LOG_DEBUG << "TLS extUsage is null";
+        return "";
+    }
+
+    bool isExKeyUsageClientAuth = false;
+    for (int i = 0; i < sk_ASN1_OBJECT_num(extUsage); i++)
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
+        int nid = OBJ_obj2nid(sk_ASN1_OBJECT_value(extUsage, i));
+        if (NID_client_auth == nid)
+        {
+            isExKeyUsageClientAuth = true;
+            break;
+        }
+    }
+    sk_ASN1_OBJECT_free(extUsage);
+
+    // Certificate has to have proper key usages set
+    if (!isExKeyUsageClientAuth)
+    {
+        BMCWEB_LOG_DEBUG << "Certificate ExtendedKeyUsage does "
+                            "not allow provided certificate to "
+                            "be used for user authentication";
+        return "";
+    }
+    std::string sslUser;
+    // Extract username contained in CommonName
+    sslUser.resize(256, '\0');
+
+    int status = X509_NAME_get_text_by_NID(X509_get_subject_name(peerCert),
+                                           NID_commonName, sslUser.data(),
+                                           static_cast<int>(sslUser.size()));
+
+    if (status == -1)
+    {
+        BMCWEB_LOG_DEBUG << "TLS cannot get username to create session";
+        return "";
+    }
+
+    size_t lastChar = sslUser.find('\0');
+    if (lastChar == std::string::npos || lastChar == 0)
+    {
+        BMCWEB_LOG_DEBUG << "Invalid TLS user name";
+        return "";
+    }
+    sslUser.resize(lastChar);
+    return sslUser;
+}
+
+/**
+ * @brief Remembers the user each client certificate maps to, keyed by the
+ * certificate's SHA-256 fingerprint, so clients that reconnect with the same
+ * certificate skip re-parsing its extensions and subject.
+ *
+ * Only the mapping is cached.  OpenSSL still verifies the chain, including
+ * any CRLs in the trust store, on every full handshake, and the cache is
+ * consulted only for certificates that passed.  What's cached depends
+ * only on the certificate's contents, so the timeout exists only to bound
+ * how long unused entries stay.  This is only used from the main
+ * io_context.
+ */
+class TlsUserCache
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit TlsUserCache(Clock::duration timeoutIn) : timeout(timeoutIn) {}
+
+    static TlsUserCache& getInstance()
+    {
+        static TlsUserCache cache{std::chrono::minutes(10)};
+        return cache;
+    }
+
+    ~TlsUserCache() = default;
+    TlsUserCache(const TlsUserCache&) = delete;
+    TlsUserCache& operator=(const TlsUserCache&) = delete;
+    TlsUserCache(TlsUserCache&&) = delete;
+    TlsUserCache& operator=(TlsUserCache&&) = delete;
+
+    // Cache key for cert, or empty if it can't be computed
+    static std::string fingerprint(X509* cert)
+    {
+        std::array<unsigned char, EVP_MAX_MD_SIZE> out{};
+        unsigned int outLen = 0;
+        if (X509_digest(cert, EVP_sha256(), out.data(), &outLen) != 1)
+        {
+            return "";
+        }
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        return {reinterpret_cast<const char*>(out.data()), outLen};
+    }
+
+    // The user remembered for this fingerprint, if still fresh.  An empty
+    // user means the certificate can't be used to log in.
+    std::optional<std::string> lookup(const std::string& certFingerprint,
+                                      Clock::time_point now = Clock::now())
+    {
+        if (certFingerprint.empty())
+        {
+            return std::nullopt;
+        }
+        auto it = entries.find(certFingerprint);
+        if (it == entries.end())
+        {
+            return std::nullopt;
+        }
+        if (now - it->second.verified >= timeout)
+        {
+            entries.erase(it);
+            return std::nullopt;
+        }
+        return it->second.username;
+    }
+
+    void insert(const std::string& certFingerprint, const std::string& username,
+                Clock::time_point now = Clock::now())
+    {
+        if (certFingerprint.empty())
+        {
+            return;
+        }
+        if (entries.size() >= tlsUserCacheMaxEntries &&
+            entries.find(certFingerprint) == entries.end())
+        {
+            evictOldest(now);
+        }
+        entries.insert_or_assign(certFingerprint, Entry{username, now});
+    }
+
+    // The user for a client certificate that passed chain verification
+    std::string getUserName(X509* peerCert)
+    {
+        std::string certFingerprint = fingerprint(peerCert);
+        std::optional<std::string> cached = lookup(certFingerprint);
+        if (cached)
+        {
+            return *cached;
+        }
+        std::string username = getTlsUserName(peerCert);
+        insert(certFingerprint, username);
+        return username;
+    }
+
+    void clear()
+    {
+        entries.clear();
+    }
+
+    std::size_t size() const
+    {
+        return entries.size();
+    }
+
+  private:
+    struct Entry
+    {
+        std::string username;
+        Clock::time_point verified;
+    };
+
+    void evictOldest(Clock::time_point now)
+    {
+        std::erase_if(entries, [this, now](const auto& entry) {
+            return now - entry.second.verified >= timeout;
+        });
+        if (entries.size() < tlsUserCacheMaxEntries)
+        {
+            return;
+        }
+        auto oldest = entries.begin();
+        for (auto it = entries.begin(); it != entries.end(); it++)
+        {
+            if (it->second.verified < oldest->second.verified)
+            {
+                oldest = it;
+            }
+        }
+        entries.erase(oldest);
+    }
+
+    Clock::duration timeout;
+    std::unordered_map<std::string, Entry> entries;
+};
+
+} // namespace authentication
+} // namespace crow
@@ -1,4 +1,5 @@
 #pragma once
+#include "basic_auth_cache.hpp"
 #include "dbus_singleton.hpp"
 #include "dbus_utility.hpp"
 #include "persistent_data.hpp"
@@ -16,6 +17,7 @@ inline void onUserRemoved(sdbusplus::message::message& msg)
     std::string username = p.filename();
     persistent_data::SessionStore::getInstance().removeSessionsByUsername(
         username);
+    crow::authentication::BasicAuthCache::getInstance().invalidate(username);
 }
 
 inline void registerUserRemovedSignal()
@@ -27,4 +29,33 @@ inline void registerUserRemovedSignal()
     static sdbusplus::bus::match_t userRemovedMatch(
         *crow::connections::systemBus, userRemovedMatchStr, onUserRemoved);
 }
+inline void onUserChanged(sdbusplus::message::message& msg)
+{
+    sdbusplus::message::object_path path(msg.get_path());
+    if (path.parent_path() == "/xyz/openbmc_project/user")
+    {
+        persistent_data::SessionStore::getInstance().invalidateUserInfo(
+            path.filename());
+        // Covers accounts being disabled, locked out or having their
+        // password expired
+        crow::authentication::BasicAuthCache::getInstance().invalidate(
+            path.filename());
+        return;
+    }
+    // Manager-level and LDAP settings such as role mappings can affect
+    // every user
+    persistent_data::SessionStore::getInstance().invalidateUserInfo("");
+    crow::authentication::BasicAuthCache::getInstance().invalidate("");
+}
+
+inline void registerUserChangedSignal()
+{
+    std::string userChangedMatchStr =
+        "type='signal',member='PropertiesChanged',"
+        "interface='org.freedesktop.DBus.Properties',"
+        "path_namespace='/xyz/openbmc_project/user'";
+
+    static sdbusplus::bus::match_t userChangedMatch(
+        *crow::connections::systemBus, userChangedMatchStr, onUserChanged);
+}
 } // namespace bmcweb
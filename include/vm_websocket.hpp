@@ -141,15 +141,34 @@ class Handler : public std::enable_shared_from_this<Handler>
             session->sendBinary(payload);
             outputBuffer->consume(bytesRead);
 
+            if (readPaused)
+            {
+                readStopped = true;
+                return;
+            }
             doRead();
         });
     }
 
+    // Stops reading from the proxy while the websocket has more than it can
+    // send waiting, rather than queueing without bound
+    void setCongested(bool congested)
+    {
+        readPaused = congested;
+        if (!readPaused && readStopped)
+        {
+            readStopped = false;
+            doRead();
+        }
+    }
+
     boost::process::async_pipe pipeOut;
     boost::process::async_pipe pipeIn;
     boost::process::child proxy;
     std::string media;
     bool doingWrite{false};
+    bool readPaused{false};
+    bool readStopped{false};
 
     std::unique_ptr<boost::beast::flat_static_buffer<nbdBufferSize>>
         outputBuffer;
@@ -185,6 +204,12 @@ inline void requestRoutes(App& app)
         // enhancement can include supporting different endpoint values.
         const char* media = "0";
         handler = std::make_shared<Handler>(media, conn.getIoContext());
+        conn.setBackpressureHandler(2 * nbdBufferSize, [](bool congested) {
+            if (handler != nullptr)
+            {
+                handler->setCongested(congested);
+            }
+        });
         handler->connect();
     })
         .onclose([](crow::websocket::Connection& conn,
@@ -4,14 +4,27 @@
 
 #include <app.hpp>
 #include <boost/algorithm/string/replace.hpp>
+#include <boost/asio/io_context.hpp>
 #include <boost/container/flat_set.hpp>
+#include <http_compression.hpp>
 #include <http_request.hpp>
 #include <http_response.hpp>
 #include <routing.hpp>
+#include <utils/hex_utils.hpp>
+#include <worker_pool.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
+#include <iterator>
+#include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <utility>
 
 namespace crow
 {
@@ -26,6 +39,180 @@ struct CmpStr
     }
 };
 
+struct StaticFile
+{
+    std::filesystem::path absolutePath;
+    const char* contentType = nullptr;
+    const char* contentEncoding = nullptr;
+    std::string etag;
+    bool immutable = false;
+
+    // Text hosted without a .gz variant, such as the Redfish schemas, is
+    // gzipped on first request and the copy kept for clients accepting it
+    bool compressible = false;
+    bool compressing = false;
+    std::shared_ptr<const std::string> gzipBody;
+};
+
+/**
+ * @brief Returns true if the file name carries a content hash, as the webui
+ * build produces for its bundles (app.1a2b3c4d.js, chunk-vendors.1a2b3c4d.css).
+ * These never change under the same name and so can be cached indefinitely.
+ */
+inline bool isHashedFilename(std::string_view filename)
+{
+    size_t dot = filename.find('.');
+    while (dot != std::string_view::npos)
+    {
+        std::string_view rest = filename.substr(dot + 1);
+        size_t next = rest.find('.');
+        std::string_view part = rest.substr(0, next);
+        if (part.size() >= 8 &&
+            std::all_of(part.begin(), part.end(),
+                        [](char c) { return std::isxdigit(c) != 0; }))
+        {
+            return true;
+        }
+        dot = (next == std::string_view::npos) ? next : dot + 1 + next;
+    }
+    return false;
+}
+
+/**
+ * @brief Computes a strong entity tag from the contents of the file.
+ */
+inline std::optional<std::string>
+    computeFileEtag(const std::filesystem::path& path)
+{
+    std::ifstream inf(path, std::ios::binary);
+    if (!inf)
+    {
+        return std::nullopt;
+    }
+    // 64 bit FNV-1a
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    std::array<char, 4096> chunk{};
+    while (inf)
+    {
+        inf.read(chunk.data(), chunk.size());
+        std::streamsize got = inf.gcount();
+        for (std::streamsize i = 0; i < got; i++)
+        {
+            hash ^= static_cast<unsigned char>(chunk[static_cast<size_t>(i)]);
+            hash *= 0x100000001b3ULL;
+        }
+    }
+    return "\"" + intToHexString(hash, 16) + "\"";
+}
+
+/**
+ * @brief Fills file->gzipBody from the file on disk, on the worker pool when
+ * there is an io_context to return to.
+ */
+inline void compressStaticFile(const std::shared_ptr<StaticFile>& file,
+                               boost::asio::io_context* io)
+{
+    if (file->compressing)
+    {
+        return;
+    }
+    file->compressing = true;
+
+    auto gzipped = std::make_shared<std::optional<std::string>>();
+    auto work = [path{file->absolutePath}, gzipped]() {
+        std::ifstream inf(path, std::ios::binary);
+        if (!inf)
+        {
+            return;
+        }
+        std::string contents((std::istreambuf_iterator<char>(inf)),
+                             std::istreambuf_iterator<char>());
+        std::string out;
+        if (compression::encode(contents, compression::Encoding::Gzip, out))
+        {
+            *gzipped = std::move(out);
+        }
+    };
+    auto done = [file, gzipped]() {
+        file->compressing = false;
+        if (!*gzipped)
+        {
+            BMCWEB_LOG_ERROR << "Unable to compress "
+                             << file->absolutePath.string();
+            // Don't try again; the file is served as it is
+            file->compressible = false;
+            return;
+        }
+        file->gzipBody =
+            std::make_shared<const std::string>(std::move(**gzipped));
+    };
+    if (io == nullptr)
+    {
+        work();
+        done();
+        return;
+    }
+    worker_pool::offload(io->get_executor(), std::move(work), std::move(done));
+}
+
+inline void
+    handleStaticFile(const std::shared_ptr<StaticFile>& filePtr,
+                     const crow::Request& req,
+                     const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
+{
+    const StaticFile& file = *filePtr;
+    asyncResp->res.addHeader(boost::beast::http::field::etag, file.etag);
+    asyncResp->res.addHeader(boost::beast::http::field::cache_control,
+                             file.immutable ? "max-age=31536000, immutable"
+                                            : "no-cache");
+
+    if (etagMatches(
+            req.getHeaderValue(boost::beast::http::field::if_none_match),
+            file.etag))
+    {
+        asyncResp->res.result(boost::beast::http::status::not_modified);
+        return;
+    }
+
+    if (file.contentType != nullptr)
+    {
+        asyncResp->res.addHeader(boost::beast::http::field::content_type,
+                                 file.contentType);
+    }
+
+    if (file.contentEncoding != nullptr)
+    {
+        asyncResp->res.addHeader(boost::beast::http::field::content_encoding,
+                                 file.contentEncoding);
+    }
+
+    if (file.compressible)
+    {
+        asyncResp->res.addHeader(boost::beast::http::field::vary,
+                                 "Accept-Encoding");
+        if (compression::getPreferredEncoding(req.getHeaderValue(
+                boost::beast::http::field::accept_encoding)) ==
+            compression::Encoding::Gzip)
+        {
+            if (file.gzipBody != nullptr)
+            {
+                asyncResp->res.addHeader(
+                    boost::beast::http::field::content_encoding, "gzip");
+                asyncResp->res.body() = *file.gzipBody;
+                return;
+            }
+            // This request gets the file as it is; later ones the gzip copy
+            compressStaticFile(filePtr, req.ioService);
+        }
+    }
+
+    if (!asyncResp->res.openFile(file.absolutePath))
+    {
+        asyncResp->res.result(
+            boost::beast::http::status::internal_server_error);
+    }
+}
+
 inline void requestRoutes(App& app)
 {
     constexpr static std::array<std::pair<const char*, const char*>, 17>
@@ -146,35 +333,29 @@ inline void requestRoutes(App& app)
                 forward_unauthorized::hasWebuiRoute = true;
             }
 
-            app.routeDynamic(webpath)(
-                [absolutePath, contentType, contentEncoding](
-                    const crow::Request&,
-                    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp) {
-                if (contentType != nullptr)
-                {
-                    asyncResp->res.addHeader(
-                        boost::beast::http::field::content_type, contentType);
-                }
-
-                if (contentEncoding != nullptr)
-                {
-                    asyncResp->res.addHeader(
-                        boost::beast::http::field::content_encoding,
-                        contentEncoding);
-                }
+            std::optional<std::string> etag = computeFileEtag(absolutePath);
+            if (!etag)
+            {
+                BMCWEB_LOG_ERROR << "Unable to read " << absolutePath.string();
+                continue;
+            }
 
-                // res.set_header("Cache-Control", "public, max-age=86400");
-                std::ifstream inf(absolutePath);
-                if (!inf)
-                {
-                    BMCWEB_LOG_DEBUG << "failed to read file";
-                    asyncResp->res.result(
-                        boost::beast::http::status::internal_server_error);
-                    return;
-                }
+            auto file = std::make_shared<StaticFile>();
+            file->absolutePath = absolutePath;
+            file->contentType = contentType;
+            file->contentEncoding = contentEncoding;
+            file->etag = std::move(*etag);
+            file->immutable =
+                isHashedFilename(absolutePath.filename().string());
+#ifdef BMCWEB_ENABLE_HTTP_COMPRESSION
+            file->compressible = contentEncoding == nullptr &&
+                                 (extension == ".json" || extension == ".xml");
+#endif
 
-                asyncResp->res.body() = {std::istreambuf_iterator<char>(inf),
-                                         std::istreambuf_iterator<char>()};
+            app.routeDynamic(webpath)(
+                [file](const crow::Request& req,
+                       const std::shared_ptr<bmcweb::AsyncResp>& asyncResp) {
+                handleStaticFile(file, req, asyncResp);
             });
         }
     }
@@ -64,6 +64,17 @@ nlohmann::json malformedJSON();
 
 void malformedJSON(crow::Response& res);
 
+/**
+ * @brief Formats MissingOrMalformedPart message into JSON
+ * Message body: "The multipart request contains malformed parts or is missing
+ * required parts."
+ *
+ *
+ * @returns Message MissingOrMalformedPart formatted to JSON */
+nlohmann::json missingOrMalformedPart();
+
+void missingOrMalformedPart(crow::Response& res);
+
 /**
  * @brief Formats ResourceMissingAtURI message into JSON
  * Message body: "The resource at the URI <arg1> was not found."
@@ -1107,8 +1118,13 @@ void restrictedRole(crow::Response& res, const std::string& arg1);
 void addMessageToErrorJson(nlohmann::json& target,
                            const nlohmann::json& message);
 
+void addMessageToErrorJson(nlohmann::json& target, nlohmann::json&& message);
+
 void addMessageToJson(nlohmann::json& target, const nlohmann::json& message,
                       std::string_view fieldPath);
+
+void addMessageToJson(nlohmann::json& target, nlohmann::json&& message,
+                      std::string_view fieldPath);
 } // namespace messages
 
 } // namespace redfish
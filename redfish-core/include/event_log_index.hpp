@@ -0,0 +1,490 @@
+#pragma once
+
+#include "logging.hpp"
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace redfish
+{
+namespace event_log
+{
+
+/**
+ * @brief Reads the "YYYY-MM-DDTHH:MM:SS" that starts logEntry as local time.
+ * Returns false, leaving timestamp alone, if the line doesn't start with one.
+ */
+inline bool parseLogTimestamp(std::string_view logEntry, std::time_t& timestamp)
+{
+    const char* pos = logEntry.data();
+    const char* end = logEntry.data() + logEntry.size();
+    // Reads a number of at most maxDigits digits, then the separator after it
+    auto field = [&pos, end](int& value, size_t maxDigits, int min, int max,
+                             char separator) {
+        const char* fieldEnd =
+            pos + std::min(maxDigits, static_cast<size_t>(end - pos));
+        auto [next, ec] = std::from_chars(pos, fieldEnd, value);
+        if (ec != std::errc() || value < min || value > max)
+        {
+            return false;
+        }
+        pos = next;
+        if (separator == '\0')
+        {
+            return true;
+        }
+        if (pos == end || *pos != separator)
+        {
+            return false;
+        }
+        pos++;
+        return true;
+    };
+
+    std::tm timeStruct = {};
+    int year = 0;
+    int month = 0;
+    if (!field(year, 4, 0, 9999, '-') || !field(month, 2, 1, 12, '-') ||
+        !field(timeStruct.tm_mday, 2, 1, 31, 'T') ||
+        !field(timeStruct.tm_hour, 2, 0, 23, ':') ||
+        !field(timeStruct.tm_min, 2, 0, 59, ':') ||
+        !field(timeStruct.tm_sec, 2, 0, 60, '\0'))
+    {
+        return false;
+    }
+    timeStruct.tm_year = year - 1900;
+    timeStruct.tm_mon = month - 1;
+    timestamp = std::mktime(&timeStruct);
+    return true;
+}
+
+/**
+ * @brief Builds the entry ids used for the redfish event log files, in the
+ * form "<timestamp>" or "<timestamp>_<index>" when several entries in the
+ * same file share a timestamp.  One generator is used per file, in order.
+ */
+class EntryIdGenerator
+{
+  public:
+    std::string next(std::string_view logEntry)
+    {
+        std::time_t curTs = 0;
+        parseLogTimestamp(logEntry, curTs);
+        // If the timestamp isn't unique, increment the index
+        if (curTs == prevTs)
+        {
+            index++;
+        }
+        else
+        {
+            index = 0;
+        }
+        prevTs = curTs;
+
+        std::string entryID = std::to_string(curTs);
+        if (index > 0)
+        {
+            entryID += "_" + std::to_string(index);
+        }
+        return entryID;
+    }
+
+  private:
+    std::time_t prevTs = 0;
+    int index = 0;
+};
+
+/**
+ * @brief Returns the MessageId of a "<Timestamp> <MessageId>,<MessageArgs>"
+ * line, or an empty view if the line doesn't have one.
+ */
+inline std::string_view getMessageId(std::string_view logEntry)
+{
+    size_t space = logEntry.find(' ');
+    if (space == std::string_view::npos)
+    {
+        return {};
+    }
+    size_t start = logEntry.find_first_not_of(' ', space);
+    if (start == std::string_view::npos)
+    {
+        return {};
+    }
+    logEntry.remove_prefix(start);
+    return logEntry.substr(0, logEntry.find(','));
+}
+
+// The fields of a "<Timestamp> <MessageId>,<MessageArgs>" line, as views
+// into it
+struct EventLogLine
+{
+    std::string_view timestamp;
+    std::string_view messageId;
+    std::vector<std::string_view> messageArgs;
+};
+
+/**
+ * @brief Splits logEntry into out.  Runs of commas count as one, and an empty
+ * first argument means there are none.  out is meant to be reused from line
+ * to line, so its arguments vector keeps its storage.
+ */
+inline bool parseEventLogLine(std::string_view logEntry, EventLogLine& out)
+{
+    out.messageArgs.clear();
+    size_t space = logEntry.find(' ');
+    if (space == std::string_view::npos)
+    {
+        return false;
+    }
+    out.timestamp = logEntry.substr(0, space);
+    size_t start = logEntry.find_first_not_of(' ', space);
+    if (start == std::string_view::npos)
+    {
+        return false;
+    }
+    logEntry.remove_prefix(start);
+
+    size_t comma = logEntry.find(',');
+    out.messageId = logEntry.substr(0, comma);
+    if (comma == std::string_view::npos)
+    {
+        return true;
+    }
+    logEntry.remove_prefix(comma);
+    while (!logEntry.empty())
+    {
+        logEntry.remove_prefix(
+            std::min(logEntry.find_first_not_of(','), logEntry.size()));
+        comma = logEntry.find(',');
+        out.messageArgs.emplace_back(logEntry.substr(0, comma));
+        if (comma == std::string_view::npos)
+        {
+            break;
+        }
+        logEntry.remove_prefix(comma);
+    }
+    if (!out.messageArgs.empty() && out.messageArgs.front().empty())
+    {
+        out.messageArgs.clear();
+    }
+    return true;
+}
+
+/**
+ * @brief Byte offset index over the rotated redfish event log files.
+ *
+ * Every line of every file is recorded by entry id along with the file and
+ * offset it starts at, so reading one entry or one page of entries is a seek
+ * rather than a scan of every file.  refresh() only parses bytes appended
+ * since the last call; files that were rotated (renamed) keep their index
+ * because they are tracked by inode, and truncated or replaced files are
+ * reparsed.  Lines rejected by the filter are still found by id but aren't
+ * counted or paged, matching what the collection has always listed.
+ */
+class EventLogIndex
+{
+  public:
+    using Filter = std::function<bool(std::string_view messageId)>;
+
+    explicit EventLogIndex(std::filesystem::path dirIn = "/var/log",
+                           std::string baseNameIn = "redfish") :
+        dir(std::move(dirIn)),
+        baseName(std::move(baseNameIn))
+    {}
+
+    static EventLogIndex& getInstance()
+    {
+        static EventLogIndex index;
+        return index;
+    }
+
+    /**
+     * @brief Sets which MessageIds are counted and paged.  Anything already
+     * indexed is dropped and reparsed on the next refresh().
+     */
+    void setFilter(Filter filterIn)
+    {
+        filter = std::move(filterIn);
+        files.clear();
+        rebuildLookup();
+    }
+
+    /**
+     * @brief Brings the index up to date with the files on disk.
+     */
+    void refresh()
+    {
+        built = true;
+
+        std::vector<std::filesystem::path> paths;
+        std::error_code ec;
+        for (const std::filesystem::directory_entry& dirEnt :
+             std::filesystem::directory_iterator(dir, ec))
+        {
+            if (dirEnt.path().filename().string().starts_with(baseName))
+            {
+                paths.emplace_back(dirEnt.path());
+            }
+        }
+        // Rotated files get a ".#" suffix that is higher for older logs, so
+        // reverse sorted order is oldest first.
+        std::sort(paths.rbegin(), paths.rend());
+
+        std::vector<IndexedFile> newFiles;
+        newFiles.reserve(paths.size());
+        bool reordered = paths.size() != files.size();
+        size_t lastFileStart = 0;
+        for (const std::filesystem::path& path : paths)
+        {
+            struct stat st
+            {};
+            if (stat(path.c_str(), &st) != 0)
+            {
+                reordered = true;
+                continue;
+            }
+
+            auto old = std::find_if(files.begin(), files.end(),
+                                    [&st](const IndexedFile& file) {
+                return file.dev == st.st_dev && file.inode == st.st_ino;
+            });
+            if (old == files.end() ||
+                old->indexedSize > static_cast<std::streamoff>(st.st_size))
+            {
+                reordered = true;
+                IndexedFile& file = newFiles.emplace_back();
+                file.dev = st.st_dev;
+                file.inode = st.st_ino;
+            }
+            else
+            {
+                if (static_cast<size_t>(old - files.begin()) !=
+                    newFiles.size())
+                {
+                    reordered = true;
+                }
+                newFiles.emplace_back(std::move(*old));
+            }
+            IndexedFile& file = newFiles.back();
+            file.path = path;
+            lastFileStart = file.entries.size();
+            if (!indexFile(file, static_cast<std::streamoff>(st.st_size)))
+            {
+                reordered = true;
+            }
+        }
+        files = std::move(newFiles);
+
+        if (reordered || files.empty())
+        {
+            rebuildLookup();
+            return;
+        }
+        // Only the last (active) file can have grown without a rotation, and
+        // its entries are always last, so just append them.
+        bool earlierChanged = false;
+        for (size_t i = 0; i + 1 < files.size(); i++)
+        {
+            earlierChanged = earlierChanged || files[i].grew;
+        }
+        if (earlierChanged)
+        {
+            rebuildLookup();
+            return;
+        }
+        addToLookup(files.size() - 1, lastFileStart);
+    }
+
+    /**
+     * @brief Brings the index up to date only if it has been used.  Intended
+     * for file change notifications, so the files aren't indexed on a system
+     * that never reads the log.
+     */
+    void refreshIfBuilt()
+    {
+        if (built)
+        {
+            refresh();
+        }
+    }
+
+    // Number of listed entries
+    size_t size() const
+    {
+        return listed.size();
+    }
+
+    /**
+     * @brief Reads the line for entry id.  Returns false if there is no such
+     * entry.
+     */
+    bool readEntry(const std::string& id, std::string& logEntry) const
+    {
+        auto it = byId.find(id);
+        if (it == byId.end())
+        {
+            return false;
+        }
+        const IndexedFile& file = files[it->second.file];
+        std::ifstream logStream(file.path);
+        return readAt(logStream, file.entries[it->second.entry].offset,
+                      logEntry);
+    }
+
+    /**
+     * @brief Calls callback(id, line) for at most top listed entries, oldest
+     * first, starting after the first skip.  Stops early if the callback
+     * returns false.
+     */
+    template <typename Callback>
+    void forEachEntry(size_t skip, size_t top, Callback&& callback) const
+    {
+        std::ifstream logStream;
+        size_t openFile = files.size();
+        std::string logEntry;
+        for (size_t i = skip; i < listed.size() && i - skip < top; i++)
+        {
+            const Location& location = listed[i];
+            if (location.file != openFile)
+            {
+                logStream.close();
+                logStream.clear();
+                logStream.open(files[location.file].path);
+                openFile = location.file;
+            }
+            const Entry& entry = files[location.file].entries[location.entry];
+            if (!readAt(logStream, entry.offset, logEntry))
+            {
+                BMCWEB_LOG_ERROR << "Failed to read event log entry "
+                                 << entry.id;
+                continue;
+            }
+            if (!callback(entry.id, logEntry))
+            {
+                return;
+            }
+        }
+    }
+
+  private:
+    struct Entry
+    {
+        std::string id;
+        std::streamoff offset = 0;
+        bool listed = true;
+    };
+
+    struct IndexedFile
+    {
+        std::filesystem::path path;
+        dev_t dev = 0;
+        ino_t inode = 0;
+        std::streamoff indexedSize = 0;
+        bool grew = false;
+        EntryIdGenerator ids;
+        std::vector<Entry> entries;
+    };
+
+    struct Location
+    {
+        size_t file = 0;
+        size_t entry = 0;
+    };
+
+    static bool readAt(std::ifstream& logStream, std::streamoff offset,
+                       std::string& logEntry)
+    {
+        logStream.clear();
+        logStream.seekg(offset);
+        return static_cast<bool>(std::getline(logStream, logEntry));
+    }
+
+    bool isListed(const std::string& logEntry) const
+    {
+        return !filter || filter(getMessageId(logEntry));
+    }
+
+    // Parses complete lines between the already indexed size and fileSize.
+    // A trailing line without a newline is still being written, so it is
+    // left for the next refresh.
+    bool indexFile(IndexedFile& file, std::streamoff fileSize)
+    {
+        file.grew = false;
+        if (fileSize == file.indexedSize)
+        {
+            return true;
+        }
+        std::ifstream logStream(file.path);
+        if (!logStream.is_open())
+        {
+            return false;
+        }
+        logStream.seekg(file.indexedSize);
+
+        std::string logEntry;
+        std::streamoff offset = file.indexedSize;
+        while (std::getline(logStream, logEntry))
+        {
+            if (logStream.eof())
+            {
+                break;
+            }
+            std::streamoff next = logStream.tellg();
+            file.entries.push_back(
+                {file.ids.next(logEntry), offset, isListed(logEntry)});
+            offset = next;
+        }
+        file.grew = offset != file.indexedSize;
+        file.indexedSize = offset;
+        return true;
+    }
+
+    void addToLookup(size_t fileIndex, size_t firstEntry)
+    {
+        const IndexedFile& file = files[fileIndex];
+        for (size_t i = firstEntry; i < file.entries.size(); i++)
+        {
+            const Entry& entry = file.entries[i];
+            // Ids only restart per file; where they collide the oldest entry
+            // wins, as it always has.
+            byId.try_emplace(entry.id, Location{fileIndex, i});
+            if (entry.listed)
+            {
+                listed.push_back({fileIndex, i});
+            }
+        }
+    }
+
+    void rebuildLookup()
+    {
+        byId.clear();
+        listed.clear();
+        for (size_t i = 0; i < files.size(); i++)
+        {
+            addToLookup(i, 0);
+        }
+    }
+
+    std::filesystem::path dir;
+    std::string baseName;
+    Filter filter;
+    bool built = false;
+    std::vector<IndexedFile> files;
+    std::vector<Location> listed;
+    std::unordered_map<std::string, Location> byId;
+};
+
+} // namespace event_log
+} // namespace redfish
@@ -0,0 +1,200 @@
+#pragma once
+
+#include "event_log_index.hpp"
+#include "logging.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace redfish
+{
+namespace event_log
+{
+
+/**
+ * @brief Follows the active redfish event log file, handing over each line
+ * appended to it since the last read().
+ *
+ * The file is kept open and only new bytes are read, through one buffer that
+ * is reused for every read.  A rotation shows up as the path naming another
+ * inode: whatever was still appended to the old file is read first, then the
+ * new file from its start.  A file truncated in place is read again from its
+ * start too.  Lines are given the same entry ids the EventLogIndex gives
+ * them.
+ */
+class EventLogTailer
+{
+  public:
+    explicit EventLogTailer(std::string pathIn) : path(std::move(pathIn)) {}
+
+    EventLogTailer(const EventLogTailer&) = delete;
+    EventLogTailer& operator=(const EventLogTailer&) = delete;
+    EventLogTailer(EventLogTailer&&) = delete;
+    EventLogTailer& operator=(EventLogTailer&&) = delete;
+
+    ~EventLogTailer()
+    {
+        closeFile();
+    }
+
+    // Starts following the file as it is now, so only lines appended after
+    // this are handed over
+    void skipExisting()
+    {
+        read([](std::string_view /*logEntry*/, const std::string& /*id*/) {});
+    }
+
+    /**
+     * @brief Calls callback(logEntry, entryId) for each complete line
+     * appended since the last call.  A trailing line without a newline is
+     * still being written, so it waits for the next call.
+     */
+    template <typename Callback>
+    void read(Callback&& callback)
+    {
+        struct stat st
+        {};
+        bool exists = stat(path.c_str(), &st) == 0;
+        if (fd >= 0 && (!exists || st.st_dev != dev || st.st_ino != inode))
+        {
+            // Rotated away or removed; finish what was written to it
+            readLines(callback);
+            closeFile();
+        }
+        if (!exists)
+        {
+            return;
+        }
+        if (fd < 0)
+        {
+            if (!openFile())
+            {
+                return;
+            }
+        }
+        else if (st.st_size < offset)
+        {
+            BMCWEB_LOG_DEBUG << path << " was truncated; reading from start";
+            if (lseek(fd, 0, SEEK_SET) != 0)
+            {
+                closeFile();
+                return;
+            }
+            restart();
+        }
+        readLines(callback);
+    }
+
+  private:
+    bool openFile()
+    {
+        fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            BMCWEB_LOG_ERROR << "Failed to open " << path << ": "
+                             << std::strerror(errno);
+            return false;
+        }
+        // The inode of what was actually opened, in case of a rotation in
+        // between
+        struct stat st
+        {};
+        if (fstat(fd, &st) != 0)
+        {
+            closeFile();
+            return false;
+        }
+        dev = st.st_dev;
+        inode = st.st_ino;
+        restart();
+        return true;
+    }
+
+    void closeFile()
+    {
+        if (fd >= 0)
+        {
+            close(fd);
+            fd = -1;
+        }
+    }
+
+    void restart()
+    {
+        offset = 0;
+        partial.clear();
+        ids = EntryIdGenerator();
+    }
+
+    template <typename Callback>
+    void readLines(Callback& callback)
+    {
+        while (true)
+        {
+            ssize_t bytesRead =
+                ::read(fd, readBuffer.data(), readBuffer.size());
+            if (bytesRead < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (bytesRead < 0)
+            {
+                BMCWEB_LOG_ERROR << "Failed to read " << path << ": "
+                                 << std::strerror(errno);
+                return;
+            }
+            if (bytesRead == 0)
+            {
+                return;
+            }
+            offset += bytesRead;
+
+            std::string_view data(readBuffer.data(),
+                                  static_cast<size_t>(bytesRead));
+            size_t newline = data.find('\n');
+            if (!partial.empty())
+            {
+                // The start of this line came with the last read
+                if (newline == std::string_view::npos)
+                {
+                    partial += data;
+                    continue;
+                }
+                partial += data.substr(0, newline);
+                callback(std::string_view(partial), ids.next(partial));
+                partial.clear();
+                data.remove_prefix(newline + 1);
+                newline = data.find('\n');
+            }
+            while (newline != std::string_view::npos)
+            {
+                std::string_view logEntry = data.substr(0, newline);
+                callback(logEntry, ids.next(logEntry));
+                data.remove_prefix(newline + 1);
+                newline = data.find('\n');
+            }
+            partial = data;
+        }
+    }
+
+    std::string path;
+    int fd = -1;
+    dev_t dev = 0;
+    ino_t inode = 0;
+    off_t offset = 0;
+    EntryIdGenerator ids;
+    // The line that the last read ended part way through
+    std::string partial;
+    std::array<char, 4096> readBuffer{};
+};
+
+} // namespace event_log
+} // namespace redfish
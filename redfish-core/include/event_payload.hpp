@@ -0,0 +1,169 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace redfish
+{
+
+/**
+ * @brief One EventRecord serialized once and shared by every subscription
+ * it goes to.
+ *
+ * The record is serialized exactly as it appears inside a pretty printed
+ * Event payload.  MemberId and Context depend on the payload and the
+ * subscription, so the record holds placeholders for them where they sort,
+ * and appendTo() fills them in.
+ */
+class SerializedEventRecord
+{
+  public:
+    // takesContext marks records that carry the subscription's Context
+    SerializedEventRecord(nlohmann::json record, bool takesContext)
+    {
+        if (record.is_object())
+        {
+            // Only renumber a MemberId the record already has
+            if (record.contains("MemberId"))
+            {
+                record["MemberId"] = placeholders[memberIdSlot];
+            }
+            if (takesContext)
+            {
+                record["Context"] = placeholders[contextSlot];
+            }
+        }
+        std::string dumped = record.dump(
+            2, ' ', true, nlohmann::json::error_handler_t::replace);
+
+        // Indent the record to its depth within the payload.  Strings are
+        // escaped, so every newline is one the dump added.
+        std::string body;
+        body.reserve(dumped.size() + dumped.size() / 8);
+        for (char c : dumped)
+        {
+            body += c;
+            if (c == '\n')
+            {
+                body += "    ";
+            }
+        }
+
+        std::array<std::string, 2> quoted;
+        for (size_t slot = 0; slot < quoted.size(); slot++)
+        {
+            quoted[slot] = nlohmann::json(placeholders[slot]).dump(-1, ' ',
+                                                                   true);
+        }
+        size_t start = 0;
+        while (true)
+        {
+            size_t found = std::string::npos;
+            size_t foundSlot = 0;
+            for (size_t slot = 0; slot < quoted.size(); slot++)
+            {
+                size_t pos = body.find(quoted[slot], start);
+                if (pos < found)
+                {
+                    found = pos;
+                    foundSlot = slot;
+                }
+            }
+            if (found == std::string::npos)
+            {
+                break;
+            }
+            pieces.emplace_back(body, start, found - start);
+            slots.push_back(foundSlot);
+            start = found + quoted[foundSlot].size();
+        }
+        pieces.emplace_back(body, start);
+    }
+
+    void appendTo(std::string& out, size_t memberId,
+                  std::string_view context) const
+    {
+        out += pieces.front();
+        for (size_t i = 0; i < slots.size(); i++)
+        {
+            if (slots[i] == memberIdSlot)
+            {
+                out += std::to_string(memberId);
+            }
+            else
+            {
+                out += nlohmann::json(context).dump(
+                    -1, ' ', true, nlohmann::json::error_handler_t::replace);
+            }
+            out += pieces[i + 1];
+        }
+    }
+
+    // Size of the record without its MemberId and Context
+    size_t size() const
+    {
+        size_t total = 0;
+        for (const std::string& piece : pieces)
+        {
+            total += piece.size();
+        }
+        return total;
+    }
+
+  private:
+    static constexpr size_t memberIdSlot = 0;
+    static constexpr size_t contextSlot = 1;
+    // Control characters are always escaped, so these can't be confused
+    // with a string that was in the record
+    static constexpr std::array<std::string_view, 2> placeholders = {
+        "\x01MemberId", "\x01Context"};
+
+    std::vector<std::string> pieces;
+    std::vector<size_t> slots;
+};
+
+/**
+ * @brief Builds an Event payload from records that were serialized once,
+ * with MemberIds numbered from 0 and context as the Context of the records
+ * that take one.  The payload is byte for byte what dumping the whole Event
+ * with an indent of 2 would produce.
+ */
+inline std::shared_ptr<const std::string> makeEventPayload(
+    std::string_view id,
+    std::span<const std::shared_ptr<const SerializedEventRecord>> records,
+    std::string_view context)
+{
+    std::string payload = "{\n  \"@odata.type\": \"#Event.v1_4_0.Event\",\n"
+                          "  \"Events\": [";
+    size_t recordsSize = 0;
+    for (const std::shared_ptr<const SerializedEventRecord>& record : records)
+    {
+        recordsSize += record->size() + context.size() + 32;
+    }
+    payload.reserve(payload.size() + recordsSize + id.size() + 48);
+
+    for (size_t i = 0; i < records.size(); i++)
+    {
+        payload += i == 0 ? "\n    " : ",\n    ";
+        records[i]->appendTo(payload, i, context);
+    }
+    if (!records.empty())
+    {
+        payload += "\n  ";
+    }
+    payload += "],\n  \"Id\": ";
+    payload += nlohmann::json(id).dump(
+        -1, ' ', true, nlohmann::json::error_handler_t::replace);
+    payload += ",\n  \"Name\": \"Event Log\"\n}";
+    return std::make_shared<const std::string>(std::move(payload));
+}
+
+} // namespace redfish
@@ -14,11 +14,16 @@
 // limitations under the License.
 */
 #pragma once
+#include "bmcweb_config.h"
+#include "event_log_index.hpp"
+#include "event_log_tailer.hpp"
+#include "event_payload.hpp"
+#include "event_spool.hpp"
+#include "event_subscription_filter.hpp"
+#include "metric_aggregator.hpp"
 #include "metric_report.hpp"
 #include "registries.hpp"
-#include "registries/base_message_registry.hpp"
-#include "registries/openbmc_message_registry.hpp"
-#include "registries/task_event_message_registry.hpp"
+#include "registries_selector.hpp"
 #include "utility.hpp"
 
 #include <sys/inotify.h>
@@ -26,6 +31,7 @@
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/split.hpp>
 #include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <boost/container/flat_map.hpp>
 #include <dbus_utility.hpp>
 #include <error_messages.hpp>
@@ -37,11 +43,16 @@
 #include <server_sent_events.hpp>
 #include <utils/json_utils.hpp>
 
+#include <chrono>
 #include <cstdlib>
 #include <ctime>
+#include <filesystem>
 #include <fstream>
 #include <memory>
+#include <optional>
 #include <span>
+#include <sstream>
+#include <unordered_map>
 
 namespace redfish
 {
@@ -55,27 +66,6 @@ static constexpr const char* metricReportFormatType = "MetricReport";
 static constexpr const char* eventServiceFile =
     "/var/lib/bmcweb/eventservice_config.json";
 
-namespace registries
-{
-inline std::span<const MessageEntry>
-    getRegistryFromPrefix(const std::string& registryName)
-{
-    if (task_event::header.registryPrefix == registryName)
-    {
-        return {task_event::registry};
-    }
-    if (openbmc::header.registryPrefix == registryName)
-    {
-        return {openbmc::registry};
-    }
-    if (base::header.registryPrefix == registryName)
-    {
-        return {base::registry};
-    }
-    return {openbmc::registry};
-}
-} // namespace registries
-
 #ifndef BMCWEB_ENABLE_REDFISH_DBUS_LOG_ENTRIES
 static std::optional<boost::asio::posix::stream_descriptor> inotifyConn;
 static constexpr const char* redfishEventLogDir = "/var/log";
@@ -85,146 +75,16 @@ static int inotifyFd = -1;
 static int dirWatchDesc = -1;
 static int fileWatchDesc = -1;
 
-// <ID, timestamp, RedfishLogId, registryPrefix, MessageId, MessageArgs>
-using EventLogObjectsType =
-    std::tuple<std::string, std::string, std::string, std::string, std::string,
-               std::vector<std::string>>;
-
-namespace registries
-{
-static const Message*
-    getMsgFromRegistry(const std::string& messageKey,
-                       const std::span<const MessageEntry>& registry)
-{
-    std::span<const MessageEntry>::iterator messageIt =
-        std::find_if(registry.begin(), registry.end(),
-                     [&messageKey](const MessageEntry& messageEntry) {
-        return messageKey == messageEntry.first;
-    });
-    if (messageIt != registry.end())
-    {
-        return &messageIt->second;
-    }
-
-    return nullptr;
-}
-
-static const Message* formatMessage(const std::string_view& messageID)
+// A redfish event log entry, formatted once for every subscription
+struct EventLogRecord
 {
-    // Redfish MessageIds are in the form
-    // RegistryName.MajorVersion.MinorVersion.MessageKey, so parse it to find
-    // the right Message
-    std::vector<std::string> fields;
-    fields.reserve(4);
-    boost::split(fields, messageID, boost::is_any_of("."));
-    if (fields.size() != 4)
-    {
-        return nullptr;
-    }
-    const std::string& registryName = fields[0];
-    const std::string& messageKey = fields[3];
-
-    // Find the right registry and check it for the MessageKey
-    return getMsgFromRegistry(messageKey, getRegistryFromPrefix(registryName));
-}
-} // namespace registries
+    std::string registryName;
+    std::string messageKey;
+    std::shared_ptr<const SerializedEventRecord> record;
+};
 
 namespace event_log
 {
-inline bool getUniqueEntryID(const std::string& logEntry, std::string& entryID)
-{
-    static time_t prevTs = 0;
-    static int index = 0;
-
-    // Get the entry timestamp
-    std::time_t curTs = 0;
-    std::tm timeStruct = {};
-    std::istringstream entryStream(logEntry);
-    if (entryStream >> std::get_time(&timeStruct, "%Y-%m-%dT%H:%M:%S"))
-    {
-        curTs = std::mktime(&timeStruct);
-        if (curTs == -1)
-        {
-            return false;
-        }
-    }
-    // If the timestamp isn't unique, increment the index
-    index = (curTs == prevTs) ? index + 1 : 0;
-
-    // Save the timestamp
-    prevTs = curTs;
-
-    entryID = std::to_string(curTs);
-    if (index > 0)
-    {
-        entryID += "_" + std::to_string(index);
-    }
-    return true;
-}
-
-inline int getEventLogParams(const std::string& logEntry,
-                             std::string& timestamp, std::string& messageID,
-                             std::vector<std::string>& messageArgs)
-{
-    // The redfish log format is "<Timestamp> <MessageId>,<MessageArgs>"
-    // First get the Timestamp
-    size_t space = logEntry.find_first_of(' ');
-    if (space == std::string::npos)
-    {
-        return -EINVAL;
-    }
-    timestamp = logEntry.substr(0, space);
-    // Then get the log contents
-    size_t entryStart = logEntry.find_first_not_of(' ', space);
-    if (entryStart == std::string::npos)
-    {
-        return -EINVAL;
-    }
-    std::string_view entry(logEntry);
-    entry.remove_prefix(entryStart);
-    // Use split to separate the entry into its fields
-    std::vector<std::string> logEntryFields;
-    boost::split(logEntryFields, entry, boost::is_any_of(","),
-                 boost::token_compress_on);
-    // We need at least a MessageId to be valid
-    if (logEntryFields.empty())
-    {
-        return -EINVAL;
-    }
-    messageID = logEntryFields[0];
-
-    // Get the MessageArgs from the log if there are any
-    if (logEntryFields.size() > 1)
-    {
-        const std::string& messageArgsStart = logEntryFields[1];
-        // If the first string is empty, assume there are no MessageArgs
-        if (!messageArgsStart.empty())
-        {
-            messageArgs.assign(logEntryFields.begin() + 1,
-                               logEntryFields.end());
-        }
-    }
-
-    return 0;
-}
-
-inline void getRegistryAndMessageKey(const std::string& messageID,
-                                     std::string& registryName,
-                                     std::string& messageKey)
-{
-    // Redfish MessageIds are in the form
-    // RegistryName.MajorVersion.MinorVersion.MessageKey, so parse it to find
-    // the right Message
-    std::vector<std::string> fields;
-    fields.reserve(4);
-    boost::split(fields, messageID, boost::is_any_of("."));
-    if (fields.size() == 4)
-    {
-        registryName = fields[0];
-        messageKey = fields[3];
-    }
-}
-
 inline int formatEventLogEntry(const std::string& logEntryID,
                                const std::string& messageID,
                                const std::span<std::string_view> messageArgs,
@@ -233,7 +93,7 @@ inline int formatEventLogEntry(const std::string& logEntryID,
                                nlohmann::json& logEntryJson)
 {
     // Get the Message from the MessageRegistry
-    const registries::Message* message = registries::formatMessage(messageID);
+    const registries::Message* message = registries::getMessage(messageID);
 
     if (message == nullptr)
     {
@@ -362,7 +222,20 @@ inline bool
     return true;
 }
 
-class Subscription : public persistent_data::UserSubscription
+// How a subscription groups Events into payloads.  Events wait until
+// maxEvents of them are pending or the oldest has waited maxLatency, then go
+// out together in one Event payload.
+struct EventBatchPolicy
+{
+    // 1 sends every Event on its own, as soon as it happens
+    size_t maxEvents = bmcwebEventBatchMaxEvents;
+    std::chrono::milliseconds maxLatency =
+        std::chrono::milliseconds(bmcwebEventBatchMaxLatencyMs);
+};
+
+class Subscription :
+    public persistent_data::UserSubscription,
+    public std::enable_shared_from_this<Subscription>
 {
   public:
     Subscription(const Subscription&) = delete;
@@ -373,23 +246,37 @@ class Subscription : public persistent_data::UserSubscription
     Subscription(const std::string& inHost, uint16_t inPort,
                  const std::string& inPath, const std::string& inUriProto) :
         host(inHost),
-        port(inPort), policy(std::make_shared<crow::ConnectionPolicy>()),
-        client(policy), path(inPath), uriProto(inUriProto)
+        port(inPort), policy(getSharedPolicy()), client(policy, true),
+        path(inPath), uriProto(inUriProto)
+    {}
+
+    // A subscription that lasts as long as the stream of an
+    // EventService/SSE client
+    explicit Subscription(const std::shared_ptr<crow::SseStream>& stream) :
+        policy(getSharedPolicy()), client(policy, true), sseStream(stream)
     {
-        // Subscription constructor
-        policy->invalidResp = retryRespHandler;
+        subscriptionType = "SSE";
     }
 
-    explicit Subscription(
-        const std::shared_ptr<boost::asio::ip::tcp::socket>& adaptor) :
-        policy(std::make_shared<crow::ConnectionPolicy>()),
-        client(policy),
-        sseConn(std::make_shared<crow::ServerSentEvents>(adaptor))
-    {}
-
-    ~Subscription() = default;
+    ~Subscription()
+    {
+        std::shared_ptr<crow::SseStream> stream = sseStream.lock();
+        if (stream != nullptr)
+        {
+            stream->finish();
+        }
+    }
 
     bool sendEvent(std::string& msg)
+    {
+        return sendEvent(std::make_shared<const std::string>(std::move(msg)),
+                         std::to_string(eventSeqNum));
+    }
+
+    // Sends a payload that may be shared with other subscriptions.  payloadId
+    // is the Id within it, which SSE clients get as the event id.
+    bool sendEvent(const std::shared_ptr<const std::string>& msg,
+                   std::string_view payloadId)
     {
         if (subscriptionType == "SNMPTrap")
         {
@@ -404,19 +291,83 @@ class Subscription : public persistent_data::UserSubscription
             return false;
         }
 
-        bool useSSL = (uriProto == "https");
-        // A connection pool will be created if one does not already exist
-        client.sendData(msg, host, port, path, useSSL, httpHeaders,
-                        boost::beast::http::verb::post);
         eventSeqNum++;
+        if (isServerSentEvents())
+        {
+            std::shared_ptr<crow::SseStream> stream = sseStream.lock();
+            if (stream == nullptr)
+            {
+                return false;
+            }
+            stream->push(crow::getSseEvent(msg, payloadId));
+            return true;
+        }
 
-        if (sseConn != nullptr)
+        bool useSSL = (uriProto == "https");
+        if (bmcwebEventSpoolSizeKb == 0)
         {
-            sseConn->sendData(eventSeqNum, msg);
+            // A connection pool will be created if one does not already exist
+            client.sendData(msg, host, port, path, useSSL, httpHeaders,
+                            boost::beast::http::verb::post);
+            return true;
+        }
+        // Once anything is spooled, later events wait behind it so the
+        // destination still gets them in order
+        if (spool != nullptr)
+        {
+            spoolEvent(*msg);
+            return true;
         }
+        client.sendDataWithCallback(
+            msg, host, port, path, useSSL, httpHeaders,
+            boost::beast::http::verb::post,
+            [weakSelf{weak_from_this()}, msg](crow::Response& res) {
+            std::shared_ptr<Subscription> self = weakSelf.lock();
+            if (self == nullptr || isDelivered(res))
+            {
+                return;
+            }
+            self->spoolEvent(*msg);
+        });
         return true;
     }
 
+    // Picks up the events spooled before a restart
+    void resumeSpool()
+    {
+        std::error_code ec;
+        if (bmcwebEventSpoolSizeKb == 0 || isServerSentEvents() ||
+            !std::filesystem::exists(spoolPath(), ec))
+        {
+            return;
+        }
+        if (openSpool())
+        {
+            BMCWEB_LOG_INFO << "Resending " << spool->size()
+                            << " spooled events for subscription " << id;
+            scheduleReplay(spoolReplayInterval());
+        }
+    }
+
+    // Drops anything spooled, for a subscription that's being deleted
+    void discardSpool()
+    {
+        replayTimer.cancel();
+        if (spool != nullptr)
+        {
+            spool->remove();
+            spool.reset();
+            return;
+        }
+        std::error_code ec;
+        std::filesystem::remove(spoolPath(), ec);
+    }
+
+    bool isServerSentEvents() const
+    {
+        return subscriptionType == "SSE";
+    }
+
     bool sendTestEventLog()
     {
         nlohmann::json logEntryArray;
@@ -444,115 +395,162 @@ class Subscription : public persistent_data::UserSubscription
         return this->sendEvent(strMsg);
     }
 
-#ifndef BMCWEB_ENABLE_REDFISH_DBUS_LOG_ENTRIES
-    void filterAndSendEventLogs(
-        const std::vector<EventLogObjectsType>& eventRecords)
+    bool isBatchingEvents() const
     {
-        nlohmann::json logEntryArray;
-        for (const EventLogObjectsType& logEntry : eventRecords)
+        return batchPolicy.maxEvents > 1;
+    }
+
+    /**
+     * @brief Sends records as one Event payload with the given Id, or, when
+     * the batch policy allows more than one event per payload, holds them to
+     * go out with the events that follow.  Batched payloads take their Id
+     * from the subscription's sequence number.
+     */
+    void sendEventRecords(
+        std::vector<std::shared_ptr<const SerializedEventRecord>>&& records,
+        const std::string& payloadId)
+    {
+        if (!isBatchingEvents())
         {
-            const std::string& idStr = std::get<0>(logEntry);
-            const std::string& timestamp = std::get<1>(logEntry);
-            const std::string& messageID = std::get<2>(logEntry);
-            const std::string& registryName = std::get<3>(logEntry);
-            const std::string& messageKey = std::get<4>(logEntry);
-            const std::vector<std::string>& messageArgs = std::get<5>(logEntry);
+            sendEvent(makeEventPayload(payloadId, records, customText),
+                      payloadId);
+            return;
+        }
 
-            // If registryPrefixes list is empty, don't filter events
-            // send everything.
-            if (!registryPrefixes.empty())
+        pendingEvents.insert(pendingEvents.end(),
+                             std::make_move_iterator(records.begin()),
+                             std::make_move_iterator(records.end()));
+        if (pendingEvents.size() >= batchPolicy.maxEvents ||
+            batchPolicy.maxLatency.count() == 0)
+        {
+            flushEvents();
+            return;
+        }
+        if (batchTimerRunning)
+        {
+            return;
+        }
+        batchTimerRunning = true;
+        batchTimer.expires_after(batchPolicy.maxLatency);
+        batchTimer.async_wait([weakSelf{weak_from_this()}](
+                                  const boost::system::error_code& ec) {
+            if (ec == boost::asio::error::operation_aborted)
             {
-                auto obj = std::find(registryPrefixes.begin(),
-                                     registryPrefixes.end(), registryName);
-                if (obj == registryPrefixes.end())
-                {
-                    continue;
-                }
+                return;
             }
-
-            // If registryMsgIds list is empty, don't filter events
-            // send everything.
-            if (!registryMsgIds.empty())
+            std::shared_ptr<Subscription> self = weakSelf.lock();
+            if (self == nullptr)
             {
-                auto obj = std::find(registryMsgIds.begin(),
-                                     registryMsgIds.end(), messageKey);
-                if (obj == registryMsgIds.end())
-                {
-                    continue;
-                }
+                return;
             }
+            self->batchTimerRunning = false;
+            self->flushEvents();
+        });
+    }
 
-            std::vector<std::string_view> messageArgsView(messageArgs.begin(),
-                                                          messageArgs.end());
+    // Sends everything waiting in the batch, at most maxEvents per payload
+    void flushEvents()
+    {
+        if (batchTimerRunning)
+        {
+            batchTimer.cancel();
+            batchTimerRunning = false;
+        }
+        size_t maxEvents = std::max<size_t>(batchPolicy.maxEvents, 1);
+        std::span<const std::shared_ptr<const SerializedEventRecord>> pending(
+            pendingEvents);
+        while (!pending.empty())
+        {
+            size_t count = std::min(pending.size(), maxEvents);
+            std::string payloadId = std::to_string(eventSeqNum);
+            sendEvent(
+                makeEventPayload(payloadId, pending.first(count), customText),
+                payloadId);
+            pending = pending.subspan(count);
+        }
+        pendingEvents.clear();
+    }
 
-            logEntryArray.push_back({});
-            nlohmann::json& bmcLogEntry = logEntryArray.back();
-            if (event_log::formatEventLogEntry(idStr, messageID,
-                                               messageArgsView, timestamp,
-                                               customText, bmcLogEntry) != 0)
+    void setBatchPolicy(const EventBatchPolicy& policyIn)
+    {
+        batchPolicy = policyIn;
+        if (batchPolicy.maxEvents <= 1)
+        {
+            flushEvents();
+        }
+    }
+
+    const EventBatchPolicy& getBatchPolicy() const
+    {
+        return batchPolicy;
+    }
+
+#ifndef BMCWEB_ENABLE_REDFISH_DBUS_LOG_ENTRIES
+    void filterAndSendEventLogs(const std::vector<EventLogRecord>& eventRecords)
+    {
+        std::vector<std::shared_ptr<const SerializedEventRecord>> records;
+        for (const EventLogRecord& logEntry : eventRecords)
+        {
+            // Empty registryPrefixes and registryMsgIds lists don't filter
+            // events, send everything.
+            if (!filter.registryPrefixes.matches(logEntry.registryName) ||
+                !filter.messageIds.matches(logEntry.messageKey))
             {
-                BMCWEB_LOG_DEBUG << "Read eventLog entry failed";
                 continue;
             }
+            records.emplace_back(logEntry.record);
         }
 
-        if (logEntryArray.empty())
+        if (records.empty())
         {
             BMCWEB_LOG_DEBUG << "No log entries available to be transferred.";
             return;
         }
 
-        nlohmann::json msg;
-        msg["@odata.type"] = "#Event.v1_4_0.Event";
-        msg["Id"] = std::to_string(eventSeqNum);
-        msg["Name"] = "Event Log";
-        msg["Events"] = logEntryArray;
-
-        std::string strMsg = msg.dump(2, ' ', true,
-                                      nlohmann::json::error_handler_t::replace);
-        this->sendEvent(strMsg);
+        sendEventRecords(std::move(records), std::to_string(eventSeqNum));
     }
 #endif
 
-    void filterAndSendReports(const std::string& reportId,
-                              const telemetry::TimestampReadings& var)
+    // report is the unaggregated report, serialized on first use and shared
+    // with the other subscriptions
+    void filterAndSendReports(
+        const std::string& reportId, const boost::urls::url& definitionUri,
+        const telemetry::TimestampReadings& readings,
+        std::optional<telemetry::MetricReportPayload>& report)
     {
-        boost::urls::url mrdUri =
-            crow::utility::urlFromPieces("redfish", "v1", "TelemetryService",
-                                         "MetricReportDefinitions", reportId);
-
         // Empty list means no filter. Send everything.
-        if (!metricReportDefinitions.empty())
+        if (!filter.metricReportDefinitions.matches(definitionUri.buffer()))
         {
-            if (std::find(metricReportDefinitions.begin(),
-                          metricReportDefinitions.end(),
-                          mrdUri.buffer()) == metricReportDefinitions.end())
-            {
-                return;
-            }
-        }
-
-        nlohmann::json msg;
-        if (!telemetry::fillReport(msg, reportId, var))
-        {
-            BMCWEB_LOG_ERROR << "Failed to fill the MetricReport for DBus "
-                                "Report with id "
-                             << reportId;
             return;
         }
 
         // Context is set by user during Event subscription and it must be
         // set for MetricReport response.
-        if (!customText.empty())
+        if (metricAggregation)
+        {
+            auto aggregator =
+                metricAggregators.try_emplace(reportId, *metricAggregation,
+                                              metricAggregationInterval);
+            std::optional<telemetry::TimestampReadings> aggregated =
+                aggregator.first->second.add(readings);
+            if (!aggregated)
+            {
+                return;
+            }
+            sendEvent(telemetry::MetricReportPayload(reportId, *aggregated)
+                          .forContext(customText),
+                      std::to_string(eventSeqNum));
+            return;
+        }
+        if (!report)
         {
-            msg["Context"] = customText;
+            report.emplace(reportId, readings);
         }
-
-        std::string strMsg = msg.dump(2, ' ', true,
-                                      nlohmann::json::error_handler_t::replace);
-        this->sendEvent(strMsg);
+        sendEvent(report->forContext(customText), std::to_string(eventSeqNum));
     }
 
+    // The retry settings are the EventService's, so they're the same for
+    // every subscription
     void updateRetryConfig(uint32_t retryAttempts,
                            uint32_t retryTimeoutInterval)
     {
@@ -565,6 +563,28 @@ class Subscription : public persistent_data::UserSubscription
         return eventSeqNum;
     }
 
+    // Rebuilds the filter from the filter properties.  Needs to be called
+    // whenever RegistryPrefixes, MessageIds, ResourceTypes or
+    // MetricReportDefinitions change.
+    void compileFilter()
+    {
+        filter.registryPrefixes = EventValueFilter(registryPrefixes);
+        filter.messageIds = EventValueFilter(registryMsgIds);
+        filter.resourceTypes = EventValueFilter(resourceTypes);
+        filter.metricReportDefinitions =
+            EventValueFilter(metricReportDefinitions);
+        metricAggregation =
+            telemetry::aggregationFunctionFromString(metricAggregationFunction);
+        metricAggregationInterval =
+            std::chrono::milliseconds(metricAggregationIntervalMs);
+        metricAggregators.clear();
+    }
+
+    bool isSubscribedToResourceType(std::string_view resType) const
+    {
+        return filter.resourceTypes.matches(resType);
+    }
+
   private:
     uint64_t eventSeqNum = 1;
     std::string host;
@@ -573,7 +593,152 @@ class Subscription : public persistent_data::UserSubscription
     crow::HttpClient client;
     std::string path;
     std::string uriProto;
-    std::shared_ptr<crow::ServerSentEvents> sseConn = nullptr;
+    std::weak_ptr<crow::SseStream> sseStream;
+    EventSubscriptionFilter filter;
+    std::optional<telemetry::AggregationFunction> metricAggregation;
+    std::chrono::milliseconds metricAggregationInterval{0};
+    // By Report id
+    std::unordered_map<std::string, telemetry::MetricAggregator>
+        metricAggregators;
+
+    EventBatchPolicy batchPolicy;
+    std::vector<std::shared_ptr<const SerializedEventRecord>> pendingEvents;
+    boost::asio::steady_timer batchTimer{
+        crow::connections::systemBus->get_io_context()};
+    bool batchTimerRunning = false;
+
+    // One policy for every subscription, which retry alike, so those sending
+    // to the same destination share one connection pool.  With a single
+    // connection per pool, each subscription's events still go out in the
+    // order they were sent.
+    static std::shared_ptr<crow::ConnectionPolicy> getSharedPolicy()
+    {
+        static std::shared_ptr<crow::ConnectionPolicy> shared = [] {
+            auto sharedPolicy = std::make_shared<crow::ConnectionPolicy>();
+            sharedPolicy->invalidResp = retryRespHandler;
+            return sharedPolicy;
+        }();
+        return shared;
+    }
+
+    // Undelivered events, oldest first; open while any are waiting
+    std::unique_ptr<EventSpool> spool;
+    boost::asio::steady_timer replayTimer{
+        crow::connections::systemBus->get_io_context()};
+
+    // How long a destination that failed a resend is left before the next
+    static constexpr std::chrono::seconds spoolRetryInterval{30};
+
+    static std::chrono::milliseconds spoolReplayInterval()
+    {
+        return std::chrono::milliseconds(1000 / bmcwebEventSpoolReplayRate);
+    }
+
+    static bool isDelivered(const crow::Response& res)
+    {
+        unsigned int code = res.resultInt();
+        return code >= 200 && code < 300;
+    }
+
+    std::filesystem::path spoolPath() const
+    {
+        return std::filesystem::path(eventSpoolDir) / id;
+    }
+
+    bool openSpool()
+    {
+        if (spool != nullptr)
+        {
+            return true;
+        }
+        if (id.empty())
+        {
+            return false;
+        }
+        spool = std::make_unique<EventSpool>(spoolPath(),
+                                             bmcwebEventSpoolSizeKb * 1024);
+        if (!spool->open())
+        {
+            spool.reset();
+            return false;
+        }
+        return true;
+    }
+
+    // Keeps an event the destination didn't take, after the client's own
+    // retries, to resend once the destination is back.  Events sent while
+    // anything is spooled come here directly, so memory stays flat for as
+    // long as the destination is down.
+    void spoolEvent(std::string_view payload)
+    {
+        if (spool == nullptr)
+        {
+            if (!openSpool())
+            {
+                return;
+            }
+            BMCWEB_LOG_WARNING << "Spooling events for subscription " << id;
+            scheduleReplay(spoolRetryInterval);
+        }
+        spool->push(payload);
+    }
+
+    void scheduleReplay(std::chrono::milliseconds delay)
+    {
+        replayTimer.expires_after(delay);
+        replayTimer.async_wait([weakSelf{weak_from_this()}](
+                                   const boost::system::error_code& ec) {
+            if (ec)
+            {
+                return;
+            }
+            std::shared_ptr<Subscription> self = weakSelf.lock();
+            if (self == nullptr)
+            {
+                return;
+            }
+            self->replaySpool();
+        });
+    }
+
+    // Resends the oldest spooled event, then the next no sooner than the
+    // replay rate allows, so a destination coming back isn't flooded
+    void replaySpool()
+    {
+        if (spool == nullptr)
+        {
+            return;
+        }
+        std::optional<std::string> payload = spool->front();
+        if (!payload)
+        {
+            // Everything has been resent, or what's left can't be read
+            BMCWEB_LOG_INFO << "Event spool for subscription " << id
+                            << " drained, " << spool->droppedCount()
+                            << " events dropped";
+            spool->remove();
+            spool.reset();
+            return;
+        }
+        client.sendDataWithCallback(
+            std::make_shared<const std::string>(std::move(*payload)), host,
+            port, path, uriProto == "https", httpHeaders,
+            boost::beast::http::verb::post,
+            [weakSelf{weak_from_this()}](crow::Response& res) {
+            std::shared_ptr<Subscription> self = weakSelf.lock();
+            if (self == nullptr || self->spool == nullptr)
+            {
+                return;
+            }
+            if (!isDelivered(res))
+            {
+                self->scheduleReplay(spoolRetryInterval);
+                return;
+            }
+            self->spool->pop();
+            self->scheduleReplay(spoolReplayInterval());
+        });
+    }
 
     // Check used to indicate what response codes are valid as part of our retry
     // policy.  2XX is considered acceptable
@@ -606,7 +771,9 @@ class EventServiceManager
         initConfig();
     }
 
-    std::streampos redfishLogFilePosition{0};
+#ifndef BMCWEB_ENABLE_REDFISH_DBUS_LOG_ENTRIES
+    event_log::EventLogTailer redfishLogTailer{redfishEventLogFile};
+#endif
     size_t noOfEventLogSubscribers{0};
     size_t noOfMetricReportSubscribers{0};
     std::shared_ptr<sdbusplus::bus::match_t> matchTelemetryMonitor;
@@ -674,6 +841,11 @@ class EventServiceManager
             subValue->resourceTypes = newSub->resourceTypes;
             subValue->httpHeaders = newSub->httpHeaders;
             subValue->metricReportDefinitions = newSub->metricReportDefinitions;
+            subValue->metricAggregationFunction =
+                newSub->metricAggregationFunction;
+            subValue->metricAggregationIntervalMs =
+                newSub->metricAggregationIntervalMs;
+            subValue->compileFilter();
 
             if (subValue->id.empty())
             {
@@ -683,13 +855,9 @@ class EventServiceManager
 
             updateNoOfSubscribersCount();
 
-#ifndef BMCWEB_ENABLE_REDFISH_DBUS_LOG_ENTRIES
-
-            cacheRedfishLogFile();
-
-#endif
             // Update retry configuration.
             subValue->updateRetryConfig(retryAttempts, retryTimeoutInterval);
+            subValue->resumeSpool();
         }
     }
 
@@ -782,7 +950,7 @@ class EventServiceManager
         persistent_data::EventServiceStore::getInstance()
             .eventServiceConfig.retryTimeoutInterval = retryTimeoutInterval;
 
-        persistent_data::getConfig().writeData();
+        persistent_data::getConfig().scheduleWrite();
     }
 
     void setEventServiceConfig(const persistent_data::EventServiceConfig& cfg)
@@ -882,6 +1050,8 @@ class EventServiceManager
     void addSubscription(const std::shared_ptr<Subscription>& subValue,
                          std::string& id, const bool updateFile = true)
     {
+        subValue->compileFilter();
+
         std::uniform_int_distribution<uint32_t> dist(0);
         bmcweb::OpenSSLGenerator gen;
 
@@ -912,36 +1082,39 @@ class EventServiceManager
             return;
         }
 
-        std::shared_ptr<persistent_data::UserSubscription> newSub =
-            std::make_shared<persistent_data::UserSubscription>();
-        newSub->id = id;
-        newSub->destinationUrl = subValue->destinationUrl;
-        newSub->protocol = subValue->protocol;
-        newSub->retryPolicy = subValue->retryPolicy;
-        newSub->customText = subValue->customText;
-        newSub->eventFormatType = subValue->eventFormatType;
-        newSub->subscriptionType = subValue->subscriptionType;
-        newSub->registryMsgIds = subValue->registryMsgIds;
-        newSub->registryPrefixes = subValue->registryPrefixes;
-        newSub->resourceTypes = subValue->resourceTypes;
-        newSub->httpHeaders = subValue->httpHeaders;
-        newSub->metricReportDefinitions = subValue->metricReportDefinitions;
-        persistent_data::EventServiceStore::getInstance()
-            .subscriptionsConfigMap.emplace(newSub->id, newSub);
+        // SSE subscriptions go with their stream, so aren't persisted
+        if (!subValue->isServerSentEvents())
+        {
+            std::shared_ptr<persistent_data::UserSubscription> newSub =
+                std::make_shared<persistent_data::UserSubscription>();
+            newSub->id = id;
+            newSub->destinationUrl = subValue->destinationUrl;
+            newSub->protocol = subValue->protocol;
+            newSub->retryPolicy = subValue->retryPolicy;
+            newSub->customText = subValue->customText;
+            newSub->eventFormatType = subValue->eventFormatType;
+            newSub->subscriptionType = subValue->subscriptionType;
+            newSub->registryMsgIds = subValue->registryMsgIds;
+            newSub->registryPrefixes = subValue->registryPrefixes;
+            newSub->resourceTypes = subValue->resourceTypes;
+            newSub->httpHeaders = subValue->httpHeaders;
+            newSub->metricReportDefinitions =
+                subValue->metricReportDefinitions;
+            newSub->metricAggregationFunction =
+                subValue->metricAggregationFunction;
+            newSub->metricAggregationIntervalMs =
+                subValue->metricAggregationIntervalMs;
+            persistent_data::EventServiceStore::getInstance()
+                .subscriptionsConfigMap.emplace(newSub->id, newSub);
+        }
 
         updateNoOfSubscribersCount();
 
-        if (updateFile)
+        if (updateFile && !subValue->isServerSentEvents())
         {
             updateSubscriptionData();
         }
 
-#ifndef BMCWEB_ENABLE_REDFISH_DBUS_LOG_ENTRIES
-        if (redfishLogFilePosition != 0)
-        {
-            cacheRedfishLogFile();
-        }
-#endif
         // Update retry configuration.
         subValue->updateRetryConfig(retryAttempts, retryTimeoutInterval);
     }
@@ -957,12 +1130,18 @@ class EventServiceManager
         auto obj = subscriptionsMap.find(id);
         if (obj != subscriptionsMap.end())
         {
+            bool persisted = !obj->second->isServerSentEvents();
+            obj->second->discardSpool();
             subscriptionsMap.erase(obj);
+            updateNoOfSubscribersCount();
+            if (!persisted)
+            {
+                return;
+            }
             auto obj2 = persistent_data::EventServiceStore::getInstance()
                             .subscriptionsConfigMap.find(id);
             persistent_data::EventServiceStore::getInstance()
                 .subscriptionsConfigMap.erase(obj2);
-            updateNoOfSubscribersCount();
             updateSubscriptionData();
         }
     }
@@ -1017,8 +1196,6 @@ class EventServiceManager
             BMCWEB_LOG_DEBUG << "EventService disabled or no Subscriptions.";
             return;
         }
-        nlohmann::json eventRecord = nlohmann::json::array();
-
         eventMessage["EventId"] = eventId;
         // MemberId is 0 : since we are sending one event record.
         eventMessage["MemberId"] = 0;
@@ -1026,32 +1203,17 @@ class EventServiceManager
             redfish::time_utils::getDateTimeOffsetNow().first;
         eventMessage["OriginOfCondition"] = origin;
 
-        eventRecord.emplace_back(std::move(eventMessage));
+        // The record is the same for every subscription, so only serialize
+        // it once.  Each subscription still gets a payload Id of its own.
+        auto record = std::make_shared<const SerializedEventRecord>(
+            std::move(eventMessage), false);
 
         for (const auto& it : this->subscriptionsMap)
         {
             std::shared_ptr<Subscription> entry = it.second;
-            bool isSubscribed = false;
-            // Search the resourceTypes list for the subscription.
             // If resourceTypes list is empty, don't filter events
             // send everything.
-            if (!entry->resourceTypes.empty())
-            {
-                for (const auto& resource : entry->resourceTypes)
-                {
-                    if (resType == resource)
-                    {
-                        BMCWEB_LOG_INFO << "ResourceType " << resource
-                                        << " found in the subscribed list";
-                        isSubscribed = true;
-                        break;
-                    }
-                }
-            }
-            else // resourceTypes list is empty.
-            {
-                isSubscribed = true;
-            }
+            bool isSubscribed = entry->isSubscribedToResourceType(resType);
 
             if (entry->subscriptionType == "SNMPTrap")
             {
@@ -1060,17 +1222,8 @@ class EventServiceManager
 
             if (isSubscribed)
             {
-                nlohmann::json msgJson;
-
-                msgJson["@odata.type"] = "#Event.v1_4_0.Event";
-                msgJson["Name"] = "Event Log";
-                msgJson["Id"] = eventId;
-                msgJson["Events"] = eventRecord;
-
-                std::string strMsg = msgJson.dump(
-                    2, ' ', true, nlohmann::json::error_handler_t::replace);
-                entry->sendEvent(strMsg);
-                eventId++; // increament the eventId
+                entry->sendEventRecords({record}, std::to_string(eventId));
+                eventId++;
             }
             else
             {
@@ -1081,89 +1234,49 @@ class EventServiceManager
 
 #ifndef BMCWEB_ENABLE_REDFISH_DBUS_LOG_ENTRIES
 
-    void resetRedfishFilePosition()
-    {
-        // Control would be here when Redfish file is created.
-        // Reset File Position as new file is created
-        redfishLogFilePosition = 0;
-    }
-
-    void cacheRedfishLogFile()
-    {
-        // Open the redfish file and read till the last record.
-
-        std::ifstream logStream(redfishEventLogFile);
-        if (!logStream.good())
-        {
-            BMCWEB_LOG_ERROR << " Redfish log file open failed \n";
-            return;
-        }
-        std::string logEntry;
-        while (std::getline(logStream, logEntry))
-        {
-            redfishLogFilePosition = logStream.tellg();
-        }
-
-        BMCWEB_LOG_DEBUG << "Next Log Position : " << redfishLogFilePosition;
-    }
-
     void readEventLogsFromFile()
     {
-        std::ifstream logStream(redfishEventLogFile);
-        if (!logStream.good())
-        {
-            BMCWEB_LOG_ERROR << " Redfish log file open failed";
-            return;
-        }
-
-        std::vector<EventLogObjectsType> eventRecords;
-
-        std::string logEntry;
-
-        // Get the read pointer to the next log to be read.
-        logStream.seekg(redfishLogFilePosition);
-
-        while (std::getline(logStream, logEntry))
-        {
-            // Update Pointer position
-            redfishLogFilePosition = logStream.tellg();
-
-            std::string idStr;
-            if (!event_log::getUniqueEntryID(logEntry, idStr))
+        // Lines are read even when nobody is listening, so the ids of later
+        // ones still count them
+        bool sending = serviceEnabled && noOfEventLogSubscribers != 0;
+        std::vector<EventLogRecord> eventRecords;
+        event_log::EventLogLine line;
+        redfishLogTailer.read([sending, &eventRecords, &line](
+                                  std::string_view logEntry,
+                                  const std::string& idStr) {
+            if (!sending)
             {
-                continue;
+                return;
             }
-
-            if (!serviceEnabled || noOfEventLogSubscribers == 0)
+            if (!event_log::parseEventLogLine(logEntry, line))
             {
-                // If Service is not enabled, no need to compute
-                // the remaining items below.
-                // But, Loop must continue to keep track of Timestamp
-                continue;
+                BMCWEB_LOG_DEBUG << "Read eventLog entry params failed";
+                return;
             }
-
-            std::string timestamp;
-            std::string messageID;
-            std::vector<std::string> messageArgs;
-            if (event_log::getEventLogParams(logEntry, timestamp, messageID,
-                                             messageArgs) != 0)
+            std::string_view registryName;
+            std::string_view messageKey;
+            if (!registries::splitMessageId(line.messageId, registryName,
+                                            messageKey))
             {
-                BMCWEB_LOG_DEBUG << "Read eventLog entry params failed";
-                continue;
+                return;
             }
 
-            std::string registryName;
-            std::string messageKey;
-            event_log::getRegistryAndMessageKey(messageID, registryName,
-                                                messageKey);
-            if (registryName.empty() || messageKey.empty())
+            // Format the entry once here rather than once per subscription.
+            // Each subscription splices in its own Context.
+            nlohmann::json bmcLogEntry;
+            if (event_log::formatEventLogEntry(
+                    idStr, std::string(line.messageId), line.messageArgs,
+                    std::string(line.timestamp), "", bmcLogEntry) != 0)
             {
-                continue;
+                BMCWEB_LOG_DEBUG << "Read eventLog entry failed";
+                return;
             }
 
-            eventRecords.emplace_back(idStr, timestamp, messageID, registryName,
-                                      messageKey, messageArgs);
-        }
+            eventRecords.push_back(
+                {std::string(registryName), std::string(messageKey),
+                 std::make_shared<const SerializedEventRecord>(
+                     std::move(bmcLogEntry), true)});
+        });
 
         if (!serviceEnabled || noOfEventLogSubscribers == 0)
         {
@@ -1252,10 +1365,12 @@ class EventServiceManager
                             return;
                         }
 
-                        EventServiceManager::getInstance()
-                            .resetRedfishFilePosition();
+                        // Picks up the tail of the rotated file, then the
+                        // new one from its start
                         EventServiceManager::getInstance()
                             .readEventLogsFromFile();
+                        event_log::EventLogIndex::getInstance()
+                            .refreshIfBuilt();
                     }
                     else if ((event.mask == IN_DELETE) ||
                              (event.mask == IN_MOVED_TO))
@@ -1265,6 +1380,8 @@ class EventServiceManager
                             inotify_rm_watch(inotifyFd, fileWatchDesc);
                             fileWatchDesc = -1;
                         }
+                        event_log::EventLogIndex::getInstance()
+                            .refreshIfBuilt();
                     }
                 }
                 else if (event.wd == fileWatchDesc)
@@ -1273,6 +1390,10 @@ class EventServiceManager
                     {
                         EventServiceManager::getInstance()
                             .readEventLogsFromFile();
+                        // Keep the index current so reads of the log only
+                        // ever have to parse what arrived since.
+                        event_log::EventLogIndex::getInstance()
+                            .refreshIfBuilt();
                     }
                 }
                 index += (iEventSize + event.len);
@@ -1314,6 +1435,9 @@ class EventServiceManager
             // Watch on directory will handle create/delete of file.
         }
 
+        // Only what is logged from now on is an event
+        EventServiceManager::getInstance().redfishLogTailer.skipExisting();
+
         // monitor redfish event log file
         inotifyConn->assign(inotifyFd);
         watchRedfishEventLogFile();
@@ -1360,13 +1484,18 @@ class EventServiceManager
             return;
         }
 
+        boost::urls::url definitionUri =
+            crow::utility::urlFromPieces("redfish", "v1", "TelemetryService",
+                                         "MetricReportDefinitions", id);
+        std::optional<telemetry::MetricReportPayload> report;
         for (const auto& it :
              EventServiceManager::getInstance().subscriptionsMap)
         {
             Subscription& entry = *it.second;
             if (entry.eventFormatType == metricReportFormatType)
             {
-                entry.filterAndSendReports(id, *readings);
+                entry.filterAndSendReports(id, definitionUri, *readings,
+                                           report);
             }
         }
     }
@@ -0,0 +1,406 @@
+#pragma once
+
+#include "logging.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+namespace redfish
+{
+
+static constexpr const char* eventSpoolDir = "/var/lib/bmcweb/event_spool";
+
+/**
+ * @brief Events a subscription couldn't deliver, kept on disk in the order
+ * they're to be resent.
+ *
+ * The file is a header holding the offset of the oldest unsent record,
+ * followed by records of a 32 bit length and the payload.  Records are only
+ * appended, and sending one only moves the header's offset, so the file is
+ * rewritten just when it's full of sent records.  When it would grow past
+ * maxBytes the oldest records are dropped to make room.  A record cut short
+ * by a crash is discarded on open.  Lengths and offsets are in host byte
+ * order; the file never leaves the BMC.
+ */
+class EventSpool
+{
+  public:
+    EventSpool(std::filesystem::path pathIn, size_t maxBytesIn) :
+        path(std::move(pathIn)), maxBytes(maxBytesIn)
+    {}
+
+    EventSpool(const EventSpool&) = delete;
+    EventSpool(EventSpool&&) = delete;
+    EventSpool& operator=(const EventSpool&) = delete;
+    EventSpool& operator=(EventSpool&&) = delete;
+
+    ~EventSpool()
+    {
+        closeFile();
+    }
+
+    /**
+     * @brief Opens the spool file, creating it if need be, and finds the
+     * records already in it.  False if the file can't be used.
+     */
+    bool open()
+    {
+        if (fd >= 0)
+        {
+            return true;
+        }
+        std::error_code ec;
+        std::filesystem::create_directories(path.parent_path(), ec);
+        fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+        if (fd < 0)
+        {
+            BMCWEB_LOG_ERROR << "Failed to open event spool " << path << ": "
+                             << std::strerror(errno);
+            return false;
+        }
+        if (!load())
+        {
+            closeFile();
+            return false;
+        }
+        return true;
+    }
+
+    bool empty() const
+    {
+        return count == 0;
+    }
+
+    // Records waiting to be sent
+    size_t size() const
+    {
+        return count;
+    }
+
+    // Bytes the records waiting take up on disk
+    uint64_t bytes() const
+    {
+        return tail - head;
+    }
+
+    // Records dropped, oldest first, to stay within maxBytes
+    uint64_t droppedCount() const
+    {
+        return dropped;
+    }
+
+    /**
+     * @brief Appends a payload, dropping the oldest records if that's what
+     * it takes to fit.  False if it couldn't be written, or is too big for
+     * the spool on its own.
+     */
+    bool push(std::string_view payload)
+    {
+        if (fd < 0)
+        {
+            return false;
+        }
+        uint64_t recordSize = sizeof(uint32_t) + payload.size();
+        if (payload.size() > UINT32_MAX || headerSize + recordSize > maxBytes)
+        {
+            BMCWEB_LOG_ERROR << "Event of " << payload.size()
+                             << " bytes doesn't fit in spool " << path;
+            dropped++;
+            return false;
+        }
+        bool skipped = false;
+        while (headerSize + bytes() + recordSize > maxBytes)
+        {
+            if (!skip())
+            {
+                return false;
+            }
+            dropped++;
+            skipped = true;
+        }
+        if (skipped && !writeHeader())
+        {
+            return false;
+        }
+        if (tail + recordSize > maxBytes && !compact())
+        {
+            return false;
+        }
+
+        uint32_t length = static_cast<uint32_t>(payload.size());
+        if (!writeAt(tail, &length, sizeof(length)) ||
+            !writeAt(tail + sizeof(length), payload.data(), payload.size()))
+        {
+            // Leave anything half written to be cut off on the next open
+            return false;
+        }
+        tail += recordSize;
+        count++;
+        return true;
+    }
+
+    // The oldest record, or nullopt if there are none or it can't be read
+    std::optional<std::string> front() const
+    {
+        if (fd < 0 || count == 0)
+        {
+            return std::nullopt;
+        }
+        uint32_t length = 0;
+        if (!readAt(head, &length, sizeof(length)))
+        {
+            return std::nullopt;
+        }
+        std::string payload(length, '\0');
+        if (!readAt(head + sizeof(length), payload.data(), length))
+        {
+            return std::nullopt;
+        }
+        return payload;
+    }
+
+    // Forgets the oldest record, once it has been sent
+    void pop()
+    {
+        if (skip())
+        {
+            writeHeader();
+        }
+    }
+
+    // Closes and deletes the spool file
+    void remove()
+    {
+        closeFile();
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+        head = headerSize;
+        tail = headerSize;
+        count = 0;
+    }
+
+  private:
+    static constexpr uint32_t magic = 0x50534542; // "BESP"
+    static constexpr uint64_t headerSize = 16;
+
+    struct Header
+    {
+        uint32_t magic;
+        uint32_t reserved;
+        uint64_t head;
+    };
+    static_assert(sizeof(Header) == headerSize);
+
+    void closeFile()
+    {
+        if (fd >= 0)
+        {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+
+    bool readAt(uint64_t offset, void* data, size_t size) const
+    {
+        char* out = static_cast<char*>(data);
+        while (size > 0)
+        {
+            ssize_t n = ::pread(fd, out, size, static_cast<off_t>(offset));
+            if (n < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (n <= 0)
+            {
+                return false;
+            }
+            out += n;
+            offset += static_cast<uint64_t>(n);
+            size -= static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    bool writeAt(uint64_t offset, const void* data, size_t size)
+    {
+        const char* in = static_cast<const char*>(data);
+        while (size > 0)
+        {
+            ssize_t n = ::pwrite(fd, in, size, static_cast<off_t>(offset));
+            if (n < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (n <= 0)
+            {
+                BMCWEB_LOG_ERROR << "Failed to write event spool " << path
+                                 << ": " << std::strerror(errno);
+                return false;
+            }
+            in += n;
+            offset += static_cast<uint64_t>(n);
+            size -= static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    bool writeHeader()
+    {
+        Header header{magic, 0, head};
+        return writeAt(0, &header, sizeof(header));
+    }
+
+    // Drops the oldest record without writing the header
+    bool skip()
+    {
+        if (count == 0)
+        {
+            return false;
+        }
+        uint32_t length = 0;
+        if (!readAt(head, &length, sizeof(length)))
+        {
+            return false;
+        }
+        head += sizeof(length) + length;
+        count--;
+        if (count == 0)
+        {
+            // Start over at the front rather than growing forever
+            head = headerSize;
+            tail = headerSize;
+            if (::ftruncate(fd, static_cast<off_t>(headerSize)) != 0)
+            {
+                BMCWEB_LOG_ERROR << "Failed to truncate event spool " << path;
+            }
+        }
+        return true;
+    }
+
+    // Reads the header, then walks the records to count them and find the
+    // end of the last whole one
+    bool load()
+    {
+        head = headerSize;
+        tail = headerSize;
+        count = 0;
+
+        struct stat st
+        {};
+        if (::fstat(fd, &st) != 0)
+        {
+            return false;
+        }
+        uint64_t fileSize = static_cast<uint64_t>(st.st_size);
+        Header header{};
+        if (fileSize < headerSize || !readAt(0, &header, sizeof(header)) ||
+            header.magic != magic || header.head < headerSize ||
+            header.head > fileSize)
+        {
+            if (fileSize != 0)
+            {
+                BMCWEB_LOG_ERROR << "Discarding unreadable event spool "
+                                 << path;
+            }
+            if (::ftruncate(fd, 0) != 0)
+            {
+                return false;
+            }
+            return writeHeader();
+        }
+
+        head = header.head;
+        tail = head;
+        while (tail + sizeof(uint32_t) <= fileSize)
+        {
+            uint32_t length = 0;
+            if (!readAt(tail, &length, sizeof(length)) ||
+                tail + sizeof(length) + length > fileSize)
+            {
+                break;
+            }
+            tail += sizeof(length) + length;
+            count++;
+        }
+        if (tail != fileSize &&
+            ::ftruncate(fd, static_cast<off_t>(tail)) != 0)
+        {
+            return false;
+        }
+        return true;
+    }
+
+    // Moves the waiting records to the front of a new file, which replaces
+    // the old one only once it's complete
+    bool compact()
+    {
+        std::filesystem::path tmpPath = path;
+        tmpPath += ".tmp";
+        int tmpFd = ::open(tmpPath.c_str(),
+                           O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+        if (tmpFd < 0)
+        {
+            BMCWEB_LOG_ERROR << "Failed to compact event spool " << path;
+            return false;
+        }
+
+        Header header{magic, 0, headerSize};
+        bool ok = ::pwrite(tmpFd, &header, sizeof(header), 0) ==
+                  static_cast<ssize_t>(sizeof(header));
+        std::array<char, 4096> chunk{};
+        uint64_t offset = head;
+        uint64_t out = headerSize;
+        while (ok && offset < tail)
+        {
+            size_t n = static_cast<size_t>(
+                std::min<uint64_t>(chunk.size(), tail - offset));
+            ok = readAt(offset, chunk.data(), n) &&
+                 ::pwrite(tmpFd, chunk.data(), n, static_cast<off_t>(out)) ==
+                     static_cast<ssize_t>(n);
+            offset += n;
+            out += n;
+        }
+
+        std::error_code ec;
+        if (ok)
+        {
+            std::filesystem::rename(tmpPath, path, ec);
+        }
+        if (!ok || ec)
+        {
+            BMCWEB_LOG_ERROR << "Failed to compact event spool " << path;
+            ::close(tmpFd);
+            std::filesystem::remove(tmpPath, ec);
+            return false;
+        }
+        closeFile();
+        fd = tmpFd;
+        tail = headerSize + bytes();
+        head = headerSize;
+        return true;
+    }
+
+    std::filesystem::path path;
+    size_t maxBytes;
+    int fd = -1;
+    uint64_t head = headerSize;
+    uint64_t tail = headerSize;
+    size_t count = 0;
+    uint64_t dropped = 0;
+};
+
+} // namespace redfish
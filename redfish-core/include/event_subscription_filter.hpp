@@ -0,0 +1,61 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace redfish
+{
+
+/**
+ * @brief The values listed in one filter property of a subscription, such as
+ * RegistryPrefixes or ResourceTypes, hashed so an event is checked with a
+ * single lookup however many values are listed.  An empty list matches every
+ * event.
+ */
+class EventValueFilter
+{
+  public:
+    EventValueFilter() = default;
+
+    explicit EventValueFilter(const std::vector<std::string>& valuesIn) :
+        values(valuesIn.begin(), valuesIn.end())
+    {}
+
+    bool matches(std::string_view value) const
+    {
+        return values.empty() || values.contains(value);
+    }
+
+    bool empty() const
+    {
+        return values.empty();
+    }
+
+  private:
+    struct StringHash
+    {
+        using is_transparent = void;
+
+        size_t operator()(std::string_view value) const
+        {
+            return std::hash<std::string_view>{}(value);
+        }
+    };
+
+    std::unordered_set<std::string, StringHash, std::equal_to<>> values;
+};
+
+// The filter properties of a subscription, built once when the subscription
+// is added rather than searched for every event
+struct EventSubscriptionFilter
+{
+    EventValueFilter registryPrefixes;
+    EventValueFilter messageIds;
+    EventValueFilter resourceTypes;
+    EventValueFilter metricReportDefinitions;
+};
+
+} // namespace redfish
@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace acceleration_function
@@ -17,17 +19,16 @@ enum class AccelerationFunctionType{
     OEM,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(AccelerationFunctionType, {
-    {AccelerationFunctionType::Invalid, "Invalid"},
-    {AccelerationFunctionType::Encryption, "Encryption"},
-    {AccelerationFunctionType::Compression, "Compression"},
-    {AccelerationFunctionType::PacketInspection, "PacketInspection"},
-    {AccelerationFunctionType::PacketSwitch, "PacketSwitch"},
-    {AccelerationFunctionType::Scheduler, "Scheduler"},
-    {AccelerationFunctionType::AudioProcessing, "AudioProcessing"},
-    {AccelerationFunctionType::VideoProcessing, "VideoProcessing"},
-    {AccelerationFunctionType::OEM, "OEM"},
-});
+REDFISH_ENUM_TABLE(AccelerationFunctionType,
+    "Invalid",
+    "Encryption",
+    "Compression",
+    "PacketInspection",
+    "PacketSwitch",
+    "Scheduler",
+    "AudioProcessing",
+    "VideoProcessing",
+    "OEM");
 
 }
 // clang-format on
@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace account_service
@@ -64,64 +66,57 @@ enum class CertificateMappingAttribute{
     UserPrincipalName,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(MFABypassType, {
-    {MFABypassType::Invalid, "Invalid"},
-    {MFABypassType::All, "All"},
-    {MFABypassType::SecurID, "SecurID"},
-    {MFABypassType::GoogleAuthenticator, "GoogleAuthenticator"},
-    {MFABypassType::MicrosoftAuthenticator, "MicrosoftAuthenticator"},
-    {MFABypassType::ClientCertificate, "ClientCertificate"},
-    {MFABypassType::OneTimePasscode, "OneTimePasscode"},
-    {MFABypassType::OEM, "OEM"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(LocalAccountAuth, {
-    {LocalAccountAuth::Invalid, "Invalid"},
-    {LocalAccountAuth::Enabled, "Enabled"},
-    {LocalAccountAuth::Disabled, "Disabled"},
-    {LocalAccountAuth::Fallback, "Fallback"},
-    {LocalAccountAuth::LocalFirst, "LocalFirst"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(AccountProviderTypes, {
-    {AccountProviderTypes::Invalid, "Invalid"},
-    {AccountProviderTypes::RedfishService, "RedfishService"},
-    {AccountProviderTypes::ActiveDirectoryService, "ActiveDirectoryService"},
-    {AccountProviderTypes::LDAPService, "LDAPService"},
-    {AccountProviderTypes::OEM, "OEM"},
-    {AccountProviderTypes::TACACSplus, "TACACSplus"},
-    {AccountProviderTypes::OAuth2, "OAuth2"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(AuthenticationTypes, {
-    {AuthenticationTypes::Invalid, "Invalid"},
-    {AuthenticationTypes::Token, "Token"},
-    {AuthenticationTypes::KerberosKeytab, "KerberosKeytab"},
-    {AuthenticationTypes::UsernameAndPassword, "UsernameAndPassword"},
-    {AuthenticationTypes::OEM, "OEM"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(TACACSplusPasswordExchangeProtocol, {
-    {TACACSplusPasswordExchangeProtocol::Invalid, "Invalid"},
-    {TACACSplusPasswordExchangeProtocol::ASCII, "ASCII"},
-    {TACACSplusPasswordExchangeProtocol::PAP, "PAP"},
-    {TACACSplusPasswordExchangeProtocol::CHAP, "CHAP"},
-    {TACACSplusPasswordExchangeProtocol::MSCHAPv1, "MSCHAPv1"},
-    {TACACSplusPasswordExchangeProtocol::MSCHAPv2, "MSCHAPv2"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(OAuth2Mode, {
-    {OAuth2Mode::Invalid, "Invalid"},
-    {OAuth2Mode::Discovery, "Discovery"},
-    {OAuth2Mode::Offline, "Offline"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(CertificateMappingAttribute, {
-    {CertificateMappingAttribute::Invalid, "Invalid"},
-    {CertificateMappingAttribute::Whole, "Whole"},
-    {CertificateMappingAttribute::CommonName, "CommonName"},
-    {CertificateMappingAttribute::UserPrincipalName, "UserPrincipalName"},
-});
+REDFISH_ENUM_TABLE(MFABypassType,
+    "Invalid",
+    "All",
+    "SecurID",
+    "GoogleAuthenticator",
+    "MicrosoftAuthenticator",
+    "ClientCertificate",
+    "OneTimePasscode",
+    "OEM");
+
+REDFISH_ENUM_TABLE(LocalAccountAuth,
+    "Invalid",
+    "Enabled",
+    "Disabled",
+    "Fallback",
+    "LocalFirst");
+
+REDFISH_ENUM_TABLE(AccountProviderTypes,
+    "Invalid",
+    "RedfishService",
+    "ActiveDirectoryService",
+    "LDAPService",
+    "OEM",
+    "TACACSplus",
+    "OAuth2");
+
+REDFISH_ENUM_TABLE(AuthenticationTypes,
+    "Invalid",
+    "Token",
+    "KerberosKeytab",
+    "UsernameAndPassword",
+    "OEM");
+
+REDFISH_ENUM_TABLE(TACACSplusPasswordExchangeProtocol,
+    "Invalid",
+    "ASCII",
+    "PAP",
+    "CHAP",
+    "MSCHAPv1",
+    "MSCHAPv2");
+
+REDFISH_ENUM_TABLE(OAuth2Mode,
+    "Invalid",
+    "Discovery",
+    "Offline");
+
+REDFISH_ENUM_TABLE(CertificateMappingAttribute,
+    "Invalid",
+    "Whole",
+    "CommonName",
+    "UserPrincipalName");
 
 }
 // clang-format on
@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace action_info
@@ -16,16 +18,15 @@ enum class ParameterTypes{
     ObjectArray,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(ParameterTypes, {
-    {ParameterTypes::Invalid, "Invalid"},
-    {ParameterTypes::Boolean, "Boolean"},
-    {ParameterTypes::Number, "Number"},
-    {ParameterTypes::NumberArray, "NumberArray"},
-    {ParameterTypes::String, "String"},
-    {ParameterTypes::StringArray, "StringArray"},
-    {ParameterTypes::Object, "Object"},
-    {ParameterTypes::ObjectArray, "ObjectArray"},
-});
+REDFISH_ENUM_TABLE(ParameterTypes,
+    "Invalid",
+    "Boolean",
+    "Number",
+    "NumberArray",
+    "String",
+    "StringArray",
+    "Object",
+    "ObjectArray");
 
 }
 // clang-format on
@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace allow_deny
@@ -23,23 +25,20 @@ enum class DataDirection{
     Egress,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(IPAddressType, {
-    {IPAddressType::Invalid, "Invalid"},
-    {IPAddressType::IPv4, "IPv4"},
-    {IPAddressType::IPv6, "IPv6"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(AllowType, {
-    {AllowType::Invalid, "Invalid"},
-    {AllowType::Allow, "Allow"},
-    {AllowType::Deny, "Deny"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(DataDirection, {
-    {DataDirection::Invalid, "Invalid"},
-    {DataDirection::Ingress, "Ingress"},
-    {DataDirection::Egress, "Egress"},
-});
+REDFISH_ENUM_TABLE(IPAddressType,
+    "Invalid",
+    "IPv4",
+    "IPv6");
+
+REDFISH_ENUM_TABLE(AllowType,
+    "Invalid",
+    "Allow",
+    "Deny");
+
+REDFISH_ENUM_TABLE(DataDirection,
+    "Invalid",
+    "Ingress",
+    "Egress");
 
 }
 // clang-format on
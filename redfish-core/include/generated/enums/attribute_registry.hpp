@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace attribute_registry
@@ -71,71 +73,65 @@ enum class MapToProperty{
     ValueExpression,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(AttributeType, {
-    {AttributeType::Invalid, "Invalid"},
-    {AttributeType::Enumeration, "Enumeration"},
-    {AttributeType::String, "String"},
-    {AttributeType::Integer, "Integer"},
-    {AttributeType::Boolean, "Boolean"},
-    {AttributeType::Password, "Password"},
-});
+REDFISH_ENUM_TABLE(AttributeType,
+    "Invalid",
+    "Enumeration",
+    "String",
+    "Integer",
+    "Boolean",
+    "Password");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(DependencyType, {
-    {DependencyType::Invalid, "Invalid"},
-    {DependencyType::Map, "Map"},
-});
+REDFISH_ENUM_TABLE(DependencyType,
+    "Invalid",
+    "Map");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(MapFromCondition, {
-    {MapFromCondition::Invalid, "Invalid"},
-    {MapFromCondition::EQU, "EQU"},
-    {MapFromCondition::NEQ, "NEQ"},
-    {MapFromCondition::GTR, "GTR"},
-    {MapFromCondition::GEQ, "GEQ"},
-    {MapFromCondition::LSS, "LSS"},
-    {MapFromCondition::LEQ, "LEQ"},
-});
+REDFISH_ENUM_TABLE(MapFromCondition,
+    "Invalid",
+    "EQU",
+    "NEQ",
+    "GTR",
+    "GEQ",
+    "LSS",
+    "LEQ");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(MapFromProperty, {
-    {MapFromProperty::Invalid, "Invalid"},
-    {MapFromProperty::CurrentValue, "CurrentValue"},
-    {MapFromProperty::DefaultValue, "DefaultValue"},
-    {MapFromProperty::ReadOnly, "ReadOnly"},
-    {MapFromProperty::WriteOnly, "WriteOnly"},
-    {MapFromProperty::GrayOut, "GrayOut"},
-    {MapFromProperty::Hidden, "Hidden"},
-    {MapFromProperty::LowerBound, "LowerBound"},
-    {MapFromProperty::UpperBound, "UpperBound"},
-    {MapFromProperty::MinLength, "MinLength"},
-    {MapFromProperty::MaxLength, "MaxLength"},
-    {MapFromProperty::ScalarIncrement, "ScalarIncrement"},
-});
+REDFISH_ENUM_TABLE(MapFromProperty,
+    "Invalid",
+    "CurrentValue",
+    "DefaultValue",
+    "ReadOnly",
+    "WriteOnly",
+    "GrayOut",
+    "Hidden",
+    "LowerBound",
+    "UpperBound",
+    "MinLength",
+    "MaxLength",
+    "ScalarIncrement");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(MapTerms, {
-    {MapTerms::Invalid, "Invalid"},
-    {MapTerms::AND, "AND"},
-    {MapTerms::OR, "OR"},
-});
+REDFISH_ENUM_TABLE(MapTerms,
+    "Invalid",
+    "AND",
+    "OR");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(MapToProperty, {
-    {MapToProperty::Invalid, "Invalid"},
-    {MapToProperty::CurrentValue, "CurrentValue"},
-    {MapToProperty::DefaultValue, "DefaultValue"},
-    {MapToProperty::ReadOnly, "ReadOnly"},
-    {MapToProperty::WriteOnly, "WriteOnly"},
-    {MapToProperty::GrayOut, "GrayOut"},
-    {MapToProperty::Hidden, "Hidden"},
-    {MapToProperty::Immutable, "Immutable"},
-    {MapToProperty::HelpText, "HelpText"},
-    {MapToProperty::WarningText, "WarningText"},
-    {MapToProperty::DisplayName, "DisplayName"},
-    {MapToProperty::DisplayOrder, "DisplayOrder"},
-    {MapToProperty::LowerBound, "LowerBound"},
-    {MapToProperty::UpperBound, "UpperBound"},
-    {MapToProperty::MinLength, "MinLength"},
-    {MapToProperty::MaxLength, "MaxLength"},
-    {MapToProperty::ScalarIncrement, "ScalarIncrement"},
-    {MapToProperty::ValueExpression, "ValueExpression"},
-});
+REDFISH_ENUM_TABLE(MapToProperty,
+    "Invalid",
+    "CurrentValue",
+    "DefaultValue",
+    "ReadOnly",
+    "WriteOnly",
+    "GrayOut",
+    "Hidden",
+    "Immutable",
+    "HelpText",
+    "WarningText",
+    "DisplayName",
+    "DisplayOrder",
+    "LowerBound",
+    "UpperBound",
+    "MinLength",
+    "MaxLength",
+    "ScalarIncrement",
+    "ValueExpression");
 
 }
 // clang-format on
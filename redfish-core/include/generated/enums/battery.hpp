@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace battery
@@ -12,12 +14,11 @@ enum class ChargeState{
     Discharging,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(ChargeState, {
-    {ChargeState::Invalid, "Invalid"},
-    {ChargeState::Idle, "Idle"},
-    {ChargeState::Charging, "Charging"},
-    {ChargeState::Discharging, "Discharging"},
-});
+REDFISH_ENUM_TABLE(ChargeState,
+    "Invalid",
+    "Idle",
+    "Charging",
+    "Discharging");
 
 }
 // clang-format on
@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace certificate
@@ -45,45 +47,42 @@ enum class CertificateUsageType{
     LAK,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(CertificateType, {
-    {CertificateType::Invalid, "Invalid"},
-    {CertificateType::PEM, "PEM"},
-    {CertificateType::PEMchain, "PEMchain"},
-    {CertificateType::PKCS7, "PKCS7"},
-});
+REDFISH_ENUM_TABLE(CertificateType,
+    "Invalid",
+    "PEM",
+    "PEMchain",
+    "PKCS7");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(KeyUsage, {
-    {KeyUsage::Invalid, "Invalid"},
-    {KeyUsage::DigitalSignature, "DigitalSignature"},
-    {KeyUsage::NonRepudiation, "NonRepudiation"},
-    {KeyUsage::KeyEncipherment, "KeyEncipherment"},
-    {KeyUsage::DataEncipherment, "DataEncipherment"},
-    {KeyUsage::KeyAgreement, "KeyAgreement"},
-    {KeyUsage::KeyCertSign, "KeyCertSign"},
-    {KeyUsage::CRLSigning, "CRLSigning"},
-    {KeyUsage::EncipherOnly, "EncipherOnly"},
-    {KeyUsage::DecipherOnly, "DecipherOnly"},
-    {KeyUsage::ServerAuthentication, "ServerAuthentication"},
-    {KeyUsage::ClientAuthentication, "ClientAuthentication"},
-    {KeyUsage::CodeSigning, "CodeSigning"},
-    {KeyUsage::EmailProtection, "EmailProtection"},
-    {KeyUsage::Timestamping, "Timestamping"},
-    {KeyUsage::OCSPSigning, "OCSPSigning"},
-});
+REDFISH_ENUM_TABLE(KeyUsage,
+    "Invalid",
+    "DigitalSignature",
+    "NonRepudiation",
+    "KeyEncipherment",
+    "DataEncipherment",
+    "KeyAgreement",
+    "KeyCertSign",
+    "CRLSigning",
+    "EncipherOnly",
+    "DecipherOnly",
+    "ServerAuthentication",
+    "ClientAuthentication",
+    "CodeSigning",
+    "EmailProtection",
+    "Timestamping",
+    "OCSPSigning");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(CertificateUsageType, {
-    {CertificateUsageType::Invalid, "Invalid"},
-    {CertificateUsageType::User, "User"},
-    {CertificateUsageType::Web, "Web"},
-    {CertificateUsageType::SSH, "SSH"},
-    {CertificateUsageType::Device, "Device"},
-    {CertificateUsageType::Platform, "Platform"},
-    {CertificateUsageType::BIOS, "BIOS"},
-    {CertificateUsageType::IDevID, "IDevID"},
-    {CertificateUsageType::LDevID, "LDevID"},
-    {CertificateUsageType::IAK, "IAK"},
-    {CertificateUsageType::LAK, "LAK"},
-});
+REDFISH_ENUM_TABLE(CertificateUsageType,
+    "Invalid",
+    "User",
+    "Web",
+    "SSH",
+    "Device",
+    "Platform",
+    "BIOS",
+    "IDevID",
+    "LDevID",
+    "IAK",
+    "LAK");
 
 }
 // clang-format on
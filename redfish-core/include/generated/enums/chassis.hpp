@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace chassis
@@ -77,77 +79,70 @@ enum class DoorState{
     Open,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(ChassisType, {
-    {ChassisType::Invalid, "Invalid"},
-    {ChassisType::Rack, "Rack"},
-    {ChassisType::Blade, "Blade"},
-    {ChassisType::Enclosure, "Enclosure"},
-    {ChassisType::StandAlone, "StandAlone"},
-    {ChassisType::RackMount, "RackMount"},
-    {ChassisType::Card, "Card"},
-    {ChassisType::Cartridge, "Cartridge"},
-    {ChassisType::Row, "Row"},
-    {ChassisType::Pod, "Pod"},
-    {ChassisType::Expansion, "Expansion"},
-    {ChassisType::Sidecar, "Sidecar"},
-    {ChassisType::Zone, "Zone"},
-    {ChassisType::Sled, "Sled"},
-    {ChassisType::Shelf, "Shelf"},
-    {ChassisType::Drawer, "Drawer"},
-    {ChassisType::Module, "Module"},
-    {ChassisType::Component, "Component"},
-    {ChassisType::IPBasedDrive, "IPBasedDrive"},
-    {ChassisType::RackGroup, "RackGroup"},
-    {ChassisType::StorageEnclosure, "StorageEnclosure"},
-    {ChassisType::ImmersionTank, "ImmersionTank"},
-    {ChassisType::HeatExchanger, "HeatExchanger"},
-    {ChassisType::Other, "Other"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(IndicatorLED, {
-    {IndicatorLED::Invalid, "Invalid"},
-    {IndicatorLED::Unknown, "Unknown"},
-    {IndicatorLED::Lit, "Lit"},
-    {IndicatorLED::Blinking, "Blinking"},
-    {IndicatorLED::Off, "Off"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(IntrusionSensor, {
-    {IntrusionSensor::Invalid, "Invalid"},
-    {IntrusionSensor::Normal, "Normal"},
-    {IntrusionSensor::HardwareIntrusion, "HardwareIntrusion"},
-    {IntrusionSensor::TamperingDetected, "TamperingDetected"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(IntrusionSensorReArm, {
-    {IntrusionSensorReArm::Invalid, "Invalid"},
-    {IntrusionSensorReArm::Manual, "Manual"},
-    {IntrusionSensorReArm::Automatic, "Automatic"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(EnvironmentalClass, {
-    {EnvironmentalClass::Invalid, "Invalid"},
-    {EnvironmentalClass::A1, "A1"},
-    {EnvironmentalClass::A2, "A2"},
-    {EnvironmentalClass::A3, "A3"},
-    {EnvironmentalClass::A4, "A4"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(ThermalDirection, {
-    {ThermalDirection::Invalid, "Invalid"},
-    {ThermalDirection::FrontToBack, "FrontToBack"},
-    {ThermalDirection::BackToFront, "BackToFront"},
-    {ThermalDirection::TopExhaust, "TopExhaust"},
-    {ThermalDirection::Sealed, "Sealed"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(DoorState, {
-    {DoorState::Invalid, "Invalid"},
-    {DoorState::Locked, "Locked"},
-    {DoorState::Closed, "Closed"},
-    {DoorState::LockedAndOpen, "LockedAndOpen"},
-    {DoorState::Open, "Open"},
-});
+REDFISH_ENUM_TABLE(ChassisType,
+    "Invalid",
+    "Rack",
+    "Blade",
+    "Enclosure",
+    "StandAlone",
+    "RackMount",
+    "Card",
+    "Cartridge",
+    "Row",
+    "Pod",
+    "Expansion",
+    "Sidecar",
+    "Zone",
+    "Sled",
+    "Shelf",
+    "Drawer",
+    "Module",
+    "Component",
+    "IPBasedDrive",
+    "RackGroup",
+    "StorageEnclosure",
+    "ImmersionTank",
+    "HeatExchanger",
+    "Other");
+
+REDFISH_ENUM_TABLE(IndicatorLED,
+    "Invalid",
+    "Unknown",
+    "Lit",
+    "Blinking",
+    "Off");
+
+REDFISH_ENUM_TABLE(IntrusionSensor,
+    "Invalid",
+    "Normal",
+    "HardwareIntrusion",
+    "TamperingDetected");
+
+REDFISH_ENUM_TABLE(IntrusionSensorReArm,
+    "Invalid",
+    "Manual",
+    "Automatic");
+
+REDFISH_ENUM_TABLE(EnvironmentalClass,
+    "Invalid",
+    "A1",
+    "A2",
+    "A3",
+    "A4");
+
+REDFISH_ENUM_TABLE(ThermalDirection,
+    "Invalid",
+    "FrontToBack",
+    "BackToFront",
+    "TopExhaust",
+    "Sealed");
+
+REDFISH_ENUM_TABLE(DoorState,
+    "Invalid",
+    "Locked",
+    "Closed",
+    "LockedAndOpen",
+    "Open");
 
 }
 // clang-format on
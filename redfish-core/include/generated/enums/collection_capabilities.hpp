@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace collection_capabilities
@@ -15,15 +17,14 @@ enum class UseCase{
     RegisterResourceBlock,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(UseCase, {
-    {UseCase::Invalid, "Invalid"},
-    {UseCase::ComputerSystemComposition, "ComputerSystemComposition"},
-    {UseCase::ComputerSystemConstrainedComposition, "ComputerSystemConstrainedComposition"},
-    {UseCase::VolumeCreation, "VolumeCreation"},
-    {UseCase::ResourceBlockComposition, "ResourceBlockComposition"},
-    {UseCase::ResourceBlockConstrainedComposition, "ResourceBlockConstrainedComposition"},
-    {UseCase::RegisterResourceBlock, "RegisterResourceBlock"},
-});
+REDFISH_ENUM_TABLE(UseCase,
+    "Invalid",
+    "ComputerSystemComposition",
+    "ComputerSystemConstrainedComposition",
+    "VolumeCreation",
+    "ResourceBlockComposition",
+    "ResourceBlockConstrainedComposition",
+    "RegisterResourceBlock");
 
 }
 // clang-format on
@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace component_integrity
@@ -47,47 +49,41 @@ enum class SecureSessionType{
     AuthenticatedOnly,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(ComponentIntegrityType, {
-    {ComponentIntegrityType::Invalid, "Invalid"},
-    {ComponentIntegrityType::SPDM, "SPDM"},
-    {ComponentIntegrityType::TPM, "TPM"},
-    {ComponentIntegrityType::OEM, "OEM"},
-});
+REDFISH_ENUM_TABLE(ComponentIntegrityType,
+    "Invalid",
+    "SPDM",
+    "TPM",
+    "OEM");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(MeasurementSpecification, {
-    {MeasurementSpecification::Invalid, "Invalid"},
-    {MeasurementSpecification::DMTF, "DMTF"},
-});
+REDFISH_ENUM_TABLE(MeasurementSpecification,
+    "Invalid",
+    "DMTF");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(SPDMmeasurementSummaryType, {
-    {SPDMmeasurementSummaryType::Invalid, "Invalid"},
-    {SPDMmeasurementSummaryType::TCB, "TCB"},
-    {SPDMmeasurementSummaryType::All, "All"},
-});
+REDFISH_ENUM_TABLE(SPDMmeasurementSummaryType,
+    "Invalid",
+    "TCB",
+    "All");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(DMTFmeasurementTypes, {
-    {DMTFmeasurementTypes::Invalid, "Invalid"},
-    {DMTFmeasurementTypes::ImmutableROM, "ImmutableROM"},
-    {DMTFmeasurementTypes::MutableFirmware, "MutableFirmware"},
-    {DMTFmeasurementTypes::HardwareConfiguration, "HardwareConfiguration"},
-    {DMTFmeasurementTypes::FirmwareConfiguration, "FirmwareConfiguration"},
-    {DMTFmeasurementTypes::MutableFirmwareVersion, "MutableFirmwareVersion"},
-    {DMTFmeasurementTypes::MutableFirmwareSecurityVersionNumber, "MutableFirmwareSecurityVersionNumber"},
-    {DMTFmeasurementTypes::MeasurementManifest, "MeasurementManifest"},
-});
+REDFISH_ENUM_TABLE(DMTFmeasurementTypes,
+    "Invalid",
+    "ImmutableROM",
+    "MutableFirmware",
+    "HardwareConfiguration",
+    "FirmwareConfiguration",
+    "MutableFirmwareVersion",
+    "MutableFirmwareSecurityVersionNumber",
+    "MeasurementManifest");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(VerificationStatus, {
-    {VerificationStatus::Invalid, "Invalid"},
-    {VerificationStatus::Success, "Success"},
-    {VerificationStatus::Failed, "Failed"},
-});
+REDFISH_ENUM_TABLE(VerificationStatus,
+    "Invalid",
+    "Success",
+    "Failed");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(SecureSessionType, {
-    {SecureSessionType::Invalid, "Invalid"},
-    {SecureSessionType::Plain, "Plain"},
-    {SecureSessionType::EncryptedAuthenticated, "EncryptedAuthenticated"},
-    {SecureSessionType::AuthenticatedOnly, "AuthenticatedOnly"},
-});
+REDFISH_ENUM_TABLE(SecureSessionType,
+    "Invalid",
+    "Plain",
+    "EncryptedAuthenticated",
+    "AuthenticatedOnly");
 
 }
 // clang-format on
@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace composition_service
@@ -17,17 +19,15 @@ enum class ComposeRequestFormat{
     Manifest,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(ComposeRequestType, {
-    {ComposeRequestType::Invalid, "Invalid"},
-    {ComposeRequestType::Preview, "Preview"},
-    {ComposeRequestType::PreviewReserve, "PreviewReserve"},
-    {ComposeRequestType::Apply, "Apply"},
-});
+REDFISH_ENUM_TABLE(ComposeRequestType,
+    "Invalid",
+    "Preview",
+    "PreviewReserve",
+    "Apply");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(ComposeRequestFormat, {
-    {ComposeRequestFormat::Invalid, "Invalid"},
-    {ComposeRequestFormat::Manifest, "Manifest"},
-});
+REDFISH_ENUM_TABLE(ComposeRequestFormat,
+    "Invalid",
+    "Manifest");
 
 }
 // clang-format on
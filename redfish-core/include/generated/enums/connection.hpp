@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace connection
@@ -26,26 +28,23 @@ enum class AccessState{
     Transitioning,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(ConnectionType, {
-    {ConnectionType::Invalid, "Invalid"},
-    {ConnectionType::Storage, "Storage"},
-    {ConnectionType::Memory, "Memory"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(AccessCapability, {
-    {AccessCapability::Invalid, "Invalid"},
-    {AccessCapability::Read, "Read"},
-    {AccessCapability::Write, "Write"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(AccessState, {
-    {AccessState::Invalid, "Invalid"},
-    {AccessState::Optimized, "Optimized"},
-    {AccessState::NonOptimized, "NonOptimized"},
-    {AccessState::Standby, "Standby"},
-    {AccessState::Unavailable, "Unavailable"},
-    {AccessState::Transitioning, "Transitioning"},
-});
+REDFISH_ENUM_TABLE(ConnectionType,
+    "Invalid",
+    "Storage",
+    "Memory");
+
+REDFISH_ENUM_TABLE(AccessCapability,
+    "Invalid",
+    "Read",
+    "Write");
+
+REDFISH_ENUM_TABLE(AccessState,
+    "Invalid",
+    "Optimized",
+    "NonOptimized",
+    "Standby",
+    "Unavailable",
+    "Transitioning");
 
 }
 // clang-format on
@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace connection_method
@@ -21,21 +23,19 @@ enum class TunnelingProtocolType{
     OEM,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(ConnectionMethodType, {
-    {ConnectionMethodType::Invalid, "Invalid"},
-    {ConnectionMethodType::Redfish, "Redfish"},
-    {ConnectionMethodType::SNMP, "SNMP"},
-    {ConnectionMethodType::IPMI15, "IPMI15"},
-    {ConnectionMethodType::IPMI20, "IPMI20"},
-    {ConnectionMethodType::NETCONF, "NETCONF"},
-    {ConnectionMethodType::OEM, "OEM"},
-});
+REDFISH_ENUM_TABLE(ConnectionMethodType,
+    "Invalid",
+    "Redfish",
+    "SNMP",
+    "IPMI15",
+    "IPMI20",
+    "NETCONF",
+    "OEM");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(TunnelingProtocolType, {
-    {TunnelingProtocolType::Invalid, "Invalid"},
-    {TunnelingProtocolType::SSH, "SSH"},
-    {TunnelingProtocolType::OEM, "OEM"},
-});
+REDFISH_ENUM_TABLE(TunnelingProtocolType,
+    "Invalid",
+    "SSH",
+    "OEM");
 
 }
 // clang-format on
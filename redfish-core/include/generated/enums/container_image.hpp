@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace container_image
@@ -12,12 +14,11 @@ enum class ImageTypes{
     OCI,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(ImageTypes, {
-    {ImageTypes::Invalid, "Invalid"},
-    {ImageTypes::DockerV1, "DockerV1"},
-    {ImageTypes::DockerV2, "DockerV2"},
-    {ImageTypes::OCI, "OCI"},
-});
+REDFISH_ENUM_TABLE(ImageTypes,
+    "Invalid",
+    "DockerV1",
+    "DockerV2",
+    "OCI");
 
 }
 // clang-format on
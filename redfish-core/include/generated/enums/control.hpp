@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace control
@@ -37,37 +39,33 @@ enum class ImplementationType{
     Monitored,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(ControlType, {
-    {ControlType::Invalid, "Invalid"},
-    {ControlType::Temperature, "Temperature"},
-    {ControlType::Power, "Power"},
-    {ControlType::Frequency, "Frequency"},
-    {ControlType::FrequencyMHz, "FrequencyMHz"},
-    {ControlType::Pressure, "Pressure"},
-    {ControlType::PressurekPa, "PressurekPa"},
-    {ControlType::Valve, "Valve"},
-});
+REDFISH_ENUM_TABLE(ControlType,
+    "Invalid",
+    "Temperature",
+    "Power",
+    "Frequency",
+    "FrequencyMHz",
+    "Pressure",
+    "PressurekPa",
+    "Valve");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(SetPointType, {
-    {SetPointType::Invalid, "Invalid"},
-    {SetPointType::Single, "Single"},
-    {SetPointType::Range, "Range"},
-});
+REDFISH_ENUM_TABLE(SetPointType,
+    "Invalid",
+    "Single",
+    "Range");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(ControlMode, {
-    {ControlMode::Invalid, "Invalid"},
-    {ControlMode::Automatic, "Automatic"},
-    {ControlMode::Override, "Override"},
-    {ControlMode::Manual, "Manual"},
-    {ControlMode::Disabled, "Disabled"},
-});
+REDFISH_ENUM_TABLE(ControlMode,
+    "Invalid",
+    "Automatic",
+    "Override",
+    "Manual",
+    "Disabled");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(ImplementationType, {
-    {ImplementationType::Invalid, "Invalid"},
-    {ImplementationType::Programmable, "Programmable"},
-    {ImplementationType::Direct, "Direct"},
-    {ImplementationType::Monitored, "Monitored"},
-});
+REDFISH_ENUM_TABLE(ImplementationType,
+    "Invalid",
+    "Programmable",
+    "Direct",
+    "Monitored");
 
 }
 // clang-format on
@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace coolant_connector
@@ -14,14 +16,13 @@ enum class CoolantConnectorType{
     Closed,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(CoolantConnectorType, {
-    {CoolantConnectorType::Invalid, "Invalid"},
-    {CoolantConnectorType::Pair, "Pair"},
-    {CoolantConnectorType::Supply, "Supply"},
-    {CoolantConnectorType::Return, "Return"},
-    {CoolantConnectorType::Inline, "Inline"},
-    {CoolantConnectorType::Closed, "Closed"},
-});
+REDFISH_ENUM_TABLE(CoolantConnectorType,
+    "Invalid",
+    "Pair",
+    "Supply",
+    "Return",
+    "Inline",
+    "Closed");
 
 }
 // clang-format on
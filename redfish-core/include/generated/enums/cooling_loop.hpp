@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace cooling_loop
@@ -13,13 +15,12 @@ enum class CoolantType{
     Dielectric,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(CoolantType, {
-    {CoolantType::Invalid, "Invalid"},
-    {CoolantType::Water, "Water"},
-    {CoolantType::Hydrocarbon, "Hydrocarbon"},
-    {CoolantType::Fluorocarbon, "Fluorocarbon"},
-    {CoolantType::Dielectric, "Dielectric"},
-});
+REDFISH_ENUM_TABLE(CoolantType,
+    "Invalid",
+    "Water",
+    "Hydrocarbon",
+    "Fluorocarbon",
+    "Dielectric");
 
 }
 // clang-format on
@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace cooling_unit
@@ -12,12 +14,11 @@ enum class CoolingEquipmentType{
     ImmersionUnit,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(CoolingEquipmentType, {
-    {CoolingEquipmentType::Invalid, "Invalid"},
-    {CoolingEquipmentType::CDU, "CDU"},
-    {CoolingEquipmentType::HeatExchanger, "HeatExchanger"},
-    {CoolingEquipmentType::ImmersionUnit, "ImmersionUnit"},
-});
+REDFISH_ENUM_TABLE(CoolingEquipmentType,
+    "Invalid",
+    "CDU",
+    "HeatExchanger",
+    "ImmersionUnit");
 
 }
 // clang-format on
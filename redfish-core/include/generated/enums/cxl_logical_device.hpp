@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace cxl_logical_device
@@ -12,12 +14,11 @@ enum class CXLSemantic{
     CXLmem,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(CXLSemantic, {
-    {CXLSemantic::Invalid, "Invalid"},
-    {CXLSemantic::CXLio, "CXLio"},
-    {CXLSemantic::CXLcache, "CXLcache"},
-    {CXLSemantic::CXLmem, "CXLmem"},
-});
+REDFISH_ENUM_TABLE(CXLSemantic,
+    "Invalid",
+    "CXLio",
+    "CXLcache",
+    "CXLmem");
 
 }
 // clang-format on
@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace endpoint_group
@@ -22,22 +24,20 @@ enum class GroupType{
     Target,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(AccessState, {
-    {AccessState::Invalid, "Invalid"},
-    {AccessState::Optimized, "Optimized"},
-    {AccessState::NonOptimized, "NonOptimized"},
-    {AccessState::Standby, "Standby"},
-    {AccessState::Unavailable, "Unavailable"},
-    {AccessState::Transitioning, "Transitioning"},
-});
+REDFISH_ENUM_TABLE(AccessState,
+    "Invalid",
+    "Optimized",
+    "NonOptimized",
+    "Standby",
+    "Unavailable",
+    "Transitioning");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(GroupType, {
-    {GroupType::Invalid, "Invalid"},
-    {GroupType::Client, "Client"},
-    {GroupType::Server, "Server"},
-    {GroupType::Initiator, "Initiator"},
-    {GroupType::Target, "Target"},
-});
+REDFISH_ENUM_TABLE(GroupType,
+    "Invalid",
+    "Client",
+    "Server",
+    "Initiator",
+    "Target");
 
 }
 // clang-format on
@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace ethernet_interface
@@ -53,53 +55,47 @@ enum class RoutingScope{
     Limited,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(LinkStatus, {
-    {LinkStatus::Invalid, "Invalid"},
-    {LinkStatus::LinkUp, "LinkUp"},
-    {LinkStatus::NoLink, "NoLink"},
-    {LinkStatus::LinkDown, "LinkDown"},
-});
+REDFISH_ENUM_TABLE(LinkStatus,
+    "Invalid",
+    "LinkUp",
+    "NoLink",
+    "LinkDown");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(DHCPv6OperatingMode, {
-    {DHCPv6OperatingMode::Invalid, "Invalid"},
-    {DHCPv6OperatingMode::Stateful, "Stateful"},
-    {DHCPv6OperatingMode::Stateless, "Stateless"},
-    {DHCPv6OperatingMode::Disabled, "Disabled"},
-    {DHCPv6OperatingMode::Enabled, "Enabled"},
-});
+REDFISH_ENUM_TABLE(DHCPv6OperatingMode,
+    "Invalid",
+    "Stateful",
+    "Stateless",
+    "Disabled",
+    "Enabled");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(DHCPFallback, {
-    {DHCPFallback::Invalid, "Invalid"},
-    {DHCPFallback::Static, "Static"},
-    {DHCPFallback::AutoConfig, "AutoConfig"},
-    {DHCPFallback::None, "None"},
-});
+REDFISH_ENUM_TABLE(DHCPFallback,
+    "Invalid",
+    "Static",
+    "AutoConfig",
+    "None");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(EthernetDeviceType, {
-    {EthernetDeviceType::Invalid, "Invalid"},
-    {EthernetDeviceType::Physical, "Physical"},
-    {EthernetDeviceType::Virtual, "Virtual"},
-});
+REDFISH_ENUM_TABLE(EthernetDeviceType,
+    "Invalid",
+    "Physical",
+    "Virtual");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(TeamMode, {
-    {TeamMode::Invalid, "Invalid"},
-    {TeamMode::None, "None"},
-    {TeamMode::RoundRobin, "RoundRobin"},
-    {TeamMode::ActiveBackup, "ActiveBackup"},
-    {TeamMode::XOR, "XOR"},
-    {TeamMode::Broadcast, "Broadcast"},
-    {TeamMode::IEEE802_3ad, "IEEE802_3ad"},
-    {TeamMode::AdaptiveTransmitLoadBalancing, "AdaptiveTransmitLoadBalancing"},
-    {TeamMode::AdaptiveLoadBalancing, "AdaptiveLoadBalancing"},
-});
+REDFISH_ENUM_TABLE(TeamMode,
+    "Invalid",
+    "None",
+    "RoundRobin",
+    "ActiveBackup",
+    "XOR",
+    "Broadcast",
+    "IEEE802_3ad",
+    "AdaptiveTransmitLoadBalancing",
+    "AdaptiveLoadBalancing");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(RoutingScope, {
-    {RoutingScope::Invalid, "Invalid"},
-    {RoutingScope::External, "External"},
-    {RoutingScope::HostOnly, "HostOnly"},
-    {RoutingScope::Internal, "Internal"},
-    {RoutingScope::Limited, "Limited"},
-});
+REDFISH_ENUM_TABLE(RoutingScope,
+    "Invalid",
+    "External",
+    "HostOnly",
+    "Internal",
+    "Limited");
 
 }
 // clang-format on
@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace event
@@ -26,26 +28,24 @@ enum class DiagnosticDataTypes{
     CPERSection,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(EventType, {
-    {EventType::Invalid, "Invalid"},
-    {EventType::StatusChange, "StatusChange"},
-    {EventType::ResourceUpdated, "ResourceUpdated"},
-    {EventType::ResourceAdded, "ResourceAdded"},
-    {EventType::ResourceRemoved, "ResourceRemoved"},
-    {EventType::Alert, "Alert"},
-    {EventType::MetricReport, "MetricReport"},
-    {EventType::Other, "Other"},
-});
+REDFISH_ENUM_TABLE(EventType,
+    "Invalid",
+    "StatusChange",
+    "ResourceUpdated",
+    "ResourceAdded",
+    "ResourceRemoved",
+    "Alert",
+    "MetricReport",
+    "Other");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(DiagnosticDataTypes, {
-    {DiagnosticDataTypes::Invalid, "Invalid"},
-    {DiagnosticDataTypes::Manager, "Manager"},
-    {DiagnosticDataTypes::PreOS, "PreOS"},
-    {DiagnosticDataTypes::OS, "OS"},
-    {DiagnosticDataTypes::OEM, "OEM"},
-    {DiagnosticDataTypes::CPER, "CPER"},
-    {DiagnosticDataTypes::CPERSection, "CPERSection"},
-});
+REDFISH_ENUM_TABLE(DiagnosticDataTypes,
+    "Invalid",
+    "Manager",
+    "PreOS",
+    "OS",
+    "OEM",
+    "CPER",
+    "CPERSection");
 
 }
 // clang-format on
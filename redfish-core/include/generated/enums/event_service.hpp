@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace event_service
@@ -22,22 +24,20 @@ enum class SMTPAuthenticationMethods{
     CRAM_MD5,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(SMTPConnectionProtocol, {
-    {SMTPConnectionProtocol::Invalid, "Invalid"},
-    {SMTPConnectionProtocol::None, "None"},
-    {SMTPConnectionProtocol::AutoDetect, "AutoDetect"},
-    {SMTPConnectionProtocol::StartTLS, "StartTLS"},
-    {SMTPConnectionProtocol::TLS_SSL, "TLS_SSL"},
-});
+REDFISH_ENUM_TABLE(SMTPConnectionProtocol,
+    "Invalid",
+    "None",
+    "AutoDetect",
+    "StartTLS",
+    "TLS_SSL");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(SMTPAuthenticationMethods, {
-    {SMTPAuthenticationMethods::Invalid, "Invalid"},
-    {SMTPAuthenticationMethods::None, "None"},
-    {SMTPAuthenticationMethods::AutoDetect, "AutoDetect"},
-    {SMTPAuthenticationMethods::Plain, "Plain"},
-    {SMTPAuthenticationMethods::Login, "Login"},
-    {SMTPAuthenticationMethods::CRAM_MD5, "CRAM_MD5"},
-});
+REDFISH_ENUM_TABLE(SMTPAuthenticationMethods,
+    "Invalid",
+    "None",
+    "AutoDetect",
+    "Plain",
+    "Login",
+    "CRAM_MD5");
 
 }
 // clang-format on
@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace external_account_provider
@@ -38,38 +40,34 @@ enum class OAuth2Mode{
     Offline,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(AccountProviderTypes, {
-    {AccountProviderTypes::Invalid, "Invalid"},
-    {AccountProviderTypes::RedfishService, "RedfishService"},
-    {AccountProviderTypes::ActiveDirectoryService, "ActiveDirectoryService"},
-    {AccountProviderTypes::LDAPService, "LDAPService"},
-    {AccountProviderTypes::OEM, "OEM"},
-    {AccountProviderTypes::TACACSplus, "TACACSplus"},
-    {AccountProviderTypes::OAuth2, "OAuth2"},
-});
+REDFISH_ENUM_TABLE(AccountProviderTypes,
+    "Invalid",
+    "RedfishService",
+    "ActiveDirectoryService",
+    "LDAPService",
+    "OEM",
+    "TACACSplus",
+    "OAuth2");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(AuthenticationTypes, {
-    {AuthenticationTypes::Invalid, "Invalid"},
-    {AuthenticationTypes::Token, "Token"},
-    {AuthenticationTypes::KerberosKeytab, "KerberosKeytab"},
-    {AuthenticationTypes::UsernameAndPassword, "UsernameAndPassword"},
-    {AuthenticationTypes::OEM, "OEM"},
-});
+REDFISH_ENUM_TABLE(AuthenticationTypes,
+    "Invalid",
+    "Token",
+    "KerberosKeytab",
+    "UsernameAndPassword",
+    "OEM");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(TACACSplusPasswordExchangeProtocol, {
-    {TACACSplusPasswordExchangeProtocol::Invalid, "Invalid"},
-    {TACACSplusPasswordExchangeProtocol::ASCII, "ASCII"},
-    {TACACSplusPasswordExchangeProtocol::PAP, "PAP"},
-    {TACACSplusPasswordExchangeProtocol::CHAP, "CHAP"},
-    {TACACSplusPasswordExchangeProtocol::MSCHAPv1, "MSCHAPv1"},
-    {TACACSplusPasswordExchangeProtocol::MSCHAPv2, "MSCHAPv2"},
-});
+REDFISH_ENUM_TABLE(TACACSplusPasswordExchangeProtocol,
+    "Invalid",
+    "ASCII",
+    "PAP",
+    "CHAP",
+    "MSCHAPv1",
+    "MSCHAPv2");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(OAuth2Mode, {
-    {OAuth2Mode::Invalid, "Invalid"},
-    {OAuth2Mode::Discovery, "Discovery"},
-    {OAuth2Mode::Offline, "Offline"},
-});
+REDFISH_ENUM_TABLE(OAuth2Mode,
+    "Invalid",
+    "Discovery",
+    "Offline");
 
 }
 // clang-format on
@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace facility
@@ -13,13 +15,12 @@ enum class FacilityType{
     Site,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(FacilityType, {
-    {FacilityType::Invalid, "Invalid"},
-    {FacilityType::Room, "Room"},
-    {FacilityType::Floor, "Floor"},
-    {FacilityType::Building, "Building"},
-    {FacilityType::Site, "Site"},
-});
+REDFISH_ENUM_TABLE(FacilityType,
+    "Invalid",
+    "Room",
+    "Floor",
+    "Building",
+    "Site");
 
 }
 // clang-format on
@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace host_interface
@@ -18,18 +20,16 @@ enum class AuthenticationMode{
     OemAuth,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(HostInterfaceType, {
-    {HostInterfaceType::Invalid, "Invalid"},
-    {HostInterfaceType::NetworkHostInterface, "NetworkHostInterface"},
-});
+REDFISH_ENUM_TABLE(HostInterfaceType,
+    "Invalid",
+    "NetworkHostInterface");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(AuthenticationMode, {
-    {AuthenticationMode::Invalid, "Invalid"},
-    {AuthenticationMode::AuthNone, "AuthNone"},
-    {AuthenticationMode::BasicAuth, "BasicAuth"},
-    {AuthenticationMode::RedfishSessionAuth, "RedfishSessionAuth"},
-    {AuthenticationMode::OemAuth, "OemAuth"},
-});
+REDFISH_ENUM_TABLE(AuthenticationMode,
+    "Invalid",
+    "AuthNone",
+    "BasicAuth",
+    "RedfishSessionAuth",
+    "OemAuth");
 
 }
 // clang-format on
@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace ip_addresses
@@ -29,29 +31,26 @@ enum class AddressState{
     Failed,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(IPv4AddressOrigin, {
-    {IPv4AddressOrigin::Invalid, "Invalid"},
-    {IPv4AddressOrigin::Static, "Static"},
-    {IPv4AddressOrigin::DHCP, "DHCP"},
-    {IPv4AddressOrigin::BOOTP, "BOOTP"},
-    {IPv4AddressOrigin::IPv4LinkLocal, "IPv4LinkLocal"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(IPv6AddressOrigin, {
-    {IPv6AddressOrigin::Invalid, "Invalid"},
-    {IPv6AddressOrigin::Static, "Static"},
-    {IPv6AddressOrigin::DHCPv6, "DHCPv6"},
-    {IPv6AddressOrigin::LinkLocal, "LinkLocal"},
-    {IPv6AddressOrigin::SLAAC, "SLAAC"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(AddressState, {
-    {AddressState::Invalid, "Invalid"},
-    {AddressState::Preferred, "Preferred"},
-    {AddressState::Deprecated, "Deprecated"},
-    {AddressState::Tentative, "Tentative"},
-    {AddressState::Failed, "Failed"},
-});
+REDFISH_ENUM_TABLE(IPv4AddressOrigin,
+    "Invalid",
+    "Static",
+    "DHCP",
+    "BOOTP",
+    "IPv4LinkLocal");
+
+REDFISH_ENUM_TABLE(IPv6AddressOrigin,
+    "Invalid",
+    "Static",
+    "DHCPv6",
+    "LinkLocal",
+    "SLAAC");
+
+REDFISH_ENUM_TABLE(AddressState,
+    "Invalid",
+    "Preferred",
+    "Deprecated",
+    "Tentative",
+    "Failed");
 
 }
 // clang-format on
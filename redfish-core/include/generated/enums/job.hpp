@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace job
@@ -22,22 +24,21 @@ enum class JobState{
     Continue,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(JobState, {
-    {JobState::Invalid, "Invalid"},
-    {JobState::New, "New"},
-    {JobState::Starting, "Starting"},
-    {JobState::Running, "Running"},
-    {JobState::Suspended, "Suspended"},
-    {JobState::Interrupted, "Interrupted"},
-    {JobState::Pending, "Pending"},
-    {JobState::Stopping, "Stopping"},
-    {JobState::Completed, "Completed"},
-    {JobState::Cancelled, "Cancelled"},
-    {JobState::Exception, "Exception"},
-    {JobState::Service, "Service"},
-    {JobState::UserIntervention, "UserIntervention"},
-    {JobState::Continue, "Continue"},
-});
+REDFISH_ENUM_TABLE(JobState,
+    "Invalid",
+    "New",
+    "Starting",
+    "Running",
+    "Suspended",
+    "Interrupted",
+    "Pending",
+    "Stopping",
+    "Completed",
+    "Cancelled",
+    "Exception",
+    "Service",
+    "UserIntervention",
+    "Continue");
 
 }
 // clang-format on
@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace key
@@ -25,25 +27,22 @@ enum class NVMeoFSecureHashType{
     SHA512,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(KeyType, {
-    {KeyType::Invalid, "Invalid"},
-    {KeyType::NVMeoF, "NVMeoF"},
-    {KeyType::SSH, "SSH"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(NVMeoFSecurityProtocolType, {
-    {NVMeoFSecurityProtocolType::Invalid, "Invalid"},
-    {NVMeoFSecurityProtocolType::DHHC, "DHHC"},
-    {NVMeoFSecurityProtocolType::TLS_PSK, "TLS_PSK"},
-    {NVMeoFSecurityProtocolType::OEM, "OEM"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(NVMeoFSecureHashType, {
-    {NVMeoFSecureHashType::Invalid, "Invalid"},
-    {NVMeoFSecureHashType::SHA256, "SHA256"},
-    {NVMeoFSecureHashType::SHA384, "SHA384"},
-    {NVMeoFSecureHashType::SHA512, "SHA512"},
-});
+REDFISH_ENUM_TABLE(KeyType,
+    "Invalid",
+    "NVMeoF",
+    "SSH");
+
+REDFISH_ENUM_TABLE(NVMeoFSecurityProtocolType,
+    "Invalid",
+    "DHHC",
+    "TLS_PSK",
+    "OEM");
+
+REDFISH_ENUM_TABLE(NVMeoFSecureHashType,
+    "Invalid",
+    "SHA256",
+    "SHA384",
+    "SHA512");
 
 }
 // clang-format on
@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace leak_detector
@@ -11,11 +13,10 @@ enum class LeakDetectorType{
     FloatSwitch,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(LeakDetectorType, {
-    {LeakDetectorType::Invalid, "Invalid"},
-    {LeakDetectorType::Moisture, "Moisture"},
-    {LeakDetectorType::FloatSwitch, "FloatSwitch"},
-});
+REDFISH_ENUM_TABLE(LeakDetectorType,
+    "Invalid",
+    "Moisture",
+    "FloatSwitch");
 
 }
 // clang-format on
@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace license
@@ -25,25 +27,22 @@ enum class LicenseOrigin{
     Installed,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(LicenseType, {
-    {LicenseType::Invalid, "Invalid"},
-    {LicenseType::Production, "Production"},
-    {LicenseType::Prototype, "Prototype"},
-    {LicenseType::Trial, "Trial"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(AuthorizationScope, {
-    {AuthorizationScope::Invalid, "Invalid"},
-    {AuthorizationScope::Device, "Device"},
-    {AuthorizationScope::Capacity, "Capacity"},
-    {AuthorizationScope::Service, "Service"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(LicenseOrigin, {
-    {LicenseOrigin::Invalid, "Invalid"},
-    {LicenseOrigin::BuiltIn, "BuiltIn"},
-    {LicenseOrigin::Installed, "Installed"},
-});
+REDFISH_ENUM_TABLE(LicenseType,
+    "Invalid",
+    "Production",
+    "Prototype",
+    "Trial");
+
+REDFISH_ENUM_TABLE(AuthorizationScope,
+    "Invalid",
+    "Device",
+    "Capacity",
+    "Service");
+
+REDFISH_ENUM_TABLE(LicenseOrigin,
+    "Invalid",
+    "BuiltIn",
+    "Installed");
 
 }
 // clang-format on
@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace license_service
@@ -18,18 +20,17 @@ enum class TransferProtocolType{
     NFS,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(TransferProtocolType, {
-    {TransferProtocolType::Invalid, "Invalid"},
-    {TransferProtocolType::CIFS, "CIFS"},
-    {TransferProtocolType::FTP, "FTP"},
-    {TransferProtocolType::SFTP, "SFTP"},
-    {TransferProtocolType::HTTP, "HTTP"},
-    {TransferProtocolType::HTTPS, "HTTPS"},
-    {TransferProtocolType::SCP, "SCP"},
-    {TransferProtocolType::TFTP, "TFTP"},
-    {TransferProtocolType::OEM, "OEM"},
-    {TransferProtocolType::NFS, "NFS"},
-});
+REDFISH_ENUM_TABLE(TransferProtocolType,
+    "Invalid",
+    "CIFS",
+    "FTP",
+    "SFTP",
+    "HTTP",
+    "HTTPS",
+    "SCP",
+    "TFTP",
+    "OEM",
+    "NFS");
 
 }
 // clang-format on
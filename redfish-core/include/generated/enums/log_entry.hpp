@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace log_entry
@@ -46,46 +48,41 @@ enum class CXLEntryType{
     Fatal,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(EventSeverity, {
-    {EventSeverity::Invalid, "Invalid"},
-    {EventSeverity::OK, "OK"},
-    {EventSeverity::Warning, "Warning"},
-    {EventSeverity::Critical, "Critical"},
-});
+REDFISH_ENUM_TABLE(EventSeverity,
+    "Invalid",
+    "OK",
+    "Warning",
+    "Critical");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(LogEntryType, {
-    {LogEntryType::Invalid, "Invalid"},
-    {LogEntryType::Event, "Event"},
-    {LogEntryType::SEL, "SEL"},
-    {LogEntryType::Oem, "Oem"},
-    {LogEntryType::CXL, "CXL"},
-});
+REDFISH_ENUM_TABLE(LogEntryType,
+    "Invalid",
+    "Event",
+    "SEL",
+    "Oem",
+    "CXL");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(LogDiagnosticDataTypes, {
-    {LogDiagnosticDataTypes::Invalid, "Invalid"},
-    {LogDiagnosticDataTypes::Manager, "Manager"},
-    {LogDiagnosticDataTypes::PreOS, "PreOS"},
-    {LogDiagnosticDataTypes::OS, "OS"},
-    {LogDiagnosticDataTypes::OEM, "OEM"},
-    {LogDiagnosticDataTypes::CPER, "CPER"},
-    {LogDiagnosticDataTypes::CPERSection, "CPERSection"},
-});
+REDFISH_ENUM_TABLE(LogDiagnosticDataTypes,
+    "Invalid",
+    "Manager",
+    "PreOS",
+    "OS",
+    "OEM",
+    "CPER",
+    "CPERSection");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(OriginatorTypes, {
-    {OriginatorTypes::Invalid, "Invalid"},
-    {OriginatorTypes::Client, "Client"},
-    {OriginatorTypes::Internal, "Internal"},
-    {OriginatorTypes::SupportingService, "SupportingService"},
-});
+REDFISH_ENUM_TABLE(OriginatorTypes,
+    "Invalid",
+    "Client",
+    "Internal",
+    "SupportingService");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(CXLEntryType, {
-    {CXLEntryType::Invalid, "Invalid"},
-    {CXLEntryType::DynamicCapacity, "DynamicCapacity"},
-    {CXLEntryType::Informational, "Informational"},
-    {CXLEntryType::Warning, "Warning"},
-    {CXLEntryType::Failure, "Failure"},
-    {CXLEntryType::Fatal, "Fatal"},
-});
+REDFISH_ENUM_TABLE(CXLEntryType,
+    "Invalid",
+    "DynamicCapacity",
+    "Informational",
+    "Warning",
+    "Failure",
+    "Fatal");
 
 }
 // clang-format on
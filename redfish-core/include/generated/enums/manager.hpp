@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace manager
@@ -44,44 +46,39 @@ enum class ResetToDefaultsType{
     PreserveNetwork,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(ManagerType, {
-    {ManagerType::Invalid, "Invalid"},
-    {ManagerType::ManagementController, "ManagementController"},
-    {ManagerType::EnclosureManager, "EnclosureManager"},
-    {ManagerType::BMC, "BMC"},
-    {ManagerType::RackManager, "RackManager"},
-    {ManagerType::AuxiliaryController, "AuxiliaryController"},
-    {ManagerType::Service, "Service"},
-});
+REDFISH_ENUM_TABLE(ManagerType,
+    "Invalid",
+    "ManagementController",
+    "EnclosureManager",
+    "BMC",
+    "RackManager",
+    "AuxiliaryController",
+    "Service");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(SerialConnectTypesSupported, {
-    {SerialConnectTypesSupported::Invalid, "Invalid"},
-    {SerialConnectTypesSupported::SSH, "SSH"},
-    {SerialConnectTypesSupported::Telnet, "Telnet"},
-    {SerialConnectTypesSupported::IPMI, "IPMI"},
-    {SerialConnectTypesSupported::Oem, "Oem"},
-});
+REDFISH_ENUM_TABLE(SerialConnectTypesSupported,
+    "Invalid",
+    "SSH",
+    "Telnet",
+    "IPMI",
+    "Oem");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(CommandConnectTypesSupported, {
-    {CommandConnectTypesSupported::Invalid, "Invalid"},
-    {CommandConnectTypesSupported::SSH, "SSH"},
-    {CommandConnectTypesSupported::Telnet, "Telnet"},
-    {CommandConnectTypesSupported::IPMI, "IPMI"},
-    {CommandConnectTypesSupported::Oem, "Oem"},
-});
+REDFISH_ENUM_TABLE(CommandConnectTypesSupported,
+    "Invalid",
+    "SSH",
+    "Telnet",
+    "IPMI",
+    "Oem");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(GraphicalConnectTypesSupported, {
-    {GraphicalConnectTypesSupported::Invalid, "Invalid"},
-    {GraphicalConnectTypesSupported::KVMIP, "KVMIP"},
-    {GraphicalConnectTypesSupported::Oem, "Oem"},
-});
+REDFISH_ENUM_TABLE(GraphicalConnectTypesSupported,
+    "Invalid",
+    "KVMIP",
+    "Oem");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(ResetToDefaultsType, {
-    {ResetToDefaultsType::Invalid, "Invalid"},
-    {ResetToDefaultsType::ResetAll, "ResetAll"},
-    {ResetToDefaultsType::PreserveNetworkAndUsers, "PreserveNetworkAndUsers"},
-    {ResetToDefaultsType::PreserveNetwork, "PreserveNetwork"},
-});
+REDFISH_ENUM_TABLE(ResetToDefaultsType,
+    "Invalid",
+    "ResetAll",
+    "PreserveNetworkAndUsers",
+    "PreserveNetwork");
 
 }
 // clang-format on
@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace manager_network_protocol
@@ -38,38 +40,34 @@ enum class SNMPEncryptionProtocols{
     CFB128_AES128,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(NotifyIPv6Scope, {
-    {NotifyIPv6Scope::Invalid, "Invalid"},
-    {NotifyIPv6Scope::Link, "Link"},
-    {NotifyIPv6Scope::Site, "Site"},
-    {NotifyIPv6Scope::Organization, "Organization"},
-});
+REDFISH_ENUM_TABLE(NotifyIPv6Scope,
+    "Invalid",
+    "Link",
+    "Site",
+    "Organization");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(SNMPCommunityAccessMode, {
-    {SNMPCommunityAccessMode::Invalid, "Invalid"},
-    {SNMPCommunityAccessMode::Full, "Full"},
-    {SNMPCommunityAccessMode::Limited, "Limited"},
-});
+REDFISH_ENUM_TABLE(SNMPCommunityAccessMode,
+    "Invalid",
+    "Full",
+    "Limited");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(SNMPAuthenticationProtocols, {
-    {SNMPAuthenticationProtocols::Invalid, "Invalid"},
-    {SNMPAuthenticationProtocols::Account, "Account"},
-    {SNMPAuthenticationProtocols::CommunityString, "CommunityString"},
-    {SNMPAuthenticationProtocols::HMAC_MD5, "HMAC_MD5"},
-    {SNMPAuthenticationProtocols::HMAC_SHA96, "HMAC_SHA96"},
-    {SNMPAuthenticationProtocols::HMAC128_SHA224, "HMAC128_SHA224"},
-    {SNMPAuthenticationProtocols::HMAC192_SHA256, "HMAC192_SHA256"},
-    {SNMPAuthenticationProtocols::HMAC256_SHA384, "HMAC256_SHA384"},
-    {SNMPAuthenticationProtocols::HMAC384_SHA512, "HMAC384_SHA512"},
-});
+REDFISH_ENUM_TABLE(SNMPAuthenticationProtocols,
+    "Invalid",
+    "Account",
+    "CommunityString",
+    "HMAC_MD5",
+    "HMAC_SHA96",
+    "HMAC128_SHA224",
+    "HMAC192_SHA256",
+    "HMAC256_SHA384",
+    "HMAC384_SHA512");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(SNMPEncryptionProtocols, {
-    {SNMPEncryptionProtocols::Invalid, "Invalid"},
-    {SNMPEncryptionProtocols::None, "None"},
-    {SNMPEncryptionProtocols::Account, "Account"},
-    {SNMPEncryptionProtocols::CBC_DES, "CBC_DES"},
-    {SNMPEncryptionProtocols::CFB128_AES128, "CFB128_AES128"},
-});
+REDFISH_ENUM_TABLE(SNMPEncryptionProtocols,
+    "Invalid",
+    "None",
+    "Account",
+    "CBC_DES",
+    "CFB128_AES128");
 
 }
 // clang-format on
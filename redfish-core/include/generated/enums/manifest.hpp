@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace manifest
@@ -22,22 +24,20 @@ enum class StanzaType{
     RegisterResourceBlock,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(Expand, {
-    {Expand::Invalid, "Invalid"},
-    {Expand::None, "None"},
-    {Expand::All, "All"},
-    {Expand::Relevant, "Relevant"},
-});
+REDFISH_ENUM_TABLE(Expand,
+    "Invalid",
+    "None",
+    "All",
+    "Relevant");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(StanzaType, {
-    {StanzaType::Invalid, "Invalid"},
-    {StanzaType::ComposeSystem, "ComposeSystem"},
-    {StanzaType::DecomposeSystem, "DecomposeSystem"},
-    {StanzaType::ComposeResource, "ComposeResource"},
-    {StanzaType::DecomposeResource, "DecomposeResource"},
-    {StanzaType::OEM, "OEM"},
-    {StanzaType::RegisterResourceBlock, "RegisterResourceBlock"},
-});
+REDFISH_ENUM_TABLE(StanzaType,
+    "Invalid",
+    "ComposeSystem",
+    "DecomposeSystem",
+    "ComposeResource",
+    "DecomposeResource",
+    "OEM",
+    "RegisterResourceBlock");
 
 }
 // clang-format on
@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace media_controller
@@ -10,10 +12,9 @@ enum class MediaControllerType{
     Memory,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(MediaControllerType, {
-    {MediaControllerType::Invalid, "Invalid"},
-    {MediaControllerType::Memory, "Memory"},
-});
+REDFISH_ENUM_TABLE(MediaControllerType,
+    "Invalid",
+    "Memory");
 
 }
 // clang-format on
@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace memory_chunks
@@ -25,25 +27,22 @@ enum class OperationalState{
     Offline,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(AddressRangeType, {
-    {AddressRangeType::Invalid, "Invalid"},
-    {AddressRangeType::Volatile, "Volatile"},
-    {AddressRangeType::PMEM, "PMEM"},
-    {AddressRangeType::Block, "Block"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(MediaLocation, {
-    {MediaLocation::Invalid, "Invalid"},
-    {MediaLocation::Local, "Local"},
-    {MediaLocation::Remote, "Remote"},
-    {MediaLocation::Mixed, "Mixed"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(OperationalState, {
-    {OperationalState::Invalid, "Invalid"},
-    {OperationalState::Online, "Online"},
-    {OperationalState::Offline, "Offline"},
-});
+REDFISH_ENUM_TABLE(AddressRangeType,
+    "Invalid",
+    "Volatile",
+    "PMEM",
+    "Block");
+
+REDFISH_ENUM_TABLE(MediaLocation,
+    "Invalid",
+    "Local",
+    "Remote",
+    "Mixed");
+
+REDFISH_ENUM_TABLE(OperationalState,
+    "Invalid",
+    "Online",
+    "Offline");
 
 }
 // clang-format on
@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace memory_region
@@ -11,11 +13,10 @@ enum class RegionType{
     Dynamic,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(RegionType, {
-    {RegionType::Invalid, "Invalid"},
-    {RegionType::Static, "Static"},
-    {RegionType::Dynamic, "Dynamic"},
-});
+REDFISH_ENUM_TABLE(RegionType,
+    "Invalid",
+    "Static",
+    "Dynamic");
 
 }
 // clang-format on
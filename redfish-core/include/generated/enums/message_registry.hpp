@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace message_registry
@@ -16,16 +18,14 @@ enum class ClearingType{
     SameOriginOfCondition,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(ParamType, {
-    {ParamType::Invalid, "Invalid"},
-    {ParamType::string, "string"},
-    {ParamType::number, "number"},
-});
+REDFISH_ENUM_TABLE(ParamType,
+    "Invalid",
+    "string",
+    "number");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(ClearingType, {
-    {ClearingType::Invalid, "Invalid"},
-    {ClearingType::SameOriginOfCondition, "SameOriginOfCondition"},
-});
+REDFISH_ENUM_TABLE(ClearingType,
+    "Invalid",
+    "SameOriginOfCondition");
 
 }
 // clang-format on
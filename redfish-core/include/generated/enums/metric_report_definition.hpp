@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace metric_report_definition
@@ -41,41 +43,36 @@ enum class CollectionTimeScope{
     StartupInterval,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(MetricReportDefinitionType, {
-    {MetricReportDefinitionType::Invalid, "Invalid"},
-    {MetricReportDefinitionType::Periodic, "Periodic"},
-    {MetricReportDefinitionType::OnChange, "OnChange"},
-    {MetricReportDefinitionType::OnRequest, "OnRequest"},
-});
+REDFISH_ENUM_TABLE(MetricReportDefinitionType,
+    "Invalid",
+    "Periodic",
+    "OnChange",
+    "OnRequest");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(ReportActionsEnum, {
-    {ReportActionsEnum::Invalid, "Invalid"},
-    {ReportActionsEnum::LogToMetricReportsCollection, "LogToMetricReportsCollection"},
-    {ReportActionsEnum::RedfishEvent, "RedfishEvent"},
-});
+REDFISH_ENUM_TABLE(ReportActionsEnum,
+    "Invalid",
+    "LogToMetricReportsCollection",
+    "RedfishEvent");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(ReportUpdatesEnum, {
-    {ReportUpdatesEnum::Invalid, "Invalid"},
-    {ReportUpdatesEnum::Overwrite, "Overwrite"},
-    {ReportUpdatesEnum::AppendWrapsWhenFull, "AppendWrapsWhenFull"},
-    {ReportUpdatesEnum::AppendStopsWhenFull, "AppendStopsWhenFull"},
-    {ReportUpdatesEnum::NewReport, "NewReport"},
-});
+REDFISH_ENUM_TABLE(ReportUpdatesEnum,
+    "Invalid",
+    "Overwrite",
+    "AppendWrapsWhenFull",
+    "AppendStopsWhenFull",
+    "NewReport");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(CalculationAlgorithmEnum, {
-    {CalculationAlgorithmEnum::Invalid, "Invalid"},
-    {CalculationAlgorithmEnum::Average, "Average"},
-    {CalculationAlgorithmEnum::Maximum, "Maximum"},
-    {CalculationAlgorithmEnum::Minimum, "Minimum"},
-    {CalculationAlgorithmEnum::Summation, "Summation"},
-});
+REDFISH_ENUM_TABLE(CalculationAlgorithmEnum,
+    "Invalid",
+    "Average",
+    "Maximum",
+    "Minimum",
+    "Summation");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(CollectionTimeScope, {
-    {CollectionTimeScope::Invalid, "Invalid"},
-    {CollectionTimeScope::Point, "Point"},
-    {CollectionTimeScope::Interval, "Interval"},
-    {CollectionTimeScope::StartupInterval, "StartupInterval"},
-});
+REDFISH_ENUM_TABLE(CollectionTimeScope,
+    "Invalid",
+    "Point",
+    "Interval",
+    "StartupInterval");
 
 }
 // clang-format on
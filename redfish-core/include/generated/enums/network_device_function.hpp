@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace network_device_function
@@ -51,51 +53,45 @@ enum class DataDirection{
     Egress,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(NetworkDeviceTechnology, {
-    {NetworkDeviceTechnology::Invalid, "Invalid"},
-    {NetworkDeviceTechnology::Disabled, "Disabled"},
-    {NetworkDeviceTechnology::Ethernet, "Ethernet"},
-    {NetworkDeviceTechnology::FibreChannel, "FibreChannel"},
-    {NetworkDeviceTechnology::iSCSI, "iSCSI"},
-    {NetworkDeviceTechnology::FibreChannelOverEthernet, "FibreChannelOverEthernet"},
-    {NetworkDeviceTechnology::InfiniBand, "InfiniBand"},
-});
+REDFISH_ENUM_TABLE(NetworkDeviceTechnology,
+    "Invalid",
+    "Disabled",
+    "Ethernet",
+    "FibreChannel",
+    "iSCSI",
+    "FibreChannelOverEthernet",
+    "InfiniBand");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(IPAddressType, {
-    {IPAddressType::Invalid, "Invalid"},
-    {IPAddressType::IPv4, "IPv4"},
-    {IPAddressType::IPv6, "IPv6"},
-});
+REDFISH_ENUM_TABLE(IPAddressType,
+    "Invalid",
+    "IPv4",
+    "IPv6");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(AuthenticationMethod, {
-    {AuthenticationMethod::Invalid, "Invalid"},
-    {AuthenticationMethod::None, "None"},
-    {AuthenticationMethod::CHAP, "CHAP"},
-    {AuthenticationMethod::MutualCHAP, "MutualCHAP"},
-});
+REDFISH_ENUM_TABLE(AuthenticationMethod,
+    "Invalid",
+    "None",
+    "CHAP",
+    "MutualCHAP");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(WWNSource, {
-    {WWNSource::Invalid, "Invalid"},
-    {WWNSource::ConfiguredLocally, "ConfiguredLocally"},
-    {WWNSource::ProvidedByFabric, "ProvidedByFabric"},
-});
+REDFISH_ENUM_TABLE(WWNSource,
+    "Invalid",
+    "ConfiguredLocally",
+    "ProvidedByFabric");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(BootMode, {
-    {BootMode::Invalid, "Invalid"},
-    {BootMode::Disabled, "Disabled"},
-    {BootMode::PXE, "PXE"},
-    {BootMode::iSCSI, "iSCSI"},
-    {BootMode::FibreChannel, "FibreChannel"},
-    {BootMode::FibreChannelOverEthernet, "FibreChannelOverEthernet"},
-    {BootMode::HTTP, "HTTP"},
-});
+REDFISH_ENUM_TABLE(BootMode,
+    "Invalid",
+    "Disabled",
+    "PXE",
+    "iSCSI",
+    "FibreChannel",
+    "FibreChannelOverEthernet",
+    "HTTP");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(DataDirection, {
-    {DataDirection::Invalid, "Invalid"},
-    {DataDirection::None, "None"},
-    {DataDirection::Ingress, "Ingress"},
-    {DataDirection::Egress, "Egress"},
-});
+REDFISH_ENUM_TABLE(DataDirection,
+    "Invalid",
+    "None",
+    "Ingress",
+    "Egress");
 
 }
 // clang-format on
@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace network_port
@@ -45,45 +47,40 @@ enum class PortConnectionType{
     ExtenderFabric,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(LinkStatus, {
-    {LinkStatus::Invalid, "Invalid"},
-    {LinkStatus::Down, "Down"},
-    {LinkStatus::Up, "Up"},
-    {LinkStatus::Starting, "Starting"},
-    {LinkStatus::Training, "Training"},
-});
+REDFISH_ENUM_TABLE(LinkStatus,
+    "Invalid",
+    "Down",
+    "Up",
+    "Starting",
+    "Training");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(LinkNetworkTechnology, {
-    {LinkNetworkTechnology::Invalid, "Invalid"},
-    {LinkNetworkTechnology::Ethernet, "Ethernet"},
-    {LinkNetworkTechnology::InfiniBand, "InfiniBand"},
-    {LinkNetworkTechnology::FibreChannel, "FibreChannel"},
-});
+REDFISH_ENUM_TABLE(LinkNetworkTechnology,
+    "Invalid",
+    "Ethernet",
+    "InfiniBand",
+    "FibreChannel");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(SupportedEthernetCapabilities, {
-    {SupportedEthernetCapabilities::Invalid, "Invalid"},
-    {SupportedEthernetCapabilities::WakeOnLAN, "WakeOnLAN"},
-    {SupportedEthernetCapabilities::EEE, "EEE"},
-});
+REDFISH_ENUM_TABLE(SupportedEthernetCapabilities,
+    "Invalid",
+    "WakeOnLAN",
+    "EEE");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(FlowControl, {
-    {FlowControl::Invalid, "Invalid"},
-    {FlowControl::None, "None"},
-    {FlowControl::TX, "TX"},
-    {FlowControl::RX, "RX"},
-    {FlowControl::TX_RX, "TX_RX"},
-});
+REDFISH_ENUM_TABLE(FlowControl,
+    "Invalid",
+    "None",
+    "TX",
+    "RX",
+    "TX_RX");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(PortConnectionType, {
-    {PortConnectionType::Invalid, "Invalid"},
-    {PortConnectionType::NotConnected, "NotConnected"},
-    {PortConnectionType::NPort, "NPort"},
-    {PortConnectionType::PointToPoint, "PointToPoint"},
-    {PortConnectionType::PrivateLoop, "PrivateLoop"},
-    {PortConnectionType::PublicLoop, "PublicLoop"},
-    {PortConnectionType::Generic, "Generic"},
-    {PortConnectionType::ExtenderFabric, "ExtenderFabric"},
-});
+REDFISH_ENUM_TABLE(PortConnectionType,
+    "Invalid",
+    "NotConnected",
+    "NPort",
+    "PointToPoint",
+    "PrivateLoop",
+    "PublicLoop",
+    "Generic",
+    "ExtenderFabric");
 
 }
 // clang-format on
@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace oem_computer_system
@@ -12,12 +14,11 @@ enum class FirmwareProvisioningStatus{
     ProvisionedAndLocked,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(FirmwareProvisioningStatus, {
-    {FirmwareProvisioningStatus::Invalid, "Invalid"},
-    {FirmwareProvisioningStatus::NotProvisioned, "NotProvisioned"},
-    {FirmwareProvisioningStatus::ProvisionedButNotLocked, "ProvisionedButNotLocked"},
-    {FirmwareProvisioningStatus::ProvisionedAndLocked, "ProvisionedAndLocked"},
-});
+REDFISH_ENUM_TABLE(FirmwareProvisioningStatus,
+    "Invalid",
+    "NotProvisioned",
+    "ProvisionedButNotLocked",
+    "ProvisionedAndLocked");
 
 }
 // clang-format on
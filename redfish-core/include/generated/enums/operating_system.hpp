@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace operating_system
@@ -48,48 +50,44 @@ enum class ContainerEngineTypes{
     CRIO,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(OperatingSystemTypes, {
-    {OperatingSystemTypes::Invalid, "Invalid"},
-    {OperatingSystemTypes::Linux, "Linux"},
-    {OperatingSystemTypes::Windows, "Windows"},
-    {OperatingSystemTypes::Solaris, "Solaris"},
-    {OperatingSystemTypes::HPUX, "HPUX"},
-    {OperatingSystemTypes::AIX, "AIX"},
-    {OperatingSystemTypes::BSD, "BSD"},
-    {OperatingSystemTypes::macOS, "macOS"},
-    {OperatingSystemTypes::IBMi, "IBMi"},
-    {OperatingSystemTypes::Hypervisor, "Hypervisor"},
-});
+REDFISH_ENUM_TABLE(OperatingSystemTypes,
+    "Invalid",
+    "Linux",
+    "Windows",
+    "Solaris",
+    "HPUX",
+    "AIX",
+    "BSD",
+    "macOS",
+    "IBMi",
+    "Hypervisor");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(VirtualMachineEngineTypes, {
-    {VirtualMachineEngineTypes::Invalid, "Invalid"},
-    {VirtualMachineEngineTypes::VMwareESX, "VMwareESX"},
-    {VirtualMachineEngineTypes::HyperV, "HyperV"},
-    {VirtualMachineEngineTypes::Xen, "Xen"},
-    {VirtualMachineEngineTypes::KVM, "KVM"},
-    {VirtualMachineEngineTypes::QEMU, "QEMU"},
-    {VirtualMachineEngineTypes::VirtualBox, "VirtualBox"},
-    {VirtualMachineEngineTypes::PowerVM, "PowerVM"},
-});
+REDFISH_ENUM_TABLE(VirtualMachineEngineTypes,
+    "Invalid",
+    "VMwareESX",
+    "HyperV",
+    "Xen",
+    "KVM",
+    "QEMU",
+    "VirtualBox",
+    "PowerVM");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(VirtualMachineImageTypes, {
-    {VirtualMachineImageTypes::Invalid, "Invalid"},
-    {VirtualMachineImageTypes::Raw, "Raw"},
-    {VirtualMachineImageTypes::OVF, "OVF"},
-    {VirtualMachineImageTypes::OVA, "OVA"},
-    {VirtualMachineImageTypes::VHD, "VHD"},
-    {VirtualMachineImageTypes::VMDK, "VMDK"},
-    {VirtualMachineImageTypes::VDI, "VDI"},
-    {VirtualMachineImageTypes::QCOW, "QCOW"},
-    {VirtualMachineImageTypes::QCOW2, "QCOW2"},
-});
+REDFISH_ENUM_TABLE(VirtualMachineImageTypes,
+    "Invalid",
+    "Raw",
+    "OVF",
+    "OVA",
+    "VHD",
+    "VMDK",
+    "VDI",
+    "QCOW",
+    "QCOW2");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(ContainerEngineTypes, {
-    {ContainerEngineTypes::Invalid, "Invalid"},
-    {ContainerEngineTypes::Docker, "Docker"},
-    {ContainerEngineTypes::containerd, "containerd"},
-    {ContainerEngineTypes::CRIO, "CRIO"},
-});
+REDFISH_ENUM_TABLE(ContainerEngineTypes,
+    "Invalid",
+    "Docker",
+    "containerd",
+    "CRIO");
 
 }
 // clang-format on
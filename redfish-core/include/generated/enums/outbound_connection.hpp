@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace outbound_connection
@@ -20,20 +22,18 @@ enum class AuthenticationType{
     OEM,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(OutboundConnectionRetryPolicyType, {
-    {OutboundConnectionRetryPolicyType::Invalid, "Invalid"},
-    {OutboundConnectionRetryPolicyType::None, "None"},
-    {OutboundConnectionRetryPolicyType::RetryForever, "RetryForever"},
-    {OutboundConnectionRetryPolicyType::RetryCount, "RetryCount"},
-});
+REDFISH_ENUM_TABLE(OutboundConnectionRetryPolicyType,
+    "Invalid",
+    "None",
+    "RetryForever",
+    "RetryCount");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(AuthenticationType, {
-    {AuthenticationType::Invalid, "Invalid"},
-    {AuthenticationType::MTLS, "MTLS"},
-    {AuthenticationType::JWT, "JWT"},
-    {AuthenticationType::None, "None"},
-    {AuthenticationType::OEM, "OEM"},
-});
+REDFISH_ENUM_TABLE(AuthenticationType,
+    "Invalid",
+    "MTLS",
+    "JWT",
+    "None",
+    "OEM");
 
 }
 // clang-format on
@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace outlet_group
@@ -12,12 +14,11 @@ enum class PowerState{
     PowerCycle,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(PowerState, {
-    {PowerState::Invalid, "Invalid"},
-    {PowerState::On, "On"},
-    {PowerState::Off, "Off"},
-    {PowerState::PowerCycle, "PowerCycle"},
-});
+REDFISH_ENUM_TABLE(PowerState,
+    "Invalid",
+    "On",
+    "Off",
+    "PowerCycle");
 
 }
 // clang-format on
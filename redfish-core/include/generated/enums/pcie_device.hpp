@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace pcie_device
@@ -57,57 +59,51 @@ enum class CXLDynamicCapacityPolicies{
     TagBased,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(PCIeTypes, {
-    {PCIeTypes::Invalid, "Invalid"},
-    {PCIeTypes::Gen1, "Gen1"},
-    {PCIeTypes::Gen2, "Gen2"},
-    {PCIeTypes::Gen3, "Gen3"},
-    {PCIeTypes::Gen4, "Gen4"},
-    {PCIeTypes::Gen5, "Gen5"},
-});
+REDFISH_ENUM_TABLE(PCIeTypes,
+    "Invalid",
+    "Gen1",
+    "Gen2",
+    "Gen3",
+    "Gen4",
+    "Gen5");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(DeviceType, {
-    {DeviceType::Invalid, "Invalid"},
-    {DeviceType::SingleFunction, "SingleFunction"},
-    {DeviceType::MultiFunction, "MultiFunction"},
-    {DeviceType::Simulated, "Simulated"},
-    {DeviceType::Retimer, "Retimer"},
-});
+REDFISH_ENUM_TABLE(DeviceType,
+    "Invalid",
+    "SingleFunction",
+    "MultiFunction",
+    "Simulated",
+    "Retimer");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(SlotType, {
-    {SlotType::Invalid, "Invalid"},
-    {SlotType::FullLength, "FullLength"},
-    {SlotType::HalfLength, "HalfLength"},
-    {SlotType::LowProfile, "LowProfile"},
-    {SlotType::Mini, "Mini"},
-    {SlotType::M2, "M2"},
-    {SlotType::OEM, "OEM"},
-    {SlotType::OCP3Small, "OCP3Small"},
-    {SlotType::OCP3Large, "OCP3Large"},
-    {SlotType::U2, "U2"},
-});
+REDFISH_ENUM_TABLE(SlotType,
+    "Invalid",
+    "FullLength",
+    "HalfLength",
+    "LowProfile",
+    "Mini",
+    "M2",
+    "OEM",
+    "OCP3Small",
+    "OCP3Large",
+    "U2");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(LaneSplittingType, {
-    {LaneSplittingType::Invalid, "Invalid"},
-    {LaneSplittingType::None, "None"},
-    {LaneSplittingType::Bridged, "Bridged"},
-    {LaneSplittingType::Bifurcated, "Bifurcated"},
-});
+REDFISH_ENUM_TABLE(LaneSplittingType,
+    "Invalid",
+    "None",
+    "Bridged",
+    "Bifurcated");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(CXLDeviceType, {
-    {CXLDeviceType::Invalid, "Invalid"},
-    {CXLDeviceType::Type1, "Type1"},
-    {CXLDeviceType::Type2, "Type2"},
-    {CXLDeviceType::Type3, "Type3"},
-});
+REDFISH_ENUM_TABLE(CXLDeviceType,
+    "Invalid",
+    "Type1",
+    "Type2",
+    "Type3");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(CXLDynamicCapacityPolicies, {
-    {CXLDynamicCapacityPolicies::Invalid, "Invalid"},
-    {CXLDynamicCapacityPolicies::Free, "Free"},
-    {CXLDynamicCapacityPolicies::Contiguous, "Contiguous"},
-    {CXLDynamicCapacityPolicies::Prescriptive, "Prescriptive"},
-    {CXLDynamicCapacityPolicies::TagBased, "TagBased"},
-});
+REDFISH_ENUM_TABLE(CXLDynamicCapacityPolicies,
+    "Invalid",
+    "Free",
+    "Contiguous",
+    "Prescriptive",
+    "TagBased");
 
 }
 // clang-format on
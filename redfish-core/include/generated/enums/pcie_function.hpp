@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace pcie_function
@@ -44,44 +46,41 @@ enum class FunctionProtocol{
     CXL,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(DeviceClass, {
-    {DeviceClass::Invalid, "Invalid"},
-    {DeviceClass::UnclassifiedDevice, "UnclassifiedDevice"},
-    {DeviceClass::MassStorageController, "MassStorageController"},
-    {DeviceClass::NetworkController, "NetworkController"},
-    {DeviceClass::DisplayController, "DisplayController"},
-    {DeviceClass::MultimediaController, "MultimediaController"},
-    {DeviceClass::MemoryController, "MemoryController"},
-    {DeviceClass::Bridge, "Bridge"},
-    {DeviceClass::CommunicationController, "CommunicationController"},
-    {DeviceClass::GenericSystemPeripheral, "GenericSystemPeripheral"},
-    {DeviceClass::InputDeviceController, "InputDeviceController"},
-    {DeviceClass::DockingStation, "DockingStation"},
-    {DeviceClass::Processor, "Processor"},
-    {DeviceClass::SerialBusController, "SerialBusController"},
-    {DeviceClass::WirelessController, "WirelessController"},
-    {DeviceClass::IntelligentController, "IntelligentController"},
-    {DeviceClass::SatelliteCommunicationsController, "SatelliteCommunicationsController"},
-    {DeviceClass::EncryptionController, "EncryptionController"},
-    {DeviceClass::SignalProcessingController, "SignalProcessingController"},
-    {DeviceClass::ProcessingAccelerators, "ProcessingAccelerators"},
-    {DeviceClass::NonEssentialInstrumentation, "NonEssentialInstrumentation"},
-    {DeviceClass::Coprocessor, "Coprocessor"},
-    {DeviceClass::UnassignedClass, "UnassignedClass"},
-    {DeviceClass::Other, "Other"},
-});
+REDFISH_ENUM_TABLE(DeviceClass,
+    "Invalid",
+    "UnclassifiedDevice",
+    "MassStorageController",
+    "NetworkController",
+    "DisplayController",
+    "MultimediaController",
+    "MemoryController",
+    "Bridge",
+    "CommunicationController",
+    "GenericSystemPeripheral",
+    "InputDeviceController",
+    "DockingStation",
+    "Processor",
+    "SerialBusController",
+    "WirelessController",
+    "IntelligentController",
+    "SatelliteCommunicationsController",
+    "EncryptionController",
+    "SignalProcessingController",
+    "ProcessingAccelerators",
+    "NonEssentialInstrumentation",
+    "Coprocessor",
+    "UnassignedClass",
+    "Other");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(FunctionType, {
-    {FunctionType::Invalid, "Invalid"},
-    {FunctionType::Physical, "Physical"},
-    {FunctionType::Virtual, "Virtual"},
-});
+REDFISH_ENUM_TABLE(FunctionType,
+    "Invalid",
+    "Physical",
+    "Virtual");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(FunctionProtocol, {
-    {FunctionProtocol::Invalid, "Invalid"},
-    {FunctionProtocol::PCIe, "PCIe"},
-    {FunctionProtocol::CXL, "CXL"},
-});
+REDFISH_ENUM_TABLE(FunctionProtocol,
+    "Invalid",
+    "PCIe",
+    "CXL");
 
 }
 // clang-format on
@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace pcie_slots
@@ -18,18 +20,17 @@ enum class SlotTypes{
     U2,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(SlotTypes, {
-    {SlotTypes::Invalid, "Invalid"},
-    {SlotTypes::FullLength, "FullLength"},
-    {SlotTypes::HalfLength, "HalfLength"},
-    {SlotTypes::LowProfile, "LowProfile"},
-    {SlotTypes::Mini, "Mini"},
-    {SlotTypes::M2, "M2"},
-    {SlotTypes::OEM, "OEM"},
-    {SlotTypes::OCP3Small, "OCP3Small"},
-    {SlotTypes::OCP3Large, "OCP3Large"},
-    {SlotTypes::U2, "U2"},
-});
+REDFISH_ENUM_TABLE(SlotTypes,
+    "Invalid",
+    "FullLength",
+    "HalfLength",
+    "LowProfile",
+    "Mini",
+    "M2",
+    "OEM",
+    "OCP3Small",
+    "OCP3Large",
+    "U2");
 
 }
 // clang-format on
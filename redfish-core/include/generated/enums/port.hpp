@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace port
@@ -165,165 +167,149 @@ enum class ConnectedDeviceType{
     Type3MLD,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(PortType, {
-    {PortType::Invalid, "Invalid"},
-    {PortType::UpstreamPort, "UpstreamPort"},
-    {PortType::DownstreamPort, "DownstreamPort"},
-    {PortType::InterswitchPort, "InterswitchPort"},
-    {PortType::ManagementPort, "ManagementPort"},
-    {PortType::BidirectionalPort, "BidirectionalPort"},
-    {PortType::UnconfiguredPort, "UnconfiguredPort"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(PortMedium, {
-    {PortMedium::Invalid, "Invalid"},
-    {PortMedium::Electrical, "Electrical"},
-    {PortMedium::Optical, "Optical"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(LinkState, {
-    {LinkState::Invalid, "Invalid"},
-    {LinkState::Enabled, "Enabled"},
-    {LinkState::Disabled, "Disabled"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(LinkStatus, {
-    {LinkStatus::Invalid, "Invalid"},
-    {LinkStatus::LinkUp, "LinkUp"},
-    {LinkStatus::Starting, "Starting"},
-    {LinkStatus::Training, "Training"},
-    {LinkStatus::LinkDown, "LinkDown"},
-    {LinkStatus::NoLink, "NoLink"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(LinkNetworkTechnology, {
-    {LinkNetworkTechnology::Invalid, "Invalid"},
-    {LinkNetworkTechnology::Ethernet, "Ethernet"},
-    {LinkNetworkTechnology::InfiniBand, "InfiniBand"},
-    {LinkNetworkTechnology::FibreChannel, "FibreChannel"},
-    {LinkNetworkTechnology::GenZ, "GenZ"},
-    {LinkNetworkTechnology::PCIe, "PCIe"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(PortConnectionType, {
-    {PortConnectionType::Invalid, "Invalid"},
-    {PortConnectionType::NotConnected, "NotConnected"},
-    {PortConnectionType::NPort, "NPort"},
-    {PortConnectionType::PointToPoint, "PointToPoint"},
-    {PortConnectionType::PrivateLoop, "PrivateLoop"},
-    {PortConnectionType::PublicLoop, "PublicLoop"},
-    {PortConnectionType::Generic, "Generic"},
-    {PortConnectionType::ExtenderFabric, "ExtenderFabric"},
-    {PortConnectionType::FPort, "FPort"},
-    {PortConnectionType::EPort, "EPort"},
-    {PortConnectionType::TEPort, "TEPort"},
-    {PortConnectionType::NPPort, "NPPort"},
-    {PortConnectionType::GPort, "GPort"},
-    {PortConnectionType::NLPort, "NLPort"},
-    {PortConnectionType::FLPort, "FLPort"},
-    {PortConnectionType::EXPort, "EXPort"},
-    {PortConnectionType::UPort, "UPort"},
-    {PortConnectionType::DPort, "DPort"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(SupportedEthernetCapabilities, {
-    {SupportedEthernetCapabilities::Invalid, "Invalid"},
-    {SupportedEthernetCapabilities::WakeOnLAN, "WakeOnLAN"},
-    {SupportedEthernetCapabilities::EEE, "EEE"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(FlowControl, {
-    {FlowControl::Invalid, "Invalid"},
-    {FlowControl::None, "None"},
-    {FlowControl::TX, "TX"},
-    {FlowControl::RX, "RX"},
-    {FlowControl::TX_RX, "TX_RX"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(IEEE802IdSubtype, {
-    {IEEE802IdSubtype::Invalid, "Invalid"},
-    {IEEE802IdSubtype::ChassisComp, "ChassisComp"},
-    {IEEE802IdSubtype::IfAlias, "IfAlias"},
-    {IEEE802IdSubtype::PortComp, "PortComp"},
-    {IEEE802IdSubtype::MacAddr, "MacAddr"},
-    {IEEE802IdSubtype::NetworkAddr, "NetworkAddr"},
-    {IEEE802IdSubtype::IfName, "IfName"},
-    {IEEE802IdSubtype::AgentId, "AgentId"},
-    {IEEE802IdSubtype::LocalAssign, "LocalAssign"},
-    {IEEE802IdSubtype::NotTransmitted, "NotTransmitted"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(SFPType, {
-    {SFPType::Invalid, "Invalid"},
-    {SFPType::SFP, "SFP"},
-    {SFPType::SFPPlus, "SFPPlus"},
-    {SFPType::SFP28, "SFP28"},
-    {SFPType::cSFP, "cSFP"},
-    {SFPType::SFPDD, "SFPDD"},
-    {SFPType::QSFP, "QSFP"},
-    {SFPType::QSFPPlus, "QSFPPlus"},
-    {SFPType::QSFP14, "QSFP14"},
-    {SFPType::QSFP28, "QSFP28"},
-    {SFPType::QSFP56, "QSFP56"},
-    {SFPType::MiniSASHD, "MiniSASHD"},
-    {SFPType::QSFPDD, "QSFPDD"},
-    {SFPType::OSFP, "OSFP"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(MediumType, {
-    {MediumType::Invalid, "Invalid"},
-    {MediumType::Copper, "Copper"},
-    {MediumType::FiberOptic, "FiberOptic"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(FiberConnectionType, {
-    {FiberConnectionType::Invalid, "Invalid"},
-    {FiberConnectionType::SingleMode, "SingleMode"},
-    {FiberConnectionType::MultiMode, "MultiMode"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(LLDPSystemCapabilities, {
-    {LLDPSystemCapabilities::Invalid, "Invalid"},
-    {LLDPSystemCapabilities::None, "None"},
-    {LLDPSystemCapabilities::Bridge, "Bridge"},
-    {LLDPSystemCapabilities::DOCSISCableDevice, "DOCSISCableDevice"},
-    {LLDPSystemCapabilities::Other, "Other"},
-    {LLDPSystemCapabilities::Repeater, "Repeater"},
-    {LLDPSystemCapabilities::Router, "Router"},
-    {LLDPSystemCapabilities::Station, "Station"},
-    {LLDPSystemCapabilities::Telephone, "Telephone"},
-    {LLDPSystemCapabilities::WLANAccessPoint, "WLANAccessPoint"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(CurrentPortConfigurationState, {
-    {CurrentPortConfigurationState::Invalid, "Invalid"},
-    {CurrentPortConfigurationState::Disabled, "Disabled"},
-    {CurrentPortConfigurationState::BindInProgress, "BindInProgress"},
-    {CurrentPortConfigurationState::UnbindInProgress, "UnbindInProgress"},
-    {CurrentPortConfigurationState::DSP, "DSP"},
-    {CurrentPortConfigurationState::USP, "USP"},
-    {CurrentPortConfigurationState::Reserved, "Reserved"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(ConnectedDeviceMode, {
-    {ConnectedDeviceMode::Invalid, "Invalid"},
-    {ConnectedDeviceMode::Disconnected, "Disconnected"},
-    {ConnectedDeviceMode::RCD, "RCD"},
-    {ConnectedDeviceMode::CXL68BFlitAndVH, "CXL68BFlitAndVH"},
-    {ConnectedDeviceMode::Standard256BFlit, "Standard256BFlit"},
-    {ConnectedDeviceMode::CXLLatencyOptimized256BFlit, "CXLLatencyOptimized256BFlit"},
-    {ConnectedDeviceMode::PBR, "PBR"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(ConnectedDeviceType, {
-    {ConnectedDeviceType::Invalid, "Invalid"},
-    {ConnectedDeviceType::None, "None"},
-    {ConnectedDeviceType::PCIeDevice, "PCIeDevice"},
-    {ConnectedDeviceType::Type1, "Type1"},
-    {ConnectedDeviceType::Type2, "Type2"},
-    {ConnectedDeviceType::Type3SLD, "Type3SLD"},
-    {ConnectedDeviceType::Type3MLD, "Type3MLD"},
-});
+REDFISH_ENUM_TABLE(PortType,
+    "Invalid",
+    "UpstreamPort",
+    "DownstreamPort",
+    "InterswitchPort",
+    "ManagementPort",
+    "BidirectionalPort",
+    "UnconfiguredPort");
+
+REDFISH_ENUM_TABLE(PortMedium,
+    "Invalid",
+    "Electrical",
+    "Optical");
+
+REDFISH_ENUM_TABLE(LinkState,
+    "Invalid",
+    "Enabled",
+    "Disabled");
+
+REDFISH_ENUM_TABLE(LinkStatus,
+    "Invalid",
+    "LinkUp",
+    "Starting",
+    "Training",
+    "LinkDown",
+    "NoLink");
+
+REDFISH_ENUM_TABLE(LinkNetworkTechnology,
+    "Invalid",
+    "Ethernet",
+    "InfiniBand",
+    "FibreChannel",
+    "GenZ",
+    "PCIe");
+
+REDFISH_ENUM_TABLE(PortConnectionType,
+    "Invalid",
+    "NotConnected",
+    "NPort",
+    "PointToPoint",
+    "PrivateLoop",
+    "PublicLoop",
+    "Generic",
+    "ExtenderFabric",
+    "FPort",
+    "EPort",
+    "TEPort",
+    "NPPort",
+    "GPort",
+    "NLPort",
+    "FLPort",
+    "EXPort",
+    "UPort",
+    "DPort");
+
+REDFISH_ENUM_TABLE(SupportedEthernetCapabilities,
+    "Invalid",
+    "WakeOnLAN",
+    "EEE");
+
+REDFISH_ENUM_TABLE(FlowControl,
+    "Invalid",
+    "None",
+    "TX",
+    "RX",
+    "TX_RX");
+
+REDFISH_ENUM_TABLE(IEEE802IdSubtype,
+    "Invalid",
+    "ChassisComp",
+    "IfAlias",
+    "PortComp",
+    "MacAddr",
+    "NetworkAddr",
+    "IfName",
+    "AgentId",
+    "LocalAssign",
+    "NotTransmitted");
+
+REDFISH_ENUM_TABLE(SFPType,
+    "Invalid",
+    "SFP",
+    "SFPPlus",
+    "SFP28",
+    "cSFP",
+    "SFPDD",
+    "QSFP",
+    "QSFPPlus",
+    "QSFP14",
+    "QSFP28",
+    "QSFP56",
+    "MiniSASHD",
+    "QSFPDD",
+    "OSFP");
+
+REDFISH_ENUM_TABLE(MediumType,
+    "Invalid",
+    "Copper",
+    "FiberOptic");
+
+REDFISH_ENUM_TABLE(FiberConnectionType,
+    "Invalid",
+    "SingleMode",
+    "MultiMode");
+
+REDFISH_ENUM_TABLE(LLDPSystemCapabilities,
+    "Invalid",
+    "None",
+    "Bridge",
+    "DOCSISCableDevice",
+    "Other",
+    "Repeater",
+    "Router",
+    "Station",
+    "Telephone",
+    "WLANAccessPoint");
+
+REDFISH_ENUM_TABLE(CurrentPortConfigurationState,
+    "Invalid",
+    "Disabled",
+    "BindInProgress",
+    "UnbindInProgress",
+    "DSP",
+    "USP",
+    "Reserved");
+
+REDFISH_ENUM_TABLE(ConnectedDeviceMode,
+    "Invalid",
+    "Disconnected",
+    "RCD",
+    "CXL68BFlitAndVH",
+    "Standard256BFlit",
+    "CXLLatencyOptimized256BFlit",
+    "PBR");
+
+REDFISH_ENUM_TABLE(ConnectedDeviceType,
+    "Invalid",
+    "None",
+    "PCIeDevice",
+    "Type1",
+    "Type2",
+    "Type3SLD",
+    "Type3MLD");
 
 }
 // clang-format on
@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace power_distribution
@@ -24,24 +26,22 @@ enum class TransferSensitivityType{
     Low,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(PowerEquipmentType, {
-    {PowerEquipmentType::Invalid, "Invalid"},
-    {PowerEquipmentType::RackPDU, "RackPDU"},
-    {PowerEquipmentType::FloorPDU, "FloorPDU"},
-    {PowerEquipmentType::ManualTransferSwitch, "ManualTransferSwitch"},
-    {PowerEquipmentType::AutomaticTransferSwitch, "AutomaticTransferSwitch"},
-    {PowerEquipmentType::Switchgear, "Switchgear"},
-    {PowerEquipmentType::PowerShelf, "PowerShelf"},
-    {PowerEquipmentType::Bus, "Bus"},
-    {PowerEquipmentType::BatteryShelf, "BatteryShelf"},
-});
+REDFISH_ENUM_TABLE(PowerEquipmentType,
+    "Invalid",
+    "RackPDU",
+    "FloorPDU",
+    "ManualTransferSwitch",
+    "AutomaticTransferSwitch",
+    "Switchgear",
+    "PowerShelf",
+    "Bus",
+    "BatteryShelf");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(TransferSensitivityType, {
-    {TransferSensitivityType::Invalid, "Invalid"},
-    {TransferSensitivityType::High, "High"},
-    {TransferSensitivityType::Medium, "Medium"},
-    {TransferSensitivityType::Low, "Low"},
-});
+REDFISH_ENUM_TABLE(TransferSensitivityType,
+    "Invalid",
+    "High",
+    "Medium",
+    "Low");
 
 }
 // clang-format on
@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace power_supply
@@ -20,20 +22,18 @@ enum class LineStatus{
     OutOfRange,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(PowerSupplyType, {
-    {PowerSupplyType::Invalid, "Invalid"},
-    {PowerSupplyType::AC, "AC"},
-    {PowerSupplyType::DC, "DC"},
-    {PowerSupplyType::ACorDC, "ACorDC"},
-    {PowerSupplyType::DCRegulator, "DCRegulator"},
-});
+REDFISH_ENUM_TABLE(PowerSupplyType,
+    "Invalid",
+    "AC",
+    "DC",
+    "ACorDC",
+    "DCRegulator");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(LineStatus, {
-    {LineStatus::Invalid, "Invalid"},
-    {LineStatus::Normal, "Normal"},
-    {LineStatus::LossOfInput, "LossOfInput"},
-    {LineStatus::OutOfRange, "OutOfRange"},
-});
+REDFISH_ENUM_TABLE(LineStatus,
+    "Invalid",
+    "Normal",
+    "LossOfInput",
+    "OutOfRange");
 
 }
 // clang-format on
@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace privileges
@@ -20,20 +22,19 @@ enum class PrivilegeType{
     OperateStorageBackup,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(PrivilegeType, {
-    {PrivilegeType::Invalid, "Invalid"},
-    {PrivilegeType::Login, "Login"},
-    {PrivilegeType::ConfigureManager, "ConfigureManager"},
-    {PrivilegeType::ConfigureUsers, "ConfigureUsers"},
-    {PrivilegeType::ConfigureSelf, "ConfigureSelf"},
-    {PrivilegeType::ConfigureComponents, "ConfigureComponents"},
-    {PrivilegeType::NoAuth, "NoAuth"},
-    {PrivilegeType::ConfigureCompositionInfrastructure, "ConfigureCompositionInfrastructure"},
-    {PrivilegeType::AdministrateSystems, "AdministrateSystems"},
-    {PrivilegeType::OperateSystems, "OperateSystems"},
-    {PrivilegeType::AdministrateStorage, "AdministrateStorage"},
-    {PrivilegeType::OperateStorageBackup, "OperateStorageBackup"},
-});
+REDFISH_ENUM_TABLE(PrivilegeType,
+    "Invalid",
+    "Login",
+    "ConfigureManager",
+    "ConfigureUsers",
+    "ConfigureSelf",
+    "ConfigureComponents",
+    "NoAuth",
+    "ConfigureCompositionInfrastructure",
+    "AdministrateSystems",
+    "OperateSystems",
+    "AdministrateStorage",
+    "OperateStorageBackup");
 
 }
 // clang-format on
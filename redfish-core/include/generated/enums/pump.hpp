@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace pump
@@ -11,11 +13,10 @@ enum class PumpType{
     Compressor,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(PumpType, {
-    {PumpType::Invalid, "Invalid"},
-    {PumpType::Liquid, "Liquid"},
-    {PumpType::Compressor, "Compressor"},
-});
+REDFISH_ENUM_TABLE(PumpType,
+    "Invalid",
+    "Liquid",
+    "Compressor");
 
 }
 // clang-format on
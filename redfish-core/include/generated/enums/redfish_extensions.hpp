@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace redfish_extensions
@@ -20,20 +22,18 @@ enum class RevisionKind{
     Deprecated,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(ReleaseStatusType, {
-    {ReleaseStatusType::Invalid, "Invalid"},
-    {ReleaseStatusType::Standard, "Standard"},
-    {ReleaseStatusType::Informational, "Informational"},
-    {ReleaseStatusType::WorkInProgress, "WorkInProgress"},
-    {ReleaseStatusType::InDevelopment, "InDevelopment"},
-});
+REDFISH_ENUM_TABLE(ReleaseStatusType,
+    "Invalid",
+    "Standard",
+    "Informational",
+    "WorkInProgress",
+    "InDevelopment");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(RevisionKind, {
-    {RevisionKind::Invalid, "Invalid"},
-    {RevisionKind::Added, "Added"},
-    {RevisionKind::Modified, "Modified"},
-    {RevisionKind::Deprecated, "Deprecated"},
-});
+REDFISH_ENUM_TABLE(RevisionKind,
+    "Invalid",
+    "Added",
+    "Modified",
+    "Deprecated");
 
 }
 // clang-format on
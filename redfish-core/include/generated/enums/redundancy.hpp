@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace redundancy
@@ -14,14 +16,13 @@ enum class RedundancyType{
     NotRedundant,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(RedundancyType, {
-    {RedundancyType::Invalid, "Invalid"},
-    {RedundancyType::Failover, "Failover"},
-    {RedundancyType::NPlusM, "NPlusM"},
-    {RedundancyType::Sharing, "Sharing"},
-    {RedundancyType::Sparing, "Sparing"},
-    {RedundancyType::NotRedundant, "NotRedundant"},
-});
+REDFISH_ENUM_TABLE(RedundancyType,
+    "Invalid",
+    "Failover",
+    "NPlusM",
+    "Sharing",
+    "Sparing",
+    "NotRedundant");
 
 }
 // clang-format on
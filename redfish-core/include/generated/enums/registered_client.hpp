@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace registered_client
@@ -11,11 +13,10 @@ enum class ClientType{
     Configure,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(ClientType, {
-    {ClientType::Invalid, "Invalid"},
-    {ClientType::Monitor, "Monitor"},
-    {ClientType::Configure, "Configure"},
-});
+REDFISH_ENUM_TABLE(ClientType,
+    "Invalid",
+    "Monitor",
+    "Configure");
 
 }
 // clang-format on
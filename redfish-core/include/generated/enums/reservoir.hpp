@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace reservoir
@@ -13,13 +15,12 @@ enum class ReservoirType{
     Immersion,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(ReservoirType, {
-    {ReservoirType::Invalid, "Invalid"},
-    {ReservoirType::Reserve, "Reserve"},
-    {ReservoirType::Overflow, "Overflow"},
-    {ReservoirType::Inline, "Inline"},
-    {ReservoirType::Immersion, "Immersion"},
-});
+REDFISH_ENUM_TABLE(ReservoirType,
+    "Invalid",
+    "Reserve",
+    "Overflow",
+    "Inline",
+    "Immersion");
 
 }
 // clang-format on
@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace resource
@@ -111,111 +113,101 @@ enum class Orientation{
     RightToLeft,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(State, {
-    {State::Invalid, "Invalid"},
-    {State::Enabled, "Enabled"},
-    {State::Disabled, "Disabled"},
-    {State::StandbyOffline, "StandbyOffline"},
-    {State::StandbySpare, "StandbySpare"},
-    {State::InTest, "InTest"},
-    {State::Starting, "Starting"},
-    {State::Absent, "Absent"},
-    {State::UnavailableOffline, "UnavailableOffline"},
-    {State::Deferring, "Deferring"},
-    {State::Quiesced, "Quiesced"},
-    {State::Updating, "Updating"},
-    {State::Qualified, "Qualified"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(Health, {
-    {Health::Invalid, "Invalid"},
-    {Health::OK, "OK"},
-    {Health::Warning, "Warning"},
-    {Health::Critical, "Critical"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(ResetType, {
-    {ResetType::Invalid, "Invalid"},
-    {ResetType::On, "On"},
-    {ResetType::ForceOff, "ForceOff"},
-    {ResetType::GracefulShutdown, "GracefulShutdown"},
-    {ResetType::GracefulRestart, "GracefulRestart"},
-    {ResetType::ForceRestart, "ForceRestart"},
-    {ResetType::Nmi, "Nmi"},
-    {ResetType::ForceOn, "ForceOn"},
-    {ResetType::PushPowerButton, "PushPowerButton"},
-    {ResetType::PowerCycle, "PowerCycle"},
-    {ResetType::Suspend, "Suspend"},
-    {ResetType::Pause, "Pause"},
-    {ResetType::Resume, "Resume"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(IndicatorLED, {
-    {IndicatorLED::Invalid, "Invalid"},
-    {IndicatorLED::Lit, "Lit"},
-    {IndicatorLED::Blinking, "Blinking"},
-    {IndicatorLED::Off, "Off"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(PowerState, {
-    {PowerState::Invalid, "Invalid"},
-    {PowerState::On, "On"},
-    {PowerState::Off, "Off"},
-    {PowerState::PoweringOn, "PoweringOn"},
-    {PowerState::PoweringOff, "PoweringOff"},
-    {PowerState::Paused, "Paused"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(DurableNameFormat, {
-    {DurableNameFormat::Invalid, "Invalid"},
-    {DurableNameFormat::NAA, "NAA"},
-    {DurableNameFormat::iQN, "iQN"},
-    {DurableNameFormat::FC_WWN, "FC_WWN"},
-    {DurableNameFormat::UUID, "UUID"},
-    {DurableNameFormat::EUI, "EUI"},
-    {DurableNameFormat::NQN, "NQN"},
-    {DurableNameFormat::NSID, "NSID"},
-    {DurableNameFormat::NGUID, "NGUID"},
-    {DurableNameFormat::MACAddress, "MACAddress"},
-    {DurableNameFormat::GCXLID, "GCXLID"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(RackUnits, {
-    {RackUnits::Invalid, "Invalid"},
-    {RackUnits::OpenU, "OpenU"},
-    {RackUnits::EIA_310, "EIA_310"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(LocationType, {
-    {LocationType::Invalid, "Invalid"},
-    {LocationType::Slot, "Slot"},
-    {LocationType::Bay, "Bay"},
-    {LocationType::Connector, "Connector"},
-    {LocationType::Socket, "Socket"},
-    {LocationType::Backplane, "Backplane"},
-    {LocationType::Embedded, "Embedded"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(Reference, {
-    {Reference::Invalid, "Invalid"},
-    {Reference::Top, "Top"},
-    {Reference::Bottom, "Bottom"},
-    {Reference::Front, "Front"},
-    {Reference::Rear, "Rear"},
-    {Reference::Left, "Left"},
-    {Reference::Right, "Right"},
-    {Reference::Middle, "Middle"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(Orientation, {
-    {Orientation::Invalid, "Invalid"},
-    {Orientation::FrontToBack, "FrontToBack"},
-    {Orientation::BackToFront, "BackToFront"},
-    {Orientation::TopToBottom, "TopToBottom"},
-    {Orientation::BottomToTop, "BottomToTop"},
-    {Orientation::LeftToRight, "LeftToRight"},
-    {Orientation::RightToLeft, "RightToLeft"},
-});
+REDFISH_ENUM_TABLE(State,
+    "Invalid",
+    "Enabled",
+    "Disabled",
+    "StandbyOffline",
+    "StandbySpare",
+    "InTest",
+    "Starting",
+    "Absent",
+    "UnavailableOffline",
+    "Deferring",
+    "Quiesced",
+    "Updating",
+    "Qualified");
+
+REDFISH_ENUM_TABLE(Health,
+    "Invalid",
+    "OK",
+    "Warning",
+    "Critical");
+
+REDFISH_ENUM_TABLE(ResetType,
+    "Invalid",
+    "On",
+    "ForceOff",
+    "GracefulShutdown",
+    "GracefulRestart",
+    "ForceRestart",
+    "Nmi",
+    "ForceOn",
+    "PushPowerButton",
+    "PowerCycle",
+    "Suspend",
+    "Pause",
+    "Resume");
+
+REDFISH_ENUM_TABLE(IndicatorLED,
+    "Invalid",
+    "Lit",
+    "Blinking",
+    "Off");
+
+REDFISH_ENUM_TABLE(PowerState,
+    "Invalid",
+    "On",
+    "Off",
+    "PoweringOn",
+    "PoweringOff",
+    "Paused");
+
+REDFISH_ENUM_TABLE(DurableNameFormat,
+    "Invalid",
+    "NAA",
+    "iQN",
+    "FC_WWN",
+    "UUID",
+    "EUI",
+    "NQN",
+    "NSID",
+    "NGUID",
+    "MACAddress",
+    "GCXLID");
+
+REDFISH_ENUM_TABLE(RackUnits,
+    "Invalid",
+    "OpenU",
+    "EIA_310");
+
+REDFISH_ENUM_TABLE(LocationType,
+    "Invalid",
+    "Slot",
+    "Bay",
+    "Connector",
+    "Socket",
+    "Backplane",
+    "Embedded");
+
+REDFISH_ENUM_TABLE(Reference,
+    "Invalid",
+    "Top",
+    "Bottom",
+    "Front",
+    "Rear",
+    "Left",
+    "Right",
+    "Middle");
+
+REDFISH_ENUM_TABLE(Orientation,
+    "Invalid",
+    "FrontToBack",
+    "BackToFront",
+    "TopToBottom",
+    "BottomToTop",
+    "LeftToRight",
+    "RightToLeft");
 
 }
 // clang-format on
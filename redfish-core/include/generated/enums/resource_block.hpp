@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace resource_block
@@ -34,34 +36,31 @@ enum class PoolType{
     Unassigned,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(ResourceBlockType, {
-    {ResourceBlockType::Invalid, "Invalid"},
-    {ResourceBlockType::Compute, "Compute"},
-    {ResourceBlockType::Processor, "Processor"},
-    {ResourceBlockType::Memory, "Memory"},
-    {ResourceBlockType::Network, "Network"},
-    {ResourceBlockType::Storage, "Storage"},
-    {ResourceBlockType::ComputerSystem, "ComputerSystem"},
-    {ResourceBlockType::Expansion, "Expansion"},
-    {ResourceBlockType::IndependentResource, "IndependentResource"},
-});
+REDFISH_ENUM_TABLE(ResourceBlockType,
+    "Invalid",
+    "Compute",
+    "Processor",
+    "Memory",
+    "Network",
+    "Storage",
+    "ComputerSystem",
+    "Expansion",
+    "IndependentResource");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(CompositionState, {
-    {CompositionState::Invalid, "Invalid"},
-    {CompositionState::Composing, "Composing"},
-    {CompositionState::ComposedAndAvailable, "ComposedAndAvailable"},
-    {CompositionState::Composed, "Composed"},
-    {CompositionState::Unused, "Unused"},
-    {CompositionState::Failed, "Failed"},
-    {CompositionState::Unavailable, "Unavailable"},
-});
+REDFISH_ENUM_TABLE(CompositionState,
+    "Invalid",
+    "Composing",
+    "ComposedAndAvailable",
+    "Composed",
+    "Unused",
+    "Failed",
+    "Unavailable");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(PoolType, {
-    {PoolType::Invalid, "Invalid"},
-    {PoolType::Free, "Free"},
-    {PoolType::Active, "Active"},
-    {PoolType::Unassigned, "Unassigned"},
-});
+REDFISH_ENUM_TABLE(PoolType,
+    "Invalid",
+    "Free",
+    "Active",
+    "Unassigned");
 
 }
 // clang-format on
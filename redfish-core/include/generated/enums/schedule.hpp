@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace schedule
@@ -34,34 +36,32 @@ enum class MonthOfYear{
     Every,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(DayOfWeek, {
-    {DayOfWeek::Invalid, "Invalid"},
-    {DayOfWeek::Monday, "Monday"},
-    {DayOfWeek::Tuesday, "Tuesday"},
-    {DayOfWeek::Wednesday, "Wednesday"},
-    {DayOfWeek::Thursday, "Thursday"},
-    {DayOfWeek::Friday, "Friday"},
-    {DayOfWeek::Saturday, "Saturday"},
-    {DayOfWeek::Sunday, "Sunday"},
-    {DayOfWeek::Every, "Every"},
-});
+REDFISH_ENUM_TABLE(DayOfWeek,
+    "Invalid",
+    "Monday",
+    "Tuesday",
+    "Wednesday",
+    "Thursday",
+    "Friday",
+    "Saturday",
+    "Sunday",
+    "Every");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(MonthOfYear, {
-    {MonthOfYear::Invalid, "Invalid"},
-    {MonthOfYear::January, "January"},
-    {MonthOfYear::February, "February"},
-    {MonthOfYear::March, "March"},
-    {MonthOfYear::April, "April"},
-    {MonthOfYear::May, "May"},
-    {MonthOfYear::June, "June"},
-    {MonthOfYear::July, "July"},
-    {MonthOfYear::August, "August"},
-    {MonthOfYear::September, "September"},
-    {MonthOfYear::October, "October"},
-    {MonthOfYear::November, "November"},
-    {MonthOfYear::December, "December"},
-    {MonthOfYear::Every, "Every"},
-});
+REDFISH_ENUM_TABLE(MonthOfYear,
+    "Invalid",
+    "January",
+    "February",
+    "March",
+    "April",
+    "May",
+    "June",
+    "July",
+    "August",
+    "September",
+    "October",
+    "November",
+    "December",
+    "Every");
 
 }
 // clang-format on
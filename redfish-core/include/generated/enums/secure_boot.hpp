@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace secure_boot
@@ -26,26 +28,23 @@ enum class ResetKeysType{
     DeletePK,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(SecureBootCurrentBootType, {
-    {SecureBootCurrentBootType::Invalid, "Invalid"},
-    {SecureBootCurrentBootType::Enabled, "Enabled"},
-    {SecureBootCurrentBootType::Disabled, "Disabled"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(SecureBootModeType, {
-    {SecureBootModeType::Invalid, "Invalid"},
-    {SecureBootModeType::SetupMode, "SetupMode"},
-    {SecureBootModeType::UserMode, "UserMode"},
-    {SecureBootModeType::AuditMode, "AuditMode"},
-    {SecureBootModeType::DeployedMode, "DeployedMode"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(ResetKeysType, {
-    {ResetKeysType::Invalid, "Invalid"},
-    {ResetKeysType::ResetAllKeysToDefault, "ResetAllKeysToDefault"},
-    {ResetKeysType::DeleteAllKeys, "DeleteAllKeys"},
-    {ResetKeysType::DeletePK, "DeletePK"},
-});
+REDFISH_ENUM_TABLE(SecureBootCurrentBootType,
+    "Invalid",
+    "Enabled",
+    "Disabled");
+
+REDFISH_ENUM_TABLE(SecureBootModeType,
+    "Invalid",
+    "SetupMode",
+    "UserMode",
+    "AuditMode",
+    "DeployedMode");
+
+REDFISH_ENUM_TABLE(ResetKeysType,
+    "Invalid",
+    "ResetAllKeysToDefault",
+    "DeleteAllKeys",
+    "DeletePK");
 
 }
 // clang-format on
@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace secure_boot_database
@@ -11,11 +13,10 @@ enum class ResetKeysType{
     DeleteAllKeys,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(ResetKeysType, {
-    {ResetKeysType::Invalid, "Invalid"},
-    {ResetKeysType::ResetAllKeysToDefault, "ResetAllKeysToDefault"},
-    {ResetKeysType::DeleteAllKeys, "DeleteAllKeys"},
-});
+REDFISH_ENUM_TABLE(ResetKeysType,
+    "Invalid",
+    "ResetAllKeysToDefault",
+    "DeleteAllKeys");
 
 }
 // clang-format on
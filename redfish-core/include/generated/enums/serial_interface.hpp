@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace serial_interface
@@ -34,34 +36,30 @@ enum class PinOut{
     Digi,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(SignalType, {
-    {SignalType::Invalid, "Invalid"},
-    {SignalType::Rs232, "Rs232"},
-    {SignalType::Rs485, "Rs485"},
-});
+REDFISH_ENUM_TABLE(SignalType,
+    "Invalid",
+    "Rs232",
+    "Rs485");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(Parity, {
-    {Parity::Invalid, "Invalid"},
-    {Parity::None, "None"},
-    {Parity::Even, "Even"},
-    {Parity::Odd, "Odd"},
-    {Parity::Mark, "Mark"},
-    {Parity::Space, "Space"},
-});
+REDFISH_ENUM_TABLE(Parity,
+    "Invalid",
+    "None",
+    "Even",
+    "Odd",
+    "Mark",
+    "Space");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(FlowControl, {
-    {FlowControl::Invalid, "Invalid"},
-    {FlowControl::None, "None"},
-    {FlowControl::Software, "Software"},
-    {FlowControl::Hardware, "Hardware"},
-});
+REDFISH_ENUM_TABLE(FlowControl,
+    "Invalid",
+    "None",
+    "Software",
+    "Hardware");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(PinOut, {
-    {PinOut::Invalid, "Invalid"},
-    {PinOut::Cisco, "Cisco"},
-    {PinOut::Cyclades, "Cyclades"},
-    {PinOut::Digi, "Digi"},
-});
+REDFISH_ENUM_TABLE(PinOut,
+    "Invalid",
+    "Cisco",
+    "Cyclades",
+    "Digi");
 
 }
 // clang-format on
@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace session
@@ -18,18 +20,17 @@ enum class SessionTypes{
     OutboundConnection,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(SessionTypes, {
-    {SessionTypes::Invalid, "Invalid"},
-    {SessionTypes::HostConsole, "HostConsole"},
-    {SessionTypes::ManagerConsole, "ManagerConsole"},
-    {SessionTypes::IPMI, "IPMI"},
-    {SessionTypes::KVMIP, "KVMIP"},
-    {SessionTypes::OEM, "OEM"},
-    {SessionTypes::Redfish, "Redfish"},
-    {SessionTypes::VirtualMedia, "VirtualMedia"},
-    {SessionTypes::WebUI, "WebUI"},
-    {SessionTypes::OutboundConnection, "OutboundConnection"},
-});
+REDFISH_ENUM_TABLE(SessionTypes,
+    "Invalid",
+    "HostConsole",
+    "ManagerConsole",
+    "IPMI",
+    "KVMIP",
+    "OEM",
+    "Redfish",
+    "VirtualMedia",
+    "WebUI",
+    "OutboundConnection");
 
 }
 // clang-format on
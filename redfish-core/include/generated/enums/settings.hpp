@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace settings
@@ -22,22 +24,20 @@ enum class ApplyTime{
     InMaintenanceWindowOnReset,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(OperationApplyTime, {
-    {OperationApplyTime::Invalid, "Invalid"},
-    {OperationApplyTime::Immediate, "Immediate"},
-    {OperationApplyTime::OnReset, "OnReset"},
-    {OperationApplyTime::AtMaintenanceWindowStart, "AtMaintenanceWindowStart"},
-    {OperationApplyTime::InMaintenanceWindowOnReset, "InMaintenanceWindowOnReset"},
-    {OperationApplyTime::OnStartUpdateRequest, "OnStartUpdateRequest"},
-});
+REDFISH_ENUM_TABLE(OperationApplyTime,
+    "Invalid",
+    "Immediate",
+    "OnReset",
+    "AtMaintenanceWindowStart",
+    "InMaintenanceWindowOnReset",
+    "OnStartUpdateRequest");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(ApplyTime, {
-    {ApplyTime::Invalid, "Invalid"},
-    {ApplyTime::Immediate, "Immediate"},
-    {ApplyTime::OnReset, "OnReset"},
-    {ApplyTime::AtMaintenanceWindowStart, "AtMaintenanceWindowStart"},
-    {ApplyTime::InMaintenanceWindowOnReset, "InMaintenanceWindowOnReset"},
-});
+REDFISH_ENUM_TABLE(ApplyTime,
+    "Invalid",
+    "Immediate",
+    "OnReset",
+    "AtMaintenanceWindowStart",
+    "InMaintenanceWindowOnReset");
 
 }
 // clang-format on
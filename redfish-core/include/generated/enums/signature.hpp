@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace signature
@@ -10,10 +12,9 @@ enum class SignatureTypeRegistry{
     UEFI,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(SignatureTypeRegistry, {
-    {SignatureTypeRegistry::Invalid, "Invalid"},
-    {SignatureTypeRegistry::UEFI, "UEFI"},
-});
+REDFISH_ENUM_TABLE(SignatureTypeRegistry,
+    "Invalid",
+    "UEFI");
 
 }
 // clang-format on
@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace software_inventory
@@ -19,19 +21,17 @@ enum class ReleaseType{
     Other,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(VersionScheme, {
-    {VersionScheme::Invalid, "Invalid"},
-    {VersionScheme::SemVer, "SemVer"},
-    {VersionScheme::DotIntegerNotation, "DotIntegerNotation"},
-    {VersionScheme::OEM, "OEM"},
-});
+REDFISH_ENUM_TABLE(VersionScheme,
+    "Invalid",
+    "SemVer",
+    "DotIntegerNotation",
+    "OEM");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(ReleaseType, {
-    {ReleaseType::Invalid, "Invalid"},
-    {ReleaseType::Production, "Production"},
-    {ReleaseType::Prototype, "Prototype"},
-    {ReleaseType::Other, "Other"},
-});
+REDFISH_ENUM_TABLE(ReleaseType,
+    "Invalid",
+    "Production",
+    "Prototype",
+    "Other");
 
 }
 // clang-format on
@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace storage
@@ -33,33 +35,29 @@ enum class AutoVolumeCreate{
     RAID1,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(ResetToDefaultsType, {
-    {ResetToDefaultsType::Invalid, "Invalid"},
-    {ResetToDefaultsType::ResetAll, "ResetAll"},
-    {ResetToDefaultsType::PreserveVolumes, "PreserveVolumes"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(HotspareActivationPolicy, {
-    {HotspareActivationPolicy::Invalid, "Invalid"},
-    {HotspareActivationPolicy::OnDriveFailure, "OnDriveFailure"},
-    {HotspareActivationPolicy::OnDrivePredictedFailure, "OnDrivePredictedFailure"},
-    {HotspareActivationPolicy::OEM, "OEM"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(EncryptionMode, {
-    {EncryptionMode::Invalid, "Invalid"},
-    {EncryptionMode::Disabled, "Disabled"},
-    {EncryptionMode::UseExternalKey, "UseExternalKey"},
-    {EncryptionMode::UseLocalKey, "UseLocalKey"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(AutoVolumeCreate, {
-    {AutoVolumeCreate::Invalid, "Invalid"},
-    {AutoVolumeCreate::Disabled, "Disabled"},
-    {AutoVolumeCreate::NonRAID, "NonRAID"},
-    {AutoVolumeCreate::RAID0, "RAID0"},
-    {AutoVolumeCreate::RAID1, "RAID1"},
-});
+REDFISH_ENUM_TABLE(ResetToDefaultsType,
+    "Invalid",
+    "ResetAll",
+    "PreserveVolumes");
+
+REDFISH_ENUM_TABLE(HotspareActivationPolicy,
+    "Invalid",
+    "OnDriveFailure",
+    "OnDrivePredictedFailure",
+    "OEM");
+
+REDFISH_ENUM_TABLE(EncryptionMode,
+    "Invalid",
+    "Disabled",
+    "UseExternalKey",
+    "UseLocalKey");
+
+REDFISH_ENUM_TABLE(AutoVolumeCreate,
+    "Invalid",
+    "Disabled",
+    "NonRAID",
+    "RAID0",
+    "RAID1");
 
 }
 // clang-format on
@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace storage_controller
@@ -20,20 +22,18 @@ enum class ANAAccessState{
     PersistentLoss,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(NVMeControllerType, {
-    {NVMeControllerType::Invalid, "Invalid"},
-    {NVMeControllerType::Admin, "Admin"},
-    {NVMeControllerType::Discovery, "Discovery"},
-    {NVMeControllerType::IO, "IO"},
-});
+REDFISH_ENUM_TABLE(NVMeControllerType,
+    "Invalid",
+    "Admin",
+    "Discovery",
+    "IO");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(ANAAccessState, {
-    {ANAAccessState::Invalid, "Invalid"},
-    {ANAAccessState::Optimized, "Optimized"},
-    {ANAAccessState::NonOptimized, "NonOptimized"},
-    {ANAAccessState::Inaccessible, "Inaccessible"},
-    {ANAAccessState::PersistentLoss, "PersistentLoss"},
-});
+REDFISH_ENUM_TABLE(ANAAccessState,
+    "Invalid",
+    "Optimized",
+    "NonOptimized",
+    "Inaccessible",
+    "PersistentLoss");
 
 }
 // clang-format on
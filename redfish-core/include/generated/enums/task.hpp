@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace task
@@ -22,22 +24,21 @@ enum class TaskState{
     Cancelled,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(TaskState, {
-    {TaskState::Invalid, "Invalid"},
-    {TaskState::New, "New"},
-    {TaskState::Starting, "Starting"},
-    {TaskState::Running, "Running"},
-    {TaskState::Suspended, "Suspended"},
-    {TaskState::Interrupted, "Interrupted"},
-    {TaskState::Pending, "Pending"},
-    {TaskState::Stopping, "Stopping"},
-    {TaskState::Completed, "Completed"},
-    {TaskState::Killed, "Killed"},
-    {TaskState::Exception, "Exception"},
-    {TaskState::Service, "Service"},
-    {TaskState::Cancelling, "Cancelling"},
-    {TaskState::Cancelled, "Cancelled"},
-});
+REDFISH_ENUM_TABLE(TaskState,
+    "Invalid",
+    "New",
+    "Starting",
+    "Running",
+    "Suspended",
+    "Interrupted",
+    "Pending",
+    "Stopping",
+    "Completed",
+    "Killed",
+    "Exception",
+    "Service",
+    "Cancelling",
+    "Cancelled");
 
 }
 // clang-format on
@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace task_service
@@ -11,11 +13,10 @@ enum class OverWritePolicy{
     Oldest,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(OverWritePolicy, {
-    {OverWritePolicy::Invalid, "Invalid"},
-    {OverWritePolicy::Manual, "Manual"},
-    {OverWritePolicy::Oldest, "Oldest"},
-});
+REDFISH_ENUM_TABLE(OverWritePolicy,
+    "Invalid",
+    "Manual",
+    "Oldest");
 
 }
 // clang-format on
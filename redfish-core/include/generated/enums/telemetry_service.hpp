@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace telemetry_service
@@ -13,13 +15,12 @@ enum class CollectionFunction{
     Summation,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(CollectionFunction, {
-    {CollectionFunction::Invalid, "Invalid"},
-    {CollectionFunction::Average, "Average"},
-    {CollectionFunction::Maximum, "Maximum"},
-    {CollectionFunction::Minimum, "Minimum"},
-    {CollectionFunction::Summation, "Summation"},
-});
+REDFISH_ENUM_TABLE(CollectionFunction,
+    "Invalid",
+    "Average",
+    "Maximum",
+    "Minimum",
+    "Summation");
 
 }
 // clang-format on
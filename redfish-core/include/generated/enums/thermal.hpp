@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace thermal
@@ -11,11 +13,10 @@ enum class ReadingUnits{
     Percent,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(ReadingUnits, {
-    {ReadingUnits::Invalid, "Invalid"},
-    {ReadingUnits::RPM, "RPM"},
-    {ReadingUnits::Percent, "Percent"},
-});
+REDFISH_ENUM_TABLE(ReadingUnits,
+    "Invalid",
+    "RPM",
+    "Percent");
 
 }
 // clang-format on
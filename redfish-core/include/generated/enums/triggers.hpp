@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace triggers
@@ -38,38 +40,33 @@ enum class DirectionOfCrossingEnum{
     Decreasing,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(MetricTypeEnum, {
-    {MetricTypeEnum::Invalid, "Invalid"},
-    {MetricTypeEnum::Numeric, "Numeric"},
-    {MetricTypeEnum::Discrete, "Discrete"},
-});
+REDFISH_ENUM_TABLE(MetricTypeEnum,
+    "Invalid",
+    "Numeric",
+    "Discrete");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(TriggerActionEnum, {
-    {TriggerActionEnum::Invalid, "Invalid"},
-    {TriggerActionEnum::LogToLogService, "LogToLogService"},
-    {TriggerActionEnum::RedfishEvent, "RedfishEvent"},
-    {TriggerActionEnum::RedfishMetricReport, "RedfishMetricReport"},
-});
+REDFISH_ENUM_TABLE(TriggerActionEnum,
+    "Invalid",
+    "LogToLogService",
+    "RedfishEvent",
+    "RedfishMetricReport");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(DiscreteTriggerConditionEnum, {
-    {DiscreteTriggerConditionEnum::Invalid, "Invalid"},
-    {DiscreteTriggerConditionEnum::Specified, "Specified"},
-    {DiscreteTriggerConditionEnum::Changed, "Changed"},
-});
+REDFISH_ENUM_TABLE(DiscreteTriggerConditionEnum,
+    "Invalid",
+    "Specified",
+    "Changed");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(ThresholdActivation, {
-    {ThresholdActivation::Invalid, "Invalid"},
-    {ThresholdActivation::Increasing, "Increasing"},
-    {ThresholdActivation::Decreasing, "Decreasing"},
-    {ThresholdActivation::Either, "Either"},
-    {ThresholdActivation::Disabled, "Disabled"},
-});
+REDFISH_ENUM_TABLE(ThresholdActivation,
+    "Invalid",
+    "Increasing",
+    "Decreasing",
+    "Either",
+    "Disabled");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(DirectionOfCrossingEnum, {
-    {DirectionOfCrossingEnum::Invalid, "Invalid"},
-    {DirectionOfCrossingEnum::Increasing, "Increasing"},
-    {DirectionOfCrossingEnum::Decreasing, "Decreasing"},
-});
+REDFISH_ENUM_TABLE(DirectionOfCrossingEnum,
+    "Invalid",
+    "Increasing",
+    "Decreasing");
 
 }
 // clang-format on
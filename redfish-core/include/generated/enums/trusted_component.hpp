@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace trusted_component
@@ -11,11 +13,10 @@ enum class TrustedComponentType{
     Integrated,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(TrustedComponentType, {
-    {TrustedComponentType::Invalid, "Invalid"},
-    {TrustedComponentType::Discrete, "Discrete"},
-    {TrustedComponentType::Integrated, "Integrated"},
-});
+REDFISH_ENUM_TABLE(TrustedComponentType,
+    "Invalid",
+    "Discrete",
+    "Integrated");
 
 }
 // clang-format on
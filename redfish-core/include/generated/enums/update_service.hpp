@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace update_service
@@ -28,28 +30,26 @@ enum class ApplyTime{
     OnStartUpdateRequest,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(TransferProtocolType, {
-    {TransferProtocolType::Invalid, "Invalid"},
-    {TransferProtocolType::CIFS, "CIFS"},
-    {TransferProtocolType::FTP, "FTP"},
-    {TransferProtocolType::SFTP, "SFTP"},
-    {TransferProtocolType::HTTP, "HTTP"},
-    {TransferProtocolType::HTTPS, "HTTPS"},
-    {TransferProtocolType::NSF, "NSF"},
-    {TransferProtocolType::SCP, "SCP"},
-    {TransferProtocolType::TFTP, "TFTP"},
-    {TransferProtocolType::OEM, "OEM"},
-    {TransferProtocolType::NFS, "NFS"},
-});
+REDFISH_ENUM_TABLE(TransferProtocolType,
+    "Invalid",
+    "CIFS",
+    "FTP",
+    "SFTP",
+    "HTTP",
+    "HTTPS",
+    "NSF",
+    "SCP",
+    "TFTP",
+    "OEM",
+    "NFS");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(ApplyTime, {
-    {ApplyTime::Invalid, "Invalid"},
-    {ApplyTime::Immediate, "Immediate"},
-    {ApplyTime::OnReset, "OnReset"},
-    {ApplyTime::AtMaintenanceWindowStart, "AtMaintenanceWindowStart"},
-    {ApplyTime::InMaintenanceWindowOnReset, "InMaintenanceWindowOnReset"},
-    {ApplyTime::OnStartUpdateRequest, "OnStartUpdateRequest"},
-});
+REDFISH_ENUM_TABLE(ApplyTime,
+    "Invalid",
+    "Immediate",
+    "OnReset",
+    "AtMaintenanceWindowStart",
+    "InMaintenanceWindowOnReset",
+    "OnStartUpdateRequest");
 
 }
 // clang-format on
@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace virtual_media
@@ -49,49 +51,44 @@ enum class EjectPolicy{
     Persistent,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(MediaType, {
-    {MediaType::Invalid, "Invalid"},
-    {MediaType::CD, "CD"},
-    {MediaType::Floppy, "Floppy"},
-    {MediaType::USBStick, "USBStick"},
-    {MediaType::DVD, "DVD"},
-});
+REDFISH_ENUM_TABLE(MediaType,
+    "Invalid",
+    "CD",
+    "Floppy",
+    "USBStick",
+    "DVD");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(ConnectedVia, {
-    {ConnectedVia::Invalid, "Invalid"},
-    {ConnectedVia::NotConnected, "NotConnected"},
-    {ConnectedVia::URI, "URI"},
-    {ConnectedVia::Applet, "Applet"},
-    {ConnectedVia::Oem, "Oem"},
-});
+REDFISH_ENUM_TABLE(ConnectedVia,
+    "Invalid",
+    "NotConnected",
+    "URI",
+    "Applet",
+    "Oem");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(TransferProtocolType, {
-    {TransferProtocolType::Invalid, "Invalid"},
-    {TransferProtocolType::CIFS, "CIFS"},
-    {TransferProtocolType::FTP, "FTP"},
-    {TransferProtocolType::SFTP, "SFTP"},
-    {TransferProtocolType::HTTP, "HTTP"},
-    {TransferProtocolType::HTTPS, "HTTPS"},
-    {TransferProtocolType::NFS, "NFS"},
-    {TransferProtocolType::SCP, "SCP"},
-    {TransferProtocolType::TFTP, "TFTP"},
-    {TransferProtocolType::OEM, "OEM"},
-});
+REDFISH_ENUM_TABLE(TransferProtocolType,
+    "Invalid",
+    "CIFS",
+    "FTP",
+    "SFTP",
+    "HTTP",
+    "HTTPS",
+    "NFS",
+    "SCP",
+    "TFTP",
+    "OEM");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(TransferMethod, {
-    {TransferMethod::Invalid, "Invalid"},
-    {TransferMethod::Stream, "Stream"},
-    {TransferMethod::Upload, "Upload"},
-});
+REDFISH_ENUM_TABLE(TransferMethod,
+    "Invalid",
+    "Stream",
+    "Upload");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(EjectPolicy, {
-    {EjectPolicy::Invalid, "Invalid"},
-    {EjectPolicy::OnPowerOff, "OnPowerOff"},
-    {EjectPolicy::Session, "Session"},
-    {EjectPolicy::Timed, "Timed"},
-    {EjectPolicy::AfterUse, "AfterUse"},
-    {EjectPolicy::Persistent, "Persistent"},
-});
+REDFISH_ENUM_TABLE(EjectPolicy,
+    "Invalid",
+    "OnPowerOff",
+    "Session",
+    "Timed",
+    "AfterUse",
+    "Persistent");
 
 }
 // clang-format on
@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/enum_table.hpp"
+
 #include <nlohmann/json.hpp>
 
 namespace zone
@@ -21,21 +23,19 @@ enum class ZoneType{
     ZoneOfResourceBlocks,
 };
 
-NLOHMANN_JSON_SERIALIZE_ENUM(ExternalAccessibility, {
-    {ExternalAccessibility::Invalid, "Invalid"},
-    {ExternalAccessibility::GloballyAccessible, "GloballyAccessible"},
-    {ExternalAccessibility::NonZonedAccessible, "NonZonedAccessible"},
-    {ExternalAccessibility::ZoneOnly, "ZoneOnly"},
-    {ExternalAccessibility::NoInternalRouting, "NoInternalRouting"},
-});
+REDFISH_ENUM_TABLE(ExternalAccessibility,
+    "Invalid",
+    "GloballyAccessible",
+    "NonZonedAccessible",
+    "ZoneOnly",
+    "NoInternalRouting");
 
-NLOHMANN_JSON_SERIALIZE_ENUM(ZoneType, {
-    {ZoneType::Invalid, "Invalid"},
-    {ZoneType::Default, "Default"},
-    {ZoneType::ZoneOfEndpoints, "ZoneOfEndpoints"},
-    {ZoneType::ZoneOfZones, "ZoneOfZones"},
-    {ZoneType::ZoneOfResourceBlocks, "ZoneOfResourceBlocks"},
-});
+REDFISH_ENUM_TABLE(ZoneType,
+    "Invalid",
+    "Default",
+    "ZoneOfEndpoints",
+    "ZoneOfZones",
+    "ZoneOfResourceBlocks");
 
 }
 // clang-format on
@@ -1,17 +1,68 @@
 #pragma once
 
+#include "logging.hpp"
+
+#include <sys/stat.h>
 #include <zlib.h>
 
 #include <array>
+#include <cstdint>
+#include <cstring>
 #include <filesystem>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
+/**
+ * @brief What reading one whole file does to a GzFileReader, as if the
+ * reader had started out with no message or delimiter carried in.  Given
+ * this, the reader can account for the file without inflating it again.
+ */
+struct GzFileSummary
+{
+    // Entries the file ends
+    size_t count = 0;
+    // Of those, '\n's starting a chunk before the file ended any chunk on a
+    // delimiter.  These are the second half of a "\r\n" when the previous
+    // file ended on '\r', and aren't entries then.
+    size_t leadingNewlines = 0;
+    // Whether the file ends a non-empty entry, which takes up the message
+    // carried in from earlier files
+    bool hasEntry = false;
+    // The message and delimiter left once the file is read.  An empty
+    // delimiter leaves the one carried in as it is.
+    std::string lastMessage;
+    std::string lastDelimiter;
+    // Chunks without any delimiter are carried over depending on $skip and
+    // $top, so files with one must always be read
+    bool skippable = true;
+};
+
 class GzFileReader
 {
   public:
     bool gzGetLines(const std::string& filename, uint64_t skip, uint64_t top,
                     std::vector<std::string>& logEntries, size_t& logCount)
     {
+        if (!inflateFile(filename, buffer))
+        {
+            return false;
+        }
+        return parseLines(buffer, skip, top, logEntries, logCount);
+    }
+
+    /**
+     * @brief Inflates all of filename into out, reusing the capacity out
+     * already has.  Touches no reader state, so files can be inflated on
+     * several threads at once and parsed in order afterwards.
+     */
+    static bool inflateFile(const std::string& filename, std::string& out)
+    {
+        out.clear();
         gzFile logStream = gzopen(filename.c_str(), "r");
         if (logStream == nullptr)
         {
@@ -19,24 +70,91 @@ class GzFileReader
             return false;
         }
 
-        if (!readFile(logStream, skip, top, logEntries, logCount))
+        constexpr size_t readSize = 65536;
+        while (gzeof(logStream) != 1)
         {
-            gzclose(logStream);
-            return false;
+            size_t used = out.size();
+            out.resize(used + readSize);
+            int bytesRead = gzread(logStream, &out[used],
+                                   static_cast<unsigned int>(readSize));
+            // On errors, gzread() shall return a value less than 0.
+            if (bytesRead < 0)
+            {
+                printErrorMessage(logStream);
+                gzclose(logStream);
+                out.clear();
+                return false;
+            }
+            out.resize(used + static_cast<size_t>(bytesRead));
+            if (bytesRead == 0)
+            {
+                break;
+            }
         }
         gzclose(logStream);
         return true;
     }
 
+    /**
+     * @brief Splits the inflated contents of one file into entries, exactly
+     * as gzGetLines() would have read them from the file.
+     */
+    bool parseLines(std::string_view contents, uint64_t skip, uint64_t top,
+                    std::vector<std::string>& logEntries, size_t& logCount)
+    {
+        fileSummary = GzFileSummary();
+        // Files have always been parsed in chunks of this size, which decides
+        // how delimiters on the edge of a chunk are treated
+        constexpr size_t chunkSize = 1024;
+        for (size_t start = 0; start < contents.size(); start += chunkSize)
+        {
+            if (!hostLogEntryParser(contents.substr(start, chunkSize), skip,
+                                    top, logEntries, logCount))
+            {
+                BMCWEB_LOG_ERROR << "Error occurs during parsing host log.\n";
+                return false;
+            }
+        }
+        return true;
+    }
+
     std::string getLastMessage()
     {
         return lastMessage;
     }
 
+    // Summary of the file last read by gzGetLines()
+    const GzFileSummary& getFileSummary() const
+    {
+        return fileSummary;
+    }
+
+    // Accounts for a file in the same way as reading it would, except that
+    // none of its entries are returned.  Only valid for skippable files.
+    void skipFile(const GzFileSummary& summary, size_t& logCount)
+    {
+        logCount += summary.count;
+        if (lastDelimiter == "\r")
+        {
+            logCount -= summary.leadingNewlines;
+        }
+        if (summary.hasEntry || !summary.lastMessage.empty())
+        {
+            lastMessage = summary.lastMessage;
+        }
+        if (!summary.lastDelimiter.empty())
+        {
+            lastDelimiter = summary.lastDelimiter;
+        }
+    }
+
   private:
     std::string lastMessage;
     std::string lastDelimiter;
     size_t totalFilesSize = 0;
+    GzFileSummary fileSummary;
+    // Inflated contents of the file being read, reused from file to file
+    std::string buffer;
 
     static void printErrorMessage(gzFile logStream)
     {
@@ -48,35 +166,35 @@ class GzFileReader
                          << "Error Number: " << errNum;
     }
 
-    bool readFile(gzFile logStream, uint64_t skip, uint64_t top,
-                  std::vector<std::string>& logEntries, size_t& logCount)
+    // Position of the first '\n' or '\r' at or after from, or npos.  memchr
+    // is vectorized where find_first_of compares each character against
+    // both delimiters; the '\r' search stops at the '\n' found, so each
+    // byte is scanned at most twice.
+    static size_t findDelimiter(std::string_view bufferStr, size_t from)
     {
-        constexpr int bufferLimitSize = 1024;
-        do
+        if (from >= bufferStr.size())
         {
-            std::string bufferStr;
-            bufferStr.resize(bufferLimitSize);
-
-            int bytesRead = gzread(logStream, bufferStr.data(),
-                                   static_cast<unsigned int>(bufferStr.size()));
-            // On errors, gzread() shall return a value less than 0.
-            if (bytesRead < 0)
-            {
-                printErrorMessage(logStream);
-                return false;
-            }
-            bufferStr.resize(static_cast<size_t>(bytesRead));
-            if (!hostLogEntryParser(bufferStr, skip, top, logEntries, logCount))
-            {
-                BMCWEB_LOG_ERROR << "Error occurs during parsing host log.\n";
-                return false;
-            }
-        } while (gzeof(logStream) != 1);
-
-        return true;
+            return std::string_view::npos;
+        }
+        const char* begin = &bufferStr[from];
+        size_t length = bufferStr.size() - from;
+        const char* lf = static_cast<const char*>(
+            std::memchr(begin, '\n', length));
+        if (lf != nullptr)
+        {
+            length = static_cast<size_t>(lf - begin);
+        }
+        const char* cr = static_cast<const char*>(
+            std::memchr(begin, '\r', length));
+        const char* found = cr != nullptr ? cr : lf;
+        if (found == nullptr)
+        {
+            return std::string_view::npos;
+        }
+        return from + static_cast<size_t>(found - begin);
     }
 
-    bool hostLogEntryParser(const std::string& bufferStr, uint64_t skip,
+    bool hostLogEntryParser(std::string_view bufferStr, uint64_t skip,
                             uint64_t top, std::vector<std::string>& logEntries,
                             size_t& logCount)
     {
@@ -88,27 +206,33 @@ class GzFileReader
         // It may contain several log entry in one line, and
         // the end of each log entry will be '\r\n' or '\r'.
         // So we need to go through and split string by '\n' and '\r'
-        size_t pos = bufferStr.find_first_of("\n\r");
+        if (bufferStr.empty())
+        {
+            return true;
+        }
+        size_t pos = findDelimiter(bufferStr, 0);
         size_t initialPos = 0;
         std::string newLastMessage;
 
-        while (pos != std::string::npos)
+        while (pos != std::string_view::npos)
         {
-            std::string logEntry = bufferStr.substr(initialPos,
-                                                    pos - initialPos);
+            std::string_view logEntry = bufferStr.substr(initialPos,
+                                                         pos - initialPos);
             // Since there might be consecutive delimiters like "\r\n", we need
             // to filter empty strings.
             if (!logEntry.empty())
             {
                 logCount++;
-                if (!lastMessage.empty())
-                {
-                    logEntry.insert(0, lastMessage);
-                    lastMessage.clear();
-                }
+                fileSummary.count++;
+                fileSummary.hasEntry = true;
+                fileSummary.lastMessage.clear();
+                // Entries outside the page are only counted, so are never
+                // copied out of the buffer
                 if (logCount > skip && logCount <= (skip + top))
                 {
-                    totalFilesSize += logEntry.size();
+                    std::string entry = std::move(lastMessage);
+                    entry += logEntry;
+                    totalFilesSize += entry.size();
                     if (totalFilesSize > maxTotalFilesSize)
                     {
                         BMCWEB_LOG_ERROR
@@ -116,8 +240,9 @@ class GzFileReader
                             << maxTotalFilesSize;
                         return false;
                     }
-                    logEntries.push_back(logEntry);
+                    logEntries.emplace_back(std::move(entry));
                 }
+                lastMessage.clear();
             }
             else
             {
@@ -127,12 +252,26 @@ class GzFileReader
                 std::string delimiters;
                 if (pos > 0)
                 {
-                    delimiters = bufferStr.substr(pos - 1, 2);
+                    delimiters = std::string(bufferStr.substr(pos - 1, 2));
                 }
                 // Handle consecutive delimiter but spilt between two files.
                 if (pos == 0 && !(lastDelimiter.empty()))
                 {
-                    delimiters = lastDelimiter + bufferStr.substr(0, 1);
+                    delimiters = lastDelimiter + bufferStr[0];
+                }
+                // Without a delimiter carried in, a delimiter starting the
+                // file's chunks always ends an entry
+                if (pos == 0 && fileSummary.lastDelimiter.empty())
+                {
+                    fileSummary.count++;
+                    if (bufferStr[0] == '\n')
+                    {
+                        fileSummary.leadingNewlines++;
+                    }
+                }
+                else if (delimiters != "\r\n")
+                {
+                    fileSummary.count++;
                 }
                 if (delimiters != "\r\n")
                 {
@@ -152,23 +291,25 @@ class GzFileReader
                 }
             }
             initialPos = pos + 1;
-            pos = bufferStr.find_first_of("\n\r", initialPos);
+            pos = findDelimiter(bufferStr, initialPos);
         }
 
         // Store the last message
         if (initialPos < bufferStr.size())
         {
-            newLastMessage = bufferStr.substr(initialPos);
+            newLastMessage = std::string(bufferStr.substr(initialPos));
         }
         // If consecutive delimiter spilt by buffer or file, the last character
         // must be the delimiter.
         else if (initialPos == bufferStr.size())
         {
             lastDelimiter = std::string(1, bufferStr.back());
+            fileSummary.lastDelimiter = lastDelimiter;
         }
         // If file doesn't contain any "\r" or "\n", initialPos should be zero
         if (initialPos == 0)
         {
+            fileSummary.skippable = false;
             // Solved an edge case that the log doesn't in skip and top range,
             // but consecutive files don't contain a single delimiter, this
             // lastMessage becomes unnecessarily large. Since last message will
@@ -197,6 +338,7 @@ class GzFileReader
             if (!newLastMessage.empty())
             {
                 lastMessage = std::move(newLastMessage);
+                fileSummary.lastMessage = lastMessage;
             }
         }
         return true;
@@ -210,3 +352,87 @@ class GzFileReader
     GzFileReader(GzFileReader&&) = delete;
     GzFileReader& operator=(GzFileReader&&) = delete;
 };
+
+/**
+ * @brief GzFileSummary of each host logger file read so far.
+ *
+ * Files are tracked by inode, so a summary survives rotation renaming its
+ * file, and it is only used while the file keeps the size and modification
+ * time it had when read.  Files whose entries all lie outside the requested
+ * page are then accounted for without being inflated, so reading a page deep
+ * into the log only inflates the files that page comes from.
+ */
+class GzFileIndex
+{
+  public:
+    // A file and the version of its contents
+    struct FileId
+    {
+        dev_t device = 0;
+        ino_t inode = 0;
+        off_t size = 0;
+        int64_t modifiedNs = 0;
+
+        bool operator==(const FileId& other) const = default;
+    };
+
+    static GzFileIndex& getInstance()
+    {
+        static GzFileIndex index;
+        return index;
+    }
+
+    static std::optional<FileId> identify(const std::string& filename)
+    {
+        struct stat st
+        {};
+        if (stat(filename.c_str(), &st) != 0)
+        {
+            return std::nullopt;
+        }
+        return FileId{st.st_dev, st.st_ino, st.st_size,
+                      static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 +
+                          st.st_mtim.tv_nsec};
+    }
+
+    // The summary taken of this version of the file, if any
+    std::optional<GzFileSummary> find(const FileId& id) const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = entries.find({id.device, id.inode});
+        if (it == entries.end() || it->second.first != id)
+        {
+            return std::nullopt;
+        }
+        return it->second.second;
+    }
+
+    void insert(const FileId& id, const GzFileSummary& summary)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::pair<dev_t, ino_t> key{id.device, id.inode};
+        // Rotated out files are never looked up again; the host logger
+        // keeps far fewer files than this, so dropping everything once in a
+        // while is enough to forget them
+        if (entries.size() >= maxFiles && !entries.contains(key))
+        {
+            entries.clear();
+        }
+        entries.insert_or_assign(key, std::make_pair(id, summary));
+    }
+
+    size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return entries.size();
+    }
+
+  private:
+    static constexpr size_t maxFiles = 64;
+
+    // Host logger files are read on the worker threads
+    mutable std::mutex mutex;
+
+    std::map<std::pair<dev_t, ino_t>, std::pair<FileId, GzFileSummary>>
+        entries;
+};
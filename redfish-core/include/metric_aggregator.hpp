@@ -0,0 +1,174 @@
+#pragma once
+
+#include "metric_values.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace redfish
+{
+namespace telemetry
+{
+
+enum class AggregationFunction
+{
+    Average,
+    Maximum,
+    Minimum,
+    Last,
+};
+
+inline std::optional<AggregationFunction>
+    aggregationFunctionFromString(std::string_view function)
+{
+    if (function == "Average")
+    {
+        return AggregationFunction::Average;
+    }
+    if (function == "Maximum")
+    {
+        return AggregationFunction::Maximum;
+    }
+    if (function == "Minimum")
+    {
+        return AggregationFunction::Minimum;
+    }
+    if (function == "Last")
+    {
+        return AggregationFunction::Last;
+    }
+    return std::nullopt;
+}
+
+/**
+ * @brief Reduces the Readings updates of one Report to a single value per
+ * MetricProperty for each interval.
+ *
+ * Intervals are aligned to multiples of the interval on the Report's own
+ * timestamps.  An interval is complete once an update from a later interval
+ * arrives, at which point its readings are handed back, each stamped with
+ * the last time that property was read.  NaN readings, which the telemetry
+ * service gives for values it couldn't read, are left out of the minimum,
+ * maximum and average.
+ */
+class MetricAggregator
+{
+  public:
+    MetricAggregator(AggregationFunction functionIn,
+                     std::chrono::milliseconds intervalIn) :
+        function(functionIn),
+        interval(static_cast<uint64_t>(
+            std::max(intervalIn, std::chrono::milliseconds(1)).count()))
+    {}
+
+    // Adds one Readings update, returning the aggregated readings of the
+    // interval it completed, if any
+    std::optional<TimestampReadings> add(const TimestampReadings& update)
+    {
+        const auto& [timestamp, readings] = update;
+        uint64_t start = timestamp - timestamp % interval;
+
+        std::optional<TimestampReadings> completed;
+        if (!accumulators.empty() && start != windowStart)
+        {
+            completed = flush();
+        }
+        windowStart = start;
+        windowTimestamp = timestamp;
+
+        for (const auto& [metadata, value, readingTimestamp] : readings)
+        {
+            auto index = propertyIndex.try_emplace(metadata,
+                                                   accumulators.size());
+            if (index.second)
+            {
+                accumulators.push_back({metadata});
+            }
+            accumulators[index.first->second].add(value, readingTimestamp);
+        }
+        return completed;
+    }
+
+  private:
+    struct Accumulator
+    {
+        std::string property;
+        double sum = 0.0;
+        double minimum = std::numeric_limits<double>::infinity();
+        double maximum = -std::numeric_limits<double>::infinity();
+        double last = std::numeric_limits<double>::quiet_NaN();
+        uint64_t count = 0;
+        uint64_t timestamp = 0;
+
+        void add(double value, uint64_t readingTimestamp)
+        {
+            last = value;
+            timestamp = readingTimestamp;
+            if (std::isnan(value))
+            {
+                return;
+            }
+            sum += value;
+            minimum = std::min(minimum, value);
+            maximum = std::max(maximum, value);
+            count++;
+        }
+
+        double result(AggregationFunction function) const
+        {
+            if (function == AggregationFunction::Last)
+            {
+                return last;
+            }
+            if (count == 0)
+            {
+                return std::numeric_limits<double>::quiet_NaN();
+            }
+            switch (function)
+            {
+                case AggregationFunction::Maximum:
+                    return maximum;
+                case AggregationFunction::Minimum:
+                    return minimum;
+                default:
+                    return sum / static_cast<double>(count);
+            }
+        }
+    };
+
+    TimestampReadings flush()
+    {
+        Readings readings;
+        readings.reserve(accumulators.size());
+        for (Accumulator& accumulator : accumulators)
+        {
+            readings.emplace_back(std::move(accumulator.property),
+                                  accumulator.result(function),
+                                  accumulator.timestamp);
+        }
+        accumulators.clear();
+        propertyIndex.clear();
+        return {windowTimestamp, std::move(readings)};
+    }
+
+    AggregationFunction function;
+    uint64_t interval;
+    uint64_t windowStart = 0;
+    // Timestamp of the latest update in the current interval
+    uint64_t windowTimestamp = 0;
+    std::unordered_map<std::string, size_t> propertyIndex;
+    std::vector<Accumulator> accumulators;
+};
+
+} // namespace telemetry
+} // namespace redfish
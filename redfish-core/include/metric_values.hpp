@@ -0,0 +1,151 @@
+#pragma once
+
+#include "utils/time_utils.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace redfish
+{
+namespace telemetry
+{
+
+using Readings = std::vector<std::tuple<std::string, double, uint64_t>>;
+using TimestampReadings = std::tuple<uint64_t, Readings>;
+
+/**
+ * @brief The readings of a MetricReport held as columns.
+ *
+ * Each distinct MetricProperty is stored once and each distinct Timestamp is
+ * formatted once; readings refer to both by index.  The MetricValues array
+ * can be written straight to json text, without a json object per reading.
+ */
+class MetricValues
+{
+  public:
+    explicit MetricValues(const Readings& readings)
+    {
+        rows.reserve(readings.size());
+        std::unordered_map<std::string_view, uint32_t> propertyIndex;
+        std::unordered_map<uint64_t, uint32_t> timestampIndex;
+        for (const auto& [metadata, sensorValue, timestamp] : readings)
+        {
+            auto property = propertyIndex.try_emplace(
+                metadata, static_cast<uint32_t>(properties.size()));
+            if (property.second)
+            {
+                properties.emplace_back(&metadata);
+            }
+            auto time = timestampIndex.try_emplace(
+                timestamp, static_cast<uint32_t>(timestamps.size()));
+            if (time.second)
+            {
+                timestamps.emplace_back(
+                    redfish::time_utils::getDateTimeUintMs(timestamp));
+            }
+            rows.push_back({property.first->second, time.first->second,
+                            sensorValue});
+        }
+    }
+
+    size_t size() const
+    {
+        return rows.size();
+    }
+
+    nlohmann::json::array_t toJson() const
+    {
+        nlohmann::json::array_t metricValues;
+        metricValues.reserve(rows.size());
+        for (const Row& row : rows)
+        {
+            nlohmann::json::object_t metricValue;
+            metricValue["MetricProperty"] = *properties[row.property];
+            metricValue["MetricValue"] = formatValue(row.value);
+            metricValue["Timestamp"] = timestamps[row.timestamp];
+            metricValues.emplace_back(std::move(metricValue));
+        }
+        return metricValues;
+    }
+
+    // Appends the MetricValues array as compact json
+    void appendJson(std::string& out) const
+    {
+        std::vector<std::string> escaped;
+        escaped.reserve(properties.size());
+        size_t propertiesSize = 0;
+        for (const std::string* property : properties)
+        {
+            escaped.emplace_back(nlohmann::json(*property).dump(
+                -1, ' ', true, nlohmann::json::error_handler_t::replace));
+            propertiesSize += escaped.back().size();
+        }
+        out.reserve(out.size() + propertiesSize + rows.size() * 96);
+
+        out += '[';
+        for (size_t i = 0; i < rows.size(); i++)
+        {
+            const Row& row = rows[i];
+            if (i > 0)
+            {
+                out += ',';
+            }
+            out += R"({"MetricProperty":)";
+            out += escaped[row.property];
+            out += R"(,"MetricValue":")";
+            appendValue(out, row.value);
+            out += R"(","Timestamp":")";
+            out += timestamps[row.timestamp];
+            out += R"("})";
+        }
+        out += ']';
+    }
+
+  private:
+    // Matches the std::to_string() text MetricValue has always had, without
+    // allocating
+    static void appendValue(std::string& out, double value)
+    {
+        std::array<char, 400> buffer{};
+        std::to_chars_result result =
+            std::to_chars(buffer.data(), buffer.data() + buffer.size(),
+                          value, std::chars_format::fixed, 6);
+        if (result.ec != std::errc())
+        {
+            out += std::to_string(value);
+            return;
+        }
+        out.append(buffer.data(), result.ptr);
+    }
+
+    static std::string formatValue(double value)
+    {
+        std::string out;
+        appendValue(out, value);
+        return out;
+    }
+
+    struct Row
+    {
+        uint32_t property;
+        uint32_t timestamp;
+        double value;
+    };
+
+    // Point into the Readings, which must outlive this
+    std::vector<const std::string*> properties;
+    std::vector<std::string> timestamps;
+    std::vector<Row> rows;
+};
+
+} // namespace telemetry
+} // namespace redfish
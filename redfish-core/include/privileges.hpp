@@ -25,6 +25,7 @@
 #include <array>
 #include <bitset>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <initializer_list>
 #include <string>
@@ -214,39 +215,118 @@ class Privileges
     std::bitset<maxPrivilegeCount> privilegeBitset = 0;
 };
 
-inline const Privileges& getUserPrivileges(const std::string& userRole)
+/**
+ * @brief The roles User.Manager gives accounts, interned so that a request
+ * can be authorized without comparing role names.  ConfigureSelfOnly is any
+ * role held by an account whose password has expired.
+ */
+enum class UserRoleId : uint8_t
+{
+    NoAccess,
+    ReadOnly,
+    Operator,
+    Administrator,
+    OemIBMServiceAgent,
+    ConfigureSelfOnly,
+};
+
+constexpr size_t userRoleIdCount =
+    static_cast<size_t>(UserRoleId::ConfigureSelfOnly) + 1;
+
+/** @brief One bit per UserRoleId, set for the roles allowed an operation */
+using UserRoleMask = uint8_t;
+
+static_assert(userRoleIdCount <= sizeof(UserRoleMask) * 8,
+              "Not enough bits to store every role");
+
+inline UserRoleId getUserRoleId(std::string_view userRole)
 {
-    // Redfish privilege : Administrator
     if (userRole == "priv-admin")
     {
-        static Privileges admin{"Login", "ConfigureManager", "ConfigureSelf",
-                                "ConfigureUsers", "ConfigureComponents"};
-        return admin;
+        return UserRoleId::Administrator;
     }
     if (userRole == "priv-operator")
     {
-        // Redfish privilege : Operator
-        static Privileges op{"Login", "ConfigureSelf", "ConfigureComponents"};
-        return op;
+        return UserRoleId::Operator;
     }
     if (userRole == "priv-user")
     {
-        // Redfish privilege : Readonly
-        static Privileges readOnly{"Login", "ConfigureSelf"};
-        return readOnly;
+        return UserRoleId::ReadOnly;
     }
     if (userRole == "priv-oemibmserviceagent")
     {
-        static Privileges admin{
-            "Login",          "ConfigureManager",    "ConfigureSelf",
-            "ConfigureUsers", "ConfigureComponents", "OemIBMPerformService"};
-        return admin;
+        return UserRoleId::OemIBMServiceAgent;
+    }
+    return UserRoleId::NoAccess;
+}
+
+/**
+ * @brief The role a request is authorized as: an expired password limits
+ * every role but NoAccess to ConfigureSelf.
+ */
+inline UserRoleId getEffectiveUserRoleId(UserRoleId role,
+                                         bool isConfigureSelfOnly)
+{
+    if (isConfigureSelfOnly && role != UserRoleId::NoAccess)
+    {
+        return UserRoleId::ConfigureSelfOnly;
+    }
+    return role;
+}
+
+inline const Privileges& getUserPrivileges(UserRoleId role)
+{
+    switch (role)
+    {
+        case UserRoleId::Administrator:
+        {
+            // Redfish privilege : Administrator
+            static Privileges admin{"Login", "ConfigureManager",
+                                    "ConfigureSelf", "ConfigureUsers",
+                                    "ConfigureComponents"};
+            return admin;
+        }
+        case UserRoleId::Operator:
+        {
+            // Redfish privilege : Operator
+            static Privileges op{"Login", "ConfigureSelf",
+                                 "ConfigureComponents"};
+            return op;
+        }
+        case UserRoleId::ReadOnly:
+        {
+            // Redfish privilege : Readonly
+            static Privileges readOnly{"Login", "ConfigureSelf"};
+            return readOnly;
+        }
+        case UserRoleId::OemIBMServiceAgent:
+        {
+            static Privileges admin{"Login",
+                                    "ConfigureManager",
+                                    "ConfigureSelf",
+                                    "ConfigureUsers",
+                                    "ConfigureComponents",
+                                    "OemIBMPerformService"};
+            return admin;
+        }
+        case UserRoleId::ConfigureSelfOnly:
+        {
+            static Privileges configureSelf{"ConfigureSelf"};
+            return configureSelf;
+        }
+        case UserRoleId::NoAccess:
+            break;
     }
     // Redfish privilege : NoAccess
     static Privileges noaccess;
     return noaccess;
 }
 
+inline const Privileges& getUserPrivileges(const std::string& userRole)
+{
+    return getUserPrivileges(getUserRoleId(userRole));
+}
+
 /**
  * @brief The OperationMap represents the privileges required for a
  * single entity (URI).  It maps from the allowable verbs to the
@@ -290,6 +370,27 @@ inline bool isOperationAllowedWithPrivileges(
     return false;
 }
 
+/**
+ * @brief Works out, for every role, whether it holds one of the alternatives
+ * in operationPrivilegesRequired.  Routes do this once at startup so that
+ * authorizing a request is a single bit test.
+ */
+inline UserRoleMask getAllowedUserRoles(
+    const std::vector<Privileges>& operationPrivilegesRequired)
+{
+    UserRoleMask allowed = 0;
+    for (size_t role = 0; role < userRoleIdCount; role++)
+    {
+        if (isOperationAllowedWithPrivileges(
+                operationPrivilegesRequired,
+                getUserPrivileges(static_cast<UserRoleId>(role))))
+        {
+            allowed |= static_cast<UserRoleMask>(1U << role);
+        }
+    }
+    return allowed;
+}
+
 /**
  * @brief Checks if given privileges allow to call an HTTP method
  *
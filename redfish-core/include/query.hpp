@@ -8,8 +8,10 @@
 #include "http_request.hpp"
 #include "http_response.hpp"
 #include "logging.hpp"
+#include "utils/change_journal.hpp"
 #include "utils/query_param.hpp"
 
+#include <boost/beast/http/status.hpp>
 #include <boost/beast/http/verb.hpp>
 #include <boost/url/params_view.hpp>
 #include <boost/url/url_view.hpp>
@@ -18,6 +20,7 @@
 #include <memory>
 #include <new>
 #include <optional>
+#include <set>
 #include <string>
 #include <string_view>
 #include <type_traits>
@@ -155,13 +158,21 @@ inline bool handleIfMatch(crow::App& app, const crow::Request& req,
     }
 
     delegated = query_param::delegate(queryCapabilities, *queryOpt);
-    std::function<void(crow::Response&)> handler =
+    if (queryOpt->deltaToken)
+    {
+        // Only collections that keep a ChangeJournal can answer it
+        messages::queryParameterValueFormatError(
+            asyncResp->res, *queryOpt->deltaToken, "$deltatoken");
+        asyncResp->res.result(boost::beast::http::status::not_implemented);
+        return false;
+    }
+    crow::Response::CompletionHandler handler =
         asyncResp->res.releaseCompleteRequestHandler();
 
     asyncResp->res.setCompleteRequestHandler(
-        [&app, handler(std::move(handler)),
-         query{std::move(*queryOpt)}](crow::Response& resIn) mutable {
-        processAllParams(app, query, handler, resIn);
+        [&app, handler(std::move(handler)), query{std::move(*queryOpt)},
+         cancellation{asyncResp->cancellation}](crow::Response& resIn) mutable {
+        processAllParams(app, query, handler, resIn, cancellation);
     });
 
     return needToCallHandlers;
@@ -177,4 +188,121 @@ inline bool handleIfMatch(crow::App& app, const crow::Request& req,
     return setUpRedfishRouteWithDelegation(app, req, asyncResp, delegated,
                                            query_param::QueryCapabilities{});
 }
+
+/**
+ * @brief Adds the @odata.deltaLink to a collection response, and when changed
+ * is given, cuts its Members down to those with changed keys.  A changed
+ * member that is no longer in the collection is listed by its @odata.id
+ * with an @odata.removed annotation.
+ */
+inline void applyCollectionDelta(
+    nlohmann::json& jsonValue, const std::string& token,
+    const std::optional<std::set<std::string, std::less<>>>& changed,
+    const std::function<std::string(std::string_view)>& keyToUri)
+{
+    auto collectionUri = jsonValue.find("@odata.id");
+    if (collectionUri == jsonValue.end() || !collectionUri->is_string())
+    {
+        return;
+    }
+    jsonValue["@odata.deltaLink"] = collectionUri->get<std::string>() +
+                                    "?$deltatoken=" + token;
+    if (!changed)
+    {
+        return;
+    }
+
+    std::set<std::string, std::less<>> uris;
+    for (const std::string& key : *changed)
+    {
+        std::string uri = keyToUri(key);
+        if (!uri.empty())
+        {
+            uris.emplace(std::move(uri));
+        }
+    }
+    nlohmann::json::array_t members;
+    auto current = jsonValue.find("Members");
+    if (current != jsonValue.end() && current->is_array())
+    {
+        for (nlohmann::json& member : *current)
+        {
+            auto memberUri = member.find("@odata.id");
+            if (memberUri == member.end() || !memberUri->is_string() ||
+                uris.erase(memberUri->get<std::string>()) == 0)
+            {
+                continue;
+            }
+            members.emplace_back(std::move(member));
+        }
+    }
+    for (const std::string& uri : uris)
+    {
+        nlohmann::json::object_t removed;
+        removed["@odata.id"] = uri;
+        removed["@odata.removed"]["reason"] = "deleted";
+        members.emplace_back(std::move(removed));
+    }
+    jsonValue["Members@odata.count"] = members.size();
+    jsonValue["Members"] = std::move(members);
+    jsonValue.erase("Members@odata.nextLink");
+}
+
+/**
+ * @brief Sets up a collection GET to give an @odata.deltaLink, and to answer
+ * a $deltatoken with the members changed since.  journal is the one fed by
+ * the signals of the cache the collection is read from, or nullptr if that
+ * cache isn't following signals.  keyToUri maps a key journal records to
+ * the @odata.id of a member of this collection, or to an empty string if it
+ * isn't one.
+ *
+ * The token and the changes are taken now, before the handler reads the
+ * collection, so a change made while it does is listed again next time
+ * rather than missed.  A token the journal can no longer answer gets 410,
+ * and the client has to read the whole collection again.
+ */
+[[nodiscard]] inline bool setUpCollectionDelta(
+    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+    const std::optional<std::string>& deltaToken, const ChangeJournal* journal,
+    std::function<std::string(std::string_view)>&& keyToUri)
+{
+    if (journal == nullptr)
+    {
+        if (deltaToken)
+        {
+            messages::queryParameterValueFormatError(
+                asyncResp->res, *deltaToken, "$deltatoken");
+            asyncResp->res.result(boost::beast::http::status::not_implemented);
+            return false;
+        }
+        return true;
+    }
+
+    std::optional<std::set<std::string, std::less<>>> changed;
+    if (deltaToken)
+    {
+        changed = journal->changedSince(*deltaToken);
+        if (!changed)
+        {
+            messages::queryParameterValueFormatError(
+                asyncResp->res, *deltaToken, "$deltatoken");
+            asyncResp->res.result(boost::beast::http::status::gone);
+            return false;
+        }
+    }
+
+    crow::Response::CompletionHandler handler =
+        asyncResp->res.releaseCompleteRequestHandler();
+    asyncResp->res.setCompleteRequestHandler(
+        [handler(std::move(handler)), token{journal->token()},
+         changed{std::move(changed)},
+         keyToUri{std::move(keyToUri)}](crow::Response& res) mutable {
+        if (res.result() == boost::beast::http::status::ok)
+        {
+            applyCollectionDelta(res.jsonValue, token, changed, keyToUri);
+        }
+        handler(res);
+    });
+    return true;
+}
 } // namespace redfish
@@ -31,6 +31,7 @@
 #include "license_service.hpp"
 #include "log_services.hpp"
 #include "manager_diagnostic_data.hpp"
+#include "manager_profile.hpp"
 #include "managers.hpp"
 #include "memory.hpp"
 #include "message_registries.hpp"
@@ -49,6 +50,7 @@
 #include "redfish_sessions.hpp"
 #include "redfish_v1.hpp"
 #include "roles.hpp"
+#include "sensor_readings.hpp"
 #include "sensors.hpp"
 #include "service_root.hpp"
 #include "storage.hpp"
@@ -112,6 +114,9 @@ class RedfishService
         requestRoutesManagerResetActionInfo(app);
         requestRoutesManagerResetToDefaultsAction(app);
         requestRoutesManagerDiagnosticData(app);
+#ifdef BMCWEB_ENABLE_REQUEST_PROFILE
+        requestRoutesManagerProfile(app);
+#endif
         requestRoutesChassisCollection(app);
         requestRoutesChassis(app);
         requestRoutesChassisResetAction(app);
@@ -262,6 +267,7 @@ class RedfishService
         requestRoutesTaskCollection(app);
         requestRoutesTask(app);
         requestRoutesEventService(app);
+        requestRoutesEventServiceSse(app);
         requestRoutesEventDestinationCollection(app);
         requestRoutesEventDestination(app);
         requestRoutesFabricAdapters(app);
@@ -280,6 +286,7 @@ class RedfishService
         requestRoutesMetricReport(app);
         requestRoutesMetricDefinitionCollection(app);
         requestRoutesMetricDefinition(app);
+        requestRoutesSensorReadings(app);
         requestRoutesTriggerCollection(app);
         requestRoutesTrigger(app);
 
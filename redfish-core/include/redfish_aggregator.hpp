@@ -1,13 +1,24 @@
 #pragma once
 
+#include "bmcweb_config.h"
+
 #include <aggregation_utils.hpp>
 #include <boost/algorithm/string/predicate.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <dbus_utility.hpp>
 #include <error_messages.hpp>
 #include <http_client.hpp>
 #include <http_connection.hpp>
+#include <satellite_cache.hpp>
+#include <utils/query_param.hpp>
 
+#include <algorithm>
 #include <array>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
 
 namespace redfish
 {
@@ -174,6 +185,19 @@ static inline void addAggregatedHeaders(crow::Response& asyncResp,
     // TODO: we need special handling for Link Header Value
 }
 
+// Each header is a single string with the form "<Field>: <Value>"
+static inline void addPrefixToHeaderString(std::string& strHeader,
+                                           std::string_view prefix)
+{
+    constexpr std::string_view location = "Location: ";
+    if (strHeader.starts_with(location))
+    {
+        std::string header = strHeader.substr(location.size());
+        addPrefixToStringItem(header, prefix);
+        strHeader = std::string(location) + header;
+    }
+}
+
 // Fix HTTP headers which appear in responses from Task resources among others
 static inline void addPrefixToHeadersInResp(nlohmann::json& json,
                                             std::string_view prefix)
@@ -188,7 +212,6 @@ static inline void addPrefixToHeadersInResp(nlohmann::json& json,
 
     for (nlohmann::json& item : *array)
     {
-        // Each header is a single string with the form "<Field>: <Value>"
         std::string* strHeader = item.get_ptr<std::string*>();
         if (strHeader == nullptr)
         {
@@ -196,13 +219,7 @@ static inline void addPrefixToHeadersInResp(nlohmann::json& json,
             continue;
         }
 
-        constexpr std::string_view location = "Location: ";
-        if (strHeader->starts_with(location))
-        {
-            std::string header = strHeader->substr(location.size());
-            addPrefixToStringItem(header, prefix);
-            *strHeader = std::string(location) + header;
-        }
+        addPrefixToHeaderString(*strHeader, prefix);
     }
 }
 
@@ -245,6 +262,139 @@ static inline void addPrefixes(nlohmann::json& json, std::string_view prefix)
     }
 }
 
+// The target a GET of an aggregated collection at url is forwarded to
+// satellites with.  $skip and $top page the merged collection, so rather than
+// those a satellite is asked for the first skip + top members, the most a
+// page can use, or for all of them if that's more than $top allows.  "only"
+// applies to the merged collection too, and isn't forwarded.  The other
+// query parameters apply to each member by itself and are forwarded as sent.
+static inline std::string satelliteCollectionTarget(boost::urls::url_view url)
+{
+    query_param::Query paging;
+    boost::urls::url target(url);
+    target.remove_query();
+    // Encoded, so what's forwarded is exactly what the client sent
+    for (const boost::urls::param_pct_view& param : url.encoded_params())
+    {
+        if (param.key == "$skip")
+        {
+            query_param::getSkipParam(param.value, paging);
+            continue;
+        }
+        if (param.key == "$top")
+        {
+            query_param::getTopParam(param.value, paging);
+            continue;
+        }
+        if (param.key == "only")
+        {
+            continue;
+        }
+        target.encoded_params().append(param);
+    }
+    if (paging.top)
+    {
+        size_t needed = paging.skip.value_or(0) + *paging.top;
+        if (needed <= query_param::Query::maxTop)
+        {
+            target.params().append({"$top", std::to_string(needed)});
+        }
+    }
+    return std::string(target.encoded_target());
+}
+
+// Parses a satellite's response, adding prefix to the same URIs addPrefixes()
+// would as each value is parsed, rather than walking the finished tree a
+// second time.  Returns a discarded value if body isn't valid json.
+static inline nlohmann::json parseWithPrefixes(std::string_view body,
+                                               std::string_view prefix)
+{
+    enum class Scope
+    {
+        Object,
+        Array,
+        // The elements of "HttpHeaders"
+        Headers,
+        // Nothing in here is changed
+        Skip,
+    };
+    // The container open at each depth, and the key last seen in it
+    std::vector<Scope> scopes(1, Scope::Array);
+    std::vector<std::string> keys(1);
+    nlohmann::json::parser_callback_t callback =
+        [&scopes, &keys, prefix](int depth, nlohmann::json::parse_event_t event,
+                                 nlohmann::json& parsed) {
+        size_t level = static_cast<size_t>(depth);
+        if (level >= scopes.size())
+        {
+            return true;
+        }
+        bool isArray = event == nlohmann::json::parse_event_t::array_start;
+        switch (event)
+        {
+            case nlohmann::json::parse_event_t::object_start:
+            case nlohmann::json::parse_event_t::array_start:
+            {
+                Scope scope = isArray ? Scope::Array : Scope::Object;
+                if (scopes[level] == Scope::Skip ||
+                    scopes[level] == Scope::Headers)
+                {
+                    scope = Scope::Skip;
+                }
+                else if (level > 0 && scopes[level] == Scope::Object)
+                {
+                    if (isPropertyUri(keys[level]))
+                    {
+                        scope = Scope::Skip;
+                    }
+                    else if (keys[level] == "HttpHeaders")
+                    {
+                        scope = isArray ? Scope::Headers : Scope::Skip;
+                    }
+                }
+                scopes.resize(level + 2);
+                keys.resize(level + 2);
+                scopes[level + 1] = scope;
+                keys[level + 1].clear();
+                break;
+            }
+            case nlohmann::json::parse_event_t::key:
+            {
+                const std::string* key = parsed.get_ptr<const std::string*>();
+                if (key != nullptr)
+                {
+                    keys[level] = *key;
+                }
+                break;
+            }
+            case nlohmann::json::parse_event_t::value:
+            {
+                std::string* strValue = parsed.get_ptr<std::string*>();
+                if (strValue == nullptr || level == 0)
+                {
+                    break;
+                }
+                if (scopes[level] == Scope::Object &&
+                    isPropertyUri(keys[level]))
+                {
+                    addPrefixToStringItem(*strValue, prefix);
+                }
+                else if (scopes[level] == Scope::Headers)
+                {
+                    // Among those we need to attempt to fix the "Location"
+                    // header
+                    addPrefixToHeaderString(*strValue, prefix);
+                }
+                break;
+            }
+            default:
+                break;
+        }
+        return true;
+    };
+    return nlohmann::json::parse(body, callback, false);
+}
+
 inline boost::system::error_code aggregationRetryHandler(unsigned int respCode)
 {
     // Allow all response codes because we want to surface any satellite
@@ -260,7 +410,8 @@ inline crow::ConnectionPolicy getAggregationPolicy()
             .maxConnections = 20,
             .retryPolicyAction = "TerminateAfterRetries",
             .retryIntervalSecs = std::chrono::seconds(0),
-            .invalidResp = aggregationRetryHandler};
+            .invalidResp = aggregationRetryHandler,
+            .pipelineDepth = bmcwebAggregationPipelineDepth};
 }
 
 class RedfishAggregator
@@ -268,6 +419,22 @@ class RedfishAggregator
   private:
     crow::HttpClient client;
 
+    // One satellite's part in a collection request.  If the satellite hasn't
+    // answered by the deadline its hold on the response is dropped, so the
+    // collection goes out with what everyone else returned.
+    struct SatelliteDeadline
+    {
+        SatelliteDeadline(
+            boost::asio::io_context& ioc,
+            const std::shared_ptr<bmcweb::AsyncResp>& asyncRespIn) :
+            asyncResp(asyncRespIn),
+            timer(ioc)
+        {}
+
+        std::shared_ptr<bmcweb::AsyncResp> asyncResp;
+        boost::asio::steady_timer timer;
+    };
+
     RedfishAggregator() :
         client(std::make_shared<crow::ConnectionPolicy>(getAggregationPolicy()))
     {
@@ -599,13 +766,97 @@ class RedfishAggregator
         }
         targetURI.erase(pos, prefix.size() + 1);
 
-        std::function<void(crow::Response&)> cb =
-            std::bind_front(processResponse, prefix, asyncResp);
-
         std::string data = thisReq.req.body();
+        SatelliteCache& cache = SatelliteCache::getInstance();
+        if (!isCacheable(thisReq))
+        {
+            if (thisReq.method() != boost::beast::http::verb::get &&
+                thisReq.method() != boost::beast::http::verb::head)
+            {
+                // Whatever this changes may show up in any resource
+                cache.invalidate(prefix);
+            }
+            std::function<void(crow::Response&)> cb =
+                std::bind_front(processResponse, prefix, asyncResp);
+            client.sendDataWithCallback(
+                data, std::string(sat->second.host()),
+                sat->second.port_number(), targetURI, false /*useSSL*/,
+                thisReq.fields, thisReq.method(), cb);
+            return;
+        }
+
+        std::string username;
+        if (thisReq.session != nullptr)
+        {
+            username = thisReq.session->username;
+        }
+        std::string cacheKey = SatelliteCache::key(prefix, username, targetURI);
+        std::optional<SatelliteCache::Message> cached = cache.lookup(cacheKey);
+        if (cached)
+        {
+            BMCWEB_LOG_DEBUG << "Answering " << targetURI << " from \""
+                             << prefix << "\" from the cache";
+            crow::Response resp;
+            resp.stringResponse = std::move(*cached);
+            processResponse(prefix, asyncResp, resp);
+            return;
+        }
+
+        boost::beast::http::fields fields = thisReq.fields;
+        std::string etag = cache.etag(cacheKey);
+        if (!etag.empty())
+        {
+            fields.set(boost::beast::http::field::if_none_match, etag);
+        }
+        std::function<void(crow::Response&)> cb =
+            [prefix, asyncResp, cacheKey, generation(cache.generation()),
+             revalidating(!etag.empty())](crow::Response& resp) {
+            SatelliteCache& satelliteCache = SatelliteCache::getInstance();
+            if (revalidating &&
+                resp.result() == boost::beast::http::status::not_modified)
+            {
+                std::optional<SatelliteCache::Message> current =
+                    satelliteCache.revalidated(cacheKey, generation);
+                if (current)
+                {
+                    resp.stringResponse = std::move(*current);
+                }
+                else
+                {
+                    BMCWEB_LOG_ERROR << "Cached response from \"" << prefix
+                                     << "\" was dropped while revalidating";
+                }
+            }
+            else if (resp.stringResponse)
+            {
+                satelliteCache.store(cacheKey, prefix, *resp.stringResponse,
+                                     generation);
+            }
+            processResponse(prefix, asyncResp, resp);
+        };
         client.sendDataWithCallback(
             data, std::string(sat->second.host()), sat->second.port_number(),
-            targetURI, false /*useSSL*/, thisReq.fields, thisReq.method(), cb);
+            targetURI, false /*useSSL*/, fields, thisReq.method(), cb);
+    }
+
+    // Only plain GETs are answered from, and stored in, the cache.  Requests
+    // with their own conditions go to the satellite as they are.
+    static bool isCacheable(const crow::Request& thisReq)
+    {
+        if (!SatelliteCache::getInstance().enabled() ||
+            thisReq.method() != boost::beast::http::verb::get)
+        {
+            return false;
+        }
+        constexpr std::array<boost::beast::http::field, 4> conditions{
+            boost::beast::http::field::if_none_match,
+            boost::beast::http::field::if_match,
+            boost::beast::http::field::if_modified_since,
+            boost::beast::http::field::range};
+        return std::none_of(conditions.begin(), conditions.end(),
+                            [&thisReq](boost::beast::http::field field) {
+            return !thisReq.getHeaderValue(field).empty();
+        });
     }
 
     // Forward a request for a collection URI to each known satellite BMC
@@ -614,13 +865,43 @@ class RedfishAggregator
         const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
         const std::unordered_map<std::string, boost::urls::url>& satelliteInfo)
     {
+        // Every satellite gets the same body, so share one copy of it
+        auto data = std::make_shared<const std::string>(thisReq.req.body());
+        std::string targetURI = satelliteCollectionTarget(thisReq.urlView);
         for (const auto& sat : satelliteInfo)
         {
-            std::function<void(crow::Response&)> cb = std::bind_front(
-                processCollectionResponse, sat.first, asyncResp);
+            auto deadline = std::make_shared<SatelliteDeadline>(
+                crow::connections::systemBus->get_io_context(), asyncResp);
+            deadline->timer.expires_after(
+                std::chrono::seconds(bmcwebAggregationSatelliteTimeoutSeconds));
+            deadline->timer.async_wait(
+                [weak(std::weak_ptr<SatelliteDeadline>(deadline)),
+                 prefix(sat.first)](const boost::system::error_code& ec) {
+                std::shared_ptr<SatelliteDeadline> self = weak.lock();
+                if (ec || self == nullptr || self->asyncResp == nullptr)
+                {
+                    return;
+                }
+                BMCWEB_LOG_WARNING << "Satellite \"" << prefix
+                                   << "\" missed its deadline; leaving it out "
+                                      "of the collection";
+                self->asyncResp.reset();
+            });
+
+            std::function<void(crow::Response&)> cb =
+                [deadline, prefix(sat.first)](crow::Response& resp) {
+                deadline->timer.cancel();
+                std::shared_ptr<bmcweb::AsyncResp> collectionResp =
+                    std::move(deadline->asyncResp);
+                if (collectionResp == nullptr)
+                {
+                    BMCWEB_LOG_DEBUG << "Dropping late response from \""
+                                     << prefix << "\"";
+                    return;
+                }
+                processCollectionResponse(prefix, collectionResp, resp);
+            };
 
-            std::string targetURI(thisReq.target());
-            std::string data = thisReq.req.body();
             client.sendDataWithCallback(data, std::string(sat.second.host()),
                                         sat.second.port_number(), targetURI,
                                         false /*useSSL*/, thisReq.fields,
@@ -706,8 +987,7 @@ class RedfishAggregator
         // We need to create a json from resp's stringResponse
         if (resp.getHeaderValue("Content-Type") == "application/json")
         {
-            nlohmann::json jsonVal = nlohmann::json::parse(resp.body(), nullptr,
-                                                           false);
+            nlohmann::json jsonVal = parseWithPrefixes(resp.body(), prefix);
             if (jsonVal.is_discarded())
             {
                 BMCWEB_LOG_ERROR << "Error parsing satellite response as JSON";
@@ -715,11 +995,7 @@ class RedfishAggregator
                 return;
             }
 
-            BMCWEB_LOG_DEBUG << "Successfully parsed satellite response";
-
-            addPrefixes(jsonVal, prefix);
-
-            BMCWEB_LOG_DEBUG << "Added prefix to parsed satellite response";
+            BMCWEB_LOG_DEBUG << "Parsed and prefixed satellite response";
 
             asyncResp->res.result(resp.result());
             asyncResp->res.jsonValue = std::move(jsonVal);
@@ -766,8 +1042,9 @@ class RedfishAggregator
         // We need to create a json from resp's stringResponse
         if (resp.getHeaderValue("Content-Type") == "application/json")
         {
-            nlohmann::json jsonVal = nlohmann::json::parse(resp.body(), nullptr,
-                                                           false);
+            // The prefix is added to the URIs contained in the response as
+            // it is parsed
+            nlohmann::json jsonVal = parseWithPrefixes(resp.body(), prefix);
             if (jsonVal.is_discarded())
             {
                 BMCWEB_LOG_ERROR << "Error parsing satellite response as JSON";
@@ -782,13 +1059,7 @@ class RedfishAggregator
                 return;
             }
 
-            BMCWEB_LOG_DEBUG << "Successfully parsed satellite response";
-
-            // Now we need to add the prefix to the URIs contained in the
-            // response.
-            addPrefixes(jsonVal, prefix);
-
-            BMCWEB_LOG_DEBUG << "Added prefix to parsed satellite response";
+            BMCWEB_LOG_DEBUG << "Parsed and prefixed satellite response";
 
             // If this resource collection does not exist on the aggregating bmc
             // and has not already been added from processing the response from
@@ -17,9 +17,11 @@
 
 #include <nlohmann/json.hpp>
 
+#include <algorithm>
 #include <array>
 #include <charconv>
 #include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <numeric>
 #include <span>
@@ -55,6 +57,64 @@ struct Message
 };
 using MessageEntry = std::pair<const char*, const Message>;
 
+/**
+ * @brief Positions of a registry's entries in MessageKey order, computed at
+ * compile time so that a key can be found by binary search.
+ */
+template <size_t N>
+constexpr std::array<uint16_t, N>
+    makeMessageKeyIndex(const std::array<MessageEntry, N>& registry)
+{
+    static_assert(N <= UINT16_MAX);
+    std::array<uint16_t, N> byKey{};
+    for (size_t i = 0; i < N; i++)
+    {
+        byKey[i] = static_cast<uint16_t>(i);
+    }
+    std::sort(byKey.begin(), byKey.end(),
+              [&registry](uint16_t lhs, uint16_t rhs) {
+        return std::string_view(registry[lhs].first) <
+               std::string_view(registry[rhs].first);
+    });
+    return byKey;
+}
+
+inline const Message* findMessage(std::span<const MessageEntry> registry,
+                                  std::span<const uint16_t> byKey,
+                                  std::string_view messageKey)
+{
+    const uint16_t* it =
+        std::lower_bound(byKey.data(), byKey.data() + byKey.size(),
+                         messageKey,
+                         [registry](uint16_t index, std::string_view key) {
+        return std::string_view(registry[index].first) < key;
+    });
+    if (it == byKey.data() + byKey.size() ||
+        std::string_view(registry[*it].first) != messageKey)
+    {
+        return nullptr;
+    }
+    return &registry[*it].second;
+}
+
+/**
+ * @brief Splits a MessageId of the form
+ * RegistryName.MajorVersion.MinorVersion.MessageKey.  Returns false if it
+ * doesn't have exactly four fields.
+ */
+inline bool splitMessageId(std::string_view messageId,
+                           std::string_view& registryName,
+                           std::string_view& messageKey)
+{
+    if (std::count(messageId.begin(), messageId.end(), '.') != 3)
+    {
+        return false;
+    }
+    registryName = messageId.substr(0, messageId.find('.'));
+    messageKey = messageId.substr(messageId.rfind('.') + 1);
+    return true;
+}
+
 inline std::string
     fillMessageArgs(const std::span<const std::string_view> messageArgs,
                     std::string_view msg)
@@ -101,14 +161,19 @@ inline nlohmann::json::object_t
     // parameters.
     std::string msg =
         redfish::registries::fillMessageArgs(args, entry.second.message);
-    nlohmann::json jArgs = nlohmann::json::array();
+    nlohmann::json::array_t jArgs;
+    jArgs.reserve(args.size());
     for (const std::string_view arg : args)
     {
-        jArgs.push_back(arg);
+        jArgs.emplace_back(arg);
     }
-    std::string msgId = header.id;
-    msgId += ".";
-    msgId += entry.first;
+    std::string_view id = header.id;
+    std::string_view key = entry.first;
+    std::string msgId;
+    msgId.reserve(id.size() + 1 + key.size());
+    msgId += id;
+    msgId += '.';
+    msgId += key;
 
     nlohmann::json::object_t response;
     response["@odata.type"] = "#Message.v1_1_1.Message";
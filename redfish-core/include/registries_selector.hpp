@@ -0,0 +1,84 @@
+#pragma once
+
+#include "registries.hpp"
+#include "registries/base_message_registry.hpp"
+#include "registries/license_message_registry.hpp"
+#include "registries/openbmc_message_registry.hpp"
+#include "registries/resource_event_message_registry.hpp"
+#include "registries/task_event_message_registry.hpp"
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace redfish::registries
+{
+
+struct MessageRegistry
+{
+    const Header* header;
+    std::span<const MessageEntry> entries;
+    std::span<const uint16_t> byKey;
+};
+
+namespace selector
+{
+inline constexpr std::array baseByKey = makeMessageKeyIndex(base::registry);
+inline constexpr std::array licenseByKey =
+    makeMessageKeyIndex(license::registry);
+inline constexpr std::array openbmcByKey =
+    makeMessageKeyIndex(openbmc::registry);
+inline constexpr std::array resourceEventByKey =
+    makeMessageKeyIndex(resource_event::registry);
+inline constexpr std::array taskEventByKey =
+    makeMessageKeyIndex(task_event::registry);
+
+inline constexpr std::array<MessageRegistry, 5> messageRegistries{{
+    {&base::header, base::registry, baseByKey},
+    {&license::header, license::registry, licenseByKey},
+    {&openbmc::header, openbmc::registry, openbmcByKey},
+    {&resource_event::header, resource_event::registry, resourceEventByKey},
+    {&task_event::header, task_event::registry, taskEventByKey},
+}};
+} // namespace selector
+
+inline const MessageRegistry*
+    getRegistryFromPrefix(std::string_view registryName)
+{
+    for (const MessageRegistry& registry : selector::messageRegistries)
+    {
+        if (registry.header->registryPrefix == registryName)
+        {
+            return &registry;
+        }
+    }
+    return nullptr;
+}
+
+inline const Message* getMessageFromRegistry(const MessageRegistry& registry,
+                                             std::string_view messageKey)
+{
+    return findMessage(registry.entries, registry.byKey, messageKey);
+}
+
+inline const Message* getMessage(std::string_view messageID)
+{
+    // Redfish MessageIds are in the form
+    // RegistryName.MajorVersion.MinorVersion.MessageKey, so parse it to find
+    // the right Message
+    std::string_view registryName;
+    std::string_view messageKey;
+    if (!splitMessageId(messageID, registryName, messageKey))
+    {
+        return nullptr;
+    }
+    const MessageRegistry* registry = getRegistryFromPrefix(registryName);
+    if (registry == nullptr)
+    {
+        return nullptr;
+    }
+    return getMessageFromRegistry(*registry, messageKey);
+}
+
+} // namespace redfish::registries
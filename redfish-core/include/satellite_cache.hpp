@@ -0,0 +1,215 @@
+#pragma once
+
+#include "bmcweb_config.h"
+#include "http_response.hpp"
+
+#include <boost/beast/http/field.hpp>
+#include <boost/beast/http/status.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace redfish
+{
+
+// Most satellite responses remembered at once
+constexpr std::size_t satelliteCacheMaxEntries = 256;
+
+// Larger responses are always fetched again
+constexpr std::size_t satelliteCacheMaxBodySize = 64UL * 1024UL;
+
+/**
+ * @brief Remembers successful GET responses from satellite BMCs, so clients
+ * that poll the same aggregated resources don't cost a round trip each time.
+ *
+ * A response is served as is until it is ttl old.  After that an entry with
+ * an ETag is revalidated with If-None-Match, and one without is fetched
+ * again.  Entries are kept per user, as the satellite authorizes the request
+ * with the credentials it's forwarded with; the Cache-Control: no-store
+ * bmcweb puts on every response is aimed at clients and isn't honored here.
+ * Anything other than a GET sent to a satellite drops what is held for it.
+ * This is only used from the main io_context.
+ */
+class SatelliteCache
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+    using Message = crow::Response::response_type;
+
+    explicit SatelliteCache(Clock::duration ttlIn) : ttl(ttlIn) {}
+
+    static SatelliteCache& getInstance()
+    {
+        static SatelliteCache cache{
+            std::chrono::seconds(bmcwebAggregationCacheTtlSeconds)};
+        return cache;
+    }
+
+    ~SatelliteCache() = default;
+    SatelliteCache(const SatelliteCache&) = delete;
+    SatelliteCache& operator=(const SatelliteCache&) = delete;
+    SatelliteCache(SatelliteCache&&) = delete;
+    SatelliteCache& operator=(SatelliteCache&&) = delete;
+
+    bool enabled() const
+    {
+        return ttl > Clock::duration::zero();
+    }
+
+    static std::string key(std::string_view prefix, std::string_view username,
+                           std::string_view target)
+    {
+        // Neither prefixes nor usernames can contain NUL
+        std::string out(prefix);
+        out += '\0';
+        out += username;
+        out += '\0';
+        out += target;
+        return out;
+    }
+
+    // The response remembered for key, if it is still fresh
+    std::optional<Message> lookup(const std::string& cacheKey,
+                                  Clock::time_point now = Clock::now())
+    {
+        auto it = entries.find(cacheKey);
+        if (it == entries.end())
+        {
+            return std::nullopt;
+        }
+        if (now - it->second.validated >= ttl)
+        {
+            if (it->second.etag.empty())
+            {
+                entries.erase(it);
+            }
+            return std::nullopt;
+        }
+        it->second.used = now;
+        return it->second.message;
+    }
+
+    // The ETag to revalidate a stale entry with, or empty if there's none
+    std::string etag(const std::string& cacheKey) const
+    {
+        auto it = entries.find(cacheKey);
+        if (it == entries.end())
+        {
+            return "";
+        }
+        return it->second.etag;
+    }
+
+    // Counter to read before asking the satellite and pass to store() or
+    // revalidated(), so an answer that raced with an invalidation is dropped
+    uint64_t generation() const
+    {
+        return currentGeneration;
+    }
+
+    // The satellite answered 304 Not Modified to etag(cacheKey).  Returns the
+    // remembered response, which is fresh again.
+    std::optional<Message> revalidated(const std::string& cacheKey,
+                                       uint64_t startedGeneration,
+                                       Clock::time_point now = Clock::now())
+    {
+        auto it = entries.find(cacheKey);
+        if (it == entries.end() || startedGeneration != currentGeneration)
+        {
+            return std::nullopt;
+        }
+        it->second.validated = now;
+        it->second.used = now;
+        return it->second.message;
+    }
+
+    void store(const std::string& cacheKey, std::string_view prefix,
+               const Message& message, uint64_t startedGeneration,
+               Clock::time_point now = Clock::now())
+    {
+        if (!enabled() || startedGeneration != currentGeneration)
+        {
+            return;
+        }
+        if (message.result() != boost::beast::http::status::ok ||
+            message.body().size() > satelliteCacheMaxBodySize)
+        {
+            entries.erase(cacheKey);
+            return;
+        }
+        if (entries.size() >= satelliteCacheMaxEntries &&
+            entries.find(cacheKey) == entries.end())
+        {
+            evictOldest(now);
+        }
+        Entry& entry = entries[cacheKey];
+        entry.prefix = prefix;
+        entry.message = message;
+        entry.etag = std::string(message[boost::beast::http::field::etag]);
+        entry.validated = now;
+        entry.used = now;
+    }
+
+    // Forgets what this satellite returned, or every satellite if prefix is
+    // empty
+    void invalidate(std::string_view prefix)
+    {
+        currentGeneration++;
+        if (prefix.empty())
+        {
+            entries.clear();
+            return;
+        }
+        std::erase_if(entries, [prefix](const auto& entry) {
+            return entry.second.prefix == prefix;
+        });
+    }
+
+    std::size_t size() const
+    {
+        return entries.size();
+    }
+
+  private:
+    struct Entry
+    {
+        std::string prefix;
+        Message message;
+        std::string etag;
+        Clock::time_point validated;
+        Clock::time_point used;
+    };
+
+    // Drops stale entries that can't be revalidated, then the least recently
+    // used one if that wasn't enough
+    void evictOldest(Clock::time_point now)
+    {
+        std::erase_if(entries, [this, now](const auto& entry) {
+            return entry.second.etag.empty() &&
+                   now - entry.second.validated >= ttl;
+        });
+        if (entries.size() < satelliteCacheMaxEntries)
+        {
+            return;
+        }
+        auto oldest = entries.begin();
+        for (auto it = entries.begin(); it != entries.end(); it++)
+        {
+            if (it->second.used < oldest->second.used)
+            {
+                oldest = it;
+            }
+        }
+        entries.erase(oldest);
+    }
+
+    Clock::duration ttl;
+    uint64_t currentGeneration = 0;
+    std::unordered_map<std::string, Entry> entries;
+};
+
+} // namespace redfish
@@ -295,5 +295,6 @@ namespace redfish
         "OemMessage",
         "OemPCIeSlots",
         "OemFabricAdapter",
+        "OemEventDestination",
     };
 }
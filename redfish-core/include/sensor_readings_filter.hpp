@@ -0,0 +1,209 @@
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace redfish
+{
+
+/**
+ * @brief The $filter of the bulk sensor readings resource: the reading types
+ * and chassis a reading must be one of.  An empty list matches any.
+ */
+struct SensorReadingsFilter
+{
+    std::vector<std::string> readingTypes;
+    std::vector<std::string> chassis;
+
+    bool matches(std::string_view chassisId, std::string_view readingType) const
+    {
+        return (readingTypes.empty() ||
+                std::ranges::find(readingTypes, readingType) !=
+                    readingTypes.end()) &&
+               (chassis.empty() ||
+                std::ranges::find(chassis, chassisId) != chassis.end());
+    }
+};
+
+namespace details
+{
+
+class SensorReadingsFilterParser
+{
+  public:
+    explicit SensorReadingsFilterParser(std::string_view filterIn) :
+        filter(filterIn)
+    {}
+
+    // filter := group ("and" group)*
+    // group  := comparison | "(" comparison ("or" comparison)* ")"
+    //         | comparison ("or" comparison)*, if it's the only group
+    std::optional<SensorReadingsFilter> parse()
+    {
+        bool grouped = false;
+        do
+        {
+            bool parenthesized = next("(");
+            std::vector<std::string>* values = parseAlternatives();
+            if (values == nullptr || (parenthesized && !next(")")))
+            {
+                return std::nullopt;
+            }
+            // Without parentheses, "a or b and c" would read as
+            // "(a or b) and c" here but "a or (b and c)" anywhere else
+            if (!parenthesized && values->size() > 1 &&
+                (grouped || peek("and")))
+            {
+                return std::nullopt;
+            }
+            grouped = true;
+        } while (next("and"));
+
+        skipSpaces();
+        if (!filter.empty())
+        {
+            return std::nullopt;
+        }
+        return std::move(result);
+    }
+
+  private:
+    // Parses comparisons on one property joined by "or", and returns the
+    // values they allow
+    std::vector<std::string>* parseAlternatives()
+    {
+        std::vector<std::string>* values = nullptr;
+        do
+        {
+            std::string_view property = word();
+            std::vector<std::string>* propertyValues = nullptr;
+            if (property == "ReadingType")
+            {
+                propertyValues = &result.readingTypes;
+            }
+            else if (property == "Chassis")
+            {
+                propertyValues = &result.chassis;
+            }
+            // Each property is compared in one group only, as a reading
+            // can't match two values of it at once
+            if (propertyValues == nullptr ||
+                (values == nullptr && !propertyValues->empty()) ||
+                (values != nullptr && values != propertyValues))
+            {
+                return nullptr;
+            }
+            values = propertyValues;
+
+            if (word() != "eq")
+            {
+                return nullptr;
+            }
+            std::optional<std::string> value = quoted();
+            if (!value)
+            {
+                return nullptr;
+            }
+            values->emplace_back(std::move(*value));
+        } while (next("or"));
+        return values;
+    }
+
+    void skipSpaces()
+    {
+        while (!filter.empty() && filter.front() == ' ')
+        {
+            filter.remove_prefix(1);
+        }
+    }
+
+    std::string_view word()
+    {
+        skipSpaces();
+        size_t length = 0;
+        while (length < filter.size() &&
+               std::isalnum(static_cast<unsigned char>(filter[length])) != 0)
+        {
+            length++;
+        }
+        std::string_view token = filter.substr(0, length);
+        filter.remove_prefix(length);
+        return token;
+    }
+
+    bool peek(std::string_view token)
+    {
+        skipSpaces();
+        if (!filter.starts_with(token))
+        {
+            return false;
+        }
+        // A keyword has to end where the word does
+        return token == "(" || token == ")" || filter.size() == token.size() ||
+               std::isalnum(static_cast<unsigned char>(
+                   filter[token.size()])) == 0;
+    }
+
+    bool next(std::string_view token)
+    {
+        if (!peek(token))
+        {
+            return false;
+        }
+        filter.remove_prefix(token.size());
+        return true;
+    }
+
+    // A string literal, in which '' stands for a single quote
+    std::optional<std::string> quoted()
+    {
+        skipSpaces();
+        if (filter.empty() || filter.front() != '\'')
+        {
+            return std::nullopt;
+        }
+        filter.remove_prefix(1);
+        std::string value;
+        while (!filter.empty())
+        {
+            char c = filter.front();
+            filter.remove_prefix(1);
+            if (c != '\'')
+            {
+                value += c;
+                continue;
+            }
+            if (filter.empty() || filter.front() != '\'')
+            {
+                return value;
+            }
+            value += '\'';
+            filter.remove_prefix(1);
+        }
+        return std::nullopt;
+    }
+
+    std::string_view filter;
+    SensorReadingsFilter result;
+};
+
+} // namespace details
+
+/**
+ * @brief Parses a $filter of comparisons of ReadingType and Chassis, such as
+ * "(ReadingType eq 'Temperature' or ReadingType eq 'Power') and
+ * Chassis eq 'chassis'".  Only eq is supported, and "or" only between
+ * comparisons of the same property.  Returns nullopt if filter is anything
+ * else.
+ */
+inline std::optional<SensorReadingsFilter>
+    parseSensorReadingsFilter(std::string_view filter)
+{
+    return details::SensorReadingsFilterParser(filter).parse();
+}
+
+} // namespace redfish
@@ -16,272 +16,202 @@
 */
 #pragma once
 
-#include <boost/asio/strand.hpp>
-#include <boost/beast/http/buffer_body.hpp>
-#include <boost/beast/http/message.hpp>
-#include <boost/beast/version.hpp>
+#include "http_response.hpp"
+#include "logging.hpp"
 
-#include <cstdlib>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <deque>
 #include <functional>
-#include <iostream>
 #include <memory>
-#include <queue>
 #include <string>
+#include <string_view>
+#include <utility>
 
 namespace crow
 {
 
-static constexpr uint8_t maxReqQueueSize = 50;
-
-enum class SseConnState
-{
-    startInit,
-    initInProgress,
-    initialized,
-    initFailed,
-    sendInProgress,
-    sendFailed,
-    idle,
-    suspended,
-    closed
-};
-
-class ServerSentEvents : public std::enable_shared_from_this<ServerSentEvents>
+// Formats data as one text/event-stream event.  A field can't hold a line
+// break, so each line of data goes in its own data field.
+inline std::string formatSseEvent(std::string_view id, std::string_view data)
 {
-  private:
-    std::shared_ptr<boost::asio::ip::tcp::socket> sseConn;
-    std::queue<std::pair<uint64_t, std::string>> requestDataQueue;
-    std::string outBuffer;
-    SseConnState state{SseConnState::startInit};
-    int retryCount{0};
-    int maxRetryAttempts{5};
-
-    void sendEvent(const std::string& id, const std::string& msg)
+    std::string out;
+    out.reserve(id.size() + data.size() + 16);
+    if (!id.empty())
+    {
+        out += "id: ";
+        out += id;
+        out += '\n';
+    }
+    while (true)
     {
-        if (msg.empty())
+        size_t newline = data.find('\n');
+        out += "data: ";
+        out += data.substr(0, newline);
+        out += '\n';
+        if (newline == std::string_view::npos)
         {
-            BMCWEB_LOG_DEBUG << "Empty data, bailing out.";
-            return;
+            break;
         }
+        data.remove_prefix(newline + 1);
+    }
+    out += '\n';
+    return out;
+}
+
+/**
+ * @brief The formatted event for payload, shared by every stream it goes to.
+ * An event is handed to each stream back to back, so only the last one needs
+ * remembering.
+ */
+inline std::shared_ptr<const std::string>
+    getSseEvent(const std::shared_ptr<const std::string>& payload,
+                std::string_view id)
+{
+    static std::weak_ptr<const std::string> lastPayload;
+    static std::string lastId;
+    static std::shared_ptr<const std::string> lastEvent;
 
-        if (state == SseConnState::sendInProgress)
-        {
-            return;
-        }
-        state = SseConnState::sendInProgress;
+    if (lastEvent != nullptr && lastPayload.lock() == payload && lastId == id)
+    {
+        return lastEvent;
+    }
+    lastPayload = payload;
+    lastId = id;
+    lastEvent = std::make_shared<const std::string>(
+        formatSseEvent(id, *payload));
+    return lastEvent;
+}
+
+/**
+ * @brief The body of one text/event-stream response.  Events are queued as
+ * buffers shared with the other streams they go to, and handed to the
+ * connection as it asks for them; a client more than maxQueuedEvents behind
+ * loses the oldest ones.
+ *
+ * The connection owns the stream through the response's body generator, so
+ * the stream, and its close handler, go once the client does.  While idle a
+ * comment goes out every keepAliveInterval, which keeps proxies from timing
+ * the response out and notices clients that left without a word.
+ */
+class SseStream : public std::enable_shared_from_this<SseStream>
+{
+  public:
+    static constexpr size_t maxQueuedEvents = 50;
+    static constexpr std::chrono::seconds keepAliveInterval{30};
 
-        if (!id.empty())
-        {
-            outBuffer += "id: ";
-            outBuffer.append(id.begin(), id.end());
-            outBuffer += "\n";
-        }
+    explicit SseStream(boost::asio::io_context& ioc) : keepAliveTimer(ioc) {}
 
-        outBuffer += "data: ";
-        for (char character : msg)
+    SseStream(const SseStream&) = delete;
+    SseStream& operator=(const SseStream&) = delete;
+    SseStream(SseStream&&) = delete;
+    SseStream& operator=(SseStream&&) = delete;
+
+    ~SseStream()
+    {
+        if (onClose)
         {
-            outBuffer += character;
-            if (character == '\n')
-            {
-                outBuffer += "data: ";
-            }
+            onClose();
         }
-        outBuffer += "\n\n";
+    }
 
-        doWrite();
+    void setCloseHandler(std::function<void()> handler)
+    {
+        onClose = std::move(handler);
     }
 
-    void doWrite()
+    void push(std::shared_ptr<const std::string> event)
     {
-        if (outBuffer.empty())
+        if (finished)
         {
-            BMCWEB_LOG_DEBUG << "All data sent successfully.";
-            // Send is successful, Lets remove data from queue
-            // check for next request data in queue.
-            requestDataQueue.pop();
-            state = SseConnState::idle;
-            checkQueue();
             return;
         }
+        if (queue.size() >= maxQueuedEvents)
+        {
+            BMCWEB_LOG_WARNING << "SSE client " << this
+                               << " fell behind; dropping oldest event";
+            queue.pop_front();
+            droppedEvents++;
+        }
+        queue.emplace_back(std::move(event));
+        deliver();
+    }
 
-        sseConn->async_write_some(
-            boost::asio::buffer(outBuffer.data(), outBuffer.size()),
-            [self(shared_from_this())](
-                boost::beast::error_code ec,
-                [[maybe_unused]] const std::size_t& bytesTransferred) {
-            self->outBuffer.erase(0, bytesTransferred);
-
-            if (ec == boost::asio::error::eof)
-            {
-                // Send is successful, Lets remove data from queue
-                // check for next request data in queue.
-                self->requestDataQueue.pop();
-                self->state = SseConnState::idle;
-                self->checkQueue();
-                return;
-            }
-
-            if (ec)
-            {
-                BMCWEB_LOG_ERROR << "async_write_some() failed: "
-                                 << ec.message();
-                self->state = SseConnState::sendFailed;
-                self->checkQueue();
-                return;
-            }
-            BMCWEB_LOG_DEBUG << "async_write_some() bytes transferred: "
-                             << bytesTransferred;
-
-            self->doWrite();
-        });
+    // Ends the response once what is already queued has been written
+    void finish()
+    {
+        finished = true;
+        deliver();
     }
 
-    void startSSE()
+    // The response's body generator
+    void pull(Response::BodyChunkHandler&& done)
     {
-        if (state == SseConnState::initInProgress)
+        waiting = std::move(done);
+        deliver();
+        if (waiting)
         {
-            return;
+            startKeepAlive();
         }
-        state = SseConnState::initInProgress;
-
-        BMCWEB_LOG_DEBUG << "starting SSE connection ";
-        using BodyType = boost::beast::http::buffer_body;
-        auto response =
-            std::make_shared<boost::beast::http::response<BodyType>>(
-                boost::beast::http::status::ok, 11);
-        auto serializer =
-            std::make_shared<boost::beast::http::response_serializer<BodyType>>(
-                *response);
-
-        // TODO: Add hostname in http header.
-        response->set(boost::beast::http::field::server, "iBMC");
-        response->set(boost::beast::http::field::content_type,
-                      "text/event-stream");
-        response->body().data = nullptr;
-        response->body().size = 0;
-        response->body().more = true;
-
-        boost::beast::http::async_write_header(
-            *sseConn, *serializer,
-            [this, response,
-             serializer](const boost::beast::error_code& ec,
-                         [[maybe_unused]] const std::size_t& bytesTransferred) {
-            if (ec)
-            {
-                BMCWEB_LOG_ERROR << "Error sending header" << ec;
-                state = SseConnState::initFailed;
-                checkQueue();
-                return;
-            }
+    }
 
-            BMCWEB_LOG_DEBUG << "startSSE  Header sent.";
-            state = SseConnState::initialized;
-            checkQueue();
-        });
+    size_t getDroppedEvents() const
+    {
+        return droppedEvents;
     }
 
-    void checkQueue(const bool newRecord = false)
+  private:
+    // Hands everything queued to the connection, if it is waiting for it
+    void deliver()
     {
-        if (requestDataQueue.empty())
+        if (!waiting || (queue.empty() && !finished))
         {
-            BMCWEB_LOG_DEBUG << "requestDataQueue is empty\n";
             return;
         }
-
-        if (retryCount >= maxRetryAttempts)
+        keepAliveTimer.cancel();
+        std::string chunk;
+        for (const std::shared_ptr<const std::string>& event : queue)
         {
-            BMCWEB_LOG_ERROR << "Maximum number of retries is reached.";
-
-            // Clear queue.
-            while (!requestDataQueue.empty())
-            {
-                requestDataQueue.pop();
-            }
-
-            // TODO: Take 'DeliveryRetryPolicy' action.
-            // For now, doing 'SuspendRetries' action.
-            state = SseConnState::suspended;
-            return;
+            chunk += *event;
         }
+        queue.clear();
+        Response::BodyChunkHandler done = std::move(waiting);
+        waiting = nullptr;
+        // The connection may let go of the stream once done has run
+        std::shared_ptr<SseStream> self = shared_from_this();
+        done(std::move(chunk), !finished);
+    }
 
-        if ((state == SseConnState::initFailed) ||
-            (state == SseConnState::sendFailed))
-        {
-            if (newRecord)
+    void startKeepAlive()
+    {
+        keepAliveTimer.expires_after(keepAliveInterval);
+        keepAliveTimer.async_wait(
+            [weakSelf{weak_from_this()}](const boost::system::error_code& ec) {
+            if (ec)
             {
-                // We are already running async wait and retry.
-                // Since record is added to queue, it gets the
-                // turn in FIFO.
                 return;
             }
-
-            retryCount++;
-            // TODO: Perform async wait for retryTimeoutInterval before proceed.
-        }
-        else
-        {
-            // reset retry count.
-            retryCount = 0;
-        }
-
-        switch (state)
-        {
-            case SseConnState::initInProgress:
-            case SseConnState::sendInProgress:
-            case SseConnState::suspended:
-            case SseConnState::startInit:
-            case SseConnState::closed:
-                // do nothing
-                break;
-            case SseConnState::initFailed:
-            {
-                startSSE();
-                break;
-            }
-            case SseConnState::initialized:
-            case SseConnState::idle:
-            case SseConnState::sendFailed:
+            std::shared_ptr<SseStream> self = weakSelf.lock();
+            if (self == nullptr)
             {
-                std::pair<uint64_t, std::string> reqData =
-                    requestDataQueue.front();
-                sendEvent(std::to_string(reqData.first), reqData.second);
-                break;
+                return;
             }
-        }
-    }
-
-  public:
-    ServerSentEvents(const ServerSentEvents&) = delete;
-    ServerSentEvents& operator=(const ServerSentEvents&) = delete;
-    ServerSentEvents(ServerSentEvents&&) = delete;
-    ServerSentEvents& operator=(ServerSentEvents&&) = delete;
-
-    explicit ServerSentEvents(
-        const std::shared_ptr<boost::asio::ip::tcp::socket>& adaptor) :
-        sseConn(adaptor)
-    {
-        startSSE();
+            static const auto keepAlive =
+                std::make_shared<const std::string>(":\n\n");
+            self->push(keepAlive);
+        });
     }
 
-    ~ServerSentEvents() = default;
-
-    void sendData(const uint64_t& id, const std::string& data)
-    {
-        if (state == SseConnState::suspended)
-        {
-            return;
-        }
-
-        if (requestDataQueue.size() <= maxReqQueueSize)
-        {
-            requestDataQueue.emplace(id, data);
-            checkQueue(true);
-        }
-        else
-        {
-            BMCWEB_LOG_ERROR << "Request queue is full. So ignoring data.";
-        }
-    }
+    std::deque<std::shared_ptr<const std::string>> queue;
+    Response::BodyChunkHandler waiting;
+    boost::asio::steady_timer keepAliveTimer;
+    std::function<void()> onClose;
+    size_t droppedEvents = 0;
+    bool finished = false;
 };
 
 } // namespace crow
@@ -1,50 +1,227 @@
+#pragma once
+
+#include "async_resp.hpp"
+#include "dbus_singleton.hpp"
+#include "dbus_utility.hpp"
+#include "error_messages.hpp"
+#include "event_service_manager.hpp"
+#include "logging.hpp"
+#include "utils/dbus_utils.hpp"
+
+#include <boost/asio/post.hpp>
+#include <sdbusplus/asio/connection.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/message.hpp>
+#include <sdbusplus/unpack_properties.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
 namespace redfish
 {
 
-inline void
-    doGetSnmpTrapClientdata(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-                            const std::string& objectPath)
+constexpr const char* snmpService = "xyz.openbmc_project.Network.SNMP";
+constexpr const char* snmpManagerPath =
+    "/xyz/openbmc_project/network/snmp/manager";
+
+struct SnmpTrapClient
 {
-    sdbusplus::asio::getAllProperties(
-        *crow::connections::systemBus, "xyz.openbmc_project.Network.SNMP",
-        objectPath, "xyz.openbmc_project.Network.Client",
-        [asyncResp](const boost::system::error_code ec,
-                    const dbus::utility::DBusPropertiesMap& propertiesList) {
-        if (ec)
+    std::string objectPath;
+    std::string address;
+    uint16_t port = 0;
+};
+
+/**
+ * @brief The SNMP trap clients, as read from one GetManagedObjects of the
+ * SNMP manager, keyed by subscription id: "snmp" and the client's D-Bus id.
+ */
+struct SnmpTrapClients
+{
+    // False if the SNMP service isn't running, in which case there are no
+    // clients
+    bool available = false;
+    std::map<std::string, SnmpTrapClient, std::less<>> clients;
+
+    SnmpTrapClients() = default;
+
+    explicit SnmpTrapClients(const dbus::utility::ManagedObjectType& objects) :
+        available(true)
+    {
+        for (const auto& [objectPath, interfaces] : objects)
         {
-            BMCWEB_LOG_ERROR << "D-Bus response error on GetSubTree " << ec;
-            messages::internalError(asyncResp->res);
-            return;
+            const std::string snmpId = objectPath.filename();
+            if (snmpId.empty())
+            {
+                BMCWEB_LOG_ERROR << "The SNMP client ID is wrong";
+                continue;
+            }
+            SnmpTrapClient& client = clients["snmp" + snmpId];
+            client.objectPath = objectPath.str;
+            for (const auto& [interface, properties] : interfaces)
+            {
+                if (interface != "xyz.openbmc_project.Network.Client")
+                {
+                    continue;
+                }
+                const std::string* address = nullptr;
+                const uint16_t* port = nullptr;
+                if (!sdbusplus::unpackPropertiesNoThrow(
+                        dbus_utils::UnpackErrorPrinter(), properties,
+                        "Address", address, "Port", port))
+                {
+                    continue;
+                }
+                if (address != nullptr && port != nullptr)
+                {
+                    client.address = *address;
+                    client.port = *port;
+                }
+            }
         }
+    }
+};
+
+/**
+ * @brief The last SnmpTrapClients read.
+ *
+ * The clients are read on first use and handed to every request until the
+ * SNMP service signals a change under its tree or changes owner, so the
+ * Subscriptions collection and SNMP subscriptions are served from memory,
+ * alongside the subscriptions EventServiceManager holds, however many
+ * clients there are.  A service that isn't running is remembered too, until
+ * it starts.  Concurrent reads share one call, and a read in flight during a
+ * change isn't kept.
+ */
+class SnmpTrapClientCache
+{
+  public:
+    using Callback =
+        std::function<void(const boost::system::error_code&,
+                           const std::shared_ptr<const SnmpTrapClients>&)>;
+
+    static SnmpTrapClientCache& getInstance()
+    {
+        static SnmpTrapClientCache cache;
+        return cache;
+    }
+
+    SnmpTrapClientCache(const SnmpTrapClientCache&) = delete;
+    SnmpTrapClientCache(SnmpTrapClientCache&&) = delete;
+    SnmpTrapClientCache& operator=(const SnmpTrapClientCache&) = delete;
+    SnmpTrapClientCache& operator=(SnmpTrapClientCache&&) = delete;
+    ~SnmpTrapClientCache() = default;
 
-        const std::string* address = nullptr;
-        const uint16_t* port = nullptr;
+    void registerMatches(sdbusplus::asio::connection& conn)
+    {
+        namespace rules = sdbusplus::bus::match::rules;
+
+        // Clients are added and removed through InterfacesAdded and
+        // InterfacesRemoved on the manager, and edited through
+        // PropertiesChanged on the clients themselves
+        matches.clear();
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn,
+            rules::type::signal() + rules::sender(snmpService) +
+                rules::path_namespace(snmpManagerPath),
+            [this](sdbusplus::message_t& /*msg*/) { clear(); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::nameOwnerChanged() + rules::argN(0, snmpService),
+            [this](sdbusplus::message_t& /*msg*/) { clear(); }));
+        clear();
+    }
 
-        const bool success = sdbusplus::unpackPropertiesNoThrow(
-            dbus_utils::UnpackErrorPrinter(), propertiesList, "Address",
-            address, "Port", port);
+    bool enabled() const
+    {
+        return !matches.empty();
+    }
 
-        if (!success)
+    /**
+     * @brief Calls callback with the SNMP trap clients, reading them if they
+     * aren't cached.  The callback is never called inline.
+     */
+    void get(Callback&& callback)
+    {
+        if (clients)
         {
-            messages::internalError(asyncResp->res);
+            std::shared_ptr<const SnmpTrapClients> current = clients;
+            boost::asio::post(crow::connections::systemBus->get_io_context(),
+                              [current, callback{std::move(callback)}]() {
+                callback(boost::system::error_code(), current);
+            });
             return;
         }
 
-        if (address != nullptr && port != nullptr)
+        callbacks.emplace_back(std::move(callback));
+        if (callbacks.size() > 1)
         {
-            std::string destination = "snmp://";
-            destination.append(*address);
-            destination.append(":");
-            destination.append(std::to_string(*port));
+            return;
+        }
+        crow::dbus_trace::SharedCallScope sharedCalls;
+        crow::connections::systemBus->async_method_call(
+            [this, fetchGeneration{generation}](
+                const boost::system::error_code& ec,
+                const dbus::utility::ManagedObjectType& objects) {
+            afterGetManagedObjects(fetchGeneration, ec, objects);
+        },
+            snmpService, snmpManagerPath, "org.freedesktop.DBus.ObjectManager",
+            "GetManagedObjects");
+    }
+
+    void clear()
+    {
+        clients.reset();
+        generation++;
+    }
 
-            asyncResp->res.jsonValue["Destination"] = std::move(destination);
+  private:
+    SnmpTrapClientCache() = default;
+
+    void afterGetManagedObjects(uint64_t fetchGeneration,
+                                const boost::system::error_code& ec,
+                                const dbus::utility::ManagedObjectType& objects)
+    {
+        std::vector<Callback> waiting = std::move(callbacks);
+        callbacks.clear();
+
+        std::shared_ptr<const SnmpTrapClients> read;
+        if (!ec)
+        {
+            read = std::make_shared<const SnmpTrapClients>(objects);
         }
-    });
-}
+        else if (ec.value() == EBADR)
+        {
+            // The service isn't running
+            read = std::make_shared<const SnmpTrapClients>();
+        }
+        else
+        {
+            BMCWEB_LOG_ERROR << "D-Bus response error on GetManagedObjects "
+                             << ec;
+        }
+        if (read != nullptr && enabled() && fetchGeneration == generation)
+        {
+            clients = read;
+        }
+        for (Callback& callback : waiting)
+        {
+            callback(read != nullptr ? boost::system::error_code() : ec, read);
+        }
+    }
+
+    std::shared_ptr<const SnmpTrapClients> clients;
+    std::vector<Callback> callbacks;
+    uint64_t generation = 0;
+    std::vector<std::unique_ptr<sdbusplus::bus::match_t>> matches;
+};
 
 inline void
     getSnmpTrapClientdata(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-                          const std::string& id, const std::string& objectPath)
+                          const std::string& id, const SnmpTrapClient& client)
 {
     asyncResp->res.jsonValue["@odata.type"] =
         "#EventDestination.v1_8_0.EventDestination";
@@ -69,50 +246,39 @@ inline void
         asyncResp->res.jsonValue["Context"] = "";
     }
 
-    doGetSnmpTrapClientdata(asyncResp, objectPath);
+    if (!client.address.empty())
+    {
+        std::string destination = "snmp://";
+        destination.append(client.address);
+        destination.append(":");
+        destination.append(std::to_string(client.port));
+
+        asyncResp->res.jsonValue["Destination"] = std::move(destination);
+    }
 }
 
 inline void
     getSnmpTrapClient(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
                       const std::string& id)
 {
-    crow::connections::systemBus->async_method_call(
-        [asyncResp, id](const boost::system::error_code ec,
-                        dbus::utility::ManagedObjectType& resp) {
-        if (ec)
+    SnmpTrapClientCache::getInstance().get(
+        [asyncResp, id](const boost::system::error_code& ec,
+                        const std::shared_ptr<const SnmpTrapClients>& read) {
+        if (ec || read == nullptr || !read->available)
         {
-            BMCWEB_LOG_ERROR << "D-Bus response error on GetManagedObjects "
-                             << ec;
             messages::internalError(asyncResp->res);
             return;
         }
 
-        for (const auto& objpath : resp)
+        auto client = read->clients.find(id);
+        if (client == read->clients.end())
         {
-            sdbusplus::message::object_path path(objpath.first);
-            const std::string snmpId = path.filename();
-            if (snmpId.empty())
-            {
-                BMCWEB_LOG_ERROR << "The SNMP client ID is wrong";
-                messages::internalError(asyncResp->res);
-                return;
-            }
-            const std::string subscriptionId = "snmp" + snmpId;
-            if (id != subscriptionId)
-            {
-                continue;
-            }
-
-            getSnmpTrapClientdata(asyncResp, id, objpath.first);
+            messages::resourceNotFound(asyncResp->res, "Subscriptions", id);
+            EventServiceManager::getInstance().deleteSubscription(id);
             return;
         }
-
-        messages::resourceNotFound(asyncResp->res, "Subscriptions", id);
-        EventServiceManager::getInstance().deleteSubscription(id);
-    },
-        "xyz.openbmc_project.Network.SNMP",
-        "/xyz/openbmc_project/network/snmp/manager",
-        "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
+        getSnmpTrapClientdata(asyncResp, id, client->second);
+    });
 }
 
 inline void
@@ -152,6 +318,8 @@ inline void
 
         std::string subscriptionId = "snmp" + snmpId;
 
+        // Don't wait on the signal for the new client to be listed
+        SnmpTrapClientCache::getInstance().clear();
         EventServiceManager::getInstance().addSubscription(subValue,
                                                            subscriptionId);
 
@@ -160,8 +328,7 @@ inline void
                                      subscriptionId);
         messages::created(asyncResp->res);
     },
-        "xyz.openbmc_project.Network.SNMP",
-        "/xyz/openbmc_project/network/snmp/manager",
+        snmpService, snmpManagerPath,
         "xyz.openbmc_project.Network.Client.Create", "Client", host,
         snmpTrapPort);
 }
@@ -242,22 +409,22 @@ inline void
         // Create the snmp client
         createSnmpTrapClient(asyncResp, host, snmpTrapPort, subValue);
     },
-        "xyz.openbmc_project.Network.SNMP",
-        "/xyz/openbmc_project/network/snmp/manager",
+        snmpService, snmpManagerPath,
         "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
 }
 
 inline void
     getSnmpSubscriptionList(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-                            const std::string& snmpId,
+                            const SnmpTrapClients& read,
                             nlohmann::json& memberArray)
 {
-    const std::string subscriptionId = "snmp" + snmpId;
-
-    nlohmann::json::object_t member;
-    member["@odata.id"] = crow::utility::urlFromPieces(
-        "redfish", "v1", "EventService", "Subscriptions", subscriptionId);
-    memberArray.push_back(std::move(member));
+    for (const auto& [subscriptionId, client] : read.clients)
+    {
+        nlohmann::json::object_t member;
+        member["@odata.id"] = crow::utility::urlFromPieces(
+            "redfish", "v1", "EventService", "Subscriptions", subscriptionId);
+        memberArray.push_back(std::move(member));
+    }
 
     asyncResp->res.jsonValue["Members@odata.count"] = memberArray.size();
 }
@@ -290,9 +457,10 @@ inline void
             messages::internalError(asyncResp->res);
             return;
         }
+        SnmpTrapClientCache::getInstance().clear();
         messages::success(asyncResp->res);
     },
-        "xyz.openbmc_project.Network.SNMP", snmpPath,
+        snmpService, snmpPath,
         "xyz.openbmc_project.Object.Delete", "Delete");
 }
 
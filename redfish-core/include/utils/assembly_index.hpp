@@ -0,0 +1,330 @@
+#pragma once
+
+#include "dbus_singleton.hpp"
+#include "dbus_utility.hpp"
+#include "logging.hpp"
+
+#include <boost/asio/post.hpp>
+#include <sdbusplus/asio/connection.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace redfish
+{
+namespace assembly_utils
+{
+
+constexpr std::array<std::string_view, 9> chassisAssemblyIfaces = {
+    "xyz.openbmc_project.Inventory.Item.Vrm",
+    "xyz.openbmc_project.Inventory.Item.Tpm",
+    "xyz.openbmc_project.Inventory.Item.Panel",
+    "xyz.openbmc_project.Inventory.Item.Battery",
+    "xyz.openbmc_project.Inventory.Item.DiskBackplane",
+    "xyz.openbmc_project.Inventory.Item.Board",
+    "xyz.openbmc_project.Inventory.Item.Connector",
+    "xyz.openbmc_project.Inventory.Item.Drive",
+    "xyz.openbmc_project.Inventory.Item.Board.Motherboard"};
+
+using Assemblies = std::vector<std::string>;
+
+/**
+ * @brief The assemblies of a chassis: the endpoints of its assembly
+ * association that implement one of the assembly interfaces, sorted by path.
+ * An assembly's position in the list is its Redfish MemberId.
+ */
+inline Assemblies
+    implementedAssemblies(const dbus::utility::MapperEndPoints& endpoints,
+                          const dbus::utility::MapperGetSubTreeResponse& tree)
+{
+    Assemblies assemblies;
+    for (const auto& [objectPath, serviceMap] : tree)
+    {
+        // Association entries without an implementation are left out
+        if (std::find(endpoints.begin(), endpoints.end(), objectPath) !=
+            endpoints.end())
+        {
+            assemblies.emplace_back(objectPath);
+        }
+    }
+    std::sort(assemblies.begin(), assemblies.end());
+    assemblies.erase(std::unique(assemblies.begin(), assemblies.end()),
+                     assemblies.end());
+    return assemblies;
+}
+
+/**
+ * @brief Holds the assemblies of each chassis once they have been resolved,
+ * so Assembly requests, and the links that refer to an assembly by its
+ * MemberId, don't crawl the chassis's associations again.
+ *
+ * Everything is dropped when an assembly or chassis interface is added or
+ * removed, when the mapper changes an assembly association, or when a well
+ * known name changes owner.
+ */
+class AssemblyIndex
+{
+  public:
+    static constexpr std::string_view mapperService =
+        "xyz.openbmc_project.ObjectMapper";
+    static constexpr std::string_view associationInterface =
+        "xyz.openbmc_project.Association";
+    static constexpr std::string_view chassisInterface =
+        "xyz.openbmc_project.Inventory.Item.Chassis";
+
+    using Callback =
+        std::function<void(const boost::system::error_code&,
+                           const std::shared_ptr<const Assemblies>&)>;
+
+    static AssemblyIndex& getInstance()
+    {
+        static AssemblyIndex index;
+        return index;
+    }
+
+    AssemblyIndex(const AssemblyIndex&) = delete;
+    AssemblyIndex(AssemblyIndex&&) = delete;
+    AssemblyIndex& operator=(const AssemblyIndex&) = delete;
+    AssemblyIndex& operator=(AssemblyIndex&&) = delete;
+    ~AssemblyIndex() = default;
+
+    static bool isTrackedInterface(std::string_view interface)
+    {
+        return interface == chassisInterface ||
+               std::find(chassisAssemblyIfaces.begin(),
+                         chassisAssemblyIfaces.end(),
+                         interface) != chassisAssemblyIfaces.end();
+    }
+
+    void registerMatches(sdbusplus::asio::connection& conn)
+    {
+        namespace rules = sdbusplus::bus::match::rules;
+        std::string mapper(mapperService);
+
+        matches.clear();
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn,
+            rules::type::signal() + rules::sender(mapper) +
+                rules::member("PropertiesChanged") +
+                rules::interface("org.freedesktop.DBus.Properties") +
+                rules::argN(0, std::string(associationInterface)),
+            [this](sdbusplus::message_t& msg) {
+            if (std::string_view(msg.get_path()).ends_with("/assembly"))
+            {
+                clear();
+            }
+        }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::interfacesAdded(),
+            [this](sdbusplus::message_t& msg) { onInterfacesAdded(msg); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::interfacesRemoved(),
+            [this](sdbusplus::message_t& msg) { onInterfacesRemoved(msg); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::nameOwnerChanged(),
+            [this](sdbusplus::message_t& msg) { onNameOwnerChanged(msg); }));
+        clear();
+    }
+
+    bool enabled() const
+    {
+        return !matches.empty();
+    }
+
+    /**
+     * @brief Calls callback with the assemblies of the chassis, resolving
+     * them if they aren't cached.  Concurrent requests for one chassis share
+     * the lookup.  The callback is never called inline.
+     */
+    void get(const std::string& chassisPath, Callback&& callback)
+    {
+        auto cached = chassisAssemblies.find(chassisPath);
+        if (cached != chassisAssemblies.end())
+        {
+            std::shared_ptr<const Assemblies> current = cached->second;
+            boost::asio::post(crow::connections::systemBus->get_io_context(),
+                              [current, callback{std::move(callback)}]() {
+                callback(boost::system::error_code(), current);
+            });
+            return;
+        }
+
+        std::vector<Callback>& waiting = pending[chassisPath];
+        waiting.emplace_back(std::move(callback));
+        if (waiting.size() > 1)
+        {
+            return;
+        }
+        crow::dbus_trace::SharedCallScope sharedCalls;
+        dbus::utility::getAssociationEndPoints(
+            chassisPath + "/assembly",
+            [this, chassisPath, fetchGeneration{generation}](
+                const boost::system::error_code& ec,
+                const dbus::utility::MapperEndPoints& endpoints) {
+            if (ec)
+            {
+                // A chassis without an assembly association has no
+                // assemblies
+                BMCWEB_LOG_DEBUG << "No assembly association on "
+                                 << chassisPath << ": " << ec.message();
+                afterGetEndPoints(chassisPath, fetchGeneration, {});
+                return;
+            }
+            afterGetEndPoints(chassisPath, fetchGeneration, endpoints);
+        });
+    }
+
+    void clear()
+    {
+        chassisAssemblies.clear();
+        generation++;
+    }
+
+  private:
+    AssemblyIndex() = default;
+
+    void afterGetEndPoints(const std::string& chassisPath,
+                           uint64_t fetchGeneration,
+                           const dbus::utility::MapperEndPoints& endpoints)
+    {
+        if (endpoints.empty())
+        {
+            finish(chassisPath, fetchGeneration, boost::system::error_code(),
+                   std::make_shared<const Assemblies>());
+            return;
+        }
+        dbus::utility::getSubTree(
+            "/xyz/openbmc_project/inventory", 0, chassisAssemblyIfaces,
+            [this, chassisPath, fetchGeneration,
+             endpoints](const boost::system::error_code& ec,
+                        const dbus::utility::MapperGetSubTreeResponse& tree) {
+            if (ec)
+            {
+                BMCWEB_LOG_DEBUG << "D-Bus response error on GetSubTree "
+                                 << ec;
+                finish(chassisPath, fetchGeneration, ec, nullptr);
+                return;
+            }
+            finish(chassisPath, fetchGeneration, ec,
+                   std::make_shared<const Assemblies>(
+                       implementedAssemblies(endpoints, tree)));
+        });
+    }
+
+    void finish(const std::string& chassisPath, uint64_t fetchGeneration,
+                const boost::system::error_code& ec,
+                const std::shared_ptr<const Assemblies>& assemblies)
+    {
+        std::vector<Callback> waiting;
+        auto it = pending.find(chassisPath);
+        if (it != pending.end())
+        {
+            waiting = std::move(it->second);
+            pending.erase(it);
+        }
+        // A change signalled while the lookup was in flight may not be in
+        // its result, so only keep it if nothing changed meanwhile
+        if (assemblies && enabled() && fetchGeneration == generation)
+        {
+            chassisAssemblies.insert_or_assign(chassisPath, assemblies);
+        }
+        for (Callback& callback : waiting)
+        {
+            callback(ec, assemblies);
+        }
+    }
+
+    void onInterfacesAdded(sdbusplus::message_t& msg)
+    {
+        sdbusplus::message::object_path path;
+        dbus::utility::DBusInteracesMap interfaces;
+        try
+        {
+            msg.read(path, interfaces);
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            BMCWEB_LOG_ERROR << "Failed to read added interfaces: "
+                             << e.what();
+            clear();
+            return;
+        }
+        for (const auto& [interface, properties] : interfaces)
+        {
+            if (isTrackedInterface(interface) ||
+                (interface == associationInterface &&
+                 path.str.ends_with("/assembly")))
+            {
+                clear();
+                return;
+            }
+        }
+    }
+
+    void onInterfacesRemoved(sdbusplus::message_t& msg)
+    {
+        sdbusplus::message::object_path path;
+        std::vector<std::string> interfaces;
+        try
+        {
+            msg.read(path, interfaces);
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            BMCWEB_LOG_ERROR << "Failed to read removed interfaces: "
+                             << e.what();
+            clear();
+            return;
+        }
+        for (const std::string& interface : interfaces)
+        {
+            if (isTrackedInterface(interface) ||
+                (interface == associationInterface &&
+                 path.str.ends_with("/assembly")))
+            {
+                clear();
+                return;
+            }
+        }
+    }
+
+    // A service coming or going can take assemblies with it without
+    // signalling them one by one; unique names are only clients
+    void onNameOwnerChanged(sdbusplus::message_t& msg)
+    {
+        std::string name;
+        try
+        {
+            msg.read(name);
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            BMCWEB_LOG_ERROR << "Failed to read owner change: " << e.what();
+            clear();
+            return;
+        }
+        if (!name.starts_with(':'))
+        {
+            clear();
+        }
+    }
+
+    std::unordered_map<std::string, std::shared_ptr<const Assemblies>>
+        chassisAssemblies;
+    std::unordered_map<std::string, std::vector<Callback>> pending;
+    uint64_t generation = 0;
+    std::vector<std::unique_ptr<sdbusplus::bus::match_t>> matches;
+};
+
+} // namespace assembly_utils
+} // namespace redfish
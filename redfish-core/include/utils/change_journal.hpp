@@ -0,0 +1,128 @@
+#pragma once
+
+#include "utils/hex_utils.hpp"
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <optional>
+#include <random>
+#include <set>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+namespace redfish
+{
+
+/**
+ * @brief The most recent changes to the members of a collection, so a client
+ * can ask for what changed since it last looked rather than reading it all
+ * again.
+ *
+ * A cache that applies D-Bus signals records the key of each object a signal
+ * touches, under a version that goes up by one with every record.  A token
+ * names a version; changedSince() gives the keys recorded after it.  Only the
+ * last capacity records are kept, and reset() forgets them all for changes
+ * that can't be told object by object, so a token that is too old, from
+ * before a reset or from another journal, isn't answered and the client has
+ * to read the whole collection again.  Tokens hold a number drawn when the
+ * journal is made, so they don't outlive a restart either.
+ */
+class ChangeJournal
+{
+  public:
+    static constexpr size_t defaultCapacity = 256;
+
+    explicit ChangeJournal(size_t capacityIn = defaultCapacity) :
+        capacity(capacityIn), instance(std::random_device{}())
+    {
+        instance = (instance << 32) | std::random_device{}();
+    }
+
+    // Records that the object at key changed
+    void record(std::string_view key)
+    {
+        version++;
+        entries.emplace_back(version, std::string(key));
+        while (entries.size() > capacity)
+        {
+            oldest = entries.front().first;
+            entries.pop_front();
+        }
+    }
+
+    // Drops every record, for a change that can't be told object by object
+    void reset()
+    {
+        entries.clear();
+        version++;
+        oldest = version;
+    }
+
+    // The token for the changes recorded so far
+    std::string token() const
+    {
+        return intToHexString(instance, 16) + intToHexString(version, 16);
+    }
+
+    /**
+     * @brief The keys of the objects changed since token was handed out, each
+     * once, or nullopt if that isn't known anymore.
+     */
+    std::optional<std::set<std::string, std::less<>>>
+        changedSince(std::string_view sinceToken) const
+    {
+        std::optional<uint64_t> since = parseToken(sinceToken);
+        if (!since || *since < oldest || *since > version)
+        {
+            return std::nullopt;
+        }
+        std::set<std::string, std::less<>> changed;
+        for (const auto& [entryVersion, key] : entries)
+        {
+            if (entryVersion > *since)
+            {
+                changed.emplace(key);
+            }
+        }
+        return changed;
+    }
+
+  private:
+    // The version in token, if it's one of this journal's
+    std::optional<uint64_t> parseToken(std::string_view sinceToken) const
+    {
+        if (sinceToken.size() != 32)
+        {
+            return std::nullopt;
+        }
+        uint64_t tokenInstance = 0;
+        uint64_t tokenVersion = 0;
+        const char* begin = sinceToken.data();
+        auto instanceResult = std::from_chars(begin, begin + 16, tokenInstance,
+                                              16);
+        auto versionResult = std::from_chars(begin + 16, begin + 32,
+                                             tokenVersion, 16);
+        if (instanceResult.ec != std::errc() ||
+            instanceResult.ptr != begin + 16 ||
+            versionResult.ec != std::errc() ||
+            versionResult.ptr != begin + 32 || tokenInstance != instance)
+        {
+            return std::nullopt;
+        }
+        return tokenVersion;
+    }
+
+    size_t capacity;
+    uint64_t instance;
+    uint64_t version = 0;
+    // Tokens of versions older than this are no longer answered
+    uint64_t oldest = 0;
+    std::deque<std::pair<uint64_t, std::string>> entries;
+};
+
+} // namespace redfish
@@ -0,0 +1,355 @@
+#pragma once
+
+#include "dbus_singleton.hpp"
+#include "dbus_utility.hpp"
+#include "logging.hpp"
+
+#include <boost/asio/post.hpp>
+#include <boost/container/flat_map.hpp>
+#include <sdbusplus/asio/connection.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace redfish
+{
+namespace chassis_utils
+{
+
+constexpr std::array<std::string_view, 1> chassisInterfaces = {
+    "xyz.openbmc_project.Inventory.Item.Chassis"};
+
+/**
+ * @brief A chassis: its Redfish ID, inventory path and the services the
+ * mapper lists for it, with the endpoints of its all_sensors association,
+ * or nullopt if it has none.
+ */
+struct ChassisNode
+{
+    std::string id;
+    std::string path;
+    dbus::utility::MapperServiceMap services;
+    std::optional<std::vector<std::string>> sensors;
+};
+
+/**
+ * @brief Every chassis in the inventory, sorted by path, and indexed by ID
+ * so a chassis sub-resource starts from a single lookup.
+ */
+class ChassisGraph
+{
+  public:
+    explicit ChassisGraph(std::vector<ChassisNode>&& nodesIn) :
+        chassisNodes(std::move(nodesIn))
+    {
+        for (size_t index = 0; index < chassisNodes.size(); index++)
+        {
+            // The first chassis with an ID is the one requests resolve to
+            byId.emplace(chassisNodes[index].id, index);
+        }
+    }
+
+    // The chassis with this ID, or nullptr if there is none
+    const ChassisNode* find(std::string_view id) const
+    {
+        auto it = byId.find(id);
+        if (it == byId.end())
+        {
+            return nullptr;
+        }
+        return &chassisNodes[it->second];
+    }
+
+    const std::vector<ChassisNode>& nodes() const
+    {
+        return chassisNodes;
+    }
+
+  private:
+    std::vector<ChassisNode> chassisNodes;
+    boost::container::flat_map<std::string, size_t, std::less<>> byId;
+};
+
+/**
+ * @brief Holds the ChassisGraph, so the Chassis, Power, Thermal, Sensor and
+ * EnvironmentMetrics handlers don't each list the chassis through the mapper
+ * and then resolve its sensors.
+ *
+ * The graph is read on first use and dropped when a chassis interface is
+ * added or removed, when the mapper changes an all_sensors association, or
+ * when a well known name changes owner; then it is read again on next use.
+ * Concurrent reads share one fetch, and a fetch that was in flight when
+ * the graph changed is answered but not kept.
+ */
+class ChassisGraphCache
+{
+  public:
+    static constexpr std::string_view mapperService =
+        "xyz.openbmc_project.ObjectMapper";
+    static constexpr std::string_view associationInterface =
+        "xyz.openbmc_project.Association";
+
+    using Callback =
+        std::function<void(const boost::system::error_code&,
+                           const std::shared_ptr<const ChassisGraph>&)>;
+
+    static ChassisGraphCache& getInstance()
+    {
+        static ChassisGraphCache cache;
+        return cache;
+    }
+
+    ChassisGraphCache(const ChassisGraphCache&) = delete;
+    ChassisGraphCache(ChassisGraphCache&&) = delete;
+    ChassisGraphCache& operator=(const ChassisGraphCache&) = delete;
+    ChassisGraphCache& operator=(ChassisGraphCache&&) = delete;
+    ~ChassisGraphCache() = default;
+
+    static bool isTrackedAssociation(std::string_view path)
+    {
+        return path.ends_with("/all_sensors");
+    }
+
+    void registerMatches(sdbusplus::asio::connection& conn)
+    {
+        namespace rules = sdbusplus::bus::match::rules;
+        std::string mapper(mapperService);
+
+        matches.clear();
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn,
+            rules::type::signal() + rules::sender(mapper) +
+                rules::member("PropertiesChanged") +
+                rules::interface("org.freedesktop.DBus.Properties") +
+                rules::argN(0, std::string(associationInterface)),
+            [this](sdbusplus::message_t& msg) {
+            if (isTrackedAssociation(msg.get_path()))
+            {
+                clear();
+            }
+        }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::interfacesAdded(),
+            [this](sdbusplus::message_t& msg) { onInterfacesAdded(msg); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::interfacesRemoved(),
+            [this](sdbusplus::message_t& msg) { onInterfacesRemoved(msg); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::nameOwnerChanged(), [this](sdbusplus::message_t& msg) {
+            std::string name;
+            msg.read(name);
+            if (!name.starts_with(':'))
+            {
+                clear();
+            }
+        }));
+        clear();
+    }
+
+    bool enabled() const
+    {
+        return !matches.empty();
+    }
+
+    /**
+     * @brief Calls callback with the chassis graph, reading it if it isn't
+     * cached.  The callback is never called inline.
+     */
+    void get(Callback&& callback)
+    {
+        if (graph)
+        {
+            std::shared_ptr<const ChassisGraph> current = graph;
+            boost::asio::post(crow::connections::systemBus->get_io_context(),
+                              [current, callback{std::move(callback)}]() {
+                callback(boost::system::error_code(), current);
+            });
+            return;
+        }
+
+        callbacks.emplace_back(std::move(callback));
+        if (callbacks.size() > 1)
+        {
+            return;
+        }
+        crow::dbus_trace::SharedCallScope sharedCalls;
+        dbus::utility::getSubTree(
+            "/xyz/openbmc_project/inventory", 0, chassisInterfaces,
+            [this, fetchGeneration{generation}](
+                const boost::system::error_code& ec,
+                const dbus::utility::MapperGetSubTreeResponse& subtree) {
+            if (ec)
+            {
+                BMCWEB_LOG_ERROR << "Chassis mapper call error: " << ec;
+                complete(fetchGeneration, ec, nullptr);
+                return;
+            }
+            readSensors(fetchGeneration, subtree);
+        });
+    }
+
+    void clear()
+    {
+        graph.reset();
+        generation++;
+    }
+
+  private:
+    // Completes the fetch once the sensors of every chassis have been read
+    struct Fetch
+    {
+        Fetch(ChassisGraphCache& cacheIn, uint64_t fetchGenerationIn) :
+            cache(cacheIn), fetchGeneration(fetchGenerationIn)
+        {}
+
+        ~Fetch()
+        {
+            cache.complete(fetchGeneration, ec,
+                           std::make_shared<const ChassisGraph>(
+                               std::move(nodes)));
+        }
+
+        Fetch(const Fetch&) = delete;
+        Fetch(Fetch&&) = delete;
+        Fetch& operator=(const Fetch&) = delete;
+        Fetch& operator=(Fetch&&) = delete;
+
+        ChassisGraphCache& cache;
+        uint64_t fetchGeneration;
+        // Set if an association couldn't be read, so the graph isn't kept
+        boost::system::error_code ec;
+        std::vector<ChassisNode> nodes;
+    };
+
+    ChassisGraphCache() = default;
+
+    void readSensors(uint64_t fetchGeneration,
+                     const dbus::utility::MapperGetSubTreeResponse& subtree)
+    {
+        auto fetch = std::make_shared<Fetch>(*this, fetchGeneration);
+        for (const auto& [path, services] : subtree)
+        {
+            std::string id = sdbusplus::message::object_path(path).filename();
+            if (id.empty())
+            {
+                BMCWEB_LOG_ERROR << "Failed to find '/' in " << path;
+                continue;
+            }
+            fetch->nodes.emplace_back(
+                ChassisNode{std::move(id), path, services, std::nullopt});
+        }
+        for (size_t index = 0; index < fetch->nodes.size(); index++)
+        {
+            dbus::utility::getAssociationEndPoints(
+                fetch->nodes[index].path + "/all_sensors",
+                [fetch, index](const boost::system::error_code& ec,
+                               const dbus::utility::MapperEndPoints& sensors) {
+                if (ec)
+                {
+                    // EBADR only means the chassis has no sensors
+                    if (ec.value() != EBADR)
+                    {
+                        BMCWEB_LOG_ERROR << "Chassis sensors error: " << ec;
+                        fetch->ec = ec;
+                    }
+                    return;
+                }
+                fetch->nodes[index].sensors = sensors;
+            });
+        }
+    }
+
+    void complete(uint64_t fetchGeneration, const boost::system::error_code& ec,
+                  const std::shared_ptr<const ChassisGraph>& read)
+    {
+        std::vector<Callback> waiting = std::move(callbacks);
+        callbacks.clear();
+
+        if (read != nullptr && !ec && enabled() &&
+            fetchGeneration == generation)
+        {
+            graph = read;
+        }
+        for (Callback& callback : waiting)
+        {
+            callback(read == nullptr ? ec : boost::system::error_code(), read);
+        }
+    }
+
+    static bool isTrackedChange(const std::string& path,
+                                std::string_view interface)
+    {
+        return interface == chassisInterfaces[0] ||
+               (interface == associationInterface &&
+                isTrackedAssociation(path));
+    }
+
+    void onInterfacesAdded(sdbusplus::message_t& msg)
+    {
+        sdbusplus::message::object_path path;
+        dbus::utility::DBusInteracesMap interfaces;
+        try
+        {
+            msg.read(path, interfaces);
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            BMCWEB_LOG_ERROR << "Failed to read added interfaces: "
+                             << e.what();
+            clear();
+            return;
+        }
+        for (const auto& [interface, properties] : interfaces)
+        {
+            if (isTrackedChange(path.str, interface))
+            {
+                clear();
+                return;
+            }
+        }
+    }
+
+    void onInterfacesRemoved(sdbusplus::message_t& msg)
+    {
+        sdbusplus::message::object_path path;
+        std::vector<std::string> interfaces;
+        try
+        {
+            msg.read(path, interfaces);
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            BMCWEB_LOG_ERROR << "Failed to read removed interfaces: "
+                             << e.what();
+            clear();
+            return;
+        }
+        for (const std::string& interface : interfaces)
+        {
+            if (isTrackedChange(path.str, interface))
+            {
+                clear();
+                return;
+            }
+        }
+    }
+
+    std::shared_ptr<const ChassisGraph> graph;
+    std::vector<Callback> callbacks;
+    uint64_t generation = 0;
+    std::vector<std::unique_ptr<sdbusplus::bus::match_t>> matches;
+};
+
+} // namespace chassis_utils
+} // namespace redfish
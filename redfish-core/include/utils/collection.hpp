@@ -9,10 +9,14 @@
 #include <boost/url/url.hpp>
 #include <nlohmann/json.hpp>
 
+#include <algorithm>
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <span>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace redfish
@@ -20,6 +24,37 @@ namespace redfish
 namespace collection_util
 {
 
+/**
+ * @brief A built and sorted Members array.  It goes stale as soon as
+ * DbusObjectCache::getMapperGeneration() moves past mapperGeneration, i.e.
+ * when an InterfacesAdded/InterfacesRemoved could have changed membership.
+ */
+struct CachedCollectionMembers
+{
+    uint64_t mapperGeneration = 0;
+    std::shared_ptr<const nlohmann::json> members;
+};
+
+// Keyed by collectionMembersKey()
+inline std::unordered_map<std::string, CachedCollectionMembers>&
+    getCollectionMembersCache()
+{
+    static std::unordered_map<std::string, CachedCollectionMembers> cache;
+    return cache;
+}
+
+inline std::string
+    collectionMembersKey(const boost::urls::url& collectionPath,
+                         std::string_view subtree,
+                         std::span<const std::string_view> interfaces)
+{
+    std::string key(collectionPath.buffer());
+    key += '|';
+    key += dbus::utility::DbusObjectCache::mapperKey("GetSubTreePaths",
+                                                     subtree, 0, interfaces);
+    return key;
+}
+
 /**
  * @brief Populate the collection "Members" from a GetSubTreePaths search of
  *        inventory
@@ -45,10 +80,29 @@ inline void getCollectionMembersWithPathConversion(
 {
     BMCWEB_LOG_DEBUG << "Get collection members for: "
                      << collectionPath.buffer();
+    const dbus::utility::DbusObjectCache& objectCache =
+        dbus::utility::DbusObjectCache::getInstance();
+    std::string key = collectionMembersKey(collectionPath, subtree, interfaces);
+    if (objectCache.enabled())
+    {
+        auto cached = getCollectionMembersCache().find(key);
+        if (cached != getCollectionMembersCache().end() &&
+            cached->second.mapperGeneration ==
+                objectCache.getMapperGeneration())
+        {
+            const nlohmann::json& members = *cached->second.members;
+            aResp->res.jsonValue["Members"] = members;
+            aResp->res.jsonValue["Members@odata.count"] = members.size();
+            return;
+        }
+    }
+
+    uint64_t generation = objectCache.getMapperGeneration();
     dbus::utility::getSubTreePaths(
         subtree, 0, interfaces,
         [collectionPath, aResp{std::move(aResp)},
-         getMembersFromPaths{std::move(getMembersFromPaths)}](
+         getMembersFromPaths{std::move(getMembersFromPaths)},
+         key{std::move(key)}, generation](
             const boost::system::error_code& ec,
             const dbus::utility::MapperGetSubTreePathsResponse& objects) {
         if (ec == boost::system::errc::io_error)
@@ -68,8 +122,7 @@ inline void getCollectionMembersWithPathConversion(
         std::vector<std::string> pathNames;
         getMembersFromPaths(pathNames, objects);
 
-        std::sort(pathNames.begin(), pathNames.end(),
-                  AlphanumLess<std::string>());
+        alphanumSort(pathNames.begin(), pathNames.end());
 
         nlohmann::json& members = aResp->res.jsonValue["Members"];
         members = nlohmann::json::array();
@@ -82,6 +135,22 @@ inline void getCollectionMembersWithPathConversion(
             members.push_back(std::move(member));
         }
         aResp->res.jsonValue["Members@odata.count"] = members.size();
+
+        const dbus::utility::DbusObjectCache& cache =
+            dbus::utility::DbusObjectCache::getInstance();
+        if (cache.enabled() && generation == cache.getMapperGeneration())
+        {
+            auto& collections = getCollectionMembersCache();
+            if (collections.size() >=
+                dbus::utility::DbusObjectCache::maxEntries)
+            {
+                collections.clear();
+            }
+            collections.insert_or_assign(
+                key, CachedCollectionMembers{
+                         generation,
+                         std::make_shared<const nlohmann::json>(members)});
+        }
     });
 }
 
@@ -0,0 +1,207 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <utility>
+
+// IWYU pragma: no_include <stddef.h>
+
+namespace redfish
+{
+
+namespace enum_utils
+{
+
+namespace details
+{
+
+template <typename Value, size_t N>
+constexpr std::array<std::pair<std::string_view, Value>, N>
+    sortByKey(std::array<std::pair<std::string_view, Value>, N> entries)
+{
+    std::sort(entries.begin(), entries.end(),
+              [](const std::pair<std::string_view, Value>& a,
+                 const std::pair<std::string_view, Value>& b) {
+        return a.first < b.first;
+    });
+    return entries;
+}
+
+template <typename Value, size_t N>
+constexpr const Value*
+    findByKey(const std::array<std::pair<std::string_view, Value>, N>& sorted,
+              std::string_view key)
+{
+    const auto* it = std::lower_bound(
+        sorted.begin(), sorted.end(), key,
+        [](const std::pair<std::string_view, Value>& entry,
+           std::string_view k) { return entry.first < k; });
+    if (it == sorted.end() || it->first != key)
+    {
+        return nullptr;
+    }
+    return &it->second;
+}
+
+} // namespace details
+
+/**
+ * @brief The strings of a generated Redfish enum, in both directions.
+ *
+ * Generated enums count up from Invalid = 0 in schema order, so a value's
+ * string is an index into names, and a string's value is a binary search of
+ * the same names sorted when the table is built at compile time.  Anything
+ * that isn't one of the names reads as Invalid, and anything out of range
+ * writes as "Invalid", as NLOHMANN_JSON_SERIALIZE_ENUM did with its first
+ * pair.
+ */
+template <typename Enum, size_t N>
+class EnumTable
+{
+  public:
+    constexpr explicit EnumTable(const std::array<std::string_view, N>& in) :
+        names(in), byName(sortNames(in))
+    {}
+
+    constexpr std::string_view toString(Enum value) const
+    {
+        size_t index = static_cast<size_t>(value);
+        if (index >= N)
+        {
+            return names[0];
+        }
+        return names[index];
+    }
+
+    constexpr Enum fromString(std::string_view name) const
+    {
+        const Enum* value = details::findByKey(byName, name);
+        if (value == nullptr)
+        {
+            return static_cast<Enum>(0);
+        }
+        return *value;
+    }
+
+    template <typename BasicJsonType>
+    Enum fromJson(const BasicJsonType& j) const
+    {
+        const typename BasicJsonType::string_t* name =
+            j.template get_ptr<const typename BasicJsonType::string_t*>();
+        if (name == nullptr)
+        {
+            return static_cast<Enum>(0);
+        }
+        return fromString(*name);
+    }
+
+  private:
+    static constexpr std::array<std::pair<std::string_view, Enum>, N>
+        sortNames(const std::array<std::string_view, N>& in)
+    {
+        std::array<std::pair<std::string_view, Enum>, N> entries{};
+        for (size_t i = 0; i < N; i++)
+        {
+            entries[i] = {in[i], static_cast<Enum>(i)};
+        }
+        return details::sortByKey(entries);
+    }
+
+    std::array<std::string_view, N> names;
+    std::array<std::pair<std::string_view, Enum>, N> byName;
+};
+
+template <typename Enum, size_t N>
+constexpr EnumTable<Enum, N>
+    makeEnumTable(const std::array<std::string_view, N>& names)
+{
+    return EnumTable<Enum, N>(names);
+}
+
+/**
+ * @brief A fixed map from strings, typically D-Bus enum values, to Value,
+ * sorted at compile time so lookups are a binary search rather than a chain
+ * of string compares.
+ */
+template <typename Value, size_t N>
+class StringMap
+{
+  public:
+    constexpr explicit StringMap(
+        const std::array<std::pair<std::string_view, Value>, N>& entries) :
+        sorted(details::sortByKey(entries))
+    {}
+
+    // Returns nullptr if key isn't in the map
+    constexpr const Value* find(std::string_view key) const
+    {
+        return details::findByKey(sorted, key);
+    }
+
+    constexpr Value get(std::string_view key, Value fallback) const
+    {
+        const Value* value = find(key);
+        if (value == nullptr)
+        {
+            return fallback;
+        }
+        return *value;
+    }
+
+  private:
+    std::array<std::pair<std::string_view, Value>, N> sorted;
+};
+
+// Value must be given explicitly, N is deduced from the entries
+template <typename Value, size_t N>
+constexpr StringMap<Value, N> makeStringMap(
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+    const std::pair<std::string_view, Value> (&entries)[N])
+{
+    return StringMap<Value, N>(std::to_array(entries));
+}
+
+/**
+ * @brief Looks up the string of any generated Redfish enum value.
+ */
+template <typename Enum>
+std::string_view toString(Enum value)
+{
+    return enumTable(value).toString(value);
+}
+
+/**
+ * @brief Looks up the generated Redfish enum value of a string; Invalid if
+ * it isn't one.
+ */
+template <typename Enum>
+Enum fromString(std::string_view name)
+{
+    return enumTable(Enum{}).fromString(name);
+}
+
+} // namespace enum_utils
+} // namespace redfish
+
+// Declares the string table of a generated Redfish enum along with its
+// nlohmann::json conversions; the strings are listed in value order.
+#define REDFISH_ENUM_TABLE(ENUM_TYPE, ...)                                     \
+    inline const auto& enumTable(ENUM_TYPE /*unused*/)                         \
+    {                                                                          \
+        static constexpr auto table =                                          \
+            redfish::enum_utils::makeEnumTable<ENUM_TYPE>(                     \
+                std::to_array<std::string_view>({__VA_ARGS__}));               \
+        return table;                                                          \
+    }                                                                          \
+    template <typename BasicJsonType>                                          \
+    inline void to_json(BasicJsonType& j, const ENUM_TYPE& e)                  \
+    {                                                                          \
+        j = enumTable(e).toString(e);                                          \
+    }                                                                          \
+    template <typename BasicJsonType>                                          \
+    inline void from_json(const BasicJsonType& j, ENUM_TYPE& e)                \
+    {                                                                          \
+        e = enumTable(e).fromJson(j);                                          \
+    }
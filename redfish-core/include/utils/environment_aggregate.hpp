@@ -0,0 +1,298 @@
+#pragma once
+
+#include "sensor_reading_cache.hpp"
+#include "utils/chassis_graph.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace redfish
+{
+namespace chassis_utils
+{
+
+/**
+ * @brief The readings of a set of sensors, with their running count, sum,
+ * minimum and maximum.
+ *
+ * refresh() only applies the members whose reading has changed since it was
+ * last applied, moving the sum by the difference.  The minimum and maximum
+ * are only looked for again when the member that held one of them changes.
+ */
+class SensorAggregate
+{
+  public:
+    struct Member
+    {
+        std::string path;
+        std::optional<double> value;
+        uint64_t version = 0;
+    };
+
+    SensorAggregate() = default;
+
+    explicit SensorAggregate(std::vector<std::string> paths)
+    {
+        std::sort(paths.begin(), paths.end());
+        members.reserve(paths.size());
+        for (std::string& path : paths)
+        {
+            members.push_back({std::move(path), std::nullopt, 0});
+        }
+    }
+
+    /**
+     * @brief Brings the readings up to date.  lookup(path) returns the
+     * SensorReadingCache::Reading of a sensor, or nullptr if it has none.
+     */
+    template <typename Lookup>
+    void refresh(const Lookup& lookup)
+    {
+        for (Member& member : members)
+        {
+            const dbus::utility::SensorReadingCache::Reading* reading =
+                lookup(member.path);
+            if (reading == nullptr)
+            {
+                if (member.value)
+                {
+                    remove(*member.value);
+                    member.value.reset();
+                }
+                continue;
+            }
+            if (member.value && member.version == reading->version)
+            {
+                continue;
+            }
+            if (member.value)
+            {
+                remove(*member.value);
+            }
+            add(reading->value);
+            member.value = reading->value;
+            member.version = reading->version;
+        }
+        if (extremesStale)
+        {
+            findExtremes();
+        }
+    }
+
+    // The members, sorted by path; those without a reading have no value
+    const std::vector<Member>& sensors() const
+    {
+        return members;
+    }
+
+    // The number of members with a reading
+    size_t count() const
+    {
+        return present;
+    }
+
+    double sum() const
+    {
+        return total;
+    }
+
+    std::optional<double> average() const
+    {
+        if (present == 0)
+        {
+            return std::nullopt;
+        }
+        return total / static_cast<double>(present);
+    }
+
+    std::optional<double> minimum() const
+    {
+        if (present == 0)
+        {
+            return std::nullopt;
+        }
+        return lowest;
+    }
+
+    std::optional<double> maximum() const
+    {
+        if (present == 0)
+        {
+            return std::nullopt;
+        }
+        return highest;
+    }
+
+  private:
+    void add(double value)
+    {
+        if (present == 0 || value < lowest)
+        {
+            lowest = value;
+        }
+        if (present == 0 || value > highest)
+        {
+            highest = value;
+        }
+        present++;
+        total += value;
+    }
+
+    void remove(double value)
+    {
+        present--;
+        total -= value;
+        if (value <= lowest || value >= highest)
+        {
+            extremesStale = true;
+        }
+    }
+
+    // Also sums the readings again, so rounding in the running sum doesn't
+    // build up
+    void findExtremes()
+    {
+        extremesStale = false;
+        present = 0;
+        total = 0.0;
+        for (const Member& member : members)
+        {
+            if (member.value)
+            {
+                add(*member.value);
+            }
+        }
+    }
+
+    std::vector<Member> members;
+    size_t present = 0;
+    double total = 0.0;
+    double lowest = 0.0;
+    double highest = 0.0;
+    bool extremesStale = false;
+};
+
+// The sensors of a chassis the environment resources report on, by type.
+// Fans aren't here; EnvironmentMetrics finds them through cooled_by.
+struct ChassisEnvironment
+{
+    SensorAggregate temperatures;
+    SensorAggregate power;
+};
+
+/**
+ * @brief Keeps a ChassisEnvironment for each chassis, so ThermalMetrics is
+ * answered from the SensorReadingCache and the running aggregates instead of
+ * reading each sensor again.
+ *
+ * The sensors of each chassis come from its all_sensors association in the
+ * ChassisGraph, and are taken again when the graph is replaced.  Readings
+ * are brought up to date on each use.
+ */
+class EnvironmentAggregator
+{
+  public:
+    static EnvironmentAggregator& getInstance()
+    {
+        static EnvironmentAggregator aggregator;
+        return aggregator;
+    }
+
+    EnvironmentAggregator(const EnvironmentAggregator&) = delete;
+    EnvironmentAggregator(EnvironmentAggregator&&) = delete;
+    EnvironmentAggregator& operator=(const EnvironmentAggregator&) = delete;
+    EnvironmentAggregator& operator=(EnvironmentAggregator&&) = delete;
+    ~EnvironmentAggregator() = default;
+
+    /**
+     * @brief The environment of chassisId, with readings from the
+     * SensorReadingCache, or nullptr if graph has no such chassis.  Valid
+     * until the next call.
+     */
+    const ChassisEnvironment*
+        get(const std::shared_ptr<const ChassisGraph>& graph,
+            const std::string& chassisId)
+    {
+        if (graph != builtFrom)
+        {
+            byChassis.clear();
+            builtFrom = graph;
+        }
+        auto it = byChassis.find(chassisId);
+        if (it == byChassis.end())
+        {
+            const ChassisNode* chassis = graph->find(chassisId);
+            if (chassis == nullptr)
+            {
+                return nullptr;
+            }
+            it = byChassis.emplace(chassisId, makeEnvironment(*chassis)).first;
+        }
+
+        const dbus::utility::SensorReadingCache& cache =
+            dbus::utility::SensorReadingCache::getInstance();
+        auto lookup = [&cache](const std::string& path) {
+            return cache.findReading(path);
+        };
+        it->second.temperatures.refresh(lookup);
+        it->second.power.refresh(lookup);
+        return &it->second;
+    }
+
+    static ChassisEnvironment makeEnvironment(const ChassisNode& chassis)
+    {
+        std::vector<std::string> temperatures;
+        std::vector<std::string> power;
+        if (chassis.sensors)
+        {
+            for (const std::string& path : *chassis.sensors)
+            {
+                std::string_view type = sensorType(path);
+                if (type == "temperature")
+                {
+                    temperatures.push_back(path);
+                }
+                else if (type == "power")
+                {
+                    power.push_back(path);
+                }
+            }
+        }
+        return {SensorAggregate(std::move(temperatures)),
+                SensorAggregate(std::move(power))};
+    }
+
+    // The type of a /xyz/openbmc_project/sensors/<type>/<name> path
+    static std::string_view sensorType(std::string_view path)
+    {
+        constexpr std::string_view prefix = "/xyz/openbmc_project/sensors/";
+        if (!path.starts_with(prefix))
+        {
+            return "";
+        }
+        path.remove_prefix(prefix.size());
+        size_t slash = path.find('/');
+        if (slash == std::string_view::npos)
+        {
+            return "";
+        }
+        return path.substr(0, slash);
+    }
+
+  private:
+    EnvironmentAggregator() = default;
+
+    std::shared_ptr<const ChassisGraph> builtFrom;
+    std::unordered_map<std::string, ChassisEnvironment> byChassis;
+};
+
+} // namespace chassis_utils
+} // namespace redfish
@@ -0,0 +1,422 @@
+#pragma once
+
+#include "dbus_singleton.hpp"
+#include "dbus_utility.hpp"
+#include "human_sort.hpp"
+#include "logging.hpp"
+#include "utils/fabric_util.hpp"
+
+#include <boost/asio/post.hpp>
+#include <sdbusplus/asio/connection.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace redfish
+{
+namespace fabric_util
+{
+
+/**
+ * @brief The fabric adapters, their ports and the cables under the
+ * inventory, as built from one GetSubTree of the three interfaces.
+ *
+ * Adapters are found by the unique id Redfish knows them by and ports by
+ * their adapter, so neither the adapter ids nor the ports of an adapter are
+ * worked out again per request.  What the cables connect is held in their
+ * associations, which are always read live.
+ */
+class FabricTopology
+{
+  public:
+    static constexpr std::string_view adapterInterface =
+        "xyz.openbmc_project.Inventory.Item.FabricAdapter";
+    static constexpr std::string_view portInterface =
+        "xyz.openbmc_project.Inventory.Item.Connector";
+    static constexpr std::string_view cableInterface =
+        "xyz.openbmc_project.Inventory.Item.Cable";
+    static constexpr std::array<std::string_view, 3> interfaces = {
+        adapterInterface, portInterface, cableInterface};
+
+    struct Object
+    {
+        std::string path;
+        std::string id;
+        dbus::utility::MapperServiceMap serviceMap;
+    };
+
+    struct Adapter : Object
+    {
+        // Indexes of the ports directly under the adapter, in path order
+        std::vector<size_t> ports;
+        // Ports anywhere under the adapter, by id
+        std::unordered_map<std::string, size_t> portIndex;
+    };
+
+    static bool isTopologyInterface(std::string_view interface)
+    {
+        return std::find(interfaces.begin(), interfaces.end(), interface) !=
+               interfaces.end();
+    }
+
+    explicit FabricTopology(dbus::utility::MapperGetSubTreeResponse tree)
+    {
+        std::sort(tree.begin(), tree.end());
+        std::unordered_map<std::string, size_t> adapterPaths;
+        for (auto& [path, serviceMap] : tree)
+        {
+            if (serviceMap.empty())
+            {
+                continue;
+            }
+            if (implements(serviceMap, adapterInterface))
+            {
+                std::string id = buildFabricUniquePath(path);
+                // The first path wins when two adapters build the same id
+                if (adapterIndex.try_emplace(id, adapterList.size()).second)
+                {
+                    adapterPaths.try_emplace(path, adapterList.size());
+                    adapterList.push_back(
+                        {{path, std::move(id), serviceMap}, {}, {}});
+                }
+            }
+            sdbusplus::message::object_path objectPath(path);
+            if (implements(serviceMap, portInterface))
+            {
+                portList.push_back({path, objectPath.filename(), serviceMap});
+            }
+            if (implements(serviceMap, cableInterface))
+            {
+                std::string id = objectPath.filename();
+                if (cableIndex.try_emplace(id, cableList.size()).second)
+                {
+                    cableList.push_back({path, std::move(id), serviceMap});
+                }
+            }
+        }
+
+        for (size_t port = 0; port < portList.size(); port++)
+        {
+            sdbusplus::message::object_path parent =
+                sdbusplus::message::object_path(portList[port].path)
+                    .parent_path();
+            bool direct = true;
+            while (!parent.str.empty() && parent.str != "/")
+            {
+                auto adapter = adapterPaths.find(parent.str);
+                if (adapter != adapterPaths.end())
+                {
+                    Adapter& owner = adapterList[adapter->second];
+                    owner.portIndex.try_emplace(portList[port].id, port);
+                    if (direct)
+                    {
+                        owner.ports.push_back(port);
+                    }
+                }
+                direct = false;
+                parent = parent.parent_path();
+            }
+        }
+
+        adapterOrder.reserve(adapterList.size());
+        for (size_t adapter = 0; adapter < adapterList.size(); adapter++)
+        {
+            adapterOrder.push_back(adapter);
+        }
+        std::sort(adapterOrder.begin(), adapterOrder.end(),
+                  [this](size_t left, size_t right) {
+            return alphanumComp(adapterList[left].id, adapterList[right].id) <
+                   0;
+        });
+        cableOrder.reserve(cableList.size());
+        for (size_t cable = 0; cable < cableList.size(); cable++)
+        {
+            cableOrder.push_back(cable);
+        }
+        std::sort(cableOrder.begin(), cableOrder.end(),
+                  [this](size_t left, size_t right) {
+            return alphanumComp(cableList[left].id, cableList[right].id) < 0;
+        });
+    }
+
+    // Calls func with every adapter, in collection order
+    template <typename Func>
+    void forEachAdapter(Func&& func) const
+    {
+        for (size_t adapter : adapterOrder)
+        {
+            func(adapterList[adapter]);
+        }
+    }
+
+    // Calls func with every cable, in collection order
+    template <typename Func>
+    void forEachCable(Func&& func) const
+    {
+        for (size_t cable : cableOrder)
+        {
+            func(cableList[cable]);
+        }
+    }
+
+    // Calls func with every port of the adapter's collection
+    template <typename Func>
+    void forEachPort(const Adapter& adapter, Func&& func) const
+    {
+        for (size_t port : adapter.ports)
+        {
+            func(portList[port]);
+        }
+    }
+
+    const Adapter* findAdapter(const std::string& id) const
+    {
+        auto it = adapterIndex.find(id);
+        if (it == adapterIndex.end())
+        {
+            return nullptr;
+        }
+        return &adapterList[it->second];
+    }
+
+    const Object* findPort(const Adapter& adapter, const std::string& id) const
+    {
+        auto it = adapter.portIndex.find(id);
+        if (it == adapter.portIndex.end())
+        {
+            return nullptr;
+        }
+        return &portList[it->second];
+    }
+
+    const Object* findCable(const std::string& id) const
+    {
+        auto it = cableIndex.find(id);
+        if (it == cableIndex.end())
+        {
+            return nullptr;
+        }
+        return &cableList[it->second];
+    }
+
+  private:
+    static bool implements(const dbus::utility::MapperServiceMap& serviceMap,
+                           std::string_view interface)
+    {
+        return std::any_of(serviceMap.begin(), serviceMap.end(),
+                           [interface](const auto& service) {
+            return std::find(service.second.begin(), service.second.end(),
+                             interface) != service.second.end();
+        });
+    }
+
+    std::vector<Adapter> adapterList;
+    std::unordered_map<std::string, size_t> adapterIndex;
+    std::vector<size_t> adapterOrder;
+    std::vector<Object> portList;
+    std::vector<Object> cableList;
+    std::unordered_map<std::string, size_t> cableIndex;
+    std::vector<size_t> cableOrder;
+};
+
+/**
+ * @brief Holds the FabricTopology, so FabricAdapter, Port and Cable requests
+ * don't each search the inventory for the object they name.
+ *
+ * The topology is dropped when one of its interfaces is added or removed,
+ * or when a well known name changes owner; the next request builds it
+ * again.  The properties of the objects are always read live.
+ */
+class FabricTopologyCache
+{
+  public:
+    using Callback =
+        std::function<void(const boost::system::error_code&,
+                           const std::shared_ptr<const FabricTopology>&)>;
+
+    static FabricTopologyCache& getInstance()
+    {
+        static FabricTopologyCache cache;
+        return cache;
+    }
+
+    FabricTopologyCache(const FabricTopologyCache&) = delete;
+    FabricTopologyCache(FabricTopologyCache&&) = delete;
+    FabricTopologyCache& operator=(const FabricTopologyCache&) = delete;
+    FabricTopologyCache& operator=(FabricTopologyCache&&) = delete;
+    ~FabricTopologyCache() = default;
+
+    void registerMatches(sdbusplus::asio::connection& conn)
+    {
+        namespace rules = sdbusplus::bus::match::rules;
+
+        matches.clear();
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::interfacesAdded(),
+            [this](sdbusplus::message_t& msg) { onInterfacesAdded(msg); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::interfacesRemoved(),
+            [this](sdbusplus::message_t& msg) { onInterfacesRemoved(msg); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::nameOwnerChanged(),
+            [this](sdbusplus::message_t& msg) { onNameOwnerChanged(msg); }));
+        clear();
+    }
+
+    bool enabled() const
+    {
+        return !matches.empty();
+    }
+
+    /**
+     * @brief Calls callback with the topology, building it if it isn't
+     * cached.  Concurrent builds share one GetSubTree.  The callback is never
+     * called inline.
+     */
+    void get(Callback&& callback)
+    {
+        if (topology)
+        {
+            std::shared_ptr<const FabricTopology> current = topology;
+            boost::asio::post(crow::connections::systemBus->get_io_context(),
+                              [current, callback{std::move(callback)}]() {
+                callback(boost::system::error_code(), current);
+            });
+            return;
+        }
+
+        callbacks.emplace_back(std::move(callback));
+        if (callbacks.size() > 1)
+        {
+            return;
+        }
+        crow::dbus_trace::SharedCallScope sharedCalls;
+        dbus::utility::getSubTree(
+            "/xyz/openbmc_project/inventory", 0, FabricTopology::interfaces,
+            [this, fetchGeneration{generation}](
+                const boost::system::error_code& ec,
+                const dbus::utility::MapperGetSubTreeResponse& tree) {
+            afterGetSubTree(fetchGeneration, ec, tree);
+        });
+    }
+
+    void clear()
+    {
+        topology.reset();
+        generation++;
+    }
+
+  private:
+    FabricTopologyCache() = default;
+
+    void afterGetSubTree(uint64_t fetchGeneration,
+                         const boost::system::error_code& ec,
+                         const dbus::utility::MapperGetSubTreeResponse& tree)
+    {
+        std::vector<Callback> waiting = std::move(callbacks);
+        callbacks.clear();
+
+        std::shared_ptr<const FabricTopology> built;
+        if (!ec)
+        {
+            built = std::make_shared<const FabricTopology>(tree);
+            // A change signalled while the call was in flight may not be in
+            // the reply, so only keep it if nothing changed meanwhile
+            if (enabled() && fetchGeneration == generation)
+            {
+                topology = built;
+            }
+        }
+        for (Callback& callback : waiting)
+        {
+            callback(ec, built);
+        }
+    }
+
+    void onInterfacesAdded(sdbusplus::message_t& msg)
+    {
+        sdbusplus::message::object_path path;
+        dbus::utility::DBusInteracesMap interfaces;
+        try
+        {
+            msg.read(path, interfaces);
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            BMCWEB_LOG_ERROR << "Failed to read added interfaces: "
+                             << e.what();
+            clear();
+            return;
+        }
+        for (const auto& [interface, properties] : interfaces)
+        {
+            if (FabricTopology::isTopologyInterface(interface))
+            {
+                clear();
+                return;
+            }
+        }
+    }
+
+    void onInterfacesRemoved(sdbusplus::message_t& msg)
+    {
+        sdbusplus::message::object_path path;
+        std::vector<std::string> interfaces;
+        try
+        {
+            msg.read(path, interfaces);
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            BMCWEB_LOG_ERROR << "Failed to read removed interfaces: "
+                             << e.what();
+            clear();
+            return;
+        }
+        if (std::any_of(interfaces.begin(), interfaces.end(),
+                        FabricTopology::isTopologyInterface))
+        {
+            clear();
+        }
+    }
+
+    // A service coming or going can take fabric objects with it without
+    // signalling them one by one; unique names are only clients
+    void onNameOwnerChanged(sdbusplus::message_t& msg)
+    {
+        std::string name;
+        try
+        {
+            msg.read(name);
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            BMCWEB_LOG_ERROR << "Failed to read owner change: " << e.what();
+            clear();
+            return;
+        }
+        if (!name.starts_with(':'))
+        {
+            clear();
+        }
+    }
+
+    std::shared_ptr<const FabricTopology> topology;
+    std::vector<Callback> callbacks;
+    uint64_t generation = 0;
+    std::vector<std::unique_ptr<sdbusplus::bus::match_t>> matches;
+};
+
+} // namespace fabric_util
+} // namespace redfish
@@ -19,20 +19,6 @@ namespace redfish
 namespace fabric_util
 {
 
-/*
- * @brief Verify whether a given adapter is the same to a given adapterId.
- *
- * @param[i]   adapterId that represents a fabric object
- * @param[i]   adapter that is to check whetehr it is the same adaptor
- *
- * @return void
- */
-inline bool checkFabricAdapterId(const std::string& adapterId,
-                                 const std::string& adapter)
-{
-    return !(adapter.empty() || adapterId != adapter);
-}
-
 /**
  * @brief Workaround to handle duplicate Fabric device list
  *
@@ -1,8 +1,8 @@
 #pragma once
 
-#include <include/dbus_singleton.hpp>
+#include <utils/chassis_graph.hpp>
 
-#include <array>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -15,13 +15,10 @@ namespace utils
 template <typename F>
 inline void getChassisNames(F&& cb)
 {
-    const std::array<const char*, 1> interfaces = {
-        "xyz.openbmc_project.Inventory.Item.Chassis"};
-
-    crow::connections::systemBus->async_method_call(
+    chassis_utils::ChassisGraphCache::getInstance().get(
         [callback = std::forward<F>(cb)](
-            const boost::system::error_code ec,
-            const std::vector<std::string>& chassis) {
+            const boost::system::error_code& ec,
+            const std::shared_ptr<const chassis_utils::ChassisGraph>& graph) {
         std::vector<std::string> chassisNames;
 
         if (ec)
@@ -30,27 +27,14 @@ inline void getChassisNames(F&& cb)
             return;
         }
 
-        chassisNames.reserve(chassis.size());
-        for (const std::string& path : chassis)
+        chassisNames.reserve(graph->nodes().size());
+        for (const chassis_utils::ChassisNode& chassis : graph->nodes())
         {
-            sdbusplus::message::object_path dbusPath = path;
-            std::string name = dbusPath.filename();
-            if (name.empty())
-            {
-                callback(boost::system::errc::make_error_code(
-                             boost::system::errc::invalid_argument),
-                         chassisNames);
-                return;
-            }
-            chassisNames.emplace_back(std::move(name));
+            chassisNames.emplace_back(chassis.id);
         }
 
         callback(ec, chassisNames);
-    },
-        "xyz.openbmc_project.ObjectMapper",
-        "/xyz/openbmc_project/object_mapper",
-        "xyz.openbmc_project.ObjectMapper", "GetSubTreePaths",
-        "/xyz/openbmc_project/inventory", 0, interfaces);
+    });
 }
 
 } // namespace utils
@@ -0,0 +1,454 @@
+#pragma once
+
+#include "dbus_singleton.hpp"
+#include "dbus_utility.hpp"
+#include "logging.hpp"
+
+#include <boost/asio/post.hpp>
+#include <sdbusplus/asio/connection.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace redfish
+{
+namespace health_utils
+{
+
+constexpr std::string_view mapperService = "xyz.openbmc_project.ObjectMapper";
+
+constexpr std::string_view associationInterface =
+    "xyz.openbmc_project.Association";
+
+constexpr std::string_view globalItemInterface =
+    "xyz.openbmc_project.Inventory.Item.Global";
+
+// Only the mapper's warning and critical associations carry health
+inline bool isStatusAssociation(std::string_view path)
+{
+    return path.ends_with("critical") || path.ends_with("warning");
+}
+
+/**
+ * @brief What HealthPopulate rolls health up from.
+ */
+struct HealthStatuses
+{
+    // The mapper's warning and critical association objects
+    dbus::utility::ManagedObjectType statuses;
+    // The one inventory item implementing Inventory.Item.Global, or an
+    // illegal path if there is none, or more than one
+    std::string globalInventoryPath = "-";
+
+    void update(const std::string& path, const std::string& interface,
+                const dbus::utility::DBusPropertiesMap& properties)
+    {
+        auto object = find(path);
+        if (object == statuses.end())
+        {
+            object = statuses.emplace(statuses.end(),
+                                      sdbusplus::message::object_path(path),
+                                      dbus::utility::DBusInteracesMap{});
+        }
+        auto it = std::find_if(object->second.begin(), object->second.end(),
+                               [&interface](const auto& entry) {
+            return entry.first == interface;
+        });
+        if (it == object->second.end())
+        {
+            object->second.emplace_back(interface, properties);
+            return;
+        }
+        for (const auto& [name, value] : properties)
+        {
+            auto property = std::find_if(it->second.begin(), it->second.end(),
+                                         [&name](const auto& entry) {
+                return entry.first == name;
+            });
+            if (property == it->second.end())
+            {
+                it->second.emplace_back(name, value);
+            }
+            else
+            {
+                property->second = value;
+            }
+        }
+    }
+
+    void erase(const std::string& path)
+    {
+        auto object = find(path);
+        if (object != statuses.end())
+        {
+            statuses.erase(object);
+        }
+    }
+
+  private:
+    dbus::utility::ManagedObjectType::iterator find(const std::string& path)
+    {
+        return std::find_if(statuses.begin(), statuses.end(),
+                            [&path](const auto& object) {
+            return object.first.str == path;
+        });
+    }
+};
+
+/**
+ * @brief Holds the HealthStatuses, so every resource with a HealthRollup
+ * doesn't read every association the mapper has.
+ *
+ * The statuses are read on first use.  After that, the mapper adding,
+ * removing or changing a warning or critical association is applied in
+ * place, and an inventory item becoming or ceasing to be the global item
+ * drops them, to be read again on next use, as does a well known name
+ * changing owner.  Statuses that have been handed out are never modified; a
+ * signal that arrives while they are still in use replaces them with an
+ * updated copy.
+ */
+class HealthStatusCache
+{
+  public:
+    using Callback =
+        std::function<void(const std::shared_ptr<const HealthStatuses>&)>;
+
+    static HealthStatusCache& getInstance()
+    {
+        static HealthStatusCache cache;
+        return cache;
+    }
+
+    HealthStatusCache(const HealthStatusCache&) = delete;
+    HealthStatusCache(HealthStatusCache&&) = delete;
+    HealthStatusCache& operator=(const HealthStatusCache&) = delete;
+    HealthStatusCache& operator=(HealthStatusCache&&) = delete;
+    ~HealthStatusCache() = default;
+
+    void registerMatches(sdbusplus::asio::connection& conn)
+    {
+        namespace rules = sdbusplus::bus::match::rules;
+        std::string mapper(mapperService);
+
+        matches.clear();
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn,
+            rules::type::signal() + rules::sender(mapper) +
+                rules::member("PropertiesChanged") +
+                rules::interface("org.freedesktop.DBus.Properties") +
+                rules::argN(0, std::string(associationInterface)),
+            [this](sdbusplus::message_t& msg) { onPropertiesChanged(msg); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::interfacesAdded() + rules::sender(mapper),
+            [this](sdbusplus::message_t& msg) { onStatusAdded(msg); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::interfacesRemoved() + rules::sender(mapper),
+            [this](sdbusplus::message_t& msg) { onStatusRemoved(msg); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::interfacesAdded(),
+            [this](sdbusplus::message_t& msg) { onInterfacesAdded(msg); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::interfacesRemoved(),
+            [this](sdbusplus::message_t& msg) { onInterfacesRemoved(msg); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::nameOwnerChanged(), [this](sdbusplus::message_t& msg) {
+            std::string name;
+            msg.read(name);
+            if (!name.starts_with(':'))
+            {
+                clear();
+            }
+        }));
+        clear();
+    }
+
+    bool enabled() const
+    {
+        return !matches.empty();
+    }
+
+    /**
+     * @brief Calls callback with the health statuses, reading them if they
+     * aren't cached.  A read that fails leaves out what it couldn't read.
+     * The callback is never called inline.
+     */
+    void get(Callback&& callback)
+    {
+        if (current)
+        {
+            std::shared_ptr<const HealthStatuses> statuses = current;
+            boost::asio::post(crow::connections::systemBus->get_io_context(),
+                              [statuses, callback{std::move(callback)}]() {
+                callback(statuses);
+            });
+            return;
+        }
+
+        callbacks.emplace_back(std::move(callback));
+        if (callbacks.size() > 1)
+        {
+            return;
+        }
+        crow::dbus_trace::SharedCallScope sharedCalls;
+        auto fetch = std::make_shared<Fetch>(*this, generation);
+        readStatuses(fetch);
+        readGlobalPath(fetch);
+    }
+
+    void clear()
+    {
+        current.reset();
+        generation++;
+    }
+
+  private:
+    // Completes the fetch once every read it issued has returned
+    struct Fetch
+    {
+        Fetch(HealthStatusCache& cacheIn, uint64_t fetchGenerationIn) :
+            cache(cacheIn), fetchGeneration(fetchGenerationIn)
+        {}
+
+        ~Fetch()
+        {
+            cache.complete(fetchGeneration, failed, read);
+        }
+
+        Fetch(const Fetch&) = delete;
+        Fetch(Fetch&&) = delete;
+        Fetch& operator=(const Fetch&) = delete;
+        Fetch& operator=(Fetch&&) = delete;
+
+        HealthStatusCache& cache;
+        uint64_t fetchGeneration;
+        bool failed = false;
+        std::shared_ptr<HealthStatuses> read =
+            std::make_shared<HealthStatuses>();
+    };
+
+    HealthStatusCache() = default;
+
+    static void readStatuses(const std::shared_ptr<Fetch>& fetch)
+    {
+        crow::connections::systemBus->async_method_call(
+            [fetch](const boost::system::error_code& ec,
+                    dbus::utility::ManagedObjectType& resp) {
+            if (ec)
+            {
+                BMCWEB_LOG_ERROR << "Health status read error: " << ec;
+                fetch->failed = true;
+                return;
+            }
+            std::erase_if(resp, [](const auto& object) {
+                return !isStatusAssociation(object.first.str);
+            });
+            fetch->read->statuses = std::move(resp);
+        },
+            std::string(mapperService), "/",
+            "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
+    }
+
+    static void readGlobalPath(const std::shared_ptr<Fetch>& fetch)
+    {
+        constexpr std::array<std::string_view, 1> interfaces = {
+            globalItemInterface};
+        dbus::utility::getSubTreePaths(
+            "/", 0, interfaces,
+            [fetch](const boost::system::error_code& ec,
+                    const dbus::utility::MapperGetSubTreePathsResponse& resp) {
+            if (ec)
+            {
+                BMCWEB_LOG_ERROR << "Global item read error: " << ec;
+                fetch->failed = true;
+                return;
+            }
+            if (resp.size() != 1)
+            {
+                // no global item, or too many
+                return;
+            }
+            fetch->read->globalInventoryPath = resp[0];
+        });
+    }
+
+    void complete(uint64_t fetchGeneration, bool failed,
+                  const std::shared_ptr<HealthStatuses>& read)
+    {
+        std::vector<Callback> waiting = std::move(callbacks);
+        callbacks.clear();
+
+        // A signal received meanwhile may not be in the replies
+        if (!failed && enabled() && fetchGeneration == generation)
+        {
+            current = read;
+        }
+        for (Callback& callback : waiting)
+        {
+            callback(read);
+        }
+    }
+
+    // Returns the statuses for modification, or nullptr when nothing is
+    // cached
+    HealthStatuses* writableStatuses()
+    {
+        generation++;
+        if (!current)
+        {
+            return nullptr;
+        }
+        if (current.use_count() > 1)
+        {
+            current = std::make_shared<HealthStatuses>(*current);
+        }
+        return current.get();
+    }
+
+    void onPropertiesChanged(sdbusplus::message_t& msg)
+    {
+        std::string path = msg.get_path();
+        if (!isStatusAssociation(path))
+        {
+            return;
+        }
+        std::string interface;
+        dbus::utility::DBusPropertiesMap properties;
+        try
+        {
+            msg.read(interface, properties);
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            BMCWEB_LOG_ERROR << "Failed to read association change: "
+                             << e.what();
+            clear();
+            return;
+        }
+        HealthStatuses* statuses = writableStatuses();
+        if (statuses != nullptr)
+        {
+            statuses->update(path, interface, properties);
+        }
+    }
+
+    void onStatusAdded(sdbusplus::message_t& msg)
+    {
+        sdbusplus::message::object_path path;
+        dbus::utility::DBusInteracesMap interfaces;
+        try
+        {
+            msg.read(path, interfaces);
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            BMCWEB_LOG_ERROR << "Failed to read added association: "
+                             << e.what();
+            clear();
+            return;
+        }
+        if (!isStatusAssociation(path.str))
+        {
+            return;
+        }
+        HealthStatuses* statuses = writableStatuses();
+        if (statuses == nullptr)
+        {
+            return;
+        }
+        for (const auto& [interface, properties] : interfaces)
+        {
+            statuses->update(path.str, interface, properties);
+        }
+    }
+
+    void onStatusRemoved(sdbusplus::message_t& msg)
+    {
+        sdbusplus::message::object_path path;
+        std::vector<std::string> interfaces;
+        try
+        {
+            msg.read(path, interfaces);
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            BMCWEB_LOG_ERROR << "Failed to read removed association: "
+                             << e.what();
+            clear();
+            return;
+        }
+        if (!isStatusAssociation(path.str))
+        {
+            return;
+        }
+        HealthStatuses* statuses = writableStatuses();
+        if (statuses != nullptr)
+        {
+            statuses->erase(path.str);
+        }
+    }
+
+    // The global item is only looked for on a fresh read
+    void onInterfacesAdded(sdbusplus::message_t& msg)
+    {
+        sdbusplus::message::object_path path;
+        dbus::utility::DBusInteracesMap interfaces;
+        try
+        {
+            msg.read(path, interfaces);
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            BMCWEB_LOG_ERROR << "Failed to read added interfaces: "
+                             << e.what();
+            clear();
+            return;
+        }
+        for (const auto& [interface, properties] : interfaces)
+        {
+            if (interface == globalItemInterface)
+            {
+                clear();
+                return;
+            }
+        }
+    }
+
+    void onInterfacesRemoved(sdbusplus::message_t& msg)
+    {
+        sdbusplus::message::object_path path;
+        std::vector<std::string> interfaces;
+        try
+        {
+            msg.read(path, interfaces);
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            BMCWEB_LOG_ERROR << "Failed to read removed interfaces: "
+                             << e.what();
+            clear();
+            return;
+        }
+        if (std::find(interfaces.begin(), interfaces.end(),
+                      globalItemInterface) != interfaces.end())
+        {
+            clear();
+        }
+    }
+
+    std::shared_ptr<HealthStatuses> current;
+    std::vector<Callback> callbacks;
+    uint64_t generation = 0;
+    std::vector<std::unique_ptr<sdbusplus::bus::match_t>> matches;
+};
+
+} // namespace health_utils
+} // namespace redfish
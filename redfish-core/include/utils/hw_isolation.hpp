@@ -1,15 +1,158 @@
 #pragma once
 
+#include <boost/container/flat_map.hpp>
+#include <dbus_utility.hpp>
+#include <registries_selector.hpp>
 #include <utils/error_log_utils.hpp>
 #include <utils/time_utils.hpp>
 
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <memory>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace redfish
 {
 namespace hw_isolation_utils
 {
 
+/**
+ * @brief The object mapper lookups made while building one hardware
+ *        isolation response, shared by every entry in it.
+ *
+ * Isolated cores and DIMMs of the same FRU resolve to the same inventory
+ * objects, so each distinct GetObject or GetAncestors lookup goes to the
+ * mapper once, however many entries ask for it, and whether or not the first
+ * answer has come back yet.  All the lookups of one response are in flight
+ * at the same time.
+ */
+class MapperLookups : public std::enable_shared_from_this<MapperLookups>
+{
+  public:
+    using Ancestors = boost::container::flat_map<
+        std::string,
+        boost::container::flat_map<std::string, std::vector<std::string>>>;
+
+    using GetObjectCallback =
+        std::function<void(const boost::system::error_code&,
+                           const dbus::utility::MapperGetObject&)>;
+    using AncestorsCallback =
+        std::function<void(const boost::system::error_code&, const Ancestors&)>;
+
+    // GetObject of path, for every interface it has
+    void getObject(const std::string& path, GetObjectCallback&& callback)
+    {
+        Lookup<dbus::utility::MapperGetObject>& lookup = objects[path];
+        if (!lookup.wait(std::move(callback)))
+        {
+            return;
+        }
+        crow::connections::systemBus->async_method_call(
+            [self = shared_from_this(),
+             path](const boost::system::error_code& ec,
+                   const dbus::utility::MapperGetObject& object) {
+            self->objects[path].complete(ec, object);
+        },
+            "xyz.openbmc_project.ObjectMapper",
+            "/xyz/openbmc_project/object_mapper",
+            "xyz.openbmc_project.ObjectMapper", "GetObject", path,
+            std::array<const char*, 0>{});
+    }
+
+    // GetObject of path, for the services implementing interface
+    void getObject(const std::string& path, const std::string& interface,
+                   GetObjectCallback&& callback)
+    {
+        getObject(path, [interface, callback{std::move(callback)}](
+                            const boost::system::error_code& ec,
+                            const dbus::utility::MapperGetObject& object) {
+            dbus::utility::MapperGetObject services;
+            for (const auto& service : object)
+            {
+                if (std::find(service.second.begin(), service.second.end(),
+                              interface) != service.second.end())
+                {
+                    services.emplace_back(service);
+                }
+            }
+            callback(ec, services);
+        });
+    }
+
+    void getAncestors(const std::string& path,
+                      const std::vector<std::string>& interfaces,
+                      AncestorsCallback&& callback)
+    {
+        std::string key = path;
+        for (const std::string& interface : interfaces)
+        {
+            key += '\0';
+            key += interface;
+        }
+        Lookup<Ancestors>& lookup = ancestors[key];
+        if (!lookup.wait(std::move(callback)))
+        {
+            return;
+        }
+        crow::connections::systemBus->async_method_call(
+            [self = shared_from_this(),
+             key](const boost::system::error_code& ec, const Ancestors& found) {
+            self->ancestors[key].complete(ec, found);
+        },
+            "xyz.openbmc_project.ObjectMapper",
+            "/xyz/openbmc_project/object_mapper",
+            "xyz.openbmc_project.ObjectMapper", "GetAncestors", path,
+            interfaces);
+    }
+
+  private:
+    template <typename Result>
+    struct Lookup
+    {
+        using Callback = std::function<void(const boost::system::error_code&,
+                                            const Result&)>;
+
+        // Returns true if this is the first to ask, which makes the call
+        bool wait(Callback&& callback)
+        {
+            if (done)
+            {
+                callback(ec, result);
+                return false;
+            }
+            waiting.emplace_back(std::move(callback));
+            return waiting.size() == 1;
+        }
+
+        void complete(const boost::system::error_code& ecIn,
+                      const Result& resultIn)
+        {
+            done = true;
+            ec = ecIn;
+            result = resultIn;
+            std::vector<Callback> callbacks = std::move(waiting);
+            waiting.clear();
+            for (Callback& callback : callbacks)
+            {
+                callback(ec, result);
+            }
+        }
+
+        bool done = false;
+        boost::system::error_code ec;
+        Result result;
+        std::vector<Callback> waiting;
+    };
+
+    std::unordered_map<std::string, Lookup<dbus::utility::MapperGetObject>>
+        objects;
+    std::unordered_map<std::string, Lookup<Ancestors>> ancestors;
+};
+
 /**
  * @brief API used to return ChassisPowerStateOffRequiredError with
  *        the Chassis id that will get by using the given resource
@@ -0,0 +1,217 @@
+#pragma once
+
+#include "dbus_utility.hpp"
+#include "logging.hpp"
+
+#include <sdbusplus/asio/connection.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace redfish
+{
+namespace hypervisor_utils
+{
+
+/**
+ * @brief The PowerState and Status.State of Systems/hypervisor for a
+ * CurrentHostState
+ */
+struct PowerStatus
+{
+    std::string_view powerState;
+    std::string_view state;
+};
+
+inline std::optional<PowerStatus> powerStatus(std::string_view hostState)
+{
+    if (hostState == "xyz.openbmc_project.State.Host.HostState.Running")
+    {
+        return PowerStatus{"On", "Enabled"};
+    }
+    if (hostState == "xyz.openbmc_project.State.Host.HostState.Quiesced")
+    {
+        return PowerStatus{"On", "Quiesced"};
+    }
+    if (hostState == "xyz.openbmc_project.State.Host.HostState.Standby")
+    {
+        return PowerStatus{"On", "StandbyOffline"};
+    }
+    if (hostState ==
+        "xyz.openbmc_project.State.Host.HostState.TransitioningToRunning")
+    {
+        return PowerStatus{"PoweringOn", "Starting"};
+    }
+    if (hostState ==
+        "xyz.openbmc_project.State.Host.HostState.TransitioningToOff")
+    {
+        return PowerStatus{"PoweringOff", "Enabled"};
+    }
+    if (hostState == "xyz.openbmc_project.State.Host.HostState.Off")
+    {
+        return PowerStatus{"Off", "Disabled"};
+    }
+    return std::nullopt;
+}
+
+/**
+ * @brief The hypervisor's host state object as last read: whether it's
+ * there at all, and its CurrentHostState if it is.
+ */
+struct HypervisorState
+{
+    bool present = false;
+    std::string hostState;
+};
+
+/**
+ * @brief Applies the CurrentHostState in properties to state.  Returns
+ * false if it is there but isn't a string.
+ */
+inline bool updateHostState(HypervisorState& state,
+                            const dbus::utility::DBusPropertiesMap& properties)
+{
+    for (const auto& [name, value] : properties)
+    {
+        if (name != "CurrentHostState")
+        {
+            continue;
+        }
+        const std::string* hostState = std::get_if<std::string>(&value);
+        if (hostState == nullptr)
+        {
+            return false;
+        }
+        state.hostState = *hostState;
+    }
+    return true;
+}
+
+/**
+ * @brief The state of the hypervisor, as served on Systems/hypervisor.
+ *
+ * The state is read on the first GET and kept current by signals: a change
+ * to CurrentHostState updates it in place, and the state service changing
+ * owner drops it, so it's read again.  A read that was in flight when
+ * something changed is not stored; see generation().
+ */
+class HypervisorStateCache
+{
+  public:
+    static constexpr std::string_view service =
+        "xyz.openbmc_project.State.Hypervisor";
+    static constexpr std::string_view path =
+        "/xyz/openbmc_project/state/hypervisor0";
+    static constexpr std::string_view hostInterface =
+        "xyz.openbmc_project.State.Host";
+
+    static HypervisorStateCache& getInstance()
+    {
+        static HypervisorStateCache cache;
+        return cache;
+    }
+
+    HypervisorStateCache(const HypervisorStateCache&) = delete;
+    HypervisorStateCache(HypervisorStateCache&&) = delete;
+    HypervisorStateCache& operator=(const HypervisorStateCache&) = delete;
+    HypervisorStateCache& operator=(HypervisorStateCache&&) = delete;
+    ~HypervisorStateCache() = default;
+
+    void registerMatches(sdbusplus::asio::connection& conn)
+    {
+        namespace rules = sdbusplus::bus::match::rules;
+
+        matches.clear();
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn,
+            rules::propertiesChanged(std::string(path),
+                                     std::string(hostInterface)),
+            [this](sdbusplus::message_t& msg) { onHostChanged(msg); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn,
+            rules::nameOwnerChanged() + rules::argN(0, std::string(service)),
+            [this](sdbusplus::message_t& /*msg*/) { clear(); }));
+        clear();
+    }
+
+    bool enabled() const
+    {
+        return !matches.empty();
+    }
+
+    // Moves on whenever the state changes.  A read started at one
+    // generation is only stored if it is still current.
+    uint64_t generation() const
+    {
+        return currentGeneration;
+    }
+
+    // The state, or nullptr if not cached
+    const HypervisorState* find() const
+    {
+        if (!state)
+        {
+            return nullptr;
+        }
+        return &*state;
+    }
+
+    void store(HypervisorState read, uint64_t readGeneration)
+    {
+        if (enabled() && readGeneration == currentGeneration)
+        {
+            state = std::move(read);
+        }
+    }
+
+    void clear()
+    {
+        state.reset();
+        currentGeneration++;
+    }
+
+  private:
+    HypervisorStateCache() = default;
+
+    void onHostChanged(sdbusplus::message_t& msg)
+    {
+        currentGeneration++;
+        if (!state)
+        {
+            return;
+        }
+        std::string interface;
+        dbus::utility::DBusPropertiesMap properties;
+        try
+        {
+            msg.read(interface, properties);
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            BMCWEB_LOG_ERROR << "Failed to read hypervisor state change: "
+                             << e.what();
+            state.reset();
+            return;
+        }
+        state->present = true;
+        if (!updateHostState(*state, properties))
+        {
+            state.reset();
+        }
+    }
+
+    std::optional<HypervisorState> state;
+    uint64_t currentGeneration = 0;
+    std::vector<std::unique_ptr<sdbusplus::bus::match_t>> matches;
+};
+
+} // namespace hypervisor_utils
+} // namespace redfish
@@ -0,0 +1,304 @@
+#pragma once
+
+#include "dbus_utility.hpp"
+#include "logging.hpp"
+#include "utils/time_utils.hpp"
+
+#include <sdbusplus/asio/connection.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace redfish
+{
+namespace power_supply_utils
+{
+
+constexpr std::string_view historyMaximumInterface =
+    "org.open_power.Sensor.Aggregation.History.Maximum";
+constexpr std::string_view historyAverageInterface =
+    "org.open_power.Sensor.Aggregation.History.Average";
+
+// One input power history sample, as it's rendered
+struct InputHistorySample
+{
+    uint64_t timestamp = 0;
+    int64_t raw = 0;
+    std::string date;
+    double value = 0.0;
+};
+
+/**
+ * @brief The samples of one input history object of a power supply, oldest
+ * first, with the service and interface (Maximum or Average) it's read from.
+ */
+struct InputHistory
+{
+    std::string service;
+    std::string interface;
+    int64_t scale = 0;
+    std::deque<InputHistorySample> samples;
+};
+
+/**
+ * @brief Applies the Scale and Values of an input history object, either a
+ * full read or a PropertiesChanged, to history.  Returns false if a property
+ * has the wrong type.
+ *
+ * Values holds the object's whole window of samples.  The samples already
+ * held are kept as they are; only those newer than the newest one held are
+ * converted and appended, and the oldest are dropped to keep the window the
+ * object reports.  Samples that don't follow on from the ones held, or a new
+ * Scale, replace the whole window.
+ */
+inline bool
+    updateInputHistory(InputHistory& history,
+                       const dbus::utility::DBusPropertiesMap& properties)
+{
+    const std::vector<std::tuple<uint64_t, int64_t>>* values = nullptr;
+    bool rescaled = false;
+    for (const auto& [name, value] : properties)
+    {
+        if (name == "Scale")
+        {
+            const int64_t* scale = std::get_if<int64_t>(&value);
+            if (scale == nullptr)
+            {
+                return false;
+            }
+            rescaled = *scale != history.scale;
+            history.scale = *scale;
+        }
+        else if (name == "Values")
+        {
+            values = std::get_if<std::vector<std::tuple<uint64_t, int64_t>>>(
+                &value);
+            if (values == nullptr)
+            {
+                return false;
+            }
+        }
+    }
+
+    double factor = std::pow(10.0, history.scale);
+    if (rescaled)
+    {
+        for (InputHistorySample& sample : history.samples)
+        {
+            sample.value = static_cast<double>(sample.raw) * factor;
+        }
+    }
+    if (values == nullptr)
+    {
+        return true;
+    }
+
+    size_t first = 0;
+    if (!history.samples.empty())
+    {
+        uint64_t newest = history.samples.back().timestamp;
+        while (first < values->size() &&
+               std::get<0>((*values)[first]) <= newest)
+        {
+            first++;
+        }
+        // The samples held have to still be there, up to the newest one
+        if (first == 0 || std::get<0>((*values)[first - 1]) != newest)
+        {
+            history.samples.clear();
+            first = 0;
+        }
+    }
+    for (size_t i = first; i < values->size(); i++)
+    {
+        const auto& [timestamp, raw] = (*values)[i];
+        history.samples.push_back(
+            {timestamp, raw, time_utils::getDateTimeUintMs(timestamp),
+             static_cast<double>(raw) * factor});
+    }
+    while (history.samples.size() > values->size())
+    {
+        history.samples.pop_front();
+    }
+    return true;
+}
+
+/**
+ * @brief The input history of each power supply history object read so far,
+ * so PowerSupplyMetrics doesn't look up and convert every sample again on
+ * each GET.
+ *
+ * Entries are filled by the PowerSupplyMetrics reads and kept current by
+ * signals: a change to an object's Values appends its new samples, the
+ * history interfaces being removed drops the object, and a well known name
+ * changing owner drops everything.  Reads that were in flight when something
+ * changed are not stored; see generation().
+ */
+class InputHistoryCache
+{
+  public:
+    static InputHistoryCache& getInstance()
+    {
+        static InputHistoryCache cache;
+        return cache;
+    }
+
+    InputHistoryCache(const InputHistoryCache&) = delete;
+    InputHistoryCache(InputHistoryCache&&) = delete;
+    InputHistoryCache& operator=(const InputHistoryCache&) = delete;
+    InputHistoryCache& operator=(InputHistoryCache&&) = delete;
+    ~InputHistoryCache() = default;
+
+    void registerMatches(sdbusplus::asio::connection& conn)
+    {
+        namespace rules = sdbusplus::bus::match::rules;
+
+        matches.clear();
+        for (std::string_view interface :
+             {historyMaximumInterface, historyAverageInterface})
+        {
+            matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+                conn,
+                rules::type::signal() + rules::member("PropertiesChanged") +
+                    rules::interface("org.freedesktop.DBus.Properties") +
+                    rules::argN(0, std::string(interface)),
+                [this](sdbusplus::message_t& msg) { onHistoryChanged(msg); }));
+        }
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::interfacesRemoved(),
+            [this](sdbusplus::message_t& msg) { onInterfacesRemoved(msg); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::nameOwnerChanged(), [this](sdbusplus::message_t& msg) {
+            std::string name;
+            try
+            {
+                msg.read(name);
+            }
+            catch (const sdbusplus::exception_t& e)
+            {
+                BMCWEB_LOG_ERROR << "Failed to read owner change: "
+                                 << e.what();
+                clear();
+                return;
+            }
+            if (!name.starts_with(':'))
+            {
+                clear();
+            }
+        }));
+        clear();
+    }
+
+    bool enabled() const
+    {
+        return !matches.empty();
+    }
+
+    // Moves on whenever a history object changes.  A read started at one
+    // generation is only stored if it is still current.
+    uint64_t generation() const
+    {
+        return currentGeneration;
+    }
+
+    // The history of historyPath, or nullptr if not cached
+    const InputHistory* find(const std::string& historyPath) const
+    {
+        auto it = histories.find(historyPath);
+        if (it == histories.end())
+        {
+            return nullptr;
+        }
+        return &it->second;
+    }
+
+    void store(const std::string& historyPath, InputHistory history,
+               uint64_t readGeneration)
+    {
+        if (enabled() && readGeneration == currentGeneration)
+        {
+            histories.insert_or_assign(historyPath, std::move(history));
+        }
+    }
+
+    void clear()
+    {
+        histories.clear();
+        currentGeneration++;
+    }
+
+  private:
+    InputHistoryCache() = default;
+
+    void onHistoryChanged(sdbusplus::message_t& msg)
+    {
+        currentGeneration++;
+        auto it = histories.find(msg.get_path());
+        if (it == histories.end())
+        {
+            return;
+        }
+        std::string interface;
+        dbus::utility::DBusPropertiesMap properties;
+        try
+        {
+            msg.read(interface, properties);
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            BMCWEB_LOG_ERROR << "Failed to read input history change: "
+                             << e.what();
+            histories.erase(it);
+            return;
+        }
+        if (interface != it->second.interface ||
+            !updateInputHistory(it->second, properties))
+        {
+            histories.erase(it);
+        }
+    }
+
+    void onInterfacesRemoved(sdbusplus::message_t& msg)
+    {
+        sdbusplus::message::object_path path;
+        std::vector<std::string> interfaces;
+        try
+        {
+            msg.read(path, interfaces);
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            BMCWEB_LOG_ERROR << "Failed to read removed interfaces: "
+                             << e.what();
+            clear();
+            return;
+        }
+        for (const std::string& interface : interfaces)
+        {
+            if (interface == historyMaximumInterface ||
+                interface == historyAverageInterface)
+            {
+                histories.erase(path.str);
+                currentGeneration++;
+            }
+        }
+    }
+
+    std::unordered_map<std::string, InputHistory> histories;
+    uint64_t currentGeneration = 0;
+    std::vector<std::unique_ptr<sdbusplus::bus::match_t>> matches;
+};
+
+} // namespace power_supply_utils
+} // namespace redfish
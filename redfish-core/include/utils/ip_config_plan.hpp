@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace redfish
+{
+namespace ip_util
+{
+
+/**
+ * @brief A static address as the network service creates it
+ */
+struct StaticAddress
+{
+    std::string address;
+    uint8_t prefixLength = 0;
+    // Only used for IPv4
+    std::string gateway;
+
+    bool operator==(const StaticAddress& other) const = default;
+};
+
+/**
+ * @brief The changes a PATCH of IPv4StaticAddresses or IPv6StaticAddresses
+ * makes to the static addresses of an interface.
+ *
+ * Each element of the PATCH is recorded against the static address it lines
+ * up with.  Elements that leave their address as it is make no change, so
+ * only what actually differs is sent to the network service.  Every change
+ * is worked out before any is applied, which means a PATCH with an error in
+ * any element changes nothing.  Deletes are applied before creates, so an
+ * address can move between entries without colliding with itself.
+ */
+class StaticAddressPlan
+{
+  public:
+    // Element removing the address with D-Bus id id
+    void remove(const std::string& id)
+    {
+        deletes.emplace_back(id);
+    }
+
+    // Element setting the address with D-Bus id id, currently current, to
+    // target
+    void replace(const std::string& id, const StaticAddress& current,
+                 StaticAddress target)
+    {
+        if (current == target)
+        {
+            return;
+        }
+        deletes.emplace_back(id);
+        creates.emplace_back(std::move(target));
+    }
+
+    // Element past the existing static addresses
+    void add(StaticAddress target)
+    {
+        creates.emplace_back(std::move(target));
+    }
+
+    bool empty() const
+    {
+        return deletes.empty() && creates.empty();
+    }
+
+    const std::vector<std::string>& getDeletes() const
+    {
+        return deletes;
+    }
+
+    const std::vector<StaticAddress>& getCreates() const
+    {
+        return creates;
+    }
+
+  private:
+    std::vector<std::string> deletes;
+    std::vector<StaticAddress> creates;
+};
+
+} // namespace ip_util
+} // namespace redfish
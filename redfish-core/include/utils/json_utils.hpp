@@ -21,6 +21,7 @@
 #include "logging.hpp"
 #include "nlohmann/json.hpp"
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <cstddef>
@@ -31,6 +32,7 @@
 #include <span>
 #include <string>
 #include <string_view>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 #include <variant>
@@ -400,85 +402,96 @@ struct PerUnpack
     bool complete = false;
 };
 
+// The first path segment of each requested key, sorted, so each member of
+// the request is matched with a binary search instead of a scan over every
+// requested key
+struct UnpackIndex
+{
+    std::string_view key;
+    size_t unpackIndex;
+
+    bool operator<(const UnpackIndex& other) const
+    {
+        return std::tie(key, unpackIndex) <
+               std::tie(other.key, other.unpackIndex);
+    }
+};
+
 inline bool readJsonHelper(nlohmann::json& jsonRequest, crow::Response& res,
                            std::span<PerUnpack> toUnpack)
 {
     bool result = true;
-    if (!jsonRequest.is_object())
+    nlohmann::json::object_t* object =
+        jsonRequest.get_ptr<nlohmann::json::object_t*>();
+    if (object == nullptr)
     {
         BMCWEB_LOG_DEBUG << "Json value is not an object";
         messages::unrecognizedRequestBody(res);
         return false;
     }
-    for (const auto& item : jsonRequest.items())
+
+    std::vector<UnpackIndex> index;
+    index.reserve(toUnpack.size());
+    for (size_t i = 0; i < toUnpack.size(); i++)
     {
-        size_t unpackIndex = 0;
-        for (; unpackIndex < toUnpack.size(); unpackIndex++)
-        {
-            PerUnpack& unpackSpec = toUnpack[unpackIndex];
-            std::string_view key = unpackSpec.key;
-            size_t keysplitIndex = key.find('/');
-            std::string_view leftover;
-            if (keysplitIndex != std::string_view::npos)
-            {
-                leftover = key.substr(keysplitIndex + 1);
-                key = key.substr(0, keysplitIndex);
-            }
+        std::string_view key = toUnpack[i].key;
+        index.push_back({key.substr(0, key.find('/')), i});
+    }
+    std::sort(index.begin(), index.end());
 
-            if (key != item.key() || unpackSpec.complete)
-            {
-                continue;
-            }
+    for (auto& [itemKey, itemValue] : *object)
+    {
+        auto found = std::lower_bound(
+            index.begin(), index.end(), itemKey,
+            [](const UnpackIndex& entry, std::string_view key) {
+            return entry.key < key;
+        });
+        while (found != index.end() && found->key == itemKey &&
+               toUnpack[found->unpackIndex].complete)
+        {
+            found++;
+        }
+        if (found == index.end() || found->key != itemKey)
+        {
+            messages::propertyUnknown(res, itemKey);
+            result = false;
+            continue;
+        }
 
-            // Sublevel key
-            if (!leftover.empty())
+        PerUnpack& unpackSpec = toUnpack[found->unpackIndex];
+        // Sublevel key
+        if (unpackSpec.key.size() > found->key.size())
+        {
+            // Include the slash in the key so we can compare later
+            std::string_view key =
+                unpackSpec.key.substr(0, found->key.size() + 1);
+            std::vector<PerUnpack> nextLevel;
+            for (PerUnpack& p : toUnpack)
             {
-                // Include the slash in the key so we can compare later
-                key = unpackSpec.key.substr(0, keysplitIndex + 1);
-                nlohmann::json j;
-                result = details::unpackValue<nlohmann::json>(item.value(), key,
-                                                              res, j) &&
-                         result;
-                if (!result)
+                if (!p.key.starts_with(key))
                 {
-                    return result;
+                    continue;
                 }
-
-                std::vector<PerUnpack> nextLevel;
-                for (PerUnpack& p : toUnpack)
-                {
-                    if (!p.key.starts_with(key))
-                    {
-                        continue;
-                    }
-                    std::string_view thisLeftover = p.key.substr(key.size());
-                    nextLevel.push_back({thisLeftover, p.value, false});
-                    p.complete = true;
-                }
-
-                result = readJsonHelper(j, res, nextLevel) && result;
-                break;
+                std::string_view thisLeftover = p.key.substr(key.size());
+                nextLevel.push_back({thisLeftover, p.value, false});
+                p.complete = true;
             }
 
-            result = std::visit(
-                         [&item, &unpackSpec, &res](auto&& val) {
-                using ContainedT =
-                    std::remove_pointer_t<std::decay_t<decltype(val)>>;
-                return details::unpackValue<ContainedT>(
-                    item.value(), unpackSpec.key, res, *val);
-            },
-                         unpackSpec.value) &&
-                     result;
-
-            unpackSpec.complete = true;
-            break;
+            result = readJsonHelper(itemValue, res, nextLevel) && result;
+            continue;
         }
 
-        if (unpackIndex == toUnpack.size())
-        {
-            messages::propertyUnknown(res, item.key());
-            result = false;
-        }
+        result = std::visit(
+                     [&itemValue, &unpackSpec, &res](auto&& val) {
+            using ContainedT =
+                std::remove_pointer_t<std::decay_t<decltype(val)>>;
+            return details::unpackValue<ContainedT>(itemValue, unpackSpec.key,
+                                                    res, *val);
+        },
+                     unpackSpec.value) &&
+                 result;
+
+        unpackSpec.complete = true;
     }
 
     for (PerUnpack& perUnpack : toUnpack)
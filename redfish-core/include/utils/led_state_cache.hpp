@@ -0,0 +1,289 @@
+#pragma once
+
+#include "dbus_utility.hpp"
+#include "logging.hpp"
+
+#include <sdbusplus/asio/connection.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace redfish
+{
+namespace led_utils
+{
+
+/**
+ * @brief The identifying LED groups of inventory items, and whether each
+ * group is asserted, as last read or signalled.
+ *
+ * Entries are filled by the LocationIndicatorActive reads and kept current
+ * by signals: Led.Group Asserted changes update the state in place, changes
+ * to an item's identifying association drop that item's groups, and a well
+ * known name changing owner drops everything.  Reads that were in flight
+ * when something changed are not stored; see generation().
+ */
+class LedStateCache
+{
+  public:
+    static constexpr std::string_view mapperService =
+        "xyz.openbmc_project.ObjectMapper";
+    static constexpr std::string_view associationInterface =
+        "xyz.openbmc_project.Association";
+    static constexpr std::string_view ledGroupInterface =
+        "xyz.openbmc_project.Led.Group";
+    static constexpr std::string_view identifyingSuffix = "/identifying";
+
+    static LedStateCache& getInstance()
+    {
+        static LedStateCache cache;
+        return cache;
+    }
+
+    LedStateCache(const LedStateCache&) = delete;
+    LedStateCache(LedStateCache&&) = delete;
+    LedStateCache& operator=(const LedStateCache&) = delete;
+    LedStateCache& operator=(LedStateCache&&) = delete;
+    ~LedStateCache() = default;
+
+    void registerMatches(sdbusplus::asio::connection& conn)
+    {
+        namespace rules = sdbusplus::bus::match::rules;
+        std::string mapper(mapperService);
+
+        matches.clear();
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn,
+            rules::type::signal() + rules::member("PropertiesChanged") +
+                rules::interface("org.freedesktop.DBus.Properties") +
+                rules::argN(0, std::string(ledGroupInterface)),
+            [this](sdbusplus::message_t& msg) { onLedChanged(msg); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn,
+            rules::type::signal() + rules::sender(mapper) +
+                rules::member("PropertiesChanged") +
+                rules::interface("org.freedesktop.DBus.Properties") +
+                rules::argN(0, std::string(associationInterface)),
+            [this](sdbusplus::message_t& msg) {
+            associationChanged(msg.get_path());
+        }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::interfacesAdded(),
+            [this](sdbusplus::message_t& msg) { onInterfacesAdded(msg); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::interfacesRemoved(),
+            [this](sdbusplus::message_t& msg) { onInterfacesRemoved(msg); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::nameOwnerChanged(),
+            [this](sdbusplus::message_t& msg) { onNameOwnerChanged(msg); }));
+        clear();
+    }
+
+    bool enabled() const
+    {
+        return !matches.empty();
+    }
+
+    // Moves on whenever something cached may have changed.  A read started
+    // at one generation is only stored if it is still current.
+    uint64_t generation() const
+    {
+        return currentGeneration;
+    }
+
+    // The identifying LED groups of objPath, or nullptr if not cached
+    const dbus::utility::MapperEndPoints*
+        identifyingLeds(const std::string& objPath) const
+    {
+        auto it = identifying.find(objPath);
+        if (it == identifying.end())
+        {
+            return nullptr;
+        }
+        return &it->second;
+    }
+
+    void setIdentifyingLeds(const std::string& objPath,
+                            dbus::utility::MapperEndPoints endpoints,
+                            uint64_t readGeneration)
+    {
+        if (enabled() && readGeneration == currentGeneration)
+        {
+            identifying.insert_or_assign(objPath, std::move(endpoints));
+        }
+    }
+
+    std::optional<bool> asserted(const std::string& ledGroup) const
+    {
+        auto it = assertedByGroup.find(ledGroup);
+        if (it == assertedByGroup.end())
+        {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    void setAsserted(const std::string& ledGroup, bool value,
+                     uint64_t readGeneration)
+    {
+        if (enabled() && readGeneration == currentGeneration)
+        {
+            assertedByGroup.insert_or_assign(ledGroup, value);
+        }
+    }
+
+    void clear()
+    {
+        identifying.clear();
+        assertedByGroup.clear();
+        currentGeneration++;
+    }
+
+  private:
+    LedStateCache() = default;
+
+    // Applies the Asserted value of a group, if the properties carry one
+    void updateAsserted(const std::string& ledGroup,
+                        const dbus::utility::DBusPropertiesMap& properties)
+    {
+        for (const auto& [name, value] : properties)
+        {
+            if (name != "Asserted")
+            {
+                continue;
+            }
+            const bool* assertedValue = std::get_if<bool>(&value);
+            currentGeneration++;
+            if (assertedValue == nullptr)
+            {
+                assertedByGroup.erase(ledGroup);
+                return;
+            }
+            assertedByGroup.insert_or_assign(ledGroup, *assertedValue);
+        }
+    }
+
+    void associationChanged(std::string_view path)
+    {
+        if (!path.ends_with(identifyingSuffix))
+        {
+            return;
+        }
+        path.remove_suffix(identifyingSuffix.size());
+        identifying.erase(std::string(path));
+        currentGeneration++;
+    }
+
+    void onLedChanged(sdbusplus::message_t& msg)
+    {
+        std::string interface;
+        dbus::utility::DBusPropertiesMap properties;
+        try
+        {
+            msg.read(interface, properties);
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            BMCWEB_LOG_ERROR << "Failed to read LED change: " << e.what();
+            clear();
+            return;
+        }
+        updateAsserted(msg.get_path(), properties);
+    }
+
+    void onInterfacesAdded(sdbusplus::message_t& msg)
+    {
+        sdbusplus::message::object_path path;
+        dbus::utility::DBusInteracesMap interfaces;
+        try
+        {
+            msg.read(path, interfaces);
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            BMCWEB_LOG_ERROR << "Failed to read added interfaces: "
+                             << e.what();
+            clear();
+            return;
+        }
+        for (const auto& [interface, properties] : interfaces)
+        {
+            if (interface == ledGroupInterface)
+            {
+                updateAsserted(path.str, properties);
+            }
+            else if (interface == associationInterface)
+            {
+                associationChanged(path.str);
+            }
+        }
+    }
+
+    void onInterfacesRemoved(sdbusplus::message_t& msg)
+    {
+        sdbusplus::message::object_path path;
+        std::vector<std::string> interfaces;
+        try
+        {
+            msg.read(path, interfaces);
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            BMCWEB_LOG_ERROR << "Failed to read removed interfaces: "
+                             << e.what();
+            clear();
+            return;
+        }
+        for (const std::string& interface : interfaces)
+        {
+            if (interface == ledGroupInterface)
+            {
+                assertedByGroup.erase(path.str);
+                currentGeneration++;
+            }
+            else if (interface == associationInterface)
+            {
+                associationChanged(path.str);
+            }
+        }
+    }
+
+    // A service going away takes its groups with it without signalling
+    // them one by one; unique names are only clients
+    void onNameOwnerChanged(sdbusplus::message_t& msg)
+    {
+        std::string name;
+        try
+        {
+            msg.read(name);
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            BMCWEB_LOG_ERROR << "Failed to read owner change: " << e.what();
+            clear();
+            return;
+        }
+        if (!name.starts_with(':'))
+        {
+            clear();
+        }
+    }
+
+    std::unordered_map<std::string, dbus::utility::MapperEndPoints>
+        identifying;
+    std::unordered_map<std::string, bool> assertedByGroup;
+    uint64_t currentGeneration = 0;
+    std::vector<std::unique_ptr<sdbusplus::bus::match_t>> matches;
+};
+
+} // namespace led_utils
+} // namespace redfish
@@ -0,0 +1,198 @@
+#pragma once
+
+#include "dbus_singleton.hpp"
+#include "dbus_utility.hpp"
+#include "logging.hpp"
+
+#include <boost/asio/post.hpp>
+#include <boost/container/flat_set.hpp>
+#include <sdbusplus/asio/connection.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace redfish
+{
+namespace network_utils
+{
+
+/**
+ * @brief Everything a network service exposes under its object manager, as
+ * returned by one GetManagedObjects: interfaces, IPv4/IPv6 addresses, DHCP
+ * configuration, VLANs and static routes.
+ */
+struct NetworkState
+{
+    explicit NetworkState(dbus::utility::ManagedObjectType&& objectsIn) :
+        objects(std::move(objectsIn))
+    {
+        for (const auto& [path, interfaces] : objects)
+        {
+            for (const auto& [interface, properties] : interfaces)
+            {
+                if (interface ==
+                    "xyz.openbmc_project.Network.EthernetInterface")
+                {
+                    std::string ifaceId = path.filename();
+                    if (!ifaceId.empty())
+                    {
+                        ethernetInterfaces.emplace(std::move(ifaceId));
+                    }
+                }
+            }
+        }
+    }
+
+    dbus::utility::ManagedObjectType objects;
+    // Ids of the objects implementing EthernetInterface, VLANs included
+    boost::container::flat_set<std::string> ethernetInterfaces;
+};
+
+/**
+ * @brief The last NetworkState read from a network service.
+ *
+ * The state is read on first use and handed to every request until the
+ * service signals a change under its tree, or changes owner; then it is
+ * dropped and read again on next use.  Concurrent reads share one
+ * GetManagedObjects call, and a read that was in flight when a change was
+ * signalled is answered but not kept.
+ */
+class NetworkStateCache
+{
+  public:
+    using Callback =
+        std::function<void(const boost::system::error_code&,
+                           const std::shared_ptr<const NetworkState>&)>;
+
+    // phosphor-networkd
+    static NetworkStateCache& getInstance()
+    {
+        static NetworkStateCache cache("xyz.openbmc_project.Network",
+                                       "/xyz/openbmc_project/network");
+        return cache;
+    }
+
+    static NetworkStateCache& getHypervisorInstance()
+    {
+        static NetworkStateCache cache(
+            "xyz.openbmc_project.Network.Hypervisor",
+            "/xyz/openbmc_project/network/hypervisor");
+        return cache;
+    }
+
+    NetworkStateCache(const NetworkStateCache&) = delete;
+    NetworkStateCache(NetworkStateCache&&) = delete;
+    NetworkStateCache& operator=(const NetworkStateCache&) = delete;
+    NetworkStateCache& operator=(NetworkStateCache&&) = delete;
+    ~NetworkStateCache() = default;
+
+    void registerMatches(sdbusplus::asio::connection& conn)
+    {
+        namespace rules = sdbusplus::bus::match::rules;
+
+        // PropertiesChanged, InterfacesAdded and InterfacesRemoved are all
+        // sent from within the service's tree
+        matches.clear();
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn,
+            rules::type::signal() + rules::sender(service) +
+                rules::path_namespace(rootPath),
+            [this](sdbusplus::message_t& /*msg*/) { clear(); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::nameOwnerChanged() + rules::argN(0, service),
+            [this](sdbusplus::message_t& /*msg*/) { clear(); }));
+        clear();
+    }
+
+    bool enabled() const
+    {
+        return !matches.empty();
+    }
+
+    /**
+     * @brief Calls callback with the state of the service, reading it if it
+     * isn't cached.  The callback is never called inline.
+     */
+    void get(Callback&& callback)
+    {
+        if (state)
+        {
+            std::shared_ptr<const NetworkState> current = state;
+            boost::asio::post(crow::connections::systemBus->get_io_context(),
+                              [current, callback{std::move(callback)}]() {
+                callback(boost::system::error_code(), current);
+            });
+            return;
+        }
+
+        callbacks.emplace_back(std::move(callback));
+        if (callbacks.size() > 1)
+        {
+            return;
+        }
+        crow::dbus_trace::SharedCallScope sharedCalls;
+        crow::connections::systemBus->async_method_call(
+            [this, fetchGeneration{generation}](
+                const boost::system::error_code& ec,
+                dbus::utility::ManagedObjectType& objects) {
+            afterGetManagedObjects(fetchGeneration, ec, objects);
+        },
+            service, rootPath, "org.freedesktop.DBus.ObjectManager",
+            "GetManagedObjects");
+    }
+
+    void clear()
+    {
+        state.reset();
+        generation++;
+    }
+
+  private:
+    NetworkStateCache(std::string_view serviceIn, std::string_view rootPathIn) :
+        service(serviceIn), rootPath(rootPathIn)
+    {}
+
+    void afterGetManagedObjects(uint64_t fetchGeneration,
+                                const boost::system::error_code& ec,
+                                dbus::utility::ManagedObjectType& objects)
+    {
+        std::vector<Callback> waiting = std::move(callbacks);
+        callbacks.clear();
+
+        std::shared_ptr<const NetworkState> read;
+        if (ec)
+        {
+            BMCWEB_LOG_DEBUG << "GetManagedObjects of " << service
+                             << " failed: " << ec;
+        }
+        else
+        {
+            read = std::make_shared<const NetworkState>(std::move(objects));
+            if (enabled() && fetchGeneration == generation)
+            {
+                state = read;
+            }
+        }
+        for (Callback& callback : waiting)
+        {
+            callback(ec, read);
+        }
+    }
+
+    std::string service;
+    std::string rootPath;
+    std::shared_ptr<const NetworkState> state;
+    std::vector<Callback> callbacks;
+    uint64_t generation = 0;
+    std::vector<std::unique_ptr<sdbusplus::bus::match_t>> matches;
+};
+
+} // namespace network_utils
+} // namespace redfish
@@ -0,0 +1,364 @@
+#pragma once
+
+#include "dbus_singleton.hpp"
+#include "dbus_utility.hpp"
+#include "logging.hpp"
+#include "utils/pcie_util.hpp"
+
+#include <boost/asio/post.hpp>
+#include <sdbusplus/asio/connection.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace redfish
+{
+namespace pcie_util
+{
+
+/**
+ * @brief The PCIe devices and slots under the inventory, and which device
+ * sits in which slot, as built from one GetSubTree of both interfaces.
+ *
+ * Devices are found by the unique name Redfish knows them by, so a lookup
+ * doesn't rebuild the name of every device path.  PCIeFunctions are
+ * properties of the device objects and need nothing of their own here.
+ */
+class PcieTopology
+{
+  public:
+    static constexpr std::string_view deviceInterface =
+        "xyz.openbmc_project.Inventory.Item.PCIeDevice";
+    static constexpr std::string_view slotInterface =
+        "xyz.openbmc_project.Inventory.Item.PCIeSlot";
+    static constexpr std::array<std::string_view, 2> interfaces = {
+        deviceInterface, slotInterface};
+
+    struct Device
+    {
+        std::string path;
+        std::string name;
+        // First service, by name, implementing the PCIeDevice interface
+        std::string service;
+    };
+
+    struct Slot
+    {
+        std::string path;
+        // Services implementing the PCIeSlot interface
+        dbus::utility::MapperServiceMap serviceMap;
+        // Indexes of the devices directly under the slot, in path order
+        std::vector<size_t> devices;
+    };
+
+    static bool isTopologyInterface(std::string_view interface)
+    {
+        return interface == deviceInterface || interface == slotInterface;
+    }
+
+    explicit PcieTopology(const dbus::utility::MapperGetSubTreeResponse& tree)
+    {
+        std::vector<std::pair<std::string, std::string>> devicePaths;
+        for (const auto& [path, serviceMap] : tree)
+        {
+            std::string deviceService;
+            dbus::utility::MapperServiceMap slotServices;
+            for (const auto& [service, serviceInterfaces] : serviceMap)
+            {
+                if (std::find(serviceInterfaces.begin(),
+                              serviceInterfaces.end(),
+                              deviceInterface) != serviceInterfaces.end() &&
+                    (deviceService.empty() || service < deviceService))
+                {
+                    deviceService = service;
+                }
+                if (std::find(serviceInterfaces.begin(),
+                              serviceInterfaces.end(),
+                              slotInterface) != serviceInterfaces.end())
+                {
+                    slotServices.emplace_back(service, serviceInterfaces);
+                }
+            }
+            if (!deviceService.empty())
+            {
+                devicePaths.emplace_back(path, std::move(deviceService));
+            }
+            if (!slotServices.empty())
+            {
+                slotIndex.try_emplace(path, slotList.size());
+                slotList.push_back({path, std::move(slotServices), {}});
+            }
+        }
+
+        std::sort(devicePaths.begin(), devicePaths.end());
+        deviceList.reserve(devicePaths.size());
+        for (auto& [path, service] : devicePaths)
+        {
+            std::string name = buildPCIeUniquePath(path);
+            // The first path wins when two devices build the same name
+            deviceIndex.try_emplace(name, deviceList.size());
+            std::string parent = sdbusplus::message::object_path(path)
+                                     .parent_path()
+                                     .str;
+            auto slot = slotIndex.find(parent);
+            if (slot != slotIndex.end())
+            {
+                slotList[slot->second].devices.push_back(deviceList.size());
+            }
+            deviceList.push_back(
+                {std::move(path), std::move(name), std::move(service)});
+        }
+    }
+
+    // Every device, in path order
+    const std::vector<Device>& devices() const
+    {
+        return deviceList;
+    }
+
+    const Device* findDevice(const std::string& name) const
+    {
+        auto it = deviceIndex.find(name);
+        if (it == deviceIndex.end())
+        {
+            return nullptr;
+        }
+        return &deviceList[it->second];
+    }
+
+    const Slot* findSlot(const std::string& path) const
+    {
+        auto it = slotIndex.find(path);
+        if (it == slotIndex.end())
+        {
+            return nullptr;
+        }
+        return &slotList[it->second];
+    }
+
+    // The slot the device sits in, or nullptr
+    const Slot* slotOf(const Device& device) const
+    {
+        return findSlot(
+            sdbusplus::message::object_path(device.path).parent_path().str);
+    }
+
+    // The first device in the slot, or nullptr
+    const Device* deviceIn(const Slot& slot) const
+    {
+        if (slot.devices.empty())
+        {
+            return nullptr;
+        }
+        return &deviceList[slot.devices.front()];
+    }
+
+  private:
+    std::vector<Device> deviceList;
+    std::unordered_map<std::string, size_t> deviceIndex;
+    std::vector<Slot> slotList;
+    std::unordered_map<std::string, size_t> slotIndex;
+};
+
+/**
+ * @brief Holds the PcieTopology, so PCIeDevice, PCIeFunction and PCIeSlot
+ * requests don't each search the inventory for the device they name.
+ *
+ * The topology is dropped when a PCIeDevice or PCIeSlot interface is added
+ * or removed, when a well known name changes owner, and when a PCIe
+ * topology refresh is requested; the next request builds it again.  The
+ * properties of the devices and slots are always read live.
+ */
+class PcieTopologyCache
+{
+  public:
+    using Callback =
+        std::function<void(const boost::system::error_code&,
+                           const std::shared_ptr<const PcieTopology>&)>;
+
+    static PcieTopologyCache& getInstance()
+    {
+        static PcieTopologyCache cache;
+        return cache;
+    }
+
+    PcieTopologyCache(const PcieTopologyCache&) = delete;
+    PcieTopologyCache(PcieTopologyCache&&) = delete;
+    PcieTopologyCache& operator=(const PcieTopologyCache&) = delete;
+    PcieTopologyCache& operator=(PcieTopologyCache&&) = delete;
+    ~PcieTopologyCache() = default;
+
+    void registerMatches(sdbusplus::asio::connection& conn)
+    {
+        namespace rules = sdbusplus::bus::match::rules;
+
+        matches.clear();
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::interfacesAdded(),
+            [this](sdbusplus::message_t& msg) { onInterfacesAdded(msg); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::interfacesRemoved(),
+            [this](sdbusplus::message_t& msg) { onInterfacesRemoved(msg); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::nameOwnerChanged(),
+            [this](sdbusplus::message_t& msg) { onNameOwnerChanged(msg); }));
+        clear();
+    }
+
+    bool enabled() const
+    {
+        return !matches.empty();
+    }
+
+    /**
+     * @brief Calls callback with the topology, building it if it isn't
+     * cached.  Concurrent builds share one GetSubTree.  The callback is never
+     * called inline.
+     */
+    void get(Callback&& callback)
+    {
+        if (topology)
+        {
+            std::shared_ptr<const PcieTopology> current = topology;
+            boost::asio::post(crow::connections::systemBus->get_io_context(),
+                              [current, callback{std::move(callback)}]() {
+                callback(boost::system::error_code(), current);
+            });
+            return;
+        }
+
+        callbacks.emplace_back(std::move(callback));
+        if (callbacks.size() > 1)
+        {
+            return;
+        }
+        crow::dbus_trace::SharedCallScope sharedCalls;
+        dbus::utility::getSubTree(
+            "/xyz/openbmc_project/inventory", 0, PcieTopology::interfaces,
+            [this, fetchGeneration{generation}](
+                const boost::system::error_code& ec,
+                const dbus::utility::MapperGetSubTreeResponse& tree) {
+            afterGetSubTree(fetchGeneration, ec, tree);
+        });
+    }
+
+    void clear()
+    {
+        topology.reset();
+        generation++;
+    }
+
+  private:
+    PcieTopologyCache() = default;
+
+    void afterGetSubTree(uint64_t fetchGeneration,
+                         const boost::system::error_code& ec,
+                         const dbus::utility::MapperGetSubTreeResponse& tree)
+    {
+        std::vector<Callback> waiting = std::move(callbacks);
+        callbacks.clear();
+
+        std::shared_ptr<const PcieTopology> built;
+        if (!ec)
+        {
+            built = std::make_shared<const PcieTopology>(tree);
+            // A change signalled while the call was in flight may not be in
+            // the reply, so only keep it if nothing changed meanwhile
+            if (enabled() && fetchGeneration == generation)
+            {
+                topology = built;
+            }
+        }
+        for (Callback& callback : waiting)
+        {
+            callback(ec, built);
+        }
+    }
+
+    void onInterfacesAdded(sdbusplus::message_t& msg)
+    {
+        sdbusplus::message::object_path path;
+        dbus::utility::DBusInteracesMap interfaces;
+        try
+        {
+            msg.read(path, interfaces);
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            BMCWEB_LOG_ERROR << "Failed to read added interfaces: "
+                             << e.what();
+            clear();
+            return;
+        }
+        for (const auto& [interface, properties] : interfaces)
+        {
+            if (PcieTopology::isTopologyInterface(interface))
+            {
+                clear();
+                return;
+            }
+        }
+    }
+
+    void onInterfacesRemoved(sdbusplus::message_t& msg)
+    {
+        sdbusplus::message::object_path path;
+        std::vector<std::string> interfaces;
+        try
+        {
+            msg.read(path, interfaces);
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            BMCWEB_LOG_ERROR << "Failed to read removed interfaces: "
+                             << e.what();
+            clear();
+            return;
+        }
+        if (std::any_of(interfaces.begin(), interfaces.end(),
+                        PcieTopology::isTopologyInterface))
+        {
+            clear();
+        }
+    }
+
+    // A service coming or going can take PCIe objects with it without
+    // signalling them one by one; unique names are only clients
+    void onNameOwnerChanged(sdbusplus::message_t& msg)
+    {
+        std::string name;
+        try
+        {
+            msg.read(name);
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            BMCWEB_LOG_ERROR << "Failed to read owner change: " << e.what();
+            clear();
+            return;
+        }
+        if (!name.starts_with(':'))
+        {
+            clear();
+        }
+    }
+
+    std::shared_ptr<const PcieTopology> topology;
+    std::vector<Callback> callbacks;
+    uint64_t generation = 0;
+    std::vector<std::unique_ptr<sdbusplus::bus::match_t>> matches;
+};
+
+} // namespace pcie_util
+} // namespace redfish
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <sdbusplus/message.hpp>
+
 #include <string>
 
 namespace redfish
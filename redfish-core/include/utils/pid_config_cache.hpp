@@ -0,0 +1,880 @@
+#pragma once
+
+#include "dbus_singleton.hpp"
+#include "dbus_utility.hpp"
+#include "logging.hpp"
+#include "utils/dbus_utils.hpp"
+
+#include <boost/asio/post.hpp>
+#include <boost/container/flat_map.hpp>
+#include <boost/container/flat_set.hpp>
+#include <nlohmann/json.hpp>
+#include <sdbusplus/asio/connection.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/message.hpp>
+#include <sdbusplus/unpack_properties.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace redfish
+{
+
+static constexpr const char* objectManagerIface =
+    "org.freedesktop.DBus.ObjectManager";
+static constexpr const char* pidConfigurationIface =
+    "xyz.openbmc_project.Configuration.Pid";
+static constexpr const char* pidZoneConfigurationIface =
+    "xyz.openbmc_project.Configuration.Pid.Zone";
+static constexpr const char* stepwiseConfigurationIface =
+    "xyz.openbmc_project.Configuration.Stepwise";
+static constexpr const char* thermalModeIface =
+    "xyz.openbmc_project.Control.ThermalMode";
+
+namespace pid_util
+{
+
+/**
+ * @brief Renders the Oem/OpenBmc/Fan object of the Manager from the PID,
+ * zone and stepwise configurations in managedObj, keeping those of
+ * currentProfile.
+ *
+ * @return false if a configuration has a property of the wrong type
+ */
+inline bool populatePid(const dbus::utility::ManagedObjectType& managedObj,
+                        const std::string& currentProfile,
+                        const std::vector<std::string>& supportedProfiles,
+                        nlohmann::json& configRoot)
+{
+    nlohmann::json& fans = configRoot["FanControllers"];
+    fans["@odata.type"] = "#OemManager.FanControllers";
+    fans["@odata.id"] =
+        "/redfish/v1/Managers/bmc#/Oem/OpenBmc/Fan/FanControllers";
+
+    nlohmann::json& pids = configRoot["PidControllers"];
+    pids["@odata.type"] = "#OemManager.PidControllers";
+    pids["@odata.id"] =
+        "/redfish/v1/Managers/bmc#/Oem/OpenBmc/Fan/PidControllers";
+
+    nlohmann::json& stepwise = configRoot["StepwiseControllers"];
+    stepwise["@odata.type"] = "#OemManager.StepwiseControllers";
+    stepwise["@odata.id"] =
+        "/redfish/v1/Managers/bmc#/Oem/OpenBmc/Fan/StepwiseControllers";
+
+    nlohmann::json& zones = configRoot["FanZones"];
+    zones["@odata.id"] =
+        "/redfish/v1/Managers/bmc#/Oem/OpenBmc/Fan/FanZones";
+    zones["@odata.type"] = "#OemManager.FanZones";
+    configRoot["@odata.id"] = "/redfish/v1/Managers/bmc#/Oem/OpenBmc/Fan";
+    configRoot["@odata.type"] = "#OemManager.Fan";
+    configRoot["Profile@Redfish.AllowableValues"] = supportedProfiles;
+
+    if (!currentProfile.empty())
+    {
+        configRoot["Profile"] = currentProfile;
+    }
+    BMCWEB_LOG_ERROR << "profile = " << currentProfile << " !";
+
+    for (const auto& pathPair : managedObj)
+    {
+        for (const auto& intfPair : pathPair.second)
+        {
+            if (intfPair.first != pidConfigurationIface &&
+                intfPair.first != pidZoneConfigurationIface &&
+                intfPair.first != stepwiseConfigurationIface)
+            {
+                continue;
+            }
+
+            std::string name;
+
+            for (const std::pair<std::string,
+                                 dbus::utility::DbusVariantType>& propPair :
+                 intfPair.second)
+            {
+                if (propPair.first == "Name")
+                {
+                    const std::string* namePtr =
+                        std::get_if<std::string>(&propPair.second);
+                    if (namePtr == nullptr)
+                    {
+                        BMCWEB_LOG_ERROR << "Pid Name Field illegal";
+                        return false;
+                    }
+                    name = *namePtr;
+                    dbus::utility::escapePathForDbus(name);
+                }
+                else if (propPair.first == "Profiles")
+                {
+                    const std::vector<std::string>* profiles =
+                        std::get_if<std::vector<std::string>>(
+                            &propPair.second);
+                    if (profiles == nullptr)
+                    {
+                        BMCWEB_LOG_ERROR << "Pid Profiles Field illegal";
+                        return false;
+                    }
+                    if (std::find(profiles->begin(), profiles->end(),
+                                  currentProfile) == profiles->end())
+                    {
+                        BMCWEB_LOG_INFO
+                            << name << " not supported in current profile";
+                        continue;
+                    }
+                }
+            }
+            nlohmann::json* config = nullptr;
+            const std::string* classPtr = nullptr;
+
+            for (const std::pair<std::string,
+                                 dbus::utility::DbusVariantType>& propPair :
+                 intfPair.second)
+            {
+                if (propPair.first == "Class")
+                {
+                    classPtr = std::get_if<std::string>(&propPair.second);
+                }
+            }
+
+            if (intfPair.first == pidZoneConfigurationIface)
+            {
+                std::string chassis;
+                if (!dbus::utility::getNthStringFromPath(pathPair.first.str,
+                                                         5, chassis))
+                {
+                    chassis = "#IllegalValue";
+                }
+                nlohmann::json& zone = zones[name];
+                zone["Chassis"]["@odata.id"] = "/redfish/v1/Chassis/" +
+                                               chassis;
+                zone["@odata.id"] =
+                    "/redfish/v1/Managers/bmc#/Oem/OpenBmc/Fan/FanZones/" +
+                    name;
+                zone["@odata.type"] = "#OemManager.FanZone";
+                config = &zone;
+            }
+
+            else if (intfPair.first == stepwiseConfigurationIface)
+            {
+                if (classPtr == nullptr)
+                {
+                    BMCWEB_LOG_ERROR << "Pid Class Field illegal";
+                    return false;
+                }
+
+                nlohmann::json& controller = stepwise[name];
+                config = &controller;
+
+                controller["@odata.id"] =
+                    "/redfish/v1/Managers/bmc#/Oem/OpenBmc/Fan/StepwiseControllers/" +
+                    name;
+                controller["@odata.type"] =
+                    "#OemManager.StepwiseController";
+
+                controller["Direction"] = *classPtr;
+            }
+
+            // pid and fans are off the same configuration
+            else if (intfPair.first == pidConfigurationIface)
+            {
+                if (classPtr == nullptr)
+                {
+                    BMCWEB_LOG_ERROR << "Pid Class Field illegal";
+                    return false;
+                }
+                bool isFan = *classPtr == "fan";
+                nlohmann::json& element = isFan ? fans[name] : pids[name];
+                config = &element;
+                if (isFan)
+                {
+                    element["@odata.id"] =
+                        "/redfish/v1/Managers/bmc#/Oem/OpenBmc/Fan/FanControllers/" +
+                        name;
+                    element["@odata.type"] = "#OemManager.FanController";
+                }
+                else
+                {
+                    element["@odata.id"] =
+                        "/redfish/v1/Managers/bmc#/Oem/OpenBmc/Fan/PidControllers/" +
+                        name;
+                    element["@odata.type"] = "#OemManager.PidController";
+                }
+            }
+            else
+            {
+                BMCWEB_LOG_ERROR << "Unexpected configuration";
+                return false;
+            }
+
+            // used for making maps out of 2 vectors
+            const std::vector<double>* keys = nullptr;
+            const std::vector<double>* values = nullptr;
+
+            for (const auto& propertyPair : intfPair.second)
+            {
+                if (propertyPair.first == "Type" ||
+                    propertyPair.first == "Class" ||
+                    propertyPair.first == "Name")
+                {
+                    continue;
+                }
+
+                // zones
+                if (intfPair.first == pidZoneConfigurationIface)
+                {
+                    const double* ptr =
+                        std::get_if<double>(&propertyPair.second);
+                    if (ptr == nullptr)
+                    {
+                        BMCWEB_LOG_ERROR << "Field Illegal "
+                                         << propertyPair.first;
+                        return false;
+                    }
+                    (*config)[propertyPair.first] = *ptr;
+                }
+
+                if (intfPair.first == stepwiseConfigurationIface)
+                {
+                    if (propertyPair.first == "Reading" ||
+                        propertyPair.first == "Output")
+                    {
+                        const std::vector<double>* ptr =
+                            std::get_if<std::vector<double>>(
+                                &propertyPair.second);
+
+                        if (ptr == nullptr)
+                        {
+                            BMCWEB_LOG_ERROR << "Field Illegal "
+                                             << propertyPair.first;
+                            return false;
+                        }
+
+                        if (propertyPair.first == "Reading")
+                        {
+                            keys = ptr;
+                        }
+                        else
+                        {
+                            values = ptr;
+                        }
+                        if (keys != nullptr && values != nullptr)
+                        {
+                            if (keys->size() != values->size())
+                            {
+                                BMCWEB_LOG_ERROR
+                                    << "Reading and Output size don't match ";
+                                return false;
+                            }
+                            nlohmann::json& steps = (*config)["Steps"];
+                            steps = nlohmann::json::array();
+                            for (size_t ii = 0; ii < keys->size(); ii++)
+                            {
+                                nlohmann::json::object_t step;
+                                step["Target"] = (*keys)[ii];
+                                step["Output"] = (*values)[ii];
+                                steps.push_back(std::move(step));
+                            }
+                        }
+                    }
+                    if (propertyPair.first == "NegativeHysteresis" ||
+                        propertyPair.first == "PositiveHysteresis")
+                    {
+                        const double* ptr =
+                            std::get_if<double>(&propertyPair.second);
+                        if (ptr == nullptr)
+                        {
+                            BMCWEB_LOG_ERROR << "Field Illegal "
+                                             << propertyPair.first;
+                            return false;
+                        }
+                        (*config)[propertyPair.first] = *ptr;
+                    }
+                }
+
+                // pid and fans are off the same configuration
+                if (intfPair.first == pidConfigurationIface ||
+                    intfPair.first == stepwiseConfigurationIface)
+                {
+                    if (propertyPair.first == "Zones")
+                    {
+                        const std::vector<std::string>* inputs =
+                            std::get_if<std::vector<std::string>>(
+                                &propertyPair.second);
+
+                        if (inputs == nullptr)
+                        {
+                            BMCWEB_LOG_ERROR << "Zones Pid Field Illegal";
+                            return false;
+                        }
+                        auto& data = (*config)[propertyPair.first];
+                        data = nlohmann::json::array();
+                        for (std::string itemCopy : *inputs)
+                        {
+                            dbus::utility::escapePathForDbus(itemCopy);
+                            nlohmann::json::object_t input;
+                            input["@odata.id"] =
+                                "/redfish/v1/Managers/bmc#/Oem/OpenBmc/Fan/FanZones/" +
+                                itemCopy;
+                            data.push_back(std::move(input));
+                        }
+                    }
+                    // todo(james): may never happen, but this
+                    // assumes configuration data referenced in the
+                    // PID config is provided by the same daemon, we
+                    // could add another loop to cover all cases,
+                    // but I'm okay kicking this can down the road a
+                    // bit
+
+                    else if (propertyPair.first == "Inputs" ||
+                             propertyPair.first == "Outputs")
+                    {
+                        auto& data = (*config)[propertyPair.first];
+                        const std::vector<std::string>* inputs =
+                            std::get_if<std::vector<std::string>>(
+                                &propertyPair.second);
+
+                        if (inputs == nullptr)
+                        {
+                            BMCWEB_LOG_ERROR << "Field Illegal "
+                                             << propertyPair.first;
+                            return false;
+                        }
+                        data = *inputs;
+                    }
+                    else if (propertyPair.first == "SetPointOffset")
+                    {
+                        const std::string* ptr =
+                            std::get_if<std::string>(&propertyPair.second);
+
+                        if (ptr == nullptr)
+                        {
+                            BMCWEB_LOG_ERROR << "Field Illegal "
+                                             << propertyPair.first;
+                            return false;
+                        }
+                        // translate from dbus to redfish
+                        if (*ptr == "WarningHigh")
+                        {
+                            (*config)["SetPointOffset"] =
+                                "UpperThresholdNonCritical";
+                        }
+                        else if (*ptr == "WarningLow")
+                        {
+                            (*config)["SetPointOffset"] =
+                                "LowerThresholdNonCritical";
+                        }
+                        else if (*ptr == "CriticalHigh")
+                        {
+                            (*config)["SetPointOffset"] =
+                                "UpperThresholdCritical";
+                        }
+                        else if (*ptr == "CriticalLow")
+                        {
+                            (*config)["SetPointOffset"] =
+                                "LowerThresholdCritical";
+                        }
+                        else
+                        {
+                            BMCWEB_LOG_ERROR << "Value Illegal " << *ptr;
+                            return false;
+                        }
+                    }
+                    // doubles
+                    else if (propertyPair.first == "FFGainCoefficient" ||
+                             propertyPair.first == "FFOffCoefficient" ||
+                             propertyPair.first == "ICoefficient" ||
+                             propertyPair.first == "ILimitMax" ||
+                             propertyPair.first == "ILimitMin" ||
+                             propertyPair.first == "PositiveHysteresis" ||
+                             propertyPair.first == "NegativeHysteresis" ||
+                             propertyPair.first == "OutLimitMax" ||
+                             propertyPair.first == "OutLimitMin" ||
+                             propertyPair.first == "PCoefficient" ||
+                             propertyPair.first == "SetPoint" ||
+                             propertyPair.first == "SlewNeg" ||
+                             propertyPair.first == "SlewPos")
+                    {
+                        const double* ptr =
+                            std::get_if<double>(&propertyPair.second);
+                        if (ptr == nullptr)
+                        {
+                            BMCWEB_LOG_ERROR << "Field Illegal "
+                                             << propertyPair.first;
+                            return false;
+                        }
+                        (*config)[propertyPair.first] = *ptr;
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief The objects of a GetManagedObjects reply indexed by the last element
+ * of their path, to find an object by the name of a controller, zone or
+ * chassis without walking the whole reply.
+ */
+class ObjectLeafIndex
+{
+  public:
+    using Object = dbus::utility::ManagedObjectType::value_type;
+
+    explicit ObjectLeafIndex(
+        const dbus::utility::ManagedObjectType& objectsIn) :
+        objects(&objectsIn)
+    {
+        byLeaf.reserve(objectsIn.size());
+        for (const Object& object : objectsIn)
+        {
+            std::string_view path = object.first.str;
+            size_t slash = path.rfind('/');
+            if (slash == std::string_view::npos)
+            {
+                continue;
+            }
+            // The first object with a leaf wins, as a search in order would
+            byLeaf.try_emplace(path.substr(slash + 1), &object);
+        }
+    }
+
+    /**
+     * @brief Returns the first object whose path ends with "/" + leaf, or
+     * nullptr if there is none
+     */
+    const Object* find(std::string_view leaf) const
+    {
+        if (leaf.find('/') == std::string_view::npos)
+        {
+            auto it = byLeaf.find(leaf);
+            if (it == byLeaf.end())
+            {
+                return nullptr;
+            }
+            return it->second;
+        }
+        // A leaf with a slash spans several elements; not worth indexing
+        std::string suffix = "/";
+        suffix += leaf;
+        auto it = std::find_if(objects->begin(), objects->end(),
+                               [&suffix](const Object& object) {
+            return object.first.str.ends_with(suffix);
+        });
+        if (it == objects->end())
+        {
+            return nullptr;
+        }
+        return &(*it);
+    }
+
+  private:
+    const dbus::utility::ManagedObjectType* objects;
+    std::unordered_map<std::string_view, const Object*> byLeaf;
+};
+
+/**
+ * @brief The rendered Oem/OpenBmc/Fan object of the Manager.
+ *
+ * Rendering it takes two mapper calls, the thermal mode properties and a
+ * GetManagedObjects of every service holding PID configurations.  The result
+ * is kept until a PID, zone, stepwise or thermal mode interface signals a
+ * change, is added or removed, or a well known name changes owner.
+ * Concurrent reads share one fetch, and a fetch that was in flight during a
+ * change is answered but not kept.
+ */
+class PidConfigCache
+{
+  public:
+    // nullptr when the configuration couldn't be read
+    using Callback =
+        std::function<void(const std::shared_ptr<const nlohmann::json>&)>;
+
+    static PidConfigCache& getInstance()
+    {
+        static PidConfigCache cache;
+        return cache;
+    }
+
+    PidConfigCache(const PidConfigCache&) = delete;
+    PidConfigCache(PidConfigCache&&) = delete;
+    PidConfigCache& operator=(const PidConfigCache&) = delete;
+    PidConfigCache& operator=(PidConfigCache&&) = delete;
+    ~PidConfigCache() = default;
+
+    void registerMatches(sdbusplus::asio::connection& conn)
+    {
+        namespace rules = sdbusplus::bus::match::rules;
+
+        matches.clear();
+        for (const char* interface : watchedInterfaces)
+        {
+            matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+                conn,
+                rules::type::signal() + rules::member("PropertiesChanged") +
+                    rules::interface("org.freedesktop.DBus.Properties") +
+                    rules::argN(0, interface),
+                [this](sdbusplus::message_t& /*msg*/) { clear(); }));
+        }
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::interfacesAdded(),
+            [this](sdbusplus::message_t& msg) { onInterfacesAdded(msg); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::interfacesRemoved(),
+            [this](sdbusplus::message_t& msg) { onInterfacesRemoved(msg); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::nameOwnerChanged(),
+            [this](sdbusplus::message_t& msg) { onNameOwnerChanged(msg); }));
+        clear();
+    }
+
+    bool enabled() const
+    {
+        return !matches.empty();
+    }
+
+    /**
+     * @brief Calls callback with the rendered Fan object, fetching it if it
+     * isn't cached.  The callback is never called inline.
+     */
+    void get(Callback&& callback)
+    {
+        if (rendered)
+        {
+            std::shared_ptr<const nlohmann::json> current = rendered;
+            boost::asio::post(crow::connections::systemBus->get_io_context(),
+                              [current, callback{std::move(callback)}]() {
+                callback(current);
+            });
+            return;
+        }
+
+        callbacks.emplace_back(std::move(callback));
+        if (callbacks.size() > 1)
+        {
+            return;
+        }
+        crow::dbus_trace::SharedCallScope sharedCalls;
+        fetch();
+    }
+
+    void clear()
+    {
+        rendered.reset();
+        generation++;
+    }
+
+  private:
+    PidConfigCache() = default;
+
+    static constexpr std::array<const char*, 4> watchedInterfaces = {
+        pidConfigurationIface, pidZoneConfigurationIface,
+        stepwiseConfigurationIface, thermalModeIface};
+
+    // What one fetch gathers; rendered once the last call is answered
+    struct Fetch
+    {
+        explicit Fetch(uint64_t generationIn) : fetchGeneration(generationIn)
+        {}
+
+        Fetch(const Fetch&) = delete;
+        Fetch(Fetch&&) = delete;
+        Fetch& operator=(const Fetch&) = delete;
+        Fetch& operator=(Fetch&&) = delete;
+
+        ~Fetch()
+        {
+            boost::asio::post(
+                crow::connections::systemBus->get_io_context(),
+                [fetchGeneration{fetchGeneration}, failed{failed},
+                 objects{std::move(objects)},
+                 currentProfile{std::move(currentProfile)},
+                 supportedProfiles{std::move(supportedProfiles)}]() {
+                PidConfigCache::getInstance().afterFetch(
+                    fetchGeneration, failed, objects, currentProfile,
+                    supportedProfiles);
+            });
+        }
+
+        uint64_t fetchGeneration;
+        bool failed = false;
+        dbus::utility::ManagedObjectType objects;
+        std::string currentProfile;
+        std::vector<std::string> supportedProfiles;
+    };
+
+    void fetch()
+    {
+        auto pending = std::make_shared<Fetch>(generation);
+
+        constexpr std::array<std::string_view, 4> configInterfaces = {
+            pidConfigurationIface, pidZoneConfigurationIface,
+            objectManagerIface, stepwiseConfigurationIface};
+        dbus::utility::getSubTree(
+            "/", 0, configInterfaces,
+            [pending](const boost::system::error_code& ec,
+                      const dbus::utility::MapperGetSubTreeResponse& subtree) {
+            if (ec)
+            {
+                BMCWEB_LOG_ERROR << ec;
+                pending->failed = true;
+                return;
+            }
+            readConfigurations(pending, subtree);
+        });
+
+        // at the same time get the selected profile
+        constexpr std::array<std::string_view, 1> thermalModeInterfaces = {
+            thermalModeIface};
+        dbus::utility::getSubTree(
+            "/", 0, thermalModeInterfaces,
+            [pending](const boost::system::error_code& ec,
+                      const dbus::utility::MapperGetSubTreeResponse& subtree) {
+            if (ec || subtree.empty())
+            {
+                return;
+            }
+            if (subtree[0].second.size() != 1)
+            {
+                // invalid mapper response, should never happen
+                BMCWEB_LOG_ERROR << "GetPIDValues: Mapper Error";
+                pending->failed = true;
+                return;
+            }
+            readThermalMode(pending, subtree[0].second[0].first,
+                            subtree[0].first);
+        });
+    }
+
+    // One GetManagedObjects per service holding configurations, at the
+    // ObjectManager the mapper lists for it
+    static void readConfigurations(
+        const std::shared_ptr<Fetch>& pending,
+        const dbus::utility::MapperGetSubTreeResponse& subtree)
+    {
+        // create map of <connection, path to objMgr>>
+        boost::container::flat_map<
+            std::string, std::string, std::less<>,
+            std::vector<std::pair<std::string, std::string>>>
+            objectMgrPaths;
+        boost::container::flat_set<std::string, std::less<>,
+                                   std::vector<std::string>>
+            calledConnections;
+        for (const auto& pathGroup : subtree)
+        {
+            for (const auto& connectionGroup : pathGroup.second)
+            {
+                auto findConnection =
+                    calledConnections.find(connectionGroup.first);
+                if (findConnection != calledConnections.end())
+                {
+                    break;
+                }
+                for (const std::string& interface : connectionGroup.second)
+                {
+                    if (interface == objectManagerIface)
+                    {
+                        objectMgrPaths[connectionGroup.first] = pathGroup.first;
+                    }
+                    // this list is alphabetical, so we
+                    // should have found the objMgr by now
+                    if (interface == pidConfigurationIface ||
+                        interface == pidZoneConfigurationIface ||
+                        interface == stepwiseConfigurationIface)
+                    {
+                        auto findObjMgr =
+                            objectMgrPaths.find(connectionGroup.first);
+                        if (findObjMgr == objectMgrPaths.end())
+                        {
+                            BMCWEB_LOG_DEBUG << connectionGroup.first
+                                             << "Has no Object Manager";
+                            continue;
+                        }
+
+                        calledConnections.insert(connectionGroup.first);
+
+                        crow::connections::systemBus->async_method_call(
+                            [pending](const boost::system::error_code& ec,
+                                      dbus::utility::ManagedObjectType& objs) {
+                            if (ec)
+                            {
+                                BMCWEB_LOG_ERROR << ec;
+                                pending->failed = true;
+                                return;
+                            }
+                            pending->objects.insert(
+                                pending->objects.end(),
+                                std::make_move_iterator(objs.begin()),
+                                std::make_move_iterator(objs.end()));
+                        },
+                            findObjMgr->first, findObjMgr->second,
+                            objectManagerIface, "GetManagedObjects");
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    static void readThermalMode(const std::shared_ptr<Fetch>& pending,
+                                const std::string& owner,
+                                const std::string& path)
+    {
+        dbus::utility::getAllProperties(
+            owner, path, thermalModeIface,
+            [pending, path](const boost::system::error_code& ec,
+                            const dbus::utility::DBusPropertiesMap& resp) {
+            if (ec)
+            {
+                BMCWEB_LOG_ERROR << "GetPIDValues: Can't get thermalModeIface "
+                                 << path;
+                pending->failed = true;
+                return;
+            }
+
+            const std::string* current = nullptr;
+            const std::vector<std::string>* supported = nullptr;
+
+            const bool success = sdbusplus::unpackPropertiesNoThrow(
+                dbus_utils::UnpackErrorPrinter(), resp, "Current", current,
+                "Supported", supported);
+
+            if (!success)
+            {
+                pending->failed = true;
+                return;
+            }
+
+            if (current == nullptr || supported == nullptr)
+            {
+                BMCWEB_LOG_ERROR
+                    << "GetPIDValues: thermal mode iface invalid " << path;
+                pending->failed = true;
+                return;
+            }
+            pending->currentProfile = *current;
+            pending->supportedProfiles = *supported;
+        });
+    }
+
+    void afterFetch(uint64_t fetchGeneration, bool failed,
+                    const dbus::utility::ManagedObjectType& objects,
+                    const std::string& currentProfile,
+                    const std::vector<std::string>& supportedProfiles)
+    {
+        std::vector<Callback> waiting = std::move(callbacks);
+        callbacks.clear();
+
+        std::shared_ptr<nlohmann::json> fan;
+        if (!failed)
+        {
+            fan = std::make_shared<nlohmann::json>();
+            if (!populatePid(objects, currentProfile, supportedProfiles, *fan))
+            {
+                fan.reset();
+            }
+        }
+        if (fan && enabled() && fetchGeneration == generation)
+        {
+            rendered = fan;
+        }
+        for (Callback& callback : waiting)
+        {
+            callback(fan);
+        }
+    }
+
+    static bool isWatched(std::string_view interface)
+    {
+        return std::find(watchedInterfaces.begin(), watchedInterfaces.end(),
+                         interface) != watchedInterfaces.end();
+    }
+
+    void onInterfacesAdded(sdbusplus::message_t& msg)
+    {
+        sdbusplus::message::object_path path;
+        dbus::utility::DBusInteracesMap interfaces;
+        try
+        {
+            msg.read(path, interfaces);
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            BMCWEB_LOG_ERROR << "Failed to read added interfaces: "
+                             << e.what();
+            clear();
+            return;
+        }
+        for (const auto& [interface, properties] : interfaces)
+        {
+            if (isWatched(interface))
+            {
+                clear();
+                return;
+            }
+        }
+    }
+
+    void onInterfacesRemoved(sdbusplus::message_t& msg)
+    {
+        sdbusplus::message::object_path path;
+        std::vector<std::string> interfaces;
+        try
+        {
+            msg.read(path, interfaces);
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            BMCWEB_LOG_ERROR << "Failed to read removed interfaces: "
+                             << e.what();
+            clear();
+            return;
+        }
+        for (const std::string& interface : interfaces)
+        {
+            if (isWatched(interface))
+            {
+                clear();
+                return;
+            }
+        }
+    }
+
+    // A service going away takes its configurations with it without
+    // signalling them one by one; unique names are only clients
+    void onNameOwnerChanged(sdbusplus::message_t& msg)
+    {
+        std::string name;
+        try
+        {
+            msg.read(name);
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            BMCWEB_LOG_ERROR << "Failed to read owner change: " << e.what();
+            clear();
+            return;
+        }
+        if (!name.starts_with(':'))
+        {
+            clear();
+        }
+    }
+
+    std::shared_ptr<const nlohmann::json> rendered;
+    std::vector<Callback> callbacks;
+    uint64_t generation = 0;
+    std::vector<std::unique_ptr<sdbusplus::bus::match_t>> matches;
+};
+
+} // namespace pid_util
+} // namespace redfish
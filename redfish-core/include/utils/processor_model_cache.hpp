@@ -0,0 +1,242 @@
+#pragma once
+
+#include "dbus_singleton.hpp"
+#include "dbus_utility.hpp"
+#include "logging.hpp"
+
+#include <boost/asio/post.hpp>
+#include <boost/container/flat_map.hpp>
+#include <sdbusplus/asio/connection.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace redfish
+{
+namespace processor_utils
+{
+
+/**
+ * @brief The CPUs an inventory service exposes, together with every object
+ * beneath them: cores, threads and operating configs, with all of their
+ * interfaces and properties.
+ */
+struct ProcessorModel
+{
+    explicit ProcessorModel(const dbus::utility::ManagedObjectType& inventory)
+    {
+        std::vector<std::string> cpuPaths;
+        for (const auto& [path, interfaces] : inventory)
+        {
+            for (const auto& [interface, properties] : interfaces)
+            {
+                if (interface == "xyz.openbmc_project.Inventory.Item.Cpu")
+                {
+                    cpuPaths.emplace_back(path.str);
+                    break;
+                }
+            }
+        }
+        for (const auto& [path, interfaces] : inventory)
+        {
+            for (const std::string& cpuPath : cpuPaths)
+            {
+                if (path.str == cpuPath ||
+                    (path.str.starts_with(cpuPath) &&
+                     path.str[cpuPath.size()] == '/'))
+                {
+                    objects.emplace(path.str, interfaces);
+                    break;
+                }
+            }
+        }
+    }
+
+    // The interfaces of the object at path, or nullptr if it isn't a CPU or
+    // beneath one
+    const dbus::utility::DBusInteracesMap* find(const std::string& path) const
+    {
+        auto it = objects.find(path);
+        if (it == objects.end())
+        {
+            return nullptr;
+        }
+        return &it->second;
+    }
+
+    // The properties of interface on the object at path, or nullptr if
+    // either doesn't exist
+    const dbus::utility::DBusPropertiesMap*
+        find(const std::string& path, std::string_view interface) const
+    {
+        const dbus::utility::DBusInteracesMap* interfaces = find(path);
+        if (interfaces == nullptr)
+        {
+            return nullptr;
+        }
+        for (const auto& [name, properties] : *interfaces)
+        {
+            if (name == interface)
+            {
+                return &properties;
+            }
+        }
+        return nullptr;
+    }
+
+    // Sorted by path, so the objects beneath a CPU or core are contiguous
+    boost::container::flat_map<std::string, dbus::utility::DBusInteracesMap>
+        objects;
+};
+
+/**
+ * @brief The last ProcessorModel read from each inventory service.
+ *
+ * A service's model is read with one GetManagedObjects on first use, then
+ * handed to every Processor, SubProcessor and OperatingConfig request until
+ * a signal is sent from within the inventory tree, or a well known name
+ * changes owner; then every model is dropped and read again on next use.
+ * Rendering all the cores of a socket therefore costs a single read rather
+ * than one of the whole inventory per core.  Concurrent reads of a service
+ * share one call, and a read that was in flight when the inventory changed
+ * is answered but not kept.
+ */
+class ProcessorModelCache
+{
+  public:
+    using Callback =
+        std::function<void(const boost::system::error_code&,
+                           const std::shared_ptr<const ProcessorModel>&)>;
+
+    static ProcessorModelCache& getInstance()
+    {
+        static ProcessorModelCache cache;
+        return cache;
+    }
+
+    ProcessorModelCache(const ProcessorModelCache&) = delete;
+    ProcessorModelCache(ProcessorModelCache&&) = delete;
+    ProcessorModelCache& operator=(const ProcessorModelCache&) = delete;
+    ProcessorModelCache& operator=(ProcessorModelCache&&) = delete;
+    ~ProcessorModelCache() = default;
+
+    void registerMatches(sdbusplus::asio::connection& conn)
+    {
+        namespace rules = sdbusplus::bus::match::rules;
+
+        matches.clear();
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn,
+            rules::type::signal() +
+                rules::path_namespace("/xyz/openbmc_project/inventory"),
+            [this](sdbusplus::message_t& /*msg*/) { clear(); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::nameOwnerChanged(), [this](sdbusplus::message_t& msg) {
+            std::string name;
+            msg.read(name);
+            if (!name.starts_with(':'))
+            {
+                clear();
+            }
+        }));
+        clear();
+    }
+
+    bool enabled() const
+    {
+        return !matches.empty();
+    }
+
+    /**
+     * @brief Calls callback with the processor model of service, reading it
+     * if it isn't cached.  The callback is never called inline.
+     */
+    void get(const std::string& service, Callback&& callback)
+    {
+        Entry& entry = entries[service];
+        if (entry.model)
+        {
+            std::shared_ptr<const ProcessorModel> current = entry.model;
+            boost::asio::post(crow::connections::systemBus->get_io_context(),
+                              [current, callback{std::move(callback)}]() {
+                callback(boost::system::error_code(), current);
+            });
+            return;
+        }
+
+        entry.callbacks.emplace_back(std::move(callback));
+        if (entry.callbacks.size() > 1)
+        {
+            return;
+        }
+        crow::dbus_trace::SharedCallScope sharedCalls;
+        crow::connections::systemBus->async_method_call(
+            [this, service, fetchGeneration{generation}](
+                const boost::system::error_code& ec,
+                const dbus::utility::ManagedObjectType& inventory) {
+            complete(service, fetchGeneration, ec, inventory);
+        },
+            service, "/xyz/openbmc_project/inventory",
+            "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
+    }
+
+    void clear()
+    {
+        for (auto& [service, entry] : entries)
+        {
+            entry.model.reset();
+        }
+        generation++;
+    }
+
+  private:
+    struct Entry
+    {
+        std::shared_ptr<const ProcessorModel> model;
+        std::vector<Callback> callbacks;
+    };
+
+    ProcessorModelCache() = default;
+
+    void complete(const std::string& service, uint64_t fetchGeneration,
+                  const boost::system::error_code& ec,
+                  const dbus::utility::ManagedObjectType& inventory)
+    {
+        Entry& entry = entries[service];
+        std::vector<Callback> waiting = std::move(entry.callbacks);
+        entry.callbacks.clear();
+
+        std::shared_ptr<const ProcessorModel> read;
+        if (ec)
+        {
+            BMCWEB_LOG_DEBUG << "GetManagedObjects of " << service
+                             << " failed: " << ec;
+        }
+        else
+        {
+            read = std::make_shared<const ProcessorModel>(inventory);
+            if (enabled() && fetchGeneration == generation)
+            {
+                entry.model = read;
+            }
+        }
+        for (Callback& callback : waiting)
+        {
+            callback(ec, read);
+        }
+    }
+
+    boost::container::flat_map<std::string, Entry> entries;
+    uint64_t generation = 0;
+    std::vector<std::unique_ptr<sdbusplus::bus::match_t>> matches;
+};
+
+} // namespace processor_utils
+} // namespace redfish
@@ -0,0 +1,550 @@
+#pragma once
+
+#include "utils/time_utils.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace redfish
+{
+namespace query_param
+{
+
+enum class FilterOperator
+{
+    Eq,
+    Ne,
+    Gt,
+    Ge,
+    Lt,
+    Le,
+};
+
+/**
+ * @brief A node of a parsed $filter: "and", "or" or "not" of its operands, or
+ * the comparison of a property with a literal.
+ */
+struct FilterNode
+{
+    enum class Kind
+    {
+        And,
+        Or,
+        Not,
+        Compare,
+    };
+
+    Kind kind = Kind::Compare;
+    std::vector<FilterNode> operands;
+
+    // Compare only
+    std::string property;
+    FilterOperator op = FilterOperator::Eq;
+    nlohmann::json value;
+};
+
+namespace details
+{
+
+// The value at property, a path of names split by '/', or nullptr if member
+// doesn't have it
+inline const nlohmann::json* findFilterProperty(const nlohmann::json& member,
+                                                std::string_view property)
+{
+    const nlohmann::json* current = &member;
+    while (true)
+    {
+        size_t slash = property.find('/');
+        const nlohmann::json::object_t* object =
+            current->get_ptr<const nlohmann::json::object_t*>();
+        if (object == nullptr)
+        {
+            return nullptr;
+        }
+        auto it = object->find(std::string(property.substr(0, slash)));
+        if (it == object->end())
+        {
+            return nullptr;
+        }
+        current = &it->second;
+        if (slash == std::string_view::npos)
+        {
+            return current;
+        }
+        property.remove_prefix(slash + 1);
+    }
+}
+
+template <typename T>
+bool compareFilterValues(const T& left, FilterOperator op, const T& right)
+{
+    switch (op)
+    {
+        case FilterOperator::Eq:
+            return left == right;
+        case FilterOperator::Ne:
+            return left != right;
+        case FilterOperator::Gt:
+            return left > right;
+        case FilterOperator::Ge:
+            return left >= right;
+        case FilterOperator::Lt:
+            return left < right;
+        case FilterOperator::Le:
+            return left <= right;
+    }
+    return false;
+}
+
+inline bool compareFilterProperty(const nlohmann::json* actual,
+                                  FilterOperator op,
+                                  const nlohmann::json& literal)
+{
+    // A property that isn't there is null
+    if (actual == nullptr || actual->is_null() || literal.is_null())
+    {
+        bool bothNull = (actual == nullptr || actual->is_null()) &&
+                        literal.is_null();
+        if (op == FilterOperator::Eq)
+        {
+            return bothNull;
+        }
+        if (op == FilterOperator::Ne)
+        {
+            return !bothNull;
+        }
+        return false;
+    }
+    if (actual->is_number() && literal.is_number())
+    {
+        return compareFilterValues(actual->get<double>(), op,
+                                   literal.get<double>());
+    }
+    if (actual->is_boolean() && literal.is_boolean())
+    {
+        return compareFilterValues(actual->get<bool>(), op,
+                                   literal.get<bool>());
+    }
+    const std::string* actualString = actual->get_ptr<const std::string*>();
+    const std::string* literalString = literal.get_ptr<const std::string*>();
+    if (actualString != nullptr && literalString != nullptr)
+    {
+        // DateTimes are compared as the times they are, whatever their
+        // offsets
+        std::optional<int64_t> actualTime =
+            time_utils::fromDateTimeString(*actualString);
+        std::optional<int64_t> literalTime =
+            time_utils::fromDateTimeString(*literalString);
+        if (actualTime && literalTime)
+        {
+            return compareFilterValues(*actualTime, op, *literalTime);
+        }
+        return compareFilterValues(*actualString, op, *literalString);
+    }
+    // Values of different types are never equal, nor ordered
+    return op == FilterOperator::Ne;
+}
+
+/**
+ * @brief Parses the subset of the OData $filter syntax Redfish asks for:
+ * comparisons of properties with literals by eq, ne, gt, ge, lt and le,
+ * joined by and, or and not, with parentheses for grouping.
+ */
+class FilterParser
+{
+  public:
+    explicit FilterParser(std::string_view filterIn) : filter(filterIn) {}
+
+    std::optional<FilterNode> parse()
+    {
+        std::optional<FilterNode> root = parseOr(0);
+        skipSpaces();
+        if (!root || !filter.empty())
+        {
+            return std::nullopt;
+        }
+        return root;
+    }
+
+  private:
+    // Limits on what a request can make the service build and evaluate
+    static constexpr size_t maxDepth = 8;
+    static constexpr size_t maxComparisons = 32;
+
+    // or := and ("or" and)*
+    std::optional<FilterNode> parseOr(size_t depth)
+    {
+        return parseJoined(depth, "or", FilterNode::Kind::Or,
+                           &FilterParser::parseAnd);
+    }
+
+    // and := unary ("and" unary)*
+    std::optional<FilterNode> parseAnd(size_t depth)
+    {
+        return parseJoined(depth, "and", FilterNode::Kind::And,
+                           &FilterParser::parseUnary);
+    }
+
+    std::optional<FilterNode> parseJoined(
+        size_t depth, std::string_view keyword, FilterNode::Kind kind,
+        std::optional<FilterNode> (FilterParser::*parseOperand)(size_t))
+    {
+        std::optional<FilterNode> first = (this->*parseOperand)(depth);
+        if (!first || !peekWord(keyword))
+        {
+            return first;
+        }
+        FilterNode joined;
+        joined.kind = kind;
+        joined.operands.emplace_back(std::move(*first));
+        while (nextWord(keyword))
+        {
+            std::optional<FilterNode> operand = (this->*parseOperand)(depth);
+            if (!operand)
+            {
+                return std::nullopt;
+            }
+            joined.operands.emplace_back(std::move(*operand));
+        }
+        return joined;
+    }
+
+    // unary := "not" unary | "(" or ")" | comparison
+    std::optional<FilterNode> parseUnary(size_t depth)
+    {
+        if (depth >= maxDepth)
+        {
+            return std::nullopt;
+        }
+        if (nextWord("not"))
+        {
+            std::optional<FilterNode> operand = parseUnary(depth + 1);
+            if (!operand)
+            {
+                return std::nullopt;
+            }
+            FilterNode negated;
+            negated.kind = FilterNode::Kind::Not;
+            negated.operands.emplace_back(std::move(*operand));
+            return negated;
+        }
+        skipSpaces();
+        if (filter.starts_with('('))
+        {
+            filter.remove_prefix(1);
+            std::optional<FilterNode> inner = parseOr(depth + 1);
+            skipSpaces();
+            if (!inner || !filter.starts_with(')'))
+            {
+                return std::nullopt;
+            }
+            filter.remove_prefix(1);
+            return inner;
+        }
+        return parseComparison();
+    }
+
+    // comparison := property operator literal
+    std::optional<FilterNode> parseComparison()
+    {
+        if (++comparisons > maxComparisons)
+        {
+            return std::nullopt;
+        }
+        FilterNode compare;
+        compare.property = propertyPath();
+        if (compare.property.empty())
+        {
+            return std::nullopt;
+        }
+        std::string_view op = word();
+        if (op == "eq")
+        {
+            compare.op = FilterOperator::Eq;
+        }
+        else if (op == "ne")
+        {
+            compare.op = FilterOperator::Ne;
+        }
+        else if (op == "gt")
+        {
+            compare.op = FilterOperator::Gt;
+        }
+        else if (op == "ge")
+        {
+            compare.op = FilterOperator::Ge;
+        }
+        else if (op == "lt")
+        {
+            compare.op = FilterOperator::Lt;
+        }
+        else if (op == "le")
+        {
+            compare.op = FilterOperator::Le;
+        }
+        else
+        {
+            return std::nullopt;
+        }
+        std::optional<nlohmann::json> value = literal();
+        if (!value)
+        {
+            return std::nullopt;
+        }
+        compare.value = std::move(*value);
+        return compare;
+    }
+
+    static bool isNameChar(char c)
+    {
+        return std::isalnum(static_cast<unsigned char>(c)) != 0 || c == '_' ||
+               c == '@' || c == '.' || c == '#';
+    }
+
+    void skipSpaces()
+    {
+        while (!filter.empty() && filter.front() == ' ')
+        {
+            filter.remove_prefix(1);
+        }
+    }
+
+    std::string_view word()
+    {
+        skipSpaces();
+        size_t length = 0;
+        while (length < filter.size() &&
+               std::isalpha(static_cast<unsigned char>(filter[length])) != 0)
+        {
+            length++;
+        }
+        std::string_view token = filter.substr(0, length);
+        filter.remove_prefix(length);
+        return token;
+    }
+
+    bool peekWord(std::string_view keyword)
+    {
+        skipSpaces();
+        return filter.starts_with(keyword) &&
+               (filter.size() == keyword.size() ||
+                !isNameChar(filter[keyword.size()]));
+    }
+
+    bool nextWord(std::string_view keyword)
+    {
+        if (!peekWord(keyword))
+        {
+            return false;
+        }
+        filter.remove_prefix(keyword.size());
+        return true;
+    }
+
+    // Names joined by '/', each starting with a letter
+    std::string propertyPath()
+    {
+        skipSpaces();
+        size_t length = 0;
+        while (length < filter.size() &&
+               std::isalpha(static_cast<unsigned char>(filter[length])) != 0)
+        {
+            while (length < filter.size() && isNameChar(filter[length]))
+            {
+                length++;
+            }
+            if (length + 1 >= filter.size() || filter[length] != '/')
+            {
+                break;
+            }
+            length++;
+        }
+        if (length == 0 || filter[length - 1] == '/')
+        {
+            return "";
+        }
+        std::string path(filter.substr(0, length));
+        filter.remove_prefix(length);
+        return path;
+    }
+
+    // A string in quotes, in which '' stands for a quote; a number; true,
+    // false or null; or a bare DateTime, which is kept as its string
+    std::optional<nlohmann::json> literal()
+    {
+        skipSpaces();
+        if (filter.starts_with('\''))
+        {
+            filter.remove_prefix(1);
+            std::string value;
+            while (!filter.empty())
+            {
+                char c = filter.front();
+                filter.remove_prefix(1);
+                if (c != '\'')
+                {
+                    value += c;
+                    continue;
+                }
+                if (!filter.starts_with('\''))
+                {
+                    return value;
+                }
+                value += '\'';
+                filter.remove_prefix(1);
+            }
+            return std::nullopt;
+        }
+
+        size_t length = 0;
+        while (length < filter.size() &&
+               (isNameChar(filter[length]) || filter[length] == '-' ||
+                filter[length] == '+' || filter[length] == ':'))
+        {
+            length++;
+        }
+        std::string_view token = filter.substr(0, length);
+        filter.remove_prefix(length);
+        if (token == "true")
+        {
+            return true;
+        }
+        if (token == "false")
+        {
+            return false;
+        }
+        if (token == "null")
+        {
+            return nullptr;
+        }
+        const char* end = token.data() + token.size();
+        int64_t integer = 0;
+        auto intResult = std::from_chars(token.data(), end, integer);
+        if (intResult.ec == std::errc() && intResult.ptr == end)
+        {
+            return integer;
+        }
+        double number = 0.0;
+        auto doubleResult = std::from_chars(token.data(), end, number);
+        if (doubleResult.ec == std::errc() && doubleResult.ptr == end)
+        {
+            return number;
+        }
+        if (time_utils::fromDateTimeString(token))
+        {
+            return std::string(token);
+        }
+        return std::nullopt;
+    }
+
+    std::string_view filter;
+    size_t comparisons = 0;
+};
+
+} // namespace details
+
+/**
+ * @brief A parsed $filter, and the text it was parsed from for the links
+ * that carry it on.
+ */
+class Filter
+{
+  public:
+    Filter(std::string textIn, FilterNode rootIn) :
+        text(std::move(textIn)), root(std::move(rootIn))
+    {}
+
+    const std::string& source() const
+    {
+        return text;
+    }
+
+    /**
+     * @brief Whether member, a resource as it's rendered, matches.  A source
+     * that can render just some properties of its members cheaply, such as
+     * an index, can test those alone first when usesOnly() says they're
+     * enough.
+     */
+    bool matches(const nlohmann::json& member) const
+    {
+        return evaluate(root, member);
+    }
+
+    // Whether every property compared is one of properties
+    bool usesOnly(std::initializer_list<std::string_view> properties) const
+    {
+        return usesOnly(root, properties);
+    }
+
+  private:
+    static bool evaluate(const FilterNode& node, const nlohmann::json& member)
+    {
+        switch (node.kind)
+        {
+            case FilterNode::Kind::And:
+                return std::ranges::all_of(node.operands,
+                                           [&member](const FilterNode& sub) {
+                    return evaluate(sub, member);
+                });
+            case FilterNode::Kind::Or:
+                return std::ranges::any_of(node.operands,
+                                           [&member](const FilterNode& sub) {
+                    return evaluate(sub, member);
+                });
+            case FilterNode::Kind::Not:
+                return !evaluate(node.operands.front(), member);
+            case FilterNode::Kind::Compare:
+                return details::compareFilterProperty(
+                    details::findFilterProperty(member, node.property),
+                    node.op, node.value);
+        }
+        return false;
+    }
+
+    static bool usesOnly(const FilterNode& node,
+                         std::initializer_list<std::string_view> properties)
+    {
+        if (node.kind == FilterNode::Kind::Compare)
+        {
+            return std::ranges::find(properties, node.property) !=
+                   properties.end();
+        }
+        return std::ranges::all_of(node.operands,
+                                   [properties](const FilterNode& sub) {
+            return usesOnly(sub, properties);
+        });
+    }
+
+    std::string text;
+    FilterNode root;
+};
+
+/**
+ * @brief Parses a $filter, such as "Severity eq 'Critical' and
+ * Created gt 2023-05-01T00:00:00Z".  Returns nullopt if filter isn't one
+ * that's supported.
+ */
+inline std::optional<Filter> parseFilter(std::string_view filter)
+{
+    std::optional<FilterNode> root = details::FilterParser(filter).parse();
+    if (!root)
+    {
+        return std::nullopt;
+    }
+    return Filter(std::string(filter), std::move(*root));
+}
+
+} // namespace query_param
+} // namespace redfish
@@ -7,6 +7,7 @@
 #include "http_request.hpp"
 #include "http_response.hpp"
 #include "logging.hpp"
+#include "utils/query_filter.hpp"
 
 #include <sys/types.h>
 
@@ -16,6 +17,7 @@
 #include <boost/beast/http/status.hpp>
 #include <boost/beast/http/verb.hpp>
 #include <boost/url/params_view.hpp>
+#include <boost/url/url.hpp>
 #include <nlohmann/json.hpp>
 
 #include <algorithm>
@@ -25,6 +27,7 @@
 #include <compare>
 #include <cstdint>
 #include <functional>
+#include <initializer_list>
 #include <iterator>
 #include <limits>
 #include <map>
@@ -33,6 +36,7 @@
 #include <string>
 #include <string_view>
 #include <system_error>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -63,7 +67,7 @@ class SelectTrieNode
   public:
     SelectTrieNode() = default;
 
-    const SelectTrieNode* find(const std::string& jsonKey) const
+    const SelectTrieNode* find(std::string_view jsonKey) const
     {
         auto it = children.find(jsonKey);
         if (it == children.end())
@@ -160,6 +164,21 @@ struct SelectTrie
         return true;
     }
 
+    // Returns false only when $select was given and names none of
+    // |properties| at the top level of the resource.  Handlers use this to
+    // skip fetching data that would be removed from the response anyway.
+    bool isAnySelected(std::initializer_list<std::string_view> properties) const
+    {
+        if (root.empty())
+        {
+            return true;
+        }
+        return std::any_of(properties.begin(), properties.end(),
+                           [this](std::string_view property) {
+            return root.find(property) != nullptr;
+        });
+    }
+
     SelectTrieNode root;
 };
 
@@ -181,6 +200,12 @@ struct Query
 
     // Select
     SelectTrie selectTrie = {};
+
+    // Filter
+    std::optional<Filter> filter = std::nullopt;
+
+    // Deltatoken, the token of an earlier @odata.deltaLink
+    std::optional<std::string> deltaToken = std::nullopt;
 };
 
 // The struct defines how resource handlers in redfish-core/lib/ can handle
@@ -193,6 +218,14 @@ struct QueryCapabilities
     bool canDelegateSkip = false;
     uint8_t canDelegateExpandLevel = 0;
     bool canDelegateSelect = false;
+    // The handler reads $select to avoid fetching unselected properties, but
+    // leaves the filtering of the response to the default handler.
+    bool canPruneBySelect = false;
+    // The handler only builds the members that match $filter, and applies
+    // $top and $skip to those itself
+    bool canDelegateFilter = false;
+    // The collection keeps a ChangeJournal and can answer $deltatoken
+    bool canDelegateDeltaToken = false;
 };
 
 // Delegates query parameters according to the given |queryCapabilities|
@@ -203,6 +236,20 @@ struct QueryCapabilities
 inline Query delegate(const QueryCapabilities& queryCapabilities, Query& query)
 {
     Query delegated;
+    // delegate filter
+    if (query.filter && queryCapabilities.canDelegateFilter)
+    {
+        delegated.filter = std::move(query.filter);
+        query.filter = std::nullopt;
+    }
+    // The default handler filters the whole collection, then pages it, so a
+    // handler that pages on its own is asked for all of it
+    bool filterLeft = query.filter.has_value();
+    if (filterLeft && queryCapabilities.canDelegateTop)
+    {
+        delegated.top = std::numeric_limits<size_t>::max();
+    }
+
     // delegate only
     if (query.isOnly && queryCapabilities.canDelegateOnly)
     {
@@ -227,14 +274,14 @@ inline Query delegate(const QueryCapabilities& queryCapabilities, Query& query)
     }
 
     // delegate top
-    if (query.top && queryCapabilities.canDelegateTop)
+    if (query.top && queryCapabilities.canDelegateTop && !filterLeft)
     {
         delegated.top = query.top;
         query.top = std::nullopt;
     }
 
     // delegate skip
-    if (query.skip && queryCapabilities.canDelegateSkip)
+    if (query.skip && queryCapabilities.canDelegateSkip && !filterLeft)
     {
         delegated.skip = query.skip;
         query.skip = 0;
@@ -246,6 +293,18 @@ inline Query delegate(const QueryCapabilities& queryCapabilities, Query& query)
         delegated.selectTrie = std::move(query.selectTrie);
         query.selectTrie.root.clear();
     }
+    else if (!query.selectTrie.root.empty() &&
+             queryCapabilities.canPruneBySelect)
+    {
+        delegated.selectTrie = query.selectTrie;
+    }
+
+    // delegate deltatoken
+    if (query.deltaToken && queryCapabilities.canDelegateDeltaToken)
+    {
+        delegated.deltaToken = std::move(query.deltaToken);
+        query.deltaToken = std::nullopt;
+    }
     return delegated;
 }
 
@@ -451,6 +510,19 @@ inline std::optional<Query> parseParameters(boost::urls::params_view urlParams,
                 return std::nullopt;
             }
         }
+        else if (it.key == "$filter")
+        {
+            ret.filter = parseFilter(it.value);
+            if (!ret.filter)
+            {
+                messages::queryParameterValueFormatError(res, it.value, it.key);
+                return std::nullopt;
+            }
+        }
+        else if (it.key == "$deltatoken")
+        {
+            ret.deltaToken = it.value;
+        }
         else
         {
             // Intentionally ignore other errors Redfish spec, 7.3.1
@@ -474,11 +546,29 @@ inline std::optional<Query> parseParameters(boost::urls::params_view urlParams,
         return std::nullopt;
     }
 
+    // Members are filtered as the collection lists them, not as they'd be
+    // expanded
+    if (ret.filter && (ret.isOnly || ret.expandType != ExpandType::None))
+    {
+        messages::queryCombinationInvalid(res);
+        return std::nullopt;
+    }
+
+    // Changes are listed whole, in a response of their own
+    if (ret.deltaToken && (ret.isOnly || ret.top || ret.skip || ret.filter ||
+                           ret.expandType != ExpandType::None))
+    {
+        messages::queryCombinationInvalid(res);
+        return std::nullopt;
+    }
+
     return ret;
 }
 
-inline bool processOnly(crow::App& app, crow::Response& res,
-                        std::function<void(crow::Response&)>& completionHandler)
+inline bool
+    processOnly(crow::App& app, crow::Response& res,
+                crow::Response::CompletionHandler& completionHandler,
+                const std::shared_ptr<const crow::Cancellation>& cancellation)
 {
     BMCWEB_LOG_DEBUG << "Processing only query param";
     auto itMembers = res.jsonValue.find("Members");
@@ -525,6 +615,7 @@ inline bool processOnly(crow::App& app, crow::Response& res,
     }
 
     auto asyncResp = std::make_shared<bmcweb::AsyncResp>();
+    asyncResp->cancellation = cancellation;
     BMCWEB_LOG_DEBUG << "setting completion handler on " << &asyncResp->res;
     asyncResp->res.setCompleteRequestHandler(std::move(completionHandler));
     asyncResp->res.setIsAliveHelper(res.releaseIsAliveHelper());
@@ -776,6 +867,12 @@ inline void propogateError(crow::Response& finalResponse,
         propogateErrorCode(finalResponse.resultInt(), subResponse.resultInt()));
 }
 
+// The number of $expand sub-requests a single MultiAsyncResp keeps in flight.
+// Each level of expansion has its own window, so a request for
+// $levels=n has at most this many sub-requests outstanding per resource on
+// the path being expanded.
+constexpr size_t maxExpandRequestsInFlight = 8;
+
 class MultiAsyncResp : public std::enable_shared_from_this<MultiAsyncResp>
 {
   public:
@@ -783,31 +880,36 @@ class MultiAsyncResp : public std::enable_shared_from_this<MultiAsyncResp>
     // allows callers to attach sub-responses within the json tree that need
     // to be executed and filled into their appropriate locations.  This
     // class manages the final "merge" of the json resources.
+    //
+    // Sub-requests are issued at most maxExpandRequestsInFlight at a time, in
+    // tree order, and each unique URI is only requested once no matter how
+    // many places in the tree reference it.  Each result is moved into the
+    // final tree as soon as it completes.
     MultiAsyncResp(crow::App& appIn,
                    std::shared_ptr<bmcweb::AsyncResp> finalResIn) :
         app(appIn),
         finalRes(std::move(finalResIn))
     {}
 
-    void addAwaitingResponse(
-        const std::shared_ptr<bmcweb::AsyncResp>& res,
-        const nlohmann::json::json_pointer& finalExpandLocation)
+    void placeResult(const std::string& subQuery, crow::Response& res)
     {
-        res->res.setCompleteRequestHandler(std::bind_front(
-            placeResultStatic, shared_from_this(), finalExpandLocation));
-    }
-
-    void placeResult(const nlohmann::json::json_pointer& locationToPlace,
-                     crow::Response& res)
-    {
-        BMCWEB_LOG_DEBUG << "placeResult for " << locationToPlace;
+        BMCWEB_LOG_DEBUG << "placeResult for " << subQuery;
+        inFlight--;
         propogateError(finalRes->res, res);
-        if (!res.jsonValue.is_object() || res.jsonValue.empty())
+
+        auto locations = pendingLocations.extract(subQuery);
+        if (!locations.empty() && res.jsonValue.is_object() &&
+            !res.jsonValue.empty())
         {
-            return;
+            std::vector<nlohmann::json::json_pointer>& places =
+                locations.mapped();
+            for (size_t i = 0; i + 1 < places.size(); i++)
+            {
+                finalRes->res.jsonValue[places[i]] = res.jsonValue;
+            }
+            finalRes->res.jsonValue[places.back()] = std::move(res.jsonValue);
         }
-        nlohmann::json& finalObj = finalRes->res.jsonValue[locationToPlace];
-        finalObj = std::move(res.jsonValue);
+        startNext();
     }
 
     // Handles the very first level of Expand, and starts a chain of sub-queries
@@ -823,9 +925,45 @@ class MultiAsyncResp : public std::enable_shared_from_this<MultiAsyncResp>
             messages::internalError(finalRes->res);
             return;
         }
-        for (const ExpandNode& node : nodes)
+        for (ExpandNode& node : nodes)
         {
-            const std::string subQuery = node.uri + *queryStr;
+            std::string subQuery = node.uri + *queryStr;
+            auto [it, inserted] = pendingLocations.try_emplace(subQuery);
+            it->second.emplace_back(std::move(node.location));
+            if (inserted)
+            {
+                subQueries.emplace_back(std::move(subQuery));
+            }
+        }
+        BMCWEB_LOG_DEBUG << subQueries.size() << " unique subqueries";
+        startNext();
+    }
+
+  private:
+    void startNext()
+    {
+        // A sub-request that completes synchronously calls back into
+        // placeResult, and from there here; let the outer loop continue
+        // rather than recursing once per sibling.
+        if (dispatching)
+        {
+            return;
+        }
+        dispatching = true;
+        if (finalRes->cancelled())
+        {
+            // Nobody will read the expanded response; let the sub-requests
+            // in flight finish and issue no more
+            BMCWEB_LOG_DEBUG << "Client gone, dropping "
+                             << subQueries.size() - nextSubQuery
+                             << " expand sub-requests";
+            nextSubQuery = subQueries.size();
+        }
+        while (inFlight < maxExpandRequestsInFlight &&
+               nextSubQuery < subQueries.size())
+        {
+            const std::string& subQuery = subQueries[nextSubQuery];
+            nextSubQuery++;
             BMCWEB_LOG_DEBUG << "URL of subquery:  " << subQuery;
             std::error_code ec;
             crow::Request newReq({boost::beast::http::verb::get, subQuery, 11},
@@ -833,31 +971,89 @@ class MultiAsyncResp : public std::enable_shared_from_this<MultiAsyncResp>
             if (ec)
             {
                 messages::internalError(finalRes->res);
-                return;
+                nextSubQuery = subQueries.size();
+                break;
             }
 
             auto asyncResp = std::make_shared<bmcweb::AsyncResp>();
+            asyncResp->cancellation = finalRes->cancellation;
             BMCWEB_LOG_DEBUG << "setting completion handler on "
                              << &asyncResp->res;
-
-            addAwaitingResponse(asyncResp, node.location);
+            asyncResp->res.setCompleteRequestHandler(
+                std::bind_front(placeResultStatic, shared_from_this(),
+                                subQuery));
+            inFlight++;
             app.handle(newReq, asyncResp);
         }
+        dispatching = false;
     }
 
-  private:
-    static void
-        placeResultStatic(const std::shared_ptr<MultiAsyncResp>& multi,
-                          const nlohmann::json::json_pointer& locationToPlace,
-                          crow::Response& res)
+    static void placeResultStatic(const std::shared_ptr<MultiAsyncResp>& multi,
+                                  const std::string& subQuery,
+                                  crow::Response& res)
     {
-        multi->placeResult(locationToPlace, res);
+        multi->placeResult(subQuery, res);
     }
 
     crow::App& app;
     std::shared_ptr<bmcweb::AsyncResp> finalRes;
+
+    // Unique sub-request URIs in the order they were found, and every place
+    // in the final tree each one is referenced from.
+    std::vector<std::string> subQueries;
+    std::unordered_map<std::string, std::vector<nlohmann::json::json_pointer>>
+        pendingLocations;
+    size_t nextSubQuery = 0;
+    size_t inFlight = 0;
+    bool dispatching = false;
 };
 
+// Leaves the Members of a collection that match filter.  The count is of the
+// matches, and any nextLink is dropped, as it wouldn't carry the filter.
+inline void processFilter(const Filter& filter, crow::Response& res)
+{
+    BMCWEB_LOG_DEBUG << "Handling filter";
+    nlohmann::json::object_t* obj =
+        res.jsonValue.get_ptr<nlohmann::json::object_t*>();
+    if (obj == nullptr)
+    {
+        messages::internalError(res);
+        return;
+    }
+    nlohmann::json::object_t::iterator members = obj->find("Members");
+    if (members == obj->end())
+    {
+        messages::queryNotSupportedOnResource(res);
+        return;
+    }
+    nlohmann::json::array_t* arr =
+        members->second.get_ptr<nlohmann::json::array_t*>();
+    if (arr == nullptr)
+    {
+        messages::internalError(res);
+        return;
+    }
+    std::erase_if(*arr, [&filter](const nlohmann::json& member) {
+        return !filter.matches(member);
+    });
+    (*obj)["Members@odata.count"] = arr->size();
+    obj->erase("Members@odata.nextLink");
+}
+
+// The nextLink of a collection a handler filters and pages itself, which
+// keeps the filter so the next page lists the same matches
+inline std::string filteredNextLink(std::string_view collectionUri, size_t skip,
+                                    const std::optional<Filter>& filter)
+{
+    boost::urls::url next(collectionUri);
+    next.params().append({"$skip", std::to_string(skip)});
+    if (filter)
+    {
+        next.params().append({"$filter", filter->source()});
+    }
+    return std::string(next.buffer());
+}
+
 inline void processTopAndSkip(const Query& query, crow::Response& res)
 {
     if (!query.skip && !query.top)
@@ -978,8 +1174,10 @@ inline void processSelect(crow::Response& intermediateResponse,
 
 inline void
     processAllParams(crow::App& app, const Query& query,
-                     std::function<void(crow::Response&)>& completionHandler,
-                     crow::Response& intermediateResponse)
+                     crow::Response::CompletionHandler& completionHandler,
+                     crow::Response& intermediateResponse,
+                     const std::shared_ptr<const crow::Cancellation>&
+                         cancellation = nullptr)
 {
     if (!completionHandler)
     {
@@ -998,10 +1196,22 @@ inline void
     }
     if (query.isOnly)
     {
-        processOnly(app, intermediateResponse, completionHandler);
+        processOnly(app, intermediateResponse, completionHandler,
+                    cancellation);
         return;
     }
 
+    // Per the OData specification, $filter is applied before $skip and $top
+    if (query.filter)
+    {
+        processFilter(*query.filter, intermediateResponse);
+        if (intermediateResponse.resultInt() >= 400)
+        {
+            completionHandler(intermediateResponse);
+            return;
+        }
+    }
+
     if (query.top || query.skip)
     {
         processTopAndSkip(query, intermediateResponse);
@@ -1012,6 +1222,7 @@ inline void
         BMCWEB_LOG_DEBUG << "Executing expand query";
         auto asyncResp = std::make_shared<bmcweb::AsyncResp>(
             std::move(intermediateResponse));
+        asyncResp->cancellation = cancellation;
 
         asyncResp->res.setCompleteRequestHandler(std::move(completionHandler));
         auto multi = std::make_shared<MultiAsyncResp>(app, asyncResp);
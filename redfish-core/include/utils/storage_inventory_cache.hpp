@@ -0,0 +1,399 @@
+#pragma once
+
+#include "dbus_singleton.hpp"
+#include "dbus_utility.hpp"
+#include "logging.hpp"
+
+#include <boost/asio/post.hpp>
+#include <boost/container/flat_map.hpp>
+#include <sdbusplus/asio/connection.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace redfish
+{
+namespace storage_utils
+{
+
+constexpr std::array<std::string_view, 1> driveInterfaces = {
+    "xyz.openbmc_project.Inventory.Item.Drive"};
+
+constexpr std::array<std::string_view, 1> controllerInterfaces = {
+    "xyz.openbmc_project.Inventory.Item.StorageController"};
+
+constexpr std::array<std::string_view, 2> chassisInterfaces = {
+    "xyz.openbmc_project.Inventory.Item.Board",
+    "xyz.openbmc_project.Inventory.Item.Chassis"};
+
+// The interfaces Drive and StorageController resources are rendered from
+constexpr std::array<std::string_view, 4> renderedInterfaces = {
+    "xyz.openbmc_project.Inventory.Decorator.Asset",
+    "xyz.openbmc_project.Inventory.Item",
+    "xyz.openbmc_project.State.Drive",
+    "xyz.openbmc_project.Inventory.Item.Drive"};
+
+/**
+ * @brief A drive or storage controller, as the mapper lists it, with the
+ * properties of the rendered interfaces its first service implements.
+ */
+struct StorageObject
+{
+    std::string id;
+    std::string path;
+    dbus::utility::MapperServiceMap services;
+    dbus::utility::DBusInteracesMap interfaces;
+
+    // The properties read of interface, or nullptr if it wasn't read
+    const dbus::utility::DBusPropertiesMap*
+        find(std::string_view interface) const
+    {
+        for (const auto& [name, properties] : interfaces)
+        {
+            if (name == interface)
+            {
+                return &properties;
+            }
+        }
+        return nullptr;
+    }
+
+    // Inventory.Item's PrettyName, or empty if there is none
+    std::string prettyName() const
+    {
+        const dbus::utility::DBusPropertiesMap* item =
+            find("xyz.openbmc_project.Inventory.Item");
+        if (item == nullptr)
+        {
+            return "";
+        }
+        for (const auto& [name, value] : *item)
+        {
+            const std::string* prettyName = std::get_if<std::string>(&value);
+            if (name == "PrettyName" && prettyName != nullptr)
+            {
+                return *prettyName;
+            }
+        }
+        return "";
+    }
+};
+
+/**
+ * @brief A chassis or board and the endpoints of its drive association, or
+ * nullopt if they couldn't be read.
+ */
+struct ChassisDrives
+{
+    std::string id;
+    std::string path;
+    std::optional<std::vector<std::string>> drives;
+};
+
+/**
+ * @brief Everything the Storage, Drive and Chassis Drive routes render.
+ * Drives and chassis are sorted by path, as the mapper returns them; a
+ * failed mapper query leaves its error here, while storage controllers
+ * are optional and are simply left out if they can't be listed.
+ */
+struct StorageInventory
+{
+    boost::system::error_code drivesError;
+    std::vector<StorageObject> drives;
+    std::vector<StorageObject> controllers;
+    boost::system::error_code chassisError;
+    std::vector<ChassisDrives> chassis;
+
+    // The first drive with this ID, or nullptr if there is none
+    const StorageObject* findDrive(const std::string& id) const
+    {
+        auto it = driveIndex.find(id);
+        if (it == driveIndex.end())
+        {
+            return nullptr;
+        }
+        return &drives[it->second];
+    }
+
+    void indexDrives()
+    {
+        driveIndex.clear();
+        for (size_t index = 0; index < drives.size(); index++)
+        {
+            driveIndex.emplace(drives[index].id, index);
+        }
+    }
+
+  private:
+    boost::container::flat_map<std::string, size_t> driveIndex;
+};
+
+/**
+ * @brief The last StorageInventory read.
+ *
+ * The drives, storage controllers and chassis are listed through the mapper,
+ * the drive association of each chassis is resolved, and the rendered
+ * properties of every drive and controller are read, all on first use.
+ * The inventory is then handed to every Storage and Drive request until a
+ * signal is sent from within the inventory tree, or a well known name
+ * changes owner; then it is read again on next use.  A chassis with two
+ * dozen drives therefore renders from memory rather than with a handful of
+ * calls per drive.  Concurrent reads share one fetch, and a fetch that was
+ * in flight when the inventory changed is answered but not kept.
+ */
+class StorageInventoryCache
+{
+  public:
+    using Callback =
+        std::function<void(const std::shared_ptr<const StorageInventory>&)>;
+
+    static StorageInventoryCache& getInstance()
+    {
+        static StorageInventoryCache cache;
+        return cache;
+    }
+
+    StorageInventoryCache(const StorageInventoryCache&) = delete;
+    StorageInventoryCache(StorageInventoryCache&&) = delete;
+    StorageInventoryCache& operator=(const StorageInventoryCache&) = delete;
+    StorageInventoryCache& operator=(StorageInventoryCache&&) = delete;
+    ~StorageInventoryCache() = default;
+
+    void registerMatches(sdbusplus::asio::connection& conn)
+    {
+        namespace rules = sdbusplus::bus::match::rules;
+
+        // The mapper keeps drive associations beneath the chassis, so their
+        // changes are sent from within the inventory tree too
+        matches.clear();
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn,
+            rules::type::signal() +
+                rules::path_namespace("/xyz/openbmc_project/inventory"),
+            [this](sdbusplus::message_t& /*msg*/) { clear(); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::nameOwnerChanged(), [this](sdbusplus::message_t& msg) {
+            std::string name;
+            msg.read(name);
+            if (!name.starts_with(':'))
+            {
+                clear();
+            }
+        }));
+        clear();
+    }
+
+    bool enabled() const
+    {
+        return !matches.empty();
+    }
+
+    /**
+     * @brief Calls callback with the storage inventory, reading it if it
+     * isn't cached.  The callback is never called inline.
+     */
+    void get(Callback&& callback)
+    {
+        if (inventory)
+        {
+            std::shared_ptr<const StorageInventory> current = inventory;
+            boost::asio::post(crow::connections::systemBus->get_io_context(),
+                              [current, callback{std::move(callback)}]() {
+                callback(current);
+            });
+            return;
+        }
+
+        callbacks.emplace_back(std::move(callback));
+        if (callbacks.size() > 1)
+        {
+            return;
+        }
+        crow::dbus_trace::SharedCallScope sharedCalls;
+        auto fetch = std::make_shared<Fetch>(*this, generation);
+        readObjects(fetch, driveInterfaces, &StorageInventory::drives);
+        readObjects(fetch, controllerInterfaces,
+                    &StorageInventory::controllers);
+        readChassis(fetch);
+    }
+
+    void clear()
+    {
+        inventory.reset();
+        generation++;
+    }
+
+  private:
+    // Completes the fetch once every read it issued has returned
+    struct Fetch
+    {
+        Fetch(StorageInventoryCache& cacheIn, uint64_t fetchGenerationIn) :
+            cache(cacheIn), fetchGeneration(fetchGenerationIn)
+        {}
+
+        ~Fetch()
+        {
+            read->indexDrives();
+            cache.complete(fetchGeneration, read);
+        }
+
+        Fetch(const Fetch&) = delete;
+        Fetch(Fetch&&) = delete;
+        Fetch& operator=(const Fetch&) = delete;
+        Fetch& operator=(Fetch&&) = delete;
+
+        StorageInventoryCache& cache;
+        uint64_t fetchGeneration;
+        std::shared_ptr<StorageInventory> read =
+            std::make_shared<StorageInventory>();
+    };
+
+    using ObjectList = std::vector<StorageObject> StorageInventory::*;
+
+    StorageInventoryCache() = default;
+
+    static void readObjects(const std::shared_ptr<Fetch>& fetch,
+                            std::span<const std::string_view> interfaces,
+                            ObjectList list)
+    {
+        dbus::utility::getSubTree(
+            "/xyz/openbmc_project/inventory", 0, interfaces,
+            [fetch, list](const boost::system::error_code& ec,
+                          const dbus::utility::MapperGetSubTreeResponse&
+                              subtree) {
+            if (ec)
+            {
+                BMCWEB_LOG_DEBUG << "Storage mapper call error " << ec;
+                if (list == &StorageInventory::drives)
+                {
+                    fetch->read->drivesError = ec;
+                }
+                return;
+            }
+            std::vector<StorageObject>& objects = (*fetch->read).*list;
+            for (const auto& [path, services] : subtree)
+            {
+                objects.emplace_back(StorageObject{
+                    sdbusplus::message::object_path(path).filename(), path,
+                    services, {}});
+            }
+            for (size_t index = 0; index < objects.size(); index++)
+            {
+                readProperties(fetch, list, index);
+            }
+        });
+    }
+
+    static void readProperties(const std::shared_ptr<Fetch>& fetch,
+                               ObjectList list, size_t index)
+    {
+        const StorageObject& object = ((*fetch->read).*list)[index];
+        if (object.services.empty())
+        {
+            return;
+        }
+        const auto& [service, interfaces] = object.services.front();
+        for (const std::string& interface : interfaces)
+        {
+            if (std::find(renderedInterfaces.begin(), renderedInterfaces.end(),
+                          interface) == renderedInterfaces.end())
+            {
+                continue;
+            }
+            dbus::utility::getAllPropertiesBatched(
+                service, object.path, interface,
+                [fetch, list, index,
+                 interface](const boost::system::error_code& ec,
+                            const dbus::utility::DBusPropertiesMap&
+                                properties) {
+                // None of these interfaces are required
+                if (ec)
+                {
+                    return;
+                }
+                ((*fetch->read).*list)[index].interfaces.emplace_back(
+                    interface, properties);
+            });
+        }
+    }
+
+    static void readChassis(const std::shared_ptr<Fetch>& fetch)
+    {
+        dbus::utility::getSubTree(
+            "/xyz/openbmc_project/inventory", 0, chassisInterfaces,
+            [fetch](const boost::system::error_code& ec,
+                    const dbus::utility::MapperGetSubTreeResponse& subtree) {
+            if (ec)
+            {
+                BMCWEB_LOG_DEBUG << "Chassis mapper call error " << ec;
+                fetch->read->chassisError = ec;
+                return;
+            }
+            std::vector<ChassisDrives>& chassis = fetch->read->chassis;
+            for (const auto& [path, services] : subtree)
+            {
+                if (services.empty())
+                {
+                    BMCWEB_LOG_ERROR << "Got 0 Connection names";
+                    continue;
+                }
+                chassis.emplace_back(ChassisDrives{
+                    sdbusplus::message::object_path(path).filename(), path,
+                    std::nullopt});
+            }
+            for (size_t index = 0; index < chassis.size(); index++)
+            {
+                dbus::utility::getAssociationEndPoints(
+                    chassis[index].path + "/drive",
+                    [fetch, index](const boost::system::error_code& ec2,
+                                   const dbus::utility::MapperEndPoints&
+                                       endpoints) {
+                    if (ec2)
+                    {
+                        return;
+                    }
+                    fetch->read->chassis[index].drives = endpoints;
+                });
+            }
+        });
+    }
+
+    void complete(uint64_t fetchGeneration,
+                  const std::shared_ptr<const StorageInventory>& read)
+    {
+        std::vector<Callback> waiting = std::move(callbacks);
+        callbacks.clear();
+
+        // Failed mapper queries are handed out but not kept
+        if (!read->drivesError && !read->chassisError && enabled() &&
+            fetchGeneration == generation)
+        {
+            inventory = read;
+        }
+        for (Callback& callback : waiting)
+        {
+            callback(read);
+        }
+    }
+
+    std::shared_ptr<const StorageInventory> inventory;
+    std::vector<Callback> callbacks;
+    uint64_t generation = 0;
+    std::vector<std::unique_ptr<sdbusplus::bus::match_t>> matches;
+};
+
+} // namespace storage_utils
+} // namespace redfish
@@ -0,0 +1,586 @@
+#pragma once
+
+#include "dbus_singleton.hpp"
+#include "dbus_utility.hpp"
+#include "logging.hpp"
+#include "utils/change_journal.hpp"
+
+#include <boost/asio/post.hpp>
+#include <boost/container/flat_map.hpp>
+#include <sdbusplus/asio/connection.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace redfish
+{
+namespace sw_util
+{
+
+constexpr std::string_view softwareRoot = "/xyz/openbmc_project/software";
+
+constexpr std::string_view versionInterface =
+    "xyz.openbmc_project.Software.Version";
+
+// The interfaces of a software image that are rendered
+constexpr std::array<std::string_view, 3> imageInterfaces = {
+    versionInterface, "xyz.openbmc_project.Software.Activation",
+    "xyz.openbmc_project.Software.MinimumVersion"};
+
+/**
+ * @brief A software image and the properties of the rendered interfaces it
+ * implements.
+ */
+struct SoftwareImage
+{
+    std::string id;
+    dbus::utility::DBusInteracesMap interfaces;
+
+    // The properties of interface, or nullptr if it isn't known
+    const dbus::utility::DBusPropertiesMap*
+        find(std::string_view interface) const
+    {
+        for (const auto& [name, properties] : interfaces)
+        {
+            if (name == interface)
+            {
+                return &properties;
+            }
+        }
+        return nullptr;
+    }
+
+    // Merges changed into the properties of interface
+    void update(const std::string& interface,
+                const dbus::utility::DBusPropertiesMap& changed)
+    {
+        auto it = std::find_if(interfaces.begin(), interfaces.end(),
+                               [&interface](const auto& entry) {
+            return entry.first == interface;
+        });
+        if (it == interfaces.end())
+        {
+            interfaces.emplace_back(interface, changed);
+            return;
+        }
+        for (const auto& [name, value] : changed)
+        {
+            auto property = std::find_if(it->second.begin(), it->second.end(),
+                                         [&name](const auto& entry) {
+                return entry.first == name;
+            });
+            if (property == it->second.end())
+            {
+                it->second.emplace_back(name, value);
+            }
+            else
+            {
+                property->second = value;
+            }
+        }
+    }
+
+    void erase(const std::string& interface)
+    {
+        std::erase_if(interfaces, [&interface](const auto& entry) {
+            return entry.first == interface;
+        });
+    }
+};
+
+/**
+ * @brief The software images beneath softwareRoot, keyed and sorted by
+ * path, with the endpoints of the functional and updateable associations.
+ * functional is nullopt if the association doesn't exist.
+ */
+struct SoftwareInventory
+{
+    boost::container::flat_map<std::string, SoftwareImage> images;
+    std::optional<std::vector<std::string>> functional;
+    std::vector<std::string> updateable;
+
+    static bool isImageInterface(std::string_view interface)
+    {
+        return std::find(imageInterfaces.begin(), imageInterfaces.end(),
+                         interface) != imageInterfaces.end();
+    }
+
+    static std::string functionalPath()
+    {
+        return std::string(softwareRoot) + "/functional";
+    }
+
+    static std::string updateablePath()
+    {
+        return std::string(softwareRoot) + "/updateable";
+    }
+
+    // Applies a PropertiesChanged, or the properties of an added interface,
+    // sent from path
+    void update(const std::string& path, const std::string& interface,
+                const dbus::utility::DBusPropertiesMap& properties)
+    {
+        if (interface == "xyz.openbmc_project.Association")
+        {
+            updateAssociation(path, properties);
+            return;
+        }
+        if (!isImageInterface(interface))
+        {
+            return;
+        }
+        auto image = images.find(path);
+        if (image == images.end())
+        {
+            // Only objects with a version are images
+            if (interface != versionInterface)
+            {
+                return;
+            }
+            std::string id = sdbusplus::message::object_path(path).filename();
+            if (id.empty())
+            {
+                return;
+            }
+            image = images.emplace(path, SoftwareImage{std::move(id), {}})
+                        .first;
+        }
+        image->second.update(interface, properties);
+    }
+
+    void erase(const std::string& path, const std::string& interface)
+    {
+        if (interface == "xyz.openbmc_project.Association")
+        {
+            if (path == functionalPath())
+            {
+                functional.reset();
+            }
+            else if (path == updateablePath())
+            {
+                updateable.clear();
+            }
+            return;
+        }
+        auto image = images.find(path);
+        if (image == images.end())
+        {
+            return;
+        }
+        if (interface == versionInterface)
+        {
+            images.erase(image);
+            return;
+        }
+        image->second.erase(interface);
+    }
+
+  private:
+    void updateAssociation(const std::string& path,
+                           const dbus::utility::DBusPropertiesMap& properties)
+    {
+        for (const auto& [name, value] : properties)
+        {
+            const std::vector<std::string>* endpoints =
+                std::get_if<std::vector<std::string>>(&value);
+            if (name != "endpoints" || endpoints == nullptr)
+            {
+                continue;
+            }
+            if (path == functionalPath())
+            {
+                functional = *endpoints;
+            }
+            else if (path == updateablePath())
+            {
+                updateable = *endpoints;
+            }
+        }
+    }
+};
+
+/**
+ * @brief Holds the SoftwareInventory, so FirmwareInventory requests and the
+ * firmware versions of Managers and Systems don't each walk the software
+ * tree and read every image.
+ *
+ * The inventory is read on first use.  After that, signals from within the
+ * software tree are applied to it in place: PropertiesChanged of an image's
+ * Activation or Version, images being added or removed through
+ * InterfacesAdded and InterfacesRemoved, and the mapper updating the
+ * functional and updateable associations.  A well known name changing owner
+ * drops it, to be read again on next use.  An inventory that has been
+ * handed out is never modified; a signal that arrives while one is still in
+ * use replaces it with an updated copy.
+ */
+class SoftwareInventoryCache
+{
+  public:
+    using Callback =
+        std::function<void(const boost::system::error_code&,
+                           const std::shared_ptr<const SoftwareInventory>&)>;
+
+    static SoftwareInventoryCache& getInstance()
+    {
+        static SoftwareInventoryCache cache;
+        return cache;
+    }
+
+    SoftwareInventoryCache(const SoftwareInventoryCache&) = delete;
+    SoftwareInventoryCache(SoftwareInventoryCache&&) = delete;
+    SoftwareInventoryCache& operator=(const SoftwareInventoryCache&) = delete;
+    SoftwareInventoryCache& operator=(SoftwareInventoryCache&&) = delete;
+    ~SoftwareInventoryCache() = default;
+
+    void registerMatches(sdbusplus::asio::connection& conn)
+    {
+        namespace rules = sdbusplus::bus::match::rules;
+        std::string root(softwareRoot);
+
+        matches.clear();
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn,
+            rules::type::signal() + rules::member("PropertiesChanged") +
+                rules::interface("org.freedesktop.DBus.Properties") +
+                rules::path_namespace(root),
+            [this](sdbusplus::message_t& msg) { onPropertiesChanged(msg); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::interfacesAdded() + rules::path_namespace(root),
+            [this](sdbusplus::message_t& msg) { onInterfacesAdded(msg); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::interfacesRemoved() + rules::path_namespace(root),
+            [this](sdbusplus::message_t& msg) { onInterfacesRemoved(msg); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::nameOwnerChanged(), [this](sdbusplus::message_t& msg) {
+            std::string name;
+            msg.read(name);
+            if (!name.starts_with(':'))
+            {
+                clear();
+            }
+        }));
+        clear();
+    }
+
+    bool enabled() const
+    {
+        return !matches.empty();
+    }
+
+    /**
+     * @brief Calls callback with the software inventory, reading it if it
+     * isn't cached.  The callback is never called inline.
+     */
+    void get(Callback&& callback)
+    {
+        if (inventory)
+        {
+            std::shared_ptr<const SoftwareInventory> current = inventory;
+            boost::asio::post(crow::connections::systemBus->get_io_context(),
+                              [current, callback{std::move(callback)}]() {
+                callback(boost::system::error_code(), current);
+            });
+            return;
+        }
+
+        callbacks.emplace_back(std::move(callback));
+        if (callbacks.size() > 1)
+        {
+            return;
+        }
+        crow::dbus_trace::SharedCallScope sharedCalls;
+        auto fetch = std::make_shared<Fetch>(*this, generation);
+        readImages(fetch);
+        readAssociations(fetch);
+    }
+
+    // The journal of software objects changed, while signals are followed
+    const ChangeJournal* changes() const
+    {
+        return enabled() ? &journal : nullptr;
+    }
+
+    void clear()
+    {
+        inventory.reset();
+        generation++;
+        journal.reset();
+    }
+
+  private:
+    // Completes the fetch once every read it issued has returned
+    struct Fetch
+    {
+        Fetch(SoftwareInventoryCache& cacheIn, uint64_t fetchGenerationIn) :
+            cache(cacheIn), fetchGeneration(fetchGenerationIn)
+        {}
+
+        ~Fetch()
+        {
+            cache.complete(fetchGeneration, ec, read);
+        }
+
+        Fetch(const Fetch&) = delete;
+        Fetch(Fetch&&) = delete;
+        Fetch& operator=(const Fetch&) = delete;
+        Fetch& operator=(Fetch&&) = delete;
+
+        SoftwareInventoryCache& cache;
+        uint64_t fetchGeneration;
+        boost::system::error_code ec;
+        std::shared_ptr<SoftwareInventory> read =
+            std::make_shared<SoftwareInventory>();
+    };
+
+    SoftwareInventoryCache() = default;
+
+    // The functional and updateable associations are part of every image's
+    // state, so a change to them can't be told image by image
+    void recordChange(const std::string& path, const std::string& interface)
+    {
+        if (interface == "xyz.openbmc_project.Association")
+        {
+            journal.reset();
+            return;
+        }
+        journal.record(path);
+    }
+
+    static void readImages(const std::shared_ptr<Fetch>& fetch)
+    {
+        constexpr std::array<std::string_view, 1> interfaces = {
+            versionInterface};
+        dbus::utility::getSubTree(
+            std::string(softwareRoot), 0, interfaces,
+            [fetch](const boost::system::error_code& ec,
+                    const dbus::utility::MapperGetSubTreeResponse& subtree) {
+            if (ec)
+            {
+                BMCWEB_LOG_ERROR << "Software mapper call error: " << ec;
+                fetch->ec = ec;
+                return;
+            }
+            BMCWEB_LOG_DEBUG << "Found " << subtree.size() << " images";
+            for (const auto& [path, services] : subtree)
+            {
+                if (services.empty())
+                {
+                    continue;
+                }
+                const auto& [service, serviceInterfaces] = services.front();
+                for (const std::string& interface : serviceInterfaces)
+                {
+                    if (!SoftwareInventory::isImageInterface(interface))
+                    {
+                        continue;
+                    }
+                    dbus::utility::getAllPropertiesBatched(
+                        service, path, interface,
+                        [fetch, path{path}, interface](
+                            const boost::system::error_code& ec2,
+                            const dbus::utility::DBusPropertiesMap&
+                                properties) {
+                        if (ec2)
+                        {
+                            // The software manager can delete an image
+                            // between the mapper call and here; it's then
+                            // left out
+                            if (ec2.value() != EBADR)
+                            {
+                                BMCWEB_LOG_ERROR << "Image read error: " << ec2;
+                                fetch->ec = ec2;
+                            }
+                            return;
+                        }
+                        fetch->read->update(path, interface, properties);
+                    });
+                }
+            }
+        });
+    }
+
+    static void readAssociations(const std::shared_ptr<Fetch>& fetch)
+    {
+        dbus::utility::getAssociationEndPoints(
+            SoftwareInventory::functionalPath(),
+            [fetch](const boost::system::error_code& ec,
+                    const dbus::utility::MapperEndPoints& endpoints) {
+            if (ec)
+            {
+                BMCWEB_LOG_DEBUG << "No functional software: " << ec;
+                return;
+            }
+            fetch->read->functional = endpoints;
+        });
+        dbus::utility::getAssociationEndPoints(
+            SoftwareInventory::updateablePath(),
+            [fetch](const boost::system::error_code& ec,
+                    const dbus::utility::MapperEndPoints& endpoints) {
+            if (ec)
+            {
+                // System can exist with no updateable software
+                BMCWEB_LOG_DEBUG << "No updateable software: " << ec;
+                return;
+            }
+            fetch->read->updateable = endpoints;
+        });
+    }
+
+    void complete(uint64_t fetchGeneration, const boost::system::error_code& ec,
+                  const std::shared_ptr<SoftwareInventory>& read)
+    {
+        std::vector<Callback> waiting = std::move(callbacks);
+        callbacks.clear();
+
+        // The images are only complete if every read succeeded, and a
+        // signal received meanwhile may not be in the replies
+        if (ec)
+        {
+            for (Callback& callback : waiting)
+            {
+                callback(ec, nullptr);
+            }
+            return;
+        }
+        if (enabled() && fetchGeneration == generation)
+        {
+            inventory = read;
+        }
+        for (Callback& callback : waiting)
+        {
+            callback(ec, read);
+        }
+    }
+
+    // Returns the inventory for modification, or nullptr when nothing is
+    // cached
+    SoftwareInventory* writableInventory()
+    {
+        generation++;
+        if (!inventory)
+        {
+            return nullptr;
+        }
+        if (inventory.use_count() > 1)
+        {
+            inventory = std::make_shared<SoftwareInventory>(*inventory);
+        }
+        return inventory.get();
+    }
+
+    void onPropertiesChanged(sdbusplus::message_t& msg)
+    {
+        std::string interface;
+        dbus::utility::DBusPropertiesMap properties;
+        try
+        {
+            msg.read(interface, properties);
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            BMCWEB_LOG_ERROR << "Failed to read software change: "
+                             << e.what();
+            clear();
+            return;
+        }
+        recordChange(msg.get_path(), interface);
+        SoftwareInventory* current = writableInventory();
+        if (current != nullptr)
+        {
+            current->update(msg.get_path(), interface, properties);
+        }
+    }
+
+    void onInterfacesAdded(sdbusplus::message_t& msg)
+    {
+        sdbusplus::message::object_path path;
+        dbus::utility::DBusInteracesMap interfaces;
+        try
+        {
+            msg.read(path, interfaces);
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            BMCWEB_LOG_ERROR << "Failed to read added software: " << e.what();
+            clear();
+            return;
+        }
+        for (const auto& [interface, properties] : interfaces)
+        {
+            recordChange(path.str, interface);
+        }
+        SoftwareInventory* current = writableInventory();
+        if (current == nullptr)
+        {
+            return;
+        }
+        // Version first, so the image exists before its other interfaces
+        // are added to it
+        for (const auto& [interface, properties] : interfaces)
+        {
+            if (interface == versionInterface)
+            {
+                current->update(path.str, interface, properties);
+            }
+        }
+        for (const auto& [interface, properties] : interfaces)
+        {
+            if (interface != versionInterface)
+            {
+                current->update(path.str, interface, properties);
+            }
+        }
+    }
+
+    void onInterfacesRemoved(sdbusplus::message_t& msg)
+    {
+        sdbusplus::message::object_path path;
+        std::vector<std::string> interfaces;
+        try
+        {
+            msg.read(path, interfaces);
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            BMCWEB_LOG_ERROR << "Failed to read removed software: "
+                             << e.what();
+            clear();
+            return;
+        }
+        for (const std::string& interface : interfaces)
+        {
+            recordChange(path.str, interface);
+        }
+        SoftwareInventory* current = writableInventory();
+        if (current == nullptr)
+        {
+            return;
+        }
+        for (const std::string& interface : interfaces)
+        {
+            current->erase(path.str, interface);
+        }
+    }
+
+    std::shared_ptr<SoftwareInventory> inventory;
+    std::vector<Callback> callbacks;
+    uint64_t generation = 0;
+    // Fed by the same signals, whether or not inventory is cached
+    ChangeJournal journal;
+    std::vector<std::unique_ptr<sdbusplus::bus::match_t>> matches;
+};
+
+} // namespace sw_util
+} // namespace redfish
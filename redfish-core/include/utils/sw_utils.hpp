@@ -2,9 +2,9 @@
 #include <async_resp.hpp>
 #include <dbus_utility.hpp>
 #include <generated/enums/resource.hpp>
-#include <sdbusplus/asio/property.hpp>
 #include <sdbusplus/unpack_properties.hpp>
 #include <utils/dbus_utils.hpp>
+#include <utils/sw_inventory_cache.hpp>
 
 #include <algorithm>
 #include <memory>
@@ -42,12 +42,10 @@ inline void
                                 const std::string& activeVersionPropName,
                                 const bool populateLinkToImages)
 {
-    // Used later to determine running (known on Redfish as active) Sw images
-    dbus::utility::getAssociationEndPoints(
-        "/xyz/openbmc_project/software/functional",
+    SoftwareInventoryCache::getInstance().get(
         [aResp, swVersionPurpose, activeVersionPropName, populateLinkToImages](
             const boost::system::error_code& ec,
-            const dbus::utility::MapperEndPoints& functionalSw) {
+            const std::shared_ptr<const SoftwareInventory>& inventory) {
         BMCWEB_LOG_DEBUG << "populateSoftwareInformation enter";
         if (ec)
         {
@@ -57,7 +55,8 @@ inline void
             return;
         }
 
-        if (functionalSw.empty())
+        // Used to determine running (known on Redfish as active) Sw images
+        if (!inventory->functional || inventory->functional->empty())
         {
             // Could keep going and try to populate SoftwareImages but
             // something is seriously wrong, so just fail
@@ -70,7 +69,7 @@ inline void
         // example functionalSw:
         // v as 2 "/xyz/openbmc_project/software/ace821ef"
         //        "/xyz/openbmc_project/software/230fb078"
-        for (const auto& sw : functionalSw)
+        for (const auto& sw : *inventory->functional)
         {
             sdbusplus::message::object_path path(sw);
             std::string leaf = path.filename();
@@ -82,145 +81,93 @@ inline void
             functionalSwIds.push_back(leaf);
         }
 
-        crow::connections::systemBus->async_method_call(
-            [aResp, swVersionPurpose, activeVersionPropName,
-             populateLinkToImages, functionalSwIds](
-                const boost::system::error_code ec2,
-                const dbus::utility::MapperGetSubTreeResponse& subtree) {
-            if (ec2)
+        BMCWEB_LOG_DEBUG << "Found " << inventory->images.size() << " images";
+
+        for (const auto& [path, image] : inventory->images)
+        {
+            const std::string& swId = image.id;
+
+            bool runningImage = false;
+            // Look at Ids from
+            // /xyz/openbmc_project/software/functional
+            // to determine if this is a running image
+            if (std::find(functionalSwIds.begin(), functionalSwIds.end(),
+                          swId) != functionalSwIds.end())
+            {
+                runningImage = true;
+            }
+
+            // Images the code update app deleted between listing and reading
+            // them have no version info; leave them off
+            const dbus::utility::DBusPropertiesMap* propertiesList =
+                image.find(versionInterface);
+            if (propertiesList == nullptr)
+            {
+                continue;
+            }
+
+            // example propertiesList
+            // a{sv} 2 "Version" s
+            // "IBM-witherspoon-OP9-v2.0.10-2.22" "Purpose"
+            // s
+            // "xyz.openbmc_project.Software.Version.VersionPurpose.Host"
+            const std::string* version = nullptr;
+            const std::string* swInvPurpose = nullptr;
+
+            const bool success = sdbusplus::unpackPropertiesNoThrow(
+                dbus_utils::UnpackErrorPrinter(), *propertiesList, "Purpose",
+                swInvPurpose, "Version", version);
+
+            if (!success)
             {
-                BMCWEB_LOG_ERROR << "error_code = " << ec2;
-                BMCWEB_LOG_ERROR << "error msg = " << ec2.message();
                 messages::internalError(aResp->res);
                 return;
             }
 
-            BMCWEB_LOG_DEBUG << "Found " << subtree.size() << " images";
-
-            for (const std::pair<std::string,
-                                 std::vector<std::pair<
-                                     std::string, std::vector<std::string>>>>&
-                     obj : subtree)
+            if (version == nullptr || version->empty())
             {
-                sdbusplus::message::object_path path(obj.first);
-                std::string swId = path.filename();
-                if (swId.empty())
-                {
-                    messages::internalError(aResp->res);
-                    BMCWEB_LOG_ERROR << "Invalid software ID";
+                messages::internalError(aResp->res);
+                return;
+            }
+            if (swInvPurpose == nullptr || *swInvPurpose != swVersionPurpose)
+            {
+                // Not purpose we're looking for
+                continue;
+            }
 
-                    return;
-                }
+            BMCWEB_LOG_DEBUG << "Image ID: " << swId;
+            BMCWEB_LOG_DEBUG << "Running image: " << runningImage;
+            BMCWEB_LOG_DEBUG << "Image purpose: " << *swInvPurpose;
 
-                bool runningImage = false;
-                // Look at Ids from
-                // /xyz/openbmc_project/software/functional
-                // to determine if this is a running image
-                if (std::find(functionalSwIds.begin(), functionalSwIds.end(),
-                              swId) != functionalSwIds.end())
+            if (populateLinkToImages)
+            {
+                nlohmann::json& softwareImageMembers =
+                    aResp->res.jsonValue["Links"]["SoftwareImages"];
+                // Firmware images are at
+                // /redfish/v1/UpdateService/FirmwareInventory/<Id>
+                // e.g. .../FirmwareInventory/82d3ec86
+                nlohmann::json::object_t member;
+                member["@odata.id"] =
+                    "/redfish/v1/UpdateService/FirmwareInventory/" + swId;
+                softwareImageMembers.push_back(std::move(member));
+                aResp->res.jsonValue["Links"]["SoftwareImages@odata.count"] =
+                    softwareImageMembers.size();
+
+                if (runningImage)
                 {
-                    runningImage = true;
+                    nlohmann::json::object_t runningMember;
+                    runningMember["@odata.id"] =
+                        "/redfish/v1/UpdateService/FirmwareInventory/" + swId;
+                    // Create the link to the running image
+                    aResp->res.jsonValue["Links"]["ActiveSoftwareImage"] =
+                        std::move(runningMember);
                 }
-
-                // Now grab its version info
-                sdbusplus::asio::getAllProperties(
-                    *crow::connections::systemBus, obj.second[0].first,
-                    obj.first, "xyz.openbmc_project.Software.Version",
-                    [aResp, swId, runningImage, swVersionPurpose,
-                     activeVersionPropName, populateLinkToImages](
-                        const boost::system::error_code ec3,
-                        const dbus::utility::DBusPropertiesMap&
-                            propertiesList) {
-                    if (ec3)
-                    {
-                        BMCWEB_LOG_ERROR << "error_code = " << ec3;
-                        BMCWEB_LOG_ERROR << "error msg = " << ec3.message();
-                        // Have seen the code update app delete the D-Bus
-                        // object, during code update, between the call to
-                        // mapper and here. Just leave these properties off if
-                        // resource not found.
-                        if (ec3.value() == EBADR)
-                        {
-                            return;
-                        }
-                        messages::internalError(aResp->res);
-                        return;
-                    }
-                    // example propertiesList
-                    // a{sv} 2 "Version" s
-                    // "IBM-witherspoon-OP9-v2.0.10-2.22" "Purpose"
-                    // s
-                    // "xyz.openbmc_project.Software.Version.VersionPurpose.Host"
-                    const std::string* version = nullptr;
-                    const std::string* swInvPurpose = nullptr;
-
-                    const bool success = sdbusplus::unpackPropertiesNoThrow(
-                        dbus_utils::UnpackErrorPrinter(), propertiesList,
-                        "Purpose", swInvPurpose, "Version", version);
-
-                    if (!success)
-                    {
-                        messages::internalError(aResp->res);
-                        return;
-                    }
-
-                    if (version == nullptr || version->empty())
-                    {
-                        messages::internalError(aResp->res);
-                        return;
-                    }
-                    if (swInvPurpose == nullptr ||
-                        *swInvPurpose != swVersionPurpose)
-                    {
-                        // Not purpose we're looking for
-                        return;
-                    }
-
-                    BMCWEB_LOG_DEBUG << "Image ID: " << swId;
-                    BMCWEB_LOG_DEBUG << "Running image: " << runningImage;
-                    BMCWEB_LOG_DEBUG << "Image purpose: " << *swInvPurpose;
-
-                    if (populateLinkToImages)
-                    {
-                        nlohmann::json& softwareImageMembers =
-                            aResp->res.jsonValue["Links"]["SoftwareImages"];
-                        // Firmware images are at
-                        // /redfish/v1/UpdateService/FirmwareInventory/<Id>
-                        // e.g. .../FirmwareInventory/82d3ec86
-                        nlohmann::json::object_t member;
-                        member["@odata.id"] = "/redfish/v1/UpdateService/"
-                                              "FirmwareInventory/" +
-                                              swId;
-                        softwareImageMembers.push_back(std::move(member));
-                        aResp->res
-                            .jsonValue["Links"]["SoftwareImages@odata.count"] =
-                            softwareImageMembers.size();
-
-                        if (runningImage)
-                        {
-                            nlohmann::json::object_t runningMember;
-                            runningMember["@odata.id"] =
-                                "/redfish/v1/UpdateService/"
-                                "FirmwareInventory/" +
-                                swId;
-                            // Create the link to the running image
-                            aResp->res
-                                .jsonValue["Links"]["ActiveSoftwareImage"] =
-                                std::move(runningMember);
-                        }
-                    }
-                    if (!activeVersionPropName.empty() && runningImage)
-                    {
-                        aResp->res.jsonValue[activeVersionPropName] = *version;
-                    }
-                });
             }
-        },
-            "xyz.openbmc_project.ObjectMapper",
-            "/xyz/openbmc_project/object_mapper",
-            "xyz.openbmc_project.ObjectMapper", "GetSubTree",
-            "/xyz/openbmc_project/software", static_cast<int32_t>(0),
-            std::array<const char*, 1>{"xyz.openbmc_project.Software.Version"});
+            if (!activeVersionPropName.empty() && runningImage)
+            {
+                aResp->res.jsonValue[activeVersionPropName] = *version;
+            }
+        }
     });
 }
 
@@ -278,133 +225,113 @@ inline std::string getRedfishSwHealth(const std::string& swState)
 }
 
 /**
- * @brief Put LowestSupportedVersion of input swId into json response
+ * @brief Put LowestSupportedVersion of input image into json response
  *
  * This function will put the MinimumVersion from D-Bus of the input
- * software id to ["LowestSupportedVersion"].
+ * software image to ["LowestSupportedVersion"].
  *
  * @param[i,o] asyncResp    Async response object
- * @param[i]   swId The software ID to get Minimum Version for
- * @param[i]   dbusSvc  The dbus service implementing the software object
+ * @param[i]   image        The software image to get Minimum Version for
  *
  * @return void
  */
 inline void
     getSwMinimumVersion(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-                        const std::shared_ptr<std::string>& swId,
-                        const std::string& dbusSvc)
+                        const SoftwareImage& image)
 {
-    sdbusplus::asio::getProperty<std::string>(
-        *crow::connections::systemBus, dbusSvc,
-        "/xyz/openbmc_project/software/" + *swId,
-        "xyz.openbmc_project.Software.MinimumVersion", "MinimumVersion",
-        [asyncResp](const boost::system::error_code& ec,
-                    const std::string& swMinimumVersion) {
-        if (ec)
-        {
-            // not all software has this interface and it is not critical
-            return;
-        }
+    const dbus::utility::DBusPropertiesMap* propertiesList =
+        image.find("xyz.openbmc_project.Software.MinimumVersion");
+    if (propertiesList == nullptr)
+    {
+        // not all software has this interface and it is not critical
+        return;
+    }
 
-        asyncResp->res.jsonValue["LowestSupportedVersion"] = swMinimumVersion;
-    });
+    const std::string* swMinimumVersion = nullptr;
+
+    const bool success = sdbusplus::unpackPropertiesNoThrow(
+        dbus_utils::UnpackErrorPrinter(), *propertiesList, "MinimumVersion",
+        swMinimumVersion);
+
+    if (!success || swMinimumVersion == nullptr)
+    {
+        return;
+    }
+
+    asyncResp->res.jsonValue["LowestSupportedVersion"] = *swMinimumVersion;
 }
 
 /**
- * @brief Put status of input swId into json response
+ * @brief Put status of input image into json response
  *
  * This function will put the appropriate Redfish state of the input
- * software id to ["Status"]["State"] within the json response
+ * software image to ["Status"]["State"] within the json response
  *
- * @param[i,o] aResp    Async response object
- * @param[i]   swId     The software ID to get status for
- * @param[i]   dbusSvc  The dbus service implementing the software object
+ * @param[i,o] asyncResp    Async response object
+ * @param[i]   image        The software image to get status for
  *
  * @return void
  */
 inline void getSwStatus(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-                        const std::shared_ptr<std::string>& swId,
-                        const std::string& dbusSvc)
+                        const SoftwareImage& image)
 {
-    BMCWEB_LOG_DEBUG << "getSwStatus: swId " << *swId << " svc " << dbusSvc;
-
-    sdbusplus::asio::getAllProperties(
-        *crow::connections::systemBus, dbusSvc,
-        "/xyz/openbmc_project/software/" + *swId,
-        "xyz.openbmc_project.Software.Activation",
-        [asyncResp,
-         swId](const boost::system::error_code errorCode,
-               const dbus::utility::DBusPropertiesMap& propertiesList) {
-        if (errorCode)
-        {
-            // not all swtypes are updateable, this is ok
-            asyncResp->res.jsonValue["Status"]["State"] = "Enabled";
-            return;
-        }
+    BMCWEB_LOG_DEBUG << "getSwStatus: swId " << image.id;
 
-        const std::string* swInvActivation = nullptr;
+    const dbus::utility::DBusPropertiesMap* propertiesList =
+        image.find("xyz.openbmc_project.Software.Activation");
+    if (propertiesList == nullptr)
+    {
+        // not all swtypes are updateable, this is ok
+        asyncResp->res.jsonValue["Status"]["State"] = "Enabled";
+        return;
+    }
 
-        const bool success = sdbusplus::unpackPropertiesNoThrow(
-            dbus_utils::UnpackErrorPrinter(), propertiesList, "Activation",
-            swInvActivation);
+    const std::string* swInvActivation = nullptr;
 
-        if (!success)
-        {
-            messages::internalError(asyncResp->res);
-            return;
-        }
+    const bool success = sdbusplus::unpackPropertiesNoThrow(
+        dbus_utils::UnpackErrorPrinter(), *propertiesList, "Activation",
+        swInvActivation);
 
-        if (swInvActivation == nullptr)
-        {
-            messages::internalError(asyncResp->res);
-            return;
-        }
+    if (!success)
+    {
+        messages::internalError(asyncResp->res);
+        return;
+    }
 
-        BMCWEB_LOG_DEBUG << "getSwStatus: Activation " << *swInvActivation;
-        asyncResp->res.jsonValue["Status"]["State"] =
-            getRedfishSwState(*swInvActivation);
-        asyncResp->res.jsonValue["Status"]["Health"] =
-            getRedfishSwHealth(*swInvActivation);
-    });
+    if (swInvActivation == nullptr)
+    {
+        messages::internalError(asyncResp->res);
+        return;
+    }
+
+    BMCWEB_LOG_DEBUG << "getSwStatus: Activation " << *swInvActivation;
+    asyncResp->res.jsonValue["Status"]["State"] =
+        getRedfishSwState(*swInvActivation);
+    asyncResp->res.jsonValue["Status"]["Health"] =
+        getRedfishSwHealth(*swInvActivation);
 }
 
 /**
- * @brief Updates programmable status of input swId into json response
+ * @brief Updates programmable status of input image into json response
  *
  * This function checks whether software inventory component
  * can be programmable or not and fill's the "Updatable"
  * Property.
  *
  * @param[i,o] asyncResp  Async response object
- * @param[i]   swId       The software ID
+ * @param[i]   inventory  The software inventory the image belongs to
+ * @param[i]   path       The object path of the software image
  */
 inline void
     getSwUpdatableStatus(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-                         const std::shared_ptr<std::string>& swId)
+                         const SoftwareInventory& inventory,
+                         const std::string& path)
 {
-    sdbusplus::asio::getProperty<std::vector<std::string>>(
-        *crow::connections::systemBus, "xyz.openbmc_project.ObjectMapper",
-        "/xyz/openbmc_project/software/updateable",
-        "xyz.openbmc_project.Association", "endpoints",
-        [asyncResp, swId](const boost::system::error_code ec,
-                          const std::vector<std::string>& objPaths) {
-        if (ec)
-        {
-            BMCWEB_LOG_DEBUG << " error_code = " << ec
-                             << " error msg =  " << ec.message();
-            // System can exist with no updateable software,
-            // so don't throw error here.
-            return;
-        }
-        std::string reqSwObjPath = "/xyz/openbmc_project/software/" + *swId;
-
-        if (std::find(objPaths.begin(), objPaths.end(), reqSwObjPath) !=
-            objPaths.end())
-        {
-            asyncResp->res.jsonValue["Updateable"] = true;
-            return;
-        }
-    });
+    if (std::find(inventory.updateable.begin(), inventory.updateable.end(),
+                  path) != inventory.updateable.end())
+    {
+        asyncResp->res.jsonValue["Updateable"] = true;
+    }
 }
 
 } // namespace sw_util
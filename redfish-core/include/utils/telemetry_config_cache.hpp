@@ -0,0 +1,366 @@
+#pragma once
+
+#include "async_resp.hpp"
+#include "dbus_singleton.hpp"
+#include "dbus_utility.hpp"
+#include "error_messages.hpp"
+#include "human_sort.hpp"
+#include "logging.hpp"
+#include "utility.hpp"
+#include "utils/telemetry_utils.hpp"
+
+#include <boost/asio/post.hpp>
+#include <nlohmann/json.hpp>
+#include <sdbusplus/asio/connection.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace redfish
+{
+namespace telemetry
+{
+
+constexpr const char* reportsRoot = "/xyz/openbmc_project/Telemetry/Reports";
+constexpr const char* triggersRoot = "/xyz/openbmc_project/Telemetry/Triggers";
+// The objects under these are the ones Redfish exposes
+constexpr const char* reportsParent =
+    "/xyz/openbmc_project/Telemetry/Reports/TelemetryService";
+constexpr const char* triggersParent =
+    "/xyz/openbmc_project/Telemetry/Triggers/TelemetryService";
+
+/**
+ * @brief The MetricReportDefinitions and Triggers of the telemetry service,
+ * rendered from one GetManagedObjects of each of its managers.
+ */
+struct TelemetryConfig
+{
+    // Resources keyed by id, in collection order.  An object that couldn't
+    // be rendered is kept as nullopt, so it's still listed.
+    using Resources = std::map<std::string, std::optional<nlohmann::json>,
+                               AlphanumLess<std::string>>;
+
+    Resources reports;
+    Resources triggers;
+};
+
+/**
+ * @brief The last TelemetryConfig read.
+ *
+ * Reports and triggers are read and rendered on first use, then handed to
+ * every request until the telemetry service adds, removes or changes one of
+ * them, or changes owner.  Reports emit PropertiesChanged for their Readings
+ * on every update, which doesn't change their definition and so is ignored.
+ * Concurrent reads share one fetch, and a fetch in flight during a change
+ * isn't kept.
+ *
+ * The renderers are set by the routes that own the resources.
+ */
+class TelemetryConfigCache
+{
+  public:
+    using Callback =
+        std::function<void(const boost::system::error_code&,
+                           const std::shared_ptr<const TelemetryConfig>&)>;
+    using ReportRenderer = std::function<std::optional<nlohmann::json>(
+        const std::string&, const dbus::utility::DBusPropertiesMap&)>;
+    using TriggerRenderer = std::function<std::optional<nlohmann::json>(
+        const std::string&, const TriggerPropertiesMap&)>;
+
+    static TelemetryConfigCache& getInstance()
+    {
+        static TelemetryConfigCache cache;
+        return cache;
+    }
+
+    TelemetryConfigCache(const TelemetryConfigCache&) = delete;
+    TelemetryConfigCache(TelemetryConfigCache&&) = delete;
+    TelemetryConfigCache& operator=(const TelemetryConfigCache&) = delete;
+    TelemetryConfigCache& operator=(TelemetryConfigCache&&) = delete;
+    ~TelemetryConfigCache() = default;
+
+    void setReportRenderer(ReportRenderer&& renderer)
+    {
+        renderReport = std::move(renderer);
+        clear();
+    }
+
+    void setTriggerRenderer(TriggerRenderer&& renderer)
+    {
+        renderTrigger = std::move(renderer);
+        clear();
+    }
+
+    void registerMatches(sdbusplus::asio::connection& conn)
+    {
+        namespace rules = sdbusplus::bus::match::rules;
+        const std::string telemetryRoot = "/xyz/openbmc_project/Telemetry";
+
+        matches.clear();
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn,
+            rules::interfacesAdded() + rules::sender(service) +
+                rules::path_namespace(telemetryRoot),
+            [this](sdbusplus::message_t& /*msg*/) { clear(); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn,
+            rules::interfacesRemoved() + rules::sender(service) +
+                rules::path_namespace(telemetryRoot),
+            [this](sdbusplus::message_t& /*msg*/) { clear(); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn,
+            rules::propertiesChanged() + rules::sender(service) +
+                rules::path_namespace(telemetryRoot),
+            [this](sdbusplus::message_t& msg) {
+            if (changesDefinition(msg))
+            {
+                clear();
+            }
+        }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::nameOwnerChanged() + rules::argN(0, service),
+            [this](sdbusplus::message_t& /*msg*/) { clear(); }));
+        clear();
+    }
+
+    bool enabled() const
+    {
+        return !matches.empty() && renderReport && renderTrigger;
+    }
+
+    /**
+     * @brief Calls callback with the reports and triggers, reading them if
+     * they aren't cached.  The callback is never called inline.
+     */
+    void get(Callback&& callback)
+    {
+        if (config)
+        {
+            std::shared_ptr<const TelemetryConfig> current = config;
+            boost::asio::post(crow::connections::systemBus->get_io_context(),
+                              [current, callback{std::move(callback)}]() {
+                callback(boost::system::error_code(), current);
+            });
+            return;
+        }
+
+        callbacks.emplace_back(std::move(callback));
+        if (callbacks.size() > 1)
+        {
+            return;
+        }
+        crow::dbus_trace::SharedCallScope sharedCalls;
+        auto fetch = std::make_shared<Fetch>(*this, generation);
+        crow::connections::systemBus->async_method_call(
+            [fetch](const boost::system::error_code& ec,
+                    const dbus::utility::ManagedObjectType& objects) {
+            if (fetch->failed(ec))
+            {
+                return;
+            }
+            fetch->reports = objects;
+        },
+            service, reportsRoot, "org.freedesktop.DBus.ObjectManager",
+            "GetManagedObjects");
+        crow::connections::systemBus->async_method_call(
+            [fetch](const boost::system::error_code& ec,
+                    const TriggerManagedObjects& objects) {
+            if (fetch->failed(ec))
+            {
+                return;
+            }
+            fetch->triggers = objects;
+        },
+            service, triggersRoot, "org.freedesktop.DBus.ObjectManager",
+            "GetManagedObjects");
+    }
+
+    void clear()
+    {
+        config.reset();
+        generation++;
+    }
+
+  private:
+    using TriggerManagedObjects = std::vector<
+        std::pair<sdbusplus::message::object_path,
+                  std::vector<std::pair<std::string, TriggerPropertiesMap>>>>;
+
+    // Collects both replies, and completes once neither is pending
+    struct Fetch
+    {
+        Fetch(TelemetryConfigCache& cacheIn, uint64_t fetchGenerationIn) :
+            cache(cacheIn), fetchGeneration(fetchGenerationIn)
+        {}
+
+        ~Fetch()
+        {
+            cache.complete(fetchGeneration, ec, *this);
+        }
+
+        Fetch(const Fetch&) = delete;
+        Fetch(Fetch&&) = delete;
+        Fetch& operator=(const Fetch&) = delete;
+        Fetch& operator=(Fetch&&) = delete;
+
+        // Records ec, unless it only means the service isn't running, in
+        // which case it has nothing to read
+        bool failed(const boost::system::error_code& replyEc)
+        {
+            if (!replyEc)
+            {
+                return false;
+            }
+            if (replyEc.value() != EBADR &&
+                replyEc != boost::system::errc::host_unreachable)
+            {
+                BMCWEB_LOG_ERROR << "D-Bus response error on GetManagedObjects "
+                                 << replyEc;
+                ec = replyEc;
+            }
+            return true;
+        }
+
+        TelemetryConfigCache& cache;
+        uint64_t fetchGeneration;
+        boost::system::error_code ec;
+        dbus::utility::ManagedObjectType reports;
+        TriggerManagedObjects triggers;
+    };
+
+    TelemetryConfigCache() = default;
+
+    // Only the Readings of a report change on their own; anything else, or a
+    // signal that can't be read, is taken as a change
+    static bool changesDefinition(sdbusplus::message_t& msg)
+    {
+        std::string interface;
+        dbus::utility::DBusPropertiesMap changed;
+        std::vector<std::string> invalidated;
+        try
+        {
+            msg.read(interface);
+            if (interface != reportInterface)
+            {
+                return true;
+            }
+            msg.read(changed, invalidated);
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            BMCWEB_LOG_ERROR << "Failed to read telemetry signal: " << e.what();
+            return true;
+        }
+        return !invalidated.empty() ||
+               !std::all_of(changed.begin(), changed.end(),
+                            [](const auto& property) {
+            return property.first == "Readings";
+        });
+    }
+
+    // Renders the objects under parent, by their last path segment
+    template <typename Objects, typename Renderer>
+    static void render(const Objects& objects, const std::string& parent,
+                       const char* interface, const Renderer& renderer,
+                       TelemetryConfig::Resources& resources)
+    {
+        for (const auto& [path, interfaces] : objects)
+        {
+            if (path.parent_path().str != parent)
+            {
+                continue;
+            }
+            const std::string id = path.filename();
+            for (const auto& [name, properties] : interfaces)
+            {
+                if (name == interface)
+                {
+                    resources.insert_or_assign(id, renderer(id, properties));
+                    break;
+                }
+            }
+        }
+    }
+
+    void complete(uint64_t fetchGeneration, const boost::system::error_code& ec,
+                  const Fetch& fetch)
+    {
+        std::vector<Callback> waiting = std::move(callbacks);
+        callbacks.clear();
+
+        std::shared_ptr<const TelemetryConfig> read;
+        if (!ec && enabled())
+        {
+            auto rendered = std::make_shared<TelemetryConfig>();
+            render(fetch.reports, reportsParent, reportInterface, renderReport,
+                   rendered->reports);
+            render(fetch.triggers, triggersParent, triggerInterface,
+                   renderTrigger, rendered->triggers);
+            read = rendered;
+        }
+        if (read != nullptr && fetchGeneration == generation)
+        {
+            config = read;
+        }
+        for (Callback& callback : waiting)
+        {
+            callback(ec, read);
+        }
+    }
+
+    ReportRenderer renderReport;
+    TriggerRenderer renderTrigger;
+    std::shared_ptr<const TelemetryConfig> config;
+    std::vector<Callback> callbacks;
+    uint64_t generation = 0;
+    std::vector<std::unique_ptr<sdbusplus::bus::match_t>> matches;
+};
+
+// Lists resources as the Members of the TelemetryService collection
+inline void fillResourceMembers(nlohmann::json& json,
+                                const TelemetryConfig::Resources& resources,
+                                std::string_view collection)
+{
+    nlohmann::json::array_t members;
+    for (const auto& resource : resources)
+    {
+        nlohmann::json::object_t member;
+        member["@odata.id"] = crow::utility::urlFromPieces(
+            "redfish", "v1", "TelemetryService", collection, resource.first);
+        members.emplace_back(std::move(member));
+    }
+    json["Members@odata.count"] = members.size();
+    json["Members"] = std::move(members);
+}
+
+inline void fillResource(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+                         const TelemetryConfig::Resources& resources,
+                         std::string_view resourceName, const std::string& id)
+{
+    auto resource = resources.find(id);
+    if (resource == resources.end())
+    {
+        messages::resourceNotFound(asyncResp->res, resourceName, id);
+        return;
+    }
+    if (!resource->second)
+    {
+        messages::internalError(asyncResp->res);
+        return;
+    }
+    asyncResp->res.jsonValue.update(*resource->second);
+}
+
+} // namespace telemetry
+} // namespace redfish
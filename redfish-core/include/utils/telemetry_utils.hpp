@@ -12,6 +12,31 @@ constexpr const char* service = "xyz.openbmc_project.Telemetry";
 constexpr const char* reportInterface = "xyz.openbmc_project.Telemetry.Report";
 constexpr const char* metricDefinitionUri =
     "/redfish/v1/TelemetryService/MetricDefinitions/";
+
+constexpr const char* triggerInterface =
+    "xyz.openbmc_project.Telemetry.Trigger";
+
+using NumericThresholdParams =
+    std::tuple<std::string, uint64_t, std::string, double>;
+
+using DiscreteThresholdParams =
+    std::tuple<std::string, std::string, uint64_t, std::string>;
+
+using TriggerThresholdParamsExt =
+    std::variant<std::monostate, std::vector<NumericThresholdParams>,
+                 std::vector<DiscreteThresholdParams>>;
+
+using TriggerSensorsParams =
+    std::vector<std::pair<sdbusplus::message::object_path, std::string>>;
+
+using TriggerGetParamsVariant =
+    std::variant<std::monostate, bool, std::string, TriggerThresholdParamsExt,
+                 TriggerSensorsParams, std::vector<std::string>,
+                 std::vector<sdbusplus::message::object_path>>;
+
+using TriggerPropertiesMap =
+    std::vector<std::pair<std::string, TriggerGetParamsVariant>>;
+
 inline std::string getDbusReportPath(const std::string& id)
 {
     sdbusplus::message::object_path reportsPath(
@@ -3,6 +3,7 @@
 #include "logging.hpp"
 
 #include <algorithm>
+#include <array>
 #include <charconv>
 #include <chrono>
 #include <cmath>
@@ -14,6 +15,7 @@
 #include <string>
 #include <string_view>
 #include <system_error>
+#include <tuple>
 
 // IWYU pragma: no_include <stddef.h>
 // IWYU pragma: no_include <stdint.h>
@@ -270,6 +272,34 @@ constexpr std::tuple<IntType, unsigned, unsigned>
     return std::tuple<IntType, unsigned, unsigned>(y + (m <= 2), m, d);
 }
 
+// Inverse of civilFromDays: the number of days since 1970-01-01 of the given
+// date.  Algorithm sourced from
+// https://howardhinnant.github.io/date_algorithms.html#days_from_civil
+template <class IntType>
+constexpr IntType daysFromCivil(IntType y, unsigned m, unsigned d) noexcept
+{
+    y -= static_cast<IntType>(m <= 2);
+    IntType era = (y >= 0 ? y : y - 399) / 400;
+    unsigned yoe = static_cast<unsigned>(y - era * 400);            // [0, 399]
+    unsigned doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1; // [0, 365]
+    unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy; // [0, 146096]
+    return era * 146097 + static_cast<IntType>(doe) - 719468;
+}
+
+constexpr std::array<std::string_view, 7> httpWeekdays = {
+    "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+constexpr std::array<std::string_view, 12> httpMonths = {
+    "Jan", "Feb", "Mar", "Apr", "May", "Jun",
+    "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+
+// Reads the unsigned decimal number that makes up all of field
+inline bool parseHttpDateField(std::string_view field, unsigned& out)
+{
+    const char* end = field.data() + field.size();
+    auto [ptr, ec] = std::from_chars(field.data(), end, out);
+    return ec == std::errc() && ptr == end;
+}
+
 template <typename IntType, typename Period>
 std::string toISO8061ExtendedStr(std::chrono::duration<IntType, Period> t)
 {
@@ -386,6 +416,163 @@ inline std::string getDateTimeStdtime(std::time_t secondsSinceEpoch)
     return details::toISO8061ExtendedStr(sinceEpoch);
 }
 
+// Returns the formatted HTTP-date, as sent in Last-Modified, such as
+// "Sun, 06 Nov 1994 08:49:37 GMT"
+inline std::string getHttpDate(uint64_t secondsSinceEpoch)
+{
+    constexpr uint64_t secondsPerDay = details::dayDuration;
+    uint64_t days = secondsSinceEpoch / secondsPerDay;
+    uint64_t secondsOfDay = secondsSinceEpoch % secondsPerDay;
+    auto [year, month, day] =
+        details::civilFromDays(static_cast<int64_t>(days));
+
+    std::string out;
+    // 1970-01-01 was a Thursday
+    out += details::httpWeekdays[(days + 4) % 7];
+    out += ", ";
+    out += details::padZeros(day, 2);
+    out += ' ';
+    out += details::httpMonths[month - 1];
+    out += ' ';
+    out += details::padZeros(year, 4);
+    out += ' ';
+    out += details::padZeros(static_cast<int64_t>(secondsOfDay / 3600), 2);
+    out += ':';
+    out += details::padZeros(static_cast<int64_t>(secondsOfDay / 60 % 60), 2);
+    out += ':';
+    out += details::padZeros(static_cast<int64_t>(secondsOfDay % 60), 2);
+    out += " GMT";
+    return out;
+}
+
+// Parses an HTTP-date, as received in If-Modified-Since, into seconds since
+// the epoch.  Only the IMF-fixdate form getHttpDate writes is accepted; the
+// obsolete RFC 850 and asctime forms, which clients no longer send, aren't.
+inline std::optional<uint64_t> fromHttpDate(std::string_view date)
+{
+    // "Sun, 06 Nov 1994 08:49:37 GMT"
+    if (date.size() != 29 || date.substr(3, 2) != ", " || date[7] != ' ' ||
+        date[11] != ' ' || date[16] != ' ' || date[19] != ':' ||
+        date[22] != ':' || date.substr(25) != " GMT" ||
+        std::find(details::httpWeekdays.begin(), details::httpWeekdays.end(),
+                  date.substr(0, 3)) == details::httpWeekdays.end())
+    {
+        return std::nullopt;
+    }
+    const auto* monthName = std::find(details::httpMonths.begin(),
+                                      details::httpMonths.end(),
+                                      date.substr(8, 3));
+    unsigned day = 0;
+    unsigned year = 0;
+    unsigned hour = 0;
+    unsigned minute = 0;
+    unsigned second = 0;
+    if (monthName == details::httpMonths.end() ||
+        !details::parseHttpDateField(date.substr(5, 2), day) ||
+        !details::parseHttpDateField(date.substr(12, 4), year) ||
+        !details::parseHttpDateField(date.substr(17, 2), hour) ||
+        !details::parseHttpDateField(date.substr(20, 2), minute) ||
+        !details::parseHttpDateField(date.substr(23, 2), second) ||
+        day < 1 || day > 31 || year < 1970 || hour > 23 || minute > 59 ||
+        second > 60)
+    {
+        return std::nullopt;
+    }
+    unsigned month =
+        static_cast<unsigned>(monthName - details::httpMonths.begin()) + 1;
+    int64_t days = details::daysFromCivil(static_cast<int64_t>(year), month,
+                                          day);
+    constexpr uint64_t secondsPerDay = details::dayDuration;
+    return static_cast<uint64_t>(days) * secondsPerDay + hour * 3600U +
+           minute * 60U + second;
+}
+
+// Parses a Redfish DateTime, such as "2023-05-01T12:00:00.123+00:00" or
+// "2023-05-01T12:00:00Z", into microseconds since the epoch.  Digits beyond
+// microseconds are dropped.
+inline std::optional<int64_t> fromDateTimeString(std::string_view dateTime)
+{
+    // "YYYY-MM-DDTHH:MM:SS"
+    if (dateTime.size() < 20 || dateTime[4] != '-' || dateTime[7] != '-' ||
+        dateTime[10] != 'T' || dateTime[13] != ':' || dateTime[16] != ':')
+    {
+        return std::nullopt;
+    }
+    unsigned year = 0;
+    unsigned month = 0;
+    unsigned day = 0;
+    unsigned hour = 0;
+    unsigned minute = 0;
+    unsigned second = 0;
+    if (!details::parseHttpDateField(dateTime.substr(0, 4), year) ||
+        !details::parseHttpDateField(dateTime.substr(5, 2), month) ||
+        !details::parseHttpDateField(dateTime.substr(8, 2), day) ||
+        !details::parseHttpDateField(dateTime.substr(11, 2), hour) ||
+        !details::parseHttpDateField(dateTime.substr(14, 2), minute) ||
+        !details::parseHttpDateField(dateTime.substr(17, 2), second) ||
+        month < 1 || month > 12 || day < 1 || day > 31 || hour > 23 ||
+        minute > 59 || second > 60)
+    {
+        return std::nullopt;
+    }
+    dateTime.remove_prefix(19);
+
+    int64_t micros = 0;
+    if (dateTime.starts_with('.'))
+    {
+        dateTime.remove_prefix(1);
+        size_t digits = 0;
+        while (digits < dateTime.size() && dateTime[digits] >= '0' &&
+               dateTime[digits] <= '9')
+        {
+            if (digits < 6)
+            {
+                micros = micros * 10 +
+                         static_cast<int64_t>(dateTime[digits] - '0');
+            }
+            digits++;
+        }
+        if (digits == 0)
+        {
+            return std::nullopt;
+        }
+        for (size_t i = digits; i < 6; i++)
+        {
+            micros *= 10;
+        }
+        dateTime.remove_prefix(digits);
+    }
+
+    int64_t offsetSeconds = 0;
+    if (dateTime != "Z")
+    {
+        unsigned offsetHour = 0;
+        unsigned offsetMinute = 0;
+        if (dateTime.size() != 6 ||
+            (dateTime[0] != '+' && dateTime[0] != '-') || dateTime[3] != ':' ||
+            !details::parseHttpDateField(dateTime.substr(1, 2), offsetHour) ||
+            !details::parseHttpDateField(dateTime.substr(4, 2),
+                                         offsetMinute) ||
+            offsetHour > 23 || offsetMinute > 59)
+        {
+            return std::nullopt;
+        }
+        offsetSeconds = static_cast<int64_t>(offsetHour * 3600 +
+                                             offsetMinute * 60);
+        if (dateTime[0] == '-')
+        {
+            offsetSeconds = -offsetSeconds;
+        }
+    }
+
+    int64_t days = details::daysFromCivil(static_cast<int64_t>(year), month,
+                                          day);
+    int64_t seconds = days * details::dayDuration +
+                      static_cast<int64_t>(hour * 3600 + minute * 60 + second) -
+                      offsetSeconds;
+    return seconds * 1000000 + micros;
+}
+
 /**
  * Returns the current Date, Time & the local Time Offset
  * infromation in a pair
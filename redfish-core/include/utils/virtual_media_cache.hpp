@@ -0,0 +1,183 @@
+#pragma once
+
+#include "dbus_singleton.hpp"
+#include "dbus_utility.hpp"
+#include "logging.hpp"
+
+#include <boost/asio/post.hpp>
+#include <sdbusplus/asio/connection.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace redfish
+{
+namespace vm_utils
+{
+
+constexpr std::string_view rootPath = "/xyz/openbmc_project/VirtualMedia";
+
+/**
+ * @brief The service that owns the virtual media tree, and every object it
+ * exposes there, as returned by one GetManagedObjects.
+ */
+struct VirtualMediaState
+{
+    std::string service;
+    dbus::utility::ManagedObjectType objects;
+};
+
+/**
+ * @brief The last VirtualMediaState read.
+ *
+ * The service is found through the mapper and its tree read on first use;
+ * then the state is handed to every request until a signal is sent from
+ * within the tree, or the service changes owner, after which it is read
+ * again on next use.  Slot listings and the lookups that precede
+ * InsertMedia and EjectMedia then cost no D-Bus calls at all.  Concurrent
+ * reads share one lookup, and a read that was in flight when a change was
+ * signalled is answered but not kept.
+ */
+class VirtualMediaCache
+{
+  public:
+    using Callback =
+        std::function<void(const boost::system::error_code&,
+                           const std::shared_ptr<const VirtualMediaState>&)>;
+
+    static VirtualMediaCache& getInstance()
+    {
+        static VirtualMediaCache cache;
+        return cache;
+    }
+
+    VirtualMediaCache(const VirtualMediaCache&) = delete;
+    VirtualMediaCache(VirtualMediaCache&&) = delete;
+    VirtualMediaCache& operator=(const VirtualMediaCache&) = delete;
+    VirtualMediaCache& operator=(VirtualMediaCache&&) = delete;
+    ~VirtualMediaCache() = default;
+
+    void registerMatches(sdbusplus::asio::connection& conn)
+    {
+        namespace rules = sdbusplus::bus::match::rules;
+
+        // Mount and Unmount change properties within the tree; slots come
+        // and go through InterfacesAdded and InterfacesRemoved, which are
+        // sent from the tree too
+        std::string root(rootPath);
+        matches.clear();
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::type::signal() + rules::path_namespace(root),
+            [this](sdbusplus::message_t& /*msg*/) { clear(); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::nameOwnerChanged(), [this](sdbusplus::message_t& msg) {
+            std::string name;
+            msg.read(name);
+            if (state && name == state->service)
+            {
+                clear();
+            }
+        }));
+        clear();
+    }
+
+    bool enabled() const
+    {
+        return !matches.empty();
+    }
+
+    /**
+     * @brief Calls callback with the virtual media state, reading it if it
+     * isn't cached.  The callback is never called inline.
+     */
+    void get(Callback&& callback)
+    {
+        if (state)
+        {
+            std::shared_ptr<const VirtualMediaState> current = state;
+            boost::asio::post(crow::connections::systemBus->get_io_context(),
+                              [current, callback{std::move(callback)}]() {
+                callback(boost::system::error_code(), current);
+            });
+            return;
+        }
+
+        callbacks.emplace_back(std::move(callback));
+        if (callbacks.size() > 1)
+        {
+            return;
+        }
+        crow::dbus_trace::SharedCallScope sharedCalls;
+        dbus::utility::getDbusObject(
+            std::string(rootPath), {},
+            [this, fetchGeneration{generation}](
+                const boost::system::error_code& ec,
+                const dbus::utility::MapperGetObject& object) {
+            if (ec || object.empty())
+            {
+                BMCWEB_LOG_ERROR << "ObjectMapper::GetObject call failed: "
+                                 << ec;
+                complete(fetchGeneration, ec, nullptr);
+                return;
+            }
+            std::string service = object.begin()->first;
+            BMCWEB_LOG_DEBUG << "GetObjectType: " << service;
+            crow::connections::systemBus->async_method_call(
+                [this, fetchGeneration,
+                 service](const boost::system::error_code& ec2,
+                          dbus::utility::ManagedObjectType& objects) {
+                if (ec2)
+                {
+                    BMCWEB_LOG_DEBUG << "DBUS response error " << ec2;
+                    complete(fetchGeneration, ec2, nullptr);
+                    return;
+                }
+                complete(fetchGeneration, ec2,
+                         std::make_shared<const VirtualMediaState>(
+                             VirtualMediaState{service, std::move(objects)}));
+            },
+                service, std::string(rootPath),
+                "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
+        });
+    }
+
+    void clear()
+    {
+        state.reset();
+        generation++;
+    }
+
+  private:
+    VirtualMediaCache() = default;
+
+    void complete(uint64_t fetchGeneration, const boost::system::error_code& ec,
+                  const std::shared_ptr<const VirtualMediaState>& read)
+    {
+        std::vector<Callback> waiting = std::move(callbacks);
+        callbacks.clear();
+
+        if (read != nullptr && enabled() && fetchGeneration == generation)
+        {
+            state = read;
+        }
+        for (Callback& callback : waiting)
+        {
+            callback(ec, read);
+        }
+    }
+
+    std::shared_ptr<const VirtualMediaState> state;
+    std::vector<Callback> callbacks;
+    uint64_t generation = 0;
+    std::vector<std::unique_ptr<sdbusplus::bus::match_t>> matches;
+};
+
+} // namespace vm_utils
+} // namespace redfish
@@ -19,19 +19,27 @@
 #include "registries/privilege_registry.hpp"
 
 #include <app.hpp>
+#include <basic_auth_cache.hpp>
+#include <boost/asio/post.hpp>
 #include <dbus_utility.hpp>
 #include <error_messages.hpp>
 #include <openbmc_dbus_rest.hpp>
+#include <pam_authenticate.hpp>
 #include <persistent_data.hpp>
 #include <query.hpp>
 #include <roles.hpp>
 #include <sdbusplus/asio/property.hpp>
+#include <sdbusplus/bus/match.hpp>
 #include <sdbusplus/unpack_properties.hpp>
 #include <utils/dbus_utils.hpp>
 #include <utils/json_utils.hpp>
 
+#include <array>
+#include <functional>
+#include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace redfish
@@ -616,6 +624,254 @@ inline void handleRoleMapPatch(
     }
 }
 
+/**
+ * @brief Fills confData from the objects of the LDAP config service whose path
+ * contains searchString
+ */
+inline void
+    extractLDAPConfigData(const dbus::utility::ManagedObjectType& ldapObjects,
+                          const std::string& searchString,
+                          LDAPConfigData& confData)
+{
+    std::string ldapEnableInterfaceStr = ldapEnableInterface;
+    std::string ldapConfigInterfaceStr = ldapConfigInterface;
+
+    for (const auto& object : ldapObjects)
+    {
+        // let's find the object whose ldap type is equal to the
+        // given type
+        if (object.first.str.find(searchString) == std::string::npos)
+        {
+            continue;
+        }
+
+        for (const auto& interface : object.second)
+        {
+            if (interface.first == ldapEnableInterfaceStr)
+            {
+                // rest of the properties are string.
+                for (const auto& property : interface.second)
+                {
+                    if (property.first == "Enabled")
+                    {
+                        const bool* value = std::get_if<bool>(&property.second);
+                        if (value == nullptr)
+                        {
+                            continue;
+                        }
+                        confData.serviceEnabled = *value;
+                        break;
+                    }
+                }
+            }
+            else if (interface.first == ldapConfigInterfaceStr)
+            {
+                for (const auto& property : interface.second)
+                {
+                    const std::string* strValue =
+                        std::get_if<std::string>(&property.second);
+                    if (strValue == nullptr)
+                    {
+                        continue;
+                    }
+                    if (property.first == "LDAPServerURI")
+                    {
+                        confData.uri = *strValue;
+                    }
+                    else if (property.first == "LDAPBindDN")
+                    {
+                        confData.bindDN = *strValue;
+                    }
+                    else if (property.first == "LDAPBaseDN")
+                    {
+                        confData.baseDN = *strValue;
+                    }
+                    else if (property.first == "LDAPSearchScope")
+                    {
+                        confData.searchScope = *strValue;
+                    }
+                    else if (property.first == "GroupNameAttribute")
+                    {
+                        confData.groupAttribute = *strValue;
+                    }
+                    else if (property.first == "UserNameAttribute")
+                    {
+                        confData.userNameAttribute = *strValue;
+                    }
+                    else if (property.first == "LDAPType")
+                    {
+                        confData.serverType = *strValue;
+                    }
+                }
+            }
+            else if (interface.first ==
+                     "xyz.openbmc_project.User.PrivilegeMapperEntry")
+            {
+                LDAPRoleMapData roleMapData{};
+                for (const auto& property : interface.second)
+                {
+                    const std::string* strValue =
+                        std::get_if<std::string>(&property.second);
+
+                    if (strValue == nullptr)
+                    {
+                        continue;
+                    }
+
+                    if (property.first == "GroupName")
+                    {
+                        roleMapData.groupName = *strValue;
+                    }
+                    else if (property.first == "Privilege")
+                    {
+                        roleMapData.privilege = *strValue;
+                    }
+                }
+
+                confData.groupRoleList.emplace_back(object.first.str,
+                                                    roleMapData);
+            }
+        }
+    }
+}
+
+/**
+ * @brief The configuration of both directory services, with their role
+ * mappings, as read from one GetManagedObjects of the LDAP config service
+ */
+struct LDAPConfigs
+{
+    explicit LDAPConfigs(const dbus::utility::ManagedObjectType& ldapObjects)
+    {
+        extractLDAPConfigData(ldapObjects, "openldap", ldap);
+        extractLDAPConfigData(ldapObjects, "active_directory",
+                              activeDirectory);
+    }
+
+    LDAPConfigData ldap;
+    LDAPConfigData activeDirectory;
+};
+
+/**
+ * @brief The last LDAPConfigs read from the LDAP config service.
+ *
+ * The configuration is read on first use and handed to every request until
+ * the service signals a change under /xyz/openbmc_project/user/ldap, config
+ * and role mapping changes included, or changes owner.  Concurrent reads
+ * share one call, and a read in flight during a change isn't kept.
+ */
+class LDAPConfigCache
+{
+  public:
+    using Callback =
+        std::function<void(const boost::system::error_code&,
+                           const std::shared_ptr<const LDAPConfigs>&)>;
+
+    static LDAPConfigCache& getInstance()
+    {
+        static LDAPConfigCache cache;
+        return cache;
+    }
+
+    LDAPConfigCache(const LDAPConfigCache&) = delete;
+    LDAPConfigCache(LDAPConfigCache&&) = delete;
+    LDAPConfigCache& operator=(const LDAPConfigCache&) = delete;
+    LDAPConfigCache& operator=(LDAPConfigCache&&) = delete;
+    ~LDAPConfigCache() = default;
+
+    void registerMatches(sdbusplus::asio::connection& conn)
+    {
+        namespace rules = sdbusplus::bus::match::rules;
+
+        matches.clear();
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn,
+            rules::type::signal() + rules::sender(ldapDbusService) +
+                rules::path_namespace(ldapRootObject),
+            [this](sdbusplus::message_t& /*msg*/) { clear(); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::nameOwnerChanged() + rules::argN(0, ldapDbusService),
+            [this](sdbusplus::message_t& /*msg*/) { clear(); }));
+        clear();
+    }
+
+    bool enabled() const
+    {
+        return !matches.empty();
+    }
+
+    /**
+     * @brief Calls callback with the configuration service holds, reading it
+     * if it isn't cached.  The callback is never called inline.
+     */
+    void get(const std::string& service, Callback&& callback)
+    {
+        if (configs && configsService == service)
+        {
+            std::shared_ptr<const LDAPConfigs> current = configs;
+            boost::asio::post(crow::connections::systemBus->get_io_context(),
+                              [current, callback{std::move(callback)}]() {
+                callback(boost::system::error_code(), current);
+            });
+            return;
+        }
+
+        callbacks.emplace_back(std::move(callback));
+        if (callbacks.size() > 1)
+        {
+            return;
+        }
+        crow::dbus_trace::SharedCallScope sharedCalls;
+        crow::connections::systemBus->async_method_call(
+            [this, service, fetchGeneration{generation}](
+                const boost::system::error_code& ec,
+                const dbus::utility::ManagedObjectType& ldapObjects) {
+            afterGetManagedObjects(service, fetchGeneration, ec, ldapObjects);
+        },
+            service, ldapRootObject, dbusObjManagerIntf, "GetManagedObjects");
+    }
+
+    void clear()
+    {
+        configs.reset();
+        configsService.clear();
+        generation++;
+    }
+
+  private:
+    LDAPConfigCache() = default;
+
+    void afterGetManagedObjects(
+        const std::string& service, uint64_t fetchGeneration,
+        const boost::system::error_code& ec,
+        const dbus::utility::ManagedObjectType& ldapObjects)
+    {
+        std::vector<Callback> waiting = std::move(callbacks);
+        callbacks.clear();
+
+        std::shared_ptr<const LDAPConfigs> read;
+        if (!ec)
+        {
+            read = std::make_shared<const LDAPConfigs>(ldapObjects);
+            if (enabled() && fetchGeneration == generation)
+            {
+                configs = read;
+                configsService = service;
+            }
+        }
+        for (Callback& callback : waiting)
+        {
+            callback(ec, read);
+        }
+    }
+
+    std::shared_ptr<const LDAPConfigs> configs;
+    std::string configsService;
+    std::vector<Callback> callbacks;
+    uint64_t generation = 0;
+    std::vector<std::unique_ptr<sdbusplus::bus::match_t>> matches;
+};
+
 /**
  * Function that retrieves all properties for LDAP config object
  * into JSON
@@ -624,11 +880,12 @@ template <typename CallbackFunc>
 inline void getLDAPConfigData(const std::string& ldapType,
                               CallbackFunc&& callback)
 {
-    const std::array<const char*, 2> interfaces = {ldapEnableInterface,
-                                                   ldapConfigInterface};
+    constexpr std::array<std::string_view, 2> interfaces = {
+        ldapEnableInterface, ldapConfigInterface};
 
-    crow::connections::systemBus->async_method_call(
-        [callback, ldapType](const boost::system::error_code ec,
+    dbus::utility::getDbusObject(
+        ldapConfigObjectName, interfaces,
+        [callback, ldapType](const boost::system::error_code& ec,
                              const dbus::utility::MapperGetObject& resp) {
         if (ec || resp.empty())
         {
@@ -639,148 +896,36 @@ inline void getLDAPConfigData(const std::string& ldapType,
             return;
         }
         std::string service = resp.begin()->first;
-        crow::connections::systemBus->async_method_call(
-            [callback,
-             ldapType](const boost::system::error_code errorCode,
-                       const dbus::utility::ManagedObjectType& ldapObjects) {
-            LDAPConfigData confData{};
-            if (errorCode)
+        LDAPConfigCache::getInstance().get(
+            service,
+            [callback, ldapType](
+                const boost::system::error_code& errorCode,
+                const std::shared_ptr<const LDAPConfigs>& configs) {
+            if (errorCode || configs == nullptr)
             {
+                LDAPConfigData confData{};
                 callback(false, confData, ldapType);
                 BMCWEB_LOG_ERROR << "D-Bus responses error: " << errorCode;
                 return;
             }
 
-            std::string ldapDbusType;
-            std::string searchString;
-
             if (ldapType == "LDAP")
             {
-                ldapDbusType =
-                    "xyz.openbmc_project.User.Ldap.Config.Type.OpenLdap";
-                searchString = "openldap";
+                callback(true, configs->ldap, ldapType);
             }
             else if (ldapType == "ActiveDirectory")
             {
-                ldapDbusType =
-                    "xyz.openbmc_project.User.Ldap.Config.Type.ActiveDirectory";
-                searchString = "active_directory";
+                callback(true, configs->activeDirectory, ldapType);
             }
             else
             {
                 BMCWEB_LOG_ERROR << "Can't get the DbusType for the given type="
                                  << ldapType;
+                LDAPConfigData confData{};
                 callback(false, confData, ldapType);
-                return;
-            }
-
-            std::string ldapEnableInterfaceStr = ldapEnableInterface;
-            std::string ldapConfigInterfaceStr = ldapConfigInterface;
-
-            for (const auto& object : ldapObjects)
-            {
-                // let's find the object whose ldap type is equal to the
-                // given type
-                if (object.first.str.find(searchString) == std::string::npos)
-                {
-                    continue;
-                }
-
-                for (const auto& interface : object.second)
-                {
-                    if (interface.first == ldapEnableInterfaceStr)
-                    {
-                        // rest of the properties are string.
-                        for (const auto& property : interface.second)
-                        {
-                            if (property.first == "Enabled")
-                            {
-                                const bool* value =
-                                    std::get_if<bool>(&property.second);
-                                if (value == nullptr)
-                                {
-                                    continue;
-                                }
-                                confData.serviceEnabled = *value;
-                                break;
-                            }
-                        }
-                    }
-                    else if (interface.first == ldapConfigInterfaceStr)
-                    {
-                        for (const auto& property : interface.second)
-                        {
-                            const std::string* strValue =
-                                std::get_if<std::string>(&property.second);
-                            if (strValue == nullptr)
-                            {
-                                continue;
-                            }
-                            if (property.first == "LDAPServerURI")
-                            {
-                                confData.uri = *strValue;
-                            }
-                            else if (property.first == "LDAPBindDN")
-                            {
-                                confData.bindDN = *strValue;
-                            }
-                            else if (property.first == "LDAPBaseDN")
-                            {
-                                confData.baseDN = *strValue;
-                            }
-                            else if (property.first == "LDAPSearchScope")
-                            {
-                                confData.searchScope = *strValue;
-                            }
-                            else if (property.first == "GroupNameAttribute")
-                            {
-                                confData.groupAttribute = *strValue;
-                            }
-                            else if (property.first == "UserNameAttribute")
-                            {
-                                confData.userNameAttribute = *strValue;
-                            }
-                            else if (property.first == "LDAPType")
-                            {
-                                confData.serverType = *strValue;
-                            }
-                        }
-                    }
-                    else if (interface.first ==
-                             "xyz.openbmc_project.User.PrivilegeMapperEntry")
-                    {
-                        LDAPRoleMapData roleMapData{};
-                        for (const auto& property : interface.second)
-                        {
-                            const std::string* strValue =
-                                std::get_if<std::string>(&property.second);
-
-                            if (strValue == nullptr)
-                            {
-                                continue;
-                            }
-
-                            if (property.first == "GroupName")
-                            {
-                                roleMapData.groupName = *strValue;
-                            }
-                            else if (property.first == "Privilege")
-                            {
-                                roleMapData.privilege = *strValue;
-                            }
-                        }
-
-                        confData.groupRoleList.emplace_back(object.first.str,
-                                                            roleMapData);
-                    }
-                }
             }
-            callback(true, confData, ldapType);
-        },
-            service, ldapRootObject, dbusObjManagerIntf, "GetManagedObjects");
-    },
-        mapperBusName, mapperObjectPath, mapperIntf, "GetObject",
-        ldapConfigObjectName, interfaces);
+        });
+    });
 }
 
 /**
@@ -1275,7 +1420,7 @@ inline void
 
     // Make a copy of methods configuration
     persistent_data::AuthConfigMethods authMethodsConfig =
-        persistent_data::SessionStore::getInstance().getAuthMethodsConfig();
+        *persistent_data::SessionStore::getInstance().getAuthMethodsConfig();
 
     if (basicAuth)
     {
@@ -1560,6 +1705,8 @@ inline void updateUserProperties(
                 // Remove existing sessions of the user when password changed
                 persistent_data::SessionStore::getInstance()
                     .removeSessionsByUsernameExceptSession(username, session);
+                crow::authentication::BasicAuthCache::getInstance().invalidate(
+                    username);
                 messages::success(asyncResp->res);
             }
         }
@@ -1812,8 +1959,9 @@ inline void
                             const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
 {
     handleAccountServiceHead(app, req, asyncResp);
-    const persistent_data::AuthConfigMethods& authMethodsConfig =
-        persistent_data::SessionStore::getInstance().getAuthMethodsConfig();
+    std::shared_ptr<const persistent_data::AuthConfigMethods>
+        authMethodsConfig =
+            persistent_data::SessionStore::getInstance().getAuthMethodsConfig();
 
     nlohmann::json& json = asyncResp->res.jsonValue;
     json["@odata.id"] = "/redfish/v1/AccountService";
@@ -1831,12 +1979,15 @@ inline void
     json["Oem"]["OpenBMC"]["@odata.id"] =
         "/redfish/v1/AccountService#/Oem/OpenBMC";
     json["Oem"]["OpenBMC"]["AuthMethods"]["BasicAuth"] =
-        authMethodsConfig.basic;
+        authMethodsConfig->basic;
     json["Oem"]["OpenBMC"]["AuthMethods"]["SessionToken"] =
-        authMethodsConfig.sessionToken;
-    json["Oem"]["OpenBMC"]["AuthMethods"]["XToken"] = authMethodsConfig.xtoken;
-    json["Oem"]["OpenBMC"]["AuthMethods"]["Cookie"] = authMethodsConfig.cookie;
-    json["Oem"]["OpenBMC"]["AuthMethods"]["TLS"] = authMethodsConfig.tls;
+        authMethodsConfig->sessionToken;
+    json["Oem"]["OpenBMC"]["AuthMethods"]["XToken"] = authMethodsConfig->xtoken;
+    json["Oem"]["OpenBMC"]["AuthMethods"]["Cookie"] = authMethodsConfig->cookie;
+    json["Oem"]["OpenBMC"]["AuthMethods"]["TLS"] = authMethodsConfig->tls;
+    json["Actions"]["Oem"]["#OpenBMCAccountService.v1_0_0.CreateAccounts"]
+        ["target"] = "/redfish/v1/AccountService/Actions/Oem/"
+                     "OpenBMCAccountService.CreateAccounts";
 
     // /redfish/v1/AccountService/LDAP/Certificates is something only
     // ConfigureManager can access then only display when the user has
@@ -1850,10 +2001,10 @@ inline void
         asyncResp->res.jsonValue["LDAP"]["Certificates"]["@odata.id"] =
             "/redfish/v1/AccountService/LDAP/Certificates";
     }
-    sdbusplus::asio::getAllProperties(
-        *crow::connections::systemBus, "xyz.openbmc_project.User.Manager",
-        "/xyz/openbmc_project/user", "xyz.openbmc_project.User.AccountPolicy",
-        [asyncResp](const boost::system::error_code ec,
+    dbus::utility::getAllProperties(
+        "xyz.openbmc_project.User.Manager", "/xyz/openbmc_project/user",
+        "xyz.openbmc_project.User.AccountPolicy",
+        [asyncResp](const boost::system::error_code& ec,
                     const dbus::utility::DBusPropertiesMap& propertiesList) {
         if (ec)
         {
@@ -2103,87 +2254,89 @@ inline void handleAccountCollectionGet(
         "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
 }
 
-inline void handleAccountCollectionPost(
-    App& app, const crow::Request& req,
-    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
+/**
+ * @brief A local account to be created, as given in a POST
+ */
+struct NewAccount
 {
-    if (!redfish::setUpRedfishRoute(app, req, asyncResp))
-    {
-        return;
-    }
     std::string username;
     std::string password;
+    std::string privilege;
+    bool enabled = true;
+};
+
+/**
+ * @brief Reads the properties of a new account from json, checking its role.
+ *
+ * @return false with an error in res if any property is wrong
+ */
+inline bool readNewAccount(nlohmann::json& json, crow::Response& res,
+                           NewAccount& account)
+{
     std::optional<std::string> roleId("User");
     std::optional<bool> enabled = true;
-    if (!json_util::readJsonPatch(req, asyncResp->res, "UserName", username,
-                                  "Password", password, "RoleId", roleId,
-                                  "Enabled", enabled))
+    if (!json_util::readJson(json, res, "UserName", account.username,
+                             "Password", account.password, "RoleId", roleId,
+                             "Enabled", enabled))
     {
-        return;
+        return false;
     }
 
     // Don't allow new accounts to have a Restricted Role.
     if (redfish::isRestrictedRole(*roleId))
     {
-        messages::restrictedRole(asyncResp->res, *roleId);
-        return;
+        messages::restrictedRole(res, *roleId);
+        return false;
     }
 
-    std::string priv = getPrivilegeFromRoleId(*roleId);
-    if (priv.empty())
+    account.privilege = getPrivilegeFromRoleId(*roleId);
+    if (account.privilege.empty())
     {
-        messages::propertyValueNotInList(asyncResp->res, *roleId, "RoleId");
-        return;
+        messages::propertyValueNotInList(res, *roleId, "RoleId");
+        return false;
     }
-    roleId = priv;
+    account.enabled = *enabled;
+    return true;
+}
 
-    // Reading AllGroups property
-    sdbusplus::asio::getProperty<std::vector<std::string>>(
-        *crow::connections::systemBus, "xyz.openbmc_project.User.Manager",
-        "/xyz/openbmc_project/user", "xyz.openbmc_project.User.Manager",
-        "AllGroups",
-        [asyncResp, username, password{std::move(password)}, roleId,
-         enabled](const boost::system::error_code ec,
-                  const std::vector<std::string>& allGroupsList) {
-        if (ec)
-        {
-            BMCWEB_LOG_DEBUG << "ERROR with async_method_call";
-            messages::internalError(asyncResp->res);
-            return;
-        }
+/**
+ * @brief Creates account in the groups of allGroupsList it is allowed, and
+ * sets its password.  The password is set on the worker pool, since PAM
+ * hashes it.
+ */
+inline void createAccount(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+                          const std::vector<std::string>& allGroupsList,
+                          NewAccount&& account)
+{
+    // Create (modified) modGroupsList from allGroupsList.
+    // Remove the ipmi group.  Also Remove "ssh" if the new
+    // user is not an Administrator.
+    std::vector<std::string> modGroupsList;
 
-        if (allGroupsList.empty())
+    for (const auto& group : allGroupsList)
+    {
+        if ((group != "ipmi") &&
+            ((group != "ssh") || (account.privilege == "Administrator")))
         {
-            messages::internalError(asyncResp->res);
-            return;
+            modGroupsList.push_back(group);
         }
+    }
 
-        // Create (modified) modGroupsList from allGroupsList.
-        // Remove the ipmi group.  Also Remove "ssh" if the new
-        // user is not an Administrator.
-        std::vector<std::string> modGroupsList;
-
-        for (const auto& group : allGroupsList)
+    crow::connections::systemBus->async_method_call(
+        [asyncResp, username{account.username},
+         password{std::move(account.password)}](
+            const boost::system::error_code ec, sdbusplus::message_t& m) {
+        if (ec)
         {
-            if ((group != "ipmi") &&
-                ((group != "ssh") || (*roleId == "Administrator")))
-            {
-                modGroupsList.push_back(group);
-            }
+            userErrorMessageHandler(m.get_error(), asyncResp, username, "");
+            return;
         }
 
-        const std::vector<std::string>* pModGroupsList = &modGroupsList;
-
-        crow::connections::systemBus->async_method_call(
-            [asyncResp, username, password](const boost::system::error_code ec2,
-                                            sdbusplus::message_t& m) {
-            if (ec2)
-            {
-                userErrorMessageHandler(m.get_error(), asyncResp, username, "");
-                return;
-            }
-
-            if (pamUpdatePassword(username, password) != PAM_SUCCESS)
+        pamUpdatePasswordAsync(
+            crow::connections::systemBus->get_io_context().get_executor(),
+            username, password,
+            [asyncResp, username, password](int pamrc) {
+            if (pamrc != PAM_SUCCESS)
             {
                 // At this point we have a user that's been
                 // created, but the password set
@@ -2215,10 +2368,186 @@ inline void handleAccountCollectionPost(
             messages::created(asyncResp->res);
             asyncResp->res.addHeader(
                 "Location", "/redfish/v1/AccountService/Accounts/" + username);
-        },
-            "xyz.openbmc_project.User.Manager", "/xyz/openbmc_project/user",
-            "xyz.openbmc_project.User.Manager", "CreateUser", username,
-            *pModGroupsList, *roleId, *enabled);
+        });
+    },
+        "xyz.openbmc_project.User.Manager", "/xyz/openbmc_project/user",
+        "xyz.openbmc_project.User.Manager", "CreateUser", account.username,
+        modGroupsList, account.privilege, account.enabled);
+}
+
+/**
+ * @brief Reads the groups new accounts may be put in
+ */
+inline void getAllGroups(
+    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+    std::function<void(const std::vector<std::string>&)>&& callback)
+{
+    sdbusplus::asio::getProperty<std::vector<std::string>>(
+        *crow::connections::systemBus, "xyz.openbmc_project.User.Manager",
+        "/xyz/openbmc_project/user", "xyz.openbmc_project.User.Manager",
+        "AllGroups",
+        [asyncResp, callback{std::move(callback)}](
+            const boost::system::error_code ec,
+            const std::vector<std::string>& allGroupsList) {
+        if (ec)
+        {
+            BMCWEB_LOG_DEBUG << "ERROR with async_method_call";
+            messages::internalError(asyncResp->res);
+            return;
+        }
+
+        if (allGroupsList.empty())
+        {
+            messages::internalError(asyncResp->res);
+            return;
+        }
+        callback(allGroupsList);
+    });
+}
+
+inline void handleAccountCollectionPost(
+    App& app, const crow::Request& req,
+    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
+{
+    if (!redfish::setUpRedfishRoute(app, req, asyncResp))
+    {
+        return;
+    }
+    std::optional<nlohmann::json> json =
+        json_util::readJsonPatchHelper(req, asyncResp->res);
+    if (!json)
+    {
+        return;
+    }
+    NewAccount account;
+    if (!readNewAccount(*json, asyncResp->res, account))
+    {
+        return;
+    }
+
+    getAllGroups(asyncResp, [asyncResp, account{std::move(account)}](
+                                const std::vector<std::string>&
+                                    allGroupsList) mutable {
+        createAccount(asyncResp, allGroupsList, std::move(account));
+    });
+}
+
+/**
+ * @brief The outcome of each account of a CreateAccounts action.  The action
+ * responds with all of them once the last account is done.
+ */
+class CreateAccountsResults
+{
+  public:
+    CreateAccountsResults(
+        const std::shared_ptr<bmcweb::AsyncResp>& asyncRespIn, size_t count) :
+        asyncResp(asyncRespIn),
+        results(count, nlohmann::json::object())
+    {}
+
+    CreateAccountsResults(const CreateAccountsResults&) = delete;
+    CreateAccountsResults(CreateAccountsResults&&) = delete;
+    CreateAccountsResults& operator=(const CreateAccountsResults&) = delete;
+    CreateAccountsResults& operator=(CreateAccountsResults&&) = delete;
+
+    ~CreateAccountsResults()
+    {
+        asyncResp->res.jsonValue["Accounts"] = std::move(results);
+    }
+
+    /**
+     * @brief Returns a response for account index of the action, which is
+     * recorded as its outcome once it completes
+     */
+    static std::shared_ptr<bmcweb::AsyncResp>
+        itemResponse(const std::shared_ptr<CreateAccountsResults>& self,
+                     size_t index, const std::string& username)
+    {
+        auto itemResp = std::make_shared<bmcweb::AsyncResp>();
+        itemResp->res.setCompleteRequestHandler(
+            [self, index, username](crow::Response& res) {
+            nlohmann::json& result = self->results[index];
+            result["UserName"] = username;
+            result["StatusCode"] = res.resultInt();
+            nlohmann::json::json_pointer errorInfo(
+                "/error/@Message.ExtendedInfo");
+            nlohmann::json::json_pointer info("/@Message.ExtendedInfo");
+            if (res.jsonValue.contains(errorInfo))
+            {
+                result["@Message.ExtendedInfo"] =
+                    std::move(res.jsonValue[errorInfo]);
+            }
+            else if (res.jsonValue.contains(info))
+            {
+                result["@Message.ExtendedInfo"] =
+                    std::move(res.jsonValue[info]);
+            }
+        });
+        return itemResp;
+    }
+
+  private:
+    std::shared_ptr<bmcweb::AsyncResp> asyncResp;
+    nlohmann::json::array_t results;
+};
+
+/**
+ * @brief Creates every account of the request, reading the groups accounts
+ * may be put in once and issuing all the creates at once.  Each account
+ * succeeds or fails on its own; the response lists the outcome of each, in
+ * request order.
+ */
+inline void handleAccountServiceCreateAccountsPost(
+    App& app, const crow::Request& req,
+    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
+{
+    if (!redfish::setUpRedfishRoute(app, req, asyncResp))
+    {
+        return;
+    }
+    std::vector<nlohmann::json> accounts;
+    if (!json_util::readJsonAction(req, asyncResp->res, "Accounts", accounts))
+    {
+        return;
+    }
+    if (accounts.empty())
+    {
+        messages::propertyValueFormatError(asyncResp->res, "[]", "Accounts");
+        return;
+    }
+
+    getAllGroups(asyncResp, [asyncResp, accounts{std::move(accounts)}](
+                                const std::vector<std::string>&
+                                    allGroupsList) mutable {
+        auto results = std::make_shared<CreateAccountsResults>(
+            asyncResp, accounts.size());
+        for (size_t index = 0; index < accounts.size(); index++)
+        {
+            nlohmann::json& accountJson = accounts[index];
+            std::string username;
+            const std::string* name = nullptr;
+            if (accountJson.is_object())
+            {
+                auto it = accountJson.find("UserName");
+                if (it != accountJson.end())
+                {
+                    name = it->get_ptr<const std::string*>();
+                }
+            }
+            if (name != nullptr)
+            {
+                username = *name;
+            }
+            std::shared_ptr<bmcweb::AsyncResp> itemResp =
+                CreateAccountsResults::itemResponse(results, index, username);
+
+            NewAccount account;
+            if (!readNewAccount(accountJson, itemResp->res, account))
+            {
+                continue;
+            }
+            createAccount(itemResp, allGroupsList, std::move(account));
+        }
     });
 }
 
@@ -2690,6 +3019,12 @@ inline void requestAccountServiceRoutes(App& app)
         .methods(boost::beast::http::verb::patch)(
             std::bind_front(handleAccountServicePatch, std::ref(app)));
 
+    BMCWEB_ROUTE(app, "/redfish/v1/AccountService/Actions/Oem/"
+                      "OpenBMCAccountService.CreateAccounts/")
+        .privileges(redfish::privileges::postManagerAccountCollection)
+        .methods(boost::beast::http::verb::post)(std::bind_front(
+            handleAccountServiceCreateAccountsPost, std::ref(app)));
+
     BMCWEB_ROUTE(app, "/redfish/v1/AccountService/Accounts/")
         .privileges(redfish::privileges::headManagerAccountCollection)
         .methods(boost::beast::http::verb::head)(
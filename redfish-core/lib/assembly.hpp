@@ -3,6 +3,7 @@
 #include "led.hpp"
 
 #include <sdbusplus/unpack_properties.hpp>
+#include <utils/assembly_index.hpp>
 #include <utils/dbus_utils.hpp>
 #include <utils/json_utils.hpp>
 #include <utils/name_utils.hpp>
@@ -14,17 +15,6 @@ namespace redfish
 {
 using VariantType = std::variant<bool, std::string, uint64_t, uint32_t>;
 
-constexpr std::array<const char*, 9> chassisAssemblyIfaces = {
-    "xyz.openbmc_project.Inventory.Item.Vrm",
-    "xyz.openbmc_project.Inventory.Item.Tpm",
-    "xyz.openbmc_project.Inventory.Item.Panel",
-    "xyz.openbmc_project.Inventory.Item.Battery",
-    "xyz.openbmc_project.Inventory.Item.DiskBackplane",
-    "xyz.openbmc_project.Inventory.Item.Board",
-    "xyz.openbmc_project.Inventory.Item.Connector",
-    "xyz.openbmc_project.Inventory.Item.Drive",
-    "xyz.openbmc_project.Inventory.Item.Board.Motherboard"};
-
 static void assembleAssemblyProperties(
     const std::shared_ptr<bmcweb::AsyncResp>& aResp,
     const dbus::utility::DBusPropertiesMap& properties,
@@ -145,11 +135,11 @@ inline void
                 std::array<const char*, 0>{});
         }
 
-        crow::connections::systemBus->async_method_call(
-            [aResp, assemblyIndex, assembly](
-                const boost::system::error_code ec,
-                const std::vector<
-                    std::pair<std::string, std::vector<std::string>>>& object) {
+        dbus::utility::getDbusObject(
+            assembly, assembly_utils::chassisAssemblyIfaces,
+            [aResp, assemblyIndex,
+             assembly](const boost::system::error_code& ec,
+                       const dbus::utility::MapperGetObject& object) {
             if (ec)
             {
                 BMCWEB_LOG_DEBUG << "DBUS response error";
@@ -319,11 +309,7 @@ inline void
                 nlohmann::json& assemblyData = assemblyArray.at(assemblyIndex);
                 assemblyData["LocationIndicatorActive"] = asserted;
             });
-        },
-            "xyz.openbmc_project.ObjectMapper",
-            "/xyz/openbmc_project/object_mapper",
-            "xyz.openbmc_project.ObjectMapper", "GetObject", assembly,
-            chassisAssemblyIfaces);
+        });
 
         assemblyIndex++;
     }
@@ -611,176 +597,8 @@ inline void setAssemblylocationIndicators(
 }
 
 /**
- * @brief Api to check if the assemblies fetched from association Json is also
- * implemented in the system. In case the interface for that assembly is not
- * found update the list and fetch properties for only implemented assemblies.
- * @param[in] aResp - Shared pointer for asynchronous calls.
- * @param[in] chassisPath - Chassis the assemblies are associated with.
- * @param[in] assemblies - list of all the assemblies associated with the
- * chassis.
- * @param[in] setLocationIndicatorActiveFlag - The doPatch flag.
- * @param[in] req - The request data.
- * @return None.
- */
-inline void checkAssemblyInterface(
-    const std::shared_ptr<bmcweb::AsyncResp>& aResp,
-    const std::string& chassisPath, dbus::utility::MapperEndPoints& assemblies,
-    const bool& setLocationIndicatorActiveFlag, const crow::Request& req)
-{
-    crow::connections::systemBus->async_method_call(
-        [aResp, chassisPath, assemblies, setLocationIndicatorActiveFlag, req](
-            const boost::system::error_code ec,
-            const std::vector<std::pair<
-                std::string,
-                std::vector<std::pair<std::string, std::vector<std::string>>>>>&
-                subtree) {
-        if (ec)
-        {
-            BMCWEB_LOG_DEBUG << "D-Bus response error on GetSubTree " << ec;
-            messages::internalError(aResp->res);
-            return;
-        }
-
-        if (subtree.empty())
-        {
-            BMCWEB_LOG_DEBUG << "No object paths found";
-            return;
-        }
-        std::vector<std::string> updatedAssemblyList;
-        for (const auto& [objectPath, serviceName] : subtree)
-        {
-            // This list will store common paths between assemblies fetched
-            // from association json and assemblies which are actually
-            // implemeted. This is to handle the case in which there is
-            // entry in association json but implementation of interface for
-            // that particular assembly is missing.
-            auto it = std::find(assemblies.begin(), assemblies.end(),
-                                objectPath);
-            if (it != assemblies.end())
-            {
-                updatedAssemblyList.emplace(updatedAssemblyList.end(), *it);
-            }
-        }
-
-        if (!updatedAssemblyList.empty())
-        {
-            // sorting is required to facilitate patch as the array does not
-            // store and data which can be mapped back to Dbus path of
-            // assembly.
-            std::sort(updatedAssemblyList.begin(), updatedAssemblyList.end());
-
-            if (setLocationIndicatorActiveFlag)
-            {
-                setAssemblylocationIndicators(aResp, chassisPath,
-                                              updatedAssemblyList, req);
-            }
-            else
-            {
-                getAssemblyProperties(aResp, chassisPath, updatedAssemblyList);
-            }
-        }
-    },
-        "xyz.openbmc_project.ObjectMapper",
-        "/xyz/openbmc_project/object_mapper",
-        "xyz.openbmc_project.ObjectMapper", "GetSubTree",
-        "/xyz/openbmc_project/inventory", int32_t(0), chassisAssemblyIfaces);
-}
-
-/**
- * @brief Api to get assembly endpoints from mapper.
- * @param[in] aResp - Shared pointer for asynchronous calls.
- * @param[in] chassisPath - Chassis to which the assemblies are
- * associated.
- * @param[in] setLocationIndicatorActiveFlag - The doPatch flag.
- * @param[in] req - The request data.
- * @return None.
- */
-inline void
-    getAssemblyEndpoints(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
-                         const std::string& chassisPath,
-                         const bool& setLocationIndicatorActiveFlag,
-                         const crow::Request& req)
-{
-    BMCWEB_LOG_DEBUG << "Get assembly endpoints";
-
-    sdbusplus::message::object_path assemblyPath(chassisPath);
-    assemblyPath /= "assembly";
-
-    // if there is assembly association, look
-    // for endpoints
-    dbus::utility::getAssociationEndPoints(
-        assemblyPath, [aResp, chassisPath, setLocationIndicatorActiveFlag,
-                       req](const boost::system::error_code ec,
-                            const dbus::utility::MapperEndPoints& endpoints) {
-        if (ec)
-        {
-            BMCWEB_LOG_DEBUG << "DBUS response "
-                                "error";
-            messages::internalError(aResp->res);
-            return;
-        }
-
-        dbus::utility::MapperEndPoints sortedAssemblyList = endpoints;
-        std::sort(sortedAssemblyList.begin(), sortedAssemblyList.end());
-
-        checkAssemblyInterface(aResp, chassisPath, sortedAssemblyList,
-                               setLocationIndicatorActiveFlag, req);
-        return;
-    });
-}
-
-/**
- * @brief Api to check for assembly associations.
- * @param[in] aResp - Shared pointer for asynchronous calls.
- * @param[in] chassisPath - Chassis to which the assemblies are
- * associated.
- * @param[in] setLocationIndicatorActiveFlag - The doPatch flag.
- * @param[in] req - The request data.
- * @return None.
- */
-inline void checkForAssemblyAssociations(
-    const std::shared_ptr<bmcweb::AsyncResp>& aResp,
-    const std::string& chassisPath, const std::string& service,
-    const bool& setLocationIndicatorActiveFlag, const crow::Request& req)
-{
-    BMCWEB_LOG_DEBUG << "Check for assembly association";
-
-    dbus::utility::getAssociationList(
-        service, chassisPath,
-        [aResp, chassisPath, setLocationIndicatorActiveFlag,
-         req](const boost::system::error_code ec,
-              const dbus::utility::AssociationList& associations) {
-        if (ec)
-        {
-            BMCWEB_LOG_DEBUG << "DBUS response error";
-            messages::internalError(aResp->res);
-            return;
-        }
-
-        bool isAssmeblyAssociation = false;
-        for (const auto& listOfAssociations : associations)
-        {
-            if (std::get<0>(listOfAssociations) != "assembly")
-            {
-                // implies this is not an assembly
-                // association
-                continue;
-            }
-
-            isAssmeblyAssociation = true;
-            break;
-        }
-
-        if (isAssmeblyAssociation)
-        {
-            getAssemblyEndpoints(aResp, chassisPath,
-                                 setLocationIndicatorActiveFlag, req);
-        }
-    });
-}
-
-/**
- * @brief Api to check if there is any association.
+ * @brief Api to get the assemblies of a chassis and fetch their properties,
+ * or set their location indicators.
  * @param[in] aResp - Shared pointer for asynchronous calls.
  * @param[in] chassisPath - Chassis to which the assemblies are
  * associated.
@@ -810,39 +628,38 @@ inline void checkAssociation(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
         aResp->res.jsonValue["Assemblies@odata.count"] = 0;
     }
 
-    // check if this chassis hosts any association
-    crow::connections::systemBus->async_method_call(
-        [aResp, chassisPath, setLocationIndicatorActiveFlag, req](
-            const boost::system::error_code ec,
-            const std::vector<std::pair<std::string, std::vector<std::string>>>&
-                object) {
+    assembly_utils::AssemblyIndex::getInstance().get(
+        chassisPath,
+        [aResp, chassisPath, setLocationIndicatorActiveFlag,
+         req](const boost::system::error_code& ec,
+              const std::shared_ptr<const assembly_utils::Assemblies>&
+                  assemblies) {
         if (ec)
         {
-            BMCWEB_LOG_DEBUG << "DBUS response error";
+            BMCWEB_LOG_DEBUG << "D-Bus response error on GetSubTree " << ec;
             messages::internalError(aResp->res);
             return;
         }
 
-        for (const auto& [serviceName, interfaceList] : object)
+        // The list is sorted, which the PATCH relies on as the array does
+        // not store any data which can be mapped back to the Dbus path of
+        // the assembly.
+        if (assemblies->empty())
         {
-            for (const auto& interface : interfaceList)
-            {
-                if (interface == "xyz.openbmc_project.Association.Definitions")
-                {
-                    checkForAssemblyAssociations(
-                        aResp, chassisPath, serviceName,
-                        setLocationIndicatorActiveFlag, req);
+            BMCWEB_LOG_DEBUG << "No assemblies found";
+            return;
+        }
 
-                    return;
-                }
-            }
+        if (setLocationIndicatorActiveFlag)
+        {
+            setAssemblylocationIndicators(aResp, chassisPath, *assemblies,
+                                          req);
         }
-        return;
-    },
-        "xyz.openbmc_project.ObjectMapper",
-        "/xyz/openbmc_project/object_mapper",
-        "xyz.openbmc_project.ObjectMapper", "GetObject", chassisPath,
-        std::array<const char*, 0>{});
+        else
+        {
+            getAssemblyProperties(aResp, chassisPath, *assemblies);
+        }
+    });
 }
 
 namespace assembly
@@ -863,11 +680,16 @@ inline void getChassis(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
 {
     BMCWEB_LOG_DEBUG << "Get chassis path";
 
+    constexpr std::array<std::string_view, 1> chassisInterfaces = {
+        assembly_utils::AssemblyIndex::chassisInterface};
+
     // get the chassis path
-    crow::connections::systemBus->async_method_call(
+    dbus::utility::getSubTreePaths(
+        "/xyz/openbmc_project/inventory", 0, chassisInterfaces,
         [aResp, chassisID, setLocationIndicatorActiveFlag,
-         req](const boost::system::error_code ec,
-              const std::vector<std::string>& chassisPaths) {
+         req](const boost::system::error_code& ec,
+              const dbus::utility::MapperGetSubTreePathsResponse&
+                  chassisPaths) {
         if (ec)
         {
             BMCWEB_LOG_DEBUG << "DBUS response error";
@@ -903,13 +725,7 @@ inline void getChassis(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
 
         BMCWEB_LOG_ERROR << "Chassis not found";
         messages::resourceNotFound(aResp->res, "Chassis", chassisID);
-    },
-        "xyz.openbmc_project.ObjectMapper",
-        "/xyz/openbmc_project/object_mapper",
-        "xyz.openbmc_project.ObjectMapper", "GetSubTreePaths",
-        "/xyz/openbmc_project/inventory", 0,
-        std::array<const char*, 1>{
-            "xyz.openbmc_project.Inventory.Item.Chassis"});
+    });
 }
 
 /**
@@ -921,7 +737,6 @@ inline void getChassis(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
  *        for the Redfish Assembly implementation.
  *
  * @param[in] aResp - The redfish response to return.
- * @param[in] assemblyParentServ - The assembly parent dbus service name.
  * @param[in] assemblyParentObjPath - The assembly parent dbus object path.
  * @param[in] assemblyParentIface - The assembly parent dbus interface name
  *                                  to valid the supports in the bmcweb.
@@ -937,7 +752,6 @@ inline void getChassis(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
  */
 inline void fillWithAssemblyId(
     const std::shared_ptr<bmcweb::AsyncResp>& aResp,
-    const std::string& assemblyParentServ,
     const sdbusplus::message::object_path& assemblyParentObjPath,
     const std::string& assemblyParentIface,
     const nlohmann::json::json_pointer& assemblyUriPropPath,
@@ -955,155 +769,77 @@ inline void fillWithAssemblyId(
         return;
     }
 
-    using associationList =
-        std::vector<std::tuple<std::string, std::string, std::string>>;
-
-    sdbusplus::asio::getProperty<associationList>(
-        *crow::connections::systemBus, assemblyParentServ,
+    assembly_utils::AssemblyIndex::getInstance().get(
         assemblyParentObjPath.str,
-        "xyz.openbmc_project.Association.Definitions", "Associations",
         [aResp, assemblyUriPropPath, assemblyParentObjPath, assembledObjPath,
-         assembledUriVal](const boost::system::error_code ec,
-                          const associationList& associations) {
+         assembledUriVal](
+            const boost::system::error_code& ec,
+            const std::shared_ptr<const assembly_utils::Assemblies>&
+                assemblies) {
         if (ec)
         {
-            BMCWEB_LOG_ERROR
-                << "DBUS response error [" << ec.value() << " : "
-                << ec.message() << "] when tried to get the Associations from ["
-                << assemblyParentObjPath.str
-                << "] to fill Assembly id of the assembled object ["
-                << assembledObjPath.str << "]";
+            BMCWEB_LOG_ERROR << "DBUS response error [" << ec.value() << " : "
+                             << ec.message()
+                             << "] when tried to get the subtree to check "
+                             << "assembled objects implementation of the ["
+                             << assemblyParentObjPath.str
+                             << "] to find assembled object id of the ["
+                             << assembledObjPath.str
+                             << "] to fill in the URI property";
             messages::internalError(aResp->res);
             return;
         }
 
-        std::vector<std::string> assemblyAssoc;
-        for (const auto& association : associations)
-        {
-            if (std::get<0>(association) != "assembly")
-            {
-                continue;
-            }
-            assemblyAssoc.emplace_back(std::get<2>(association));
-        }
-
-        if (assemblyAssoc.empty())
+        if (assemblies->empty())
         {
             BMCWEB_LOG_ERROR
-                << "No assembly associations in the ["
-                << assemblyParentObjPath.str
-                << "] to fill Assembly id of the assembled object ["
-                << assembledObjPath.str << "]";
+                << "The assembled objects of the ["
+                << assemblyParentObjPath.str << "] are not implemented so "
+                << "unable to fill the assembled object [ "
+                << assembledObjPath.str << "] id in the URI property";
             messages::internalError(aResp->res);
             return;
         }
 
-        // Mak sure whether the retrieved assembly associations are
-        // implemented before finding the assembly id as per bmcweb
-        // Assembly design.
-        crow::connections::systemBus->async_method_call(
-            [aResp, assemblyUriPropPath, assemblyParentObjPath,
-             assembledObjPath, assemblyAssoc, assembledUriVal](
-                const boost::system::error_code ec1,
-                const std::vector<std::pair<
-                    std::string, std::vector<std::pair<
-                                     std::string, std::vector<std::string>>>>>&
-                    objects) {
-            if (ec1)
-            {
-                BMCWEB_LOG_ERROR << "DBUS response error [" << ec1.value()
-                                 << " : " << ec1.message()
-                                 << "] when tried to get the subtree to check "
-                                 << "assembled objects implementation of the ["
-                                 << assemblyParentObjPath.str
-                                 << "] to find assembled object id of the ["
-                                 << assembledObjPath.str
-                                 << "] to fill in the URI property";
-                messages::internalError(aResp->res);
-                return;
-            }
-
-            if (objects.empty())
-            {
-                BMCWEB_LOG_ERROR
-                    << "No objects in the [" << assemblyParentObjPath.str
-                    << "] to check assembled objects implementation "
-                    << "to fill the assembled object [ " << assembledObjPath.str
-                    << "] id in the URI property";
-                messages::internalError(aResp->res);
-                return;
-            }
-
-            std::vector<std::string> implAssemblyAssocs;
-            for (const auto& object : objects)
-            {
-                auto it = std::find(assemblyAssoc.begin(), assemblyAssoc.end(),
-                                    object.first);
-                if (it != assemblyAssoc.end())
-                {
-                    implAssemblyAssocs.emplace_back(*it);
-                }
-            }
-
-            if (implAssemblyAssocs.empty())
-            {
-                BMCWEB_LOG_ERROR
-                    << "The assembled objects of the ["
-                    << assemblyParentObjPath.str << "] are not implemented so "
-                    << "unable to fill the assembled object [ "
-                    << assembledObjPath.str << "] id in the URI property";
-                messages::internalError(aResp->res);
-                return;
-            }
-
-            // sort the implemented assemply object as per bmcweb design
-            // to match with Assembly GET and PATCH handler.
-            std::sort(implAssemblyAssocs.begin(), implAssemblyAssocs.end());
+        // The implemented assemblies are sorted as per bmcweb design to
+        // match with Assembly GET and PATCH handler.
+        auto assembledObjectIt = std::find(
+            assemblies->begin(), assemblies->end(), assembledObjPath.str);
 
-            auto assembledObjectIt = std::find(implAssemblyAssocs.begin(),
-                                               implAssemblyAssocs.end(),
-                                               assembledObjPath.str);
+        if (assembledObjectIt == assemblies->end())
+        {
+            BMCWEB_LOG_ERROR << "The assembled object ["
+                             << assembledObjPath.str << "] in the object ["
+                             << assemblyParentObjPath.str
+                             << "] is not implemented so unable to fill "
+                             << "assembled object id in the URI property";
+            messages::internalError(aResp->res);
+            return;
+        }
 
-            if (assembledObjectIt == implAssemblyAssocs.end())
-            {
-                BMCWEB_LOG_ERROR << "The assembled object ["
-                                 << assembledObjPath.str << "] in the object ["
-                                 << assemblyParentObjPath.str
-                                 << "] is not implemented so unable to fill "
-                                 << "assembled object id in the URI property";
-                messages::internalError(aResp->res);
-                return;
-            }
+        auto assembledObjectId =
+            std::distance(assemblies->begin(), assembledObjectIt);
 
-            auto assembledObjectId = std::distance(implAssemblyAssocs.begin(),
-                                                   assembledObjectIt);
+        std::string::size_type assembledObjectNamePos =
+            assembledUriVal.rfind(assembledObjPath.filename());
 
-            std::string::size_type assembledObjectNamePos =
-                assembledUriVal.rfind(assembledObjPath.filename());
+        if (assembledObjectNamePos == std::string::npos)
+        {
+            BMCWEB_LOG_ERROR << "The assembled object name ["
+                             << assembledObjPath.filename() << "] is not "
+                             << "found in the redfish property value ["
+                             << assembledUriVal
+                             << "] to replace with assembled object id ["
+                             << assembledObjectId << "]";
+            messages::internalError(aResp->res);
+            return;
+        }
+        std::string uriValwithId(assembledUriVal);
+        uriValwithId.replace(assembledObjectNamePos,
+                             assembledObjPath.filename().length(),
+                             std::to_string(assembledObjectId));
 
-            if (assembledObjectNamePos == std::string::npos)
-            {
-                BMCWEB_LOG_ERROR << "The assembled object name ["
-                                 << assembledObjPath.filename() << "] is not "
-                                 << "found in the redfish property value ["
-                                 << assembledUriVal
-                                 << "] to replace with assembled object id ["
-                                 << assembledObjectId << "]";
-                messages::internalError(aResp->res);
-                return;
-            }
-            std::string uriValwithId(assembledUriVal);
-            uriValwithId.replace(assembledObjectNamePos,
-                                 assembledObjPath.filename().length(),
-                                 std::to_string(assembledObjectId));
-
-            aResp->res.jsonValue[assemblyUriPropPath] = uriValwithId;
-        },
-            "xyz.openbmc_project.ObjectMapper",
-            "/xyz/openbmc_project/object_mapper",
-            "xyz.openbmc_project.ObjectMapper", "GetSubTree",
-            "/xyz/openbmc_project/inventory", int32_t(0),
-            chassisAssemblyIfaces);
+        aResp->res.jsonValue[assemblyUriPropPath] = uriValwithId;
     });
 }
 
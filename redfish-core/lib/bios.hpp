@@ -1,11 +1,30 @@
 #pragma once
 
 #include <app.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/lexical_cast.hpp>
+#include <dbus_utility.hpp>
+#include <http_utility.hpp>
 #include <query.hpp>
 #include <registries/privilege_registry.hpp>
+#include <sdbusplus/asio/connection.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/asio/property.hpp>
+#include <utils/hex_utils.hpp>
 #include <utils/sw_utils.hpp>
 
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
 namespace redfish
 {
 
@@ -139,6 +158,528 @@ static std::string mapBoundTypeToRedfish(const std::string_view typeDbus)
     return ret;
 }
 
+/**
+ * @brief Renders the AttributeRegistry resource for a BaseBIOSTable.
+ *
+ * @return std::nullopt if an attribute has a type or bound the registry
+ * can't describe.
+ */
+inline std::optional<nlohmann::json>
+    renderBiosAttributeRegistry(const BiosBaseTableType& baseBiosTable)
+{
+    nlohmann::json registry;
+    registry["@odata.id"] = "/redfish/v1/Registries/BiosAttributeRegistry/"
+                            "BiosAttributeRegistry";
+    registry["@odata.type"] = "#AttributeRegistry.v1_3_2.AttributeRegistry";
+    registry["Name"] = "Bios Attribute Registry";
+    registry["Id"] = "BiosAttributeRegistry";
+    registry["RegistryVersion"] = "1.0.0";
+    registry["Language"] = "en";
+    registry["OwningEntity"] = "OpenBMC";
+    nlohmann::json& attributeArray = registry["RegistryEntries"]["Attributes"];
+    attributeArray = nlohmann::json::array();
+
+    for (const BiosBaseTableItemType& item : baseBiosTable)
+    {
+        nlohmann::json optionsArray = nlohmann::json::array();
+        const std::string& itemType = std::get<biosBaseAttrType>(item.second);
+        std::string attrType = mapAttrTypeToRedfish(itemType);
+        if (attrType == "UNKNOWN")
+        {
+            BMCWEB_LOG_ERROR << "attrType == UNKNOWN";
+            return std::nullopt;
+        }
+        nlohmann::json attributeItem;
+        attributeItem["AttributeName"] = item.first;
+        attributeItem["Type"] = attrType;
+        attributeItem["ReadOnly"] =
+            std::get<biosBaseReadonlyStatus>(item.second);
+        attributeItem["DisplayName"] =
+            std::get<biosBaseDisplayName>(item.second);
+        attributeItem["HelpText"] = std::get<biosBaseDescription>(item.second);
+        if (!std::get<biosBaseMenuPath>(item.second).empty())
+        {
+            attributeItem["MenuPath"] = std::get<biosBaseMenuPath>(item.second);
+        }
+
+        if (attrType == "String" || attrType == "Enumeration")
+        {
+            const std::string* currValue = std::get_if<std::string>(
+                &std::get<biosBaseCurrValue>(item.second));
+            const std::string* defValue = std::get_if<std::string>(
+                &std::get<biosBaseDefaultValue>(item.second));
+            if (currValue != nullptr && !currValue->empty())
+            {
+                attributeItem["CurrentValue"] = *currValue;
+            }
+            if (defValue != nullptr && !defValue->empty())
+            {
+                attributeItem["DefaultValue"] = *defValue;
+            }
+        }
+        else if (attrType == "Integer")
+        {
+            const int64_t* currValue = std::get_if<int64_t>(
+                &std::get<biosBaseCurrValue>(item.second));
+            const int64_t* defValue = std::get_if<int64_t>(
+                &std::get<biosBaseDefaultValue>(item.second));
+            attributeItem["CurrentValue"] =
+                currValue != nullptr ? *currValue : 0;
+            attributeItem["DefaultValue"] = defValue != nullptr ? *defValue : 0;
+        }
+        else
+        {
+            BMCWEB_LOG_ERROR << "Unsupported attribute type.";
+            return std::nullopt;
+        }
+
+        const std::vector<OptionsItemType>& optionsVector =
+            std::get<biosBaseOptions>(item.second);
+        for (const OptionsItemType& optItem : optionsVector)
+        {
+            nlohmann::json optItemJson;
+            const std::string& strOptItemType = std::get<optItemType>(optItem);
+            std::string optItemTypeRedfish =
+                mapBoundTypeToRedfish(strOptItemType);
+            if (optItemTypeRedfish == "UNKNOWN")
+            {
+                BMCWEB_LOG_ERROR << "optItemTypeRedfish == UNKNOWN";
+                return std::nullopt;
+            }
+            if (optItemTypeRedfish == "OneOf")
+            {
+                const std::string* currValue =
+                    std::get_if<std::string>(&std::get<optItemValue>(optItem));
+                if (currValue != nullptr)
+                {
+                    optItemJson["ValueName"] = *currValue;
+                    optionsArray.push_back(optItemJson);
+                }
+            }
+            else
+            {
+                const int64_t* currValue =
+                    std::get_if<int64_t>(&std::get<optItemValue>(optItem));
+                if (currValue != nullptr)
+                {
+                    attributeItem[optItemTypeRedfish] = *currValue;
+                }
+            }
+        }
+
+        if (!optionsArray.empty())
+        {
+            attributeItem["Value"] = optionsArray;
+        }
+        attributeArray.push_back(attributeItem);
+    }
+    return registry;
+}
+
+/**
+ * @brief Renders the current value of each attribute in a BaseBIOSTable.
+ *
+ * @param[out] complete  False if an attribute had an unsupported type and
+ *                       was left out
+ */
+inline nlohmann::json renderBiosAttributes(
+    const BiosBaseTableType& baseBiosTable, bool& complete)
+{
+    complete = true;
+    nlohmann::json attributesJson(nlohmann::json::value_t::object);
+    for (const BiosBaseTableItemType& item : baseBiosTable)
+    {
+        const std::string& key = item.first;
+        const std::string& itemType = std::get<biosBaseAttrType>(item.second);
+        std::string attrType = mapAttrTypeToRedfish(itemType);
+        if (attrType == "String" || attrType == "Enumeration")
+        {
+            const std::string* currValue = std::get_if<std::string>(
+                &std::get<biosBaseCurrValue>(item.second));
+            attributesJson.emplace(key,
+                                   currValue != nullptr ? *currValue : "");
+        }
+        else if (attrType == "Integer")
+        {
+            const int64_t* currValue = std::get_if<int64_t>(
+                &std::get<biosBaseCurrValue>(item.second));
+            attributesJson.emplace(key, currValue != nullptr ? *currValue : 0);
+        }
+        else
+        {
+            BMCWEB_LOG_ERROR << "Unsupported attribute type.";
+            complete = false;
+        }
+    }
+    return attributesJson;
+}
+
+/**
+ * @brief What a PATCH of an attribute is checked against.
+ */
+struct BiosAttributeConstraints
+{
+    bool readOnly = false;
+    // The attribute type as D-Bus names it, and as Redfish does
+    std::string dbusType;
+    std::string redfishType;
+    // Bounds of an Integer value, and of the length of a String value
+    int64_t lowerBound = 0;
+    int64_t upperBound = 0;
+    int64_t minLength = 0;
+    int64_t maxLength = 0;
+    std::variant<int64_t, std::string> currentValue;
+};
+
+using BiosAttributeIndex =
+    std::unordered_map<std::string, BiosAttributeConstraints>;
+
+/**
+ * @brief Indexes the attributes of a BaseBIOSTable by name.
+ *
+ * @return std::nullopt if an attribute has a bound of unknown type.
+ */
+inline std::optional<BiosAttributeIndex>
+    indexBiosAttributes(const BiosBaseTableType& baseBiosTable)
+{
+    BiosAttributeIndex index;
+    index.reserve(baseBiosTable.size());
+    for (const BiosBaseTableItemType& item : baseBiosTable)
+    {
+        BiosAttributeConstraints constraints;
+        constraints.readOnly = std::get<biosBaseReadonlyStatus>(item.second);
+        constraints.dbusType = std::get<biosBaseAttrType>(item.second);
+        constraints.redfishType = mapAttrTypeToRedfish(constraints.dbusType);
+        constraints.currentValue = std::get<biosBaseCurrValue>(item.second);
+
+        // The first bound of each kind applies
+        bool lowerBoundSet = false;
+        bool upperBoundSet = false;
+        bool minLengthSet = false;
+        bool maxLengthSet = false;
+        for (const OptionsItemType& optItem :
+             std::get<biosBaseOptions>(item.second))
+        {
+            std::string optItemTypeRedfish =
+                mapBoundTypeToRedfish(std::get<optItemType>(optItem));
+            if (optItemTypeRedfish == "UNKNOWN")
+            {
+                BMCWEB_LOG_ERROR << "optItemTypeRedfish == UNKNOWN";
+                return std::nullopt;
+            }
+            const int64_t* bound =
+                std::get_if<int64_t>(&std::get<optItemValue>(optItem));
+            if (bound == nullptr)
+            {
+                continue;
+            }
+            if (optItemTypeRedfish == "LowerBound" && !lowerBoundSet)
+            {
+                constraints.lowerBound = *bound;
+                lowerBoundSet = true;
+            }
+            else if (optItemTypeRedfish == "UpperBound" && !upperBoundSet)
+            {
+                constraints.upperBound = *bound;
+                upperBoundSet = true;
+            }
+            else if (optItemTypeRedfish == "MinLength" && !minLengthSet)
+            {
+                constraints.minLength = *bound;
+                minLengthSet = true;
+            }
+            else if (optItemTypeRedfish == "MaxLength" && !maxLengthSet)
+            {
+                constraints.maxLength = *bound;
+                maxLengthSet = true;
+            }
+        }
+        index.try_emplace(item.first, std::move(constraints));
+    }
+    return index;
+}
+
+/**
+ * @brief Checks a PATCHed attribute value against its constraints and adds
+ * it to pendingAttributes, unless it is the value the attribute already has.
+ *
+ * @return False, with the error set on res, if the value isn't acceptable.
+ */
+inline bool addPendingBiosAttribute(crow::Response& res,
+                                    const std::string& attrName,
+                                    const BiosAttributeConstraints& attr,
+                                    const nlohmann::json& value,
+                                    PendingAttributesType& pendingAttributes)
+{
+    if (attr.readOnly)
+    {
+        BMCWEB_LOG_ERROR << "Attribute Type is ReadOnly. Patch failed!";
+        messages::propertyNotWritable(res, attrName);
+        return false;
+    }
+    if (attr.dbusType.empty())
+    {
+        BMCWEB_LOG_ERROR << "Attribute type not found in BIOS Table";
+        messages::internalError(res);
+        return false;
+    }
+
+    std::variant<int64_t, std::string> pendingValue;
+    if (attr.redfishType == "Integer")
+    {
+        if (value.type() != nlohmann::json::value_t::number_unsigned)
+        {
+            BMCWEB_LOG_ERROR << "The value must be of type int";
+            messages::propertyValueTypeError(
+                res, boost::lexical_cast<std::string>(value), attrName);
+            return false;
+        }
+        const int64_t attrValue = value.get<int64_t>();
+        if (attrValue < attr.lowerBound || attrValue > attr.upperBound)
+        {
+            BMCWEB_LOG_ERROR << "Attribute value is out of range";
+            messages::propertyValueOutOfRange(
+                res, boost::lexical_cast<std::string>(value), attrName);
+            return false;
+        }
+        pendingValue = attrValue;
+    }
+    else if (attr.redfishType == "String")
+    {
+        const std::string* attrValue = value.get_ptr<const std::string*>();
+        if (attrValue == nullptr)
+        {
+            BMCWEB_LOG_ERROR << "The value must be of type String";
+            messages::propertyValueTypeError(
+                res, boost::lexical_cast<std::string>(value), attrName);
+            return false;
+        }
+        const int64_t attrValueLength =
+            static_cast<int64_t>(attrValue->length());
+        if (attrValueLength < attr.minLength ||
+            attrValueLength > attr.maxLength)
+        {
+            BMCWEB_LOG_ERROR << "Attribute value length is incorrect for "
+                             << attrName;
+            messages::propertyValueIncorrect(res, attrName, *attrValue);
+            return false;
+        }
+        pendingValue = *attrValue;
+    }
+    else if (attr.redfishType == "Enumeration" ||
+             attr.redfishType == "Password")
+    {
+        const std::string* attrValue = value.get_ptr<const std::string*>();
+        if (attrValue == nullptr)
+        {
+            BMCWEB_LOG_ERROR << "The value must be of type string";
+            messages::propertyValueTypeError(
+                res, boost::lexical_cast<std::string>(value), attrName);
+            return false;
+        }
+        pendingValue = *attrValue;
+    }
+    else if (attr.redfishType == "Boolean")
+    {
+        const bool* attrValue = value.get_ptr<const bool*>();
+        if (attrValue == nullptr)
+        {
+            BMCWEB_LOG_ERROR << "The value must be of type bool";
+            messages::propertyValueTypeError(
+                res, boost::lexical_cast<std::string>(value), attrName);
+            return false;
+        }
+        pendingValue = static_cast<int64_t>(*attrValue);
+    }
+    else
+    {
+        BMCWEB_LOG_ERROR << "Attribute Type in BiosTable is Unknown";
+        messages::internalError(res);
+        return false;
+    }
+
+    // Passwords are never reported back, so they are always written
+    if (attr.redfishType != "Password" && pendingValue == attr.currentValue)
+    {
+        BMCWEB_LOG_DEBUG << attrName << " already has the PATCHed value";
+        return true;
+    }
+    pendingAttributes.emplace_back(
+        attrName, std::make_tuple(attr.dbusType, std::move(pendingValue)));
+    return true;
+}
+
+/**
+ * @brief What the BIOS resources make of one read of BaseBIOSTable.
+ */
+struct BiosTableRendering
+{
+    explicit BiosTableRendering(const BiosBaseTableType& baseBiosTable) :
+        registry(renderBiosAttributeRegistry(baseBiosTable)),
+        attributes(renderBiosAttributes(baseBiosTable, attributesComplete)),
+        attributeIndex(indexBiosAttributes(baseBiosTable))
+    {
+        if (registry)
+        {
+            registryBody = registry->dump(
+                -1, ' ', true, nlohmann::json::error_handler_t::replace);
+            registryEtag = intToHexString(
+                std::hash<std::string>{}(registryBody), 16);
+        }
+    }
+
+    // std::nullopt if the table can't be described as a registry
+    std::optional<nlohmann::json> registry;
+    // The registry serialized as compact json, and a version of it
+    std::string registryBody;
+    std::string registryEtag;
+    bool attributesComplete = true;
+    nlohmann::json attributes;
+    // std::nullopt if the table can't be PATCHed against
+    std::optional<BiosAttributeIndex> attributeIndex;
+};
+
+/**
+ * @brief Holds the rendering of BaseBIOSTable, so the attribute registry and
+ * the Bios resource don't convert thousands of attributes on every GET.
+ *
+ * The table only changes when the BIOS config manager signals a change to
+ * its properties, or is restarted; either drops the rendering.
+ */
+class BiosTableCache
+{
+  public:
+    static constexpr std::string_view managerPath =
+        "/xyz/openbmc_project/bios_config/manager";
+    static constexpr std::string_view managerInterface =
+        "xyz.openbmc_project.BIOSConfig.Manager";
+
+    using Callback =
+        std::function<void(const boost::system::error_code&,
+                           const std::shared_ptr<const BiosTableRendering>&)>;
+
+    static BiosTableCache& getInstance()
+    {
+        static BiosTableCache cache;
+        return cache;
+    }
+
+    BiosTableCache(const BiosTableCache&) = delete;
+    BiosTableCache(BiosTableCache&&) = delete;
+    BiosTableCache& operator=(const BiosTableCache&) = delete;
+    BiosTableCache& operator=(BiosTableCache&&) = delete;
+    ~BiosTableCache() = default;
+
+    void registerMatches(sdbusplus::asio::connection& conn)
+    {
+        namespace rules = sdbusplus::bus::match::rules;
+
+        matches.clear();
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn,
+            rules::propertiesChanged(std::string(managerPath),
+                                     std::string(managerInterface)),
+            [this](sdbusplus::message_t& /*msg*/) { clear(); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn,
+            rules::nameOwnerChanged() +
+                rules::argN(0, "xyz.openbmc_project.BIOSConfigManager"),
+            [this](sdbusplus::message_t& /*msg*/) { clear(); }));
+        clear();
+    }
+
+    bool enabled() const
+    {
+        return !matches.empty();
+    }
+
+    /**
+     * @brief Calls callback with the rendering of the table service holds,
+     * reading it if it isn't cached.  Concurrent reads share one call.  The
+     * callback is never called inline.
+     */
+    void get(const std::string& service, Callback&& callback)
+    {
+        if (rendering && renderedService == service)
+        {
+            std::shared_ptr<const BiosTableRendering> current = rendering;
+            boost::asio::post(crow::connections::systemBus->get_io_context(),
+                              [current, callback{std::move(callback)}]() {
+                callback(boost::system::error_code(), current);
+            });
+            return;
+        }
+
+        callbacks.emplace_back(std::move(callback));
+        if (callbacks.size() > 1)
+        {
+            return;
+        }
+        crow::dbus_trace::SharedCallScope sharedCalls;
+        crow::connections::bulkBus->async_method_call(
+            [this, service, fetchGeneration{generation}](
+                const boost::system::error_code& ec,
+                const std::variant<BiosBaseTableType>& retBiosTable) {
+            afterGetTable(service, fetchGeneration, ec, retBiosTable);
+        },
+            service, std::string(managerPath),
+            "org.freedesktop.DBus.Properties", "Get",
+            std::string(managerInterface), "BaseBIOSTable");
+    }
+
+    void clear()
+    {
+        rendering.reset();
+        renderedService.clear();
+        generation++;
+    }
+
+  private:
+    BiosTableCache() = default;
+
+    void afterGetTable(const std::string& service, uint64_t fetchGeneration,
+                       const boost::system::error_code& ec,
+                       const std::variant<BiosBaseTableType>& retBiosTable)
+    {
+        std::vector<Callback> waiting = std::move(callbacks);
+        callbacks.clear();
+
+        std::shared_ptr<const BiosTableRendering> rendered;
+        if (!ec)
+        {
+            const BiosBaseTableType* baseBiosTable =
+                std::get_if<BiosBaseTableType>(&retBiosTable);
+            // Left empty if the reply isn't a table
+            if (baseBiosTable == nullptr)
+            {
+                BMCWEB_LOG_ERROR << "baseBiosTable == nullptr ";
+            }
+            else
+            {
+                rendered =
+                    std::make_shared<const BiosTableRendering>(*baseBiosTable);
+                // A change signalled while the call was in flight may not be
+                // in the reply, so only keep it if nothing changed meanwhile
+                if (enabled() && fetchGeneration == generation)
+                {
+                    rendering = rendered;
+                    renderedService = service;
+                }
+            }
+        }
+        for (Callback& callback : waiting)
+        {
+            callback(ec, rendered);
+        }
+    }
+
+    std::shared_ptr<const BiosTableRendering> rendering;
+    std::string renderedService;
+    std::vector<Callback> callbacks;
+    uint64_t generation = 0;
+    std::vector<std::unique_ptr<sdbusplus::bus::match_t>> matches;
+};
+
 /**
  * BiosService class supports handle get method for bios.
  */
@@ -175,10 +716,11 @@ inline void
     asyncResp->res.jsonValue["AttributeRegistry"] = "BiosAttributeRegistry";
     asyncResp->res.jsonValue["Attributes"] = {};
 
-    crow::connections::systemBus->async_method_call(
-        [asyncResp](const boost::system::error_code ec,
+    dbus::utility::getDbusObject(
+        std::string(BiosTableCache::managerPath), {},
+        [asyncResp](const boost::system::error_code& ec,
                     const dbus::utility::MapperGetObject& getObjectType) {
-        if (ec)
+        if (ec || getObjectType.empty())
         {
             BMCWEB_LOG_ERROR << "ObjectMapper::GetObject call failed: " << ec;
             messages::internalError(asyncResp->res);
@@ -187,61 +729,29 @@ inline void
         }
         const std::string& service = getObjectType.begin()->first;
 
-        crow::connections::systemBus->async_method_call(
-            [asyncResp](const boost::system::error_code ec1,
-                        const std::variant<BiosBaseTableType>& retBiosTable) {
+        BiosTableCache::getInstance().get(
+            service,
+            [asyncResp](
+                const boost::system::error_code& ec1,
+                const std::shared_ptr<const BiosTableRendering>& rendering) {
             if (ec1)
             {
                 BMCWEB_LOG_ERROR << "getBiosAttributes DBUS error: " << ec1;
                 messages::internalError(asyncResp->res);
                 return;
             }
-            const BiosBaseTableType* baseBiosTable =
-                std::get_if<BiosBaseTableType>(&retBiosTable);
-            nlohmann::json& attributesJson =
-                asyncResp->res.jsonValue["Attributes"];
-            if (baseBiosTable == nullptr)
+            if (rendering == nullptr)
             {
-                BMCWEB_LOG_ERROR << "baseBiosTable == nullptr ";
                 messages::internalError(asyncResp->res);
                 return;
             }
-            for (const BiosBaseTableItemType& item : *baseBiosTable)
+            asyncResp->res.jsonValue["Attributes"] = rendering->attributes;
+            if (!rendering->attributesComplete)
             {
-                const std::string& key = item.first;
-                const std::string& itemType =
-                    std::get<biosBaseAttrType>(item.second);
-                std::string attrType = mapAttrTypeToRedfish(itemType);
-                if (attrType == "String" || attrType == "Enumeration")
-                {
-                    const std::string* currValue = std::get_if<std::string>(
-                        &std::get<biosBaseCurrValue>(item.second));
-                    attributesJson.emplace(
-                        key, currValue != nullptr ? *currValue : "");
-                }
-                else if (attrType == "Integer")
-                {
-                    const int64_t* currValue = std::get_if<int64_t>(
-                        &std::get<biosBaseCurrValue>(item.second));
-                    attributesJson.emplace(
-                        key, currValue != nullptr ? *currValue : 0);
-                }
-                else
-                {
-                    BMCWEB_LOG_ERROR << "Unsupported attribute type.";
-                    messages::internalError(asyncResp->res);
-                }
+                messages::internalError(asyncResp->res);
             }
-        },
-            service, "/xyz/openbmc_project/bios_config/manager",
-            "org.freedesktop.DBus.Properties", "Get",
-            "xyz.openbmc_project.BIOSConfig.Manager", "BaseBIOSTable");
-    },
-        "xyz.openbmc_project.ObjectMapper",
-        "/xyz/openbmc_project/object_mapper",
-        "xyz.openbmc_project.ObjectMapper", "GetObject",
-        "/xyz/openbmc_project/bios_config/manager",
-        std::array<const char*, 0>());
+        });
+    });
 }
 
 inline void requestRoutesBiosService(App& app)
@@ -390,88 +900,27 @@ inline void requestRoutesBiosSettings(App& app)
             return;
         }
 
-        crow::connections::systemBus->async_method_call(
-            [asyncResp, attrsJson,
-             systemName](const boost::system::error_code ec,
-                         const std::variant<BiosBaseTableType>& retBiosTable) {
+        BiosTableCache::getInstance().get(
+            "xyz.openbmc_project.BIOSConfigManager",
+            [asyncResp, attrsJson, systemName](
+                const boost::system::error_code& ec,
+                const std::shared_ptr<const BiosTableRendering>& rendering) {
             if (ec)
             {
                 BMCWEB_LOG_ERROR << "getBiosAttributes DBUS error: " << ec;
                 messages::internalError(asyncResp->res);
                 return;
             }
-
-            boost::container::flat_map<
-                std::string,
-                std::tuple<
-                    bool, std::string,
-                    boost::container::flat_map<
-                        std::string, std::variant<int64_t, std::string>>>>
-                biosAttrsType;
-            const BiosBaseTableType* baseBiosTable =
-                std::get_if<BiosBaseTableType>(&retBiosTable);
-
-            if (baseBiosTable == nullptr)
+            if (rendering == nullptr || !rendering->attributeIndex)
             {
                 BMCWEB_LOG_ERROR << "baseBiosTable == nullptr ";
                 messages::internalError(asyncResp->res);
                 return;
             }
-
-            for (const BiosBaseTableItemType& item : *baseBiosTable)
-            {
-                const std::vector<OptionsItemType>& optionsVector =
-                    std::get<biosBaseOptions>(item.second);
-
-                boost::container::flat_map<std::string,
-                                           std::variant<int64_t, std::string>>
-                    attrBaseOptions;
-
-                for (const OptionsItemType& optItem : optionsVector)
-                {
-                    const std::string& strOptItemType =
-                        std::get<optItemType>(optItem);
-
-                    const std::string& optItemTypeRedfish =
-                        mapBoundTypeToRedfish(strOptItemType);
-
-                    if (optItemTypeRedfish == "UNKNOWN")
-                    {
-                        BMCWEB_LOG_ERROR << "optItemTypeRedfish == UNKNOWN";
-                        messages::internalError(asyncResp->res);
-                        return;
-                    }
-                    if (optItemTypeRedfish == "OneOf")
-                    {
-                        const std::string* currValue = std::get_if<std::string>(
-                            &std::get<optItemValue>(optItem));
-                        if (currValue != nullptr)
-                        {
-                            attrBaseOptions.try_emplace(optItemTypeRedfish,
-                                                        *currValue);
-                        }
-                    }
-                    else
-                    {
-                        const int64_t* currValue = std::get_if<int64_t>(
-                            &std::get<optItemValue>(optItem));
-                        if (currValue != nullptr)
-                        {
-                            attrBaseOptions.try_emplace(optItemTypeRedfish,
-                                                        *currValue);
-                        }
-                    }
-                }
-
-                biosAttrsType.try_emplace(
-                    item.first,
-                    std::make_tuple(
-                        std::get<biosBaseReadonlyStatus>(item.second),
-                        std::get<biosBaseAttrType>(item.second),
-                        attrBaseOptions));
-            }
+            const BiosAttributeIndex& biosAttrs = *rendering->attributeIndex;
 
             PendingAttributesType pendingAttributes;
+            pendingAttributes.reserve(attrsJson.size());
             for (const auto& attrItr : attrsJson.items())
             {
                 const std::string& attrName = attrItr.key();
@@ -485,169 +934,16 @@ inline void requestRoutesBiosSettings(App& app)
                                             systemName, "Bios", "Settings"));
                     return;
                 }
-                auto it = biosAttrsType.find(attrName);
-                if (it == biosAttrsType.end())
+                auto it = biosAttrs.find(attrName);
+                if (it == biosAttrs.end())
                 {
                     messages::propertyUnknown(asyncResp->res, attrName);
                     return;
                 }
-
-                const bool& biosAttrReadOnlyStatus = std::get<0>((*it).second);
-
-                if (biosAttrReadOnlyStatus)
-                {
-                    BMCWEB_LOG_ERROR
-                        << "Attribute Type is ReadOnly. Patch failed!";
-                    messages::propertyNotWritable(asyncResp->res, attrName);
-                    return;
-                }
-
-                const std::string& biosAttrType = std::get<1>((*it).second);
-                if (biosAttrType.empty())
+                if (!addPendingBiosAttribute(asyncResp->res, attrName,
+                                             it->second, attrItr.value(),
+                                             pendingAttributes))
                 {
-                    BMCWEB_LOG_ERROR
-                        << "Attribute type not found in BIOS Table";
-                    messages::internalError(asyncResp->res);
-                    return;
-                }
-
-                const std::string& biosRedfishAttrType =
-                    mapAttrTypeToRedfish(biosAttrType);
-                if (biosRedfishAttrType == "Integer")
-                {
-                    if (attrItr.value().type() !=
-                        nlohmann::json::value_t::number_unsigned)
-                    {
-                        BMCWEB_LOG_ERROR << "The value must be of type int";
-                        std::string val =
-                            boost::lexical_cast<std::string>(attrItr.value());
-                        messages::propertyValueTypeError(asyncResp->res, val,
-                                                         attrName);
-                        return;
-                    }
-                    const int64_t& attrValue = attrItr.value();
-
-                    boost::container::flat_map<
-                        std::string, std::variant<int64_t, std::string>>
-                        attrBaseOptionsMap = std::get<2>((*it).second);
-
-                    int64_t lowerBoundVal = 0;
-                    int64_t upperBoundVal = 0;
-
-                    // Get Lower Bound value
-                    auto iter = attrBaseOptionsMap.find("LowerBound");
-                    if (iter != attrBaseOptionsMap.end())
-                    {
-                        lowerBoundVal = std::get<int64_t>((*iter).second);
-                    }
-
-                    // Get Upper Bound value
-                    iter = attrBaseOptionsMap.find("UpperBound");
-                    if (iter != attrBaseOptionsMap.end())
-                    {
-                        upperBoundVal = std::get<int64_t>((*iter).second);
-                    }
-
-                    if (attrValue < lowerBoundVal || attrValue > upperBoundVal)
-                    {
-                        BMCWEB_LOG_ERROR << "Attribute value is out of range";
-                        std::string val =
-                            boost::lexical_cast<std::string>(attrItr.value());
-                        messages::propertyValueOutOfRange(asyncResp->res, val,
-                                                          attrName);
-                        return;
-                    }
-
-                    pendingAttributes.emplace_back(std::make_pair(
-                        attrName, std::make_tuple(biosAttrType, attrValue)));
-                }
-                else if (biosRedfishAttrType == "String")
-                {
-                    if (attrItr.value().type() !=
-                        nlohmann::json::value_t::string)
-                    {
-                        BMCWEB_LOG_ERROR << "The value must be of type String";
-                        std::string val =
-                            boost::lexical_cast<std::string>(attrItr.value());
-                        messages::propertyValueTypeError(asyncResp->res, val,
-                                                         attrName);
-                        return;
-                    }
-                    boost::container::flat_map<
-                        std::string, std::variant<int64_t, std::string>>
-                        attrBaseOptionsMap = std::get<2>((*it).second);
-
-                    int64_t minStringLength = 0;
-                    int64_t maxStringLength = 0;
-
-                    // Get Minimum String Length
-                    auto iter = attrBaseOptionsMap.find("MinLength");
-                    if (iter != attrBaseOptionsMap.end())
-                    {
-                        minStringLength = std::get<int64_t>((*iter).second);
-                    }
-
-                    // Get Maximum String Length
-                    iter = attrBaseOptionsMap.find("MaxLength");
-                    if (iter != attrBaseOptionsMap.end())
-                    {
-                        maxStringLength = std::get<int64_t>((*iter).second);
-                    }
-                    const std::string& attrValue = attrItr.value();
-                    const int64_t attrValueLength =
-                        static_cast<int64_t>(attrValue.length());
-                    if (attrValueLength < minStringLength ||
-                        attrValueLength > maxStringLength)
-                    {
-                        BMCWEB_LOG_ERROR << "Attribute value length is "
-                                            "incorrect for "
-                                         << attrName;
-                        messages::propertyValueIncorrect(asyncResp->res,
-                                                         attrName, attrValue);
-                        return;
-                    }
-
-                    pendingAttributes.emplace_back(std::make_pair(
-                        attrName, std::make_tuple(biosAttrType, attrValue)));
-                }
-                else if (biosRedfishAttrType == "Enumeration" ||
-                         biosRedfishAttrType == "Password")
-                {
-                    if (attrItr.value().type() !=
-                        nlohmann::json::value_t::string)
-                    {
-                        BMCWEB_LOG_ERROR << "The value must be of type string";
-                        std::string val =
-                            boost::lexical_cast<std::string>(attrItr.value());
-                        messages::propertyValueTypeError(asyncResp->res, val,
-                                                         attrName);
-                        return;
-                    }
-                    std::string attrValue = attrItr.value();
-                    pendingAttributes.emplace_back(std::make_pair(
-                        attrName, std::make_tuple(biosAttrType, attrValue)));
-                }
-                else if (biosRedfishAttrType == "Boolean")
-                {
-                    if (attrItr.value().type() !=
-                        nlohmann::json::value_t::boolean)
-                    {
-                        BMCWEB_LOG_ERROR << "The value must be of type bool";
-                        std::string val =
-                            boost::lexical_cast<std::string>(attrItr.value());
-                        messages::propertyValueTypeError(asyncResp->res, val,
-                                                         attrName);
-                        return;
-                    }
-                    bool attrValue = attrItr.value();
-                    pendingAttributes.emplace_back(std::make_pair(
-                        attrName, std::make_tuple(biosAttrType, attrValue)));
-                }
-                else
-                {
-                    BMCWEB_LOG_ERROR
-                        << "Attribute Type in BiosTable is Unknown";
-                    messages::internalError(asyncResp->res);
                     return;
                 }
             }
@@ -666,12 +962,9 @@ inline void requestRoutesBiosSettings(App& app)
                 "/xyz/openbmc_project/bios_config/manager",
                 "org.freedesktop.DBus.Properties", "Set",
                 "xyz.openbmc_project.BIOSConfig.Manager", "PendingAttributes",
-                std::variant<PendingAttributesType>(pendingAttributes));
-        },
-            "xyz.openbmc_project.BIOSConfigManager",
-            "/xyz/openbmc_project/bios_config/manager",
-            "org.freedesktop.DBus.Properties", "Get",
-            "xyz.openbmc_project.BIOSConfig.Manager", "BaseBIOSTable");
+                std::variant<PendingAttributesType>(
+                    std::move(pendingAttributes)));
+        });
     });
 }
 
@@ -692,23 +985,22 @@ inline void requestRoutesBiosAttributeRegistry(App& app)
         {
             return;
         }
-        asyncResp->res.jsonValue["@odata.id"] =
-            "/redfish/v1/Registries/BiosAttributeRegistry/"
-            "BiosAttributeRegistry";
-        asyncResp->res.jsonValue["@odata.type"] =
-            "#AttributeRegistry.v1_3_2.AttributeRegistry";
-        asyncResp->res.jsonValue["Name"] = "Bios Attribute Registry";
-        asyncResp->res.jsonValue["Id"] = "BiosAttributeRegistry";
-        asyncResp->res.jsonValue["RegistryVersion"] = "1.0.0";
-        asyncResp->res.jsonValue["Language"] = "en";
-        asyncResp->res.jsonValue["OwningEntity"] = "OpenBMC";
-        asyncResp->res.jsonValue["RegistryEntries"]["Attributes"] =
-            nlohmann::json::array();
+        // Without query parameters or a browser asking for html, the body
+        // is the registry exactly as it was serialized when it was cached
+        using http_helpers::ContentType;
+        std::array<ContentType, 2> allowed{ContentType::JSON,
+                                           ContentType::HTML};
+        bool serialized =
+            req.urlView.params().empty() &&
+            http_helpers::getPreferedContentType(req.getHeaderValue("Accept"),
+                                                 allowed) != ContentType::HTML;
 
-        crow::connections::systemBus->async_method_call(
-            [asyncResp](const boost::system::error_code ec,
-                        const dbus::utility::MapperGetObject& getObjectType) {
-            if (ec)
+        dbus::utility::getDbusObject(
+            std::string(BiosTableCache::managerPath), {},
+            [asyncResp,
+             serialized](const boost::system::error_code& ec,
+                         const dbus::utility::MapperGetObject& getObjectType) {
+            if (ec || getObjectType.empty())
             {
                 BMCWEB_LOG_ERROR << "ObjectMapper::GetObject call failed: "
                                  << ec;
@@ -716,12 +1008,14 @@ inline void requestRoutesBiosAttributeRegistry(App& app)
 
                 return;
             }
-            std::string service = getObjectType.begin()->first;
+            const std::string& service = getObjectType.begin()->first;
 
-            crow::connections::systemBus->async_method_call(
-                [asyncResp](
-                    const boost::system::error_code ec1,
-                    const std::variant<BiosBaseTableType>& retBiosTable) {
+            BiosTableCache::getInstance().get(
+                service,
+                [asyncResp, serialized](
+                    const boost::system::error_code& ec1,
+                    const std::shared_ptr<const BiosTableRendering>&
+                        rendering) {
                 if (ec1)
                 {
                     BMCWEB_LOG_ERROR << "getBiosAttributeRegistry DBUS error: "
@@ -730,129 +1024,27 @@ inline void requestRoutesBiosAttributeRegistry(App& app)
                                                "Registries/Bios", "Bios");
                     return;
                 }
-                const BiosBaseTableType* baseBiosTable =
-                    std::get_if<BiosBaseTableType>(&retBiosTable);
-                nlohmann::json& attributeArray =
-                    asyncResp->res.jsonValue["RegistryEntries"]["Attributes"];
-                if (baseBiosTable == nullptr)
+                if (rendering == nullptr || !rendering->registry)
                 {
-                    BMCWEB_LOG_ERROR << "baseBiosTable == nullptr ";
                     messages::internalError(asyncResp->res);
                     return;
                 }
-                for (const BiosBaseTableItemType& item : *baseBiosTable)
+                asyncResp->res.setEncodedBodyCacheable();
+                if (!serialized)
                 {
-                    nlohmann::json optionsArray = nlohmann::json::array();
-                    const std::string& itemType =
-                        std::get<biosBaseAttrType>(item.second);
-                    std::string attrType = mapAttrTypeToRedfish(itemType);
-                    if (attrType == "UNKNOWN")
-                    {
-                        BMCWEB_LOG_ERROR << "attrType == UNKNOWN";
-                        messages::internalError(asyncResp->res);
-                        return;
-                    }
-                    nlohmann::json attributeItem;
-                    attributeItem["AttributeName"] = item.first;
-                    attributeItem["Type"] = attrType;
-                    attributeItem["ReadOnly"] =
-                        std::get<biosBaseReadonlyStatus>(item.second);
-                    attributeItem["DisplayName"] =
-                        std::get<biosBaseDisplayName>(item.second);
-                    attributeItem["HelpText"] =
-                        std::get<biosBaseDescription>(item.second);
-                    if (!std::get<biosBaseMenuPath>(item.second).empty())
-                    {
-                        attributeItem["MenuPath"] =
-                            std::get<biosBaseMenuPath>(item.second);
-                    }
-
-                    if (attrType == "String" || attrType == "Enumeration")
-                    {
-                        const std::string* currValue = std::get_if<std::string>(
-                            &std::get<biosBaseCurrValue>(item.second));
-                        const std::string* defValue = std::get_if<std::string>(
-                            &std::get<biosBaseDefaultValue>(item.second));
-                        if (currValue != nullptr && !currValue->empty())
-                        {
-                            attributeItem["CurrentValue"] = *currValue;
-                        }
-                        if (defValue != nullptr && !defValue->empty())
-                        {
-                            attributeItem["DefaultValue"] = *defValue;
-                        }
-                    }
-                    else if (attrType == "Integer")
-                    {
-                        const int64_t* currValue = std::get_if<int64_t>(
-                            &std::get<biosBaseCurrValue>(item.second));
-                        const int64_t* defValue = std::get_if<int64_t>(
-                            &std::get<biosBaseDefaultValue>(item.second));
-                        attributeItem["CurrentValue"] =
-                            currValue != nullptr ? *currValue : 0;
-                        attributeItem["DefaultValue"] =
-                            defValue != nullptr ? *defValue : 0;
-                    }
-                    else
-                    {
-                        BMCWEB_LOG_ERROR << "Unsupported attribute type.";
-                        messages::internalError(asyncResp->res);
-                        return;
-                    }
-
-                    const std::vector<OptionsItemType>& optionsVector =
-                        std::get<biosBaseOptions>(item.second);
-                    for (const OptionsItemType& optItem : optionsVector)
-                    {
-                        nlohmann::json optItemJson;
-                        const std::string& strOptItemType =
-                            std::get<optItemType>(optItem);
-                        std::string optItemTypeRedfish =
-                            mapBoundTypeToRedfish(strOptItemType);
-                        if (optItemTypeRedfish == "UNKNOWN")
-                        {
-                            BMCWEB_LOG_ERROR << "optItemTypeRedfish == UNKNOWN";
-                            messages::internalError(asyncResp->res);
-                            return;
-                        }
-                        if (optItemTypeRedfish == "OneOf")
-                        {
-                            const std::string* currValue =
-                                std::get_if<std::string>(
-                                    &std::get<optItemValue>(optItem));
-                            if (currValue != nullptr)
-                            {
-                                optItemJson["ValueName"] = *currValue;
-                                optionsArray.push_back(optItemJson);
-                            }
-                        }
-                        else
-                        {
-                            const int64_t* currValue = std::get_if<int64_t>(
-                                &std::get<optItemValue>(optItem));
-                            if (currValue != nullptr)
-                            {
-                                attributeItem[optItemTypeRedfish] = *currValue;
-                            }
-                        }
-                    }
-
-                    if (!optionsArray.empty())
-                    {
-                        attributeItem["Value"] = optionsArray;
-                    }
-                    attributeArray.push_back(attributeItem);
+                    asyncResp->res.jsonValue = *rendering->registry;
+                    return;
                 }
-            },
-                service, "/xyz/openbmc_project/bios_config/manager",
-                "org.freedesktop.DBus.Properties", "Get",
-                "xyz.openbmc_project.BIOSConfig.Manager", "BaseBIOSTable");
-        },
-            "xyz.openbmc_project.ObjectMapper",
-            "/xyz/openbmc_project/object_mapper",
-            "xyz.openbmc_project.ObjectMapper", "GetObject",
-            "/xyz/openbmc_project/bios_config/manager",
-            std::array<const char*, 0>());
+                if (asyncResp->res.setEtagVersion(rendering->registryEtag))
+                {
+                    return;
+                }
+                asyncResp->res.addHeader(
+                    boost::beast::http::field::content_type,
+                    "application/json");
+                asyncResp->res.body() = rendering->registryBody;
+            });
+        });
     });
 }
 
@@ -6,7 +6,7 @@
 #include <sdbusplus/unpack_properties.hpp>
 #include <utils/chassis_utils.hpp>
 #include <utils/dbus_utils.hpp>
-#include <utils/fabric_util.hpp>
+#include <utils/fabric_topology.hpp>
 #include <utils/json_utils.hpp>
 #include <utils/pcie_util.hpp>
 
@@ -374,13 +374,11 @@ inline void requestRoutesCable(App& app)
             return;
         }
         BMCWEB_LOG_DEBUG << "Cable Id: " << cableId;
-        constexpr std::array<std::string_view, 1> interfaces = {
-            "xyz.openbmc_project.Inventory.Item.Cable"};
-        dbus::utility::getSubTree(
-            "/xyz/openbmc_project/inventory", 0, interfaces,
-            [asyncResp,
-             cableId](const boost::system::error_code& ec,
-                      const dbus::utility::MapperGetSubTreeResponse& subtree) {
+        fabric_util::FabricTopologyCache::getInstance().get(
+            [asyncResp, cableId](
+                const boost::system::error_code& ec,
+                const std::shared_ptr<const fabric_util::FabricTopology>&
+                    topology) {
             if (ec.value() == EBADR)
             {
                 messages::resourceNotFound(asyncResp->res, "Cable", cableId);
@@ -394,24 +392,21 @@ inline void requestRoutesCable(App& app)
                 return;
             }
 
-            for (const auto& [objectPath, serviceMap] : subtree)
+            const fabric_util::FabricTopology::Object* cable =
+                topology->findCable(cableId);
+            if (cable == nullptr)
             {
-                sdbusplus::message::object_path path(objectPath);
-                if (path.filename() != cableId)
-                {
-                    continue;
-                }
-
-                asyncResp->res.jsonValue["@odata.type"] = "#Cable.v1_2_0.Cable";
-                asyncResp->res.jsonValue["@odata.id"] = "/redfish/v1/Cables/" +
-                                                        cableId;
-                asyncResp->res.jsonValue["Id"] = cableId;
-                asyncResp->res.jsonValue["Name"] = "Cable";
-
-                getCableProperties(asyncResp, objectPath, serviceMap);
+                messages::resourceNotFound(asyncResp->res, "Cable", cableId);
                 return;
             }
-            messages::resourceNotFound(asyncResp->res, "Cable", cableId);
+
+            asyncResp->res.jsonValue["@odata.type"] = "#Cable.v1_2_0.Cable";
+            asyncResp->res.jsonValue["@odata.id"] = "/redfish/v1/Cables/" +
+                                                    cableId;
+            asyncResp->res.jsonValue["Id"] = cableId;
+            asyncResp->res.jsonValue["Name"] = "Cable";
+
+            getCableProperties(asyncResp, cable->path, cable->serviceMap);
         });
     });
 }
@@ -435,10 +430,28 @@ inline void requestRoutesCableCollection(App& app)
         asyncResp->res.jsonValue["@odata.id"] = "/redfish/v1/Cables";
         asyncResp->res.jsonValue["Name"] = "Cable Collection";
         asyncResp->res.jsonValue["Description"] = "Collection of Cable Entries";
-        constexpr std::array<std::string_view, 1> interfaces{
-            "xyz.openbmc_project.Inventory.Item.Cable"};
-        collection_util::getCollectionMembers(
-            asyncResp, boost::urls::url("/redfish/v1/Cables"), interfaces);
+        fabric_util::FabricTopologyCache::getInstance().get(
+            [asyncResp](
+                const boost::system::error_code& ec,
+                const std::shared_ptr<const fabric_util::FabricTopology>&
+                    topology) {
+            if (ec)
+            {
+                BMCWEB_LOG_DEBUG << "DBUS response error " << ec.value();
+                messages::internalError(asyncResp->res);
+                return;
+            }
+            nlohmann::json::array_t members;
+            topology->forEachCable(
+                [&members](const fabric_util::FabricTopology::Object& cable) {
+                nlohmann::json::object_t member;
+                member["@odata.id"] = crow::utility::urlFromPieces(
+                    "redfish", "v1", "Cables", cable.id);
+                members.emplace_back(std::move(member));
+            });
+            asyncResp->res.jsonValue["Members@odata.count"] = members.size();
+            asyncResp->res.jsonValue["Members"] = std::move(members);
+        });
     });
 }
 
@@ -26,6 +26,7 @@
 #include <sdbusplus/asio/property.hpp>
 #include <sdbusplus/message.hpp>
 #include <sdbusplus/unpack_properties.hpp>
+#include <utils/chassis_graph.hpp>
 #include <utils/collection.hpp>
 #include <utils/dbus_utils.hpp>
 #include <utils/name_utils.hpp>
@@ -217,13 +218,10 @@ inline void
     {
         return;
     }
-    const std::array<const char*, 1> interfaces = {
-        "xyz.openbmc_project.Inventory.Item.Chassis"};
-
-    crow::connections::systemBus->async_method_call(
+    chassis_utils::ChassisGraphCache::getInstance().get(
         [asyncResp, chassisId(std::string(chassisId))](
-            const boost::system::error_code ec,
-            const dbus::utility::MapperGetSubTreeResponse& subtree) {
+            const boost::system::error_code& ec,
+            const std::shared_ptr<const chassis_utils::ChassisGraph>& graph) {
         if (ec)
         {
             BMCWEB_LOG_ERROR << "DBUS response error " << ec;
@@ -231,34 +229,23 @@ inline void
             return;
         }
         // Iterate over all retrieved ObjectPaths.
-        for (const std::pair<
-                 std::string,
-                 std::vector<std::pair<std::string, std::vector<std::string>>>>&
-                 object : subtree)
+        for (const chassis_utils::ChassisNode& chassis : graph->nodes())
         {
-            const std::string& path = object.first;
-            const std::vector<std::pair<std::string, std::vector<std::string>>>&
-                connectionNames = object.second;
+            const std::string& path = chassis.path;
+            const dbus::utility::MapperServiceMap& connectionNames =
+                chassis.services;
 
-            sdbusplus::message::object_path objPath(path);
-            if (objPath.filename() != chassisId)
+            if (chassis.id != chassisId)
             {
                 continue;
             }
 
             auto health = std::make_shared<HealthPopulate>(asyncResp);
 
-            sdbusplus::asio::getProperty<std::vector<std::string>>(
-                *crow::connections::systemBus,
-                "xyz.openbmc_project.ObjectMapper", path + "/all_sensors",
-                "xyz.openbmc_project.Association", "endpoints",
-                [health](const boost::system::error_code ec2,
-                         const std::vector<std::string>& resp) {
-                if (ec2)
-                {
-                    return; // no sensors = no failures
-                }
-                health->inventory = resp;
+            // no sensors = no failures
+            if (chassis.sensors)
+            {
+                health->inventory = *chassis.sensors;
 
                 constexpr const std::array<const char*, 13>
                     inventoryForChassis = {"xyz.openbmc_project.Inventory.Item."
@@ -303,7 +290,7 @@ inline void
                     "/xyz/openbmc_project/object_mapper",
                     "xyz.openbmc_project.ObjectMapper", "GetSubTreePaths", "/",
                     int32_t(0), inventoryForChassis);
-            });
+            }
 
             health->populate();
 
@@ -526,11 +513,7 @@ inline void
 
         // Couldn't find an object with that name.  return an error
         messages::resourceNotFound(asyncResp->res, "Chassis", chassisId);
-    },
-        "xyz.openbmc_project.ObjectMapper",
-        "/xyz/openbmc_project/object_mapper",
-        "xyz.openbmc_project.ObjectMapper", "GetSubTree",
-        "/xyz/openbmc_project/inventory", 0, interfaces);
+    });
 
     getPhysicalSecurityData(asyncResp);
 }
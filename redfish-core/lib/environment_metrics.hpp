@@ -3,87 +3,59 @@
 #include "app.hpp"
 #include "dbus_utility.hpp"
 #include "error_messages.hpp"
+#include "sensor_reading_cache.hpp"
 #include "utils/chassis_utils.hpp"
 
 #include <boost/system/error_code.hpp>
 
-#include <array>
 #include <memory>
 #include <optional>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace redfish
 {
-static constexpr std::array<std::string_view, 1> sensorInterface = {
-    "xyz.openbmc_project.Sensor.Value"};
 inline void
-    updateFanSensorList(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-                        const std::string& chassisId,
-                        const std::string& fanSensorPath, double value)
+    addFanSpeeds(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+                 const std::string& chassisId,
+                 const std::vector<std::string>& fanSensorPaths)
 {
-    std::string fanSensorName =
-        sdbusplus::message::object_path(fanSensorPath).filename();
-    if (fanSensorName.empty())
+    const dbus::utility::SensorReadingCache& cache =
+        dbus::utility::SensorReadingCache::getInstance();
+    for (const std::string& fanSensorPath : fanSensorPaths)
     {
-        return;
-    }
-
-    nlohmann::json item;
-    item["DataSourceUri"] = crow::utility::urlFromPieces(
-        "redfish", "v1", "Chassis", chassisId, "Sensors", fanSensorName);
-    item["DeviceName"] = "Chassis Fan #" + fanSensorName;
-    item["SpeedRPM"] = value;
-
-    nlohmann::json& fanSensorList =
-        asyncResp->res.jsonValue["FanSpeedsPercent"];
-    fanSensorList.emplace_back(std::move(item));
-    asyncResp->res.jsonValue["FanSpeedsPercent@odata.count"] =
-        fanSensorList.size();
-}
-
-inline void getFanSensors(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-                          const std::string& chassisId,
-                          const std::string& service, const std::string& path)
-{
-    sdbusplus::asio::getProperty<double>(
-        *crow::connections::systemBus, service, path,
-        "xyz.openbmc_project.Sensor.Value", "Value",
-        [asyncResp, chassisId, path](const boost::system::error_code ec,
-                                     const double value) {
-        if (ec)
+        const dbus::utility::SensorReadingCache::Reading* reading =
+            cache.findReading(fanSensorPath);
+        if (reading == nullptr)
         {
-            if (ec.value() != EBADR)
-            {
-                messages::internalError(asyncResp->res);
-            }
+            // Not a sensor with a value
+            messages::internalError(asyncResp->res);
             return;
         }
-
-        updateFanSensorList(asyncResp, chassisId, path, value);
-    });
-}
-
-inline void
-    getFanSensorPaths(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-                      const std::string& fanSensorPath,
-                      const std::string& chassisId)
-{
-    dbus::utility::getDbusObject(
-        fanSensorPath, sensorInterface,
-        [asyncResp, chassisId,
-         fanSensorPath](const boost::system::error_code& ec,
-                        const dbus::utility::MapperGetObject& object) {
-        if (ec || object.empty())
+        std::string fanSensorName =
+            sdbusplus::message::object_path(fanSensorPath).filename();
+        if (fanSensorName.empty())
         {
-            messages::internalError(asyncResp->res);
-            return;
+            continue;
         }
 
-        getFanSensors(asyncResp, chassisId, object.begin()->first,
-                      fanSensorPath);
-    });
+        nlohmann::json item;
+        item["DataSourceUri"] = crow::utility::urlFromPieces(
+            "redfish", "v1", "Chassis", chassisId, "Sensors", fanSensorName);
+        item["DeviceName"] = "Chassis Fan #" + fanSensorName;
+        item["SpeedRPM"] = reading->value;
+
+        nlohmann::json& fanSensorList =
+            asyncResp->res.jsonValue["FanSpeedsPercent"];
+        fanSensorList.emplace_back(std::move(item));
+        asyncResp->res.jsonValue["FanSpeedsPercent@odata.count"] =
+            fanSensorList.size();
+    }
 }
 
+// Follows the cooled_by associations of the chassis to its fans' sensors,
+// and reads them from the SensorReadingCache once every lookup is back
 inline void
     getFanSpeedsPercent(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
                         const std::string& chassisPath,
@@ -103,13 +75,16 @@ inline void
             }
         }
 
+        auto fanSensorPaths = std::make_shared<std::vector<std::string>>();
+        auto pending = std::make_shared<size_t>(cooledEndpoints.size());
         for (const auto& cooledEndpoint : cooledEndpoints)
         {
             dbus::utility::getAssociationEndPoints(
                 cooledEndpoint + "/sensors",
-                [asyncResp, chassisId](
+                [asyncResp, chassisId, fanSensorPaths, pending](
                     const boost::system::error_code& ec1,
                     const dbus::utility::MapperEndPoints& sensorsEndpoints) {
+                (*pending)--;
                 if (ec1)
                 {
                     if (ec1.value() != EBADR)
@@ -119,15 +94,59 @@ inline void
                     }
                 }
 
-                for (const auto& sensorsEndpoint : sensorsEndpoints)
+                fanSensorPaths->insert(fanSensorPaths->end(),
+                                       sensorsEndpoints.begin(),
+                                       sensorsEndpoints.end());
+                if (*pending == 0)
                 {
-                    getFanSensorPaths(asyncResp, sensorsEndpoint, chassisId);
+                    addFanSpeeds(asyncResp, chassisId, *fanSensorPaths);
                 }
             });
         }
     });
 }
 
+inline void addPowerWatts(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+                          const std::string& chassisId)
+{
+    const dbus::utility::SensorReadingCache::Reading* totalPower =
+        dbus::utility::SensorReadingCache::getInstance().findReading(
+            "/xyz/openbmc_project/sensors/power/total_power");
+    if (totalPower == nullptr)
+    {
+        BMCWEB_LOG_DEBUG << "There is not total_power";
+        return;
+    }
+    asyncResp->res.jsonValue["PowerWatts"]["@odata.id"] =
+        crow::utility::urlFromPieces("redfish", "v1", "Chassis", chassisId,
+                                     "Sensors", "power_total_power");
+    asyncResp->res.jsonValue["PowerWatts"]["DataSourceUri"] =
+        crow::utility::urlFromPieces("redfish", "v1", "Chassis", chassisId,
+                                     "Sensors", "power_total_power");
+    asyncResp->res.jsonValue["PowerWatts"]["Reading"] = totalPower->value;
+}
+
+// Fills the fan speeds and power from the sensor readings already held,
+// reading only the sensor services that haven't been read yet
+inline void
+    getEnvironmentReadings(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+                           const std::string& chassisPath,
+                           const std::string& chassisId)
+{
+    dbus::utility::SensorReadingCache::getInstance().readAllServices(
+        [asyncResp, chassisPath,
+         chassisId](const boost::system::error_code& ec) {
+        if (ec)
+        {
+            BMCWEB_LOG_ERROR << "DBUS response error: " << ec.message();
+            messages::internalError(asyncResp->res);
+            return;
+        }
+        getFanSpeedsPercent(asyncResp, chassisPath, chassisId);
+        addPowerWatts(asyncResp, chassisId);
+    });
+}
+
 inline void handleEnvironmentMetricsHead(
     App& app, const crow::Request& req,
     const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
@@ -155,78 +174,6 @@ inline void handleEnvironmentMetricsHead(
                                                 std::move(respHandler));
 }
 
-inline void getPowerWatts(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-                          const std::string& chassisId)
-{
-    const std::string sensorPath = "/xyz/openbmc_project/sensors";
-    dbus::utility::getSubTreePaths(
-        sensorPath, 0, sensorInterface,
-        [asyncResp,
-         chassisId](const boost::system::error_code& ec,
-                    const dbus::utility::MapperGetSubTreePathsResponse& paths) {
-        if (ec)
-        {
-            BMCWEB_LOG_ERROR << "DBUS response error: " << ec.message();
-            messages::internalError(asyncResp->res);
-            return;
-        }
-        bool judgment = false;
-        for (const auto& tempPath : paths)
-        {
-            sdbusplus::message::object_path path(tempPath);
-            std::string leaf = path.filename();
-            if (!leaf.compare("total_power"))
-            {
-                judgment = true;
-                break;
-            }
-        }
-        if (!judgment)
-        {
-            BMCWEB_LOG_DEBUG << "There is not total_power";
-            return;
-        }
-
-        const std::string& totalPowerPath =
-            "/xyz/openbmc_project/sensors/power/total_power";
-        dbus::utility::getDbusObject(
-            totalPowerPath, sensorInterface,
-            [asyncResp, chassisId,
-             totalPowerPath](const boost::system::error_code& ec1,
-                             const dbus::utility::MapperGetObject& object) {
-            if (ec1 || object.empty())
-            {
-                BMCWEB_LOG_ERROR << "DBUS response error: " << ec1.message();
-                messages::internalError(asyncResp->res);
-                return;
-            }
-
-            sdbusplus::asio::getProperty<double>(
-                *crow::connections::systemBus, object.begin()->first,
-                totalPowerPath, "xyz.openbmc_project.Sensor.Value", "Value",
-                [asyncResp, chassisId](const boost::system::error_code& ec2,
-                                       double value) {
-                if (ec2)
-                {
-                    BMCWEB_LOG_ERROR << "Can't get Power Watts!"
-                                     << ec2.message();
-                    messages::internalError(asyncResp->res);
-                    return;
-                }
-                asyncResp->res.jsonValue["PowerWatts"]["@odata.id"] =
-                    crow::utility::urlFromPieces("redfish", "v1", "Chassis",
-                                                 chassisId, "Sensors",
-                                                 "power_total_power");
-                asyncResp->res.jsonValue["PowerWatts"]["DataSourceUri"] =
-                    crow::utility::urlFromPieces("redfish", "v1", "Chassis",
-                                                 chassisId, "Sensors",
-                                                 "power_total_power");
-                asyncResp->res.jsonValue["PowerWatts"]["Reading"] = value;
-            });
-        });
-    });
-}
-
 inline void
     getPowerLimitWatts(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
 {
@@ -318,9 +265,8 @@ inline void handleEnvironmentMetricsGet(
         asyncResp->res.jsonValue["@odata.id"] = crow::utility::urlFromPieces(
             "redfish", "v1", "Chassis", chassisId, "EnvironmentMetrics");
 
-        getFanSpeedsPercent(asyncResp, *validChassisPath, chassisId);
         getPowerLimitWatts(asyncResp);
-        getPowerWatts(asyncResp, chassisId);
+        getEnvironmentReadings(asyncResp, *validChassisPath, chassisId);
     };
 
     redfish::chassis_utils::getValidChassisPath(asyncResp, chassisId,
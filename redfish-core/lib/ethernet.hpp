@@ -15,7 +15,9 @@
 */
 #pragma once
 
+#include "utils/ip_config_plan.hpp"
 #include "utils/ip_utils.hpp"
+#include "utils/network_state_cache.hpp"
 
 #include <app.hpp>
 #include <boost/algorithm/string/classification.hpp>
@@ -770,30 +772,6 @@ inline void
     }
 }
 
-/**
- * @brief Deletes given IPv4 interface
- *
- * @param[in] ifaceId     Id of interface whose IP should be deleted
- * @param[in] ipHash      DBus Hash id of IP that should be deleted
- * @param[io] asyncResp   Response object that will be returned to client
- *
- * @return None
- */
-inline void deleteIPv4(const std::string& ifaceId, const std::string& ipHash,
-                       const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
-{
-    crow::connections::systemBus->async_method_call(
-        [asyncResp](const boost::system::error_code ec) {
-        if (ec)
-        {
-            messages::internalError(asyncResp->res);
-        }
-    },
-        "xyz.openbmc_project.Network",
-        "/xyz/openbmc_project/network/" + ifaceId + ipHash,
-        "xyz.openbmc_project.Object.Delete", "Delete");
-}
-
 inline void updateIPv4DefaultGateway(
     const std::string& ifaceId, const std::string& gateway,
     const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
@@ -813,190 +791,83 @@ inline void updateIPv4DefaultGateway(
         "xyz.openbmc_project.Network.EthernetInterface", "DefaultGateway",
         dbus::utility::DbusVariantType(gateway));
 }
-/**
- * @brief Creates a static IPv4 entry
- *
- * @param[in] ifaceId      Id of interface upon which to create the IPv4 entry
- * @param[in] prefixLength IPv4 prefix syntax for the subnet mask
- * @param[in] gateway      IPv4 address of this interfaces gateway
- * @param[in] address      IPv4 address to assign to this interface
- * @param[io] asyncResp    Response object that will be returned to client
- *
- * @return None
- */
-inline void createIPv4(const std::string& ifaceId, uint8_t prefixLength,
-                       const std::string& gateway, const std::string& address,
-                       const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
-{
-    auto createIpHandler = [asyncResp, ifaceId,
-                            gateway](const boost::system::error_code ec) {
-        if (ec)
-        {
-            messages::internalError(asyncResp->res);
-            return;
-        }
-        updateIPv4DefaultGateway(ifaceId, gateway, asyncResp);
-    };
-
-    crow::connections::systemBus->async_method_call(
-        std::move(createIpHandler), "xyz.openbmc_project.Network",
-        "/xyz/openbmc_project/network/" + ifaceId,
-        "xyz.openbmc_project.Network.IP.Create", "IP",
-        "xyz.openbmc_project.Network.IP.Protocol.IPv4", address, prefixLength,
-        gateway);
-}
 
 /**
- * @brief Deletes the IPv4 entry for this interface and creates a replacement
- * static IPv4 entry
+ * @brief Applies the changes of a static address PATCH one after the other,
+ * deletes first, stopping at the first that fails.  The network service
+ * defers reloading its configuration for a moment after each change, so
+ * changes sent back to back take effect in one reload.  For IPv4 the
+ * default gateway is set once, to that of the last address created.
  *
- * @param[in] ifaceId      Id of interface upon which to create the IPv4 entry
- * @param[in] id           The unique hash entry identifying the DBus entry
- * @param[in] prefixLength IPv4 prefix syntax for the subnet mask
- * @param[in] gateway      IPv4 address of this interfaces gateway
- * @param[in] address      IPv4 address to assign to this interface
+ * @param[in] ifaceId      Id of interface whose addresses are changed
+ * @param[in] isIPv4       Whether the addresses are IPv4 or IPv6
+ * @param[in] plan         The changes to apply
+ * @param[in] step         Index of the next change, deletes then creates
  * @param[io] asyncResp    Response object that will be returned to client
  *
  * @return None
  */
-inline void
-    deleteAndCreateIPv4(const std::string& ifaceId, const std::string& id,
-                        uint8_t prefixLength, const std::string& gateway,
-                        const std::string& address,
-                        const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
+inline void applyStaticAddressPlan(
+    const std::string& ifaceId, bool isIPv4,
+    const std::shared_ptr<const ip_util::StaticAddressPlan>& plan, size_t step,
+    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
 {
-    crow::connections::systemBus->async_method_call(
-        [asyncResp, ifaceId, address, prefixLength,
-         gateway](const boost::system::error_code ec) {
-        if (ec)
-        {
-            messages::internalError(asyncResp->res);
-            return;
-        }
+    const std::vector<std::string>& deletes = plan->getDeletes();
+    const std::vector<ip_util::StaticAddress>& creates = plan->getCreates();
 
+    if (step < deletes.size())
+    {
         crow::connections::systemBus->async_method_call(
-            [asyncResp, ifaceId, gateway](const boost::system::error_code ec2) {
-            if (ec2)
+            [ifaceId, isIPv4, plan, step,
+             asyncResp](const boost::system::error_code& ec) {
+            if (ec)
             {
                 messages::internalError(asyncResp->res);
                 return;
             }
-            updateIPv4DefaultGateway(ifaceId, gateway, asyncResp);
+            applyStaticAddressPlan(ifaceId, isIPv4, plan, step + 1, asyncResp);
         },
             "xyz.openbmc_project.Network",
-            "/xyz/openbmc_project/network/" + ifaceId,
-            "xyz.openbmc_project.Network.IP.Create", "IP",
-            "xyz.openbmc_project.Network.IP.Protocol.IPv4", address,
-            prefixLength, gateway);
-    },
-        "xyz.openbmc_project.Network",
-        "/xyz/openbmc_project/network/" + ifaceId + id,
-        "xyz.openbmc_project.Object.Delete", "Delete");
-}
-
-/**
- * @brief Deletes given IPv6
- *
- * @param[in] ifaceId     Id of interface whose IP should be deleted
- * @param[in] ipHash      DBus Hash id of IP that should be deleted
- * @param[io] asyncResp   Response object that will be returned to client
- *
- * @return None
- */
-inline void deleteIPv6(const std::string& ifaceId, const std::string& ipHash,
-                       const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
-{
-    crow::connections::systemBus->async_method_call(
-        [asyncResp](const boost::system::error_code ec) {
-        if (ec)
-        {
-            messages::internalError(asyncResp->res);
-        }
-    },
-        "xyz.openbmc_project.Network",
-        "/xyz/openbmc_project/network/" + ifaceId + ipHash,
-        "xyz.openbmc_project.Object.Delete", "Delete");
-}
+            "/xyz/openbmc_project/network/" + ifaceId + deletes[step],
+            "xyz.openbmc_project.Object.Delete", "Delete");
+        return;
+    }
 
-/**
- * @brief Deletes the IPv6 entry for this interface and creates a replacement
- * static IPv6 entry
- *
- * @param[in] ifaceId      Id of interface upon which to create the IPv6 entry
- * @param[in] id           The unique hash entry identifying the DBus entry
- * @param[in] prefixLength IPv6 prefix syntax for the subnet mask
- * @param[in] address      IPv6 address to assign to this interface
- * @param[io] asyncResp    Response object that will be returned to client
- *
- * @return None
- */
-inline void
-    deleteAndCreateIPv6(const std::string& ifaceId, const std::string& id,
-                        uint8_t prefixLength, const std::string& address,
-                        const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
-{
-    crow::connections::systemBus->async_method_call(
-        [asyncResp, ifaceId, address,
-         prefixLength](const boost::system::error_code ec) {
-        if (ec)
-        {
-            messages::internalError(asyncResp->res);
-        }
+    size_t createIndex = step - deletes.size();
+    if (createIndex < creates.size())
+    {
+        const ip_util::StaticAddress& create = creates[createIndex];
         crow::connections::systemBus->async_method_call(
-            [asyncResp](const boost::system::error_code ec2) {
-            if (ec2)
+            [ifaceId, isIPv4, plan, step, asyncResp,
+             address{create.address}](const boost::system::error_code& ec) {
+            if (ec)
             {
-                messages::internalError(asyncResp->res);
+                if (!isIPv4 && ec == boost::system::errc::io_error)
+                {
+                    messages::propertyValueFormatError(asyncResp->res, address,
+                                                       "Address");
+                }
+                else
+                {
+                    messages::internalError(asyncResp->res);
+                }
+                return;
             }
+            applyStaticAddressPlan(ifaceId, isIPv4, plan, step + 1, asyncResp);
         },
             "xyz.openbmc_project.Network",
             "/xyz/openbmc_project/network/" + ifaceId,
             "xyz.openbmc_project.Network.IP.Create", "IP",
-            "xyz.openbmc_project.Network.IP.Protocol.IPv6", address,
-            prefixLength, "");
-    },
-        "xyz.openbmc_project.Network",
-        "/xyz/openbmc_project/network/" + ifaceId + id,
-        "xyz.openbmc_project.Object.Delete", "Delete");
-}
+            isIPv4 ? "xyz.openbmc_project.Network.IP.Protocol.IPv4"
+                   : "xyz.openbmc_project.Network.IP.Protocol.IPv6",
+            create.address, create.prefixLength, create.gateway);
+        return;
+    }
 
-/**
- * @brief Creates IPv6 with given data
- *
- * @param[in] ifaceId      Id of interface whose IP should be added
- * @param[in] prefixLength Prefix length that needs to be added
- * @param[in] address      IP address that needs to be added
- * @param[io] asyncResp    Response object that will be returned to client
- *
- * @return None
- */
-inline void createIPv6(const std::string& ifaceId, uint8_t prefixLength,
-                       const std::string& address,
-                       const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
-{
-    auto createIpHandler = [asyncResp,
-                            address](const boost::system::error_code& ec) {
-        if (ec)
-        {
-            if (ec == boost::system::errc::io_error)
-            {
-                messages::propertyValueFormatError(asyncResp->res, address,
-                                                   "Address");
-            }
-            else
-            {
-                messages::internalError(asyncResp->res);
-            }
-        }
-    };
-    // Passing null for gateway, as per redfish spec IPv6StaticAddresses object
-    // does not have associated gateway property
-    crow::connections::systemBus->async_method_call(
-        std::move(createIpHandler), "xyz.openbmc_project.Network",
-        "/xyz/openbmc_project/network/" + ifaceId,
-        "xyz.openbmc_project.Network.IP.Create", "IP",
-        "xyz.openbmc_project.Network.IP.Protocol.IPv6", address, prefixLength,
-        "");
+    if (isIPv4 && !creates.empty())
+    {
+        updateIPv4DefaultGateway(ifaceId, creates.back().gateway, asyncResp);
+    }
 }
 
 /**
@@ -1223,21 +1094,22 @@ template <typename CallbackFunc>
 void getEthernetIfaceData(const std::string& ethifaceId,
                           CallbackFunc&& callback)
 {
-    crow::connections::systemBus->async_method_call(
+    network_utils::NetworkStateCache::getInstance().get(
         [ethifaceId{std::string{ethifaceId}},
          callback{std::forward<CallbackFunc>(callback)}](
-            const boost::system::error_code errorCode,
-            const dbus::utility::ManagedObjectType& resp) {
+            const boost::system::error_code& errorCode,
+            const std::shared_ptr<const network_utils::NetworkState>& state) {
         EthernetInterfaceData ethData{};
         boost::container::flat_set<IPv4AddressData> ipv4Data;
         boost::container::flat_set<IPv6AddressData> ipv6Data;
         boost::container::flat_set<StaticGatewayData> ipv6GatewayData;
 
-        if (errorCode)
+        if (errorCode || state == nullptr)
         {
             callback(false, ethData, ipv4Data, ipv6Data, ipv6GatewayData);
             return;
         }
+        const dbus::utility::ManagedObjectType& resp = state->objects;
 
         bool found = extractEthernetInterfaceData(ethifaceId, resp, ethData);
         if (!found)
@@ -1262,9 +1134,7 @@ void getEthernetIfaceData(const std::string& ethifaceId,
         extractIPv6DefaultGatewayData(ethifaceId, resp, ipv6GatewayData);
         // Finally make a callback with useful data
         callback(true, ethData, ipv4Data, ipv6Data, ipv6GatewayData);
-    },
-        "xyz.openbmc_project.Network", "/xyz/openbmc_project/network",
-        "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
+    });
 }
 
 /**
@@ -1276,47 +1146,17 @@ void getEthernetIfaceData(const std::string& ethifaceId,
 template <typename CallbackFunc>
 void getEthernetIfaceList(CallbackFunc&& callback)
 {
-    crow::connections::systemBus->async_method_call(
+    network_utils::NetworkStateCache::getInstance().get(
         [callback{std::forward<CallbackFunc>(callback)}](
-            const boost::system::error_code errorCode,
-            dbus::utility::ManagedObjectType& resp) {
-        // Callback requires vector<string> to retrieve all available
-        // ethernet interfaces
-        boost::container::flat_set<std::string> ifaceList;
-        ifaceList.reserve(resp.size());
-        if (errorCode)
+            const boost::system::error_code& errorCode,
+            const std::shared_ptr<const network_utils::NetworkState>& state) {
+        if (errorCode || state == nullptr)
         {
-            callback(false, ifaceList);
+            callback(false, boost::container::flat_set<std::string>());
             return;
         }
-
-        // Iterate over all retrieved ObjectPaths.
-        for (const auto& objpath : resp)
-        {
-            // And all interfaces available for certain ObjectPath.
-            for (const auto& interface : objpath.second)
-            {
-                // If interface is
-                // xyz.openbmc_project.Network.EthernetInterface, this is
-                // what we're looking for.
-                if (interface.first ==
-                    "xyz.openbmc_project.Network.EthernetInterface")
-                {
-                    std::string ifaceId = objpath.first.filename();
-                    if (ifaceId.empty())
-                    {
-                        continue;
-                    }
-                    // and put it into output vector.
-                    ifaceList.emplace(ifaceId);
-                }
-            }
-        }
-        // Finally make a callback with useful data
-        callback(true, ifaceList);
-    },
-        "xyz.openbmc_project.Network", "/xyz/openbmc_project/network",
-        "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
+        callback(true, state->ethernetInterfaces);
+    });
 }
 
 inline void
@@ -1744,6 +1584,7 @@ inline void handleIPv4StaticPatch(
     // into the NIC.
     boost::container::flat_set<IPv4AddressData>::const_iterator nicIpEntry =
         getNextStaticIpEntry(ipv4Data.cbegin(), ipv4Data.cend());
+    auto plan = std::make_shared<ip_util::StaticAddressPlan>();
 
     for (nlohmann::json& thisJson : input)
     {
@@ -1860,15 +1701,19 @@ inline void handleIPv4StaticPatch(
 
             if (nicIpEntry != ipv4Data.cend())
             {
-                deleteAndCreateIPv4(ifaceId, nicIpEntry->id, prefixLength, *gw,
-                                    *addr, asyncResp);
+                uint8_t currentPrefixLength = 0;
+                ip_util::ipv4VerifyIpAndGetBitcount(nicIpEntry->netmask,
+                                                    &currentPrefixLength);
+                plan->replace(nicIpEntry->id,
+                              {nicIpEntry->address, currentPrefixLength,
+                               nicIpEntry->gateway},
+                              {*addr, prefixLength, *gw});
                 nicIpEntry = getNextStaticIpEntry(++nicIpEntry,
                                                   ipv4Data.cend());
             }
             else
             {
-                createIPv4(ifaceId, prefixLength, *gateway, *address,
-                           asyncResp);
+                plan->add({*address, prefixLength, *gateway});
             }
             entryIdx++;
         }
@@ -1894,7 +1739,7 @@ inline void handleIPv4StaticPatch(
 
             if (thisJson.is_null())
             {
-                deleteIPv4(ifaceId, nicIpEntry->id, asyncResp);
+                plan->remove(nicIpEntry->id);
             }
             if (nicIpEntry != ipv4Data.cend())
             {
@@ -1904,6 +1749,11 @@ inline void handleIPv4StaticPatch(
             entryIdx++;
         }
     }
+
+    if (!plan->empty())
+    {
+        applyStaticAddressPlan(ifaceId, true, plan, 0, asyncResp);
+    }
 }
 
 inline void handleStaticNameServersPatch(
@@ -1942,6 +1792,7 @@ inline void handleIPv6StaticAddressesPatch(
     size_t entryIdx = 1;
     boost::container::flat_set<IPv6AddressData>::const_iterator nicIpEntry =
         getNextStaticIpEntry(ipv6Data.cbegin(), ipv6Data.cend());
+    auto plan = std::make_shared<ip_util::StaticAddressPlan>();
     for (const nlohmann::json& thisJson : input)
     {
         std::string pathString = "IPv6StaticAddresses/" +
@@ -2002,14 +1853,16 @@ inline void handleIPv6StaticAddressesPatch(
 
             if (nicIpEntry != ipv6Data.end())
             {
-                deleteAndCreateIPv6(ifaceId, nicIpEntry->id, prefix, *addr,
-                                    asyncResp);
+                plan->replace(nicIpEntry->id,
+                              {nicIpEntry->address, nicIpEntry->prefixLength,
+                               ""},
+                              {*addr, prefix, ""});
                 nicIpEntry = getNextStaticIpEntry(++nicIpEntry,
                                                   ipv6Data.cend());
             }
             else
             {
-                createIPv6(ifaceId, *prefixLength, *addr, asyncResp);
+                plan->add({*addr, prefix, ""});
             }
             entryIdx++;
         }
@@ -2035,7 +1888,7 @@ inline void handleIPv6StaticAddressesPatch(
 
             if (thisJson.is_null())
             {
-                deleteIPv6(ifaceId, nicIpEntry->id, asyncResp);
+                plan->remove(nicIpEntry->id);
             }
             if (nicIpEntry != ipv6Data.cend())
             {
@@ -2045,6 +1898,11 @@ inline void handleIPv6StaticAddressesPatch(
             entryIdx++;
         }
     }
+
+    if (!plan->empty())
+    {
+        applyStaticAddressPlan(ifaceId, false, plan, 0, asyncResp);
+    }
 }
 
 inline void parseInterfaceData(
@@ -15,9 +15,11 @@
 */
 #pragma once
 #include "event_service_manager.hpp"
+#include "registries_selector.hpp"
 #include "snmp_trap_event_clients.hpp"
 
 #include <app.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/beast/http/fields.hpp>
 #include <http/utility.hpp>
 #include <logging.hpp>
@@ -25,8 +27,10 @@
 #include <registries/privilege_registry.hpp>
 #include <sdbusplus/unpack_properties.hpp>
 #include <utils/dbus_utils.hpp>
+#include <utils/time_utils.hpp>
 
 #include <charconv>
+#include <chrono>
 #include <span>
 
 namespace redfish
@@ -68,6 +72,8 @@ inline void requestRoutesEventService(App& app)
         asyncResp->res.jsonValue["Name"] = "Event Service";
         asyncResp->res.jsonValue["Subscriptions"]["@odata.id"] =
             "/redfish/v1/EventService/Subscriptions";
+        asyncResp->res.jsonValue["ServerSentEventUri"] =
+            "/redfish/v1/EventService/SSE";
         asyncResp->res
             .jsonValue["Actions"]["#EventService.SubmitTestEvent"]["target"] =
             "/redfish/v1/EventService/Actions/EventService.SubmitTestEvent";
@@ -186,10 +192,94 @@ inline void requestRoutesSubmitTestEvent(App& app)
     });
 }
 
+/**
+ * @brief Opens a text/event-stream of the events selected by $filter.  The
+ * stream shows up as an SSE subscription for as long as the client stays.
+ */
+inline void requestRoutesEventServiceSse(App& app)
+{
+    BMCWEB_ROUTE(app, "/redfish/v1/EventService/SSE/")
+        .privileges(redfish::privileges::getEventService)
+        .methods(boost::beast::http::verb::get)(
+            [](const crow::Request& req,
+               const std::shared_ptr<bmcweb::AsyncResp>& asyncResp) {
+        // The stream never ends on its own, so a body that has to be sent
+        // whole can't work
+        if (req.version() < 11)
+        {
+            asyncResp->res.result(
+                boost::beast::http::status::http_version_not_supported);
+            return;
+        }
+        if (!persistent_data::EventServiceStore::getInstance()
+                 .getEventServiceConfig()
+                 .enabled)
+        {
+            messages::serviceDisabled(asyncResp->res,
+                                      "/redfish/v1/EventService/");
+            return;
+        }
+        if (EventServiceManager::getInstance().getNumberOfSubscriptions() >=
+            maxNoOfSubscriptions)
+        {
+            messages::eventSubscriptionLimitExceeded(asyncResp->res);
+            return;
+        }
+
+        std::string formatType = eventFormatType;
+        std::vector<std::string> messageIds;
+        std::vector<std::string> registryPrefixes;
+        std::vector<std::string> metricReportDefinitions;
+        auto filter = req.urlView.params().find("$filter");
+        if (filter != req.urlView.params().end() &&
+            (!readSSEQueryParams((*filter).value, formatType, messageIds,
+                                 registryPrefixes, metricReportDefinitions) ||
+             (formatType != eventFormatType &&
+              formatType != metricReportFormatType)))
+        {
+            messages::queryParameterValueFormatError(
+                asyncResp->res, (*filter).value, "$filter");
+            return;
+        }
+
+        auto stream = std::make_shared<crow::SseStream>(*req.ioService);
+        auto subValue = std::make_shared<Subscription>(stream);
+        subValue->protocol = "Redfish";
+        subValue->eventFormatType = formatType;
+        subValue->registryMsgIds = std::move(messageIds);
+        subValue->registryPrefixes = std::move(registryPrefixes);
+        subValue->metricReportDefinitions = std::move(metricReportDefinitions);
+
+        std::string id;
+        EventServiceManager::getInstance().addSubscription(subValue, id);
+        if (!EventServiceManager::getInstance().isSubscriptionExist(id))
+        {
+            messages::internalError(asyncResp->res);
+            return;
+        }
+        boost::asio::io_context& ioc = *req.ioService;
+        stream->setCloseHandler([&ioc, id]() {
+            // Not from inside whatever let go of the stream
+            boost::asio::post(ioc, [id]() {
+                EventServiceManager::getInstance().deleteSubscription(id);
+            });
+        });
+
+        asyncResp->res.addHeader(boost::beast::http::field::content_type,
+                                 "text/event-stream");
+        asyncResp->res.addHeader(boost::beast::http::field::cache_control,
+                                 "no-cache");
+        asyncResp->res.setAsyncBodyGenerator(
+            [stream](crow::Response::BodyChunkHandler&& done) {
+            stream->pull(std::move(done));
+        });
+    });
+}
+
 inline void doSubscriptionCollection(
-    const boost::system::error_code ec,
+    const boost::system::error_code& ec,
     const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-    dbus::utility::ManagedObjectType& resp)
+    const std::shared_ptr<const SnmpTrapClients>& snmpClients)
 {
     nlohmann::json& memberArray = asyncResp->res.jsonValue["Members"];
     std::vector<std::string> subscripIds =
@@ -209,32 +299,13 @@ inline void doSubscriptionCollection(
 
     asyncResp->res.jsonValue["Members@odata.count"] = memberArray.size();
 
-    if (ec)
+    if (ec || snmpClients == nullptr)
     {
-        if (ec.value() == EBADR)
-        {
-            // This is an optional process so just return if it isn't there
-            return;
-        }
-
-        BMCWEB_LOG_ERROR << "D-Bus response error on GetManagedObjects " << ec;
         messages::internalError(asyncResp->res);
         return;
     }
 
-    for (const auto& objpath : resp)
-    {
-        sdbusplus::message::object_path path(objpath.first);
-        const std::string snmpId = path.filename();
-        if (snmpId.empty())
-        {
-            BMCWEB_LOG_ERROR << "The SNMP client ID is wrong";
-            messages::internalError(asyncResp->res);
-            return;
-        }
-
-        getSnmpSubscriptionList(asyncResp, snmpId, memberArray);
-    }
+    getSnmpSubscriptionList(asyncResp, *snmpClients, memberArray);
 }
 
 inline void requestRoutesEventDestinationCollection(App& app)
@@ -254,14 +325,12 @@ inline void requestRoutesEventDestinationCollection(App& app)
             "/redfish/v1/EventService/Subscriptions";
         asyncResp->res.jsonValue["Name"] = "Event Destination Collections";
 
-        crow::connections::systemBus->async_method_call(
-            [asyncResp](const boost::system::error_code ec,
-                        dbus::utility::ManagedObjectType& resp) {
-            doSubscriptionCollection(ec, asyncResp, resp);
-        },
-            "xyz.openbmc_project.Network.SNMP",
-            "/xyz/openbmc_project/network/snmp/manager",
-            "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
+        SnmpTrapClientCache::getInstance().get(
+            [asyncResp](
+                const boost::system::error_code& ec,
+                const std::shared_ptr<const SnmpTrapClients>& snmpClients) {
+            doSubscriptionCollection(ec, asyncResp, snmpClients);
+        });
     });
 
     BMCWEB_ROUTE(app, "/redfish/v1/EventService/Subscriptions/")
@@ -290,6 +359,8 @@ inline void requestRoutesEventDestinationCollection(App& app)
         std::optional<std::vector<std::string>> resTypes;
         std::optional<std::vector<nlohmann::json>> headers;
         std::optional<std::vector<nlohmann::json>> mrdJsonArray;
+        std::optional<std::string> aggregationFunction;
+        std::optional<std::string> aggregationInterval;
 
         if (!json_util::readJsonPatch(
                 req, asyncResp->res, "Destination", destUrl, "Context", context,
@@ -297,7 +368,9 @@ inline void requestRoutesEventDestinationCollection(App& app)
                 "EventFormatType", eventFormatType2, "HttpHeaders", headers,
                 "RegistryPrefixes", regPrefixes, "MessageIds", msgIds,
                 "DeliveryRetryPolicy", retryPolicy, "MetricReportDefinitions",
-                mrdJsonArray, "ResourceTypes", resTypes))
+                mrdJsonArray, "ResourceTypes", resTypes,
+                "Oem/OpenBMC/MetricAggregation/Function", aggregationFunction,
+                "Oem/OpenBMC/MetricAggregation/Interval", aggregationInterval))
         {
             return;
         }
@@ -465,16 +538,12 @@ inline void requestRoutesEventDestinationCollection(App& app)
                 // Check for Message ID in each of the selected Registry
                 for (const std::string& it : registryPrefix)
                 {
-                    const std::span<const redfish::registries::MessageEntry>
-                        registry =
-                            redfish::registries::getRegistryFromPrefix(it);
-
-                    if (std::any_of(
-                            registry.begin(), registry.end(),
-                            [&id](const redfish::registries::MessageEntry&
-                                      messageEntry) {
-                        return id == messageEntry.first;
-                    }))
+                    const redfish::registries::MessageRegistry* registry =
+                        redfish::registries::getRegistryFromPrefix(it);
+
+                    if (registry != nullptr &&
+                        redfish::registries::getMessageFromRegistry(
+                            *registry, id) != nullptr)
                     {
                         validId = true;
                         break;
@@ -526,6 +595,41 @@ inline void requestRoutesEventDestinationCollection(App& app)
             }
         }
 
+        if (aggregationFunction || aggregationInterval)
+        {
+            if (!aggregationFunction)
+            {
+                messages::propertyMissing(
+                    asyncResp->res, "Oem/OpenBMC/MetricAggregation/Function");
+                return;
+            }
+            if (!aggregationInterval)
+            {
+                messages::propertyMissing(
+                    asyncResp->res, "Oem/OpenBMC/MetricAggregation/Interval");
+                return;
+            }
+            if (!telemetry::aggregationFunctionFromString(*aggregationFunction))
+            {
+                messages::propertyValueNotInList(
+                    asyncResp->res, *aggregationFunction,
+                    "Oem/OpenBMC/MetricAggregation/Function");
+                return;
+            }
+            std::optional<std::chrono::milliseconds> interval =
+                time_utils::fromDurationString(*aggregationInterval);
+            if (!interval || interval->count() <= 0)
+            {
+                messages::propertyValueFormatError(
+                    asyncResp->res, *aggregationInterval,
+                    "Oem/OpenBMC/MetricAggregation/Interval");
+                return;
+            }
+            subValue->metricAggregationFunction = *aggregationFunction;
+            subValue->metricAggregationIntervalMs =
+                static_cast<uint64_t>(interval->count());
+        }
+
         if (protocol == "SNMPv2c")
         {
             addSnmpTrapClient(asyncResp, host, port, destUrl, subValue);
@@ -603,6 +707,18 @@ inline void requestRoutesEventDestination(App& app)
             mrdJsonArray.emplace_back(std::move(mdr));
         }
         asyncResp->res.jsonValue["MetricReportDefinitions"] = mrdJsonArray;
+
+        if (!subValue->metricAggregationFunction.empty())
+        {
+            nlohmann::json& oem = asyncResp->res.jsonValue["Oem"]["OpenBMC"];
+            oem["@odata.type"] =
+                "#OemEventDestination.v1_0_0.EventDestination";
+            oem["MetricAggregation"]["Function"] =
+                subValue->metricAggregationFunction;
+            oem["MetricAggregation"]["Interval"] =
+                time_utils::toDurationString(std::chrono::milliseconds(
+                    subValue->metricAggregationIntervalMs));
+        }
     });
     BMCWEB_ROUTE(app, "/redfish/v1/EventService/Subscriptions/<str>/")
         // The below privilege is wrong, it should be ConfigureManager OR
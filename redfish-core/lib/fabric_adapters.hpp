@@ -5,9 +5,8 @@
 #include "led.hpp"
 #include "query.hpp"
 #include "registries/privilege_registry.hpp"
-#include "utils/collection.hpp"
 #include "utils/dbus_utils.hpp"
-#include "utils/fabric_util.hpp"
+#include "utils/fabric_topology.hpp"
 #include "utils/json_utils.hpp"
 #include "utils/pcie_util.hpp"
 
@@ -342,35 +341,28 @@ inline void getValidFabricAdapterPath(
         messages::resourceNotFound(aResp->res, "ComputerSystem", systemName);
         return;
     }
-    constexpr std::array<std::string_view, 1> interfaces{
-        "xyz.openbmc_project.Inventory.Item.FabricAdapter"};
-
-    dbus::utility::getSubTree(
-        "/xyz/openbmc_project/inventory", 0, interfaces,
-        [adapterId, aResp,
-         callback](const boost::system::error_code& ec,
-                   const dbus::utility::MapperGetSubTreeResponse& subtree) {
+    fabric_util::FabricTopologyCache::getInstance().get(
+        [adapterId, aResp, callback{std::move(callback)}](
+            const boost::system::error_code& ec,
+            const std::shared_ptr<const fabric_util::FabricTopology>&
+                topology) {
         if (ec)
         {
             handleAdapterError(ec, aResp->res, adapterId);
             return;
         }
-        for (const auto& [adapterPath, serviceMap] : subtree)
+        const fabric_util::FabricTopology::Adapter* adapter =
+            topology->findAdapter(adapterId);
+        if (adapter == nullptr)
         {
-            std::string adapterUniq =
-                fabric_util::buildFabricUniquePath(adapterPath);
-            if (fabric_util::checkFabricAdapterId(adapterId, adapterUniq))
-            {
-                nlohmann::json::json_pointer ptr("/Name");
-                name_util::getPrettyName(aResp, adapterPath,
-                                         serviceMap[0].first, ptr);
-                callback(adapterPath, serviceMap.begin()->first,
-                         serviceMap.begin()->second);
-                return;
-            }
+            BMCWEB_LOG_WARNING << "Adapter not found";
+            messages::resourceNotFound(aResp->res, "FabricAdapter", adapterId);
+            return;
         }
-        BMCWEB_LOG_WARNING << "Adapter not found";
-        messages::resourceNotFound(aResp->res, "FabricAdapter", adapterId);
+        const auto& [service, interfaces] = adapter->serviceMap.front();
+        nlohmann::json::json_pointer ptr("/Name");
+        name_util::getPrettyName(aResp, adapter->path, service, ptr);
+        callback(adapter->path, service, interfaces);
     });
 }
 
@@ -453,25 +445,30 @@ inline void handleFabricAdapterCollectionGet(
     aResp->res.jsonValue["@odata.id"] = crow::utility::urlFromPieces(
         "redfish", "v1", "Systems", systemName, "FabricAdapters");
 
-    auto getMembersFromPaths =
-        [](std::vector<std::string>& pathNames,
-           const dbus::utility::MapperGetSubTreePathsResponse& objects) {
-        for (const auto& object : objects)
+    fabric_util::FabricTopologyCache::getInstance().get(
+        [aResp, systemName](
+            const boost::system::error_code& ec,
+            const std::shared_ptr<const fabric_util::FabricTopology>&
+                topology) {
+        if (ec)
         {
-            std::string leaf = fabric_util::buildFabricUniquePath(object);
-            if (leaf.empty())
-            {
-                continue;
-            }
-            pathNames.push_back(leaf);
+            BMCWEB_LOG_DEBUG << "DBUS response error " << ec.value();
+            messages::internalError(aResp->res);
+            return;
         }
-    };
-
-    constexpr std::array<std::string_view, 1> interfaces{
-        "xyz.openbmc_project.Inventory.Item.FabricAdapter"};
-    collection_util::getCollectionMembersWithPathConversion(
-        aResp, boost::urls::url("/redfish/v1/Systems/system/FabricAdapters"),
-        interfaces, std::move(getMembersFromPaths));
+        nlohmann::json::array_t members;
+        topology->forEachAdapter(
+            [&members, &systemName](
+                const fabric_util::FabricTopology::Adapter& adapter) {
+            nlohmann::json::object_t member;
+            member["@odata.id"] = crow::utility::urlFromPieces(
+                "redfish", "v1", "Systems", systemName, "FabricAdapters",
+                adapter.id);
+            members.emplace_back(std::move(member));
+        });
+        aResp->res.jsonValue["Members@odata.count"] = members.size();
+        aResp->res.jsonValue["Members"] = std::move(members);
+    });
 }
 
 inline void handleFabricAdapterCollectionHead(
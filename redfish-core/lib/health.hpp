@@ -16,6 +16,7 @@
 #pragma once
 
 #include "async_resp.hpp"
+#include "utils/health_status_cache.hpp"
 
 #include <app.hpp>
 #include <dbus_singleton.hpp>
@@ -61,11 +62,15 @@ struct HealthPopulate : std::enable_shared_from_this<HealthPopulate>
 
         for (const std::shared_ptr<HealthPopulate>& healthChild : children)
         {
-            healthChild->globalInventoryPath = globalInventoryPath;
             healthChild->statuses = statuses;
         }
 
-        for (const auto& [path, interfaces] : statuses)
+        if (!statuses)
+        {
+            return;
+        }
+        const std::string& globalInventoryPath = statuses->globalInventoryPath;
+        for (const auto& [path, interfaces] : statuses->statuses)
         {
             bool isChild = false;
             bool isSelf = false;
@@ -184,54 +189,10 @@ struct HealthPopulate : std::enable_shared_from_this<HealthPopulate>
             return;
         }
         populated = true;
-        getAllStatusAssociations();
-        getGlobalPath();
-    }
-
-    void getGlobalPath()
-    {
-        std::shared_ptr<HealthPopulate> self = shared_from_this();
-        crow::connections::systemBus->async_method_call(
-            [self](const boost::system::error_code ec,
-                   const dbus::utility::MapperGetSubTreePathsResponse& resp) {
-            if (ec || resp.size() != 1)
-            {
-                // no global item, or too many
-                return;
-            }
-            self->globalInventoryPath = resp[0];
-        },
-            "xyz.openbmc_project.ObjectMapper",
-            "/xyz/openbmc_project/object_mapper",
-            "xyz.openbmc_project.ObjectMapper", "GetSubTreePaths", "/", 0,
-            std::array<const char*, 1>{
-                "xyz.openbmc_project.Inventory.Item.Global"});
-    }
-
-    void getAllStatusAssociations()
-    {
         std::shared_ptr<HealthPopulate> self = shared_from_this();
-        crow::connections::systemBus->async_method_call(
-            [self](const boost::system::error_code ec,
-                   const dbus::utility::ManagedObjectType& resp) {
-            if (ec)
-            {
-                return;
-            }
-            self->statuses = resp;
-            for (auto it = self->statuses.begin(); it != self->statuses.end();)
-            {
-                if (it->first.str.ends_with("critical") ||
-                    it->first.str.ends_with("warning"))
-                {
-                    it++;
-                    continue;
-                }
-                it = self->statuses.erase(it);
-            }
-        },
-            "xyz.openbmc_project.ObjectMapper", "/",
-            "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
+        health_utils::HealthStatusCache::getInstance().get(
+            [self](const std::shared_ptr<const health_utils::HealthStatuses>&
+                       current) { self->statuses = current; });
     }
 
     std::shared_ptr<bmcweb::AsyncResp> asyncResp;
@@ -250,8 +211,7 @@ struct HealthPopulate : std::enable_shared_from_this<HealthPopulate>
 
     std::vector<std::string> inventory;
     bool isManagersHealth = false;
-    dbus::utility::ManagedObjectType statuses;
-    std::string globalInventoryPath = "-"; // default to illegal dbus path
+    std::shared_ptr<const health_utils::HealthStatuses> statuses;
     bool populated = false;
 };
 } // namespace redfish
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "ethernet.hpp"
+#include "utils/hypervisor_state_cache.hpp"
 #include "utils/ip_utils.hpp"
+#include "utils/network_state_cache.hpp"
 
 #include <app.hpp>
 #include <boost/container/flat_set.hpp>
@@ -13,7 +15,9 @@
 #include <sdbusplus/asio/property.hpp>
 #include <utils/json_utils.hpp>
 
+#include <array>
 #include <optional>
+#include <string_view>
 #include <utility>
 #include <variant>
 
@@ -28,7 +32,32 @@ namespace redfish::hypervisor
 using namespace redfish::ip_util;
 
 /**
- * @brief Retrieves hypervisor state properties over dbus
+ * @brief Fills in PowerState and Status from the hypervisor state, if the
+ * hypervisor state object is there
+ */
+inline void
+    addHypervisorState(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
+                       const hypervisor_utils::HypervisorState& state)
+{
+    if (!state.present)
+    {
+        return;
+    }
+    BMCWEB_LOG_DEBUG << "Hypervisor state: " << state.hostState;
+    std::optional<hypervisor_utils::PowerStatus> status =
+        hypervisor_utils::powerStatus(state.hostState);
+    if (!status)
+    {
+        messages::internalError(aResp->res);
+        return;
+    }
+    aResp->res.jsonValue["PowerState"] = status->powerState;
+    aResp->res.jsonValue["Status"]["State"] = status->state;
+}
+
+/**
+ * @brief Retrieves hypervisor state properties, from the
+ * HypervisorStateCache when it's there
  *
  * The hypervisor state object is optional so this function will only set the
  * state variables if the object is found
@@ -40,17 +69,32 @@ using namespace redfish::ip_util;
 inline void getHypervisorState(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
 {
     BMCWEB_LOG_DEBUG << "Get hypervisor state information.";
+    hypervisor_utils::HypervisorStateCache& cache =
+        hypervisor_utils::HypervisorStateCache::getInstance();
+    const hypervisor_utils::HypervisorState* cached = cache.find();
+    if (cached != nullptr)
+    {
+        addHypervisorState(aResp, *cached);
+        return;
+    }
+
     sdbusplus::asio::getProperty<std::variant<std::string>>(
-        *crow::connections::systemBus, "xyz.openbmc_project.State.Hypervisor",
-        "/xyz/openbmc_project/state/hypervisor0",
-        "xyz.openbmc_project.State.Host", "CurrentHostState",
-        [aResp](const boost::system::error_code ec,
-                const std::variant<std::string>& hostState) {
+        *crow::connections::systemBus,
+        std::string(hypervisor_utils::HypervisorStateCache::service),
+        std::string(hypervisor_utils::HypervisorStateCache::path),
+        std::string(hypervisor_utils::HypervisorStateCache::hostInterface),
+        "CurrentHostState",
+        [aResp, generation{cache.generation()}](
+            const boost::system::error_code ec,
+            const std::variant<std::string>& hostState) {
+        hypervisor_utils::HypervisorState state;
         if (ec)
         {
             BMCWEB_LOG_DEBUG << "DBUS response error " << ec;
-            // This is an optional D-Bus object so just return if
-            // error occurs
+            // This is an optional D-Bus object, so it's remembered as
+            // missing until the state service changes owner
+            hypervisor_utils::HypervisorStateCache::getInstance().store(
+                state, generation);
             return;
         }
 
@@ -61,47 +105,11 @@ inline void getHypervisorState(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
             return;
         }
 
-        BMCWEB_LOG_DEBUG << "Hypervisor state: " << *s;
-        // Verify Host State
-        if (*s == "xyz.openbmc_project.State.Host.HostState.Running")
-        {
-            aResp->res.jsonValue["PowerState"] = "On";
-            aResp->res.jsonValue["Status"]["State"] = "Enabled";
-        }
-        else if (*s == "xyz.openbmc_project.State.Host.HostState."
-                       "Quiesced")
-        {
-            aResp->res.jsonValue["PowerState"] = "On";
-            aResp->res.jsonValue["Status"]["State"] = "Quiesced";
-        }
-        else if (*s == "xyz.openbmc_project.State.Host.HostState."
-                       "Standby")
-        {
-            aResp->res.jsonValue["PowerState"] = "On";
-            aResp->res.jsonValue["Status"]["State"] = "StandbyOffline";
-        }
-        else if (*s == "xyz.openbmc_project.State.Host.HostState."
-                       "TransitioningToRunning")
-        {
-            aResp->res.jsonValue["PowerState"] = "PoweringOn";
-            aResp->res.jsonValue["Status"]["State"] = "Starting";
-        }
-        else if (*s == "xyz.openbmc_project.State.Host.HostState."
-                       "TransitioningToOff")
-        {
-            aResp->res.jsonValue["PowerState"] = "PoweringOff";
-            aResp->res.jsonValue["Status"]["State"] = "Enabled";
-        }
-        else if (*s == "xyz.openbmc_project.State.Host.HostState.Off")
-        {
-            aResp->res.jsonValue["PowerState"] = "Off";
-            aResp->res.jsonValue["Status"]["State"] = "Disabled";
-        }
-        else
-        {
-            messages::internalError(aResp->res);
-            return;
-        }
+        state.present = true;
+        state.hostState = *s;
+        hypervisor_utils::HypervisorStateCache::getInstance().store(
+            state, generation);
+        addHypervisorState(aResp, state);
     });
 }
 
@@ -119,11 +127,12 @@ inline void
     getHypervisorActions(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
 {
     BMCWEB_LOG_DEBUG << "Get hypervisor actions.";
-    crow::connections::systemBus->async_method_call(
-        [aResp](
-            const boost::system::error_code ec,
-            const std::vector<std::pair<std::string, std::vector<std::string>>>&
-                objInfo) {
+    constexpr std::array<std::string_view, 1> interfaces = {
+        hypervisor_utils::HypervisorStateCache::hostInterface};
+    dbus::utility::getDbusObject(
+        std::string(hypervisor_utils::HypervisorStateCache::path), interfaces,
+        [aResp](const boost::system::error_code& ec,
+                const dbus::utility::MapperGetObject& objInfo) {
         if (ec)
         {
             BMCWEB_LOG_DEBUG << "DBUS response error " << ec;
@@ -154,12 +163,7 @@ inline void
             "/redfish/v1/Systems/hypervisor/Actions/ComputerSystem.Reset";
         reset["@Redfish.ActionInfo"] =
             "/redfish/v1/Systems/hypervisor/ResetActionInfo";
-    },
-        "xyz.openbmc_project.ObjectMapper",
-        "/xyz/openbmc_project/object_mapper",
-        "xyz.openbmc_project.ObjectMapper", "GetObject",
-        "/xyz/openbmc_project/state/hypervisor0",
-        std::array<const char*, 1>{"xyz.openbmc_project.State.Host"});
+    });
 }
 
 inline bool translateSlaacEnabledToBool(const std::string& inputDHCP)
@@ -422,32 +426,62 @@ void getHypervisorIfaceData(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
                             const std::string& ethIfaceId,
                             CallbackFunc&& callback)
 {
-    crow::connections::systemBus->async_method_call(
+    network_utils::NetworkStateCache::getHypervisorInstance().get(
         [asyncResp, ethIfaceId{std::string{ethIfaceId}},
          callback{std::forward<CallbackFunc>(callback)}](
-            const boost::system::error_code error,
-            const dbus::utility::ManagedObjectType& resp) {
+            const boost::system::error_code& error,
+            const std::shared_ptr<const network_utils::NetworkState>& state) {
         EthernetInterfaceData ethData{};
         boost::container::flat_set<IPv4AddressData> ipv4Data;
         boost::container::flat_set<IPv6AddressData> ipv6Data;
-        if (error)
+        if (error || state == nullptr)
         {
             callback(false, ethData, ipv4Data, ipv6Data);
             return;
         }
 
-        bool found = extractHypervisorInterfaceData(
-            asyncResp, ethIfaceId, resp, ethData, ipv4Data, ipv6Data);
+        bool found = extractHypervisorInterfaceData(asyncResp, ethIfaceId,
+                                                    state->objects, ethData,
+                                                    ipv4Data, ipv6Data);
 
         if (!found)
         {
             BMCWEB_LOG_DEBUG << "Hypervisor Interface not found";
         }
         callback(found, ethData, ipv4Data, ipv6Data);
-    },
-        "xyz.openbmc_project.Network.Hypervisor",
-        "/xyz/openbmc_project/network/hypervisor",
-        "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
+    });
+}
+
+/**
+ * @brief Whether the hypervisor network service has its system
+ * configuration, with a HostName, which is what makes the hypervisor system
+ * available
+ */
+inline bool hasHypervisorHostName(const network_utils::NetworkState& state)
+{
+    for (const auto& [path, interfaces] : state.objects)
+    {
+        if (path != "/xyz/openbmc_project/network/hypervisor/config")
+        {
+            continue;
+        }
+        for (const auto& [interface, properties] : interfaces)
+        {
+            if (interface != "xyz.openbmc_project.Network.SystemConfiguration")
+            {
+                continue;
+            }
+            for (const auto& [name, value] : properties)
+            {
+                if (name == "HostName" &&
+                    std::get_if<std::string>(&value) != nullptr)
+                {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
 }
 
 inline bool translateDHCPEnabledToIPv6AutoConfig(const std::string& inputDHCP)
@@ -1113,14 +1147,12 @@ inline void requestRoutesHypervisorSystems(App& app)
             return;
         }
 
-        sdbusplus::asio::getProperty<std::string>(
-            *crow::connections::systemBus,
-            "xyz.openbmc_project.Network.Hypervisor",
-            "/xyz/openbmc_project/network/hypervisor/config",
-            "xyz.openbmc_project.Network.SystemConfiguration", "HostName",
-            [asyncResp](const boost::system::error_code ec,
-                        const std::string& /*hostName*/) {
-            if (ec)
+        network_utils::NetworkStateCache::getHypervisorInstance().get(
+            [asyncResp](
+                const boost::system::error_code& ec,
+                const std::shared_ptr<const network_utils::NetworkState>&
+                    state) {
+            if (ec || state == nullptr || !hasHypervisorHostName(*state))
             {
                 messages::resourceNotFound(asyncResp->res, "System",
                                            "hypervisor");
@@ -1164,14 +1196,12 @@ inline void requestRoutesHypervisorSystems(App& app)
         {
             return;
         }
-        const std::array<const char*, 1> interfaces = {
-            "xyz.openbmc_project.Network.EthernetInterface"};
-
-        crow::connections::systemBus->async_method_call(
+        network_utils::NetworkStateCache::getHypervisorInstance().get(
             [asyncResp](
-                const boost::system::error_code error,
-                const dbus::utility::MapperGetSubTreePathsResponse& ifaceList) {
-            if (error)
+                const boost::system::error_code& ec,
+                const std::shared_ptr<const network_utils::NetworkState>&
+                    state) {
+            if (ec || state == nullptr)
             {
                 messages::resourceNotFound(asyncResp->res, "System",
                                            "hypervisor");
@@ -1190,25 +1220,15 @@ inline void requestRoutesHypervisorSystems(App& app)
 
             nlohmann::json& ifaceArray = asyncResp->res.jsonValue["Members"];
             ifaceArray = nlohmann::json::array();
-            for (const std::string& iface : ifaceList)
+            for (const std::string& name : state->ethernetInterfaces)
             {
-                sdbusplus::message::object_path path(iface);
-                std::string name = path.filename();
-                if (name.empty())
-                {
-                    continue;
-                }
                 nlohmann::json::object_t ethIface;
                 ethIface["@odata.id"] =
                     "/redfish/v1/Systems/hypervisor/EthernetInterfaces/" + name;
                 ifaceArray.push_back(std::move(ethIface));
             }
             asyncResp->res.jsonValue["Members@odata.count"] = ifaceArray.size();
-        },
-            "xyz.openbmc_project.ObjectMapper",
-            "/xyz/openbmc_project/object_mapper",
-            "xyz.openbmc_project.ObjectMapper", "GetSubTreePaths",
-            "/xyz/openbmc_project/network/hypervisor", 0, interfaces);
+        });
     });
 
     BMCWEB_ROUTE(app,
@@ -20,7 +20,9 @@
 #include "redfish_util.hpp"
 
 #include <app.hpp>
+#include <boost/asio/post.hpp>
 #include <sdbusplus/asio/property.hpp>
+#include <utils/led_state_cache.hpp>
 
 #include <array>
 
@@ -164,11 +166,19 @@ inline void getLedAsset(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
                         const std::string& ledGroup,
                         const std::function<void(bool asserted)>& callback)
 {
+    led_utils::LedStateCache& cache = led_utils::LedStateCache::getInstance();
+    std::optional<bool> cached = cache.asserted(ledGroup);
+    if (cached)
+    {
+        callback(*cached);
+        return;
+    }
+
     dbus::utility::getDbusObject(
         ledGroup, ledGroupInterface,
-        [aResp, ledGroup,
-         callback](const boost::system::error_code& ec,
-                   const dbus::utility::MapperGetObject& object) {
+        [aResp, ledGroup, callback, generation{cache.generation()}](
+            const boost::system::error_code& ec,
+            const dbus::utility::MapperGetObject& object) {
         if (ec || object.empty())
         {
             BMCWEB_LOG_ERROR << "DBUS response error " << ec.message();
@@ -176,11 +186,13 @@ inline void getLedAsset(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
             return;
         }
 
-        sdbusplus::asio::getProperty<bool>(
-            *crow::connections::systemBus, object.begin()->first, ledGroup,
-            "xyz.openbmc_project.Led.Group", "Asserted",
-            [aResp, callback](const boost::system::error_code& ec1,
-                              bool assert) {
+        // Reads of the other groups of the LED manager share one
+        // GetManagedObjects
+        dbus::utility::getPropertyBatched<bool>(
+            object.begin()->first, ledGroup, "xyz.openbmc_project.Led.Group",
+            "Asserted",
+            [aResp, ledGroup, callback,
+             generation](const boost::system::error_code& ec1, bool assert) {
             if (ec1)
             {
                 if (ec1.value() != EBADR)
@@ -191,6 +203,8 @@ inline void getLedAsset(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
                 return;
             }
 
+            led_utils::LedStateCache::getInstance().setAsserted(
+                ledGroup, assert, generation);
             callback(assert);
         });
     });
@@ -228,6 +242,63 @@ inline void setLedAsset(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
     });
 }
 
+/**
+ * @brief Finds the identifying LED groups of objPath, from the cache when
+ * they are in it.  The callback is never called inline.
+ *
+ * @param[in] aResp     Shared pointer for generating response message.
+ * @param[in] objPath   Object path on PIM
+ * @param[in] callback  Called with the groups, or with the error of the
+ *                      association lookup
+ *
+ * @return None.
+ */
+inline void getIdentifyingLeds(
+    const std::shared_ptr<bmcweb::AsyncResp>& aResp, const std::string& objPath,
+    std::function<void(const boost::system::error_code&,
+                       const dbus::utility::MapperEndPoints&)>&& callback)
+{
+    led_utils::LedStateCache& cache = led_utils::LedStateCache::getInstance();
+    const dbus::utility::MapperEndPoints* cached =
+        cache.identifyingLeds(objPath);
+    if (cached != nullptr)
+    {
+        // An empty list stands for the association not being there
+        boost::system::error_code ec;
+        if (cached->empty())
+        {
+            ec = boost::system::error_code(EBADR,
+                                           boost::system::system_category());
+        }
+        boost::asio::post(crow::connections::systemBus->get_io_context(),
+                          [ec, endpoints{*cached},
+                           callback{std::move(callback)}]() {
+            callback(ec, endpoints);
+        });
+        return;
+    }
+
+    dbus::utility::getAssociationEndPoints(
+        objPath + "/identifying",
+        [objPath, callback{std::move(callback)},
+         generation{cache.generation()}](
+            const boost::system::error_code& ec,
+            const dbus::utility::MapperEndPoints& endpoints) {
+        led_utils::LedStateCache& current =
+            led_utils::LedStateCache::getInstance();
+        if (!ec)
+        {
+            current.setIdentifyingLeds(objPath, endpoints, generation);
+        }
+        else if (ec.value() == EBADR)
+        {
+            // No identifying association; remember that as no groups
+            current.setIdentifyingLeds(objPath, {}, generation);
+        }
+        callback(ec, endpoints);
+    });
+}
+
 /**
  * @brief Retrieves identify led group properties over dbus
  *
@@ -242,8 +313,8 @@ inline void getLocationIndicatorActive(
 {
     BMCWEB_LOG_DEBUG << "Get LocationIndicatorActive";
 
-    dbus::utility::getAssociationEndPoints(
-        objPath + "/identifying",
+    getIdentifyingLeds(
+        aResp, objPath,
         [aResp, callback{std::move(callback)}](
             const boost::system::error_code& ec,
             const dbus::utility::MapperEndPoints& endpoints) {
@@ -288,8 +359,8 @@ inline void
 {
     BMCWEB_LOG_DEBUG << "Set LocationIndicatorActive";
 
-    dbus::utility::getAssociationEndPoints(
-        objPath + "/identifying",
+    getIdentifyingLeds(
+        aResp, objPath,
         [aResp, ledState,
          objPath](const boost::system::error_code& ec,
                   const dbus::utility::MapperEndPoints& endpoints) {
@@ -16,14 +16,18 @@
 #pragma once
 
 #include "assembly.hpp"
+#include "byte_range.hpp"
+#include "event_log_index.hpp"
 #include "gzfile.hpp"
 #include "http_utility.hpp"
 #include "human_sort.hpp"
 #include "registries.hpp"
-#include "registries/base_message_registry.hpp"
-#include "registries/openbmc_message_registry.hpp"
+#include "registries_selector.hpp"
 #include "task.hpp"
+#include "utility.hpp"
+#include "worker_pool.hpp"
 
+#include <sys/stat.h>
 #include <systemd/sd-id128.h>
 #include <systemd/sd-journal.h>
 #include <tinyxml2.h>
@@ -37,20 +41,27 @@
 #include <boost/beast/http/verb.hpp>
 #include <boost/container/flat_map.hpp>
 #include <boost/system/linux_error.hpp>
+#include <boost/url/params_view.hpp>
 #include <dbus_utility.hpp>
 #include <error_messages.hpp>
 #include <query.hpp>
 #include <registries/privilege_registry.hpp>
 #include <sdbusplus/asio/property.hpp>
 #include <sdbusplus/unpack_properties.hpp>
+#include <utils/change_journal.hpp>
 #include <utils/dbus_utils.hpp>
+#include <utils/enum_table.hpp>
 #include <utils/error_log_utils.hpp>
+#include <utils/hw_isolation.hpp>
 #include <utils/name_utils.hpp>
 #include <utils/time_utils.hpp>
 
 #include <charconv>
 #include <filesystem>
+#include <functional>
+#include <limits>
 #include <optional>
+#include <sstream>
 #include <span>
 #include <string_view>
 #include <tuple>
@@ -102,51 +113,6 @@ enum class DumpCreationProgress
     DUMP_CREATE_INPROGRESS
 };
 
-namespace registries
-{
-static const Message*
-    getMessageFromRegistry(const std::string& messageKey,
-                           const std::span<const MessageEntry> registry)
-{
-    std::span<const MessageEntry>::iterator messageIt =
-        std::find_if(registry.begin(), registry.end(),
-                     [&messageKey](const MessageEntry& messageEntry) {
-        return std::strcmp(messageEntry.first, messageKey.c_str()) == 0;
-    });
-    if (messageIt != registry.end())
-    {
-        return &messageIt->second;
-    }
-
-    return nullptr;
-}
-
-static const Message* getMessage(const std::string_view& messageID)
-{
-    // Redfish MessageIds are in the form
-    // RegistryName.MajorVersion.MinorVersion.MessageKey, so parse it to find
-    // the right Message
-    std::vector<std::string> fields;
-    fields.reserve(4);
-    boost::split(fields, messageID, boost::is_any_of("."));
-    const std::string& registryName = fields[0];
-    const std::string& messageKey = fields[3];
-
-    // Find the right registry and check it for the MessageKey
-    if (std::string(base::header.registryPrefix) == registryName)
-    {
-        return getMessageFromRegistry(
-            messageKey, std::span<const MessageEntry>(base::registry));
-    }
-    if (std::string(openbmc::header.registryPrefix) == registryName)
-    {
-        return getMessageFromRegistry(
-            messageKey, std::span<const MessageEntry>(openbmc::registry));
-    }
-    return nullptr;
-}
-} // namespace registries
-
 namespace fs = std::filesystem;
 
 using AssociationsValType =
@@ -160,26 +126,20 @@ using GetManagedObjectsType = boost::container::flat_map<
     sdbusplus::message::object_path,
     boost::container::flat_map<std::string, GetManagedPropertyType>>;
 
+// D-Bus Logging Entry levels and the Redfish Health each is reported as
+constexpr auto dbusLogSeverities = enum_utils::makeStringMap<std::string_view>(
+    {{"xyz.openbmc_project.Logging.Entry.Level.Alert", "Critical"},
+     {"xyz.openbmc_project.Logging.Entry.Level.Critical", "Critical"},
+     {"xyz.openbmc_project.Logging.Entry.Level.Emergency", "Critical"},
+     {"xyz.openbmc_project.Logging.Entry.Level.Error", "Critical"},
+     {"xyz.openbmc_project.Logging.Entry.Level.Debug", "OK"},
+     {"xyz.openbmc_project.Logging.Entry.Level.Informational", "OK"},
+     {"xyz.openbmc_project.Logging.Entry.Level.Notice", "OK"},
+     {"xyz.openbmc_project.Logging.Entry.Level.Warning", "Warning"}});
+
 inline std::string translateSeverityDbusToRedfish(const std::string& s)
 {
-    if ((s == "xyz.openbmc_project.Logging.Entry.Level.Alert") ||
-        (s == "xyz.openbmc_project.Logging.Entry.Level.Critical") ||
-        (s == "xyz.openbmc_project.Logging.Entry.Level.Emergency") ||
-        (s == "xyz.openbmc_project.Logging.Entry.Level.Error"))
-    {
-        return "Critical";
-    }
-    if ((s == "xyz.openbmc_project.Logging.Entry.Level.Debug") ||
-        (s == "xyz.openbmc_project.Logging.Entry.Level.Informational") ||
-        (s == "xyz.openbmc_project.Logging.Entry.Level.Notice"))
-    {
-        return "OK";
-    }
-    if (s == "xyz.openbmc_project.Logging.Entry.Level.Warning")
-    {
-        return "Warning";
-    }
-    return "";
+    return std::string(dbusLogSeverities.get(s, ""));
 }
 
 inline static int getJournalMetadata(sd_journal* journal,
@@ -251,18 +211,19 @@ inline static bool getEntryTimestamp(sd_journal* journal,
     return true;
 }
 
+// Tracks the previous entry while walking the journal so that entries with
+// the same timestamp get distinct ids
+struct JournalEntryIdState
+{
+    sd_id128_t prevBootID{};
+    uint64_t prevTs = 0;
+    int index = 0;
+};
+
 inline static bool getUniqueEntryID(sd_journal* journal, std::string& entryID,
-                                    const bool firstEntry = true)
+                                    JournalEntryIdState& state)
 {
     int ret = 0;
-    static sd_id128_t prevBootID{};
-    static uint64_t prevTs = 0;
-    static int index = 0;
-    if (firstEntry)
-    {
-        prevBootID = {};
-        prevTs = 0;
-    }
 
     // Get the entry timestamp
     uint64_t curTs = 0;
@@ -275,73 +236,46 @@ inline static bool getUniqueEntryID(sd_journal* journal, std::string& entryID,
         return false;
     }
     // If the timestamp isn't unique on the same boot, increment the index
-    bool sameBootIDs = sd_id128_equal(curBootID, prevBootID) != 0;
-    if (sameBootIDs && (curTs == prevTs))
+    bool sameBootIDs = sd_id128_equal(curBootID, state.prevBootID) != 0;
+    if (sameBootIDs && (curTs == state.prevTs))
     {
-        index++;
+        state.index++;
     }
     else
     {
         // Otherwise, reset it
-        index = 0;
+        state.index = 0;
     }
 
     if (!sameBootIDs)
     {
         // Save the bootID
-        prevBootID = curBootID;
+        state.prevBootID = curBootID;
     }
     // Save the timestamp
-    prevTs = curTs;
+    state.prevTs = curTs;
 
     // make entryID as <bootID>_<timestamp>[_<index>]
     std::array<char, SD_ID128_STRING_MAX> bootIDStr{};
     sd_id128_to_string(curBootID, bootIDStr.data());
     entryID = std::format("{}_{}", bootIDStr.data(), curTs);
-    if (index > 0)
+    if (state.index > 0)
     {
-        entryID += "_" + std::to_string(index);
+        entryID += "_" + std::to_string(state.index);
     }
     return true;
 }
 
-static bool getUniqueEntryID(const std::string& logEntry, std::string& entryID,
-                             const bool firstEntry = true)
+inline static bool getUniqueEntryID(sd_journal* journal, std::string& entryID,
+                                    const bool firstEntry = true)
 {
-    static time_t prevTs = 0;
-    static int index = 0;
+    static JournalEntryIdState state;
     if (firstEntry)
     {
-        prevTs = 0;
-    }
-
-    // Get the entry timestamp
-    std::time_t curTs = 0;
-    std::tm timeStruct = {};
-    std::istringstream entryStream(logEntry);
-    if (entryStream >> std::get_time(&timeStruct, "%Y-%m-%dT%H:%M:%S"))
-    {
-        curTs = std::mktime(&timeStruct);
-    }
-    // If the timestamp isn't unique, increment the index
-    if (curTs == prevTs)
-    {
-        index++;
-    }
-    else
-    {
-        // Otherwise, reset it
-        index = 0;
-    }
-    // Save the timestamp
-    prevTs = curTs;
-
-    entryID = std::to_string(curTs);
-    if (index > 0)
-    {
-        entryID += "_" + std::to_string(index);
+        state.prevBootID = {};
+        state.prevTs = 0;
     }
-    return true;
+    return getUniqueEntryID(journal, entryID, state);
 }
 
 // Entry is formed like "BootID_timestamp" or "BootID_timestamp_index"
@@ -435,6 +369,69 @@ static bool
     return !redfishLogFiles.empty();
 }
 
+/**
+ * @brief Returns true if a log entry collection should be exported as
+ * newline delimited json, one LogEntry per line, rather than as a single
+ * collection resource.  It is asked for with "Accept: application/x-ndjson"
+ * or with "format=ndjson" in the query, and can only be combined with $top
+ * and $skip.
+ */
+inline bool isLogEntryStreamRequested(const crow::Request& req)
+{
+    bool requested = http_helpers::isContentTypeAllowed(
+        req.getHeaderValue("Accept"), http_helpers::ContentType::NDJSON,
+        false);
+    for (const boost::urls::params_view::value_type& param :
+         req.urlView.params())
+    {
+        if (param.key == "format" && param.value == "ndjson")
+        {
+            requested = true;
+        }
+        else if (param.key == "only" ||
+                 (param.key.starts_with('$') && param.key != "$top" &&
+                  param.key != "$skip"))
+        {
+            return false;
+        }
+    }
+    return requested;
+}
+
+// Produces the next LogEntry into entry, leaving it null for one that should
+// be left out.  Returns false once there are no more.
+using NextLogEntry = std::function<bool(nlohmann::json& entry)>;
+
+/**
+ * @brief Sends the entries produced by next as newline delimited json.
+ * Entries are rendered as the socket drains, so only one chunk of output is
+ * held in memory at a time no matter how large the log is.
+ */
+inline void streamLogEntries(crow::Response& res, NextLogEntry next)
+{
+    res.addHeader(boost::beast::http::field::content_type,
+                  "application/x-ndjson");
+    res.setBodyGenerator([next{std::move(next)}](std::string& out,
+                                                 size_t chunkSize) {
+        while (out.size() < chunkSize)
+        {
+            nlohmann::json entry;
+            if (!next(entry))
+            {
+                return false;
+            }
+            if (entry.is_null())
+            {
+                continue;
+            }
+            out += entry.dump(-1, ' ', true,
+                              nlohmann::json::error_handler_t::replace);
+            out += '\n';
+        }
+        return true;
+    });
+}
+
 inline std::string
     mapDbusOriginatorTypeToRedfish(const std::string& originatorType)
 {
@@ -584,6 +581,345 @@ static std::string getDumpEntriesPath(const std::string& dumpType)
     return entriesPath;
 }
 
+/**
+ * @brief Holds the dump manager's objects, so dump entry collections and
+ * single entry lookups don't each read every dump.
+ *
+ * The objects are read on first use and kept in the order the collections
+ * list them.  After that, signals from within the dump tree are applied in
+ * place: PropertiesChanged, say a dump's progress reaching Completed, and
+ * dumps being added or removed through InterfacesAdded and
+ * InterfacesRemoved.  A well known name changing owner drops them, to be
+ * read again on next use.  Objects that have been handed out are never
+ * modified; a signal that arrives while they are still in use replaces them
+ * with an updated copy.
+ */
+class DumpEntryCache
+{
+  public:
+    static constexpr std::string_view dumpRoot = "/xyz/openbmc_project/dump";
+
+    using Callback = std::function<void(
+        const boost::system::error_code&,
+        const std::shared_ptr<const dbus::utility::ManagedObjectType>&)>;
+
+    static DumpEntryCache& getInstance()
+    {
+        static DumpEntryCache cache;
+        return cache;
+    }
+
+    DumpEntryCache(const DumpEntryCache&) = delete;
+    DumpEntryCache(DumpEntryCache&&) = delete;
+    DumpEntryCache& operator=(const DumpEntryCache&) = delete;
+    DumpEntryCache& operator=(DumpEntryCache&&) = delete;
+    ~DumpEntryCache() = default;
+
+    void registerMatches(sdbusplus::asio::connection& conn)
+    {
+        namespace rules = sdbusplus::bus::match::rules;
+        std::string root(dumpRoot);
+
+        matches.clear();
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn,
+            rules::type::signal() + rules::member("PropertiesChanged") +
+                rules::interface("org.freedesktop.DBus.Properties") +
+                rules::path_namespace(root),
+            [this](sdbusplus::message_t& msg) { onPropertiesChanged(msg); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::interfacesAdded() + rules::path_namespace(root),
+            [this](sdbusplus::message_t& msg) { onInterfacesAdded(msg); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::interfacesRemoved() + rules::path_namespace(root),
+            [this](sdbusplus::message_t& msg) { onInterfacesRemoved(msg); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::nameOwnerChanged(), [this](sdbusplus::message_t& msg) {
+            std::string name;
+            msg.read(name);
+            if (!name.starts_with(':'))
+            {
+                clear();
+            }
+        }));
+        clear();
+    }
+
+    bool enabled() const
+    {
+        return !matches.empty();
+    }
+
+    /**
+     * @brief Calls callback with the dump manager's objects, reading them if
+     * they aren't cached.  The callback is never called inline.
+     */
+    void get(Callback&& callback)
+    {
+        if (objects)
+        {
+            std::shared_ptr<const dbus::utility::ManagedObjectType> current =
+                objects;
+            boost::asio::post(crow::connections::systemBus->get_io_context(),
+                              [current, callback{std::move(callback)}]() {
+                callback(boost::system::error_code(), current);
+            });
+            return;
+        }
+
+        callbacks.emplace_back(std::move(callback));
+        if (callbacks.size() > 1)
+        {
+            return;
+        }
+        crow::dbus_trace::SharedCallScope sharedCalls;
+        crow::connections::bulkBus->async_method_call(
+            [this, fetchGeneration{generation}](
+                const boost::system::error_code& ec,
+                dbus::utility::ManagedObjectType& resp) {
+            complete(fetchGeneration, ec, resp);
+        },
+            "xyz.openbmc_project.Dump.Manager", std::string(dumpRoot),
+            "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
+    }
+
+    // The journal of dumps changed, while signals are followed
+    const ChangeJournal* changes() const
+    {
+        return enabled() ? &journal : nullptr;
+    }
+
+    void clear()
+    {
+        objects.reset();
+        generation++;
+        journal.reset();
+    }
+
+  private:
+    DumpEntryCache() = default;
+
+    static void sortObjects(dbus::utility::ManagedObjectType& sorted)
+    {
+        alphanumSort(sorted.begin(), sorted.end(), [](const auto& object) {
+            return object.first.filename();
+        });
+    }
+
+    void complete(uint64_t fetchGeneration, const boost::system::error_code& ec,
+                  dbus::utility::ManagedObjectType& resp)
+    {
+        std::vector<Callback> waiting = std::move(callbacks);
+        callbacks.clear();
+
+        if (ec)
+        {
+            BMCWEB_LOG_ERROR << "DumpEntry resp_handler got error " << ec;
+            for (Callback& callback : waiting)
+            {
+                callback(ec, nullptr);
+            }
+            return;
+        }
+        sortObjects(resp);
+        auto read =
+            std::make_shared<dbus::utility::ManagedObjectType>(std::move(resp));
+        // A signal received meanwhile may not be in the reply
+        if (enabled() && fetchGeneration == generation)
+        {
+            objects = read;
+        }
+        for (Callback& callback : waiting)
+        {
+            callback(ec, read);
+        }
+    }
+
+    // Returns the objects for modification, or nullptr when nothing is
+    // cached
+    dbus::utility::ManagedObjectType* writableObjects()
+    {
+        generation++;
+        if (!objects)
+        {
+            return nullptr;
+        }
+        if (objects.use_count() > 1)
+        {
+            objects =
+                std::make_shared<dbus::utility::ManagedObjectType>(*objects);
+        }
+        return objects.get();
+    }
+
+    static dbus::utility::ManagedObjectType::iterator
+        findObject(dbus::utility::ManagedObjectType& current,
+                   const std::string& path)
+    {
+        return std::find_if(current.begin(), current.end(),
+                            [&path](const auto& object) {
+            return object.first.str == path;
+        });
+    }
+
+    static void updateInterface(dbus::utility::DBusInteracesMap& interfaces,
+                                const std::string& interface,
+                                const dbus::utility::DBusPropertiesMap& changed)
+    {
+        auto it = std::find_if(interfaces.begin(), interfaces.end(),
+                               [&interface](const auto& entry) {
+            return entry.first == interface;
+        });
+        if (it == interfaces.end())
+        {
+            interfaces.emplace_back(interface, changed);
+            return;
+        }
+        for (const auto& [name, value] : changed)
+        {
+            auto property = std::find_if(it->second.begin(), it->second.end(),
+                                         [&name](const auto& entry) {
+                return entry.first == name;
+            });
+            if (property == it->second.end())
+            {
+                it->second.emplace_back(name, value);
+            }
+            else
+            {
+                property->second = value;
+            }
+        }
+    }
+
+    void onPropertiesChanged(sdbusplus::message_t& msg)
+    {
+        std::string interface;
+        dbus::utility::DBusPropertiesMap changed;
+        try
+        {
+            msg.read(interface, changed);
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            BMCWEB_LOG_ERROR << "Failed to read dump change: " << e.what();
+            clear();
+            return;
+        }
+        journal.record(msg.get_path());
+        dbus::utility::ManagedObjectType* current = writableObjects();
+        if (current == nullptr)
+        {
+            return;
+        }
+        auto object = findObject(*current, msg.get_path());
+        if (object != current->end())
+        {
+            updateInterface(object->second, interface, changed);
+        }
+    }
+
+    void onInterfacesAdded(sdbusplus::message_t& msg)
+    {
+        sdbusplus::message::object_path path;
+        dbus::utility::DBusInteracesMap interfaces;
+        try
+        {
+            msg.read(path, interfaces);
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            BMCWEB_LOG_ERROR << "Failed to read added dump: " << e.what();
+            clear();
+            return;
+        }
+        journal.record(path.str);
+        dbus::utility::ManagedObjectType* current = writableObjects();
+        if (current == nullptr)
+        {
+            return;
+        }
+        auto object = findObject(*current, path.str);
+        if (object == current->end())
+        {
+            current->emplace_back(path, std::move(interfaces));
+            sortObjects(*current);
+            return;
+        }
+        for (const auto& [interface, properties] : interfaces)
+        {
+            updateInterface(object->second, interface, properties);
+        }
+    }
+
+    void onInterfacesRemoved(sdbusplus::message_t& msg)
+    {
+        sdbusplus::message::object_path path;
+        std::vector<std::string> interfaces;
+        try
+        {
+            msg.read(path, interfaces);
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            BMCWEB_LOG_ERROR << "Failed to read removed dump: " << e.what();
+            clear();
+            return;
+        }
+        journal.record(path.str);
+        dbus::utility::ManagedObjectType* current = writableObjects();
+        if (current == nullptr)
+        {
+            return;
+        }
+        auto object = findObject(*current, path.str);
+        if (object == current->end())
+        {
+            return;
+        }
+        for (const std::string& interface : interfaces)
+        {
+            std::erase_if(object->second, [&interface](const auto& entry) {
+                return entry.first == interface;
+            });
+        }
+        if (object->second.empty())
+        {
+            current->erase(object);
+        }
+    }
+
+    std::shared_ptr<dbus::utility::ManagedObjectType> objects;
+    std::vector<Callback> callbacks;
+    uint64_t generation = 0;
+    // Fed by the same signals, whether or not objects are cached
+    ChangeJournal journal;
+    std::vector<std::unique_ptr<sdbusplus::bus::match_t>> matches;
+};
+
+/**
+ * @brief The URI of the dumpType dump at path, or an empty string if path
+ * isn't one.
+ */
+inline std::string dumpEntryUri(const std::string& dumpType,
+                                std::string_view path)
+{
+    std::string entryRoot = "/xyz/openbmc_project/dump/" +
+                            boost::algorithm::to_lower_copy(dumpType) +
+                            "/entry/";
+    if (!path.starts_with(entryRoot) || path.size() == entryRoot.size() ||
+        path.find('/', entryRoot.size()) != std::string_view::npos)
+    {
+        return "";
+    }
+    std::string entryID(path.substr(entryRoot.size()));
+    if (dumpType == "BMC" || dumpType == "FaultLog")
+    {
+        return getDumpEntriesPath(dumpType) + entryID;
+    }
+    return getDumpEntriesPath(dumpType) + dumpType + "_" + entryID;
+}
+
 inline void
     getDumpEntryCollection(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
                            const std::string& dumpType)
@@ -595,13 +931,13 @@ inline void
         return;
     }
 
-    crow::connections::systemBus->async_method_call(
-        [asyncResp, entriesPath,
-         dumpType](const boost::system::error_code ec,
-                   dbus::utility::ManagedObjectType& resp) {
+    DumpEntryCache::getInstance().get(
+        [asyncResp, entriesPath, dumpType](
+            const boost::system::error_code& ec,
+            const std::shared_ptr<const dbus::utility::ManagedObjectType>&
+                resp) {
         if (ec)
         {
-            BMCWEB_LOG_ERROR << "DumpEntry resp_handler got error " << ec;
             messages::internalError(asyncResp->res);
             return;
         }
@@ -615,12 +951,8 @@ inline void
             "/xyz/openbmc_project/dump/" +
             std::string(boost::algorithm::to_lower_copy(dumpType)) + "/entry/";
 
-        std::sort(resp.begin(), resp.end(), [](const auto& l, const auto& r) {
-            return AlphanumLess<std::string>()(l.first.filename(),
-                                               r.first.filename());
-        });
-
-        for (auto& object : resp)
+        // The cache keeps the objects in alphanumeric order of their names
+        for (const auto& object : *resp)
         {
             if (object.first.str.find(dumpEntryPath) == std::string::npos)
             {
@@ -691,9 +1023,7 @@ inline void
             entriesArray.push_back(std::move(thisEntry));
         }
         asyncResp->res.jsonValue["Members@odata.count"] = entriesArray.size();
-    },
-        "xyz.openbmc_project.Dump.Manager", "/xyz/openbmc_project/dump",
-        "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
+    });
 }
 
 inline void
@@ -723,13 +1053,13 @@ inline void
         dumpId = entryID.substr(pos + 1);
     }
 
-    crow::connections::systemBus->async_method_call(
-        [asyncResp, entryID, dumpType, dumpId,
-         entriesPath](const boost::system::error_code ec,
-                      const dbus::utility::ManagedObjectType& resp) {
+    DumpEntryCache::getInstance().get(
+        [asyncResp, entryID, dumpType, dumpId, entriesPath](
+            const boost::system::error_code& ec,
+            const std::shared_ptr<const dbus::utility::ManagedObjectType>&
+                resp) {
         if (ec)
         {
-            BMCWEB_LOG_ERROR << "DumpEntry resp_handler got error " << ec;
             messages::internalError(asyncResp->res);
             return;
         }
@@ -739,7 +1069,7 @@ inline void
             "/xyz/openbmc_project/dump/" +
             std::string(boost::algorithm::to_lower_copy(dumpType)) + "/entry/";
 
-        for (const auto& objectPath : resp)
+        for (const auto& objectPath : *resp)
         {
             if (objectPath.first.str != dumpEntryPath + dumpId)
             {
@@ -808,9 +1138,7 @@ inline void
                                        entryID);
             return;
         }
-    },
-        "xyz.openbmc_project.Dump.Manager", "/xyz/openbmc_project/dump",
-        "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
+    });
 }
 
 inline void deleteDumpEntry(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
@@ -1339,6 +1667,46 @@ inline void createDump(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
         "xyz.openbmc_project.Dump.Create", "CreateDump", createDumpParamVec);
 }
 
+// Deletes the dumpType entries implementing dumpInterface one by one.  The
+// deletes are all sent at once rather than one after another.
+inline void
+    deleteDumpEntries(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+                      const std::string& dumpType,
+                      const std::string& dumpInterface)
+{
+    DumpEntryCache::getInstance().get(
+        [asyncResp, dumpType, dumpInterface](
+            const boost::system::error_code& ec,
+            const std::shared_ptr<const dbus::utility::ManagedObjectType>&
+                resp) {
+        if (ec)
+        {
+            messages::internalError(asyncResp->res);
+            return;
+        }
+        std::string dumpEntryPath =
+            std::string(DumpEntryCache::dumpRoot) + "/" +
+            std::string(boost::algorithm::to_lower_copy(dumpType)) + "/entry/";
+        for (const auto& [path, interfaces] : *resp)
+        {
+            if (!path.str.starts_with(dumpEntryPath) ||
+                std::none_of(interfaces.begin(), interfaces.end(),
+                             [&dumpInterface](const auto& entry) {
+                return entry.first == dumpInterface;
+            }))
+            {
+                continue;
+            }
+            std::string logID = path.filename();
+            if (logID.empty())
+            {
+                continue;
+            }
+            deleteDumpEntry(asyncResp, logID, dumpType);
+        }
+    });
+}
+
 inline void clearDump(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
                       const std::string& dumpType)
 {
@@ -1356,33 +1724,35 @@ inline void clearDump(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
     std::string dumpTypeLowerCopy =
         std::string(boost::algorithm::to_lower_copy(dumpType));
 
+    // Dump managers that can delete all of their dumps in one call are asked
+    // to; the others have them deleted one by one
     crow::connections::systemBus->async_method_call(
-        [asyncResp, dumpType](
-            const boost::system::error_code ec,
-            const dbus::utility::MapperGetSubTreePathsResponse& subTreePaths) {
-        if (ec)
+        [asyncResp, dumpType,
+         dumpInterface](const boost::system::error_code& ec,
+                        const sdbusplus::message_t& msg) {
+        if (!ec)
         {
-            BMCWEB_LOG_ERROR << "resp_handler got error " << ec;
-            messages::internalError(asyncResp->res);
             return;
         }
-
-        for (const std::string& path : subTreePaths)
+        const sd_bus_error* dbusError = msg.get_error();
+        if (dbusError != nullptr &&
+            (std::string_view("org.freedesktop.DBus.Error.UnknownMethod") ==
+                 dbusError->name ||
+             std::string_view("org.freedesktop.DBus.Error.UnknownInterface") ==
+                 dbusError->name))
         {
-            sdbusplus::message::object_path objPath(path);
-            std::string logID = objPath.filename();
-            if (logID.empty())
-            {
-                continue;
-            }
-            deleteDumpEntry(asyncResp, logID, dumpType);
+            BMCWEB_LOG_DEBUG << dumpType
+                             << " dumps can't all be deleted at once";
+            deleteDumpEntries(asyncResp, dumpType, dumpInterface);
+            return;
         }
+        BMCWEB_LOG_ERROR << "DeleteAll of " << dumpType
+                         << " dumps got error " << ec;
+        messages::internalError(asyncResp->res);
     },
-        "xyz.openbmc_project.ObjectMapper",
-        "/xyz/openbmc_project/object_mapper",
-        "xyz.openbmc_project.ObjectMapper", "GetSubTreePaths",
-        "/xyz/openbmc_project/dump/" + dumpTypeLowerCopy, 0,
-        std::array<std::string, 1>{dumpInterface});
+        "xyz.openbmc_project.Dump.Manager",
+        std::string(DumpEntryCache::dumpRoot) + "/" + dumpTypeLowerCopy,
+        deleteAllInterface, "DeleteAll");
 }
 
 inline static void
@@ -1688,6 +2058,20 @@ enum class LogParseError
     messageIdNotInRegistry,
 };
 
+// Gets the Created time from a log timestamp.  The log timestamp is in RFC3339
+// format which matches the Redfish format except for the fractional seconds
+// between the '.' and the '+', so just remove them.
+inline std::string eventLogCreated(std::string timestamp)
+{
+    std::size_t dot = timestamp.find_first_of('.');
+    std::size_t plus = timestamp.find_first_of('+');
+    if (dot != std::string::npos && plus != std::string::npos)
+    {
+        timestamp.erase(dot, plus - dot);
+    }
+    return timestamp;
+}
+
 static LogParseError
     fillEventLogEntryJson(const std::string& logEntryID,
                           const std::string& logEntry,
@@ -1758,16 +2142,6 @@ static LogParseError
         }
     }
 
-    // Get the Created time from the timestamp. The log timestamp is in RFC3339
-    // format which matches the Redfish format except for the fractional seconds
-    // between the '.' and the '+', so just remove them.
-    std::size_t dot = timestamp.find_first_of('.');
-    std::size_t plus = timestamp.find_first_of('+');
-    if (dot != std::string::npos && plus != std::string::npos)
-    {
-        timestamp.erase(dot, plus - dot);
-    }
-
     // Fill in the log entry with the gathered data
     logEntryJson["@odata.type"] = "#LogEntry.v1_9_0.LogEntry";
     logEntryJson["@odata.id"] =
@@ -1779,12 +2153,141 @@ static LogParseError
     logEntryJson["MessageArgs"] = messageArgs;
     logEntryJson["EntryType"] = "Event";
     logEntryJson["Severity"] = message->messageSeverity;
-    logEntryJson["Created"] = std::move(timestamp);
+    logEntryJson["Created"] = eventLogCreated(std::move(timestamp));
+    return LogParseError::success;
+}
+
+// Fills the properties of an event log line that don't need its message filled
+// in: Id, MessageId, Severity and Created
+inline LogParseError
+    fillEventLogEntrySummary(const std::string& logEntryID,
+                             std::string_view logEntry,
+                             nlohmann::json::object_t& summary)
+{
+    size_t space = logEntry.find_first_of(' ');
+    if (space == std::string_view::npos)
+    {
+        return LogParseError::parseFailed;
+    }
+    size_t entryStart = logEntry.find_first_not_of(' ', space);
+    if (entryStart == std::string_view::npos)
+    {
+        return LogParseError::parseFailed;
+    }
+    std::string_view messageID = logEntry.substr(entryStart);
+    messageID = messageID.substr(0, messageID.find(','));
+    const registries::Message* message = registries::getMessage(messageID);
+    if (message == nullptr)
+    {
+        return LogParseError::messageIdNotInRegistry;
+    }
+    summary["Id"] = logEntryID;
+    summary["MessageId"] = messageID;
+    summary["Severity"] = message->messageSeverity;
+    summary["Created"] =
+        eventLogCreated(std::string(logEntry.substr(0, space)));
     return LogParseError::success;
 }
 
+// Entries whose MessageId isn't in a registry we know have never been listed
+// in the collection.  Lines with no MessageId stay listed so the parse error
+// is still reported when the entry is rendered.
+inline bool isListedEventLogMessage(std::string_view messageId)
+{
+    if (messageId.empty())
+    {
+        return true;
+    }
+    return registries::getMessage(messageId) != nullptr;
+}
+
+/**
+ * @brief Lists the event log entries that match filter.
+ *
+ * When the filter reads nothing but the properties of a summary, each line is
+ * checked against that, and only the matches on the page asked for have their
+ * message filled in.  The count is of every match, so each line of the log is
+ * still read once.
+ */
+inline void handleFilteredEventLogEntries(
+    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+    const query_param::Filter& filter, size_t skip, size_t top)
+{
+    const event_log::EventLogIndex& index =
+        event_log::EventLogIndex::getInstance();
+    bool bySummary =
+        filter.usesOnly({"Id", "MessageId", "Severity", "Created"});
+
+    nlohmann::json::array_t members;
+    size_t matched = 0;
+    bool failed = false;
+    index.forEachEntry(
+        0, std::numeric_limits<size_t>::max(),
+        [&](const std::string& idStr, const std::string& logEntry) {
+        nlohmann::json member = nlohmann::json::object();
+        nlohmann::json::object_t& bmcLogEntry =
+            member.get_ref<nlohmann::json::object_t&>();
+        LogParseError status = LogParseError::success;
+        if (bySummary)
+        {
+            status = fillEventLogEntrySummary(idStr, logEntry, bmcLogEntry);
+        }
+        else
+        {
+            status = fillEventLogEntryJson(idStr, logEntry, bmcLogEntry);
+        }
+        if (status == LogParseError::messageIdNotInRegistry)
+        {
+            return true;
+        }
+        if (status != LogParseError::success)
+        {
+            failed = true;
+            return false;
+        }
+        if (!filter.matches(member))
+        {
+            return true;
+        }
+        matched++;
+        if (matched <= skip || matched - skip > top)
+        {
+            return true;
+        }
+        if (bySummary)
+        {
+            bmcLogEntry.clear();
+            if (fillEventLogEntryJson(idStr, logEntry, bmcLogEntry) !=
+                LogParseError::success)
+            {
+                failed = true;
+                return false;
+            }
+        }
+        members.emplace_back(std::move(member));
+        return true;
+    });
+    if (failed)
+    {
+        messages::internalError(asyncResp->res);
+        return;
+    }
+
+    asyncResp->res.jsonValue["Members"] = std::move(members);
+    asyncResp->res.jsonValue["Members@odata.count"] = matched;
+    if (skip + top < matched)
+    {
+        asyncResp->res.jsonValue["Members@odata.nextLink"] =
+            query_param::filteredNextLink(
+                "/redfish/v1/Systems/system/LogServices/EventLog/Entries",
+                skip + top, filter);
+    }
+}
+
 inline void requestRoutesJournalEventLogEntryCollection(App& app)
 {
+    event_log::EventLogIndex::getInstance().setFilter(isListedEventLogMessage);
+
     BMCWEB_ROUTE(app, "/redfish/v1/Systems/<str>/LogServices/EventLog/Entries/")
         .privileges(redfish::privileges::getLogEntryCollection)
         .methods(boost::beast::http::verb::get)(
@@ -1794,6 +2297,7 @@ inline void requestRoutesJournalEventLogEntryCollection(App& app)
         query_param::QueryCapabilities capabilities = {
             .canDelegateTop = true,
             .canDelegateSkip = true,
+            .canDelegateFilter = true,
         };
         query_param::Query delegatedQuery;
         if (!redfish::setUpRedfishRouteWithDelegation(
@@ -1823,59 +2327,45 @@ inline void requestRoutesJournalEventLogEntryCollection(App& app)
 
         nlohmann::json& logEntryArray = asyncResp->res.jsonValue["Members"];
         logEntryArray = nlohmann::json::array();
-        // Go through the log files and create a unique ID for each
-        // entry
-        std::vector<std::filesystem::path> redfishLogFiles;
-        getRedfishLogFiles(redfishLogFiles);
-        uint64_t entryCount = 0;
-        std::string logEntry;
 
-        // Oldest logs are in the last file, so start there and loop
-        // backwards
-        for (auto it = redfishLogFiles.rbegin(); it < redfishLogFiles.rend();
-             it++)
+        event_log::EventLogIndex& index =
+            event_log::EventLogIndex::getInstance();
+        index.refresh();
+
+        if (delegatedQuery.filter)
         {
-            std::ifstream logStream(*it);
-            if (!logStream.is_open())
+            handleFilteredEventLogEntries(asyncResp, *delegatedQuery.filter,
+                                          skip, top);
+            return;
+        }
+
+        bool failed = false;
+        index.forEachEntry(
+            skip, top,
+            [&logEntryArray, &failed](const std::string& idStr,
+                                      const std::string& logEntry) {
+            nlohmann::json::object_t bmcLogEntry;
+            LogParseError status = fillEventLogEntryJson(idStr, logEntry,
+                                                         bmcLogEntry);
+            if (status == LogParseError::messageIdNotInRegistry)
             {
-                continue;
+                return true;
             }
-
-            // Reset the unique ID on the first entry
-            bool firstEntry = true;
-            while (std::getline(logStream, logEntry))
+            if (status != LogParseError::success)
             {
-                std::string idStr;
-                if (!getUniqueEntryID(logEntry, idStr, firstEntry))
-                {
-                    continue;
-                }
-                firstEntry = false;
-
-                nlohmann::json::object_t bmcLogEntry;
-                LogParseError status = fillEventLogEntryJson(idStr, logEntry,
-                                                             bmcLogEntry);
-                if (status == LogParseError::messageIdNotInRegistry)
-                {
-                    continue;
-                }
-                if (status != LogParseError::success)
-                {
-                    messages::internalError(asyncResp->res);
-                    return;
-                }
-
-                entryCount++;
-                // Handle paging using skip (number of entries to skip from the
-                // start) and top (number of entries to display)
-                if (entryCount <= skip || entryCount > skip + top)
-                {
-                    continue;
-                }
-
-                logEntryArray.push_back(std::move(bmcLogEntry));
+                failed = true;
+                return false;
             }
+            logEntryArray.push_back(std::move(bmcLogEntry));
+            return true;
+        });
+        if (failed)
+        {
+            messages::internalError(asyncResp->res);
+            return;
         }
+
+        size_t entryCount = index.size();
         asyncResp->res.jsonValue["Members@odata.count"] = entryCount;
         if (skip + top < entryCount)
         {
@@ -1909,76 +2399,26 @@ inline void requestRoutesJournalEventLogEntry(App& app)
 
         const std::string& targetID = param;
 
-        // Go through the log files and check the unique ID for each
-        // entry to find the target entry
-        std::vector<std::filesystem::path> redfishLogFiles;
-        getRedfishLogFiles(redfishLogFiles);
-        std::string logEntry;
+        event_log::EventLogIndex& index =
+            event_log::EventLogIndex::getInstance();
+        index.refresh();
 
-        // Oldest logs are in the last file, so start there and loop
-        // backwards
-        for (auto it = redfishLogFiles.rbegin(); it < redfishLogFiles.rend();
-             it++)
+        std::string logEntry;
+        if (!index.readEntry(targetID, logEntry))
         {
-            std::ifstream logStream(*it);
-            if (!logStream.is_open())
-            {
-                continue;
-            }
-
-            // Reset the unique ID on the first entry
-            bool firstEntry = true;
-            while (std::getline(logStream, logEntry))
-            {
-                std::string idStr;
-                if (!getUniqueEntryID(logEntry, idStr, firstEntry))
-                {
-                    continue;
-                }
-                firstEntry = false;
-
-                if (idStr == targetID)
-                {
-                    nlohmann::json::object_t bmcLogEntry;
-                    LogParseError status =
-                        fillEventLogEntryJson(idStr, logEntry, bmcLogEntry);
-                    if (status != LogParseError::success)
-                    {
-                        messages::internalError(asyncResp->res);
-                        return;
-                    }
-                    asyncResp->res.jsonValue.update(bmcLogEntry);
-                    return;
-                }
-            }
+            messages::resourceNotFound(asyncResp->res, "LogEntry", targetID);
+            return;
         }
-        // Requested ID was not found
-        messages::resourceNotFound(asyncResp->res, "LogEntry", targetID);
-    });
-}
-
-template <typename Callback>
-void getHiddenPropertyValue(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-                            const std::string& entryId, Callback&& callback)
-{
-    auto respHandler = [callback{std::forward<Callback>(callback)},
-                        asyncResp](const boost::system::error_code ec,
-                                   const bool& hiddenProperty) {
-        if (ec)
+        nlohmann::json::object_t bmcLogEntry;
+        LogParseError status = fillEventLogEntryJson(targetID, logEntry,
+                                                     bmcLogEntry);
+        if (status != LogParseError::success)
         {
-            BMCWEB_LOG_ERROR << "DBUS response error: " << ec;
             messages::internalError(asyncResp->res);
             return;
         }
-
-        callback(hiddenProperty);
-    };
-
-    // Get the Hidden Property
-    sdbusplus::asio::getProperty<bool>(
-        *crow::connections::systemBus, "xyz.openbmc_project.Logging",
-        "/xyz/openbmc_project/logging/entry/" + entryId,
-        "org.open_power.Logging.PEL.Entry", "Hidden", respHandler);
+        asyncResp->res.jsonValue.update(bmcLogEntry);
+    });
 }
 
 inline void updateProperty(const std::optional<bool>& resolved,
@@ -2058,260 +2498,1162 @@ inline void
         "xyz.openbmc_project.Object.Delete", "Delete");
 }
 
-inline void requestRoutesDBusEventLogEntryCollection(App& app)
+enum class DBusEventLogParse
 {
-    BMCWEB_ROUTE(app, "/redfish/v1/Systems/<str>/LogServices/EventLog/Entries/")
-        .privileges(redfish::privileges::getLogEntryCollection)
-        .methods(boost::beast::http::verb::get)(
-            [&app](const crow::Request& req,
-                   const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-                   const std::string& systemName) {
-        if (!redfish::setUpRedfishRoute(app, req, asyncResp))
+    success,
+    skip,
+    error,
+};
+
+// Returns the Id of an EventLog entry if it is one that the collection lists;
+// that is, it has all the properties fillDBusEventLogEntryJson requires and
+// isn't hidden.
+inline std::optional<uint32_t> getVisibleDBusEventLogEntryId(
+    const dbus::utility::ManagedObjectType::value_type& object)
+{
+    std::optional<uint32_t> id;
+    size_t requiredFound = 0;
+    std::optional<bool> hidden;
+    for (const auto& [interface, properties] : object.second)
+    {
+        if (interface == "xyz.openbmc_project.Logging.Entry")
         {
-            return;
+            for (const auto& [name, value] : properties)
+            {
+                if (name == "Id")
+                {
+                    const uint32_t* idValue = std::get_if<uint32_t>(&value);
+                    if (idValue != nullptr)
+                    {
+                        id = *idValue;
+                    }
+                }
+                else if ((name == "Timestamp" || name == "UpdateTimestamp") &&
+                         std::holds_alternative<uint64_t>(value))
+                {
+                    requiredFound++;
+                }
+                else if ((name == "Severity" || name == "EventId") &&
+                         std::holds_alternative<std::string>(value))
+                {
+                    requiredFound++;
+                }
+            }
         }
-        if (systemName != "system")
+        else if (interface == "org.open_power.Logging.PEL.Entry")
         {
-            messages::resourceNotFound(asyncResp->res, "ComputerSystem",
-                                       systemName);
-            return;
-        }
-
-        // Collections don't include the static data added by SubRoute
-        // because it has a duplicate entry for members
-        asyncResp->res.jsonValue["@odata.type"] =
-            "#LogEntryCollection.LogEntryCollection";
-        asyncResp->res.jsonValue["@odata.id"] =
-            "/redfish/v1/Systems/system/LogServices/EventLog/Entries";
-        asyncResp->res.jsonValue["Name"] = "System Event Log Entries";
-        asyncResp->res.jsonValue["Description"] =
-            "Collection of System Event Log Entries";
-
-        // DBus implementation of EventLog/Entries
-        // Make call to Logging Service to find all log entry objects
-        crow::connections::systemBus->async_method_call(
-            [asyncResp](const boost::system::error_code ec,
-                        const dbus::utility::ManagedObjectType& resp) {
-            if (ec)
+            for (const auto& [name, value] : properties)
             {
-                // TODO Handle for specific error code
-                BMCWEB_LOG_ERROR
-                    << "getLogEntriesIfaceData resp_handler got error " << ec;
-                messages::internalError(asyncResp->res);
-                return;
+                if (name == "Hidden")
+                {
+                    const bool* hiddenValue = std::get_if<bool>(&value);
+                    if (hiddenValue != nullptr)
+                    {
+                        hidden = *hiddenValue;
+                    }
+                }
+                else if (name == "Subsystem" &&
+                         std::holds_alternative<std::string>(value))
+                {
+                    requiredFound++;
+                }
             }
-            nlohmann::json& entriesArray = asyncResp->res.jsonValue["Members"];
-            entriesArray = nlohmann::json::array();
-            for (const auto& objectPath : resp)
-            {
-                const uint32_t* id = nullptr;
-                const uint64_t* timestamp = nullptr;
-                const uint64_t* updateTimestamp = nullptr;
-                const std::string* severity = nullptr;
-                const std::string* subsystem = nullptr;
-                const std::string* filePath = nullptr;
-                const std::string* resolution = nullptr;
-                const std::string* eventId = nullptr;
-                const bool* resolved = nullptr;
-                const bool* hidden = nullptr;
-                const std::string* notify = nullptr;
+        }
+    }
+    // Hidden logs are part of CELogs
+    if (!id || requiredFound != 5 || !hidden || *hidden)
+    {
+        return std::nullopt;
+    }
+    return id;
+}
+
+inline DBusEventLogParse fillDBusEventLogEntryJson(
+    const dbus::utility::ManagedObjectType::value_type& object,
+    nlohmann::json& thisEntry)
+{
+    const uint32_t* id = nullptr;
+    const uint64_t* timestamp = nullptr;
+    const uint64_t* updateTimestamp = nullptr;
+    const std::string* severity = nullptr;
+    const std::string* subsystem = nullptr;
+    const std::string* filePath = nullptr;
+    const std::string* resolution = nullptr;
+    const std::string* eventId = nullptr;
+    const bool* resolved = nullptr;
+    const bool* hidden = nullptr;
+    const std::string* notify = nullptr;
 #ifdef BMCWEB_ENABLE_IBM_MANAGEMENT_CONSOLE
-                const bool* managementSystemAck = nullptr;
+    const bool* managementSystemAck = nullptr;
 #endif
 
-                for (const auto& interfaceMap : objectPath.second)
+    for (const auto& interfaceMap : object.second)
+    {
+        if (interfaceMap.first == "xyz.openbmc_project.Logging.Entry")
+        {
+            for (const auto& propertyMap : interfaceMap.second)
+            {
+                if (propertyMap.first == "Id")
+                {
+                    id = std::get_if<uint32_t>(&propertyMap.second);
+                }
+                else if (propertyMap.first == "Timestamp")
+                {
+                    timestamp = std::get_if<uint64_t>(&propertyMap.second);
+                }
+                else if (propertyMap.first == "UpdateTimestamp")
+                {
+                    updateTimestamp =
+                        std::get_if<uint64_t>(&propertyMap.second);
+                }
+                else if (propertyMap.first == "Severity")
+                {
+                    severity = std::get_if<std::string>(&propertyMap.second);
+                }
+                else if (propertyMap.first == "Resolution")
+                {
+                    resolution = std::get_if<std::string>(&propertyMap.second);
+                }
+                else if (propertyMap.first == "EventId")
                 {
-                    if (interfaceMap.first ==
-                        "xyz.openbmc_project.Logging.Entry")
+                    eventId = std::get_if<std::string>(&propertyMap.second);
+                    if (eventId == nullptr)
                     {
-                        for (const auto& propertyMap : interfaceMap.second)
-                        {
-                            if (propertyMap.first == "Id")
-                            {
-                                id = std::get_if<uint32_t>(&propertyMap.second);
-                            }
-                            else if (propertyMap.first == "Timestamp")
-                            {
-                                timestamp =
-                                    std::get_if<uint64_t>(&propertyMap.second);
-                            }
-                            else if (propertyMap.first == "UpdateTimestamp")
-                            {
-                                updateTimestamp =
-                                    std::get_if<uint64_t>(&propertyMap.second);
-                            }
-                            else if (propertyMap.first == "Severity")
-                            {
-                                severity = std::get_if<std::string>(
-                                    &propertyMap.second);
-                            }
-                            else if (propertyMap.first == "Resolution")
-                            {
-                                resolution = std::get_if<std::string>(
-                                    &propertyMap.second);
-                            }
-                            else if (propertyMap.first == "EventId")
-                            {
-                                eventId = std::get_if<std::string>(
-                                    &propertyMap.second);
-                                if (eventId == nullptr)
-                                {
-                                    messages::internalError(asyncResp->res);
-                                    return;
-                                }
-                            }
-                            else if (propertyMap.first == "Resolved")
-                            {
-                                resolved =
-                                    std::get_if<bool>(&propertyMap.second);
-                                if (resolved == nullptr)
-                                {
-                                    messages::internalError(asyncResp->res);
-                                    return;
-                                }
-                            }
-                            else if (propertyMap.first ==
-                                     "ServiceProviderNotify")
-                            {
-                                notify = std::get_if<std::string>(
-                                    &propertyMap.second);
-                                if (notify == nullptr)
-                                {
-                                    messages::internalError(asyncResp->res);
-                                    return;
-                                }
-                            }
-                        }
-                        if (id == nullptr || severity == nullptr)
-                        {
-                            messages::internalError(asyncResp->res);
-                            return;
-                        }
+                        return DBusEventLogParse::error;
                     }
-                    else if (interfaceMap.first ==
-                             "xyz.openbmc_project.Common.FilePath")
+                }
+                else if (propertyMap.first == "Resolved")
+                {
+                    resolved = std::get_if<bool>(&propertyMap.second);
+                    if (resolved == nullptr)
                     {
-                        for (const auto& propertyMap : interfaceMap.second)
-                        {
-                            if (propertyMap.first == "Path")
-                            {
-                                filePath = std::get_if<std::string>(
-                                    &propertyMap.second);
-                            }
-                        }
+                        return DBusEventLogParse::error;
                     }
-                    else if (interfaceMap.first ==
-                             "org.open_power.Logging.PEL.Entry")
+                }
+                else if (propertyMap.first == "ServiceProviderNotify")
+                {
+                    notify = std::get_if<std::string>(&propertyMap.second);
+                    if (notify == nullptr)
                     {
-                        for (const auto& propertyMap : interfaceMap.second)
-                        {
-                            if (propertyMap.first == "Hidden")
-                            {
-                                hidden = std::get_if<bool>(&propertyMap.second);
-                                if (hidden == nullptr)
-                                {
-                                    messages::internalError(asyncResp->res);
-                                    return;
-                                }
-                            }
-                            else if (propertyMap.first == "Subsystem")
-                            {
-                                subsystem = std::get_if<std::string>(
-                                    &propertyMap.second);
-                                if (subsystem == nullptr)
-                                {
-                                    messages::internalError(asyncResp->res);
-                                    return;
-                                }
-                            }
+                        return DBusEventLogParse::error;
+                    }
+                }
+            }
+            if (id == nullptr || severity == nullptr)
+            {
+                return DBusEventLogParse::error;
+            }
+        }
+        else if (interfaceMap.first == "xyz.openbmc_project.Common.FilePath")
+        {
+            for (const auto& propertyMap : interfaceMap.second)
+            {
+                if (propertyMap.first == "Path")
+                {
+                    filePath = std::get_if<std::string>(&propertyMap.second);
+                }
+            }
+        }
+        else if (interfaceMap.first == "org.open_power.Logging.PEL.Entry")
+        {
+            for (const auto& propertyMap : interfaceMap.second)
+            {
+                if (propertyMap.first == "Hidden")
+                {
+                    hidden = std::get_if<bool>(&propertyMap.second);
+                    if (hidden == nullptr)
+                    {
+                        return DBusEventLogParse::error;
+                    }
+                }
+                else if (propertyMap.first == "Subsystem")
+                {
+                    subsystem = std::get_if<std::string>(&propertyMap.second);
+                    if (subsystem == nullptr)
+                    {
+                        return DBusEventLogParse::error;
+                    }
+                }
 #ifdef BMCWEB_ENABLE_IBM_MANAGEMENT_CONSOLE
-                            else if (propertyMap.first == "ManagementSystemAck")
-                            {
-                                managementSystemAck =
-                                    std::get_if<bool>(&propertyMap.second);
-                                if (managementSystemAck == nullptr)
-                                {
-                                    messages::internalError(asyncResp->res);
-                                    return;
-                                }
-                            }
+                else if (propertyMap.first == "ManagementSystemAck")
+                {
+                    managementSystemAck =
+                        std::get_if<bool>(&propertyMap.second);
+                    if (managementSystemAck == nullptr)
+                    {
+                        return DBusEventLogParse::error;
+                    }
+                }
 #endif
-                        }
+            }
+        }
+    }
+    // Object path without the xyz.openbmc_project.Logging.Entry interface,
+    // ignore it.
+    if (id == nullptr || eventId == nullptr || severity == nullptr ||
+        timestamp == nullptr || updateTimestamp == nullptr ||
+        hidden == nullptr || subsystem == nullptr)
+    {
+        return DBusEventLogParse::skip;
+    }
+
+    // Hidden logs are part of CELogs, ignore them.
+    if (*hidden)
+    {
+        return DBusEventLogParse::skip;
+    }
+
+    thisEntry["@odata.type"] = "#LogEntry.v1_9_0.LogEntry";
+    thisEntry["@odata.id"] =
+        "/redfish/v1/Systems/system/LogServices/EventLog/Entries/" +
+        std::to_string(*id);
+    thisEntry["Name"] = "System Event Log Entry";
+    thisEntry["Id"] = std::to_string(*id);
+    thisEntry["EventId"] = *eventId;
+    thisEntry["Message"] = (*eventId).substr(0, 8) +
+                           " event in subsystem: " + *subsystem;
+    thisEntry["Resolved"] = *resolved;
+    if ((resolution != nullptr) && (!(*resolution).empty()))
+    {
+        thisEntry["Resolution"] = *resolution;
+    }
+    thisEntry["EntryType"] = "Event";
+    thisEntry["Severity"] = translateSeverityDbusToRedfish(*severity);
+    thisEntry["Created"] = redfish::time_utils::getDateTimeUintMs(*timestamp);
+    thisEntry["Modified"] =
+        redfish::time_utils::getDateTimeUintMs(*updateTimestamp);
+    std::optional<bool> notifyAction = getProviderNotifyAction(*notify);
+    if (notifyAction)
+    {
+        thisEntry["ServiceProviderNotified"] = *notifyAction;
+    }
+
+    thisEntry["Oem"]["IBM"]["@odata.id"] =
+        "/redfish/v1/Systems/system/LogServices/EventLog/Entries/" +
+        std::to_string(*id) + "/OemPelAttachment";
+    if (filePath != nullptr)
+    {
+        thisEntry["AdditionalDataURI"] =
+            "/redfish/v1/Systems/system/LogServices/EventLog/Entries/" +
+            std::to_string(*id) + "/attachment";
+    }
+#ifdef BMCWEB_ENABLE_IBM_MANAGEMENT_CONSOLE
+    thisEntry["Oem"]["OpenBMC"]["@odata.type"] = "#OemLogEntry.v1_0_0.LogEntry";
+    thisEntry["Oem"]["OpenBMC"]["ManagementSystemAck"] = *managementSystemAck;
+#endif
+    return DBusEventLogParse::success;
+}
+
+// Fills thisEntry from a CELog entry object; see DBusEventLogParse
+inline DBusEventLogParse fillDBusCELogEntryJson(
+    const dbus::utility::ManagedObjectType::value_type& object,
+    nlohmann::json& thisEntry)
+{
+    const uint32_t* id = nullptr;
+    const uint64_t* timestamp = nullptr;
+    const uint64_t* updateTimestamp = nullptr;
+    const std::string* severity = nullptr;
+    const std::string* subsystem = nullptr;
+    const std::string* filePath = nullptr;
+    const std::string* eventId = nullptr;
+    const std::string* resolution = nullptr;
+    bool resolved = false;
+    const bool* hidden = nullptr;
+    const std::string* notify = nullptr;
+#ifdef BMCWEB_ENABLE_IBM_MANAGEMENT_CONSOLE
+    bool managementSystemAck = false;
+#endif
+
+    for (const auto& interfaceMap : object.second)
+    {
+        if (interfaceMap.first == "xyz.openbmc_project.Logging.Entry")
+        {
+            for (const auto& propertyMap : interfaceMap.second)
+            {
+                if (propertyMap.first == "Id")
+                {
+                    id = std::get_if<uint32_t>(&propertyMap.second);
+                }
+                else if (propertyMap.first == "Timestamp")
+                {
+                    timestamp = std::get_if<uint64_t>(&propertyMap.second);
+                }
+                else if (propertyMap.first == "UpdateTimestamp")
+                {
+                    updateTimestamp =
+                        std::get_if<uint64_t>(&propertyMap.second);
+                }
+                else if (propertyMap.first == "Severity")
+                {
+                    severity = std::get_if<std::string>(&propertyMap.second);
+                }
+                else if (propertyMap.first == "Resolution")
+                {
+                    resolution = std::get_if<std::string>(&propertyMap.second);
+                }
+                else if (propertyMap.first == "EventId")
+                {
+                    eventId = std::get_if<std::string>(&propertyMap.second);
+                    if (eventId == nullptr)
+                    {
+                        return DBusEventLogParse::error;
                     }
                 }
-                // Object path without the
-                // xyz.openbmc_project.Logging.Entry interface, ignore
-                // and continue.
-                if (id == nullptr || eventId == nullptr ||
-                    severity == nullptr || timestamp == nullptr ||
-                    updateTimestamp == nullptr || hidden == nullptr ||
-                    subsystem == nullptr)
+                else if (propertyMap.first == "Resolved")
                 {
-                    continue;
+                    const bool* resolveptr =
+                        std::get_if<bool>(&propertyMap.second);
+                    if (resolveptr == nullptr)
+                    {
+                        return DBusEventLogParse::error;
+                    }
+                    resolved = *resolveptr;
+                }
+                else if (propertyMap.first == "ServiceProviderNotify")
+                {
+                    notify = std::get_if<std::string>(&propertyMap.second);
+                    if (notify == nullptr)
+                    {
+                        return DBusEventLogParse::error;
+                    }
+                }
+            }
+            if (id == nullptr || severity == nullptr)
+            {
+                return DBusEventLogParse::error;
+            }
+        }
+        else if (interfaceMap.first == "xyz.openbmc_project.Common.FilePath")
+        {
+            for (const auto& propertyMap : interfaceMap.second)
+            {
+                if (propertyMap.first == "Path")
+                {
+                    filePath = std::get_if<std::string>(&propertyMap.second);
                 }
+            }
+        }
+        else if (interfaceMap.first == "org.open_power.Logging.PEL.Entry")
+        {
+            for (const auto& propertyMap : interfaceMap.second)
+            {
+                if (propertyMap.first == "Hidden")
+                {
+                    hidden = std::get_if<bool>(&propertyMap.second);
+                    if (hidden == nullptr)
+                    {
+                        return DBusEventLogParse::error;
+                    }
+                }
+                else if (propertyMap.first == "Subsystem")
+                {
+                    subsystem = std::get_if<std::string>(&propertyMap.second);
+                    if (subsystem == nullptr)
+                    {
+                        return DBusEventLogParse::error;
+                    }
+                }
+#ifdef BMCWEB_ENABLE_IBM_MANAGEMENT_CONSOLE
+                else if (propertyMap.first == "ManagementSystemAck")
+                {
+                    const bool* managementSystemAckptr =
+                        std::get_if<bool>(&propertyMap.second);
+                    if (managementSystemAckptr == nullptr)
+                    {
+                        return DBusEventLogParse::error;
+                    }
+                    managementSystemAck = *managementSystemAckptr;
+                }
+#endif
+            }
+        }
+    }
+    // Object path without the xyz.openbmc_project.Logging.Entry interface,
+    // ignore and continue.
+    if (id == nullptr || eventId == nullptr || severity == nullptr ||
+        timestamp == nullptr || updateTimestamp == nullptr ||
+        hidden == nullptr || subsystem == nullptr)
+    {
+        return DBusEventLogParse::skip;
+    }
+
+    // Part of Event Logs, ignore and continue
+    if (!(*hidden))
+    {
+        return DBusEventLogParse::skip;
+    }
+
+    thisEntry["@odata.type"] = "#LogEntry.v1_9_0.LogEntry";
+    thisEntry["@odata.id"] =
+        "/redfish/v1/Systems/system/LogServices/CELog/Entries/" +
+        std::to_string(*id);
+    thisEntry["Name"] = "System Event Log Entry";
+    thisEntry["Id"] = std::to_string(*id);
+    thisEntry["EventId"] = *eventId;
+    thisEntry["Message"] = (*eventId).substr(0, 8) +
+                           " event in subsystem: " + *subsystem;
+    thisEntry["Resolved"] = resolved;
+    if ((resolution != nullptr) && (!(*resolution).empty()))
+    {
+        thisEntry["Resolution"] = *resolution;
+    }
+    thisEntry["EntryType"] = "Event";
+    thisEntry["Severity"] = translateSeverityDbusToRedfish(*severity);
+    thisEntry["Created"] = redfish::time_utils::getDateTimeUintMs(*timestamp);
+    thisEntry["Modified"] =
+        redfish::time_utils::getDateTimeUintMs(*updateTimestamp);
+    std::optional<bool> notifyAction = getProviderNotifyAction(*notify);
+    if (notifyAction)
+    {
+        thisEntry["ServiceProviderNotified"] = *notifyAction;
+    }
+
+    thisEntry["Oem"]["IBM"]["@odata.id"] =
+        "/redfish/v1/Systems/system/LogServices/CELog/Entries/" +
+        std::to_string(*id) + "/OemPelAttachment";
+    if (filePath != nullptr)
+    {
+        thisEntry["AdditionalDataURI"] =
+            "/redfish/v1/Systems/system/LogServices/CELog/Entries/" +
+            std::to_string(*id) + "/attachment";
+    }
+#ifdef BMCWEB_ENABLE_IBM_MANAGEMENT_CONSOLE
+    thisEntry["Oem"]["OpenBMC"]["@odata.type"] = "#OemLogEntry.v1_0_0.LogEntry";
+    thisEntry["Oem"]["OpenBMC"]["ManagementSystemAck"] = managementSystemAck;
+#endif
+    return DBusEventLogParse::success;
+}
+
+/**
+ * @brief A D-Bus log entry rendered as an EventLog or CELog LogEntry.
+ */
+struct RenderedLogEntry
+{
+    uint32_t id = 0;
+    DBusEventLogParse status = DBusEventLogParse::skip;
+    nlohmann::json json;
+    // json as a line of newline delimited json, for streamed exports
+    std::string line;
+};
+
+using RenderedLogEntries =
+    std::vector<std::shared_ptr<const RenderedLogEntry>>;
+
+/**
+ * @brief A logging service object with its EventLog and CELog renderings,
+ * each nullptr if that collection doesn't list it.
+ */
+struct DBusLogObject
+{
+    dbus::utility::ManagedObjectType::value_type object;
+    std::shared_ptr<const RenderedLogEntry> eventLog;
+    std::shared_ptr<const RenderedLogEntry> ceLog;
+};
+
+/**
+ * @brief What the EventLog and CELog collections list: EventLog entries by
+ * numeric Id, and CELog entries in object path order, which is the order of
+ * their Ids as strings.  ceLogError is set if a CELog entry couldn't be
+ * rendered.
+ */
+struct DBusLogSnapshot
+{
+    RenderedLogEntries eventLog;
+    RenderedLogEntries ceLog;
+    bool ceLogError = false;
+};
+
+/**
+ * @brief Every logging service object, with each entry rendered once as the
+ * LogEntry the EventLog or CELog collection lists.
+ *
+ * The objects are read with one GetManagedObjects on first use.  After that
+ * they are kept up to date entry by entry: an entry added, removed or
+ * changed, say by being marked Resolved, is rendered again on its own while
+ * the other entries keep their rendering.  A collection GET then only
+ * copies out the rendered entries of its page, and a streamed export writes
+ * out their lines as they are.  The objects are kept by path, which is
+ * derived from the entry's Redfish ID, so a single entry is found without
+ * asking the logging service.  A well known name changing owner drops
+ * everything, to be read again on next use.
+ */
+class DBusLogEntryCache
+{
+  public:
+    static constexpr std::string_view loggingRoot =
+        "/xyz/openbmc_project/logging";
+
+    using Callback =
+        std::function<void(const boost::system::error_code&,
+                           const std::shared_ptr<const DBusLogSnapshot>&)>;
+    using EntryCallback =
+        std::function<void(const boost::system::error_code&,
+                           const dbus::utility::DBusPropertiesMap*)>;
+
+    static DBusLogEntryCache& getInstance()
+    {
+        static DBusLogEntryCache cache;
+        return cache;
+    }
+
+    DBusLogEntryCache(const DBusLogEntryCache&) = delete;
+    DBusLogEntryCache(DBusLogEntryCache&&) = delete;
+    DBusLogEntryCache& operator=(const DBusLogEntryCache&) = delete;
+    DBusLogEntryCache& operator=(DBusLogEntryCache&&) = delete;
+    ~DBusLogEntryCache() = default;
+
+    void registerMatches(sdbusplus::asio::connection& conn)
+    {
+        namespace rules = sdbusplus::bus::match::rules;
+        std::string root(loggingRoot);
+
+        matches.clear();
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn,
+            rules::type::signal() + rules::member("PropertiesChanged") +
+                rules::interface("org.freedesktop.DBus.Properties") +
+                rules::path_namespace(root),
+            [this](sdbusplus::message_t& msg) { onPropertiesChanged(msg); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::interfacesAdded() + rules::path_namespace(root),
+            [this](sdbusplus::message_t& msg) { onInterfacesAdded(msg); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::interfacesRemoved() + rules::path_namespace(root),
+            [this](sdbusplus::message_t& msg) { onInterfacesRemoved(msg); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::nameOwnerChanged(), [this](sdbusplus::message_t& msg) {
+            std::string name;
+            msg.read(name);
+            if (!name.starts_with(':'))
+            {
+                clear();
+            }
+        }));
+        clear();
+    }
+
+    bool enabled() const
+    {
+        return !matches.empty();
+    }
+
+    /**
+     * @brief Calls callback with what the collections list, reading the
+     * logging service if it isn't cached.  The callback is never called
+     * inline.
+     */
+    void get(Callback&& callback)
+    {
+        if (loaded)
+        {
+            if (!snapshot)
+            {
+                snapshot = buildSnapshot(objects);
+            }
+            std::shared_ptr<const DBusLogSnapshot> current = snapshot;
+            boost::asio::post(crow::connections::systemBus->get_io_context(),
+                              [current, callback{std::move(callback)}]() {
+                callback(boost::system::error_code(), current);
+            });
+            return;
+        }
+
+        callbacks.emplace_back(std::move(callback));
+        if (callbacks.size() > 1)
+        {
+            return;
+        }
+        crow::dbus_trace::SharedCallScope sharedCalls;
+        crow::connections::bulkBus->async_method_call(
+            [this, fetchGeneration{generation}](
+                const boost::system::error_code& ec,
+                dbus::utility::ManagedObjectType& resp) {
+            complete(fetchGeneration, ec, resp);
+        },
+            "xyz.openbmc_project.Logging", std::string(loggingRoot),
+            "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
+    }
+
+    /**
+     * @brief Calls callback with every property of the entry with Redfish ID
+     * entryID, or with nullptr if there is no such entry.  Once the logging
+     * service is cached this is a lookup by object path; before that the
+     * cache is loaded first, or the entry is read on its own if the cache
+     * isn't kept.  The callback is never called inline.
+     */
+    void getEntry(const std::string& entryID, EntryCallback&& callback)
+    {
+        std::string path = std::string(loggingRoot) + "/entry/" + entryID;
+        if (loaded)
+        {
+            auto properties = findEntry(path);
+            boost::asio::post(
+                crow::connections::systemBus->get_io_context(),
+                [properties, callback{std::move(callback)}]() {
+                callback(boost::system::error_code(), properties.get());
+            });
+            return;
+        }
+        if (!enabled())
+        {
+            readEntry(path, std::move(callback));
+            return;
+        }
+        get([this, path, callback{std::move(callback)}](
+                const boost::system::error_code& ec,
+                const std::shared_ptr<const DBusLogSnapshot>&) mutable {
+            if (ec)
+            {
+                callback(ec, nullptr);
+                return;
+            }
+            if (!loaded)
+            {
+                // The read raced with a change and wasn't kept
+                readEntry(path, std::move(callback));
+                return;
+            }
+            auto properties = findEntry(path);
+            callback(ec, properties.get());
+        });
+    }
+
+    // The journal of logging objects changed, while signals are followed
+    const ChangeJournal* changes() const
+    {
+        return enabled() ? &journal : nullptr;
+    }
+
+    void clear()
+    {
+        objects.clear();
+        loaded = false;
+        snapshot.reset();
+        generation++;
+        journal.reset();
+    }
+
+  private:
+    using ObjectMap = boost::container::flat_map<std::string, DBusLogObject>;
+
+    DBusLogEntryCache() = default;
+
+    static void finishRendering(RenderedLogEntry& rendered)
+    {
+        if (rendered.status == DBusEventLogParse::success)
+        {
+            rendered.line = rendered.json.dump(
+                -1, ' ', true, nlohmann::json::error_handler_t::replace);
+            rendered.line += '\n';
+        }
+    }
+
+    static void render(DBusLogObject& entry)
+    {
+        entry.eventLog.reset();
+        entry.ceLog.reset();
+
+        // The EventLog lists whatever has an Id and isn't hidden, even if it
+        // then fails to render
+        std::optional<uint32_t> id =
+            getVisibleDBusEventLogEntryId(entry.object);
+        if (id)
+        {
+            auto rendered = std::make_shared<RenderedLogEntry>();
+            rendered->id = *id;
+            rendered->status = fillDBusEventLogEntryJson(entry.object,
+                                                         rendered->json);
+            finishRendering(*rendered);
+            entry.eventLog = std::move(rendered);
+        }
+
+        auto rendered = std::make_shared<RenderedLogEntry>();
+        rendered->status = fillDBusCELogEntryJson(entry.object,
+                                                  rendered->json);
+        if (rendered->status != DBusEventLogParse::skip)
+        {
+            finishRendering(*rendered);
+            entry.ceLog = std::move(rendered);
+        }
+    }
+
+    // Every property of the cached object at path, as a GetAll on all of
+    // its interfaces would return them
+    std::shared_ptr<dbus::utility::DBusPropertiesMap>
+        findEntry(const std::string& path) const
+    {
+        auto it = objects.find(path);
+        if (it == objects.end())
+        {
+            return nullptr;
+        }
+        auto properties = std::make_shared<dbus::utility::DBusPropertiesMap>();
+        for (const auto& [interface, values] : it->second.object.second)
+        {
+            properties->insert(properties->end(), values.begin(), values.end());
+        }
+        return properties;
+    }
+
+    static void readEntry(const std::string& path, EntryCallback&& callback)
+    {
+        sdbusplus::asio::getAllProperties(
+            *crow::connections::systemBus, "xyz.openbmc_project.Logging", path,
+            "",
+            [callback{std::move(callback)}](
+                const boost::system::error_code& ec,
+                const dbus::utility::DBusPropertiesMap& properties) {
+            if (ec.value() == EBADR)
+            {
+                callback(boost::system::error_code(), nullptr);
+                return;
+            }
+            callback(ec, ec ? nullptr : &properties);
+        });
+    }
+
+    static std::shared_ptr<const DBusLogSnapshot>
+        buildSnapshot(const ObjectMap& objectMap)
+    {
+        auto built = std::make_shared<DBusLogSnapshot>();
+        for (const auto& [path, entry] : objectMap)
+        {
+            if (entry.eventLog)
+            {
+                built->eventLog.emplace_back(entry.eventLog);
+            }
+            if (entry.ceLog)
+            {
+                if (entry.ceLog->status == DBusEventLogParse::error)
+                {
+                    built->ceLogError = true;
+                }
+                else
+                {
+                    built->ceLog.emplace_back(entry.ceLog);
+                }
+            }
+        }
+        std::sort(built->eventLog.begin(), built->eventLog.end(),
+                  [](const auto& left, const auto& right) {
+            return left->id < right->id;
+        });
+        return built;
+    }
+
+    void complete(uint64_t fetchGeneration, const boost::system::error_code& ec,
+                  dbus::utility::ManagedObjectType& resp)
+    {
+        std::vector<Callback> waiting = std::move(callbacks);
+        callbacks.clear();
+
+        if (ec)
+        {
+            BMCWEB_LOG_ERROR << "getLogEntriesIfaceData resp_handler got error "
+                             << ec;
+            for (Callback& callback : waiting)
+            {
+                callback(ec, nullptr);
+            }
+            return;
+        }
+
+        ObjectMap::sequence_type read;
+        read.reserve(resp.size());
+        for (auto& object : resp)
+        {
+            std::string path = object.first.str;
+            DBusLogObject entry{std::move(object), nullptr, nullptr};
+            render(entry);
+            read.emplace_back(std::move(path), std::move(entry));
+        }
+        std::sort(read.begin(), read.end(),
+                  [](const auto& left, const auto& right) {
+            return left.first < right.first;
+        });
+        ObjectMap readMap;
+        readMap.adopt_sequence(boost::container::ordered_unique_range,
+                               std::move(read));
+
+        std::shared_ptr<const DBusLogSnapshot> built = buildSnapshot(readMap);
+        // A reply that raced with a change isn't kept
+        if (enabled() && fetchGeneration == generation)
+        {
+            objects = std::move(readMap);
+            loaded = true;
+            snapshot = built;
+        }
+        for (Callback& callback : waiting)
+        {
+            callback(ec, built);
+        }
+    }
+
+    // Returns the objects for modification, or nullptr when nothing is
+    // cached
+    ObjectMap* changing()
+    {
+        generation++;
+        snapshot.reset();
+        if (!loaded)
+        {
+            return nullptr;
+        }
+        return &objects;
+    }
+
+    static void updateInterface(dbus::utility::DBusInteracesMap& interfaces,
+                                const std::string& interface,
+                                const dbus::utility::DBusPropertiesMap& changed)
+    {
+        auto it = std::find_if(interfaces.begin(), interfaces.end(),
+                               [&interface](const auto& entry) {
+            return entry.first == interface;
+        });
+        if (it == interfaces.end())
+        {
+            interfaces.emplace_back(interface, changed);
+            return;
+        }
+        for (const auto& [name, value] : changed)
+        {
+            auto property = std::find_if(it->second.begin(), it->second.end(),
+                                         [&name](const auto& entry) {
+                return entry.first == name;
+            });
+            if (property == it->second.end())
+            {
+                it->second.emplace_back(name, value);
+            }
+            else
+            {
+                property->second = value;
+            }
+        }
+    }
+
+    void onPropertiesChanged(sdbusplus::message_t& msg)
+    {
+        std::string interface;
+        dbus::utility::DBusPropertiesMap changed;
+        try
+        {
+            msg.read(interface, changed);
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            BMCWEB_LOG_ERROR << "Failed to read log entry change: "
+                             << e.what();
+            clear();
+            return;
+        }
+        journal.record(msg.get_path());
+        ObjectMap* current = changing();
+        if (current == nullptr)
+        {
+            return;
+        }
+        auto it = current->find(msg.get_path());
+        if (it == current->end())
+        {
+            // Objects that aren't known yet are added by InterfacesAdded
+            return;
+        }
+        updateInterface(it->second.object.second, interface, changed);
+        render(it->second);
+    }
+
+    void onInterfacesAdded(sdbusplus::message_t& msg)
+    {
+        sdbusplus::message::object_path path;
+        dbus::utility::DBusInteracesMap interfaces;
+        try
+        {
+            msg.read(path, interfaces);
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            BMCWEB_LOG_ERROR << "Failed to read added log entry: " << e.what();
+            clear();
+            return;
+        }
+        journal.record(path.str);
+        ObjectMap* current = changing();
+        if (current == nullptr)
+        {
+            return;
+        }
+        auto it = current->find(path.str);
+        if (it == current->end())
+        {
+            it = current
+                     ->emplace(path.str, DBusLogObject{{path, {}}, nullptr,
+                                                       nullptr})
+                     .first;
+        }
+        for (const auto& [interface, properties] : interfaces)
+        {
+            updateInterface(it->second.object.second, interface, properties);
+        }
+        render(it->second);
+    }
+
+    void onInterfacesRemoved(sdbusplus::message_t& msg)
+    {
+        sdbusplus::message::object_path path;
+        std::vector<std::string> interfaces;
+        try
+        {
+            msg.read(path, interfaces);
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            BMCWEB_LOG_ERROR << "Failed to read removed log entry: "
+                             << e.what();
+            clear();
+            return;
+        }
+        journal.record(path.str);
+        ObjectMap* current = changing();
+        if (current == nullptr)
+        {
+            return;
+        }
+        auto it = current->find(path.str);
+        if (it == current->end())
+        {
+            return;
+        }
+        dbus::utility::DBusInteracesMap& remaining = it->second.object.second;
+        for (const std::string& interface : interfaces)
+        {
+            std::erase_if(remaining, [&interface](const auto& entry) {
+                return entry.first == interface;
+            });
+        }
+        if (remaining.empty())
+        {
+            current->erase(it);
+            return;
+        }
+        render(it->second);
+    }
+
+    ObjectMap objects;
+    // Set once objects holds the logging service's objects
+    bool loaded = false;
+    std::shared_ptr<const DBusLogSnapshot> snapshot;
+    std::vector<Callback> callbacks;
+    uint64_t generation = 0;
+    // Fed by the same signals, whether or not objects are loaded
+    ChangeJournal journal;
+    std::vector<std::unique_ptr<sdbusplus::bus::match_t>> matches;
+};
+
+/**
+ * @brief The URI in the collection at collectionUri of the logging entry at
+ * path, or an empty string if path isn't one.
+ */
+inline std::string dbusLogEntryUri(std::string_view collectionUri,
+                                   std::string_view path)
+{
+    constexpr std::string_view entryRoot =
+        "/xyz/openbmc_project/logging/entry/";
+    if (!path.starts_with(entryRoot) || path.size() == entryRoot.size() ||
+        path.find('/', entryRoot.size()) != std::string_view::npos)
+    {
+        return "";
+    }
+    std::string uri(collectionUri);
+    uri += '/';
+    uri += path.substr(entryRoot.size());
+    return uri;
+}
+
+/**
+ * @brief Sends the rendered entries [start, end) as newline delimited json,
+ * leaving out any that failed to render.  The generator keeps entries alive,
+ * so a list in a snapshot is passed by a pointer that shares the snapshot.
+ */
+inline void streamRenderedLogEntries(
+    crow::Response& res,
+    const std::shared_ptr<const RenderedLogEntries>& entries, size_t start,
+    size_t end)
+{
+    res.addHeader(boost::beast::http::field::content_type,
+                  "application/x-ndjson");
+    res.setBodyGenerator([entries, next{start},
+                          end](std::string& out, size_t chunkSize) mutable {
+        while (out.size() < chunkSize)
+        {
+            if (next >= end)
+            {
+                return false;
+            }
+            const RenderedLogEntry& entry = *(*entries)[next++];
+            if (entry.status == DBusEventLogParse::success)
+            {
+                out += entry.line;
+            }
+        }
+        return true;
+    });
+}
+
+template <typename Callback>
+void getHiddenPropertyValue(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+                            const std::string& entryId, Callback&& callback)
+{
+    DBusLogEntryCache::getInstance().getEntry(
+        entryId, [callback{std::forward<Callback>(callback)}, asyncResp,
+                  entryId](const boost::system::error_code& ec,
+                           const dbus::utility::DBusPropertiesMap* properties) {
+        if (ec)
+        {
+            BMCWEB_LOG_ERROR << "DBUS response error: " << ec;
+            messages::internalError(asyncResp->res);
+            return;
+        }
+        if (properties == nullptr)
+        {
+            messages::resourceNotFound(asyncResp->res, "LogEntry", entryId);
+            return;
+        }
+
+        const bool* hiddenProperty = nullptr;
+        const bool success = sdbusplus::unpackPropertiesNoThrow(
+            dbus_utils::UnpackErrorPrinter(), *properties, "Hidden",
+            hiddenProperty);
+        if (!success || hiddenProperty == nullptr)
+        {
+            messages::internalError(asyncResp->res);
+            return;
+        }
+
+        callback(*hiddenProperty);
+    });
+}
+
+inline void requestRoutesDBusEventLogEntryCollection(App& app)
+{
+    BMCWEB_ROUTE(app, "/redfish/v1/Systems/<str>/LogServices/EventLog/Entries/")
+        .privileges(redfish::privileges::getLogEntryCollection)
+        .methods(boost::beast::http::verb::get)(
+            [&app](const crow::Request& req,
+                   const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+                   const std::string& systemName) {
+        bool stream = isLogEntryStreamRequested(req);
+        query_param::QueryCapabilities capabilities = {
+            .canDelegateTop = true,
+            .canDelegateSkip = true,
+            .canDelegateFilter = true,
+            .canDelegateDeltaToken = !stream,
+        };
+        query_param::Query delegatedQuery;
+        if (!redfish::setUpRedfishRouteWithDelegation(
+                app, req, asyncResp, delegatedQuery, capabilities))
+        {
+            return;
+        }
+        // Changes are looked for among all the entries
+        size_t top = delegatedQuery.top.value_or(
+            stream || delegatedQuery.deltaToken
+                ? std::numeric_limits<size_t>::max()
+                : query_param::Query::maxTop);
+        size_t skip = delegatedQuery.skip.value_or(0);
+        if (systemName != "system")
+        {
+            messages::resourceNotFound(asyncResp->res, "ComputerSystem",
+                                       systemName);
+            return;
+        }
+        if (!stream &&
+            !setUpCollectionDelta(
+                asyncResp, delegatedQuery.deltaToken,
+                DBusLogEntryCache::getInstance().changes(),
+                std::bind_front(
+                    dbusLogEntryUri,
+                    "/redfish/v1/Systems/system/LogServices/EventLog/Entries")))
+        {
+            return;
+        }
 
-                // Hidden logs are part of CELogs, ignore and continue.
-                if (*hidden)
+        // Entries are ordered by their numeric Id, which only grows as new
+        // entries are logged, so $skip offsets (and the nextLink below) stay
+        // valid while entries are appended.  Each entry was rendered when it
+        // was logged, so $filter is checked against that rendering and only
+        // the requested window of the matches is copied out.
+        DBusLogEntryCache::getInstance().get(
+            [asyncResp, top, skip, stream,
+             filter{std::move(delegatedQuery.filter)}](
+                const boost::system::error_code& ec,
+                const std::shared_ptr<const DBusLogSnapshot>& snapshot) {
+            if (ec)
+            {
+                // TODO Handle for specific error code
+                messages::internalError(asyncResp->res);
+                return;
+            }
+            std::shared_ptr<const RenderedLogEntries> listed(
+                snapshot, &snapshot->eventLog);
+            if (filter)
+            {
+                auto matched = std::make_shared<RenderedLogEntries>();
+                for (const std::shared_ptr<const RenderedLogEntry>& entry :
+                     snapshot->eventLog)
                 {
-                    continue;
+                    if (entry->status != DBusEventLogParse::success ||
+                        filter->matches(entry->json))
+                    {
+                        matched->emplace_back(entry);
+                    }
                 }
+                listed = std::move(matched);
+            }
+            const RenderedLogEntries& visible = *listed;
+            size_t start = std::min(skip, visible.size());
+            size_t end = start + std::min(visible.size() - start, top);
+            if (stream)
+            {
+                streamRenderedLogEntries(asyncResp->res, listed, start, end);
+                return;
+            }
 
-                entriesArray.push_back({});
-                nlohmann::json& thisEntry = entriesArray.back();
-                thisEntry["@odata.type"] = "#LogEntry.v1_9_0.LogEntry";
-                thisEntry["@odata.id"] =
-                    "/redfish/v1/Systems/system/LogServices/EventLog/Entries/" +
-                    std::to_string(*id);
-                thisEntry["Name"] = "System Event Log Entry";
-                thisEntry["Id"] = std::to_string(*id);
-                thisEntry["EventId"] = *eventId;
-                thisEntry["Message"] = (*eventId).substr(0, 8) +
-                                       " event in subsystem: " + *subsystem;
-                thisEntry["Resolved"] = *resolved;
-                if ((resolution != nullptr) && (!(*resolution).empty()))
-                {
-                    thisEntry["Resolution"] = *resolution;
-                }
-                thisEntry["EntryType"] = "Event";
-                thisEntry["Severity"] =
-                    translateSeverityDbusToRedfish(*severity);
-                thisEntry["Created"] =
-                    redfish::time_utils::getDateTimeUintMs(*timestamp);
-                thisEntry["Modified"] =
-                    redfish::time_utils::getDateTimeUintMs(*updateTimestamp);
-                std::optional<bool> notifyAction =
-                    getProviderNotifyAction(*notify);
-                if (notifyAction)
+            // Collections don't include the static data added by SubRoute
+            // because it has a duplicate entry for members
+            asyncResp->res.jsonValue["@odata.type"] =
+                "#LogEntryCollection.LogEntryCollection";
+            asyncResp->res.jsonValue["@odata.id"] =
+                "/redfish/v1/Systems/system/LogServices/EventLog/Entries";
+            asyncResp->res.jsonValue["Name"] = "System Event Log Entries";
+            asyncResp->res.jsonValue["Description"] =
+                "Collection of System Event Log Entries";
+            nlohmann::json& entriesArray = asyncResp->res.jsonValue["Members"];
+            entriesArray = nlohmann::json::array();
+            for (size_t i = start; i < end; i++)
+            {
+                const RenderedLogEntry& entry = *visible[i];
+                if (entry.status == DBusEventLogParse::error)
                 {
-                    thisEntry["ServiceProviderNotified"] = *notifyAction;
+                    messages::internalError(asyncResp->res);
+                    return;
                 }
-
-                thisEntry["Oem"]["IBM"]["@odata.id"] =
-                    "/redfish/v1/Systems/system/LogServices/EventLog/Entries/" +
-                    std::to_string(*id) + "/OemPelAttachment";
-                if (filePath != nullptr)
+                if (entry.status == DBusEventLogParse::success)
                 {
-                    thisEntry["AdditionalDataURI"] =
-                        "/redfish/v1/Systems/system/LogServices/EventLog/Entries/" +
-                        std::to_string(*id) + "/attachment";
+                    entriesArray.emplace_back(entry.json);
                 }
-#ifdef BMCWEB_ENABLE_IBM_MANAGEMENT_CONSOLE
-                thisEntry["Oem"]["OpenBMC"]["@odata.type"] =
-                    "#OemLogEntry.v1_0_0.LogEntry";
-                thisEntry["Oem"]["OpenBMC"]["ManagementSystemAck"] =
-                    *managementSystemAck;
-#endif
             }
-            std::sort(
-                entriesArray.begin(), entriesArray.end(),
-                [](const nlohmann::json& left, const nlohmann::json& right) {
-                return (left["Id"] <= right["Id"]);
-            });
-            asyncResp->res.jsonValue["Members@odata.count"] =
-                entriesArray.size();
-        },
-            "xyz.openbmc_project.Logging", "/xyz/openbmc_project/logging",
-            "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
+            asyncResp->res.jsonValue["Members@odata.count"] = visible.size();
+            if (end < visible.size())
+            {
+                std::string nextLink = query_param::filteredNextLink(
+                    "/redfish/v1/Systems/system/LogServices/EventLog/Entries",
+                    end, filter);
+                nextLink += "&$top=" + std::to_string(top);
+                asyncResp->res.jsonValue["Members@odata.nextLink"] =
+                    std::move(nextLink);
+            }
+        });
     });
 }
 
@@ -2323,7 +3665,17 @@ inline void requestRoutesDBusCELogEntryCollection(App& app)
             [&app](const crow::Request& req,
                    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
                    const std::string& systemName) {
-        if (!redfish::setUpRedfishRoute(app, req, asyncResp))
+        // A streamed export has no Members array for the generic handler to
+        // page, so $top and $skip are applied here in that case.
+        bool stream = isLogEntryStreamRequested(req);
+        query_param::QueryCapabilities capabilities = {
+            .canDelegateTop = stream,
+            .canDelegateSkip = stream,
+            .canDelegateDeltaToken = !stream,
+        };
+        query_param::Query delegatedQuery;
+        if (!redfish::setUpRedfishRouteWithDelegation(
+                app, req, asyncResp, delegatedQuery, capabilities))
         {
             return;
         }
@@ -2333,244 +3685,67 @@ inline void requestRoutesDBusCELogEntryCollection(App& app)
                                        systemName);
             return;
         }
+        if (!stream &&
+            !setUpCollectionDelta(
+                asyncResp, delegatedQuery.deltaToken,
+                DBusLogEntryCache::getInstance().changes(),
+                std::bind_front(
+                    dbusLogEntryUri,
+                    "/redfish/v1/Systems/system/LogServices/CELog/Entries")))
+        {
+            return;
+        }
+        size_t top = delegatedQuery.top.value_or(
+            std::numeric_limits<size_t>::max());
+        size_t skip = delegatedQuery.skip.value_or(0);
 
-        // Collections don't include the static data added by SubRoute
-        // because it has a duplicate entry for members
-        asyncResp->res.jsonValue["@odata.type"] =
-            "#LogEntryCollection.LogEntryCollection";
-        asyncResp->res.jsonValue["@odata.id"] =
-            "/redfish/v1/Systems/system/LogServices/CELog/Entries";
-        asyncResp->res.jsonValue["Name"] = "System Event Log Entries";
-        asyncResp->res.jsonValue["Description"] =
-            "Collection of System Event Log Entries";
-
-        // DBus implementation of CELog/Entries
-        // Make call to Logging Service to find all log entry objects
-        crow::connections::systemBus->async_method_call(
-            [asyncResp](const boost::system::error_code ec,
-                        const dbus::utility::ManagedObjectType& resp) {
+        // Entries are listed in object path order, the order of their Ids
+        DBusLogEntryCache::getInstance().get(
+            [asyncResp, stream, top,
+             skip](const boost::system::error_code& ec,
+                   const std::shared_ptr<const DBusLogSnapshot>& snapshot) {
             if (ec)
             {
                 // TODO Handle for specific error code
-                BMCWEB_LOG_ERROR
-                    << "getLogEntriesIfaceData resp_handler got error " << ec;
                 messages::internalError(asyncResp->res);
                 return;
             }
+            const RenderedLogEntries& entries = snapshot->ceLog;
+            if (stream)
+            {
+                size_t start = std::min(skip, entries.size());
+                size_t end = start + std::min(entries.size() - start, top);
+                streamRenderedLogEntries(
+                    asyncResp->res,
+                    std::shared_ptr<const RenderedLogEntries>(snapshot,
+                                                              &entries),
+                    start, end);
+                return;
+            }
+            if (snapshot->ceLogError)
+            {
+                messages::internalError(asyncResp->res);
+                return;
+            }
+
+            // Collections don't include the static data added by SubRoute
+            // because it has a duplicate entry for members
+            asyncResp->res.jsonValue["@odata.type"] =
+                "#LogEntryCollection.LogEntryCollection";
+            asyncResp->res.jsonValue["@odata.id"] =
+                "/redfish/v1/Systems/system/LogServices/CELog/Entries";
+            asyncResp->res.jsonValue["Name"] = "System Event Log Entries";
+            asyncResp->res.jsonValue["Description"] =
+                "Collection of System Event Log Entries";
             nlohmann::json& entriesArray = asyncResp->res.jsonValue["Members"];
             entriesArray = nlohmann::json::array();
-            for (const auto& objectPath : resp)
-            {
-                const uint32_t* id = nullptr;
-                const uint64_t* timestamp = nullptr;
-                const uint64_t* updateTimestamp = nullptr;
-                const std::string* severity = nullptr;
-                const std::string* subsystem = nullptr;
-                const std::string* filePath = nullptr;
-                const std::string* eventId = nullptr;
-                const std::string* resolution = nullptr;
-                bool resolved = false;
-                const bool* hidden = nullptr;
-                const std::string* notify = nullptr;
-#ifdef BMCWEB_ENABLE_IBM_MANAGEMENT_CONSOLE
-                bool managementSystemAck = false;
-#endif
-
-                for (const auto& interfaceMap : objectPath.second)
-                {
-                    if (interfaceMap.first ==
-                        "xyz.openbmc_project.Logging.Entry")
-                    {
-                        for (const auto& propertyMap : interfaceMap.second)
-                        {
-                            if (propertyMap.first == "Id")
-                            {
-                                id = std::get_if<uint32_t>(&propertyMap.second);
-                            }
-                            else if (propertyMap.first == "Timestamp")
-                            {
-                                timestamp =
-                                    std::get_if<uint64_t>(&propertyMap.second);
-                            }
-                            else if (propertyMap.first == "UpdateTimestamp")
-                            {
-                                updateTimestamp =
-                                    std::get_if<uint64_t>(&propertyMap.second);
-                            }
-                            else if (propertyMap.first == "Severity")
-                            {
-                                severity = std::get_if<std::string>(
-                                    &propertyMap.second);
-                            }
-                            else if (propertyMap.first == "Resolution")
-                            {
-                                resolution = std::get_if<std::string>(
-                                    &propertyMap.second);
-                            }
-                            else if (propertyMap.first == "EventId")
-                            {
-                                eventId = std::get_if<std::string>(
-                                    &propertyMap.second);
-                                if (eventId == nullptr)
-                                {
-                                    messages::internalError(asyncResp->res);
-                                    return;
-                                }
-                            }
-                            else if (propertyMap.first == "Resolved")
-                            {
-                                const bool* resolveptr =
-                                    std::get_if<bool>(&propertyMap.second);
-                                if (resolveptr == nullptr)
-                                {
-                                    messages::internalError(asyncResp->res);
-                                    return;
-                                }
-                                resolved = *resolveptr;
-                            }
-                            else if (propertyMap.first ==
-                                     "ServiceProviderNotify")
-                            {
-                                notify = std::get_if<std::string>(
-                                    &propertyMap.second);
-                                if (notify == nullptr)
-                                {
-                                    messages::internalError(asyncResp->res);
-                                    return;
-                                }
-                            }
-                        }
-                        if (id == nullptr || severity == nullptr)
-                        {
-                            messages::internalError(asyncResp->res);
-                            return;
-                        }
-                    }
-                    else if (interfaceMap.first ==
-                             "xyz.openbmc_project.Common.FilePath")
-                    {
-                        for (const auto& propertyMap : interfaceMap.second)
-                        {
-                            if (propertyMap.first == "Path")
-                            {
-                                filePath = std::get_if<std::string>(
-                                    &propertyMap.second);
-                            }
-                        }
-                    }
-                    else if (interfaceMap.first ==
-                             "org.open_power.Logging.PEL.Entry")
-                    {
-                        for (const auto& propertyMap : interfaceMap.second)
-                        {
-                            if (propertyMap.first == "Hidden")
-                            {
-                                hidden = std::get_if<bool>(&propertyMap.second);
-                                if (hidden == nullptr)
-                                {
-                                    messages::internalError(asyncResp->res);
-                                    return;
-                                }
-                            }
-                            else if (propertyMap.first == "Subsystem")
-                            {
-                                subsystem = std::get_if<std::string>(
-                                    &propertyMap.second);
-                                if (subsystem == nullptr)
-                                {
-                                    messages::internalError(asyncResp->res);
-                                    return;
-                                }
-                            }
-#ifdef BMCWEB_ENABLE_IBM_MANAGEMENT_CONSOLE
-                            else if (propertyMap.first == "ManagementSystemAck")
-                            {
-                                const bool* managementSystemAckptr =
-                                    std::get_if<bool>(&propertyMap.second);
-                                if (managementSystemAckptr == nullptr)
-                                {
-                                    messages::internalError(asyncResp->res);
-                                    return;
-                                }
-                                managementSystemAck = *managementSystemAckptr;
-                            }
-#endif
-                        }
-                    }
-                }
-                // Object path without the
-                // xyz.openbmc_project.Logging.Entry interface, ignore
-                // and continue.
-                if (id == nullptr || eventId == nullptr ||
-                    severity == nullptr || timestamp == nullptr ||
-                    updateTimestamp == nullptr || hidden == nullptr ||
-                    subsystem == nullptr)
-                {
-                    continue;
-                }
-
-                // Part of Event Logs, ignore and continue
-                if (!(*hidden))
-                {
-                    continue;
-                }
-
-                entriesArray.push_back({});
-                nlohmann::json& thisEntry = entriesArray.back();
-                thisEntry["@odata.type"] = "#LogEntry.v1_9_0.LogEntry";
-                thisEntry["@odata.id"] =
-                    "/redfish/v1/Systems/system/LogServices/CELog/Entries/" +
-                    std::to_string(*id);
-                thisEntry["Name"] = "System Event Log Entry";
-                thisEntry["Id"] = std::to_string(*id);
-                thisEntry["EventId"] = *eventId;
-                thisEntry["Message"] = (*eventId).substr(0, 8) +
-                                       " event in subsystem: " + *subsystem;
-                thisEntry["Resolved"] = resolved;
-                if ((resolution != nullptr) && (!(*resolution).empty()))
-                {
-                    thisEntry["Resolution"] = *resolution;
-                }
-                thisEntry["EntryType"] = "Event";
-                thisEntry["Severity"] =
-                    translateSeverityDbusToRedfish(*severity);
-                thisEntry["Created"] =
-                    redfish::time_utils::getDateTimeUintMs(*timestamp);
-                thisEntry["Modified"] =
-                    redfish::time_utils::getDateTimeUintMs(*updateTimestamp);
-                std::optional<bool> notifyAction =
-                    getProviderNotifyAction(*notify);
-                if (notifyAction)
-                {
-                    thisEntry["ServiceProviderNotified"] = *notifyAction;
-                }
-
-                thisEntry["Oem"]["IBM"]["@odata.id"] =
-                    "/redfish/v1/Systems/system/LogServices/CELog/Entries/" +
-                    std::to_string(*id) + "/OemPelAttachment";
-                if (filePath != nullptr)
-                {
-                    thisEntry["AdditionalDataURI"] =
-                        "/redfish/v1/Systems/system/LogServices/CELog/Entries/" +
-                        std::to_string(*id) + "/attachment";
-                }
-#ifdef BMCWEB_ENABLE_IBM_MANAGEMENT_CONSOLE
-                thisEntry["Oem"]["OpenBMC"]["@odata.type"] =
-                    "#OemLogEntry.v1_0_0.LogEntry";
-                thisEntry["Oem"]["OpenBMC"]["ManagementSystemAck"] =
-                    managementSystemAck;
-#endif
+            for (const std::shared_ptr<const RenderedLogEntry>& entry : entries)
+            {
+                entriesArray.emplace_back(entry->json);
             }
-            std::sort(
-                entriesArray.begin(), entriesArray.end(),
-                [](const nlohmann::json& left, const nlohmann::json& right) {
-                return (left["Id"] <= right["Id"]);
-            });
             asyncResp->res.jsonValue["Members@odata.count"] =
                 entriesArray.size();
-        },
-            "xyz.openbmc_project.Logging", "/xyz/openbmc_project/logging",
-            "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
+        });
     });
 }
 
@@ -2598,18 +3773,11 @@ inline void requestRoutesDBusEventLogEntry(App& app)
         dbus::utility::escapePathForDbus(entryID);
 
         // DBus implementation of EventLog/Entries
-        // Make call to Logging Service to find all log entry objects
-        sdbusplus::asio::getAllProperties(
-            *crow::connections::systemBus, "xyz.openbmc_project.Logging",
-            "/xyz/openbmc_project/logging/entry/" + entryID, "",
-            [asyncResp, entryID](const boost::system::error_code ec,
-                                 const dbus::utility::DBusPropertiesMap& resp) {
-            if (ec.value() == EBADR)
-            {
-                messages::resourceNotFound(asyncResp->res, "EventLogEntry",
-                                           entryID);
-                return;
-            }
+        // Look the entry up in the cached logging service objects
+        DBusLogEntryCache::getInstance().getEntry(
+            entryID, [asyncResp, entryID](
+                         const boost::system::error_code& ec,
+                         const dbus::utility::DBusPropertiesMap* properties) {
             if (ec)
             {
                 BMCWEB_LOG_ERROR
@@ -2617,6 +3785,13 @@ inline void requestRoutesDBusEventLogEntry(App& app)
                 messages::internalError(asyncResp->res);
                 return;
             }
+            if (properties == nullptr)
+            {
+                messages::resourceNotFound(asyncResp->res, "EventLogEntry",
+                                           entryID);
+                return;
+            }
+            const dbus::utility::DBusPropertiesMap& resp = *properties;
             const uint32_t* id = nullptr;
             const uint64_t* timestamp = nullptr;
             const uint64_t* updateTimestamp = nullptr;
@@ -2835,17 +4010,11 @@ inline void requestRoutesDBusCELogEntry(App& app)
         dbus::utility::escapePathForDbus(entryID);
 
         // DBus implementation of CELog/Entries
-        // Make call to Logging Service to find all log entry objects
-        sdbusplus::asio::getAllProperties(
-            *crow::connections::systemBus, "xyz.openbmc_project.Logging",
-            "/xyz/openbmc_project/logging/entry/" + entryID, "",
-            [asyncResp, entryID](const boost::system::error_code ec,
-                                 const dbus::utility::DBusPropertiesMap& resp) {
-            if (ec.value() == EBADR)
-            {
-                messages::resourceNotFound(asyncResp->res, "LogEntry", entryID);
-                return;
-            }
+        // Look the entry up in the cached logging service objects
+        DBusLogEntryCache::getInstance().getEntry(
+            entryID, [asyncResp, entryID](
+                         const boost::system::error_code& ec,
+                         const dbus::utility::DBusPropertiesMap* properties) {
             if (ec)
             {
                 BMCWEB_LOG_ERROR << "CELogEntry (DBus) resp_handler got error "
@@ -2853,6 +4022,12 @@ inline void requestRoutesDBusCELogEntry(App& app)
                 messages::internalError(asyncResp->res);
                 return;
             }
+            if (properties == nullptr)
+            {
+                messages::resourceNotFound(asyncResp->res, "LogEntry", entryID);
+                return;
+            }
+            const dbus::utility::DBusPropertiesMap& resp = *properties;
             const uint32_t* id = nullptr;
             const uint64_t* timestamp = nullptr;
             const uint64_t* updateTimestamp = nullptr;
@@ -3171,73 +4346,146 @@ inline void requestRoutesDBusCELogEntryDownloadPelJson(App& app)
     });
 }
 
+/**
+ * @brief Sends the base64 encoding of the file behind fd, or the part of it
+ * rangeRequest asks for, taking ownership of fd.  The file is read and
+ * encoded a piece at a time as the socket drains, and only the bytes a range
+ * covers are read.
+ */
+inline void sendBase64Attachment(
+    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp, int fd,
+    const crow::byte_range::RangeRequest& rangeRequest, off_t maxFileSize)
+{
+    struct stat st
+    {};
+    if (fstat(fd, &st) != 0)
+    {
+        BMCWEB_LOG_ERROR << "Failed to get size of fd " << fd;
+        messages::internalError(asyncResp->res);
+        close(fd);
+        return;
+    }
+    auto file = std::make_shared<crow::BodyFile>();
+    boost::system::error_code ec;
+    file->adopt(fd, ec);
+    if (ec)
+    {
+        BMCWEB_LOG_ERROR << "Failed to get size of fd " << fd;
+        messages::internalError(asyncResp->res);
+        return;
+    }
+    if (st.st_size > maxFileSize)
+    {
+        BMCWEB_LOG_ERROR << "File size " << st.st_size
+                         << " exceeds maximum allowed size of " << maxFileSize;
+        messages::internalError(asyncResp->res);
+        return;
+    }
+    uint64_t rawSize = file->getFileSize();
+    uint64_t encodedSize = (rawSize + 2) / 3 * 4;
+    std::string validator = crow::byte_range::fileValidator(st);
+    crow::byte_range::RangeSelection selection =
+        crow::byte_range::selectRange(rangeRequest, encodedSize, validator);
+    crow::byte_range::setRangeHeaders(asyncResp->res, selection, encodedSize,
+                                      validator);
+    if (selection.status == crow::byte_range::RangeStatus::Unsatisfiable)
+    {
+        return;
+    }
+
+    // Every 3 bytes of the file encode to 4, so a range of the encoding
+    // needs only the groups of 3 it overlaps
+    uint64_t skip = 0;
+    uint64_t remaining = encodedSize;
+    if (selection.status == crow::byte_range::RangeStatus::Partial)
+    {
+        uint64_t rawFirst = selection.range.first / 4 * 3;
+        uint64_t rawEnd = std::min(rawSize,
+                                   (selection.range.last / 4 + 1) * 3);
+        file->setRange(rawFirst, rawEnd - rawFirst);
+        skip = selection.range.first % 4;
+        remaining = selection.range.length();
+    }
+
+    asyncResp->res.addHeader(boost::beast::http::field::content_type,
+                             "application/octet-stream");
+    asyncResp->res.addHeader(
+        boost::beast::http::field::content_transfer_encoding, "Base64");
+    asyncResp->res.setBodyGenerator(
+        [file, pos = uint64_t{0}, skip,
+         remaining](std::string& out, size_t chunkSize) mutable {
+        // A multiple of 3, so each piece encodes without padding
+        std::array<char, 3 * 4096> raw{};
+        while (out.size() < chunkSize && remaining > 0)
+        {
+            size_t want = static_cast<size_t>(
+                std::min<uint64_t>(raw.size(), file->size() - pos));
+            size_t got = 0;
+            while (got < want)
+            {
+                ssize_t rc = file->read(pos + got, raw.data() + got,
+                                        want - got);
+                if (rc <= 0)
+                {
+                    BMCWEB_LOG_ERROR << "Failed to read attachment";
+                    return false;
+                }
+                got += static_cast<size_t>(rc);
+            }
+            if (got == 0)
+            {
+                return false;
+            }
+            pos += got;
+            size_t start = out.size();
+            crow::utility::base64EncodeAppend(
+                out, std::string_view(raw.data(), got));
+            size_t skipped = static_cast<size_t>(
+                std::min<uint64_t>(skip, out.size() - start));
+            out.erase(start, skipped);
+            skip -= skipped;
+            size_t produced = static_cast<size_t>(
+                std::min<uint64_t>(remaining, out.size() - start));
+            out.resize(start + produced);
+            remaining -= produced;
+        }
+        return remaining > 0;
+    });
+}
+
 inline void getEventLogEntryAttachment(
     const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-    const std::string& entryID)
+    const std::string& entryID,
+    const crow::byte_range::RangeRequest& rangeRequest)
 {
     crow::connections::systemBus->async_method_call(
-        [asyncResp, entryID](const boost::system::error_code ec,
-                             const sdbusplus::message::unix_fd& unixfd) {
+        [asyncResp, entryID,
+         rangeRequest](const boost::system::error_code ec,
+                       const sdbusplus::message::unix_fd& unixfd) {
         if (ec.value() == EBADR)
         {
-            messages::resourceNotFound(asyncResp->res, "EventLogAttachment",
-                                       entryID);
-            return;
-        }
-        if (ec)
-        {
-            BMCWEB_LOG_DEBUG << "DBUS response error " << ec;
-            messages::internalError(asyncResp->res);
-            return;
-        }
-
-        int fd = -1;
-        fd = dup(unixfd);
-        if (fd == -1)
-        {
-            messages::internalError(asyncResp->res);
-            return;
-        }
-
-        long long int size = lseek(fd, 0, SEEK_END);
-        if (size == -1)
-        {
-            messages::internalError(asyncResp->res);
-            return;
-        }
-
-        // Arbitrary max size of 64kb
-        constexpr int maxFileSize = 65536;
-        if (size > maxFileSize)
-        {
-            BMCWEB_LOG_ERROR << "File size exceeds maximum allowed size of "
-                             << maxFileSize;
-            messages::internalError(asyncResp->res);
+            messages::resourceNotFound(asyncResp->res, "EventLogAttachment",
+                                       entryID);
             return;
         }
-        std::vector<char> data(static_cast<size_t>(size));
-        long long int rc = lseek(fd, 0, SEEK_SET);
-        if (rc == -1)
+        if (ec)
         {
+            BMCWEB_LOG_DEBUG << "DBUS response error " << ec;
             messages::internalError(asyncResp->res);
             return;
         }
-        rc = read(fd, data.data(), data.size());
-        if ((rc == -1) || (rc != size))
+
+        int fd = -1;
+        fd = dup(unixfd);
+        if (fd == -1)
         {
             messages::internalError(asyncResp->res);
             return;
         }
-        close(fd);
-
-        std::string_view strData(data.data(), data.size());
-        std::string output = crow::utility::base64encode(strData);
 
-        asyncResp->res.addHeader(boost::beast::http::field::content_type,
-                                 "application/octet-stream");
-        asyncResp->res.addHeader(
-            boost::beast::http::field::content_transfer_encoding, "Base64");
-        asyncResp->res.body() = std::move(output);
+        // Arbitrary max size of 64kb
+        constexpr off_t maxFileSize = 65536;
+        sendBase64Attachment(asyncResp, fd, rangeRequest, maxFileSize);
     },
         "xyz.openbmc_project.Logging",
         "/xyz/openbmc_project/logging/entry/" + entryID,
@@ -3275,14 +4523,16 @@ inline void requestRoutesDBusEventLogEntryDownload(App& app)
         std::string entryID = param;
         dbus::utility::escapePathForDbus(entryID);
 
-        auto eventLogAttachmentCallback = [asyncResp,
-                                           entryID](bool hiddenPropVal) {
+        auto eventLogAttachmentCallback =
+            [asyncResp, entryID,
+             rangeRequest{crow::byte_range::RangeRequest(req)}](
+                bool hiddenPropVal) {
             if (hiddenPropVal)
             {
                 messages::resourceNotFound(asyncResp->res, "LogEntry", entryID);
                 return;
             }
-            getEventLogEntryAttachment(asyncResp, entryID);
+            getEventLogEntryAttachment(asyncResp, entryID, rangeRequest);
         };
         getHiddenPropertyValue(asyncResp, entryID,
                                std::move(eventLogAttachmentCallback));
@@ -3320,14 +4570,16 @@ inline void requestRoutesDBusCELogEntryDownload(App& app)
         std::string entryID = param;
         dbus::utility::escapePathForDbus(entryID);
 
-        auto eventLogAttachmentCallback = [asyncResp,
-                                           entryID](bool hiddenPropVal) {
+        auto eventLogAttachmentCallback =
+            [asyncResp, entryID,
+             rangeRequest{crow::byte_range::RangeRequest(req)}](
+                bool hiddenPropVal) {
             if (!hiddenPropVal)
             {
                 messages::resourceNotFound(asyncResp->res, "LogEntry", entryID);
                 return;
             }
-            getEventLogEntryAttachment(asyncResp, entryID);
+            getEventLogEntryAttachment(asyncResp, entryID, rangeRequest);
         };
         getHiddenPropertyValue(asyncResp, entryID,
                                std::move(eventLogAttachmentCallback));
@@ -3360,26 +4612,66 @@ inline bool
     // As the log files rotate, they are appended with a ".#" that is higher for
     // the older logs. Since we start from oldest logs, sort the name in
     // descending order.
-    std::sort(hostLoggerFiles.rbegin(), hostLoggerFiles.rend(),
-              AlphanumLess<std::string>());
+    alphanumSort(hostLoggerFiles.rbegin(), hostLoggerFiles.rend(),
+                 [](const std::filesystem::path& path) {
+        return path.string();
+    });
 
     return true;
 }
 
-inline bool getHostLoggerEntries(
-    const std::vector<std::filesystem::path>& hostLoggerFiles, uint64_t skip,
-    uint64_t top, std::vector<std::string>& logEntries, size_t& logCount)
+// A host logger file, and its contents if already inflated
+struct HostLoggerFile
+{
+    std::filesystem::path path;
+    std::optional<GzFileIndex::FileId> fileId;
+    std::optional<std::string> contents;
+};
+
+inline bool getHostLoggerEntries(std::vector<HostLoggerFile>& hostLoggerFiles,
+                                 uint64_t skip, uint64_t top,
+                                 std::vector<std::string>& logEntries,
+                                 size_t& logCount)
 {
     GzFileReader logFile;
+    GzFileIndex& index = GzFileIndex::getInstance();
 
     // Go though all log files and expose host logs.
-    for (const std::filesystem::path& it : hostLoggerFiles)
+    for (HostLoggerFile& file : hostLoggerFiles)
     {
-        if (!logFile.gzGetLines(it.string(), skip, top, logEntries, logCount))
+        std::optional<GzFileSummary> summary;
+        if (file.fileId)
+        {
+            summary = index.find(*file.fileId);
+        }
+        // Files with no entries in the page only need counting, which
+        // their summary does without inflating them
+        if (summary && summary->skippable &&
+            (logCount + summary->count <= skip || logCount >= skip + top))
+        {
+            logFile.skipFile(*summary, logCount);
+            continue;
+        }
+        bool parsed = false;
+        if (file.contents)
+        {
+            parsed = logFile.parseLines(*file.contents, skip, top, logEntries,
+                                        logCount);
+        }
+        else
+        {
+            parsed = logFile.gzGetLines(file.path.string(), skip, top,
+                                        logEntries, logCount);
+        }
+        if (!parsed)
         {
             BMCWEB_LOG_ERROR << "fail to expose host logs";
             return false;
         }
+        if (file.fileId)
+        {
+            index.insert(*file.fileId, logFile.getFileSummary());
+        }
     }
     // Get lastMessage from constructor by getter
     std::string lastMessage = logFile.getLastMessage();
@@ -3394,6 +4686,89 @@ inline bool getHostLoggerEntries(
     return true;
 }
 
+// The entries of one page of the host log, and how many there are in all
+struct HostLoggerPage
+{
+    bool success = false;
+    std::vector<std::string> entries;
+    size_t count = 0;
+};
+
+/**
+ * @brief Reads one page of the host log off the io thread, then calls
+ * callback with it on the io thread.
+ *
+ * Files the index has no summary of (all of them, after a rotation) are
+ * inflated on the worker threads in parallel, since that doesn't depend on
+ * what came before.  Splitting them into entries carries state from one file
+ * to the next, so that is then done in order, in one more worker job.
+ */
+inline void readHostLoggerEntries(
+    const std::vector<std::filesystem::path>& paths, uint64_t skip,
+    uint64_t top, std::function<void(const HostLoggerPage&)>&& callback)
+{
+    struct Read
+    {
+        std::vector<HostLoggerFile> files;
+        size_t pending = 0;
+        HostLoggerPage page;
+    };
+    auto read = std::make_shared<Read>();
+    std::vector<size_t> toInflate;
+    for (const std::filesystem::path& path : paths)
+    {
+        HostLoggerFile& file = read->files.emplace_back();
+        file.path = path;
+        file.fileId = GzFileIndex::identify(path.string());
+        if (!file.fileId || !GzFileIndex::getInstance().find(*file.fileId))
+        {
+            toInflate.push_back(read->files.size() - 1);
+        }
+    }
+
+    boost::asio::io_context& io =
+        crow::connections::systemBus->get_io_context();
+    auto parse = [read, skip, top, &io,
+                  callback{std::move(callback)}]() mutable {
+        crow::worker_pool::offload(
+            io.get_executor(),
+            [read, skip, top]() {
+            read->page.success = getHostLoggerEntries(
+                read->files, skip, top, read->page.entries, read->page.count);
+        },
+            [read, callback{std::move(callback)}]() { callback(read->page); });
+    };
+    if (toInflate.empty())
+    {
+        parse();
+        return;
+    }
+
+    // Each job only writes the file it was given; pending is only touched
+    // back on the io thread
+    read->pending = toInflate.size();
+    auto inflated = std::make_shared<decltype(parse)>(std::move(parse));
+    for (size_t i : toInflate)
+    {
+        crow::worker_pool::offload(
+            io.get_executor(),
+            [read, i]() {
+            HostLoggerFile& file = read->files[i];
+            std::string contents;
+            if (GzFileReader::inflateFile(file.path.string(), contents))
+            {
+                file.contents = std::move(contents);
+            }
+        },
+            [read, inflated]() {
+            if (--read->pending == 0)
+            {
+                (*inflated)();
+            }
+        });
+    }
+}
+
 inline void fillHostLoggerEntryJson(const std::string& logEntryID,
                                     const std::string& msg,
                                     nlohmann::json::object_t& logEntryJson)
@@ -3473,8 +4848,7 @@ inline void requestRoutesSystemHostLoggerCollection(App& app)
         asyncResp->res.jsonValue["Name"] = "HostLogger Entries";
         asyncResp->res.jsonValue["Description"] =
             "Collection of HostLogger Entries";
-        nlohmann::json& logEntryArray = asyncResp->res.jsonValue["Members"];
-        logEntryArray = nlohmann::json::array();
+        asyncResp->res.jsonValue["Members"] = nlohmann::json::array();
         asyncResp->res.jsonValue["Members@odata.count"] = 0;
 
         std::vector<std::filesystem::path> hostLoggerFiles;
@@ -3486,41 +4860,40 @@ inline void requestRoutesSystemHostLoggerCollection(App& app)
         // If we weren't provided top and skip limits, use the defaults.
         size_t skip = delegatedQuery.skip.value_or(0);
         size_t top = delegatedQuery.top.value_or(query_param::Query::maxTop);
-        size_t logCount = 0;
-        // This vector only store the entries we want to expose that
-        // control by skip and top.
-        std::vector<std::string> logEntries;
-        if (!getHostLoggerEntries(hostLoggerFiles, skip, top, logEntries,
-                                  logCount))
-        {
-            messages::internalError(asyncResp->res);
-            return;
-        }
-        // If vector is empty, that means skip value larger than total
-        // log count
-        if (logEntries.empty())
-        {
-            asyncResp->res.jsonValue["Members@odata.count"] = logCount;
-            return;
-        }
-        if (!logEntries.empty())
-        {
-            for (size_t i = 0; i < logEntries.size(); i++)
+        // The page only holds the entries we want to expose, as controlled
+        // by skip and top.
+        readHostLoggerEntries(
+            hostLoggerFiles, skip, top,
+            [asyncResp, skip, top](const HostLoggerPage& page) {
+            if (!page.success)
+            {
+                messages::internalError(asyncResp->res);
+                return;
+            }
+            // If there are no entries, that means skip value larger than
+            // total log count
+            asyncResp->res.jsonValue["Members@odata.count"] = page.count;
+            if (page.entries.empty())
+            {
+                return;
+            }
+            nlohmann::json& logEntryArray =
+                asyncResp->res.jsonValue["Members"];
+            for (size_t i = 0; i < page.entries.size(); i++)
             {
                 nlohmann::json::object_t hostLogEntry;
-                fillHostLoggerEntryJson(std::to_string(skip + i), logEntries[i],
-                                        hostLogEntry);
+                fillHostLoggerEntryJson(std::to_string(skip + i),
+                                        page.entries[i], hostLogEntry);
                 logEntryArray.push_back(std::move(hostLogEntry));
             }
 
-            asyncResp->res.jsonValue["Members@odata.count"] = logCount;
-            if (skip + top < logCount)
+            if (skip + top < page.count)
             {
                 asyncResp->res.jsonValue["Members@odata.nextLink"] =
                     "/redfish/v1/Systems/system/LogServices/HostLogger/Entries?$skip=" +
                     std::to_string(skip + top);
             }
-        }
+        });
     });
 }
 
@@ -3565,29 +4938,30 @@ inline void requestRoutesSystemHostLoggerLogEntry(App& app)
             return;
         }
 
-        size_t logCount = 0;
-        size_t top = 1;
-        std::vector<std::string> logEntries;
         // We can get specific entry by skip and top. For example, if we
         // want to get nth entry, we can set skip = n-1 and top = 1 to
         // get that entry
-        if (!getHostLoggerEntries(hostLoggerFiles, idInt, top, logEntries,
-                                  logCount))
-        {
-            messages::internalError(asyncResp->res);
-            return;
-        }
+        readHostLoggerEntries(
+            hostLoggerFiles, idInt, 1,
+            [asyncResp, targetID](const HostLoggerPage& page) {
+            if (!page.success)
+            {
+                messages::internalError(asyncResp->res);
+                return;
+            }
 
-        if (!logEntries.empty())
-        {
-            nlohmann::json::object_t hostLogEntry;
-            fillHostLoggerEntryJson(targetID, logEntries[0], hostLogEntry);
-            asyncResp->res.jsonValue.update(hostLogEntry);
-            return;
-        }
+            if (!page.entries.empty())
+            {
+                nlohmann::json::object_t hostLogEntry;
+                fillHostLoggerEntryJson(targetID, page.entries[0],
+                                        hostLogEntry);
+                asyncResp->res.jsonValue.update(hostLogEntry);
+                return;
+            }
 
-        // Requested ID was not found
-        messages::resourceNotFound(asyncResp->res, "LogEntry", param);
+            // Requested ID was not found
+            messages::resourceNotFound(asyncResp->res, "LogEntry", targetID);
+        });
     });
 }
 
@@ -3771,6 +5145,296 @@ static int
     return 0;
 }
 
+/**
+ * @brief Remembers the cursors of recently served journal pages by entry
+ * position so that deep $skip requests can seek instead of walking the
+ * journal from the head.  The total entry count is kept along with the cursor
+ * of the last entry counted, so only entries appended since the previous
+ * request are counted again.  Positions are only meaningful while the oldest
+ * entry stays the same, so everything is dropped when the journal is vacuumed
+ * or rotated away.
+ */
+struct JournalCursorCache
+{
+    static constexpr size_t maxCursors = 32;
+
+    static JournalCursorCache& getInstance()
+    {
+        static JournalCursorCache cache;
+        return cache;
+    }
+
+    void reset(std::string headIn)
+    {
+        headCursor = std::move(headIn);
+        tailCursor.clear();
+        entryCount = 0;
+        positions.clear();
+    }
+
+    void add(uint64_t position, std::string cursor)
+    {
+        if (cursor.empty())
+        {
+            return;
+        }
+        positions.insert_or_assign(position, std::move(cursor));
+        if (positions.size() > maxCursors)
+        {
+            // The lowest positions are the cheapest to walk to from the head
+            positions.erase(positions.begin());
+        }
+    }
+
+    std::string headCursor;
+    std::string tailCursor;
+    uint64_t entryCount = 0;
+    boost::container::flat_map<uint64_t, std::string> positions;
+};
+
+inline static std::string getJournalCursor(sd_journal* journal)
+{
+    char* cursor = nullptr;
+    if (sd_journal_get_cursor(journal, &cursor) < 0)
+    {
+        return "";
+    }
+    std::string ret(cursor);
+    free(cursor); // NOLINT(cppcoreguidelines-no-malloc)
+    return ret;
+}
+
+inline static bool seekJournalCursor(sd_journal* journal,
+                                     const std::string& cursor)
+{
+    if (cursor.empty() || sd_journal_seek_cursor(journal, cursor.c_str()) < 0)
+    {
+        return false;
+    }
+    if (sd_journal_next(journal) <= 0)
+    {
+        return false;
+    }
+    return sd_journal_test_cursor(journal, cursor.c_str()) > 0;
+}
+
+// Returns the number of entries in the journal, counting only the entries
+// appended since the last call when the oldest entry hasn't changed.
+inline static uint64_t countJournalEntries(sd_journal* journal,
+                                           JournalCursorCache& cache)
+{
+    sd_journal_seek_head(journal);
+    if (sd_journal_next(journal) <= 0)
+    {
+        cache.reset("");
+        return 0;
+    }
+    std::string head = getJournalCursor(journal);
+    if (head != cache.headCursor || cache.tailCursor.empty() ||
+        !seekJournalCursor(journal, cache.tailCursor))
+    {
+        cache.reset(std::move(head));
+        sd_journal_seek_head(journal);
+        sd_journal_next(journal);
+        cache.entryCount = 1;
+    }
+    while (sd_journal_next(journal) > 0)
+    {
+        cache.entryCount++;
+    }
+    sd_journal_seek_tail(journal);
+    if (sd_journal_previous(journal) > 0)
+    {
+        cache.tailCursor = getJournalCursor(journal);
+    }
+    return cache.entryCount;
+}
+
+// Positions the journal on the entry at position (0 based), walking from
+// whichever of the head, the tail or a cached cursor is closest.
+inline static bool seekJournalPosition(sd_journal* journal,
+                                       const JournalCursorCache& cache,
+                                       uint64_t position)
+{
+    if (position >= cache.entryCount)
+    {
+        return false;
+    }
+    uint64_t from = 0;
+    const std::string* cursor = nullptr;
+    auto it = cache.positions.upper_bound(position);
+    if (it != cache.positions.begin())
+    {
+        --it;
+        from = it->first;
+        cursor = &it->second;
+    }
+
+    uint64_t fromTail = cache.entryCount - position;
+    if (fromTail < position - from)
+    {
+        sd_journal_seek_tail(journal);
+        return sd_journal_previous_skip(journal, fromTail) ==
+               static_cast<int>(fromTail);
+    }
+    if (cursor != nullptr && seekJournalCursor(journal, *cursor))
+    {
+        if (position == from)
+        {
+            return true;
+        }
+        return sd_journal_next_skip(journal, position - from) ==
+               static_cast<int>(position - from);
+    }
+    sd_journal_seek_head(journal);
+    return sd_journal_next_skip(journal, position + 1) ==
+           static_cast<int>(position + 1);
+}
+
+// Steps back over the entries that share the current entry's boot and
+// timestamp, returning how many there were, so that walking forward from the
+// new position gives ids with the same _index suffix as a scan from the head.
+inline static uint64_t seekFirstJournalEntryAtTimestamp(sd_journal* journal)
+{
+    uint64_t curTs = 0;
+    sd_id128_t curBootID{};
+    if (sd_journal_get_monotonic_usec(journal, &curTs, &curBootID) < 0)
+    {
+        return 0;
+    }
+    uint64_t count = 0;
+    while (sd_journal_previous(journal) > 0)
+    {
+        uint64_t ts = 0;
+        sd_id128_t bootID{};
+        if (sd_journal_get_monotonic_usec(journal, &ts, &bootID) < 0 ||
+            ts != curTs || sd_id128_equal(bootID, curBootID) == 0)
+        {
+            sd_journal_next(journal);
+            break;
+        }
+        count++;
+    }
+    return count;
+}
+
+/**
+ * @brief Makes the opaque token carried in the journal nextLink.  It holds
+ * the position of the first entry of the next page and its cursor.
+ */
+inline std::string makeJournalPageToken(uint64_t position,
+                                        std::string_view cursor)
+{
+    std::string raw = std::to_string(position);
+    raw += ':';
+    raw += cursor;
+    std::string token;
+    for (char c : crow::utility::base64encode(raw))
+    {
+        // Keep the token intact through query string decoding
+        if (c == '+')
+        {
+            token += "%2B";
+        }
+        else if (c == '/')
+        {
+            token += "%2F";
+        }
+        else if (c == '=')
+        {
+            token += "%3D";
+        }
+        else
+        {
+            token += c;
+        }
+    }
+    return token;
+}
+
+inline bool parseJournalPageToken(std::string_view token, uint64_t& position,
+                                  std::string& cursor)
+{
+    std::string raw;
+    if (!crow::utility::base64Decode(token, raw))
+    {
+        return false;
+    }
+    size_t colon = raw.find(':');
+    if (colon == std::string::npos || colon + 1 == raw.size())
+    {
+        return false;
+    }
+    const char* end = raw.data() + colon;
+    auto [ptr, ec] = std::from_chars(raw.data(), end, position);
+    if (ec != std::errc() || ptr != end)
+    {
+        return false;
+    }
+    cursor = raw.substr(colon + 1);
+    return true;
+}
+
+/**
+ * @brief Renders journal entries walking forward from the current one.  Ids
+ * are built from ids, which must describe the entries before the current one.
+ */
+class JournalEntryReader
+{
+  public:
+    JournalEntryReader(std::shared_ptr<sd_journal> journalIn,
+                       const JournalEntryIdState& idsIn, size_t count) :
+        journal(std::move(journalIn)),
+        ids(idsIn), remaining(count)
+    {}
+
+    // Fills entry from the next journal entry, leaving it null if the entry
+    // has no usable timestamp.  Returns false once count entries have been
+    // read or the journal has run out.  The journal is left on the last
+    // entry read.
+    bool next(nlohmann::json& entry)
+    {
+        if (remaining == 0)
+        {
+            return false;
+        }
+        if (!first && sd_journal_next(journal.get()) <= 0)
+        {
+            remaining = 0;
+            return false;
+        }
+        first = false;
+        remaining--;
+
+        std::string idStr;
+        if (!getUniqueEntryID(journal.get(), idStr, ids))
+        {
+            return true;
+        }
+        nlohmann::json::object_t bmcJournalLogEntry;
+        if (fillBMCJournalLogEntryJson(idStr, journal.get(),
+                                       bmcJournalLogEntry) != 0)
+        {
+            failed = true;
+            return true;
+        }
+        entry = std::move(bmcJournalLogEntry);
+        return true;
+    }
+
+    bool hasFailed() const
+    {
+        return failed;
+    }
+
+  private:
+    std::shared_ptr<sd_journal> journal;
+    JournalEntryIdState ids;
+    size_t remaining;
+    bool first = true;
+    bool failed = false;
+};
+
 inline void requestRoutesBMCJournalLogEntryCollection(App& app)
 {
     BMCWEB_ROUTE(app, "/redfish/v1/Managers/bmc/LogServices/Journal/Entries/")
@@ -3789,23 +5453,13 @@ inline void requestRoutesBMCJournalLogEntryCollection(App& app)
             return;
         }
 
+        // An export has no page size unless one is asked for
+        bool stream = isLogEntryStreamRequested(req);
         size_t skip = delegatedQuery.skip.value_or(0);
-        size_t top = delegatedQuery.top.value_or(query_param::Query::maxTop);
-
-        // Collections don't include the static data added by SubRoute
-        // because it has a duplicate entry for members
-        asyncResp->res.jsonValue["@odata.type"] =
-            "#LogEntryCollection.LogEntryCollection";
-        asyncResp->res.jsonValue["@odata.id"] =
-            "/redfish/v1/Managers/bmc/LogServices/Journal/Entries";
-        asyncResp->res.jsonValue["Name"] = "Open BMC Journal Entries";
-        asyncResp->res.jsonValue["Description"] =
-            "Collection of BMC Journal Entries";
-        nlohmann::json& logEntryArray = asyncResp->res.jsonValue["Members"];
-        logEntryArray = nlohmann::json::array();
+        size_t top = delegatedQuery.top.value_or(
+            stream ? std::numeric_limits<size_t>::max()
+                   : query_param::Query::maxTop);
 
-        // Go through the journal and use the timestamp to create a
-        // unique ID for each entry
         sd_journal* journalTmp = nullptr;
         int ret = sd_journal_open(&journalTmp, SD_JOURNAL_LOCAL_ONLY);
         if (ret < 0)
@@ -3814,44 +5468,114 @@ inline void requestRoutesBMCJournalLogEntryCollection(App& app)
             messages::internalError(asyncResp->res);
             return;
         }
-        std::unique_ptr<sd_journal, decltype(&sd_journal_close)> journal(
-            journalTmp, sd_journal_close);
+        std::shared_ptr<sd_journal> journal(journalTmp, sd_journal_close);
         journalTmp = nullptr;
-        uint64_t entryCount = 0;
-        // Reset the unique ID on the first entry
-        bool firstEntry = true;
-        SD_JOURNAL_FOREACH(journal.get())
+
+        JournalCursorCache& cache = JournalCursorCache::getInstance();
+        uint64_t entryCount = countJournalEntries(journal.get(), cache);
+
+        if (!stream)
+        {
+            // Collections don't include the static data added by SubRoute
+            // because it has a duplicate entry for members
+            asyncResp->res.jsonValue["@odata.type"] =
+                "#LogEntryCollection.LogEntryCollection";
+            asyncResp->res.jsonValue["@odata.id"] =
+                "/redfish/v1/Managers/bmc/LogServices/Journal/Entries";
+            asyncResp->res.jsonValue["Name"] = "Open BMC Journal Entries";
+            asyncResp->res.jsonValue["Description"] =
+                "Collection of BMC Journal Entries";
+            asyncResp->res.jsonValue["Members"] = nlohmann::json::array();
+            asyncResp->res.jsonValue["Members@odata.count"] = entryCount;
+        }
+        if (skip >= entryCount || top == 0)
         {
-            entryCount++;
-            // Handle paging using skip (number of entries to skip from
-            // the start) and top (number of entries to display)
-            if (entryCount <= skip || entryCount > skip + top)
+            if (stream)
             {
-                continue;
+                streamLogEntries(asyncResp->res,
+                                 [](nlohmann::json& /*entry*/) {
+                    return false;
+                });
             }
+            return;
+        }
 
-            std::string idStr;
-            if (!getUniqueEntryID(journal.get(), idStr, firstEntry))
+        // A nextLink token lets the page start exactly where the last one
+        // ended, even if entries were added or vacuumed in between.  Its
+        // position can't be trusted after that though, so only pages found
+        // by position are remembered in the cache.
+        bool fromToken = false;
+        auto tokenParam = req.urlView.params().find("skiptoken");
+        if (tokenParam != req.urlView.params().end())
+        {
+            uint64_t tokenPosition = 0;
+            std::string cursor;
+            fromToken = parseJournalPageToken((*tokenParam).value,
+                                              tokenPosition, cursor) &&
+                        tokenPosition == skip &&
+                        seekJournalCursor(journal.get(), cursor);
+        }
+        if (!fromToken)
+        {
+            if (!seekJournalPosition(journal.get(), cache, skip))
             {
-                continue;
+                BMCWEB_LOG_ERROR << "failed to seek to journal entry " << skip;
+                messages::internalError(asyncResp->res);
+                return;
             }
-            firstEntry = false;
+            cache.add(skip, getJournalCursor(journal.get()));
+        }
+
+        // Walk over any earlier entries with the same timestamp so the ids
+        // match the ones a scan from the head would produce
+        uint64_t sameTimestamp =
+            seekFirstJournalEntryAtTimestamp(journal.get());
+        JournalEntryIdState ids;
+        std::string idStr;
+        for (uint64_t i = 0; i < sameTimestamp; i++)
+        {
+            getUniqueEntryID(journal.get(), idStr, ids);
+            sd_journal_next(journal.get());
+        }
+
+        JournalEntryReader reader(journal, ids, top);
+        if (stream)
+        {
+            // Entries that fail to render are logged and left out; the
+            // status line has already been sent by then.
+            streamLogEntries(asyncResp->res,
+                             [reader](nlohmann::json& entry) mutable {
+                return reader.next(entry);
+            });
+            return;
+        }
 
-            nlohmann::json::object_t bmcJournalLogEntry;
-            if (fillBMCJournalLogEntryJson(idStr, journal.get(),
-                                           bmcJournalLogEntry) != 0)
+        nlohmann::json& logEntryArray = asyncResp->res.jsonValue["Members"];
+        nlohmann::json entry;
+        while (reader.next(entry))
+        {
+            if (reader.hasFailed())
             {
                 messages::internalError(asyncResp->res);
                 return;
             }
-            logEntryArray.push_back(std::move(bmcJournalLogEntry));
+            if (!entry.is_null())
+            {
+                logEntryArray.push_back(std::move(entry));
+            }
+            entry = nullptr;
         }
-        asyncResp->res.jsonValue["Members@odata.count"] = entryCount;
-        if (skip + top < entryCount)
+        if (skip + top < entryCount && sd_journal_next(journal.get()) > 0)
         {
+            std::string cursor = getJournalCursor(journal.get());
+            if (!fromToken)
+            {
+                cache.add(skip + top, cursor);
+            }
             asyncResp->res.jsonValue["Members@odata.nextLink"] =
                 "/redfish/v1/Managers/bmc/LogServices/Journal/Entries?$skip=" +
-                std::to_string(skip + top);
+                std::to_string(skip + top) +
+                "&skiptoken=" + makeJournalPageToken(skip + top, cursor);
         }
     });
 }
@@ -4020,7 +5744,18 @@ inline void handleLogServicesDumpEntriesCollectionGet(
     crow::App& app, const std::string& dumpType, const crow::Request& req,
     const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
 {
-    if (!redfish::setUpRedfishRoute(app, req, asyncResp))
+    query_param::QueryCapabilities capabilities = {
+        .canDelegateDeltaToken = true,
+    };
+    query_param::Query delegatedQuery;
+    if (!redfish::setUpRedfishRouteWithDelegation(app, req, asyncResp,
+                                                  delegatedQuery, capabilities))
+    {
+        return;
+    }
+    if (!setUpCollectionDelta(asyncResp, delegatedQuery.deltaToken,
+                              DumpEntryCache::getInstance().changes(),
+                              std::bind_front(dumpEntryUri, dumpType)))
     {
         return;
     }
@@ -4041,7 +5776,12 @@ inline void handleLogServicesDumpEntriesCollectionComputerSystemGet(
     const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
     const std::string& chassisId)
 {
-    if (!redfish::setUpRedfishRoute(app, req, asyncResp))
+    query_param::QueryCapabilities capabilities = {
+        .canDelegateDeltaToken = true,
+    };
+    query_param::Query delegatedQuery;
+    if (!redfish::setUpRedfishRouteWithDelegation(app, req, asyncResp,
+                                                  delegatedQuery, capabilities))
     {
         return;
     }
@@ -4050,6 +5790,25 @@ inline void handleLogServicesDumpEntriesCollectionComputerSystemGet(
         messages::resourceNotFound(asyncResp->res, "ComputerSystem", chassisId);
         return;
     }
+    // The collection lists the dumps of each of these types
+    auto systemDumpUri = [](std::string_view path) {
+        for (const char* dumpType :
+             {"System", "Resource", "Hostboot", "Hardware", "SBE"})
+        {
+            std::string uri = dumpEntryUri(dumpType, path);
+            if (!uri.empty())
+            {
+                return uri;
+            }
+        }
+        return std::string();
+    };
+    if (!setUpCollectionDelta(asyncResp, delegatedQuery.deltaToken,
+                              DumpEntryCache::getInstance().changes(),
+                              std::move(systemDumpUri)))
+    {
+        return;
+    }
 
     asyncResp->res.jsonValue["@odata.type"] =
         "#LogEntryCollection.LogEntryCollection";
@@ -4548,10 +6307,11 @@ static void
             logEntryJson.update(logEntry);
         }
     };
-    sdbusplus::asio::getAllProperties(
-        *crow::connections::systemBus, crashdumpObject,
-        crashdumpPath + std::string("/") + logID, crashdumpInterface,
-        std::move(getStoredLogCallback));
+    // A stored crashdump doesn't change once written, so this is served from
+    // DbusObjectCache after the first read
+    dbus::utility::getAllProperties(
+        crashdumpObject, crashdumpPath + std::string("/") + logID,
+        crashdumpInterface, std::move(getStoredLogCallback));
 }
 
 inline void requestRoutesCrashdumpEntryCollection(App& app)
@@ -4579,9 +6339,13 @@ inline void requestRoutesCrashdumpEntryCollection(App& app)
             return;
         }
 
-        crow::connections::systemBus->async_method_call(
-            [asyncResp](const boost::system::error_code ec,
-                        const std::vector<std::string>& resp) {
+        constexpr std::array<std::string_view, 1> interfaces = {
+            crashdumpInterface};
+        dbus::utility::getSubTreePaths(
+            "/", 0, interfaces,
+            [asyncResp](const boost::system::error_code& ec,
+                        const dbus::utility::MapperGetSubTreePathsResponse&
+                            resp) {
             if (ec)
             {
                 if (ec.value() !=
@@ -4616,11 +6380,7 @@ inline void requestRoutesCrashdumpEntryCollection(App& app)
                 logCrashdumpEntry(asyncResp, logID,
                                   asyncResp->res.jsonValue["Members"]);
             }
-        },
-            "xyz.openbmc_project.ObjectMapper",
-            "/xyz/openbmc_project/object_mapper",
-            "xyz.openbmc_project.ObjectMapper", "GetSubTreePaths", "", 0,
-            std::array<const char*, 1>{crashdumpInterface});
+        });
     });
 }
 
@@ -4677,7 +6437,8 @@ inline void requestRoutesCrashdumpFile(App& app)
         }
 
         auto getStoredLogCallback =
-            [asyncResp, logID, fileName, url(boost::urls::url(req.urlView))](
+            [asyncResp, logID, fileName, url(boost::urls::url(req.urlView)),
+             rangeRequest{crow::byte_range::RangeRequest(req)}](
                 const boost::system::error_code ec,
                 const std::vector<
                     std::pair<std::string, dbus::utility::DbusVariantType>>&
@@ -4710,24 +6471,43 @@ inline void requestRoutesCrashdumpFile(App& app)
                 return;
             }
 
-            if (!std::filesystem::exists(dbusFilepath))
+            struct stat st
+            {};
+            if (stat(dbusFilepath.c_str(), &st) != 0)
             {
                 messages::resourceNotFound(asyncResp->res, "LogEntry", logID);
                 return;
             }
-            std::ifstream ifs(dbusFilepath, std::ios::in | std::ios::binary);
-            asyncResp->res.body() =
-                std::string(std::istreambuf_iterator<char>{ifs}, {});
+            uint64_t size = static_cast<uint64_t>(st.st_size);
+            std::string validator = crow::byte_range::fileValidator(st);
+            crow::byte_range::RangeSelection selection =
+                crow::byte_range::selectRange(rangeRequest, size, validator);
+            crow::byte_range::setRangeHeaders(asyncResp->res, selection, size,
+                                              validator);
+            if (selection.status ==
+                crow::byte_range::RangeStatus::Unsatisfiable)
+            {
+                return;
+            }
+            if (!asyncResp->res.openFile(dbusFilepath))
+            {
+                messages::internalError(asyncResp->res);
+                return;
+            }
+            if (selection.status == crow::byte_range::RangeStatus::Partial)
+            {
+                asyncResp->res.setFileRange(selection.range.first,
+                                            selection.range.length());
+            }
 
             // Configure this to be a file download when accessed
             // from a browser
             asyncResp->res.addHeader(
                 boost::beast::http::field::content_disposition, "attachment");
         };
-        sdbusplus::asio::getAllProperties(
-            *crow::connections::systemBus, crashdumpObject,
-            crashdumpPath + std::string("/") + logID, crashdumpInterface,
-            std::move(getStoredLogCallback));
+        dbus::utility::getAllProperties(
+            crashdumpObject, crashdumpPath + std::string("/") + logID,
+            crashdumpInterface, std::move(getStoredLogCallback));
     });
 }
 
@@ -4753,6 +6533,31 @@ inline OEMDiagnosticType
     return OEMDiagnosticType::invalid;
 }
 
+/**
+ * @brief The crashdump collection of one type that's in progress.
+ *
+ * crashdump only runs one collection at a time and fails any other with
+ * EBUSY, so concurrent requests share one: those that arrive while it's
+ * being started wait for it, and those that arrive while it runs are given
+ * its task.
+ */
+struct CrashdumpCollection
+{
+    std::vector<std::shared_ptr<bmcweb::AsyncResp>> starting;
+    std::weak_ptr<task::TaskData> task;
+};
+
+inline CrashdumpCollection& getCrashdumpCollection(OEMDiagnosticType type)
+{
+    static CrashdumpCollection onDemand;
+    static CrashdumpCollection telemetry;
+    if (type == OEMDiagnosticType::onDemand)
+    {
+        return onDemand;
+    }
+    return telemetry;
+}
+
 inline void requestRoutesCrashdumpCollect(App& app)
 {
     // Note: Deviated from redfish privilege registry for GET & HEAD
@@ -4832,25 +6637,51 @@ inline void requestRoutesCrashdumpCollect(App& app)
             return;
         }
 
+        CrashdumpCollection& collection = getCrashdumpCollection(oemDiagType);
+        std::shared_ptr<task::TaskData> running = collection.task.lock();
+        if (running != nullptr && !running->endTime)
+        {
+            BMCWEB_LOG_DEBUG << "Joining crashdump collection task "
+                             << running->index;
+            running->populateResp(asyncResp->res);
+            return;
+        }
+        collection.starting.emplace_back(asyncResp);
+        if (collection.starting.size() > 1)
+        {
+            return;
+        }
+        crow::dbus_trace::SharedCallScope sharedCalls;
+
+        // The task's payload is that of the request that started it
         auto collectCrashdumpCallback =
-            [asyncResp, payload(task::Payload(req)),
+            [oemDiagType, payload(task::Payload(req)),
              taskMatchStr](const boost::system::error_code ec,
                            const std::string&) mutable {
+            CrashdumpCollection& started = getCrashdumpCollection(oemDiagType);
+            std::vector<std::shared_ptr<bmcweb::AsyncResp>> waiters =
+                std::move(started.starting);
+            started.starting.clear();
             if (ec)
             {
-                if (ec.value() == boost::system::errc::operation_not_supported)
-                {
-                    messages::resourceInStandby(asyncResp->res);
-                }
-                else if (ec.value() ==
-                         boost::system::errc::device_or_resource_busy)
+                for (const std::shared_ptr<bmcweb::AsyncResp>& waiter :
+                     waiters)
                 {
-                    messages::serviceTemporarilyUnavailable(asyncResp->res,
-                                                            "60");
-                }
-                else
-                {
-                    messages::internalError(asyncResp->res);
+                    if (ec.value() ==
+                        boost::system::errc::operation_not_supported)
+                    {
+                        messages::resourceInStandby(waiter->res);
+                    }
+                    else if (ec.value() ==
+                             boost::system::errc::device_or_resource_busy)
+                    {
+                        messages::serviceTemporarilyUnavailable(waiter->res,
+                                                                "60");
+                    }
+                    else
+                    {
+                        messages::internalError(waiter->res);
+                    }
                 }
                 return;
             }
@@ -4868,8 +6699,12 @@ inline void requestRoutesCrashdumpCollect(App& app)
                 taskMatchStr);
 
             task->startTimer(std::chrono::minutes(5));
-            task->populateResp(asyncResp->res);
             task->payload.emplace(std::move(payload));
+            started.task = task;
+            for (const std::shared_ptr<bmcweb::AsyncResp>& waiter : waiters)
+            {
+                task->populateResp(waiter->res);
+            }
         };
 
         crow::connections::systemBus->async_method_call(
@@ -5034,6 +6869,244 @@ inline void requestRoutesPostCodesLogService(App& app)
     });
 }
 
+// The post codes of one boot cycle by timestamp, as GetPostCodesWithTimeStamp
+// returns them
+using PostCodes = boost::container::flat_map<
+    uint64_t, std::tuple<uint64_t, std::vector<uint8_t>>>;
+
+/**
+ * @brief Holds the post codes of each boot cycle read so far, so paging
+ * through the PostCodes collection doesn't read every boot cycle again on
+ * each page.
+ *
+ * Boot cycles are numbered from 1, the current one, back to
+ * CurrentBootCycleCount.  Only the current boot cycle gains post codes, so
+ * a post code arriving on the raw post code object drops just that cycle,
+ * to be read again on next use.  The older cycles are kept until a new boot
+ * cycle is seen starting, which renumbers them: the current cycle is always
+ * read before an older one is served, and if it no longer starts with the
+ * post code it started with before, the older cycles and the cycle count
+ * are dropped.  A change to the post code manager's own properties, a
+ * ClearLog, or a well known name changing owner drops everything.
+ */
+class PostCodeCache
+{
+  public:
+    static constexpr std::string_view service =
+        "xyz.openbmc_project.State.Boot.PostCode0";
+    static constexpr std::string_view path =
+        "/xyz/openbmc_project/State/Boot/PostCode0";
+    static constexpr std::string_view interface =
+        "xyz.openbmc_project.State.Boot.PostCode";
+
+    using BootCallback =
+        std::function<void(const boost::system::error_code&,
+                           const std::shared_ptr<const PostCodes>&)>;
+    using CountCallback =
+        std::function<void(const boost::system::error_code&, uint16_t)>;
+
+    static PostCodeCache& getInstance()
+    {
+        static PostCodeCache cache;
+        return cache;
+    }
+
+    PostCodeCache(const PostCodeCache&) = delete;
+    PostCodeCache(PostCodeCache&&) = delete;
+    PostCodeCache& operator=(const PostCodeCache&) = delete;
+    PostCodeCache& operator=(PostCodeCache&&) = delete;
+    ~PostCodeCache() = default;
+
+    void registerMatches(sdbusplus::asio::connection& conn)
+    {
+        namespace rules = sdbusplus::bus::match::rules;
+
+        matches.clear();
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn,
+            rules::propertiesChanged("/xyz/openbmc_project/state/boot/raw0",
+                                     "xyz.openbmc_project.State.Boot.Raw"),
+            [this](sdbusplus::message_t&) { currentBootChanged(); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn,
+            rules::propertiesChanged(std::string(path),
+                                     std::string(interface)),
+            [this](sdbusplus::message_t&) { clear(); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::nameOwnerChanged(), [this](sdbusplus::message_t& msg) {
+            std::string name;
+            msg.read(name);
+            if (!name.starts_with(':'))
+            {
+                clear();
+            }
+        }));
+        clear();
+    }
+
+    bool enabled() const
+    {
+        return !matches.empty();
+    }
+
+    /**
+     * @brief Calls callback with CurrentBootCycleCount.  The callback is
+     * never called inline.
+     */
+    void getBootCount(CountCallback&& callback)
+    {
+        if (bootCount)
+        {
+            boost::asio::post(
+                crow::connections::systemBus->get_io_context(),
+                [count{*bootCount}, callback{std::move(callback)}]() {
+                callback(boost::system::error_code(), count);
+            });
+            return;
+        }
+        sdbusplus::asio::getProperty<uint16_t>(
+            *crow::connections::systemBus, std::string(service),
+            std::string(path), std::string(interface), "CurrentBootCycleCount",
+            [this, fetchGeneration{generation}, callback{std::move(callback)}](
+                const boost::system::error_code& ec, uint16_t count) {
+            if (!ec && enabled() && fetchGeneration == generation)
+            {
+                bootCount = count;
+            }
+            callback(ec, count);
+        });
+    }
+
+    /**
+     * @brief Calls callback with the post codes of boot cycle bootIndex.
+     * The callback is never called inline.
+     */
+    void getBoot(uint16_t bootIndex, BootCallback&& callback)
+    {
+        if (!enabled())
+        {
+            readBoot(bootIndex, std::move(callback));
+            return;
+        }
+        if (bootIndex > 1 && (boots.empty() || !boots.front()))
+        {
+            // Make sure the older cycles haven't been renumbered first
+            getBoot(1, [this, bootIndex, callback{std::move(callback)}](
+                           const boost::system::error_code& ec,
+                           const std::shared_ptr<const PostCodes>&) mutable {
+                if (ec)
+                {
+                    callback(ec, nullptr);
+                    return;
+                }
+                if (boots.empty() || !boots.front())
+                {
+                    // Changed again meanwhile, or not kept
+                    readBoot(bootIndex, std::move(callback));
+                    return;
+                }
+                getBoot(bootIndex, std::move(callback));
+            });
+            return;
+        }
+        size_t slot = static_cast<size_t>(bootIndex) - 1;
+        if (bootIndex > 0 && slot < boots.size() && boots[slot])
+        {
+            std::shared_ptr<const PostCodes> codes = boots[slot];
+            boost::asio::post(crow::connections::systemBus->get_io_context(),
+                              [codes, callback{std::move(callback)}]() {
+                callback(boost::system::error_code(), codes);
+            });
+            return;
+        }
+        readBoot(bootIndex, std::move(callback));
+    }
+
+    void clear()
+    {
+        boots.clear();
+        currentFirstCode.reset();
+        bootCount.reset();
+        generation++;
+    }
+
+  private:
+    PostCodeCache() = default;
+
+    void currentBootChanged()
+    {
+        if (!boots.empty())
+        {
+            boots.front().reset();
+        }
+        generation++;
+    }
+
+    void readBoot(uint16_t bootIndex, BootCallback&& callback)
+    {
+        crow::connections::bulkBus->async_method_call(
+            [this, bootIndex, fetchGeneration{generation},
+             callback{std::move(callback)}](const boost::system::error_code& ec,
+                                            PostCodes& postcode) {
+            if (ec)
+            {
+                callback(ec, nullptr);
+                return;
+            }
+            auto codes = std::make_shared<const PostCodes>(std::move(postcode));
+            if (enabled() && fetchGeneration == generation && bootIndex > 0)
+            {
+                store(bootIndex, codes);
+            }
+            callback(ec, codes);
+        },
+            std::string(service), std::string(path), std::string(interface),
+            "GetPostCodesWithTimeStamp", bootIndex);
+    }
+
+    void store(uint16_t bootIndex,
+               const std::shared_ptr<const PostCodes>& codes)
+    {
+        if (bootIndex == 1)
+        {
+            std::optional<uint64_t> firstCode;
+            if (!codes->empty())
+            {
+                firstCode = codes->begin()->first;
+            }
+            if (!currentFirstCode || firstCode != currentFirstCode)
+            {
+                // Either a new boot cycle began, or the cycle that was
+                // current is only now known; the older ones can't be
+                // trusted to have kept their numbers
+                boots.clear();
+                bootCount.reset();
+            }
+            currentFirstCode = firstCode;
+        }
+        else if (boots.empty() || !boots.front())
+        {
+            // Read before the current cycle was checked
+            return;
+        }
+        size_t slot = static_cast<size_t>(bootIndex) - 1;
+        if (boots.size() <= slot)
+        {
+            boots.resize(slot + 1);
+        }
+        boots[slot] = codes;
+    }
+
+    // Index 0 holds boot cycle 1; cycles not read yet are nullptr
+    std::vector<std::shared_ptr<const PostCodes>> boots;
+    // When the current boot cycle's first post code was logged, as of the
+    // last read
+    std::optional<uint64_t> currentFirstCode;
+    std::optional<uint16_t> bootCount;
+    uint64_t generation = 0;
+    std::vector<std::unique_ptr<sdbusplus::bus::match_t>> matches;
+};
+
 inline void requestRoutesPostCodesClear(App& app)
 {
     BMCWEB_ROUTE(
@@ -5071,6 +7144,7 @@ inline void requestRoutesPostCodesClear(App& app)
                 messages::internalError(asyncResp->res);
                 return;
             }
+            PostCodeCache::getInstance().clear();
         },
             "xyz.openbmc_project.State.Boot.PostCode0",
             "/xyz/openbmc_project/State/Boot/PostCode0",
@@ -5119,9 +7193,7 @@ inline static bool parsePostCode(const std::string& postCodeID,
 }
 
 static bool fillPostCodeEntry(
-    const std::shared_ptr<bmcweb::AsyncResp>& aResp,
-    const boost::container::flat_map<
-        uint64_t, std::tuple<uint64_t, std::vector<uint8_t>>>& postcode,
+    const std::shared_ptr<bmcweb::AsyncResp>& aResp, const PostCodes& postcode,
     const uint16_t bootIndex, const uint64_t codeIndex = 0,
     const uint64_t skip = 0, const uint64_t top = 0)
 {
@@ -5276,18 +7348,18 @@ static void getPostCodeForEntry(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
         return;
     }
 
-    crow::connections::systemBus->async_method_call(
+    PostCodeCache::getInstance().getBoot(
+        bootIndex,
         [aResp, entryId, bootIndex,
-         codeIndex](const boost::system::error_code ec,
-                    const boost::container::flat_map<
-                        uint64_t, std::tuple<uint64_t, std::vector<uint8_t>>>&
-                        postcode) {
+         codeIndex](const boost::system::error_code& ec,
+                    const std::shared_ptr<const PostCodes>& codes) {
         if (ec)
         {
             BMCWEB_LOG_DEBUG << "DBUS POST CODE PostCode response error";
             messages::internalError(aResp->res);
             return;
         }
+        const PostCodes& postcode = *codes;
 
         if (postcode.empty())
         {
@@ -5300,11 +7372,7 @@ static void getPostCodeForEntry(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
             messages::resourceNotFound(aResp->res, "LogEntry", entryId);
             return;
         }
-    },
-        "xyz.openbmc_project.State.Boot.PostCode0",
-        "/xyz/openbmc_project/State/Boot/PostCode0",
-        "xyz.openbmc_project.State.Boot.PostCode", "GetPostCodesWithTimeStamp",
-        bootIndex);
+    });
 }
 
 static void getPostCodeForBoot(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
@@ -5313,18 +7381,17 @@ static void getPostCodeForBoot(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
                                const uint64_t entryCount, size_t skip,
                                size_t top)
 {
-    crow::connections::systemBus->async_method_call(
-        [aResp, bootIndex, bootCount, entryCount, skip,
-         top](const boost::system::error_code ec,
-              const boost::container::flat_map<
-                  uint64_t, std::tuple<uint64_t, std::vector<uint8_t>>>&
-                  postcode) {
+    PostCodeCache::getInstance().getBoot(
+        bootIndex, [aResp, bootIndex, bootCount, entryCount, skip,
+                    top](const boost::system::error_code& ec,
+                         const std::shared_ptr<const PostCodes>& codes) {
         if (ec)
         {
             BMCWEB_LOG_DEBUG << "DBUS POST CODE PostCode response error";
             messages::internalError(aResp->res);
             return;
         }
+        const PostCodes& postcode = *codes;
 
         uint64_t endCount = entryCount;
         if (!postcode.empty())
@@ -5357,11 +7424,7 @@ static void getPostCodeForBoot(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
                 "/redfish/v1/Systems/system/LogServices/PostCodes/Entries?$skip=" +
                 std::to_string(skip + top);
         }
-    },
-        "xyz.openbmc_project.State.Boot.PostCode0",
-        "/xyz/openbmc_project/State/Boot/PostCode0",
-        "xyz.openbmc_project.State.Boot.PostCode", "GetPostCodesWithTimeStamp",
-        bootIndex);
+    });
 }
 
 static void
@@ -5369,12 +7432,8 @@ static void
                          size_t skip, size_t top)
 {
     uint64_t entryCount = 0;
-    sdbusplus::asio::getProperty<uint16_t>(
-        *crow::connections::systemBus,
-        "xyz.openbmc_project.State.Boot.PostCode0",
-        "/xyz/openbmc_project/State/Boot/PostCode0",
-        "xyz.openbmc_project.State.Boot.PostCode", "CurrentBootCycleCount",
-        [aResp, entryCount, skip, top](const boost::system::error_code ec,
+    PostCodeCache::getInstance().getBootCount(
+        [aResp, entryCount, skip, top](const boost::system::error_code& ec,
                                        const uint16_t bootCount) {
         if (ec)
         {
@@ -5466,11 +7525,11 @@ inline void requestRoutesPostCodesEntryAdditionalData(App& app)
             return;
         }
 
-        crow::connections::systemBus->async_method_call(
-            [asyncResp, postCodeID, currentValue](
-                const boost::system::error_code ec,
-                const std::vector<std::tuple<uint64_t, std::vector<uint8_t>>>&
-                    postcodes) {
+        PostCodeCache::getInstance().getBoot(
+            index,
+            [asyncResp, postCodeID,
+             currentValue](const boost::system::error_code& ec,
+                           const std::shared_ptr<const PostCodes>& codes) {
             if (ec.value() == EBADR)
             {
                 messages::resourceNotFound(asyncResp->res, "LogEntry",
@@ -5485,7 +7544,7 @@ inline void requestRoutesPostCodesEntryAdditionalData(App& app)
             }
 
             size_t value = static_cast<size_t>(currentValue) - 1;
-            if (value == std::string::npos || postcodes.size() < currentValue)
+            if (value == std::string::npos || codes->size() < currentValue)
             {
                 BMCWEB_LOG_ERROR << "Wrong currentValue value";
                 messages::resourceNotFound(asyncResp->res, "LogEntry",
@@ -5493,7 +7552,8 @@ inline void requestRoutesPostCodesEntryAdditionalData(App& app)
                 return;
             }
 
-            const auto& [tID, c] = postcodes[value];
+            const std::vector<uint8_t>& c =
+                std::get<std::vector<uint8_t>>(codes->nth(value)->second);
             if (c.empty())
             {
                 BMCWEB_LOG_INFO << "No found post code data";
@@ -5510,10 +7570,7 @@ inline void requestRoutesPostCodesEntryAdditionalData(App& app)
             asyncResp->res.addHeader(
                 boost::beast::http::field::content_transfer_encoding, "Base64");
             asyncResp->res.body() = crow::utility::base64encode(strData);
-        },
-            "xyz.openbmc_project.State.Boot.PostCode0",
-            "/xyz/openbmc_project/State/Boot/PostCode0",
-            "xyz.openbmc_project.State.Boot.PostCode", "GetPostCodes", index);
+        });
     });
 }
 
@@ -5613,6 +7670,7 @@ inline std::string
  * @param[in] dbusObjPath - The DBus object path which represents redfishUri.
  * @param[in] entryJsonIdx - The json entry index to add isolated hardware
  *                            details in the appropriate entry json object.
+ * @param[in] lookups - The mapper lookups shared by the response's entries.
  *
  * @return The redfish response with "OriginOfCondition" property of
  *         LogEntry schema if success else return the error
@@ -5620,12 +7678,14 @@ inline std::string
 inline void getRedfishUriByDbusObjPath(
     const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
     const sdbusplus::message::object_path& dbusObjPath,
-    const size_t entryJsonIdx)
-{
-    crow::connections::systemBus->async_method_call(
-        [asyncResp, dbusObjPath,
-         entryJsonIdx](const boost::system::error_code ec,
-                       const dbus::utility::MapperGetObject& objType) {
+    const size_t entryJsonIdx,
+    const std::shared_ptr<hw_isolation_utils::MapperLookups>& lookups)
+{
+    lookups->getObject(
+        dbusObjPath.str,
+        [asyncResp, dbusObjPath, entryJsonIdx,
+         lookups](const boost::system::error_code& ec,
+                  const dbus::utility::MapperGetObject& objType) {
         if (ec || objType.empty())
         {
             BMCWEB_LOG_ERROR << "DBUS response error [" << ec.value() << " : "
@@ -5754,13 +7814,12 @@ inline void getRedfishUriByDbusObjPath(
             return p.first;
         });
 
-        crow::connections::systemBus->async_method_call(
+        lookups->getAncestors(
+            dbusObjPath.str, ancestorsIfacesOnly,
             [asyncResp, dbusObjPath, entryJsonIdx, redfishUri, uriIdPos,
              uriIdPattern, ancestorsIfaces, isChassisAssemblyUri](
-                const boost::system::error_code ec1,
-                const boost::container::flat_map<
-                    std::string, boost::container::flat_map<
-                                     std::string, std::vector<std::string>>>&
+                const boost::system::error_code& ec1,
+                const hw_isolation_utils::MapperLookups::Ancestors&
                     ancestors) mutable {
             if (ec1)
             {
@@ -5849,8 +7908,7 @@ inline void getRedfishUriByDbusObjPath(
                     uriPropPath /= "@odata.id";
 
                     assembly::fillWithAssemblyId(
-                        asyncResp, std::get<0>(assemblyParent),
-                        std::get<1>(assemblyParent),
+                        asyncResp, std::get<1>(assemblyParent),
                         std::get<2>(assemblyParent), uriPropPath, dbusObjPath,
                         redfishUri);
                 }
@@ -5867,22 +7925,13 @@ inline void getRedfishUriByDbusObjPath(
                     uriPropPath /= "@odata.id";
 
                     assembly::fillWithAssemblyId(
-                        asyncResp, std::get<0>(assemblyParent),
-                        std::get<1>(assemblyParent),
+                        asyncResp, std::get<1>(assemblyParent),
                         std::get<2>(assemblyParent), uriPropPath, dbusObjPath,
                         redfishUri);
                 }
             }
-        },
-            "xyz.openbmc_project.ObjectMapper",
-            "/xyz/openbmc_project/object_mapper",
-            "xyz.openbmc_project.ObjectMapper", "GetAncestors", dbusObjPath.str,
-            ancestorsIfacesOnly);
-    },
-        "xyz.openbmc_project.ObjectMapper",
-        "/xyz/openbmc_project/object_mapper",
-        "xyz.openbmc_project.ObjectMapper", "GetObject", dbusObjPath.str,
-        std::array<const char*, 0>{});
+        });
+    });
 }
 
 /**
@@ -5893,6 +7942,7 @@ inline void getRedfishUriByDbusObjPath(
  * @param[in] dbusObjPath - The DBus object path which represents redfishUri.
  * @param[in] entryJsonIdx - The json entry index to add isolated hardware
  *                            details in the appropriate entry json object.
+ * @param[in] lookups - The mapper lookups shared by the response's entries.
  *
  * @return The redfish response with "Message" property of LogEntry schema
  *         if success else nothing in redfish response.
@@ -5901,11 +7951,13 @@ inline void getRedfishUriByDbusObjPath(
 inline void getPrettyNameByDbusObjPath(
     const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
     const sdbusplus::message::object_path& dbusObjPath,
-    const size_t entryJsonIdx)
+    const size_t entryJsonIdx,
+    const std::shared_ptr<hw_isolation_utils::MapperLookups>& lookups)
 {
-    crow::connections::systemBus->async_method_call(
+    lookups->getObject(
+        dbusObjPath.str, "xyz.openbmc_project.Inventory.Item",
         [asyncResp, dbusObjPath,
-         entryJsonIdx](const boost::system::error_code ec,
+         entryJsonIdx](const boost::system::error_code& ec,
                        const dbus::utility::MapperGetObject& objType) mutable {
         if (ec || objType.empty())
         {
@@ -5952,11 +8004,7 @@ inline void getPrettyNameByDbusObjPath(
             name_util::getPrettyName(asyncResp, dbusObjPath.str,
                                      objType[0].first, "/Message"_json_pointer);
         }
-    },
-        "xyz.openbmc_project.ObjectMapper",
-        "/xyz/openbmc_project/object_mapper",
-        "xyz.openbmc_project.ObjectMapper", "GetObject", dbusObjPath.str,
-        std::array<const char*, 1>{"xyz.openbmc_project.Inventory.Item"});
+    });
 }
 
 /**
@@ -5969,6 +8017,7 @@ inline void getPrettyNameByDbusObjPath(
  * @param[in] dbusObjPath - The DBus object path which represents redfishUri.
  * @param[in] entryJsonIdx - The json entry index to add isolated hardware
  *                            details in the appropriate entry json object.
+ * @param[in] lookups - The mapper lookups shared by the response's entries.
  *
  * @return The redfish response with appropriate redfish properties of the
  *         isolated hardware details into LogEntry schema if success else
@@ -5977,7 +8026,8 @@ inline void getPrettyNameByDbusObjPath(
 inline void fillIsolatedHwDetailsByObjPath(
     const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
     const sdbusplus::message::object_path& dbusObjPath,
-    const size_t entryJsonIdx)
+    const size_t entryJsonIdx,
+    const std::shared_ptr<hw_isolation_utils::MapperLookups>& lookups)
 {
     // Fill Redfish uri of isolated hardware into "OriginOfCondition"
     if (dbusObjPath.filename().find("unit") != std::string::npos)
@@ -5986,15 +8036,16 @@ inline void fillIsolatedHwDetailsByObjPath(
         // is not modelled in inventory and redfish so the "OriginOfCondition"
         // should filled with it's parent (aka FRU of unit) path.
         getRedfishUriByDbusObjPath(asyncResp, dbusObjPath.parent_path(),
-                                   entryJsonIdx);
+                                   entryJsonIdx, lookups);
     }
     else
     {
-        getRedfishUriByDbusObjPath(asyncResp, dbusObjPath, entryJsonIdx);
+        getRedfishUriByDbusObjPath(asyncResp, dbusObjPath, entryJsonIdx,
+                                   lookups);
     }
 
     // Fill PrettyName of isolated hardware into "Message"
-    getPrettyNameByDbusObjPath(asyncResp, dbusObjPath, entryJsonIdx);
+    getPrettyNameByDbusObjPath(asyncResp, dbusObjPath, entryJsonIdx, lookups);
 }
 
 /**
@@ -6011,6 +8062,7 @@ inline void fillIsolatedHwDetailsByObjPath(
  *                            appropriate entry json object.
  * @param[in] dbusObjIt - The DBus object which contains isolated hardware
                          details.
+ * @param[in] lookups - The mapper lookups shared by the response's entries.
  *
  * @return The redfish response with appropriate redfish properties of the
  *         isolated hardware details into LogEntry schema if success else
@@ -6018,7 +8070,8 @@ inline void fillIsolatedHwDetailsByObjPath(
  */
 inline void fillSystemHardwareIsolationLogEntry(
     const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-    const size_t entryJsonIdx, GetManagedObjectsType::const_iterator& dbusObjIt)
+    const size_t entryJsonIdx, GetManagedObjectsType::const_iterator& dbusObjIt,
+    const std::shared_ptr<hw_isolation_utils::MapperLookups>& lookups)
 {
     nlohmann::json& entryJson =
         (entryJsonIdx > 0
@@ -6121,7 +8174,7 @@ inline void fillSystemHardwareIsolationLogEntry(
                                 asyncResp,
                                 sdbusplus::message::object_path(
                                     std::get<2>(assoc)),
-                                entryJsonIdx);
+                                entryJsonIdx, lookups);
                         }
                         else if (std::get<0>(assoc) == "isolated_hw_errorlog")
                         {
@@ -6194,6 +8247,7 @@ inline void getSystemHardwareIsolationLogEntryCollection(
         nlohmann::json& entriesArray = asyncResp->res.jsonValue["Members"];
         entriesArray = nlohmann::json::array();
 
+        auto lookups = std::make_shared<hw_isolation_utils::MapperLookups>();
         for (auto dbusObjIt = mgtObjs.begin(); dbusObjIt != mgtObjs.end();
              dbusObjIt++)
         {
@@ -6207,7 +8261,7 @@ inline void getSystemHardwareIsolationLogEntryCollection(
             entriesArray.push_back(nlohmann::json::object());
 
             fillSystemHardwareIsolationLogEntry(asyncResp, entriesArray.size(),
-                                                dbusObjIt);
+                                                dbusObjIt, lookups);
         }
 
         asyncResp->res.jsonValue["Members@odata.count"] = entriesArray.size();
@@ -6255,7 +8309,7 @@ inline void getSystemHardwareIsolationLogEntryCollection(
 
         // Fill the Redfish LogEntry schema for the retrieved
         // HardwareIsolation entries
-        crow::connections::systemBus->async_method_call(
+        crow::connections::bulkBus->async_method_call(
             getManagedObjectsHandler, objType[0].first,
             "/xyz/openbmc_project/hardware_isolation",
             "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
@@ -6310,7 +8364,9 @@ inline void getSystemHardwareIsolationLogEntryById(
             if (dbusObjIt->first == entryObjPath)
             {
                 entryIsPresent = true;
-                fillSystemHardwareIsolationLogEntry(asyncResp, 0, dbusObjIt);
+                fillSystemHardwareIsolationLogEntry(
+                    asyncResp, 0, dbusObjIt,
+                    std::make_shared<hw_isolation_utils::MapperLookups>());
                 break;
             }
         }
@@ -6362,7 +8418,7 @@ inline void getSystemHardwareIsolationLogEntryById(
         }
 
         // Fill the Redfish LogEntry schema for the identified entry dbus object
-        crow::connections::systemBus->async_method_call(
+        crow::connections::bulkBus->async_method_call(
             getManagedObjectsRespHandler, objType[0].first,
             "/xyz/openbmc_project/hardware_isolation",
             "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
@@ -7121,7 +9177,8 @@ inline void requestRoutesAuditLogEntry(App& app)
 
 inline void getFullAuditLogAttachment(
     const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-    const sdbusplus::message::unix_fd& unixfd)
+    const sdbusplus::message::unix_fd& unixfd,
+    const crow::byte_range::RangeRequest& rangeRequest)
 {
     int fd = -1;
     fd = dup(unixfd);
@@ -7132,55 +9189,12 @@ inline void getFullAuditLogAttachment(
         return;
     }
 
-    long long int size = lseek(fd, 0, SEEK_END);
-    if (size == -1)
-    {
-        BMCWEB_LOG_ERROR << "Failed to get size of fd " << fd;
-        messages::internalError(asyncResp->res);
-        close(fd);
-        return;
-    }
-
     /* Max file size based on default configuration:
      *   - Raw audit log: 10MB
      *   - Allow up to 20MB to adjust for JSON metadata
      */
-    constexpr int maxFileSize = 20971520;
-    if (size > maxFileSize)
-    {
-        BMCWEB_LOG_ERROR << "File size " << size
-                         << " exceeds maximum allowed size of " << maxFileSize;
-        messages::internalError(asyncResp->res);
-        close(fd);
-        return;
-    }
-    std::vector<char> data(static_cast<size_t>(size));
-    long long int rc = lseek(fd, 0, SEEK_SET);
-    if (rc == -1)
-    {
-        BMCWEB_LOG_ERROR << "Failed to seek fd " << fd;
-        messages::internalError(asyncResp->res);
-        close(fd);
-        return;
-    }
-    rc = read(fd, data.data(), data.size());
-    if ((rc == -1) || (rc != size))
-    {
-        BMCWEB_LOG_ERROR << "Failed to read fd " << fd;
-        messages::internalError(asyncResp->res);
-        close(fd);
-        return;
-    }
-    close(fd);
-
-    std::string_view strData(data.data(), data.size());
-    std::string output = crow::utility::base64encode(strData);
-
-    asyncResp->res.addHeader(boost::beast::http::field::content_type,
-                             "application/octet-stream");
-    asyncResp->res.addHeader(
-        boost::beast::http::field::content_transfer_encoding, "Base64");
-    asyncResp->res.body() = std::move(output);
+    constexpr off_t maxFileSize = 20971520;
+    sendBase64Attachment(asyncResp, fd, rangeRequest, maxFileSize);
 }
 
 inline void handleFullAuditLogAttachment(
@@ -7216,8 +9230,10 @@ inline void handleFullAuditLogAttachment(
 
     /* Download attachment */
     crow::connections::systemBus->async_method_call(
-        [asyncResp, entryID](const boost::system::error_code ec,
-                             const sdbusplus::message::unix_fd& unixfd) {
+        [asyncResp, entryID,
+         rangeRequest{crow::byte_range::RangeRequest(req)}](
+            const boost::system::error_code ec,
+            const sdbusplus::message::unix_fd& unixfd) {
         if (ec)
         {
             if (ec.value() == EBADR)
@@ -7230,7 +9246,7 @@ inline void handleFullAuditLogAttachment(
             return;
         }
 
-        getFullAuditLogAttachment(asyncResp, unixfd);
+        getFullAuditLogAttachment(asyncResp, unixfd, rangeRequest);
     },
         "xyz.openbmc_project.Logging.AuditLog",
         "/xyz/openbmc_project/logging/auditlog",
@@ -6,6 +6,7 @@
 #include <nlohmann/json.hpp>
 #include <privileges.hpp>
 #include <routing.hpp>
+#include <ssl_key_handler.hpp>
 
 #include <string>
 
@@ -31,6 +32,22 @@ inline void handleManagerDiagnosticDataGet(
         "/redfish/v1/Managers/bmc/ManagerDiagnosticData";
     asyncResp->res.jsonValue["Id"] = "ManagerDiagnosticData";
     asyncResp->res.jsonValue["Name"] = "Manager Diagnostic Data";
+
+#ifdef BMCWEB_ENABLE_SSL
+    if (app.sslContext != nullptr)
+    {
+        ensuressl::SessionCacheStats stats =
+            ensuressl::getSessionCacheStats(*app.sslContext);
+        nlohmann::json& tls =
+            asyncResp->res.jsonValue["Oem"]["OpenBMC"]["TLSSessionCache"];
+        tls["Hits"] = stats.hits;
+        tls["Misses"] = stats.misses;
+        tls["Timeouts"] = stats.timeouts;
+        tls["CacheFull"] = stats.cacheFull;
+        tls["CachedSessions"] = stats.cached;
+        tls["TicketKeyRotations"] = stats.ticketKeyRotations;
+    }
+#endif
 }
 
 inline void requestRoutesManagerDiagnosticData(App& app)
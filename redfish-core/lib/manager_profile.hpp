@@ -0,0 +1,191 @@
+#pragma once
+
+#include "app.hpp"
+#include "async_resp.hpp"
+#include "dbus_singleton.hpp"
+#include "dbus_trace.hpp"
+#include "error_messages.hpp"
+#include "http_request.hpp"
+#include "http_response.hpp"
+#include "profile_sampler.hpp"
+#include "query.hpp"
+#include "route_metrics.hpp"
+
+#include <boost/asio/steady_timer.hpp>
+#include <boost/url/params_view.hpp>
+#include <nlohmann/json.hpp>
+
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace redfish
+{
+
+inline crow::profile::ProfileSampler& getProfileSampler()
+{
+    static crow::profile::ProfileSampler sampler;
+    return sampler;
+}
+
+inline crow::profile::ProfileSampler::Totals getRouteTotals(App& app)
+{
+    crow::profile::ProfileSampler::Totals totals;
+    for (const crow::metrics::RouteSeries& series : app.getRouteMetrics())
+    {
+        if (series.metrics->requests == 0)
+        {
+            continue;
+        }
+        crow::profile::Counters& counters =
+            totals.emplace_back(series.methods + " " +
+                                    std::string(series.route),
+                                crow::profile::Counters{})
+                .second;
+        counters.count = series.metrics->requests;
+        counters.total = std::chrono::microseconds(
+            series.metrics->latency.sumMicroseconds());
+        counters.dbusCalls = series.metrics->dbusCalls;
+    }
+    return totals;
+}
+
+inline crow::profile::ProfileSampler::Totals getDbusCallTotals()
+{
+    crow::profile::ProfileSampler::Totals totals;
+    for (const auto& [call, summary] : crow::dbus_trace::getCallTotals())
+    {
+        crow::profile::Counters& counters =
+            totals.emplace_back(call.first + " " + call.second,
+                                crow::profile::Counters{})
+                .second;
+        counters.count = summary.count;
+        counters.total = summary.total;
+    }
+    return totals;
+}
+
+inline void recordProfile(App& app,
+                          const std::shared_ptr<boost::asio::steady_timer>&
+                              timer)
+{
+    getProfileSampler().record(std::chrono::steady_clock::now(),
+                               getRouteTotals(app), getDbusCallTotals());
+    timer->expires_after(crow::profile::ProfileSampler::interval);
+    timer->async_wait([&app, timer](const boost::system::error_code& ec) {
+        if (ec)
+        {
+            return;
+        }
+        recordProfile(app, timer);
+    });
+}
+
+// Reads a whole number query parameter within [min, max].  Sets an error
+// and gives nullopt if it's there but isn't one.
+inline std::optional<size_t>
+    readProfileParam(const crow::Request& req, crow::Response& res,
+                     std::string_view name, size_t defaultValue, size_t min,
+                     size_t max)
+{
+    auto it = req.urlView.params().find(name);
+    if (it == req.urlView.params().end())
+    {
+        return defaultValue;
+    }
+    std::string_view value = (*it).value;
+    size_t number = 0;
+    const char* end = value.data() + value.size();
+    auto [ptr, ec] = std::from_chars(value.data(), end, number);
+    if (ec != std::errc() || ptr != end || number < min || number > max)
+    {
+        messages::queryParameterValueFormatError(res, value, name);
+        return std::nullopt;
+    }
+    return number;
+}
+
+inline nlohmann::json::array_t
+    profileUsage(const std::vector<crow::profile::Usage>& used,
+                 std::string_view nameKey)
+{
+    nlohmann::json::array_t out;
+    for (const crow::profile::Usage& usage : used)
+    {
+        nlohmann::json::object_t entry;
+        entry[std::string(nameKey)] = usage.name;
+        entry["Count"] = usage.counters.count;
+        entry["TotalMilliseconds"] =
+            static_cast<double>(usage.counters.total.count()) / 1000.0;
+        entry["MeanMilliseconds"] =
+            static_cast<double>(usage.counters.total.count()) / 1000.0 /
+            static_cast<double>(usage.counters.count);
+        if (nameKey == "Route")
+        {
+            entry["DBusCalls"] = usage.counters.dbusCalls;
+        }
+        out.emplace_back(std::move(entry));
+    }
+    return out;
+}
+
+/**
+ * @brief The routes and D-Bus calls that took the most time over the last
+ * WindowSeconds, at most Top of each.  Worked out from the per route and
+ * per call totals behind /metrics, which are recorded every
+ * ProfileSampler::interval.
+ */
+inline void
+    handleManagerProfileGet(App& app, const crow::Request& req,
+                            const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
+{
+    if (!redfish::setUpRedfishRoute(app, req, asyncResp))
+    {
+        return;
+    }
+    std::optional<size_t> window = readProfileParam(
+        req, asyncResp->res, "WindowSeconds", 60, 1,
+        static_cast<size_t>(crow::profile::ProfileSampler::maxWindow.count()));
+    if (!window)
+    {
+        return;
+    }
+    std::optional<size_t> top =
+        readProfileParam(req, asyncResp->res, "Top", 20, 1, 1000);
+    if (!top)
+    {
+        return;
+    }
+
+    crow::profile::ProfileSampler::Totals routes = getRouteTotals(app);
+    crow::profile::ProfileSampler::Totals calls = getDbusCallTotals();
+    crow::profile::Profile profile = getProfileSampler().hottest(
+        std::chrono::steady_clock::now(), std::chrono::seconds(*window), *top,
+        routes, calls);
+
+    nlohmann::json& json = asyncResp->res.jsonValue;
+    json["@odata.id"] = "/redfish/v1/Managers/bmc/Oem/OpenBMC/Profile";
+    json["Id"] = "Profile";
+    json["Name"] = "Request Profile";
+    json["WindowSeconds"] = profile.covered.count();
+    json["Routes"] = profileUsage(profile.routes, "Route");
+    json["DBusCalls"] = profileUsage(profile.calls, "Call");
+}
+
+inline void requestRoutesManagerProfile(App& app)
+{
+    BMCWEB_ROUTE(app, "/redfish/v1/Managers/bmc/Oem/OpenBMC/Profile/")
+        .privileges({{"ConfigureManager"}})
+        .methods(boost::beast::http::verb::get)(
+            std::bind_front(handleManagerProfileGet, std::ref(app)));
+
+    recordProfile(app, std::make_shared<boost::asio::steady_timer>(
+                           crow::connections::systemBus->get_io_context()));
+}
+
+} // namespace redfish
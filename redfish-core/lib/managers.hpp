@@ -25,6 +25,7 @@
 #include "redfish_util.hpp"
 #include "registries/privilege_registry.hpp"
 #include "utils/dbus_utils.hpp"
+#include "utils/pid_config_cache.hpp"
 #include "utils/sw_utils.hpp"
 #include "utils/systemd_utils.hpp"
 #include "utils/time_utils.hpp"
@@ -34,9 +35,11 @@
 #include <sdbusplus/unpack_properties.hpp>
 
 #include <algorithm>
+#include <array>
 #include <cstdint>
 #include <memory>
 #include <sstream>
+#include <string_view>
 #include <variant>
 
 namespace redfish
@@ -325,415 +328,6 @@ inline void requestRoutesManagerResetActionInfo(App& app)
     });
 }
 
-static constexpr const char* objectManagerIface =
-    "org.freedesktop.DBus.ObjectManager";
-static constexpr const char* pidConfigurationIface =
-    "xyz.openbmc_project.Configuration.Pid";
-static constexpr const char* pidZoneConfigurationIface =
-    "xyz.openbmc_project.Configuration.Pid.Zone";
-static constexpr const char* stepwiseConfigurationIface =
-    "xyz.openbmc_project.Configuration.Stepwise";
-static constexpr const char* thermalModeIface =
-    "xyz.openbmc_project.Control.ThermalMode";
-
-inline void
-    asyncPopulatePid(const std::string& connection, const std::string& path,
-                     const std::string& currentProfile,
-                     const std::vector<std::string>& supportedProfiles,
-                     const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
-{
-    crow::connections::systemBus->async_method_call(
-        [asyncResp, currentProfile, supportedProfiles](
-            const boost::system::error_code ec,
-            const dbus::utility::ManagedObjectType& managedObj) {
-        if (ec)
-        {
-            BMCWEB_LOG_ERROR << ec;
-            messages::internalError(asyncResp->res);
-            return;
-        }
-        nlohmann::json& configRoot =
-            asyncResp->res.jsonValue["Oem"]["OpenBmc"]["Fan"];
-        nlohmann::json& fans = configRoot["FanControllers"];
-        fans["@odata.type"] = "#OemManager.FanControllers";
-        fans["@odata.id"] =
-            "/redfish/v1/Managers/bmc#/Oem/OpenBmc/Fan/FanControllers";
-
-        nlohmann::json& pids = configRoot["PidControllers"];
-        pids["@odata.type"] = "#OemManager.PidControllers";
-        pids["@odata.id"] =
-            "/redfish/v1/Managers/bmc#/Oem/OpenBmc/Fan/PidControllers";
-
-        nlohmann::json& stepwise = configRoot["StepwiseControllers"];
-        stepwise["@odata.type"] = "#OemManager.StepwiseControllers";
-        stepwise["@odata.id"] =
-            "/redfish/v1/Managers/bmc#/Oem/OpenBmc/Fan/StepwiseControllers";
-
-        nlohmann::json& zones = configRoot["FanZones"];
-        zones["@odata.id"] =
-            "/redfish/v1/Managers/bmc#/Oem/OpenBmc/Fan/FanZones";
-        zones["@odata.type"] = "#OemManager.FanZones";
-        configRoot["@odata.id"] = "/redfish/v1/Managers/bmc#/Oem/OpenBmc/Fan";
-        configRoot["@odata.type"] = "#OemManager.Fan";
-        configRoot["Profile@Redfish.AllowableValues"] = supportedProfiles;
-
-        if (!currentProfile.empty())
-        {
-            configRoot["Profile"] = currentProfile;
-        }
-        BMCWEB_LOG_ERROR << "profile = " << currentProfile << " !";
-
-        for (const auto& pathPair : managedObj)
-        {
-            for (const auto& intfPair : pathPair.second)
-            {
-                if (intfPair.first != pidConfigurationIface &&
-                    intfPair.first != pidZoneConfigurationIface &&
-                    intfPair.first != stepwiseConfigurationIface)
-                {
-                    continue;
-                }
-
-                std::string name;
-
-                for (const std::pair<std::string,
-                                     dbus::utility::DbusVariantType>& propPair :
-                     intfPair.second)
-                {
-                    if (propPair.first == "Name")
-                    {
-                        const std::string* namePtr =
-                            std::get_if<std::string>(&propPair.second);
-                        if (namePtr == nullptr)
-                        {
-                            BMCWEB_LOG_ERROR << "Pid Name Field illegal";
-                            messages::internalError(asyncResp->res);
-                            return;
-                        }
-                        name = *namePtr;
-                        dbus::utility::escapePathForDbus(name);
-                    }
-                    else if (propPair.first == "Profiles")
-                    {
-                        const std::vector<std::string>* profiles =
-                            std::get_if<std::vector<std::string>>(
-                                &propPair.second);
-                        if (profiles == nullptr)
-                        {
-                            BMCWEB_LOG_ERROR << "Pid Profiles Field illegal";
-                            messages::internalError(asyncResp->res);
-                            return;
-                        }
-                        if (std::find(profiles->begin(), profiles->end(),
-                                      currentProfile) == profiles->end())
-                        {
-                            BMCWEB_LOG_INFO
-                                << name << " not supported in current profile";
-                            continue;
-                        }
-                    }
-                }
-                nlohmann::json* config = nullptr;
-                const std::string* classPtr = nullptr;
-
-                for (const std::pair<std::string,
-                                     dbus::utility::DbusVariantType>& propPair :
-                     intfPair.second)
-                {
-                    if (propPair.first == "Class")
-                    {
-                        classPtr = std::get_if<std::string>(&propPair.second);
-                    }
-                }
-
-                if (intfPair.first == pidZoneConfigurationIface)
-                {
-                    std::string chassis;
-                    if (!dbus::utility::getNthStringFromPath(pathPair.first.str,
-                                                             5, chassis))
-                    {
-                        chassis = "#IllegalValue";
-                    }
-                    nlohmann::json& zone = zones[name];
-                    zone["Chassis"]["@odata.id"] = "/redfish/v1/Chassis/" +
-                                                   chassis;
-                    zone["@odata.id"] =
-                        "/redfish/v1/Managers/bmc#/Oem/OpenBmc/Fan/FanZones/" +
-                        name;
-                    zone["@odata.type"] = "#OemManager.FanZone";
-                    config = &zone;
-                }
-
-                else if (intfPair.first == stepwiseConfigurationIface)
-                {
-                    if (classPtr == nullptr)
-                    {
-                        BMCWEB_LOG_ERROR << "Pid Class Field illegal";
-                        messages::internalError(asyncResp->res);
-                        return;
-                    }
-
-                    nlohmann::json& controller = stepwise[name];
-                    config = &controller;
-
-                    controller["@odata.id"] =
-                        "/redfish/v1/Managers/bmc#/Oem/OpenBmc/Fan/StepwiseControllers/" +
-                        name;
-                    controller["@odata.type"] =
-                        "#OemManager.StepwiseController";
-
-                    controller["Direction"] = *classPtr;
-                }
-
-                // pid and fans are off the same configuration
-                else if (intfPair.first == pidConfigurationIface)
-                {
-                    if (classPtr == nullptr)
-                    {
-                        BMCWEB_LOG_ERROR << "Pid Class Field illegal";
-                        messages::internalError(asyncResp->res);
-                        return;
-                    }
-                    bool isFan = *classPtr == "fan";
-                    nlohmann::json& element = isFan ? fans[name] : pids[name];
-                    config = &element;
-                    if (isFan)
-                    {
-                        element["@odata.id"] =
-                            "/redfish/v1/Managers/bmc#/Oem/OpenBmc/Fan/FanControllers/" +
-                            name;
-                        element["@odata.type"] = "#OemManager.FanController";
-                    }
-                    else
-                    {
-                        element["@odata.id"] =
-                            "/redfish/v1/Managers/bmc#/Oem/OpenBmc/Fan/PidControllers/" +
-                            name;
-                        element["@odata.type"] = "#OemManager.PidController";
-                    }
-                }
-                else
-                {
-                    BMCWEB_LOG_ERROR << "Unexpected configuration";
-                    messages::internalError(asyncResp->res);
-                    return;
-                }
-
-                // used for making maps out of 2 vectors
-                const std::vector<double>* keys = nullptr;
-                const std::vector<double>* values = nullptr;
-
-                for (const auto& propertyPair : intfPair.second)
-                {
-                    if (propertyPair.first == "Type" ||
-                        propertyPair.first == "Class" ||
-                        propertyPair.first == "Name")
-                    {
-                        continue;
-                    }
-
-                    // zones
-                    if (intfPair.first == pidZoneConfigurationIface)
-                    {
-                        const double* ptr =
-                            std::get_if<double>(&propertyPair.second);
-                        if (ptr == nullptr)
-                        {
-                            BMCWEB_LOG_ERROR << "Field Illegal "
-                                             << propertyPair.first;
-                            messages::internalError(asyncResp->res);
-                            return;
-                        }
-                        (*config)[propertyPair.first] = *ptr;
-                    }
-
-                    if (intfPair.first == stepwiseConfigurationIface)
-                    {
-                        if (propertyPair.first == "Reading" ||
-                            propertyPair.first == "Output")
-                        {
-                            const std::vector<double>* ptr =
-                                std::get_if<std::vector<double>>(
-                                    &propertyPair.second);
-
-                            if (ptr == nullptr)
-                            {
-                                BMCWEB_LOG_ERROR << "Field Illegal "
-                                                 << propertyPair.first;
-                                messages::internalError(asyncResp->res);
-                                return;
-                            }
-
-                            if (propertyPair.first == "Reading")
-                            {
-                                keys = ptr;
-                            }
-                            else
-                            {
-                                values = ptr;
-                            }
-                            if (keys != nullptr && values != nullptr)
-                            {
-                                if (keys->size() != values->size())
-                                {
-                                    BMCWEB_LOG_ERROR
-                                        << "Reading and Output size don't match ";
-                                    messages::internalError(asyncResp->res);
-                                    return;
-                                }
-                                nlohmann::json& steps = (*config)["Steps"];
-                                steps = nlohmann::json::array();
-                                for (size_t ii = 0; ii < keys->size(); ii++)
-                                {
-                                    nlohmann::json::object_t step;
-                                    step["Target"] = (*keys)[ii];
-                                    step["Output"] = (*values)[ii];
-                                    steps.push_back(std::move(step));
-                                }
-                            }
-                        }
-                        if (propertyPair.first == "NegativeHysteresis" ||
-                            propertyPair.first == "PositiveHysteresis")
-                        {
-                            const double* ptr =
-                                std::get_if<double>(&propertyPair.second);
-                            if (ptr == nullptr)
-                            {
-                                BMCWEB_LOG_ERROR << "Field Illegal "
-                                                 << propertyPair.first;
-                                messages::internalError(asyncResp->res);
-                                return;
-                            }
-                            (*config)[propertyPair.first] = *ptr;
-                        }
-                    }
-
-                    // pid and fans are off the same configuration
-                    if (intfPair.first == pidConfigurationIface ||
-                        intfPair.first == stepwiseConfigurationIface)
-                    {
-                        if (propertyPair.first == "Zones")
-                        {
-                            const std::vector<std::string>* inputs =
-                                std::get_if<std::vector<std::string>>(
-                                    &propertyPair.second);
-
-                            if (inputs == nullptr)
-                            {
-                                BMCWEB_LOG_ERROR << "Zones Pid Field Illegal";
-                                messages::internalError(asyncResp->res);
-                                return;
-                            }
-                            auto& data = (*config)[propertyPair.first];
-                            data = nlohmann::json::array();
-                            for (std::string itemCopy : *inputs)
-                            {
-                                dbus::utility::escapePathForDbus(itemCopy);
-                                nlohmann::json::object_t input;
-                                input["@odata.id"] =
-                                    "/redfish/v1/Managers/bmc#/Oem/OpenBmc/Fan/FanZones/" +
-                                    itemCopy;
-                                data.push_back(std::move(input));
-                            }
-                        }
-                        // todo(james): may never happen, but this
-                        // assumes configuration data referenced in the
-                        // PID config is provided by the same daemon, we
-                        // could add another loop to cover all cases,
-                        // but I'm okay kicking this can down the road a
-                        // bit
-
-                        else if (propertyPair.first == "Inputs" ||
-                                 propertyPair.first == "Outputs")
-                        {
-                            auto& data = (*config)[propertyPair.first];
-                            const std::vector<std::string>* inputs =
-                                std::get_if<std::vector<std::string>>(
-                                    &propertyPair.second);
-
-                            if (inputs == nullptr)
-                            {
-                                BMCWEB_LOG_ERROR << "Field Illegal "
-                                                 << propertyPair.first;
-                                messages::internalError(asyncResp->res);
-                                return;
-                            }
-                            data = *inputs;
-                        }
-                        else if (propertyPair.first == "SetPointOffset")
-                        {
-                            const std::string* ptr =
-                                std::get_if<std::string>(&propertyPair.second);
-
-                            if (ptr == nullptr)
-                            {
-                                BMCWEB_LOG_ERROR << "Field Illegal "
-                                                 << propertyPair.first;
-                                messages::internalError(asyncResp->res);
-                                return;
-                            }
-                            // translate from dbus to redfish
-                            if (*ptr == "WarningHigh")
-                            {
-                                (*config)["SetPointOffset"] =
-                                    "UpperThresholdNonCritical";
-                            }
-                            else if (*ptr == "WarningLow")
-                            {
-                                (*config)["SetPointOffset"] =
-                                    "LowerThresholdNonCritical";
-                            }
-                            else if (*ptr == "CriticalHigh")
-                            {
-                                (*config)["SetPointOffset"] =
-                                    "UpperThresholdCritical";
-                            }
-                            else if (*ptr == "CriticalLow")
-                            {
-                                (*config)["SetPointOffset"] =
-                                    "LowerThresholdCritical";
-                            }
-                            else
-                            {
-                                BMCWEB_LOG_ERROR << "Value Illegal " << *ptr;
-                                messages::internalError(asyncResp->res);
-                                return;
-                            }
-                        }
-                        // doubles
-                        else if (propertyPair.first == "FFGainCoefficient" ||
-                                 propertyPair.first == "FFOffCoefficient" ||
-                                 propertyPair.first == "ICoefficient" ||
-                                 propertyPair.first == "ILimitMax" ||
-                                 propertyPair.first == "ILimitMin" ||
-                                 propertyPair.first == "PositiveHysteresis" ||
-                                 propertyPair.first == "NegativeHysteresis" ||
-                                 propertyPair.first == "OutLimitMax" ||
-                                 propertyPair.first == "OutLimitMin" ||
-                                 propertyPair.first == "PCoefficient" ||
-                                 propertyPair.first == "SetPoint" ||
-                                 propertyPair.first == "SlewNeg" ||
-                                 propertyPair.first == "SlewPos")
-                        {
-                            const double* ptr =
-                                std::get_if<double>(&propertyPair.second);
-                            if (ptr == nullptr)
-                            {
-                                BMCWEB_LOG_ERROR << "Field Illegal "
-                                                 << propertyPair.first;
-                                messages::internalError(asyncResp->res);
-                                return;
-                            }
-                            (*config)[propertyPair.first] = *ptr;
-                        }
-                    }
-                }
-            }
-        }
-    },
-        connection, path, objectManagerIface, "GetManagedObjects");
-}
-
 enum class CreatePIDRet
 {
     fail,
@@ -780,33 +374,25 @@ inline bool
 }
 
 inline const dbus::utility::ManagedObjectType::value_type*
-    findChassis(const dbus::utility::ManagedObjectType& managedObj,
+    findChassis(const pid_util::ObjectLeafIndex& objects,
                 const std::string& value, std::string& chassis)
 {
     BMCWEB_LOG_DEBUG << "Find Chassis: " << value << "\n";
 
     std::string escaped = value;
     std::replace(escaped.begin(), escaped.end(), '_', ' ');
-    escaped = "/" + escaped;
-    auto it = std::find_if(managedObj.begin(), managedObj.end(),
-                           [&escaped](const auto& obj) {
-        if (boost::algorithm::ends_with(obj.first.str, escaped))
-        {
-            BMCWEB_LOG_DEBUG << "Matched " << obj.first.str << "\n";
-            return true;
-        }
-        return false;
-    });
-
-    if (it == managedObj.end())
+    const dbus::utility::ManagedObjectType::value_type* object =
+        objects.find(escaped);
+    if (object == nullptr)
     {
         return nullptr;
     }
+    BMCWEB_LOG_DEBUG << "Matched " << object->first.str << "\n";
     // 5 comes from <chassis-name> being the 5th element
     // /xyz/openbmc_project/inventory/system/chassis/<chassis-name>
-    if (dbus::utility::getNthStringFromPath(it->first.str, 5, chassis))
+    if (dbus::utility::getNthStringFromPath(object->first.str, 5, chassis))
     {
-        return &(*it);
+        return object;
     }
 
     return nullptr;
@@ -815,7 +401,7 @@ inline const dbus::utility::ManagedObjectType::value_type*
 inline CreatePIDRet createPidInterface(
     const std::shared_ptr<bmcweb::AsyncResp>& response, const std::string& type,
     const nlohmann::json::iterator& it, const std::string& path,
-    const dbus::utility::ManagedObjectType& managedObj, bool createNewObject,
+    const pid_util::ObjectLeafIndex& managedObj, bool createNewObject,
     dbus::utility::DBusPropertiesMap& output, std::string& chassis,
     const std::string& profile)
 {
@@ -1221,183 +807,18 @@ inline CreatePIDRet createPidInterface(
     }
     return CreatePIDRet::patch;
 }
-struct GetPIDValues : std::enable_shared_from_this<GetPIDValues>
+inline void getPIDValues(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
 {
-    struct CompletionValues
-    {
-        std::vector<std::string> supportedProfiles;
-        std::string currentProfile;
-        dbus::utility::MapperGetSubTreeResponse subtree;
-    };
-
-    explicit GetPIDValues(
-        const std::shared_ptr<bmcweb::AsyncResp>& asyncRespIn) :
-        asyncResp(asyncRespIn)
-
-    {}
-
-    void run()
-    {
-        std::shared_ptr<GetPIDValues> self = shared_from_this();
-
-        // get all configurations
-        crow::connections::systemBus->async_method_call(
-            [self](
-                const boost::system::error_code ec,
-                const dbus::utility::MapperGetSubTreeResponse& subtreeLocal) {
-            if (ec)
-            {
-                BMCWEB_LOG_ERROR << ec;
-                messages::internalError(self->asyncResp->res);
-                return;
-            }
-            self->complete.subtree = subtreeLocal;
-        },
-            "xyz.openbmc_project.ObjectMapper",
-            "/xyz/openbmc_project/object_mapper",
-            "xyz.openbmc_project.ObjectMapper", "GetSubTree", "/", 0,
-            std::array<const char*, 4>{
-                pidConfigurationIface, pidZoneConfigurationIface,
-                objectManagerIface, stepwiseConfigurationIface});
-
-        // at the same time get the selected profile
-        crow::connections::systemBus->async_method_call(
-            [self](
-                const boost::system::error_code ec,
-                const dbus::utility::MapperGetSubTreeResponse& subtreeLocal) {
-            if (ec || subtreeLocal.empty())
-            {
-                return;
-            }
-            if (subtreeLocal[0].second.size() != 1)
-            {
-                // invalid mapper response, should never happen
-                BMCWEB_LOG_ERROR << "GetPIDValues: Mapper Error";
-                messages::internalError(self->asyncResp->res);
-                return;
-            }
-
-            const std::string& path = subtreeLocal[0].first;
-            const std::string& owner = subtreeLocal[0].second[0].first;
-
-            sdbusplus::asio::getAllProperties(
-                *crow::connections::systemBus, owner, path, thermalModeIface,
-                [path, owner,
-                 self](const boost::system::error_code ec2,
-                       const dbus::utility::DBusPropertiesMap& resp) {
-                if (ec2)
-                {
-                    BMCWEB_LOG_ERROR
-                        << "GetPIDValues: Can't get thermalModeIface " << path;
-                    messages::internalError(self->asyncResp->res);
-                    return;
-                }
-
-                const std::string* current = nullptr;
-                const std::vector<std::string>* supported = nullptr;
-
-                const bool success = sdbusplus::unpackPropertiesNoThrow(
-                    dbus_utils::UnpackErrorPrinter(), resp, "Current", current,
-                    "Supported", supported);
-
-                if (!success)
-                {
-                    messages::internalError(self->asyncResp->res);
-                    return;
-                }
-
-                if (current == nullptr || supported == nullptr)
-                {
-                    BMCWEB_LOG_ERROR
-                        << "GetPIDValues: thermal mode iface invalid " << path;
-                    messages::internalError(self->asyncResp->res);
-                    return;
-                }
-                self->complete.currentProfile = *current;
-                self->complete.supportedProfiles = *supported;
-            });
-        },
-            "xyz.openbmc_project.ObjectMapper",
-            "/xyz/openbmc_project/object_mapper",
-            "xyz.openbmc_project.ObjectMapper", "GetSubTree", "/", 0,
-            std::array<const char*, 1>{thermalModeIface});
-    }
-
-    static void
-        processingComplete(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-                           const CompletionValues& completion)
-    {
-        if (asyncResp->res.result() != boost::beast::http::status::ok)
+    pid_util::PidConfigCache::getInstance().get(
+        [asyncResp](const std::shared_ptr<const nlohmann::json>& fan) {
+        if (!fan)
         {
+            messages::internalError(asyncResp->res);
             return;
         }
-        // create map of <connection, path to objMgr>>
-        boost::container::flat_map<
-            std::string, std::string, std::less<>,
-            std::vector<std::pair<std::string, std::string>>>
-            objectMgrPaths;
-        boost::container::flat_set<std::string, std::less<>,
-                                   std::vector<std::string>>
-            calledConnections;
-        for (const auto& pathGroup : completion.subtree)
-        {
-            for (const auto& connectionGroup : pathGroup.second)
-            {
-                auto findConnection =
-                    calledConnections.find(connectionGroup.first);
-                if (findConnection != calledConnections.end())
-                {
-                    break;
-                }
-                for (const std::string& interface : connectionGroup.second)
-                {
-                    if (interface == objectManagerIface)
-                    {
-                        objectMgrPaths[connectionGroup.first] = pathGroup.first;
-                    }
-                    // this list is alphabetical, so we
-                    // should have found the objMgr by now
-                    if (interface == pidConfigurationIface ||
-                        interface == pidZoneConfigurationIface ||
-                        interface == stepwiseConfigurationIface)
-                    {
-                        auto findObjMgr =
-                            objectMgrPaths.find(connectionGroup.first);
-                        if (findObjMgr == objectMgrPaths.end())
-                        {
-                            BMCWEB_LOG_DEBUG << connectionGroup.first
-                                             << "Has no Object Manager";
-                            continue;
-                        }
-
-                        calledConnections.insert(connectionGroup.first);
-
-                        asyncPopulatePid(findObjMgr->first, findObjMgr->second,
-                                         completion.currentProfile,
-                                         completion.supportedProfiles,
-                                         asyncResp);
-                        break;
-                    }
-                }
-            }
-        }
-    }
-
-    ~GetPIDValues()
-    {
-        boost::asio::post(crow::connections::systemBus->get_io_context(),
-                          std::bind_front(&processingComplete, asyncResp,
-                                          std::move(complete)));
-    }
-
-    GetPIDValues(const GetPIDValues&) = delete;
-    GetPIDValues(GetPIDValues&&) = delete;
-    GetPIDValues& operator=(const GetPIDValues&) = delete;
-    GetPIDValues& operator=(GetPIDValues&&) = delete;
-
-    std::shared_ptr<bmcweb::AsyncResp> asyncResp;
-    CompletionValues complete;
-};
+        asyncResp->res.jsonValue["Oem"]["OpenBmc"]["Fan"] = *fan;
+    });
+}
 
 struct SetPIDValues : std::enable_shared_from_this<SetPIDValues>
 {
@@ -1542,6 +963,9 @@ struct SetPIDValues : std::enable_shared_from_this<SetPIDValues>
             return;
         }
         std::shared_ptr<bmcweb::AsyncResp> response = asyncResp;
+        // The changes signal themselves as well, but a GET right after this
+        // PATCH shouldn't depend on the signals having arrived first
+        pid_util::PidConfigCache::getInstance().clear();
         if (profile)
         {
             if (std::find(supportedProfiles.begin(), supportedProfiles.end(),
@@ -1565,6 +989,7 @@ struct SetPIDValues : std::enable_shared_from_this<SetPIDValues>
                 "Current", dbus::utility::DbusVariantType(*profile));
         }
 
+        const pid_util::ObjectLeafIndex objects(managedObj);
         for (auto& containerPair : configuration)
         {
             auto& container = containerPair.second;
@@ -1582,19 +1007,15 @@ struct SetPIDValues : std::enable_shared_from_this<SetPIDValues>
                 const auto& name = it.key();
                 BMCWEB_LOG_DEBUG << "looking for " << name;
 
-                auto pathItr = std::find_if(managedObj.begin(),
-                                            managedObj.end(),
-                                            [&name](const auto& obj) {
-                    return boost::algorithm::ends_with(obj.first.str,
-                                                       "/" + name);
-                });
+                const dbus::utility::ManagedObjectType::value_type* pathItr =
+                    objects.find(name);
                 dbus::utility::DBusPropertiesMap output;
 
                 output.reserve(16); // The pid interface length
 
                 // determines if we're patching entity-manager or
                 // creating a new object
-                bool createNewObject = (pathItr == managedObj.end());
+                bool createNewObject = (pathItr == nullptr);
                 BMCWEB_LOG_DEBUG << "Found = " << !createNewObject;
 
                 std::string iface;
@@ -1649,7 +1070,7 @@ struct SetPIDValues : std::enable_shared_from_this<SetPIDValues>
                 }
 
                 std::string path;
-                if (pathItr != managedObj.end())
+                if (pathItr != nullptr)
                 {
                     path = pathItr->first.str;
                 }
@@ -1669,7 +1090,7 @@ struct SetPIDValues : std::enable_shared_from_this<SetPIDValues>
 
                 std::string chassis;
                 CreatePIDRet ret = createPidInterface(
-                    response, type, it, path, managedObj, createNewObject,
+                    response, type, it, path, objects, createNewObject,
                     output, chassis, currentProfile);
                 if (ret == CreatePIDRet::fail)
                 {
@@ -1711,17 +1132,9 @@ struct SetPIDValues : std::enable_shared_from_this<SetPIDValues>
                         return;
                     }
 
-                    bool foundChassis = false;
-                    for (const auto& obj : managedObj)
-                    {
-                        if (boost::algorithm::ends_with(obj.first.str, chassis))
-                        {
-                            chassis = obj.first.str;
-                            foundChassis = true;
-                            break;
-                        }
-                    }
-                    if (!foundChassis)
+                    const dbus::utility::ManagedObjectType::value_type*
+                        chassisObject = objects.find(chassis);
+                    if (chassisObject == nullptr)
                     {
                         BMCWEB_LOG_ERROR << "Failed to find chassis on dbus";
                         messages::resourceMissingAtURI(
@@ -1730,6 +1143,7 @@ struct SetPIDValues : std::enable_shared_from_this<SetPIDValues>
                                                          "Chassis", chassis));
                         return;
                     }
+                    chassis = chassisObject->first.str;
 
                     crow::connections::systemBus->async_method_call(
                         [response](const boost::system::error_code ec) {
@@ -1787,11 +1201,11 @@ inline void getLocation(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
 {
     BMCWEB_LOG_DEBUG << "Get BMC manager Location data.";
 
-    sdbusplus::asio::getProperty<std::string>(
-        *crow::connections::systemBus, connectionName, path,
-        "xyz.openbmc_project.Inventory.Decorator.LocationCode", "LocationCode",
-        [aResp](const boost::system::error_code ec,
-                const std::string& property) {
+    dbus::utility::getAllProperties(
+        connectionName, path,
+        "xyz.openbmc_project.Inventory.Decorator.LocationCode",
+        [aResp](const boost::system::error_code& ec,
+                const dbus::utility::DBusPropertiesMap& properties) {
         if (ec)
         {
             BMCWEB_LOG_DEBUG << "DBUS response error for "
@@ -1800,38 +1214,22 @@ inline void getLocation(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
             return;
         }
 
-        aResp->res.jsonValue["Location"]["PartLocation"]["ServiceLabel"] =
-            property;
-    });
-}
-// avoid name collision systems.hpp
-inline void
-    managerGetLastResetTime(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
-{
-    BMCWEB_LOG_DEBUG << "Getting Manager Last Reset Time";
-
-    sdbusplus::asio::getProperty<uint64_t>(
-        *crow::connections::systemBus, "xyz.openbmc_project.State.BMC",
-        "/xyz/openbmc_project/state/bmc0", "xyz.openbmc_project.State.BMC",
-        "LastRebootTime",
-        [aResp](const boost::system::error_code ec,
-                const uint64_t lastResetTime) {
-        if (ec)
+        const std::string* locationCode = nullptr;
+
+        const bool success = sdbusplus::unpackPropertiesNoThrow(
+            dbus_utils::UnpackErrorPrinter(), properties, "LocationCode",
+            locationCode);
+
+        if (!success || locationCode == nullptr)
         {
-            BMCWEB_LOG_DEBUG << "D-BUS response error " << ec;
+            messages::internalError(aResp->res);
             return;
         }
 
-        // LastRebootTime is epoch time, in milliseconds
-        // https://github.com/openbmc/phosphor-dbus-interfaces/blob/7f9a128eb9296e926422ddc312c148b625890bb6/xyz/openbmc_project/State/BMC.interface.yaml#L19
-        uint64_t lastResetTimeStamp = lastResetTime / 1000;
-
-        // Convert to ISO 8601 standard
-        aResp->res.jsonValue["LastResetTime"] =
-            redfish::time_utils::getDateTimeUint(lastResetTimeStamp);
+        aResp->res.jsonValue["Location"]["PartLocation"]["ServiceLabel"] =
+            *locationCode;
     });
 }
-
 /**
  * @brief Set the running firmware image
  *
@@ -1990,53 +1388,84 @@ inline void setDateTime(std::shared_ptr<bmcweb::AsyncResp> aResp,
     }
 }
 
+inline void setBMCState(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
+                        const std::string& bmcState)
+{
+    if (bmcState == "xyz.openbmc_project.State.BMC.BMCState.Ready")
+    {
+        aResp->res.jsonValue["Status"]["State"] = "Enabled";
+        aResp->res.jsonValue["Status"]["Health"] = "OK";
+    }
+    else if (bmcState == "xyz.openbmc_project.State.BMC.BMCState."
+                         "Quiesced")
+    {
+        aResp->res.jsonValue["Status"]["State"] = "Quiesced";
+        aResp->res.jsonValue["Status"]["Health"] = "Critical";
+    }
+    else if (bmcState == "xyz.openbmc_project.State.BMC.BMCState."
+                         "NotReady")
+    {
+        aResp->res.jsonValue["Status"]["State"] = "Starting";
+        aResp->res.jsonValue["Status"]["Health"] = "OK";
+    }
+    else if (bmcState == "xyz.openbmc_project.State.BMC.BMCState."
+                         "UpdateInProgress")
+    {
+        aResp->res.jsonValue["Status"]["State"] = "Updating";
+        aResp->res.jsonValue["Status"]["Health"] = "OK";
+    }
+    else
+    {
+        BMCWEB_LOG_DEBUG << "Unsupported D-Bus CurrentBMCState " << bmcState;
+        aResp->res.jsonValue["Status"]["State"] = "Enabled";
+        aResp->res.jsonValue["Status"]["Health"] = "OK";
+    }
+}
+
+/**
+ * @brief Fills Status and LastResetTime from one read of the BMC state
+ * object, which holds both.
+ */
 inline void getBMCState(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
 {
     aResp->res.jsonValue["PowerState"] = "On";
-    sdbusplus::asio::getProperty<std::string>(
-        *crow::connections::systemBus, "xyz.openbmc_project.State.BMC",
-        "/xyz/openbmc_project/state/bmc0", "xyz.openbmc_project.State.BMC",
-        "CurrentBMCState",
-        [aResp](const boost::system::error_code ec,
-                const std::string& bmcState) {
+    dbus::utility::getAllProperties(
+        "xyz.openbmc_project.State.BMC", "/xyz/openbmc_project/state/bmc0",
+        "xyz.openbmc_project.State.BMC",
+        [aResp](const boost::system::error_code& ec,
+                const dbus::utility::DBusPropertiesMap& properties) {
         if (ec)
         {
-            BMCWEB_LOG_DEBUG << "DBUS response error for "
-                                "Location";
+            BMCWEB_LOG_DEBUG << "D-BUS response error " << ec;
             aResp->res.jsonValue["Status"]["State"] = "Enabled";
             aResp->res.jsonValue["Status"]["Health"] = "OK";
             return;
         }
 
-        if (bmcState == "xyz.openbmc_project.State.BMC.BMCState.Ready")
-        {
-            aResp->res.jsonValue["Status"]["State"] = "Enabled";
-            aResp->res.jsonValue["Status"]["Health"] = "OK";
-        }
-        else if (bmcState == "xyz.openbmc_project.State.BMC.BMCState."
-                             "Quiesced")
-        {
-            aResp->res.jsonValue["Status"]["State"] = "Quiesced";
-            aResp->res.jsonValue["Status"]["Health"] = "Critical";
-        }
-        else if (bmcState == "xyz.openbmc_project.State.BMC.BMCState."
-                             "NotReady")
-        {
-            aResp->res.jsonValue["Status"]["State"] = "Starting";
-            aResp->res.jsonValue["Status"]["Health"] = "OK";
-        }
-        else if (bmcState == "xyz.openbmc_project.State.BMC.BMCState."
-                             "UpdateInProgress")
+        const std::string* bmcState = nullptr;
+        const uint64_t* lastRebootTime = nullptr;
+
+        const bool success = sdbusplus::unpackPropertiesNoThrow(
+            dbus_utils::UnpackErrorPrinter(), properties, "CurrentBMCState",
+            bmcState, "LastRebootTime", lastRebootTime);
+
+        if (!success)
         {
-            aResp->res.jsonValue["Status"]["State"] = "Updating";
-            aResp->res.jsonValue["Status"]["Health"] = "OK";
+            messages::internalError(aResp->res);
+            return;
         }
-        else
+
+        setBMCState(aResp, bmcState == nullptr ? "" : *bmcState);
+
+        if (lastRebootTime != nullptr)
         {
-            BMCWEB_LOG_DEBUG << "Unsupported D-Bus CurrentBMCState "
-                             << bmcState;
-            aResp->res.jsonValue["Status"]["State"] = "Enabled";
-            aResp->res.jsonValue["Status"]["Health"] = "OK";
+            // LastRebootTime is epoch time, in milliseconds
+            // https://github.com/openbmc/phosphor-dbus-interfaces/blob/7f9a128eb9296e926422ddc312c148b625890bb6/xyz/openbmc_project/State/BMC.interface.yaml#L19
+            uint64_t lastResetTimeStamp = *lastRebootTime / 1000;
+
+            // Convert to ISO 8601 standard
+            aResp->res.jsonValue["LastResetTime"] =
+                redfish::time_utils::getDateTimeUint(lastResetTimeStamp);
         }
     });
 }
@@ -2147,8 +1576,6 @@ inline void requestRoutesManager(App& app)
         sw_util::populateSoftwareInformation(asyncResp, sw_util::bmcPurpose,
                                              "FirmwareVersion", true);
 
-        managerGetLastResetTime(asyncResp);
-
 #ifdef BMCWEB_ENABLE_IBM_USB_CODE_UPDATE
         getUSBCodeUpdateState(asyncResp);
 #endif
@@ -2160,8 +1587,7 @@ inline void requestRoutesManager(App& app)
             "/redfish/v1/Managers/bmc/ManagerDiagnosticData";
 
 #ifdef BMCWEB_ENABLE_REDFISH_OEM_MANAGER_FAN_DATA
-        auto pids = std::make_shared<GetPIDValues>(asyncResp);
-        pids->run();
+        getPIDValues(asyncResp);
 #endif
 
         getMainChassisId(asyncResp,
@@ -2178,9 +1604,12 @@ inline void requestRoutesManager(App& app)
                 "/redfish/v1/Chassis/" + chassisId;
         });
 
-        crow::connections::systemBus->async_method_call(
+        constexpr std::array<std::string_view, 1> bmcInterfaces = {
+            "xyz.openbmc_project.Inventory.Item.Bmc"};
+        dbus::utility::getSubTree(
+            "/xyz/openbmc_project/inventory", 0, bmcInterfaces,
             [asyncResp](
-                const boost::system::error_code ec,
+                const boost::system::error_code& ec,
                 const dbus::utility::MapperGetSubTreeResponse& subtree) {
             if (ec)
             {
@@ -2216,10 +1645,10 @@ inline void requestRoutesManager(App& app)
                 if (interfaceName ==
                     "xyz.openbmc_project.Inventory.Decorator.Asset")
                 {
-                    sdbusplus::asio::getAllProperties(
-                        *crow::connections::systemBus, connectionName, path,
+                    dbus::utility::getAllProperties(
+                        connectionName, path,
                         "xyz.openbmc_project.Inventory.Decorator.Asset",
-                        [asyncResp](const boost::system::error_code ec2,
+                        [asyncResp](const boost::system::error_code& ec2,
                                     const dbus::utility::DBusPropertiesMap&
                                         propertiesList) {
                         if (ec2)
@@ -2287,13 +1716,7 @@ inline void requestRoutesManager(App& app)
                     getLocationIndicatorActive(asyncResp, path);
                 }
             }
-        },
-            "xyz.openbmc_project.ObjectMapper",
-            "/xyz/openbmc_project/object_mapper",
-            "xyz.openbmc_project.ObjectMapper", "GetSubTree",
-            "/xyz/openbmc_project/inventory", int32_t(0),
-            std::array<const char*, 1>{
-                "xyz.openbmc_project.Inventory.Item.Bmc"});
+        });
     });
 
     BMCWEB_ROUTE(app, "/redfish/v1/Managers/bmc/")
@@ -20,13 +20,12 @@
 #include <nlohmann/json.hpp>
 #include <query.hpp>
 #include <registries/privilege_registry.hpp>
-#include <sdbusplus/asio/property.hpp>
 #include <sdbusplus/unpack_properties.hpp>
 #include <utils/collection.hpp>
+#include <utils/enum_table.hpp>
 #include <utils/hex_utils.hpp>
 #include <utils/hw_isolation.hpp>
 #include <utils/json_utils.hpp>
-#include <utils/name_utils.hpp>
 
 namespace redfish
 {
@@ -35,97 +34,43 @@ namespace redfish
 constexpr std::array<const char*, 1> dimmInterfaces = {
     "xyz.openbmc_project.Inventory.Item.Dimm"};
 
+// D-Bus DeviceType values, less their prefix, and the MemoryDeviceType each
+// translates to
+constexpr auto memoryDeviceTypes = enum_utils::makeStringMap<std::string_view>(
+    {{"DDR", "DDR"},
+     {"DDR2", "DDR2"},
+     {"DDR3", "DDR3"},
+     {"DDR4", "DDR4"},
+     {"DDR4E_SDRAM", "DDR4E_SDRAM"},
+     {"DDR5", "DDR5"},
+     {"LPDDR4_SDRAM", "LPDDR4_SDRAM"},
+     {"LPDDR3_SDRAM", "LPDDR3_SDRAM"},
+     {"DDR2_SDRAM_FB_DIMM", "DDR2_SDRAM_FB_DIMM"},
+     {"DDR2_SDRAM_FB_DIMM_PROBE", "DDR2_SDRAM_FB_DIMM_PROBE"},
+     {"DDR_SGRAM", "DDR_SGRAM"},
+     {"ROM", "ROM"},
+     {"SDRAM", "SDRAM"},
+     {"EDO", "EDO"},
+     {"FastPageMode", "FastPageMode"},
+     {"PipelinedNibble", "PipelinedNibble"},
+     {"Logical", "Logical"},
+     {"HBM", "HBM"},
+     {"HBM2", "HBM2"},
+     {"HBM3", "HBM3"}});
+
 inline std::string translateMemoryTypeToRedfish(const std::string& memoryType)
 {
-    if (memoryType == "xyz.openbmc_project.Inventory.Item.Dimm.DeviceType.DDR")
-    {
-        return "DDR";
-    }
-    if (memoryType == "xyz.openbmc_project.Inventory.Item.Dimm.DeviceType.DDR2")
-    {
-        return "DDR2";
-    }
-    if (memoryType == "xyz.openbmc_project.Inventory.Item.Dimm.DeviceType.DDR3")
-    {
-        return "DDR3";
-    }
-    if (memoryType == "xyz.openbmc_project.Inventory.Item.Dimm.DeviceType.DDR4")
-    {
-        return "DDR4";
-    }
-    if (memoryType ==
-        "xyz.openbmc_project.Inventory.Item.Dimm.DeviceType.DDR4E_SDRAM")
-    {
-        return "DDR4E_SDRAM";
-    }
-    if (memoryType == "xyz.openbmc_project.Inventory.Item.Dimm.DeviceType.DDR5")
-    {
-        return "DDR5";
-    }
-    if (memoryType ==
-        "xyz.openbmc_project.Inventory.Item.Dimm.DeviceType.LPDDR4_SDRAM")
-    {
-        return "LPDDR4_SDRAM";
-    }
-    if (memoryType ==
-        "xyz.openbmc_project.Inventory.Item.Dimm.DeviceType.LPDDR3_SDRAM")
-    {
-        return "LPDDR3_SDRAM";
-    }
-    if (memoryType ==
-        "xyz.openbmc_project.Inventory.Item.Dimm.DeviceType.DDR2_SDRAM_FB_DIMM")
-    {
-        return "DDR2_SDRAM_FB_DIMM";
-    }
-    if (memoryType ==
-        "xyz.openbmc_project.Inventory.Item.Dimm.DeviceType.DDR2_SDRAM_FB_DIMM_PROB")
-    {
-        return "DDR2_SDRAM_FB_DIMM_PROBE";
-    }
-    if (memoryType ==
-        "xyz.openbmc_project.Inventory.Item.Dimm.DeviceType.DDR_SGRAM")
-    {
-        return "DDR_SGRAM";
-    }
-    if (memoryType == "xyz.openbmc_project.Inventory.Item.Dimm.DeviceType.ROM")
-    {
-        return "ROM";
-    }
-    if (memoryType ==
-        "xyz.openbmc_project.Inventory.Item.Dimm.DeviceType.SDRAM")
-    {
-        return "SDRAM";
-    }
-    if (memoryType == "xyz.openbmc_project.Inventory.Item.Dimm.DeviceType.EDO")
-    {
-        return "EDO";
-    }
-    if (memoryType ==
-        "xyz.openbmc_project.Inventory.Item.Dimm.DeviceType.FastPageMode")
-    {
-        return "FastPageMode";
-    }
-    if (memoryType ==
-        "xyz.openbmc_project.Inventory.Item.Dimm.DeviceType.PipelinedNibble")
-    {
-        return "PipelinedNibble";
-    }
-    if (memoryType ==
-        "xyz.openbmc_project.Inventory.Item.Dimm.DeviceType.Logical")
-    {
-        return "Logical";
-    }
-    if (memoryType == "xyz.openbmc_project.Inventory.Item.Dimm.DeviceType.HBM")
-    {
-        return "HBM";
-    }
-    if (memoryType == "xyz.openbmc_project.Inventory.Item.Dimm.DeviceType.HBM2")
-    {
-        return "HBM2";
-    }
-    if (memoryType == "xyz.openbmc_project.Inventory.Item.Dimm.DeviceType.HBM3")
-    {
-        return "HBM3";
+    constexpr std::string_view prefix =
+        "xyz.openbmc_project.Inventory.Item.Dimm.DeviceType.";
+    std::string_view type = memoryType;
+    if (type.starts_with(prefix))
+    {
+        type.remove_prefix(prefix.size());
+        const std::string_view* redfishType = memoryDeviceTypes.find(type);
+        if (redfishType != nullptr)
+        {
+            return std::string(*redfishType);
+        }
     }
     // This is values like Other or Unknown
     // Also D-Bus values:
@@ -608,10 +553,10 @@ inline void getDimmDataByService(std::shared_ptr<bmcweb::AsyncResp> aResp,
                                  const std::string& objPath)
 {
     BMCWEB_LOG_DEBUG << "Get available system components.";
-    sdbusplus::asio::getAllProperties(
-        *crow::connections::systemBus, service, objPath, "",
-        [dimmId, aResp{std::move(aResp)}, objPath,
-         service](const boost::system::error_code ec,
+    dbus::utility::getAllPropertiesBatched(
+        service, objPath, "",
+        [dimmId, aResp{std::move(aResp)},
+         objPath](const boost::system::error_code& ec,
                   const dbus::utility::DBusPropertiesMap& properties) {
         if (ec)
         {
@@ -621,7 +566,17 @@ inline void getDimmDataByService(std::shared_ptr<bmcweb::AsyncResp> aResp,
         }
         assembleDimmProperties(dimmId, aResp, properties, ""_json_pointer);
 
-        name_util::getPrettyName(aResp, objPath, service, "/Name"_json_pointer);
+        // Inventory.Item's PrettyName came with the other interfaces, so
+        // the name needs no read of its own
+        for (const auto& [name, value] : properties)
+        {
+            const std::string* prettyName = std::get_if<std::string>(&value);
+            if (name == "PrettyName" && prettyName != nullptr &&
+                !prettyName->empty())
+            {
+                aResp->res.jsonValue["Name"] = *prettyName;
+            }
+        }
 
 #ifdef BMCWEB_ENABLE_HW_ISOLATION
         // Check for the hardware status event
@@ -687,8 +642,8 @@ inline void getDimmPartitionData(std::shared_ptr<bmcweb::AsyncResp> aResp,
                                  const std::string& service,
                                  const std::string& path)
 {
-    sdbusplus::asio::getAllProperties(
-        *crow::connections::systemBus, service, path,
+    dbus::utility::getAllPropertiesBatched(
+        service, path,
         "xyz.openbmc_project.Inventory.Item.PersistentMemory.Partition",
         [aResp{std::move(aResp)}](
             const boost::system::error_code ec,
@@ -723,9 +678,8 @@ inline void getDimmPartitionData(std::shared_ptr<bmcweb::AsyncResp> aResp,
 inline void getObjectEnable(std::shared_ptr<bmcweb::AsyncResp> aResp,
                             const std::string& service, const std::string& path)
 {
-    sdbusplus::asio::getProperty<bool>(
-        *crow::connections::systemBus, service, path,
-        "xyz.openbmc_project.Object.Enable", "Enabled",
+    dbus::utility::getPropertyBatched<bool>(
+        service, path, "xyz.openbmc_project.Object.Enable", "Enabled",
         [aResp{std::move(aResp)}](const boost::system::error_code ec,
                                   const bool enabled) {
         if (ec)
@@ -741,7 +695,8 @@ inline void getObjectEnable(std::shared_ptr<bmcweb::AsyncResp> aResp,
 }
 
 inline void getDimmData(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
-                        const std::string& dimmId)
+                        const std::string& dimmId,
+                        const query_param::SelectTrie& select = {})
 {
     BMCWEB_LOG_DEBUG << "Get available system dimm resources.";
     // GetSubTree on all interfaces which provide info about a Memory
@@ -752,9 +707,11 @@ inline void getDimmData(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
 
     dbus::utility::getSubTree(
         "/xyz/openbmc_project/inventory", 0, interfaces,
-        [aResp,
-         dimmId](const boost::system::error_code& ec,
-                 const dbus::utility::MapperGetSubTreeResponse& subtree) {
+        [aResp, dimmId, wantRegions{select.isAnySelected({"Regions"})},
+         wantIndicator{select.isAnySelected({"LocationIndicatorActive"})},
+         wantEnabled{select.isAnySelected({"Enabled"})}](
+            const boost::system::error_code& ec,
+            const dbus::utility::MapperGetSubTreeResponse& subtree) {
         if (ec)
         {
             BMCWEB_LOG_DEBUG << "DBUS response error: " << ec;
@@ -807,7 +764,7 @@ inline void getDimmData(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
                     }
                 }
 
-                if (dimmInterface && partitionInterface)
+                if (dimmInterface && partitionInterface && wantRegions)
                 {
                     // partitions are separate as there can be multiple
                     // per
@@ -817,12 +774,12 @@ inline void getDimmData(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
                     getDimmPartitionData(aResp, serviceName, objectPath);
                 }
 
-                if (dimmInterface && associationInterface)
+                if (dimmInterface && associationInterface && wantIndicator)
                 {
                     getLocationIndicatorActive(aResp, objectPath);
                 }
 
-                if (dimmInterface && objectEnable)
+                if (dimmInterface && objectEnable && wantEnabled)
                 {
                     getObjectEnable(aResp, serviceName, objectPath);
                 }
@@ -1020,7 +977,12 @@ inline void handleMemoryGet(App& app, const crow::Request& req,
                             const std::string& systemName,
                             const std::string& dimmId)
 {
-    if (!redfish::setUpRedfishRoute(app, req, asyncResp))
+    query_param::QueryCapabilities capabilities = {
+        .canPruneBySelect = true,
+    };
+    query_param::Query delegatedQuery;
+    if (!redfish::setUpRedfishRouteWithDelegation(app, req, asyncResp,
+                                                  delegatedQuery, capabilities))
     {
         return;
     }
@@ -1032,7 +994,7 @@ inline void handleMemoryGet(App& app, const crow::Request& req,
         return;
     }
 
-    getDimmData(asyncResp, dimmId);
+    getDimmData(asyncResp, dimmId, delegatedQuery.selectTrie);
 }
 
 inline void requestRoutesMemory(App& app)
@@ -24,10 +24,14 @@
 #include "registries/task_event_message_registry.hpp"
 
 #include <app.hpp>
+#include <boost/container/flat_map.hpp>
 #include <query.hpp>
 #include <registries/privilege_registry.hpp>
 
 #include <array>
+#include <functional>
+#include <string>
+#include <vector>
 
 namespace redfish
 {
@@ -42,25 +46,29 @@ inline void handleMessageRegistryFileCollectionGet(
     }
     // Collections don't include the static data added by SubRoute
     // because it has a duplicate entry for members
+    static const nlohmann::json collection = []() {
+        nlohmann::json json;
+        json["@odata.type"] =
+            "#MessageRegistryFileCollection.MessageRegistryFileCollection";
+        json["@odata.id"] = "/redfish/v1/Registries";
+        json["Name"] = "MessageRegistryFile Collection";
+        json["Description"] = "Collection of MessageRegistryFiles";
+        json["Members@odata.count"] = 6;
 
-    asyncResp->res.jsonValue["@odata.type"] =
-        "#MessageRegistryFileCollection.MessageRegistryFileCollection";
-    asyncResp->res.jsonValue["@odata.id"] = "/redfish/v1/Registries";
-    asyncResp->res.jsonValue["Name"] = "MessageRegistryFile Collection";
-    asyncResp->res.jsonValue["Description"] =
-        "Collection of MessageRegistryFiles";
-    asyncResp->res.jsonValue["Members@odata.count"] = 6;
-
-    nlohmann::json& members = asyncResp->res.jsonValue["Members"];
-    for (const char* memberName :
-         std::to_array({"Base", "TaskEvent", "ResourceEvent", "OpenBMC",
-                        "BiosAttributeRegistry", "License"}))
-    {
-        nlohmann::json::object_t member;
-        member["@odata.id"] = crow::utility::urlFromPieces(
-            "redfish", "v1", "Registries", memberName);
-        members.emplace_back(std::move(member));
-    }
+        nlohmann::json& members = json["Members"];
+        for (const char* memberName :
+             std::to_array({"Base", "TaskEvent", "ResourceEvent", "OpenBMC",
+                            "BiosAttributeRegistry", "License"}))
+        {
+            nlohmann::json::object_t member;
+            member["@odata.id"] =
+                crow::utility::urlPath<"/redfish/v1/Registries/{}">(
+                    memberName);
+            members.emplace_back(std::move(member));
+        }
+        return json;
+    }();
+    asyncResp->res.jsonValue = collection;
 }
 
 inline void requestRoutesMessageRegistryFileCollection(App& app)
@@ -159,6 +167,50 @@ inline void requestRoutesMessageRegistryFile(App& app)
             handleMessageRoutesMessageRegistryFileGet, std::ref(app)));
 }
 
+inline nlohmann::json makeMessageRegistryJson(
+    const registries::Header& header,
+    const std::vector<const registries::MessageEntry*>& registryEntries)
+{
+    nlohmann::json json;
+    json["@Redfish.Copyright"] = header.copyright;
+    json["@odata.type"] = header.type;
+    json["Id"] = header.id;
+    json["Name"] = header.name;
+    json["Language"] = header.language;
+    json["Description"] = header.description;
+    json["RegistryPrefix"] = header.registryPrefix;
+    json["RegistryVersion"] = header.registryVersion;
+    json["OwningEntity"] = header.owningEntity;
+
+    nlohmann::json& messageObj = json["Messages"];
+
+    // Go through the Message Registry and populate each Message
+    for (const registries::MessageEntry* message : registryEntries)
+    {
+        nlohmann::json& obj = messageObj[message->first];
+        obj["Description"] = message->second.description;
+        obj["Message"] = message->second.message;
+        obj["Severity"] = message->second.messageSeverity;
+        obj["MessageSeverity"] = message->second.messageSeverity;
+        obj["NumberOfArgs"] = message->second.numberOfArgs;
+        obj["Resolution"] = message->second.resolution;
+        if (message->second.numberOfArgs > 0)
+        {
+            nlohmann::json& messageParamArray = obj["ParamTypes"];
+            messageParamArray = nlohmann::json::array();
+            for (const char* str : message->second.paramTypes)
+            {
+                if (str == nullptr)
+                {
+                    break;
+                }
+                messageParamArray.push_back(str);
+            }
+        }
+    }
+    return json;
+}
+
 inline void handleMessageRegistryGet(
     crow::App& app, const crow::Request& req,
     const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
@@ -228,42 +280,21 @@ inline void handleMessageRegistryGet(
         return;
     }
 
-    asyncResp->res.jsonValue["@Redfish.Copyright"] = header->copyright;
-    asyncResp->res.jsonValue["@odata.type"] = header->type;
-    asyncResp->res.jsonValue["Id"] = header->id;
-    asyncResp->res.jsonValue["Name"] = header->name;
-    asyncResp->res.jsonValue["Language"] = header->language;
-    asyncResp->res.jsonValue["Description"] = header->description;
-    asyncResp->res.jsonValue["RegistryPrefix"] = header->registryPrefix;
-    asyncResp->res.jsonValue["RegistryVersion"] = header->registryVersion;
-    asyncResp->res.jsonValue["OwningEntity"] = header->owningEntity;
-
-    nlohmann::json& messageObj = asyncResp->res.jsonValue["Messages"];
-
-    // Go through the Message Registry and populate each Message
-    for (const registries::MessageEntry* message : registryEntries)
+    // Registries are compiled in, so each is rendered once and copied from
+    // then on
+    static boost::container::flat_map<std::string, nlohmann::json,
+                                      std::less<>>
+        rendered;
+    auto it = rendered.find(registry);
+    if (it == rendered.end())
     {
-        nlohmann::json& obj = messageObj[message->first];
-        obj["Description"] = message->second.description;
-        obj["Message"] = message->second.message;
-        obj["Severity"] = message->second.messageSeverity;
-        obj["MessageSeverity"] = message->second.messageSeverity;
-        obj["NumberOfArgs"] = message->second.numberOfArgs;
-        obj["Resolution"] = message->second.resolution;
-        if (message->second.numberOfArgs > 0)
-        {
-            nlohmann::json& messageParamArray = obj["ParamTypes"];
-            messageParamArray = nlohmann::json::array();
-            for (const char* str : message->second.paramTypes)
-            {
-                if (str == nullptr)
-                {
-                    break;
-                }
-                messageParamArray.push_back(str);
-            }
-        }
+        it = rendered
+                 .emplace(registry,
+                          makeMessageRegistryJson(*header, registryEntries))
+                 .first;
     }
+    asyncResp->res.setEncodedBodyCacheable();
+    asyncResp->res.jsonValue = it->second;
 }
 
 inline void requestRoutesMessageRegistry(App& app)
@@ -1,11 +1,29 @@
 #pragma once
 
 #include "async_resp.hpp"
+#include "dbus_utility.hpp"
+#include "http_utility.hpp"
+#include "sensor_reading_cache.hpp"
 #include "sensors.hpp"
+#include "utils/chassis_graph.hpp"
 #include "utils/get_chassis_names.hpp"
+#include "utils/hex_utils.hpp"
 #include "utils/telemetry_utils.hpp"
 
+#include <boost/asio/post.hpp>
 #include <registries/privilege_registry.hpp>
+#include <sdbusplus/asio/connection.hpp>
+#include <sdbusplus/bus/match.hpp>
+
+#include <array>
+#include <cmath>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 namespace redfish
 {
@@ -13,136 +31,6 @@ namespace redfish
 namespace telemetry
 {
 
-struct ValueVisitor
-{
-    explicit ValueVisitor(boost::system::error_code& ec) : ec3(ec) {}
-
-    template <class T>
-    double operator()(T value) const
-    {
-        return static_cast<double>(value);
-    }
-
-    double operator()(std::monostate /*unused*/) const
-    {
-        ec3 = boost::system::errc::make_error_code(
-            boost::system::errc::invalid_argument);
-        return double{};
-    }
-
-    boost::system::error_code& ec3;
-};
-
-inline void getReadingRange(
-    const std::string& service2, const std::string& path,
-    const std::string& property,
-    std::function<void(boost::system::error_code, double)> callback)
-{
-    crow::connections::systemBus->async_method_call(
-        [callback = std::move(callback)](
-            boost::system::error_code ec,
-            const std::variant<std::monostate, double, uint64_t, int64_t,
-                               uint32_t, int32_t, uint16_t, int16_t>&
-                valueVariant) {
-        if (ec)
-        {
-            callback(ec, double{});
-            return;
-        }
-
-        const double value = std::visit(ValueVisitor(ec), valueVariant);
-
-        callback(ec, value);
-    },
-        service2, path, "org.freedesktop.DBus.Properties", "Get",
-        "xyz.openbmc_project.Sensor.Value", property);
-}
-
-inline void
-    fillMinMaxReadingRange(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-                           const std::string& serviceName,
-                           const std::string& sensorPath)
-{
-    asyncResp->res.jsonValue["MetricType"] = "Numeric";
-
-    telemetry::getReadingRange(
-        serviceName, sensorPath, "MinValue",
-        [asyncResp](boost::system::error_code ec, double readingRange) {
-        if (ec)
-        {
-            messages::internalError(asyncResp->res);
-            return;
-        }
-
-        if (std::isfinite(readingRange))
-        {
-            asyncResp->res.jsonValue["MetricType"] = "Gauge";
-
-            asyncResp->res.jsonValue["MinReadingRange"] = readingRange;
-        }
-    });
-
-    telemetry::getReadingRange(
-        serviceName, sensorPath, "MaxValue",
-        [asyncResp](boost::system::error_code ec, double readingRange) {
-        if (ec)
-        {
-            messages::internalError(asyncResp->res);
-            return;
-        }
-
-        if (std::isfinite(readingRange))
-        {
-            asyncResp->res.jsonValue["MetricType"] = "Gauge";
-
-            asyncResp->res.jsonValue["MaxReadingRange"] = readingRange;
-        }
-    });
-}
-
-inline void getSensorService(
-    const std::string& sensorPath,
-    std::function<void(boost::system::error_code, const std::string&)> callback)
-{
-    using ResultType = std::pair<
-        std::string,
-        std::vector<std::pair<std::string, std::vector<std::string>>>>;
-
-    crow::connections::systemBus->async_method_call(
-        [sensorPath, callback = std::move(callback)](
-            boost::system::error_code ec,
-            const std::vector<ResultType>& result) {
-        if (ec)
-        {
-            callback(ec, std::string{});
-            return;
-        }
-
-        for (const auto& [path, serviceToInterfaces] : result)
-        {
-            if (path == sensorPath)
-            {
-                for (const auto& [service2, interfaces] : serviceToInterfaces)
-                {
-                    callback(boost::system::errc::make_error_code(
-                                 boost::system::errc::success),
-                             service2);
-                    return;
-                }
-            }
-        }
-
-        callback(boost::system::errc::make_error_code(
-                     boost::system::errc::no_such_file_or_directory),
-                 std::string{});
-    },
-        "xyz.openbmc_project.ObjectMapper",
-        "/xyz/openbmc_project/object_mapper",
-        "xyz.openbmc_project.ObjectMapper", "GetSubTree",
-        "/xyz/openbmc_project/sensors", 2,
-        std::array{"xyz.openbmc_project.Sensor.Value"});
-}
-
 constexpr auto metricDefinitionMapping = std::array{
     std::pair{"fan_pwm", "Fan_Pwm"}, std::pair{"fan_tach", "Fan_Tach"}};
 
@@ -179,6 +67,11 @@ inline void mapRedfishUriToDbusPath(Callback&& callback)
             callback(ec, {});
             return;
         }
+        if (chassisNames.empty())
+        {
+            callback(ec, {});
+            return;
+        }
 
         auto counter = std::make_shared<std::pair<
             boost::container::flat_map<std::string, std::string>, size_t>>();
@@ -221,53 +114,371 @@ inline void mapRedfishUriToDbusPath(Callback&& callback)
     });
 }
 
-} // namespace telemetry
+/**
+ * @brief What a MetricDefinition reports, other than its reading range,
+ * which is read from the sensor when the definition is
+ */
+struct MetricDefinitionEntry
+{
+    // The sensor whose units and range stand for the definition
+    std::string sensorPath;
+    // Empty if the mapper doesn't know the sensor
+    std::string service;
+    std::string units;
+    std::vector<std::string> metricProperties;
+};
 
-inline void requestRoutesMetricDefinitionCollection(App& app)
+/**
+ * @brief Every MetricDefinition, keyed by @odata.id, built from the URI to
+ * sensor map of every chassis and one mapper GetSubTree of the sensors.  The
+ * collection is serialized once, as it's the same for every client.
+ */
+struct MetricDefinitionCatalog
 {
-    BMCWEB_ROUTE(app, "/redfish/v1/TelemetryService/MetricDefinitions/")
-        .privileges(privileges::getMetricDefinitionCollection)
-        .methods(boost::beast::http::verb::get)(
-            [](const crow::Request&,
-               const std::shared_ptr<bmcweb::AsyncResp>& asyncResp) {
-        telemetry::mapRedfishUriToDbusPath(
-            [asyncResp](
+    MetricDefinitionCatalog(
+        const boost::container::flat_map<std::string, std::string>& uriToDbus,
+        const dbus::utility::MapperGetSubTreeResponse& subtree)
+    {
+        for (const auto& [uri, dbusPath] : uriToDbus)
+        {
+            MetricDefinitionEntry& entry =
+                definitions[mapSensorToMetricDefinition(dbusPath)];
+            if (entry.sensorPath.empty())
+            {
+                entry.sensorPath = dbusPath;
+                entry.units = sensors::toReadingUnits(
+                    sdbusplus::message::object_path{dbusPath}
+                        .parent_path()
+                        .filename());
+            }
+            entry.metricProperties.emplace_back(uri);
+        }
+
+        for (const auto& [path, services] : subtree)
+        {
+            if (services.empty())
+            {
+                continue;
+            }
+            for (auto& [odataId, entry] : definitions)
+            {
+                if (entry.sensorPath == path)
+                {
+                    entry.service = services.front().first;
+                }
+            }
+        }
+
+        collection["@odata.type"] =
+            "#MetricDefinitionCollection.MetricDefinitionCollection";
+        collection["@odata.id"] =
+            "/redfish/v1/TelemetryService/MetricDefinitions";
+        collection["Name"] = "Metric Definition Collection";
+        nlohmann::json::array_t members;
+        for (const auto& [odataId, entry] : definitions)
+        {
+            nlohmann::json::object_t member;
+            member["@odata.id"] = odataId;
+            members.emplace_back(std::move(member));
+        }
+        collection["Members@odata.count"] = members.size();
+        collection["Members"] = std::move(members);
+
+        collectionBody = collection.dump(
+            -1, ' ', true, nlohmann::json::error_handler_t::replace);
+        collectionEtag =
+            intToHexString(std::hash<std::string>{}(collectionBody), 16);
+    }
+
+    const MetricDefinitionEntry* find(std::string_view odataId) const
+    {
+        auto it = definitions.find(odataId);
+        if (it == definitions.end())
+        {
+            return nullptr;
+        }
+        return &it->second;
+    }
+
+    std::map<std::string, MetricDefinitionEntry, std::less<>> definitions;
+    nlohmann::json collection;
+    // The collection serialized as compact json, and a version of it
+    std::string collectionBody;
+    std::string collectionEtag;
+};
+
+/**
+ * @brief Holds the MetricDefinitionCatalog, so telemetry clients that list
+ * and read every definition on each reconnect don't resolve the sensors of
+ * every chassis each time.
+ *
+ * The catalog is built on first use from the ChassisGraph then cached, and
+ * built again once that graph is replaced or a sensor is added or removed.
+ * Concurrent reads share one build, and a build that was in flight when a
+ * sensor changed is answered but not kept.
+ */
+class MetricDefinitionCache
+{
+  public:
+    using Callback = std::function<void(
+        const boost::system::error_code&,
+        const std::shared_ptr<const MetricDefinitionCatalog>&)>;
+
+    static MetricDefinitionCache& getInstance()
+    {
+        static MetricDefinitionCache cache;
+        return cache;
+    }
+
+    MetricDefinitionCache(const MetricDefinitionCache&) = delete;
+    MetricDefinitionCache(MetricDefinitionCache&&) = delete;
+    MetricDefinitionCache& operator=(const MetricDefinitionCache&) = delete;
+    MetricDefinitionCache& operator=(MetricDefinitionCache&&) = delete;
+    ~MetricDefinitionCache() = default;
+
+    void registerMatches(sdbusplus::asio::connection& conn)
+    {
+        namespace rules = sdbusplus::bus::match::rules;
+        std::string sensorsPrefix(
+            dbus::utility::SensorReadingCache::sensorsPath);
+        sensorsPrefix += '/';
+
+        // Chassis changes and service restarts replace the ChassisGraph,
+        // which get() notices on its own
+        matches.clear();
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::interfacesAdded() + rules::argNpath(0, sensorsPrefix),
+            [this](sdbusplus::message_t& /*msg*/) { clear(); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn,
+            rules::interfacesRemoved() + rules::argNpath(0, sensorsPrefix),
+            [this](sdbusplus::message_t& /*msg*/) { clear(); }));
+        clear();
+    }
+
+    bool enabled() const
+    {
+        return !matches.empty();
+    }
+
+    /**
+     * @brief Calls callback with the catalog, building it if it isn't cached
+     * or the chassis have changed since.  The callback is never called
+     * inline.
+     */
+    void get(Callback&& callback)
+    {
+        chassis_utils::ChassisGraphCache::getInstance().get(
+            [this, callback{std::move(callback)}](
+                const boost::system::error_code& ec,
+                const std::shared_ptr<const chassis_utils::ChassisGraph>&
+                    graph) mutable {
+            if (ec)
+            {
+                callback(ec, nullptr);
+                return;
+            }
+            if (catalog && catalogGraph == graph)
+            {
+                callback(ec, catalog);
+                return;
+            }
+
+            callbacks.emplace_back(std::move(callback));
+            if (callbacks.size() > 1)
+            {
+                return;
+            }
+            crow::dbus_trace::SharedCallScope sharedCalls;
+            build(graph);
+        });
+    }
+
+    void clear()
+    {
+        catalog.reset();
+        catalogGraph.reset();
+        generation++;
+    }
+
+  private:
+    MetricDefinitionCache() = default;
+
+    void build(const std::shared_ptr<const chassis_utils::ChassisGraph>& graph)
+    {
+        mapRedfishUriToDbusPath(
+            [this, graph, fetchGeneration{generation}](
                 boost::system::error_code ec,
                 const boost::container::flat_map<std::string, std::string>&
                     uriToDbus) {
             if (ec)
             {
-                messages::internalError(asyncResp->res);
                 BMCWEB_LOG_ERROR << "mapRedfishUriToDbusPath error: "
                                  << ec.value();
+                complete(fetchGeneration, graph, ec, nullptr);
                 return;
             }
+            constexpr std::array<std::string_view, 1> interfaces = {
+                dbus::utility::SensorReadingCache::valueInterface};
+            dbus::utility::getSubTree(
+                std::string(dbus::utility::SensorReadingCache::sensorsPath), 2,
+                interfaces,
+                [this, graph, fetchGeneration, uriToDbus](
+                    const boost::system::error_code& ec2,
+                    const dbus::utility::MapperGetSubTreeResponse& subtree) {
+                if (ec2)
+                {
+                    BMCWEB_LOG_ERROR << "Sensor mapper call error: " << ec2;
+                    complete(fetchGeneration, graph, ec2, nullptr);
+                    return;
+                }
+                complete(fetchGeneration, graph, ec2,
+                         std::make_shared<const MetricDefinitionCatalog>(
+                             uriToDbus, subtree));
+            });
+        });
+    }
 
-            std::set<std::string> members;
+    void complete(uint64_t fetchGeneration,
+                  const std::shared_ptr<const chassis_utils::ChassisGraph>&
+                      graph,
+                  const boost::system::error_code& ec,
+                  const std::shared_ptr<const MetricDefinitionCatalog>& read)
+    {
+        std::vector<Callback> waiting = std::move(callbacks);
+        callbacks.clear();
 
-            for (const auto& [uri, dbusPath] : uriToDbus)
+        if (read != nullptr && enabled() && fetchGeneration == generation)
+        {
+            catalog = read;
+            catalogGraph = graph;
+        }
+        for (Callback& callback : waiting)
+        {
+            callback(ec, read);
+        }
+    }
+
+    std::shared_ptr<const MetricDefinitionCatalog> catalog;
+    // The graph catalog was built from
+    std::shared_ptr<const chassis_utils::ChassisGraph> catalogGraph;
+    std::vector<Callback> callbacks;
+    uint64_t generation = 0;
+    std::vector<std::unique_ptr<sdbusplus::bus::match_t>> matches;
+};
+
+/**
+ * @brief Fills MetricType and the reading range from the sensor's
+ * MinValue and MaxValue, as the sensor cache holds them.
+ */
+inline void
+    fillMinMaxReadingRange(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+                           const std::string& serviceName,
+                           const std::string& sensorPath)
+{
+    asyncResp->res.jsonValue["MetricType"] = "Numeric";
+
+    dbus::utility::SensorReadingCache::getInstance().getManagedObjects(
+        serviceName,
+        [asyncResp,
+         sensorPath](const boost::system::error_code& ec,
+                     const dbus::utility::ManagedObjectType& objects) {
+        if (ec)
+        {
+            BMCWEB_LOG_ERROR << "Sensor read error: " << ec;
+            messages::internalError(asyncResp->res);
+            return;
+        }
+
+        const dbus::utility::DBusPropertiesMap* properties = nullptr;
+        for (const auto& [path, interfaces] : objects)
+        {
+            if (path.str != sensorPath)
             {
-                members.insert(
-                    telemetry::mapSensorToMetricDefinition(dbusPath));
+                continue;
+            }
+            for (const auto& [interface, interfaceProperties] : interfaces)
+            {
+                if (interface ==
+                    dbus::utility::SensorReadingCache::valueInterface)
+                {
+                    properties = &interfaceProperties;
+                }
             }
+        }
+        if (properties == nullptr)
+        {
+            messages::internalError(asyncResp->res);
+            return;
+        }
 
-            for (const std::string& odataId : members)
+        for (const auto& [name, value] : *properties)
+        {
+            const char* rangeProperty = nullptr;
+            if (name == "MinValue")
+            {
+                rangeProperty = "MinReadingRange";
+            }
+            else if (name == "MaxValue")
             {
-                asyncResp->res.jsonValue["Members"].push_back(
-                    {{"@odata.id", odataId}});
+                rangeProperty = "MaxReadingRange";
             }
+            else
+            {
+                continue;
+            }
+            const double* readingRange = std::get_if<double>(&value);
+            if (readingRange != nullptr && std::isfinite(*readingRange))
+            {
+                asyncResp->res.jsonValue["MetricType"] = "Gauge";
+                asyncResp->res.jsonValue[rangeProperty] = *readingRange;
+            }
+        }
+    });
+}
 
-            asyncResp->res.jsonValue["Members@odata.count"] =
-                asyncResp->res.jsonValue["Members"].size();
-        });
+} // namespace telemetry
 
-        asyncResp->res.jsonValue["@odata.type"] = "#MetricDefinitionCollection."
-                                                  "MetricDefinitionCollection";
-        asyncResp->res.jsonValue["@odata.id"] =
-            "/redfish/v1/TelemetryService/MetricDefinitions";
-        asyncResp->res.jsonValue["Name"] = "Metric Definition Collection";
-        asyncResp->res.jsonValue["Members"] = nlohmann::json::array();
-        asyncResp->res.jsonValue["Members@odata.count"] = 0;
+inline void requestRoutesMetricDefinitionCollection(App& app)
+{
+    BMCWEB_ROUTE(app, "/redfish/v1/TelemetryService/MetricDefinitions/")
+        .privileges(privileges::getMetricDefinitionCollection)
+        .methods(boost::beast::http::verb::get)(
+            [](const crow::Request& req,
+               const std::shared_ptr<bmcweb::AsyncResp>& asyncResp) {
+        // Without query parameters or a browser asking for html, the body
+        // is the collection exactly as it was serialized when it was built
+        using http_helpers::ContentType;
+        std::array<ContentType, 2> allowed{ContentType::JSON,
+                                           ContentType::HTML};
+        bool serialized =
+            req.urlView.params().empty() &&
+            http_helpers::getPreferedContentType(req.getHeaderValue("Accept"),
+                                                 allowed) != ContentType::HTML;
+
+        telemetry::MetricDefinitionCache::getInstance().get(
+            [asyncResp, serialized](
+                const boost::system::error_code& ec,
+                const std::shared_ptr<const telemetry::MetricDefinitionCatalog>&
+                    catalog) {
+            if (ec || catalog == nullptr)
+            {
+                messages::internalError(asyncResp->res);
+                return;
+            }
+            if (!serialized)
+            {
+                asyncResp->res.jsonValue = catalog->collection;
+                return;
+            }
+            if (asyncResp->res.setEtagVersion(catalog->collectionEtag))
+            {
+                return;
+            }
+            asyncResp->res.addHeader(boost::beast::http::field::content_type,
+                                     "application/json");
+            asyncResp->res.body() = catalog->collectionBody;
+        });
     });
 }
 
@@ -279,73 +490,46 @@ inline void requestRoutesMetricDefinition(App& app)
             [](const crow::Request&,
                const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
                const std::string& name) {
-        telemetry::mapRedfishUriToDbusPath(
-            [asyncResp,
-             name](boost::system::error_code ec2,
-                   const boost::container::flat_map<std::string, std::string>&
-                       uriToDbus) {
-            if (ec2)
+        telemetry::MetricDefinitionCache::getInstance().get(
+            [asyncResp, name](
+                const boost::system::error_code& ec,
+                const std::shared_ptr<const telemetry::MetricDefinitionCatalog>&
+                    catalog) {
+            if (ec || catalog == nullptr)
             {
                 messages::internalError(asyncResp->res);
-                BMCWEB_LOG_ERROR << "mapRedfishUriToDbusPath error: "
-                                 << ec2.value();
                 return;
             }
 
             std::string odataId = telemetry::metricDefinitionUri + name;
-            boost::container::flat_map<std::string, std::string> matchingUris;
-
-            for (const auto& [uri, dbusPath] : uriToDbus)
-            {
-                if (telemetry::mapSensorToMetricDefinition(dbusPath) == odataId)
-                {
-                    matchingUris.emplace(uri, dbusPath);
-                }
-            }
-
-            if (matchingUris.empty())
+            const telemetry::MetricDefinitionEntry* entry =
+                catalog->find(odataId);
+            if (entry == nullptr)
             {
                 messages::resourceNotFound(asyncResp->res, "MetricDefinition",
                                            name);
                 return;
             }
+            if (entry->service.empty())
+            {
+                BMCWEB_LOG_ERROR << "No service for " << entry->sensorPath;
+                messages::internalError(asyncResp->res);
+                return;
+            }
 
-            std::string sensorPath = matchingUris.begin()->second;
-
-            telemetry::getSensorService(
-                sensorPath,
-                [asyncResp, name, odataId = std::move(odataId), sensorPath,
-                 matchingUris = std::move(matchingUris)](
-                    boost::system::error_code ec3,
-                    const std::string& serviceName) {
-                if (ec3)
-                {
-                    messages::internalError(asyncResp->res);
-                    BMCWEB_LOG_ERROR << "getServiceSensorFailed: "
-                                     << ec3.value();
-                    return;
-                }
-
-                asyncResp->res.jsonValue["Id"] = name;
-                asyncResp->res.jsonValue["Name"] = name;
-                asyncResp->res.jsonValue["@odata.id"] = odataId;
-                asyncResp->res.jsonValue["@odata.type"] =
-                    "#MetricDefinition.v1_0_3.MetricDefinition";
-                asyncResp->res.jsonValue["MetricDataType"] = "Decimal";
-                asyncResp->res.jsonValue["IsLinear"] = true;
-                asyncResp->res.jsonValue["Units"] = sensors::toReadingUnits(
-                    sdbusplus::message::object_path{sensorPath}
-                        .parent_path()
-                        .filename());
-
-                for (const auto& [uri, dbusPath] : matchingUris)
-                {
-                    asyncResp->res.jsonValue["MetricProperties"].push_back(uri);
-                }
-
-                telemetry::fillMinMaxReadingRange(asyncResp, serviceName,
-                                                  sensorPath);
-            });
+            asyncResp->res.jsonValue["Id"] = name;
+            asyncResp->res.jsonValue["Name"] = name;
+            asyncResp->res.jsonValue["@odata.id"] = odataId;
+            asyncResp->res.jsonValue["@odata.type"] =
+                "#MetricDefinition.v1_0_3.MetricDefinition";
+            asyncResp->res.jsonValue["MetricDataType"] = "Decimal";
+            asyncResp->res.jsonValue["IsLinear"] = true;
+            asyncResp->res.jsonValue["Units"] = entry->units;
+            asyncResp->res.jsonValue["MetricProperties"] =
+                entry->metricProperties;
+
+            telemetry::fillMinMaxReadingRange(asyncResp, entry->service,
+                                              entry->sensorPath);
         });
     });
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "metric_values.hpp"
 #include "utils/collection.hpp"
 #include "utils/telemetry_utils.hpp"
 #include "utils/time_utils.hpp"
@@ -16,26 +17,6 @@ namespace redfish
 namespace telemetry
 {
 
-using Readings = std::vector<std::tuple<std::string, double, uint64_t>>;
-using TimestampReadings = std::tuple<uint64_t, Readings>;
-
-inline nlohmann::json toMetricValues(const Readings& readings)
-{
-    nlohmann::json metricValues = nlohmann::json::array_t();
-
-    for (const auto& [metadata, sensorValue, timestamp] : readings)
-    {
-        nlohmann::json::object_t metricReport;
-        metricReport["MetricProperty"] = metadata;
-        metricReport["MetricValue"] = std::to_string(sensorValue);
-        metricReport["Timestamp"] =
-            redfish::time_utils::getDateTimeUintMs(timestamp);
-        metricValues.push_back(std::move(metricReport));
-    }
-
-    return metricValues;
-}
-
 inline bool fillReport(nlohmann::json& json, const std::string& id,
                        const TimestampReadings& timestampReadings)
 {
@@ -49,9 +30,61 @@ inline bool fillReport(nlohmann::json& json, const std::string& id,
 
     const auto& [timestamp, readings] = timestampReadings;
     json["Timestamp"] = redfish::time_utils::getDateTimeUintMs(timestamp);
-    json["MetricValues"] = toMetricValues(readings);
+    json["MetricValues"] = MetricValues(readings).toJson();
     return true;
 }
+
+/**
+ * @brief A MetricReport serialized once per Readings update and shared by
+ * every subscription it is pushed to.
+ */
+class MetricReportPayload
+{
+  public:
+    MetricReportPayload(const std::string& id,
+                        const TimestampReadings& timestampReadings)
+    {
+        const auto& [timestamp, readings] = timestampReadings;
+        nlohmann::json json;
+        json["@odata.type"] = "#MetricReport.v1_3_0.MetricReport";
+        json["@odata.id"] = crow::utility::urlFromPieces(
+            "redfish", "v1", "TelemetryService", "MetricReports", id);
+        json["Id"] = id;
+        json["Name"] = id;
+        json["MetricReportDefinition"]["@odata.id"] =
+            crow::utility::urlFromPieces("redfish", "v1", "TelemetryService",
+                                         "MetricReportDefinitions", id);
+        json["Timestamp"] = redfish::time_utils::getDateTimeUintMs(timestamp);
+
+        std::string out = json.dump(-1, ' ', true,
+                                    nlohmann::json::error_handler_t::replace);
+        // Reopen the object to add the MetricValues
+        out.pop_back();
+        out += R"(,"MetricValues":)";
+        MetricValues(readings).appendJson(out);
+        out += '}';
+        body = std::make_shared<const std::string>(std::move(out));
+    }
+
+    // The report as a subscription with the given Context receives it
+    std::shared_ptr<const std::string>
+        forContext(std::string_view context) const
+    {
+        if (context.empty())
+        {
+            return body;
+        }
+        std::string out = R"({"Context":)";
+        out += nlohmann::json(context).dump(
+            -1, ' ', true, nlohmann::json::error_handler_t::replace);
+        out += ',';
+        out.append(*body, 1);
+        return std::make_shared<const std::string>(std::move(out));
+    }
+
+  private:
+    std::shared_ptr<const std::string> body;
+};
 } // namespace telemetry
 
 inline void requestRoutesMetricReportCollection(App& app)
@@ -2,6 +2,7 @@
 
 #include "generated/enums/metric_report_definition.hpp"
 #include "sensors.hpp"
+#include "utils/telemetry_config_cache.hpp"
 #include "utils/telemetry_utils.hpp"
 #include "utils/time_utils.hpp"
 
@@ -184,9 +185,8 @@ inline std::string toDbusReportUpdates(
     return "";
 }
 
-inline void
-    fillReportDefinition(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-                         const std::string& id,
+inline bool
+    fillReportDefinition(nlohmann::json& json, const std::string& id,
                          const dbus::utility::DBusPropertiesMap& properties)
 {
     std::vector<std::string> reportActions;
@@ -206,8 +206,7 @@ inline void
 
     if (!success)
     {
-        messages::internalError(asyncResp->res);
-        return;
+        return false;
     }
 
     metric_report_definition::MetricReportDefinitionType redfishReportingType =
@@ -215,12 +214,10 @@ inline void
     if (redfishReportingType ==
         metric_report_definition::MetricReportDefinitionType::Invalid)
     {
-        messages::internalError(asyncResp->res);
-        return;
+        return false;
     }
 
-    asyncResp->res.jsonValue["MetricReportDefinitionType"] =
-        redfishReportingType;
+    json["MetricReportDefinitionType"] = redfishReportingType;
 
     nlohmann::json::array_t redfishReportActions;
     for (const std::string& action : reportActions)
@@ -230,14 +227,13 @@ inline void
         if (redfishAction ==
             metric_report_definition::ReportActionsEnum::Invalid)
         {
-            messages::internalError(asyncResp->res);
-            return;
+            return false;
         }
 
         redfishReportActions.emplace_back(redfishAction);
     }
 
-    asyncResp->res.jsonValue["ReportActions"] = std::move(redfishReportActions);
+    json["ReportActions"] = std::move(redfishReportActions);
 
     nlohmann::json::array_t metrics = nlohmann::json::array();
     for (const auto& [sensorData, collectionFunction, collectionTimeScope,
@@ -256,8 +252,7 @@ inline void
             telemetry::toRedfishCollectionFunction(collectionFunction);
         if (redfishCollectionFunction.empty())
         {
-            messages::internalError(asyncResp->res);
-            return;
+            return false;
         }
         metric["CollectionFunction"] = redfishCollectionFunction;
 
@@ -267,8 +262,7 @@ inline void
         if (redfishCollectionTimeScope ==
             metric_report_definition::CollectionTimeScope::Invalid)
         {
-            messages::internalError(asyncResp->res);
-            return;
+            return false;
         }
         metric["CollectionTimeScope"] = redfishCollectionTimeScope;
 
@@ -277,15 +271,15 @@ inline void
             std::chrono::milliseconds(collectionDuration));
         metrics.emplace_back(std::move(metric));
     }
-    asyncResp->res.jsonValue["Metrics"] = std::move(metrics);
+    json["Metrics"] = std::move(metrics);
 
     if (enabled)
     {
-        asyncResp->res.jsonValue["Status"]["State"] = "Enabled";
+        json["Status"]["State"] = "Enabled";
     }
     else
     {
-        asyncResp->res.jsonValue["Status"]["State"] = "Disabled";
+        json["Status"]["State"] = "Disabled";
     }
 
     metric_report_definition::ReportUpdatesEnum redfishReportUpdates =
@@ -293,24 +287,23 @@ inline void
     if (redfishReportUpdates ==
         metric_report_definition::ReportUpdatesEnum::Invalid)
     {
-        messages::internalError(asyncResp->res);
-        return;
+        return false;
     }
-    asyncResp->res.jsonValue["ReportUpdates"] = redfishReportUpdates;
+    json["ReportUpdates"] = redfishReportUpdates;
 
-    asyncResp->res.jsonValue["MetricReportDefinitionEnabled"] = enabled;
-    asyncResp->res.jsonValue["AppendLimit"] = appendLimit;
-    asyncResp->res.jsonValue["Name"] = name;
-    asyncResp->res.jsonValue["Schedule"]["RecurrenceInterval"] =
+    json["MetricReportDefinitionEnabled"] = enabled;
+    json["AppendLimit"] = appendLimit;
+    json["Name"] = name;
+    json["Schedule"]["RecurrenceInterval"] =
         time_utils::toDurationString(std::chrono::milliseconds(interval));
-    asyncResp->res.jsonValue["@odata.type"] =
+    json["@odata.type"] =
         "#MetricReportDefinition.v1_3_0.MetricReportDefinition";
-    asyncResp->res.jsonValue["@odata.id"] = crow::utility::urlFromPieces(
+    json["@odata.id"] = crow::utility::urlFromPieces(
         "redfish", "v1", "TelemetryService", "MetricReportDefinitions", id);
-    asyncResp->res.jsonValue["Id"] = id;
-    asyncResp->res.jsonValue["MetricReport"]["@odata.id"] =
-        crow::utility::urlFromPieces("redfish", "v1", "TelemetryService",
-                                     "MetricReports", id);
+    json["Id"] = id;
+    json["MetricReport"]["@odata.id"] = crow::utility::urlFromPieces(
+        "redfish", "v1", "TelemetryService", "MetricReports", id);
+    return true;
 }
 
 struct AddReportArgs
@@ -690,6 +683,7 @@ class AddReport
                 return;
             }
 
+            telemetry::TelemetryConfigCache::getInstance().clear();
             messages::created(asyncResp->res);
         },
             telemetry::service, "/xyz/openbmc_project/Telemetry/Reports",
@@ -734,6 +728,25 @@ inline void requestRoutesMetricReportDefinitionCollection(App& app)
         asyncResp->res.jsonValue["@odata.id"] =
             "/redfish/v1/TelemetryService/MetricReportDefinitions";
         asyncResp->res.jsonValue["Name"] = "Metric Definition Collection";
+        telemetry::TelemetryConfigCache& configCache =
+            telemetry::TelemetryConfigCache::getInstance();
+        if (configCache.enabled())
+        {
+            configCache.get(
+                [asyncResp](const boost::system::error_code& ec,
+                            const std::shared_ptr<
+                                const telemetry::TelemetryConfig>& config) {
+                if (ec || config == nullptr)
+                {
+                    messages::internalError(asyncResp->res);
+                    return;
+                }
+                telemetry::fillResourceMembers(asyncResp->res.jsonValue,
+                                               config->reports,
+                                               "MetricReportDefinitions");
+            });
+            return;
+        }
         constexpr std::array<std::string_view, 1> interfaces{
             telemetry::reportInterface};
         collection_util::getCollectionMembers(
@@ -792,6 +805,18 @@ inline void requestRoutesMetricReportDefinitionCollection(App& app)
 
 inline void requestRoutesMetricReportDefinition(App& app)
 {
+    telemetry::TelemetryConfigCache::getInstance().setReportRenderer(
+        [](const std::string& id,
+           const dbus::utility::DBusPropertiesMap& properties)
+            -> std::optional<nlohmann::json> {
+        nlohmann::json json;
+        if (!telemetry::fillReportDefinition(json, id, properties))
+        {
+            return std::nullopt;
+        }
+        return json;
+    });
+
     BMCWEB_ROUTE(app,
                  "/redfish/v1/TelemetryService/MetricReportDefinitions/<str>/")
         .privileges(redfish::privileges::getMetricReportDefinition)
@@ -804,6 +829,25 @@ inline void requestRoutesMetricReportDefinition(App& app)
             return;
         }
 
+        telemetry::TelemetryConfigCache& configCache =
+            telemetry::TelemetryConfigCache::getInstance();
+        if (configCache.enabled())
+        {
+            configCache.get(
+                [asyncResp,
+                 id](const boost::system::error_code& ec,
+                     const std::shared_ptr<const telemetry::TelemetryConfig>&
+                         config) {
+                if (ec || config == nullptr)
+                {
+                    messages::internalError(asyncResp->res);
+                    return;
+                }
+                telemetry::fillResource(asyncResp, config->reports,
+                                        "MetricReportDefinition", id);
+            });
+            return;
+        }
         sdbusplus::asio::getAllProperties(
             *crow::connections::systemBus, telemetry::service,
             telemetry::getDbusReportPath(id), telemetry::reportInterface,
@@ -824,7 +868,11 @@ inline void requestRoutesMetricReportDefinition(App& app)
                 return;
             }
 
-            telemetry::fillReportDefinition(asyncResp, id, properties);
+            if (!telemetry::fillReportDefinition(asyncResp->res.jsonValue, id,
+                                                 properties))
+            {
+                messages::internalError(asyncResp->res);
+            }
         });
     });
 
@@ -864,6 +912,7 @@ inline void requestRoutesMetricReportDefinition(App& app)
                 return;
             }
 
+            telemetry::TelemetryConfigCache::getInstance().clear();
             asyncResp->res.result(boost::beast::http::status::no_content);
         },
             telemetry::service, reportPath, "xyz.openbmc_project.Object.Delete",
@@ -18,6 +18,7 @@
 #include "error_messages.hpp"
 #include "openbmc_dbus_rest.hpp"
 #include "redfish_util.hpp"
+#include "utils/network_state_cache.hpp"
 
 #include <app.hpp>
 #include <dbus_utility.hpp>
@@ -103,27 +104,25 @@ inline void extractNTPServersAndDomainNamesData(
 template <typename CallbackFunc>
 void getEthernetIfaceData(CallbackFunc&& callback)
 {
-    crow::connections::systemBus->async_method_call(
+    network_utils::NetworkStateCache::getInstance().get(
         [callback{std::forward<CallbackFunc>(callback)}](
-            const boost::system::error_code errorCode,
-            const dbus::utility::ManagedObjectType& dbusData) {
+            const boost::system::error_code& errorCode,
+            const std::shared_ptr<const network_utils::NetworkState>& state) {
         std::vector<std::string> ntpServers;
         std::vector<std::string> dynamicNtpServers;
         std::vector<std::string> domainNames;
 
-        if (errorCode)
+        if (errorCode || state == nullptr)
         {
             callback(false, ntpServers, dynamicNtpServers, domainNames);
             return;
         }
 
-        extractNTPServersAndDomainNamesData(dbusData, ntpServers,
+        extractNTPServersAndDomainNamesData(state->objects, ntpServers,
                                             dynamicNtpServers, domainNames);
 
         callback(true, ntpServers, dynamicNtpServers, domainNames);
-    },
-        "xyz.openbmc_project.Network", "/xyz/openbmc_project/network",
-        "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
+    });
 }
 
 inline void afterNetworkPortRequest(
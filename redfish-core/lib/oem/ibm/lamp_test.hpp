@@ -3,14 +3,27 @@
 #include "async_resp.hpp"
 #include "dbus_utility.hpp"
 #include "redfish_util.hpp"
+#include "utils/led_state_cache.hpp"
 
+#include <optional>
 #include <variant>
 
 namespace redfish
 {
 
+constexpr const char* lampTestGroup =
+    "/xyz/openbmc_project/led/groups/lamp_test";
+
+inline void addLampTestState(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
+                             bool asserted)
+{
+    aResp->res.jsonValue["Oem"]["IBM"]["@odata.type"] =
+        "#OemComputerSystem.v1_0_0.IBM";
+    aResp->res.jsonValue["Oem"]["IBM"]["LampTest"] = asserted;
+}
+
 /**
- * @brief Retrieves lamp test state.
+ * @brief Retrieves lamp test state, from the LedStateCache when it's there.
  *
  * @param[in] aResp     Shared pointer for generating response message.
  *
@@ -20,12 +33,21 @@ inline void getLampTestState(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
 {
     BMCWEB_LOG_DEBUG << "Get lamp test state";
 
+    led_utils::LedStateCache& cache = led_utils::LedStateCache::getInstance();
+    std::optional<bool> cached = cache.asserted(lampTestGroup);
+    if (cached)
+    {
+        addLampTestState(aResp, *cached);
+        return;
+    }
+
     std::array<std::string_view, 1> interfaces = {
         "xyz.openbmc_project.Led.Group"};
     dbus::utility::getDbusObject(
-        "/xyz/openbmc_project/led/groups/lamp_test", interfaces,
-        [aResp](const boost::system::error_code& ec,
-                const dbus::utility::MapperGetObject& object) {
+        lampTestGroup, interfaces,
+        [aResp, generation{cache.generation()}](
+            const boost::system::error_code& ec,
+            const dbus::utility::MapperGetObject& object) {
         if (ec || object.empty())
         {
             if (ec.value() == 5) // generic:5 error
@@ -38,11 +60,12 @@ inline void getLampTestState(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
             return;
         }
 
-        sdbusplus::asio::getProperty<bool>(
-            *crow::connections::systemBus, object.begin()->first,
-            "/xyz/openbmc_project/led/groups/lamp_test",
+        // Shares one GetManagedObjects with the other LED group reads
+        dbus::utility::getPropertyBatched<bool>(
+            object.begin()->first, lampTestGroup,
             "xyz.openbmc_project.Led.Group", "Asserted",
-            [aResp](const boost::system::error_code& ec1, bool assert) {
+            [aResp, generation](const boost::system::error_code& ec1,
+                                bool assert) {
             if (ec1)
             {
                 if (ec1.value() != EBADR)
@@ -53,9 +76,9 @@ inline void getLampTestState(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
                 return;
             }
 
-            aResp->res.jsonValue["Oem"]["IBM"]["@odata.type"] =
-                "#OemComputerSystem.v1_0_0.IBM";
-            aResp->res.jsonValue["Oem"]["IBM"]["LampTest"] = assert;
+            led_utils::LedStateCache::getInstance().setAsserted(
+                lampTestGroup, assert, generation);
+            addLampTestState(aResp, assert);
         });
     });
 }
@@ -76,7 +99,7 @@ inline void setLampTestState(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
     std::array<std::string_view, 1> interfaces = {
         "xyz.openbmc_project.Led.Group"};
     dbus::utility::getDbusObject(
-        "/xyz/openbmc_project/led/groups/lamp_test", interfaces,
+        lampTestGroup, interfaces,
         [aResp, state](const boost::system::error_code& ec,
                        const dbus::utility::MapperGetObject& object) {
         if (ec || object.empty())
@@ -88,8 +111,7 @@ inline void setLampTestState(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
 
         sdbusplus::asio::setProperty(
             *crow::connections::systemBus, object.begin()->first,
-            "/xyz/openbmc_project/led/groups/lamp_test",
-            "xyz.openbmc_project.Led.Group", "Asserted", state,
+            lampTestGroup, "xyz.openbmc_project.Led.Group", "Asserted", state,
             [aResp, state](const boost::system::error_code& ec1) {
             if (ec1)
             {
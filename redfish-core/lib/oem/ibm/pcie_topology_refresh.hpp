@@ -3,6 +3,7 @@
 #include "async_resp.hpp"
 #include "dbus_utility.hpp"
 #include "redfish_util.hpp"
+#include "utils/pcie_topology.hpp"
 
 #include <variant>
 
@@ -80,6 +81,7 @@ static void pcieTopologyRefreshWatchdog(
         else
         {
             BMCWEB_LOG_ERROR << "pcieRefreshValuePtr value refreshed";
+            pcie_util::PcieTopologyCache::getInstance().clear();
             pcieTopologyRefreshTimer = nullptr;
             (*countPtr) = 0;
             return;
@@ -112,6 +114,7 @@ inline void
             messages::internalError(aResp->res);
             return;
         }
+        pcie_util::PcieTopologyCache::getInstance().clear();
         count = 0;
         pcieTopologyRefreshTimer =
             std::make_unique<boost::asio::steady_timer>(*req.ioService);
@@ -2,13 +2,24 @@
 
 #include "async_resp.hpp"
 #include "dbus_utility.hpp"
+#include "utils/led_state_cache.hpp"
 
+#include <optional>
 #include <variant>
 
 namespace redfish
 {
+inline void addSAI(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
+                   const std::string& propertyValue, bool asserted)
+{
+    nlohmann::json& oemSAI = aResp->res.jsonValue["Oem"]["IBM"];
+    oemSAI["@odata.type"] = "#OemComputerSystem.v1_0_0.IBM";
+    oemSAI[propertyValue] = asserted;
+}
+
 /**
- * @brief Get System Attention Indicator
+ * @brief Get System Attention Indicator, from the LedStateCache when it's
+ * there
  *
  * @param[in] aResp             Shared pointer for generating response message.
  * @param[in] propertyValue     The property value
@@ -36,25 +47,34 @@ inline void getSAI(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
         return;
     }
 
+    std::string ledGroup = "/xyz/openbmc_project/led/groups/" + name;
+    led_utils::LedStateCache& cache = led_utils::LedStateCache::getInstance();
+    std::optional<bool> cached = cache.asserted(ledGroup);
+    if (cached)
+    {
+        addSAI(aResp, propertyValue, *cached);
+        return;
+    }
+
     std::array<std::string_view, 1> interfaces = {
         "xyz.openbmc_project.Led.Group"};
     dbus::utility::getDbusObject(
-        "/xyz/openbmc_project/led/groups/" + name, interfaces,
-        [aResp, name,
-         propertyValue](const boost::system::error_code& ec,
-                        const dbus::utility::MapperGetObject& object) {
+        ledGroup, interfaces,
+        [aResp, ledGroup, propertyValue, generation{cache.generation()}](
+            const boost::system::error_code& ec,
+            const dbus::utility::MapperGetObject& object) {
         if (ec || object.empty())
         {
             BMCWEB_LOG_DEBUG << "Failed to get LED DBus name: " << ec.message();
             return;
         }
 
-        sdbusplus::asio::getProperty<bool>(
-            *crow::connections::systemBus, object.begin()->first,
-            "/xyz/openbmc_project/led/groups/" + name,
-            "xyz.openbmc_project.Led.Group", "Asserted",
-            [aResp, propertyValue](const boost::system::error_code& ec1,
-                                   bool assert) {
+        // Shares one GetManagedObjects with the other LED group reads
+        dbus::utility::getPropertyBatched<bool>(
+            object.begin()->first, ledGroup, "xyz.openbmc_project.Led.Group",
+            "Asserted",
+            [aResp, ledGroup, propertyValue,
+             generation](const boost::system::error_code& ec1, bool assert) {
             if (ec1)
             {
                 if (ec1.value() != EBADR)
@@ -65,16 +85,9 @@ inline void getSAI(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
                 return;
             }
 
-            nlohmann::json& oemSAI = aResp->res.jsonValue["Oem"]["IBM"];
-            oemSAI["@odata.type"] = "#OemComputerSystem.v1_0_0.IBM";
-            if (propertyValue == "PartitionSystemAttentionIndicator")
-            {
-                oemSAI["PartitionSystemAttentionIndicator"] = assert;
-            }
-            else if (propertyValue == "PlatformSystemAttentionIndicator")
-            {
-                oemSAI["PlatformSystemAttentionIndicator"] = assert;
-            }
+            led_utils::LedStateCache::getInstance().setAsserted(
+                ledGroup, assert, generation);
+            addSAI(aResp, propertyValue, assert);
         });
     });
 }
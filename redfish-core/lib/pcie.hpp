@@ -26,6 +26,7 @@
 #include <sdbusplus/asio/property.hpp>
 #include <sdbusplus/unpack_properties.hpp>
 #include <utils/dbus_utils.hpp>
+#include <utils/pcie_topology.hpp>
 #include <utils/pcie_util.hpp>
 
 #include <map>
@@ -54,34 +55,25 @@ inline void getPcieDevicePath(
     std::function<void(const boost::system::error_code&, const std::string&)>&&
         callback)
 {
-    constexpr std::array<std::string_view, 1> interfaces = {
-        pcieDeviceInterface};
-
-    dbus::utility::getSubTreePaths(
-        "/xyz/openbmc_project/inventory", 0, interfaces,
+    pcie_util::PcieTopologyCache::getInstance().get(
         [asyncResp, pcieDevice, callback{std::move(callback)}](
             const boost::system::error_code& ec,
-            const dbus::utility::MapperGetSubTreePathsResponse&
-                pcieDevicePaths) {
+            const std::shared_ptr<const pcie_util::PcieTopology>& topology) {
+        std::string pcieDevicePath;
         if (ec)
         {
             BMCWEB_LOG_DEBUG << "no PCIe device paths found ec: "
                              << ec.message();
             // Not an error, system just doesn't have PCIe info
-            std::string pcieDevicePath;
             callback(ec, pcieDevicePath);
             return;
         }
-        for (const auto& devPath : pcieDevicePaths)
+        const pcie_util::PcieTopology::Device* device =
+            topology->findDevice(pcieDevice);
+        if (device != nullptr)
         {
-            if (pcieDevice == pcie_util::buildPCIeUniquePath(devPath))
-            {
-                callback(ec, devPath);
-                return;
-            }
+            pcieDevicePath = device->path;
         }
-        // No matching pcieDevice found
-        std::string pcieDevicePath;
         callback(ec, pcieDevicePath);
     });
 }
@@ -96,30 +88,27 @@ inline void getPcieDevicePathAndService(
     std::function<void(const boost::system::error_code&, const std::string&,
                        const std::string&)>&& callback)
 {
-    getPcieDevicePath(asyncResp, pcieDevice,
-                      [pcieDevice, asyncResp,
-                       callback{callback}](const boost::system::error_code& ec,
-                                           const std::string& pcieDevicePath) {
-        if (ec || pcieDevicePath.empty())
+    pcie_util::PcieTopologyCache::getInstance().get(
+        [asyncResp, pcieDevice, callback{std::move(callback)}](
+            const boost::system::error_code& ec,
+            const std::shared_ptr<const pcie_util::PcieTopology>& topology) {
+        std::string pcieDevicePath;
+        std::string serviceName;
+        if (ec)
         {
-            std::string serviceName;
+            BMCWEB_LOG_DEBUG << "no PCIe device paths found ec: "
+                             << ec.message();
             callback(ec, pcieDevicePath, serviceName);
             return;
         }
-
-        dbus::utility::getDbusObject(
-            pcieDevicePath, pcieDeviceInterface,
-            [pcieDevice, pcieDevicePath, asyncResp,
-             callback{callback}](const boost::system::error_code& ec1,
-                                 const dbus::utility::MapperGetObject& object) {
-            if (ec1 || object.empty())
-            {
-                std::string serviceName;
-                callback(ec1, pcieDevicePath, serviceName);
-                return;
-            }
-            callback(ec1, pcieDevicePath, object.begin()->first);
-        });
+        const pcie_util::PcieTopology::Device* device =
+            topology->findDevice(pcieDevice);
+        if (device != nullptr)
+        {
+            pcieDevicePath = device->path;
+            serviceName = device->service;
+        }
+        callback(ec, pcieDevicePath, serviceName);
     });
 }
 
@@ -133,14 +122,10 @@ static inline void
     getPCIeDeviceList(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
                       const std::string& name)
 {
-    constexpr std::array<std::string_view, 1> interfaces = {
-        pcieDeviceInterface};
-
-    dbus::utility::getSubTreePaths(
-        "/xyz/openbmc_project/inventory", 0, interfaces,
+    pcie_util::PcieTopologyCache::getInstance().get(
         [asyncResp,
          name](const boost::system::error_code& ec,
-               const dbus::utility::MapperGetSubTreePathsResponse& paths) {
+               const std::shared_ptr<const pcie_util::PcieTopology>& topology) {
         nlohmann::json& pcieDeviceList = asyncResp->res.jsonValue[name];
         pcieDeviceList = nlohmann::json::array();
         if (ec)
@@ -153,18 +138,18 @@ static inline void
             return;
         }
 
-        for (const auto& pcieDevicePath : paths)
+        for (const pcie_util::PcieTopology::Device& device :
+             topology->devices())
         {
-            std::string devName =
-                pcie_util::buildPCIeUniquePath(pcieDevicePath);
-            if (devName.empty())
+            if (device.name.empty())
             {
                 BMCWEB_LOG_DEBUG << "Invalid Name";
                 continue;
             }
             nlohmann::json::object_t pcieDevice;
             pcieDevice["@odata.id"] = crow::utility::urlFromPieces(
-                "redfish", "v1", "Systems", "system", "PCIeDevices", devName);
+                "redfish", "v1", "Systems", "system", "PCIeDevices",
+                device.name);
             pcieDeviceList.push_back(std::move(pcieDevice));
         }
         asyncResp->res.jsonValue[name + "@odata.count"] = pcieDeviceList.size();
@@ -307,12 +292,11 @@ static inline void
                            const std::string& pcieSlotPath,
                            const std::string& pcieDevice, Callback&& callback)
 {
-    dbus::utility::getSubTree(
-        "/xyz/openbmc_project/inventory", 0, pcieSlotInterface,
+    pcie_util::PcieTopologyCache::getInstance().get(
         [asyncResp, pcieSlotPath, pcieDevice,
          callback{std::forward<Callback>(callback)}](
             const boost::system::error_code& ec,
-            const dbus::utility::MapperGetSubTreeResponse& subTree) {
+            const std::shared_ptr<const pcie_util::PcieTopology>& topology) {
         if (ec)
         {
             BMCWEB_LOG_ERROR << "DBUS response error on GetSubTree"
@@ -321,30 +305,20 @@ static inline void
             return;
         }
 
-        if (subTree.empty())
+        const pcie_util::PcieTopology::Slot* slot =
+            topology->findSlot(pcieSlotPath);
+        if (slot == nullptr)
         {
-            BMCWEB_LOG_ERROR << "Can't find PCIeSlot D-Bus object!";
+            BMCWEB_LOG_ERROR << "PCIe Slot not found for " << pcieDevice;
             return;
         }
-
-        for (const auto& [objectPath, serviceMap] : subTree)
+        if (slot->serviceMap.size() != 1)
         {
-            if (objectPath.empty() || serviceMap.size() != 1)
-            {
-                BMCWEB_LOG_ERROR << "Error getting PCIeSlot D-Bus object!";
-                messages::internalError(asyncResp->res);
-                return;
-            }
-
-            if (pcieSlotPath != objectPath)
-            {
-                continue;
-            }
-
-            callback(pcieSlotPath, serviceMap);
+            BMCWEB_LOG_ERROR << "Error getting PCIeSlot D-Bus object!";
+            messages::internalError(asyncResp->res);
             return;
         }
-        BMCWEB_LOG_ERROR << "PCIe Slot not found for " << pcieDevice;
+        callback(pcieSlotPath, slot->serviceMap);
     });
 }
 
@@ -360,18 +334,33 @@ inline void
                      const std::string& pcieDevice,
                      FindPcieSlotCbFunc&& callback)
 {
-    getPcieDevicePath(asyncResp, pcieDevice,
-                      [asyncResp, pcieDevice, callback{std::move(callback)}](
-                          const boost::system::error_code& ec,
-                          const std::string& pcieDevicePath) {
-        if (ec || pcieDevicePath.empty())
+    pcie_util::PcieTopologyCache::getInstance().get(
+        [asyncResp, pcieDevice, callback{std::move(callback)}](
+            const boost::system::error_code& ec,
+            const std::shared_ptr<const pcie_util::PcieTopology>& topology) {
+        if (ec)
         {
             return;
         }
-        sdbusplus::message::object_path objpath(pcieDevicePath);
-        std::string pcieSlotPath = objpath.parent_path();
-
-        findPcieSlotServiceMap(asyncResp, pcieSlotPath, pcieDevice, callback);
+        const pcie_util::PcieTopology::Device* device =
+            topology->findDevice(pcieDevice);
+        if (device == nullptr)
+        {
+            return;
+        }
+        const pcie_util::PcieTopology::Slot* slot = topology->slotOf(*device);
+        if (slot == nullptr)
+        {
+            BMCWEB_LOG_ERROR << "PCIe Slot not found for " << pcieDevice;
+            return;
+        }
+        if (slot->serviceMap.size() != 1)
+        {
+            BMCWEB_LOG_ERROR << "Error getting PCIeSlot D-Bus object!";
+            messages::internalError(asyncResp->res);
+            return;
+        }
+        callback(slot->path, slot->serviceMap);
     });
 }
 
@@ -15,6 +15,7 @@
 #include <utils/dbus_utils.hpp>
 #include <utils/fabric_util.hpp>
 #include <utils/json_utils.hpp>
+#include <utils/pcie_topology.hpp>
 #include <utils/pcie_util.hpp>
 
 #include <algorithm>
@@ -92,32 +93,29 @@ inline void
 {
     // Collect device associated with this slot and
     // populate it here
-    constexpr std::array<std::string_view, 1> interfaces = {
-        "xyz.openbmc_project.Inventory.Item.PCIeDevice"};
-    dbus::utility::getSubTree(
-        slotPath, 1, interfaces,
-        [asyncResp,
-         index](const boost::system::error_code& ec,
-                const dbus::utility::MapperGetSubTreeResponse& subtree) {
+    pcie_util::PcieTopologyCache::getInstance().get(
+        [asyncResp, slotPath, index](
+            const boost::system::error_code& ec,
+            const std::shared_ptr<const pcie_util::PcieTopology>& topology) {
         if (ec)
         {
             BMCWEB_LOG_ERROR << "D-Bus response error on GetSubTree " << ec;
             messages::internalError(asyncResp->res);
             return;
         }
-        if (subtree.empty())
+        const pcie_util::PcieTopology::Slot* slot =
+            topology->findSlot(slotPath);
+        // Assuming only one device path per slot.
+        const pcie_util::PcieTopology::Device* device =
+            slot == nullptr ? nullptr : topology->deviceIn(*slot);
+        if (device == nullptr)
         {
             BMCWEB_LOG_DEBUG
                 << "Can't find PCIeDevice D-Bus object for given slot";
             return;
         }
 
-        // Assuming only one device path per slot.
-        const std::string& pcieDevciePath = std::get<0>(subtree[0]);
-
-        std::string devName = pcie_util::buildPCIeUniquePath(pcieDevciePath);
-
-        if (devName.empty())
+        if (device->name.empty())
         {
             BMCWEB_LOG_ERROR << "Failed to find / in pcie device path";
             messages::internalError(asyncResp->res);
@@ -126,7 +124,7 @@ inline void
 
         asyncResp->res.jsonValue["Slots"][index]["Links"]["PCIeDevice"] = {
             {{"@odata.id",
-              "/redfish/v1/Systems/system/PCIeDevices/" + devName}}};
+              "/redfish/v1/Systems/system/PCIeDevices/" + device->name}}};
     });
 }
 
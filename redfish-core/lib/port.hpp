@@ -6,7 +6,7 @@
 #include "query.hpp"
 #include "registries/privilege_registry.hpp"
 
-#include <utils/fabric_util.hpp>
+#include <utils/fabric_topology.hpp>
 #include <utils/json_utils.hpp>
 
 #include <array>
@@ -70,20 +70,16 @@ inline void getPortProperties(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
  * @param[in]       systemName         System name Id.
  * @param[in]       adapterId          AdapterId whose ports
  * are to be collected.
- * @param[in]       interfaces         List of interfaces to
- * constrain the GetSubTree search
  */
 inline void getPortCollection(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
                               const std::string& systemName,
                               const std::string& adapterId)
 {
-    constexpr std::array<std::string_view, 1> interfaces = {
-        "xyz.openbmc_project.Inventory.Item.Connector"};
-    dbus::utility::getSubTreePaths(
-        "/xyz/openbmc_project/inventory", 0, interfaces,
-        [aResp, systemName,
-         adapterId](const boost::system::error_code& ec,
-                    const dbus::utility::MapperGetSubTreePathsResponse& paths) {
+    fabric_util::FabricTopologyCache::getInstance().get(
+        [aResp, systemName, adapterId](
+            const boost::system::error_code& ec,
+            const std::shared_ptr<const fabric_util::FabricTopology>&
+                topology) {
         if (ec)
         {
             BMCWEB_LOG_DEBUG << "DBUS response error";
@@ -93,25 +89,20 @@ inline void getPortCollection(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
         nlohmann::json& members = aResp->res.jsonValue["Members"];
         members = nlohmann::json::array();
 
-        for (const auto& path : paths)
+        const fabric_util::FabricTopology::Adapter* adapter =
+            topology->findAdapter(adapterId);
+        if (adapter != nullptr)
         {
-            // get adapterPath from the dbus connector path
-            std::string adapterPath =
-                sdbusplus::message::object_path(path).parent_path();
-            const std::string& adapterUniq =
-                fabric_util::buildFabricUniquePath(adapterPath);
-            if (!fabric_util::checkFabricAdapterId(adapterId, adapterUniq))
-            {
-                continue;
-            }
-
-            std::string connectorId =
-                sdbusplus::message::object_path(path).filename();
-            nlohmann::json item;
-            item["@odata.id"] = crow::utility::urlFromPieces(
-                "redfish", "v1", "Systems", systemName, "FabricAdapters",
-                adapterId, "Ports", connectorId);
-            members.emplace_back(std::move(item));
+            topology->forEachPort(
+                *adapter,
+                [&members, &systemName,
+                 &adapterId](const fabric_util::FabricTopology::Object& port) {
+                nlohmann::json item;
+                item["@odata.id"] = crow::utility::urlFromPieces(
+                    "redfish", "v1", "Systems", systemName, "FabricAdapters",
+                    adapterId, "Ports", port.id);
+                members.emplace_back(std::move(item));
+            });
         }
         aResp->res.jsonValue["Members@odata.count"] = members.size();
     });
@@ -201,43 +192,37 @@ inline void handlePortError(const boost::system::error_code& ec,
     messages::internalError(res);
 }
 
-inline bool checkPortId(const std::string& portPath, const std::string& portId)
-{
-    std::string portName = sdbusplus::message::object_path(portPath).filename();
-
-    return !(portName.empty() || portName != portId);
-}
-
 inline void getValidPortPath(
     const std::shared_ptr<bmcweb::AsyncResp>& aResp,
-    const std::string& adapterPath, const std::string& portId,
+    const std::string& adapterId, const std::string& portId,
     std::function<void(const std::string& portPath,
                        const dbus::utility::MapperServiceMap& serviceMap)>&&
         callback)
 {
-    constexpr std::array<std::string_view, 1> interfaces{
-        "xyz.openbmc_project.Inventory.Item.Connector"};
-
-    dbus::utility::getSubTree(
-        adapterPath, 0, interfaces,
-        [portId, aResp,
-         callback](const boost::system::error_code& ec,
-                   const dbus::utility::MapperGetSubTreeResponse& subtree) {
+    fabric_util::FabricTopologyCache::getInstance().get(
+        [adapterId, portId, aResp, callback{std::move(callback)}](
+            const boost::system::error_code& ec,
+            const std::shared_ptr<const fabric_util::FabricTopology>&
+                topology) {
         if (ec)
         {
             handlePortError(ec, aResp->res, portId);
             return;
         }
-        for (const auto& [portPath, serviceMap] : subtree)
+        const fabric_util::FabricTopology::Adapter* adapter =
+            topology->findAdapter(adapterId);
+        const fabric_util::FabricTopology::Object* port = nullptr;
+        if (adapter != nullptr)
         {
-            if (checkPortId(portPath, portId))
-            {
-                callback(portPath, serviceMap);
-                return;
-            }
+            port = topology->findPort(*adapter, portId);
+        }
+        if (port == nullptr)
+        {
+            BMCWEB_LOG_WARNING << "Port not found";
+            messages::resourceNotFound(aResp->res, "Port", portId);
+            return;
         }
-        BMCWEB_LOG_WARNING << "Port not found";
-        messages::resourceNotFound(aResp->res, "Port", portId);
+        callback(port->path, port->serviceMap);
     });
 }
 
@@ -254,9 +239,9 @@ inline void handlePortHead(crow::App& app, const crow::Request& req,
 
     getValidFabricAdapterPath(
         adapterId, systemName, aResp,
-        [aResp, portId](const std::string& adapterPath, const std::string&,
-                        const dbus::utility::InterfaceList&) {
-        getValidPortPath(aResp, adapterPath, portId,
+        [aResp, adapterId, portId](const std::string&, const std::string&,
+                                   const dbus::utility::InterfaceList&) {
+        getValidPortPath(aResp, adapterId, portId,
                          [aResp](const std::string&,
                                  const dbus::utility::MapperServiceMap&) {
             aResp->res.addHeader(
@@ -280,10 +265,10 @@ inline void handlePortGet(App& app, const crow::Request& req,
     getValidFabricAdapterPath(
         adapterId, systemName, aResp,
         [aResp, portId, adapterId,
-         systemName](const std::string& adapterPath, const std::string&,
+         systemName](const std::string&, const std::string&,
                      const dbus::utility::InterfaceList&) {
         getValidPortPath(
-            aResp, adapterPath, portId,
+            aResp, adapterId, portId,
             [aResp, adapterId, systemName,
              portId](const std::string& portPath,
                      const dbus::utility::MapperServiceMap& serviceMap) {
@@ -343,12 +328,12 @@ inline void handlePortPatch(App& app, const crow::Request& req,
     }
 
     getValidFabricAdapterPath(adapterId, systemName, aResp,
-                              [aResp, portId, locationIndicatorActive](
-                                  const std::string& adapterPath,
-                                  const std::string&,
+                              [aResp, adapterId, portId,
+                               locationIndicatorActive](
+                                  const std::string&, const std::string&,
                                   const dbus::utility::InterfaceList&) {
         getValidPortPath(
-            aResp, adapterPath, portId,
+            aResp, adapterId, portId,
             [aResp, locationIndicatorActive](
                 const std::string& portPath,
                 const dbus::utility::MapperServiceMap& serviceMap) {
@@ -147,9 +147,8 @@ inline void
                         const std::string& service, const std::string& path,
                         bool available)
 {
-    sdbusplus::asio::getProperty<bool>(
-        *crow::connections::systemBus, service, path,
-        "xyz.openbmc_project.Inventory.Item", "Present",
+    dbus::utility::getPropertyBatched<bool>(
+        service, path, "xyz.openbmc_project.Inventory.Item", "Present",
         [asyncResp, available](const boost::system::error_code ec,
                                const bool value) {
         if (ec)
@@ -177,9 +176,9 @@ inline void
                          const std::string& service, const std::string& path,
                          bool available)
 {
-    sdbusplus::asio::getProperty<bool>(
-        *crow::connections::systemBus, service, path,
-        "xyz.openbmc_project.State.Decorator.OperationalStatus", "Functional",
+    dbus::utility::getPropertyBatched<bool>(
+        service, path, "xyz.openbmc_project.State.Decorator.OperationalStatus",
+        "Functional",
         [asyncResp, available](const boost::system::error_code ec,
                                const bool value) {
         if (ec)
@@ -202,9 +201,9 @@ inline void getPowerSupplyStateAndHealth(
     const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
     const std::string& service, const std::string& path)
 {
-    sdbusplus::asio::getProperty<bool>(
-        *crow::connections::systemBus, service, path,
-        "xyz.openbmc_project.State.Decorator.Availability", "Available",
+    dbus::utility::getPropertyBatched<bool>(
+        service, path, "xyz.openbmc_project.State.Decorator.Availability",
+        "Available",
         [asyncResp, service, path](const boost::system::error_code ec,
                                    const bool available) {
         if (ec)
@@ -226,9 +225,8 @@ inline void
     getPowerSupplyAsset(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
                         const std::string& service, const std::string& path)
 {
-    sdbusplus::asio::getAllProperties(
-        *crow::connections::systemBus, service, path,
-        "xyz.openbmc_project.Inventory.Decorator.Asset",
+    dbus::utility::getAllPropertiesBatched(
+        service, path, "xyz.openbmc_project.Inventory.Decorator.Asset",
         [asyncResp](const boost::system::error_code ec,
                     const dbus::utility::DBusPropertiesMap& propertiesList) {
         if (ec)
@@ -289,9 +287,8 @@ inline void getPowerSupplyFirmwareVersion(
     const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
     const std::string& service, const std::string& path)
 {
-    sdbusplus::asio::getProperty<std::string>(
-        *crow::connections::systemBus, service, path,
-        "xyz.openbmc_project.Software.Version", "Version",
+    dbus::utility::getPropertyBatched<std::string>(
+        service, path, "xyz.openbmc_project.Software.Version", "Version",
         [asyncResp](const boost::system::error_code ec,
                     const std::string& value) {
         if (ec)
@@ -310,9 +307,9 @@ inline void
     getPowerSupplyLocation(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
                            const std::string& service, const std::string& path)
 {
-    sdbusplus::asio::getProperty<std::string>(
-        *crow::connections::systemBus, service, path,
-        "xyz.openbmc_project.Inventory.Decorator.LocationCode", "LocationCode",
+    dbus::utility::getPropertyBatched<std::string>(
+        service, path, "xyz.openbmc_project.Inventory.Decorator.LocationCode",
+        "LocationCode",
         [asyncResp](const boost::system::error_code ec,
                     const std::string& value) {
         if (ec)
@@ -10,25 +10,24 @@
 #include "registries/privilege_registry.hpp"
 #include "utility.hpp"
 #include "utils/chassis_utils.hpp"
-#include "utils/dbus_utils.hpp"
+#include "utils/input_history_cache.hpp"
 #include "utils/power_supply_utils.hpp"
-#include "utils/time_utils.hpp"
+#include "utils/query_param.hpp"
 
 #include <boost/beast/http/field.hpp>
 #include <boost/beast/http/verb.hpp>
 #include <boost/system/error_code.hpp>
 #include <sdbusplus/asio/property.hpp>
-#include <sdbusplus/unpack_properties.hpp>
 
 #include <algorithm>
 #include <array>
-#include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <memory>
 #include <optional>
 #include <string>
-#include <tuple>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -38,34 +37,16 @@ namespace redfish
 namespace power_supply_metrics
 {
 
-static const char* historyMaximumInterface =
-    "org.open_power.Sensor.Aggregation.History.Maximum";
-static const char* historyAverageInterface =
-    "org.open_power.Sensor.Aggregation.History.Average";
-
 static std::array<std::string_view, 2> historyInterfaces{
-    historyMaximumInterface, historyAverageInterface};
+    power_supply_utils::historyMaximumInterface,
+    power_supply_utils::historyAverageInterface};
 
-inline void addInputHistoryProperties(
-    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-    const std::string& interface,
-    const dbus::utility::DBusPropertiesMap& propertiesList)
+// Adds the samples of one history object to the InputPowerHistoryItems
+inline void
+    addInputHistoryItems(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+                         const power_supply_utils::InputHistory& history)
 {
-    // Get Scale and Values properties
-    int64_t scale{0};
-    std::vector<std::tuple<uint64_t, int64_t>> values{};
-    const bool success = sdbusplus::unpackPropertiesNoThrow(
-        dbus_utils::UnpackErrorPrinter(), propertiesList, "Scale", scale,
-        "Values", values);
-
-    if (!success)
-    {
-        BMCWEB_LOG_ERROR << "Unable to unpack input history properties";
-        messages::internalError(asyncResp->res);
-        return;
-    }
-
-    if (values.empty())
+    if (history.samples.empty())
     {
         return;
     }
@@ -76,30 +57,51 @@ inline void addInputHistoryProperties(
     if (jsonItems.empty())
     {
         // First set of values being added; create array with correct size
-        jsonItems = nlohmann::json(values.size(), nlohmann::json::object());
+        jsonItems = nlohmann::json(history.samples.size(),
+                                   nlohmann::json::object());
     }
-    else if (jsonItems.size() != values.size())
+    else if (jsonItems.size() != history.samples.size())
     {
         // Second set of values being added; different size than first set
         messages::internalError(asyncResp->res);
         return;
     }
 
-    // Loop through the values, adding them to the JSON array
-    for (unsigned int i = 0; i < values.size(); ++i)
+    const char* key = history.interface ==
+                              power_supply_utils::historyMaximumInterface
+                          ? "Maximum"
+                          : "Average";
+    size_t i = 0;
+    for (const power_supply_utils::InputHistorySample& sample :
+         history.samples)
     {
-        auto& jsonItem = jsonItems[i];
-        const auto [timestamp, value] = values[i];
-        jsonItem["Date"] = redfish::time_utils::getDateTimeUintMs(timestamp);
-        double scaledValue = static_cast<double>(value) * std::pow(10.0, scale);
-        if (interface == historyMaximumInterface)
-        {
-            jsonItem["Maximum"] = scaledValue;
-        }
-        else
-        {
-            jsonItem["Average"] = scaledValue;
-        }
+        auto& jsonItem = jsonItems[i++];
+        jsonItem["Date"] = sample.date;
+        jsonItem[key] = sample.value;
+    }
+}
+
+// Applies the delegated $filter and $top to the InputPowerHistoryItems, so a
+// client can ask for a window of time, e.g. $filter=Date ge '<DateTime>'
+inline void limitInputHistoryItems(crow::Response& res,
+                                   const query_param::Query& delegated)
+{
+    nlohmann::json::array_t* items =
+        res.jsonValue["Oem"]["IBM"]["InputPowerHistoryItems"]
+            .get_ptr<nlohmann::json::array_t*>();
+    if (items == nullptr)
+    {
+        return;
+    }
+    if (delegated.filter)
+    {
+        std::erase_if(*items, [&delegated](const nlohmann::json& item) {
+            return !delegated.filter->matches(item);
+        });
+    }
+    if (delegated.top && *delegated.top < items->size())
+    {
+        items->resize(*delegated.top);
     }
 }
 
@@ -139,22 +141,43 @@ inline void getInputHistoryServiceAndInterface(
     });
 }
 
-inline void getInputHistory(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-                            std::vector<std::string> historyPaths)
+inline void getInputHistory(
+    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+    const std::shared_ptr<const std::vector<std::string>>& historyPaths,
+    size_t index, const std::shared_ptr<const query_param::Query>& delegated)
 {
-    // Get the service and interface for the first history path
+    if (index >= historyPaths->size())
+    {
+        limitInputHistoryItems(asyncResp->res, *delegated);
+        return;
+    }
+    const std::string& historyPath = (*historyPaths)[index];
+
+    power_supply_utils::InputHistoryCache& cache =
+        power_supply_utils::InputHistoryCache::getInstance();
+    const power_supply_utils::InputHistory* cached = cache.find(historyPath);
+    if (cached != nullptr)
+    {
+        addInputHistoryItems(asyncResp, *cached);
+        getInputHistory(asyncResp, historyPaths, index + 1, delegated);
+        return;
+    }
+
+    // Get the service and interface for the history path
     getInputHistoryServiceAndInterface(
-        asyncResp, historyPaths.front(),
-        [asyncResp, historyPaths](const std::string& service,
-                                  const std::string& interface) mutable {
-        // Get all properties from the first history path
+        asyncResp, historyPath,
+        [asyncResp, historyPaths, index,
+         delegated](const std::string& service, const std::string& interface) {
+        const std::string& path = (*historyPaths)[index];
+        uint64_t generation =
+            power_supply_utils::InputHistoryCache::getInstance().generation();
+        // Get all properties from the history path
         sdbusplus::asio::getAllProperties(
-            *crow::connections::systemBus, service, historyPaths.front(),
-            interface,
-            [asyncResp, historyPaths,
-             interface](const boost::system::error_code& ec,
-                        const dbus::utility::DBusPropertiesMap&
-                            propertiesList) mutable {
+            *crow::connections::systemBus, service, path, interface,
+            [asyncResp, historyPaths, index, delegated, service, interface,
+             generation](const boost::system::error_code& ec,
+                         const dbus::utility::DBusPropertiesMap&
+                             propertiesList) {
             if (ec)
             {
                 BMCWEB_LOG_ERROR << "D-Bus response error: " << ec;
@@ -162,15 +185,23 @@ inline void getInputHistory(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
                 return;
             }
 
-            // Add input history properties to the JSON response
-            addInputHistoryProperties(asyncResp, interface, propertiesList);
-
-            // Recurse if there are more input history paths
-            if (historyPaths.size() > 1)
+            power_supply_utils::InputHistory history;
+            history.service = service;
+            history.interface = interface;
+            if (!power_supply_utils::updateInputHistory(history,
+                                                        propertiesList))
             {
-                historyPaths.erase(historyPaths.cbegin());
-                getInputHistory(asyncResp, historyPaths);
+                BMCWEB_LOG_ERROR << "Unable to unpack input history properties";
+                messages::internalError(asyncResp->res);
+                return;
             }
+
+            // Add input history properties to the JSON response
+            addInputHistoryItems(asyncResp, history);
+            power_supply_utils::InputHistoryCache::getInstance().store(
+                (*historyPaths)[index], std::move(history), generation);
+
+            getInputHistory(asyncResp, historyPaths, index + 1, delegated);
         });
     });
 }
@@ -238,15 +269,23 @@ inline void handleGet(App& app, const crow::Request& req,
                       const std::string& chassisId,
                       const std::string& powerSupplyId)
 {
-    if (!redfish::setUpRedfishRoute(app, req, asyncResp))
+    query_param::Query delegated;
+    query_param::QueryCapabilities capabilities = {
+        .canDelegateTop = true,
+        .canDelegateFilter = true,
+    };
+    if (!redfish::setUpRedfishRouteWithDelegation(app, req, asyncResp,
+                                                  delegated, capabilities))
     {
         return;
     }
 
     getValidInputHistoryPaths(
         asyncResp, chassisId, powerSupplyId,
-        [asyncResp, chassisId,
-         powerSupplyId](const std::vector<std::string>& historyPaths) {
+        [asyncResp, chassisId, powerSupplyId,
+         delegated{std::make_shared<const query_param::Query>(
+             std::move(delegated))}](
+            const std::vector<std::string>& historyPaths) {
         asyncResp->res.addHeader(
             boost::beast::http::field::link,
             "</redfish/v1/JsonSchemas/PowerSupplyMetrics/PowerSupplyMetrics.json>; rel=describedby");
@@ -265,7 +304,10 @@ inline void handleGet(App& app, const crow::Request& req,
             nlohmann::json::array();
 
         // Get input history values and add them to the response
-        getInputHistory(asyncResp, historyPaths);
+        getInputHistory(
+            asyncResp,
+            std::make_shared<const std::vector<std::string>>(historyPaths), 0,
+            delegated);
     });
 }
 
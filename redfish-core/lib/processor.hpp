@@ -35,6 +35,7 @@
 #include <utils/hw_isolation.hpp>
 #include <utils/json_utils.hpp>
 #include <utils/name_utils.hpp>
+#include <utils/processor_model_cache.hpp>
 
 namespace redfish
 {
@@ -110,11 +111,10 @@ inline void getProcessorUUID(std::shared_ptr<bmcweb::AsyncResp> aResp,
                              const std::string& objPath)
 {
     BMCWEB_LOG_DEBUG << "Get Processor UUID";
-    sdbusplus::asio::getProperty<std::string>(
-        *crow::connections::systemBus, service, objPath,
-        "xyz.openbmc_project.Common.UUID", "UUID",
-        [objPath, aResp{std::move(aResp)}](const boost::system::error_code ec,
-                                           const std::string& property) {
+    dbus::utility::getPropertyBatched<std::string>(
+        service, objPath, "xyz.openbmc_project.Common.UUID", "UUID",
+        [aResp{std::move(aResp)}](const boost::system::error_code& ec,
+                                  const std::string& property) {
         if (ec)
         {
             BMCWEB_LOG_DEBUG << "DBUS response error";
@@ -275,10 +275,13 @@ inline void getCpuDataByService(std::shared_ptr<bmcweb::AsyncResp> aResp,
 {
     BMCWEB_LOG_DEBUG << "Get available system cpu resources by service.";
 
-    crow::connections::systemBus->async_method_call(
-        [cpuId, service, objPath, aResp{std::move(aResp)}](
-            const boost::system::error_code ec,
-            const dbus::utility::ManagedObjectType& dbusData) {
+    std::string corePath = objPath + "/core";
+    processor_utils::ProcessorModelCache::getInstance().get(
+        service,
+        [cpuId, objPath, corePath, aResp{std::move(aResp)}](
+            const boost::system::error_code& ec,
+            const std::shared_ptr<const processor_utils::ProcessorModel>&
+                model) {
         if (ec)
         {
             BMCWEB_LOG_DEBUG << "DBUS response error";
@@ -289,34 +292,39 @@ inline void getCpuDataByService(std::shared_ptr<bmcweb::AsyncResp> aResp,
         aResp->res.jsonValue["Name"] = "Processor";
         aResp->res.jsonValue["ProcessorType"] = "CPU";
 
+        const dbus::utility::DBusInteracesMap* cpuInterfaces =
+            model->find(objPath);
+        if (cpuInterfaces != nullptr)
+        {
+            getCpuDataByInterface(aResp, *cpuInterfaces);
+        }
+
+        // The model is sorted by path, so the cores follow one another
         bool slotPresent = false;
-        std::string corePath = objPath + "/core";
         size_t totalCores = 0;
-        for (const auto& object : dbusData)
+        for (auto object = model->objects.lower_bound(corePath);
+             object != model->objects.end(); object++)
         {
-            if (object.first.str == objPath)
+            if (!object->first.starts_with(corePath))
             {
-                getCpuDataByInterface(aResp, object.second);
+                break;
             }
-            else if (object.first.str.starts_with(corePath))
+            for (const auto& interface : object->second)
             {
-                for (const auto& interface : object.second)
+                if (interface.first == "xyz.openbmc_project.Inventory.Item")
                 {
-                    if (interface.first == "xyz.openbmc_project.Inventory.Item")
+                    for (const auto& property : interface.second)
                     {
-                        for (const auto& property : interface.second)
+                        if (property.first == "Present")
                         {
-                            if (property.first == "Present")
+                            const bool* present =
+                                std::get_if<bool>(&property.second);
+                            if (present != nullptr)
                             {
-                                const bool* present =
-                                    std::get_if<bool>(&property.second);
-                                if (present != nullptr)
+                                if (*present)
                                 {
-                                    if (*present)
-                                    {
-                                        slotPresent = true;
-                                        totalCores++;
-                                    }
+                                    slotPresent = true;
+                                    totalCores++;
                                 }
                             }
                         }
@@ -338,9 +346,7 @@ inline void getCpuDataByService(std::shared_ptr<bmcweb::AsyncResp> aResp,
             aResp->res.jsonValue["TotalCores"] = totalCores;
         }
         return;
-    },
-        service, "/xyz/openbmc_project/inventory",
-        "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
+    });
 }
 
 /**
@@ -428,9 +434,8 @@ inline void
 {
     BMCWEB_LOG_DEBUG << "Get processor throttle resources";
 
-    sdbusplus::asio::getAllProperties(
-        *crow::connections::systemBus, service, objectPath,
-        "xyz.openbmc_project.Control.Power.Throttle",
+    dbus::utility::getAllPropertiesBatched(
+        service, objectPath, "xyz.openbmc_project.Control.Power.Throttle",
         [aResp](const boost::system::error_code& ec,
                 const dbus::utility::DBusPropertiesMap& properties) {
         readThrottleProperties(aResp, ec, properties);
@@ -442,11 +447,10 @@ inline void getCpuAssetData(std::shared_ptr<bmcweb::AsyncResp> aResp,
                             const std::string& objPath)
 {
     BMCWEB_LOG_DEBUG << "Get Cpu Asset Data";
-    sdbusplus::asio::getAllProperties(
-        *crow::connections::systemBus, service, objPath,
-        "xyz.openbmc_project.Inventory.Decorator.Asset",
-        [objPath, aResp{std::move(aResp)}](
-            const boost::system::error_code ec,
+    dbus::utility::getAllPropertiesBatched(
+        service, objPath, "xyz.openbmc_project.Inventory.Decorator.Asset",
+        [aResp{std::move(aResp)}](
+            const boost::system::error_code& ec,
             const dbus::utility::DBusPropertiesMap& properties) {
         if (ec)
         {
@@ -516,11 +520,10 @@ inline void getCpuRevisionData(std::shared_ptr<bmcweb::AsyncResp> aResp,
                                const std::string& objPath)
 {
     BMCWEB_LOG_DEBUG << "Get Cpu Revision Data";
-    sdbusplus::asio::getAllProperties(
-        *crow::connections::systemBus, service, objPath,
-        "xyz.openbmc_project.Inventory.Decorator.Revision",
-        [objPath, aResp{std::move(aResp)}](
-            const boost::system::error_code ec,
+    dbus::utility::getAllPropertiesBatched(
+        service, objPath, "xyz.openbmc_project.Inventory.Decorator.Revision",
+        [aResp{std::move(aResp)}](
+            const boost::system::error_code& ec,
             const dbus::utility::DBusPropertiesMap& properties) {
         if (ec)
         {
@@ -553,8 +556,8 @@ inline void getAcceleratorDataByService(
 {
     BMCWEB_LOG_DEBUG
         << "Get available system Accelerator resources by service.";
-    sdbusplus::asio::getAllProperties(
-        *crow::connections::systemBus, service, objPath, "",
+    dbus::utility::getAllProperties(
+        service, objPath, "",
         [acclrtrId, aResp{std::move(aResp)}](
             const boost::system::error_code ec,
             const dbus::utility::DBusPropertiesMap& properties) {
@@ -665,19 +668,29 @@ inline void getCpuConfigData(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
 {
     BMCWEB_LOG_INFO << "Getting CPU operating configs for " << cpuId;
 
-    // First, GetAll CurrentOperatingConfig properties on the object
-    sdbusplus::asio::getAllProperties(
-        *crow::connections::systemBus, service, objPath,
-        "xyz.openbmc_project.Control.Processor.CurrentOperatingConfig",
-        [aResp, cpuId,
-         service](const boost::system::error_code ec,
-                  const dbus::utility::DBusPropertiesMap& properties) {
+    // The CPU's CurrentOperatingConfig and the config it points at both
+    // come out of the processor model
+    processor_utils::ProcessorModelCache::getInstance().get(
+        service,
+        [aResp, cpuId, objPath](
+            const boost::system::error_code& ec,
+            const std::shared_ptr<const processor_utils::ProcessorModel>&
+                model) {
         if (ec)
         {
             BMCWEB_LOG_WARNING << "D-Bus error: " << ec << ", " << ec.message();
             messages::internalError(aResp->res);
             return;
         }
+        const dbus::utility::DBusPropertiesMap* properties = model->find(
+            objPath,
+            "xyz.openbmc_project.Control.Processor.CurrentOperatingConfig");
+        if (properties == nullptr)
+        {
+            BMCWEB_LOG_WARNING << "No CurrentOperatingConfig on " << objPath;
+            messages::internalError(aResp->res);
+            return;
+        }
 
         nlohmann::json& json = aResp->res.jsonValue;
 
@@ -685,7 +698,7 @@ inline void getCpuConfigData(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
         const bool* baseSpeedPriorityEnabled = nullptr;
 
         const bool success = sdbusplus::unpackPropertiesNoThrow(
-            dbus_utils::UnpackErrorPrinter(), properties, "AppliedConfig",
+            dbus_utils::UnpackErrorPrinter(), *properties, "AppliedConfig",
             appliedConfig, "BaseSpeedPriorityEnabled",
             baseSpeedPriorityEnabled);
 
@@ -722,26 +735,26 @@ inline void getCpuConfigData(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
             appliedOperatingConfig["@odata.id"] = uri;
             json["AppliedOperatingConfig"] = std::move(appliedOperatingConfig);
 
-            // Once we found the current applied config, queue another
-            // request to read the base freq core ids out of that
+            // Read the base freq core ids out of the current applied
             // config.
-            sdbusplus::asio::getProperty<BaseSpeedPrioritySettingsProperty>(
-                *crow::connections::systemBus, service, dbusPath,
-                "xyz.openbmc_project.Inventory.Item.Cpu."
-                "OperatingConfig",
-                "BaseSpeedPrioritySettings",
-                [aResp](
-                    const boost::system::error_code ec2,
-                    const BaseSpeedPrioritySettingsProperty& baseSpeedList) {
-                if (ec2)
-                {
-                    BMCWEB_LOG_WARNING << "D-Bus Property Get error: " << ec2;
-                    messages::internalError(aResp->res);
-                    return;
-                }
+            const dbus::utility::DBusPropertiesMap* configProperties =
+                model->find(
+                    dbusPath,
+                    "xyz.openbmc_project.Inventory.Item.Cpu.OperatingConfig");
+            const BaseSpeedPrioritySettingsProperty* baseSpeedList = nullptr;
+            if (configProperties == nullptr ||
+                !sdbusplus::unpackPropertiesNoThrow(
+                    dbus_utils::UnpackErrorPrinter(), *configProperties,
+                    "BaseSpeedPrioritySettings", baseSpeedList) ||
+                baseSpeedList == nullptr)
+            {
+                BMCWEB_LOG_WARNING << "No BaseSpeedPrioritySettings on "
+                                   << dbusPath;
+                messages::internalError(aResp->res);
+                return;
+            }
 
-                highSpeedCoreIdsHandler(aResp, baseSpeedList);
-            });
+            highSpeedCoreIdsHandler(aResp, *baseSpeedList);
         }
 
         if (baseSpeedPriorityEnabled != nullptr)
@@ -765,11 +778,11 @@ inline void getCpuLocationCode(std::shared_ptr<bmcweb::AsyncResp> aResp,
                                const std::string& objPath)
 {
     BMCWEB_LOG_DEBUG << "Get Cpu Location Data";
-    sdbusplus::asio::getProperty<std::string>(
-        *crow::connections::systemBus, service, objPath,
+    dbus::utility::getPropertyBatched<std::string>(
+        service, objPath,
         "xyz.openbmc_project.Inventory.Decorator.LocationCode", "LocationCode",
-        [objPath, aResp{std::move(aResp)}](const boost::system::error_code ec,
-                                           const std::string& property) {
+        [aResp{std::move(aResp)}](const boost::system::error_code& ec,
+                                  const std::string& property) {
         if (ec)
         {
             BMCWEB_LOG_DEBUG << "DBUS response error";
@@ -795,11 +808,11 @@ inline void getCpuUniqueId(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
                            const std::string& objectPath)
 {
     BMCWEB_LOG_DEBUG << "Get CPU UniqueIdentifier";
-    sdbusplus::asio::getProperty<std::string>(
-        *crow::connections::systemBus, service, objectPath,
+    dbus::utility::getPropertyBatched<std::string>(
+        service, objectPath,
         "xyz.openbmc_project.Inventory.Decorator.UniqueIdentifier",
         "UniqueIdentifier",
-        [aResp](boost::system::error_code ec, const std::string& id) {
+        [aResp](const boost::system::error_code& ec, const std::string& id) {
         if (ec)
         {
             BMCWEB_LOG_ERROR << "Failed to read cpu unique id: " << ec;
@@ -895,9 +908,23 @@ inline void getProcessorObject(const std::shared_ptr<bmcweb::AsyncResp>& resp,
 
 inline void getProcessorData(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
                              const std::string& processorId,
+                             const query_param::SelectTrie& select,
                              const std::string& objectPath,
                              const dbus::utility::MapperServiceMap& serviceMap)
 {
+    // With $select, skip the D-Bus calls whose properties weren't asked for.
+    // The Cpu and Accelerator data carry Status, so those are only skipped
+    // when none of their properties were selected either.
+    const bool wantCpuData = select.isAnySelected(
+        {"Id", "Name", "ProcessorType", "Status", "TotalCores", "TotalThreads",
+         "MaxSpeedMHz", "Socket", "ProcessorId"});
+    const bool wantConfig = select.isAnySelected(
+        {"OperatingConfigs", "AppliedOperatingConfig", "BaseSpeedPriorityState",
+         "HighSpeedCoreIDs"});
+    const bool wantAsset = select.isAnySelected(
+        {"Manufacturer", "Model", "PartNumber", "SerialNumber",
+         "SparePartNumber", "ProcessorArchitecture", "InstructionSet"});
+
     for (const auto& [serviceName, interfaceList] : serviceMap)
     {
         bool assertInterface = false;
@@ -919,22 +946,32 @@ inline void getProcessorData(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
             else if (interface == "xyz.openbmc_project.Inventory.Item.Cpu")
             {
                 cpuInterface = true;
-                getCpuDataByService(aResp, processorId, serviceName,
-                                    objectPath);
-                name_util::getPrettyName(aResp, objectPath, serviceName,
-                                         "/Name"_json_pointer);
+                if (wantCpuData)
+                {
+                    getCpuDataByService(aResp, processorId, serviceName,
+                                        objectPath);
+                    name_util::getPrettyName(aResp, objectPath, serviceName,
+                                             "/Name"_json_pointer);
+                }
             }
             else if (interface ==
                      "xyz.openbmc_project.Inventory.Item.Accelerator")
             {
-                getAcceleratorDataByService(aResp, processorId, serviceName,
-                                            objectPath);
+                if (wantCpuData)
+                {
+                    getAcceleratorDataByService(aResp, processorId,
+                                                serviceName, objectPath);
+                }
             }
             else if (
                 interface ==
                 "xyz.openbmc_project.Control.Processor.CurrentOperatingConfig")
             {
-                getCpuConfigData(aResp, processorId, serviceName, objectPath);
+                if (wantConfig)
+                {
+                    getCpuConfigData(aResp, processorId, serviceName,
+                                     objectPath);
+                }
             }
             else if (interface ==
                      "xyz.openbmc_project.Inventory.Decorator.LocationCode")
@@ -943,12 +980,18 @@ inline void getProcessorData(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
             }
             else if (interface == "xyz.openbmc_project.Common.UUID")
             {
-                getProcessorUUID(aResp, serviceName, objectPath);
+                if (select.isAnySelected({"UUID"}))
+                {
+                    getProcessorUUID(aResp, serviceName, objectPath);
+                }
             }
             else if (interface ==
                      "xyz.openbmc_project.Inventory.Decorator.UniqueIdentifier")
             {
-                getCpuUniqueId(aResp, serviceName, objectPath);
+                if (select.isAnySelected({"ProcessorId"}))
+                {
+                    getCpuUniqueId(aResp, serviceName, objectPath);
+                }
             }
             else if (interface == "xyz.openbmc_project.Association.Definitions")
             {
@@ -956,26 +999,32 @@ inline void getProcessorData(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
             }
             else if (interface == "xyz.openbmc_project.Control.Power.Throttle")
             {
-                getThrottleProperties(aResp, serviceName, objectPath);
+                if (select.isAnySelected({"Throttled", "ThrottleCauses"}))
+                {
+                    getThrottleProperties(aResp, serviceName, objectPath);
+                }
             }
         }
 
-        if (cpuInterface && assertInterface)
+        if (cpuInterface && assertInterface && wantAsset)
         {
             getCpuAssetData(aResp, serviceName, objectPath);
         }
 
-        if (cpuInterface && revisionInterface)
+        if (cpuInterface && revisionInterface &&
+            select.isAnySelected({"Version"}))
         {
             getCpuRevisionData(aResp, serviceName, objectPath);
         }
 
-        if (cpuInterface && locationCodeInterface)
+        if (cpuInterface && locationCodeInterface &&
+            select.isAnySelected({"Location"}))
         {
             getCpuLocationCode(aResp, serviceName, objectPath);
         }
 
-        if (cpuInterface && associationInterface)
+        if (cpuInterface && associationInterface &&
+            select.isAnySelected({"LocationIndicatorActive"}))
         {
             getLocationIndicatorActive(aResp, objectPath);
         }
@@ -986,10 +1035,13 @@ template <typename Handler>
 inline void getProcessorPaths(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
                               const std::string& processorId, Handler&& handler)
 {
-    crow::connections::systemBus->async_method_call(
+    constexpr std::array<std::string_view, 1> interfaces = {
+        "xyz.openbmc_project.Inventory.Item.Cpu"};
+    dbus::utility::getSubTreePaths(
+        "/xyz/openbmc_project/inventory", 0, interfaces,
         [processorId, aResp, handler{std::forward<Handler>(handler)}](
-            const boost::system::error_code ec,
-            const std::vector<std::string>& subTreePaths) {
+            const boost::system::error_code& ec,
+            const dbus::utility::MapperGetSubTreePathsResponse& subTreePaths) {
         if (ec)
         {
             BMCWEB_LOG_ERROR << "DBUS response error";
@@ -1019,12 +1071,7 @@ inline void getProcessorPaths(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
 
         // Object not found
         messages::resourceNotFound(aResp->res, "Processor", processorId);
-    },
-        "xyz.openbmc_project.ObjectMapper",
-        "/xyz/openbmc_project/object_mapper",
-        "xyz.openbmc_project.ObjectMapper", "GetSubTreePaths",
-        "/xyz/openbmc_project/inventory", 0,
-        std::array<const char*, 1>{"xyz.openbmc_project.Inventory.Item.Cpu"});
+    });
 }
 
 inline void
@@ -1037,9 +1084,12 @@ inline void
     aResp->res.jsonValue["Status"]["State"] = "Enabled";
     aResp->res.jsonValue["Status"]["Health"] = "OK";
 
-    crow::connections::systemBus->async_method_call(
-        [objPath, aResp](const boost::system::error_code ec,
-                         const dbus::utility::ManagedObjectType& dbusData) {
+    processor_utils::ProcessorModelCache::getInstance().get(
+        service,
+        [objPath, aResp](
+            const boost::system::error_code& ec,
+            const std::shared_ptr<const processor_utils::ProcessorModel>&
+                model) {
         if (ec)
         {
             BMCWEB_LOG_DEBUG << "DBUS response error, ec: " << ec.value();
@@ -1047,120 +1097,117 @@ inline void
             return;
         }
 
-        for (const auto& [path, interfaces] : dbusData)
+        const dbus::utility::DBusInteracesMap* interfaces =
+            model->find(objPath);
+        if (interfaces == nullptr)
         {
-            if (path != objPath)
-            {
-                continue;
-            }
+            return;
+        }
 
-            bool present = true;
-            bool functional = true;
-            bool available = true;
+        bool present = true;
+        bool functional = true;
+        bool available = true;
 
-            for (const auto& [interface, properties] : interfaces)
+        for (const auto& [interface, properties] : *interfaces)
+        {
+            if (interface == "xyz.openbmc_project.State."
+                             "Decorator.OperationalStatus")
             {
-                if (interface == "xyz.openbmc_project.State."
-                                 "Decorator.OperationalStatus")
+                for (const auto& [proName, proValue] : properties)
                 {
-                    for (const auto& [proName, proValue] : properties)
+                    if (proName == "Functional")
                     {
-                        if (proName == "Functional")
+                        const bool* value = std::get_if<bool>(&proValue);
+                        if (value == nullptr)
                         {
-                            const bool* value = std::get_if<bool>(&proValue);
-                            if (value == nullptr)
-                            {
-                                messages::internalError(aResp->res);
-                                return;
-                            }
-                            functional = *value;
+                            messages::internalError(aResp->res);
+                            return;
                         }
+                        functional = *value;
                     }
                 }
-                else if (interface == "xyz.openbmc_project.Inventory.Item")
+            }
+            else if (interface == "xyz.openbmc_project.Inventory.Item")
+            {
+                for (const auto& [proName, proValue] : properties)
                 {
-                    for (const auto& [proName, proValue] : properties)
+                    if (proName == "Present")
                     {
-                        if (proName == "Present")
+                        const bool* value = std::get_if<bool>(&proValue);
+                        if (value == nullptr)
                         {
-                            const bool* value = std::get_if<bool>(&proValue);
-                            if (value == nullptr)
-                            {
-                                messages::internalError(aResp->res);
-                                return;
-                            }
-                            present = *value;
+                            messages::internalError(aResp->res);
+                            return;
                         }
-                        else if (proName == "PrettyName")
+                        present = *value;
+                    }
+                    else if (proName == "PrettyName")
+                    {
+                        const std::string* prettyName =
+                            std::get_if<std::string>(&proValue);
+                        if (prettyName == nullptr)
                         {
-                            const std::string* prettyName =
-                                std::get_if<std::string>(&proValue);
-                            if (prettyName == nullptr)
-                            {
-                                messages::internalError(aResp->res);
-                                return;
-                            }
-                            aResp->res.jsonValue["Name"] = *prettyName;
+                            messages::internalError(aResp->res);
+                            return;
                         }
+                        aResp->res.jsonValue["Name"] = *prettyName;
                     }
                 }
-                else if (interface == "xyz.openbmc_project.Object.Enable")
+            }
+            else if (interface == "xyz.openbmc_project.Object.Enable")
+            {
+                for (const auto& [proName, proValue] : properties)
                 {
-                    for (const auto& [proName, proValue] : properties)
+                    if (proName == "Enabled")
                     {
-                        if (proName == "Enabled")
+                        const bool* enabled = std::get_if<bool>(&proValue);
+                        if (enabled == nullptr)
                         {
-                            const bool* enabled = std::get_if<bool>(&proValue);
-                            if (enabled == nullptr)
-                            {
-                                messages::internalError(aResp->res);
-                                return;
-                            }
-                            aResp->res.jsonValue["Enabled"] = *enabled;
+                            messages::internalError(aResp->res);
+                            return;
                         }
+                        aResp->res.jsonValue["Enabled"] = *enabled;
                     }
                 }
-                else if (interface ==
-                         "xyz.openbmc_project.State.Decorator.Availability")
+            }
+            else if (interface ==
+                     "xyz.openbmc_project.State.Decorator.Availability")
+            {
+                for (const auto& [proName, proValue] : properties)
                 {
-                    for (const auto& [proName, proValue] : properties)
+                    if (proName == "Available")
                     {
-                        if (proName == "Available")
+                        const bool* value = std::get_if<bool>(&proValue);
+                        if (value == nullptr)
                         {
-                            const bool* value = std::get_if<bool>(&proValue);
-                            if (value == nullptr)
-                            {
-                                messages::internalError(aResp->res);
-                                return;
-                            }
-                            available = *value;
+                            messages::internalError(aResp->res);
+                            return;
                         }
+                        available = *value;
                     }
                 }
             }
+        }
 
-            if (!available)
-            {
-                aResp->res.jsonValue["Status"]["State"] = "UnavailableOffline";
-            }
-            else if (!present)
-            {
-                aResp->res.jsonValue["Status"]["State"] = "Absent";
-            }
+        if (!available)
+        {
+            aResp->res.jsonValue["Status"]["State"] = "UnavailableOffline";
+        }
+        else if (!present)
+        {
+            aResp->res.jsonValue["Status"]["State"] = "Absent";
+        }
 
-            if (!functional)
-            {
-                aResp->res.jsonValue["Status"]["Health"] = "Critical";
-            }
+        if (!functional)
+        {
+            aResp->res.jsonValue["Status"]["Health"] = "Critical";
+        }
 
 #ifdef BMCWEB_ENABLE_HW_ISOLATION
-            // Check for the hardware status event
-            hw_isolation_utils::getHwIsolationStatus(aResp, objPath);
+        // Check for the hardware status event
+        hw_isolation_utils::getHwIsolationStatus(aResp, objPath);
 #endif // end of BMCWEB_ENABLE_HW_ISOLATION
-        }
-    },
-        service, "/xyz/openbmc_project/inventory",
-        "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
+    });
 }
 
 inline void getSubProcessorData(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
@@ -1170,13 +1217,13 @@ inline void getSubProcessorData(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
     BMCWEB_LOG_DEBUG << "Get available system sub processor resources.";
 
     auto callback = [aResp, processorId, coreId](const std::string& cpuPath) {
-        crow::connections::systemBus->async_method_call(
+        constexpr std::array<std::string_view, 1> interfaces = {
+            "xyz.openbmc_project.Inventory.Item.CpuCore"};
+        dbus::utility::getSubTree(
+            cpuPath, 0, interfaces,
             [aResp, processorId, coreId](
-                const boost::system::error_code ec,
-                const boost::container::flat_map<
-                    std::string, boost::container::flat_map<
-                                     std::string, std::vector<std::string>>>&
-                    subtree) {
+                const boost::system::error_code& ec,
+                const dbus::utility::MapperGetSubTreeResponse& subtree) {
             if (ec)
             {
                 BMCWEB_LOG_DEBUG << "DBUS response error, ec: " << ec.value();
@@ -1224,12 +1271,7 @@ inline void getSubProcessorData(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
                 messages::resourceNotFound(aResp->res, "Processor", coreId);
                 return;
             }
-        },
-            "xyz.openbmc_project.ObjectMapper",
-            "/xyz/openbmc_project/object_mapper",
-            "xyz.openbmc_project.ObjectMapper", "GetSubTree", cpuPath, 0,
-            std::array<const char*, 1>{
-                "xyz.openbmc_project.Inventory.Item.CpuCore"});
+        });
     };
 
     getProcessorPaths(aResp, processorId, std::move(callback));
@@ -1240,9 +1282,14 @@ inline void
                            const std::string& processorId)
 {
     auto callback = [aResp, processorId](const std::string& cpuPath) {
-        crow::connections::systemBus->async_method_call(
-            [processorId, aResp](const boost::system::error_code ec,
-                                 const std::vector<std::string>& subTreePaths) {
+        constexpr std::array<std::string_view, 1> interfaces = {
+            "xyz.openbmc_project.Inventory.Item.CpuCore"};
+        dbus::utility::getSubTreePaths(
+            cpuPath, 0, interfaces,
+            [processorId, aResp](
+                const boost::system::error_code& ec,
+                const dbus::utility::MapperGetSubTreePathsResponse&
+                    subTreePaths) {
             if (ec)
             {
                 BMCWEB_LOG_ERROR << "DBUS response error";
@@ -1277,12 +1324,7 @@ inline void
                                            .filename()}});
             }
             aResp->res.jsonValue["Members@odata.count"] = members.size();
-        },
-            "xyz.openbmc_project.ObjectMapper",
-            "/xyz/openbmc_project/object_mapper",
-            "xyz.openbmc_project.ObjectMapper", "GetSubTreePaths", cpuPath, 0,
-            std::array<const char*, 1>{
-                "xyz.openbmc_project.Inventory.Item.CpuCore"});
+        });
     };
 
     getProcessorPaths(aResp, processorId, std::move(callback));
@@ -1301,17 +1343,26 @@ inline void
                            const std::string& service,
                            const std::string& objPath)
 {
-    sdbusplus::asio::getAllProperties(
-        *crow::connections::systemBus, service, objPath,
-        "xyz.openbmc_project.Inventory.Item.Cpu.OperatingConfig",
-        [aResp](const boost::system::error_code ec,
-                const dbus::utility::DBusPropertiesMap& properties) {
+    processor_utils::ProcessorModelCache::getInstance().get(
+        service,
+        [aResp, objPath](
+            const boost::system::error_code& ec,
+            const std::shared_ptr<const processor_utils::ProcessorModel>&
+                model) {
         if (ec)
         {
             BMCWEB_LOG_WARNING << "D-Bus error: " << ec << ", " << ec.message();
             messages::internalError(aResp->res);
             return;
         }
+        const dbus::utility::DBusPropertiesMap* properties = model->find(
+            objPath, "xyz.openbmc_project.Inventory.Item.Cpu.OperatingConfig");
+        if (properties == nullptr)
+        {
+            BMCWEB_LOG_WARNING << "No OperatingConfig on " << objPath;
+            messages::internalError(aResp->res);
+            return;
+        }
 
         const size_t* availableCoreCount = nullptr;
         const uint32_t* baseSpeed = nullptr;
@@ -1323,7 +1374,7 @@ inline void
             nullptr;
 
         const bool success = sdbusplus::unpackPropertiesNoThrow(
-            dbus_utils::UnpackErrorPrinter(), properties, "AvailableCoreCount",
+            dbus_utils::UnpackErrorPrinter(), *properties, "AvailableCoreCount",
             availableCoreCount, "BaseSpeed", baseSpeed,
             "MaxJunctionTemperature", maxJunctionTemperature, "MaxSpeed",
             maxSpeed, "PowerLimit", powerLimit, "TurboProfile", turboProfile,
@@ -1521,27 +1572,44 @@ inline void patchAppliedOperatingConfig(
 
 inline void handleProcessorHead(crow::App& app, const crow::Request& req,
                                 const std::shared_ptr<bmcweb::AsyncResp>& aResp,
-                                const std::string& /* systemName */,
-                                const std::string& /* processorId */)
+                                const std::string& systemName,
+                                const std::string& processorId)
 {
     if (!redfish::setUpRedfishRoute(app, req, aResp))
     {
         return;
     }
-    aResp->res.addHeader(
-        boost::beast::http::field::link,
-        "</redfish/v1/JsonSchemas/Processor/Processor.json>; rel=describedby");
+    if (systemName != "system")
+    {
+        messages::resourceNotFound(aResp->res, "ComputerSystem", systemName);
+        return;
+    }
+    // HEAD only needs to know the processor exists, which the cached subtree
+    // answers without reading any of its properties
+    getProcessorObject(
+        aResp, processorId,
+        [aResp](const std::string& /*objectPath*/,
+                const dbus::utility::MapperServiceMap& /*serviceMap*/) {
+        aResp->res.addHeader(
+            boost::beast::http::field::link,
+            "</redfish/v1/JsonSchemas/Processor/Processor.json>; rel=describedby");
+    });
 }
 
 inline void handleProcessorCollectionHead(
     crow::App& app, const crow::Request& req,
     const std::shared_ptr<bmcweb::AsyncResp>& aResp,
-    const std::string& /* systemName */)
+    const std::string& systemName)
 {
     if (!redfish::setUpRedfishRoute(app, req, aResp))
     {
         return;
     }
+    if (systemName != "system")
+    {
+        messages::resourceNotFound(aResp->res, "ComputerSystem", systemName);
+        return;
+    }
     aResp->res.addHeader(
         boost::beast::http::field::link,
         "</redfish/v1/JsonSchemas/ProcessorCollection/ProcessorCollection.json>; rel=describedby");
@@ -1670,9 +1738,12 @@ inline void requestRoutesOperatingConfigCollection(App& app)
 
         // First find the matching CPU object so we know how to
         // constrain our search for related Config objects.
-        crow::connections::systemBus->async_method_call(
+        constexpr std::array<std::string_view, 1> cpuInterfaces = {
+            "xyz.openbmc_project.Control.Processor.CurrentOperatingConfig"};
+        dbus::utility::getSubTreePaths(
+            "/xyz/openbmc_project/inventory", 0, cpuInterfaces,
             [asyncResp, cpuName](
-                const boost::system::error_code ec,
+                const boost::system::error_code& ec,
                 const dbus::utility::MapperGetSubTreePathsResponse& objects) {
             if (ec)
             {
@@ -1706,13 +1777,7 @@ inline void requestRoutesOperatingConfigCollection(App& app)
                     interface, object.c_str());
                 return;
             }
-        },
-            "xyz.openbmc_project.ObjectMapper",
-            "/xyz/openbmc_project/object_mapper",
-            "xyz.openbmc_project.ObjectMapper", "GetSubTreePaths",
-            "/xyz/openbmc_project/inventory", 0,
-            std::array<const char*, 1>{
-                "xyz.openbmc_project.Control.Processor.CurrentOperatingConfig"});
+        });
     });
 }
 
@@ -1732,9 +1797,12 @@ inline void requestRoutesOperatingConfig(App& app)
         }
         // Ask for all objects implementing OperatingConfig so we can search
         // for one with a matching name
-        crow::connections::systemBus->async_method_call(
+        constexpr std::array<std::string_view, 1> interfaces = {
+            "xyz.openbmc_project.Inventory.Item.Cpu.OperatingConfig"};
+        dbus::utility::getSubTree(
+            "/xyz/openbmc_project/inventory", 0, interfaces,
             [asyncResp, cpuName, configName, reqUrl{req.url}](
-                boost::system::error_code ec,
+                const boost::system::error_code& ec,
                 const dbus::utility::MapperGetSubTreeResponse& subtree) {
             if (ec)
             {
@@ -1780,13 +1848,7 @@ inline void requestRoutesOperatingConfig(App& app)
             }
             messages::resourceNotFound(asyncResp->res, "OperatingConfig",
                                        configName);
-        },
-            "xyz.openbmc_project.ObjectMapper",
-            "/xyz/openbmc_project/object_mapper",
-            "xyz.openbmc_project.ObjectMapper", "GetSubTree",
-            "/xyz/openbmc_project/inventory", 0,
-            std::array<const char*, 1>{
-                "xyz.openbmc_project.Inventory.Item.Cpu.OperatingConfig"});
+        });
     });
 }
 
@@ -1904,7 +1966,12 @@ inline void requestRoutesProcessor(App& app)
                    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
                    const std::string& systemName,
                    const std::string& processorId) {
-        if (!redfish::setUpRedfishRoute(app, req, asyncResp))
+        query_param::QueryCapabilities capabilities = {
+            .canPruneBySelect = true,
+        };
+        query_param::Query delegatedQuery;
+        if (!redfish::setUpRedfishRouteWithDelegation(
+                app, req, asyncResp, delegatedQuery, capabilities))
         {
             return;
         }
@@ -1929,7 +1996,8 @@ inline void requestRoutesProcessor(App& app)
 
         getProcessorObject(
             asyncResp, processorId,
-            std::bind_front(getProcessorData, asyncResp, processorId));
+            std::bind_front(getProcessorData, asyncResp, processorId,
+                            std::move(delegatedQuery.selectTrie)));
     });
 
     BMCWEB_ROUTE(app, "/redfish/v1/Systems/<str>/Processors/<str>/")
@@ -175,40 +175,12 @@ inline void handleSessionCollectionMembersGet(
     asyncResp->res.jsonValue = getSessionCollectionMembers();
 }
 
-inline void handleSessionCollectionPost(
-    crow::App& app, const crow::Request& req,
-    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
+inline void afterSessionAuthenticate(
+    const crow::Request& req,
+    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+    const std::string& username, std::optional<std::string> clientId,
+    int pamrc)
 {
-    if (!redfish::setUpRedfishRoute(app, req, asyncResp))
-    {
-        return;
-    }
-    std::string username;
-    std::string password;
-    std::optional<std::string> clientId;
-    if (!json_util::readJsonPatch(req, asyncResp->res, "UserName", username,
-                                  "Password", password, "Context", clientId))
-    {
-        return;
-    }
-
-    if (password.empty() || username.empty() ||
-        asyncResp->res.result() != boost::beast::http::status::ok)
-    {
-        if (username.empty())
-        {
-            messages::propertyMissing(asyncResp->res, "UserName");
-        }
-
-        if (password.empty())
-        {
-            messages::propertyMissing(asyncResp->res, "Password");
-        }
-
-        return;
-    }
-
-    int pamrc = pamAuthenticateUser(username, password);
     bool isConfigureSelfOnly = pamrc == PAM_NEW_AUTHTOK_REQD;
     if ((pamrc != PAM_SUCCESS) && !isConfigureSelfOnly)
     {
@@ -250,6 +222,48 @@ inline void handleSessionCollectionPost(
 
     fillSessionObject(asyncResp->res, *session);
 }
+
+inline void handleSessionCollectionPost(
+    crow::App& app, const crow::Request& req,
+    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
+{
+    if (!redfish::setUpRedfishRoute(app, req, asyncResp))
+    {
+        return;
+    }
+    std::string username;
+    std::string password;
+    std::optional<std::string> clientId;
+    if (!json_util::readJsonPatch(req, asyncResp->res, "UserName", username,
+                                  "Password", password, "Context", clientId))
+    {
+        return;
+    }
+
+    if (password.empty() || username.empty() ||
+        asyncResp->res.result() != boost::beast::http::status::ok)
+    {
+        if (username.empty())
+        {
+            messages::propertyMissing(asyncResp->res, "UserName");
+        }
+
+        if (password.empty())
+        {
+            messages::propertyMissing(asyncResp->res, "Password");
+        }
+
+        return;
+    }
+
+    pamAuthenticateUserAsync(
+        req.ioService->get_executor(), username, std::move(password),
+        [req, asyncResp, username,
+         clientId{std::move(clientId)}](int pamrc) mutable {
+        afterSessionAuthenticate(req, asyncResp, username, std::move(clientId),
+                                 pamrc);
+    });
+}
 inline void handleSessionServiceHead(
     crow::App& app, const crow::Request& req,
     const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
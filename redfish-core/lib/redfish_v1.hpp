@@ -76,6 +76,7 @@ inline void
     {
         return;
     }
+    asyncResp->res.setEncodedBodyCacheable();
     nlohmann::json& json = asyncResp->res.jsonValue;
     json["@odata.id"] = "/redfish/v1/JsonSchemas";
     json["@odata.context"] =
@@ -0,0 +1,197 @@
+#pragma once
+
+#include "app.hpp"
+#include "dbus_utility.hpp"
+#include "error_messages.hpp"
+#include "generated/enums/sensor.hpp"
+#include "registries/privilege_registry.hpp"
+#include "sensor_reading_cache.hpp"
+#include "sensor_readings_filter.hpp"
+#include "sensors.hpp"
+#include "utils/chassis_graph.hpp"
+#include "utils/enum_table.hpp"
+#include "utils/time_utils.hpp"
+
+#include <boost/beast/http/field.hpp>
+#include <boost/beast/http/status.hpp>
+#include <boost/beast/http/verb.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace redfish
+{
+
+constexpr std::string_view sensorReadingsUri =
+    "/redfish/v1/TelemetryService/Oem/OpenBMC/SensorReadings";
+
+// Builds the readings once every sensor service has been read
+inline void afterGetSensorReadingsGraph(
+    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+    const SensorReadingsFilter& filter, std::optional<uint64_t> modifiedSince,
+    const chassis_utils::ChassisGraph& graph)
+{
+    const dbus::utility::SensorReadingCache& cache =
+        dbus::utility::SensorReadingCache::getInstance();
+
+    nlohmann::json::array_t readings;
+    uint64_t lastModified = 0;
+    for (const chassis_utils::ChassisNode& chassis : graph.nodes())
+    {
+        if (!chassis.sensors)
+        {
+            continue;
+        }
+        for (const std::string& sensorPath : *chassis.sensors)
+        {
+            // Only sensors that have a Sensor resource
+            if (std::ranges::none_of(sensors::dbus::sensorPaths,
+                                     [&sensorPath](std::string_view type) {
+                    return sensorPath.starts_with(type);
+                }))
+            {
+                continue;
+            }
+            sdbusplus::message::object_path path(sensorPath);
+            std::string sensorType = path.parent_path().filename();
+            std::string_view readingType =
+                enum_utils::toString(sensors::toReadingType(sensorType));
+            if (!filter.matches(chassis.id, readingType))
+            {
+                continue;
+            }
+            const dbus::utility::SensorReadingCache::Reading* reading =
+                cache.findReading(sensorPath);
+            if (reading == nullptr)
+            {
+                continue;
+            }
+
+            uint64_t updatedMs = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    reading->updated.time_since_epoch())
+                    .count());
+            uint64_t updated = updatedMs / 1000;
+            lastModified = std::max(lastModified, updated);
+            if (modifiedSince && updated < *modifiedSince)
+            {
+                continue;
+            }
+
+            nlohmann::json::object_t entry;
+            entry["Id"] = sensors::getSensorId(path.filename(), sensorType);
+            entry["Chassis"] = chassis.id;
+            entry["Reading"] = reading->value;
+            entry["Timestamp"] = time_utils::getDateTimeUintMs(updatedMs);
+            readings.emplace_back(std::move(entry));
+        }
+    }
+
+    if (lastModified != 0)
+    {
+        asyncResp->res.addHeader(boost::beast::http::field::last_modified,
+                                 time_utils::getHttpDate(lastModified));
+    }
+    if (modifiedSince && readings.empty())
+    {
+        asyncResp->res.result(boost::beast::http::status::not_modified);
+        return;
+    }
+
+    asyncResp->res.jsonValue["@odata.id"] = sensorReadingsUri;
+    asyncResp->res.jsonValue["@odata.type"] =
+        "#OemSensorReadings.v1_0_0.SensorReadings";
+    asyncResp->res.jsonValue["Id"] = "SensorReadings";
+    asyncResp->res.jsonValue["Name"] = "Sensor Readings";
+    asyncResp->res.jsonValue["Readings@odata.count"] = readings.size();
+    asyncResp->res.jsonValue["Readings"] = std::move(readings);
+}
+
+/**
+ * @brief Lists the reading of every sensor in the chassis Sensors
+ * collections, or those $filter selects, as one compact array.
+ *
+ * With If-Modified-Since only the readings updated in or after that second
+ * are listed, so a poller passing back the Last-Modified it was given gets
+ * what changed since, and 304 if nothing did.  A reading updated in the same
+ * second as Last-Modified is listed again rather than missed.
+ */
+inline void
+    handleSensorReadingsGet(const crow::Request& req,
+                            const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
+{
+    asyncResp->res.addHeader("OData-Version", "4.0");
+
+    // $filter isn't one of the query parameters setUpRedfishRoute knows of,
+    // so they're all handled here
+    SensorReadingsFilter filter;
+    for (const boost::urls::params_view::value_type& param :
+         req.urlView.params())
+    {
+        if (param.key == "$filter")
+        {
+            std::optional<SensorReadingsFilter> parsed =
+                parseSensorReadingsFilter(param.value);
+            if (!parsed)
+            {
+                messages::queryParameterValueFormatError(
+                    asyncResp->res, param.value, param.key);
+                return;
+            }
+            filter = std::move(*parsed);
+        }
+        else if (param.key.starts_with("$"))
+        {
+            messages::queryParameterValueFormatError(asyncResp->res,
+                                                     param.value, param.key);
+            asyncResp->res.result(boost::beast::http::status::not_implemented);
+            return;
+        }
+    }
+
+    // A date that can't be read is ignored, as HTTP requires
+    std::optional<uint64_t> modifiedSince =
+        time_utils::fromHttpDate(req.getHeaderValue("If-Modified-Since"));
+
+    dbus::utility::SensorReadingCache::getInstance().readAllServices(
+        [asyncResp, filter{std::move(filter)},
+         modifiedSince](const boost::system::error_code& ec) {
+        if (ec)
+        {
+            BMCWEB_LOG_ERROR << "Sensor readings subtree failed " << ec;
+            messages::internalError(asyncResp->res);
+            return;
+        }
+        chassis_utils::ChassisGraphCache::getInstance().get(
+            [asyncResp, filter, modifiedSince](
+                const boost::system::error_code& ec2,
+                const std::shared_ptr<const chassis_utils::ChassisGraph>&
+                    graph) {
+            if (ec2 || graph == nullptr)
+            {
+                BMCWEB_LOG_ERROR << "Sensor readings chassis error " << ec2;
+                messages::internalError(asyncResp->res);
+                return;
+            }
+            afterGetSensorReadingsGraph(asyncResp, filter, modifiedSince,
+                                        *graph);
+        });
+    });
+}
+
+inline void requestRoutesSensorReadings(App& app)
+{
+    BMCWEB_ROUTE(app, "/redfish/v1/TelemetryService/Oem/OpenBMC/"
+                      "SensorReadings/")
+        .privileges(redfish::privileges::getSensorCollection)
+        .methods(boost::beast::http::verb::get)(handleSensorReadingsGet);
+}
+
+} // namespace redfish
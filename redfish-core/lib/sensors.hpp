@@ -30,14 +30,20 @@
 #include <registries/privilege_registry.hpp>
 #include <sdbusplus/asio/property.hpp>
 #include <sdbusplus/unpack_properties.hpp>
+#include <sensor_association_cache.hpp>
+#include <sensor_reading_cache.hpp>
+#include <utils/chassis_graph.hpp>
 #include <utils/dbus_utils.hpp>
+#include <utils/enum_table.hpp>
 #include <utils/json_utils.hpp>
 #include <utils/query_param.hpp>
 
+#include <chrono>
 #include <cmath>
 #include <iterator>
 #include <map>
 #include <set>
+#include <unordered_map>
 #include <utility>
 #include <variant>
 
@@ -92,49 +98,23 @@ static constexpr std::array<sensorPair, 3> paths = {
      {node::sensors, std::span<std::string_view>(dbus::sensorPaths)},
      {node::thermal, std::span<std::string_view>(dbus::thermalPaths)}}};
 
+// Sensor types, as named in D-Bus sensor paths, and their ReadingType
+constexpr auto readingTypes = enum_utils::makeStringMap<sensor::ReadingType>(
+    {{"voltage", sensor::ReadingType::Voltage},
+     {"power", sensor::ReadingType::Power},
+     {"current", sensor::ReadingType::Current},
+     {"fan_tach", sensor::ReadingType::Rotational},
+     {"temperature", sensor::ReadingType::Temperature},
+     {"fan_pwm", sensor::ReadingType::Percent},
+     {"utilization", sensor::ReadingType::Percent},
+     {"humidity", sensor::ReadingType::Humidity},
+     {"altitude", sensor::ReadingType::Altitude},
+     {"airflow", sensor::ReadingType::AirFlow},
+     {"energy", sensor::ReadingType::EnergyJoules}});
+
 inline sensor::ReadingType toReadingType(std::string_view sensorType)
 {
-    if (sensorType == "voltage")
-    {
-        return sensor::ReadingType::Voltage;
-    }
-    if (sensorType == "power")
-    {
-        return sensor::ReadingType::Power;
-    }
-    if (sensorType == "current")
-    {
-        return sensor::ReadingType::Current;
-    }
-    if (sensorType == "fan_tach")
-    {
-        return sensor::ReadingType::Rotational;
-    }
-    if (sensorType == "temperature")
-    {
-        return sensor::ReadingType::Temperature;
-    }
-    if (sensorType == "fan_pwm" || sensorType == "utilization")
-    {
-        return sensor::ReadingType::Percent;
-    }
-    if (sensorType == "humidity")
-    {
-        return sensor::ReadingType::Humidity;
-    }
-    if (sensorType == "altitude")
-    {
-        return sensor::ReadingType::Altitude;
-    }
-    if (sensorType == "airflow")
-    {
-        return sensor::ReadingType::AirFlow;
-    }
-    if (sensorType == "energy")
-    {
-        return sensor::ReadingType::EnergyJoules;
-    }
-    return sensor::ReadingType::Invalid;
+    return readingTypes.get(sensorType, sensor::ReadingType::Invalid);
 }
 
 inline std::string_view toReadingUnits(std::string_view sensorType)
@@ -178,6 +158,22 @@ inline std::string_view toReadingUnits(std::string_view sensorType)
     }
     return "";
 }
+
+// Sensor resources are polled by dashboards and collectors on the same
+// interval, so identical GETs that arrive together share one response
+constexpr std::chrono::milliseconds pollCacheTtl{500};
+
+// The Id of a Sensor resource: its type, without underscores, then its name
+inline std::string getSensorId(std::string_view sensorName,
+                               std::string_view sensorType)
+{
+    std::string sensorId(sensorType);
+    sensorId.erase(std::remove(sensorId.begin(), sensorId.end(), '_'),
+                   sensorId.end());
+    sensorId += '_';
+    sensorId += sensorName;
+    return sensorId;
+}
 } // namespace sensors
 
 /**
@@ -515,14 +511,13 @@ void getChassis(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
                 std::span<std::string_view> sensorTypes, Callback&& callback)
 {
     BMCWEB_LOG_DEBUG << "getChassis enter";
-    const std::array<const char*, 1> interfaces = {
-        "xyz.openbmc_project.Inventory.Item.Chassis"};
-    auto respHandler =
+    chassis_utils::ChassisGraphCache::getInstance().get(
         [callback{std::forward<Callback>(callback)}, asyncResp,
          chassisIdStr{std::string(chassisId)},
-         chassisSubNode{std::string(chassisSubNode)}, sensorTypes](
-            const boost::system::error_code ec,
-            const dbus::utility::MapperGetSubTreePathsResponse& chassisPaths) {
+         chassisSubNode{std::string(chassisSubNode)},
+         sensorTypes](const boost::system::error_code& ec,
+                      const std::shared_ptr<const chassis_utils::ChassisGraph>&
+                          graph) {
         BMCWEB_LOG_DEBUG << "getChassis respHandler enter";
         if (ec)
         {
@@ -530,24 +525,8 @@ void getChassis(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
             messages::internalError(asyncResp->res);
             return;
         }
-        const std::string* chassisPath = nullptr;
-        std::string chassisName;
-        for (const std::string& chassis : chassisPaths)
-        {
-            sdbusplus::message::object_path path(chassis);
-            chassisName = path.filename();
-            if (chassisName.empty())
-            {
-                BMCWEB_LOG_ERROR << "Failed to find '/' in " << chassis;
-                continue;
-            }
-            if (chassisName == chassisIdStr)
-            {
-                chassisPath = &chassis;
-                break;
-            }
-        }
-        if (chassisPath == nullptr)
+        const chassis_utils::ChassisNode* chassis = graph->find(chassisIdStr);
+        if (chassis == nullptr)
         {
             messages::resourceNotFound(asyncResp->res, "Chassis", chassisIdStr);
             return;
@@ -557,38 +536,18 @@ void getChassis(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
         asyncResp->res.jsonValue["@odata.id"] =
             "/redfish/v1/Chassis/" + chassisIdStr + "/" + chassisSubNode;
 
-        // Get the list of all sensors for this Chassis element
-        std::string sensorPath = *chassisPath + "/all_sensors";
-        sdbusplus::asio::getProperty<std::vector<std::string>>(
-            *crow::connections::systemBus, "xyz.openbmc_project.ObjectMapper",
-            sensorPath, "xyz.openbmc_project.Association", "endpoints",
-            [asyncResp, chassisSubNode, sensorTypes,
-             callback{std::forward<const Callback>(callback)}](
-                const boost::system::error_code& e,
-                const std::vector<std::string>& nodeSensorList) {
-            if (e)
-            {
-                if (e.value() != EBADR)
-                {
-                    messages::internalError(asyncResp->res);
-                    return;
-                }
-            }
-            const std::shared_ptr<std::set<std::string>> culledSensorList =
-                std::make_shared<std::set<std::string>>();
-            reduceSensorList(asyncResp->res, chassisSubNode, sensorTypes,
-                             &nodeSensorList, culledSensorList);
-            BMCWEB_LOG_DEBUG << "Finishing with " << culledSensorList->size();
-            callback(culledSensorList);
-        });
-    };
-
-    // Get the Chassis Collection
-    crow::connections::systemBus->async_method_call(
-        respHandler, "xyz.openbmc_project.ObjectMapper",
-        "/xyz/openbmc_project/object_mapper",
-        "xyz.openbmc_project.ObjectMapper", "GetSubTreePaths",
-        "/xyz/openbmc_project/inventory", 0, interfaces);
+        // The list of all sensors for this Chassis element; a chassis
+        // without the association has none
+        const std::vector<std::string> noSensors;
+        const std::vector<std::string>& nodeSensorList =
+            chassis->sensors ? *chassis->sensors : noSensors;
+        const std::shared_ptr<std::set<std::string>> culledSensorList =
+            std::make_shared<std::set<std::string>>();
+        reduceSensorList(asyncResp->res, chassisSubNode, sensorTypes,
+                         &nodeSensorList, culledSensorList);
+        BMCWEB_LOG_DEBUG << "Finishing with " << culledSensorList->size();
+        callback(culledSensorList);
+    });
     BMCWEB_LOG_DEBUG << "getChassis exit";
 }
 
@@ -733,16 +692,9 @@ inline void objectPropertiesToJson(
 {
     if (chassisSubNode == sensors::node::sensors)
     {
-        std::string subNodeEscaped(sensorType);
-        subNodeEscaped.erase(
-            std::remove(subNodeEscaped.begin(), subNodeEscaped.end(), '_'),
-            subNodeEscaped.end());
-
         // For sensors in SensorCollection we set Id instead of MemberId,
         // including power sensors.
-        subNodeEscaped += '_';
-        subNodeEscaped += sensorName;
-        sensorJson["Id"] = std::move(subNodeEscaped);
+        sensorJson["Id"] = sensors::getSensorId(sensorName, sensorType);
 
         std::string sensorNameEs(sensorName);
         std::replace(sensorNameEs.begin(), sensorNameEs.end(), '_', ' ');
@@ -1213,23 +1165,22 @@ inline InventoryItem* findInventoryItem(
 }
 
 /**
- * @brief Finds the inventory item associated with the specified sensor.
+ * @brief Indexes inventory items by the sensors associated with them.
  * @param inventoryItems D-Bus inventory items associated with sensors.
- * @param sensorObjPath D-Bus object path of sensor.
- * @return Inventory item within vector, or nullptr if no match found.
+ * @return Map from sensor object path to its inventory item within vector.
  */
-inline InventoryItem* findInventoryItemForSensor(
-    const std::shared_ptr<std::vector<InventoryItem>>& inventoryItems,
-    const std::string& sensorObjPath)
+inline std::unordered_map<std::string, InventoryItem*>
+    indexInventoryItemsBySensor(std::vector<InventoryItem>& inventoryItems)
 {
-    for (InventoryItem& inventoryItem : *inventoryItems)
+    std::unordered_map<std::string, InventoryItem*> index;
+    for (InventoryItem& inventoryItem : inventoryItems)
     {
-        if (inventoryItem.sensors.count(sensorObjPath) > 0)
+        for (const std::string& sensor : inventoryItem.sensors)
         {
-            return &inventoryItem;
+            index.try_emplace(sensor, &inventoryItem);
         }
     }
-    return nullptr;
+    return index;
 }
 
 /**
@@ -1252,39 +1203,6 @@ inline InventoryItem*
     return nullptr;
 }
 
-/**
- * @brief Adds inventory item and associated sensor to specified vector.
- *
- * Adds a new InventoryItem to the vector if necessary.  Searches for an
- * existing InventoryItem with the specified object path.  If not found, one is
- * added to the vector.
- *
- * Next, the specified sensor is added to the set of sensors associated with the
- * InventoryItem.
- *
- * @param inventoryItems D-Bus inventory items associated with sensors.
- * @param invItemObjPath D-Bus object path of inventory item.
- * @param sensorObjPath D-Bus object path of sensor
- */
-inline void addInventoryItem(
-    const std::shared_ptr<std::vector<InventoryItem>>& inventoryItems,
-    const std::string& invItemObjPath, const std::string& sensorObjPath)
-{
-    // Look for inventory item in vector
-    InventoryItem* inventoryItem = findInventoryItem(inventoryItems,
-                                                     invItemObjPath);
-
-    // If inventory item doesn't exist in vector, add it
-    if (inventoryItem == nullptr)
-    {
-        inventoryItems->emplace_back(invItemObjPath);
-        inventoryItem = &(inventoryItems->back());
-    }
-
-    // Add sensor to set of sensors associated with inventory item
-    inventoryItem->sensors.emplace(sensorObjPath);
-}
-
 /**
  * @brief Stores D-Bus data in the specified inventory item.
  *
@@ -1604,11 +1522,13 @@ static void getInventoryItemAssociations(
 {
     BMCWEB_LOG_DEBUG << "getInventoryItemAssociations enter";
 
-    // Response handler for GetManagedObjects
+    // Response handler for the association graph
     auto respHandler =
         [callback{std::forward<Callback>(callback)}, sensorsAsyncResp,
-         sensorNames](const boost::system::error_code ec,
-                      const dbus::utility::ManagedObjectType& resp) {
+         sensorNames](
+            const boost::system::error_code& ec,
+            const std::shared_ptr<const dbus::utility::SensorAssociationGraph>&
+                graph) {
         BMCWEB_LOG_DEBUG << "getInventoryItemAssociations respHandler enter";
         if (ec)
         {
@@ -1621,105 +1541,46 @@ static void getInventoryItemAssociations(
         // Create vector to hold list of inventory items
         std::shared_ptr<std::vector<InventoryItem>> inventoryItems =
             std::make_shared<std::vector<InventoryItem>>();
+        // Position of each inventory item in the vector, by object path
+        std::unordered_map<std::string, size_t> itemIndex;
 
-        // Loop through returned object paths
-        std::string sensorAssocPath;
-        sensorAssocPath.reserve(128); // avoid memory allocations
-        for (const auto& objDictEntry : resp)
+        // Find the inventory item associated with each sensor
+        for (const std::string& sensorName : *sensorNames)
         {
-            const std::string& objPath =
-                static_cast<const std::string&>(objDictEntry.first);
-
-            // If path is inventory association for one of the specified sensors
-            for (const std::string& sensorName : *sensorNames)
+            const std::string* invItemPath =
+                graph->inventoryForSensor(sensorName);
+            if (invItemPath == nullptr)
             {
-                sensorAssocPath = sensorName;
-                sensorAssocPath += "/inventory";
-                if (objPath == sensorAssocPath)
-                {
-                    // Get Association interface for object path
-                    for (const auto& [interface, values] : objDictEntry.second)
-                    {
-                        if (interface == "xyz.openbmc_project.Association")
-                        {
-                            for (const auto& [valueName, value] : values)
-                            {
-                                if (valueName == "endpoints")
-                                {
-                                    const std::vector<std::string>* endpoints =
-                                        std::get_if<std::vector<std::string>>(
-                                            &value);
-                                    if ((endpoints != nullptr) &&
-                                        !endpoints->empty())
-                                    {
-                                        // Add inventory item to vector
-                                        const std::string& invItemPath =
-                                            endpoints->front();
-                                        addInventoryItem(inventoryItems,
-                                                         invItemPath,
-                                                         sensorName);
-                                    }
-                                }
-                            }
-                        }
-                    }
-                    break;
-                }
+                continue;
+            }
+            auto inserted =
+                itemIndex.try_emplace(*invItemPath, inventoryItems->size());
+            if (inserted.second)
+            {
+                inventoryItems->emplace_back(*invItemPath);
             }
+            (*inventoryItems)[inserted.first->second].sensors.emplace(
+                sensorName);
         }
 
-        // Now loop through the returned object paths again, this time to
-        // find the leds associated with the inventory items we just found
-        std::string inventoryAssocPath;
-        inventoryAssocPath.reserve(128); // avoid memory allocations
-        for (const auto& objDictEntry : resp)
+        // Find the leds associated with the inventory items we just found
+        for (InventoryItem& inventoryItem : *inventoryItems)
         {
-            const std::string& objPath =
-                static_cast<const std::string&>(objDictEntry.first);
-
-            for (InventoryItem& inventoryItem : *inventoryItems)
+            const std::string* ledPath =
+                graph->ledForInventory(inventoryItem.objectPath);
+            if (ledPath != nullptr)
             {
-                inventoryAssocPath = inventoryItem.objectPath;
-                inventoryAssocPath += "/leds";
-                if (objPath == inventoryAssocPath)
-                {
-                    for (const auto& [interface, values] : objDictEntry.second)
-                    {
-                        if (interface == "xyz.openbmc_project.Association")
-                        {
-                            for (const auto& [valueName, value] : values)
-                            {
-                                if (valueName == "endpoints")
-                                {
-                                    const std::vector<std::string>* endpoints =
-                                        std::get_if<std::vector<std::string>>(
-                                            &value);
-                                    if ((endpoints != nullptr) &&
-                                        !endpoints->empty())
-                                    {
-                                        // Add inventory item to vector
-                                        // Store LED path in inventory item
-                                        const std::string& ledPath =
-                                            endpoints->front();
-                                        inventoryItem.ledObjectPath = ledPath;
-                                    }
-                                }
-                            }
-                        }
-                    }
-
-                    break;
-                }
+                inventoryItem.ledObjectPath = *ledPath;
             }
         }
         callback(inventoryItems);
         BMCWEB_LOG_DEBUG << "getInventoryItemAssociations respHandler exit";
     };
 
-    // Call GetManagedObjects on the ObjectMapper to get all associations
-    crow::connections::systemBus->async_method_call(
-        std::move(respHandler), "xyz.openbmc_project.ObjectMapper", "/",
-        "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
+    // The graph is built from the ObjectMapper's associations once and kept
+    // current from its signals
+    dbus::utility::SensorAssociationCache::getInstance().get(
+        std::move(respHandler));
 
     BMCWEB_LOG_DEBUG << "getInventoryItemAssociations exit";
 }
@@ -2284,6 +2145,9 @@ inline void getSensorData(
                 messages::internalError(sensorsAsyncResp->asyncResp->res);
                 return;
             }
+            std::unordered_map<std::string, InventoryItem*> sensorItems =
+                indexInventoryItemsBySensor(*inventoryItems);
+
             // Go through all objects and update response with sensor data
             for (const auto& objDictEntry : resp)
             {
@@ -2316,8 +2180,12 @@ inline void getSensorData(
                 }
 
                 // Find inventory item (if any) associated with sensor
-                InventoryItem* inventoryItem =
-                    findInventoryItemForSensor(inventoryItems, objPath);
+                InventoryItem* inventoryItem = nullptr;
+                auto sensorItem = sensorItems.find(objPath);
+                if (sensorItem != sensorItems.end())
+                {
+                    inventoryItem = sensorItem->second;
+                }
 
                 const std::string& sensorSchema =
                     sensorsAsyncResp->chassisSubNode;
@@ -2327,14 +2195,8 @@ inline void getSensorData(
                 if (sensorSchema == sensors::node::sensors &&
                     !sensorsAsyncResp->efficientExpand)
                 {
-                    std::string sensorTypeEscaped(sensorType);
-                    sensorTypeEscaped.erase(
-                        std::remove(sensorTypeEscaped.begin(),
-                                    sensorTypeEscaped.end(), '_'),
-                        sensorTypeEscaped.end());
-                    std::string sensorId(sensorTypeEscaped);
-                    sensorId += "_";
-                    sensorId += sensorName;
+                    std::string sensorId =
+                        sensors::getSensorId(sensorName, sensorType);
 
                     sensorsAsyncResp->asyncResp->res.jsonValue["@odata.id"] =
                         crow::utility::urlFromPieces(
@@ -2417,18 +2279,12 @@ inline void getSensorData(
                     }
                     else if (fieldName == "Members")
                     {
-                        std::string sensorTypeEscaped(sensorType);
-                        sensorTypeEscaped.erase(
-                            std::remove(sensorTypeEscaped.begin(),
-                                        sensorTypeEscaped.end(), '_'),
-                            sensorTypeEscaped.end());
-                        std::string sensorId(sensorTypeEscaped);
-                        sensorId += "_";
-                        sensorId += sensorName;
+                        std::string sensorId =
+                            sensors::getSensorId(sensorName, sensorType);
 
                         nlohmann::json::object_t member;
-                        member["@odata.id"] = crow::utility::urlFromPieces(
-                            "redfish", "v1", "Chassis",
+                        member["@odata.id"] = crow::utility::urlPath<
+                            "/redfish/v1/Chassis/{}/{}/{}">(
                             sensorsAsyncResp->chassisId,
                             sensorsAsyncResp->chassisSubNode, sensorId);
                         tempArray.push_back(std::move(member));
@@ -2482,9 +2338,10 @@ inline void getSensorData(
             BMCWEB_LOG_DEBUG << "getManagedObjectsCb exit";
         };
 
-        crow::connections::systemBus->async_method_call(
-            getManagedObjectsCb, connection, "/xyz/openbmc_project/sensors",
-            "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
+        // Served from the signal-driven copy once the connection has been
+        // read, so repeated sensor GETs don't go back to the service
+        dbus::utility::SensorReadingCache::getInstance().getManagedObjects(
+            connection, std::move(getManagedObjectsCb));
     }
     BMCWEB_LOG_DEBUG << "getSensorData exit";
 }
@@ -2807,8 +2664,9 @@ inline void getChassisCallback(
         std::string id = type;
         id += "_";
         id += sensorName;
-        member["@odata.id"] = crow::utility::urlFromPieces(
-            "redfish", "v1", "Chassis", chassisId, chassisSubNode, id);
+        member["@odata.id"] =
+            crow::utility::urlPath<"/redfish/v1/Chassis/{}/{}/{}">(
+                chassisId, chassisSubNode, id);
 
         entriesArray.push_back(std::move(member));
     }
@@ -2817,13 +2675,131 @@ inline void getChassisCallback(
     BMCWEB_LOG_DEBUG << "getChassisCallback exit";
 }
 
+/**
+ * @brief The properties of the sensor at sensorPath that a $filter can be
+ * checked against without reading its whole Sensor resource: Id, Name,
+ * ReadingType and, from the reading cache, Reading.
+ */
+inline nlohmann::json getSensorFilterView(const std::string& sensorPath)
+{
+    sdbusplus::message::object_path path(sensorPath);
+    std::string sensorName = path.filename();
+    std::string sensorType = path.parent_path().filename();
+
+    nlohmann::json view = nlohmann::json::object();
+    view["Id"] = getSensorId(sensorName, sensorType);
+    std::replace(sensorName.begin(), sensorName.end(), '_', ' ');
+    view["Name"] = std::move(sensorName);
+    sensor::ReadingType readingType = toReadingType(sensorType);
+    if (readingType != sensor::ReadingType::Invalid)
+    {
+        view["ReadingType"] = readingType;
+    }
+    const ::dbus::utility::SensorReadingCache::Reading* reading =
+        ::dbus::utility::SensorReadingCache::getInstance().findReading(
+            sensorPath);
+    if (reading != nullptr && std::isfinite(reading->value))
+    {
+        view["Reading"] = reading->value;
+    }
+    return view;
+}
+
+// Leaves the sensors that match filter by their filter view
+inline void filterSensorsByView(
+    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+    std::string_view chassisId, const query_param::Filter& filter,
+    const std::shared_ptr<std::set<std::string>>& sensorNames)
+{
+    std::erase_if(*sensorNames, [&filter](const std::string& sensorPath) {
+        return !filter.matches(getSensorFilterView(sensorPath));
+    });
+    getChassisCallback(asyncResp, chassisId, node::sensors, sensorNames);
+}
+
+/**
+ * @brief Lists the sensors of the chassis that match filter.
+ *
+ * A filter on Id, Name, ReadingType and Reading alone is checked against the
+ * sensor paths and the reading cache, so no Sensor resource is built.  Any
+ * other filter needs the resources, which are built the way an expand would,
+ * then cut down to the links of those that match.
+ */
+inline void
+    getFilteredSensorCollection(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
+                                const std::string& chassisId,
+                                query_param::Filter&& filter)
+{
+    if (!filter.usesOnly({"Id", "Name", "ReadingType", "Reading"}))
+    {
+        crow::Response::CompletionHandler handler =
+            aResp->res.releaseCompleteRequestHandler();
+        aResp->res.setCompleteRequestHandler(
+            [handler(std::move(handler)),
+             filter{std::move(filter)}](crow::Response& res) mutable {
+            nlohmann::json::array_t* members =
+                res.jsonValue["Members"].get_ptr<nlohmann::json::array_t*>();
+            if (res.result() == boost::beast::http::status::ok &&
+                members != nullptr)
+            {
+                nlohmann::json::array_t links;
+                for (const nlohmann::json& member : *members)
+                {
+                    if (filter.matches(member))
+                    {
+                        nlohmann::json::object_t link;
+                        link["@odata.id"] = member["@odata.id"];
+                        links.emplace_back(std::move(link));
+                    }
+                }
+                res.jsonValue["Members@odata.count"] = links.size();
+                *members = std::move(links);
+            }
+            handler(res);
+        });
+        auto asyncResp = std::make_shared<SensorsAsyncResp>(
+            aResp, chassisId, dbus::sensorPaths, node::sensors,
+            /*efficientExpand=*/true);
+        getChassisData(asyncResp);
+        return;
+    }
+
+    bool readsReadings = !filter.usesOnly({"Id", "Name", "ReadingType"});
+    auto listMatches = [aResp, chassisId,
+                        filter{std::move(filter)}]() mutable {
+        getChassis(aResp, chassisId, node::sensors, dbus::sensorPaths,
+                   std::bind_front(filterSensorsByView, aResp, chassisId,
+                                   std::move(filter)));
+    };
+    if (!readsReadings)
+    {
+        listMatches();
+        return;
+    }
+    // Readings are only cached once their service has been read
+    ::dbus::utility::SensorReadingCache::getInstance().readAllServices(
+        [aResp, listMatches{std::move(listMatches)}](
+            const boost::system::error_code& ec) mutable {
+        if (ec)
+        {
+            BMCWEB_LOG_ERROR << "Sensor readings subtree failed " << ec;
+            messages::internalError(aResp->res);
+            return;
+        }
+        listMatches();
+    });
+}
+
 inline void
     handleSensorCollectionGet(App& app, const crow::Request& req,
                               const std::shared_ptr<bmcweb::AsyncResp>& aResp,
                               const std::string& chassisId)
 {
+    // Members hold only links, which a $filter can't be checked against, so
+    // the filter is always applied here
     query_param::QueryCapabilities capabilities = {
         .canDelegateExpandLevel = 1,
+        .canDelegateFilter = true,
     };
     query_param::Query delegatedQuery;
     if (!redfish::setUpRedfishRouteWithDelegation(app, req, aResp,
@@ -2832,6 +2808,13 @@ inline void
         return;
     }
 
+    if (delegatedQuery.filter)
+    {
+        getFilteredSensorCollection(aResp, chassisId,
+                                    std::move(*delegatedQuery.filter));
+        return;
+    }
+
     if (delegatedQuery.expandType != query_param::ExpandType::None)
     {
         // we perform efficient expand.
@@ -2945,6 +2928,7 @@ inline void requestRoutesSensorCollection(App& app)
 {
     BMCWEB_ROUTE(app, "/redfish/v1/Chassis/<str>/Sensors/")
         .privileges(redfish::privileges::getSensorCollection)
+        .cacheFor(sensors::pollCacheTtl)
         .methods(boost::beast::http::verb::get)(
             std::bind_front(sensors::handleSensorCollectionGet, std::ref(app)));
 }
@@ -2953,6 +2937,7 @@ inline void requestRoutesSensor(App& app)
 {
     BMCWEB_ROUTE(app, "/redfish/v1/Chassis/<str>/Sensors/<str>/")
         .privileges(redfish::privileges::getSensor)
+        .cacheFor(sensors::pollCacheTtl)
         .methods(boost::beast::http::verb::get)(
             std::bind_front(sensors::handleSensorGet, std::ref(app)));
 }
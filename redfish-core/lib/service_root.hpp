@@ -15,6 +15,7 @@
 */
 #pragma once
 
+#include "dbus_utility.hpp"
 #include "utils/dbus_utils.hpp"
 
 #include <bmcweb_config.h>
@@ -31,6 +32,9 @@
 #include <utils/systemd_utils.hpp>
 #include <utils/time_utils.hpp>
 
+#include <array>
+#include <string_view>
+
 namespace redfish
 {
 
@@ -89,8 +93,11 @@ inline void
 inline void
     handleServiceRootOem(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
 {
-    crow::connections::systemBus->async_method_call(
-        [asyncResp](const boost::system::error_code ec,
+    constexpr std::array<std::string_view, 1> interfaces = {
+        "xyz.openbmc_project.Inventory.Decorator.Asset"};
+    dbus::utility::getSubTree(
+        "/xyz/openbmc_project/inventory", 0, interfaces,
+        [asyncResp](const boost::system::error_code& ec,
                     const dbus::utility::MapperGetSubTreeResponse& subtree) {
         if (ec)
         {
@@ -99,17 +106,9 @@ inline void
             return;
         }
         // Iterate over all retrieved ObjectPaths.
-        for (const auto& object : subtree)
+        for (const auto& [path, connectionNames] : subtree)
         {
-            const std::string& path = object.first;
             BMCWEB_LOG_DEBUG << "Got path: " << path;
-            const std::vector<std::pair<std::string, std::vector<std::string>>>&
-                connectionNames = object.second;
-            if (connectionNames.empty())
-            {
-                continue;
-            }
-
             for (const auto& connection : connectionNames)
             {
                 for (const auto& interfaceName : connection.second)
@@ -117,11 +116,10 @@ inline void
                     if (interfaceName ==
                         "xyz.openbmc_project.Inventory.Item.System")
                     {
-                        sdbusplus::asio::getAllProperties(
-                            *crow::connections::systemBus, connection.first,
-                            path,
+                        dbus::utility::getAllProperties(
+                            connection.first, path,
                             "xyz.openbmc_project.Inventory.Decorator.Asset",
-                            [asyncResp](const boost::system::error_code ec2,
+                            [asyncResp](const boost::system::error_code& ec2,
                                         const dbus::utility::DBusPropertiesMap&
                                             propertiesList) {
                             if (ec2)
@@ -165,14 +163,7 @@ inline void
                 }
             }
         }
-    },
-        "xyz.openbmc_project.ObjectMapper",
-        "/xyz/openbmc_project/object_mapper",
-        "xyz.openbmc_project.ObjectMapper", "GetSubTree",
-        "/xyz/openbmc_project/inventory", int32_t(0),
-        std::array<const char*, 1>{
-            "xyz.openbmc_project.Inventory.Decorator.Asset",
-        });
+    });
 
     std::pair<std::string, std::string> redfishDateTimeOffset =
         redfish::time_utils::getDateTimeOffsetNow();
@@ -201,47 +192,40 @@ inline void
         "</redfish/v1/JsonSchemas/ServiceRoot/ServiceRoot.json>; rel=describedby");
 }
 
-inline void handleServiceRootGetImpl(
-    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
+/**
+ * @brief The parts of the ServiceRoot that are fixed once bmcweb has started:
+ * links, protocol features and the service UUID.  They are built on first use
+ * and copied into each response.
+ */
+inline nlohmann::json makeServiceRootStatic()
 {
-    std::string uuid = persistent_data::getConfig().systemUuid;
-    asyncResp->res.jsonValue["@odata.type"] =
-        "#ServiceRoot.v1_12_0.ServiceRoot";
-    asyncResp->res.jsonValue["@odata.id"] = "/redfish/v1";
-    asyncResp->res.jsonValue["Id"] = "RootService";
-    asyncResp->res.jsonValue["Name"] = "Root Service";
-    asyncResp->res.jsonValue["RedfishVersion"] = "1.17.0";
-    asyncResp->res.jsonValue["Links"]["Sessions"]["@odata.id"] =
+    nlohmann::json root;
+    root["@odata.type"] = "#ServiceRoot.v1_12_0.ServiceRoot";
+    root["@odata.id"] = "/redfish/v1";
+    root["Id"] = "RootService";
+    root["Name"] = "Root Service";
+    root["RedfishVersion"] = "1.17.0";
+    root["Links"]["Sessions"]["@odata.id"] =
         "/redfish/v1/SessionService/Sessions";
-    asyncResp->res.jsonValue["AccountService"]["@odata.id"] =
-        "/redfish/v1/AccountService";
+    root["AccountService"]["@odata.id"] = "/redfish/v1/AccountService";
 #ifdef BMCWEB_ENABLE_REDFISH_AGGREGATION
-    asyncResp->res.jsonValue["AggregationService"]["@odata.id"] =
-        "/redfish/v1/AggregationService";
+    root["AggregationService"]["@odata.id"] = "/redfish/v1/AggregationService";
 #endif
-    asyncResp->res.jsonValue["Chassis"]["@odata.id"] = "/redfish/v1/Chassis";
-    asyncResp->res.jsonValue["JsonSchemas"]["@odata.id"] =
-        "/redfish/v1/JsonSchemas";
-    asyncResp->res.jsonValue["Managers"]["@odata.id"] = "/redfish/v1/Managers";
-    asyncResp->res.jsonValue["SessionService"]["@odata.id"] =
-        "/redfish/v1/SessionService";
-    asyncResp->res.jsonValue["Systems"]["@odata.id"] = "/redfish/v1/Systems";
-    asyncResp->res.jsonValue["Registries"]["@odata.id"] =
-        "/redfish/v1/Registries";
-    asyncResp->res.jsonValue["UpdateService"]["@odata.id"] =
-        "/redfish/v1/UpdateService";
-    asyncResp->res.jsonValue["UUID"] = uuid;
-    asyncResp->res.jsonValue["CertificateService"]["@odata.id"] =
-        "/redfish/v1/CertificateService";
-    asyncResp->res.jsonValue["Tasks"]["@odata.id"] = "/redfish/v1/TaskService";
-    asyncResp->res.jsonValue["EventService"]["@odata.id"] =
-        "/redfish/v1/EventService";
-    asyncResp->res.jsonValue["TelemetryService"]["@odata.id"] =
-        "/redfish/v1/TelemetryService";
-    asyncResp->res.jsonValue["Cables"]["@odata.id"] = "/redfish/v1/Cables";
+    root["Chassis"]["@odata.id"] = "/redfish/v1/Chassis";
+    root["JsonSchemas"]["@odata.id"] = "/redfish/v1/JsonSchemas";
+    root["Managers"]["@odata.id"] = "/redfish/v1/Managers";
+    root["SessionService"]["@odata.id"] = "/redfish/v1/SessionService";
+    root["Systems"]["@odata.id"] = "/redfish/v1/Systems";
+    root["Registries"]["@odata.id"] = "/redfish/v1/Registries";
+    root["UpdateService"]["@odata.id"] = "/redfish/v1/UpdateService";
+    root["UUID"] = persistent_data::getConfig().systemUuid;
+    root["CertificateService"]["@odata.id"] = "/redfish/v1/CertificateService";
+    root["Tasks"]["@odata.id"] = "/redfish/v1/TaskService";
+    root["EventService"]["@odata.id"] = "/redfish/v1/EventService";
+    root["TelemetryService"]["@odata.id"] = "/redfish/v1/TelemetryService";
+    root["Cables"]["@odata.id"] = "/redfish/v1/Cables";
 
-    nlohmann::json& protocolFeatures =
-        asyncResp->res.jsonValue["ProtocolFeaturesSupported"];
+    nlohmann::json& protocolFeatures = root["ProtocolFeaturesSupported"];
     protocolFeatures["ExcerptQuery"] = false;
 
     protocolFeatures["ExpandQuery"]["ExpandAll"] =
@@ -262,10 +246,18 @@ inline void handleServiceRootGetImpl(
     protocolFeatures["DeepOperations"]["DeepPATCH"] = false;
 
 #ifdef BMCWEB_ENABLE_REDFISH_LICENSE
-    asyncResp->res.jsonValue["LicenseService"] = {
-        {"@odata.id", "/redfish/v1/LicenseService"}};
+    root["LicenseService"] = {{"@odata.id", "/redfish/v1/LicenseService"}};
 #endif
+    return root;
 }
+
+inline void handleServiceRootGetImpl(
+    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
+{
+    static const nlohmann::json serviceRoot = makeServiceRootStatic();
+    asyncResp->res.jsonValue.update(serviceRoot);
+}
+
 inline void
     handleServiceRootGet(App& app, const crow::Request& req,
                          const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
@@ -23,10 +23,14 @@
 
 #include <query.hpp>
 #include <registries/privilege_registry.hpp>
-#include <sdbusplus/asio/property.hpp>
 #include <sdbusplus/unpack_properties.hpp>
 #include <utils/dbus_utils.hpp>
-#include <utils/name_utils.hpp>
+#include <utils/storage_inventory_cache.hpp>
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
 
 namespace redfish
 {
@@ -63,307 +67,218 @@ inline void requestRoutesStorageCollection(App& app)
     });
 }
 
-inline void getDrives(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
+inline void getDrives(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+                      const storage_utils::StorageInventory& inventory)
 {
-    crow::connections::systemBus->async_method_call(
-        [asyncResp](
-            const boost::system::error_code ec,
-            const dbus::utility::MapperGetSubTreePathsResponse& driveList) {
-        if (ec)
-        {
-            BMCWEB_LOG_ERROR << "Drive mapper call error";
-            messages::internalError(asyncResp->res);
-            return;
-        }
+    if (inventory.drivesError)
+    {
+        BMCWEB_LOG_ERROR << "Drive mapper call error";
+        messages::internalError(asyncResp->res);
+        return;
+    }
 
-        nlohmann::json& driveArray = asyncResp->res.jsonValue["Drives"];
-        driveArray = nlohmann::json::array();
-        auto& count = asyncResp->res.jsonValue["Drives@odata.count"];
-        count = 0;
+    nlohmann::json& driveArray = asyncResp->res.jsonValue["Drives"];
+    driveArray = nlohmann::json::array();
+    auto& count = asyncResp->res.jsonValue["Drives@odata.count"];
+    count = 0;
 
-        for (const std::string& drive : driveList)
+    for (const storage_utils::StorageObject& drive : inventory.drives)
+    {
+        if (drive.id.empty())
         {
-            sdbusplus::message::object_path object(drive);
-            if (object.filename().empty())
-            {
-                BMCWEB_LOG_ERROR << "Failed to find filename in " << drive;
-                return;
-            }
-
-            nlohmann::json::object_t driveJson;
-            driveJson["@odata.id"] =
-                "/redfish/v1/Systems/system/Storage/1/Drives/" +
-                object.filename();
-            driveArray.push_back(std::move(driveJson));
+            BMCWEB_LOG_ERROR << "Failed to find filename in " << drive.path;
+            return;
         }
 
-        count = driveArray.size();
-    },
-        "xyz.openbmc_project.ObjectMapper",
-        "/xyz/openbmc_project/object_mapper",
-        "xyz.openbmc_project.ObjectMapper", "GetSubTreePaths",
-        "/xyz/openbmc_project/inventory", int32_t(0),
-        std::array<const char*, 1>{"xyz.openbmc_project.Inventory.Item.Drive"});
+        nlohmann::json::object_t driveJson;
+        driveJson["@odata.id"] =
+            "/redfish/v1/Systems/system/Storage/1/Drives/" + drive.id;
+        driveArray.push_back(std::move(driveJson));
+    }
+
+    count = driveArray.size();
 }
 
 inline void
-    getStorageControllers(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
+    assembleAsset(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+                  nlohmann::json& item,
+                  const dbus::utility::DBusPropertiesMap& propertiesList)
 {
-    crow::connections::systemBus->async_method_call(
-        [asyncResp](const boost::system::error_code ec,
-                    const dbus::utility::MapperGetSubTreeResponse& subtree) {
-        if (ec || subtree.empty())
-        {
-            // doesn't have to be there
-            return;
-        }
+    const std::string* partNumber = nullptr;
+    const std::string* serialNumber = nullptr;
+    const std::string* manufacturer = nullptr;
+    const std::string* model = nullptr;
 
-        nlohmann::json& root = asyncResp->res.jsonValue["StorageControllers"];
-        root = nlohmann::json::array();
-        for (const auto& [path, interfaceDict] : subtree)
-        {
-            sdbusplus::message::object_path object(path);
-            std::string id = object.filename();
-            if (id.empty())
-            {
-                BMCWEB_LOG_ERROR << "Failed to find filename in " << path;
-                return;
-            }
+    const bool success = sdbusplus::unpackPropertiesNoThrow(
+        dbus_utils::UnpackErrorPrinter(), propertiesList, "PartNumber",
+        partNumber, "SerialNumber", serialNumber, "Manufacturer", manufacturer,
+        "Model", model);
 
-            if (interfaceDict.size() != 1)
-            {
-                BMCWEB_LOG_ERROR << "Connection size " << interfaceDict.size()
-                                 << ", greater than 1";
-                messages::internalError(asyncResp->res);
-                return;
-            }
-
-            const std::string& connectionName = interfaceDict.front().first;
-
-            size_t index = root.size();
-            nlohmann::json& storageController =
-                root.emplace_back(nlohmann::json::object());
-
-            storageController["@odata.type"] =
-                "#Storage.v1_7_0.StorageController";
-            storageController["@odata.id"] =
-                "/redfish/v1/Systems/system/Storage/1#/StorageControllers/" +
-                std::to_string(index);
-            auto namePointer = "/StorageControllers"_json_pointer;
-            namePointer /= index;
-            namePointer /= "Name";
-            name_util::getPrettyName(asyncResp, path, interfaceDict[0].first,
-                                     namePointer);
-
-            storageController["MemberId"] = id;
-            storageController["Status"]["State"] = "Enabled";
-
-            sdbusplus::asio::getProperty<bool>(
-                *crow::connections::systemBus, connectionName, path,
-                "xyz.openbmc_project.Inventory.Item", "Present",
-                [asyncResp, index](const boost::system::error_code ec2,
-                                   bool enabled) {
-                // this interface isn't necessary, only check it
-                // if we get a good return
-                if (ec2)
-                {
-                    return;
-                }
-                if (!enabled)
-                {
-                    asyncResp->res.jsonValue["StorageControllers"][index]
-                                            ["Status"]["State"] = "Disabled";
-                }
-            });
-
-            sdbusplus::asio::getAllProperties(
-                *crow::connections::systemBus, connectionName, path,
-                "xyz.openbmc_project.Inventory.Decorator.Asset",
-                [asyncResp, index](
-                    const boost::system::error_code ec2,
-                    const std::vector<
-                        std::pair<std::string, dbus::utility::DbusVariantType>>&
-                        propertiesList) {
-                if (ec2)
-                {
-                    // this interface isn't necessary
-                    return;
-                }
-
-                const std::string* partNumber = nullptr;
-                const std::string* serialNumber = nullptr;
-                const std::string* manufacturer = nullptr;
-                const std::string* model = nullptr;
-
-                const bool success = sdbusplus::unpackPropertiesNoThrow(
-                    dbus_utils::UnpackErrorPrinter(), propertiesList,
-                    "PartNumber", partNumber, "SerialNumber", serialNumber,
-                    "Manufacturer", manufacturer, "Model", model);
-
-                if (!success)
-                {
-                    messages::internalError(asyncResp->res);
-                    return;
-                }
-
-                nlohmann::json& controller =
-                    asyncResp->res.jsonValue["StorageControllers"][index];
+    if (!success)
+    {
+        messages::internalError(asyncResp->res);
+        return;
+    }
 
-                if (partNumber != nullptr)
-                {
-                    controller["PartNumber"] = *partNumber;
-                }
+    if (partNumber != nullptr)
+    {
+        item["PartNumber"] = *partNumber;
+    }
 
-                if (serialNumber != nullptr)
-                {
-                    controller["SerialNumber"] = *serialNumber;
-                }
+    if (serialNumber != nullptr)
+    {
+        item["SerialNumber"] = *serialNumber;
+    }
 
-                if (manufacturer != nullptr)
-                {
-                    controller["Manufacturer"] = *manufacturer;
-                }
+    if (manufacturer != nullptr)
+    {
+        item["Manufacturer"] = *manufacturer;
+    }
 
-                if (model != nullptr)
-                {
-                    controller["Model"] = *model;
-                }
-            });
-        }
-    },
-        "xyz.openbmc_project.ObjectMapper",
-        "/xyz/openbmc_project/object_mapper",
-        "xyz.openbmc_project.ObjectMapper", "GetSubTree",
-        "/xyz/openbmc_project/inventory", int32_t(0),
-        std::array<const char*, 1>{
-            "xyz.openbmc_project.Inventory.Item.StorageController"});
+    if (model != nullptr)
+    {
+        item["Model"] = *model;
+    }
 }
 
-inline void requestRoutesStorage(App& app)
+// The value of a bool property, or nullopt if it's missing or not a bool
+inline std::optional<bool>
+    getBoolProperty(const dbus::utility::DBusPropertiesMap& properties,
+                    std::string_view name)
 {
-    BMCWEB_ROUTE(app, "/redfish/v1/Systems/system/Storage/1/")
-        .privileges(redfish::privileges::getStorage)
-        .methods(boost::beast::http::verb::get)(
-            [&app](const crow::Request& req,
-                   const std::shared_ptr<bmcweb::AsyncResp>& asyncResp) {
-        if (!redfish::setUpRedfishRoute(app, req, asyncResp))
+    for (const auto& [propertyName, value] : properties)
+    {
+        if (propertyName == name)
         {
-            return;
+            const bool* typed = std::get_if<bool>(&value);
+            if (typed == nullptr)
+            {
+                return std::nullopt;
+            }
+            return *typed;
         }
-        asyncResp->res.jsonValue["@odata.type"] = "#Storage.v1_7_1.Storage";
-        asyncResp->res.jsonValue["@odata.id"] =
-            "/redfish/v1/Systems/system/Storage/1";
-        asyncResp->res.jsonValue["Name"] = "Storage";
-        asyncResp->res.jsonValue["Id"] = "1";
-        asyncResp->res.jsonValue["Status"]["State"] = "Enabled";
-
-        getDrives(asyncResp);
-        getStorageControllers(asyncResp);
-    });
+    }
+    return std::nullopt;
 }
 
-inline void getDriveAsset(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-                          const std::string& connectionName,
-                          const std::string& path)
+inline void
+    getStorageControllers(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+                          const storage_utils::StorageInventory& inventory)
 {
-    sdbusplus::asio::getAllProperties(
-        *crow::connections::systemBus, connectionName, path,
-        "xyz.openbmc_project.Inventory.Decorator.Asset",
-        [asyncResp](const boost::system::error_code ec,
-                    const std::vector<
-                        std::pair<std::string, dbus::utility::DbusVariantType>>&
-                        propertiesList) {
-        if (ec)
+    if (inventory.controllers.empty())
+    {
+        // doesn't have to be there
+        return;
+    }
+
+    nlohmann::json& root = asyncResp->res.jsonValue["StorageControllers"];
+    root = nlohmann::json::array();
+    for (const storage_utils::StorageObject& object : inventory.controllers)
+    {
+        if (object.id.empty())
         {
-            // this interface isn't necessary
+            BMCWEB_LOG_ERROR << "Failed to find filename in " << object.path;
             return;
         }
 
-        const std::string* partNumber = nullptr;
-        const std::string* serialNumber = nullptr;
-        const std::string* manufacturer = nullptr;
-        const std::string* model = nullptr;
-
-        const bool success = sdbusplus::unpackPropertiesNoThrow(
-            dbus_utils::UnpackErrorPrinter(), propertiesList, "PartNumber",
-            partNumber, "SerialNumber", serialNumber, "Manufacturer",
-            manufacturer, "Model", model);
-
-        if (!success)
+        if (object.services.size() != 1)
         {
+            BMCWEB_LOG_ERROR << "Connection size " << object.services.size()
+                             << ", greater than 1";
             messages::internalError(asyncResp->res);
             return;
         }
 
-        if (partNumber != nullptr)
+        size_t index = root.size();
+        nlohmann::json& storageController =
+            root.emplace_back(nlohmann::json::object());
+
+        storageController["@odata.type"] = "#Storage.v1_7_0.StorageController";
+        storageController["@odata.id"] =
+            "/redfish/v1/Systems/system/Storage/1#/StorageControllers/" +
+            std::to_string(index);
+        std::string prettyName = object.prettyName();
+        if (!prettyName.empty())
         {
-            asyncResp->res.jsonValue["PartNumber"] = *partNumber;
+            storageController["Name"] = prettyName;
         }
 
-        if (serialNumber != nullptr)
+        storageController["MemberId"] = object.id;
+        storageController["Status"]["State"] = "Enabled";
+
+        // this interface isn't necessary, only check it if it was read
+        const dbus::utility::DBusPropertiesMap* item =
+            object.find("xyz.openbmc_project.Inventory.Item");
+        std::optional<bool> present;
+        if (item != nullptr)
         {
-            asyncResp->res.jsonValue["SerialNumber"] = *serialNumber;
+            present = getBoolProperty(*item, "Present");
         }
-
-        if (manufacturer != nullptr)
+        if (present && !*present)
         {
-            asyncResp->res.jsonValue["Manufacturer"] = *manufacturer;
+            storageController["Status"]["State"] = "Disabled";
         }
 
-        if (model != nullptr)
+        const dbus::utility::DBusPropertiesMap* asset =
+            object.find("xyz.openbmc_project.Inventory.Decorator.Asset");
+        if (asset != nullptr)
         {
-            asyncResp->res.jsonValue["Model"] = *model;
+            assembleAsset(asyncResp, storageController, *asset);
         }
-    });
+    }
 }
 
-inline void getDrivePresent(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-                            const std::string& connectionName,
-                            const std::string& path)
+inline void requestRoutesStorage(App& app)
 {
-    sdbusplus::asio::getProperty<bool>(
-        *crow::connections::systemBus, connectionName, path,
-        "xyz.openbmc_project.Inventory.Item", "Present",
-        [asyncResp, path](const boost::system::error_code ec,
-                          const bool enabled) {
-        // this interface isn't necessary, only check it if
-        // we get a good return
-        if (ec)
+    BMCWEB_ROUTE(app, "/redfish/v1/Systems/system/Storage/1/")
+        .privileges(redfish::privileges::getStorage)
+        .methods(boost::beast::http::verb::get)(
+            [&app](const crow::Request& req,
+                   const std::shared_ptr<bmcweb::AsyncResp>& asyncResp) {
+        if (!redfish::setUpRedfishRoute(app, req, asyncResp))
         {
             return;
         }
+        asyncResp->res.jsonValue["@odata.type"] = "#Storage.v1_7_1.Storage";
+        asyncResp->res.jsonValue["@odata.id"] =
+            "/redfish/v1/Systems/system/Storage/1";
+        asyncResp->res.jsonValue["Name"] = "Storage";
+        asyncResp->res.jsonValue["Id"] = "1";
+        asyncResp->res.jsonValue["Status"]["State"] = "Enabled";
 
-        if (!enabled)
-        {
-            asyncResp->res.jsonValue["Status"]["State"] = "Disabled";
-        }
+        storage_utils::StorageInventoryCache::getInstance().get(
+            [asyncResp](const std::shared_ptr<
+                        const storage_utils::StorageInventory>& inventory) {
+            getDrives(asyncResp, *inventory);
+            getStorageControllers(asyncResp, *inventory);
+        });
     });
 }
 
-inline void getDriveState(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-                          const std::string& connectionName,
-                          const std::string& path)
+inline void
+    assembleDrivePresent(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+                         const dbus::utility::DBusPropertiesMap& properties)
 {
-    sdbusplus::asio::getProperty<bool>(
-        *crow::connections::systemBus, connectionName, path,
-        "xyz.openbmc_project.State.Drive", "Rebuilding",
-        [asyncResp](const boost::system::error_code ec, const bool updating) {
-        // this interface isn't necessary, only check it
-        // if we get a good return
-        if (ec)
-        {
-            return;
-        }
+    std::optional<bool> present = getBoolProperty(properties, "Present");
+    if (present && !*present)
+    {
+        asyncResp->res.jsonValue["Status"]["State"] = "Disabled";
+    }
+}
 
-        // updating and disabled in the backend shouldn't be
-        // able to be set at the same time, so we don't need
-        // to check for the race condition of these two
-        // calls
-        if (updating)
-        {
-            asyncResp->res.jsonValue["Status"]["State"] = "Updating";
-        }
-    });
+inline void
+    assembleDriveState(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+                       const dbus::utility::DBusPropertiesMap& properties)
+{
+    // updating and disabled in the backend shouldn't be
+    // able to be set at the same time, so we don't need
+    // to check for the race condition of these two
+    // properties
+    std::optional<bool> updating = getBoolProperty(properties, "Rebuilding");
+    if (updating && *updating)
+    {
+        asyncResp->res.jsonValue["Status"]["State"] = "Updating";
+    }
 }
 
 inline std::optional<drive::MediaType> convertDriveType(std::string_view type)
@@ -412,143 +327,131 @@ inline std::optional<protocol::Protocol>
     return protocol::Protocol::Invalid;
 }
 
-inline void
-    getDriveItemProperties(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-                           const std::string& connectionName,
-                           const std::string& path)
+inline void assembleDriveItemProperties(
+    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+    const dbus::utility::DBusPropertiesMap& propertiesList)
 {
-    sdbusplus::asio::getAllProperties(
-        *crow::connections::systemBus, connectionName, path,
-        "xyz.openbmc_project.Inventory.Item.Drive",
-        [asyncResp](const boost::system::error_code ec,
-                    const std::vector<
-                        std::pair<std::string, dbus::utility::DbusVariantType>>&
-                        propertiesList) {
-        if (ec)
+    for (const std::pair<std::string, dbus::utility::DbusVariantType>&
+             property : propertiesList)
+    {
+        const std::string& propertyName = property.first;
+        if (propertyName == "Type")
         {
-            // this interface isn't required
-            return;
+            const std::string* value =
+                std::get_if<std::string>(&property.second);
+            if (value == nullptr)
+            {
+                // illegal property
+                BMCWEB_LOG_ERROR << "Illegal property: Type";
+                messages::internalError(asyncResp->res);
+                return;
+            }
+
+            std::optional<drive::MediaType> mediaType =
+                convertDriveType(*value);
+            if (!mediaType)
+            {
+                BMCWEB_LOG_WARNING << "UnknownDriveType Interface: " << *value;
+                continue;
+            }
+            if (*mediaType == drive::MediaType::Invalid)
+            {
+                messages::internalError(asyncResp->res);
+                return;
+            }
+
+            asyncResp->res.jsonValue["MediaType"] = *mediaType;
         }
-        for (const std::pair<std::string, dbus::utility::DbusVariantType>&
-                 property : propertiesList)
+        else if (propertyName == "Capacity")
         {
-            const std::string& propertyName = property.first;
-            if (propertyName == "Type")
+            const uint64_t* capacity = std::get_if<uint64_t>(&property.second);
+            if (capacity == nullptr)
             {
-                const std::string* value =
-                    std::get_if<std::string>(&property.second);
-                if (value == nullptr)
-                {
-                    // illegal property
-                    BMCWEB_LOG_ERROR << "Illegal property: Type";
-                    messages::internalError(asyncResp->res);
-                    return;
-                }
+                BMCWEB_LOG_ERROR << "Illegal property: Capacity";
+                messages::internalError(asyncResp->res);
+                return;
+            }
+            if (*capacity == 0)
+            {
+                // drive capacity not known
+                continue;
+            }
 
-                std::optional<drive::MediaType> mediaType =
-                    convertDriveType(*value);
-                if (!mediaType)
-                {
-                    BMCWEB_LOG_WARNING << "UnknownDriveType Interface: "
-                                       << *value;
-                    continue;
-                }
-                if (*mediaType == drive::MediaType::Invalid)
-                {
-                    messages::internalError(asyncResp->res);
-                    return;
-                }
+            asyncResp->res.jsonValue["CapacityBytes"] = *capacity;
+        }
+        else if (propertyName == "Protocol")
+        {
+            const std::string* value =
+                std::get_if<std::string>(&property.second);
+            if (value == nullptr)
+            {
+                BMCWEB_LOG_ERROR << "Illegal property: Protocol";
+                messages::internalError(asyncResp->res);
+                return;
+            }
 
-                asyncResp->res.jsonValue["MediaType"] = *mediaType;
+            std::optional<protocol::Protocol> proto =
+                convertDriveProtocol(*value);
+            if (!proto)
+            {
+                BMCWEB_LOG_WARNING << "Unknown DrivePrototype Interface: "
+                                   << *value;
+                continue;
             }
-            else if (propertyName == "Capacity")
+            if (*proto == protocol::Protocol::Invalid)
             {
-                const uint64_t* capacity =
-                    std::get_if<uint64_t>(&property.second);
-                if (capacity == nullptr)
-                {
-                    BMCWEB_LOG_ERROR << "Illegal property: Capacity";
-                    messages::internalError(asyncResp->res);
-                    return;
-                }
-                if (*capacity == 0)
-                {
-                    // drive capacity not known
-                    continue;
-                }
-
-                asyncResp->res.jsonValue["CapacityBytes"] = *capacity;
+                messages::internalError(asyncResp->res);
+                return;
             }
-            else if (propertyName == "Protocol")
+            asyncResp->res.jsonValue["Protocol"] = *proto;
+        }
+        else if (propertyName == "PredictedMediaLifeLeftPercent")
+        {
+            const uint8_t* lifeLeft = std::get_if<uint8_t>(&property.second);
+            if (lifeLeft == nullptr)
             {
-                const std::string* value =
-                    std::get_if<std::string>(&property.second);
-                if (value == nullptr)
-                {
-                    BMCWEB_LOG_ERROR << "Illegal property: Protocol";
-                    messages::internalError(asyncResp->res);
-                    return;
-                }
-
-                std::optional<protocol::Protocol> proto =
-                    convertDriveProtocol(*value);
-                if (!proto)
-                {
-                    BMCWEB_LOG_WARNING << "Unknown DrivePrototype Interface: "
-                                       << *value;
-                    continue;
-                }
-                if (*proto == protocol::Protocol::Invalid)
-                {
-                    messages::internalError(asyncResp->res);
-                    return;
-                }
-                asyncResp->res.jsonValue["Protocol"] = *proto;
+                BMCWEB_LOG_ERROR
+                    << "Illegal property: PredictedMediaLifeLeftPercent";
+                messages::internalError(asyncResp->res);
+                return;
             }
-            else if (propertyName == "PredictedMediaLifeLeftPercent")
+            // 255 means reading the value is not supported
+            if (*lifeLeft != 255)
             {
-                const uint8_t* lifeLeft =
-                    std::get_if<uint8_t>(&property.second);
-                if (lifeLeft == nullptr)
-                {
-                    BMCWEB_LOG_ERROR
-                        << "Illegal property: PredictedMediaLifeLeftPercent";
-                    messages::internalError(asyncResp->res);
-                    return;
-                }
-                // 255 means reading the value is not supported
-                if (*lifeLeft != 255)
-                {
-                    asyncResp->res.jsonValue["PredictedMediaLifeLeftPercent"] =
-                        *lifeLeft;
-                }
+                asyncResp->res.jsonValue["PredictedMediaLifeLeftPercent"] =
+                    *lifeLeft;
             }
         }
-    });
+    }
 }
 
-static void addAllDriveInfo(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-                            const std::string& connectionName,
-                            const std::string& path,
-                            const std::vector<std::string>& interfaces)
+inline void addAllDriveInfo(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+                            const storage_utils::StorageObject& drive)
 {
-    for (const std::string& interface : interfaces)
+    // The interfaces that couldn't be read aren't necessary
+    for (const std::string& interface : drive.services.front().second)
     {
+        const dbus::utility::DBusPropertiesMap* properties =
+            drive.find(interface);
+        if (properties == nullptr)
+        {
+            continue;
+        }
         if (interface == "xyz.openbmc_project.Inventory.Decorator.Asset")
         {
-            getDriveAsset(asyncResp, connectionName, path);
+            assembleAsset(asyncResp, asyncResp->res.jsonValue, *properties);
         }
         else if (interface == "xyz.openbmc_project.Inventory.Item")
         {
-            getDrivePresent(asyncResp, connectionName, path);
+            assembleDrivePresent(asyncResp, *properties);
         }
         else if (interface == "xyz.openbmc_project.State.Drive")
         {
-            getDriveState(asyncResp, connectionName, path);
+            assembleDriveState(asyncResp, *properties);
         }
         else if (interface == "xyz.openbmc_project.Inventory.Item.Drive")
         {
-            getDriveItemProperties(asyncResp, connectionName, path);
+            assembleDriveItemProperties(asyncResp, *properties);
         }
     }
 }
@@ -572,46 +475,39 @@ inline void requestRoutesDrive(App& app)
             return;
         }
 
-        crow::connections::systemBus->async_method_call(
-            [asyncResp,
-             driveId](const boost::system::error_code ec,
-                      const dbus::utility::MapperGetSubTreeResponse& subtree) {
-            if (ec)
+        storage_utils::StorageInventoryCache::getInstance().get(
+            [asyncResp, driveId](const std::shared_ptr<
+                                 const storage_utils::StorageInventory>&
+                                     inventory) {
+            if (inventory->drivesError)
             {
                 BMCWEB_LOG_ERROR << "Drive mapper call error";
                 messages::internalError(asyncResp->res);
                 return;
             }
 
-            auto drive = std::find_if(
-                subtree.begin(), subtree.end(),
-                [&driveId](
-                    const std::pair<std::string,
-                                    dbus::utility::MapperServiceMap>& object) {
-                return sdbusplus::message::object_path(object.first)
-                           .filename() == driveId;
-            });
-
-            if (drive == subtree.end())
+            const storage_utils::StorageObject* drive =
+                inventory->findDrive(driveId);
+            if (drive == nullptr)
             {
                 messages::resourceNotFound(asyncResp->res, "Drive", driveId);
                 return;
             }
 
-            const std::string& path = drive->first;
-            const dbus::utility::MapperServiceMap& connectionNames =
-                drive->second;
-
             asyncResp->res.jsonValue["@odata.type"] = "#Drive.v1_7_0.Drive";
             asyncResp->res.jsonValue["@odata.id"] =
                 "/redfish/v1/Systems/system/Storage/1/Drives/" + driveId;
-            name_util::getPrettyName(asyncResp, path, drive->second[0].first,
-                                     "/Name"_json_pointer);
+            std::string prettyName = drive->prettyName();
+            if (!prettyName.empty())
+            {
+                asyncResp->res.jsonValue["Name"] = prettyName;
+            }
             asyncResp->res.jsonValue["Id"] = driveId;
 
-            if (connectionNames.size() != 1)
+            if (drive->services.size() != 1)
             {
-                BMCWEB_LOG_ERROR << "Connection size " << connectionNames.size()
+                BMCWEB_LOG_ERROR << "Connection size "
+                                 << drive->services.size()
                                  << ", not equal to 1";
                 messages::internalError(asyncResp->res);
                 return;
@@ -627,15 +523,8 @@ inline void requestRoutesDrive(App& app)
             // default it to Enabled
             asyncResp->res.jsonValue["Status"]["State"] = "Enabled";
 
-            addAllDriveInfo(asyncResp, connectionNames[0].first, path,
-                            connectionNames[0].second);
-        },
-            "xyz.openbmc_project.ObjectMapper",
-            "/xyz/openbmc_project/object_mapper",
-            "xyz.openbmc_project.ObjectMapper", "GetSubTree",
-            "/xyz/openbmc_project/inventory", int32_t(0),
-            std::array<const char*, 1>{
-                "xyz.openbmc_project.Inventory.Item.Drive"});
+            addAllDriveInfo(asyncResp, *drive);
+        });
     });
 }
 
@@ -653,14 +542,14 @@ inline void chassisDriveCollectionGet(
         return;
     }
 
-    // mapper call lambda
-    crow::connections::systemBus->async_method_call(
-        [asyncResp,
-         chassisId](const boost::system::error_code ec,
-                    const dbus::utility::MapperGetSubTreeResponse& subtree) {
-        if (ec)
+    storage_utils::StorageInventoryCache::getInstance().get(
+        [asyncResp, chassisId](
+            const std::shared_ptr<const storage_utils::StorageInventory>&
+                inventory) {
+        if (inventory->chassisError)
         {
-            if (ec == boost::system::errc::host_unreachable)
+            if (inventory->chassisError ==
+                boost::system::errc::host_unreachable)
             {
                 messages::resourceNotFound(asyncResp->res, "Chassis",
                                            chassisId);
@@ -671,17 +560,10 @@ inline void chassisDriveCollectionGet(
         }
 
         // Iterate over all retrieved ObjectPaths.
-        for (const auto& [path, connectionNames] : subtree)
+        for (const storage_utils::ChassisDrives& chassis : inventory->chassis)
         {
-            sdbusplus::message::object_path objPath(path);
-            if (objPath.filename() != chassisId)
-            {
-                continue;
-            }
-
-            if (connectionNames.empty())
+            if (chassis.id != chassisId)
             {
-                BMCWEB_LOG_ERROR << "Got 0 Connection names";
                 continue;
             }
 
@@ -692,52 +574,37 @@ inline void chassisDriveCollectionGet(
                                              chassisId, "Drives");
             asyncResp->res.jsonValue["Name"] = "Drive Collection";
 
-            // Association lambda
-            sdbusplus::asio::getProperty<std::vector<std::string>>(
-                *crow::connections::systemBus,
-                "xyz.openbmc_project.ObjectMapper", path + "/drive",
-                "xyz.openbmc_project.Association", "endpoints",
-                [asyncResp, chassisId](const boost::system::error_code ec3,
-                                       const std::vector<std::string>& resp) {
-                if (ec3)
-                {
-                    BMCWEB_LOG_ERROR << "Error in chassis Drive association ";
-                }
-                nlohmann::json& members = asyncResp->res.jsonValue["Members"];
-                // important if array is empty
-                members = nlohmann::json::array();
+            if (!chassis.drives)
+            {
+                BMCWEB_LOG_ERROR << "Error in chassis Drive association ";
+            }
+            nlohmann::json& members = asyncResp->res.jsonValue["Members"];
+            // important if array is empty
+            members = nlohmann::json::array();
 
-                std::vector<std::string> leafNames;
-                for (const auto& drive : resp)
+            std::vector<std::string> leafNames;
+            if (chassis.drives)
+            {
+                for (const auto& drive : *chassis.drives)
                 {
                     sdbusplus::message::object_path drivePath(drive);
                     leafNames.push_back(drivePath.filename());
                 }
+            }
 
-                std::sort(leafNames.begin(), leafNames.end(),
-                          AlphanumLess<std::string>());
+            alphanumSort(leafNames.begin(), leafNames.end());
 
-                for (const auto& leafName : leafNames)
-                {
-                    nlohmann::json::object_t member;
-                    member["@odata.id"] = crow::utility::urlFromPieces(
-                        "redfish", "v1", "Chassis", chassisId, "Drives",
-                        leafName);
-                    members.push_back(std::move(member));
-                    // navigation links will be registered in next patch set
-                }
-                asyncResp->res.jsonValue["Members@odata.count"] = resp.size();
-            }); // end association lambda
-
-        }       // end Iterate over all retrieved ObjectPaths
-    },
-        "xyz.openbmc_project.ObjectMapper",
-        "/xyz/openbmc_project/object_mapper",
-        "xyz.openbmc_project.ObjectMapper", "GetSubTree",
-        "/xyz/openbmc_project/inventory", 0,
-        std::array<const char*, 2>{
-            "xyz.openbmc_project.Inventory.Item.Board",
-            "xyz.openbmc_project.Inventory.Item.Chassis"});
+            for (const auto& leafName : leafNames)
+            {
+                nlohmann::json::object_t member;
+                member["@odata.id"] = crow::utility::urlFromPieces(
+                    "redfish", "v1", "Chassis", chassisId, "Drives", leafName);
+                members.push_back(std::move(member));
+                // navigation links will be registered in next patch set
+            }
+            asyncResp->res.jsonValue["Members@odata.count"] = leafNames.size();
+        }
+    });
 }
 
 inline void requestRoutesChassisDrive(App& app)
@@ -751,26 +618,24 @@ inline void requestRoutesChassisDrive(App& app)
 inline void buildDrive(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
                        const std::string& chassisId,
                        const std::string& driveName,
-                       const boost::system::error_code ec,
-                       const dbus::utility::MapperGetSubTreeResponse& subtree)
+                       const storage_utils::StorageInventory& inventory)
 {
-    if (ec)
+    if (inventory.drivesError)
     {
-        BMCWEB_LOG_DEBUG << "DBUS response error " << ec;
+        BMCWEB_LOG_DEBUG << "DBUS response error " << inventory.drivesError;
         messages::internalError(asyncResp->res);
         return;
     }
 
     // Iterate over all retrieved ObjectPaths.
-    for (const auto& [path, connectionNames] : subtree)
+    for (const storage_utils::StorageObject& drive : inventory.drives)
     {
-        sdbusplus::message::object_path objPath(path);
-        if (objPath.filename() != driveName)
+        if (drive.id != driveName)
         {
             continue;
         }
 
-        if (connectionNames.empty())
+        if (drive.services.empty())
         {
             BMCWEB_LOG_ERROR << "Got 0 Connection names";
             continue;
@@ -790,8 +655,7 @@ inline void buildDrive(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
             crow::utility::urlFromPieces("redfish", "v1", "Chassis", chassisId);
         asyncResp->res.jsonValue["Links"]["Chassis"] = linkChassisNav;
 
-        addAllDriveInfo(asyncResp, connectionNames[0].first, path,
-                        connectionNames[0].second);
+        addAllDriveInfo(asyncResp, drive);
     }
 }
 
@@ -799,7 +663,8 @@ inline void
     matchAndFillDrive(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
                       const std::string& chassisId,
                       const std::string& driveName,
-                      const std::vector<std::string>& resp)
+                      const std::vector<std::string>& resp,
+                      const storage_utils::StorageInventory& inventory)
 {
     for (const std::string& drivePath : resp)
     {
@@ -809,20 +674,7 @@ inline void
         {
             continue;
         }
-        //  mapper call drive
-        const std::array<const char*, 1> driveInterface = {
-            "xyz.openbmc_project.Inventory.Item.Drive"};
-
-        crow::connections::systemBus->async_method_call(
-            [asyncResp, chassisId, driveName](
-                const boost::system::error_code ec,
-                const dbus::utility::MapperGetSubTreeResponse& subtree) {
-            buildDrive(asyncResp, chassisId, driveName, ec, subtree);
-        },
-            "xyz.openbmc_project.ObjectMapper",
-            "/xyz/openbmc_project/object_mapper",
-            "xyz.openbmc_project.ObjectMapper", "GetSubTree",
-            "/xyz/openbmc_project/inventory", 0, driveInterface);
+        buildDrive(asyncResp, chassisId, driveName, inventory);
     }
 }
 
@@ -836,56 +688,34 @@ inline void
     {
         return;
     }
-    const std::array<const char*, 2> interfaces = {
-        "xyz.openbmc_project.Inventory.Item.Board",
-        "xyz.openbmc_project.Inventory.Item.Chassis"};
-
-    // mapper call chassis
-    crow::connections::systemBus->async_method_call(
-        [asyncResp, chassisId,
-         driveName](const boost::system::error_code ec,
-                    const dbus::utility::MapperGetSubTreeResponse& subtree) {
-        if (ec)
+
+    storage_utils::StorageInventoryCache::getInstance().get(
+        [asyncResp, chassisId, driveName](
+            const std::shared_ptr<const storage_utils::StorageInventory>&
+                inventory) {
+        if (inventory->chassisError)
         {
             messages::internalError(asyncResp->res);
             return;
         }
 
         // Iterate over all retrieved ObjectPaths.
-        for (const auto& [path, connectionNames] : subtree)
+        for (const storage_utils::ChassisDrives& chassis : inventory->chassis)
         {
-            sdbusplus::message::object_path objPath(path);
-            if (objPath.filename() != chassisId)
+            if (chassis.id != chassisId)
             {
                 continue;
             }
 
-            if (connectionNames.empty())
+            if (!chassis.drives)
             {
-                BMCWEB_LOG_ERROR << "Got 0 Connection names";
-                continue;
+                return; // no drives = no failures
             }
-
-            sdbusplus::asio::getProperty<std::vector<std::string>>(
-                *crow::connections::systemBus,
-                "xyz.openbmc_project.ObjectMapper", path + "/drive",
-                "xyz.openbmc_project.Association", "endpoints",
-                [asyncResp, chassisId,
-                 driveName](const boost::system::error_code ec3,
-                            const std::vector<std::string>& resp) {
-                if (ec3)
-                {
-                    return; // no drives = no failures
-                }
-                matchAndFillDrive(asyncResp, chassisId, driveName, resp);
-            });
+            matchAndFillDrive(asyncResp, chassisId, driveName, *chassis.drives,
+                              *inventory);
             break;
         }
-    },
-        "xyz.openbmc_project.ObjectMapper",
-        "/xyz/openbmc_project/object_mapper",
-        "xyz.openbmc_project.ObjectMapper", "GetSubTree",
-        "/xyz/openbmc_project/inventory", 0, interfaces);
+    });
 }
 
 /**
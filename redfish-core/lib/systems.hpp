@@ -30,17 +30,25 @@
 
 #include <app.hpp>
 #include <boost/asio/error.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/container/flat_map.hpp>
 #include <dbus_utility.hpp>
 #include <registries/privilege_registry.hpp>
 #include <sdbusplus/asio/property.hpp>
+#include <sdbusplus/bus/match.hpp>
 #include <sdbusplus/message.hpp>
 #include <sdbusplus/unpack_properties.hpp>
 #include <utils/dbus_utils.hpp>
 #include <utils/json_utils.hpp>
 #include <utils/sw_utils.hpp>
 
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string_view>
 #include <variant>
+#include <vector>
 
 namespace redfish
 {
@@ -208,20 +216,17 @@ inline void getProcessorSummary(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
     };
 
     // Get the Presence of CPU
-    sdbusplus::asio::getProperty<bool>(
-        *crow::connections::systemBus, service, path,
-        "xyz.openbmc_project.Inventory.Item", "Present",
+    dbus::utility::getPropertyBatched<bool>(
+        service, path, "xyz.openbmc_project.Inventory.Item", "Present",
         std::move(getCpuPresenceState));
 
     // Get the Functional State
-    sdbusplus::asio::getProperty<bool>(
-        *crow::connections::systemBus, service, path,
-        "xyz.openbmc_project.State.Decorator.OperationalStatus", "Functional",
-        std::move(getCpuFunctionalState));
+    dbus::utility::getPropertyBatched<bool>(
+        service, path, "xyz.openbmc_project.State.Decorator.OperationalStatus",
+        "Functional", std::move(getCpuFunctionalState));
 
-    sdbusplus::asio::getAllProperties(
-        *crow::connections::systemBus, service, path,
-        "xyz.openbmc_project.Inventory.Item.Cpu",
+    dbus::utility::getAllPropertiesBatched(
+        service, path, "xyz.openbmc_project.Inventory.Item.Cpu",
         [aResp, service,
          path](const boost::system::error_code ec2,
                const dbus::utility::DBusPropertiesMap& properties) {
@@ -236,20 +241,34 @@ inline void getProcessorSummary(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
 }
 
 /*
- * @brief Retrieves computer system properties over dbus
+ * @brief Retrieves properties of the system's components over dbus
  *
  * @param[in] aResp Shared pointer for completing asynchronous calls
- * @param[in] systemHealth  Shared HealthPopulate pointer
+ * @param[in] wantMemory Whether to add up MemorySummary
+ * @param[in] wantProcessor Whether to add up ProcessorSummary
+ * @param[in] wantUuid Whether to get UUID
+ * @param[in] wantAsset Whether to get the asset properties and BiosVersion
  *
  * @return None.
  */
-inline void getComputerSystem(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
+inline void
+    getSystemComponents(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
+                        bool wantMemory, bool wantProcessor, bool wantUuid,
+                        bool wantAsset)
 {
     BMCWEB_LOG_DEBUG << "Get available system components.";
-
-    crow::connections::systemBus->async_method_call(
-        [aResp](const boost::system::error_code ec,
-                const dbus::utility::MapperGetSubTreeResponse& subtree) {
+    constexpr std::array<std::string_view, 5> interfaces = {
+        "xyz.openbmc_project.Inventory.Decorator.Asset",
+        "xyz.openbmc_project.Inventory.Item.Cpu",
+        "xyz.openbmc_project.Inventory.Item.Dimm",
+        "xyz.openbmc_project.Inventory.Item.System",
+        "xyz.openbmc_project.Common.UUID",
+    };
+    dbus::utility::getSubTree(
+        "/xyz/openbmc_project/inventory", 0, interfaces,
+        [aResp, wantMemory, wantProcessor, wantUuid, wantAsset](
+            const boost::system::error_code& ec,
+            const dbus::utility::MapperGetSubTreeResponse& subtree) {
         if (ec)
         {
             BMCWEB_LOG_ERROR << "D-Bus response error: " << ec;
@@ -277,15 +296,16 @@ inline void getComputerSystem(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
             {
                 for (const auto& interfaceName : connection.second)
                 {
-                    if (interfaceName ==
-                        "xyz.openbmc_project.Inventory.Item.Dimm")
+                    if (wantMemory &&
+                        interfaceName ==
+                            "xyz.openbmc_project.Inventory.Item.Dimm")
                     {
                         BMCWEB_LOG_DEBUG
                             << "Found Dimm, now get its properties.";
 
-                        sdbusplus::asio::getAllProperties(
-                            *crow::connections::systemBus, connection.first,
-                            path, "xyz.openbmc_project.Inventory.Item.Dimm",
+                        dbus::utility::getAllPropertiesBatched(
+                            connection.first, path,
+                            "xyz.openbmc_project.Inventory.Item.Dimm",
                             [aResp, service{connection.first},
                              path](const boost::system::error_code ec2,
                                    const dbus::utility::DBusPropertiesMap&
@@ -302,9 +322,8 @@ inline void getComputerSystem(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
 
                             if (properties.empty())
                             {
-                                sdbusplus::asio::getProperty<bool>(
-                                    *crow::connections::systemBus, service,
-                                    path,
+                                dbus::utility::getPropertyBatched<bool>(
+                                    service, path,
                                     "xyz.openbmc_project.State."
                                     "Decorator.OperationalStatus",
                                     "Functional",
@@ -365,22 +384,24 @@ inline void getComputerSystem(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
                             }
                         });
                     }
-                    else if (interfaceName ==
-                             "xyz.openbmc_project.Inventory.Item.Cpu")
+                    else if (wantProcessor &&
+                             interfaceName ==
+                                 "xyz.openbmc_project.Inventory.Item.Cpu")
                     {
                         BMCWEB_LOG_DEBUG
                             << "Found Cpu, now get its properties.";
 
                         getProcessorSummary(aResp, connection.first, path);
                     }
-                    else if (interfaceName == "xyz.openbmc_project.Common.UUID")
+                    else if (wantUuid &&
+                             interfaceName == "xyz.openbmc_project.Common.UUID")
                     {
                         BMCWEB_LOG_DEBUG
                             << "Found UUID, now get its properties.";
 
-                        sdbusplus::asio::getAllProperties(
-                            *crow::connections::systemBus, connection.first,
-                            path, "xyz.openbmc_project.Common.UUID",
+                        dbus::utility::getAllPropertiesBatched(
+                            connection.first, path,
+                            "xyz.openbmc_project.Common.UUID",
                             [aResp](const boost::system::error_code ec3,
                                     const dbus::utility::DBusPropertiesMap&
                                         properties) {
@@ -422,12 +443,12 @@ inline void getComputerSystem(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
                             }
                         });
                     }
-                    else if (interfaceName ==
-                             "xyz.openbmc_project.Inventory.Item.System")
+                    else if (wantAsset &&
+                             interfaceName ==
+                                 "xyz.openbmc_project.Inventory.Item.System")
                     {
-                        sdbusplus::asio::getAllProperties(
-                            *crow::connections::systemBus, connection.first,
-                            path,
+                        dbus::utility::getAllPropertiesBatched(
+                            connection.first, path,
                             "xyz.openbmc_project.Inventory.Decorator.Asset",
                             [aResp](const boost::system::error_code ec2,
                                     const dbus::utility::DBusPropertiesMap&
@@ -495,9 +516,8 @@ inline void getComputerSystem(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
                                 false);
                         });
 
-                        sdbusplus::asio::getProperty<std::string>(
-                            *crow::connections::systemBus, connection.first,
-                            path,
+                        dbus::utility::getPropertyBatched<std::string>(
+                            connection.first, path,
                             "xyz.openbmc_project.Inventory.Decorator."
                             "AssetTag",
                             "AssetTag",
@@ -517,18 +537,199 @@ inline void getComputerSystem(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
                 break;
             }
         }
-    },
-        "xyz.openbmc_project.ObjectMapper",
-        "/xyz/openbmc_project/object_mapper",
-        "xyz.openbmc_project.ObjectMapper", "GetSubTree",
-        "/xyz/openbmc_project/inventory", int32_t(0),
-        std::array<const char*, 5>{
-            "xyz.openbmc_project.Inventory.Decorator.Asset",
-            "xyz.openbmc_project.Inventory.Item.Cpu",
-            "xyz.openbmc_project.Inventory.Item.Dimm",
-            "xyz.openbmc_project.Inventory.Item.System",
-            "xyz.openbmc_project.Common.UUID",
+    });
+}
+
+/**
+ * @brief The MemorySummary and ProcessorSummary of the system.
+ *
+ * Adding these up takes a property read of every DIMM and CPU, so they are
+ * computed on first use and then kept until a signal is sent from within the
+ * inventory tree: a DIMM or CPU being added or removed, or changing its
+ * Present, Functional or size properties.  A service taking or dropping a
+ * well known name clears them too, since its objects come or go with it.
+ * Concurrent reads share one computation, and one that was in flight when
+ * the inventory changed is answered but not kept.
+ */
+class SystemSummaryCache
+{
+  public:
+    // Called with an object holding MemorySummary and ProcessorSummary, or
+    // nullptr if they couldn't be computed
+    using Callback = std::function<void(
+        const std::shared_ptr<const nlohmann::json::object_t>&)>;
+
+    static SystemSummaryCache& getInstance()
+    {
+        static SystemSummaryCache cache;
+        return cache;
+    }
+
+    SystemSummaryCache(const SystemSummaryCache&) = delete;
+    SystemSummaryCache(SystemSummaryCache&&) = delete;
+    SystemSummaryCache& operator=(const SystemSummaryCache&) = delete;
+    SystemSummaryCache& operator=(SystemSummaryCache&&) = delete;
+    ~SystemSummaryCache() = default;
+
+    void registerMatches(sdbusplus::asio::connection& conn)
+    {
+        namespace rules = sdbusplus::bus::match::rules;
+
+        matches.clear();
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn,
+            rules::type::signal() +
+                rules::path_namespace("/xyz/openbmc_project/inventory"),
+            [this](sdbusplus::message_t& /*msg*/) { clear(); }));
+        matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            conn, rules::nameOwnerChanged(), [this](sdbusplus::message_t& msg) {
+            std::string name;
+            msg.read(name);
+            if (!name.starts_with(':'))
+            {
+                clear();
+            }
+        }));
+        clear();
+    }
+
+    bool enabled() const
+    {
+        return !matches.empty();
+    }
+
+    /**
+     * @brief Calls callback with the summaries, computing them if they
+     * aren't cached.  The callback is never called inline.
+     */
+    void get(Callback&& callback)
+    {
+        if (summaries)
+        {
+            std::shared_ptr<const nlohmann::json::object_t> current =
+                summaries;
+            boost::asio::post(crow::connections::systemBus->get_io_context(),
+                              [current, callback{std::move(callback)}]() {
+                callback(current);
+            });
+            return;
+        }
+
+        callbacks.emplace_back(std::move(callback));
+        if (callbacks.size() > 1)
+        {
+            return;
+        }
+        crow::dbus_trace::SharedCallScope sharedCalls;
+
+        // Add the summaries up into a response of their own, which completes
+        // once every DIMM and CPU has been read
+        auto summaryResp = std::make_shared<bmcweb::AsyncResp>();
+        summaryResp->res.setCompleteRequestHandler(
+            [this, fetchGeneration{generation}](crow::Response& res) {
+            complete(fetchGeneration, res);
         });
+        nlohmann::json& json = summaryResp->res.jsonValue;
+        json["ProcessorSummary"]["Count"] = 0;
+        json["ProcessorSummary"]["Status"]["State"] = "Disabled";
+        json["MemorySummary"]["TotalSystemMemoryGiB"] = double(0);
+        json["MemorySummary"]["Status"]["State"] = "Disabled";
+        getSystemComponents(summaryResp, true, true, false, false);
+    }
+
+    void clear()
+    {
+        summaries.reset();
+        generation++;
+    }
+
+  private:
+    SystemSummaryCache() = default;
+
+    void complete(uint64_t fetchGeneration, crow::Response& res)
+    {
+        std::vector<Callback> waiting = std::move(callbacks);
+        callbacks.clear();
+
+        std::shared_ptr<const nlohmann::json::object_t> computed;
+        if (res.result() != boost::beast::http::status::ok)
+        {
+            BMCWEB_LOG_ERROR << "Failed to compute system summaries";
+        }
+        else
+        {
+            nlohmann::json::object_t read;
+            read["MemorySummary"] = std::move(res.jsonValue["MemorySummary"]);
+            read["ProcessorSummary"] =
+                std::move(res.jsonValue["ProcessorSummary"]);
+            computed = std::make_shared<const nlohmann::json::object_t>(
+                std::move(read));
+            if (enabled() && fetchGeneration == generation)
+            {
+                summaries = computed;
+            }
+        }
+        for (Callback& callback : waiting)
+        {
+            callback(computed);
+        }
+    }
+
+    std::shared_ptr<const nlohmann::json::object_t> summaries;
+    std::vector<Callback> callbacks;
+    uint64_t generation = 0;
+    std::vector<std::unique_ptr<sdbusplus::bus::match_t>> matches;
+};
+
+/*
+ * @brief Retrieves computer system properties over dbus
+ *
+ * @param[in] aResp Shared pointer for completing asynchronous calls
+ * @param[in] select The properties the client selected
+ *
+ * @return None.
+ */
+inline void getComputerSystem(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
+                              const query_param::SelectTrie& select = {})
+{
+    const bool wantMemory = select.isAnySelected({"MemorySummary"});
+    const bool wantProcessor = select.isAnySelected({"ProcessorSummary"});
+    const bool wantUuid = select.isAnySelected({"UUID"});
+    const bool wantAsset = select.isAnySelected(
+        {"PartNumber", "SerialNumber", "Manufacturer", "Model", "SubModel",
+         "BiosVersion", "AssetTag"});
+    if (!wantMemory && !wantProcessor && !wantUuid && !wantAsset)
+    {
+        BMCWEB_LOG_DEBUG << "No system component properties selected";
+        return;
+    }
+    if (wantMemory || wantProcessor)
+    {
+        SystemSummaryCache::getInstance().get(
+            [aResp, wantMemory, wantProcessor](
+                const std::shared_ptr<const nlohmann::json::object_t>&
+                    summaries) {
+            if (summaries == nullptr)
+            {
+                messages::internalError(aResp->res);
+                return;
+            }
+            if (wantMemory)
+            {
+                aResp->res.jsonValue["MemorySummary"] =
+                    summaries->at("MemorySummary");
+            }
+            if (wantProcessor)
+            {
+                aResp->res.jsonValue["ProcessorSummary"] =
+                    summaries->at("ProcessorSummary");
+            }
+        });
+    }
+    if (wantUuid || wantAsset)
+    {
+        getSystemComponents(aResp, false, false, wantUuid, wantAsset);
+    }
 }
 
 /**
@@ -541,10 +742,9 @@ inline void getComputerSystem(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
 inline void getHostState(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
 {
     BMCWEB_LOG_DEBUG << "Get host information.";
-    sdbusplus::asio::getProperty<std::string>(
-        *crow::connections::systemBus, "xyz.openbmc_project.State.Host",
-        "/xyz/openbmc_project/state/host0", "xyz.openbmc_project.State.Host",
-        "CurrentHostState",
+    dbus::utility::getPropertyBatched<std::string>(
+        "xyz.openbmc_project.State.Host", "/xyz/openbmc_project/state/host0",
+        "xyz.openbmc_project.State.Host", "CurrentHostState",
         [aResp](const boost::system::error_code ec,
                 const std::string& hostState) {
         if (ec)
@@ -712,9 +912,8 @@ inline std::string dbusToRfBootProgress(const std::string& dbusBootProgress)
  */
 inline void getBootProgress(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
 {
-    sdbusplus::asio::getProperty<std::string>(
-        *crow::connections::systemBus, "xyz.openbmc_project.State.Host",
-        "/xyz/openbmc_project/state/host0",
+    dbus::utility::getPropertyBatched<std::string>(
+        "xyz.openbmc_project.State.Host", "/xyz/openbmc_project/state/host0",
         "xyz.openbmc_project.State.Boot.Progress", "BootProgress",
         [aResp](const boost::system::error_code ec,
                 const std::string& bootProgressStr) {
@@ -742,9 +941,8 @@ inline void getBootProgress(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
 inline void getBootProgressLastStateTime(
     const std::shared_ptr<bmcweb::AsyncResp>& aResp)
 {
-    sdbusplus::asio::getProperty<uint64_t>(
-        *crow::connections::systemBus, "xyz.openbmc_project.State.Host",
-        "/xyz/openbmc_project/state/host0",
+    dbus::utility::getPropertyBatched<uint64_t>(
+        "xyz.openbmc_project.State.Host", "/xyz/openbmc_project/state/host0",
         "xyz.openbmc_project.State.Boot.Progress", "BootProgressLastUpdate",
         [aResp](const boost::system::error_code ec,
                 const uint64_t lastStateTime) {
@@ -782,8 +980,8 @@ inline void getLastResetTime(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
 {
     BMCWEB_LOG_DEBUG << "Getting System Last Reset Time";
 
-    sdbusplus::asio::getProperty<uint64_t>(
-        *crow::connections::systemBus, "xyz.openbmc_project.State.Chassis",
+    dbus::utility::getPropertyBatched<uint64_t>(
+        "xyz.openbmc_project.State.Chassis",
         "/xyz/openbmc_project/state/chassis0",
         "xyz.openbmc_project.State.Chassis", "LastStateChangeTime",
         [aResp](const boost::system::error_code ec, uint64_t lastResetTime) {
@@ -814,8 +1012,8 @@ inline void getAutomaticRetry(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
 {
     BMCWEB_LOG_DEBUG << "Get Automatic Retry policy";
 
-    sdbusplus::asio::getProperty<bool>(
-        *crow::connections::systemBus, "xyz.openbmc_project.Settings",
+    dbus::utility::getPropertyBatched<bool>(
+        "xyz.openbmc_project.Settings",
         "/xyz/openbmc_project/control/host0/auto_reboot",
         "xyz.openbmc_project.Control.Boot.RebootPolicy", "AutoReboot",
         [aResp](const boost::system::error_code ec, bool autoRebootEnabled) {
@@ -832,8 +1030,8 @@ inline void getAutomaticRetry(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
                 "RetryAttempts";
             // If AutomaticRetry (AutoReboot) is enabled see how many
             // attempts are left
-            sdbusplus::asio::getProperty<uint32_t>(
-                *crow::connections::systemBus, "xyz.openbmc_project.State.Host",
+            dbus::utility::getPropertyBatched<uint32_t>(
+                "xyz.openbmc_project.State.Host",
                 "/xyz/openbmc_project/state/host0",
                 "xyz.openbmc_project.Control.Boot.RebootAttempts",
                 "AttemptsLeft",
@@ -883,8 +1081,8 @@ inline void
 {
     BMCWEB_LOG_DEBUG << "Get power restore policy";
 
-    sdbusplus::asio::getProperty<std::string>(
-        *crow::connections::systemBus, "xyz.openbmc_project.Settings",
+    dbus::utility::getPropertyBatched<std::string>(
+        "xyz.openbmc_project.Settings",
         "/xyz/openbmc_project/control/host0/power_restore_policy",
         "xyz.openbmc_project.Control.Power.RestorePolicy", "PowerRestorePolicy",
         [aResp](const boost::system::error_code ec, const std::string& policy) {
@@ -927,9 +1125,8 @@ inline void getStopBootOnFault(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
 {
     BMCWEB_LOG_DEBUG << "Get Stop Boot On Fault";
 
-    sdbusplus::asio::getProperty<bool>(
-        *crow::connections::systemBus, "xyz.openbmc_project.Settings",
-        "/xyz/openbmc_project/logging/settings",
+    dbus::utility::getPropertyBatched<bool>(
+        "xyz.openbmc_project.Settings", "/xyz/openbmc_project/logging/settings",
         "xyz.openbmc_project.Logging.Settings", "QuiesceOnHwError",
         [aResp](const boost::system::error_code& ec, bool value) {
         if (ec)
@@ -965,8 +1162,11 @@ inline void getTrustedModuleRequiredToBoot(
 {
     BMCWEB_LOG_DEBUG << "Get TPM required to boot.";
 
-    crow::connections::systemBus->async_method_call(
-        [aResp](const boost::system::error_code ec,
+    constexpr std::array<std::string_view, 1> interfaces = {
+        "xyz.openbmc_project.Control.TPM.Policy"};
+    dbus::utility::getSubTree(
+        "/", 0, interfaces,
+        [aResp](const boost::system::error_code& ec,
                 const dbus::utility::MapperGetSubTreeResponse& subtree) {
         if (ec)
         {
@@ -1007,9 +1207,8 @@ inline void getTrustedModuleRequiredToBoot(
         const std::string& serv = subtree[0].second.begin()->first;
 
         // Valid TPM Enable object found, now reading the current value
-        sdbusplus::asio::getProperty<bool>(
-            *crow::connections::systemBus, serv, path,
-            "xyz.openbmc_project.Control.TPM.Policy", "TPMEnable",
+        dbus::utility::getPropertyBatched<bool>(
+            serv, path, "xyz.openbmc_project.Control.TPM.Policy", "TPMEnable",
             [aResp](const boost::system::error_code ec2, bool tpmRequired) {
             if (ec2)
             {
@@ -1030,11 +1229,7 @@ inline void getTrustedModuleRequiredToBoot(
                     "Disabled";
             }
         });
-    },
-        "xyz.openbmc_project.ObjectMapper",
-        "/xyz/openbmc_project/object_mapper",
-        "xyz.openbmc_project.ObjectMapper", "GetSubTree", "/", int32_t(0),
-        std::array<const char*, 1>{"xyz.openbmc_project.Control.TPM.Policy"});
+    });
 }
 
 /**
@@ -1371,9 +1566,9 @@ inline void
 inline void getProvisioningStatus(std::shared_ptr<bmcweb::AsyncResp> aResp)
 {
     BMCWEB_LOG_DEBUG << "Get OEM information.";
-    sdbusplus::asio::getAllProperties(
-        *crow::connections::systemBus, "xyz.openbmc_project.PFR.Manager",
-        "/xyz/openbmc_project/pfr", "xyz.openbmc_project.PFR.Attributes",
+    dbus::utility::getAllPropertiesBatched(
+        "xyz.openbmc_project.PFR.Manager", "/xyz/openbmc_project/pfr",
+        "xyz.openbmc_project.PFR.Attributes",
         [aResp](const boost::system::error_code ec,
                 const dbus::utility::DBusPropertiesMap& propertiesList) {
         nlohmann::json& oemPFR =
@@ -1480,8 +1675,11 @@ inline void getPowerMode(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
     BMCWEB_LOG_DEBUG << "Get power mode.";
 
     // Get Power Mode object path:
-    crow::connections::systemBus->async_method_call(
-        [aResp](const boost::system::error_code ec,
+    constexpr std::array<std::string_view, 1> interfaces = {
+        "xyz.openbmc_project.Control.Power.Mode"};
+    dbus::utility::getSubTree(
+        "/", 0, interfaces,
+        [aResp](const boost::system::error_code& ec,
                 const dbus::utility::MapperGetSubTreeResponse& subtree) {
         if (ec)
         {
@@ -1523,9 +1721,8 @@ inline void getPowerMode(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
         }
 
         // Valid Power Mode object found, now read the current value
-        sdbusplus::asio::getAllProperties(
-            *crow::connections::systemBus, service, path,
-            "xyz.openbmc_project.Control.Power.Mode",
+        dbus::utility::getAllPropertiesBatched(
+            service, path, "xyz.openbmc_project.Control.Power.Mode",
             [aResp](const boost::system::error_code ec2,
                     const dbus::utility::DBusPropertiesMap& properties) {
             if (ec2)
@@ -1568,11 +1765,7 @@ inline void getPowerMode(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
                 translatePowerMode(aResp, *powerMode);
             }
         });
-    },
-        "xyz.openbmc_project.ObjectMapper",
-        "/xyz/openbmc_project/object_mapper",
-        "xyz.openbmc_project.ObjectMapper", "GetSubTree", "/", int32_t(0),
-        std::array<const char*, 1>{"xyz.openbmc_project.Control.Power.Mode"});
+    });
 }
 
 /**
@@ -1769,9 +1962,8 @@ inline void
     getHostWatchdogTimer(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
 {
     BMCWEB_LOG_DEBUG << "Get host watchodg";
-    sdbusplus::asio::getAllProperties(
-        *crow::connections::systemBus, "xyz.openbmc_project.Watchdog",
-        "/xyz/openbmc_project/watchdog/host0",
+    dbus::utility::getAllPropertiesBatched(
+        "xyz.openbmc_project.Watchdog", "/xyz/openbmc_project/watchdog/host0",
         "xyz.openbmc_project.State.Watchdog",
         [aResp](const boost::system::error_code ec,
                 const dbus::utility::DBusPropertiesMap& properties) {
@@ -1962,8 +2154,11 @@ inline void getIdlePowerSaver(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
     BMCWEB_LOG_DEBUG << "Get idle power saver parameters";
 
     // Get IdlePowerSaver object path:
-    crow::connections::systemBus->async_method_call(
-        [aResp](const boost::system::error_code ec,
+    constexpr std::array<std::string_view, 1> interfaces = {
+        "xyz.openbmc_project.Control.Power.IdlePowerSaver"};
+    dbus::utility::getSubTree(
+        "/", 0, interfaces,
+        [aResp](const boost::system::error_code& ec,
                 const dbus::utility::MapperGetSubTreeResponse& subtree) {
         if (ec)
         {
@@ -2006,9 +2201,8 @@ inline void getIdlePowerSaver(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
         }
 
         // Valid IdlePowerSaver object found, now read the current values
-        sdbusplus::asio::getAllProperties(
-            *crow::connections::systemBus, service, path,
-            "xyz.openbmc_project.Control.Power.IdlePowerSaver",
+        dbus::utility::getAllPropertiesBatched(
+            service, path, "xyz.openbmc_project.Control.Power.IdlePowerSaver",
             [aResp](const boost::system::error_code ec2,
                     const dbus::utility::DBusPropertiesMap& properties) {
             if (ec2)
@@ -2025,39 +2219,7 @@ inline void getIdlePowerSaver(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
                 return;
             }
         });
-    },
-        "xyz.openbmc_project.ObjectMapper",
-        "/xyz/openbmc_project/object_mapper",
-        "xyz.openbmc_project.ObjectMapper", "GetSubTree", "/", int32_t(0),
-        std::array<const char*, 1>{
-            "xyz.openbmc_project.Control.Power.IdlePowerSaver"});
-
-    BMCWEB_LOG_DEBUG << "EXIT: Get idle power saver parameters";
-}
-
-/*
- * Handle Enabled Panel Functions
- */
-inline void doGetEnabledPanelFunctions(
-    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-    std::function<void(const std::vector<uint8_t>&)>&& callback)
-{
-    BMCWEB_LOG_DEBUG << "Get Enabled Panel functions";
-
-    crow::connections::systemBus->async_method_call(
-        [asyncResp, callback](const boost::system::error_code& ec,
-                              const std::vector<uint8_t>& enabledFuncs) {
-        if (ec)
-        {
-            BMCWEB_LOG_ERROR << "Get Enabled Panel Functions D-bus error: "
-                             << ec.value();
-            messages::internalError(asyncResp->res);
-            return;
-        }
-        callback(enabledFuncs);
-    },
-        "com.ibm.PanelApp", "/com/ibm/panel_app", "com.ibm.panel",
-        "getEnabledFunctions");
+    });
 }
 
 /*
@@ -2470,8 +2632,7 @@ inline void requestRoutesSystemsCollection(App& app)
         asyncResp->res.jsonValue["@odata.id"] = "/redfish/v1/Systems";
         asyncResp->res.jsonValue["Name"] = "Computer System Collection";
 
-        sdbusplus::asio::getProperty<std::string>(
-            *crow::connections::systemBus,
+        dbus::utility::getPropertyBatched<std::string>(
             "xyz.openbmc_project.Network.Hypervisor",
             "/xyz/openbmc_project/network/hypervisor/config",
             "xyz.openbmc_project.Network.SystemConfiguration", "HostName",
@@ -2740,10 +2901,16 @@ inline void requestRoutesSystems(App& app)
         .methods(boost::beast::http::verb::get)(
             [&app](const crow::Request& req,
                    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp) {
-        if (!redfish::setUpRedfishRoute(app, req, asyncResp))
+        query_param::QueryCapabilities capabilities = {
+            .canPruneBySelect = true,
+        };
+        query_param::Query delegatedQuery;
+        if (!redfish::setUpRedfishRouteWithDelegation(
+                app, req, asyncResp, delegatedQuery, capabilities))
         {
             return;
         }
+        const query_param::SelectTrie& select = delegatedQuery.selectTrie;
 
         std::string systemName = "system";
         asyncResp->res.addHeader(
@@ -2847,16 +3014,25 @@ inline void requestRoutesSystems(App& app)
 
         // TODO (Gunnar): Remove IndicatorLED after enough time has passed
         getIndicatorLedState(asyncResp);
-        getComputerSystem(asyncResp);
+        getComputerSystem(asyncResp, select);
         getHostState(asyncResp);
-        getBootProgress(asyncResp);
-        getBootProgressLastStateTime(asyncResp);
+        if (select.isAnySelected({"BootProgress"}))
+        {
+            getBootProgress(asyncResp);
+            getBootProgressLastStateTime(asyncResp);
+        }
         getPCIeDeviceList(asyncResp, "PCIeDevices");
         getHostWatchdogTimer(asyncResp);
         getPowerRestorePolicy(asyncResp);
         getStopBootOnFault(asyncResp);
-        getAutomaticRetry(asyncResp);
-        getLastResetTime(asyncResp);
+        if (select.isAnySelected({"Boot"}))
+        {
+            getAutomaticRetry(asyncResp);
+        }
+        if (select.isAnySelected({"LastResetTime"}))
+        {
+            getLastResetTime(asyncResp);
+        }
 #ifdef BMCWEB_ENABLE_IBM_LED_EXTENSIONS
         getLampTestState(asyncResp);
         getSAI(asyncResp, "PartitionSystemAttentionIndicator");
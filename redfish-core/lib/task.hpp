@@ -18,8 +18,10 @@
 #include "app.hpp"
 #include "dbus_utility.hpp"
 #include "event_service_manager.hpp"
+#include "http_utility.hpp"
 #include "query.hpp"
 #include "registries/privilege_registry.hpp"
+#include "server_sent_events.hpp"
 #include "task_messages.hpp"
 
 #include <boost/asio/post.hpp>
@@ -27,8 +29,18 @@
 #include <boost/url/format.hpp>
 #include <sdbusplus/bus/match.hpp>
 
+#include <algorithm>
+#include <charconv>
 #include <chrono>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
 #include <variant>
+#include <vector>
 
 namespace redfish
 {
@@ -37,10 +49,52 @@ namespace task
 {
 constexpr size_t maxTaskCount = 100; // arbitrary limit
 
+// Indexes are handed out in order and the oldest task is dropped first, so
+// the task with index i is at tasks[i - tasks.front()->index]
 static std::deque<std::shared_ptr<struct TaskData>> tasks;
 
 constexpr bool completed = true;
 
+// Longest a Monitor GET is held for a "Prefer: wait" before it is answered
+constexpr std::chrono::seconds maxMonitorWait{60};
+
+/**
+ * @brief Keeps one bus match per distinct match rule, shared by every task
+ * waiting on it, so concurrent tasks watching the same object don't each add
+ * a rule to the bus daemon.
+ */
+class TaskMatchDispatcher
+{
+  public:
+    static TaskMatchDispatcher& getInstance()
+    {
+        static TaskMatchDispatcher dispatcher;
+        return dispatcher;
+    }
+
+    TaskMatchDispatcher(const TaskMatchDispatcher&) = delete;
+    TaskMatchDispatcher& operator=(const TaskMatchDispatcher&) = delete;
+    TaskMatchDispatcher(TaskMatchDispatcher&&) = delete;
+    TaskMatchDispatcher& operator=(TaskMatchDispatcher&&) = delete;
+    ~TaskMatchDispatcher() = default;
+
+    void add(const std::shared_ptr<TaskData>& task);
+    void remove(TaskData& task);
+
+  private:
+    TaskMatchDispatcher() = default;
+
+    void dispatch(const std::string& matchStr, sdbusplus::message_t& message);
+
+    struct Rule
+    {
+        std::unique_ptr<sdbusplus::bus::match_t> match;
+        std::vector<std::shared_ptr<TaskData>> tasks;
+    };
+
+    std::unordered_map<std::string, Rule> rules;
+};
+
 struct Payload
 {
     explicit Payload(const crow::Request& req) :
@@ -126,7 +180,7 @@ struct TaskData : std::enable_shared_from_this<TaskData>
 
             // destroy all references
             last->timer.cancel();
-            last->match.reset();
+            TaskMatchDispatcher::getInstance().remove(*last);
             tasks.pop_front();
         }
 
@@ -180,7 +234,7 @@ struct TaskData : std::enable_shared_from_this<TaskData>
                 // change ec to error as timer expired
                 ec = boost::asio::error::operation_aborted;
             }
-            self->match.reset();
+            TaskMatchDispatcher::getInstance().remove(*self);
             sdbusplus::message_t msg;
             self->finishTask();
             self->state = "Cancelled";
@@ -189,6 +243,7 @@ struct TaskData : std::enable_shared_from_this<TaskData>
                 std::to_string(self->index), "None", "None", "None"));
             self->sendTaskEvent(self->state, self->index);
             self->callback(ec, msg, self);
+            self->notifyChange();
         });
     }
 
@@ -264,35 +319,64 @@ struct TaskData : std::enable_shared_from_this<TaskData>
         }
     }
 
-    void startTimer(const std::chrono::seconds& timeout)
+    /**
+     * @brief Tells the Monitor clients waiting on this task that its
+     * TaskState, TaskStatus or PercentComplete may have changed.  Hanging
+     * GETs are answered, and each progress stream gets an event; the streams
+     * end once the task has.
+     */
+    void notifyChange()
     {
-        if (match)
+        std::shared_ptr<const std::string> event = progressEvent();
+        std::vector<std::weak_ptr<crow::SseStream>> open;
+        for (const std::weak_ptr<crow::SseStream>& weakStream : streams)
         {
-            return;
+            std::shared_ptr<crow::SseStream> stream = weakStream.lock();
+            if (stream == nullptr)
+            {
+                continue;
+            }
+            stream->push(event);
+            if (endTime)
+            {
+                stream->finish();
+                continue;
+            }
+            open.emplace_back(stream);
         }
-        match = std::make_unique<sdbusplus::bus::match_t>(
-            static_cast<sdbusplus::bus_t&>(*crow::connections::systemBus),
-            matchStr,
-            [self = shared_from_this()](sdbusplus::message_t& message) {
-            boost::system::error_code ec;
+        streams = std::move(open);
 
-            // callback to return True if callback is done, callback needs
-            // to update status itself if needed
-            if (self->callback(ec, message, self) == task::completed)
-            {
-                self->timer.cancel();
-                self->finishTask();
+        // A waiter may start waiting again from inside its own call
+        std::vector<std::function<void()>> waiting;
+        waiting.swap(waiters);
+        for (std::function<void()>& waiter : waiting)
+        {
+            waiter();
+        }
+    }
 
-                // Send event
-                self->sendTaskEvent(self->state, self->index);
+    // The text/event-stream event for where the task is now
+    std::shared_ptr<const std::string> progressEvent() const
+    {
+        nlohmann::json::object_t progress;
+        progress["Id"] = std::to_string(index);
+        progress["TaskState"] = state;
+        progress["TaskStatus"] = status;
+        progress["PercentComplete"] = percentComplete;
+        std::string data = nlohmann::json(std::move(progress))
+                               .dump(-1, ' ', true,
+                                     nlohmann::json::error_handler_t::replace);
+        return std::make_shared<const std::string>(
+            crow::formatSseEvent("", data));
+    }
 
-                // reset the match after the callback was successful
-                boost::asio::post(
-                    crow::connections::systemBus->get_io_context(),
-                    [self] { self->match.reset(); });
-                return;
-            }
-        });
+    void startTimer(const std::chrono::seconds& timeout)
+    {
+        if (matched)
+        {
+            return;
+        }
+        TaskMatchDispatcher::getInstance().add(shared_from_this());
 
         extendTimer(timeout);
         messages.emplace_back(messages::taskStarted(std::to_string(index)));
@@ -300,6 +384,47 @@ struct TaskData : std::enable_shared_from_this<TaskData>
         sendTaskEvent(state, index);
     }
 
+    // Called by the TaskMatchDispatcher for each signal matching matchStr
+    void handleSignal(sdbusplus::message_t& message)
+    {
+        boost::system::error_code ec;
+        int lastPercentComplete = percentComplete;
+        std::string lastState = state;
+        std::string lastStatus = status;
+
+        // callback to return True if callback is done, callback needs
+        // to update status itself if needed
+        if (callback(ec, message, shared_from_this()) == task::completed)
+        {
+            timer.cancel();
+            finishTask();
+
+            // Send event
+            sendTaskEvent(state, index);
+
+            // Stop matching once the callback was successful
+            TaskMatchDispatcher::getInstance().remove(*this);
+            notifyChange();
+            return;
+        }
+        if (state != lastState || status != lastStatus ||
+            percentComplete != lastPercentComplete)
+        {
+            notifyChange();
+        }
+        if (percentComplete != lastPercentComplete && percentComplete >= 0)
+        {
+            // Pushed to event subscribers, including SSE, so that progress
+            // doesn't have to be polled from the Task
+            redfish::EventServiceManager::getInstance().sendEvent(
+                redfish::messages::taskProgressChanged(
+                    std::to_string(index),
+                    static_cast<size_t>(percentComplete)),
+                "/redfish/v1/TaskService/Tasks/" + std::to_string(index),
+                "Task");
+        }
+    }
+
     std::function<bool(boost::system::error_code, sdbusplus::message_t&,
                        const std::shared_ptr<TaskData>&)>
         callback;
@@ -310,13 +435,170 @@ struct TaskData : std::enable_shared_from_this<TaskData>
     std::string state;
     nlohmann::json messages;
     boost::asio::steady_timer timer;
-    std::unique_ptr<sdbusplus::bus::match_t> match;
+    // Registered with the TaskMatchDispatcher
+    bool matched = false;
     std::optional<time_t> endTime;
     std::optional<Payload> payload;
     bool gave204 = false;
     int percentComplete = 0;
+    // Hanging Monitor GETs, each called once on the next change
+    std::vector<std::function<void()>> waiters;
+    // Monitor GETs streaming progress as text/event-stream
+    std::vector<std::weak_ptr<crow::SseStream>> streams;
 };
 
+inline void TaskMatchDispatcher::add(const std::shared_ptr<TaskData>& task)
+{
+    task->matched = true;
+    Rule& rule = rules[task->matchStr];
+    rule.tasks.emplace_back(task);
+    if (rule.match)
+    {
+        return;
+    }
+    rule.match = std::make_unique<sdbusplus::bus::match_t>(
+        static_cast<sdbusplus::bus_t&>(*crow::connections::systemBus),
+        task->matchStr,
+        [this, matchStr = task->matchStr](sdbusplus::message_t& message) {
+        dispatch(matchStr, message);
+    });
+}
+
+inline void TaskMatchDispatcher::remove(TaskData& task)
+{
+    if (!task.matched)
+    {
+        return;
+    }
+    task.matched = false;
+    auto it = rules.find(task.matchStr);
+    if (it == rules.end())
+    {
+        return;
+    }
+    std::erase_if(it->second.tasks,
+                  [&task](const std::shared_ptr<TaskData>& waiting) {
+        return waiting.get() == &task;
+    });
+    if (!it->second.tasks.empty())
+    {
+        return;
+    }
+    // This may be called from the match's own callback, so it is released
+    // once that has returned
+    std::shared_ptr<sdbusplus::bus::match_t> match =
+        std::move(it->second.match);
+    rules.erase(it);
+    boost::asio::post(crow::connections::systemBus->get_io_context(),
+                      [match] {});
+}
+
+inline void TaskMatchDispatcher::dispatch(const std::string& matchStr,
+                                          sdbusplus::message_t& message)
+{
+    auto it = rules.find(matchStr);
+    if (it == rules.end())
+    {
+        return;
+    }
+    // Tasks finish, and so leave the rule, from inside handleSignal
+    std::vector<std::shared_ptr<TaskData>> waiting = it->second.tasks;
+    for (const std::shared_ptr<TaskData>& task : waiting)
+    {
+        if (!task->matched)
+        {
+            continue;
+        }
+        // Every task reads the message from the start
+        sd_bus_message_rewind(message.get(), 1);
+        task->handleSignal(message);
+    }
+}
+
+// Finds a task by its Id in constant time
+inline std::shared_ptr<TaskData> getTask(std::string_view id)
+{
+    size_t index = 0;
+    const char* end = id.data() + id.size();
+    auto [ptr, ec] = std::from_chars(id.data(), end, index);
+    // Only the canonical spelling of an index names it
+    if (ec != std::errc() || ptr != end || (id.size() > 1 && id[0] == '0'))
+    {
+        return nullptr;
+    }
+    if (tasks.empty() || index < tasks.front()->index)
+    {
+        return nullptr;
+    }
+    size_t offset = index - tasks.front()->index;
+    if (offset >= tasks.size())
+    {
+        return nullptr;
+    }
+    return tasks[offset];
+}
+
+/**
+ * @brief Holds a Monitor GET until the task next changes, or until wait, up
+ * to maxMonitorWait, has passed, then answers it as a plain GET would be.
+ */
+inline void waitOnMonitor(const crow::Request& req,
+                          const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+                          const std::shared_ptr<TaskData>& task,
+                          std::chrono::seconds wait)
+{
+    wait = std::min(wait, maxMonitorWait);
+    auto timer = std::make_shared<boost::asio::steady_timer>(*req.ioService);
+    timer->expires_after(wait);
+    // The response goes out once the timer handler lets go of asyncResp,
+    // however the timer ended
+    timer->async_wait([timer, asyncResp,
+                       task](const boost::system::error_code& /*ec*/) {
+        task->populateResp(asyncResp->res);
+    });
+    task->waiters.emplace_back(
+        [weakTimer{std::weak_ptr<boost::asio::steady_timer>(timer)}]() {
+        std::shared_ptr<boost::asio::steady_timer> pending = weakTimer.lock();
+        if (pending != nullptr)
+        {
+            pending->cancel();
+        }
+    });
+    asyncResp->res.addHeader("Preference-Applied",
+                             "wait=" + std::to_string(wait.count()));
+}
+
+/**
+ * @brief Answers a Monitor GET with a text/event-stream of the task's
+ * TaskState and PercentComplete transitions, ending when the task does.
+ */
+inline void streamMonitor(const crow::Request& req,
+                          const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+                          const std::shared_ptr<TaskData>& task)
+{
+    auto stream = std::make_shared<crow::SseStream>(*req.ioService);
+    // The first event is where the task is now, so a client that subscribed
+    // late, or after the end, isn't left waiting
+    stream->push(task->progressEvent());
+    if (task->endTime)
+    {
+        stream->finish();
+    }
+    else
+    {
+        task->streams.emplace_back(stream);
+    }
+
+    asyncResp->res.addHeader(boost::beast::http::field::content_type,
+                             "text/event-stream");
+    asyncResp->res.addHeader(boost::beast::http::field::cache_control,
+                             "no-cache");
+    asyncResp->res.setAsyncBodyGenerator(
+        [stream](crow::Response::BodyChunkHandler&& done) {
+        stream->pull(std::move(done));
+    });
+}
+
 } // namespace task
 
 inline void requestRoutesTaskMonitor(App& app)
@@ -331,31 +613,31 @@ inline void requestRoutesTaskMonitor(App& app)
         {
             return;
         }
-        auto find = std::find_if(
-            task::tasks.begin(), task::tasks.end(),
-            [&strParam](const std::shared_ptr<task::TaskData>& task) {
-            if (!task)
-            {
-                return false;
-            }
-
-            // we compare against the string version as on failure
-            // strtoul returns 0
-            return std::to_string(task->index) == strParam;
-        });
-
-        if (find == task::tasks.end())
+        std::shared_ptr<task::TaskData> ptr = task::getTask(strParam);
+        if (ptr == nullptr)
         {
             messages::resourceNotFound(asyncResp->res, "Task", strParam);
             return;
         }
-        std::shared_ptr<task::TaskData>& ptr = *find;
         // monitor expires after 204
         if (ptr->gave204)
         {
             messages::resourceNotFound(asyncResp->res, "Task", strParam);
             return;
         }
+        if (req.getHeaderValue(boost::beast::http::field::accept)
+                .find("text/event-stream") != std::string_view::npos)
+        {
+            task::streamMonitor(req, asyncResp, ptr);
+            return;
+        }
+        std::optional<std::chrono::seconds> wait =
+            http_helpers::getPreferredWait(req.getHeaderValue("Prefer"));
+        if (wait && *wait > std::chrono::seconds(0) && !ptr->endTime)
+        {
+            task::waitOnMonitor(req, asyncResp, ptr, *wait);
+            return;
+        }
         ptr->populateResp(asyncResp->res);
     });
 }
@@ -372,27 +654,13 @@ inline void requestRoutesTask(App& app)
         {
             return;
         }
-        auto find = std::find_if(
-            task::tasks.begin(), task::tasks.end(),
-            [&strParam](const std::shared_ptr<task::TaskData>& task) {
-            if (!task)
-            {
-                return false;
-            }
-
-            // we compare against the string version as on failure
-            // strtoul returns 0
-            return std::to_string(task->index) == strParam;
-        });
-
-        if (find == task::tasks.end())
+        std::shared_ptr<task::TaskData> ptr = task::getTask(strParam);
+        if (ptr == nullptr)
         {
             messages::resourceNotFound(asyncResp->res, "Task", strParam);
             return;
         }
 
-        const std::shared_ptr<task::TaskData>& ptr = *find;
-
         asyncResp->res.jsonValue["@odata.type"] = "#Task.v1_4_3.Task";
         asyncResp->res.jsonValue["Id"] = strParam;
         asyncResp->res.jsonValue["Name"] = "Task " + strParam;
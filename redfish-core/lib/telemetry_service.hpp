@@ -35,6 +35,8 @@ inline void handleTelemetryServiceGet(
         "/redfish/v1/TelemetryService/MetricDefinitions";
     asyncResp->res.jsonValue["Triggers"]["@odata.id"] =
         "/redfish/v1/TelemetryService/Triggers";
+    asyncResp->res.jsonValue["Oem"]["OpenBMC"]["SensorReadings"]["@odata.id"] =
+        "/redfish/v1/TelemetryService/Oem/OpenBMC/SensorReadings";
 
     sdbusplus::asio::getAllProperties(
         *crow::connections::systemBus, telemetry::service,
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "utils/collection.hpp"
+#include "utils/telemetry_config_cache.hpp"
 #include "utils/telemetry_utils.hpp"
 
 #include <app.hpp>
@@ -18,27 +19,6 @@ namespace redfish
 {
 namespace telemetry
 {
-constexpr const char* triggerInterface =
-    "xyz.openbmc_project.Telemetry.Trigger";
-
-using NumericThresholdParams =
-    std::tuple<std::string, uint64_t, std::string, double>;
-
-using DiscreteThresholdParams =
-    std::tuple<std::string, std::string, uint64_t, std::string>;
-
-using TriggerThresholdParamsExt =
-    std::variant<std::monostate, std::vector<NumericThresholdParams>,
-                 std::vector<DiscreteThresholdParams>>;
-
-using TriggerSensorsParams =
-    std::vector<std::pair<sdbusplus::message::object_path, std::string>>;
-
-using TriggerGetParamsVariant =
-    std::variant<std::monostate, bool, std::string, TriggerThresholdParamsExt,
-                 TriggerSensorsParams, std::vector<std::string>,
-                 std::vector<sdbusplus::message::object_path>>;
-
 inline std::optional<std::string>
     getRedfishFromDbusAction(const std::string& dbusAction)
 {
@@ -180,10 +160,8 @@ inline std::vector<std::string>
     return metricProperties;
 }
 
-inline bool fillTrigger(
-    nlohmann::json& json, const std::string& id,
-    const std::vector<std::pair<std::string, TriggerGetParamsVariant>>&
-        properties)
+inline bool fillTrigger(nlohmann::json& json, const std::string& id,
+                        const TriggerPropertiesMap& properties)
 {
     const std::string* name = nullptr;
     const bool* discrete = nullptr;
@@ -304,6 +282,24 @@ inline void requestRoutesTriggerCollection(App& app)
         asyncResp->res.jsonValue["@odata.id"] =
             "/redfish/v1/TelemetryService/Triggers";
         asyncResp->res.jsonValue["Name"] = "Triggers Collection";
+        telemetry::TelemetryConfigCache& configCache =
+            telemetry::TelemetryConfigCache::getInstance();
+        if (configCache.enabled())
+        {
+            configCache.get(
+                [asyncResp](const boost::system::error_code& ec,
+                            const std::shared_ptr<
+                                const telemetry::TelemetryConfig>& config) {
+                if (ec || config == nullptr)
+                {
+                    messages::internalError(asyncResp->res);
+                    return;
+                }
+                telemetry::fillResourceMembers(
+                    asyncResp->res.jsonValue, config->triggers, "Triggers");
+            });
+            return;
+        }
         constexpr std::array<std::string_view, 1> interfaces{
             telemetry::triggerInterface};
         collection_util::getCollectionMembers(
@@ -316,6 +312,17 @@ inline void requestRoutesTriggerCollection(App& app)
 
 inline void requestRoutesTrigger(App& app)
 {
+    telemetry::TelemetryConfigCache::getInstance().setTriggerRenderer(
+        [](const std::string& id, const telemetry::TriggerPropertiesMap& props)
+            -> std::optional<nlohmann::json> {
+        nlohmann::json json;
+        if (!telemetry::fillTrigger(json, id, props))
+        {
+            return std::nullopt;
+        }
+        return json;
+    });
+
     BMCWEB_ROUTE(app, "/redfish/v1/TelemetryService/Triggers/<str>/")
         .privileges(redfish::privileges::getTriggers)
         .methods(boost::beast::http::verb::get)(
@@ -326,13 +333,30 @@ inline void requestRoutesTrigger(App& app)
         {
             return;
         }
+        telemetry::TelemetryConfigCache& configCache =
+            telemetry::TelemetryConfigCache::getInstance();
+        if (configCache.enabled())
+        {
+            configCache.get(
+                [asyncResp,
+                 id](const boost::system::error_code& ec,
+                     const std::shared_ptr<const telemetry::TelemetryConfig>&
+                         config) {
+                if (ec || config == nullptr)
+                {
+                    messages::internalError(asyncResp->res);
+                    return;
+                }
+                telemetry::fillResource(asyncResp, config->triggers,
+                                        "Triggers", id);
+            });
+            return;
+        }
         sdbusplus::asio::getAllProperties(
             *crow::connections::systemBus, telemetry::service,
             telemetry::getDbusTriggerPath(id), telemetry::triggerInterface,
-            [asyncResp,
-             id](const boost::system::error_code ec,
-                 const std::vector<std::pair<
-                     std::string, telemetry::TriggerGetParamsVariant>>& ret) {
+            [asyncResp, id](const boost::system::error_code ec,
+                            const telemetry::TriggerPropertiesMap& ret) {
             if (ec.value() == EBADR ||
                 ec == boost::system::errc::host_unreachable)
             {
@@ -380,6 +404,7 @@ inline void requestRoutesTrigger(App& app)
                 return;
             }
 
+            telemetry::TelemetryConfigCache::getInstance().clear();
             asyncResp->res.result(boost::beast::http::status::no_content);
         },
             telemetry::service, triggerPath,
@@ -20,30 +20,19 @@
 #include <app.hpp>
 #include <boost/range/adaptor/reversed.hpp>
 #include <dbus_utility.hpp>
+#include <multipart_parser.hpp>
 #include <query.hpp>
 #include <registries/privilege_registry.hpp>
 #include <sdbusplus/asio/property.hpp>
 #include <sdbusplus/unpack_properties.hpp>
+#include <software_update.hpp>
+#include <upload_body.hpp>
 #include <utils/dbus_utils.hpp>
 #include <utils/sw_utils.hpp>
 
 namespace redfish
 {
 
-// Match signals added on software path
-static std::unique_ptr<sdbusplus::bus::match_t> fwUpdateMatcher;
-static std::unique_ptr<sdbusplus::bus::match_t> fwUpdateErrorMatcher;
-// Only allow one update at a time
-static bool fwUpdateInProgress = false;
-// Timer for software available
-static std::unique_ptr<boost::asio::steady_timer> fwAvailableTimer;
-
-inline static void cleanUp()
-{
-    fwUpdateInProgress = false;
-    fwUpdateMatcher = nullptr;
-    fwUpdateErrorMatcher = nullptr;
-}
 inline static void activateImage(const std::string& objPath,
                                  const std::string& service)
 {
@@ -160,218 +149,164 @@ inline void
 }
 
 // Note that asyncResp can be either a valid pointer or nullptr. If nullptr
-// then no asyncResp updates will occur
-static void
-    softwareInterfaceAdded(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-                           sdbusplus::message_t& m, task::Payload&& payload)
+// then no asyncResp updates will occur.  Returns true if the image was
+// picked up.
+static bool softwareInterfaceAdded(
+    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+    task::Payload& payload, sdbusplus::message_t& m,
+    const sdbusplus::message::object_path& objPath,
+    const dbus::utility::DBusInteracesMap& interfacesProperties)
 {
-    dbus::utility::DBusInteracesMap interfacesProperties;
-
-    sdbusplus::message::object_path objPath;
-
-    m.read(objPath, interfacesProperties);
-
-    BMCWEB_LOG_DEBUG << "obj path = " << objPath.str;
-    for (auto& interface : interfacesProperties)
+    for (const auto& interface : interfacesProperties)
     {
         BMCWEB_LOG_DEBUG << "interface = " << interface.first;
 
         if (interface.first == "xyz.openbmc_project.Software.Activation")
         {
-            // Retrieve service and activate
-            crow::connections::systemBus->async_method_call(
-                [objPath, asyncResp, payload(std::move(payload))](
-                    const boost::system::error_code errorCode,
-                    const std::vector<
-                        std::pair<std::string, std::vector<std::string>>>&
-                        objInfo) mutable {
-                if (errorCode)
-                {
-                    BMCWEB_LOG_DEBUG << "error_code = " << errorCode;
-                    BMCWEB_LOG_DEBUG << "error msg = " << errorCode.message();
-                    if (asyncResp)
-                    {
-                        messages::internalError(asyncResp->res);
-                    }
-                    cleanUp();
-                    return;
-                }
-                // Ensure we only got one service back
-                if (objInfo.size() != 1)
-                {
-                    BMCWEB_LOG_ERROR << "Invalid Object Size "
-                                     << objInfo.size();
-                    if (asyncResp)
+            // The software manager that sent the signal owns the image, so
+            // activate it there straight away rather than asking the mapper
+            activateImage(objPath.str, m.get_sender());
+            if (asyncResp)
+            {
+                std::shared_ptr<task::TaskData> task =
+                    task::TaskData::createTask(
+                        [](boost::system::error_code ec,
+                           sdbusplus::message_t& msg,
+                           const std::shared_ptr<task::TaskData>& taskData) {
+                    if (ec)
                     {
-                        messages::internalError(asyncResp->res);
+                        return task::completed;
                     }
-                    cleanUp();
-                    return;
-                }
-                // cancel timer only when
-                // xyz.openbmc_project.Software.Activation interface
-                // is added
-                fwAvailableTimer = nullptr;
 
-                activateImage(objPath.str, objInfo[0].first);
-                if (asyncResp)
-                {
-                    std::shared_ptr<task::TaskData> task =
-                        task::TaskData::createTask(
-                            [](boost::system::error_code ec,
-                               sdbusplus::message_t& msg,
-                               const std::shared_ptr<task::TaskData>&
-                                   taskData) {
-                        if (ec)
-                        {
-                            return task::completed;
-                        }
-
-                        std::string iface;
-                        dbus::utility::DBusPropertiesMap values;
+                    std::string iface;
+                    dbus::utility::DBusPropertiesMap values;
 
-                        std::string index = std::to_string(taskData->index);
-                        msg.read(iface, values);
+                    std::string index = std::to_string(taskData->index);
+                    msg.read(iface, values);
 
-                        if (iface == "xyz.openbmc_project.Software.Activation")
+                    if (iface == "xyz.openbmc_project.Software.Activation")
+                    {
+                        const std::string* state = nullptr;
+                        for (const auto& property : values)
                         {
-                            const std::string* state = nullptr;
-                            for (const auto& property : values)
+                            if (property.first == "Activation")
                             {
-                                if (property.first == "Activation")
+                                state = std::get_if<std::string>(
+                                    &property.second);
+                                if (state == nullptr)
                                 {
-                                    state = std::get_if<std::string>(
-                                        &property.second);
-                                    if (state == nullptr)
-                                    {
-                                        taskData->messages.emplace_back(
-                                            messages::internalError());
-                                        return task::completed;
-                                    }
+                                    taskData->messages.emplace_back(
+                                        messages::internalError());
+                                    return task::completed;
                                 }
                             }
+                        }
 
-                            if (state == nullptr)
-                            {
-                                return !task::completed;
-                            }
+                        if (state == nullptr)
+                        {
+                            return !task::completed;
+                        }
 
-                            if (state->ends_with("Invalid") ||
-                                state->ends_with("Failed"))
-                            {
-                                taskData->state = "Exception";
-                                taskData->status = "Warning";
-                                updateErrorLogMessage(taskData, index);
-                                return task::completed;
-                            }
+                        if (state->ends_with("Invalid") ||
+                            state->ends_with("Failed"))
+                        {
+                            taskData->state = "Exception";
+                            taskData->status = "Warning";
+                            updateErrorLogMessage(taskData, index);
+                            return task::completed;
+                        }
 
-                            if (state->ends_with("Staged"))
-                            {
-                                taskData->state = "Stopping";
-                                taskData->messages.emplace_back(
-                                    messages::taskPaused(index));
-
-                                // its staged, set a long timer to
-                                // allow them time to complete the
-                                // update (probably cycle the
-                                // system) if this expires then
-                                // task will be cancelled
-                                taskData->extendTimer(std::chrono::hours(5));
-                                return !task::completed;
-                            }
+                        if (state->ends_with("Staged"))
+                        {
+                            taskData->state = "Stopping";
+                            taskData->messages.emplace_back(
+                                messages::taskPaused(index));
+
+                            // its staged, set a long timer to
+                            // allow them time to complete the
+                            // update (probably cycle the
+                            // system) if this expires then
+                            // task will be cancelled
+                            taskData->extendTimer(std::chrono::hours(5));
+                            return !task::completed;
+                        }
 
-                            if (state->ends_with("Active"))
-                            {
-                                taskData->messages.emplace_back(
-                                    messages::taskCompletedOK(index));
-                                taskData->state = "Completed";
-                                return task::completed;
-                            }
+                        if (state->ends_with("Active"))
+                        {
+                            taskData->messages.emplace_back(
+                                messages::taskCompletedOK(index));
+                            taskData->state = "Completed";
+                            return task::completed;
                         }
-                        else if (
-                            iface ==
-                            "xyz.openbmc_project.Software.ActivationProgress")
+                    }
+                    else if (
+                        iface ==
+                        "xyz.openbmc_project.Software.ActivationProgress")
+                    {
+                        const uint8_t* progress = nullptr;
+                        for (const auto& property : values)
                         {
-                            const uint8_t* progress = nullptr;
-                            for (const auto& property : values)
+                            if (property.first == "Progress")
                             {
-                                if (property.first == "Progress")
+                                progress =
+                                    std::get_if<uint8_t>(&property.second);
+                                if (progress == nullptr)
                                 {
-                                    progress =
-                                        std::get_if<uint8_t>(&property.second);
-                                    if (progress == nullptr)
-                                    {
-                                        taskData->messages.emplace_back(
-                                            messages::internalError());
-                                        return task::completed;
-                                    }
+                                    taskData->messages.emplace_back(
+                                        messages::internalError());
+                                    return task::completed;
                                 }
                             }
+                        }
 
-                            if (progress == nullptr)
-                            {
-                                return !task::completed;
-                            }
-                            taskData->percentComplete = *progress;
-                            taskData->messages.emplace_back(
-                                messages::taskProgressChanged(index,
-                                                              *progress));
-
-                            // if we're getting status updates it's
-                            // still alive, update timer
-                            taskData->extendTimer(std::chrono::minutes(5));
+                        if (progress == nullptr)
+                        {
+                            return !task::completed;
                         }
+                        taskData->percentComplete = *progress;
+                        taskData->messages.emplace_back(
+                            messages::taskProgressChanged(index,
+                                                          *progress));
+
+                        // if we're getting status updates it's
+                        // still alive, update timer
+                        taskData->extendTimer(std::chrono::minutes(5));
+                    }
 
-                        // as firmware update often results in a
-                        // reboot, the task  may never "complete"
-                        // unless it is an error
-
-                        return !task::completed;
-                    },
-                            "type='signal',interface='org.freedesktop.DBus.Properties',"
-                            "member='PropertiesChanged',path='" +
-                                objPath.str + "'");
-                    task->startTimer(std::chrono::minutes(5));
-                    task->populateResp(asyncResp->res);
-                    task->payload.emplace(std::move(payload));
-                }
-                fwUpdateInProgress = false;
-            },
-                "xyz.openbmc_project.ObjectMapper",
-                "/xyz/openbmc_project/object_mapper",
-                "xyz.openbmc_project.ObjectMapper", "GetObject", objPath.str,
-                std::array<const char*, 1>{
-                    "xyz.openbmc_project.Software.Activation"});
-
-            break;
+                    // as firmware update often results in a
+                    // reboot, the task  may never "complete"
+                    // unless it is an error
+
+                    return !task::completed;
+                },
+                        "type='signal',interface='org.freedesktop.DBus.Properties',"
+                        "member='PropertiesChanged',path='" +
+                            objPath.str + "'");
+                task->startTimer(std::chrono::minutes(5));
+                task->populateResp(asyncResp->res);
+                task->payload.emplace(std::move(payload));
+            }
+            // Only the xyz.openbmc_project.Software.Activation interface
+            // ends the wait for the image
+            return true;
         }
     }
+    return false;
 }
 
-inline void afterAvailbleTimerAsyncWait(
-    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-    const boost::system::error_code& ec)
+inline void afterSoftwareAvailableTimeout(
+    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
 {
-    cleanUp();
-    if (ec == boost::asio::error::operation_aborted)
-    {
-        // expected, we were canceled before the timer completed.
-        return;
-    }
     BMCWEB_LOG_ERROR << "Timed out waiting for firmware object being created";
     BMCWEB_LOG_ERROR << "FW image may has already been uploaded to server";
-    if (ec)
-    {
-        BMCWEB_LOG_ERROR << "Async_wait failed" << ec;
-        return;
-    }
     if (asyncResp)
     {
         redfish::messages::internalError(asyncResp->res);
     }
 }
 
-inline void
+// Returns true if type is an error about a pushed image
+inline bool
     handleUpdateErrorType(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
                           const std::string& url, const std::string& type)
 {
@@ -432,20 +367,18 @@ inline void
         // Unrelated error types. Ignored
         BMCWEB_LOG_INFO << "Non-Software-related Error type=" << type
                         << ". Ignored";
-        return;
+        return false;
     }
-    // Clear the timer
-    fwAvailableTimer = nullptr;
+    return true;
 }
 
-inline void
-    afterUpdateErrorMatcher(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-                            const std::string& url, sdbusplus::message_t& m)
+// Returns true if the log entry was about the pushed image
+inline bool afterUpdateErrorMatcher(
+    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp, const std::string& url,
+    sdbusplus::message_t& /*m*/,
+    const sdbusplus::message::object_path& /*objPath*/,
+    const dbus::utility::DBusInteracesMap& interfacesProperties)
 {
-    dbus::utility::DBusInteracesMap interfacesProperties;
-    sdbusplus::message::object_path objPath;
-    m.read(objPath, interfacesProperties);
-    BMCWEB_LOG_DEBUG << "obj path = " << objPath.str;
     for (const std::pair<std::string, dbus::utility::DBusPropertiesMap>&
              interface : interfacesProperties)
     {
@@ -463,59 +396,56 @@ inline void
                 if (type == nullptr)
                 {
                     // if this was our message, timeout will cover it
-                    return;
+                    return false;
+                }
+                if (handleUpdateErrorType(asyncResp, url, *type))
+                {
+                    return true;
                 }
-                handleUpdateErrorType(asyncResp, url, *type);
             }
         }
     }
+    return false;
 }
 
 // Note that asyncResp can be either a valid pointer or nullptr. If nullptr
-// then no asyncResp updates will occur
-static void monitorForSoftwareAvailable(
+// then no asyncResp updates will occur.  Returns the image's ID in
+// crow::software_update::PendingImages, or nullopt if too many updates are
+// already in flight.
+static std::optional<uint64_t> monitorForSoftwareAvailable(
     const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
     const crow::Request& req, const std::string& url,
     int timeoutTimeSeconds = 55)
 {
-    // Only allow one FW update at a time
-    if (fwUpdateInProgress)
-    {
-        if (asyncResp)
-        {
-            messages::serviceTemporarilyUnavailable(asyncResp->res, "30");
-        }
-        return;
-    }
-
-    fwAvailableTimer =
-        std::make_unique<boost::asio::steady_timer>(*req.ioService);
-
-    fwAvailableTimer->expires_after(std::chrono::seconds(timeoutTimeSeconds));
-
-    fwAvailableTimer->async_wait(
-        std::bind_front(afterAvailbleTimerAsyncWait, asyncResp));
-
-    task::Payload payload(req);
-    auto callback = [asyncResp, payload](sdbusplus::message_t& m) mutable {
+    // Every image gets its own task, so several can be in flight at once
+    auto payload = std::make_shared<task::Payload>(req);
+    crow::software_update::PendingImage image;
+    image.onSoftwareAdded =
+        [asyncResp, payload](
+            sdbusplus::message_t& m,
+            const sdbusplus::message::object_path& objPath,
+            const dbus::utility::DBusInteracesMap& interfaces) {
         BMCWEB_LOG_DEBUG << "Match fired";
-        softwareInterfaceAdded(asyncResp, m, std::move(payload));
+        return softwareInterfaceAdded(asyncResp, *payload, m, objPath,
+                                      interfaces);
     };
-
-    fwUpdateInProgress = true;
-
-    fwUpdateMatcher = std::make_unique<sdbusplus::bus::match_t>(
-        *crow::connections::systemBus,
-        "interface='org.freedesktop.DBus.ObjectManager',type='signal',"
-        "member='InterfacesAdded',path='/xyz/openbmc_project/software'",
-        callback);
-
-    fwUpdateErrorMatcher = std::make_unique<sdbusplus::bus::match_t>(
-        *crow::connections::systemBus,
-        "interface='org.freedesktop.DBus.ObjectManager',type='signal',"
-        "member='InterfacesAdded',"
-        "path='/xyz/openbmc_project/logging'",
-        std::bind_front(afterUpdateErrorMatcher, asyncResp, url));
+    if (asyncResp)
+    {
+        image.onLogAdded = std::bind_front(afterUpdateErrorMatcher, asyncResp,
+                                           url);
+    }
+    image.onTimeout = std::bind_front(afterSoftwareAvailableTimeout,
+                                      asyncResp);
+
+    std::optional<uint64_t> id =
+        crow::software_update::PendingImages::getInstance().add(
+            *req.ioService, std::chrono::seconds(timeoutTimeSeconds),
+            std::move(image));
+    if (!id && asyncResp)
+    {
+        messages::serviceTemporarilyUnavailable(asyncResp->res, "30");
+    }
+    return id;
 }
 
 /**
@@ -611,10 +541,14 @@ inline void requestRoutesUpdateServiceActionsSimpleUpdate(App& app)
 
         // Setup callback for when new software detected
         // Give TFTP 10 minutes to complete
-        monitorForSoftwareAvailable(
+        std::optional<uint64_t> pendingId = monitorForSoftwareAvailable(
             asyncResp, req,
             "/redfish/v1/UpdateService/Actions/UpdateService.SimpleUpdate",
             600);
+        if (!pendingId)
+        {
+            return;
+        }
 
         // TFTP can take up to 10 minutes depending on image size and
         // connection speed. Return to caller as soon as the TFTP operation
@@ -624,11 +558,12 @@ inline void requestRoutesUpdateServiceActionsSimpleUpdate(App& app)
 
         // Call TFTP service
         crow::connections::systemBus->async_method_call(
-            [](const boost::system::error_code ec) {
+            [pendingId](const boost::system::error_code ec) {
             if (ec)
             {
                 // messages::internalError(asyncResp->res);
-                cleanUp();
+                crow::software_update::PendingImages::getInstance().remove(
+                    *pendingId);
                 BMCWEB_LOG_DEBUG << "error_code = " << ec;
                 BMCWEB_LOG_DEBUG << "error msg = " << ec.message();
             }
@@ -645,6 +580,107 @@ inline void requestRoutesUpdateServiceActionsSimpleUpdate(App& app)
     });
 }
 
+inline void setApplyTime(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+                         const std::string& applyTime)
+{
+    std::string applyTimeNewVal;
+    if (applyTime == "Immediate")
+    {
+        applyTimeNewVal =
+            "xyz.openbmc_project.Software.ApplyTime.RequestedApplyTimes.Immediate";
+    }
+    else if (applyTime == "OnReset")
+    {
+        applyTimeNewVal =
+            "xyz.openbmc_project.Software.ApplyTime.RequestedApplyTimes.OnReset";
+    }
+    else
+    {
+        BMCWEB_LOG_INFO
+            << "ApplyTime value is not in the list of acceptable values";
+        messages::propertyValueNotInList(asyncResp->res, applyTime,
+                                         "ApplyTime");
+        return;
+    }
+
+    // Set the requested image apply time value
+    crow::connections::systemBus->async_method_call(
+        [asyncResp](const boost::system::error_code ec) {
+        if (ec)
+        {
+            BMCWEB_LOG_ERROR << "D-Bus responses error: " << ec;
+            messages::internalError(asyncResp->res);
+            return;
+        }
+        messages::success(asyncResp->res);
+    },
+        "xyz.openbmc_project.Settings",
+        "/xyz/openbmc_project/software/apply_time",
+        "org.freedesktop.DBus.Properties", "Set",
+        "xyz.openbmc_project.Software.ApplyTime", "RequestedApplyTime",
+        dbus::utility::DbusVariantType{applyTimeNewVal});
+}
+
+#ifdef BMCWEB_ENABLE_REDFISH_MULTIPART_UPDATE
+// Applies the UpdateParameters part of a multipart push.  Returns false, with
+// the error in asyncResp, if the push should go no further.
+inline bool
+    applyUpdateParameters(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+                          const crow::UploadFile& upload)
+{
+    const FormPart* parameters = nullptr;
+    for (const FormPart& part : upload.parts())
+    {
+        auto it = part.fields.find("Content-Disposition");
+        if (it != part.fields.end() &&
+            it->value().find("name=\"UpdateParameters\"") !=
+                boost::beast::string_view::npos)
+        {
+            parameters = &part;
+        }
+    }
+    if (parameters == nullptr)
+    {
+        // UpdateParameters is optional; the defaults apply
+        return true;
+    }
+
+    nlohmann::json json = nlohmann::json::parse(parameters->content, nullptr,
+                                                false);
+    if (json.is_discarded())
+    {
+        messages::missingOrMalformedPart(asyncResp->res);
+        return false;
+    }
+    std::optional<std::vector<std::string>> targets;
+    std::optional<std::string> applyTime;
+    if (!json_util::readJson(json, asyncResp->res, "Targets", targets,
+                             "@Redfish.OperationApplyTime", applyTime))
+    {
+        return false;
+    }
+    if (targets)
+    {
+        // Images say which component they are for; only the BMC's own
+        // inventory can be named here
+        for (const std::string& target : *targets)
+        {
+            if (target != "/redfish/v1/Managers/bmc")
+            {
+                messages::propertyValueNotInList(asyncResp->res, target,
+                                                 "Targets");
+                return false;
+            }
+        }
+    }
+    if (applyTime)
+    {
+        setApplyTime(asyncResp, *applyTime);
+    }
+    return true;
+}
+#endif
+
 inline void
     handleUpdateServicePost(App& app, const crow::Request& req,
                             const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
@@ -656,18 +692,47 @@ inline void
     }
     BMCWEB_LOG_DEBUG << url << " doPost...";
 
+#ifdef BMCWEB_ENABLE_REDFISH_MULTIPART_UPDATE
+    // A MultipartHttpPushUri push; the image is the part with a filename
+    if (req.upload != nullptr && req.upload->isMultipart())
+    {
+        if (req.upload->multipartResult() != ParserError::PARSER_SUCCESS ||
+            req.upload->filePart() == nullptr)
+        {
+            BMCWEB_LOG_DEBUG << "Bad multipart push, ec "
+                             << static_cast<int>(
+                                    req.upload->multipartResult());
+            messages::missingOrMalformedPart(asyncResp->res);
+            return;
+        }
+        if (!applyUpdateParameters(asyncResp, *req.upload))
+        {
+            return;
+        }
+    }
+#endif
+
     // Setup callback for when new software detected
-    monitorForSoftwareAvailable(asyncResp, req, url);
+    std::optional<uint64_t> pendingId =
+        monitorForSoftwareAvailable(asyncResp, req, url);
+    if (!pendingId)
+    {
+        return;
+    }
 
     std::string filepath(
         "/tmp/images/" +
         boost::uuids::to_string(boost::uuids::random_generator()()));
-    BMCWEB_LOG_DEBUG << "Writing file to " << filepath;
-    std::ofstream out(filepath, std::ofstream::out | std::ofstream::binary |
-                                    std::ofstream::trunc);
-    out << req.body;
-    out.close();
-    BMCWEB_LOG_DEBUG << "file upload complete!!";
+    BMCWEB_LOG_DEBUG << "Moving upload to " << filepath;
+    // The body was written to disk as it arrived; see crow::UploadFile
+    if (req.upload == nullptr || !req.upload->moveTo(filepath))
+    {
+        crow::software_update::PendingImages::getInstance().remove(*pendingId);
+        messages::internalError(asyncResp->res);
+        return;
+    }
+    BMCWEB_LOG_INFO << "Received " << req.upload->size() << " byte image "
+                    << filepath << ", sha256 " << req.upload->sha256();
 }
 
 /**
@@ -679,6 +744,7 @@ inline void requestRoutesUpdateServiceActionsOemConcurrentUpdate(App& app)
     BMCWEB_ROUTE(app, "/redfish/v1/UpdateService/Actions/Oem/"
                       "OemUpdateService.ConcurrentUpdate/")
         .privileges(redfish::privileges::postUpdateService)
+        .fileUpload()
         .methods(boost::beast::http::verb::post)(std::bind_front(
             [&app](App&, const crow::Request& req,
                    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp) {
@@ -700,8 +766,14 @@ inline void requestRoutesUpdateService(App& app)
         {
             return;
         }
+#ifdef BMCWEB_ENABLE_REDFISH_MULTIPART_UPDATE
+        // MultipartHttpPushUri came in v1_11
+        asyncResp->res.jsonValue["@odata.type"] =
+            "#UpdateService.v1_11_1.UpdateService";
+#else
         asyncResp->res.jsonValue["@odata.type"] =
             "#UpdateService.v1_5_0.UpdateService";
+#endif
         asyncResp->res.jsonValue["@odata.id"] = "/redfish/v1/UpdateService";
         asyncResp->res.jsonValue["Id"] = "UpdateService";
         asyncResp->res.jsonValue["Description"] = "Service for Software Update";
@@ -718,6 +790,10 @@ inline void requestRoutesUpdateService(App& app)
 
         asyncResp->res.jsonValue["HttpPushUri"] =
             "/redfish/v1/UpdateService/update";
+#ifdef BMCWEB_ENABLE_REDFISH_MULTIPART_UPDATE
+        asyncResp->res.jsonValue["MultipartHttpPushUri"] =
+            "/redfish/v1/UpdateService/update";
+#endif
 
         // UpdateService cannot be disabled
         asyncResp->res.jsonValue["ServiceEnabled"] = true;
@@ -811,43 +887,7 @@ inline void requestRoutesUpdateService(App& app)
 
                 if (applyTime)
                 {
-                    std::string applyTimeNewVal;
-                    if (applyTime == "Immediate")
-                    {
-                        applyTimeNewVal =
-                            "xyz.openbmc_project.Software.ApplyTime.RequestedApplyTimes.Immediate";
-                    }
-                    else if (applyTime == "OnReset")
-                    {
-                        applyTimeNewVal =
-                            "xyz.openbmc_project.Software.ApplyTime.RequestedApplyTimes.OnReset";
-                    }
-                    else
-                    {
-                        BMCWEB_LOG_INFO
-                            << "ApplyTime value is not in the list of acceptable values";
-                        messages::propertyValueNotInList(
-                            asyncResp->res, *applyTime, "ApplyTime");
-                        return;
-                    }
-
-                    // Set the requested image apply time value
-                    crow::connections::systemBus->async_method_call(
-                        [asyncResp](const boost::system::error_code ec) {
-                        if (ec)
-                        {
-                            BMCWEB_LOG_ERROR << "D-Bus responses error: " << ec;
-                            messages::internalError(asyncResp->res);
-                            return;
-                        }
-                        messages::success(asyncResp->res);
-                    },
-                        "xyz.openbmc_project.Settings",
-                        "/xyz/openbmc_project/software/apply_time",
-                        "org.freedesktop.DBus.Properties", "Set",
-                        "xyz.openbmc_project.Software.ApplyTime",
-                        "RequestedApplyTime",
-                        dbus::utility::DbusVariantType{applyTimeNewVal});
+                    setApplyTime(asyncResp, *applyTime);
                 }
             }
         }
@@ -864,6 +904,7 @@ inline void requestRoutesUpdateService(App& app)
 #ifdef BMCWEB_ENABLE_REDFISH_UPDATESERVICE_OLD_POST_URL
     BMCWEB_ROUTE(app, "/redfish/v1/UpdateService/")
         .privileges(redfish::privileges::postUpdateService)
+        .fileUpload()
         .methods(boost::beast::http::verb::post)(
             [&app](const crow::Request& req,
                    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp) {
@@ -877,6 +918,7 @@ inline void requestRoutesUpdateService(App& app)
 #endif
     BMCWEB_ROUTE(app, "/redfish/v1/UpdateService/update/")
         .privileges(redfish::privileges::postUpdateService)
+        .fileUpload()
         .methods(boost::beast::http::verb::post)(std::bind_front(
             [&app](App&, const crow::Request& req,
                    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp) {
@@ -886,6 +928,21 @@ inline void requestRoutesUpdateService(App& app)
             std::ref(app)));
 }
 
+/**
+ * @brief The URI of the software image at path, or an empty string if path
+ * isn't directly beneath the software root.
+ */
+inline std::string firmwareInventoryUri(std::string_view path)
+{
+    sdbusplus::message::object_path object{std::string(path)};
+    std::string id = object.filename();
+    if (object.parent_path().str != sw_util::softwareRoot || id.empty())
+    {
+        return "";
+    }
+    return "/redfish/v1/UpdateService/FirmwareInventory/" + id;
+}
+
 inline void requestRoutesSoftwareInventoryCollection(App& app)
 {
     BMCWEB_ROUTE(app, "/redfish/v1/UpdateService/FirmwareInventory/")
@@ -893,7 +950,19 @@ inline void requestRoutesSoftwareInventoryCollection(App& app)
         .methods(boost::beast::http::verb::get)(
             [&app](const crow::Request& req,
                    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp) {
-        if (!redfish::setUpRedfishRoute(app, req, asyncResp))
+        query_param::QueryCapabilities capabilities = {
+            .canDelegateDeltaToken = true,
+        };
+        query_param::Query delegatedQuery;
+        if (!redfish::setUpRedfishRouteWithDelegation(
+                app, req, asyncResp, delegatedQuery, capabilities))
+        {
+            return;
+        }
+        if (!setUpCollectionDelta(
+                asyncResp, delegatedQuery.deltaToken,
+                sw_util::SoftwareInventoryCache::getInstance().changes(),
+                firmwareInventoryUri))
         {
             return;
         }
@@ -903,10 +972,14 @@ inline void requestRoutesSoftwareInventoryCollection(App& app)
             "/redfish/v1/UpdateService/FirmwareInventory";
         asyncResp->res.jsonValue["Name"] = "Software Inventory Collection";
 
-        crow::connections::systemBus->async_method_call(
-            [asyncResp](
-                const boost::system::error_code ec,
-                const dbus::utility::MapperGetSubTreeResponse& subtree) {
+        // Note that only firmware levels associated with a device are
+        // stored under /xyz/openbmc_project/software, which is all the
+        // software inventory holds, so only real FirmwareInventory items
+        // are returned
+        sw_util::SoftwareInventoryCache::getInstance().get(
+            [asyncResp](const boost::system::error_code& ec,
+                        const std::shared_ptr<const sw_util::SoftwareInventory>&
+                            inventory) {
             if (ec)
             {
                 messages::internalError(asyncResp->res);
@@ -915,36 +988,17 @@ inline void requestRoutesSoftwareInventoryCollection(App& app)
             asyncResp->res.jsonValue["Members"] = nlohmann::json::array();
             asyncResp->res.jsonValue["Members@odata.count"] = 0;
 
-            for (const auto& obj : subtree)
+            for (const auto& [path, image] : inventory->images)
             {
-                sdbusplus::message::object_path path(obj.first);
-                std::string swId = path.filename();
-                if (swId.empty())
-                {
-                    messages::internalError(asyncResp->res);
-                    BMCWEB_LOG_DEBUG << "Can't parse firmware ID!!";
-                    return;
-                }
-
                 nlohmann::json& members = asyncResp->res.jsonValue["Members"];
                 nlohmann::json::object_t member;
                 member["@odata.id"] =
-                    "/redfish/v1/UpdateService/FirmwareInventory/" + swId;
+                    "/redfish/v1/UpdateService/FirmwareInventory/" + image.id;
                 members.push_back(std::move(member));
                 asyncResp->res.jsonValue["Members@odata.count"] =
                     members.size();
             }
-        },
-            // Note that only firmware levels associated with a device
-            // are stored under /xyz/openbmc_project/software therefore
-            // to ensure only real FirmwareInventory items are returned,
-            // this full object path must be used here as input to
-            // mapper
-            "xyz.openbmc_project.ObjectMapper",
-            "/xyz/openbmc_project/object_mapper",
-            "xyz.openbmc_project.ObjectMapper", "GetSubTree",
-            "/xyz/openbmc_project/software", static_cast<int32_t>(0),
-            std::array<const char*, 1>{"xyz.openbmc_project.Software.Version"});
+        });
     });
 }
 /* Fill related item links (i.e. bmc, bios) in for inventory */
@@ -976,74 +1030,68 @@ inline static void
 
 inline void
     getSoftwareVersion(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-                       const std::string& service, const std::string& path,
-                       const std::string& swId)
+                       const sw_util::SoftwareImage& image)
 {
-    sdbusplus::asio::getAllProperties(
-        *crow::connections::systemBus, service, path,
-        "xyz.openbmc_project.Software.Version",
-        [asyncResp,
-         swId](const boost::system::error_code errorCode,
-               const dbus::utility::DBusPropertiesMap& propertiesList) {
-        if (errorCode)
-        {
-            messages::internalError(asyncResp->res);
-            return;
-        }
+    const dbus::utility::DBusPropertiesMap* propertiesList =
+        image.find(sw_util::versionInterface);
+    if (propertiesList == nullptr)
+    {
+        messages::internalError(asyncResp->res);
+        return;
+    }
 
-        const std::string* swInvPurpose = nullptr;
-        const std::string* version = nullptr;
+    const std::string* swInvPurpose = nullptr;
+    const std::string* version = nullptr;
 
-        const bool success = sdbusplus::unpackPropertiesNoThrow(
-            dbus_utils::UnpackErrorPrinter(), propertiesList, "Purpose",
-            swInvPurpose, "Version", version);
+    const bool success = sdbusplus::unpackPropertiesNoThrow(
+        dbus_utils::UnpackErrorPrinter(), *propertiesList, "Purpose",
+        swInvPurpose, "Version", version);
 
-        if (!success)
-        {
-            messages::internalError(asyncResp->res);
-            return;
-        }
+    if (!success)
+    {
+        messages::internalError(asyncResp->res);
+        return;
+    }
 
-        if (swInvPurpose == nullptr)
-        {
-            BMCWEB_LOG_DEBUG << "Can't find property \"Purpose\"!";
-            messages::internalError(asyncResp->res);
-            return;
-        }
+    if (swInvPurpose == nullptr)
+    {
+        BMCWEB_LOG_DEBUG << "Can't find property \"Purpose\"!";
+        messages::internalError(asyncResp->res);
+        return;
+    }
 
-        BMCWEB_LOG_DEBUG << "swInvPurpose = " << *swInvPurpose;
+    BMCWEB_LOG_DEBUG << "swInvPurpose = " << *swInvPurpose;
 
-        if (version == nullptr)
-        {
-            BMCWEB_LOG_DEBUG << "Can't find property \"Version\"!";
+    if (version == nullptr)
+    {
+        BMCWEB_LOG_DEBUG << "Can't find property \"Version\"!";
 
-            messages::internalError(asyncResp->res);
+        messages::internalError(asyncResp->res);
 
-            return;
-        }
-        asyncResp->res.jsonValue["Version"] = *version;
-        asyncResp->res.jsonValue["Id"] = swId;
-
-        // swInvPurpose is of format:
-        // xyz.openbmc_project.Software.Version.VersionPurpose.ABC
-        // Translate this to "ABC image"
-        size_t endDesc = swInvPurpose->rfind('.');
-        if (endDesc == std::string::npos)
-        {
-            messages::internalError(asyncResp->res);
-            return;
-        }
-        endDesc++;
-        if (endDesc >= swInvPurpose->size())
-        {
-            messages::internalError(asyncResp->res);
-            return;
-        }
+        return;
+    }
+    asyncResp->res.jsonValue["Version"] = *version;
+    asyncResp->res.jsonValue["Id"] = image.id;
+
+    // swInvPurpose is of format:
+    // xyz.openbmc_project.Software.Version.VersionPurpose.ABC
+    // Translate this to "ABC image"
+    size_t endDesc = swInvPurpose->rfind('.');
+    if (endDesc == std::string::npos)
+    {
+        messages::internalError(asyncResp->res);
+        return;
+    }
+    endDesc++;
+    if (endDesc >= swInvPurpose->size())
+    {
+        messages::internalError(asyncResp->res);
+        return;
+    }
 
-        std::string formatDesc = swInvPurpose->substr(endDesc);
-        asyncResp->res.jsonValue["Description"] = formatDesc + " image";
-        getRelatedItems(asyncResp, *swInvPurpose);
-    });
+    std::string formatDesc = swInvPurpose->substr(endDesc);
+    asyncResp->res.jsonValue["Description"] = formatDesc + " image";
+    getRelatedItems(asyncResp, *swInvPurpose);
 }
 
 inline void requestRoutesSoftwareInventory(App& app)
@@ -1064,10 +1112,11 @@ inline void requestRoutesSoftwareInventory(App& app)
         asyncResp->res.jsonValue["@odata.id"] =
             "/redfish/v1/UpdateService/FirmwareInventory/" + *swId;
 
-        crow::connections::systemBus->async_method_call(
-            [asyncResp,
-             swId](const boost::system::error_code ec,
-                   const dbus::utility::MapperGetSubTreeResponse& subtree) {
+        sw_util::SoftwareInventoryCache::getInstance().get(
+            [asyncResp, swId](
+                const boost::system::error_code& ec,
+                const std::shared_ptr<const sw_util::SoftwareInventory>&
+                    inventory) {
             BMCWEB_LOG_DEBUG << "doGet callback...";
             if (ec)
             {
@@ -1076,31 +1125,21 @@ inline void requestRoutesSoftwareInventory(App& app)
             }
 
             // Ensure we find our input swId, otherwise return an error
-            bool found = false;
-            for (const std::pair<std::string,
-                                 std::vector<std::pair<
-                                     std::string, std::vector<std::string>>>>&
-                     obj : subtree)
+            std::vector<std::string> found;
+            for (const auto& [path, image] : inventory->images)
             {
-                if (!obj.first.ends_with(*swId))
-                {
-                    continue;
-                }
-
-                if (obj.second.empty())
+                if (!path.ends_with(*swId))
                 {
                     continue;
                 }
 
-                found = true;
-                sw_util::getSwStatus(asyncResp, swId, obj.second[0].first);
-                getSoftwareVersion(asyncResp, obj.second[0].first, obj.first,
-                                   *swId);
+                found.emplace_back(path);
+                sw_util::getSwStatus(asyncResp, image);
+                getSoftwareVersion(asyncResp, image);
                 asyncResp->res.jsonValue["Name"] = "Software Inventory";
-                sw_util::getSwMinimumVersion(asyncResp, swId,
-                                             obj.second[0].first);
+                sw_util::getSwMinimumVersion(asyncResp, image);
             }
-            if (!found)
+            if (found.empty())
             {
                 BMCWEB_LOG_ERROR << "Input swID " << *swId << " not found!";
                 messages::resourceMissingAtURI(
@@ -1114,13 +1153,11 @@ inline void requestRoutesSoftwareInventory(App& app)
             asyncResp->res.jsonValue["Status"]["HealthRollup"] = "OK";
 
             asyncResp->res.jsonValue["Updateable"] = false;
-            sw_util::getSwUpdatableStatus(asyncResp, swId);
-        },
-            "xyz.openbmc_project.ObjectMapper",
-            "/xyz/openbmc_project/object_mapper",
-            "xyz.openbmc_project.ObjectMapper", "GetSubTree", "/",
-            static_cast<int32_t>(0),
-            std::array<const char*, 1>{"xyz.openbmc_project.Software.Version"});
+            for (const std::string& path : found)
+            {
+                sw_util::getSwUpdatableStatus(asyncResp, *inventory, path);
+            }
+        });
     });
 }
 
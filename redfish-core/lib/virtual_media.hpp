@@ -23,6 +23,9 @@
 #include <query.hpp>
 #include <registries/privilege_registry.hpp>
 #include <utils/json_utils.hpp>
+#include <utils/virtual_media_cache.hpp>
+
+#include <filesystem>
 
 namespace redfish
 {
@@ -167,23 +170,22 @@ inline nlohmann::json vmItemTemplate(const std::string& name,
  *  @brief Fills collection data
  */
 inline void getVmResourceList(std::shared_ptr<bmcweb::AsyncResp> aResp,
-                              const std::string& service,
                               const std::string& name)
 {
     BMCWEB_LOG_DEBUG << "Get available Virtual Media resources.";
-    crow::connections::systemBus->async_method_call(
+    vm_utils::VirtualMediaCache::getInstance().get(
         [name, aResp{std::move(aResp)}](
-            const boost::system::error_code ec,
-            const dbus::utility::ManagedObjectType& subtree) {
-        if (ec)
+            const boost::system::error_code& ec,
+            const std::shared_ptr<const vm_utils::VirtualMediaState>& state) {
+        if (ec || state == nullptr)
         {
-            BMCWEB_LOG_DEBUG << "DBUS response error";
+            messages::internalError(aResp->res);
             return;
         }
         nlohmann::json& members = aResp->res.jsonValue["Members"];
         members = nlohmann::json::array();
 
-        for (const auto& object : subtree)
+        for (const auto& object : state->objects)
         {
             nlohmann::json item;
             std::string path = object.first.filename();
@@ -197,32 +199,28 @@ inline void getVmResourceList(std::shared_ptr<bmcweb::AsyncResp> aResp,
             members.emplace_back(std::move(item));
         }
         aResp->res.jsonValue["Members@odata.count"] = members.size();
-    },
-        service, "/xyz/openbmc_project/VirtualMedia",
-        "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
+    });
 }
 
 /**
  *  @brief Fills data for specific resource
  */
 inline void getVmData(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
-                      const std::string& service, const std::string& name,
-                      const std::string& resName)
+                      const std::string& name, const std::string& resName)
 {
     BMCWEB_LOG_DEBUG << "Get Virtual Media resource data.";
 
-    crow::connections::systemBus->async_method_call(
-        [resName, name,
-         aResp](const boost::system::error_code ec,
-                const dbus::utility::ManagedObjectType& subtree) {
-        if (ec)
+    vm_utils::VirtualMediaCache::getInstance().get(
+        [resName, name, aResp](
+            const boost::system::error_code& ec,
+            const std::shared_ptr<const vm_utils::VirtualMediaState>& state) {
+        if (ec || state == nullptr)
         {
-            BMCWEB_LOG_DEBUG << "DBUS response error";
-
+            messages::internalError(aResp->res);
             return;
         }
 
-        for (const auto& item : subtree)
+        for (const auto& item : state->objects)
         {
             std::string thispath = item.first.filename();
             if (thispath.empty())
@@ -271,9 +269,7 @@ inline void getVmData(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
         }
 
         messages::resourceNotFound(aResp->res, "VirtualMedia", resName);
-    },
-        service, "/xyz/openbmc_project/VirtualMedia",
-        "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
+    });
 }
 
 /**
@@ -801,86 +797,65 @@ inline void handleManagersVirtualMediaActionInsertPost(
         return;
     }
 
-    crow::connections::systemBus->async_method_call(
-        [asyncResp, actionParams,
-         resName](const boost::system::error_code ec,
-                  const dbus::utility::MapperGetObject& getObjectType) mutable {
-        if (ec)
+    vm_utils::VirtualMediaCache::getInstance().get(
+        [asyncResp, actionParams, resName](
+            const boost::system::error_code& ec,
+            const std::shared_ptr<const vm_utils::VirtualMediaState>&
+                state) mutable {
+        if (ec || state == nullptr)
         {
-            BMCWEB_LOG_ERROR << "ObjectMapper::GetObject call failed: " << ec;
             messages::internalError(asyncResp->res);
-
             return;
         }
-        std::string service = getObjectType.begin()->first;
-        BMCWEB_LOG_DEBUG << "GetObjectType: " << service;
 
-        crow::connections::systemBus->async_method_call(
-            [service, resName, actionParams,
-             asyncResp](const boost::system::error_code ec2,
-                        dbus::utility::ManagedObjectType& subtree) mutable {
-            if (ec2)
-            {
-                BMCWEB_LOG_DEBUG << "DBUS response error";
+        for (const auto& object : state->objects)
+        {
+            const std::string& path =
+                static_cast<const std::string&>(object.first);
 
-                return;
+            std::size_t lastIndex = path.rfind('/');
+            if (lastIndex == std::string::npos)
+            {
+                continue;
             }
 
-            for (const auto& object : subtree)
+            lastIndex += 1;
+
+            if (path.substr(lastIndex) == resName)
             {
-                const std::string& path =
-                    static_cast<const std::string&>(object.first);
+                lastIndex = path.rfind("Proxy");
+                if (lastIndex != std::string::npos)
+                {
+                    // Not possible in proxy mode
+                    BMCWEB_LOG_DEBUG << "InsertMedia not "
+                                        "allowed in proxy mode";
+                    messages::resourceNotFound(asyncResp->res,
+                                               "VirtualMedia.InsertMedia",
+                                               resName);
+
+                    return;
+                }
 
-                std::size_t lastIndex = path.rfind('/');
+                lastIndex = path.rfind("Legacy");
                 if (lastIndex == std::string::npos)
                 {
                     continue;
                 }
 
-                lastIndex += 1;
+                // manager is irrelevant for
+                // VirtualMedia dbus calls
+                doMountVmLegacy(asyncResp, state->service, resName,
+                                actionParams.imageUrl,
+                                !(*actionParams.writeProtected),
+                                std::move(*actionParams.userName),
+                                std::move(*actionParams.password));
 
-                if (path.substr(lastIndex) == resName)
-                {
-                    lastIndex = path.rfind("Proxy");
-                    if (lastIndex != std::string::npos)
-                    {
-                        // Not possible in proxy mode
-                        BMCWEB_LOG_DEBUG << "InsertMedia not "
-                                            "allowed in proxy mode";
-                        messages::resourceNotFound(asyncResp->res,
-                                                   "VirtualMedia.InsertMedia",
-                                                   resName);
-
-                        return;
-                    }
-
-                    lastIndex = path.rfind("Legacy");
-                    if (lastIndex == std::string::npos)
-                    {
-                        continue;
-                    }
-
-                    // manager is irrelevant for
-                    // VirtualMedia dbus calls
-                    doMountVmLegacy(asyncResp, service, resName,
-                                    actionParams.imageUrl,
-                                    !(*actionParams.writeProtected),
-                                    std::move(*actionParams.userName),
-                                    std::move(*actionParams.password));
-
-                    return;
-                }
+                return;
             }
-            BMCWEB_LOG_DEBUG << "Parent item not found";
-            messages::resourceNotFound(asyncResp->res, "VirtualMedia", resName);
-        },
-            service, "/xyz/openbmc_project/VirtualMedia",
-            "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
-    },
-        "xyz.openbmc_project.ObjectMapper",
-        "/xyz/openbmc_project/object_mapper",
-        "xyz.openbmc_project.ObjectMapper", "GetObject",
-        "/xyz/openbmc_project/VirtualMedia", std::array<const char*, 0>());
+        }
+        BMCWEB_LOG_DEBUG << "Parent item not found";
+        messages::resourceNotFound(asyncResp->res, "VirtualMedia", resName);
+    });
 }
 
 inline void handleManagersVirtualMediaActionEject(
@@ -900,73 +875,51 @@ inline void handleManagersVirtualMediaActionEject(
         return;
     }
 
-    crow::connections::systemBus->async_method_call(
-        [asyncResp,
-         resName](const boost::system::error_code ec2,
-                  const dbus::utility::MapperGetObject& getObjectType) {
-        if (ec2)
+    vm_utils::VirtualMediaCache::getInstance().get(
+        [resName, asyncResp](
+            const boost::system::error_code& ec,
+            const std::shared_ptr<const vm_utils::VirtualMediaState>& state) {
+        if (ec || state == nullptr)
         {
-            BMCWEB_LOG_ERROR << "ObjectMapper::GetObject call failed: " << ec2;
             messages::internalError(asyncResp->res);
-
             return;
         }
-        std::string service = getObjectType.begin()->first;
-        BMCWEB_LOG_DEBUG << "GetObjectType: " << service;
 
-        crow::connections::systemBus->async_method_call(
-            [resName, service, asyncResp{asyncResp}](
-                const boost::system::error_code ec,
-                const dbus::utility::ManagedObjectType& subtree) {
-            if (ec)
-            {
-                BMCWEB_LOG_DEBUG << "DBUS response error";
+        for (const auto& object : state->objects)
+        {
+            const std::string& path =
+                static_cast<const std::string&>(object.first);
 
-                return;
+            std::size_t lastIndex = path.rfind('/');
+            if (lastIndex == std::string::npos)
+            {
+                continue;
             }
 
-            for (const auto& object : subtree)
-            {
-                const std::string& path =
-                    static_cast<const std::string&>(object.first);
+            lastIndex += 1;
 
-                std::size_t lastIndex = path.rfind('/');
-                if (lastIndex == std::string::npos)
+            if (path.substr(lastIndex) == resName)
+            {
+                lastIndex = path.rfind("Proxy");
+                if (lastIndex != std::string::npos)
                 {
-                    continue;
+                    // Proxy mode
+                    doVmAction(asyncResp, state->service, resName, false);
                 }
 
-                lastIndex += 1;
-
-                if (path.substr(lastIndex) == resName)
+                lastIndex = path.rfind("Legacy");
+                if (lastIndex != std::string::npos)
                 {
-                    lastIndex = path.rfind("Proxy");
-                    if (lastIndex != std::string::npos)
-                    {
-                        // Proxy mode
-                        doVmAction(asyncResp, service, resName, false);
-                    }
-
-                    lastIndex = path.rfind("Legacy");
-                    if (lastIndex != std::string::npos)
-                    {
-                        // Legacy mode
-                        doVmAction(asyncResp, service, resName, true);
-                    }
-
-                    return;
+                    // Legacy mode
+                    doVmAction(asyncResp, state->service, resName, true);
                 }
+
+                return;
             }
-            BMCWEB_LOG_DEBUG << "Parent item not found";
-            messages::resourceNotFound(asyncResp->res, "VirtualMedia", resName);
-        },
-            service, "/xyz/openbmc_project/VirtualMedia",
-            "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
-    },
-        "xyz.openbmc_project.ObjectMapper",
-        "/xyz/openbmc_project/object_mapper",
-        "xyz.openbmc_project.ObjectMapper", "GetObject",
-        "/xyz/openbmc_project/VirtualMedia", std::array<const char*, 0>());
+        }
+        BMCWEB_LOG_DEBUG << "Parent item not found";
+        messages::resourceNotFound(asyncResp->res, "VirtualMedia", resName);
+    });
 }
 
 inline void handleManagersVirtualMediaCollectionGet(
@@ -991,25 +944,7 @@ inline void handleManagersVirtualMediaCollectionGet(
     asyncResp->res.jsonValue["@odata.id"] = crow::utility::urlFromPieces(
         "redfish", "v1", "Managers", name, "VirtualMedia");
 
-    crow::connections::systemBus->async_method_call(
-        [asyncResp, name](const boost::system::error_code ec,
-                          const dbus::utility::MapperGetObject& getObjectType) {
-        if (ec)
-        {
-            BMCWEB_LOG_ERROR << "ObjectMapper::GetObject call failed: " << ec;
-            messages::internalError(asyncResp->res);
-
-            return;
-        }
-        std::string service = getObjectType.begin()->first;
-        BMCWEB_LOG_DEBUG << "GetObjectType: " << service;
-
-        getVmResourceList(asyncResp, service, name);
-    },
-        "xyz.openbmc_project.ObjectMapper",
-        "/xyz/openbmc_project/object_mapper",
-        "xyz.openbmc_project.ObjectMapper", "GetObject",
-        "/xyz/openbmc_project/VirtualMedia", std::array<const char*, 0>());
+    getVmResourceList(asyncResp, name);
 }
 
 inline void
@@ -1028,26 +963,7 @@ inline void
         return;
     }
 
-    crow::connections::systemBus->async_method_call(
-        [asyncResp, name,
-         resName](const boost::system::error_code ec,
-                  const dbus::utility::MapperGetObject& getObjectType) {
-        if (ec)
-        {
-            BMCWEB_LOG_ERROR << "ObjectMapper::GetObject call failed: " << ec;
-            messages::internalError(asyncResp->res);
-
-            return;
-        }
-        std::string service = getObjectType.begin()->first;
-        BMCWEB_LOG_DEBUG << "GetObjectType: " << service;
-
-        getVmData(asyncResp, service, name, resName);
-    },
-        "xyz.openbmc_project.ObjectMapper",
-        "/xyz/openbmc_project/object_mapper",
-        "xyz.openbmc_project.ObjectMapper", "GetObject",
-        "/xyz/openbmc_project/VirtualMedia", std::array<const char*, 0>());
+    getVmData(asyncResp, name, resName);
 }
 
 inline void requestNBDVirtualMediaRoutes(App& app)
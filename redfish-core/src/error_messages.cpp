@@ -39,8 +39,7 @@ namespace redfish
 namespace messages
 {
 
-void addMessageToErrorJson(nlohmann::json& target,
-                           const nlohmann::json& message)
+void addMessageToErrorJson(nlohmann::json& target, nlohmann::json&& message)
 {
     auto& error = target["error"];
 
@@ -83,7 +82,13 @@ void addMessageToErrorJson(nlohmann::json& target,
         extendedInfo = nlohmann::json::array();
     }
 
-    extendedInfo.push_back(message);
+    extendedInfo.push_back(std::move(message));
+}
+
+void addMessageToErrorJson(nlohmann::json& target,
+                           const nlohmann::json& message)
+{
+    addMessageToErrorJson(target, nlohmann::json(message));
 }
 
 void moveErrorsToErrorJson(nlohmann::json& target, nlohmann::json& source)
@@ -96,7 +101,7 @@ void moveErrorsToErrorJson(nlohmann::json& target, nlohmann::json& source)
     if (errorIt == source.end())
     {
         // caller puts error message in root
-        messages::addMessageToErrorJson(target, source);
+        messages::addMessageToErrorJson(target, std::move(source));
         source.clear();
         return;
     }
@@ -105,16 +110,17 @@ void moveErrorsToErrorJson(nlohmann::json& target, nlohmann::json& source)
     {
         return;
     }
-    const nlohmann::json::array_t* extendedInfo =
-        (*extendedInfoIt).get_ptr<const nlohmann::json::array_t*>();
+    nlohmann::json::array_t* extendedInfo =
+        (*extendedInfoIt).get_ptr<nlohmann::json::array_t*>();
     if (extendedInfo == nullptr)
     {
         source.erase(errorIt);
         return;
     }
-    for (const nlohmann::json& message : *extendedInfo)
+    // The source is dropped below, so its messages can move over
+    for (nlohmann::json& message : *extendedInfo)
     {
-        addMessageToErrorJson(target, message);
+        addMessageToErrorJson(target, std::move(message));
     }
     source.erase(errorIt);
 }
@@ -131,7 +137,7 @@ static void addMessageToJsonRoot(nlohmann::json& target,
     target[messages::messageAnnotation].push_back(message);
 }
 
-void addMessageToJson(nlohmann::json& target, const nlohmann::json& message,
+void addMessageToJson(nlohmann::json& target, nlohmann::json&& message,
                       std::string_view fieldPath)
 {
     std::string extendedInfo(fieldPath);
@@ -145,7 +151,37 @@ void addMessageToJson(nlohmann::json& target, const nlohmann::json& message,
     }
 
     // Object exists and it is an array so we can just push in the message
-    field.push_back(message);
+    field.push_back(std::move(message));
+}
+
+void addMessageToJson(nlohmann::json& target, const nlohmann::json& message,
+                      std::string_view fieldPath)
+{
+    addMessageToJson(target, nlohmann::json(message), fieldPath);
+}
+
+// Messages that take no arguments always format the same way, so they are
+// built once and copied out rather than rebuilt from the registry each time
+static const nlohmann::json& getFixedLog(size_t index)
+{
+    static const std::array<nlohmann::json,
+                            redfish::registries::base::registry.size()>
+        fixedLogs = []() {
+        std::array<nlohmann::json, redfish::registries::base::registry.size()>
+            logs;
+        for (size_t i = 0; i < logs.size(); i++)
+        {
+            if (redfish::registries::base::registry[i].second.numberOfArgs ==
+                0)
+            {
+                logs[i] = getLogFromRegistry(
+                    redfish::registries::base::header,
+                    redfish::registries::base::registry, i, {});
+            }
+        }
+        return logs;
+    }();
+    return fixedLogs[index];
 }
 
 static nlohmann::json getLog(redfish::registries::base::Index name,
@@ -156,6 +192,11 @@ static nlohmann::json getLog(redfish::registries::base::Index name,
     {
         return {};
     }
+    if (args.empty() &&
+        redfish::registries::base::registry[index].second.numberOfArgs == 0)
+    {
+        return getFixedLog(index);
+    }
     return getLogFromRegistry(redfish::registries::base::header,
                               redfish::registries::base::registry, index, args);
 }
@@ -196,6 +237,24 @@ void malformedJSON(crow::Response& res)
     addMessageToErrorJson(res.jsonValue, malformedJSON());
 }
 
+/**
+ * @internal
+ * @brief Formats MissingOrMalformedPart message into JSON
+ *
+ * See header file for more information
+ * @endinternal
+ */
+nlohmann::json missingOrMalformedPart()
+{
+    return getLog(redfish::registries::base::Index::missingOrMalformedPart, {});
+}
+
+void missingOrMalformedPart(crow::Response& res)
+{
+    res.result(boost::beast::http::status::bad_request);
+    addMessageToErrorJson(res.jsonValue, missingOrMalformedPart());
+}
+
 /**
  * @internal
  * @brief Formats ResourceMissingAtURI message into JSON
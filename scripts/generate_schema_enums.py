@@ -70,6 +70,7 @@ def camel_to_snake(name):
 def write_enum_list(redfish_defs_file, enum_list, snake_case_namespace):
     redfish_defs_file.write(
         "#pragma once\n"
+        '#include "utils/enum_table.hpp"\n\n'
         "#include <nlohmann/json.hpp>\n\n"
         "namespace {}\n"
         "{{\n"
@@ -91,19 +92,13 @@ def write_enum_list(redfish_defs_file, enum_list, snake_case_namespace):
         values = element.values
         if "Invalid" not in values:
             values.insert(0, "Invalid")
-        # nlohmann::json aparently uses c style arrays in their enum
-        # implementation, and clang-tidy isn't smart enough to figure out that
-        # the C arrays are in their code not bmcwebs, so we have to explicitly
-        # ignore the error.
         redfish_defs_file.write(
-            "NLOHMANN_JSON_SERIALIZE_ENUM({}, {{\n".format(element.name)
+            "REDFISH_ENUM_TABLE({},\n".format(element.name)
         )
-        for value in values:
-            redfish_defs_file.write(
-                '    {{{}::{}, "{}"}},\n'.format(element.name, value, value)
-            )
-
-        redfish_defs_file.write("});\n\n")
+        redfish_defs_file.write(
+            ",\n".join('    "{}"'.format(value) for value in values)
+        )
+        redfish_defs_file.write(");\n\n")
 
         print(element.name)
 
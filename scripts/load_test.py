@@ -0,0 +1,377 @@
+#!/usr/bin/env python3
+
+# Measures bmcweb throughput and latency under a mixed Redfish workload.
+#
+# With --bmcweb, starts a private D-Bus daemon, scripts/mock_dbus_tree.py and
+# the given bmcweb binary against it, so results only depend on bmcweb and the
+# machine running it.  Build that bmcweb with -Dinsecure-disable-auth=enabled,
+# or pass credentials PAM on the test machine accepts.  bmcweb listens on port
+# 18080 when not socket activated, and creates its certificate under
+# /etc/ssl/certs/https, so this needs to run as root unless built with
+# -Dinsecure-disable-ssl=enabled.
+#
+# With --host, drives an already running bmcweb instead; the workload only
+# reads, so this is safe to point at real hardware.
+#
+# Each connection is a keep-alive HTTP/1.1 client issuing one request at a
+# time.  Latencies are measured from sending a request to reading the last
+# byte of its response.
+#
+# Examples:
+#   load_test.py --bmcweb build/bmcweb --profile large --no-ssl
+#   load_test.py --host 1.2.3.4:443 --connections 8 --json results.json
+#
+# requires the dbus-next package when using --bmcweb
+
+import argparse
+import asyncio
+import base64
+import json
+import math
+import os
+import random
+import re
+import signal
+import ssl
+import subprocess
+import sys
+import time
+
+parser = argparse.ArgumentParser()
+target = parser.add_mutually_exclusive_group(required=True)
+target.add_argument("--bmcweb", help="bmcweb binary to start and test")
+target.add_argument("--host", help="Running bmcweb to test, as host:port")
+parser.add_argument(
+    "--profile",
+    choices=["default", "large"],
+    default="default",
+    help="Object tree size for the mock; see mock_dbus_tree.py",
+)
+parser.add_argument("--connections", type=int, default=16)
+parser.add_argument(
+    "--duration", type=float, default=30, help="Seconds to measure for"
+)
+parser.add_argument(
+    "--warmup", type=float, default=5, help="Seconds of load before measuring"
+)
+parser.add_argument("--seed", type=int, default=1, help="Workload RNG seed")
+parser.add_argument(
+    "--username", help="Username to connect with", default="root"
+)
+parser.add_argument("--password", help="Password to use", default="0penBmc")
+parser.add_argument(
+    "--ssl", default=True, action=argparse.BooleanOptionalAction
+)
+parser.add_argument("--json", help="Also write the results to this file")
+
+args = parser.parse_args()
+
+# (weight, name, url or function returning one given the discovered ids)
+WORKLOAD = [
+    (5, "ServiceRoot", lambda ids, rng: "/redfish/v1"),
+    (5, "ChassisCollection", lambda ids, rng: "/redfish/v1/Chassis"),
+    (10, "Chassis", lambda ids, rng: ids["chassis"]),
+    (5, "SensorCollection", lambda ids, rng: ids["chassis"] + "/Sensors"),
+    (30, "Sensor", lambda ids, rng: rng.choice(ids["sensors"])),
+    (10, "Thermal", lambda ids, rng: ids["chassis"] + "/Thermal"),
+    (5, "Power", lambda ids, rng: ids["chassis"] + "/Power"),
+    (10, "System", lambda ids, rng: "/redfish/v1/Systems/system"),
+    (
+        10,
+        "LogEntryPage",
+        lambda ids, rng: ids["entries"]
+        + f"?$top=50&$skip={rng.randrange(max(ids['entry_count'], 1))}",
+    ),
+    (
+        10,
+        "LogEntry",
+        lambda ids, rng: ids["entries"]
+        + f"/{rng.randrange(max(ids['entry_count'], 1)) + 1}",
+    ),
+]
+
+
+class Connection:
+    def __init__(self, host, port, ssl_context, auth):
+        self.host = host
+        self.port = port
+        self.ssl_context = ssl_context
+        self.auth = auth
+        self.reader = None
+        self.writer = None
+
+    async def connect(self):
+        self.reader, self.writer = await asyncio.open_connection(
+            self.host, self.port, ssl=self.ssl_context
+        )
+
+    async def get(self, url):
+        if self.writer is None:
+            await self.connect()
+        request = (
+            f"GET {url} HTTP/1.1\r\n"
+            f"Host: {self.host}\r\n"
+            f"Authorization: Basic {self.auth}\r\n"
+            "Accept: application/json\r\n"
+            "Connection: keep-alive\r\n\r\n"
+        )
+        self.writer.write(request.encode())
+        await self.writer.drain()
+
+        status_line = await self.reader.readline()
+        if not status_line:
+            raise ConnectionError("connection closed")
+        status = int(status_line.split()[1])
+        headers = {}
+        while True:
+            line = await self.reader.readline()
+            if line in (b"\r\n", b""):
+                break
+            name, _, value = line.decode().partition(":")
+            headers[name.strip().lower()] = value.strip()
+
+        if headers.get("transfer-encoding") == "chunked":
+            body = b""
+            while True:
+                size = int((await self.reader.readline()).strip(), 16)
+                if size == 0:
+                    await self.reader.readline()
+                    break
+                body += await self.reader.readexactly(size)
+                await self.reader.readline()
+        else:
+            length = int(headers.get("content-length", "0"))
+            body = await self.reader.readexactly(length)
+
+        if headers.get("connection") == "close":
+            self.close()
+        return status, body
+
+    def close(self):
+        if self.writer is not None:
+            self.writer.close()
+        self.reader = None
+        self.writer = None
+
+
+def percentile(sorted_values, fraction):
+    """Nearest-rank percentile of an already sorted list"""
+    if not sorted_values:
+        return 0.0
+    rank = max(math.ceil(fraction * len(sorted_values)), 1)
+    return sorted_values[rank - 1]
+
+
+async def discover(conn):
+    """Finds the resources the workload picks from"""
+    status, body = await conn.get("/redfish/v1/Chassis")
+    if status != 200:
+        sys.exit(f"GET /redfish/v1/Chassis returned {status}")
+    members = json.loads(body)["Members"]
+    if not members:
+        sys.exit("No chassis to test against")
+    chassis = members[0]["@odata.id"]
+
+    status, body = await conn.get(chassis + "/Sensors")
+    sensors = [m["@odata.id"] for m in json.loads(body).get("Members", [])]
+    if not sensors:
+        sensors = [chassis + "/Sensors"]
+
+    entries = "/redfish/v1/Systems/system/LogServices/EventLog/Entries"
+    status, body = await conn.get(entries + "?$top=1")
+    entry_count = 0
+    if status == 200:
+        entry_count = json.loads(body).get("Members@odata.count", 0)
+    return {
+        "chassis": chassis,
+        "sensors": sensors,
+        "entries": entries,
+        "entry_count": entry_count,
+    }
+
+
+async def worker(conn, ids, rng, state):
+    weights = [w for w, _, _ in WORKLOAD]
+    while not state["stop"]:
+        _, name, make_url = rng.choices(WORKLOAD, weights)[0]
+        url = make_url(ids, rng)
+        start = time.perf_counter()
+        try:
+            status, _ = await conn.get(url)
+        except (ConnectionError, asyncio.IncompleteReadError, ValueError):
+            conn.close()
+            status = 0
+        elapsed = time.perf_counter() - start
+        if state["measuring"]:
+            state["latencies"].setdefault(name, []).append(elapsed)
+            if not 200 <= status < 300:
+                state["errors"][name] = state["errors"].get(name, 0) + 1
+
+
+async def run_load(host, port):
+    ssl_context = None
+    if args.ssl:
+        ssl_context = ssl.create_default_context()
+        ssl_context.check_hostname = False
+        ssl_context.verify_mode = ssl.CERT_NONE
+    auth = base64.b64encode(
+        f"{args.username}:{args.password}".encode()
+    ).decode()
+
+    first = Connection(host, port, ssl_context, auth)
+    ids = await discover(first)
+    print(
+        f"Testing {host}:{port} with {len(ids['sensors'])} sensors and "
+        f"{ids['entry_count']} log entries over {args.connections} "
+        "connections",
+        flush=True,
+    )
+
+    state = {"stop": False, "measuring": False, "latencies": {}, "errors": {}}
+    conns = [first] + [
+        Connection(host, port, ssl_context, auth)
+        for _ in range(args.connections - 1)
+    ]
+    tasks = [
+        asyncio.create_task(
+            worker(conn, ids, random.Random(args.seed + i), state)
+        )
+        for i, conn in enumerate(conns)
+    ]
+    await asyncio.sleep(args.warmup)
+    state["measuring"] = True
+    start = time.perf_counter()
+    await asyncio.sleep(args.duration)
+    state["measuring"] = False
+    elapsed = time.perf_counter() - start
+    state["stop"] = True
+    await asyncio.gather(*tasks)
+    for conn in conns:
+        conn.close()
+    return report(state, elapsed)
+
+
+def summarize(latencies, errors, elapsed):
+    latencies = sorted(latencies)
+    return {
+        "requests": len(latencies),
+        "errors": errors,
+        "rps": len(latencies) / elapsed,
+        "p50_ms": percentile(latencies, 0.50) * 1000,
+        "p90_ms": percentile(latencies, 0.90) * 1000,
+        "p99_ms": percentile(latencies, 0.99) * 1000,
+        "max_ms": (latencies[-1] if latencies else 0.0) * 1000,
+    }
+
+
+def report(state, elapsed):
+    results = {"duration_s": elapsed, "connections": args.connections}
+    per_route = {}
+    all_latencies = []
+    for _, name, _ in WORKLOAD:
+        latencies = state["latencies"].get(name, [])
+        all_latencies += latencies
+        per_route[name] = summarize(
+            latencies, state["errors"].get(name, 0), elapsed
+        )
+    results["routes"] = per_route
+    results["total"] = summarize(
+        all_latencies, sum(state["errors"].values()), elapsed
+    )
+
+    header = (
+        f"{'route':<20}{'requests':>10}{'errors':>8}{'rps':>10}"
+        f"{'p50 ms':>10}{'p90 ms':>10}{'p99 ms':>10}{'max ms':>10}"
+    )
+    print(header)
+    for name, row in list(per_route.items()) + [("total", results["total"])]:
+        print(
+            f"{name:<20}{row['requests']:>10}{row['errors']:>8}"
+            f"{row['rps']:>10.1f}{row['p50_ms']:>10.2f}"
+            f"{row['p90_ms']:>10.2f}{row['p99_ms']:>10.2f}"
+            f"{row['max_ms']:>10.2f}"
+        )
+    return results
+
+
+async def wait_for_port(port, proc, timeout=30):
+    deadline = time.monotonic() + timeout
+    while time.monotonic() < deadline:
+        if proc.poll() is not None:
+            sys.exit(f"bmcweb exited with {proc.returncode}")
+        try:
+            _, writer = await asyncio.open_connection("127.0.0.1", port)
+            writer.close()
+            return
+        except OSError:
+            await asyncio.sleep(0.2)
+    sys.exit(f"bmcweb did not listen on {port} within {timeout}s")
+
+
+def start_stack():
+    """Starts dbus-daemon, the mock tree and bmcweb; returns their processes"""
+    daemon = subprocess.Popen(
+        ["dbus-daemon", "--session", "--nofork", "--print-address=1"],
+        stdout=subprocess.PIPE,
+        text=True,
+    )
+    address = daemon.stdout.readline().strip()
+    if not address:
+        sys.exit("dbus-daemon did not report an address")
+    env = dict(os.environ, DBUS_SYSTEM_BUS_ADDRESS=address)
+
+    ready_read, ready_write = os.pipe()
+    mock = subprocess.Popen(
+        [
+            sys.executable,
+            os.path.join(os.path.dirname(__file__), "mock_dbus_tree.py"),
+            "--profile",
+            args.profile,
+            "--ready-fd",
+            str(ready_write),
+        ],
+        env=env,
+        pass_fds=[ready_write],
+    )
+    os.close(ready_write)
+    with os.fdopen(ready_read) as ready:
+        if not ready.readline():
+            sys.exit("mock_dbus_tree.py failed to start")
+
+    bmcweb = subprocess.Popen([args.bmcweb], env=env)
+    return [bmcweb, mock, daemon]
+
+
+def main():
+    procs = []
+    if args.bmcweb:
+        procs = start_stack()
+        host = "127.0.0.1"
+        port = 18080
+    else:
+        match = re.fullmatch(r"(.+):(\d+)", args.host)
+        if match is None:
+            sys.exit("--host must be host:port")
+        host = match.group(1)
+        port = int(match.group(2))
+
+    async def run():
+        if procs:
+            await wait_for_port(port, procs[0])
+        return await run_load(host, port)
+
+    try:
+        results = asyncio.run(run())
+    finally:
+        for proc in procs:
+            proc.send_signal(signal.SIGTERM)
+            proc.wait()
+
+    results["profile"] = args.profile if args.bmcweb else None
+    if args.json:
+        with open(args.json, "w") as out:
+            json.dump(results, out, indent=2)
+
+
+if __name__ == "__main__":
+    main()
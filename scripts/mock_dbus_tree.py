@@ -0,0 +1,350 @@
+#!/usr/bin/env python3
+
+# Serves a synthetic OpenBMC object tree on D-Bus so bmcweb can be load tested
+# without hardware.  Implements just enough of the ObjectMapper, sensor,
+# inventory and logging daemons for the Redfish Chassis, Sensors, Thermal,
+# Power, Systems and EventLog resources.
+#
+# Normally started by scripts/load_test.py against a private bus.  To run it
+# by hand, point DBUS_SYSTEM_BUS_ADDRESS at a bus bmcweb also uses.
+#
+# requires the dbus-next package to be installed
+
+import argparse
+import asyncio
+import os
+
+from dbus_next import BusType, Message, MessageType, Variant
+from dbus_next.aio import MessageBus
+
+PROFILES = {
+    "default": {"sensors": 100, "log_entries": 1000},
+    # The scale limits we want sensors.hpp and log_services.hpp to handle
+    "large": {"sensors": 2000, "log_entries": 50000},
+}
+
+MAPPER = "xyz.openbmc_project.ObjectMapper"
+SENSOR_SERVICE = "xyz.openbmc_project.HwmonTempSensor"
+INVENTORY = "xyz.openbmc_project.Inventory.Manager"
+LOGGING = "xyz.openbmc_project.Logging"
+STATE_HOST = "xyz.openbmc_project.State.Host"
+CHASSIS_PATH = "/xyz/openbmc_project/inventory/system/chassis"
+
+SENSOR_TYPES = [
+    ("temperature", "DegreesC", 35.0),
+    ("fan_tach", "RPMS", 6000.0),
+    ("voltage", "Volts", 12.0),
+    ("current", "Amperes", 3.0),
+    ("power", "Watts", 250.0),
+]
+
+
+class ObjectTree:
+    """Every object served, keyed by service, then path, then interface"""
+
+    def __init__(self):
+        self.services = {}
+
+    def add(self, service, path, interface, properties):
+        objects = self.services.setdefault(service, {})
+        objects.setdefault(path, {})[interface] = properties
+
+    def owners(self, path):
+        result = {}
+        for service, objects in self.services.items():
+            if path in objects:
+                result[service] = list(objects[path].keys())
+        return result
+
+
+def build_tree(sensor_count, log_entry_count):
+    tree = ObjectTree()
+    sensor_paths = []
+    for i in range(sensor_count):
+        kind, unit, nominal = SENSOR_TYPES[i % len(SENSOR_TYPES)]
+        path = f"/xyz/openbmc_project/sensors/{kind}/{kind}_{i}"
+        sensor_paths.append(path)
+        unit_enum = f"xyz.openbmc_project.Sensor.Value.Unit.{unit}"
+        tree.add(
+            SENSOR_SERVICE,
+            path,
+            "xyz.openbmc_project.Sensor.Value",
+            {
+                "Value": Variant("d", nominal + (i % 7)),
+                "Unit": Variant("s", unit_enum),
+                "MaxValue": Variant("d", nominal * 4),
+                "MinValue": Variant("d", 0.0),
+            },
+        )
+        tree.add(
+            SENSOR_SERVICE,
+            path,
+            "xyz.openbmc_project.Sensor.Threshold.Warning",
+            {
+                "WarningHigh": Variant("d", nominal * 2),
+                "WarningLow": Variant("d", nominal / 4),
+                "WarningAlarmHigh": Variant("b", False),
+                "WarningAlarmLow": Variant("b", False),
+            },
+        )
+        tree.add(
+            SENSOR_SERVICE,
+            path,
+            "xyz.openbmc_project.State.Decorator.OperationalStatus",
+            {"Functional": Variant("b", True)},
+        )
+        tree.add(
+            SENSOR_SERVICE,
+            path,
+            "xyz.openbmc_project.State.Decorator.Availability",
+            {"Available": Variant("b", True)},
+        )
+
+    tree.add(
+        INVENTORY,
+        CHASSIS_PATH,
+        "xyz.openbmc_project.Inventory.Item.Chassis",
+        {"Type": Variant("s", "xyz.openbmc_project.Inventory.Item.Chassis."
+                              "ChassisType.RackMount")},
+    )
+    tree.add(
+        INVENTORY,
+        CHASSIS_PATH,
+        "xyz.openbmc_project.Inventory.Decorator.Asset",
+        {
+            "Manufacturer": Variant("s", "OpenBMC"),
+            "Model": Variant("s", "Load Test"),
+            "PartNumber": Variant("s", "0000"),
+            "SerialNumber": Variant("s", "0001"),
+        },
+    )
+    tree.add(
+        INVENTORY,
+        CHASSIS_PATH,
+        "xyz.openbmc_project.Inventory.Item",
+        {"Present": Variant("b", True), "PrettyName": Variant("s", "chassis")},
+    )
+    # Associations are served by the mapper
+    tree.add(
+        MAPPER,
+        CHASSIS_PATH + "/all_sensors",
+        "xyz.openbmc_project.Association",
+        {"endpoints": Variant("as", sensor_paths)},
+    )
+
+    tree.add(
+        STATE_HOST,
+        "/xyz/openbmc_project/state/host0",
+        "xyz.openbmc_project.State.Host",
+        {
+            "CurrentHostState": Variant(
+                "s", "xyz.openbmc_project.State.Host.HostState.Running"
+            )
+        },
+    )
+
+    severities = ["Informational", "Warning", "Error", "Critical"]
+    for i in range(1, log_entry_count + 1):
+        path = f"/xyz/openbmc_project/logging/entry/{i}"
+        tree.add(
+            LOGGING,
+            path,
+            "xyz.openbmc_project.Logging.Entry",
+            {
+                "Id": Variant("u", i),
+                "Message": Variant("s", f"xyz.openbmc_project.Sensor.Event.{i}"),
+                "Resolution": Variant("s", ""),
+                "Resolved": Variant("b", i % 3 == 0),
+                "Severity": Variant(
+                    "s",
+                    "xyz.openbmc_project.Logging.Entry.Level."
+                    + severities[i % len(severities)],
+                ),
+                "Timestamp": Variant("t", 1672531200000 + i * 1000),
+                "UpdateTimestamp": Variant("t", 1672531200000 + i * 1000),
+                "AdditionalData": Variant("as", [f"SENSOR=temperature_{i}"]),
+                "ServiceProviderNotify": Variant("b", False),
+            },
+        )
+        tree.add(
+            LOGGING,
+            path,
+            "xyz.openbmc_project.Common.FilePath",
+            {"Path": Variant("s", f"/var/lib/phosphor-logging/errors/{i}")},
+        )
+    return tree
+
+
+def sub_paths(tree, root, depth):
+    """Yields (path, owners) for every object under root within depth"""
+    prefix = root.rstrip("/") + "/"
+    base_depth = root.rstrip("/").count("/")
+    seen = set()
+    for objects in tree.services.values():
+        for path in objects:
+            if path in seen or not path.startswith(prefix):
+                continue
+            if depth > 0 and path.count("/") - base_depth > depth:
+                continue
+            seen.add(path)
+            yield path, tree.owners(path)
+
+
+def filter_interfaces(owners, interfaces):
+    if not interfaces:
+        return owners
+    wanted = set(interfaces)
+    result = {}
+    for service, ifaces in owners.items():
+        if wanted.intersection(ifaces):
+            result[service] = ifaces
+    return result
+
+
+def association_endpoints(tree, assoc_path):
+    props = tree.services.get(MAPPER, {}).get(assoc_path, {})
+    endpoints = props.get("xyz.openbmc_project.Association", {})
+    return endpoints.get("endpoints", Variant("as", [])).value
+
+
+class MockBus:
+    def __init__(self, bus, tree):
+        self.bus = bus
+        self.tree = tree
+
+    def reply(self, msg, signature, body):
+        return Message.new_method_return(msg, signature, body)
+
+    def get_sub_tree(self, root, depth, interfaces):
+        result = {}
+        for path, owners in sub_paths(self.tree, root, depth):
+            matched = filter_interfaces(owners, interfaces)
+            if matched:
+                result[path] = matched
+        return result
+
+    def handle_mapper(self, msg):
+        args = msg.body
+        if msg.member == "GetSubTree":
+            return self.reply(
+                msg, "a{sa{sas}}", [self.get_sub_tree(*args)]
+            )
+        if msg.member == "GetSubTreePaths":
+            return self.reply(
+                msg, "as", [list(self.get_sub_tree(*args).keys())]
+            )
+        if msg.member == "GetObject":
+            owners = filter_interfaces(self.tree.owners(args[0]), args[1])
+            if not owners:
+                return Message.new_error(
+                    msg,
+                    "xyz.openbmc_project.Common.Error.ResourceNotFound",
+                    "Resource not found",
+                )
+            return self.reply(msg, "a{sas}", [owners])
+        if msg.member in ("GetAssociatedSubTree", "GetAssociatedSubTreePaths"):
+            assoc_path, root, depth, interfaces = args
+            tree = self.get_sub_tree(root, depth, interfaces)
+            endpoints = set(association_endpoints(self.tree, assoc_path))
+            tree = {p: o for p, o in tree.items() if p in endpoints}
+            if msg.member == "GetAssociatedSubTree":
+                return self.reply(msg, "a{sa{sas}}", [tree])
+            return self.reply(msg, "as", [list(tree.keys())])
+        return None
+
+    def handle_properties(self, msg, service):
+        objects = self.tree.services.get(service, {})
+        interfaces = objects.get(msg.path)
+        if interfaces is None:
+            return Message.new_error(
+                msg, "org.freedesktop.DBus.Error.UnknownObject", msg.path
+            )
+        props = interfaces.get(msg.body[0], {})
+        if msg.member == "GetAll":
+            return self.reply(msg, "a{sv}", [props])
+        if msg.member == "Get":
+            if msg.body[1] not in props:
+                return Message.new_error(
+                    msg,
+                    "org.freedesktop.DBus.Error.UnknownProperty",
+                    msg.body[1],
+                )
+            return self.reply(msg, "v", [props[msg.body[1]]])
+        return None
+
+    def handle_object_manager(self, msg, service):
+        prefix = msg.path.rstrip("/") + "/"
+        objects = {
+            path: interfaces
+            for path, interfaces in self.tree.services.get(service, {}).items()
+            if path.startswith(prefix)
+        }
+        return self.reply(msg, "a{oa{sa{sv}}}", [objects])
+
+    def handle(self, msg):
+        if msg.message_type != MessageType.METHOD_CALL:
+            return None
+        service = msg.destination
+        if service not in self.tree.services and service != MAPPER:
+            return None
+        reply = None
+        if msg.interface == "org.freedesktop.DBus.Properties":
+            reply = self.handle_properties(msg, service)
+        elif msg.interface == "org.freedesktop.DBus.ObjectManager":
+            reply = self.handle_object_manager(msg, service)
+        elif msg.interface == MAPPER and service == MAPPER:
+            reply = self.handle_mapper(msg)
+        if reply is None:
+            reply = Message.new_error(
+                msg,
+                "org.freedesktop.DBus.Error.UnknownMethod",
+                f"{msg.interface}.{msg.member} is not mocked",
+            )
+        self.bus.send(reply)
+        return True
+
+
+async def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument(
+        "--profile", choices=PROFILES.keys(), default="default"
+    )
+    parser.add_argument("--sensors", type=int, help="Overrides the profile")
+    parser.add_argument(
+        "--log-entries", type=int, help="Overrides the profile"
+    )
+    parser.add_argument(
+        "--ready-fd",
+        type=int,
+        help="Write a line to this fd once every name is owned",
+    )
+    args = parser.parse_args()
+
+    profile = PROFILES[args.profile]
+    sensors = args.sensors if args.sensors is not None else profile["sensors"]
+    log_entries = (
+        args.log_entries
+        if args.log_entries is not None
+        else profile["log_entries"]
+    )
+    tree = build_tree(sensors, log_entries)
+
+    bus = await MessageBus(bus_type=BusType.SYSTEM).connect()
+    mock = MockBus(bus, tree)
+    bus.add_message_handler(mock.handle)
+    for service in set(tree.services.keys()) | {MAPPER}:
+        await bus.request_name(service)
+
+    print(
+        f"Serving {sensors} sensors and {log_entries} log entries on "
+        f"{bus.unique_name}",
+        flush=True,
+    )
+    if args.ready_fd is not None:
+        os.write(args.ready_fd, b"ready\n")
+        os.close(args.ready_fd)
+    await bus.wait_for_disconnect()
+
+
+if __name__ == "__main__":
+    asyncio.run(main())
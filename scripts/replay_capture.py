@@ -0,0 +1,369 @@
+#!/usr/bin/env python3
+
+# Replays requests recorded by bmcweb's traffic-capture option, and reports
+# latency per route, so a real traffic mix can be compared between builds.
+#
+# The capture holds one JSON object per line; see http/traffic_capture.hpp.
+# Each captured connection is replayed on its own keep-alive connection, and
+# each request is sent when it arrived in the capture, scaled by --speed, or
+# once the previous request on its connection has been answered if that's
+# later.  Credentials and bodies aren't captured, so requests are sent with
+# basic auth from --username and --password, and only GET and HEAD requests
+# are replayed.  A request counts as an error when its status differs from
+# the captured one.
+#
+# With --bmcweb, starts a private D-Bus daemon, scripts/mock_dbus_tree.py and
+# the given bmcweb binary against it, as scripts/load_test.py does; see there
+# for how to build that bmcweb.  With --host, replays against a running one.
+#
+# Examples:
+#   replay_capture.py capture.jsonl --bmcweb old/bmcweb --no-ssl --json a.json
+#   replay_capture.py capture.jsonl --bmcweb new/bmcweb --no-ssl \
+#       --compare a.json
+#   replay_capture.py capture.jsonl --host 1.2.3.4:443 --speed 4
+#
+# requires the dbus-next package when using --bmcweb
+
+import argparse
+import asyncio
+import base64
+import json
+import math
+import os
+import re
+import signal
+import ssl
+import subprocess
+import sys
+import time
+
+parser = argparse.ArgumentParser()
+parser.add_argument("capture", help="File written by traffic-capture")
+target = parser.add_mutually_exclusive_group(required=True)
+target.add_argument("--bmcweb", help="bmcweb binary to start and replay to")
+target.add_argument("--host", help="Running bmcweb to replay to, host:port")
+parser.add_argument(
+    "--profile",
+    choices=["default", "large"],
+    default="default",
+    help="Object tree size for the mock; see mock_dbus_tree.py",
+)
+parser.add_argument(
+    "--speed",
+    type=float,
+    default=1.0,
+    help="Times faster than captured to send; 0 sends without waiting",
+)
+parser.add_argument(
+    "--username", help="Username to connect with", default="root"
+)
+parser.add_argument("--password", help="Password to use", default="0penBmc")
+parser.add_argument(
+    "--ssl", default=True, action=argparse.BooleanOptionalAction
+)
+parser.add_argument("--json", help="Also write the results to this file")
+parser.add_argument(
+    "--compare", help="Results of an earlier replay, to report changes from"
+)
+
+args = parser.parse_args()
+
+REPLAYED_METHODS = ("GET", "HEAD")
+
+# Set for each request by the replay itself
+SKIPPED_HEADERS = ("host", "connection", "content-length", "keep-alive")
+
+
+def load_capture(path):
+    """The replayable requests of a capture, by connection, and how many
+    requests were left out"""
+    connections = {}
+    skipped = 0
+    with open(path) as capture:
+        for line in capture:
+            if not line.strip():
+                continue
+            record = json.loads(line)
+            if (
+                record["method"] not in REPLAYED_METHODS
+                or record.get("body_bytes", 0) != 0
+            ):
+                skipped += 1
+                continue
+            connections.setdefault(record["connection"], []).append(record)
+    for records in connections.values():
+        records.sort(key=lambda record: record["at_us"])
+    return connections, skipped
+
+
+def route_of(record):
+    """The route a request is reported under"""
+    route = record.get("route")
+    if route is None:
+        route = record["target"].partition("?")[0]
+    return f"{record['method']} {route}"
+
+
+class Connection:
+    def __init__(self, host, port, ssl_context, auth):
+        self.host = host
+        self.port = port
+        self.ssl_context = ssl_context
+        self.auth = auth
+        self.reader = None
+        self.writer = None
+
+    async def connect(self):
+        self.reader, self.writer = await asyncio.open_connection(
+            self.host, self.port, ssl=self.ssl_context
+        )
+
+    async def send(self, record):
+        if self.writer is None:
+            await self.connect()
+        request = f"{record['method']} {record['target']} HTTP/1.1\r\n"
+        request += f"Host: {self.host}\r\n"
+        request += f"Authorization: Basic {self.auth}\r\n"
+        for name, value in record["headers"]:
+            if name.lower() not in SKIPPED_HEADERS:
+                request += f"{name}: {value}\r\n"
+        request += "Connection: keep-alive\r\n\r\n"
+        self.writer.write(request.encode())
+        await self.writer.drain()
+
+        status_line = await self.reader.readline()
+        if not status_line:
+            raise ConnectionError("connection closed")
+        status = int(status_line.split()[1])
+        headers = {}
+        while True:
+            line = await self.reader.readline()
+            if line in (b"\r\n", b""):
+                break
+            name, _, value = line.decode().partition(":")
+            headers[name.strip().lower()] = value.strip()
+
+        if record["method"] == "HEAD":
+            # No body follows, whatever the headers say
+            headers.pop("transfer-encoding", None)
+            headers["content-length"] = "0"
+        if headers.get("transfer-encoding") == "chunked":
+            while True:
+                size = int((await self.reader.readline()).strip(), 16)
+                if size == 0:
+                    await self.reader.readline()
+                    break
+                await self.reader.readexactly(size)
+                await self.reader.readline()
+        else:
+            length = int(headers.get("content-length", "0"))
+            await self.reader.readexactly(length)
+
+        if headers.get("connection") == "close":
+            self.close()
+        return status
+
+    def close(self):
+        if self.writer is not None:
+            self.writer.close()
+        self.reader = None
+        self.writer = None
+
+
+def percentile(sorted_values, fraction):
+    """Nearest-rank percentile of an already sorted list"""
+    if not sorted_values:
+        return 0.0
+    rank = max(math.ceil(fraction * len(sorted_values)), 1)
+    return sorted_values[rank - 1]
+
+
+async def replay_connection(conn, records, start, results):
+    for record in records:
+        if args.speed > 0:
+            due = start + record["at_us"] / 1e6 / args.speed
+            delay = due - time.perf_counter()
+            if delay > 0:
+                await asyncio.sleep(delay)
+        sent = time.perf_counter()
+        status = 0
+        # Once more on a new connection, if the server closed the old one
+        for _ in range(2):
+            try:
+                status = await conn.send(record)
+                break
+            except ConnectionError:
+                conn.close()
+            except (asyncio.IncompleteReadError, ValueError):
+                conn.close()
+                break
+        elapsed = time.perf_counter() - sent
+        route = results.setdefault(
+            route_of(record), {"latencies": [], "errors": 0}
+        )
+        route["latencies"].append(elapsed)
+        if status != record.get("status", status) or status == 0:
+            route["errors"] += 1
+    conn.close()
+
+
+async def run_replay(host, port, connections):
+    ssl_context = None
+    if args.ssl:
+        ssl_context = ssl.create_default_context()
+        ssl_context.check_hostname = False
+        ssl_context.verify_mode = ssl.CERT_NONE
+    auth = base64.b64encode(
+        f"{args.username}:{args.password}".encode()
+    ).decode()
+
+    results = {}
+    start = time.perf_counter()
+    await asyncio.gather(
+        *[
+            replay_connection(
+                Connection(host, port, ssl_context, auth),
+                records,
+                start,
+                results,
+            )
+            for records in connections.values()
+        ]
+    )
+    return results, time.perf_counter() - start
+
+
+def summarize(route):
+    latencies = sorted(route["latencies"])
+    return {
+        "requests": len(latencies),
+        "errors": route["errors"],
+        "p50_ms": percentile(latencies, 0.50) * 1000,
+        "p90_ms": percentile(latencies, 0.90) * 1000,
+        "p99_ms": percentile(latencies, 0.99) * 1000,
+    }
+
+
+def report(results, elapsed, baseline):
+    routes = {name: summarize(route) for name, route in results.items()}
+    header = (
+        f"{'route':<60}{'requests':>10}{'errors':>8}"
+        f"{'p50 ms':>10}{'p90 ms':>10}{'p99 ms':>10}"
+    )
+    if baseline is not None:
+        header += f"{'p50 diff':>10}{'p90 diff':>10}"
+    print(header)
+    for name in sorted(routes):
+        row = routes[name]
+        line = (
+            f"{name:<60}{row['requests']:>10}{row['errors']:>8}"
+            f"{row['p50_ms']:>10.2f}{row['p90_ms']:>10.2f}"
+            f"{row['p99_ms']:>10.2f}"
+        )
+        before = None
+        if baseline is not None:
+            before = baseline["routes"].get(name)
+        if before is not None:
+            line += (
+                f"{row['p50_ms'] - before['p50_ms']:>+10.2f}"
+                f"{row['p90_ms'] - before['p90_ms']:>+10.2f}"
+            )
+        print(line)
+    print(f"Replayed in {elapsed:.1f}s")
+    return {"duration_s": elapsed, "speed": args.speed, "routes": routes}
+
+
+async def wait_for_port(port, proc, timeout=30):
+    deadline = time.monotonic() + timeout
+    while time.monotonic() < deadline:
+        if proc.poll() is not None:
+            sys.exit(f"bmcweb exited with {proc.returncode}")
+        try:
+            _, writer = await asyncio.open_connection("127.0.0.1", port)
+            writer.close()
+            return
+        except OSError:
+            await asyncio.sleep(0.2)
+    sys.exit(f"bmcweb did not listen on {port} within {timeout}s")
+
+
+def start_stack():
+    """Starts dbus-daemon, the mock tree and bmcweb; returns their processes"""
+    daemon = subprocess.Popen(
+        ["dbus-daemon", "--session", "--nofork", "--print-address=1"],
+        stdout=subprocess.PIPE,
+        text=True,
+    )
+    address = daemon.stdout.readline().strip()
+    if not address:
+        sys.exit("dbus-daemon did not report an address")
+    env = dict(os.environ, DBUS_SYSTEM_BUS_ADDRESS=address)
+
+    ready_read, ready_write = os.pipe()
+    mock = subprocess.Popen(
+        [
+            sys.executable,
+            os.path.join(os.path.dirname(__file__), "mock_dbus_tree.py"),
+            "--profile",
+            args.profile,
+            "--ready-fd",
+            str(ready_write),
+        ],
+        env=env,
+        pass_fds=[ready_write],
+    )
+    os.close(ready_write)
+    with os.fdopen(ready_read) as ready:
+        if not ready.readline():
+            sys.exit("mock_dbus_tree.py failed to start")
+
+    bmcweb = subprocess.Popen([args.bmcweb], env=env)
+    return [bmcweb, mock, daemon]
+
+
+def main():
+    connections, skipped = load_capture(args.capture)
+    total = sum(len(records) for records in connections.values())
+    print(
+        f"Replaying {total} requests on {len(connections)} connections at "
+        f"{args.speed}x; skipped {skipped} requests that can't be replayed",
+        flush=True,
+    )
+
+    baseline = None
+    if args.compare:
+        with open(args.compare) as previous:
+            baseline = json.load(previous)
+
+    procs = []
+    if args.bmcweb:
+        procs = start_stack()
+        host = "127.0.0.1"
+        port = 18080
+    else:
+        match = re.fullmatch(r"(.+):(\d+)", args.host)
+        if match is None:
+            sys.exit("--host must be host:port")
+        host = match.group(1)
+        port = int(match.group(2))
+
+    async def run():
+        if procs:
+            await wait_for_port(port, procs[0])
+        return await run_replay(host, port, connections)
+
+    try:
+        results, elapsed = asyncio.run(run())
+    finally:
+        for proc in procs:
+            proc.send_signal(signal.SIGTERM)
+            proc.wait()
+
+    summary = report(results, elapsed, baseline)
+    if args.json:
+        with open(args.json, "w") as out:
+            json.dump(summary, out, indent=2)
+
+
+if __name__ == "__main__":
+    main()
@@ -41,6 +41,7 @@ oem_schema_names = [
     "OemMessage",
     "OemPCIeSlots",
     "OemFabricAdapter",
+    "OemEventDestination",
 ]
 
 SCRIPT_DIR = os.path.dirname(os.path.realpath(__file__))
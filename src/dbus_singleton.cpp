@@ -7,7 +7,8 @@ namespace crow
 namespace connections
 {
 
-sdbusplus::asio::connection* systemBus = nullptr;
+TracedConnection* systemBus = nullptr;
+TracedConnection* bulkBus = nullptr;
 
 } // namespace connections
 } // namespace crow
@@ -3,9 +3,14 @@
 
 #include <app.hpp>
 #include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <cors_preflight.hpp>
+#include <dbus_cache_snapshot.hpp>
+#include <dbus_introspect_cache.hpp>
 #include <dbus_monitor.hpp>
 #include <dbus_singleton.hpp>
+#include <dbus_utility.hpp>
 #include <event_dbus_monitor.hpp>
 #include <google/google_service_root.hpp>
 #include <hostname_monitor.hpp>
@@ -13,29 +18,56 @@
 #include <image_upload.hpp>
 #include <kvm_websocket.hpp>
 #include <login_routes.hpp>
+#include <metrics.hpp>
 #include <nbd_proxy.hpp>
 #include <obmc_console.hpp>
 #include <obmc_hypervisor.hpp>
 #include <obmc_shell.hpp>
 #include <openbmc_dbus_rest.hpp>
+#include <persistent_data.hpp>
 #include <redfish.hpp>
 #include <redfish_aggregator.hpp>
 #include <sdbusplus/asio/connection.hpp>
 #include <sdbusplus/bus.hpp>
 #include <sdbusplus/server.hpp>
 #include <security_headers.hpp>
+#include <sessions.hpp>
+#include <sensor_association_cache.hpp>
+#include <sensor_reading_cache.hpp>
+#include <sensor_stream.hpp>
 #include <ssl_key_handler.hpp>
+#ifdef BMCWEB_ENABLE_TRAFFIC_CAPTURE
+#include <traffic_capture.hpp>
+#endif
 #include <user_monitor.hpp>
+#include <utils/assembly_index.hpp>
+#include <utils/chassis_graph.hpp>
+#include <utils/fabric_topology.hpp>
+#include <utils/health_status_cache.hpp>
+#include <utils/hypervisor_state_cache.hpp>
+#include <utils/input_history_cache.hpp>
+#include <utils/led_state_cache.hpp>
+#include <utils/network_state_cache.hpp>
+#include <utils/pcie_topology.hpp>
+#include <utils/pid_config_cache.hpp>
+#include <utils/processor_model_cache.hpp>
+#include <utils/storage_inventory_cache.hpp>
+#include <utils/sw_inventory_cache.hpp>
+#include <utils/virtual_media_cache.hpp>
 #include <vm_websocket.hpp>
 #include <webassets.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <exception>
 #include <memory>
 #include <string>
+#include <string_view>
 
 constexpr int defaultPort = 18080;
 
-inline void setupSocket(crow::App& app)
+// Returns true when listening on a socket passed in by systemd
+inline bool setupSocket(crow::App& app)
 {
     int listenFd = sd_listen_fds(0);
     if (1 == listenFd)
@@ -47,6 +79,7 @@ inline void setupSocket(crow::App& app)
             BMCWEB_LOG_INFO << "Starting webserver on socket handle: "
                             << SD_LISTEN_FDS_START;
             app.socket(SD_LISTEN_FDS_START);
+            return true;
         }
         else
         {
@@ -62,6 +95,59 @@ inline void setupSocket(crow::App& app)
                         << "port: " << defaultPort;
         app.port(defaultPort);
     }
+    return false;
+}
+
+// Whether nothing is using bmcweb: no connections, websockets or event
+// subscriptions
+inline bool isIdle()
+{
+    if (crow::connectionCount > 0 || crow::websocket::websocketCount > 0)
+    {
+        return false;
+    }
+#ifdef BMCWEB_ENABLE_REDFISH
+    if (redfish::EventServiceManager::getInstance()
+            .getNumberOfSubscriptions() > 0)
+    {
+        return false;
+    }
+#endif
+    return true;
+}
+
+/**
+ * @brief Stops io once bmcweb has been idle for bmcwebIdleExitTimeoutSeconds.
+ * Only used when socket activated, where bmcweb.socket starts it again on the
+ * next connection.
+ */
+inline void watchForIdleExit(boost::asio::steady_timer& timer,
+                             boost::asio::io_context& io,
+                             std::chrono::steady_clock::time_point idleSince)
+{
+    const std::chrono::seconds timeout(bmcwebIdleExitTimeoutSeconds);
+    std::chrono::steady_clock::time_point now =
+        std::chrono::steady_clock::now();
+    if (!isIdle())
+    {
+        idleSince = now;
+    }
+    else if (now - idleSince >= timeout)
+    {
+        BMCWEB_LOG_INFO << "Exiting after " << timeout.count()
+                        << "s idle; socket activation will restart bmcweb";
+        io.stop();
+        return;
+    }
+    timer.expires_after(std::max(timeout / 4, std::chrono::seconds(1)));
+    timer.async_wait([&timer, &io, idleSince](
+                         const boost::system::error_code& ec) {
+        if (ec)
+        {
+            return;
+        }
+        watchForIdleExit(timer, io, idleSince);
+    });
 }
 
 static int run()
@@ -74,11 +160,89 @@ static int run()
     crow::Logger::setLogLevel(crow::LogLevel::Error);
 #endif
 
+    // With logging enabled, how long each part of startup took, so slow
+    // starts after a BMC reboot can be tracked down
+    const std::chrono::steady_clock::time_point startTime =
+        std::chrono::steady_clock::now();
+    auto logStartupPhase = [startTime](std::string_view phase) {
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - startTime);
+        BMCWEB_LOG_INFO << "Startup: " << phase << " after "
+                        << elapsed.count() << "ms";
+    };
+
     auto io = std::make_shared<boost::asio::io_context>();
     App app(io);
+    logStartupPhase("app created");
+
+#ifdef BMCWEB_ENABLE_TRAFFIC_CAPTURE
+    crow::capture::TrafficCapture::getInstance().open(
+        bmcwebTrafficCaptureFile);
+#endif
 
-    sdbusplus::asio::connection systemBus(*io);
+    crow::TracedConnection systemBus(*io);
     crow::connections::systemBus = &systemBus;
+#ifdef BMCWEB_ENABLE_DBUS_BULK_CONNECTION
+    crow::TracedConnection bulkBus(*io);
+    crow::connections::bulkBus = &bulkBus;
+#else
+    crow::connections::bulkBus = &systemBus;
+#endif
+    dbus::utility::DbusObjectCache::getInstance().registerMatches(systemBus);
+    dbus::utility::SensorReadingCache::getInstance().registerMatches(systemBus);
+    dbus::utility::SensorAssociationCache::getInstance().registerMatches(
+        systemBus);
+    dbus::utility::IntrospectCache::getInstance().registerMatches(systemBus);
+    redfish::fabric_util::FabricTopologyCache::getInstance().registerMatches(
+        systemBus);
+    redfish::pcie_util::PcieTopologyCache::getInstance().registerMatches(
+        systemBus);
+    redfish::assembly_utils::AssemblyIndex::getInstance().registerMatches(
+        systemBus);
+    redfish::chassis_utils::ChassisGraphCache::getInstance().registerMatches(
+        systemBus);
+    redfish::health_utils::HealthStatusCache::getInstance().registerMatches(
+        systemBus);
+    redfish::led_utils::LedStateCache::getInstance().registerMatches(
+        systemBus);
+    redfish::BiosTableCache::getInstance().registerMatches(systemBus);
+    redfish::LDAPConfigCache::getInstance().registerMatches(systemBus);
+    redfish::SnmpTrapClientCache::getInstance().registerMatches(systemBus);
+    redfish::telemetry::MetricDefinitionCache::getInstance().registerMatches(
+        systemBus);
+    redfish::telemetry::TelemetryConfigCache::getInstance().registerMatches(
+        systemBus);
+    redfish::network_utils::NetworkStateCache::getInstance().registerMatches(
+        systemBus);
+    redfish::network_utils::NetworkStateCache::getHypervisorInstance()
+        .registerMatches(systemBus);
+    redfish::hypervisor_utils::HypervisorStateCache::getInstance()
+        .registerMatches(systemBus);
+    redfish::pid_util::PidConfigCache::getInstance().registerMatches(
+        systemBus);
+    redfish::SystemSummaryCache::getInstance().registerMatches(systemBus);
+    redfish::processor_utils::ProcessorModelCache::getInstance()
+        .registerMatches(systemBus);
+    redfish::storage_utils::StorageInventoryCache::getInstance()
+        .registerMatches(systemBus);
+    redfish::sw_util::SoftwareInventoryCache::getInstance().registerMatches(
+        systemBus);
+    redfish::PostCodeCache::getInstance().registerMatches(systemBus);
+#ifdef BMCWEB_ENABLE_REDFISH_DUMP_LOG
+    redfish::DumpEntryCache::getInstance().registerMatches(systemBus);
+#endif
+#ifdef BMCWEB_ENABLE_REDFISH_DBUS_LOG_ENTRIES
+    redfish::DBusLogEntryCache::getInstance().registerMatches(systemBus);
+#endif
+#ifdef BMCWEB_NEW_POWERSUBSYSTEM_THERMALSUBSYSTEM
+    redfish::power_supply_utils::InputHistoryCache::getInstance()
+        .registerMatches(systemBus);
+#endif
+#ifdef BMCWEB_ENABLE_VM_NBDPROXY
+    redfish::vm_utils::VirtualMediaCache::getInstance().registerMatches(
+        systemBus);
+#endif
+    logStartupPhase("D-Bus caches registered");
 
     // Static assets need to be initialized before Authorization, because auth
     // needs to build the whitelist from the static routes
@@ -93,14 +257,7 @@ static int run()
 
 #ifdef BMCWEB_ENABLE_REDFISH
     redfish::RedfishService redfish(app);
-
-    // Create EventServiceManager instance and initialize Config
-    redfish::EventServiceManager::getInstance();
-
-#ifdef BMCWEB_ENABLE_REDFISH_AGGREGATION
-    // Create RedfishAggregator instance and initialize Config
-    redfish::RedfishAggregator::getInstance();
-#endif
+    logStartupPhase("Redfish routes registered");
 #endif
 
 #ifdef BMCWEB_ENABLE_DBUS_REST
@@ -112,6 +269,14 @@ static int run()
     crow::dbus_monitor::requestRoutes(app);
 #endif
 
+#ifdef BMCWEB_ENABLE_SENSOR_STREAM
+    crow::sensor_stream::requestRoutes(app);
+#endif
+
+#ifdef BMCWEB_ENABLE_METRICS
+    crow::metrics::requestRoutes(app);
+#endif
+
 #ifdef BMCWEB_ENABLE_HOST_SERIAL_WEBSOCKET
     crow::obmc_console::requestRoutes(app);
 #endif
@@ -130,7 +295,6 @@ static int run()
 
 #ifdef BMCWEB_ENABLE_IBM_MANAGEMENT_CONSOLE
     crow::ibm_mc::requestRoutes(app);
-    crow::ibm_mc_lock::Lock::getInstance();
     // Start BMC and Host state change dbus monitor
     crow::dbus_monitor::registerStateChangeSignal();
     // Start Dump created signal monitor for BMC and System Dump
@@ -160,7 +324,7 @@ static int run()
 
     crow::login_routes::requestRoutes(app);
 
-    setupSocket(app);
+    bool socketActivated = setupSocket(app);
 
 #ifdef BMCWEB_ENABLE_VM_NBDPROXY
     crow::nbd_proxy::requestRoutes(app);
@@ -181,10 +345,47 @@ static int run()
 #endif
 
     bmcweb::registerUserRemovedSignal();
+    bmcweb::registerUserChangedSignal();
+
+    persistent_data::SessionStore::getInstance().startTimeoutTimer(*io);
+    persistent_data::getConfig().startWriteTimer(*io);
+#ifdef BMCWEB_ENABLE_DBUS_CACHE_SNAPSHOT
+    dbus::utility::DbusCacheSnapshot::getInstance().start(*io);
+#endif
+
+    boost::asio::steady_timer idleTimer(*io);
+    if (bmcwebIdleExitTimeoutSeconds > 0 && socketActivated)
+    {
+        watchForIdleExit(idleTimer, *io, std::chrono::steady_clock::now());
+    }
+
+    // Anything that isn't needed to accept connections is set up once the
+    // listener is running.  Each of these is also created on first use, so a
+    // request that arrives before this runs still finds it.
+    boost::asio::post(*io, [logStartupPhase]() {
+#ifdef BMCWEB_ENABLE_REDFISH
+        // Create EventServiceManager instance and initialize Config
+        redfish::EventServiceManager::getInstance();
+#ifdef BMCWEB_ENABLE_REDFISH_AGGREGATION
+        // Create RedfishAggregator instance and initialize Config
+        redfish::RedfishAggregator::getInstance();
+#endif
+#endif
+#ifdef BMCWEB_ENABLE_IBM_MANAGEMENT_CONSOLE
+        crow::ibm_mc_lock::Lock::getInstance();
+#endif
+        logStartupPhase("deferred initialization done");
+    });
 
     app.run();
+    logStartupPhase("listening");
     io->run();
 
+    persistent_data::getConfig().stopWriteTimer();
+#ifdef BMCWEB_ENABLE_DBUS_CACHE_SNAPSHOT
+    dbus::utility::DbusCacheSnapshot::getInstance().stop();
+#endif
+    crow::connections::bulkBus = nullptr;
     crow::connections::systemBus = nullptr;
 
     return 0;
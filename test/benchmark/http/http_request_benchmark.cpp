@@ -0,0 +1,52 @@
+#include "http_request.hpp"
+
+#include <boost/beast/http/verb.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <string_view>
+#include <system_error>
+
+namespace crow
+{
+namespace
+{
+
+constexpr std::string_view collectionTarget =
+    "/redfish/v1/Systems/system/LogServices/EventLog/Entries"
+    "?$top=50&$skip=100&$expand=.($levels=1)";
+
+// What every request pays before its handler runs: parsing the target,
+// the copies the router and query delegation make, and reading the path and
+// query parameters
+void requestSetup(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        std::error_code ec;
+        Request req({boost::beast::http::verb::get, collectionTarget, 11}, ec);
+        Request routed(req);
+        Request delegated(routed);
+        benchmark::DoNotOptimize(delegated.url);
+        for (const auto& param : delegated.urlView.params())
+        {
+            benchmark::DoNotOptimize(param.key);
+        }
+    }
+}
+BENCHMARK(requestSetup);
+
+void requestCopy(benchmark::State& state)
+{
+    std::error_code ec;
+    Request req({boost::beast::http::verb::get, collectionTarget, 11}, ec);
+    for (auto _ : state)
+    {
+        Request copy(req);
+        benchmark::DoNotOptimize(copy.urlView);
+    }
+}
+BENCHMARK(requestCopy);
+
+} // namespace
+} // namespace crow
@@ -0,0 +1,93 @@
+#include "routing.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+namespace crow
+{
+namespace
+{
+
+// A route table shaped like the Redfish tree: static collections plus
+// parameterized members under each
+Trie makeRedfishTrie(std::vector<std::string>& staticUrls)
+{
+    Trie trie;
+    unsigned ruleIndex = 1;
+    for (const char* collection :
+         {"Systems", "Chassis", "Managers", "AccountService", "EventService",
+          "UpdateService", "SessionService", "TaskService", "Registries"})
+    {
+        std::string base = std::string("/redfish/v1/") + collection;
+        for (const char* leaf :
+             {"", "/", "/Members", "/Settings", "/Actions", "/LogServices"})
+        {
+            staticUrls.push_back(base + leaf);
+            trie.add(staticUrls.back(), ruleIndex++);
+        }
+        trie.add(base + "/<str>", ruleIndex++);
+        trie.add(base + "/<str>/LogServices/<str>", ruleIndex++);
+        trie.add(base + "/<str>/LogServices/<str>/Entries/<str>",
+                 ruleIndex++);
+    }
+    trie.validate();
+    return trie;
+}
+
+void trieFindStatic(benchmark::State& state)
+{
+    std::vector<std::string> urls;
+    Trie trie = makeRedfishTrie(urls);
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(trie.find(urls[i++ % urls.size()]));
+    }
+}
+BENCHMARK(trieFindStatic);
+
+// The same lookups without the table of static routes, for comparison
+void trieFindStaticWalk(benchmark::State& state)
+{
+    std::vector<std::string> urls;
+    Trie trie = makeRedfishTrie(urls);
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(trie.findInTrie(urls[i++ % urls.size()]));
+    }
+}
+BENCHMARK(trieFindStaticWalk);
+
+void trieFindParameterized(benchmark::State& state)
+{
+    std::vector<std::string> staticUrls;
+    Trie trie = makeRedfishTrie(staticUrls);
+    std::vector<std::string> urls = {
+        "/redfish/v1/Systems/system",
+        "/redfish/v1/Chassis/chassis/LogServices/EventLog",
+        "/redfish/v1/Managers/bmc/LogServices/Journal/Entries/1234",
+        "/redfish/v1/TaskService/Tasks"};
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(trie.find(urls[i++ % urls.size()]));
+    }
+}
+BENCHMARK(trieFindParameterized);
+
+void trieFindMiss(benchmark::State& state)
+{
+    std::vector<std::string> urls;
+    Trie trie = makeRedfishTrie(urls);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(trie.find("/redfish/v2/NotARoute/at/all"));
+    }
+}
+BENCHMARK(trieFindMiss);
+
+} // namespace
+} // namespace crow
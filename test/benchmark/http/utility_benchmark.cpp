@@ -0,0 +1,124 @@
+#include "utility.hpp"
+
+#include <boost/url/parse.hpp>
+#include <boost/url/url_view.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace crow
+{
+namespace utility
+{
+namespace
+{
+
+void parseRelativeRef(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(boost::urls::parse_relative_ref(
+            "/redfish/v1/Systems/system/LogServices/EventLog/Entries"
+            "?$top=50&$skip=100&$expand=.($levels=1)"));
+    }
+}
+BENCHMARK(parseRelativeRef);
+
+void readUrlSegmentsMatch(benchmark::State& state)
+{
+    boost::system::result<boost::urls::url_view> parsed =
+        boost::urls::parse_relative_ref(
+            "/redfish/v1/Systems/system/LogServices/EventLog/Entries/1234");
+    std::string system;
+    std::string service;
+    std::string entry;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(readUrlSegments(
+            *parsed, "redfish", "v1", "Systems", std::ref(system),
+            "LogServices", std::ref(service), "Entries", std::ref(entry)));
+    }
+}
+BENCHMARK(readUrlSegmentsMatch);
+
+void validateAndSplitUrlBenchmark(benchmark::State& state)
+{
+    std::string proto;
+    std::string host;
+    uint16_t port = 0;
+    std::string path;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(validateAndSplitUrl(
+            "https://subscriber.example.com:8443/events/redfish", proto, host,
+            port, path));
+    }
+}
+BENCHMARK(validateAndSplitUrlBenchmark);
+
+void base64EncodeAttachment(benchmark::State& state)
+{
+    std::string data(65536, '\0');
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = static_cast<char>(i * 31);
+    }
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(base64encode(data));
+    }
+    state.SetBytesProcessed(state.iterations() *
+                            static_cast<int64_t>(data.size()));
+}
+BENCHMARK(base64EncodeAttachment);
+
+void base64DecodeAttachment(benchmark::State& state)
+{
+    std::string data(65536, '\0');
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = static_cast<char>(i * 31);
+    }
+    std::string encoded = base64encode(data);
+    std::string decoded;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(base64Decode(encoded, decoded));
+    }
+    state.SetBytesProcessed(state.iterations() *
+                            static_cast<int64_t>(encoded.size()));
+}
+BENCHMARK(base64DecodeAttachment);
+
+void urlFromPiecesSensor(benchmark::State& state)
+{
+    std::string chassis = "chassis";
+    std::string sensor = "fan_tach_0";
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(
+            urlFromPieces("redfish", "v1", "Chassis", chassis, "Sensors",
+                          sensor)
+                .buffer());
+    }
+}
+BENCHMARK(urlFromPiecesSensor);
+
+void urlPathSensor(benchmark::State& state)
+{
+    std::string chassis = "chassis";
+    std::string sensor = "fan_tach_0";
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(
+            urlPath<"/redfish/v1/Chassis/{}/Sensors/{}">(chassis, sensor));
+    }
+}
+BENCHMARK(urlPathSensor);
+
+} // namespace
+} // namespace utility
+} // namespace crow
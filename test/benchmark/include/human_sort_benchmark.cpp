@@ -0,0 +1,40 @@
+#include "human_sort.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+void alphanumCompare(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(alphanumComp("/redfish/v1/Chassis/dimm123",
+                                              "/redfish/v1/Chassis/dimm1234"));
+    }
+}
+BENCHMARK(alphanumCompare);
+
+// Sorting collection members, as every collection handler does
+void alphanumSortMembers(benchmark::State& state)
+{
+    std::vector<std::string> names;
+    for (int64_t i = state.range(0); i > 0; i--)
+    {
+        names.push_back("/redfish/v1/Chassis/chassis/Sensors/temp_" +
+                        std::to_string(i * 7919 % state.range(0)));
+    }
+    for (auto _ : state)
+    {
+        std::vector<std::string> sorted = names;
+        std::sort(sorted.begin(), sorted.end(), AlphanumLess<std::string>());
+        benchmark::DoNotOptimize(sorted);
+    }
+}
+BENCHMARK(alphanumSortMembers)->Arg(64)->Arg(1024);
+
+} // namespace
@@ -0,0 +1,68 @@
+#include "json_html_serializer.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+namespace json_html_util
+{
+namespace
+{
+
+// A collection of log entries, the largest responses bmcweb commonly sends
+nlohmann::json makeLogCollection(int64_t members)
+{
+    nlohmann::json::array_t entries;
+    for (int64_t i = 0; i < members; i++)
+    {
+        std::string id = std::to_string(i);
+        nlohmann::json::object_t entry;
+        entry["@odata.id"] =
+            "/redfish/v1/Systems/system/LogServices/EventLog/Entries/" + id;
+        entry["@odata.type"] = "#LogEntry.v1_9_0.LogEntry";
+        entry["Id"] = id;
+        entry["Name"] = "System Event Log Entry";
+        entry["Created"] = "2023-01-01T00:00:00+00:00";
+        entry["EntryType"] = "Event";
+        entry["Message"] = "The \"resource\" <property> has changed & so on";
+        entry["MessageArgs"] = nlohmann::json::array({"a", "b", 1.5, -3});
+        entry["Severity"] = "OK";
+        entry["Resolved"] = false;
+        entries.emplace_back(std::move(entry));
+    }
+    nlohmann::json collection;
+    collection["@odata.id"] =
+        "/redfish/v1/Systems/system/LogServices/EventLog/Entries";
+    collection["Members"] = std::move(entries);
+    collection["Members@odata.count"] = members;
+    return collection;
+}
+
+void jsonDump(benchmark::State& state)
+{
+    nlohmann::json json = makeLogCollection(state.range(0));
+    for (auto _ : state)
+    {
+        std::string out;
+        dump(out, json);
+        benchmark::DoNotOptimize(out);
+    }
+}
+BENCHMARK(jsonDump)->Arg(10)->Arg(1000);
+
+void jsonDumpHtml(benchmark::State& state)
+{
+    nlohmann::json json = makeLogCollection(state.range(0));
+    for (auto _ : state)
+    {
+        std::string out;
+        dumpHtml(out, json);
+        benchmark::DoNotOptimize(out);
+    }
+}
+BENCHMARK(jsonDumpHtml)->Arg(10)->Arg(1000)->Arg(10000);
+
+} // namespace
+} // namespace json_html_util
@@ -0,0 +1,77 @@
+#include "json_stream_serializer.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace json_stream
+{
+namespace
+{
+
+// A collection of log entries, the largest responses bmcweb commonly sends
+nlohmann::json makeLogCollection(int64_t members)
+{
+    nlohmann::json::array_t entries;
+    for (int64_t i = 0; i < members; i++)
+    {
+        std::string id = std::to_string(i);
+        nlohmann::json::object_t entry;
+        entry["@odata.id"] =
+            "/redfish/v1/Systems/system/LogServices/EventLog/Entries/" + id;
+        entry["@odata.type"] = "#LogEntry.v1_9_0.LogEntry";
+        entry["Id"] = id;
+        entry["Name"] = "System Event Log Entry";
+        entry["Created"] = "2023-01-01T00:00:00+00:00";
+        entry["EntryType"] = "Event";
+        entry["Message"] = "The \"resource\" property has changed";
+        entry["MessageArgs"] = nlohmann::json::array({"a", "b", 1.5, -3});
+        entry["Severity"] = "OK";
+        entry["Resolved"] = false;
+        entries.emplace_back(std::move(entry));
+    }
+    nlohmann::json collection;
+    collection["@odata.id"] =
+        "/redfish/v1/Systems/system/LogServices/EventLog/Entries";
+    collection["Members"] = std::move(entries);
+    collection["Members@odata.count"] = members;
+    return collection;
+}
+
+// Serializes the whole document 16KiB at a time, as a connection does
+void jsonChunkSerialize(benchmark::State& state)
+{
+    nlohmann::json json = makeLogCollection(state.range(0));
+    for (auto _ : state)
+    {
+        JsonChunkSerializer serializer(json);
+        size_t total = 0;
+        while (!serializer.done())
+        {
+            std::string chunk;
+            serializer.fill(chunk, 16384);
+            total += chunk.size();
+        }
+        benchmark::DoNotOptimize(total);
+    }
+}
+BENCHMARK(jsonChunkSerialize)->Arg(10)->Arg(1000)->Arg(10000);
+
+void jsonDumpReference(benchmark::State& state)
+{
+    nlohmann::json json = makeLogCollection(state.range(0));
+    for (auto _ : state)
+    {
+        std::string out =
+            json.dump(2, ' ', true, nlohmann::json::error_handler_t::replace);
+        benchmark::DoNotOptimize(out);
+    }
+}
+BENCHMARK(jsonDumpReference)->Arg(10)->Arg(1000)->Arg(10000);
+
+} // namespace
+} // namespace json_stream
@@ -0,0 +1,49 @@
+#include "http_request.hpp"
+#include "multipart_parser.hpp"
+
+#include <boost/beast/http/message.hpp>
+#include <boost/beast/http/string_body.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <system_error>
+
+namespace
+{
+
+// A form with a short text field and a binary blob of state.range(0) bytes,
+// as sent when uploading a certificate or firmware image
+void multipartParse(benchmark::State& state)
+{
+    boost::beast::http::request<boost::beast::http::string_body> req;
+    req.set("Content-Type",
+            "multipart/form-data; "
+            "boundary=---------------------------d74496d66958873e");
+    req.body() = "-----------------------------d74496d66958873e\r\n"
+                 "Content-Disposition: form-data; name=\"UpdateParameters\""
+                 "\r\n\r\n"
+                 "{\"Targets\":[\"/redfish/v1/Managers/bmc\"]}\r\n"
+                 "-----------------------------d74496d66958873e\r\n"
+                 "Content-Disposition: form-data; name=\"UpdateFile\"\r\n"
+                 "Content-Type: application/octet-stream\r\n\r\n";
+    for (int64_t i = 0; i < state.range(0); i++)
+    {
+        // Dashes and CRs exercise the boundary lookbehind
+        req.body() += static_cast<char>("-\r\n\x01\xfe"[i % 5]);
+    }
+    req.body() += "\r\n-----------------------------d74496d66958873e--\r\n";
+
+    std::error_code ec;
+    crow::Request reqIn(req, ec);
+    for (auto _ : state)
+    {
+        MultipartParser parser;
+        benchmark::DoNotOptimize(parser.parse(reqIn));
+    }
+    state.SetBytesProcessed(state.iterations() *
+                            static_cast<int64_t>(req.body().size()));
+}
+BENCHMARK(multipartParse)->Arg(1024)->Arg(64 * 1024)->Arg(1024 * 1024);
+
+} // namespace
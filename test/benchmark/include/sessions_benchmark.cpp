@@ -0,0 +1,63 @@
+#include "sessions.hpp"
+
+#include <boost/asio/ip/address.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace persistent_data
+{
+namespace
+{
+
+// Token lookup against a store holding state.range(0) sessions, as done
+// for every request that uses X-Auth-Token
+void loginSessionByTokenBenchmark(benchmark::State& state)
+{
+    SessionStore& store = SessionStore::getInstance();
+    std::vector<std::shared_ptr<UserSession>> sessions;
+    for (int64_t i = 0; i < state.range(0); i++)
+    {
+        sessions.emplace_back(store.generateUserSession(
+            "user" + std::to_string(i),
+            boost::asio::ip::make_address("10.0.0.1"), std::nullopt));
+    }
+    std::string missing(sessionTokenSize, 'x');
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(store.loginSessionByToken(
+            sessions[i++ % sessions.size()]->sessionToken));
+        benchmark::DoNotOptimize(store.loginSessionByToken(missing));
+    }
+
+    for (const std::shared_ptr<UserSession>& session : sessions)
+    {
+        store.removeSession(session);
+    }
+}
+BENCHMARK(loginSessionByTokenBenchmark)->Arg(1)->Arg(64);
+
+// Token generation for a login, without the write to disk
+void generateUserSessionBenchmark(benchmark::State& state)
+{
+    SessionStore& store = SessionStore::getInstance();
+    boost::asio::ip::address clientIp =
+        boost::asio::ip::make_address("10.0.0.1");
+    for (auto _ : state)
+    {
+        std::shared_ptr<UserSession> session = store.generateUserSession(
+            "user", clientIp, std::nullopt, PersistenceType::SINGLE_REQUEST);
+        benchmark::DoNotOptimize(session);
+        store.removeSession(session);
+    }
+}
+BENCHMARK(generateUserSessionBenchmark);
+
+} // namespace
+} // namespace persistent_data
@@ -0,0 +1,58 @@
+#include "privileges.hpp"
+
+#include <boost/beast/http/verb.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+namespace redfish
+{
+namespace
+{
+
+void getUserPrivilegesBenchmark(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(getUserPrivileges("priv-operator"));
+    }
+}
+BENCHMARK(getUserPrivilegesBenchmark);
+
+// The check made for each request that needs more than Login; the
+// operator only satisfies the last alternative
+void operationAllowed(benchmark::State& state)
+{
+    std::vector<Privileges> required = {{"ConfigureManager"},
+                                        {"ConfigureUsers"},
+                                        {"ConfigureComponents"}};
+    const Privileges& userPrivileges = getUserPrivileges("priv-operator");
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(
+            isOperationAllowedWithPrivileges(required, userPrivileges));
+    }
+}
+BENCHMARK(operationAllowed);
+
+void methodAllowed(benchmark::State& state)
+{
+    OperationMap operationMap = {
+        {boost::beast::http::verb::get, {{"Login"}}},
+        {boost::beast::http::verb::patch, {{"ConfigureManager"}}},
+        {boost::beast::http::verb::post, {{"ConfigureManager"}}}};
+    const Privileges& userPrivileges = getUserPrivileges("priv-readonly");
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(isMethodAllowedWithPrivileges(
+            boost::beast::http::verb::get, operationMap, userPrivileges));
+        benchmark::DoNotOptimize(isMethodAllowedWithPrivileges(
+            boost::beast::http::verb::patch, operationMap, userPrivileges));
+    }
+}
+BENCHMARK(methodAllowed);
+
+} // namespace
+} // namespace redfish
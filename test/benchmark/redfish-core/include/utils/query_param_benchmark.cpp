@@ -0,0 +1,73 @@
+#include "http_response.hpp"
+#include "utils/query_param.hpp"
+
+#include <boost/url/parse.hpp>
+#include <boost/url/url_view.hpp>
+#include <nlohmann/json.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace redfish
+{
+namespace query_param
+{
+namespace
+{
+
+void parseParametersBenchmark(benchmark::State& state)
+{
+    boost::system::result<boost::urls::url_view> url =
+        boost::urls::parse_relative_ref(
+            "/redfish/v1/Systems/system/LogServices/EventLog/Entries"
+            "?$top=50&$skip=100&$select=Id,Name,Created,Message");
+    for (auto _ : state)
+    {
+        crow::Response res;
+        benchmark::DoNotOptimize(
+            parseParameters(url->params(), res, url->encoded_path()));
+    }
+}
+BENCHMARK(parseParametersBenchmark);
+
+// $select over a collection of state.range(0) members
+void recursiveSelectBenchmark(benchmark::State& state)
+{
+    nlohmann::json::array_t members;
+    for (int64_t i = 0; i < state.range(0); i++)
+    {
+        nlohmann::json::object_t member;
+        member["@odata.id"] = "/redfish/v1/Chassis/chassis/Sensors/" +
+                              std::to_string(i);
+        member["Id"] = std::to_string(i);
+        member["Name"] = "Sensor";
+        member["Reading"] = 21.5;
+        member["Status"] = {{"State", "Enabled"}, {"Health", "OK"}};
+        member["Thresholds"] = {{"UpperCritical", {{"Reading", 90}}},
+                                {"LowerCritical", {{"Reading", 5}}}};
+        members.emplace_back(std::move(member));
+    }
+    nlohmann::json root;
+    root["Members"] = std::move(members);
+
+    SelectTrie trie;
+    for (std::string_view property :
+         {"Members/Id", "Members/Reading", "Members/Status/Health"})
+    {
+        trie.insertNode(property);
+    }
+    for (auto _ : state)
+    {
+        nlohmann::json copy = root;
+        recursiveSelect(copy, trie.root);
+        benchmark::DoNotOptimize(copy);
+    }
+}
+BENCHMARK(recursiveSelectBenchmark)->Arg(16)->Arg(256);
+
+} // namespace
+} // namespace query_param
+} // namespace redfish
@@ -0,0 +1,114 @@
+#include "admission_control.hpp"
+
+#include <chrono>
+#include <optional>
+#include <vector>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace crow
+{
+namespace
+{
+
+using boost::beast::http::verb;
+
+TEST(ClassifyRequest, SeparatesHealthChecksFromHeavyQueries)
+{
+    EXPECT_EQ(classifyRequest(verb::get, "/redfish/v1", ""),
+              RequestClass::Light);
+    EXPECT_EQ(classifyRequest(verb::post, "/redfish/v1/", ""),
+              RequestClass::Normal);
+    EXPECT_EQ(classifyRequest(verb::get, "/redfish/v1/Systems", "$expand=."),
+              RequestClass::Heavy);
+    EXPECT_EQ(classifyRequest(verb::get, "/bus/system/xyz/enumerate", ""),
+              RequestClass::Heavy);
+    EXPECT_EQ(classifyRequest(verb::get, "/redfish/v1/Chassis", "$top=2"),
+              RequestClass::Normal);
+    EXPECT_EQ(classifyRequest(
+                  verb::get,
+                  "/redfish/v1/Systems/system/LogServices/EventLog/Entries",
+                  ""),
+              RequestClass::Heavy);
+    EXPECT_EQ(classifyRequest(
+                  verb::post,
+                  "/redfish/v1/CertificateService/Actions/"
+                  "CertificateService.GenerateCSR",
+                  ""),
+              RequestClass::Heavy);
+}
+
+TEST(AdmissionController, BoundsRequestsInFlight)
+{
+    AdmissionController controller(4, 0);
+    auto now = std::chrono::steady_clock::now();
+    std::chrono::seconds retryAfter{0};
+
+    std::vector<AdmissionTicket> tickets;
+    for (int i = 0; i < 2; i++)
+    {
+        std::optional<AdmissionTicket> ticket = controller.admit(
+            RequestClass::Heavy, "10.0.0.1", "", now, retryAfter);
+        ASSERT_TRUE(ticket);
+        tickets.emplace_back(std::move(*ticket));
+    }
+    // Heavy requests only get half of the slots
+    EXPECT_FALSE(controller.admit(RequestClass::Heavy, "10.0.0.1", "", now,
+                                  retryAfter));
+    EXPECT_EQ(retryAfter, std::chrono::seconds(1));
+
+    for (int i = 0; i < 2; i++)
+    {
+        std::optional<AdmissionTicket> ticket = controller.admit(
+            RequestClass::Normal, "10.0.0.1", "", now, retryAfter);
+        ASSERT_TRUE(ticket);
+        tickets.emplace_back(std::move(*ticket));
+    }
+    EXPECT_FALSE(controller.admit(RequestClass::Normal, "10.0.0.1", "", now,
+                                  retryAfter));
+    // Health checks still get through
+    EXPECT_TRUE(controller.admit(RequestClass::Light, "10.0.0.1", "", now,
+                                 retryAfter));
+    EXPECT_EQ(controller.inFlightCount(), 4U);
+
+    tickets.clear();
+    EXPECT_EQ(controller.inFlightCount(), 0U);
+    EXPECT_TRUE(controller.admit(RequestClass::Normal, "10.0.0.1", "", now,
+                                 retryAfter));
+}
+
+TEST(AdmissionController, RateLimitsClientsAndSessions)
+{
+    AdmissionController controller(0, 2);
+    auto now = std::chrono::steady_clock::now();
+    std::chrono::seconds retryAfter{0};
+
+    // Bursts of twice the rate are allowed
+    for (int i = 0; i < 4; i++)
+    {
+        EXPECT_TRUE(controller.admit(RequestClass::Normal, "10.0.0.1",
+                                     "session", now, retryAfter));
+    }
+    EXPECT_FALSE(controller.admit(RequestClass::Normal, "10.0.0.1", "session",
+                                  now, retryAfter));
+    EXPECT_EQ(retryAfter, std::chrono::seconds(1));
+
+    // The session is limited from any address
+    EXPECT_FALSE(controller.admit(RequestClass::Normal, "10.0.0.2", "session",
+                                  now, retryAfter));
+    EXPECT_TRUE(controller.admit(RequestClass::Normal, "10.0.0.2", "", now,
+                                 retryAfter));
+    EXPECT_TRUE(controller.admit(RequestClass::Light, "10.0.0.1", "session",
+                                 now, retryAfter));
+
+    now += std::chrono::seconds(1);
+    EXPECT_TRUE(controller.admit(RequestClass::Normal, "10.0.0.1", "session",
+                                 now, retryAfter));
+}
+
+} // namespace
+} // namespace crow
@@ -0,0 +1,106 @@
+#include "async_file.hpp"
+
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace crow::async_file
+{
+namespace
+{
+
+std::filesystem::path writeTestFile(std::string_view name,
+                                    std::string_view contents)
+{
+    std::filesystem::path path = std::filesystem::temp_directory_path() /
+                                 name;
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << contents;
+    return path;
+}
+
+TEST(ReadFile, ReadsWholeFile)
+{
+    std::filesystem::path path = writeTestFile("bmcweb_async_file_read",
+                                               "some contents");
+    std::string contents;
+    EXPECT_FALSE(readFile(path.string(), contents, 100));
+    EXPECT_EQ(contents, "some contents");
+    std::filesystem::remove(path);
+}
+
+TEST(ReadFile, RejectsMissingLargeAndNonRegularFiles)
+{
+    std::filesystem::path path = writeTestFile("bmcweb_async_file_large",
+                                               "0123456789");
+    std::string contents = "stale";
+    EXPECT_EQ(readFile(path.string(), contents, 9),
+              boost::system::errc::file_too_large);
+    EXPECT_EQ(contents, "");
+    std::filesystem::remove(path);
+
+    EXPECT_EQ(readFile(path.string(), contents, 100),
+              boost::system::errc::no_such_file_or_directory);
+    EXPECT_EQ(readFile(std::filesystem::temp_directory_path().string(),
+                       contents, 100),
+              boost::system::errc::invalid_argument);
+}
+
+TEST(AsyncReadFile, CallsBackOnExecutor)
+{
+    std::filesystem::path path = writeTestFile("bmcweb_async_file_async",
+                                               "async contents");
+    boost::asio::io_context io;
+    // The read may still be on a worker thread when run() starts
+    auto work = boost::asio::make_work_guard(io);
+    bool called = false;
+    asyncReadFile(io.get_executor(), path.string(), 100,
+                  [&called, &work](const boost::system::error_code& ec,
+                                   std::string&& contents) {
+        called = true;
+        EXPECT_FALSE(ec);
+        EXPECT_EQ(contents, "async contents");
+        work.reset();
+    });
+    io.run();
+    EXPECT_TRUE(called);
+    std::filesystem::remove(path);
+}
+
+bool writeTestContents(const std::string& path, std::string_view contents)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << contents;
+    return static_cast<bool>(file);
+}
+
+TEST(OrderedWriter, LastWriteWins)
+{
+    std::filesystem::path path = std::filesystem::temp_directory_path() /
+                                 "bmcweb_async_file_ordered";
+    OrderedWriter writer(path.string(), writeTestContents);
+    boost::asio::io_context io;
+    writer.write(io.get_executor(), "first");
+    writer.write(io.get_executor(), "second");
+    EXPECT_TRUE(writer.writeNow("third"));
+    io.run();
+
+    std::string contents;
+    EXPECT_FALSE(readFile(path.string(), contents, 100));
+    EXPECT_EQ(contents, "third");
+    std::filesystem::remove(path);
+}
+
+} // namespace
+} // namespace crow::async_file
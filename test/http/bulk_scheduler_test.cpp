@@ -0,0 +1,54 @@
+#include "bulk_scheduler.hpp"
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+
+#include <string>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace crow
+{
+namespace
+{
+
+TEST(BulkScheduler, InterleavesOtherWorkBetweenTasks)
+{
+    boost::asio::io_context io;
+    BulkScheduler scheduler(io);
+    std::string order;
+
+    scheduler.post([&order]() { order += 'A'; });
+    scheduler.post([&order]() { order += 'B'; });
+    scheduler.post([&order]() { order += 'C'; });
+    boost::asio::post(io, [&order]() { order += '1'; });
+    boost::asio::post(io, [&order]() { order += '2'; });
+    EXPECT_EQ(scheduler.pending(), 3U);
+
+    io.run();
+    EXPECT_EQ(order, "A12BC");
+    EXPECT_EQ(scheduler.pending(), 0U);
+}
+
+TEST(BulkScheduler, TasksCanQueueMoreWork)
+{
+    boost::asio::io_context io;
+    BulkScheduler scheduler(io);
+    std::string order;
+
+    scheduler.post([&]() {
+        order += 'A';
+        scheduler.post([&order]() { order += 'B'; });
+        boost::asio::post(io, [&order]() { order += '1'; });
+    });
+
+    io.run();
+    EXPECT_EQ(order, "A1B");
+}
+
+} // namespace
+} // namespace crow
@@ -0,0 +1,92 @@
+#include "byte_range.hpp"
+
+#include <cstdint>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace crow::byte_range
+{
+namespace
+{
+
+TEST(ParseRange, SelectsOneRange)
+{
+    RangeSelection selection = parseRange("bytes=10-19", 100);
+    ASSERT_EQ(selection.status, RangeStatus::Partial);
+    EXPECT_EQ(selection.range.first, 10);
+    EXPECT_EQ(selection.range.last, 19);
+    EXPECT_EQ(selection.range.length(), 10);
+
+    selection = parseRange("bytes=90-", 100);
+    ASSERT_EQ(selection.status, RangeStatus::Partial);
+    EXPECT_EQ(selection.range.first, 90);
+    EXPECT_EQ(selection.range.last, 99);
+
+    selection = parseRange("Bytes = 0-1000", 100);
+    ASSERT_EQ(selection.status, RangeStatus::Full);
+
+    selection = parseRange("bytes=0-1000", 100);
+    ASSERT_EQ(selection.status, RangeStatus::Partial);
+    EXPECT_EQ(selection.range.first, 0);
+    EXPECT_EQ(selection.range.last, 99);
+}
+
+TEST(ParseRange, SelectsSuffix)
+{
+    RangeSelection selection = parseRange("bytes=-10", 100);
+    ASSERT_EQ(selection.status, RangeStatus::Partial);
+    EXPECT_EQ(selection.range.first, 90);
+    EXPECT_EQ(selection.range.last, 99);
+
+    selection = parseRange("bytes=-1000", 100);
+    ASSERT_EQ(selection.status, RangeStatus::Partial);
+    EXPECT_EQ(selection.range.first, 0);
+    EXPECT_EQ(selection.range.last, 99);
+
+    EXPECT_EQ(parseRange("bytes=-0", 100).status, RangeStatus::Unsatisfiable);
+    EXPECT_EQ(parseRange("bytes=-10", 0).status, RangeStatus::Unsatisfiable);
+}
+
+TEST(ParseRange, RejectsRangesPastTheEnd)
+{
+    EXPECT_EQ(parseRange("bytes=100-", 100).status,
+              RangeStatus::Unsatisfiable);
+    EXPECT_EQ(parseRange("bytes=200-300", 100).status,
+              RangeStatus::Unsatisfiable);
+}
+
+TEST(ParseRange, IgnoresWhatItDoesNotSupport)
+{
+    EXPECT_EQ(parseRange("", 100).status, RangeStatus::Full);
+    EXPECT_EQ(parseRange("items=0-10", 100).status, RangeStatus::Full);
+    EXPECT_EQ(parseRange("bytes=0-10,20-30", 100).status, RangeStatus::Full);
+    EXPECT_EQ(parseRange("bytes=20-10", 100).status, RangeStatus::Full);
+    EXPECT_EQ(parseRange("bytes=a-10", 100).status, RangeStatus::Full);
+    EXPECT_EQ(parseRange("bytes=10", 100).status, RangeStatus::Full);
+    EXPECT_EQ(parseRange("bytes=-", 100).status, RangeStatus::Full);
+}
+
+TEST(SelectRange, HonorsIfRange)
+{
+    EXPECT_EQ(selectRange("bytes=10-", "", 100, "\"a\"").status,
+              RangeStatus::Partial);
+    EXPECT_EQ(selectRange("bytes=10-", "\"a\"", 100, "\"a\"").status,
+              RangeStatus::Partial);
+    EXPECT_EQ(selectRange("bytes=10-", "\"b\"", 100, "\"a\"").status,
+              RangeStatus::Full);
+    EXPECT_EQ(selectRange("bytes=10-", "\"a\"", 100, "").status,
+              RangeStatus::Full);
+}
+
+TEST(ContentRange, Formats)
+{
+    EXPECT_EQ(contentRange(ByteRange{10, 19}, 100), "bytes 10-19/100");
+    EXPECT_EQ(unsatisfiedRange(100), "bytes */100");
+}
+
+} // namespace
+} // namespace crow::byte_range
@@ -0,0 +1,97 @@
+#include "cancellation.hpp"
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <boost/beast/http/verb.hpp>
+
+#include <array>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace crow
+{
+namespace
+{
+
+// A connected pair of loopback TCP sockets, client first
+std::array<int, 2> connectedPair()
+{
+    int listener = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t len = sizeof(addr);
+    EXPECT_EQ(
+        ::bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+    EXPECT_EQ(::listen(listener, 1), 0);
+    EXPECT_EQ(
+        ::getsockname(listener, reinterpret_cast<sockaddr*>(&addr), &len), 0);
+    int client = ::socket(AF_INET, SOCK_STREAM, 0);
+    EXPECT_EQ(
+        ::connect(client, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)),
+        0);
+    int server = ::accept(listener, nullptr, nullptr);
+    ::close(listener);
+    return {client, server};
+}
+
+TEST(PeekPeerState, DataIsLeftToRead)
+{
+    std::array<int, 2> fds = connectedPair();
+    EXPECT_EQ(peekPeerState(fds[1]), PeerState::Idle);
+
+    ASSERT_EQ(::send(fds[0], "G", 1, 0), 1);
+    EXPECT_EQ(peekPeerState(fds[1]), PeerState::Sending);
+    char byte = 0;
+    EXPECT_EQ(::recv(fds[1], &byte, 1, 0), 1);
+    EXPECT_EQ(byte, 'G');
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+TEST(PeekPeerState, HalfClosedClientCanStillBeAnswered)
+{
+    std::array<int, 2> fds = connectedPair();
+    ASSERT_EQ(::shutdown(fds[0], SHUT_WR), 0);
+    EXPECT_EQ(peekPeerState(fds[1]), PeerState::HalfClosed);
+
+    // The response still reaches it
+    ASSERT_EQ(::send(fds[1], "OK", 2, 0), 2);
+    std::array<char, 2> response{};
+    EXPECT_EQ(::recv(fds[0], response.data(), response.size(), 0), 2);
+    EXPECT_EQ(response, (std::array<char, 2>{'O', 'K'}));
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+TEST(PeekPeerState, ResetClientIsGone)
+{
+    std::array<int, 2> fds = connectedPair();
+    linger abort{1, 0};
+    ASSERT_EQ(
+        ::setsockopt(fds[0], SOL_SOCKET, SO_LINGER, &abort, sizeof(abort)), 0);
+    ::close(fds[0]);
+    EXPECT_EQ(peekPeerState(fds[1]), PeerState::Gone);
+    ::close(fds[1]);
+}
+
+TEST(DropOnHalfClose, OnlyIdempotentRequestsWithNothingBuffered)
+{
+    using boost::beast::http::verb;
+    EXPECT_TRUE(dropOnHalfClose(verb::get, 0));
+    EXPECT_TRUE(dropOnHalfClose(verb::head, 0));
+    // A pipelined request is waiting on this one's response
+    EXPECT_FALSE(dropOnHalfClose(verb::get, 12));
+    EXPECT_FALSE(dropOnHalfClose(verb::post, 0));
+    EXPECT_FALSE(dropOnHalfClose(verb::patch, 0));
+    EXPECT_FALSE(dropOnHalfClose(verb::delete_, 0));
+}
+
+} // namespace
+} // namespace crow
@@ -0,0 +1,103 @@
+#include "connection_manager.hpp"
+
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace crow
+{
+namespace
+{
+
+TEST(ConnectionManager, TurnsAwayConnectionsOverTheCapWhenNoneIdle)
+{
+    ConnectionManager manager(2);
+    int evictions = 0;
+    ManagedConnection first(manager, [&evictions] { evictions++; });
+    ManagedConnection second(manager, [&evictions] { evictions++; });
+    ManagedConnection third(manager, [&evictions] { evictions++; });
+
+    EXPECT_TRUE(first.open());
+    EXPECT_TRUE(second.open());
+    EXPECT_FALSE(third.open());
+    EXPECT_EQ(manager.liveCount(), 2U);
+    EXPECT_EQ(evictions, 0);
+
+    second.release();
+    EXPECT_TRUE(third.open());
+    EXPECT_EQ(manager.liveCount(), 2U);
+}
+
+TEST(ConnectionManager, EvictsTheLongestIdleFirst)
+{
+    ConnectionManager manager(3);
+    std::vector<int> evicted;
+    ManagedConnection a(manager, [&evicted] { evicted.push_back(1); });
+    ManagedConnection b(manager, [&evicted] { evicted.push_back(2); });
+    ManagedConnection c(manager, [&evicted] { evicted.push_back(3); });
+    ManagedConnection d(manager, [&evicted] { evicted.push_back(4); });
+    ManagedConnection e(manager, [&evicted] { evicted.push_back(5); });
+
+    ASSERT_TRUE(a.open());
+    ASSERT_TRUE(b.open());
+    ASSERT_TRUE(c.open());
+
+    b.markIdle();
+    a.markIdle();
+    c.markIdle();
+    // b went back to work, so a has now been idle longest
+    b.markBusy();
+    b.markIdle();
+    EXPECT_EQ(manager.idleCount(), 3U);
+
+    EXPECT_TRUE(d.open());
+    EXPECT_EQ(evicted, std::vector<int>{1});
+    EXPECT_FALSE(a.isIdle());
+
+    EXPECT_TRUE(e.open());
+    EXPECT_EQ(evicted, (std::vector<int>{1, 3}));
+    EXPECT_EQ(manager.liveCount(), 3U);
+    EXPECT_EQ(manager.idleCount(), 1U);
+    EXPECT_EQ(manager.evictedCount(), 2U);
+
+    // Evicted connections no longer count, so releasing them is harmless
+    a.release();
+    c.release();
+    EXPECT_EQ(manager.liveCount(), 3U);
+}
+
+TEST(ConnectionManager, BusyConnectionsAreNeverEvicted)
+{
+    ConnectionManager manager(1);
+    int evictions = 0;
+    ManagedConnection busy(manager, [&evictions] { evictions++; });
+    ManagedConnection next(manager, [&evictions] { evictions++; });
+
+    ASSERT_TRUE(busy.open());
+    busy.markIdle();
+    busy.markBusy();
+
+    EXPECT_FALSE(next.open());
+    EXPECT_EQ(evictions, 0);
+}
+
+TEST(ConnectionManager, DestroyingReleases)
+{
+    ConnectionManager manager(1);
+    auto conn = std::make_unique<ManagedConnection>(manager, [] {});
+    ASSERT_TRUE(conn->open());
+    conn->markIdle();
+    EXPECT_EQ(manager.idleCount(), 1U);
+
+    conn.reset();
+    EXPECT_EQ(manager.liveCount(), 0U);
+    EXPECT_EQ(manager.idleCount(), 0U);
+}
+
+} // namespace
+} // namespace crow
@@ -0,0 +1,70 @@
+#include "connection_pool.hpp"
+
+#include <memory>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace crow
+{
+namespace
+{
+
+struct FakeConnection
+{
+    void park()
+    {
+        parkCount++;
+    }
+
+    int parkCount = 0;
+};
+
+TEST(ConnectionPool, ReusesReleasedObjects)
+{
+    auto pool = std::make_shared<ConnectionPool<FakeConnection>>(1);
+    EXPECT_EQ(pool->take(), nullptr);
+
+    std::shared_ptr<FakeConnection> conn =
+        pool->share(std::make_unique<FakeConnection>());
+    FakeConnection* first = conn.get();
+    std::shared_ptr<FakeConnection> copy = conn;
+    conn.reset();
+    EXPECT_EQ(pool->parkedCount(), 0U);
+
+    copy.reset();
+    EXPECT_EQ(pool->parkedCount(), 1U);
+
+    std::unique_ptr<FakeConnection> reused = pool->take();
+    ASSERT_NE(reused, nullptr);
+    EXPECT_EQ(reused.get(), first);
+    EXPECT_EQ(reused->parkCount, 1);
+    EXPECT_EQ(pool->parkedCount(), 0U);
+}
+
+TEST(ConnectionPool, DestroysObjectsPastCapacity)
+{
+    auto pool = std::make_shared<ConnectionPool<FakeConnection>>(1);
+    std::shared_ptr<FakeConnection> first =
+        pool->share(std::make_unique<FakeConnection>());
+    std::shared_ptr<FakeConnection> second =
+        pool->share(std::make_unique<FakeConnection>());
+    first.reset();
+    second.reset();
+    EXPECT_EQ(pool->parkedCount(), 1U);
+}
+
+TEST(ConnectionPool, OutlivingThePoolIsSafe)
+{
+    auto pool = std::make_shared<ConnectionPool<FakeConnection>>(4);
+    std::shared_ptr<FakeConnection> conn =
+        pool->share(std::make_unique<FakeConnection>());
+    pool.reset();
+    conn.reset();
+}
+
+} // namespace
+} // namespace crow
@@ -0,0 +1,158 @@
+#include "file_body.hpp"
+
+#include <sys/socket.h>
+
+#include <boost/beast/http/message.hpp>
+
+#include <array>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace crow
+{
+namespace
+{
+
+class FileBodyTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        path = std::filesystem::temp_directory_path() /
+               ("file_body_test_" + std::to_string(::getpid()));
+        for (size_t i = 0; i < 40000; i++)
+        {
+            contents += static_cast<char>('a' + i % 26);
+        }
+        std::ofstream out(path, std::ios::binary);
+        out << contents;
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove(path);
+    }
+
+    // Everything the writer produces for body
+    static std::string drain(const BodyFile& body)
+    {
+        boost::beast::http::response_header<> header;
+        FileBody::writer writer(header, body);
+        boost::system::error_code ec;
+        writer.init(ec);
+        EXPECT_FALSE(ec);
+        std::string out;
+        while (true)
+        {
+            auto piece = writer.get(ec);
+            EXPECT_FALSE(ec);
+            if (!piece)
+            {
+                break;
+            }
+            out.append(static_cast<const char*>(piece->first.data()),
+                       piece->first.size());
+            if (!piece->second)
+            {
+                break;
+            }
+        }
+        return out;
+    }
+
+    std::filesystem::path path;
+    std::string contents;
+};
+
+TEST_F(FileBodyTest, SendsWholeFile)
+{
+    BodyFile body;
+    boost::system::error_code ec;
+    body.open(path, ec);
+    ASSERT_FALSE(ec);
+    EXPECT_TRUE(body.isOpen());
+    EXPECT_EQ(body.getFileSize(), contents.size());
+    EXPECT_EQ(FileBody::size(body), contents.size());
+    EXPECT_EQ(drain(body), contents);
+}
+
+TEST_F(FileBodyTest, SendsRange)
+{
+    BodyFile body;
+    boost::system::error_code ec;
+    body.open(path, ec);
+    ASSERT_FALSE(ec);
+    body.setRange(30000, 5000);
+    EXPECT_EQ(body.size(), 5000);
+    EXPECT_EQ(drain(body), contents.substr(30000, 5000));
+
+    // Clamped to the end of the file
+    body.setRange(39990, 100);
+    EXPECT_EQ(drain(body), contents.substr(39990));
+}
+
+TEST_F(FileBodyTest, AdoptsDescriptor)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    ASSERT_GE(fd, 0);
+    // Where the descriptor points doesn't matter
+    ASSERT_EQ(::lseek(fd, 0, SEEK_END), contents.size());
+
+    BodyFile body;
+    boost::system::error_code ec;
+    body.adopt(fd, ec);
+    ASSERT_FALSE(ec);
+    BodyFile moved(std::move(body));
+    EXPECT_FALSE(body.isOpen());
+    EXPECT_EQ(drain(moved), contents);
+}
+
+TEST_F(FileBodyTest, SendsRangeToSocket)
+{
+    BodyFile body;
+    boost::system::error_code ec;
+    body.open(path, ec);
+    ASSERT_FALSE(ec);
+    body.setRange(1000, 3000);
+
+    std::array<int, 2> fds{};
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds.data()), 0);
+    EXPECT_EQ(body.sendTo(fds[0], 0, 1000), 1000);
+    EXPECT_EQ(body.sendTo(fds[0], 1000, 5000), 2000);
+    ::close(fds[0]);
+
+    std::string out(4000, '\0');
+    size_t got = 0;
+    while (got < out.size())
+    {
+        ssize_t n = ::read(fds[1], out.data() + got, out.size() - got);
+        if (n <= 0)
+        {
+            break;
+        }
+        got += static_cast<size_t>(n);
+    }
+    ::close(fds[1]);
+    out.resize(got);
+    EXPECT_EQ(out, contents.substr(1000, 3000));
+}
+
+TEST_F(FileBodyTest, MissingFileFails)
+{
+    BodyFile body;
+    boost::system::error_code ec;
+    body.open(path.string() + ".missing", ec);
+    EXPECT_TRUE(ec);
+    EXPECT_FALSE(body.isOpen());
+}
+
+} // namespace
+} // namespace crow
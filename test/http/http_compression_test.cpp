@@ -0,0 +1,61 @@
+#include "gzip_helper.hpp"
+#include "http_compression.hpp"
+
+#include <string>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+namespace crow::compression
+{
+namespace
+{
+
+TEST(GetPreferredEncoding, NegotiatesFromHeader)
+{
+    EXPECT_EQ(getPreferredEncoding(""), Encoding::Identity);
+    EXPECT_EQ(getPreferredEncoding("identity"), Encoding::Identity);
+    EXPECT_EQ(getPreferredEncoding("gzip"), Encoding::Gzip);
+    EXPECT_EQ(getPreferredEncoding("deflate"), Encoding::Deflate);
+    EXPECT_EQ(getPreferredEncoding("deflate, gzip;q=1.0, br"), Encoding::Gzip);
+    EXPECT_EQ(getPreferredEncoding("gzip;q=0, deflate"), Encoding::Deflate);
+    EXPECT_EQ(getPreferredEncoding("gzip; q=0.000"), Encoding::Identity);
+    EXPECT_EQ(getPreferredEncoding("*"), Encoding::Gzip);
+}
+
+TEST(Encode, GzipRoundTrips)
+{
+    std::string body(8192, 'a');
+    body += "end";
+    std::string encoded;
+    ASSERT_TRUE(encode(body, Encoding::Gzip, encoded));
+    EXPECT_LT(encoded.size(), body.size());
+
+    std::string decoded;
+    ASSERT_TRUE(gzipInflate(encoded, decoded));
+    EXPECT_EQ(decoded.substr(0, body.size()), body);
+}
+
+TEST(EncodedBodyCache, EvictsOldestWhenFull)
+{
+    EncodedBodyCache cache;
+    std::string big(EncodedBodyCache::maxBytes / 2, 'x');
+    cache.insert("a", big);
+    cache.insert("b", big);
+    EXPECT_NE(cache.find("a"), nullptr);
+    cache.insert("c", big);
+    EXPECT_EQ(cache.find("a"), nullptr);
+    EXPECT_NE(cache.find("b"), nullptr);
+    EXPECT_NE(cache.find("c"), nullptr);
+    EXPECT_EQ(cache.size(), 2U);
+}
+
+TEST(EncodedBodyCache, KeyIncludesEtagAndEncoding)
+{
+    EXPECT_NE(EncodedBodyCache::makeKey("/a", "\"1\"", Encoding::Gzip),
+              EncodedBodyCache::makeKey("/a", "\"2\"", Encoding::Gzip));
+    EXPECT_NE(EncodedBodyCache::makeKey("/a", "\"1\"", Encoding::Gzip),
+              EncodedBodyCache::makeKey("/a", "\"1\"", Encoding::Deflate));
+}
+
+} // namespace
+} // namespace crow::compression
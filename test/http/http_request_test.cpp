@@ -0,0 +1,51 @@
+#include "http_request.hpp"
+
+#include <boost/beast/http/verb.hpp>
+
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace crow
+{
+namespace
+{
+
+TEST(HttpRequest, CopiesShareParsedTarget)
+{
+    std::error_code ec;
+    Request req({boost::beast::http::verb::get,
+                 "/redfish/v1/Chassis?$top=2&only", 11},
+                ec);
+    ASSERT_FALSE(ec);
+
+    Request copy(req);
+    EXPECT_EQ(copy.url, "/redfish/v1/Chassis");
+    EXPECT_EQ(copy.url.data(), req.url.data());
+    EXPECT_EQ(copy.urlView.params().size(), 2U);
+
+    Request moved(std::move(copy));
+    EXPECT_EQ(moved.url, "/redfish/v1/Chassis");
+    EXPECT_EQ(moved.urlView.encoded_query(), "$top=2&only");
+
+    // Changing the target reparses it
+    EXPECT_TRUE(moved.target("/redfish/v1/Managers"));
+    EXPECT_EQ(moved.url, "/redfish/v1/Managers");
+    EXPECT_TRUE(moved.urlView.params().empty());
+}
+
+TEST(HttpRequest, RejectsUnparsableTarget)
+{
+    std::error_code ec;
+    Request req({boost::beast::http::verb::get, "/%zz", 11}, ec);
+    EXPECT_TRUE(ec);
+}
+
+} // namespace
+} // namespace crow
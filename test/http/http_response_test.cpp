@@ -0,0 +1,136 @@
+#include "http_response.hpp"
+
+#include <boost/beast/http/field.hpp>
+#include <boost/beast/http/status.hpp>
+
+#include <string>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace crow
+{
+namespace
+{
+
+TEST(HttpResponse, HashesJsonIntoEtag)
+{
+    Response res;
+    res.jsonValue["Name"] = "System";
+    res.setHashAndHandleNotModified();
+    std::string etag(res.getHeaderValue("ETag"));
+    EXPECT_EQ(etag, res.computeEtag());
+    EXPECT_EQ(res.result(), boost::beast::http::status::ok);
+
+    Response again;
+    again.setExpectedHash("W/" + etag);
+    again.jsonValue["Name"] = "System";
+    again.setHashAndHandleNotModified();
+    EXPECT_EQ(again.result(), boost::beast::http::status::not_modified);
+    EXPECT_TRUE(again.jsonValue.is_null());
+}
+
+TEST(HttpResponse, EtagRepresentationKeepsEncodingsApart)
+{
+    Response json;
+    json.jsonValue["Name"] = "System";
+    json.setHashAndHandleNotModified();
+    std::string jsonEtag(json.getHeaderValue("ETag"));
+
+    // A CBOR request holding the json's ETag gets the body
+    Response cbor;
+    cbor.setExpectedHash(jsonEtag);
+    cbor.setEtagRepresentation("cbor");
+    cbor.jsonValue["Name"] = "System";
+    cbor.setHashAndHandleNotModified();
+    EXPECT_EQ(cbor.result(), boost::beast::http::status::ok);
+    std::string cborEtag(cbor.getHeaderValue("ETag"));
+    EXPECT_NE(cborEtag, jsonEtag);
+    EXPECT_EQ(cborEtag, jsonEtag.substr(0, jsonEtag.size() - 1) + "-cbor\"");
+
+    // and a 304 once it holds the CBOR one
+    Response again;
+    again.setExpectedHash(cborEtag);
+    again.setEtagRepresentation("cbor");
+    again.jsonValue["Name"] = "System";
+    again.setHashAndHandleNotModified();
+    EXPECT_EQ(again.result(), boost::beast::http::status::not_modified);
+
+    Response versioned;
+    versioned.setExpectedHash("\"v42\"");
+    versioned.setEtagRepresentation("msgpack");
+    EXPECT_FALSE(versioned.setEtagVersion("v42"));
+    versioned.jsonValue["Name"] = "System";
+    versioned.setHashAndHandleNotModified();
+    EXPECT_EQ(versioned.getHeaderValue("ETag"), "\"v42-msgpack\"");
+}
+
+TEST(HttpResponse, EtagVersionSkipsBody)
+{
+    Response res;
+    res.setExpectedHash("\"other\", \"v42\"");
+    EXPECT_TRUE(res.setEtagVersion("v42"));
+    EXPECT_EQ(res.result(), boost::beast::http::status::not_modified);
+    EXPECT_EQ(res.getHeaderValue("ETag"), "\"v42\"");
+}
+
+TEST(HttpResponse, EtagVersionReplacesHash)
+{
+    Response res;
+    res.setExpectedHash("\"v41\"");
+    EXPECT_FALSE(res.setEtagVersion("v42"));
+    res.jsonValue["Name"] = "System";
+
+    // The version survives the move into the connection's response
+    Response moved(std::move(res));
+    moved.setHashAndHandleNotModified();
+    EXPECT_EQ(moved.result(), boost::beast::http::status::ok);
+    EXPECT_EQ(moved.getHeaderValue("ETag"), "\"v42\"");
+}
+
+TEST(HttpResponse, EtagVersionOnSerializedBody)
+{
+    Response res;
+    EXPECT_FALSE(res.setEtagVersion("v42"));
+    res.body() = R"({"Name":"System"})";
+    res.setHashAndHandleNotModified();
+    EXPECT_EQ(res.result(), boost::beast::http::status::ok);
+    EXPECT_EQ(res.getHeaderValue("ETag"), "\"v42\"");
+
+    Response unversioned;
+    unversioned.body() = R"({"Name":"System"})";
+    unversioned.setHashAndHandleNotModified();
+    EXPECT_EQ(unversioned.getHeaderValue("ETag"), "");
+}
+
+TEST(HttpResponse, AsyncBodyGeneratorMovesWithResponse)
+{
+    Response res;
+    EXPECT_FALSE(res.hasBodyGenerator());
+    res.setAsyncBodyGenerator([](Response::BodyChunkHandler&& done) {
+        done("line\n", false);
+    });
+    EXPECT_TRUE(res.hasBodyGenerator());
+
+    Response moved(std::move(res));
+    EXPECT_TRUE(moved.hasBodyGenerator());
+
+    moved.clear();
+    EXPECT_FALSE(moved.hasBodyGenerator());
+}
+
+TEST(EtagMatches, MatchesAnyListedTag)
+{
+    EXPECT_TRUE(etagMatches("\"abc\"", "\"abc\""));
+    EXPECT_TRUE(etagMatches("\"xyz\", \"abc\"", "\"abc\""));
+    EXPECT_TRUE(etagMatches("W/\"abc\"", "\"abc\""));
+    EXPECT_TRUE(etagMatches("*", "\"abc\""));
+    EXPECT_FALSE(etagMatches("", "\"abc\""));
+    EXPECT_FALSE(etagMatches("\"abd\"", "\"abc\""));
+}
+
+} // namespace
+} // namespace crow
@@ -0,0 +1,48 @@
+#include "logging.hpp"
+
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+namespace crow
+{
+namespace
+{
+
+TEST(LoggingBaseName, StripsDirectories)
+{
+    static_assert(logging::baseName("/a/b/file.hpp") == "file.hpp");
+    EXPECT_EQ(logging::baseName("file.hpp"), "file.hpp");
+    EXPECT_EQ(logging::baseName("dir/"), "");
+}
+
+TEST(LoggingFixedStreambuf, FormatsIntoBuffer)
+{
+    logging::FixedStreambuf buf;
+    std::ostream stream(&buf);
+    stream << "value " << 42;
+    EXPECT_FALSE(buf.isTruncated());
+    EXPECT_EQ(buf.finish(), "value 42\n");
+
+    buf.reset();
+    stream << "again";
+    EXPECT_EQ(buf.finish(), "again\n");
+}
+
+TEST(LoggingFixedStreambuf, TruncatesLongMessages)
+{
+    logging::FixedStreambuf buf;
+    std::ostream stream(&buf);
+    std::string big(logging::FixedStreambuf::capacity * 2, 'x');
+    stream << big;
+    EXPECT_TRUE(buf.isTruncated());
+
+    std::string_view out = buf.finish();
+    EXPECT_EQ(out.size(), logging::FixedStreambuf::capacity);
+    EXPECT_EQ(out.back(), '\n');
+}
+
+} // namespace
+} // namespace crow
@@ -0,0 +1,84 @@
+#include "profile_sampler.hpp"
+
+#include <chrono>
+#include <string>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace crow::profile
+{
+namespace
+{
+
+using std::chrono::microseconds;
+using std::chrono::seconds;
+
+TEST(ProfileSampler, ReportsUsageSinceTheWindowStarted)
+{
+    ProfileSampler sampler;
+    ProfileSampler::Clock::time_point start{};
+    sampler.record(start, {{"GET /a", {10, microseconds(1000), 5}}}, {});
+    sampler.record(start + seconds(30),
+                   {{"GET /a", {12, microseconds(1500), 6}},
+                    {"GET /b", {1, microseconds(9000), 0}}},
+                   {{"svc Get", {3, microseconds(300), 0}}});
+
+    ProfileSampler::Totals routes = {{"GET /a", {20, microseconds(2000), 9}},
+                                     {"GET /b", {1, microseconds(9000), 0}},
+                                     {"GET /c", {0, microseconds(0), 0}}};
+    ProfileSampler::Totals calls = {{"svc Get", {7, microseconds(700), 0}}};
+    Profile profile =
+        sampler.hottest(start + seconds(40), seconds(10), 10, routes, calls);
+
+    EXPECT_EQ(profile.covered, seconds(10));
+    // /b did nothing since the recording the window starts at
+    ASSERT_EQ(profile.routes.size(), 1U);
+    EXPECT_EQ(profile.routes[0].name, "GET /a");
+    EXPECT_EQ(profile.routes[0].counters.count, 8U);
+    EXPECT_EQ(profile.routes[0].counters.total, microseconds(500));
+    EXPECT_EQ(profile.routes[0].counters.dbusCalls, 3U);
+    ASSERT_EQ(profile.calls.size(), 1U);
+    EXPECT_EQ(profile.calls[0].counters.count, 4U);
+}
+
+TEST(ProfileSampler, CoversWhatItCanOfLongWindows)
+{
+    ProfileSampler sampler;
+    ProfileSampler::Clock::time_point start{};
+    sampler.record(start, {}, {});
+
+    ProfileSampler::Totals routes = {{"GET /a", {2, microseconds(10), 0}},
+                                     {"GET /b", {1, microseconds(50), 0}}};
+    Profile profile =
+        sampler.hottest(start + seconds(20), seconds(600), 1, routes, {});
+
+    EXPECT_EQ(profile.covered, seconds(20));
+    // Busiest by time spent, cut to top
+    ASSERT_EQ(profile.routes.size(), 1U);
+    EXPECT_EQ(profile.routes[0].name, "GET /b");
+}
+
+TEST(ProfileSampler, DropsRecordingsPastTheLongestWindow)
+{
+    ProfileSampler sampler;
+    ProfileSampler::Clock::time_point start{};
+    sampler.record(start, {{"GET /a", {1, microseconds(10), 0}}}, {});
+    sampler.record(start + ProfileSampler::maxWindow + seconds(60),
+                   {{"GET /a", {5, microseconds(50), 0}}}, {});
+
+    ProfileSampler::Totals routes = {{"GET /a", {6, microseconds(60), 0}}};
+    Profile profile = sampler.hottest(
+        start + ProfileSampler::maxWindow + seconds(90),
+        ProfileSampler::maxWindow * 2, 10, routes, {});
+
+    EXPECT_EQ(profile.covered, seconds(30));
+    ASSERT_EQ(profile.routes.size(), 1U);
+    EXPECT_EQ(profile.routes[0].counters.count, 1U);
+}
+
+} // namespace
+} // namespace crow::profile
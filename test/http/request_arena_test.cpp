@@ -0,0 +1,60 @@
+#include "request_arena.hpp"
+
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace crow
+{
+namespace
+{
+
+TEST(RequestArena, ResetsOnlyWhenNothingIsOutstanding)
+{
+    auto arena = std::make_shared<RequestArena>();
+    auto value = std::allocate_shared<std::string>(
+        ArenaAllocator<std::string>(arena), "first request");
+    EXPECT_EQ(arena->outstandingBlocks(), 1U);
+    EXPECT_FALSE(arena->reset());
+
+    value.reset();
+    EXPECT_EQ(arena->outstandingBlocks(), 0U);
+    EXPECT_TRUE(arena->reset());
+
+    // The next request reuses the same space
+    auto next = std::allocate_shared<std::string>(
+        ArenaAllocator<std::string>(arena), "second request");
+    EXPECT_EQ(*next, "second request");
+}
+
+TEST(RequestArena, OutlivesItsOwner)
+{
+    auto arena = std::make_shared<RequestArena>();
+    std::weak_ptr<RequestArena> weakArena = arena;
+    auto value = std::allocate_shared<std::string>(
+        ArenaAllocator<std::string>(arena), "still in use");
+    arena.reset();
+
+    EXPECT_FALSE(weakArena.expired());
+    EXPECT_EQ(*value, "still in use");
+    value.reset();
+    EXPECT_TRUE(weakArena.expired());
+}
+
+TEST(RequestArena, GrowsPastInitialSize)
+{
+    auto arena = std::make_shared<RequestArena>();
+    ArenaAllocator<char> allocator(arena);
+    char* large = allocator.allocate(RequestArena::initialSize * 4);
+    large[RequestArena::initialSize * 4 - 1] = 'x';
+    allocator.deallocate(large, RequestArena::initialSize * 4);
+    EXPECT_TRUE(arena->reset());
+}
+
+} // namespace
+} // namespace crow
@@ -0,0 +1,161 @@
+#include "http_response.hpp"
+#include "response_cache.hpp"
+
+#include <boost/beast/http/field.hpp>
+#include <boost/beast/http/status.hpp>
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace crow
+{
+namespace
+{
+
+using std::chrono::milliseconds;
+
+const ResponseCache::Clock::time_point start{};
+
+Response makeResponse(std::string_view id)
+{
+    Response res;
+    res.result(boost::beast::http::status::ok);
+    res.addHeader(boost::beast::http::field::location, "/redfish/v1");
+    res.jsonValue["Id"] = id;
+    return res;
+}
+
+TEST(ResponseCache, ServesUntilTtlPasses)
+{
+    ResponseCache cache;
+    std::string key = ResponseCache::makeKey("/a", "1", "gzip");
+    cache.start(key);
+    cache.complete(key, milliseconds(500), start, makeResponse("a"));
+
+    Response hit;
+    ASSERT_TRUE(cache.serve(key, start + milliseconds(499), hit));
+    EXPECT_EQ(hit.result(), boost::beast::http::status::ok);
+    EXPECT_EQ(hit.jsonValue["Id"], "a");
+    EXPECT_EQ(hit.getHeaderValue("Location"), "/redfish/v1");
+
+    Response miss;
+    EXPECT_FALSE(cache.serve(key, start + milliseconds(500), miss));
+    EXPECT_EQ(cache.size(), 0U);
+}
+
+TEST(ResponseCache, KeyIncludesRoleAndEncoding)
+{
+    EXPECT_NE(ResponseCache::makeKey("/a", "1", "gzip"),
+              ResponseCache::makeKey("/a", "2", "gzip"));
+    EXPECT_NE(ResponseCache::makeKey("/a", "1", "gzip"),
+              ResponseCache::makeKey("/a", "1", ""));
+    EXPECT_NE(ResponseCache::makeKey("/a", "1", "gzip"),
+              ResponseCache::makeKey("/a?$top=1", "1", "gzip"));
+}
+
+TEST(ResponseCache, WaitersShareTheResponse)
+{
+    ResponseCache cache;
+    std::string key = ResponseCache::makeKey("/a", "1", "");
+    EXPECT_FALSE(cache.join(key, [](const ResponseCache::Entry*) {}));
+    cache.start(key);
+
+    std::vector<std::string> seen;
+    auto waiter = [&seen](const ResponseCache::Entry* shared) {
+        ASSERT_NE(shared, nullptr);
+        Response res;
+        ResponseCache::fill(*shared, res);
+        seen.emplace_back(res.jsonValue["Id"]);
+    };
+    EXPECT_TRUE(cache.join(key, waiter));
+    EXPECT_TRUE(cache.join(key, waiter));
+    cache.complete(key, milliseconds(500), start, makeResponse("a"));
+    EXPECT_EQ(seen, (std::vector<std::string>{"a", "a"}));
+}
+
+TEST(ResponseCache, ErrorsAreNeitherKeptNorShared)
+{
+    ResponseCache cache;
+    std::string key = ResponseCache::makeKey("/a", "1", "");
+    cache.start(key);
+    int handledAlone = 0;
+    EXPECT_TRUE(
+        cache.join(key, [&handledAlone](const ResponseCache::Entry* shared) {
+        EXPECT_EQ(shared, nullptr);
+        handledAlone++;
+    }));
+
+    Response res = makeResponse("a");
+    res.result(boost::beast::http::status::internal_server_error);
+    cache.complete(key, milliseconds(500), start, res);
+    EXPECT_EQ(handledAlone, 1);
+    EXPECT_EQ(cache.size(), 0U);
+}
+
+TEST(ResponseCache, CancelledRequestsAreNeitherKeptNorShared)
+{
+    ResponseCache cache;
+    std::string key = ResponseCache::makeKey("/a", "1", "");
+    cache.start(key);
+    int handledAlone = 0;
+    EXPECT_TRUE(
+        cache.join(key, [&handledAlone](const ResponseCache::Entry* shared) {
+        EXPECT_EQ(shared, nullptr);
+        handledAlone++;
+    }));
+
+    // The client of the request being handled left, so its 200 may be
+    // missing whatever the handler stopped doing
+    cache.abandon(key);
+    EXPECT_EQ(handledAlone, 1);
+    EXPECT_EQ(cache.size(), 0U);
+    EXPECT_FALSE(cache.join(key, [](const ResponseCache::Entry*) {}));
+
+    Response res;
+    EXPECT_FALSE(cache.serve(key, start, res));
+    cache.complete(key, milliseconds(500), start, makeResponse("a"));
+    EXPECT_EQ(cache.size(), 0U);
+}
+
+TEST(ResponseCache, InvalidateDropsEntriesAndResponsesInFlight)
+{
+    ResponseCache cache;
+    std::string kept = ResponseCache::makeKey("/a", "1", "");
+    std::string started = ResponseCache::makeKey("/b", "1", "");
+    cache.start(kept);
+    cache.complete(kept, milliseconds(500), start, makeResponse("a"));
+    cache.start(started);
+
+    cache.invalidate();
+    Response res;
+    EXPECT_FALSE(cache.serve(kept, start, res));
+
+    cache.complete(started, milliseconds(500), start, makeResponse("b"));
+    EXPECT_FALSE(cache.serve(started, start, res));
+}
+
+TEST(ResponseCache, EvictsOldestWhenFull)
+{
+    ResponseCache cache;
+    for (size_t i = 0; i <= ResponseCache::maxEntries; i++)
+    {
+        std::string key = ResponseCache::makeKey(std::to_string(i), "", "");
+        cache.start(key);
+        cache.complete(key, milliseconds(500), start, makeResponse("x"));
+    }
+    EXPECT_EQ(cache.size(), ResponseCache::maxEntries);
+    Response res;
+    EXPECT_FALSE(cache.serve(ResponseCache::makeKey("0", "", ""), start, res));
+    EXPECT_TRUE(cache.serve(ResponseCache::makeKey("1", "", ""), start, res));
+}
+
+} // namespace
+} // namespace crow
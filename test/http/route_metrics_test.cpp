@@ -0,0 +1,78 @@
+#include "route_metrics.hpp"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h> // IWYU pragma: keep
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+// IWYU pragma: no_include <gmock/gmock-matchers.h>
+
+namespace crow
+{
+namespace
+{
+
+using ::testing::HasSubstr;
+using ::testing::Not;
+
+TEST(LatencyHistogram, CountsIntoUpperBounds)
+{
+    LatencyHistogram histogram;
+    histogram.observe(std::chrono::microseconds(100));
+    histogram.observe(std::chrono::microseconds(101));
+    histogram.observe(std::chrono::seconds(20));
+    EXPECT_EQ(histogram.bucketCount(0), 1U);
+    EXPECT_EQ(histogram.bucketCount(1), 1U);
+    EXPECT_EQ(histogram.bucketCount(LatencyHistogram::bounds.size()), 1U);
+    EXPECT_EQ(histogram.sumMicroseconds(), 20000201U);
+}
+
+TEST(RenderPrometheus, RendersRoutesThatServedRequests)
+{
+    RouteMetrics systems;
+    systems.record(std::chrono::microseconds(1500), 200, 120, 900, 3);
+    systems.record(std::chrono::milliseconds(30), 404, 100, 300, 1);
+    RouteMetrics unused;
+
+    std::vector<metrics::RouteSeries> routes = {
+        {"/redfish/v1/Systems/<str>/", "GET", &systems},
+        {"/redfish/v1/Chassis/", "GET", &unused}};
+    std::string text = metrics::renderPrometheus(routes);
+
+    EXPECT_THAT(text, HasSubstr("bmcweb_http_request_duration_seconds_bucket{"
+                                "route=\"/redfish/v1/Systems/<str>/\","
+                                "method=\"GET\",le=\"0.001\"} 0\n"));
+    EXPECT_THAT(text, HasSubstr("bmcweb_http_request_duration_seconds_bucket{"
+                                "route=\"/redfish/v1/Systems/<str>/\","
+                                "method=\"GET\",le=\"0.0025\"} 1\n"));
+    EXPECT_THAT(text, HasSubstr("le=\"+Inf\"} 2\n"));
+    EXPECT_THAT(text, HasSubstr("bmcweb_http_request_duration_seconds_sum{"
+                                "route=\"/redfish/v1/Systems/<str>/\","
+                                "method=\"GET\"} 0.0315\n"));
+    EXPECT_THAT(text, HasSubstr("code=\"404\"} 1\n"));
+    EXPECT_THAT(text, HasSubstr("bmcweb_http_request_bytes_total{"
+                                "route=\"/redfish/v1/Systems/<str>/\","
+                                "method=\"GET\"} 220\n"));
+    EXPECT_THAT(text, HasSubstr("bmcweb_http_response_bytes_total{"
+                                "route=\"/redfish/v1/Systems/<str>/\","
+                                "method=\"GET\"} 1200\n"));
+    EXPECT_THAT(text, HasSubstr("bmcweb_http_dbus_calls_total{"
+                                "route=\"/redfish/v1/Systems/<str>/\","
+                                "method=\"GET\"} 4\n"));
+    EXPECT_THAT(text, Not(HasSubstr("/redfish/v1/Chassis/")));
+}
+
+TEST(RenderPrometheus, EscapesLabelValues)
+{
+    std::string out;
+    metrics::appendLabelValue(out, "a\"b\\c\n");
+    EXPECT_EQ(out, "a\\\"b\\\\c\\n");
+}
+
+} // namespace
+} // namespace crow
@@ -10,6 +10,8 @@
 #include <string>
 #include <string_view>
 #include <system_error>
+#include <utility>
+#include <vector>
 
 #include <gtest/gtest.h> // IWYU pragma: keep
 
@@ -122,5 +124,102 @@ TEST(Router, 405)
     }
     EXPECT_TRUE(called);
 }
+
+TEST(Router, FileUpload)
+{
+    auto nullCallback = [](const Request&,
+                           const std::shared_ptr<bmcweb::AsyncResp>&) {};
+
+    Router router;
+    router.newRuleTagged<getParameterTag("/upload")>("/upload")
+        .fileUpload()
+        .methods(boost::beast::http::verb::post)(nullCallback);
+    router.newRuleTagged<getParameterTag("/upload")>("/upload")
+        .methods(boost::beast::http::verb::get)(nullCallback);
+    router.validate();
+
+    EXPECT_TRUE(
+        router.isFileUpload(boost::beast::http::verb::post, "/upload"));
+    EXPECT_TRUE(
+        router.isFileUpload(boost::beast::http::verb::post, "/upload?a=b"));
+    EXPECT_FALSE(router.isFileUpload(boost::beast::http::verb::get, "/upload"));
+    EXPECT_FALSE(router.isFileUpload(boost::beast::http::verb::post, "/other"));
+}
+
+TEST(Trie, StaticRoutesMatchTrieResults)
+{
+    Trie trie;
+    trie.add("/redfish/v1/Systems/<str>", 1);
+    trie.add("/redfish/v1/Systems/system", 2);
+    trie.add("/redfish/v1/Chassis", 3);
+    trie.add("/redfish/v1/Chassis/<str>", 4);
+    trie.validate();
+
+    // The parameterized route was registered first, so it still wins
+    std::pair<unsigned, RoutingParams> systems =
+        trie.find("/redfish/v1/Systems/system");
+    EXPECT_EQ(systems.first, 1U);
+    ASSERT_EQ(systems.second.stringParams.size(), 1U);
+    EXPECT_EQ(systems.second.stringParams[0], "system");
+
+    std::pair<unsigned, RoutingParams> chassis =
+        trie.find("/redfish/v1/Chassis");
+    EXPECT_EQ(chassis.first, 3U);
+    EXPECT_TRUE(chassis.second.stringParams.empty());
+
+    EXPECT_EQ(trie.find("/redfish/v1/Chassis/chassis").first, 4U);
+    EXPECT_EQ(trie.find("/redfish/v1/Nope").first, 0U);
+}
+
+TEST(Trie, EveryStaticRouteResolves)
+{
+    Trie trie;
+    std::vector<std::pair<std::string, unsigned>> staticUrls;
+    unsigned ruleIndex = 1;
+    for (const char* collection : {"Systems", "Chassis", "Managers"})
+    {
+        std::string base = std::string("/redfish/v1/") + collection;
+        for (const char* leaf : {"", "/Members", "/Settings"})
+        {
+            staticUrls.emplace_back(base + leaf, ruleIndex);
+            trie.add(base + leaf, ruleIndex++);
+        }
+        trie.add(base + "/<str>/LogServices/<str>", ruleIndex++);
+    }
+    trie.validate();
+
+    for (const auto& [url, index] : staticUrls)
+    {
+        std::pair<unsigned, RoutingParams> found = trie.find(url);
+        EXPECT_EQ(found.first, index) << url;
+        EXPECT_TRUE(found.second.stringParams.empty()) << url;
+        EXPECT_EQ(found.first, trie.findInTrie(url).first) << url;
+    }
+    std::pair<unsigned, RoutingParams> member =
+        trie.find("/redfish/v1/Chassis/chassis/LogServices/EventLog");
+    EXPECT_EQ(member.first, 8U);
+    ASSERT_EQ(member.second.stringParams.size(), 2U);
+    EXPECT_EQ(member.second.stringParams[0], "chassis");
+    EXPECT_EQ(member.second.stringParams[1], "EventLog");
+}
+
+TEST(Trie, TrailingSlashesResolveAsBefore)
+{
+    // As Router::internalAddRuleObject adds them: a rule ending in a slash
+    // is also added without it
+    Trie trie;
+    trie.add("/redfish/v1/Chassis/", 1);
+    trie.add("/redfish/v1/Chassis", 1);
+    trie.add("/redfish/v1/Managers", 2);
+    trie.validate();
+
+    EXPECT_EQ(trie.find("/redfish/v1/Chassis/").first, 1U);
+    EXPECT_EQ(trie.find("/redfish/v1/Chassis").first, 1U);
+    EXPECT_EQ(trie.find("/redfish/v1/Managers").first, 2U);
+    EXPECT_EQ(trie.find("/redfish/v1/Managers/").first, 0U);
+    EXPECT_EQ(trie.find("/redfish/v1/Managers/").first,
+              trie.findInTrie("/redfish/v1/Managers/").first);
+}
+
 } // namespace
 } // namespace crow
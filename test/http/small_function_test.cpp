@@ -0,0 +1,84 @@
+#include "small_function.hpp"
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace crow
+{
+namespace
+{
+
+using IntFunction = SmallFunction<int(int)>;
+
+TEST(SmallFunction, KeepsSmallCallablesInline)
+{
+    auto owner = std::make_shared<int>(2);
+    auto multiply = [owner, unused{owner.get()}](int value) {
+        return value * *owner;
+    };
+    EXPECT_TRUE(IntFunction::storedInline<decltype(multiply)>());
+
+    IntFunction f = multiply;
+    ASSERT_TRUE(f);
+    EXPECT_EQ(f(21), 42);
+}
+
+TEST(SmallFunction, KeepsLargeCallablesOnHeap)
+{
+    std::array<int, 32> values{};
+    values[31] = 5;
+    auto lookup = [values](int index) {
+        return values[static_cast<size_t>(index)];
+    };
+    EXPECT_FALSE(IntFunction::storedInline<decltype(lookup)>());
+
+    IntFunction f = lookup;
+    IntFunction moved = std::move(f);
+    EXPECT_FALSE(f);
+    EXPECT_EQ(moved(31), 5);
+}
+
+TEST(SmallFunction, MovesAndDestroysCallable)
+{
+    auto owner = std::make_shared<int>(0);
+    {
+        IntFunction f = [owner](int value) { return value + *owner; };
+        EXPECT_EQ(owner.use_count(), 2);
+        IntFunction moved = std::move(f);
+        EXPECT_EQ(owner.use_count(), 2);
+        EXPECT_EQ(moved(1), 1);
+        moved = nullptr;
+        EXPECT_EQ(owner.use_count(), 1);
+        EXPECT_FALSE(moved);
+    }
+    EXPECT_EQ(owner.use_count(), 1);
+}
+
+TEST(SmallFunction, CallsMutableAndMoveOnlyCallables)
+{
+    auto counter = std::make_unique<int>(0);
+    SmallFunction<int()> next = [counter{std::move(counter)}]() mutable {
+        return ++*counter;
+    };
+    EXPECT_EQ(next(), 1);
+    EXPECT_EQ(next(), 2);
+}
+
+TEST(SmallFunction, ThrowsWhenEmpty)
+{
+    SmallFunction<void(std::string&)> empty;
+    std::string out;
+    EXPECT_THROW(empty(out), std::bad_function_call);
+}
+
+} // namespace
+} // namespace crow
@@ -0,0 +1,101 @@
+#include "timer_wheel.hpp"
+
+#include <boost/asio/io_context.hpp>
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace crow
+{
+namespace
+{
+
+using std::chrono::milliseconds;
+
+TEST(TimerWheel, FiresOnTheTickAfterItsTimeout)
+{
+    boost::asio::io_context io;
+    TimerWheel wheel(io);
+    int fired = 0;
+    WheelTimer timer(wheel, [&fired] { fired++; });
+
+    timer.expiresAfter(milliseconds(200));
+    EXPECT_TRUE(timer.pending());
+    EXPECT_EQ(wheel.armedCount(), 1U);
+
+    io.run_for(TimerWheel::tick / 2);
+    EXPECT_EQ(fired, 0);
+
+    io.run_for(TimerWheel::tick);
+    EXPECT_EQ(fired, 1);
+    EXPECT_FALSE(timer.pending());
+    EXPECT_EQ(wheel.armedCount(), 0U);
+}
+
+TEST(TimerWheel, CancelledAndDestroyedTimersDontFire)
+{
+    boost::asio::io_context io;
+    TimerWheel wheel(io);
+    int fired = 0;
+    WheelTimer cancelled(wheel, [&fired] { fired++; });
+    auto destroyed =
+        std::make_unique<WheelTimer>(wheel, [&fired] { fired++; });
+
+    cancelled.expiresAfter(milliseconds(1));
+    destroyed->expiresAfter(milliseconds(1));
+    EXPECT_EQ(wheel.armedCount(), 2U);
+
+    cancelled.cancel();
+    destroyed.reset();
+    EXPECT_EQ(wheel.armedCount(), 0U);
+
+    io.run_for(TimerWheel::tick * 3 / 2);
+    EXPECT_EQ(fired, 0);
+}
+
+TEST(TimerWheel, RearmingReplacesTheTimeout)
+{
+    boost::asio::io_context io;
+    TimerWheel wheel(io);
+    int fired = 0;
+    WheelTimer timer(wheel, [&fired] { fired++; });
+
+    timer.expiresAfter(milliseconds(1));
+    timer.expiresAfter(TimerWheel::tick * 3);
+    EXPECT_EQ(wheel.armedCount(), 1U);
+
+    io.run_for(TimerWheel::tick * 3 / 2);
+    EXPECT_EQ(fired, 0);
+    EXPECT_TRUE(timer.pending());
+}
+
+TEST(TimerWheel, HandlersMayCancelTimersDueOnTheSameTick)
+{
+    boost::asio::io_context io;
+    TimerWheel wheel(io);
+    std::vector<int> fired;
+    std::unique_ptr<WheelTimer> second;
+    WheelTimer first(wheel, [&fired, &second] {
+        fired.push_back(1);
+        second.reset();
+    });
+    second = std::make_unique<WheelTimer>(wheel,
+                                          [&fired] { fired.push_back(2); });
+
+    first.expiresAfter(milliseconds(1));
+    second->expiresAfter(milliseconds(1));
+
+    io.run_for(TimerWheel::tick * 3 / 2);
+    EXPECT_EQ(fired, std::vector<int>{1});
+    EXPECT_EQ(wheel.armedCount(), 0U);
+}
+
+} // namespace
+} // namespace crow
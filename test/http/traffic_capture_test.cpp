@@ -0,0 +1,60 @@
+#include "http_request.hpp"
+#include "traffic_capture.hpp"
+
+#include <boost/beast/http/field.hpp>
+#include <boost/beast/http/verb.hpp>
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <string>
+#include <system_error>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace crow::capture
+{
+namespace
+{
+
+TEST(TrafficCapture, RecognizesCredentialHeaders)
+{
+    EXPECT_TRUE(isCredentialHeader("Authorization"));
+    EXPECT_TRUE(isCredentialHeader("X-Auth-Token"));
+    EXPECT_TRUE(isCredentialHeader("cookie"));
+    EXPECT_FALSE(isCredentialHeader("Accept"));
+    EXPECT_FALSE(isCredentialHeader("Cookies"));
+}
+
+TEST(TrafficCapture, RecordLeavesOutCredentials)
+{
+    std::error_code ec;
+    Request req({boost::beast::http::verb::get,
+                 "/redfish/v1/Chassis/chassis?$expand=.", 11},
+                ec);
+    ASSERT_FALSE(ec);
+    req.req.set(boost::beast::http::field::host, "bmc");
+    req.req.set(boost::beast::http::field::authorization, "Basic cm9vdDox");
+    req.req.set("X-Auth-Token", "secret");
+    req.req.set(boost::beast::http::field::cookie, "SESSION=secret");
+    req.route = "/redfish/v1/Chassis/<str>/";
+
+    nlohmann::json record =
+        makeRecord(req, 3, 1500, 200, std::chrono::microseconds(250));
+    EXPECT_EQ(record["at_us"], 1500);
+    EXPECT_EQ(record["connection"], 3);
+    EXPECT_EQ(record["method"], "GET");
+    EXPECT_EQ(record["target"], "/redfish/v1/Chassis/chassis?$expand=.");
+    EXPECT_EQ(record["route"], "/redfish/v1/Chassis/<str>/");
+    EXPECT_EQ(record["status"], 200);
+    EXPECT_EQ(record["latency_us"], 250);
+    EXPECT_EQ(record["body_bytes"], 0);
+    EXPECT_EQ(record["headers"], nlohmann::json::parse(R"([["Host","bmc"]])"));
+    EXPECT_EQ(record.dump().find("secret"), std::string::npos);
+}
+
+} // namespace
+} // namespace crow::capture
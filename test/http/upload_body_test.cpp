@@ -0,0 +1,136 @@
+#include "upload_body.hpp"
+
+#include <boost/asio/buffer.hpp>
+#include <boost/beast/http/parser.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <system_error>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace crow
+{
+namespace
+{
+
+std::string readFile(const std::filesystem::path& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(in),
+            std::istreambuf_iterator<char>()};
+}
+
+TEST(UploadBody, WritesAndHashesBodyAsItArrives)
+{
+    boost::beast::http::request_parser<UploadBody> parser;
+    parser.eager(true);
+    boost::beast::error_code ec;
+    std::string request = "POST /upload HTTP/1.1\r\n"
+                          "Content-Length: 3\r\n\r\n"
+                          "ab";
+    parser.put(boost::asio::buffer(request), ec);
+    ASSERT_FALSE(ec);
+    EXPECT_EQ(parser.get().body().size(), 2U);
+
+    parser.put(boost::asio::buffer("c", 1), ec);
+    ASSERT_FALSE(ec);
+    ASSERT_TRUE(parser.is_done());
+
+    UploadFile& upload = parser.get().body();
+    EXPECT_EQ(upload.size(), 3U);
+    EXPECT_EQ(upload.sha256(), "ba7816bf8f01cfea414140de5dae2223"
+                               "b00361a396177a9cb410ff61f20015ad");
+
+    std::filesystem::path dest = std::filesystem::temp_directory_path() /
+                                 "upload_body_test_image";
+    std::filesystem::remove(dest);
+    ASSERT_TRUE(upload.moveTo(dest.string()));
+    EXPECT_FALSE(upload.isOpen());
+    EXPECT_EQ(readFile(dest), "abc");
+    std::filesystem::remove(dest);
+}
+
+#ifdef BMCWEB_ENABLE_REDFISH_MULTIPART_UPDATE
+TEST(UploadBody, WritesOnlyTheFilePartOfAMultipartBody)
+{
+    boost::beast::http::request_parser<UploadBody> parser;
+    parser.eager(true);
+    boost::beast::error_code ec;
+    std::string body = "--XX\r\n"
+                       "Content-Disposition: form-data; "
+                       "name=\"UpdateParameters\"\r\n\r\n"
+                       "{\"Targets\":[]}\r\n"
+                       "--XX\r\n"
+                       "Content-Disposition: form-data; name=\"UpdateFile\"; "
+                       "filename=\"image.tar\"\r\n\r\n"
+                       "abc\r\n"
+                       "--XX--\r\n";
+    std::string request = "POST /upload HTTP/1.1\r\n"
+                          "Content-Type: multipart/form-data; boundary=XX\r\n"
+                          "Content-Length: " +
+                          std::to_string(body.size()) + "\r\n\r\n";
+    parser.put(boost::asio::buffer(request), ec);
+    ASSERT_FALSE(ec);
+    // A byte at a time, as the worst case of Beast handing over pieces
+    for (char c : body)
+    {
+        parser.put(boost::asio::buffer(&c, 1), ec);
+        ASSERT_FALSE(ec);
+    }
+    ASSERT_TRUE(parser.is_done());
+
+    UploadFile& upload = parser.get().body();
+    ASSERT_TRUE(upload.isMultipart());
+    EXPECT_EQ(upload.multipartResult(), ParserError::PARSER_SUCCESS);
+    ASSERT_EQ(upload.parts().size(), 2U);
+    EXPECT_EQ(upload.parts()[0].content, "{\"Targets\":[]}");
+    EXPECT_EQ(upload.filePart(), &upload.parts()[1]);
+    EXPECT_EQ(upload.parts()[1].content, "");
+    EXPECT_EQ(upload.size(), 3U);
+    EXPECT_EQ(upload.sha256(), "ba7816bf8f01cfea414140de5dae2223"
+                               "b00361a396177a9cb410ff61f20015ad");
+}
+#endif
+
+size_t stagedUploads()
+{
+    size_t count = 0;
+    for (const auto& entry : std::filesystem::directory_iterator("/tmp"))
+    {
+        if (entry.path().filename().string().starts_with("bmcweb-upload-"))
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+TEST(UploadBody, UnclaimedUploadIsDeleted)
+{
+    size_t before = stagedUploads();
+    {
+        UploadFile upload;
+        boost::system::error_code ec;
+        upload.open(ec);
+        ASSERT_FALSE(ec);
+        upload.write("partial", ec);
+        ASSERT_FALSE(ec);
+        EXPECT_EQ(stagedUploads(), before + 1);
+
+        UploadFile moved(std::move(upload));
+        EXPECT_FALSE(upload.isOpen());
+        EXPECT_TRUE(moved.isOpen());
+    }
+    EXPECT_EQ(stagedUploads(), before);
+}
+
+} // namespace
+} // namespace crow
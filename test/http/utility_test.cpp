@@ -7,6 +7,7 @@
 #include <boost/url/url_view.hpp>
 #include <nlohmann/json.hpp>
 
+#include <array>
 #include <cstdint>
 #include <ctime>
 #include <functional>
@@ -81,6 +82,46 @@ TEST(Utility, Base64EncodeDecodeString)
     EXPECT_EQ(data, decoded);
 }
 
+TEST(Utility, Base64DecodeUnpadded)
+{
+    using namespace std::string_literals;
+    std::string result;
+    EXPECT_TRUE(base64Decode("ZjAAIEI", result));
+    EXPECT_EQ(result, "f0\0 B"s);
+
+    EXPECT_FALSE(base64Decode("ZjAAI", result));
+    EXPECT_FALSE(base64Decode("ZjA!IEJh", result));
+}
+
+TEST(Utility, Base64EncodeAppend)
+{
+    using namespace std::string_literals;
+    std::string out = "prefix:";
+    base64EncodeAppend(out, "f0\0 B"s);
+    EXPECT_EQ(out, "prefix:ZjAAIEI=");
+}
+
+TEST(Utility, Base64EncoderMatchesOneShot)
+{
+    std::string data;
+    for (size_t i = 0; i < 100; i++)
+    {
+        data += static_cast<char>(i * 7);
+    }
+    for (size_t pieceSize = 1; pieceSize < 8; pieceSize++)
+    {
+        Base64Encoder encoder;
+        std::string encoded;
+        for (size_t pos = 0; pos < data.size(); pos += pieceSize)
+        {
+            encoder.update(encoded,
+                           std::string_view(data).substr(pos, pieceSize));
+        }
+        encoder.finish(encoded);
+        EXPECT_EQ(encoded, base64encode(data));
+    }
+}
+
 TEST(Utility, UrlFromPieces)
 {
     boost::urls::url url = urlFromPieces("redfish", "v1", "foo");
@@ -96,6 +137,29 @@ TEST(Utility, UrlFromPieces)
     EXPECT_EQ(url.buffer(), "/%2F/bad&tring");
 }
 
+TEST(Utility, UrlPath)
+{
+    EXPECT_EQ(urlPath<"/redfish/v1">(), "/redfish/v1");
+    EXPECT_EQ(urlPath<"/redfish/v1/{}">("foo"), "/redfish/v1/foo");
+    EXPECT_EQ(urlPath<"/{}/{}">("/", "badString"), "/%2F/badString");
+    EXPECT_EQ(urlPath<"/{}">("bad?tring"), "/bad%3Ftring");
+    EXPECT_EQ(urlPath<"/{}/{}">("/", "bad&tring"), "/%2F/bad&tring");
+    EXPECT_EQ(urlPath<"/{}">(".."), "/%2E%2E");
+}
+
+TEST(Utility, UrlPathMatchesUrlFromPieces)
+{
+    const std::array<std::string, 8> ids = {
+        "chassis", "fan_tach_0", "a b",   "100%",
+        "..",      "x:y@z",      "#frag", "~!$'()*+,;="};
+    for (const std::string& id : ids)
+    {
+        EXPECT_EQ(urlPath<"/redfish/v1/Chassis/{}/Sensors/{}">(id, id),
+                  urlFromPieces("redfish", "v1", "Chassis", id, "Sensors", id)
+                      .buffer());
+    }
+}
+
 TEST(Utility, readUrlSegments)
 {
     boost::system::result<boost::urls::url_view> parsed =
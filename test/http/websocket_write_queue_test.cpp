@@ -0,0 +1,90 @@
+#include "websocket_write_queue.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace crow::websocket
+{
+namespace
+{
+
+TEST(WebsocketWriteQueue, CountsQueuedBytes)
+{
+    WriteQueue queue;
+    EXPECT_TRUE(queue.empty());
+    auto shared = std::make_shared<const std::string>("shared");
+    queue.push({MessageType::Text, std::string("owned"), nullptr});
+    queue.push({MessageType::Binary, shared, nullptr});
+    queue.push({MessageType::Binary, std::string_view("view"), nullptr});
+    EXPECT_EQ(queue.size(), 15U);
+
+    EXPECT_EQ(queue.front().type, MessageType::Text);
+    EXPECT_EQ(queue.front().data(), "owned");
+    queue.pop();
+    EXPECT_EQ(queue.front().data(), "shared");
+    EXPECT_EQ(queue.front().data().data(), shared->data());
+    queue.pop();
+    EXPECT_EQ(queue.front().data(), "view");
+    queue.pop();
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.size(), 0U);
+}
+
+TEST(WebsocketWriteQueue, PopReturnsCompletion)
+{
+    WriteQueue queue;
+    int done = 0;
+    queue.push({MessageType::Binary, std::string("abc"), [&done]() { done++; }});
+    std::function<void()> onDone = queue.pop();
+    EXPECT_EQ(done, 0);
+    ASSERT_TRUE(onDone);
+    onDone();
+    EXPECT_EQ(done, 1);
+}
+
+TEST(WebsocketWriteQueue, AlwaysTakesFirstMessage)
+{
+    WriteQueue queue;
+    queue.setLimits(0, 4);
+    EXPECT_FALSE(queue.wouldOverflow(10));
+    queue.push({MessageType::Binary, std::string("0123456789"), nullptr});
+    EXPECT_TRUE(queue.wouldOverflow(1));
+
+    queue.clear();
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.size(), 0U);
+    EXPECT_FALSE(queue.wouldOverflow(3));
+}
+
+TEST(WebsocketWriteQueue, ReportsCongestionOncePerTransition)
+{
+    WriteQueue queue;
+    std::vector<bool> changes;
+    queue.setLimits(8, 0);
+    queue.setCongestionHandler(
+        [&changes](bool congested) { changes.push_back(congested); });
+
+    queue.push({MessageType::Binary, std::string("abc"), nullptr});
+    EXPECT_TRUE(changes.empty());
+    queue.push({MessageType::Binary, std::string("abc"), nullptr});
+    queue.push({MessageType::Binary, std::string("abc"), nullptr});
+    EXPECT_EQ(changes, std::vector<bool>{true});
+
+    // 6 bytes left is still above half the high water mark
+    queue.pop();
+    EXPECT_EQ(changes, std::vector<bool>{true});
+    queue.pop();
+    EXPECT_EQ(changes, (std::vector<bool>{true, false}));
+    queue.pop();
+    EXPECT_EQ(changes, (std::vector<bool>{true, false}));
+}
+
+} // namespace
+} // namespace crow::websocket
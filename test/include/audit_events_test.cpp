@@ -1,5 +1,10 @@
 #include "audit_events.hpp"
 
+#include <boost/asio/io_context.hpp>
+
+#include <cstdint>
+#include <string>
+
 #include <gtest/gtest.h> // IWYU pragma: keep
 
 // IWYU pragma: no_include <gtest/gtest-message.h>
@@ -197,5 +202,38 @@ TEST(appendItemToBuf, NegativeTest)
     EXPECT_EQ(testBuf, cmpStr);
 }
 
+TEST(AuditQueue, CoalescesRepeatedRecords)
+{
+    boost::asio::io_context io;
+    AuditQueue& queue = AuditQueue::getInstance();
+    uint64_t coalesced = queue.coalescedTotal();
+
+    queue.push(io, {"op=PATCH:/foo ", "10.0.0.1", true});
+    queue.push(io, {"op=PATCH:/foo ", "10.0.0.1", true});
+    queue.push(io, {"op=PATCH:/foo ", "10.0.0.2", true});
+    EXPECT_EQ(queue.size(), 2);
+    EXPECT_EQ(queue.coalescedTotal(), coalesced + 1);
+
+    io.run();
+    EXPECT_EQ(queue.size(), 0);
+}
+
+TEST(AuditQueue, DropsPastLimit)
+{
+    boost::asio::io_context io;
+    AuditQueue& queue = AuditQueue::getInstance();
+    uint64_t dropped = queue.droppedTotal();
+
+    for (size_t i = 0; i < AuditQueue::maxQueued + 3; i++)
+    {
+        queue.push(io, {"op=PATCH:/foo/" + std::to_string(i) + " ", "", true});
+    }
+    EXPECT_EQ(queue.size(), AuditQueue::maxQueued);
+    EXPECT_EQ(queue.droppedTotal(), dropped + 3);
+
+    io.run();
+    EXPECT_EQ(queue.size(), 0);
+}
+
 } // namespace
 } // namespace audit
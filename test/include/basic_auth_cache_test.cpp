@@ -0,0 +1,99 @@
+#include "basic_auth_cache.hpp"
+
+#include <chrono>
+#include <string>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace crow
+{
+namespace authentication
+{
+namespace
+{
+
+TEST(BasicAuthCache, RemembersUntilTimeout)
+{
+    BasicAuthCache cache(std::chrono::seconds(10));
+    BasicAuthCache::Clock::time_point now = BasicAuthCache::Clock::now();
+    std::string credentials = cache.digest("user", "password");
+    ASSERT_FALSE(credentials.empty());
+
+    EXPECT_FALSE(cache.lookup(credentials, now));
+    cache.insert(credentials, "user", cache.generation(), now);
+    EXPECT_TRUE(cache.lookup(credentials, now + std::chrono::seconds(9)));
+    EXPECT_FALSE(cache.lookup(credentials, now + std::chrono::seconds(10)));
+    EXPECT_EQ(cache.size(), 0);
+}
+
+TEST(BasicAuthCache, DigestDependsOnUserAndPassword)
+{
+    BasicAuthCache cache(std::chrono::seconds(10));
+    std::string credentials = cache.digest("user", "password");
+    EXPECT_EQ(credentials, cache.digest("user", "password"));
+    EXPECT_NE(credentials, cache.digest("user", "Password"));
+    EXPECT_NE(credentials, cache.digest("use", "rpassword"));
+
+    // Keyed per instance, so digests mean nothing outside this process
+    BasicAuthCache other(std::chrono::seconds(10));
+    EXPECT_NE(credentials, other.digest("user", "password"));
+}
+
+TEST(BasicAuthCache, InvalidateDropsUserAndRacingResults)
+{
+    BasicAuthCache cache(std::chrono::seconds(10));
+    std::string user1 = cache.digest("user1", "password");
+    std::string user2 = cache.digest("user2", "password");
+    cache.insert(user1, "user1", cache.generation());
+    cache.insert(user2, "user2", cache.generation());
+
+    uint64_t started = cache.generation();
+    cache.invalidate("user1");
+    EXPECT_FALSE(cache.lookup(user1));
+    EXPECT_TRUE(cache.lookup(user2));
+
+    // PAM answered before the password change was seen
+    cache.insert(user1, "user1", started);
+    EXPECT_FALSE(cache.lookup(user1));
+
+    cache.invalidate("");
+    EXPECT_EQ(cache.size(), 0);
+}
+
+TEST(BasicAuthCache, EvictsOldestWhenFull)
+{
+    BasicAuthCache cache(std::chrono::seconds(10));
+    BasicAuthCache::Clock::time_point now = BasicAuthCache::Clock::now();
+    std::string first = cache.digest("user0", "password");
+    for (std::size_t i = 0; i < basicAuthCacheMaxEntries; i++)
+    {
+        std::string user = "user" + std::to_string(i);
+        cache.insert(cache.digest(user, "password"), user, cache.generation(),
+                     now + std::chrono::milliseconds(i));
+    }
+    std::string extra = cache.digest("extra", "password");
+    cache.insert(extra, "extra", cache.generation(),
+                 now + std::chrono::seconds(1));
+
+    EXPECT_EQ(cache.size(), basicAuthCacheMaxEntries);
+    EXPECT_FALSE(cache.lookup(first, now + std::chrono::seconds(1)));
+    EXPECT_TRUE(cache.lookup(extra, now + std::chrono::seconds(1)));
+}
+
+TEST(BasicAuthCache, ZeroTimeoutDisables)
+{
+    BasicAuthCache cache(std::chrono::seconds(0));
+    EXPECT_FALSE(cache.enabled());
+    std::string credentials = cache.digest("user", "password");
+    EXPECT_TRUE(credentials.empty());
+    cache.insert(credentials, "user", cache.generation());
+    EXPECT_FALSE(cache.lookup(credentials));
+}
+
+} // namespace
+} // namespace authentication
+} // namespace crow
@@ -0,0 +1,96 @@
+#include "dbus_cache_snapshot.hpp"
+#include "dbus_utility.hpp"
+
+#include <array>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace dbus::utility
+{
+namespace
+{
+
+TEST(CacheSnapshot, RoundTrips)
+{
+    CacheSnapshot snapshot;
+    snapshot.subTrees.emplace_back(
+        "GetSubTree|/xyz|0|xyz.openbmc_project.Inventory.Item",
+        MapperGetSubTreeResponse{
+            {"/xyz/board",
+             {{"xyz.openbmc_project.Inventory.Manager",
+               {"xyz.openbmc_project.Inventory.Item"}}}}});
+    snapshot.subTreePaths.emplace_back("GetSubTreePaths|/xyz|1",
+                                       MapperGetSubTreePathsResponse{
+                                           "/xyz/board", "/xyz/fan"});
+    snapshot.objects.emplace_back(
+        "GetObject|/xyz/board|0",
+        MapperGetObject{{"xyz.openbmc_project.Inventory.Manager",
+                         {"xyz.openbmc_project.Inventory.Item",
+                          "xyz.openbmc_project.Inventory.Decorator.Asset"}}});
+    snapshot.properties.push_back(
+        {"xyz.openbmc_project.Inventory.Manager",
+         "/xyz/board",
+         "xyz.openbmc_project.Inventory.Decorator.Asset",
+         {{"Model", std::string("board")}, {"Present", true}}});
+
+    std::optional<CacheSnapshot> decoded =
+        decodeCacheSnapshot(encodeCacheSnapshot(snapshot));
+    ASSERT_TRUE(decoded);
+    EXPECT_EQ(decoded->subTrees, snapshot.subTrees);
+    EXPECT_EQ(decoded->subTreePaths, snapshot.subTreePaths);
+    EXPECT_EQ(decoded->objects, snapshot.objects);
+    ASSERT_EQ(decoded->properties.size(), 1U);
+    EXPECT_EQ(decoded->properties[0].service,
+              "xyz.openbmc_project.Inventory.Manager");
+    EXPECT_EQ(decoded->properties[0].path, "/xyz/board");
+    EXPECT_EQ(decoded->properties[0].interface,
+              "xyz.openbmc_project.Inventory.Decorator.Asset");
+    EXPECT_EQ(decoded->properties[0].properties,
+              snapshot.properties[0].properties);
+}
+
+TEST(CacheSnapshot, RejectsUnreadableFiles)
+{
+    EXPECT_FALSE(decodeCacheSnapshot(""));
+    EXPECT_FALSE(decodeCacheSnapshot("not cbor"));
+
+    std::string otherVersion;
+    nlohmann::json::to_cbor(
+        nlohmann::json{{"version", cacheSnapshotVersion + 1},
+                       {"subtrees", nlohmann::json::array()},
+                       {"subtree_paths", nlohmann::json::array()},
+                       {"objects", nlohmann::json::array()},
+                       {"properties", nlohmann::json::array()}},
+        otherVersion);
+    EXPECT_FALSE(decodeCacheSnapshot(otherVersion));
+}
+
+TEST(CacheSnapshot, ParsesMapperKeys)
+{
+    std::array<std::string_view, 2> interfaces = {"a.b", "c.d"};
+    std::optional<MapperQuery> query = parseMapperKey(
+        DbusObjectCache::mapperKey("GetSubTree", "/xyz", -1, interfaces));
+    ASSERT_TRUE(query);
+    EXPECT_EQ(query->method, "GetSubTree");
+    EXPECT_EQ(query->path, "/xyz");
+    EXPECT_EQ(query->depth, -1);
+    EXPECT_EQ(query->interfaces, (std::vector<std::string>{"a.b", "c.d"}));
+
+    query = parseMapperKey(
+        DbusObjectCache::mapperKey("GetObject", "/xyz", 0, {}));
+    ASSERT_TRUE(query);
+    EXPECT_TRUE(query->interfaces.empty());
+
+    EXPECT_FALSE(parseMapperKey("GetObject|/xyz"));
+    EXPECT_FALSE(parseMapperKey("GetObject|/xyz|zero"));
+}
+
+} // namespace
+} // namespace dbus::utility
@@ -0,0 +1,92 @@
+#include "dbus_introspect_cache.hpp"
+
+#include <optional>
+#include <string_view>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace dbus::utility
+{
+namespace
+{
+
+constexpr std::string_view introspectXml = R"(<!DOCTYPE node>
+<node>
+  <interface name="xyz.openbmc_project.Example">
+    <method name="Frob">
+      <arg name="count" direction="in" type="u"/>
+      <arg direction="out" type="s"/>
+    </method>
+    <method>
+      <arg name="ignored" direction="in" type="b"/>
+    </method>
+    <signal name="Frobbed">
+      <arg name="count" type="u"/>
+    </signal>
+    <property name="Value" type="d" access="read"/>
+    <property name="Untyped" access="read"/>
+  </interface>
+  <interface>
+    <method name="Orphan"/>
+  </interface>
+  <node name="child0"/>
+  <node/>
+  <node name="child1"/>
+</node>
+)";
+
+TEST(ParseIntrospection, ParsesChildrenAndInterfaces)
+{
+    std::optional<IntrospectData> data = parseIntrospection(introspectXml);
+    ASSERT_TRUE(data);
+    ASSERT_EQ(data->children.size(), 2);
+    EXPECT_EQ(data->children[0], "child0");
+    EXPECT_EQ(data->children[1], "child1");
+
+    ASSERT_EQ(data->interfaces.size(), 1);
+    const IntrospectInterface* interface =
+        data->findInterface("xyz.openbmc_project.Example");
+    ASSERT_NE(interface, nullptr);
+
+    ASSERT_EQ(interface->methods.size(), 1);
+    EXPECT_EQ(interface->methods[0].name, "Frob");
+    ASSERT_EQ(interface->methods[0].args.size(), 2);
+    EXPECT_EQ(interface->methods[0].args[0].name, "count");
+    EXPECT_EQ(interface->methods[0].args[0].direction, "in");
+    EXPECT_EQ(interface->methods[0].args[0].type, "u");
+    EXPECT_EQ(interface->methods[0].args[1].name, "");
+    EXPECT_EQ(interface->methods[0].args[1].direction, "out");
+    EXPECT_EQ(interface->methods[0].args[1].type, "s");
+
+    ASSERT_EQ(interface->signals.size(), 1);
+    EXPECT_EQ(interface->signals[0].name, "Frobbed");
+    ASSERT_EQ(interface->signals[0].args.size(), 1);
+
+    ASSERT_EQ(interface->properties.size(), 1);
+    EXPECT_EQ(interface->properties[0].name, "Value");
+    EXPECT_EQ(interface->properties[0].type, "d");
+
+    EXPECT_EQ(data->findInterface("xyz.openbmc_project.Missing"), nullptr);
+}
+
+TEST(ParseIntrospection, RejectsDocumentsWithoutNode)
+{
+    EXPECT_FALSE(parseIntrospection(""));
+    EXPECT_FALSE(parseIntrospection("not xml"));
+    EXPECT_FALSE(parseIntrospection("<interface name=\"a.b\"/>"));
+}
+
+TEST(ParseIntrospection, EmptyNode)
+{
+    std::optional<IntrospectData> data = parseIntrospection("<node/>");
+    ASSERT_TRUE(data);
+    EXPECT_TRUE(data->children.empty());
+    EXPECT_TRUE(data->interfaces.empty());
+}
+
+} // namespace
+} // namespace dbus::utility
@@ -0,0 +1,77 @@
+#include "dbus_path_trie.hpp"
+
+#include <string_view>
+#include <vector>
+
+#include <gmock/gmock.h> // IWYU pragma: keep
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+// IWYU pragma: no_include <gmock/gmock-matchers.h>
+// IWYU pragma: no_include <gtest/gtest-matchers.h>
+
+namespace dbus::utility
+{
+namespace
+{
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+std::vector<int> findAll(const PathNamespaceTrie<int>& trie,
+                         std::string_view path)
+{
+    std::vector<int> out;
+    trie.find(path, [&out](const int& value) { out.push_back(value); });
+    return out;
+}
+
+TEST(PathNamespaceTrie, MatchesPathNamespaces)
+{
+    PathNamespaceTrie<int> trie;
+    trie.insert("/xyz/openbmc_project/sensors", 1);
+    trie.insert("/xyz/openbmc_project/sensors/temperature", 2);
+    trie.insert("/xyz/openbmc_project/state", 3);
+
+    EXPECT_THAT(findAll(trie, "/xyz/openbmc_project/sensors"), ElementsAre(1));
+    EXPECT_THAT(findAll(trie, "/xyz/openbmc_project/sensors/temperature/cpu0"),
+                ElementsAre(1, 2));
+    EXPECT_THAT(findAll(trie, "/xyz/openbmc_project/sensorsX"), IsEmpty());
+    EXPECT_THAT(findAll(trie, "/xyz/openbmc_project"), IsEmpty());
+    EXPECT_THAT(findAll(trie, "/xyz/openbmc_project/state/host0"),
+                ElementsAre(3));
+}
+
+TEST(PathNamespaceTrie, RootMatchesEverything)
+{
+    PathNamespaceTrie<int> trie;
+    trie.insert("/", 7);
+    trie.insert("/a", 7);
+    EXPECT_THAT(findAll(trie, "/"), ElementsAre(7));
+    EXPECT_THAT(findAll(trie, "/a/b"), ElementsAre(7));
+}
+
+TEST(PathNamespaceTrie, EraseRemovesOnlyThatPath)
+{
+    PathNamespaceTrie<int> trie;
+    trie.insert("/a/b", 1);
+    trie.insert("/a", 2);
+    trie.insert("/a/b", 2);
+
+    trie.erase("/a/b", 2);
+    EXPECT_THAT(findAll(trie, "/a/b/c"), ElementsAre(1, 2));
+    trie.erase("/a", 2);
+    EXPECT_THAT(findAll(trie, "/a/b/c"), ElementsAre(1));
+    trie.erase("/a/b", 1);
+    EXPECT_THAT(findAll(trie, "/a/b/c"), IsEmpty());
+    EXPECT_TRUE(trie.empty());
+
+    // Erasing something that was never there is harmless
+    trie.erase("/x/y", 1);
+    EXPECT_TRUE(trie.empty());
+}
+
+} // namespace
+} // namespace dbus::utility
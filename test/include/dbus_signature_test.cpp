@@ -0,0 +1,84 @@
+#include "dbus_signature.hpp"
+
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace dbus::utility
+{
+namespace
+{
+
+TEST(ParseDbusSignature, SplitsCompleteTypes)
+{
+    DbusSignature types;
+    ASSERT_TRUE(parseDbusSignature("sa{sv}(ib)av", types));
+    ASSERT_EQ(types.size(), 4);
+    EXPECT_EQ(types[0].code, 's');
+
+    EXPECT_EQ(types[1].code, 'a');
+    EXPECT_EQ(types[1].contents, "{sv}");
+    ASSERT_EQ(types[1].children.size(), 1);
+    const DbusTypeNode& entry = types[1].children[0];
+    EXPECT_EQ(entry.code, '{');
+    EXPECT_EQ(entry.contents, "sv");
+    ASSERT_EQ(entry.children.size(), 2);
+    EXPECT_EQ(entry.children[0].code, 's');
+    EXPECT_EQ(entry.children[1].code, 'v');
+
+    EXPECT_EQ(types[2].code, '(');
+    EXPECT_EQ(types[2].contents, "ib");
+    ASSERT_EQ(types[2].children.size(), 2);
+
+    EXPECT_EQ(types[3].code, 'a');
+    EXPECT_EQ(types[3].contents, "v");
+}
+
+TEST(ParseDbusSignature, NestedContainers)
+{
+    DbusSignature types;
+    ASSERT_TRUE(parseDbusSignature("a{oa{sa{sv}}}", types));
+    ASSERT_EQ(types.size(), 1);
+    EXPECT_EQ(types[0].contents, "{oa{sa{sv}}}");
+    const DbusTypeNode& inner = types[0].children[0].children[1];
+    EXPECT_EQ(inner.code, 'a');
+    EXPECT_EQ(inner.contents, "{sa{sv}}");
+
+    ASSERT_TRUE(parseDbusSignature("a(sa(ii))", types));
+    ASSERT_EQ(types.size(), 1);
+    EXPECT_EQ(types[0].children[0].contents, "sa(ii)");
+}
+
+TEST(ParseDbusSignature, RejectsInvalidSignatures)
+{
+    DbusSignature types;
+    EXPECT_TRUE(parseDbusSignature("", types));
+    EXPECT_TRUE(types.empty());
+
+    EXPECT_FALSE(parseDbusSignature("a", types));
+    EXPECT_TRUE(types.empty());
+    EXPECT_FALSE(parseDbusSignature("()", types));
+    EXPECT_FALSE(parseDbusSignature("(ii", types));
+    EXPECT_FALSE(parseDbusSignature("{sv}", types));
+    EXPECT_FALSE(parseDbusSignature("a{vs}", types));
+    EXPECT_FALSE(parseDbusSignature("a{s}", types));
+    EXPECT_FALSE(parseDbusSignature("a{svs}", types));
+    EXPECT_FALSE(parseDbusSignature("z", types));
+    EXPECT_FALSE(parseDbusSignature(std::string(100, 'a') + "s", types));
+}
+
+TEST(GetParsedSignature, SharesParses)
+{
+    std::shared_ptr<const DbusSignature> first = getParsedSignature("a{sv}");
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(getParsedSignature("a{sv}"), first);
+    EXPECT_EQ(getParsedSignature("a{"), nullptr);
+}
+
+} // namespace
+} // namespace dbus::utility
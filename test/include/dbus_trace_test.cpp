@@ -0,0 +1,174 @@
+#include "cancellation.hpp"
+#include "dbus_trace.hpp"
+
+#include <boost/system/error_code.hpp>
+
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include <gmock/gmock.h> // IWYU pragma: keep
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+// IWYU pragma: no_include <gmock/gmock-matchers.h>
+
+namespace crow
+{
+namespace dbus_trace
+{
+namespace
+{
+
+using ::testing::HasSubstr;
+using ::testing::StartsWith;
+
+TEST(ScopedTrace, RestoresPreviousTrace)
+{
+    auto outer = std::make_shared<RequestTrace>();
+    auto inner = std::make_shared<RequestTrace>();
+    {
+        ScopedTrace outerScope(outer);
+        {
+            ScopedTrace innerScope(inner);
+            EXPECT_EQ(currentTrace(), inner);
+        }
+        EXPECT_EQ(currentTrace(), outer);
+    }
+    EXPECT_EQ(currentTrace(), nullptr);
+}
+
+TEST(TracedHandler, AttributesNestedCallsToIssuingRequest)
+{
+    auto trace = std::make_shared<RequestTrace>();
+    std::shared_ptr<RequestTrace> seenInHandler;
+    auto handler = traceHandler(
+        [&seenInHandler](const boost::system::error_code&, int value) {
+        EXPECT_EQ(value, 42);
+        seenInHandler = currentTrace();
+    },
+        "xyz.openbmc_project.Test", "xyz.openbmc_project.Iface", "Method");
+    // The handler was created with no trace current, so nothing is attributed
+    handler(boost::system::error_code(), 42);
+    EXPECT_EQ(seenInHandler, nullptr);
+    EXPECT_EQ(trace->count(), 0U);
+
+    ScopedTrace scope(trace);
+    auto traced = traceHandler(
+        [&seenInHandler](const boost::system::error_code&) {
+        seenInHandler = currentTrace();
+    },
+        "xyz.openbmc_project.Test", "xyz.openbmc_project.Iface", "Method");
+    {
+        ScopedTrace other(nullptr);
+        traced(boost::system::error_code(
+            EIO, boost::system::system_category()));
+        EXPECT_EQ(currentTrace(), nullptr);
+    }
+    EXPECT_EQ(seenInHandler, trace);
+    EXPECT_EQ(trace->count(), 1U);
+    const CallSummary& summary =
+        trace->summaries().at({"xyz.openbmc_project.Test",
+                               "xyz.openbmc_project.Iface.Method"});
+    EXPECT_EQ(summary.count, 1U);
+    EXPECT_EQ(summary.errors, 1U);
+}
+
+TEST(TracedHandler, AbortsCallsOfCancelledRequest)
+{
+    auto cancellation = std::make_shared<Cancellation>();
+    auto trace = std::make_shared<RequestTrace>(cancellation);
+    ScopedTrace scope(trace);
+    boost::system::error_code seenEc;
+    std::string seenValue = "unset";
+    auto traced = traceHandler(
+        [&seenEc, &seenValue](const boost::system::error_code& ec,
+                              const std::string& value) {
+        seenEc = ec;
+        seenValue = value;
+    },
+        "xyz.openbmc_project.Test", "xyz.openbmc_project.Iface", "Aborted");
+    EXPECT_FALSE(traced.cancelled());
+
+    cancellation->cancel();
+    EXPECT_TRUE(trace->cancelled());
+    ASSERT_TRUE(traced.cancelled());
+    traced.abort();
+    EXPECT_EQ(seenEc, boost::asio::error::operation_aborted);
+    EXPECT_EQ(seenValue, "");
+    // Counted as cancelled rather than made
+    EXPECT_EQ(trace->count(), 0U);
+    const CallSummary& total =
+        getCallTotals().at({"xyz.openbmc_project.Test",
+                            "xyz.openbmc_project.Iface.Aborted"});
+    EXPECT_EQ(total.count, 0U);
+    EXPECT_EQ(total.cancelled, 1U);
+}
+
+TEST(TracedHandler, SharedCallsAreNotCancelled)
+{
+    auto cancellation = std::make_shared<Cancellation>();
+    auto trace = std::make_shared<RequestTrace>(cancellation);
+    ScopedTrace scope(trace);
+    bool sharedInHandler = false;
+    auto makeHandler = [&sharedInHandler]() {
+        return traceHandler(
+            [&sharedInHandler](const boost::system::error_code&) {
+            sharedInHandler = currentShared();
+        },
+            "xyz.openbmc_project.Test", "xyz.openbmc_project.Iface", "Shared");
+    };
+    auto unshared = makeHandler();
+    std::optional<decltype(makeHandler())> shared;
+    {
+        SharedCallScope sharedCalls;
+        shared.emplace(makeHandler());
+    }
+    EXPECT_FALSE(currentShared());
+
+    cancellation->cancel();
+    EXPECT_TRUE(unshared.cancelled());
+    EXPECT_FALSE(shared->cancelled());
+
+    // Calls issued from the shared call's reply are shared too
+    (*shared)(boost::system::error_code());
+    EXPECT_TRUE(sharedInHandler);
+    EXPECT_FALSE(currentShared());
+    EXPECT_EQ(trace->count(), 1U);
+}
+
+TEST(RequestTrace, HeaderValueListsSlowestFirst)
+{
+    RequestTrace trace;
+    trace.record("a.service", "a.Iface.Get", std::chrono::microseconds(10),
+                 false);
+    trace.record("b.service", "b.Iface.Set", std::chrono::microseconds(300),
+                 true);
+    trace.record("a.service", "a.Iface.Get", std::chrono::microseconds(20),
+                 false);
+    EXPECT_EQ(trace.headerValue(),
+              "3 calls 330us; b.service b.Iface.Set 1 300us 1 failed; "
+              "a.service a.Iface.Get 2 30us");
+}
+
+TEST(RenderPrometheus, EmitsTotalsPerMember)
+{
+    CallSummaries totals;
+    totals[{"a.service", "a.Iface.Get"}].add(std::chrono::milliseconds(1500),
+                                             true);
+    std::string out = renderPrometheus(totals);
+    EXPECT_THAT(out, StartsWith("# HELP bmcweb_dbus_calls_total"));
+    EXPECT_THAT(out, HasSubstr("bmcweb_dbus_calls_total{service=\"a.service\","
+                               "member=\"a.Iface.Get\"} 1\n"));
+    EXPECT_THAT(out, HasSubstr("bmcweb_dbus_call_errors_total{service=\"a."
+                               "service\",member=\"a.Iface.Get\"} 1\n"));
+    EXPECT_THAT(out, HasSubstr("bmcweb_dbus_call_seconds_total{service=\"a."
+                               "service\",member=\"a.Iface.Get\"} 1.5\n"));
+}
+
+} // namespace
+} // namespace dbus_trace
+} // namespace crow
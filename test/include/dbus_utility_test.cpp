@@ -1,6 +1,9 @@
 #include "dbus_utility.hpp"
 
+#include <array>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include <gtest/gtest.h> // IWYU pragma: keep
 
@@ -44,5 +47,113 @@ TEST(GetNthStringFromPath, InvalidIndexReturnsFalse)
     std::string result;
     EXPECT_FALSE(getNthStringFromPath(path, -1, result));
 }
+
+TEST(DbusObjectCache, MapperKeyDistinguishesQueries)
+{
+    constexpr std::array<std::string_view, 2> interfaces = {"a.b", "c.d"};
+    constexpr std::array<std::string_view, 1> oneInterface = {"a.b"};
+    std::string key =
+        DbusObjectCache::mapperKey("GetSubTree", "/xyz", 0, interfaces);
+    EXPECT_EQ(key, "GetSubTree|/xyz|0|a.b|c.d");
+    EXPECT_NE(key,
+              DbusObjectCache::mapperKey("GetSubTreePaths", "/xyz", 0,
+                                         interfaces));
+    EXPECT_NE(key,
+              DbusObjectCache::mapperKey("GetSubTree", "/xyz", 1, interfaces));
+    EXPECT_NE(key, DbusObjectCache::mapperKey("GetSubTree", "/xyz", 0,
+                                              oneInterface));
+}
+
+TEST(DbusObjectCache, DisabledCacheNeverHits)
+{
+    DbusObjectCache& cache = DbusObjectCache::getInstance();
+    ASSERT_FALSE(cache.enabled());
+    MapperGetSubTreePathsResponse paths{"/xyz/a"};
+    cache.insertMapper("key", cache.getGeneration(), paths);
+    EXPECT_EQ(cache.findMapper<MapperGetSubTreePathsResponse>("key"),
+              nullptr);
+    cache.insertProperties("svc", "/xyz/a", "", cache.getGeneration(), {});
+    EXPECT_EQ(cache.findProperties("svc", "/xyz/a", ""), nullptr);
+}
+TEST(PendingMapperCalls, CallersJoinOnlyCallsOfTheirGeneration)
+{
+    PendingMapperCalls<MapperGetSubTreePathsResponse> pending;
+    std::vector<std::string> answered;
+    auto waiter = [&answered](std::string name) {
+        return [&answered, name](const boost::system::error_code&,
+                                 const MapperGetSubTreePathsResponse&) {
+            answered.push_back(name);
+        };
+    };
+
+    EXPECT_TRUE(pending.join("key", 1, waiter("first")));
+    EXPECT_FALSE(pending.join("key", 1, waiter("joined")));
+
+    // An InterfacesAdded moved the mapper generation on between the call
+    // being made and this caller arriving, so it needs a call of its own
+    EXPECT_TRUE(pending.join("key", 2, waiter("after signal")));
+    EXPECT_EQ(pending.size(), 2U);
+
+    for (const auto& callback : pending.take("key", 1))
+    {
+        callback(boost::system::error_code(), {});
+    }
+    EXPECT_EQ(answered, (std::vector<std::string>{"first", "joined"}));
+
+    for (const auto& callback : pending.take("key", 2))
+    {
+        callback(boost::system::error_code(), {});
+    }
+    EXPECT_EQ(answered,
+              (std::vector<std::string>{"first", "joined", "after signal"}));
+    EXPECT_TRUE(pending.take("key", 2).empty());
+    EXPECT_EQ(pending.size(), 0U);
+}
+
+TEST(ManagedObjectBatcher, FindObjectManagerPicksDeepestAncestor)
+{
+    MapperGetSubTreeResponse managers = {
+        {"/", {{"xyz.openbmc_project.Inventory.Manager", {}}}},
+        {"/xyz/openbmc_project/inventory",
+         {{"xyz.openbmc_project.Inventory.Manager", {}},
+          {"xyz.openbmc_project.EntityManager", {}}}},
+        {"/xyz/openbmc_project/inventory/system/chassis",
+         {{"xyz.openbmc_project.EntityManager", {}}}}};
+
+    EXPECT_EQ(ManagedObjectBatcher::findObjectManager(
+                  managers, "xyz.openbmc_project.Inventory.Manager",
+                  "/xyz/openbmc_project/inventory/system/chassis/fan0"),
+              "/xyz/openbmc_project/inventory");
+    EXPECT_EQ(ManagedObjectBatcher::findObjectManager(
+                  managers, "xyz.openbmc_project.EntityManager",
+                  "/xyz/openbmc_project/inventory/system/chassis/fan0"),
+              "/xyz/openbmc_project/inventory/system/chassis");
+    EXPECT_EQ(ManagedObjectBatcher::findObjectManager(
+                  managers, "xyz.openbmc_project.Inventory.Manager",
+                  "/xyz/openbmc_project/software/abc"),
+              "/");
+}
+
+TEST(ManagedObjectBatcher, FindObjectManagerNeedsStrictDescendant)
+{
+    MapperGetSubTreeResponse managers = {
+        {"/xyz/openbmc_project/inventory",
+         {{"xyz.openbmc_project.Inventory.Manager", {}}}}};
+
+    // GetManagedObjects doesn't return the manager object itself
+    EXPECT_EQ(ManagedObjectBatcher::findObjectManager(
+                  managers, "xyz.openbmc_project.Inventory.Manager",
+                  "/xyz/openbmc_project/inventory"),
+              "");
+    EXPECT_EQ(ManagedObjectBatcher::findObjectManager(
+                  managers, "xyz.openbmc_project.Inventory.Manager",
+                  "/xyz/openbmc_project/inventory2/fan0"),
+              "");
+    EXPECT_EQ(ManagedObjectBatcher::findObjectManager(
+                  managers, "xyz.openbmc_project.Other",
+                  "/xyz/openbmc_project/inventory/fan0"),
+              "");
+}
+
 } // namespace
 } // namespace dbus::utility
@@ -74,6 +74,16 @@ TEST(getPreferedContentType, PositiveTest)
     EXPECT_EQ(getPreferedContentType("application/json", cborJson),
               ContentType::JSON);
     EXPECT_EQ(getPreferedContentType("*/*", cborJson), ContentType::ANY);
+
+    std::array<ContentType, 3> binary{ContentType::JSON, ContentType::CBOR,
+                                      ContentType::MsgPack};
+    EXPECT_EQ(getPreferedContentType("application/msgpack", binary),
+              ContentType::MsgPack);
+    EXPECT_EQ(
+        getPreferedContentType("application/msgpack, application/json", binary),
+        ContentType::MsgPack);
+    EXPECT_EQ(getPreferedContentType("application/msgpack", cborJson),
+              ContentType::NoMatch);
 }
 
 TEST(getPreferedContentType, NegativeTest)
@@ -83,5 +93,23 @@ TEST(getPreferedContentType, NegativeTest)
         getPreferedContentType("text/html, application/json", contentType),
         ContentType::NoMatch);
 }
+
+TEST(getPreferredWait, ReadsWaitPreference)
+{
+    EXPECT_EQ(getPreferredWait("wait=30"), std::chrono::seconds(30));
+    EXPECT_EQ(getPreferredWait("respond-async, wait=10"),
+              std::chrono::seconds(10));
+    EXPECT_EQ(getPreferredWait(" wait=5 ;foo=bar, return=minimal"),
+              std::chrono::seconds(5));
+}
+
+TEST(getPreferredWait, NoWaitPreference)
+{
+    EXPECT_EQ(getPreferredWait(""), std::nullopt);
+    EXPECT_EQ(getPreferredWait("respond-async"), std::nullopt);
+    EXPECT_EQ(getPreferredWait("wait=soon"), std::nullopt);
+    EXPECT_EQ(getPreferredWait("wait=-1"), std::nullopt);
+    EXPECT_EQ(getPreferredWait("waiting=3"), std::nullopt);
+}
 } // namespace
 } // namespace http_helpers
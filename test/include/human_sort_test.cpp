@@ -1,7 +1,12 @@
 #include "human_sort.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <random>
 #include <set>
 #include <string>
+#include <vector>
 
 #include <gmock/gmock.h> // IWYU pragma: keep
 #include <gtest/gtest.h> // IWYU pragma: keep
@@ -55,4 +60,90 @@ TEST(AlphaNum, LessTest)
                                                             "Alpha 2"};
     EXPECT_THAT(sorted, ElementsAreArray({"Alpha 2", "Alpha 10"}));
 }
+
+TEST(AlphanumSortKey, OrdersLikeAlphanumComp)
+{
+    std::vector<std::string> values = {
+        "", "a", "9", "1", "2", "a1", "a2", "a1a2", "a1a3", "a1a0", "134",
+        "122", "12a3", "12a1", "12a0", "aa", "aaa", "Alpha 2", "Alpha 2A",
+        "Alpha 2 B", "a01b", "a1a", "a0", "a00", "dimm10", "dimm9", "DIMM9",
+        "cpu0_core", "log.2", "log.10"};
+    for (const std::string& left : values)
+    {
+        for (const std::string& right : values)
+        {
+            int compared = alphanumComp(left, right);
+            int keyCompared =
+                alphanumSortKey(left).compare(alphanumSortKey(right));
+            EXPECT_EQ(compared < 0, keyCompared < 0) << left << " " << right;
+            EXPECT_EQ(compared == 0, keyCompared == 0) << left << " " << right;
+        }
+    }
+}
+
+TEST(AlphanumSortKey, NumbersBeyondIntRange)
+{
+    EXPECT_LT(alphanumSortKey("entry_99999999999"),
+              alphanumSortKey("entry_100000000000"));
+    EXPECT_LT(alphanumSortKey("1678901234567_1"),
+              alphanumSortKey("1678901234567_2"));
+}
+
+TEST(AlphanumSort, SortsWithProjection)
+{
+    std::vector<std::filesystem::path> paths = {
+        "/var/log/log.10", "/var/log/log.2", "/var/log/log", "/var/log/log.1"};
+    alphanumSort(paths.begin(), paths.end(),
+                 [](const std::filesystem::path& path) {
+        return path.filename().string();
+    });
+    EXPECT_THAT(paths, ElementsAreArray(
+                           {std::filesystem::path("/var/log/log"),
+                            std::filesystem::path("/var/log/log.1"),
+                            std::filesystem::path("/var/log/log.2"),
+                            std::filesystem::path("/var/log/log.10")}));
+}
+
+// Not a pass/fail benchmark; the timings are recorded in the test results
+// (--gtest_output=xml) to compare the two sorts on realistic sizes.
+TEST(AlphanumSort, MatchesAlphanumLessOn10kEntries)
+{
+    std::mt19937 random(42);
+    std::vector<std::string> values;
+    values.reserve(10000);
+    for (size_t i = 0; i < 5000; i++)
+    {
+        // Log entry ids: a timestamp, with a suffix on duplicates
+        std::string id = std::to_string(1678000000 + random() % 100000);
+        if (i % 7 == 0)
+        {
+            id += "_" + std::to_string(i % 13);
+        }
+        values.push_back(std::move(id));
+    }
+    for (size_t i = 0; i < 5000; i++)
+    {
+        values.push_back("cpu" + std::to_string(random() % 8) + "_dimm" +
+                         std::to_string(random() % 64));
+    }
+
+    std::vector<std::string> expected = values;
+    auto start = std::chrono::steady_clock::now();
+    std::stable_sort(expected.begin(), expected.end(),
+                     AlphanumLess<std::string>());
+    auto comparing = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    alphanumSort(values.begin(), values.end());
+    auto keyed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(values, expected);
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+    int comparingUs =
+        static_cast<int>(duration_cast<microseconds>(comparing).count());
+    int keyedUs = static_cast<int>(duration_cast<microseconds>(keyed).count());
+    RecordProperty("AlphanumLessMicroseconds", comparingUs);
+    RecordProperty("AlphanumSortMicroseconds", keyedUs);
+}
 } // namespace
@@ -0,0 +1,126 @@
+#include "ibm/config_file_index.hpp"
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <gmock/gmock.h> // IWYU pragma: keep
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace crow::ibm_utils
+{
+namespace
+{
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+class ConfigFileIndexTest : public ::testing::Test
+{
+  protected:
+    ConfigFileIndexTest() :
+        dir(std::filesystem::temp_directory_path() /
+            ("config_file_index_test_" + std::to_string(getpid())))
+    {
+        std::filesystem::create_directories(dir);
+    }
+
+    ~ConfigFileIndexTest() override
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(dir, ec);
+    }
+
+    ConfigFileIndexTest(const ConfigFileIndexTest&) = delete;
+    ConfigFileIndexTest(ConfigFileIndexTest&&) = delete;
+    ConfigFileIndexTest& operator=(const ConfigFileIndexTest&) = delete;
+    ConfigFileIndexTest& operator=(ConfigFileIndexTest&&) = delete;
+
+    void write(const std::filesystem::path& path, size_t size) const
+    {
+        std::ofstream file(dir / path);
+        file << std::string(size, 'a');
+    }
+
+    std::filesystem::path dir;
+};
+
+TEST_F(ConfigFileIndexTest, ScansExistingFiles)
+{
+    write("b", 20);
+    write("a", 10);
+    std::filesystem::create_directory(dir / "sub");
+    write("sub/c", 5);
+
+    ConfigFileIndex index(dir);
+    ASSERT_TRUE(index.refresh());
+    EXPECT_THAT(index.names(), ElementsAre("a", "b"));
+    EXPECT_EQ(index.totalSize(), 35);
+    const ConfigFileIndex::Entry* entry = index.find("b");
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->size, 20);
+    EXPECT_EQ(index.find("c"), nullptr);
+}
+
+TEST_F(ConfigFileIndexTest, TracksWritesAndDeletesWithoutRescanning)
+{
+    ConfigFileIndex index(dir);
+    ASSERT_TRUE(index.refresh());
+    EXPECT_THAT(index.names(), IsEmpty());
+
+    write("a", 10);
+    index.added("a", 10);
+    write("b", 30);
+    index.added("b", 30);
+    write("a", 4);
+    index.added("a", 4);
+    ASSERT_TRUE(index.refresh());
+    EXPECT_THAT(index.names(), ElementsAre("a", "b"));
+    EXPECT_EQ(index.totalSize(), 34);
+
+    std::filesystem::remove(dir / "b");
+    index.removed("b");
+    ASSERT_TRUE(index.refresh());
+    EXPECT_THAT(index.names(), ElementsAre("a"));
+    EXPECT_EQ(index.totalSize(), 4);
+}
+
+TEST_F(ConfigFileIndexTest, RescansWhenDirectoryChangesBehindIt)
+{
+    ConfigFileIndex index(dir);
+    ASSERT_TRUE(index.refresh());
+
+    // Make sure the directory's modification time moves on
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    write("outside", 7);
+    ASSERT_TRUE(index.refresh());
+    EXPECT_THAT(index.names(), ElementsAre("outside"));
+    EXPECT_EQ(index.totalSize(), 7);
+}
+
+TEST_F(ConfigFileIndexTest, MissingDirectoryIsEmpty)
+{
+    ConfigFileIndex index(dir / "missing");
+    ASSERT_TRUE(index.refresh());
+    EXPECT_THAT(index.names(), IsEmpty());
+    EXPECT_EQ(index.totalSize(), 0);
+
+    std::filesystem::create_directory(dir / "missing");
+    write("missing/a", 3);
+    ASSERT_TRUE(index.refresh());
+    EXPECT_THAT(index.names(), ElementsAre("a"));
+}
+
+} // namespace
+} // namespace crow::ibm_utils
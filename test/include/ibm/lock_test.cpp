@@ -1,7 +1,11 @@
 #include "ibm/locks.hpp"
 
+#include <array>
+#include <chrono>
 #include <cstdint>
 #include <memory>
+#include <optional>
+#include <random>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -112,6 +116,11 @@ class MockLock : public crow::ibm_mc_lock::Lock
         auto status = Lock::isItMyLock(tids, ids);
         return status;
     }
+    bool isConflictRecord(const LockRequest& record1,
+                          const LockRequest& record2) override
+    {
+        return Lock::isConflictRecord(record1, record2);
+    }
     friend class LockTest;
 };
 
@@ -362,5 +371,143 @@ TEST_F(LockTest, ValidateSessionIDForGetlocklistGoodTestCase)
     EXPECT_EQ(result.size(), 1);
 }
 
+TEST_F(LockTest, ReleaseLockBySessionIdRemovesOnlyThatSession)
+{
+    MockLock lockManager;
+    lockManager.isConflictWithTable(request1);
+    std::get<0>(record) = "yyyyy";
+    lockManager.isConflictWithTable({record});
+
+    lockManager.releaseLock("xxxxx");
+    auto xLocks = std::get<std::vector<std::pair<uint32_t, LockRequests>>>(
+        lockManager.getLockList({"xxxxx"}));
+    EXPECT_THAT(xLocks, IsEmpty());
+    auto yLocks = std::get<std::vector<std::pair<uint32_t, LockRequests>>>(
+        lockManager.getLockList({"yyyyy"}));
+    ASSERT_EQ(yLocks.size(), 1);
+    EXPECT_EQ(yLocks[0].first, 2);
+    EXPECT_FALSE(lockManager.validateRids({1}));
+    EXPECT_TRUE(lockManager.validateRids({2}));
+
+    // Only the lock left can conflict
+    auto rc = lockManager.isConflictWithTable(request2);
+    ASSERT_TRUE(rc.first);
+    using Conflict = std::pair<uint32_t, LockRequest>;
+    EXPECT_EQ(std::get<Conflict>(rc.second).first, 2);
+}
+
+TEST_F(LockTest, ReleasedLocksNoLongerConflict)
+{
+    MockLock lockManager;
+    auto rc1 = lockManager.isConflictWithTable(request2);
+    ASSERT_FALSE(rc1.first);
+    EXPECT_TRUE(lockManager.isConflictWithTable(request1).first);
+
+    auto rc = lockManager.isItMyLock({1}, {"hmc-id", "xxxxx"});
+    EXPECT_TRUE(rc.first);
+    EXPECT_FALSE(lockManager.isConflictWithTable(request1).first);
+}
+
+LockRequest randomRecord(std::mt19937& gen, uint32_t session)
+{
+    constexpr std::array<const char*, 3> flags{"DontLock", "LockSame",
+                                               "LockAll"};
+    std::uniform_int_distribution<uint32_t> flagDist(0, 9);
+    std::uniform_int_distribution<uint32_t> lengthDist(1, 2);
+    std::uniform_int_distribution<uint64_t> byteDist(0, 3);
+
+    SegmentFlags segments;
+    bool locked = false;
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        // Mostly DontLock, and at most one segment locking
+        uint32_t flag = flagDist(gen);
+        uint32_t index = flag < 7 || locked ? 0 : 1 + flag % 2;
+        locked = locked || index != 0;
+        segments.emplace_back(flags[index], lengthDist(gen));
+    }
+    uint64_t resourceId = 0;
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        resourceId = (resourceId << 8) | byteDist(gen);
+    }
+    return {"session" + std::to_string(session), "hmc-id",
+            byteDist(gen) == 0 ? "Write" : "Read", resourceId,
+            std::move(segments)};
+}
+
+TEST_F(LockTest, IndexedConflictsMatchComparingEveryLock)
+{
+    MockLock lockManager;
+    std::mt19937 gen(1234);
+    std::uniform_int_distribution<uint32_t> sessionDist(0, 7);
+    std::vector<std::pair<uint32_t, LockRequests>> held;
+    for (uint32_t i = 0; i < 2000; i++)
+    {
+        LockRequests requests{randomRecord(gen, sessionDist(gen))};
+        ASSERT_TRUE(lockManager.isValidLockRequest(requests[0]));
+
+        std::optional<std::pair<uint32_t, LockRequest>> expected;
+        for (const auto& [id, records] : held)
+        {
+            for (const LockRequest& heldRecord : records)
+            {
+                if (!expected &&
+                    lockManager.isConflictRecord(requests[0], heldRecord))
+                {
+                    expected.emplace(id, heldRecord);
+                }
+            }
+        }
+
+        Rc rc = lockManager.isConflictWithTable(requests);
+        ASSERT_EQ(rc.first, expected.has_value());
+        if (expected)
+        {
+            using Conflict = std::pair<uint32_t, LockRequest>;
+            EXPECT_EQ(std::get<Conflict>(rc.second), *expected);
+        }
+        else
+        {
+            held.emplace_back(std::get<uint32_t>(rc.second), requests);
+        }
+
+        // Now and then a session goes away
+        if (i % 200 == 199)
+        {
+            std::string session = "session" + std::to_string(sessionDist(gen));
+            lockManager.releaseLock(session);
+            std::erase_if(held, [&session](const auto& lock) {
+                return std::get<0>(lock.second[0]) == session;
+            });
+        }
+    }
+}
+
+TEST_F(LockTest, ManyDisjointLocksAcquireAndReleaseQuickly)
+{
+    MockLock lockManager;
+    constexpr uint32_t lockCount = 20000;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < lockCount; i++)
+    {
+        // Each on its own resource at the first segment
+        LockRequests requests{{"session" + std::to_string(i % 100),
+                               "hmc-id",
+                               "Write",
+                               static_cast<uint64_t>(i) << 48,
+                               {{"DontLock", 2}, {"LockSame", 2}}}};
+        ASSERT_FALSE(lockManager.isConflictWithTable(requests).first);
+    }
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        lockManager.releaseLock("session" + std::to_string(i));
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    // Comparing each lock with every lock held takes minutes for this many
+    EXPECT_LT(elapsed, std::chrono::seconds(10));
+    EXPECT_FALSE(lockManager.validateRids({1}));
+}
+
 } // namespace
 } // namespace crow::ibm_mc_lock
@@ -0,0 +1,54 @@
+#include "json_html_serializer.hpp"
+
+#include <string>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace json_html_util
+{
+namespace
+{
+
+std::string escaped(const std::string& str)
+{
+    std::string out;
+    dumpEscaped(out, str);
+    return out;
+}
+
+TEST(DumpEscaped, PlainAsciiIsCopied)
+{
+    EXPECT_EQ(escaped(""), "");
+    EXPECT_EQ(escaped("abc"), "abc");
+    EXPECT_EQ(escaped("/redfish/v1/Systems/system/LogServices/EventLog"),
+              "/redfish/v1/Systems/system/LogServices/EventLog");
+}
+
+TEST(DumpEscaped, SpecialCharactersAreEscaped)
+{
+    EXPECT_EQ(escaped("a \"quoted\" word"), "a &quot;quoted&quot; word");
+    EXPECT_EQ(escaped("it's"), "it&apos;s");
+    EXPECT_EQ(escaped("this & that"), "this &amp; that");
+    EXPECT_EQ(escaped("line one\nline two\ttabbed"),
+              "line one\\nline two\\ttabbed");
+    EXPECT_EQ(escaped(std::string("\x01", 1)), "\\u0001");
+}
+
+TEST(DumpEscaped, MultiByteCharacters)
+{
+    EXPECT_EQ(escaped("caf\xc3\xa9 latte"), "caf\\u00e9 latte");
+    EXPECT_EQ(escaped("\xf0\x9f\x98\x80 smile"), "\\ud83d\\ude00 smile");
+}
+
+TEST(DumpEscaped, InvalidUtf8IsReplaced)
+{
+    EXPECT_EQ(escaped("bad \xff byte"), "bad \\ufffd byte");
+    EXPECT_EQ(escaped("truncated \xc3"), "truncated \\ufffd");
+}
+
+} // namespace
+} // namespace json_html_util
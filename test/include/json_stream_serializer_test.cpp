@@ -0,0 +1,107 @@
+#include "json_stream_serializer.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace json_stream
+{
+namespace
+{
+
+std::string serializeInChunks(const nlohmann::json& value, size_t chunkSize)
+{
+    JsonChunkSerializer serializer(value);
+    std::string out;
+    while (!serializer.done())
+    {
+        std::string chunk;
+        serializer.fill(chunk, chunkSize);
+        out += chunk;
+    }
+    return out;
+}
+
+std::string referenceDump(const nlohmann::json& value)
+{
+    return value.dump(2, ' ', true, nlohmann::json::error_handler_t::replace);
+}
+
+TEST(JsonChunkSerializer, ScalarsMatchDump)
+{
+    for (const nlohmann::json& value :
+         {nlohmann::json(nullptr), nlohmann::json(true), nlohmann::json(42),
+          nlohmann::json(-1.5), nlohmann::json("a\"b\né")})
+    {
+        EXPECT_EQ(serializeInChunks(value, 1), referenceDump(value));
+    }
+}
+
+TEST(JsonChunkSerializer, NestedDocumentMatchesDumpForAnyChunkSize)
+{
+    nlohmann::json value = R"({
+        "@odata.id": "/redfish/v1/Systems/system/LogServices/EventLog",
+        "Members": [{"Id": "1", "Message": "x"}, {"Id": "2"}, [], {}],
+        "Empty": {},
+        "Nested": {"a": [1, 2, [3, {"b": null}]], "c": "ÿ"},
+        "Members@odata.count": 4
+    })"_json;
+
+    std::string expected = referenceDump(value);
+    for (size_t chunkSize : std::to_array<size_t>({1, 2, 7, 64, 4096}))
+    {
+        EXPECT_EQ(serializeInChunks(value, chunkSize), expected);
+    }
+}
+
+TEST(JsonChunkSerializer, FillStopsAtChunkSize)
+{
+    nlohmann::json value = nlohmann::json::array();
+    for (int i = 0; i < 1000; i++)
+    {
+        value.push_back(i);
+    }
+    JsonChunkSerializer serializer(value);
+    std::string chunk;
+    serializer.fill(chunk, 100);
+    EXPECT_FALSE(serializer.done());
+    // Output may overshoot by at most one element
+    EXPECT_GE(chunk.size(), 100);
+    EXPECT_LT(chunk.size(), 120);
+}
+
+TEST(JsonChunkSerializer, WrittenLeavesMatchDump)
+{
+    nlohmann::json value = {
+        {"plain", "abc"},
+        {"ke\"y", "back\\slash"},
+        {"tab\tkey", "\x01"},
+        {"\x7f", "é"},
+        {"", ""},
+        {"min", std::numeric_limits<int64_t>::min()},
+        {"max", std::numeric_limits<uint64_t>::max()},
+        {"zero", 0},
+        {"negative", -17},
+        {"float", 0.1},
+        {"false", false}};
+    EXPECT_EQ(serializeInChunks(value, 1), referenceDump(value));
+}
+
+TEST(JsonChunkSerializer, InvalidUtf8IsReplaced)
+{
+    nlohmann::json value = {{"key", "\xff"}};
+    EXPECT_EQ(serializeInChunks(value, 3), referenceDump(value));
+}
+
+} // namespace
+} // namespace json_stream
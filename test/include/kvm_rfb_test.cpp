@@ -0,0 +1,307 @@
+#include "kvm_rfb.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace crow::obmc_kvm
+{
+namespace
+{
+
+void appendU32(std::string& out, uint32_t value)
+{
+    rfb::writeU16(out, static_cast<uint16_t>(value >> 16U));
+    rfb::writeU16(out, static_cast<uint16_t>(value & 0xFFFFU));
+}
+
+// Everything a KVM server sends before its first message, for a 32 bit
+// framebuffer
+std::string serverHandshake(uint16_t width, uint16_t height)
+{
+    std::string out(rfb::version38);
+    out += '\x01';
+    out += '\x01';
+    appendU32(out, 0);
+    rfb::writeU16(out, width);
+    rfb::writeU16(out, height);
+    out += '\x20';
+    out.append(15, '\0');
+    appendU32(out, 3);
+    out += "kvm";
+    return out;
+}
+
+std::string updateHeader(uint16_t rects)
+{
+    std::string out("\x00\x00", 2);
+    rfb::writeU16(out, rects);
+    return out;
+}
+
+std::string rectHeader(uint16_t width, uint16_t height, int32_t encoding)
+{
+    std::string out;
+    rfb::writeU16(out, 0);
+    rfb::writeU16(out, 0);
+    rfb::writeU16(out, width);
+    rfb::writeU16(out, height);
+    appendU32(out, static_cast<uint32_t>(encoding));
+    return out;
+}
+
+TEST(RfbServerStream, RecordsHandshakeBeforeMessages)
+{
+    RfbServerStream stream;
+    std::string handshake = serverHandshake(800, 600);
+    EXPECT_EQ(stream.feed(handshake.substr(0, 10)), "");
+    EXPECT_FALSE(stream.ready());
+
+    std::string bell("\x02", 1);
+    EXPECT_EQ(stream.feed(handshake.substr(10) + bell), bell);
+    EXPECT_TRUE(stream.ready());
+    EXPECT_EQ(stream.handshake(), handshake);
+    EXPECT_EQ(stream.frameWidth(), 800);
+    EXPECT_EQ(stream.frameHeight(), 600);
+}
+
+TEST(RfbServerStream, SplitsAtMessageBoundaries)
+{
+    RfbServerStream stream;
+    stream.feed(serverHandshake(16, 16));
+
+    std::string raw = updateHeader(1) + rectHeader(2, 2, rfb::encodingRaw) +
+                      std::string(2U * 2U * 4U, 'p');
+    std::string cutText("\x03\x00\x00\x00", 4);
+    appendU32(cutText, 2);
+    cutText += "hi";
+
+    std::string all = raw + cutText;
+    // Only whole messages come out, however the bytes arrive
+    EXPECT_EQ(stream.feed(all.substr(0, raw.size() - 1)), "");
+    EXPECT_EQ(stream.feed(all.substr(raw.size() - 1, 3)), raw);
+    EXPECT_EQ(stream.feed(all.substr(raw.size() + 2)), cutText);
+    EXPECT_TRUE(stream.shareable());
+}
+
+TEST(RfbServerStream, FollowsHextileTiles)
+{
+    RfbServerStream stream;
+    stream.feed(serverHandshake(32, 16));
+
+    // Two tiles: one with a background and two coloured subrects, one raw
+    std::string update = updateHeader(1) +
+                         rectHeader(20, 16, rfb::encodingHextile);
+    update += '\x1a';
+    update.append(4, 'b');
+    update += '\x02';
+    update.append(2U * (4U + 2U), 's');
+    update += '\x01';
+    update.append(4U * 16U * 4U, 'r');
+
+    EXPECT_EQ(stream.feed(update + '\x02'), update + '\x02');
+    EXPECT_TRUE(stream.shareable());
+}
+
+TEST(RfbServerStream, PatchesServerInitAfterResize)
+{
+    RfbServerStream stream;
+    stream.feed(serverHandshake(800, 600));
+
+    std::string resize = updateHeader(1) +
+                         rectHeader(1024, 768, rfb::encodingDesktopSize);
+    EXPECT_EQ(stream.feed(resize), resize);
+    EXPECT_EQ(stream.handshake(), serverHandshake(1024, 768));
+
+    std::string request = stream.fullUpdateRequest();
+    ASSERT_EQ(request.size(), 10U);
+    EXPECT_EQ(request[1], '\0');
+    EXPECT_EQ(rfb::readU16(request, 6), 1024);
+    EXPECT_EQ(rfb::readU16(request, 8), 768);
+}
+
+TEST(RfbServerStream, HoldsBackUpdatesThatCarryCompressionState)
+{
+    RfbServerStream stream;
+    stream.feed(serverHandshake(16, 16));
+
+    std::string zrle = updateHeader(1) +
+                       rectHeader(16, 16, rfb::encodingZRLE);
+    appendU32(zrle, 5);
+    zrle += "zzzzz";
+    std::string bell("\x02", 1);
+
+    std::string all = zrle + bell + zrle;
+    EXPECT_EQ(stream.feed(all.substr(0, 10)), "");
+    EXPECT_EQ(stream.feed(all.substr(10)), bell);
+    EXPECT_TRUE(stream.shareable());
+    EXPECT_TRUE(stream.ready());
+}
+
+TEST(RfbServerStream, MeasuresTightRectangles)
+{
+    RfbServerStream stream;
+    stream.feed(serverHandshake(16, 16));
+
+    std::string tight = updateHeader(3);
+    // Fill
+    tight += rectHeader(16, 16, rfb::encodingTight);
+    tight += '\x80';
+    tight.append(4, 'f');
+    // Two colour palette, small enough to be sent uncompressed
+    tight += rectHeader(16, 2, rfb::encodingTight);
+    tight += "\x40\x01\x01";
+    tight.append(2U * 4U, 'c');
+    tight.append(2U * 2U, 'i');
+    // JPEG, with a two byte compact length
+    tight += rectHeader(16, 16, rfb::encodingTight);
+    tight += "\x90\xc8\x01";
+    tight.append(200, 'j');
+
+    std::string raw = updateHeader(1) + rectHeader(1, 1, rfb::encodingRaw) +
+                      std::string(4, 'p');
+    std::string all = tight + raw;
+    for (size_t split = 0; split < all.size(); split += 7)
+    {
+        stream.feed(std::string_view(all).substr(split, 7));
+    }
+    EXPECT_TRUE(stream.shareable());
+    EXPECT_EQ(stream.feed(raw), raw);
+}
+
+TEST(RfbServerStream, FollowsPseudoEncodings)
+{
+    RfbServerStream stream;
+    stream.feed(serverHandshake(16, 16));
+
+    // An update ended by LastRect, with a cursor shape in it
+    std::string update = updateHeader(0xFFFF);
+    update += rectHeader(9, 2, rfb::encodingCursor);
+    update.append(9U * 2U * 4U + 2U * 2U, 'c');
+    update += rectHeader(0, 0, rfb::encodingLastRect);
+    update += '\x02';
+
+    EXPECT_EQ(stream.feed(update), update);
+    EXPECT_TRUE(stream.shareable());
+}
+
+TEST(RfbServerStream, GivesUpOnUnknownEncoding)
+{
+    RfbServerStream stream;
+    stream.feed(serverHandshake(16, 16));
+
+    // ZlibHex
+    EXPECT_EQ(stream.feed(updateHeader(1) + rectHeader(16, 16, 8)), "");
+    EXPECT_FALSE(stream.shareable());
+    EXPECT_FALSE(stream.ready());
+}
+
+TEST(RfbServerStream, GivesUpOnOtherVersions)
+{
+    RfbServerStream stream;
+    EXPECT_EQ(stream.feed("RFB 003.003\n"), "");
+    EXPECT_FALSE(stream.shareable());
+}
+
+TEST(RfbClientFilter, KeepsOnlyShareableEncodings)
+{
+    RfbServerStream stream;
+    stream.feed(serverHandshake(16, 16));
+    RfbClientFilter filter(stream);
+    EXPECT_EQ(filter.setShared(true), "");
+
+    std::string handshake(rfb::version38);
+    handshake += "\x01\x01";
+    EXPECT_EQ(filter.filter(handshake), handshake);
+
+    std::string setEncodings("\x02\x00", 2);
+    rfb::writeU16(setEncodings, 3);
+    appendU32(setEncodings, 7);
+    appendU32(setEncodings, rfb::encodingHextile);
+    appendU32(setEncodings, static_cast<uint32_t>(rfb::encodingDesktopSize));
+
+    std::string expected("\x02\x00", 2);
+    rfb::writeU16(expected, 2);
+    appendU32(expected, rfb::encodingHextile);
+    appendU32(expected, static_cast<uint32_t>(rfb::encodingDesktopSize));
+
+    // A message split across websocket frames is held until it's whole
+    EXPECT_EQ(filter.filter(setEncodings.substr(0, 5)), "");
+    EXPECT_EQ(filter.filter(setEncodings.substr(5)), expected);
+
+    std::string key("\x04\x01\x00\x00\x00\x00\x00\x61", 8);
+    EXPECT_EQ(filter.filter(key), key);
+    EXPECT_TRUE(stream.shareable());
+}
+
+TEST(RfbClientFilter, RestrictsEncodingsOnlyWhileShared)
+{
+    RfbServerStream stream;
+    stream.feed(serverHandshake(16, 16));
+    RfbClientFilter filter(stream);
+    filter.filter(std::string(rfb::version38) + "\x01\x01");
+
+    std::string setEncodings("\x02\x00", 2);
+    rfb::writeU16(setEncodings, 2);
+    appendU32(setEncodings, rfb::encodingTight);
+    appendU32(setEncodings, rfb::encodingHextile);
+
+    std::string restricted("\x02\x00", 2);
+    rfb::writeU16(restricted, 1);
+    appendU32(restricted, rfb::encodingHextile);
+
+    // The owner alone keeps its own encodings
+    EXPECT_EQ(filter.filter(setEncodings), setEncodings);
+    EXPECT_EQ(filter.setShared(true), restricted);
+    EXPECT_EQ(filter.setShared(true), "");
+    EXPECT_EQ(filter.filter(setEncodings), restricted);
+    EXPECT_EQ(filter.setShared(false), setEncodings);
+    EXPECT_EQ(filter.setShared(false), "");
+    EXPECT_EQ(filter.filter(setEncodings), setEncodings);
+}
+
+TEST(RfbClientFilter, TakesPixelFormatBeforeFirstUpdate)
+{
+    RfbServerStream stream;
+    stream.feed(serverHandshake(2, 1));
+    RfbClientFilter filter(stream);
+    filter.filter(std::string(rfb::version38) + "\x01\x01");
+
+    std::string setPixelFormat(20, '\0');
+    setPixelFormat[4] = '\x10';
+    filter.filter(setPixelFormat);
+
+    std::string raw = updateHeader(1) + rectHeader(2, 1, rfb::encodingRaw) +
+                      std::string(2U * 2U, 'p');
+    EXPECT_EQ(stream.feed(raw), raw);
+
+    filter.filter(stream.fullUpdateRequest());
+    filter.filter(setPixelFormat);
+    EXPECT_FALSE(stream.shareable());
+}
+
+TEST(RfbClientFilter, PassesEverythingOnceUnshareable)
+{
+    RfbServerStream stream;
+    stream.feed(serverHandshake(16, 16));
+    RfbClientFilter filter(stream);
+    filter.filter(std::string(rfb::version38) + "\x01\x01");
+
+    std::string unknown("\xfa\x01\x02", 3);
+    EXPECT_EQ(filter.filter(unknown), unknown);
+    EXPECT_FALSE(stream.shareable());
+    std::string partial("\x02\x00", 2);
+    EXPECT_EQ(filter.filter(partial), partial);
+    // Nothing can be put between messages that can't be followed
+    EXPECT_EQ(filter.setShared(true), "");
+}
+
+} // namespace
+} // namespace crow::obmc_kvm
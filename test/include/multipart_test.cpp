@@ -6,6 +6,7 @@
 #include <boost/beast/http/string_body.hpp>
 
 #include <memory>
+#include <string>
 #include <string_view>
 #include <system_error>
 #include <vector>
@@ -427,4 +428,59 @@ TEST_F(MultipartTest, TestFinalBoundaryIsCorrectlyRecognized)
                                              "StillData1");
 }
 
+TEST_F(MultipartTest, TestParsesBodyInAnySizedPieces)
+{
+    const std::string body =
+        "----XX\r\n"
+        "Content-Disposition: form-data; name=\"Test1\"\r\n\r\n"
+        "Data1\r\n----XX-abc-\r\n"
+        "----XX\r\n"
+        "Content-Disposition: form-data; name=\"File\"\r\n\r\n"
+        "StillData1\r\n----X\r\n"
+        "----XX--\r\n";
+
+    for (size_t step = 1; step <= body.size(); step++)
+    {
+        MultipartParser chunked;
+        std::string sunk;
+        chunked.onPartHeaders = [&sunk](FormPart& part) {
+            if (part.fields.at("Content-Disposition").ends_with("\"File\""))
+            {
+                part.sink = [&sunk](std::string_view data) {
+                    sunk += data;
+                    return true;
+                };
+            }
+        };
+        ASSERT_EQ(chunked.start("multipart/form-data; boundary=--XX"),
+                  ParserError::PARSER_SUCCESS);
+        for (size_t i = 0; i < body.size(); i += step)
+        {
+            ASSERT_EQ(chunked.feed(std::string_view(body).substr(i, step)),
+                      ParserError::PARSER_SUCCESS);
+        }
+        ASSERT_EQ(chunked.finish(), ParserError::PARSER_SUCCESS);
+
+        ASSERT_EQ(chunked.mime_fields.size(), 2);
+        EXPECT_EQ(chunked.mime_fields[1].fields.at("Content-Disposition"),
+                  "form-data; name=\"File\"");
+        EXPECT_EQ(chunked.mime_fields[0].content, "Data1\r\n----XX-abc-");
+        EXPECT_EQ(chunked.mime_fields[1].content, "");
+        EXPECT_EQ(sunk, "StillData1\r\n----X");
+    }
+}
+
+TEST_F(MultipartTest, TestBufferedPartSizeIsLimited)
+{
+    parser.maxBufferedPartSize = 4;
+    ASSERT_EQ(parser.start("multipart/form-data; boundary=--XX"),
+              ParserError::PARSER_SUCCESS);
+    EXPECT_EQ(parser.feed("----XX\r\n"
+                          "Content-Disposition: form-data; name=\"A\"\r\n\r\n"
+                          "Data1\r\n"
+                          "----XX--\r\n"),
+              ParserError::ERROR_PART_TOO_LARGE);
+    EXPECT_EQ(parser.finish(), ParserError::ERROR_PART_TOO_LARGE);
+}
+
 } // namespace
@@ -0,0 +1,63 @@
+#include "dbus_utility.hpp"
+#include "nbd_proxy.hpp"
+
+#include <string>
+#include <utility>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace crow::nbd_proxy
+{
+namespace
+{
+
+void addMountPoint(dbus::utility::ManagedObjectType& objects,
+                   const std::string& path,
+                   dbus::utility::DBusPropertiesMap properties)
+{
+    dbus::utility::DBusInteracesMap interfaces;
+    interfaces.emplace_back("xyz.openbmc_project.VirtualMedia.MountPoint",
+                            std::move(properties));
+    objects.emplace_back(sdbusplus::message::object_path(path),
+                         std::move(interfaces));
+}
+
+TEST(ParseMountPoints, IndexesSlotsByEndpointId)
+{
+    dbus::utility::ManagedObjectType objects;
+    addMountPoint(objects, "/xyz/openbmc_project/VirtualMedia/Proxy/Slot_0",
+                  {{"EndpointId", std::string("/nbd/0")},
+                   {"Socket", std::string("/run/virtual-media/nbd0.sock")}});
+    addMountPoint(objects, "/xyz/openbmc_project/VirtualMedia/Proxy/Slot_1",
+                  {{"EndpointId", std::string("/nbd/1")},
+                   {"Socket", std::string("/run/virtual-media/nbd1.sock")}});
+    // Not a mount point yet
+    addMountPoint(objects, "/xyz/openbmc_project/VirtualMedia/Proxy/Slot_2",
+                  {{"EndpointId", std::string("/nbd/2")}});
+
+    auto slots = parseMountPoints(objects);
+    ASSERT_EQ(slots.size(), 2U);
+    EXPECT_EQ(slots["/nbd/1"].socket, "/run/virtual-media/nbd1.sock");
+    EXPECT_EQ(slots["/nbd/1"].objectPath,
+              "/xyz/openbmc_project/VirtualMedia/Proxy/Slot_1");
+    EXPECT_EQ(slots["/nbd/0"].socket, "/run/virtual-media/nbd0.sock");
+}
+
+TEST(ParseMountPoints, RejectsWrongPropertyTypes)
+{
+    dbus::utility::ManagedObjectType objects;
+    addMountPoint(objects, "/xyz/openbmc_project/VirtualMedia/Proxy/Slot_0",
+                  {{"EndpointId", std::string("/nbd/0")},
+                   {"Socket", std::string("/run/virtual-media/nbd0.sock")}});
+    addMountPoint(objects, "/xyz/openbmc_project/VirtualMedia/Proxy/Slot_1",
+                  {{"EndpointId", 1}});
+
+    EXPECT_TRUE(parseMountPoints(objects).empty());
+}
+
+} // namespace
+} // namespace crow::nbd_proxy
@@ -0,0 +1,53 @@
+#include "persistent_data.hpp"
+
+#include <sys/stat.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace persistent_data
+{
+namespace
+{
+
+std::string readFile(const std::filesystem::path& path)
+{
+    std::ifstream file(path);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+}
+
+TEST(WriteFileAtomically, ReplacesContentsWithOwnerGroupReadable)
+{
+    std::filesystem::path path = std::filesystem::temp_directory_path() /
+                                 "bmcweb_write_atomically_test.json";
+    ASSERT_TRUE(writeFileAtomically(path.string(), "first version"));
+    ASSERT_TRUE(writeFileAtomically(path.string(), "second"));
+
+    EXPECT_EQ(readFile(path), "second");
+    EXPECT_FALSE(std::filesystem::exists(path.string() + ".tmp"));
+
+    struct stat info
+    {};
+    ASSERT_EQ(stat(path.c_str(), &info), 0);
+    EXPECT_EQ(info.st_mode & 0777, 0640U);
+    std::filesystem::remove(path);
+}
+
+TEST(WriteFileAtomically, FailsWithoutTouchingTarget)
+{
+    EXPECT_FALSE(
+        writeFileAtomically("/nonexistent-directory/bmcweb.json", "data"));
+}
+
+} // namespace
+} // namespace persistent_data
@@ -0,0 +1,69 @@
+#include "random.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h> // IWYU pragma: keep
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+// IWYU pragma: no_include <gmock/gmock-matchers.h>
+
+namespace bmcweb
+{
+namespace
+{
+
+using ::testing::MatchesRegex;
+
+// Hands out a fixed sequence of bytes
+struct FixedGenerator
+{
+    uint8_t operator()()
+    {
+        return bytes[next++ % bytes.size()];
+    }
+
+    bool error() const
+    {
+        return false;
+    }
+
+    std::vector<uint8_t> bytes;
+    size_t next = 0;
+};
+
+TEST(FillAlphanumeric, MapsBytesOntoTheAlphabet)
+{
+    FixedGenerator gen{{0, 9, 10, 36, 61, 62, 247}};
+    std::string out(7, ' ');
+    fillAlphanumeric(gen, out);
+    EXPECT_EQ(out, "09Aaz0z");
+}
+
+TEST(FillAlphanumeric, DrawsAgainForBiasedBytes)
+{
+    // 248 and up would favour the first eight characters
+    FixedGenerator gen{{248, 255, 1}};
+    std::string out(1, ' ');
+    fillAlphanumeric(gen, out);
+    EXPECT_EQ(out, "1");
+    EXPECT_EQ(gen.next, 3);
+}
+
+TEST(FillAlphanumeric, OpenSSLTokensAreAlphanumeric)
+{
+    OpenSSLGenerator gen;
+    // Longer than one batch of random bytes
+    std::string out(300, ' ');
+    fillAlphanumeric(gen, out);
+    ASSERT_FALSE(gen.error());
+    EXPECT_THAT(out, MatchesRegex("[0-9A-Za-z]{300}"));
+}
+
+} // namespace
+} // namespace bmcweb
@@ -0,0 +1,37 @@
+#include "http_request.hpp"
+#include "http_response.hpp"
+#include "security_headers.hpp"
+
+#include <boost/beast/http/field.hpp>
+#include <boost/beast/http/verb.hpp>
+
+#include <string_view>
+#include <system_error>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace
+{
+
+TEST(AddSecurityHeaders, AddsEachHeaderOnce)
+{
+    std::error_code ec;
+    crow::Request req{{boost::beast::http::verb::get, "/redfish/v1", 11}, ec};
+    crow::Response res;
+    res.addHeader(boost::beast::http::field::cache_control, "max-age=10");
+
+    addSecurityHeaders(req, res);
+
+    EXPECT_EQ(res.getHeaderValue("X-Frame-Options"), "DENY");
+    EXPECT_EQ(res.getHeaderValue("X-Content-Type-Options"), "nosniff");
+    EXPECT_EQ(res.getHeaderValue("Cache-Control"), "no-store, max-age=0");
+    EXPECT_EQ(res.stringResponse->count("Cache-Control"), 1);
+    EXPECT_EQ(res.stringResponse->count("Content-Security-Policy"), 1);
+    EXPECT_EQ(res.stringResponse->count("Permissions-Policy"), 1);
+}
+
+} // namespace
@@ -0,0 +1,91 @@
+#include "sessions.hpp"
+
+#include <boost/asio/ip/address.hpp>
+
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace persistent_data
+{
+namespace
+{
+
+class SessionStoreTest : public ::testing::Test
+{
+  public:
+    SessionStore& store = SessionStore::getInstance();
+
+    std::shared_ptr<UserSession> login(const std::string& username)
+    {
+        return store.generateUserSession(
+            username, boost::asio::ip::make_address("127.0.0.1"),
+            std::nullopt);
+    }
+
+    ~SessionStoreTest() override
+    {
+        store.updateSessionTimeout(std::chrono::seconds(1800));
+        store.removeSessionsByUsername("alice");
+        store.removeSessionsByUsername("bob");
+        store.applySessionTimeouts();
+    }
+};
+
+TEST_F(SessionStoreTest, LookupByTokenAndUid)
+{
+    std::shared_ptr<UserSession> alice = login("alice");
+    std::shared_ptr<UserSession> bob = login("bob");
+    ASSERT_NE(alice, nullptr);
+    ASSERT_NE(bob, nullptr);
+
+    EXPECT_EQ(store.loginSessionByToken(alice->sessionToken), alice);
+    EXPECT_EQ(store.getSessionByUid(bob->uniqueId), bob);
+    EXPECT_EQ(store.getSessionByUid("nonexistent"), nullptr);
+
+    store.removeSession(alice);
+    EXPECT_EQ(store.loginSessionByToken(alice->sessionToken), nullptr);
+    EXPECT_EQ(store.getSessionByUid(alice->uniqueId), nullptr);
+    EXPECT_EQ(store.getSessionByUid(bob->uniqueId), bob);
+}
+
+TEST_F(SessionStoreTest, RemoveByUsernameUpdatesUidIndex)
+{
+    std::shared_ptr<UserSession> alice1 = login("alice");
+    std::shared_ptr<UserSession> alice2 = login("alice");
+    std::shared_ptr<UserSession> bob = login("bob");
+
+    store.removeSessionsByUsernameExceptSession("alice", alice2);
+    EXPECT_EQ(store.getSessionByUid(alice1->uniqueId), nullptr);
+    EXPECT_EQ(store.getSessionByUid(alice2->uniqueId), alice2);
+
+    store.removeSessionsByUsername("alice");
+    EXPECT_EQ(store.getSessionByUid(alice2->uniqueId), nullptr);
+    EXPECT_EQ(store.getSessionByUid(bob->uniqueId), bob);
+}
+
+TEST_F(SessionStoreTest, IdleSessionsExpire)
+{
+    std::shared_ptr<UserSession> alice = login("alice");
+    std::shared_ptr<UserSession> bob = login("bob");
+
+    // Lookups check the session itself, even if no sweep has run
+    store.updateSessionTimeout(std::chrono::seconds(0));
+    EXPECT_EQ(store.loginSessionByToken(alice->sessionToken), nullptr);
+    EXPECT_EQ(store.getSessionByUid(alice->uniqueId), nullptr);
+
+    // The sweep removes the rest without anyone looking them up
+    store.applySessionTimeouts();
+    EXPECT_TRUE(store.authTokens.empty());
+    EXPECT_TRUE(store.sessionsByUid.empty());
+}
+
+} // namespace
+} // namespace persistent_data
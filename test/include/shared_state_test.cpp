@@ -0,0 +1,82 @@
+#include "shared_state.hpp"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace bmcweb
+{
+namespace
+{
+
+TEST(SharedSnapshot, StartsWithInitialValue)
+{
+    SharedSnapshot<std::string> empty;
+    EXPECT_EQ(*empty.load(), "");
+
+    SharedSnapshot<std::string> value(std::string("first"));
+    EXPECT_EQ(*value.load(), "first");
+}
+
+TEST(SharedSnapshot, HeldSnapshotDoesntChange)
+{
+    SharedSnapshot<std::string> value(std::string("first"));
+    std::shared_ptr<const std::string> held = value.load();
+
+    value.store("second");
+    EXPECT_EQ(*held, "first");
+    EXPECT_EQ(*value.load(), "second");
+
+    value.update([](std::string& current) { current += " and third"; });
+    EXPECT_EQ(*held, "first");
+    EXPECT_EQ(*value.load(), "second and third");
+}
+
+TEST(SharedSnapshot, ConcurrentUpdatesAreAllApplied)
+{
+    SharedSnapshot<std::vector<int>> value;
+    std::atomic<bool> done = false;
+
+    // Every snapshot a reader sees is one some writer published whole
+    std::thread reader([&value, &done]() {
+        while (!done)
+        {
+            std::shared_ptr<const std::vector<int>> snapshot = value.load();
+            for (size_t i = 0; i < snapshot->size(); i++)
+            {
+                ASSERT_EQ((*snapshot)[i], 1);
+            }
+        }
+    });
+
+    std::vector<std::thread> writers;
+    for (int i = 0; i < 4; i++)
+    {
+        writers.emplace_back([&value]() {
+            for (int j = 0; j < 250; j++)
+            {
+                value.update(
+                    [](std::vector<int>& current) { current.push_back(1); });
+            }
+        });
+    }
+    for (std::thread& writer : writers)
+    {
+        writer.join();
+    }
+    done = true;
+    reader.join();
+
+    EXPECT_EQ(value.load()->size(), 1000U);
+}
+
+} // namespace
+} // namespace bmcweb
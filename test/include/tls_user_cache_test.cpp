@@ -0,0 +1,61 @@
+#include "tls_user_cache.hpp"
+
+#include <chrono>
+#include <string>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace crow
+{
+namespace authentication
+{
+namespace
+{
+
+TEST(TlsUserCache, RemembersUntilTimeout)
+{
+    TlsUserCache cache(std::chrono::seconds(10));
+    TlsUserCache::Clock::time_point now = TlsUserCache::Clock::now();
+
+    EXPECT_EQ(cache.lookup("fingerprint", now), std::nullopt);
+    cache.insert("fingerprint", "user", now);
+    EXPECT_EQ(cache.lookup("fingerprint", now + std::chrono::seconds(9)),
+              "user");
+    EXPECT_EQ(cache.lookup("fingerprint", now + std::chrono::seconds(10)),
+              std::nullopt);
+    EXPECT_EQ(cache.size(), 0);
+}
+
+TEST(TlsUserCache, RemembersUnusableCertificates)
+{
+    TlsUserCache cache(std::chrono::seconds(10));
+    TlsUserCache::Clock::time_point now = TlsUserCache::Clock::now();
+
+    cache.insert("fingerprint", "", now);
+    EXPECT_EQ(cache.lookup("fingerprint", now), "");
+}
+
+TEST(TlsUserCache, EvictsOldestWhenFull)
+{
+    TlsUserCache cache(std::chrono::seconds(100));
+    TlsUserCache::Clock::time_point now = TlsUserCache::Clock::now();
+
+    for (std::size_t i = 0; i < tlsUserCacheMaxEntries; i++)
+    {
+        cache.insert(std::to_string(i), "user",
+                     now + std::chrono::seconds(static_cast<int>(i)));
+    }
+    cache.insert("new", "user", now + std::chrono::seconds(90));
+    EXPECT_EQ(cache.size(), tlsUserCacheMaxEntries);
+    EXPECT_EQ(cache.lookup("0", now + std::chrono::seconds(90)),
+              std::nullopt);
+    EXPECT_EQ(cache.lookup("new", now + std::chrono::seconds(90)), "user");
+}
+
+} // namespace
+} // namespace authentication
+} // namespace crow
@@ -0,0 +1,21 @@
+#include "webassets.hpp"
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+namespace crow::webassets
+{
+namespace
+{
+
+TEST(IsHashedFilename, DetectsContentHash)
+{
+    EXPECT_TRUE(isHashedFilename("app.1a2b3c4d.js"));
+    EXPECT_TRUE(isHashedFilename("chunk-vendors.0123abcd.css.gz"));
+    EXPECT_FALSE(isHashedFilename("index.html"));
+    EXPECT_FALSE(isHashedFilename("favicon.ico"));
+    EXPECT_FALSE(isHashedFilename("app.1a2b3c.js"));
+    EXPECT_FALSE(isHashedFilename("noextension"));
+}
+
+} // namespace
+} // namespace crow::webassets
@@ -0,0 +1,217 @@
+#include "event_log_index.hpp"
+
+#include <unistd.h>
+
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace redfish::event_log
+{
+namespace
+{
+
+class EventLogIndexTest : public ::testing::Test
+{
+  protected:
+    EventLogIndexTest() :
+        dir(std::filesystem::temp_directory_path() /
+            ("event_log_index_test_" + std::to_string(getpid())))
+    {
+        std::filesystem::remove_all(dir);
+        std::filesystem::create_directories(dir);
+    }
+
+    ~EventLogIndexTest() override
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(dir, ec);
+    }
+
+    EventLogIndexTest(const EventLogIndexTest&) = delete;
+    EventLogIndexTest(EventLogIndexTest&&) = delete;
+    EventLogIndexTest& operator=(const EventLogIndexTest&) = delete;
+    EventLogIndexTest& operator=(EventLogIndexTest&&) = delete;
+
+    void append(const std::string& name, std::string_view text) const
+    {
+        std::ofstream out(dir / name, std::ios::app);
+        out << text;
+    }
+
+    static std::vector<std::pair<std::string, std::string>>
+        page(const EventLogIndex& index, size_t skip, size_t top)
+    {
+        std::vector<std::pair<std::string, std::string>> out;
+        index.forEachEntry(skip, top,
+                           [&out](const std::string& id,
+                                  const std::string& line) {
+            out.emplace_back(id, line);
+            return true;
+        });
+        return out;
+    }
+
+    std::filesystem::path dir;
+};
+
+TEST(GetMessageId, ReturnsIdBeforeArgs)
+{
+    EXPECT_EQ(getMessageId("2023-01-01T00:00:00+00:00 OpenBMC.0.1.Foo,a,b"),
+              "OpenBMC.0.1.Foo");
+    EXPECT_EQ(getMessageId("2023-01-01T00:00:00+00:00  OpenBMC.0.1.Foo"),
+              "OpenBMC.0.1.Foo");
+    EXPECT_EQ(getMessageId("2023-01-01T00:00:00+00:00"), "");
+}
+
+TEST(ParseEventLogLine, SplitsFields)
+{
+    EventLogLine line;
+    ASSERT_TRUE(parseEventLogLine(
+        "2023-01-01T00:00:00+00:00 OpenBMC.0.1.Foo,a,,b", line));
+    EXPECT_EQ(line.timestamp, "2023-01-01T00:00:00+00:00");
+    EXPECT_EQ(line.messageId, "OpenBMC.0.1.Foo");
+    EXPECT_EQ(line.messageArgs, (std::vector<std::string_view>{"a", "b"}));
+
+    // An empty first argument means there are none
+    ASSERT_TRUE(
+        parseEventLogLine("2023-01-01T00:00:00+00:00 OpenBMC.0.1.Foo,", line));
+    EXPECT_TRUE(line.messageArgs.empty());
+
+    EXPECT_FALSE(parseEventLogLine("2023-01-01T00:00:00+00:00", line));
+}
+
+TEST(ParseLogTimestamp, ReadsLeadingTimestamp)
+{
+    std::tm expected = {};
+    expected.tm_year = 2023 - 1900;
+    expected.tm_mon = 5;
+    expected.tm_mday = 7;
+    expected.tm_hour = 8;
+    expected.tm_min = 9;
+    expected.tm_sec = 10;
+    std::time_t timestamp = 0;
+    ASSERT_TRUE(parseLogTimestamp("2023-06-07T08:09:10+00:00 A", timestamp));
+    EXPECT_EQ(timestamp, std::mktime(&expected));
+
+    timestamp = 0;
+    EXPECT_FALSE(parseLogTimestamp("2023-13-07T08:09:10 A", timestamp));
+    EXPECT_FALSE(parseLogTimestamp("garbage", timestamp));
+    EXPECT_EQ(timestamp, 0);
+}
+
+TEST(EntryIdGenerator, SuffixesDuplicateTimestamps)
+{
+    EntryIdGenerator ids;
+    std::string first = ids.next("2023-01-01T00:00:00+00:00 A");
+    EXPECT_EQ(ids.next("2023-01-01T00:00:00+00:00 B"), first + "_1");
+    EXPECT_EQ(ids.next("2023-01-01T00:00:00+00:00 C"), first + "_2");
+    EXPECT_NE(ids.next("2023-01-01T00:00:01+00:00 D"), first);
+}
+
+TEST_F(EventLogIndexTest, IndexesOldestFileFirst)
+{
+    append("redfish.1", "2023-01-01T00:00:00+00:00 Old.0.1.A\n");
+    append("redfish", "2023-01-02T00:00:00+00:00 New.0.1.B\n");
+
+    EventLogIndex index(dir, "redfish");
+    index.refresh();
+    ASSERT_EQ(index.size(), 2U);
+
+    auto entries = page(index, 0, 10);
+    ASSERT_EQ(entries.size(), 2U);
+    EXPECT_EQ(entries[0].second, "2023-01-01T00:00:00+00:00 Old.0.1.A");
+    EXPECT_EQ(entries[1].second, "2023-01-02T00:00:00+00:00 New.0.1.B");
+
+    std::string line;
+    ASSERT_TRUE(index.readEntry(entries[1].first, line));
+    EXPECT_EQ(line, entries[1].second);
+    EXPECT_FALSE(index.readEntry("0", line));
+}
+
+TEST_F(EventLogIndexTest, PagesWithSkipAndTop)
+{
+    append("redfish", "2023-01-01T00:00:00+00:00 A.0.1.A\n"
+                      "2023-01-01T00:00:01+00:00 A.0.1.B\n"
+                      "2023-01-01T00:00:02+00:00 A.0.1.C\n");
+    EventLogIndex index(dir, "redfish");
+    index.refresh();
+
+    auto entries = page(index, 1, 1);
+    ASSERT_EQ(entries.size(), 1U);
+    EXPECT_EQ(entries[0].second, "2023-01-01T00:00:01+00:00 A.0.1.B");
+    EXPECT_TRUE(page(index, 3, 1).empty());
+}
+
+TEST_F(EventLogIndexTest, ParsesOnlyAppendedCompleteLines)
+{
+    append("redfish", "2023-01-01T00:00:00+00:00 A.0.1.A\n"
+                      "2023-01-01T00:00:01+00:00 A.0.1.B");
+    EventLogIndex index(dir, "redfish");
+    index.refresh();
+    // The second line has no newline yet, so it's still being written
+    EXPECT_EQ(index.size(), 1U);
+
+    append("redfish", "\n2023-01-01T00:00:01+00:00 A.0.1.C\n");
+    index.refresh();
+    auto entries = page(index, 0, 10);
+    ASSERT_EQ(entries.size(), 3U);
+    EXPECT_EQ(entries[1].second, "2023-01-01T00:00:01+00:00 A.0.1.B");
+    // Same timestamp as the entry before it
+    EXPECT_EQ(entries[2].first, entries[1].first + "_1");
+}
+
+TEST_F(EventLogIndexTest, FollowsRotationAndTruncation)
+{
+    append("redfish", "2023-01-01T00:00:00+00:00 A.0.1.A\n");
+    EventLogIndex index(dir, "redfish");
+    index.refresh();
+
+    std::filesystem::rename(dir / "redfish", dir / "redfish.1");
+    append("redfish", "2023-01-02T00:00:00+00:00 A.0.1.B\n");
+    index.refresh();
+    auto entries = page(index, 0, 10);
+    ASSERT_EQ(entries.size(), 2U);
+    EXPECT_EQ(entries[0].second, "2023-01-01T00:00:00+00:00 A.0.1.A");
+    EXPECT_EQ(entries[1].second, "2023-01-02T00:00:00+00:00 A.0.1.B");
+
+    std::filesystem::remove(dir / "redfish.1");
+    std::filesystem::resize_file(dir / "redfish", 0);
+    append("redfish", "2023-01-03T00:00:00+00:00 A.0.1.C\n");
+    index.refresh();
+    entries = page(index, 0, 10);
+    ASSERT_EQ(entries.size(), 1U);
+    EXPECT_EQ(entries[0].second, "2023-01-03T00:00:00+00:00 A.0.1.C");
+}
+
+TEST_F(EventLogIndexTest, FilteredEntriesAreFoundButNotListed)
+{
+    append("redfish", "2023-01-01T00:00:00+00:00 Known.0.1.A\n"
+                      "2023-01-01T00:00:01+00:00 Unknown.0.1.B\n");
+    EventLogIndex index(dir, "redfish");
+    index.setFilter(
+        [](std::string_view messageId) { return messageId.starts_with("K"); });
+    index.refresh();
+    EXPECT_EQ(index.size(), 1U);
+
+    EntryIdGenerator ids;
+    ids.next("2023-01-01T00:00:00+00:00 Known.0.1.A");
+    std::string line;
+    ASSERT_TRUE(
+        index.readEntry(ids.next("2023-01-01T00:00:01+00:00 Unknown.0.1.B"),
+                        line));
+    EXPECT_EQ(line, "2023-01-01T00:00:01+00:00 Unknown.0.1.B");
+}
+
+} // namespace
+} // namespace redfish::event_log
@@ -0,0 +1,127 @@
+#include "event_log_tailer.hpp"
+
+#include <unistd.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace redfish::event_log
+{
+namespace
+{
+
+class EventLogTailerTest : public ::testing::Test
+{
+  protected:
+    EventLogTailerTest() :
+        dir(std::filesystem::temp_directory_path() /
+            ("event_log_tailer_test_" + std::to_string(getpid()))),
+        path(dir / "redfish")
+    {
+        std::filesystem::remove_all(dir);
+        std::filesystem::create_directories(dir);
+    }
+
+    ~EventLogTailerTest() override
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(dir, ec);
+    }
+
+    EventLogTailerTest(const EventLogTailerTest&) = delete;
+    EventLogTailerTest(EventLogTailerTest&&) = delete;
+    EventLogTailerTest& operator=(const EventLogTailerTest&) = delete;
+    EventLogTailerTest& operator=(EventLogTailerTest&&) = delete;
+
+    void append(std::string_view text) const
+    {
+        std::ofstream out(path, std::ios::app);
+        out << text;
+    }
+
+    static std::vector<std::string> read(EventLogTailer& tailer)
+    {
+        std::vector<std::string> lines;
+        tailer.read([&lines](std::string_view logEntry,
+                             const std::string& /*id*/) {
+            lines.emplace_back(logEntry);
+        });
+        return lines;
+    }
+
+    std::filesystem::path dir;
+    std::filesystem::path path;
+};
+
+TEST_F(EventLogTailerTest, HandsOverOnlyAppendedLines)
+{
+    append("2023-01-01T00:00:00+00:00 A.0.1.A\n");
+    EventLogTailer tailer(path.string());
+    tailer.skipExisting();
+    EXPECT_TRUE(read(tailer).empty());
+
+    append("2023-01-01T00:00:01+00:00 A.0.1.B\n2023-01-01T00:00:02");
+    EXPECT_EQ(read(tailer),
+              std::vector<std::string>{"2023-01-01T00:00:01+00:00 A.0.1.B"});
+
+    // The partial line is finished by the next write
+    append("+00:00 A.0.1.C\n");
+    EXPECT_EQ(read(tailer),
+              std::vector<std::string>{"2023-01-01T00:00:02+00:00 A.0.1.C"});
+}
+
+TEST_F(EventLogTailerTest, FollowsRotation)
+{
+    append("2023-01-01T00:00:00+00:00 A.0.1.A\n");
+    EventLogTailer tailer(path.string());
+    tailer.skipExisting();
+
+    append("2023-01-01T00:00:01+00:00 A.0.1.B\n");
+    std::filesystem::rename(path, dir / "redfish.1");
+    append("2023-01-01T00:00:02+00:00 A.0.1.C\n");
+    EXPECT_EQ(read(tailer), (std::vector<std::string>{
+                                "2023-01-01T00:00:01+00:00 A.0.1.B",
+                                "2023-01-01T00:00:02+00:00 A.0.1.C"}));
+}
+
+TEST_F(EventLogTailerTest, RereadsTruncatedFile)
+{
+    append("2023-01-01T00:00:00+00:00 A.0.1.A\n"
+           "2023-01-01T00:00:01+00:00 A.0.1.B\n");
+    EventLogTailer tailer(path.string());
+    tailer.skipExisting();
+
+    std::filesystem::resize_file(path, 0);
+    append("2023-01-01T00:00:02+00:00 A.0.1.C\n");
+    EXPECT_EQ(read(tailer),
+              std::vector<std::string>{"2023-01-01T00:00:02+00:00 A.0.1.C"});
+}
+
+TEST_F(EventLogTailerTest, GivesIndexEntryIds)
+{
+    append("2023-01-01T00:00:00+00:00 A.0.1.A\n");
+    EventLogTailer tailer(path.string());
+    tailer.skipExisting();
+    append("2023-01-01T00:00:00+00:00 A.0.1.B\n");
+
+    std::vector<std::string> ids;
+    tailer.read([&ids](std::string_view /*logEntry*/, const std::string& id) {
+        ids.push_back(id);
+    });
+    EntryIdGenerator expected;
+    expected.next("2023-01-01T00:00:00+00:00 A.0.1.A");
+    EXPECT_EQ(ids, std::vector<std::string>{
+                       expected.next("2023-01-01T00:00:00+00:00 A.0.1.B")});
+}
+
+} // namespace
+} // namespace redfish::event_log
@@ -0,0 +1,88 @@
+#include "event_payload.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace redfish
+{
+namespace
+{
+
+std::string prettyEvent(const std::string& id, nlohmann::json events)
+{
+    nlohmann::json msg;
+    msg["@odata.type"] = "#Event.v1_4_0.Event";
+    msg["Id"] = id;
+    msg["Name"] = "Event Log";
+    msg["Events"] = std::move(events);
+    return msg.dump(2, ' ', true, nlohmann::json::error_handler_t::replace);
+}
+
+TEST(MakeEventPayload, NumbersMembersAndSplicesContext)
+{
+    std::vector<std::shared_ptr<const SerializedEventRecord>> records;
+    records.emplace_back(std::make_shared<const SerializedEventRecord>(
+        nlohmann::json{{"EventId", "1"},
+                       {"MemberId", 7},
+                       {"Context", "x"},
+                       {"MessageArgs", {"a", "b"}},
+                       {"Oem", {{"Nested", {{"Deep", 1}}}}}},
+        true));
+    records.emplace_back(std::make_shared<const SerializedEventRecord>(
+        nlohmann::json{{"EventId", "2"}, {"MemberId", 0}}, false));
+
+    std::shared_ptr<const std::string> payload =
+        makeEventPayload("12", records, "my \"ctx\"");
+    ASSERT_NE(payload, nullptr);
+
+    nlohmann::json events = nlohmann::json::array();
+    events.push_back({{"EventId", "1"},
+                      {"MemberId", 0},
+                      {"Context", "my \"ctx\""},
+                      {"MessageArgs", {"a", "b"}},
+                      {"Oem", {{"Nested", {{"Deep", 1}}}}}});
+    events.push_back({{"EventId", "2"}, {"MemberId", 1}});
+    EXPECT_EQ(*payload, prettyEvent("12", events));
+}
+
+TEST(MakeEventPayload, OnlyNumbersRecordsWithAMemberId)
+{
+    std::vector<std::shared_ptr<const SerializedEventRecord>> records;
+    records.emplace_back(std::make_shared<const SerializedEventRecord>(
+        nlohmann::json{{"EventId", "1"}, {"Context", "kept"}}, false));
+
+    nlohmann::json events = nlohmann::json::array();
+    events.push_back({{"EventId", "1"}, {"Context", "kept"}});
+    EXPECT_EQ(*makeEventPayload("3", records, "ignored"),
+              prettyEvent("3", events));
+}
+
+TEST(MakeEventPayload, HandlesEmptyRecords)
+{
+    std::vector<std::shared_ptr<const SerializedEventRecord>> records;
+    records.emplace_back(std::make_shared<const SerializedEventRecord>(
+        nlohmann::json::object(), true));
+    records.emplace_back(std::make_shared<const SerializedEventRecord>(
+        nlohmann::json::object(), false));
+
+    nlohmann::json events = nlohmann::json::array();
+    events.push_back({{"Context", ""}});
+    events.push_back(nlohmann::json::object());
+    EXPECT_EQ(*makeEventPayload("1", records, ""), prettyEvent("1", events));
+
+    EXPECT_EQ(*makeEventPayload("1", {}, ""),
+              prettyEvent("1", nlohmann::json::array()));
+}
+
+} // namespace
+} // namespace redfish
@@ -0,0 +1,144 @@
+#include "event_spool.hpp"
+
+#include <unistd.h>
+
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace redfish
+{
+namespace
+{
+
+class EventSpoolTest : public ::testing::Test
+{
+  protected:
+    EventSpoolTest() :
+        dir(std::filesystem::temp_directory_path() /
+            ("event_spool_test_" + std::to_string(getpid()))),
+        path(dir / "spool")
+    {
+        std::filesystem::remove_all(dir);
+    }
+
+    ~EventSpoolTest() override
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(dir, ec);
+    }
+
+    EventSpoolTest(const EventSpoolTest&) = delete;
+    EventSpoolTest(EventSpoolTest&&) = delete;
+    EventSpoolTest& operator=(const EventSpoolTest&) = delete;
+    EventSpoolTest& operator=(EventSpoolTest&&) = delete;
+
+    std::filesystem::path dir;
+    std::filesystem::path path;
+};
+
+TEST_F(EventSpoolTest, ReplaysInOrder)
+{
+    EventSpool spool(path, 4096);
+    ASSERT_TRUE(spool.open());
+    EXPECT_TRUE(spool.empty());
+    EXPECT_EQ(spool.front(), std::nullopt);
+
+    EXPECT_TRUE(spool.push("first"));
+    EXPECT_TRUE(spool.push("second"));
+    EXPECT_TRUE(spool.push(""));
+    EXPECT_EQ(spool.size(), 3U);
+
+    EXPECT_EQ(spool.front(), "first");
+    spool.pop();
+    EXPECT_EQ(spool.front(), "second");
+    spool.pop();
+    EXPECT_EQ(spool.front(), "");
+    spool.pop();
+    EXPECT_TRUE(spool.empty());
+}
+
+TEST_F(EventSpoolTest, SurvivesReopening)
+{
+    {
+        EventSpool spool(path, 4096);
+        ASSERT_TRUE(spool.open());
+        spool.push("sent");
+        spool.push("waiting");
+        spool.push("also waiting");
+        spool.pop();
+    }
+
+    EventSpool spool(path, 4096);
+    ASSERT_TRUE(spool.open());
+    EXPECT_EQ(spool.size(), 2U);
+    EXPECT_EQ(spool.front(), "waiting");
+    spool.pop();
+    EXPECT_EQ(spool.front(), "also waiting");
+}
+
+TEST_F(EventSpoolTest, DropsOldestToStayBounded)
+{
+    // Header of 16, then records of 4 + 10 bytes
+    EventSpool spool(path, 16 + 14 * 3);
+    ASSERT_TRUE(spool.open());
+    EXPECT_TRUE(spool.push("event-0000"));
+    EXPECT_TRUE(spool.push("event-0001"));
+    EXPECT_TRUE(spool.push("event-0002"));
+    EXPECT_EQ(spool.droppedCount(), 0U);
+
+    EXPECT_TRUE(spool.push("event-0003"));
+    EXPECT_TRUE(spool.push("event-0004"));
+    EXPECT_EQ(spool.droppedCount(), 2U);
+    EXPECT_EQ(spool.size(), 3U);
+    EXPECT_LE(std::filesystem::file_size(path), 16U + 14U * 3U);
+
+    EXPECT_EQ(spool.front(), "event-0002");
+    spool.pop();
+    EXPECT_EQ(spool.front(), "event-0003");
+    spool.pop();
+    EXPECT_EQ(spool.front(), "event-0004");
+
+    // Too big to ever fit
+    EXPECT_FALSE(spool.push(std::string(64, 'x')));
+    EXPECT_EQ(spool.front(), "event-0004");
+}
+
+TEST_F(EventSpoolTest, DiscardsATruncatedRecord)
+{
+    {
+        EventSpool spool(path, 4096);
+        ASSERT_TRUE(spool.open());
+        spool.push("whole");
+        spool.push("cut short");
+    }
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 3);
+
+    EventSpool spool(path, 4096);
+    ASSERT_TRUE(spool.open());
+    EXPECT_EQ(spool.size(), 1U);
+    EXPECT_EQ(spool.front(), "whole");
+    EXPECT_TRUE(spool.push("next"));
+    spool.pop();
+    EXPECT_EQ(spool.front(), "next");
+}
+
+TEST_F(EventSpoolTest, RemoveDeletesTheFile)
+{
+    EventSpool spool(path, 4096);
+    ASSERT_TRUE(spool.open());
+    spool.push("event");
+    spool.remove();
+    EXPECT_FALSE(std::filesystem::exists(path));
+    EXPECT_TRUE(spool.empty());
+}
+
+} // namespace
+} // namespace redfish
@@ -0,0 +1,40 @@
+#include "event_subscription_filter.hpp"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace redfish
+{
+namespace
+{
+
+TEST(EventValueFilter, EmptyMatchesEverything)
+{
+    EventValueFilter filter;
+    EXPECT_TRUE(filter.empty());
+    EXPECT_TRUE(filter.matches("OpenBMC"));
+    EXPECT_TRUE(filter.matches(""));
+
+    EventValueFilter fromEmpty(std::vector<std::string>{});
+    EXPECT_TRUE(fromEmpty.matches("Base"));
+}
+
+TEST(EventValueFilter, MatchesOnlyListedValues)
+{
+    EventValueFilter filter(std::vector<std::string>{"OpenBMC", "Base"});
+    EXPECT_FALSE(filter.empty());
+    EXPECT_TRUE(filter.matches("OpenBMC"));
+    EXPECT_TRUE(filter.matches("Base"));
+    EXPECT_FALSE(filter.matches("TaskEvent"));
+    EXPECT_FALSE(filter.matches("Open"));
+    EXPECT_FALSE(filter.matches("openbmc"));
+}
+
+} // namespace
+} // namespace redfish
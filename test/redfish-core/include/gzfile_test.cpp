@@ -0,0 +1,180 @@
+#include "gzfile.hpp"
+
+#include <unistd.h>
+#include <zlib.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h> // IWYU pragma: keep
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+// IWYU pragma: no_include <gmock/gmock-matchers.h>
+
+namespace
+{
+
+class GzFileTest : public ::testing::Test
+{
+  protected:
+    GzFileTest() :
+        dir(std::filesystem::temp_directory_path() /
+            ("gzfile_test_" + std::to_string(getpid())))
+    {
+        std::filesystem::remove_all(dir);
+        std::filesystem::create_directories(dir);
+    }
+
+    ~GzFileTest() override
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(dir, ec);
+    }
+
+    GzFileTest(const GzFileTest&) = delete;
+    GzFileTest(GzFileTest&&) = delete;
+    GzFileTest& operator=(const GzFileTest&) = delete;
+    GzFileTest& operator=(GzFileTest&&) = delete;
+
+    std::string write(const std::string& name, const std::string& text)
+    {
+        std::string path = (dir / name).string();
+        gzFile out = gzopen(path.c_str(), "w");
+        gzwrite(out, text.data(), static_cast<unsigned int>(text.size()));
+        gzclose(out);
+        files.emplace_back(path);
+        return path;
+    }
+
+    // Reads files the way the HostLogger entries are read, using index if
+    // given
+    std::vector<std::string> read(uint64_t skip, uint64_t top, size_t& count,
+                                  GzFileIndex* index) const
+    {
+        GzFileReader reader;
+        std::vector<std::string> entries;
+        count = 0;
+        for (const std::string& file : files)
+        {
+            std::optional<GzFileIndex::FileId> fileId =
+                GzFileIndex::identify(file);
+            std::optional<GzFileSummary> summary;
+            if (index != nullptr && fileId)
+            {
+                summary = index->find(*fileId);
+            }
+            if (summary && summary->skippable &&
+                (count + summary->count <= skip || count >= skip + top))
+            {
+                reader.skipFile(*summary, count);
+                continue;
+            }
+            EXPECT_TRUE(reader.gzGetLines(file, skip, top, entries, count));
+            if (index != nullptr && fileId)
+            {
+                index->insert(*fileId, reader.getFileSummary());
+            }
+        }
+        std::string lastMessage = reader.getLastMessage();
+        if (!lastMessage.empty())
+        {
+            count++;
+            if (count > skip && count <= skip + top)
+            {
+                entries.push_back(lastMessage);
+            }
+        }
+        return entries;
+    }
+
+    std::filesystem::path dir;
+    std::vector<std::string> files;
+};
+
+TEST_F(GzFileTest, IndexedReadsMatchFullReads)
+{
+    write("log.5", "one\ntwo\r\n");
+    // "\r\n" split between files is a single delimiter
+    write("log.4", "three\r");
+    write("log.3", "\nfour\n\nfive\n");
+    // A line split between files is joined
+    write("log.2", "six");
+    write("log.1", " seven\n");
+
+    GzFileIndex index;
+    size_t count = 0;
+    read(0, 100, count, &index);
+    EXPECT_EQ(index.size(), files.size());
+
+    for (uint64_t skip = 0; skip <= 10; skip++)
+    {
+        for (uint64_t top = 1; top <= 3; top++)
+        {
+            size_t fullCount = 0;
+            size_t indexedCount = 0;
+            EXPECT_EQ(read(skip, top, fullCount, nullptr),
+                      read(skip, top, indexedCount, &index))
+                << "skip " << skip << " top " << top;
+            EXPECT_EQ(fullCount, indexedCount);
+        }
+    }
+    EXPECT_THAT(read(0, 100, count, &index),
+                ::testing::ElementsAre("one", "two", "three", "four", "\n",
+                                       "five", "six seven"));
+    EXPECT_EQ(count, 7);
+}
+
+TEST_F(GzFileTest, DelimiterSplitAcrossChunks)
+{
+    // The "\r\n" straddles the first 1024 byte chunk
+    std::string longLine(1023, 'a');
+    std::string path = write("log", longLine + "\r\nb\rc\n");
+
+    GzFileReader reader;
+    std::vector<std::string> entries;
+    size_t count = 0;
+    ASSERT_TRUE(reader.gzGetLines(path, 0, 100, entries, count));
+    EXPECT_THAT(entries, ::testing::ElementsAre(longLine, "b", "c"));
+    EXPECT_EQ(count, 3);
+    EXPECT_TRUE(reader.getLastMessage().empty());
+}
+
+TEST_F(GzFileTest, SummarySurvivesRename)
+{
+    std::string path = write("log.1", "one\ntwo\n");
+    GzFileIndex index;
+    size_t count = 0;
+    read(0, 100, count, &index);
+
+    std::filesystem::path renamed = dir / "log.2";
+    std::filesystem::rename(path, renamed);
+    std::optional<GzFileIndex::FileId> fileId =
+        GzFileIndex::identify(renamed.string());
+    ASSERT_TRUE(fileId);
+    std::optional<GzFileSummary> summary = index.find(*fileId);
+    ASSERT_TRUE(summary);
+    EXPECT_EQ(summary->count, 2);
+    EXPECT_TRUE(summary->skippable);
+}
+
+TEST_F(GzFileTest, ChangedFileIsNotFound)
+{
+    std::string path = write("log", "one\n");
+    GzFileIndex index;
+    size_t count = 0;
+    read(0, 100, count, &index);
+
+    files.clear();
+    write("log", "one\ntwo\nthree\n");
+    std::optional<GzFileIndex::FileId> fileId = GzFileIndex::identify(path);
+    ASSERT_TRUE(fileId);
+    EXPECT_FALSE(index.find(*fileId));
+}
+
+} // namespace
@@ -0,0 +1,100 @@
+#include "metric_aggregator.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <string>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace redfish::telemetry
+{
+namespace
+{
+
+TEST(AggregationFunction, ParsesNames)
+{
+    EXPECT_EQ(aggregationFunctionFromString("Average"),
+              AggregationFunction::Average);
+    EXPECT_EQ(aggregationFunctionFromString("Maximum"),
+              AggregationFunction::Maximum);
+    EXPECT_EQ(aggregationFunctionFromString("Minimum"),
+              AggregationFunction::Minimum);
+    EXPECT_EQ(aggregationFunctionFromString("Last"),
+              AggregationFunction::Last);
+    EXPECT_EQ(aggregationFunctionFromString("Median"), std::nullopt);
+}
+
+double aggregate(AggregationFunction function)
+{
+    MetricAggregator aggregator(function, std::chrono::seconds(60));
+    EXPECT_EQ(aggregator.add({60000, {{"a", 1.0, 60000}}}), std::nullopt);
+    EXPECT_EQ(aggregator.add({61000, {{"a", 5.0, 61000}}}), std::nullopt);
+    EXPECT_EQ(aggregator.add({62000, {{"a", 3.0, 62000}}}), std::nullopt);
+    std::optional<TimestampReadings> out =
+        aggregator.add({120000, {{"a", 100.0, 120000}}});
+    EXPECT_TRUE(out);
+    if (!out)
+    {
+        return 0.0;
+    }
+    const auto& [timestamp, readings] = *out;
+    EXPECT_EQ(timestamp, 62000U);
+    EXPECT_EQ(readings.size(), 1U);
+    if (readings.size() != 1)
+    {
+        return 0.0;
+    }
+    EXPECT_EQ(std::get<0>(readings[0]), "a");
+    EXPECT_EQ(std::get<2>(readings[0]), 62000U);
+    return std::get<1>(readings[0]);
+}
+
+TEST(MetricAggregator, AppliesFunctionOverInterval)
+{
+    EXPECT_DOUBLE_EQ(aggregate(AggregationFunction::Average), 3.0);
+    EXPECT_DOUBLE_EQ(aggregate(AggregationFunction::Maximum), 5.0);
+    EXPECT_DOUBLE_EQ(aggregate(AggregationFunction::Minimum), 1.0);
+    EXPECT_DOUBLE_EQ(aggregate(AggregationFunction::Last), 3.0);
+}
+
+TEST(MetricAggregator, KeepsPropertiesApartAndSkipsNaN)
+{
+    constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+    MetricAggregator aggregator(AggregationFunction::Average,
+                                std::chrono::seconds(10));
+    EXPECT_EQ(aggregator.add({1000, {{"a", 2.0, 1000}, {"b", nan, 1000}}}),
+              std::nullopt);
+    EXPECT_EQ(aggregator.add({2000, {{"a", nan, 2000}, {"b", nan, 2000}}}),
+              std::nullopt);
+    EXPECT_EQ(aggregator.add({3000, {{"a", 4.0, 3000}}}), std::nullopt);
+
+    std::optional<TimestampReadings> out =
+        aggregator.add({10000, {{"a", 9.0, 10000}}});
+    ASSERT_TRUE(out);
+    const Readings& readings = std::get<1>(*out);
+    ASSERT_EQ(readings.size(), 2U);
+    EXPECT_EQ(std::get<0>(readings[0]), "a");
+    EXPECT_DOUBLE_EQ(std::get<1>(readings[0]), 3.0);
+    EXPECT_EQ(std::get<2>(readings[0]), 3000U);
+    EXPECT_EQ(std::get<0>(readings[1]), "b");
+    EXPECT_TRUE(std::isnan(std::get<1>(readings[1])));
+    EXPECT_EQ(std::get<2>(readings[1]), 2000U);
+
+    // The update that completed the interval starts the next one
+    out = aggregator.add({20000, {}});
+    ASSERT_TRUE(out);
+    ASSERT_EQ(std::get<1>(*out).size(), 1U);
+    EXPECT_DOUBLE_EQ(std::get<1>(std::get<1>(*out)[0]), 9.0);
+
+    // An empty interval hands nothing back
+    EXPECT_EQ(aggregator.add({30000, {}}), std::nullopt);
+}
+
+} // namespace
+} // namespace redfish::telemetry
@@ -0,0 +1,61 @@
+#include "metric_values.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <string>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace redfish::telemetry
+{
+namespace
+{
+
+TEST(MetricValues, SerializesEveryReading)
+{
+    Readings readings{{"/sensors/a", 1.5, 1000},
+                      {"/sensors/\"b\"", -2.0, 1000},
+                      {"/sensors/a", 3.25, 2500}};
+    MetricValues values(readings);
+    EXPECT_EQ(values.size(), 3U);
+
+    nlohmann::json expected = nlohmann::json::array(
+        {{{"MetricProperty", "/sensors/a"},
+          {"MetricValue", "1.500000"},
+          {"Timestamp", "1970-01-01T00:00:01.000+00:00"}},
+         {{"MetricProperty", "/sensors/\"b\""},
+          {"MetricValue", "-2.000000"},
+          {"Timestamp", "1970-01-01T00:00:01.000+00:00"}},
+         {{"MetricProperty", "/sensors/a"},
+          {"MetricValue", "3.250000"},
+          {"Timestamp", "1970-01-01T00:00:02.500+00:00"}}});
+    EXPECT_EQ(nlohmann::json(values.toJson()), expected);
+
+    std::string out;
+    values.appendJson(out);
+    EXPECT_EQ(nlohmann::json::parse(out), expected);
+}
+
+TEST(MetricValues, MatchesToStringFormatting)
+{
+    Readings readings{{"p", 123456789.125, 0}, {"p", 1e-7, 0}};
+    std::string out;
+    MetricValues(readings).appendJson(out);
+    nlohmann::json parsed = nlohmann::json::parse(out);
+    EXPECT_EQ(parsed[0]["MetricValue"], std::to_string(123456789.125));
+    EXPECT_EQ(parsed[1]["MetricValue"], std::to_string(1e-7));
+}
+
+TEST(MetricValues, EmptyReadings)
+{
+    std::string out;
+    MetricValues(Readings{}).appendJson(out);
+    EXPECT_EQ(out, "[]");
+}
+
+} // namespace
+} // namespace redfish::telemetry
@@ -3,6 +3,8 @@
 #include <boost/beast/http/verb.hpp>
 
 #include <array>
+#include <cstddef>
+#include <vector>
 
 #include <gmock/gmock.h> // IWYU pragma: keep
 #include <gtest/gtest.h> // IWYU pragma: keep
@@ -134,5 +136,50 @@ TEST(PrivilegeTest, GetActivePrivilegeNames)
                              expectedPrivileges[2], expectedPrivileges[3],
                              expectedPrivileges[4]));
 }
+TEST(PrivilegeTest, UserRoleIdsMatchRoleNames)
+{
+    EXPECT_EQ(getUserRoleId("priv-admin"), UserRoleId::Administrator);
+    EXPECT_EQ(getUserRoleId("priv-operator"), UserRoleId::Operator);
+    EXPECT_EQ(getUserRoleId("priv-user"), UserRoleId::ReadOnly);
+    EXPECT_EQ(getUserRoleId("priv-oemibmserviceagent"),
+              UserRoleId::OemIBMServiceAgent);
+    EXPECT_EQ(getUserRoleId("priv-noaccess"), UserRoleId::NoAccess);
+    EXPECT_EQ(getUserRoleId(""), UserRoleId::NoAccess);
+}
+
+TEST(PrivilegeTest, ExpiredPasswordLimitsRoleToConfigureSelf)
+{
+    EXPECT_EQ(getEffectiveUserRoleId(UserRoleId::Administrator, true),
+              UserRoleId::ConfigureSelfOnly);
+    EXPECT_EQ(getEffectiveUserRoleId(UserRoleId::Administrator, false),
+              UserRoleId::Administrator);
+    EXPECT_EQ(getEffectiveUserRoleId(UserRoleId::NoAccess, true),
+              UserRoleId::NoAccess);
+}
+
+TEST(PrivilegeTest, AllowedUserRolesMatchPrivilegeCheck)
+{
+    std::vector<Privileges> required{{"ConfigureComponents"},
+                                     {"ConfigureManager"}};
+    UserRoleMask allowed = getAllowedUserRoles(required);
+    for (size_t role = 0; role < userRoleIdCount; role++)
+    {
+        EXPECT_EQ((allowed & (1U << role)) != 0,
+                  isOperationAllowedWithPrivileges(
+                      required,
+                      getUserPrivileges(static_cast<UserRoleId>(role))));
+    }
+    auto bit = [](UserRoleId role) {
+        return 1U << static_cast<size_t>(role);
+    };
+    EXPECT_EQ(allowed, bit(UserRoleId::Operator) |
+                           bit(UserRoleId::Administrator) |
+                           bit(UserRoleId::OemIBMServiceAgent));
+}
+
+TEST(PrivilegeTest, NoRequiredPrivilegesAllowsEveryRole)
+{
+    EXPECT_EQ(getAllowedUserRoles({}), (1U << userRoleIdCount) - 1);
+}
 } // namespace
 } // namespace redfish
@@ -238,6 +238,58 @@ TEST(addPrefixes, FixHttpHeadersInResponseBody)
         "Location: /redfish/v1/Managers/5B247A_bmc/LogServices/Dump/Entries/0");
 }
 
+TEST(parseWithPrefixes, MatchesAddPrefixes)
+{
+    constexpr std::string_view body = R"(
+    {
+      "@odata.id": "/redfish/v1/TaskService/Tasks/0",
+      "Name": "/redfish/v1/Chassis/fakeName",
+      "Members": [
+        {"@odata.id": "/redfish/v1/Chassis/TestChassis"},
+        [{"@odata.id": "/redfish/v1/Chassis/Nested"}, "/redfish/v1/Chassis/x"]
+      ],
+      "Status": {
+        "Conditions": [
+          {
+            "Message": "This is a test",
+            "OriginOfCondition": {
+              "@odata.id": "/redfish/v1/Chassis/TestChassis"
+            }
+          }
+        ]
+      },
+      "Payload": {
+        "HttpHeaders": [
+          "Accept: */*",
+          "Location: /redfish/v1/Managers/bmc/LogServices/Dump/Entries/0",
+          ["Location: /redfish/v1/Managers/bmc"]
+        ],
+        "TargetUri": "/redfish/v1/Systems/system"
+      },
+      "TaskMonitor": "/redfish/v1/TaskService/Tasks/0/Monitor"
+    }
+    )";
+
+    nlohmann::json expected = nlohmann::json::parse(body, nullptr, false);
+    ASSERT_FALSE(expected.is_discarded());
+    addPrefixes(expected, "5B247A");
+
+    nlohmann::json parsed = parseWithPrefixes(body, "5B247A");
+    ASSERT_FALSE(parsed.is_discarded());
+    EXPECT_EQ(parsed, expected);
+    EXPECT_EQ(parsed["Members"][0]["@odata.id"],
+              "/redfish/v1/Chassis/5B247A_TestChassis");
+    EXPECT_EQ(
+        parsed["Payload"]["HttpHeaders"][1],
+        "Location: /redfish/v1/Managers/5B247A_bmc/LogServices/Dump/Entries/0");
+}
+
+TEST(parseWithPrefixes, InvalidJson)
+{
+    EXPECT_TRUE(parseWithPrefixes(R"({"@odata.id": )", "5B42").is_discarded());
+    EXPECT_TRUE(parseWithPrefixes("", "5B42").is_discarded());
+}
+
 // Attempts to perform prefix fixing on a response with response code "result".
 // Fixing should always occur
 void assertProcessResponse(unsigned result)
@@ -517,5 +569,34 @@ TEST(processResponse, DifferentContentType)
     assertProcessResponseContentType(";charset=utf-8");
 }
 
+TEST(satelliteCollectionTarget, AsksForWhatThePageNeeds)
+{
+    EXPECT_EQ(satelliteCollectionTarget(
+                  boost::urls::url_view("/redfish/v1/Chassis")),
+              "/redfish/v1/Chassis");
+    EXPECT_EQ(satelliteCollectionTarget(
+                  boost::urls::url_view("/redfish/v1/Chassis?$skip=5&$top=10")),
+              "/redfish/v1/Chassis?$top=15");
+    EXPECT_EQ(satelliteCollectionTarget(
+                  boost::urls::url_view("/redfish/v1/Chassis?$top=2")),
+              "/redfish/v1/Chassis?$top=2");
+    // Skipping alone still needs every member
+    EXPECT_EQ(satelliteCollectionTarget(
+                  boost::urls::url_view("/redfish/v1/Chassis?$skip=5")),
+              "/redfish/v1/Chassis");
+    // More than a satellite would allow in one $top
+    EXPECT_EQ(
+        satelliteCollectionTarget(
+            boost::urls::url_view("/redfish/v1/Chassis?$skip=900&$top=200")),
+        "/redfish/v1/Chassis");
+}
+
+TEST(satelliteCollectionTarget, ForwardsPerMemberParameters)
+{
+    EXPECT_EQ(satelliteCollectionTarget(boost::urls::url_view(
+                  "/redfish/v1/Chassis?$expand=.($levels=1)&only&$top=1")),
+              "/redfish/v1/Chassis?$expand=.($levels=1)&$top=1");
+}
+
 } // namespace
 } // namespace redfish
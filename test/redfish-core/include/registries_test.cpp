@@ -1,4 +1,10 @@
 #include "registries.hpp"
+#include "registries_selector.hpp"
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
 
 #include <gtest/gtest.h> // IWYU pragma: keep
 
@@ -22,5 +28,70 @@ TEST(FillMessageArgs, ArgsAreFilledCorrectly)
     EXPECT_EQ(fillMessageArgs({}, "%foo"), "");
 }
 
+constexpr std::array testRegistry{
+    MessageEntry{"Zeta", {"", "zeta", "OK", 0, {}, ""}},
+    MessageEntry{"Alpha", {"", "alpha", "OK", 0, {}, ""}},
+    MessageEntry{"Mu", {"", "mu", "OK", 0, {}, ""}},
+};
+
+TEST(GetLogFromRegistry, FillsMessageFields)
+{
+    constexpr Header header{"", "", "Test.1.0", "", "", "", "Test", "", ""};
+    constexpr std::array registry{
+        MessageEntry{"Args", {"", "%2 then %1", "Warning", 2, {}, "Retry."}},
+    };
+    std::array<std::string_view, 2> args{"a", "b"};
+    nlohmann::json::object_t log =
+        getLogFromRegistry(header, registry, 0, args);
+    EXPECT_EQ(log["MessageId"], "Test.1.0.Args");
+    EXPECT_EQ(log["Message"], "b then a");
+    EXPECT_EQ(log["MessageArgs"], nlohmann::json({"a", "b"}));
+    EXPECT_EQ(log["MessageSeverity"], "Warning");
+    EXPECT_EQ(log["Resolution"], "Retry.");
+}
+
+TEST(MessageKeyIndex, FindsEveryKey)
+{
+    constexpr std::array byKey = makeMessageKeyIndex(testRegistry);
+    static_assert(byKey == std::array<uint16_t, 3>{1, 2, 0});
+
+    for (const MessageEntry& entry : testRegistry)
+    {
+        EXPECT_EQ(findMessage(testRegistry, byKey, entry.first),
+                  &entry.second);
+    }
+    EXPECT_EQ(findMessage(testRegistry, byKey, "Beta"), nullptr);
+    EXPECT_EQ(findMessage(testRegistry, byKey, "Zz"), nullptr);
+    EXPECT_EQ(findMessage(testRegistry, byKey, ""), nullptr);
+}
+
+TEST(SplitMessageId, NeedsFourFields)
+{
+    std::string_view registryName;
+    std::string_view messageKey;
+    ASSERT_TRUE(splitMessageId("OpenBMC.0.1.Foo", registryName, messageKey));
+    EXPECT_EQ(registryName, "OpenBMC");
+    EXPECT_EQ(messageKey, "Foo");
+    EXPECT_FALSE(splitMessageId("OpenBMC.0.Foo", registryName, messageKey));
+    EXPECT_FALSE(splitMessageId("A.0.1.2.Foo", registryName, messageKey));
+}
+
+TEST(GetMessage, LooksUpEveryRegistry)
+{
+    for (const MessageRegistry& registry : selector::messageRegistries)
+    {
+        std::string prefix = registry.header->registryPrefix;
+        for (const MessageEntry& entry : registry.entries)
+        {
+            EXPECT_EQ(getMessage(prefix + ".1.0." + entry.first),
+                      &entry.second)
+                << entry.first;
+        }
+    }
+    EXPECT_EQ(getMessage("Base.1.0.NotAMessage"), nullptr);
+    EXPECT_EQ(getMessage("NotARegistry.1.0.Success"), nullptr);
+    EXPECT_EQ(getMessage("Base.Success"), nullptr);
+}
+
 } // namespace
 } // namespace redfish::registries
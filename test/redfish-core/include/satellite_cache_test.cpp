@@ -0,0 +1,153 @@
+#include "satellite_cache.hpp"
+
+#include <boost/beast/http/field.hpp>
+#include <boost/beast/http/status.hpp>
+
+#include <chrono>
+#include <string>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace redfish
+{
+namespace
+{
+
+SatelliteCache::Message makeMessage(const std::string& body,
+                                    const std::string& etag = "")
+{
+    SatelliteCache::Message message;
+    message.result(boost::beast::http::status::ok);
+    message.set(boost::beast::http::field::content_type, "application/json");
+    if (!etag.empty())
+    {
+        message.set(boost::beast::http::field::etag, etag);
+    }
+    message.body() = body;
+    return message;
+}
+
+TEST(SatelliteCache, ServesUntilTtl)
+{
+    SatelliteCache cache(std::chrono::seconds(5));
+    SatelliteCache::Clock::time_point now = SatelliteCache::Clock::now();
+    std::string key = SatelliteCache::key("5B247A", "admin", "/redfish/v1");
+
+    EXPECT_EQ(cache.lookup(key, now), std::nullopt);
+    cache.store(key, "5B247A", makeMessage("{}"), cache.generation(), now);
+    std::optional<SatelliteCache::Message> cached =
+        cache.lookup(key, now + std::chrono::seconds(4));
+    ASSERT_TRUE(cached);
+    EXPECT_EQ(cached->body(), "{}");
+    EXPECT_EQ((*cached)[boost::beast::http::field::content_type],
+              "application/json");
+
+    // Without an ETag a stale entry can't be revalidated, so it goes
+    EXPECT_EQ(cache.lookup(key, now + std::chrono::seconds(5)), std::nullopt);
+    EXPECT_EQ(cache.size(), 0);
+}
+
+TEST(SatelliteCache, RevalidatesWithEtag)
+{
+    SatelliteCache cache(std::chrono::seconds(5));
+    SatelliteCache::Clock::time_point now = SatelliteCache::Clock::now();
+    std::string key = SatelliteCache::key("5B247A", "admin", "/redfish/v1");
+
+    cache.store(key, "5B247A", makeMessage("{}", "\"1\""), cache.generation(),
+                now);
+    now += std::chrono::seconds(6);
+    EXPECT_EQ(cache.lookup(key, now), std::nullopt);
+    EXPECT_EQ(cache.etag(key), "\"1\"");
+
+    std::optional<SatelliteCache::Message> current =
+        cache.revalidated(key, cache.generation(), now);
+    ASSERT_TRUE(current);
+    EXPECT_EQ(current->body(), "{}");
+    EXPECT_TRUE(cache.lookup(key, now + std::chrono::seconds(4)));
+}
+
+TEST(SatelliteCache, KeyedByUser)
+{
+    SatelliteCache cache(std::chrono::seconds(5));
+    SatelliteCache::Clock::time_point now = SatelliteCache::Clock::now();
+    cache.store(SatelliteCache::key("5B247A", "admin", "/redfish/v1"),
+                "5B247A", makeMessage("{}"), cache.generation(), now);
+
+    EXPECT_EQ(
+        cache.lookup(SatelliteCache::key("5B247A", "operator", "/redfish/v1"),
+                     now),
+        std::nullopt);
+}
+
+TEST(SatelliteCache, OnlyStoresSmallSuccesses)
+{
+    SatelliteCache cache(std::chrono::seconds(5));
+    std::string key = SatelliteCache::key("5B247A", "admin", "/redfish/v1");
+
+    SatelliteCache::Message notFound = makeMessage("{}");
+    notFound.result(boost::beast::http::status::not_found);
+    cache.store(key, "5B247A", notFound, cache.generation());
+    EXPECT_EQ(cache.size(), 0);
+
+    cache.store(key, "5B247A",
+                makeMessage(std::string(satelliteCacheMaxBodySize + 1, ' ')),
+                cache.generation());
+    EXPECT_EQ(cache.size(), 0);
+}
+
+TEST(SatelliteCache, InvalidateDropsSatellite)
+{
+    SatelliteCache cache(std::chrono::seconds(5));
+    std::string first = SatelliteCache::key("5B247A", "admin", "/redfish/v1");
+    std::string second = SatelliteCache::key("ABCDEF", "admin", "/redfish/v1");
+    cache.store(first, "5B247A", makeMessage("{}"), cache.generation());
+    cache.store(second, "ABCDEF", makeMessage("{}"), cache.generation());
+
+    // A response to a request sent before the invalidation isn't kept
+    uint64_t generation = cache.generation();
+    cache.invalidate("5B247A");
+    EXPECT_EQ(cache.lookup(first), std::nullopt);
+    EXPECT_TRUE(cache.lookup(second));
+    cache.store(first, "5B247A", makeMessage("{}"), generation);
+    EXPECT_EQ(cache.lookup(first), std::nullopt);
+}
+
+TEST(SatelliteCache, EvictsLeastRecentlyUsed)
+{
+    SatelliteCache cache(std::chrono::seconds(60));
+    SatelliteCache::Clock::time_point now = SatelliteCache::Clock::now();
+    for (std::size_t i = 0; i < satelliteCacheMaxEntries; i++)
+    {
+        cache.store(SatelliteCache::key("5B247A", "admin", std::to_string(i)),
+                    "5B247A", makeMessage("{}"), cache.generation(),
+                    now + std::chrono::milliseconds(i));
+    }
+    // Touching the oldest entry makes the second oldest the one to go
+    EXPECT_TRUE(cache.lookup(SatelliteCache::key("5B247A", "admin", "0"),
+                             now + std::chrono::seconds(1)));
+    cache.store(SatelliteCache::key("5B247A", "admin", "new"), "5B247A",
+                makeMessage("{}"), cache.generation(),
+                now + std::chrono::seconds(2));
+    EXPECT_EQ(cache.size(), satelliteCacheMaxEntries);
+    EXPECT_TRUE(cache.lookup(SatelliteCache::key("5B247A", "admin", "0"),
+                             now + std::chrono::seconds(3)));
+    EXPECT_EQ(cache.lookup(SatelliteCache::key("5B247A", "admin", "1"),
+                           now + std::chrono::seconds(3)),
+              std::nullopt);
+}
+
+TEST(SatelliteCache, DisabledStoresNothing)
+{
+    SatelliteCache cache(std::chrono::seconds(0));
+    EXPECT_FALSE(cache.enabled());
+    std::string key = SatelliteCache::key("5B247A", "admin", "/redfish/v1");
+    cache.store(key, "5B247A", makeMessage("{}"), cache.generation());
+    EXPECT_EQ(cache.size(), 0);
+}
+
+} // namespace
+} // namespace redfish
@@ -0,0 +1,84 @@
+#include "sensor_readings_filter.hpp"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace redfish
+{
+namespace
+{
+
+TEST(ParseSensorReadingsFilter, SingleComparison)
+{
+    std::optional<SensorReadingsFilter> filter =
+        parseSensorReadingsFilter("ReadingType eq 'Temperature'");
+    ASSERT_TRUE(filter);
+    EXPECT_EQ(filter->readingTypes, std::vector<std::string>{"Temperature"});
+    EXPECT_TRUE(filter->chassis.empty());
+    EXPECT_TRUE(filter->matches("chassis", "Temperature"));
+    EXPECT_FALSE(filter->matches("chassis", "Power"));
+}
+
+TEST(ParseSensorReadingsFilter, AlternativesAndConjunction)
+{
+    std::optional<SensorReadingsFilter> filter = parseSensorReadingsFilter(
+        "(ReadingType eq 'Temperature' or ReadingType eq 'Power') and "
+        "Chassis eq 'chassis'");
+    ASSERT_TRUE(filter);
+    EXPECT_EQ(filter->readingTypes,
+              (std::vector<std::string>{"Temperature", "Power"}));
+    EXPECT_EQ(filter->chassis, std::vector<std::string>{"chassis"});
+    EXPECT_TRUE(filter->matches("chassis", "Power"));
+    EXPECT_FALSE(filter->matches("chassis2", "Power"));
+    EXPECT_FALSE(filter->matches("chassis", "Voltage"));
+
+    filter = parseSensorReadingsFilter("Chassis eq 'a' or Chassis eq 'b'");
+    ASSERT_TRUE(filter);
+    EXPECT_EQ(filter->chassis, (std::vector<std::string>{"a", "b"}));
+    EXPECT_TRUE(filter->matches("b", "Voltage"));
+}
+
+TEST(ParseSensorReadingsFilter, QuotedValues)
+{
+    std::optional<SensorReadingsFilter> filter =
+        parseSensorReadingsFilter("Chassis eq 'it''s'");
+    ASSERT_TRUE(filter);
+    EXPECT_EQ(filter->chassis, std::vector<std::string>{"it's"});
+
+    filter = parseSensorReadingsFilter("Chassis eq 'a and b'");
+    ASSERT_TRUE(filter);
+    EXPECT_EQ(filter->chassis, std::vector<std::string>{"a and b"});
+}
+
+TEST(ParseSensorReadingsFilter, Rejected)
+{
+    EXPECT_FALSE(parseSensorReadingsFilter(""));
+    EXPECT_FALSE(parseSensorReadingsFilter("Reading eq '5'"));
+    EXPECT_FALSE(parseSensorReadingsFilter("ReadingType ne 'Power'"));
+    EXPECT_FALSE(parseSensorReadingsFilter("ReadingType eq Power"));
+    EXPECT_FALSE(parseSensorReadingsFilter("ReadingType eq 'Power"));
+    EXPECT_FALSE(parseSensorReadingsFilter("ReadingType eq 'Power' trailing"));
+    EXPECT_FALSE(
+        parseSensorReadingsFilter("ReadingType eq 'Power' or Chassis eq 'a'"));
+    EXPECT_FALSE(parseSensorReadingsFilter(
+        "ReadingType eq 'Power' or ReadingType eq 'Voltage' and "
+        "Chassis eq 'a'"));
+    EXPECT_FALSE(parseSensorReadingsFilter(
+        "Chassis eq 'a' and ReadingType eq 'Power' or "
+        "ReadingType eq 'Voltage'"));
+    EXPECT_FALSE(
+        parseSensorReadingsFilter("Chassis eq 'a' and Chassis eq 'b'"));
+    EXPECT_FALSE(parseSensorReadingsFilter("(Chassis eq 'a'"));
+    EXPECT_FALSE(parseSensorReadingsFilter("Chassis eq 'a' andReadingType "
+                                           "eq 'Power'"));
+}
+
+} // namespace
+} // namespace redfish
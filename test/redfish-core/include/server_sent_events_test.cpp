@@ -0,0 +1,102 @@
+#include "server_sent_events.hpp"
+
+#include <boost/asio/io_context.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace crow
+{
+namespace
+{
+
+TEST(FormatSseEvent, SplitsLinesIntoDataFields)
+{
+    EXPECT_EQ(formatSseEvent("7", "{}"), "id: 7\ndata: {}\n\n");
+    EXPECT_EQ(formatSseEvent("", "{\n  \"Id\": 1\n}"),
+              "data: {\ndata:   \"Id\": 1\ndata: }\n\n");
+}
+
+TEST(GetSseEvent, SharesEventForSamePayload)
+{
+    auto payload = std::make_shared<const std::string>("{}");
+    std::shared_ptr<const std::string> first = getSseEvent(payload, "1");
+    EXPECT_EQ(*first, "id: 1\ndata: {}\n\n");
+    EXPECT_EQ(getSseEvent(payload, "1"), first);
+    EXPECT_NE(getSseEvent(payload, "2"), first);
+}
+
+struct Chunk
+{
+    std::string data;
+    bool more = false;
+};
+
+TEST(SseStream, WaitsForEventsThenHandsOverQueue)
+{
+    boost::asio::io_context io;
+    auto stream = std::make_shared<SseStream>(io);
+    std::vector<Chunk> chunks;
+    auto pull = [&stream, &chunks]() {
+        stream->pull([&chunks](std::string data, bool more) {
+            chunks.push_back({std::move(data), more});
+        });
+    };
+
+    pull();
+    EXPECT_TRUE(chunks.empty());
+    stream->push(std::make_shared<const std::string>("a"));
+    ASSERT_EQ(chunks.size(), 1U);
+    EXPECT_EQ(chunks[0].data, "a");
+    EXPECT_TRUE(chunks[0].more);
+
+    // Everything queued while a write is out goes in the next chunk
+    stream->push(std::make_shared<const std::string>("b"));
+    stream->push(std::make_shared<const std::string>("c"));
+    pull();
+    ASSERT_EQ(chunks.size(), 2U);
+    EXPECT_EQ(chunks[1].data, "bc");
+
+    stream->finish();
+    pull();
+    ASSERT_EQ(chunks.size(), 3U);
+    EXPECT_EQ(chunks[2].data, "");
+    EXPECT_FALSE(chunks[2].more);
+}
+
+TEST(SseStream, DropsOldestWhenBehind)
+{
+    boost::asio::io_context io;
+    auto stream = std::make_shared<SseStream>(io);
+    for (size_t i = 0; i < SseStream::maxQueuedEvents + 2; i++)
+    {
+        stream->push(std::make_shared<const std::string>(std::to_string(i)));
+    }
+    EXPECT_EQ(stream->getDroppedEvents(), 2U);
+
+    std::string chunk;
+    stream->pull([&chunk](std::string data, bool /*more*/) {
+        chunk = std::move(data);
+    });
+    EXPECT_EQ(chunk.substr(0, 2), "23");
+}
+
+TEST(SseStream, CallsCloseHandlerWhenReleased)
+{
+    boost::asio::io_context io;
+    bool closed = false;
+    auto stream = std::make_shared<SseStream>(io);
+    stream->setCloseHandler([&closed]() { closed = true; });
+    stream.reset();
+    EXPECT_TRUE(closed);
+}
+
+} // namespace
+} // namespace crow
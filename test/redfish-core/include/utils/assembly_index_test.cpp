@@ -0,0 +1,73 @@
+#include "dbus_utility.hpp"
+#include "utils/assembly_index.hpp"
+
+#include <string>
+
+#include <gmock/gmock.h> // IWYU pragma: keep
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace redfish::assembly_utils
+{
+namespace
+{
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+const std::string inventory = "/xyz/openbmc_project/inventory/system/chassis";
+
+dbus::utility::MapperGetSubTreeResponse implemented()
+{
+    return {
+        {inventory + "/motherboard/vrm0",
+         {{"xyz.openbmc_project.Inventory.Manager",
+           {"xyz.openbmc_project.Inventory.Item.Vrm"}}}},
+        {inventory + "/motherboard",
+         {{"xyz.openbmc_project.Inventory.Manager",
+           {"xyz.openbmc_project.Inventory.Item.Board.Motherboard"}}}},
+        {inventory + "/motherboard/tod_battery",
+         {{"xyz.openbmc_project.Inventory.Manager",
+           {"xyz.openbmc_project.Inventory.Item.Battery"}}}},
+        {inventory + "/motherboard/tpm_wilson",
+         {{"xyz.openbmc_project.Inventory.Manager",
+           {"xyz.openbmc_project.Inventory.Item.Tpm"}}}},
+    };
+}
+
+TEST(ImplementedAssemblies, KeepsImplementedEndpointsSortedByPath)
+{
+    dbus::utility::MapperEndPoints endpoints = {
+        inventory + "/motherboard/tpm_wilson",
+        inventory + "/motherboard/missing_panel",
+        inventory + "/motherboard/tod_battery",
+        inventory + "/motherboard",
+    };
+
+    EXPECT_THAT(implementedAssemblies(endpoints, implemented()),
+                ElementsAre(inventory + "/motherboard",
+                            inventory + "/motherboard/tod_battery",
+                            inventory + "/motherboard/tpm_wilson"));
+}
+
+TEST(ImplementedAssemblies, NoEndpoints)
+{
+    EXPECT_THAT(implementedAssemblies({}, implemented()), IsEmpty());
+    EXPECT_THAT(implementedAssemblies({inventory + "/motherboard"}, {}),
+                IsEmpty());
+}
+
+TEST(AssemblyIndex, TracksChassisAndAssemblyInterfaces)
+{
+    EXPECT_TRUE(AssemblyIndex::isTrackedInterface(
+        "xyz.openbmc_project.Inventory.Item.Chassis"));
+    EXPECT_TRUE(AssemblyIndex::isTrackedInterface(
+        "xyz.openbmc_project.Inventory.Item.Board.Motherboard"));
+    EXPECT_FALSE(AssemblyIndex::isTrackedInterface(
+        "xyz.openbmc_project.Inventory.Decorator.Asset"));
+}
+
+} // namespace
+} // namespace redfish::assembly_utils
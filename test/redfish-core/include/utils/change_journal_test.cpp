@@ -0,0 +1,92 @@
+#include "utils/change_journal.hpp"
+
+#include <optional>
+#include <set>
+#include <string>
+
+#include <gmock/gmock.h> // IWYU pragma: keep
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+// IWYU pragma: no_include <gmock/gmock-matchers.h>
+
+namespace redfish
+{
+namespace
+{
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+TEST(ChangeJournal, NothingChangedSinceCurrentToken)
+{
+    ChangeJournal journal;
+    journal.record("/a");
+    auto changed = journal.changedSince(journal.token());
+    ASSERT_TRUE(changed);
+    EXPECT_THAT(*changed, IsEmpty());
+}
+
+TEST(ChangeJournal, ListsEachKeyChangedSinceTokenOnce)
+{
+    ChangeJournal journal;
+    journal.record("/a");
+    std::string token = journal.token();
+    journal.record("/b");
+    journal.record("/c");
+    journal.record("/b");
+
+    auto changed = journal.changedSince(token);
+    ASSERT_TRUE(changed);
+    EXPECT_THAT(*changed, ElementsAre("/b", "/c"));
+}
+
+TEST(ChangeJournal, TokenOlderThanCapacityIsNotAnswered)
+{
+    ChangeJournal journal(2);
+    std::string token = journal.token();
+    journal.record("/a");
+    journal.record("/b");
+    std::string kept = journal.token();
+    EXPECT_TRUE(journal.changedSince(token));
+
+    journal.record("/c");
+    EXPECT_EQ(journal.changedSince(token), std::nullopt);
+    auto changed = journal.changedSince(kept);
+    ASSERT_TRUE(changed);
+    EXPECT_THAT(*changed, ElementsAre("/c"));
+}
+
+TEST(ChangeJournal, ResetForgetsEarlierTokens)
+{
+    ChangeJournal journal;
+    journal.record("/a");
+    std::string token = journal.token();
+    journal.reset();
+    EXPECT_EQ(journal.changedSince(token), std::nullopt);
+
+    std::string afterReset = journal.token();
+    journal.record("/b");
+    auto changed = journal.changedSince(afterReset);
+    ASSERT_TRUE(changed);
+    EXPECT_THAT(*changed, ElementsAre("/b"));
+}
+
+TEST(ChangeJournal, RejectsMalformedAndForeignTokens)
+{
+    ChangeJournal journal;
+    ChangeJournal other;
+    journal.record("/a");
+    std::string token = journal.token();
+
+    EXPECT_EQ(journal.changedSince(""), std::nullopt);
+    EXPECT_EQ(journal.changedSince("not a token"), std::nullopt);
+    EXPECT_EQ(journal.changedSince(token.substr(1)), std::nullopt);
+    EXPECT_EQ(journal.changedSince(token.substr(0, 31) + "g"), std::nullopt);
+    EXPECT_EQ(journal.changedSince(other.token()), std::nullopt);
+}
+
+} // namespace
+} // namespace redfish
@@ -0,0 +1,78 @@
+#include "generated/enums/resource.hpp"
+#include "utils/enum_table.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <string_view>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace redfish::enum_utils
+{
+namespace
+{
+
+TEST(EnumTable, ToJsonWritesEveryName)
+{
+    EXPECT_EQ(nlohmann::json(resource::Health::OK), "OK");
+    EXPECT_EQ(nlohmann::json(resource::Health::Warning), "Warning");
+    EXPECT_EQ(nlohmann::json(resource::Health::Critical), "Critical");
+    EXPECT_EQ(nlohmann::json(resource::State::Qualified), "Qualified");
+}
+
+TEST(EnumTable, ToJsonOutOfRangeIsInvalid)
+{
+    EXPECT_EQ(nlohmann::json(static_cast<resource::Health>(42)), "Invalid");
+}
+
+TEST(EnumTable, FromJsonReadsEveryName)
+{
+    EXPECT_EQ(nlohmann::json("Enabled").get<resource::State>(),
+              resource::State::Enabled);
+    EXPECT_EQ(nlohmann::json("Absent").get<resource::State>(),
+              resource::State::Absent);
+    EXPECT_EQ(nlohmann::json("Updating").get<resource::State>(),
+              resource::State::Updating);
+    EXPECT_EQ(nlohmann::json("Invalid").get<resource::State>(),
+              resource::State::Invalid);
+}
+
+TEST(EnumTable, FromJsonUnknownIsInvalid)
+{
+    EXPECT_EQ(nlohmann::json("enabled").get<resource::State>(),
+              resource::State::Invalid);
+    EXPECT_EQ(nlohmann::json(1).get<resource::State>(),
+              resource::State::Invalid);
+    EXPECT_EQ(nlohmann::json(nullptr).get<resource::State>(),
+              resource::State::Invalid);
+}
+
+TEST(EnumTable, StringLookups)
+{
+    EXPECT_EQ(toString(resource::PowerState::PoweringOn), "PoweringOn");
+    EXPECT_EQ(fromString<resource::PowerState>("Paused"),
+              resource::PowerState::Paused);
+    EXPECT_EQ(fromString<resource::PowerState>(""),
+              resource::PowerState::Invalid);
+}
+
+TEST(StringMap, FindsEveryKey)
+{
+    constexpr auto map = makeStringMap<int>(
+        {{"zeta", 1}, {"alpha", 2}, {"mu", 3}, {"beta", 4}});
+    static_assert(*map.find("alpha") == 2);
+
+    ASSERT_NE(map.find("zeta"), nullptr);
+    EXPECT_EQ(*map.find("zeta"), 1);
+    EXPECT_EQ(map.get("mu", 0), 3);
+    EXPECT_EQ(map.get("beta", 0), 4);
+    EXPECT_EQ(map.find("gamma"), nullptr);
+    EXPECT_EQ(map.get("", 0), 0);
+}
+
+} // namespace
+} // namespace redfish::enum_utils
@@ -0,0 +1,123 @@
+#include "sensor_reading_cache.hpp"
+#include "utils/chassis_graph.hpp"
+#include "utils/environment_aggregate.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace redfish::chassis_utils
+{
+namespace
+{
+
+using Reading = dbus::utility::SensorReadingCache::Reading;
+
+class FakeReadings
+{
+  public:
+    void set(const std::string& path, double value)
+    {
+        readings[path] = Reading{value, ++version, {}};
+    }
+
+    void erase(const std::string& path)
+    {
+        readings.erase(path);
+    }
+
+    const Reading* operator()(const std::string& path) const
+    {
+        auto it = readings.find(path);
+        if (it == readings.end())
+        {
+            return nullptr;
+        }
+        return &it->second;
+    }
+
+  private:
+    std::unordered_map<std::string, Reading> readings;
+    uint64_t version = 0;
+};
+
+TEST(SensorAggregate, EmptyHasNoExtremes)
+{
+    SensorAggregate aggregate({"/a"});
+    aggregate.refresh(FakeReadings());
+    EXPECT_EQ(aggregate.count(), 0U);
+    EXPECT_EQ(aggregate.average(), std::nullopt);
+    EXPECT_EQ(aggregate.minimum(), std::nullopt);
+    EXPECT_EQ(aggregate.maximum(), std::nullopt);
+}
+
+TEST(SensorAggregate, KeepsRunningSumAndExtremes)
+{
+    FakeReadings readings;
+    readings.set("/c", 30.0);
+    readings.set("/a", 10.0);
+    readings.set("/b", 20.0);
+    SensorAggregate aggregate({"/c", "/a", "/b", "/missing"});
+    aggregate.refresh(readings);
+
+    ASSERT_EQ(aggregate.sensors().size(), 4U);
+    EXPECT_EQ(aggregate.sensors()[0].path, "/a");
+    EXPECT_EQ(aggregate.sensors()[3].value, std::nullopt);
+    EXPECT_EQ(aggregate.count(), 3U);
+    EXPECT_DOUBLE_EQ(aggregate.sum(), 60.0);
+    EXPECT_EQ(aggregate.average(), 20.0);
+    EXPECT_EQ(aggregate.minimum(), 10.0);
+    EXPECT_EQ(aggregate.maximum(), 30.0);
+
+    // The maximum moving down is found again
+    readings.set("/c", 15.0);
+    aggregate.refresh(readings);
+    EXPECT_DOUBLE_EQ(aggregate.sum(), 45.0);
+    EXPECT_EQ(aggregate.minimum(), 10.0);
+    EXPECT_EQ(aggregate.maximum(), 20.0);
+
+    // A reading going away drops out
+    readings.erase("/a");
+    aggregate.refresh(readings);
+    EXPECT_EQ(aggregate.count(), 2U);
+    EXPECT_DOUBLE_EQ(aggregate.sum(), 35.0);
+    EXPECT_EQ(aggregate.minimum(), 15.0);
+
+    readings.set("/missing", 50.0);
+    aggregate.refresh(readings);
+    EXPECT_EQ(aggregate.count(), 3U);
+    EXPECT_EQ(aggregate.maximum(), 50.0);
+}
+
+TEST(EnvironmentAggregator, SplitsChassisSensorsByType)
+{
+    ChassisNode chassis;
+    chassis.id = "chassis";
+    chassis.sensors = std::vector<std::string>{
+        "/xyz/openbmc_project/sensors/temperature/inlet",
+        "/xyz/openbmc_project/sensors/fan_tach/fan0",
+        "/xyz/openbmc_project/sensors/power/total_power",
+        "/xyz/openbmc_project/sensors/voltage/p12v",
+        "/xyz/openbmc_project/sensors/fan_tach/fan1"};
+    ChassisEnvironment environment =
+        EnvironmentAggregator::makeEnvironment(chassis);
+    ASSERT_EQ(environment.temperatures.sensors().size(), 1U);
+    EXPECT_EQ(environment.temperatures.sensors()[0].path,
+              "/xyz/openbmc_project/sensors/temperature/inlet");
+    EXPECT_EQ(environment.power.sensors().size(), 1U);
+
+    EXPECT_EQ(EnvironmentAggregator::sensorType("/xyz/openbmc_project/sensors"),
+              "");
+    EXPECT_EQ(EnvironmentAggregator::sensorType("/other/temperature/x"), "");
+}
+
+} // namespace
+} // namespace redfish::chassis_utils
@@ -0,0 +1,134 @@
+#include "dbus_utility.hpp"
+#include "utils/fabric_topology.hpp"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace redfish::fabric_util
+{
+namespace
+{
+
+constexpr const char* adapterIface =
+    "xyz.openbmc_project.Inventory.Item.FabricAdapter";
+constexpr const char* portIface =
+    "xyz.openbmc_project.Inventory.Item.Connector";
+constexpr const char* cableIface = "xyz.openbmc_project.Inventory.Item.Cable";
+
+dbus::utility::MapperGetSubTreeResponse makeTree()
+{
+    const std::string board =
+        "/xyz/openbmc_project/inventory/system/chassis/motherboard";
+    return {
+        {board + "/adapter10",
+         {{"xyz.openbmc_project.Inventory.Manager", {adapterIface}}}},
+        {board + "/adapter10/port0",
+         {{"xyz.openbmc_project.Inventory.Manager", {portIface}}}},
+        {board + "/adapter2",
+         {{"xyz.openbmc_project.Inventory.Manager", {adapterIface}}}},
+        {board + "/adapter2/port1",
+         {{"xyz.openbmc_project.Inventory.Manager", {portIface}}}},
+        {board + "/adapter2/port0",
+         {{"xyz.openbmc_project.Inventory.Manager", {portIface}}}},
+        {board + "/adapter2/module/port5",
+         {{"xyz.openbmc_project.Inventory.Manager", {portIface}}}},
+        {board + "/port9",
+         {{"xyz.openbmc_project.Inventory.Manager", {portIface}}}},
+        {"/xyz/openbmc_project/inventory/cables/cable10",
+         {{"xyz.openbmc_project.Inventory.Manager", {cableIface}}}},
+        {"/xyz/openbmc_project/inventory/cables/cable2",
+         {{"xyz.openbmc_project.Inventory.Manager", {cableIface}}}},
+    };
+}
+
+std::vector<std::string> adapterIds(const FabricTopology& topology)
+{
+    std::vector<std::string> ids;
+    topology.forEachAdapter([&ids](const FabricTopology::Adapter& adapter) {
+        ids.emplace_back(adapter.id);
+    });
+    return ids;
+}
+
+TEST(FabricTopology, FindsAdaptersByUniqueId)
+{
+    FabricTopology topology(makeTree());
+
+    EXPECT_EQ(adapterIds(topology),
+              (std::vector<std::string>{"chassis-motherboard-adapter2",
+                                        "chassis-motherboard-adapter10"}));
+    const FabricTopology::Adapter* adapter =
+        topology.findAdapter("chassis-motherboard-adapter2");
+    ASSERT_NE(adapter, nullptr);
+    EXPECT_EQ(adapter->path, "/xyz/openbmc_project/inventory/system/chassis/"
+                             "motherboard/adapter2");
+    ASSERT_EQ(adapter->serviceMap.size(), 1);
+
+    EXPECT_EQ(topology.findAdapter("adapter2"), nullptr);
+}
+
+TEST(FabricTopology, ListsPortsDirectlyUnderAnAdapter)
+{
+    FabricTopology topology(makeTree());
+
+    const FabricTopology::Adapter* adapter =
+        topology.findAdapter("chassis-motherboard-adapter2");
+    ASSERT_NE(adapter, nullptr);
+    std::vector<std::string> ids;
+    topology.forEachPort(*adapter, [&ids](const FabricTopology::Object& port) {
+        ids.emplace_back(port.id);
+    });
+    EXPECT_EQ(ids, (std::vector<std::string>{"port0", "port1"}));
+}
+
+TEST(FabricTopology, FindsPortsAnywhereUnderTheirAdapter)
+{
+    FabricTopology topology(makeTree());
+
+    const FabricTopology::Adapter* adapter =
+        topology.findAdapter("chassis-motherboard-adapter2");
+    ASSERT_NE(adapter, nullptr);
+    const FabricTopology::Object* port = topology.findPort(*adapter, "port5");
+    ASSERT_NE(port, nullptr);
+    EXPECT_EQ(port->path, "/xyz/openbmc_project/inventory/system/chassis/"
+                          "motherboard/adapter2/module/port5");
+    port = topology.findPort(*adapter, "port0");
+    ASSERT_NE(port, nullptr);
+    EXPECT_EQ(port->path, "/xyz/openbmc_project/inventory/system/chassis/"
+                          "motherboard/adapter2/port0");
+
+    EXPECT_EQ(topology.findPort(*adapter, "port9"), nullptr);
+}
+
+TEST(FabricTopology, FindsCablesById)
+{
+    FabricTopology topology(makeTree());
+
+    std::vector<std::string> ids;
+    topology.forEachCable([&ids](const FabricTopology::Object& cable) {
+        ids.emplace_back(cable.id);
+    });
+    EXPECT_EQ(ids, (std::vector<std::string>{"cable2", "cable10"}));
+    const FabricTopology::Object* cable = topology.findCable("cable10");
+    ASSERT_NE(cable, nullptr);
+    EXPECT_EQ(cable->path, "/xyz/openbmc_project/inventory/cables/cable10");
+    EXPECT_EQ(topology.findCable("cable1"), nullptr);
+}
+
+TEST(FabricTopology, EmptyTree)
+{
+    FabricTopology topology(dbus::utility::MapperGetSubTreeResponse{});
+
+    EXPECT_TRUE(adapterIds(topology).empty());
+    EXPECT_EQ(topology.findAdapter("adapter"), nullptr);
+    EXPECT_EQ(topology.findCable("cable"), nullptr);
+}
+
+} // namespace
+} // namespace redfish::fabric_util
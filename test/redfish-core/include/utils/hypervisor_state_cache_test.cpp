@@ -0,0 +1,79 @@
+#include "dbus_utility.hpp"
+#include "utils/hypervisor_state_cache.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace redfish::hypervisor_utils
+{
+namespace
+{
+
+TEST(PowerStatus, MapsHostStates)
+{
+    std::optional<PowerStatus> running =
+        powerStatus("xyz.openbmc_project.State.Host.HostState.Running");
+    ASSERT_TRUE(running);
+    EXPECT_EQ(running->powerState, "On");
+    EXPECT_EQ(running->state, "Enabled");
+
+    std::optional<PowerStatus> starting = powerStatus(
+        "xyz.openbmc_project.State.Host.HostState.TransitioningToRunning");
+    ASSERT_TRUE(starting);
+    EXPECT_EQ(starting->powerState, "PoweringOn");
+    EXPECT_EQ(starting->state, "Starting");
+
+    std::optional<PowerStatus> off =
+        powerStatus("xyz.openbmc_project.State.Host.HostState.Off");
+    ASSERT_TRUE(off);
+    EXPECT_EQ(off->powerState, "Off");
+    EXPECT_EQ(off->state, "Disabled");
+}
+
+TEST(PowerStatus, RejectsUnknownState)
+{
+    EXPECT_FALSE(powerStatus(""));
+    EXPECT_FALSE(powerStatus("xyz.openbmc_project.State.Host.HostState.Bogus"));
+}
+
+TEST(UpdateHostState, AppliesCurrentHostState)
+{
+    HypervisorState state{true, "xyz.openbmc_project.State.Host.HostState.Off"};
+    dbus::utility::DBusPropertiesMap properties;
+    properties.emplace_back("RequestedHostTransition",
+                            std::string("xyz.openbmc_project.State.Host."
+                                        "Transition.On"));
+    properties.emplace_back(
+        "CurrentHostState",
+        std::string("xyz.openbmc_project.State.Host.HostState.Running"));
+    ASSERT_TRUE(updateHostState(state, properties));
+    EXPECT_EQ(state.hostState,
+              "xyz.openbmc_project.State.Host.HostState.Running");
+}
+
+TEST(UpdateHostState, KeepsStateWithoutCurrentHostState)
+{
+    HypervisorState state{true, "xyz.openbmc_project.State.Host.HostState.Off"};
+    dbus::utility::DBusPropertiesMap properties;
+    properties.emplace_back("RestartCause", std::string("Unknown"));
+    ASSERT_TRUE(updateHostState(state, properties));
+    EXPECT_EQ(state.hostState, "xyz.openbmc_project.State.Host.HostState.Off");
+}
+
+TEST(UpdateHostState, RejectsWrongType)
+{
+    HypervisorState state{true, "xyz.openbmc_project.State.Host.HostState.Off"};
+    dbus::utility::DBusPropertiesMap properties;
+    properties.emplace_back("CurrentHostState", uint32_t{3});
+    EXPECT_FALSE(updateHostState(state, properties));
+}
+
+} // namespace
+} // namespace redfish::hypervisor_utils
@@ -0,0 +1,95 @@
+#include "dbus_utility.hpp"
+#include "utils/input_history_cache.hpp"
+
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace redfish::power_supply_utils
+{
+namespace
+{
+
+using Values = std::vector<std::tuple<uint64_t, int64_t>>;
+
+dbus::utility::DBusPropertiesMap makeProperties(int64_t scale,
+                                                const Values& values)
+{
+    dbus::utility::DBusPropertiesMap properties;
+    properties.emplace_back("Scale", scale);
+    properties.emplace_back("Values", values);
+    return properties;
+}
+
+TEST(UpdateInputHistory, ConvertsFullRead)
+{
+    InputHistory history;
+    ASSERT_TRUE(updateInputHistory(
+        history, makeProperties(-1, {{1000, 125}, {2000, 130}})));
+    ASSERT_EQ(history.samples.size(), 2U);
+    EXPECT_EQ(history.samples[0].date, "1970-01-01T00:00:01.000+00:00");
+    EXPECT_DOUBLE_EQ(history.samples[0].value, 12.5);
+    EXPECT_EQ(history.samples[1].timestamp, 2000U);
+    EXPECT_DOUBLE_EQ(history.samples[1].value, 13.0);
+}
+
+TEST(UpdateInputHistory, AppendsNewSamplesAndKeepsWindow)
+{
+    InputHistory history;
+    ASSERT_TRUE(updateInputHistory(
+        history, makeProperties(0, {{1000, 1}, {2000, 2}, {3000, 3}})));
+    history.samples[1].date = "kept";
+
+    ASSERT_TRUE(updateInputHistory(
+        history, makeProperties(0, {{2000, 2}, {3000, 3}, {4000, 4}})));
+    ASSERT_EQ(history.samples.size(), 3U);
+    EXPECT_EQ(history.samples[0].timestamp, 2000U);
+    // Samples already held aren't converted again
+    EXPECT_EQ(history.samples[0].date, "kept");
+    EXPECT_EQ(history.samples[2].timestamp, 4000U);
+    EXPECT_DOUBLE_EQ(history.samples[2].value, 4.0);
+}
+
+TEST(UpdateInputHistory, ReplacesSamplesThatDontFollowOn)
+{
+    InputHistory history;
+    ASSERT_TRUE(
+        updateInputHistory(history, makeProperties(0, {{1000, 1}, {2000, 2}})));
+    history.samples[0].date = "stale";
+
+    ASSERT_TRUE(
+        updateInputHistory(history, makeProperties(0, {{500, 5}, {1500, 6}})));
+    ASSERT_EQ(history.samples.size(), 2U);
+    EXPECT_EQ(history.samples[0].timestamp, 500U);
+    EXPECT_NE(history.samples[0].date, "stale");
+}
+
+TEST(UpdateInputHistory, RescalesHeldSamples)
+{
+    InputHistory history;
+    ASSERT_TRUE(updateInputHistory(history, makeProperties(0, {{1000, 20}})));
+
+    dbus::utility::DBusPropertiesMap scaleOnly;
+    scaleOnly.emplace_back("Scale", int64_t{1});
+    ASSERT_TRUE(updateInputHistory(history, scaleOnly));
+    ASSERT_EQ(history.samples.size(), 1U);
+    EXPECT_DOUBLE_EQ(history.samples[0].value, 200.0);
+}
+
+TEST(UpdateInputHistory, RejectsWrongTypes)
+{
+    InputHistory history;
+    dbus::utility::DBusPropertiesMap properties;
+    properties.emplace_back("Values", std::string("not values"));
+    EXPECT_FALSE(updateInputHistory(history, properties));
+}
+
+} // namespace
+} // namespace redfish::power_supply_utils
@@ -0,0 +1,52 @@
+#include "utils/ip_config_plan.hpp"
+
+#include <string>
+
+#include <gmock/gmock.h> // IWYU pragma: keep
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace redfish::ip_util
+{
+namespace
+{
+using ::testing::ElementsAre;
+
+TEST(StaticAddressPlan, UnchangedAddressesMakeNoChange)
+{
+    StaticAddressPlan plan;
+    plan.replace("/ipv4/a", {"10.0.0.2", 24, "10.0.0.1"},
+                 {"10.0.0.2", 24, "10.0.0.1"});
+    plan.replace("/ipv6/b", {"fd00::2", 64, ""}, {"fd00::2", 64, ""});
+    EXPECT_TRUE(plan.empty());
+}
+
+TEST(StaticAddressPlan, ChangedAddressIsDeletedAndCreated)
+{
+    StaticAddressPlan plan;
+    plan.replace("/ipv4/a", {"10.0.0.2", 24, "10.0.0.1"},
+                 {"10.0.0.2", 16, "10.0.0.1"});
+    EXPECT_FALSE(plan.empty());
+    EXPECT_THAT(plan.getDeletes(), ElementsAre("/ipv4/a"));
+    EXPECT_THAT(plan.getCreates(),
+                ElementsAre(StaticAddress{"10.0.0.2", 16, "10.0.0.1"}));
+}
+
+TEST(StaticAddressPlan, KeepsElementOrderWithinDeletesAndCreates)
+{
+    StaticAddressPlan plan;
+    plan.replace("/ipv4/a", {"10.0.0.2", 24, "10.0.0.1"},
+                 {"10.0.0.3", 24, "10.0.0.1"});
+    plan.remove("/ipv4/b");
+    plan.add({"10.0.0.2", 24, "10.0.0.1"});
+    EXPECT_THAT(plan.getDeletes(), ElementsAre("/ipv4/a", "/ipv4/b"));
+    EXPECT_THAT(plan.getCreates(),
+                ElementsAre(StaticAddress{"10.0.0.3", 24, "10.0.0.1"},
+                            StaticAddress{"10.0.0.2", 24, "10.0.0.1"}));
+}
+
+} // namespace
+} // namespace redfish::ip_util
@@ -184,6 +184,29 @@ TEST(ReadJson, MultipleJsonSubElementValueAreUnpackedCorrectly)
     EXPECT_THAT(res.jsonValue, IsEmpty());
 }
 
+TEST(ReadJson, ExtraSubElementReturnsFalseOthersUnpacked)
+{
+    crow::Response res;
+    nlohmann::json jsonRequest = R"(
+        {
+            "json": {
+                "integer": 42,
+                "extra": true
+            },
+            "string": "bazbar"
+        }
+    )"_json;
+
+    std::optional<int> integer;
+    std::optional<std::string> bazbar;
+    EXPECT_FALSE(readJson(jsonRequest, res, "string", bazbar, "json/integer",
+                          integer));
+    EXPECT_EQ(res.result(), boost::beast::http::status::bad_request);
+    EXPECT_FALSE(res.jsonValue.empty());
+    EXPECT_EQ(integer, 42);
+    EXPECT_EQ(bazbar, "bazbar");
+}
+
 TEST(ReadJson, ExtraElement)
 {
     crow::Response res;
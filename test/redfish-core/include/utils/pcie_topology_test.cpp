@@ -0,0 +1,104 @@
+#include "dbus_utility.hpp"
+#include "utils/pcie_topology.hpp"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace redfish::pcie_util
+{
+namespace
+{
+
+constexpr const char* deviceIface =
+    "xyz.openbmc_project.Inventory.Item.PCIeDevice";
+constexpr const char* slotIface = "xyz.openbmc_project.Inventory.Item.PCIeSlot";
+
+dbus::utility::MapperGetSubTreeResponse makeTree()
+{
+    const std::string chassis = "/xyz/openbmc_project/inventory/system/chassis";
+    return {
+        {chassis + "/motherboard/pcieslot1",
+         {{"xyz.openbmc_project.Inventory.Manager",
+           {slotIface, "com.ibm.Control.Host.PCIeLink"}}}},
+        {chassis + "/motherboard/pcieslot1/pcie_card1",
+         {{"xyz.openbmc_project.Inventory.Manager", {deviceIface}},
+          {"xyz.openbmc_project.Inventory.Extra", {deviceIface}}}},
+        {chassis + "/motherboard/pcieslot2",
+         {{"xyz.openbmc_project.Inventory.Manager", {slotIface}}}},
+        {chassis + "/motherboard/pcieslot2/pcie_card2",
+         {{"xyz.openbmc_project.Inventory.Manager", {deviceIface}}}},
+        {chassis + "/motherboard/pcieslot2/pcie_card0",
+         {{"xyz.openbmc_project.Inventory.Manager", {deviceIface}}}},
+        {chassis + "/motherboard/pcie_card3",
+         {{"xyz.openbmc_project.Inventory.Manager", {deviceIface}}}},
+    };
+}
+
+TEST(PcieTopology, FindsDevicesByUniqueName)
+{
+    PcieTopology topology(makeTree());
+
+    ASSERT_EQ(topology.devices().size(), 4);
+    const PcieTopology::Device* device =
+        topology.findDevice("chassis_motherboard_pcieslot1_pcie_card1");
+    ASSERT_NE(device, nullptr);
+    EXPECT_EQ(device->path, "/xyz/openbmc_project/inventory/system/chassis/"
+                            "motherboard/pcieslot1/pcie_card1");
+    EXPECT_EQ(device->service, "xyz.openbmc_project.Inventory.Extra");
+
+    EXPECT_EQ(topology.findDevice("pcie_card1"), nullptr);
+}
+
+TEST(PcieTopology, DevicesAreInPathOrder)
+{
+    PcieTopology topology(makeTree());
+
+    std::vector<std::string> names;
+    for (const PcieTopology::Device& device : topology.devices())
+    {
+        names.emplace_back(device.name);
+    }
+    EXPECT_EQ(names, (std::vector<std::string>{
+                         "system_chassis_motherboard_pcie_card3",
+                         "chassis_motherboard_pcieslot1_pcie_card1",
+                         "chassis_motherboard_pcieslot2_pcie_card0",
+                         "chassis_motherboard_pcieslot2_pcie_card2"}));
+}
+
+TEST(PcieTopology, LinksDevicesAndSlots)
+{
+    PcieTopology topology(makeTree());
+
+    const PcieTopology::Slot* slot =
+        topology.findSlot("/xyz/openbmc_project/inventory/system/chassis/"
+                          "motherboard/pcieslot2");
+    ASSERT_NE(slot, nullptr);
+    ASSERT_EQ(slot->serviceMap.size(), 1);
+    const PcieTopology::Device* device = topology.deviceIn(*slot);
+    ASSERT_NE(device, nullptr);
+    EXPECT_EQ(device->name, "chassis_motherboard_pcieslot2_pcie_card0");
+    EXPECT_EQ(topology.slotOf(*device), slot);
+
+    const PcieTopology::Device* unslotted =
+        topology.findDevice("system_chassis_motherboard_pcie_card3");
+    ASSERT_NE(unslotted, nullptr);
+    EXPECT_EQ(topology.slotOf(*unslotted), nullptr);
+}
+
+TEST(PcieTopology, EmptyTree)
+{
+    PcieTopology topology(dbus::utility::MapperGetSubTreeResponse{});
+
+    EXPECT_TRUE(topology.devices().empty());
+    EXPECT_EQ(topology.findDevice("pcie_card1"), nullptr);
+    EXPECT_EQ(topology.findSlot("/xyz/openbmc_project/inventory"), nullptr);
+}
+
+} // namespace
+} // namespace redfish::pcie_util
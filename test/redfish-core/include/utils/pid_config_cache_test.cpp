@@ -0,0 +1,90 @@
+#include "dbus_utility.hpp"
+#include "utils/pid_config_cache.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h> // IWYU pragma: keep
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace redfish::pid_util
+{
+namespace
+{
+
+dbus::utility::ManagedObjectType makeObjects()
+{
+    dbus::utility::ManagedObjectType objects;
+    objects.emplace_back(sdbusplus::message::object_path(
+                             "/xyz/openbmc_project/inventory/system/chassis/"
+                             "board/CPU Fan"),
+                         dbus::utility::DBusInteracesMap{});
+    objects.emplace_back(sdbusplus::message::object_path(
+                             "/xyz/openbmc_project/inventory/system/chassis/"
+                             "other/CPU Fan"),
+                         dbus::utility::DBusInteracesMap{});
+    objects.emplace_back(sdbusplus::message::object_path(
+                             "/xyz/openbmc_project/inventory/system/chassis/"
+                             "board"),
+                         dbus::utility::DBusInteracesMap{});
+    return objects;
+}
+
+TEST(ObjectLeafIndex, FindsFirstObjectWithLeaf)
+{
+    dbus::utility::ManagedObjectType objects = makeObjects();
+    ObjectLeafIndex index(objects);
+
+    const auto* fan = index.find("CPU Fan");
+    ASSERT_NE(fan, nullptr);
+    EXPECT_EQ(fan->first.str,
+              "/xyz/openbmc_project/inventory/system/chassis/board/CPU Fan");
+
+    const auto* board = index.find("board");
+    ASSERT_NE(board, nullptr);
+    EXPECT_EQ(board->first.str,
+              "/xyz/openbmc_project/inventory/system/chassis/board");
+}
+
+TEST(ObjectLeafIndex, MatchesWholeElementsOnly)
+{
+    dbus::utility::ManagedObjectType objects = makeObjects();
+    ObjectLeafIndex index(objects);
+
+    EXPECT_EQ(index.find("Fan"), nullptr);
+    EXPECT_EQ(index.find("Missing"), nullptr);
+}
+
+TEST(ObjectLeafIndex, FindsLeafSpanningSeveralElements)
+{
+    dbus::utility::ManagedObjectType objects = makeObjects();
+    ObjectLeafIndex index(objects);
+
+    const auto* fan = index.find("other/CPU Fan");
+    ASSERT_NE(fan, nullptr);
+    EXPECT_EQ(fan->first.str,
+              "/xyz/openbmc_project/inventory/system/chassis/other/CPU Fan");
+}
+
+TEST(PopulatePid, EmptyConfigurationRendersCollections)
+{
+    nlohmann::json fan;
+    std::vector<std::string> supported{"Acoustic", "Performance"};
+    ASSERT_TRUE(populatePid({}, "Acoustic", supported, fan));
+
+    EXPECT_EQ(fan["@odata.type"], "#OemManager.Fan");
+    EXPECT_EQ(fan["Profile"], "Acoustic");
+    EXPECT_EQ(fan["Profile@Redfish.AllowableValues"], supported);
+    EXPECT_EQ(fan["FanZones"]["@odata.type"], "#OemManager.FanZones");
+    EXPECT_EQ(fan["PidControllers"]["@odata.type"],
+              "#OemManager.PidControllers");
+}
+
+} // namespace
+} // namespace redfish::pid_util
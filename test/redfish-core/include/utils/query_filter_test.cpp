@@ -0,0 +1,117 @@
+#include "utils/query_filter.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <optional>
+#include <string_view>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace redfish::query_param
+{
+namespace
+{
+
+const nlohmann::json entry = R"({
+    "Id": "12",
+    "Severity": "Critical",
+    "Created": "2023-05-01T12:00:00+00:00",
+    "Resolved": false,
+    "Reading": 42.5,
+    "Status": {"Health": "OK"}
+})"_json;
+
+bool matches(std::string_view filter, const nlohmann::json& member = entry)
+{
+    std::optional<Filter> parsed = parseFilter(filter);
+    EXPECT_TRUE(parsed) << filter;
+    return parsed && parsed->matches(member);
+}
+
+TEST(ParseFilter, ComparesStrings)
+{
+    EXPECT_TRUE(matches("Severity eq 'Critical'"));
+    EXPECT_FALSE(matches("Severity eq 'OK'"));
+    EXPECT_TRUE(matches("Severity ne 'OK'"));
+    EXPECT_TRUE(matches("Id gt '100'"));
+}
+
+TEST(ParseFilter, ComparesNumbersAndBooleans)
+{
+    EXPECT_TRUE(matches("Reading gt 40"));
+    EXPECT_TRUE(matches("Reading le 42.5"));
+    EXPECT_FALSE(matches("Reading lt -1"));
+    EXPECT_TRUE(matches("Resolved eq false"));
+    EXPECT_FALSE(matches("Resolved eq true"));
+}
+
+TEST(ParseFilter, ComparesDateTimesAsTimes)
+{
+    EXPECT_TRUE(matches("Created gt 2023-05-01T11:59:59Z"));
+    EXPECT_TRUE(matches("Created eq 2023-05-01T14:00:00+02:00"));
+    EXPECT_FALSE(matches("Created ge '2023-05-02T00:00:00+00:00'"));
+}
+
+TEST(ParseFilter, MissingPropertiesAreNull)
+{
+    EXPECT_TRUE(matches("Resolution eq null"));
+    EXPECT_FALSE(matches("Resolution eq 'x'"));
+    EXPECT_TRUE(matches("Resolution ne 'x'"));
+    EXPECT_FALSE(matches("Severity eq null"));
+    // Different types are never equal
+    EXPECT_FALSE(matches("Reading eq '42.5'"));
+}
+
+TEST(ParseFilter, FollowsPropertyPaths)
+{
+    EXPECT_TRUE(matches("Status/Health eq 'OK'"));
+    EXPECT_FALSE(matches("Status/State eq 'Enabled'"));
+}
+
+TEST(ParseFilter, JoinsWithPrecedence)
+{
+    EXPECT_TRUE(matches("Severity eq 'OK' or Reading gt 40 and Resolved eq "
+                        "false"));
+    EXPECT_FALSE(matches("(Severity eq 'OK' or Reading gt 40) and "
+                         "Resolved eq true"));
+    EXPECT_TRUE(matches("not Severity eq 'OK'"));
+    EXPECT_TRUE(matches("not (Severity eq 'OK' or Resolved eq true)"));
+}
+
+TEST(ParseFilter, UnescapesQuotes)
+{
+    nlohmann::json member = {{"Name", "It's"}};
+    EXPECT_TRUE(matches("Name eq 'It''s'", member));
+}
+
+TEST(ParseFilter, UsesOnly)
+{
+    std::optional<Filter> filter =
+        parseFilter("Severity eq 'Critical' and not (Id eq '1')");
+    ASSERT_TRUE(filter);
+    EXPECT_TRUE(filter->usesOnly({"Id", "Severity"}));
+    EXPECT_FALSE(filter->usesOnly({"Severity"}));
+    EXPECT_EQ(filter->source(), "Severity eq 'Critical' and not (Id eq '1')");
+}
+
+TEST(ParseFilter, RejectsWhatIsNotSupported)
+{
+    EXPECT_EQ(parseFilter(""), std::nullopt);
+    EXPECT_EQ(parseFilter("Severity"), std::nullopt);
+    EXPECT_EQ(parseFilter("Severity eq"), std::nullopt);
+    EXPECT_EQ(parseFilter("Severity eq 'Critical"), std::nullopt);
+    EXPECT_EQ(parseFilter("Severity has 'Critical'"), std::nullopt);
+    EXPECT_EQ(parseFilter("Severity eq Critical"), std::nullopt);
+    EXPECT_EQ(parseFilter("(Severity eq 'OK'"), std::nullopt);
+    EXPECT_EQ(parseFilter("Severity eq 'OK' and"), std::nullopt);
+    EXPECT_EQ(parseFilter("Status/ eq 'OK'"), std::nullopt);
+    EXPECT_EQ(parseFilter("contains(Severity, 'OK')"), std::nullopt);
+    EXPECT_EQ(parseFilter("((((((((((Id eq '1'))))))))))"), std::nullopt);
+}
+
+} // namespace
+} // namespace redfish::query_param
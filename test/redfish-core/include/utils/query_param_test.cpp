@@ -6,6 +6,7 @@
 #include <boost/url/url_view.hpp>
 #include <nlohmann/json.hpp>
 
+#include <limits>
 #include <new>
 #include <span>
 
@@ -125,6 +126,89 @@ TEST(Delegate, SkipPositive)
     EXPECT_EQ(query.skip, 0);
 }
 
+TEST(Delegate, DeltaTokenNegative)
+{
+    Query query{
+        .deltaToken = "token",
+    };
+    Query delegated = delegate(QueryCapabilities{}, query);
+    EXPECT_EQ(delegated.deltaToken, std::nullopt);
+    EXPECT_EQ(query.deltaToken, "token");
+}
+
+TEST(Delegate, DeltaTokenPositive)
+{
+    Query query{
+        .deltaToken = "token",
+    };
+    QueryCapabilities capabilities{
+        .canDelegateDeltaToken = true,
+    };
+    Query delegated = delegate(capabilities, query);
+    EXPECT_EQ(delegated.deltaToken, "token");
+    EXPECT_EQ(query.deltaToken, std::nullopt);
+}
+
+TEST(Delegate, FilterNegativeKeepsPagingWithDefaultHandler)
+{
+    Query query{
+        .skip = 2,
+        .top = 3,
+        .filter = parseFilter("Id eq '1'"),
+    };
+    QueryCapabilities capabilities{
+        .canDelegateTop = true,
+        .canDelegateSkip = true,
+    };
+    Query delegated = delegate(capabilities, query);
+    EXPECT_EQ(delegated.filter, std::nullopt);
+    EXPECT_EQ(delegated.top, std::numeric_limits<size_t>::max());
+    EXPECT_EQ(delegated.skip, std::nullopt);
+    EXPECT_TRUE(query.filter);
+    EXPECT_EQ(query.top, 3);
+    EXPECT_EQ(query.skip, 2);
+}
+
+TEST(Delegate, FilterPositive)
+{
+    Query query{
+        .skip = 2,
+        .top = 3,
+        .filter = parseFilter("Id eq '1'"),
+    };
+    QueryCapabilities capabilities{
+        .canDelegateTop = true,
+        .canDelegateSkip = true,
+        .canDelegateFilter = true,
+    };
+    Query delegated = delegate(capabilities, query);
+    ASSERT_TRUE(delegated.filter);
+    EXPECT_EQ(delegated.filter->source(), "Id eq '1'");
+    EXPECT_EQ(delegated.top, 3);
+    EXPECT_EQ(delegated.skip, 2);
+    EXPECT_EQ(query.filter, std::nullopt);
+}
+
+TEST(Delegate, SelectPruneSharesTrie)
+{
+    Query query;
+    ASSERT_TRUE(query.selectTrie.insertNode("Status/Health"));
+    QueryCapabilities capabilities{
+        .canPruneBySelect = true,
+    };
+    Query delegated = delegate(capabilities, query);
+    EXPECT_TRUE(delegated.selectTrie.isAnySelected({"Status"}));
+    EXPECT_FALSE(delegated.selectTrie.isAnySelected({"Model", "UUID"}));
+    // The default handler still applies $select to the response
+    EXPECT_NE(query.selectTrie.root.find("Status"), nullptr);
+}
+
+TEST(SelectTrie, IsAnySelectedWithoutSelect)
+{
+    SelectTrie trie;
+    EXPECT_TRUE(trie.isAnySelected({"Model"}));
+}
+
 TEST(FormatQueryForExpand, NoSubQueryWhenQueryIsEmpty)
 {
     EXPECT_EQ(formatQueryForExpand(Query{}), "");
@@ -415,6 +499,40 @@ TEST(PropogateErrorCode, 4xxIsWorseThanOthers)
     EXPECT_EQ(propogateErrorCode(403, 402), 403);
 }
 
+TEST(ProcessFilter, LeavesMatchingMembersAndCountsThem)
+{
+    std::optional<Filter> filter = parseFilter("Severity ne 'OK'");
+    ASSERT_TRUE(filter);
+    crow::Response res;
+    res.jsonValue = R"({
+        "Members": [
+            {"Id": "1", "Severity": "OK"},
+            {"Id": "2", "Severity": "Critical"},
+            {"Id": "3", "Severity": "Warning"}
+        ],
+        "Members@odata.count": 3,
+        "Members@odata.nextLink": "/redfish/v1/Entries?$skip=3"
+    })"_json;
+    processFilter(*filter, res);
+    EXPECT_EQ(res.jsonValue, R"({
+        "Members": [
+            {"Id": "2", "Severity": "Critical"},
+            {"Id": "3", "Severity": "Warning"}
+        ],
+        "Members@odata.count": 2
+    })"_json);
+}
+
+TEST(ProcessFilter, NotACollectionGetsError)
+{
+    std::optional<Filter> filter = parseFilter("Id eq '1'");
+    ASSERT_TRUE(filter);
+    crow::Response res;
+    res.jsonValue = R"({"Id": "1"})"_json;
+    processFilter(*filter, res);
+    EXPECT_EQ(res.result(), boost::beast::http::status::bad_request);
+}
+
 TEST(PropogateError, IntermediateNoErrorMessageMakesNoChange)
 {
     crow::Response intermediate;
@@ -618,6 +736,62 @@ TEST(QueryParams, ParseParametersSkipOutOfRange)
     ASSERT_EQ(query, std::nullopt);
 }
 
+TEST(QueryParams, ParseParametersDeltaToken)
+{
+    auto ret = boost::urls::parse_relative_ref("/redfish/v1?$deltatoken=abc");
+    ASSERT_TRUE(ret);
+
+    std::string_view url = "/redfish/v1";
+    crow::Response res;
+
+    std::optional<Query> query = parseParameters(ret->params(), res, url);
+    ASSERT_TRUE(query != std::nullopt);
+    EXPECT_EQ(query->deltaToken, "abc");
+}
+
+TEST(QueryParams, ParseParametersDeltaTokenWithTopGetsError)
+{
+    auto ret =
+        boost::urls::parse_relative_ref("/redfish/v1?$deltatoken=abc&$top=1");
+    ASSERT_TRUE(ret);
+
+    std::string_view url = "/redfish/v1";
+    crow::Response res;
+
+    std::optional<Query> query = parseParameters(ret->params(), res, url);
+    ASSERT_TRUE(query == std::nullopt);
+    EXPECT_EQ(res.result(), boost::beast::http::status::bad_request);
+}
+
+TEST(QueryParams, ParseParametersFilter)
+{
+    auto ret = boost::urls::parse_relative_ref(
+        "/redfish/v1?$filter=Severity%20eq%20'Critical'");
+    ASSERT_TRUE(ret);
+
+    std::string_view url = "/redfish/v1";
+    crow::Response res;
+
+    std::optional<Query> query = parseParameters(ret->params(), res, url);
+    ASSERT_TRUE(query != std::nullopt);
+    ASSERT_TRUE(query->filter);
+    EXPECT_EQ(query->filter->source(), "Severity eq 'Critical'");
+}
+
+TEST(QueryParams, ParseParametersFilterMalformedGetsError)
+{
+    auto ret =
+        boost::urls::parse_relative_ref("/redfish/v1?$filter=Severity%20eq");
+    ASSERT_TRUE(ret);
+
+    std::string_view url = "/redfish/v1";
+    crow::Response res;
+
+    std::optional<Query> query = parseParameters(ret->params(), res, url);
+    ASSERT_TRUE(query == std::nullopt);
+    EXPECT_EQ(res.result(), boost::beast::http::status::bad_request);
+}
+
 TEST(QueryParams, ParseParametersUnexpectedGetsIgnored)
 {
     auto ret = boost::urls::parse_relative_ref("/redfish/v1?unexpected_param");
@@ -139,5 +139,58 @@ TEST(Utility, GetDateTimeUintUs)
               "1970-01-01T00:00:00.000000+00:00");
 }
 
+TEST(GetHttpDate, ConversionTests)
+{
+    EXPECT_EQ(getHttpDate(0), "Thu, 01 Jan 1970 00:00:00 GMT");
+    EXPECT_EQ(getHttpDate(784111777), "Sun, 06 Nov 1994 08:49:37 GMT");
+    EXPECT_EQ(getHttpDate(1709164800), "Thu, 29 Feb 2024 00:00:00 GMT");
+}
+
+TEST(FromHttpDate, ConversionTests)
+{
+    EXPECT_EQ(fromHttpDate("Thu, 01 Jan 1970 00:00:00 GMT"), 0U);
+    EXPECT_EQ(fromHttpDate("Sun, 06 Nov 1994 08:49:37 GMT"), 784111777U);
+    EXPECT_EQ(fromHttpDate(getHttpDate(1709164800)), 1709164800U);
+}
+
+TEST(FromHttpDate, NegativeTests)
+{
+    // Obsolete forms
+    EXPECT_EQ(fromHttpDate("Sunday, 06-Nov-94 08:49:37 GMT"), std::nullopt);
+    EXPECT_EQ(fromHttpDate("Sun Nov  6 08:49:37 1994"), std::nullopt);
+
+    EXPECT_EQ(fromHttpDate(""), std::nullopt);
+    EXPECT_EQ(fromHttpDate("Sun, 06 Nov 1994 08:49:37 UTC"), std::nullopt);
+    EXPECT_EQ(fromHttpDate("Sun, 06 Nov 1994 24:49:37 GMT"), std::nullopt);
+    EXPECT_EQ(fromHttpDate("Sun, 06 Foo 1994 08:49:37 GMT"), std::nullopt);
+    EXPECT_EQ(fromHttpDate("Sun, +6 Nov 1994 08:49:37 GMT"), std::nullopt);
+}
+
+TEST(FromDateTimeString, ConversionTests)
+{
+    EXPECT_EQ(fromDateTimeString("1970-01-01T00:00:00+00:00"), 0);
+    EXPECT_EQ(fromDateTimeString("1970-01-01T00:00:00Z"), 0);
+    EXPECT_EQ(fromDateTimeString("1994-11-06T08:49:37Z"), 784111777000000);
+    EXPECT_EQ(fromDateTimeString("1994-11-06T10:49:37+02:00"),
+              784111777000000);
+    EXPECT_EQ(fromDateTimeString("1994-11-06T08:19:37-00:30"),
+              784111777000000);
+    EXPECT_EQ(fromDateTimeString("1970-01-01T00:00:00.5Z"), 500000);
+    EXPECT_EQ(fromDateTimeString("1970-01-01T00:00:00.123456789Z"), 123456);
+    EXPECT_EQ(fromDateTimeString(getDateTimeUintMs(1638312095123)),
+              1638312095123000);
+}
+
+TEST(FromDateTimeString, NegativeTests)
+{
+    EXPECT_EQ(fromDateTimeString(""), std::nullopt);
+    EXPECT_EQ(fromDateTimeString("1970-01-01T00:00:00"), std::nullopt);
+    EXPECT_EQ(fromDateTimeString("1970-01-01 00:00:00Z"), std::nullopt);
+    EXPECT_EQ(fromDateTimeString("1970-13-01T00:00:00Z"), std::nullopt);
+    EXPECT_EQ(fromDateTimeString("1970-01-01T00:00:00.Z"), std::nullopt);
+    EXPECT_EQ(fromDateTimeString("1970-01-01T00:00:00+0000"), std::nullopt);
+    EXPECT_EQ(fromDateTimeString("1970-01-01T00:00:00Zjunk"), std::nullopt);
+}
+
 } // namespace
 } // namespace redfish::time_utils
@@ -4,6 +4,7 @@
 
 #include <systemd/sd-id128.h>
 
+#include <boost/url/pct_string_view.hpp>
 #include <nlohmann/json.hpp>
 
 #include <format>
@@ -65,5 +66,76 @@ TEST(LogServicesBMCJouralTest, LogServicesBMCJouralGetReturnsError)
     EXPECT_EQ(indexOut, indexIn);
 }
 
+TEST(LogServicesBMCJouralTest, PageTokenRoundTrips)
+{
+    std::string cursor = "s=739ad463348b4ceca5a9e69c95a3c93f;i=4ece7;"
+                         "b=6c7c6013a8a7427991e439e9c8ee2add;m=3e8ac;"
+                         "t=5a0c3a4b8857b;x=8e1f6c6d3a8c5f72";
+    std::string token = makeJournalPageToken(1234, cursor);
+    // The token goes into a query string as-is
+    EXPECT_EQ(token.find_first_of("+/=&"), std::string::npos);
+
+    auto decoded = boost::urls::make_pct_string_view(token);
+    ASSERT_TRUE(decoded);
+
+    uint64_t position = 0;
+    std::string cursorOut;
+    ASSERT_TRUE(parseJournalPageToken(decoded->decode(), position, cursorOut));
+    EXPECT_EQ(position, 1234);
+    EXPECT_EQ(cursorOut, cursor);
+}
+
+TEST(LogServicesBMCJouralTest, PageTokenRejectsGarbage)
+{
+    uint64_t position = 0;
+    std::string cursor;
+    EXPECT_FALSE(parseJournalPageToken("", position, cursor));
+    EXPECT_FALSE(parseJournalPageToken("not base64!", position, cursor));
+    // "abc:def" has no numeric position
+    EXPECT_FALSE(parseJournalPageToken("YWJjOmRlZg==", position, cursor));
+    // "12:" has no cursor
+    EXPECT_FALSE(parseJournalPageToken("MTI6", position, cursor));
+}
+
+TEST(IsLogEntryStreamRequested, OptInByHeaderOrQuery)
+{
+    std::error_code ec;
+    crow::Request plain({boost::beast::http::verb::get, "/Entries", 11}, ec);
+    EXPECT_FALSE(isLogEntryStreamRequested(plain));
+
+    crow::Request byHeader({boost::beast::http::verb::get, "/Entries", 11},
+                           ec);
+    byHeader.req.set(boost::beast::http::field::accept,
+                     "application/x-ndjson");
+    EXPECT_TRUE(isLogEntryStreamRequested(byHeader));
+
+    crow::Request byQuery(
+        {boost::beast::http::verb::get, "/Entries?format=ndjson&$skip=5", 11},
+        ec);
+    EXPECT_TRUE(isLogEntryStreamRequested(byQuery));
+}
+
+TEST(IsLogEntryStreamRequested, OnlyCombinesWithTopAndSkip)
+{
+    std::error_code ec;
+    crow::Request expand(
+        {boost::beast::http::verb::get, "/Entries?format=ndjson&$expand=.", 11},
+        ec);
+    EXPECT_FALSE(isLogEntryStreamRequested(expand));
+
+    crow::Request only(
+        {boost::beast::http::verb::get, "/Entries?only&format=ndjson", 11}, ec);
+    EXPECT_FALSE(isLogEntryStreamRequested(only));
+}
+
+TEST(StreamLogEntries, SetsGeneratorAndContentType)
+{
+    crow::Response res;
+    streamLogEntries(res, [](nlohmann::json& /*entry*/) { return false; });
+    EXPECT_TRUE(res.hasBodyGenerator());
+    EXPECT_TRUE(res.jsonValue.empty());
+    EXPECT_EQ(res.getHeaderValue("Content-Type"), "application/x-ndjson");
+}
+
 } // namespace
 } // namespace redfish
@@ -1,5 +1,9 @@
 #include "sensors.hpp"
 
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include <gmock/gmock.h> // IWYU pragma: keep
 #include <gtest/gtest.h> // IWYU pragma: keep
 
@@ -32,5 +36,23 @@ TEST(SplitSensorNameAndType, Error)
     EXPECT_TRUE(splitSensorNameAndType("temperature").second.empty());
 }
 
+TEST(IndexInventoryItemsBySensor, MapsEachSensorToItsItem)
+{
+    std::vector<InventoryItem> items;
+    items.emplace_back("/xyz/openbmc_project/inventory/system/psu0");
+    items.back().sensors.emplace("/xyz/openbmc_project/sensors/power/psu0");
+    items.back().sensors.emplace("/xyz/openbmc_project/sensors/voltage/psu0");
+    items.emplace_back("/xyz/openbmc_project/inventory/system/fan0");
+    items.back().sensors.emplace("/xyz/openbmc_project/sensors/fan_tach/fan0");
+
+    std::unordered_map<std::string, InventoryItem*> index =
+        indexInventoryItemsBySensor(items);
+    ASSERT_EQ(index.size(), 3U);
+    EXPECT_EQ(index["/xyz/openbmc_project/sensors/power/psu0"], &items[0]);
+    EXPECT_EQ(index["/xyz/openbmc_project/sensors/voltage/psu0"], &items[0]);
+    EXPECT_EQ(index["/xyz/openbmc_project/sensors/fan_tach/fan0"], &items[1]);
+    EXPECT_FALSE(index.contains("/xyz/openbmc_project/sensors/fan_tach/fan1"));
+}
+
 } // namespace
 } // namespace redfish